@@ -299,8 +299,16 @@ absl::Status CompileHloBenchmark(benchmark::State& state,
   }
 
   for (auto _ : state) {
-    TF_ASSIGN_OR_RETURN(std::unique_ptr<PjRtLoadedExecutable> executable,
-                        client->CompileAndLoad(computation, compile_options));
+    std::unique_ptr<PjRtLoadedExecutable> executable;
+    if (benchmark_options.aot_options) {
+      auto* cpu_client = tsl::down_cast<TfrtCpuClient*>(client.get());
+      TF_ASSIGN_OR_RETURN(executable, cpu_client->CompileAheadOfTimeAndLoad(
+                                          computation, compile_options,
+                                          *benchmark_options.aot_options));
+    } else {
+      TF_ASSIGN_OR_RETURN(executable,
+                          client->CompileAndLoad(computation, compile_options));
+    }
     tsl::testing::DoNotOptimize(executable);
   }
 
@@ -59,7 +59,8 @@ absl::Status RunHloBenchmark(benchmark::State& state,
 // Benchmarks the given HLO's compilation time.
 //
 // Takes the same options as RunHloBenchmark, except no arguments since the
-// HLO is only compiled, not run.
+// HLO is only compiled, not run. If `aot_options` is set, the benchmark
+// measures ahead-of-time compilation and loading of the executable.
 absl::Status CompileHloBenchmark(
     benchmark::State& state, absl::string_view hlo_module,
     StrToStrMapping replacements = {},
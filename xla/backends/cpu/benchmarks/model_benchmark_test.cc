@@ -0,0 +1,368 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// End-to-end benchmarks for representative model graphs: transformer encoder,
+// convolutional network, recommender (embedding lookup + MLP) and sort-heavy
+// graphs. Every model is benchmarked for run time (throughput is reported as
+// `items_per_second`, where one item is one example in a batch) and compile
+// time, in both JIT and AOT modes.
+//
+// Use `--benchmark_format=json` (or `--benchmark_out=<file>` together with
+// `--benchmark_out_format=json`) to get machine readable results.
+
+#include <cstdint>
+
+#include "absl/log/check.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "xla/backends/cpu/benchmarks/hlo_benchmark_runner.h"
+#include "xla/backends/cpu/benchmarks/multi_benchmark_config.h"
+#include "xla/tsl/platform/test_benchmark.h"
+
+namespace xla::cpu {
+
+// Single transformer encoder layer with 4 attention heads: hidden size 256,
+// sequence length 128, feed forward size 1024 and tanh approximation of GELU.
+static constexpr absl::string_view kTransformerEncoder = R"(
+  HloModule transformer_encoder
+
+  add {
+    a = f32[] parameter(0)
+    b = f32[] parameter(1)
+    ROOT add = f32[] add(a, b)
+  }
+
+  max {
+    a = f32[] parameter(0)
+    b = f32[] parameter(1)
+    ROOT max = f32[] maximum(a, b)
+  }
+
+  ENTRY e {
+    x = f32[$batch,128,256] parameter(0)
+    w_qkv = f32[256,768] parameter(1)
+    w_out = f32[256,256] parameter(2)
+    w_ffn1 = f32[256,1024] parameter(3)
+    w_ffn2 = f32[1024,256] parameter(4)
+
+    zero = f32[] constant(0)
+    ninf = f32[] constant(-inf)
+    inv_h = f32[] constant(0.00390625)
+    eps = f32[] constant(1e-5)
+    inv_h_b = f32[$batch,128] broadcast(inv_h), dimensions={}
+    eps_b = f32[$batch,128] broadcast(eps), dimensions={}
+
+    ln1_sum = f32[$batch,128] reduce(x, zero), dimensions={2}, to_apply=add
+    ln1_mean = f32[$batch,128] multiply(ln1_sum, inv_h_b)
+    ln1_mean_b = f32[$batch,128,256] broadcast(ln1_mean), dimensions={0,1}
+    ln1_xc = f32[$batch,128,256] subtract(x, ln1_mean_b)
+    ln1_xc2 = f32[$batch,128,256] multiply(ln1_xc, ln1_xc)
+    ln1_var_sum = f32[$batch,128] reduce(ln1_xc2, zero), dimensions={2},
+                                  to_apply=add
+    ln1_var = f32[$batch,128] multiply(ln1_var_sum, inv_h_b)
+    ln1_var_eps = f32[$batch,128] add(ln1_var, eps_b)
+    ln1_rstd = f32[$batch,128] rsqrt(ln1_var_eps)
+    ln1_rstd_b = f32[$batch,128,256] broadcast(ln1_rstd), dimensions={0,1}
+    ln1 = f32[$batch,128,256] multiply(ln1_xc, ln1_rstd_b)
+
+    qkv = f32[$batch,128,768] dot(ln1, w_qkv),
+                              lhs_contracting_dims={2},
+                              rhs_contracting_dims={0}
+    q = f32[$batch,128,256] slice(qkv), slice={[0:$batch], [0:128], [0:256]}
+    k = f32[$batch,128,256] slice(qkv), slice={[0:$batch], [0:128], [256:512]}
+    v = f32[$batch,128,256] slice(qkv), slice={[0:$batch], [0:128], [512:768]}
+    q4 = f32[$batch,128,4,64] reshape(q)
+    k4 = f32[$batch,128,4,64] reshape(k)
+    v4 = f32[$batch,128,4,64] reshape(v)
+
+    scores = f32[$batch,4,128,128] dot(q4, k4),
+                                   lhs_batch_dims={0,2},
+                                   lhs_contracting_dims={3},
+                                   rhs_batch_dims={0,2},
+                                   rhs_contracting_dims={3}
+    scale = f32[] constant(0.125)
+    scale_b = f32[$batch,4,128,128] broadcast(scale), dimensions={}
+    scaled = f32[$batch,4,128,128] multiply(scores, scale_b)
+    smax = f32[$batch,4,128] reduce(scaled, ninf), dimensions={3},
+                             to_apply=max
+    smax_b = f32[$batch,4,128,128] broadcast(smax), dimensions={0,1,2}
+    shifted = f32[$batch,4,128,128] subtract(scaled, smax_b)
+    exps = f32[$batch,4,128,128] exponential(shifted)
+    ssum = f32[$batch,4,128] reduce(exps, zero), dimensions={3}, to_apply=add
+    ssum_b = f32[$batch,4,128,128] broadcast(ssum), dimensions={0,1,2}
+    probs = f32[$batch,4,128,128] divide(exps, ssum_b)
+
+    ctx = f32[$batch,4,128,64] dot(probs, v4),
+                               lhs_batch_dims={0,1},
+                               lhs_contracting_dims={3},
+                               rhs_batch_dims={0,2},
+                               rhs_contracting_dims={1}
+    ctx_t = f32[$batch,128,4,64] transpose(ctx), dimensions={0,2,1,3}
+    ctx_r = f32[$batch,128,256] reshape(ctx_t)
+    attn = f32[$batch,128,256] dot(ctx_r, w_out),
+                               lhs_contracting_dims={2},
+                               rhs_contracting_dims={0}
+    res1 = f32[$batch,128,256] add(x, attn)
+
+    ln2_sum = f32[$batch,128] reduce(res1, zero), dimensions={2}, to_apply=add
+    ln2_mean = f32[$batch,128] multiply(ln2_sum, inv_h_b)
+    ln2_mean_b = f32[$batch,128,256] broadcast(ln2_mean), dimensions={0,1}
+    ln2_xc = f32[$batch,128,256] subtract(res1, ln2_mean_b)
+    ln2_xc2 = f32[$batch,128,256] multiply(ln2_xc, ln2_xc)
+    ln2_var_sum = f32[$batch,128] reduce(ln2_xc2, zero), dimensions={2},
+                                  to_apply=add
+    ln2_var = f32[$batch,128] multiply(ln2_var_sum, inv_h_b)
+    ln2_var_eps = f32[$batch,128] add(ln2_var, eps_b)
+    ln2_rstd = f32[$batch,128] rsqrt(ln2_var_eps)
+    ln2_rstd_b = f32[$batch,128,256] broadcast(ln2_rstd), dimensions={0,1}
+    ln2 = f32[$batch,128,256] multiply(ln2_xc, ln2_rstd_b)
+
+    h1 = f32[$batch,128,1024] dot(ln2, w_ffn1),
+                              lhs_contracting_dims={2},
+                              rhs_contracting_dims={0}
+    c_half = f32[] constant(0.5)
+    c_one = f32[] constant(1)
+    c_sqrt = f32[] constant(0.7978845608)
+    c_cube = f32[] constant(0.044715)
+    c_half_b = f32[$batch,128,1024] broadcast(c_half), dimensions={}
+    c_one_b = f32[$batch,128,1024] broadcast(c_one), dimensions={}
+    c_sqrt_b = f32[$batch,128,1024] broadcast(c_sqrt), dimensions={}
+    c_cube_b = f32[$batch,128,1024] broadcast(c_cube), dimensions={}
+    h1_2 = f32[$batch,128,1024] multiply(h1, h1)
+    h1_3 = f32[$batch,128,1024] multiply(h1_2, h1)
+    h1_3s = f32[$batch,128,1024] multiply(h1_3, c_cube_b)
+    inner = f32[$batch,128,1024] add(h1, h1_3s)
+    inner_s = f32[$batch,128,1024] multiply(inner, c_sqrt_b)
+    th = f32[$batch,128,1024] tanh(inner_s)
+    th_1 = f32[$batch,128,1024] add(th, c_one_b)
+    h1_half = f32[$batch,128,1024] multiply(h1, c_half_b)
+    gelu = f32[$batch,128,1024] multiply(h1_half, th_1)
+
+    h2 = f32[$batch,128,256] dot(gelu, w_ffn2),
+                             lhs_contracting_dims={2},
+                             rhs_contracting_dims={0}
+    ROOT out = f32[$batch,128,256] add(res1, h2)
+  }
+)";
+
+// Small convolutional network for 32x32 RGB images: two 3x3 convolutions with
+// ReLU and max pooling, global average pooling and a dense classifier.
+static constexpr absl::string_view kConvNet = R"(
+  HloModule conv_net
+
+  add {
+    a = f32[] parameter(0)
+    b = f32[] parameter(1)
+    ROOT add = f32[] add(a, b)
+  }
+
+  max {
+    a = f32[] parameter(0)
+    b = f32[] parameter(1)
+    ROOT max = f32[] maximum(a, b)
+  }
+
+  ENTRY e {
+    x = f32[$batch,32,32,3] parameter(0)
+    w1 = f32[3,3,3,32] parameter(1)
+    w2 = f32[3,3,32,64] parameter(2)
+    w_fc = f32[64,10] parameter(3)
+
+    zero = f32[] constant(0)
+    ninf = f32[] constant(-inf)
+
+    conv1 = f32[$batch,32,32,32] convolution(x, w1),
+                                 window={size=3x3 pad=1_1x1_1},
+                                 dim_labels=b01f_01io->b01f
+    zero1 = f32[$batch,32,32,32] broadcast(zero), dimensions={}
+    relu1 = f32[$batch,32,32,32] maximum(conv1, zero1)
+    pool1 = f32[$batch,16,16,32] reduce-window(relu1, ninf),
+                                 window={size=1x2x2x1 stride=1x2x2x1},
+                                 to_apply=max
+
+    conv2 = f32[$batch,16,16,64] convolution(pool1, w2),
+                                 window={size=3x3 pad=1_1x1_1},
+                                 dim_labels=b01f_01io->b01f
+    zero2 = f32[$batch,16,16,64] broadcast(zero), dimensions={}
+    relu2 = f32[$batch,16,16,64] maximum(conv2, zero2)
+    pool2 = f32[$batch,8,8,64] reduce-window(relu2, ninf),
+                               window={size=1x2x2x1 stride=1x2x2x1},
+                               to_apply=max
+
+    gap_sum = f32[$batch,64] reduce(pool2, zero), dimensions={1,2},
+                             to_apply=add
+    inv_hw = f32[] constant(0.015625)
+    inv_hw_b = f32[$batch,64] broadcast(inv_hw), dimensions={}
+    gap = f32[$batch,64] multiply(gap_sum, inv_hw_b)
+
+    ROOT logits = f32[$batch,10] dot(gap, w_fc),
+                                 lhs_contracting_dims={1},
+                                 rhs_contracting_dims={0}
+  }
+)";
+
+// Recommender model: 26 sparse features looked up in a shared embedding table,
+// concatenated with 13 dense features and fed into a 512-256-1 MLP.
+static constexpr absl::string_view kRecommender = R"(
+  HloModule recommender
+
+  ENTRY e {
+    table = f32[100000,64] parameter(0)
+    ids = s32[$batch,26] parameter(1)
+    dense = f32[$batch,13] parameter(2)
+    w0 = f32[1677,512] parameter(3)
+    w1 = f32[512,256] parameter(4)
+    w2 = f32[256,1] parameter(5)
+
+    zero = f32[] constant(0)
+
+    emb = f32[$batch,26,64] gather(table, ids),
+                            offset_dims={2},
+                            collapsed_slice_dims={0},
+                            start_index_map={0},
+                            index_vector_dim=2,
+                            slice_sizes={1,64}
+    emb_flat = f32[$batch,1664] reshape(emb)
+    features = f32[$batch,1677] concatenate(emb_flat, dense), dimensions={1}
+
+    h0 = f32[$batch,512] dot(features, w0),
+                         lhs_contracting_dims={1},
+                         rhs_contracting_dims={0}
+    zero0 = f32[$batch,512] broadcast(zero), dimensions={}
+    relu0 = f32[$batch,512] maximum(h0, zero0)
+
+    h1 = f32[$batch,256] dot(relu0, w1),
+                         lhs_contracting_dims={1},
+                         rhs_contracting_dims={0}
+    zero1 = f32[$batch,256] broadcast(zero), dimensions={}
+    relu1 = f32[$batch,256] maximum(h1, zero1)
+
+    logit = f32[$batch,1] dot(relu1, w2),
+                          lhs_contracting_dims={1},
+                          rhs_contracting_dims={0}
+    ROOT prob = f32[$batch,1] logistic(logit)
+  }
+)";
+
+// Sort-heavy graph: row-wise argsort of 4096 scores, followed by selecting the
+// 128 best candidates and sorting them back into their original order.
+static constexpr absl::string_view kSortHeavy = R"(
+  HloModule sort_heavy
+
+  compare_scores {
+    p0 = f32[] parameter(0)
+    p1 = f32[] parameter(1)
+    p2 = s32[] parameter(2)
+    p3 = s32[] parameter(3)
+    ROOT gt = pred[] compare(p0, p1), direction=GT
+  }
+
+  compare_indices {
+    p0 = s32[] parameter(0)
+    p1 = s32[] parameter(1)
+    p2 = f32[] parameter(2)
+    p3 = f32[] parameter(3)
+    ROOT lt = pred[] compare(p0, p1), direction=LT
+  }
+
+  ENTRY e {
+    x = f32[$batch,4096] parameter(0)
+    iota = s32[$batch,4096] iota(), iota_dimension=1
+
+    sorted = (f32[$batch,4096], s32[$batch,4096]) sort(x, iota),
+             dimensions={1}, to_apply=compare_scores
+    keys = f32[$batch,4096] get-tuple-element(sorted), index=0
+    idx = s32[$batch,4096] get-tuple-element(sorted), index=1
+
+    top_keys = f32[$batch,128] slice(keys), slice={[0:$batch], [0:128]}
+    top_idx = s32[$batch,128] slice(idx), slice={[0:$batch], [0:128]}
+
+    ROOT resorted = (s32[$batch,128], f32[$batch,128]) sort(top_idx, top_keys),
+                    dimensions={1}, to_apply=compare_indices
+  }
+)";
+
+// Runs the model with fake arguments and reports the number of processed
+// examples, so that the throughput is available in the benchmark output.
+static void RunModelBenchmark(benchmark::State& state, absl::string_view hlo,
+                              const HloBenchmarkOptions& options) {
+  int64_t batch = state.range(0);
+  CHECK_OK(RunHloBenchmark(state, hlo, /*args=*/{},
+                           {{"$batch", absl::StrCat(batch)}}, options));
+  state.SetItemsProcessed(state.iterations() * batch);
+}
+
+static void CompileModelBenchmark(benchmark::State& state,
+                                  absl::string_view hlo,
+                                  const HloBenchmarkOptions& options) {
+  int64_t batch = state.range(0);
+  CHECK_OK(CompileHloBenchmark(state, hlo, {{"$batch", absl::StrCat(batch)}},
+                               options));
+}
+
+static void BM_TransformerEncoder(benchmark::State& state,
+                                  HloBenchmarkOptions options) {
+  RunModelBenchmark(state, kTransformerEncoder, options);
+}
+
+static void BM_TransformerEncoderCompile(benchmark::State& state,
+                                         HloBenchmarkOptions options) {
+  CompileModelBenchmark(state, kTransformerEncoder, options);
+}
+
+static void BM_ConvNet(benchmark::State& state, HloBenchmarkOptions options) {
+  RunModelBenchmark(state, kConvNet, options);
+}
+
+static void BM_ConvNetCompile(benchmark::State& state,
+                              HloBenchmarkOptions options) {
+  CompileModelBenchmark(state, kConvNet, options);
+}
+
+static void BM_Recommender(benchmark::State& state,
+                           HloBenchmarkOptions options) {
+  RunModelBenchmark(state, kRecommender, options);
+}
+
+static void BM_RecommenderCompile(benchmark::State& state,
+                                  HloBenchmarkOptions options) {
+  CompileModelBenchmark(state, kRecommender, options);
+}
+
+static void BM_SortHeavy(benchmark::State& state, HloBenchmarkOptions options) {
+  RunModelBenchmark(state, kSortHeavy, options);
+}
+
+static void BM_SortHeavyCompile(benchmark::State& state,
+                                HloBenchmarkOptions options) {
+  CompileModelBenchmark(state, kSortHeavy, options);
+}
+
+// Compile time does not depend much on the batch size, and we benchmark it
+// only for the smallest batch.
+#define BENCHMARK_MODEL(name, ...) \
+  XLA_CPU_BENCHMARK(name)          \
+      ->MeasureProcessCPUTime()    \
+      ->BatchSizes({__VA_ARGS__}); \
+  XLA_CPU_BENCHMARK(name##Compile) \
+      ->MeasureProcessCPUTime()    \
+      ->BatchSizes({1})
+
+BENCHMARK_MODEL(BM_TransformerEncoder, 1, 8, 32);
+BENCHMARK_MODEL(BM_ConvNet, 1, 8, 32, 128);
+BENCHMARK_MODEL(BM_Recommender, 1, 32, 256, 1024);
+BENCHMARK_MODEL(BM_SortHeavy, 1, 8, 32, 128);
+
+}  // namespace xla::cpu
@@ -116,6 +116,16 @@ class MultiBenchmarkConfig {
     return Ranges(ranges);
   }
 
+  // Registers benchmark arguments for the given batch sizes. Benchmarks are
+  // expected to read the batch size from `state.range(0)`.
+  MultiBenchmarkConfig* BatchSizes(const std::vector<int64_t>& batch_sizes) {
+    ArgName("batch");
+    for (int64_t batch_size : batch_sizes) {
+      Arg(batch_size);
+    }
+    return this;
+  }
+
   MultiBenchmarkConfig* Apply(
       void (*func)(benchmark::internal::Benchmark* benchmark)) {
     for (auto b : benchmarks_) {
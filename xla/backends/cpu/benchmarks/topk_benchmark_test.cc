@@ -99,7 +99,9 @@ static void BM_TopK_BF16(benchmark::State& state, HloBenchmarkOptions options) {
       ->Args({16, 64, 16})                 \
       ->Args({64, 4, 64})                  \
       ->Args({64, 16, 64})                 \
-      ->Args({64, 64, 64})
+      ->Args({64, 64, 64})                 \
+      ->Args({16, 64, 32768})              \
+      ->Args({4096, 64, 32768})
 
 BENCHMARK_TOPK(BM_TopKCustomCall_F32);
 BENCHMARK_TOPK(BM_TopK_BF16);
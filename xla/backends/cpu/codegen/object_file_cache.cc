@@ -0,0 +1,112 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/codegen/object_file_cache.h"
+
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/string_view.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Target/TargetMachine.h"
+#include "xla/backends/cpu/codegen/ir_compiler.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/errors.h"
+#include "tsl/platform/fingerprint.h"
+#include "tsl/platform/path.h"
+
+namespace xla::cpu {
+
+ObjectFileCache::ObjectFileCache(std::string cache_dir)
+    : cache_dir_(std::move(cache_dir)) {}
+
+std::string ObjectFileCache::CompilerFingerprint(
+    const llvm::TargetMachine& target_machine,
+    const IrCompiler::Options& options) {
+  std::string fast_math_flags;
+  llvm::raw_string_ostream os(fast_math_flags);
+  options.fast_math_flags.print(os);
+
+  std::string max_cpu_feature =
+      options.max_cpu_feature.has_value()
+          ? absl::StrCat(static_cast<int>(*options.max_cpu_feature))
+          : "none";
+
+  return absl::StrCat(
+      target_machine.getTargetTriple().str(), ";",
+      target_machine.getTargetCPU().str(), ";",
+      target_machine.getTargetFeatureString().str(), ";",
+      static_cast<int>(options.opt_level), ";", options.optimize_for_size, ";",
+      max_cpu_feature, ";", fast_math_flags, ";",
+      options.disable_expensive_passes, ";", options.disable_slp_vectorizer,
+      ";", options.disable_loop_unrolling, ";", options.dfsan_enabled);
+}
+
+std::string ObjectFileCache::Key(absl::string_view bitcode,
+                                 absl::string_view compiler_fingerprint) {
+  tsl::Fprint128 fingerprint = tsl::FingerprintCat128(
+      tsl::Fingerprint128(bitcode), tsl::Fingerprint128(compiler_fingerprint));
+  return absl::StrFormat("%016x%016x", fingerprint.high64, fingerprint.low64);
+}
+
+std::string ObjectFileCache::ObjectFilePath(absl::string_view key) const {
+  return tsl::io::JoinPath(cache_dir_, absl::StrCat(key, ".o"));
+}
+
+std::optional<std::string> ObjectFileCache::Lookup(
+    absl::string_view key) const {
+  tsl::Env* env = tsl::Env::Default();
+  std::string path = ObjectFilePath(key);
+  if (!env->FileExists(path).ok()) return std::nullopt;
+
+  std::string obj_file;
+  if (absl::Status status = tsl::ReadFileToString(env, path, &obj_file);
+      !status.ok()) {
+    LOG(WARNING) << "Failed to read cached object file " << path << ": "
+                 << status;
+    return std::nullopt;
+  }
+
+  VLOG(3) << "Loaded cached object file " << path;
+  return obj_file;
+}
+
+absl::Status ObjectFileCache::Insert(absl::string_view key,
+                                     absl::string_view obj_file) const {
+  tsl::Env* env = tsl::Env::Default();
+  TF_RETURN_IF_ERROR(env->RecursivelyCreateDir(cache_dir_));
+
+  // Write object file to a unique temporary file and rename it to the final
+  // path, so that concurrent readers never observe partially written files.
+  std::string path = ObjectFilePath(key);
+  std::string tmp_path = absl::StrCat(path, ".tmp-");
+  if (!env->CreateUniqueFileName(&tmp_path, "")) {
+    return absl::InternalError(
+        absl::StrCat("Failed to create a temporary file name for ", path));
+  }
+
+  TF_RETURN_IF_ERROR(tsl::WriteStringToFile(env, tmp_path, obj_file));
+  TF_RETURN_IF_ERROR(env->RenameFile(tmp_path, path));
+
+  VLOG(3) << "Inserted object file " << path << " into the cache";
+  return absl::OkStatus();
+}
+
+}  // namespace xla::cpu
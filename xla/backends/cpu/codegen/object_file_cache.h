@@ -0,0 +1,69 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_BACKENDS_CPU_CODEGEN_OBJECT_FILE_CACHE_H_
+#define XLA_BACKENDS_CPU_CODEGEN_OBJECT_FILE_CACHE_H_
+
+#include <optional>
+#include <string>
+
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "llvm/Target/TargetMachine.h"
+#include "xla/backends/cpu/codegen/ir_compiler.h"
+
+namespace xla::cpu {
+
+// A persistent on-disk cache of object files compiled from LLVM modules.
+//
+// Cache is content-addressed: object files are keyed by the fingerprint of the
+// LLVM module bitcode and the fingerprint of the compiler configuration (target
+// triple, CPU, target features and compiler options). Object files are stored
+// as individual files in the cache directory, and can be shared by multiple
+// processes concurrently: new entries are written to a temporary file first
+// and then atomically renamed to the final name.
+class ObjectFileCache {
+ public:
+  explicit ObjectFileCache(std::string cache_dir);
+
+  // Returns a fingerprint of the compiler configuration that affects the
+  // machine code generated from LLVM modules.
+  static std::string CompilerFingerprint(
+      const llvm::TargetMachine& target_machine,
+      const IrCompiler::Options& options);
+
+  // Returns a cache key for an LLVM module serialized to `bitcode` and
+  // compiled with the compiler configuration with `compiler_fingerprint`.
+  static std::string Key(absl::string_view bitcode,
+                         absl::string_view compiler_fingerprint);
+
+  // Returns the cached object file for the `key`, or std::nullopt if it is not
+  // in the cache or can't be read.
+  std::optional<std::string> Lookup(absl::string_view key) const;
+
+  // Inserts the object file for the `key` into the cache.
+  absl::Status Insert(absl::string_view key, absl::string_view obj_file) const;
+
+  const std::string& cache_dir() const { return cache_dir_; }
+
+ private:
+  std::string ObjectFilePath(absl::string_view key) const;
+
+  std::string cache_dir_;
+};
+
+}  // namespace xla::cpu
+
+#endif  // XLA_BACKENDS_CPU_CODEGEN_OBJECT_FILE_CACHE_H_
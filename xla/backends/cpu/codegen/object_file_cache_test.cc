@@ -0,0 +1,57 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/codegen/object_file_cache.h"
+
+#include <optional>
+#include <string>
+
+#include <gtest/gtest.h>
+#include "xla/tsl/lib/core/status_test_util.h"
+#include "tsl/platform/path.h"
+#include "tsl/platform/test.h"
+
+namespace xla::cpu {
+namespace {
+
+TEST(ObjectFileCacheTest, Key) {
+  std::string key = ObjectFileCache::Key("bitcode", "compiler");
+  EXPECT_EQ(key, ObjectFileCache::Key("bitcode", "compiler"));
+  EXPECT_EQ(key.size(), 32);
+
+  EXPECT_NE(key, ObjectFileCache::Key("other_bitcode", "compiler"));
+  EXPECT_NE(key, ObjectFileCache::Key("bitcode", "other_compiler"));
+}
+
+TEST(ObjectFileCacheTest, InsertAndLookup) {
+  ObjectFileCache cache(
+      tsl::io::JoinPath(tsl::testing::TmpDir(), "object_file_cache_test"));
+
+  std::string key = ObjectFileCache::Key("bitcode", "compiler");
+  EXPECT_EQ(cache.Lookup(key), std::nullopt);
+
+  TF_ASSERT_OK(cache.Insert(key, "object_file"));
+  EXPECT_EQ(cache.Lookup(key), "object_file");
+
+  // Inserting the same key again overwrites the cached object file.
+  TF_ASSERT_OK(cache.Insert(key, "new_object_file"));
+  EXPECT_EQ(cache.Lookup(key), "new_object_file");
+
+  EXPECT_EQ(cache.Lookup(ObjectFileCache::Key("bitcode", "other_compiler")),
+            std::nullopt);
+}
+
+}  // namespace
+}  // namespace xla::cpu
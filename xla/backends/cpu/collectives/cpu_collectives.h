@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef XLA_BACKENDS_CPU_COLLECTIVES_CPU_COLLECTIVES_H_
 #define XLA_BACKENDS_CPU_COLLECTIVES_CPU_COLLECTIVES_H_
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <vector>
@@ -44,6 +45,20 @@ class CpuCollectives : public Collectives {
     Device() = default;
   };
 
+  // Options for selecting collective algorithms in implementations that
+  // support more than one algorithm (i.e. Gloo). Algorithms are selected based
+  // on the message size in bytes.
+  struct AlgorithmOptions {
+    // All-reduce messages up to this size use the BCube algorithm, which
+    // completes in a logarithmic number of latency-bound steps.
+    size_t tree_max_bytes = 64 * 1024;
+
+    // All-reduce messages up to this size use the halving-doubling algorithm,
+    // larger messages use the bandwidth-optimal chunked ring algorithm, which
+    // pipelines transfers of one chunk with the reduction of another.
+    size_t halving_doubling_max_bytes = 4 * 1024 * 1024;
+  };
+
   // Executor allows CPU collectives clients to pass additional information to
   // the collectives implementation.
   class Executor : public Communicator::Executor {
@@ -76,6 +91,18 @@ class CpuCollectives : public Collectives {
   // Tries to cast a Communicator::Executor to a CpuCollectives::Executor.
   static absl::StatusOr<const Executor*> TryCast(
       const Communicator::Executor* executor);
+
+  const AlgorithmOptions& algorithm_options() const {
+    return algorithm_options_;
+  }
+
+  // Updates algorithm options for communicators created after this call.
+  void set_algorithm_options(const AlgorithmOptions& algorithm_options) {
+    algorithm_options_ = algorithm_options;
+  }
+
+ private:
+  AlgorithmOptions algorithm_options_;
 };
 
 }  // namespace xla::cpu
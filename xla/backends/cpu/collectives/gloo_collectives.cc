@@ -77,7 +77,8 @@ GlooCollectives::CreateCommunicators(const CliqueKey& clique_key,
     }
 
     communicators.push_back(std::make_unique<GlooCommunicator>(
-        std::move(gloo_context), rank, clique_key.num_devices()));
+        std::move(gloo_context), rank, clique_key.num_devices(),
+        algorithm_options()));
   }
 
   return communicators;
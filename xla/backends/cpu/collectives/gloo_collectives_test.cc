@@ -65,7 +65,8 @@ constexpr absl::Duration kTimeout = absl::Seconds(5);
 
 absl::StatusOr<std::unique_ptr<Communicator>> GetCommunicator(
     size_t kNumParticipants, absl::Span<GlobalDeviceId const> global_devices,
-    const std::shared_ptr<xla::KeyValueStoreInterface>& kv_store, int rank) {
+    const std::shared_ptr<xla::KeyValueStoreInterface>& kv_store, int rank,
+    const CpuCollectives::AlgorithmOptions& algorithm_options) {
   auto collectives = std::make_shared<cpu::GlooCollectives>(
       std::make_unique<cpu::GlooKeyValueStore>(kv_store),
 #if defined(__linux__)
@@ -73,6 +74,7 @@ absl::StatusOr<std::unique_ptr<Communicator>> GetCommunicator(
 #elif defined(__APPLE__)
       gloo::transport::uv::CreateDevice(gloo::transport::uv::attr()));
 #endif  // defined(__linux__)
+  collectives->set_algorithm_options(algorithm_options);
 
   CpuCliqueKey clique_key(global_devices);
   CpuCollectives::DeviceRank device_rank(nullptr, RankId(rank));
@@ -102,12 +104,14 @@ static se::DeviceMemoryBase AsDeviceMemory(const std::vector<T>& data) {
 absl::StatusOr<std::vector<uint8_t>> AllReduce(
     const std::shared_ptr<xla::KeyValueStoreInterface>& kv_store,
     const std::vector<uint8_t>& input_buffer,
-    std::vector<GlobalDeviceId> global_devices, int rank) {
+    std::vector<GlobalDeviceId> global_devices, int rank,
+    const CpuCollectives::AlgorithmOptions& algorithm_options) {
   std::vector<uint8_t> output_buffer(kBufferSize);
   RendezvousKey rendezvous_key = MakeRendezvousKey(global_devices);
   TF_ASSIGN_OR_RETURN(
       auto communicator,
-      GetCommunicator(kNumParticipants, global_devices, kv_store, rank));
+      GetCommunicator(kNumParticipants, global_devices, kv_store, rank,
+                      algorithm_options));
 
   CpuCollectives::Executor executor(rendezvous_key, kTimeout);
   TF_RETURN_IF_ERROR(communicator->AllReduce(
@@ -117,7 +121,9 @@ absl::StatusOr<std::vector<uint8_t>> AllReduce(
   return output_buffer;
 }
 
-TEST(GlooCollectives, AllReduce) {
+// Runs all-reduce with the given algorithm options and checks the result.
+static void RunAllReduce(
+    const CpuCollectives::AlgorithmOptions& algorithm_options) {
   std::vector<GlobalDeviceId> global_devices;
   global_devices.reserve(kNumParticipants);
   for (int rank = 0; rank < kNumParticipants; ++rank) {
@@ -136,10 +142,12 @@ TEST(GlooCollectives, AllReduce) {
         tsl::Env::Default(), "AllReduceParticipants", kNumParticipants);
     for (int rank = 0; rank < kNumParticipants; ++rank) {
       thread_pool.Schedule(
-          [rank, &output_buffers, &kv_store, &global_devices]() {
+          [rank, &output_buffers, &kv_store, &global_devices,
+           &algorithm_options]() {
             std::vector<uint8_t> input_buffer(kBufferSize, rank + 1);
             output_buffers[rank] =
-                AllReduce(kv_store, input_buffer, global_devices, rank);
+                AllReduce(kv_store, input_buffer, global_devices, rank,
+                          algorithm_options);
           });
     }
   }
@@ -155,5 +163,17 @@ TEST(GlooCollectives, AllReduce) {
                 Each(Eq(kNumParticipants * (kNumParticipants + 1) / 2)));
   }
 }
+
+TEST(GlooCollectives, AllReduce) { RunAllReduce({}); }
+
+TEST(GlooCollectives, AllReduceHalvingDoubling) {
+  RunAllReduce({/*tree_max_bytes=*/0,
+                /*halving_doubling_max_bytes=*/kBufferSize});
+}
+
+TEST(GlooCollectives, AllReduceRingChunked) {
+  RunAllReduce({/*tree_max_bytes=*/0, /*halving_doubling_max_bytes=*/0});
+}
+
 }  // namespace
 }  // namespace xla::cpu
@@ -27,6 +27,7 @@ limitations under the License.
 
 #include "absl/log/log.h"
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
 #include "absl/time/clock.h"
 #include "absl/time/time.h"
@@ -34,6 +35,8 @@ limitations under the License.
 #include "gloo/algorithm.h"
 #include "gloo/allgather.h"
 #include "gloo/allreduce.h"
+#include "gloo/allreduce_halving_doubling.h"
+#include "gloo/allreduce_ring_chunked.h"
 #include "gloo/context.h"
 #include "gloo/math.h"
 #include "gloo/reduce_scatter.h"
@@ -53,9 +56,13 @@ limitations under the License.
 
 namespace xla::cpu {
 
-GlooCommunicator::GlooCommunicator(std::shared_ptr<gloo::Context> context,
-                                   size_t rank, size_t num_ranks)
-    : context_(std::move(context)), rank_(rank), num_ranks_(num_ranks) {}
+GlooCommunicator::GlooCommunicator(
+    std::shared_ptr<gloo::Context> context, size_t rank, size_t num_ranks,
+    CpuCollectives::AlgorithmOptions algorithm_options)
+    : context_(std::move(context)),
+      rank_(rank),
+      num_ranks_(num_ranks),
+      algorithm_options_(algorithm_options) {}
 
 GlooCommunicator::~GlooCommunicator() = default;
 
@@ -101,6 +108,92 @@ static absl::Status SetAllReduceOptions(ReductionKind reduction_kind,
   return absl::OkStatus();
 }
 
+// Returns a Gloo reduction function for the legacy (class-based) algorithms.
+template <typename T>
+static absl::StatusOr<const gloo::ReductionFunction<T>*> GetReductionFunction(
+    ReductionKind reduction_kind) {
+  switch (reduction_kind) {
+    case ReductionKind::SUM:
+      return gloo::ReductionFunction<T>::sum;
+    case ReductionKind::PRODUCT:
+      return gloo::ReductionFunction<T>::product;
+    case ReductionKind::MAX:
+      if constexpr (!is_complex_v<T>) {
+        return gloo::ReductionFunction<T>::max;
+      }
+      break;
+    case ReductionKind::MIN:
+      if constexpr (!is_complex_v<T>) {
+        return gloo::ReductionFunction<T>::min;
+      }
+      break;
+  }
+  return absl::InvalidArgumentError(absl::StrCat(
+      "Unsupported reduction kind: ", static_cast<int>(reduction_kind)));
+}
+
+// Runs all-reduce with an algorithm selected based on the message size:
+//
+// - small messages use BCube, which is latency-bound and completes in a
+//   logarithmic number of steps;
+// - medium messages use halving-doubling, which balances latency and
+//   bandwidth;
+// - large messages use the chunked ring, which is bandwidth-optimal and
+//   overlaps transfers of one chunk with the reduction of another.
+template <typename T>
+static absl::Status AllReduceHelper(
+    const std::shared_ptr<gloo::Context>& context,
+    const CpuCollectives::AlgorithmOptions& algorithm_options,
+    ReductionKind reduction_kind, se::DeviceMemoryBase input_buffer,
+    se::DeviceMemoryBase output_buffer, size_t num_elements,
+    absl::Duration timeout) {
+  size_t num_bytes = num_elements * sizeof(T);
+
+  if (num_bytes <= algorithm_options.tree_max_bytes) {
+    gloo::AllreduceOptions options(context);
+    // TODO(phawkins): how to do tags?
+    // options.setTag(tag);
+    TF_RETURN_IF_ERROR(SetAllReduceOptions<T>(
+        reduction_kind, input_buffer, output_buffer, num_elements, options));
+    options.setAlgorithm(gloo::AllreduceOptions::Algorithm::BCUBE);
+    options.setTimeout(absl::ToChronoMilliseconds(timeout));
+
+    try {
+      gloo::allreduce(options);
+    } catch (std::exception& e) {
+      return absl::UnknownError(
+          absl::StrCat("Gloo all-reduce failed: ", e.what()));
+    }
+    return absl::OkStatus();
+  }
+
+  TF_ASSIGN_OR_RETURN(const gloo::ReductionFunction<T>* reduction_function,
+                      GetReductionFunction<T>(reduction_kind));
+
+  // Legacy algorithms reduce in place and take the timeout from the context.
+  if (output_buffer.opaque() != input_buffer.opaque()) {
+    std::memcpy(output_buffer.opaque(), input_buffer.opaque(), num_bytes);
+  }
+  context->setTimeout(absl::ToChronoMilliseconds(timeout));
+
+  std::vector<T*> ptrs = {reinterpret_cast<T*>(output_buffer.opaque())};
+  try {
+    if (num_bytes <= algorithm_options.halving_doubling_max_bytes) {
+      gloo::AllreduceHalvingDoubling<T> algorithm(context, ptrs, num_elements,
+                                                  reduction_function);
+      algorithm.run();
+    } else {
+      gloo::AllreduceRingChunked<T> algorithm(context, ptrs, num_elements,
+                                              reduction_function);
+      algorithm.run();
+    }
+  } catch (std::exception& e) {
+    return absl::UnknownError(
+        absl::StrCat("Gloo all-reduce failed: ", e.what()));
+  }
+  return absl::OkStatus();
+}
+
 absl::Status GlooCommunicator::AllReduce(se::DeviceMemoryBase send_buffer,
                                          se::DeviceMemoryBase recv_buffer,
                                          PrimitiveType dtype, size_t count,
@@ -108,79 +201,82 @@ absl::Status GlooCommunicator::AllReduce(se::DeviceMemoryBase send_buffer,
                                          const Executor& executor) {
   TF_ASSIGN_OR_RETURN(auto cpu_executor, CpuCollectives::TryCast(&executor));
 
-  gloo::AllreduceOptions options(context_);
-  // TODO(phawkins): how to do tags?
-  // options.setTag(tag);
+  absl::Duration timeout = cpu_executor->timeout();
   switch (dtype) {
     case S8:
-      TF_RETURN_IF_ERROR(SetAllReduceOptions<int8_t>(
-          reduction_kind, send_buffer, recv_buffer, count, options));
+      TF_RETURN_IF_ERROR(AllReduceHelper<int8_t>(
+          context_, algorithm_options_, reduction_kind, send_buffer,
+          recv_buffer, count, timeout));
       break;
     case PRED:
     case U8:
-      TF_RETURN_IF_ERROR(SetAllReduceOptions<uint8_t>(
-          reduction_kind, send_buffer, recv_buffer, count, options));
+      TF_RETURN_IF_ERROR(AllReduceHelper<uint8_t>(
+          context_, algorithm_options_, reduction_kind, send_buffer,
+          recv_buffer, count, timeout));
       break;
     case S16:
-      TF_RETURN_IF_ERROR(SetAllReduceOptions<int16_t>(
-          reduction_kind, send_buffer, recv_buffer, count, options));
+      TF_RETURN_IF_ERROR(AllReduceHelper<int16_t>(
+          context_, algorithm_options_, reduction_kind, send_buffer,
+          recv_buffer, count, timeout));
       break;
     case U16:
-      TF_RETURN_IF_ERROR(SetAllReduceOptions<uint16_t>(
-          reduction_kind, send_buffer, recv_buffer, count, options));
+      TF_RETURN_IF_ERROR(AllReduceHelper<uint16_t>(
+          context_, algorithm_options_, reduction_kind, send_buffer,
+          recv_buffer, count, timeout));
       break;
     case S32:
-      TF_RETURN_IF_ERROR(SetAllReduceOptions<int32_t>(
-          reduction_kind, send_buffer, recv_buffer, count, options));
+      TF_RETURN_IF_ERROR(AllReduceHelper<int32_t>(
+          context_, algorithm_options_, reduction_kind, send_buffer,
+          recv_buffer, count, timeout));
       break;
     case U32:
-      TF_RETURN_IF_ERROR(SetAllReduceOptions<uint32_t>(
-          reduction_kind, send_buffer, recv_buffer, count, options));
+      TF_RETURN_IF_ERROR(AllReduceHelper<uint32_t>(
+          context_, algorithm_options_, reduction_kind, send_buffer,
+          recv_buffer, count, timeout));
       break;
     case S64:
-      TF_RETURN_IF_ERROR(SetAllReduceOptions<int64_t>(
-          reduction_kind, send_buffer, recv_buffer, count, options));
+      TF_RETURN_IF_ERROR(AllReduceHelper<int64_t>(
+          context_, algorithm_options_, reduction_kind, send_buffer,
+          recv_buffer, count, timeout));
       break;
     case U64:
-      TF_RETURN_IF_ERROR(SetAllReduceOptions<uint64_t>(
-          reduction_kind, send_buffer, recv_buffer, count, options));
+      TF_RETURN_IF_ERROR(AllReduceHelper<uint64_t>(
+          context_, algorithm_options_, reduction_kind, send_buffer,
+          recv_buffer, count, timeout));
       break;
     case F16:
-      TF_RETURN_IF_ERROR(SetAllReduceOptions<gloo::float16>(
-          reduction_kind, send_buffer, recv_buffer, count, options));
+      TF_RETURN_IF_ERROR(AllReduceHelper<gloo::float16>(
+          context_, algorithm_options_, reduction_kind, send_buffer,
+          recv_buffer, count, timeout));
       break;
     case BF16:
-      TF_RETURN_IF_ERROR(SetAllReduceOptions<bfloat16>(
-          reduction_kind, send_buffer, recv_buffer, count, options));
+      TF_RETURN_IF_ERROR(AllReduceHelper<bfloat16>(
+          context_, algorithm_options_, reduction_kind, send_buffer,
+          recv_buffer, count, timeout));
       break;
     case F32:
-      TF_RETURN_IF_ERROR(SetAllReduceOptions<float>(
-          reduction_kind, send_buffer, recv_buffer, count, options));
+      TF_RETURN_IF_ERROR(AllReduceHelper<float>(
+          context_, algorithm_options_, reduction_kind, send_buffer,
+          recv_buffer, count, timeout));
       break;
     case F64:
-      TF_RETURN_IF_ERROR(SetAllReduceOptions<double>(
-          reduction_kind, send_buffer, recv_buffer, count, options));
+      TF_RETURN_IF_ERROR(AllReduceHelper<double>(
+          context_, algorithm_options_, reduction_kind, send_buffer,
+          recv_buffer, count, timeout));
       break;
     case C64:
-      TF_RETURN_IF_ERROR(SetAllReduceOptions<std::complex<float>>(
-          reduction_kind, send_buffer, recv_buffer, count, options));
+      TF_RETURN_IF_ERROR(AllReduceHelper<std::complex<float>>(
+          context_, algorithm_options_, reduction_kind, send_buffer,
+          recv_buffer, count, timeout));
       break;
     case C128:
-      TF_RETURN_IF_ERROR(SetAllReduceOptions<std::complex<double>>(
-          reduction_kind, send_buffer, recv_buffer, count, options));
+      TF_RETURN_IF_ERROR(AllReduceHelper<std::complex<double>>(
+          context_, algorithm_options_, reduction_kind, send_buffer,
+          recv_buffer, count, timeout));
       break;
     default:
       return absl::InvalidArgumentError("Unknown datatype in allreduce");
   }
-  options.setAlgorithm(gloo::AllreduceOptions::Algorithm::RING);
-  options.setTimeout(absl::ToChronoMilliseconds(cpu_executor->timeout()));
-
-  try {
-    gloo::allreduce(options);
-  } catch (std::exception& e) {
-    return absl::UnknownError(
-        absl::StrCat("Gloo all-reduce failed: ", e.what()));
-  }
   return absl::OkStatus();
 }
 
@@ -322,38 +418,8 @@ template <typename T>
 absl::Status ReduceScatterHelper(std::shared_ptr<gloo::Context> context,
                                  ReductionKind reduction_kind, void* buffer,
                                  size_t chunk_elems) {
-  const gloo::ReductionFunction<T>* reduction_function = nullptr;
-  if constexpr (is_complex_v<T>) {
-    switch (reduction_kind) {
-      case ReductionKind::SUM:
-        reduction_function = gloo::ReductionFunction<T>::sum;
-        break;
-      case ReductionKind::PRODUCT:
-        reduction_function = gloo::ReductionFunction<T>::product;
-        break;
-      default:
-        return absl::InvalidArgumentError(absl::StrCat(
-            "Unsupported reduction kind: ", static_cast<int>(reduction_kind)));
-    }
-  } else {
-    switch (reduction_kind) {
-      case ReductionKind::SUM:
-        reduction_function = gloo::ReductionFunction<T>::sum;
-        break;
-      case ReductionKind::PRODUCT:
-        reduction_function = gloo::ReductionFunction<T>::product;
-        break;
-      case ReductionKind::MAX:
-        reduction_function = gloo::ReductionFunction<T>::max;
-        break;
-      case ReductionKind::MIN:
-        reduction_function = gloo::ReductionFunction<T>::min;
-        break;
-      default:
-        return absl::InvalidArgumentError(absl::StrCat(
-            "Unsupported reduction kind: ", static_cast<int>(reduction_kind)));
-    }
-  }
+  TF_ASSIGN_OR_RETURN(const gloo::ReductionFunction<T>* reduction_function,
+                      GetReductionFunction<T>(reduction_kind));
   try {
     std::vector<int> recv_elems(context->size, chunk_elems);
     gloo::ReduceScatterHalvingDoubling<T> algorithm(
@@ -26,6 +26,7 @@ limitations under the License.
 #include "absl/strings/str_cat.h"
 #include "absl/types/span.h"
 #include "gloo/context.h"
+#include "xla/backends/cpu/collectives/cpu_collectives.h"
 #include "xla/core/collectives/communicator.h"
 #include "xla/core/collectives/rank_id.h"
 #include "xla/service/collective_ops_utils.h"
@@ -39,7 +40,8 @@ namespace xla::cpu {
 class GlooCommunicator : public Communicator {
  public:
   GlooCommunicator(std::shared_ptr<gloo::Context> context, size_t rank,
-                   size_t num_ranks);
+                   size_t num_ranks,
+                   CpuCollectives::AlgorithmOptions algorithm_options = {});
   ~GlooCommunicator() override;
 
   absl::Status AllReduce(se::DeviceMemoryBase send_buffer,
@@ -96,6 +98,7 @@ class GlooCommunicator : public Communicator {
   std::shared_ptr<gloo::Context> context_;
   size_t rank_;
   size_t num_ranks_;
+  CpuCollectives::AlgorithmOptions algorithm_options_;
 };
 
 }  // namespace xla::cpu
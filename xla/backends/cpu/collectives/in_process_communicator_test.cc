@@ -0,0 +1,115 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/collectives/in_process_communicator.h"
+
+#include <cstddef>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/time/time.h"
+#include "xla/backends/cpu/collectives/cpu_collectives.h"
+#include "xla/service/collective_ops_utils.h"
+#include "xla/service/global_device_id.h"
+#include "xla/stream_executor/device_memory.h"
+#include "xla/tsl/lib/core/status_test_util.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/test.h"
+#include "xla/tsl/platform/threadpool.h"
+#include "xla/xla_data.pb.h"
+
+namespace xla::cpu {
+namespace {
+
+using ::testing::Each;
+using ::testing::Eq;
+
+constexpr size_t kNumParticipants = 4;
+constexpr absl::Duration kTimeout = absl::Seconds(5);
+
+// Large enough to span multiple reduction blocks per participant chunk.
+constexpr size_t kNumElements = 3 * 4096 * kNumParticipants + 7;
+
+RendezvousKey MakeRendezvousKey() {
+  std::vector<GlobalDeviceId> global_devices;
+  for (size_t rank = 0; rank < kNumParticipants; ++rank) {
+    global_devices.push_back(GlobalDeviceId(rank));
+  }
+  return RendezvousKey(RunId(0), global_devices, kNumParticipants,
+                       RendezvousKey::CollectiveOpKind::kCrossModule,
+                       /*op_id=*/0);
+}
+
+template <typename T>
+static se::DeviceMemoryBase AsDeviceMemory(std::vector<T>& data) {
+  return se::DeviceMemoryBase(data.data(), data.size() * sizeof(T));
+}
+
+// Runs all-reduce with each participant in a separate thread. If `in_place` is
+// true, participants use the same buffer for the source and destination.
+void RunAllReduce(ReductionKind reduction_kind, bool in_place,
+                  std::vector<std::vector<float>>& src,
+                  std::vector<std::vector<float>>& dest) {
+  RendezvousKey rendezvous_key = MakeRendezvousKey();
+  std::vector<absl::Status> statuses(kNumParticipants);
+
+  {
+    tsl::thread::ThreadPool thread_pool(
+        tsl::Env::Default(), "AllReduceParticipants", kNumParticipants);
+    for (size_t rank = 0; rank < kNumParticipants; ++rank) {
+      thread_pool.Schedule([&, rank] {
+        InProcessCommunicator communicator(rank, kNumParticipants);
+        CpuCollectives::Executor executor(rendezvous_key, kTimeout);
+        std::vector<float>& out = in_place ? src[rank] : dest[rank];
+        statuses[rank] = communicator.AllReduce(
+            AsDeviceMemory(src[rank]), AsDeviceMemory(out), F32, kNumElements,
+            reduction_kind, executor);
+      });
+    }
+  }
+
+  for (const absl::Status& status : statuses) TF_ASSERT_OK(status);
+}
+
+TEST(InProcessCommunicatorTest, AllReduceSum) {
+  std::vector<std::vector<float>> src, dest;
+  for (size_t rank = 0; rank < kNumParticipants; ++rank) {
+    src.emplace_back(kNumElements, rank + 1);
+    dest.emplace_back(kNumElements, 0.0f);
+  }
+
+  RunAllReduce(ReductionKind::SUM, /*in_place=*/false, src, dest);
+
+  for (size_t rank = 0; rank < kNumParticipants; ++rank) {
+    EXPECT_THAT(src[rank], Each(Eq(static_cast<float>(rank + 1))));
+    EXPECT_THAT(dest[rank], Each(Eq(10.0f)));
+  }
+}
+
+TEST(InProcessCommunicatorTest, AllReduceMaxInPlace) {
+  std::vector<std::vector<float>> src, dest;
+  for (size_t rank = 0; rank < kNumParticipants; ++rank) {
+    src.emplace_back(kNumElements, -static_cast<float>(rank));
+  }
+
+  RunAllReduce(ReductionKind::MAX, /*in_place=*/true, src, dest);
+
+  for (size_t rank = 0; rank < kNumParticipants; ++rank) {
+    EXPECT_THAT(src[rank], Each(Eq(0.0f)));
+  }
+}
+
+}  // namespace
+}  // namespace xla::cpu
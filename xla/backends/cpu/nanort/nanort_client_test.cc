@@ -140,6 +140,81 @@ TEST(NanoRtClientTest, CompileAndRunTupledComputation) {
   EXPECT_EQ(r1_value, 6.0f);
 }
 
+TEST(NanoRtClientTest, CompileAndRunBoundExecution) {
+  constexpr absl::string_view hlo = R"(
+    HloModule add
+
+    ENTRY e {
+      p0 = f32[] parameter(0)
+      p1 = f32[] parameter(1)
+      ROOT add = f32[] add(p0, p1)
+    }
+  )";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto module, ParseAndReturnUnverifiedModule(hlo));
+  XlaComputation computation(module->ToProto());
+
+  NanoRtClient client;
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<NanoRtExecutable> executable,
+                          client.Compile(computation));
+
+  // Storage for executable parameters and results.
+  alignas(32) float p0_value = 1.0f;
+  alignas(32) float p1_value = 2.0f;
+  alignas(32) float r0_value = 0.0f;
+
+  // Bind executable to parameters, results and temp storage.
+  Arguments arguments = {{&p0_value, 1}, {&p1_value, 1}};
+  Results results = {{&r0_value, 1}};
+  NanoRtExecutable::ManagedTemp<32> temp(executable->temp_buffer_size());
+
+  TF_ASSERT_OK_AND_ASSIGN(NanoRtExecutable::BoundExecution bound,
+                          executable->Bind(arguments, results, temp));
+
+  auto event = bound.Execute();
+  tsl::BlockUntilReady(event);
+
+  ASSERT_TRUE(event.IsConcrete());
+  EXPECT_EQ(r0_value, 3.0f);
+
+  // Update bound arguments in place and execute again.
+  p0_value = 3.0f;
+  p1_value = 4.0f;
+
+  event = bound.Execute();
+  tsl::BlockUntilReady(event);
+
+  ASSERT_TRUE(event.IsConcrete());
+  EXPECT_EQ(r0_value, 7.0f);
+}
+
+TEST(NanoRtClientTest, BindWithInvalidArguments) {
+  constexpr absl::string_view hlo = R"(
+    HloModule add
+
+    ENTRY e {
+      p0 = f32[] parameter(0)
+      p1 = f32[] parameter(1)
+      ROOT add = f32[] add(p0, p1)
+    }
+  )";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto module, ParseAndReturnUnverifiedModule(hlo));
+  XlaComputation computation(module->ToProto());
+
+  NanoRtClient client;
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<NanoRtExecutable> executable,
+                          client.Compile(computation));
+
+  alignas(32) float p0_value = 1.0f;
+  alignas(32) float r0_value = 0.0f;
+
+  Arguments arguments = {{&p0_value, 1}};
+  Results results = {{&r0_value, 1}};
+
+  EXPECT_FALSE(executable->Bind(arguments, results).ok());
+}
+
 TEST(NanoRtClientTest, CompileAndRunConstantComputation) {
   absl::string_view hlo = R"(
     HloModule cst
@@ -336,6 +411,42 @@ BENCHMARK_CAPTURE(BM_NanoRtAddScalars, no_thread_pool, std::nullopt);
 BENCHMARK_CAPTURE(BM_NanoRtAddScalars, thread_pool,
                   std::make_optional<Eigen::ThreadPool>(2));
 
+// Bound execution resolves buffers once, and in the steady state executes
+// without any heap allocations when running without a thread pool.
+static void BM_NanoRtAddScalarsBound(benchmark::State& state,
+                                     std::optional<Eigen::ThreadPool> tp) {
+  NanoRtClient client;
+
+  auto computation = CreateAddScalarsComputation();
+  auto executable = client.Compile(*computation);
+
+  // Storage for executable arguments and results.
+  alignas(32) float p0_value = 1.0f;
+  alignas(32) float p1_value = 2.0f;
+  alignas(32) float r0_value = 0.0f;
+
+  NanoRtExecutable::ExecuteOptions execute_options;
+  std::optional<Eigen::ThreadPoolDevice> device;
+  if (tp) {
+    device.emplace(&tp.value(), tp->NumThreads());
+    execute_options.set_intra_op_thread_pool(&*device);
+  }
+
+  Arguments arguments = {{&p0_value, 1}, {&p1_value, 1}};
+  Results results = {{&r0_value, 1}};
+  auto bound = (*executable)->Bind(arguments, results);
+  CHECK_OK(bound);
+
+  for (auto _ : state) {
+    auto event = bound->Execute(execute_options);
+    tsl::BlockUntilReady(event);
+  }
+}
+
+BENCHMARK_CAPTURE(BM_NanoRtAddScalarsBound, no_thread_pool, std::nullopt);
+BENCHMARK_CAPTURE(BM_NanoRtAddScalarsBound, thread_pool,
+                  std::make_optional<Eigen::ThreadPool>(2));
+
 static void BM_NanoRtFibonacci(benchmark::State& state,
                                std::optional<Eigen::ThreadPool> tp) {
   NanoRtClient client;
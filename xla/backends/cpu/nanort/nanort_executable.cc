@@ -271,14 +271,9 @@ static se::DeviceMemoryBase ToDeviceMemory(
                               temp.size());
 }
 
-tsl::AsyncValueRef<NanoRtExecutable::ExecuteEvent> NanoRtExecutable::Execute(
+absl::StatusOr<BufferAllocations::Buffers> NanoRtExecutable::ResolveBuffers(
     absl::Span<const Argument> arguments, absl::Span<const Result> results,
-    PreallocatedTemp temp, const ExecuteOptions& options) {
-  TraceMe trace([&] {
-    return TraceMeEncode("NanoRtExecutable::Execute",
-                         {{"name", executable_->module().name()}});
-  });
-
+    PreallocatedTemp temp) const {
   auto* executable = tsl::down_cast<cpu::CpuExecutable*>(executable_.get());
 
   size_t num_arguments = argument_to_allocation_index_.size();
@@ -337,6 +332,26 @@ tsl::AsyncValueRef<NanoRtExecutable::ExecuteEvent> NanoRtExecutable::Execute(
     }
   }
 
+  return buffers;
+}
+
+tsl::AsyncValueRef<NanoRtExecutable::ExecuteEvent> NanoRtExecutable::Execute(
+    absl::Span<const Argument> arguments, absl::Span<const Result> results,
+    PreallocatedTemp temp, const ExecuteOptions& options) {
+  TraceMe trace([&] {
+    return TraceMeEncode("NanoRtExecutable::Execute",
+                         {{"name", executable_->module().name()}});
+  });
+
+  auto* executable = tsl::down_cast<cpu::CpuExecutable*>(executable_.get());
+
+  absl::StatusOr<BufferAllocations::Buffers> resolved_buffers =
+      ResolveBuffers(arguments, results, temp);
+  if (ABSL_PREDICT_FALSE(!resolved_buffers.ok())) {
+    return resolved_buffers.status();
+  }
+  cpu::BufferAllocations::Buffers buffers = *std::move(resolved_buffers);
+
   struct ExecutionContext {
     ExecutionContext(cpu::BufferAllocations::Buffers buffers,
                      FunctionLibrary* function_library,
@@ -372,6 +387,51 @@ tsl::AsyncValueRef<NanoRtExecutable::ExecuteEvent> NanoRtExecutable::Execute(
   }
 }
 
+absl::StatusOr<NanoRtExecutable::BoundExecution> NanoRtExecutable::Bind(
+    absl::Span<const Argument> arguments, absl::Span<const Result> results,
+    PreallocatedTemp temp) {
+  TF_ASSIGN_OR_RETURN(BufferAllocations::Buffers buffers,
+                      ResolveBuffers(arguments, results, temp));
+  return BoundExecution(tsl::down_cast<cpu::CpuExecutable*>(executable_.get()),
+                        std::move(buffers));
+}
+
+NanoRtExecutable::BoundExecution::BoundExecution(
+    CpuExecutable* executable, BufferAllocations::Buffers buffers)
+    : executable_(executable),
+      allocations_(std::move(buffers)),
+      execute_params_{executable_->function_library(), &allocations_} {}
+
+NanoRtExecutable::BoundExecution::BoundExecution(BoundExecution&& other)
+    : executable_(other.executable_),
+      allocations_(std::move(other.allocations_)),
+      execute_params_(std::move(other.execute_params_)) {
+  execute_params_.buffer_allocations = &allocations_;
+}
+
+NanoRtExecutable::BoundExecution& NanoRtExecutable::BoundExecution::operator=(
+    BoundExecution&& other) {
+  executable_ = other.executable_;
+  allocations_ = std::move(other.allocations_);
+  execute_params_ = std::move(other.execute_params_);
+  execute_params_.buffer_allocations = &allocations_;
+  return *this;
+}
+
+tsl::AsyncValueRef<NanoRtExecutable::ExecuteEvent>
+NanoRtExecutable::BoundExecution::Execute(const ExecuteOptions& options) {
+  TraceMe trace([&] {
+    return TraceMeEncode("NanoRtExecutable::BoundExecution::Execute",
+                         {{"name", executable_->module().name()}});
+  });
+
+  // Update only the execute options, as constructing execute params from
+  // scratch allocates a new execute session.
+  execute_params_.intra_op_threadpool = options.intra_op_thread_pool();
+  execute_params_.task_runner = options.task_runner();
+  return executable_->thunks().Execute(execute_params_);
+}
+
 size_t NanoRtExecutable::temp_buffer_size() const {
   if (temp_allocation_index_.has_value()) {
     return allocation_sizes_[*temp_allocation_index_];
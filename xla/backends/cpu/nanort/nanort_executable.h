@@ -28,7 +28,10 @@ limitations under the License.
 #include "absl/status/statusor.h"
 #include "absl/types/span.h"
 #include "xla/backends/cpu/alignment.h"
+#include "xla/backends/cpu/runtime/buffer_allocations.h"
 #include "xla/backends/cpu/runtime/thread_pool_task_runner.h"
+#include "xla/backends/cpu/runtime/thunk.h"
+#include "xla/service/cpu/cpu_executable.h"
 #include "xla/service/executable.h"
 #include "xla/tsl/concurrency/async_value_ref.h"
 #include "xla/tsl/concurrency/chain.h"
@@ -143,6 +146,46 @@ class NanoRtExecutable {
     return Execute(arguments, results, temp.data(), std::move(options));
   }
 
+  // An execution of the NanoRtExecutable bound to the argument, result and
+  // temp buffers. Buffers are validated and resolved to buffer allocations
+  // once at bind time, and repeated executions in the caller thread do not
+  // allocate on the heap. It is the caller's responsibility to keep bound
+  // buffers alive, and to not start a new execution before the previous one
+  // is complete.
+  class BoundExecution {
+   public:
+    BoundExecution(BoundExecution&& other);
+    BoundExecution& operator=(BoundExecution&& other);
+
+    tsl::AsyncValueRef<ExecuteEvent> Execute(
+        const ExecuteOptions& options = {});
+
+   private:
+    friend class NanoRtExecutable;
+
+    BoundExecution(CpuExecutable* executable,
+                   BufferAllocations::Buffers buffers);
+
+    CpuExecutable* executable_;
+    BufferAllocations allocations_;
+
+    // Execute params must outlive asynchronous execution, and we construct
+    // them once to avoid heap allocating them for every execution.
+    Thunk::ExecuteParams execute_params_;
+  };
+
+  // Binds the executable to the given arguments, results and temp buffers.
+  absl::StatusOr<BoundExecution> Bind(absl::Span<const Argument> arguments,
+                                      absl::Span<const Result> results,
+                                      PreallocatedTemp temp = {});
+
+  template <size_t n>
+  absl::StatusOr<BoundExecution> Bind(absl::Span<const Argument> arguments,
+                                      absl::Span<const Result> results,
+                                      ManagedTemp<n>& temp) {
+    return Bind(arguments, results, temp.data());
+  }
+
   // Returns the size of the temp buffer required to run the executable.
   size_t temp_buffer_size() const;
 
@@ -153,6 +196,11 @@ class NanoRtExecutable {
                    std::vector<size_t> result_to_allocation_index,
                    std::optional<size_t> temp_allocation_index);
 
+  // Resolves arguments, results and temp to buffer allocations.
+  absl::StatusOr<BufferAllocations::Buffers> ResolveBuffers(
+      absl::Span<const Argument> arguments, absl::Span<const Result> results,
+      PreallocatedTemp temp) const;
+
   std::unique_ptr<Executable> executable_;
   std::vector<size_t> allocation_sizes_;
 
@@ -16,9 +16,11 @@ limitations under the License.
 #ifndef XLA_BACKENDS_CPU_RUNTIME_OBJECT_POOL_H_
 #define XLA_BACKENDS_CPU_RUNTIME_OBJECT_POOL_H_
 
+#include <array>
 #include <atomic>
 #include <cstddef>
 #include <memory>
+#include <new>
 #include <optional>
 
 #include "absl/functional/any_invocable.h"
@@ -32,6 +34,13 @@ namespace xla::cpu {
 //
 // This object pool is intended to be used on a critical path and optimized for
 // zero-allocation in steady state.
+//
+// In addition to the shared lock-free stack of objects, the pool has a small
+// set of per-thread cache slots each holding at most one object. Threads
+// borrow and return objects via their own cache slot, which avoids contended
+// CAS operations on the shared stack head when many threads concurrently
+// borrow objects from the same pool. Returned objects overflow to the shared
+// stack only when the thread cache slot is already occupied.
 template <typename T, typename... Args>
 class ObjectPool {
   struct Entry {
@@ -41,6 +50,23 @@ class ObjectPool {
     std::atomic<Entry*> next;
   };
 
+  // Align cache slots to a cache line boundary to avoid false sharing between
+  // threads using different slots.
+  static constexpr size_t kCacheSlotAlignment =
+#if defined(__cpp_lib_hardware_interference_size)
+      std::hardware_destructive_interference_size;
+#else
+      64;
+#endif
+
+  // Threads are assigned to cache slots in round-robin order, and threads
+  // sharing the same slot are still correct, they just compete for it.
+  static constexpr size_t kNumCacheSlots = 16;
+
+  struct CacheSlot {
+    alignas(kCacheSlotAlignment) std::atomic<Entry*> entry = nullptr;
+  };
+
  public:
   explicit ObjectPool(absl::AnyInvocable<absl::StatusOr<T>(Args...)> builder);
   ~ObjectPool();
@@ -73,9 +99,21 @@ class ObjectPool {
   std::unique_ptr<Entry> PopEntry();
   void PushEntry(std::unique_ptr<Entry> entry);
 
+  // Returns the cache slot assigned to the calling thread.
+  CacheSlot& thread_cache_slot();
+
+  // Pops entry from the calling thread cache slot, or from the shared stack if
+  // the cache slot is empty.
+  std::unique_ptr<Entry> PopCachedEntry();
+
+  // Pushes entry to the calling thread cache slot, and if the cache slot was
+  // already occupied, moves the previously cached entry to the shared stack.
+  void PushCachedEntry(std::unique_ptr<Entry> entry);
+
   absl::AnyInvocable<absl::StatusOr<T>(Args...)> builder_;
   std::atomic<Entry*> head_;
   std::atomic<size_t> num_created_;
+  std::array<CacheSlot, kNumCacheSlots> cache_slots_;
 };
 
 template <typename T, typename... Args>
@@ -85,6 +123,9 @@ ObjectPool<T, Args...>::ObjectPool(
 
 template <typename T, typename... Args>
 ObjectPool<T, Args...>::~ObjectPool() {
+  for (CacheSlot& slot : cache_slots_) {
+    delete slot.entry.load();
+  }
   while (Entry* entry = head_.load()) {
     head_.store(entry->next);
     delete entry;
@@ -118,6 +159,38 @@ void ObjectPool<T, Args...>::PushEntry(std::unique_ptr<Entry> entry) {
   } while (!head_.compare_exchange_weak(head, new_head));
 }
 
+template <typename T, typename... Args>
+auto ObjectPool<T, Args...>::thread_cache_slot() -> CacheSlot& {
+  static std::atomic<size_t> next_thread_index = 0;
+  thread_local size_t thread_index =
+      next_thread_index.fetch_add(1, std::memory_order_relaxed);
+  return cache_slots_[thread_index % kNumCacheSlots];
+}
+
+template <typename T, typename... Args>
+auto ObjectPool<T, Args...>::PopCachedEntry() -> std::unique_ptr<Entry> {
+  CacheSlot& slot = thread_cache_slot();
+
+  // Check that the slot is non-empty before exchanging it to avoid an atomic
+  // read-modify-write operation when we have nothing to take from it.
+  if (slot.entry.load(std::memory_order_relaxed)) {
+    if (Entry* entry = slot.entry.exchange(nullptr, std::memory_order_acquire)) {
+      return std::unique_ptr<Entry>(entry);
+    }
+  }
+
+  return PopEntry();
+}
+
+template <typename T, typename... Args>
+void ObjectPool<T, Args...>::PushCachedEntry(std::unique_ptr<Entry> entry) {
+  CacheSlot& slot = thread_cache_slot();
+  if (Entry* evicted =
+          slot.entry.exchange(entry.release(), std::memory_order_acq_rel)) {
+    PushEntry(std::unique_ptr<Entry>(evicted));
+  }
+}
+
 template <typename T, typename... Args>
 ObjectPool<T, Args...>::BorrowedObject::BorrowedObject(
     ObjectPool<T, Args...>* parent, std::unique_ptr<Entry> entry)
@@ -125,13 +198,13 @@ ObjectPool<T, Args...>::BorrowedObject::BorrowedObject(
 
 template <typename T, typename... Args>
 ObjectPool<T, Args...>::BorrowedObject::~BorrowedObject() {
-  if (parent_ && entry_) parent_->PushEntry(std::move(entry_));
+  if (parent_ && entry_) parent_->PushCachedEntry(std::move(entry_));
 }
 
 template <typename T, typename... Args>
 auto ObjectPool<T, Args...>::GetOrCreate(Args... args)
     -> absl::StatusOr<BorrowedObject> {
-  if (std::unique_ptr<Entry> entry = PopEntry()) {
+  if (std::unique_ptr<Entry> entry = PopCachedEntry()) {
     return BorrowedObject(this, std::move(entry));
   }
   TF_ASSIGN_OR_RETURN(auto entry, CreateEntry(std::forward<Args>(args)...));
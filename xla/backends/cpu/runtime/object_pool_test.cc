@@ -55,6 +55,31 @@ TEST(ObjectPoolTest, GetOrCreate) {
   ASSERT_EQ(counter, 2);
 }
 
+TEST(ObjectPoolTest, GetOrCreateFromAnotherThread) {
+  int32_t counter = 0;
+  IntPool pool([&]() -> absl::StatusOr<std::unique_ptr<int32_t>> {
+    return std::make_unique<int32_t>(counter++);
+  });
+
+  // Borrow and return two objects in the main thread: one of them stays in
+  // the thread cache, and the other one overflows to the shared stack.
+  {
+    TF_ASSERT_OK_AND_ASSIGN(auto obj0, pool.GetOrCreate());
+    TF_ASSERT_OK_AND_ASSIGN(auto obj1, pool.GetOrCreate());
+  }
+  ASSERT_EQ(counter, 2);
+
+  // Objects returned in the main thread must be reusable from other threads.
+  {
+    tsl::thread::ThreadPool threads(tsl::Env::Default(), "test", 1);
+    threads.Schedule([&] {
+      TF_ASSERT_OK_AND_ASSIGN(auto obj, pool.GetOrCreate());
+      ASSERT_GE(**obj, 0);
+    });
+  }
+  EXPECT_EQ(counter, 2);
+}
+
 TEST(ObjectPoolTest, GetOrCreateUnderContention) {
   tsl::thread::ThreadPool threads(tsl::Env::Default(), "test", 8);
 
@@ -99,5 +124,41 @@ static void BM_GetOrCreate(benchmark::State& state) {
 
 BENCHMARK(BM_GetOrCreate);
 
+static void BM_GetOrCreateMultiThreaded(benchmark::State& state) {
+  size_t num_threads = state.range(0);
+  tsl::thread::ThreadPool threads(tsl::Env::Default(), "benchmark",
+                                  num_threads);
+
+  std::atomic<int32_t> cnt = 0;
+  IntPool pool([&]() -> absl::StatusOr<std::unique_ptr<int32_t>> {
+    return std::make_unique<int32_t>(cnt++);
+  });
+
+  static constexpr size_t kNumIterations = 1024;
+
+  for (auto _ : state) {
+    absl::BlockingCounter counter(num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+      threads.Schedule([&] {
+        for (size_t j = 0; j < kNumIterations; ++j) {
+          auto obj = pool.GetOrCreate();
+          benchmark::DoNotOptimize(obj);
+        }
+        counter.DecrementCount();
+      });
+    }
+    counter.Wait();
+  }
+
+  state.SetItemsProcessed(state.iterations() * num_threads * kNumIterations);
+}
+
+BENCHMARK(BM_GetOrCreateMultiThreaded)
+    ->MeasureProcessCPUTime()
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->Arg(16);
+
 }  // namespace
 }  // namespace xla::cpu
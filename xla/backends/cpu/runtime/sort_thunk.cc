@@ -23,6 +23,7 @@ limitations under the License.
 #include <cstring>
 #include <functional>
 #include <iterator>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <string>
@@ -33,6 +34,7 @@ limitations under the License.
 #include "absl/algorithm/container.h"
 #include "absl/base/attributes.h"
 #include "absl/base/call_once.h"
+#include "absl/base/casts.h"
 #include "absl/base/dynamic_annotations.h"
 #include "absl/base/optimization.h"
 #include "absl/container/inlined_vector.h"
@@ -672,6 +674,174 @@ static void Sort1DArrInplace(const SortDims& sort_dims, int64_t offset,
   }
 }
 
+// Key types for which we sort by key using a radix sort.
+template <PrimitiveType Type>
+static constexpr bool kIsRadixSortable =
+    Type == PrimitiveType::F32 || Type == PrimitiveType::BF16 ||
+    Type == PrimitiveType::S32 || Type == PrimitiveType::U32;
+
+// Radix sort has a large constant overhead and for small arrays it's faster
+// to use a comparison based sort.
+static constexpr int64_t kMinRadixSortSize = 512;
+
+// Maps a key to an unsigned integer of the same width, such that unsigned
+// integers order is the same as the ascending order of keys. Positive and
+// negative zeros are mapped to the same value, as they compare equal.
+template <PrimitiveType Type>
+static ABSL_ATTRIBUTE_ALWAYS_INLINE auto RadixKey(
+    typename primitive_util::PrimitiveTypeToNative<Type>::type key) {
+  if constexpr (Type == PrimitiveType::F32) {
+    uint32_t bits = absl::bit_cast<uint32_t>(key);
+    if ((bits << 1) == 0) bits = 0;
+    return (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+  } else if constexpr (Type == PrimitiveType::BF16) {
+    uint16_t bits = absl::bit_cast<uint16_t>(key);
+    if (static_cast<uint16_t>(bits << 1) == 0) bits = 0;
+    return static_cast<uint16_t>((bits & 0x8000u) ? ~bits : bits | 0x8000u);
+  } else if constexpr (Type == PrimitiveType::S32) {
+    return absl::bit_cast<uint32_t>(key) ^ 0x80000000u;
+  } else {
+    static_assert(Type == PrimitiveType::U32);
+    return key;
+  }
+}
+
+// Stable LSD radix sort of (key, index) pairs with 8-bit digits. Sorted pairs
+// are written back into `items`, `scratch` must have the same size.
+template <typename Item>
+static void RadixSort(absl::Span<Item> items, absl::Span<Item> scratch) {
+  using UInt = decltype(Item::key);
+
+  Item* src = items.data();
+  Item* dst = scratch.data();
+
+  for (size_t shift = 0; shift < 8 * sizeof(UInt); shift += 8) {
+    std::array<size_t, 256> counts = {};
+    for (size_t i = 0; i < items.size(); ++i) {
+      ++counts[(src[i].key >> shift) & 0xFF];
+    }
+
+    // All keys have the same digit, and pass doesn't change the order.
+    if (absl::c_find(counts, items.size()) != counts.end()) continue;
+
+    size_t offset = 0;
+    for (size_t& count : counts) {
+      offset += std::exchange(count, offset);
+    }
+    for (size_t i = 0; i < items.size(); ++i) {
+      dst[counts[(src[i].key >> shift) & 0xFF]++] = src[i];
+    }
+    std::swap(src, dst);
+  }
+
+  if (src != items.data()) {
+    std::copy(src, src + items.size(), items.data());
+  }
+}
+
+// Sorts all inputs along the sort dimension by the keys in the first input
+// using builtin comparison of keys, which is a lot faster than calling a
+// jit-compiled comparator for every comparison. We compute a permutation that
+// sorts the keys (with a radix sort or a comparison based sort), and shuffle
+// all inputs according to the permutation.
+template <PrimitiveType Type>
+static void SortByKeyInplace(const SortDims& sort_dims,
+                             absl::Span<se::DeviceMemoryBase> data,
+                             absl::Span<const Shape> shapes, bool is_stable,
+                             SortThunk::SortDirection direction) {
+  using NativeT = typename primitive_util::PrimitiveTypeToNative<Type>::type;
+
+  const int64_t n = sort_dims.sort_dim_size;
+  const int64_t stride = sort_dims.inner_dim_size;
+  const bool ascending = direction == SortThunk::SortDirection::kAscending;
+
+  std::vector<size_t> primitive_sizes(data.size());
+  for (size_t i = 0; i < data.size(); ++i) {
+    primitive_sizes[i] = primitive_util::ByteWidth(shapes[i].element_type());
+  }
+
+  // Permutation that sorts the keys, and a scratch space for shuffling inputs.
+  std::vector<uint32_t> permutation(n);
+  std::vector<std::byte> shuffled(n * kMaxElementSize);
+
+  struct KeyIndex {
+    NativeT key;
+    uint32_t index;
+  };
+  std::vector<KeyIndex> key_indices;
+
+  bool use_radix_sort = false;
+  if constexpr (kIsRadixSortable<Type>) {
+    use_radix_sort = n >= kMinRadixSortSize;
+  }
+
+  for (int64_t it = 0; it < sort_dims.num_iterations; ++it) {
+    int64_t inner_idx = it % stride;
+    int64_t offset = inner_idx + (it - inner_idx) * n;
+
+    const NativeT* keys = reinterpret_cast<const NativeT*>(data[0].opaque());
+
+    if (use_radix_sort) {
+      if constexpr (kIsRadixSortable<Type>) {
+        using UInt = decltype(RadixKey<Type>(NativeT{}));
+        struct RadixItem {
+          UInt key;
+          uint32_t index;
+        };
+        std::vector<RadixItem> items(n), scratch(n);
+        for (int64_t j = 0; j < n; ++j) {
+          UInt key = RadixKey<Type>(keys[offset + j * stride]);
+          items[j] = RadixItem{ascending ? key : static_cast<UInt>(~key),
+                               static_cast<uint32_t>(j)};
+        }
+        RadixSort(absl::MakeSpan(items), absl::MakeSpan(scratch));
+        for (int64_t j = 0; j < n; ++j) permutation[j] = items[j].index;
+      }
+
+    } else {
+      key_indices.resize(n);
+      for (int64_t j = 0; j < n; ++j) {
+        key_indices[j] =
+            KeyIndex{keys[offset + j * stride], static_cast<uint32_t>(j)};
+      }
+
+      auto sort = [&](auto compare) {
+        auto compare_keys = [&](const KeyIndex& a, const KeyIndex& b) {
+          return compare(a.key, b.key);
+        };
+        if (is_stable) {
+          std::stable_sort(key_indices.begin(), key_indices.end(),
+                           compare_keys);
+        } else {
+          std::sort(key_indices.begin(), key_indices.end(), compare_keys);
+        }
+      };
+
+      if (ascending) {
+        sort(std::less<NativeT>());
+      } else {
+        sort(std::greater<NativeT>());
+      }
+      for (int64_t j = 0; j < n; ++j) permutation[j] = key_indices[j].index;
+    }
+
+    // Shuffle all inputs according to the sorting permutation.
+    for (size_t i = 0; i < data.size(); ++i) {
+      size_t size = primitive_sizes[i];
+      std::byte* base =
+          reinterpret_cast<std::byte*>(data[i].opaque()) + offset * size;
+
+      for (int64_t j = 0; j < n; ++j) {
+        Memcpy(&shuffled[j * size], base + permutation[j] * stride * size,
+               size);
+      }
+      for (int64_t j = 0; j < n; ++j) {
+        Memcpy(base + j * stride * size, &shuffled[j * size], size);
+      }
+    }
+  }
+}
+
 // Sorts `n` buffers in place.
 template <size_t n>
 static void SortInplace(const SortDims& sort_dims, int64_t offset,
@@ -748,6 +918,26 @@ static absl::Status SortInplace(
   // shape to get the sort dimensions.
   SortDims sort_dims = GetSortDims(shapes[0], dimension);
 
+  // If we know the sort direction for multiple inputs, it means that the
+  // comparator compares only the keys in the first input, and we can sort all
+  // inputs by keys without calling the comparator.
+  if (direction.has_value() && data.size() > 1 &&
+      sort_dims.sort_dim_size <= std::numeric_limits<uint32_t>::max()) {
+    bool sorted = false;
+    primitive_util::ArrayTypeSwitch<void>(
+        [&](auto cst_type) {
+          if constexpr ((primitive_util::IsFloatingPointType(cst_type) ||
+                         primitive_util::IsIntegralType(cst_type)) &&
+                        primitive_util::BitWidth(cst_type) >= 8) {
+            SortByKeyInplace<cst_type>(sort_dims, data, shapes, is_stable,
+                                       *direction);
+            sorted = true;
+          }
+        },
+        shapes[0].element_type());
+    if (sorted) return absl::OkStatus();
+  }
+
   // Iterate over all the 1-dimensional slices of the buffers and sort them.
   for (int64_t i = 0; i < sort_dims.num_iterations; ++i) {
     int64_t inner_idx = i % sort_dims.inner_dim_size;
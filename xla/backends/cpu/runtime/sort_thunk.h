@@ -34,6 +34,13 @@ namespace xla::cpu {
 
 // Sorts data in the input buffers along the given dimension with a custom
 // less-than comparator function.
+//
+// If sort direction is known, it means that the comparator compares only the
+// elements of the first input (keys) with a builtin comparison, and the thunk
+// sorts inputs without calling the comparator function: a single input is
+// sorted with builtin comparator, and multiple inputs are shuffled according to
+// the permutation that sorts the keys (computed with a radix sort for large
+// f32, bf16, s32 and u32 keys).
 class SortThunk final : public Thunk {
  public:
   using LessThan = absl::AnyInvocable<bool(const void** data)>;
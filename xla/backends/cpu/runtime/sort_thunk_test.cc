@@ -32,6 +32,7 @@ limitations under the License.
 #include "xla/layout_util.h"
 #include "xla/literal.h"
 #include "xla/literal_util.h"
+#include "xla/primitive_util.h"
 #include "xla/service/buffer_assignment.h"
 #include "xla/shape.h"
 #include "xla/shape_util.h"
@@ -299,6 +300,83 @@ TEST_P(SortThunkTest, Sort2DWithLayout) {
   EXPECT_EQ(indices, LiteralUtil::CreateR2<int32_t>({{2, 3}, {0, 1}}));
 }
 
+template <PrimitiveType Type>
+static void SortByKeyTest(bool is_stable, SortThunk::SortDirection direction) {
+  using NativeT = primitive_util::NativeTypeOf<Type>;
+
+  // Use large number of elements to trigger radix sort for supported types,
+  // and a small number of distinct keys to check stability of the sort.
+  static constexpr int64_t kSize = 4096;
+
+  std::vector<NativeT> keys(kSize);
+  std::vector<int32_t> indices(kSize);
+  for (int64_t i = 0; i < kSize; ++i) {
+    keys[i] = static_cast<NativeT>(static_cast<float>((i * 7919) % 101 - 50));
+    indices[i] = i;
+  }
+
+  Literal data = LiteralUtil::CreateR1<NativeT>(keys);
+  Literal iota = LiteralUtil::CreateR1<int32_t>(indices);
+
+  BufferAllocations allocations = CreateBufferAllocations(data, iota);
+  auto [alloc0, alloc1] = CreateBufferAllocation(data, iota);
+  auto [slice0, slice1] = CreateBufferAllocationSlice(alloc0, alloc1);
+
+  // The comparator function is not used when the sort direction is specified.
+  auto fake_less_than = [](const void** data) { return false; };
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto thunk,
+      SortThunk::Create({"sort"},
+                        {{slice0, data.shape()}, {slice1, iota.shape()}},
+                        /*dimension=*/0, is_stable, fake_less_than, direction));
+
+  Thunk::ExecuteParams params;
+  params.buffer_allocations = &allocations;
+
+  auto execute_event = thunk->Execute(params);
+  tsl::BlockUntilReady(execute_event);
+  ASSERT_FALSE(execute_event.IsError());
+
+  auto sorted_keys = data.data<NativeT>();
+  auto sorted_indices = iota.data<int32_t>();
+
+  for (int64_t i = 0; i < kSize; ++i) {
+    // Values must be shuffled together with keys.
+    ASSERT_EQ(sorted_keys[i], keys[sorted_indices[i]]);
+    if (i == 0) continue;
+
+    if (direction == SortThunk::SortDirection::kAscending) {
+      ASSERT_LE(sorted_keys[i - 1], sorted_keys[i]);
+    } else {
+      ASSERT_GE(sorted_keys[i - 1], sorted_keys[i]);
+    }
+    if (is_stable && sorted_keys[i - 1] == sorted_keys[i]) {
+      ASSERT_LT(sorted_indices[i - 1], sorted_indices[i]);
+    }
+  }
+}
+
+TEST_P(SortThunkTest, SortByKeyF32) {
+  SortByKeyTest<F32>(GetParam(), SortThunk::SortDirection::kAscending);
+  SortByKeyTest<F32>(GetParam(), SortThunk::SortDirection::kDescending);
+}
+
+TEST_P(SortThunkTest, SortByKeyBF16) {
+  SortByKeyTest<BF16>(GetParam(), SortThunk::SortDirection::kAscending);
+  SortByKeyTest<BF16>(GetParam(), SortThunk::SortDirection::kDescending);
+}
+
+TEST_P(SortThunkTest, SortByKeyS32) {
+  SortByKeyTest<S32>(GetParam(), SortThunk::SortDirection::kAscending);
+  SortByKeyTest<S32>(GetParam(), SortThunk::SortDirection::kDescending);
+}
+
+TEST_P(SortThunkTest, SortByKeyS64) {
+  SortByKeyTest<S64>(GetParam(), SortThunk::SortDirection::kAscending);
+  SortByKeyTest<S64>(GetParam(), SortThunk::SortDirection::kDescending);
+}
+
 INSTANTIATE_TEST_SUITE_P(SortThunk, SortThunkTest, testing::Bool(),
                          testing::PrintToStringParamName());
 
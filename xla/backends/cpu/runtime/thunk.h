@@ -88,6 +88,10 @@ class Thunk {
     std::string op_name;
     std::string module_name;
     int64_t module_id;
+
+    // Estimated cost of executing the thunk (flops plus bytes accessed as
+    // computed by the HloCostAnalysis). Zero if the cost is unknown.
+    int64_t cost = 0;
   };
 
   using Task = std::function<void()>;
@@ -21,8 +21,10 @@ limitations under the License.
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <iterator>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -30,6 +32,8 @@ limitations under the License.
 #include "absl/algorithm/container.h"
 #include "absl/base/attributes.h"
 #include "absl/base/optimization.h"
+#include "absl/base/thread_annotations.h"
+#include "absl/container/fixed_array.h"
 #include "absl/log/check.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -38,11 +42,13 @@ limitations under the License.
 #include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
 #include "xla/backends/cpu/runtime/thunk.h"
+#include "xla/backends/cpu/runtime/thunk_profile.h"
 #include "xla/runtime/buffer_use.h"
 #include "xla/runtime/execution_graph.h"
 #include "xla/runtime/resource_use.h"
 #include "xla/tsl/concurrency/async_value_ref.h"
 #include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/errors.h"
 #include "xla/tsl/platform/logging.h"
 #include "xla/tsl/platform/statusor.h"
 #include "tsl/platform/numbers.h"
@@ -95,6 +101,19 @@ static std::vector<ThunkOperation> CreateThunkOperations(
   return operations;
 }
 
+// Collects estimated costs of all thunks in the sequence. Thunks with unknown
+// cost are assigned a unit cost, so that in absence of cost estimates we
+// prioritize the longest chain of dependent thunks.
+static std::vector<int64_t> CreateThunkCosts(
+    const ThunkSequence& thunk_sequence) {
+  std::vector<int64_t> costs;
+  costs.reserve(thunk_sequence.size());
+  for (const auto& thunk : thunk_sequence) {
+    costs.push_back(std::max<int64_t>(1, thunk->info().cost));
+  }
+  return costs;
+}
+
 ThunkExecutor::ThunkExecutor(ThunkSequence thunk_sequence,
                              ExecutionGraph execution_graph,
                              const ThunkExecutor::Options& options)
@@ -121,6 +140,11 @@ ThunkExecutor::ThunkExecutor(ThunkSequence thunk_sequence,
   // Xprof traces easier to read.
   is_sequential_ |= UseBlockingThunkExecutor();
 
+  if (options.profile_num_executions > 0) {
+    profile_ = std::make_unique<ThunkProfile>(num_thunks_,
+                                              options.profile_num_executions);
+  }
+
   VLOG(2) << absl::StreamFormat(
       "Constructed ThunkExecutor with %d thunks: #source_nodes=%d "
       "#sink_nodes=%d, is_sequential=%v, small_buffers=%v",
@@ -135,6 +159,12 @@ absl::StatusOr<ThunkExecutor> ThunkExecutor::Create(
                       ExecutionGraph::Create<ThunkOperation>(
                           CreateThunkOperations(thunk_sequence)));
 
+  // Override default priorities with the critical path length.
+  if (options.use_critical_path_priority) {
+    TF_RETURN_IF_ERROR(execution_graph.UpdatePrioritiesWithCriticalPath(
+        CreateThunkCosts(thunk_sequence)));
+  }
+
   return ThunkExecutor(std::move(thunk_sequence), std::move(execution_graph),
                        options);
 }
@@ -143,9 +173,11 @@ ThunkExecutor::ExecuteState::Node::Node(const NodeDef& node_def)
     : counter(node_def.in_edges.size()), out_edges(node_def.out_edges) {}
 
 ThunkExecutor::ExecuteState::ExecuteState(ThunkExecutor* executor,
-                                          Thunk::TaskRunner* runner)
+                                          Thunk::TaskRunner* runner,
+                                          ThunkProfile* profile)
     : executor(executor),
       runner(runner),
+      profile(profile),
       nodes(executor->execution_graph_.nodes_defs().size()),
       execute_event(tsl::MakeConstructedAsyncValueRef<ExecuteEvent>()),
       pending_sink_nodes(executor->execution_graph_.sink().size()),
@@ -182,6 +214,28 @@ tsl::AsyncValueRef<Thunk::ExecuteEvent> ThunkExecutor::TracedExecute(
   return execute_event;
 }
 
+tsl::AsyncValueRef<Thunk::ExecuteEvent> ThunkExecutor::ProfiledExecute(
+    Thunk& thunk, const Thunk::ExecuteParams& params, ThunkProfile* profile,
+    size_t index) {
+  uint64_t start_ns = tsl::Env::Default()->NowNanos();
+  auto execute_event = TracedExecute(thunk, params);
+
+  // Fast path for thunks that completed execution in the caller thread.
+  if (ABSL_PREDICT_TRUE(execute_event.IsAvailable())) {
+    profile->Record(index, tsl::Env::Default()->NowNanos() - start_ns);
+    return execute_event;
+  }
+
+  // Callbacks run in the order they were added, so the execution time is
+  // recorded before the executor processes the thunk out edges, and
+  // potentially completes the execution.
+  execute_event.AndThen([profile, index, start_ns] {
+    profile->Record(index, tsl::Env::Default()->NowNanos() - start_ns);
+  });
+
+  return execute_event;
+}
+
 tsl::AsyncValueRef<ThunkExecutor::ExecuteEvent> ThunkExecutor::Execute(
     const Thunk::ExecuteParams& params) {
   // Short-circuit execution of empty thunk sequence.
@@ -189,21 +243,30 @@ tsl::AsyncValueRef<ThunkExecutor::ExecuteEvent> ThunkExecutor::Execute(
     return Thunk::OkExecuteEventSingleton();
   }
 
+  // Check if we have to record thunks execution time for this execution.
+  ThunkProfile* profile =
+      ABSL_PREDICT_FALSE(profile_ && profile_->StartExecution())
+          ? profile_.get()
+          : nullptr;
+
   // Short-circuit execution of single thunk sequence.
   if (ABSL_PREDICT_FALSE(num_thunks_ == 1)) {
-    return TracedExecute(*thunk_sequence_[0], params);
+    return ABSL_PREDICT_FALSE(profile)
+               ? ProfiledExecute(*thunk_sequence_[0], params, profile, 0)
+               : TracedExecute(*thunk_sequence_[0], params);
   }
 
   // When we choose sequential execution strategy (we rely on heuristics and
   // a cost model to make the decision), we skip expensive async execution and
   // simply run thunks one by one. This minimizes runtime overheads from small
   // XLA programs with many cheap operations.
-  if (is_sequential_) {
+  if (is_sequential_ && ABSL_PREDICT_TRUE(!profile)) {
     return ExecuteSequential(params);
   }
 
   // Create async execution state on heap and kick-off execution.
-  auto state = std::make_unique<ExecuteState>(this, params.task_runner);
+  auto state =
+      std::make_unique<ExecuteState>(this, params.task_runner, profile);
 
   // When we kick-off execution we don't have to grab the session lock, as the
   // main thread is not counted towards the number of concurrent workers limit.
@@ -225,6 +288,11 @@ tsl::AsyncValueRef<ThunkExecutor::ExecuteEvent> ThunkExecutor::Execute(
       execute(PriorityReadyQueue(execution_graph_.nodes_defs(),
                                  execution_graph_.source()));
       break;
+    case Options::ReadyQueueType::kWorkStealing:
+      // One deque for each of the session workers plus the main thread.
+      execute(WorkStealingReadyQueue(params.session.max_workers() + 1,
+                                     execution_graph_.source()));
+      break;
   }
 
   // If execution already completed (all kernels executed in the caller thread),
@@ -408,6 +476,8 @@ void ThunkExecutor::Execute(ExecuteState* state,
     tsl::AsyncValueRef<ExecuteEvent> execute_event =
         ABSL_PREDICT_FALSE(state->abort.load(std::memory_order_relaxed))
             ? Thunk::OkExecuteEventSingleton()
+        : ABSL_PREDICT_FALSE(state->profile)
+            ? ProfiledExecute(thunk, params, state->profile, id)
             : TracedExecute(thunk, params);
 
     if (ABSL_PREDICT_TRUE(execute_event.IsAvailable())) {
@@ -678,4 +748,160 @@ ThunkExecutor::PriorityReadyQueue::CreateEmptyReadyQueue() const {
   return PriorityReadyQueue(nodes_defs_, {});
 }
 
+class ThunkExecutor::WorkStealingReadyQueue::Deques {
+ public:
+  // Align deques to a cache line boundary to avoid false sharing between
+  // worker threads that concurrently push and pop nodes.
+  struct alignas(kAtomicAlignment) Deque {
+    absl::Mutex mu;
+    std::deque<NodeId> nodes ABSL_GUARDED_BY(mu);
+
+    // Number of nodes in the deque that we use to skip empty victims without
+    // taking a lock. It is updated while holding the lock.
+    std::atomic<size_t> size = 0;
+  };
+
+  explicit Deques(size_t num_deques)
+      : deques_(std::max<size_t>(1, num_deques)) {}
+
+  Deque& operator[](size_t index) {
+    DCHECK_LT(index, deques_.size()) << "Deque index is out of bounds";
+    return deques_[index];
+  }
+
+  size_t size() const { return deques_.size(); }
+
+  // Returns the index of a deque for a new work stealing queue. We assign
+  // deques in round-robin order, and if we have more concurrent queues than
+  // deques, multiple queues will share the same deque.
+  size_t NextIndex() {
+    return next_index_.fetch_add(1, std::memory_order_relaxed) %
+           deques_.size();
+  }
+
+ private:
+  absl::FixedArray<Deque> deques_;
+  std::atomic<size_t> next_index_ = 0;
+};
+
+ThunkExecutor::WorkStealingReadyQueue::WorkStealingReadyQueue(
+    size_t num_deques, absl::Span<const NodeId> ready_nodes)
+    : deques_(std::make_shared<Deques>(num_deques)),
+      index_(deques_->NextIndex()) {
+  for (NodeId id : ready_nodes) Push(id);
+}
+
+ThunkExecutor::WorkStealingReadyQueue::WorkStealingReadyQueue(
+    std::shared_ptr<Deques> deques, size_t index)
+    : deques_(std::move(deques)), index_(index) {}
+
+void ThunkExecutor::WorkStealingReadyQueue::Push(NodeId id) {
+  Deques::Deque& deque = (*deques_)[index_];
+  absl::MutexLock lock(&deque.mu);
+  deque.nodes.push_back(id);
+  deque.size.store(deque.nodes.size(), std::memory_order_relaxed);
+}
+
+std::optional<ThunkExecutor::NodeId>
+ThunkExecutor::WorkStealingReadyQueue::TryPop() {
+  Deques::Deque& deque = (*deques_)[index_];
+  {
+    absl::MutexLock lock(&deque.mu);
+    if (ABSL_PREDICT_TRUE(!deque.nodes.empty())) {
+      NodeId id = deque.nodes.back();
+      deque.nodes.pop_back();
+      deque.size.store(deque.nodes.size(), std::memory_order_relaxed);
+      return id;
+    }
+  }
+  return TrySteal();
+}
+
+std::optional<ThunkExecutor::NodeId>
+ThunkExecutor::WorkStealingReadyQueue::TrySteal() {
+  // Start looking for a victim from the neighbor deque, so that different
+  // thieves do not all contend on the same victim.
+  for (size_t i = 1; i < deques_->size(); ++i) {
+    Deques::Deque& victim = (*deques_)[(index_ + i) % deques_->size()];
+    if (victim.size.load(std::memory_order_relaxed) == 0) continue;
+
+    // Steal the oldest half of the victim's nodes (rounded up).
+    absl::InlinedVector<NodeId, 8> stolen;
+    {
+      absl::MutexLock lock(&victim.mu);
+      size_t num_stolen = (victim.nodes.size() + 1) / 2;
+      stolen.assign(victim.nodes.begin(), victim.nodes.begin() + num_stolen);
+      victim.nodes.erase(victim.nodes.begin(),
+                         victim.nodes.begin() + num_stolen);
+      victim.size.store(victim.nodes.size(), std::memory_order_relaxed);
+    }
+
+    if (stolen.empty()) continue;
+
+    // Keep the oldest stolen node for the caller, and push the rest to the
+    // local deque in the same order.
+    for (size_t j = 1; j < stolen.size(); ++j) Push(stolen[j]);
+    return stolen[0];
+  }
+
+  return std::nullopt;
+}
+
+ThunkExecutor::NodeId ThunkExecutor::WorkStealingReadyQueue::Pop() {
+  if (ABSL_PREDICT_TRUE(next_.has_value())) {
+    NodeId id = *next_;
+    next_.reset();
+    return id;
+  }
+
+  std::optional<NodeId> id = TryPop();
+  CHECK(id.has_value()) << "Queue must not be empty";
+  return *id;
+}
+
+ThunkExecutor::WorkStealingReadyQueue
+ThunkExecutor::WorkStealingReadyQueue::PopHalf() {
+  // Move the oldest half of the local nodes (rounded up) to the popped queue,
+  // and keep the recently added nodes in the local deque.
+  absl::InlinedVector<NodeId, 8> nodes;
+  {
+    Deques::Deque& deque = (*deques_)[index_];
+    absl::MutexLock lock(&deque.mu);
+    size_t num_popped = (deque.nodes.size() + 1) / 2;
+    nodes.assign(deque.nodes.begin(), deque.nodes.begin() + num_popped);
+    deque.nodes.erase(deque.nodes.begin(), deque.nodes.begin() + num_popped);
+    deque.size.store(deque.nodes.size(), std::memory_order_relaxed);
+  }
+
+  // If concurrent thieves emptied the local deque, give away the reserved
+  // node, so that the popped queue is not empty.
+  if (ABSL_PREDICT_FALSE(nodes.empty() && next_.has_value())) {
+    nodes.push_back(*next_);
+    next_.reset();
+  }
+
+  WorkStealingReadyQueue popped = CreateEmptyReadyQueue();
+  if (ABSL_PREDICT_TRUE(!nodes.empty())) {
+    popped.next_ = nodes[0];
+    for (size_t i = 1; i < nodes.size(); ++i) popped.Push(nodes[i]);
+  }
+  return popped;
+}
+
+size_t ThunkExecutor::WorkStealingReadyQueue::Size() const {
+  return (*deques_)[index_].size.load(std::memory_order_relaxed) +
+         next_.has_value();
+}
+
+bool ThunkExecutor::WorkStealingReadyQueue::Empty() {
+  if (ABSL_PREDICT_TRUE(next_.has_value())) return false;
+  next_ = TryPop();
+  return !next_.has_value();
+}
+
+ThunkExecutor::WorkStealingReadyQueue
+ThunkExecutor::WorkStealingReadyQueue::CreateEmptyReadyQueue() const {
+  return WorkStealingReadyQueue(deques_, deques_->NextIndex());
+}
+
 }  // namespace xla::cpu
@@ -19,7 +19,9 @@ limitations under the License.
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <new>
+#include <optional>
 #include <queue>
 #include <string>
 #include <type_traits>
@@ -34,6 +36,7 @@ limitations under the License.
 #include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
 #include "xla/backends/cpu/runtime/thunk.h"
+#include "xla/backends/cpu/runtime/thunk_profile.h"
 #include "xla/runtime/execution_graph.h"
 #include "xla/tsl/concurrency/async_value_ref.h"
 
@@ -43,7 +46,7 @@ namespace internal {
 // Clang does not allow defining a nested struct with member initializer, as
 // a workaround we define a struct in internal namespace and create an alias.
 struct ThunkExecutorOptions {
-  enum class ReadyQueueType { kFifo, kLifo, kPriority };
+  enum class ReadyQueueType { kFifo, kLifo, kPriority, kWorkStealing };
 
   // If all thunks in a sequence use buffers of size less than or equal to the
   // given threshold, we mark execution as sequential, as concurrency overheads
@@ -57,6 +60,20 @@ struct ThunkExecutorOptions {
 
   // The type of a queue for ready thunks.
   ReadyQueueType ready_queue_type = ReadyQueueType::kFifo;
+
+  // If true, nodes priorities are computed as the length of the critical path
+  // (bottom level) from the node to a sink node using the thunks' estimated
+  // costs (see `Thunk::Info::cost`). Otherwise nodes priorities are computed
+  // from the number of reachable nodes. Priorities are used only by the
+  // priority ready queue.
+  bool use_critical_path_priority = false;
+
+  // If greater than zero, executor records execution time of all thunks for
+  // the given number of first executions of the thunk sequence (see
+  // `ThunkProfile`). Profiled executions never take a sequential execution
+  // path (even if executor `is_sequential()`), as we want it to measure thunks
+  // execution times in the same environment as in regular executions.
+  size_t profile_num_executions = 0;
 };
 }  // namespace internal
 
@@ -93,6 +110,9 @@ class ThunkExecutor {
 
   bool is_sequential() const { return is_sequential_; }
 
+  // Returns thunk execution profile if profiling is enabled in options.
+  const ThunkProfile* profile() const { return profile_.get(); }
+
   // We use underlying execution graph nodes to index into the thunk sequence.
   using NodeId = ExecutionGraph::NodeId;
   using NodeDef = ExecutionGraph::NodeDef;
@@ -167,6 +187,59 @@ class ThunkExecutor {
     InlinedPriorityQueue queue_;
   };
 
+  // A ready queue that gives each concurrent executor task its own deque of
+  // ready nodes, and lets tasks that ran out of local work steal nodes from
+  // the deques of other tasks. Owner pushes and pops nodes at the back of its
+  // deque (LIFO order keeps recently produced buffers hot in cache), and
+  // thieves steal the oldest nodes from the front of the victim's deque.
+  //
+  // All queues created from the same queue (via PopHalf or
+  // CreateEmptyReadyQueue) share the same set of deques.
+  class WorkStealingReadyQueue {
+   public:
+    // A set of deques shared by all work stealing queues of one execution.
+    class Deques;
+
+    WorkStealingReadyQueue(size_t num_deques,
+                           absl::Span<const NodeId> ready_nodes);
+
+    void Push(NodeId id);
+
+    NodeId Pop();
+    WorkStealingReadyQueue PopHalf();
+
+    size_t Size() const;
+
+    // Returns true if the queue has no local nodes and it failed to steal any
+    // nodes from other deques. Note that unlike other ready queues this is not
+    // a const method, as it might steal nodes into the local deque.
+    bool Empty();
+
+    WorkStealingReadyQueue CreateEmptyReadyQueue() const;
+
+   private:
+    WorkStealingReadyQueue(std::shared_ptr<Deques> deques, size_t index);
+
+    // Pops a node from the back of the local deque, or if it's empty, steals
+    // nodes from other deques.
+    std::optional<NodeId> TryPop();
+
+    // Steals half of the nodes from the first non-empty victim deque into the
+    // local deque, and returns one of the stolen nodes.
+    std::optional<NodeId> TrySteal();
+
+    // Deques are shared between all queues participating in work stealing,
+    // and we keep them alive for as long as at least one queue is alive, as
+    // queues can outlive the execute state that created them.
+    std::shared_ptr<Deques> deques_;
+    size_t index_;
+
+    // A node reserved by `Empty()` (or `PopHalf()` for the returned queue) to
+    // guarantee that the following `Pop()` will succeed even if concurrent
+    // thieves emptied the local deque in between.
+    std::optional<NodeId> next_;
+  };
+
  private:
   // Align all atomic counters to a cache line boundary to avoid false
   // sharing between multiple worker threads.
@@ -197,7 +270,8 @@ class ThunkExecutor {
       alignas(Node) std::byte data[sizeof(Node)];
     };
 
-    ExecuteState(ThunkExecutor* executor, Thunk::TaskRunner* runner);
+    ExecuteState(ThunkExecutor* executor, Thunk::TaskRunner* runner,
+                 ThunkProfile* profile);
 
     Node& node(NodeId id) {
       DCHECK_LT(id, nodes.size()) << "Node id is out of bounds";
@@ -207,6 +281,9 @@ class ThunkExecutor {
     ThunkExecutor* executor;
     Thunk::TaskRunner* runner;
 
+    // If not null, we record execution time of all thunks into the profile.
+    ThunkProfile* profile;
+
     // Note: using alignas(Node) here instead of in NodeStorage does not work:
     // `nodes` would be aligned, but not its elements.
     absl::FixedArray<NodeStorage> nodes;
@@ -231,6 +308,13 @@ class ThunkExecutor {
   static tsl::AsyncValueRef<ExecuteEvent> TracedExecute(
       Thunk& thunk, const Thunk::ExecuteParams& params);
 
+  // Executes given `thunk` with `params` and records its execution time (from
+  // the start of the execution to the execute event completion) into the
+  // profile at the given thunk `index`.
+  static tsl::AsyncValueRef<ExecuteEvent> ProfiledExecute(
+      Thunk& thunk, const Thunk::ExecuteParams& params, ThunkProfile* profile,
+      size_t index);
+
   // Executes thunks sequentially starting from the first thunk in the
   // sequence.
   tsl::AsyncValueRef<ExecuteEvent> ExecuteSequential(
@@ -271,6 +355,10 @@ class ThunkExecutor {
   // heuristics to use sequential execution for sequences of small thunks where
   // async execution overhead will likely dominate the overall execution time.
   bool is_sequential_;
+
+  // Thunk execution profile, allocated only if profiling is enabled. We keep
+  // it on the heap to keep the executor movable.
+  std::unique_ptr<ThunkProfile> profile_;
 };
 
 }  // namespace xla::cpu
@@ -35,6 +35,8 @@ limitations under the License.
 #include "xla/backends/cpu/runtime/buffer_allocations.h"
 #include "xla/backends/cpu/runtime/thread_pool_task_runner.h"
 #include "xla/backends/cpu/runtime/thunk.h"
+#include "xla/backends/cpu/runtime/thunk.pb.h"
+#include "xla/backends/cpu/runtime/thunk_profile.h"
 #include "xla/backends/cpu/runtime/thunk_testlib.h"
 #include "xla/literal.h"
 #include "xla/literal_util.h"
@@ -108,13 +110,14 @@ class AddI32Thunk final : public Thunk {
   AddI32Thunk(std::string name, std::vector<BufferAllocation::Slice> srcs,
               std::vector<BufferAllocation::Slice> dsts,
               std::vector<std::string>* trace, bool use_shared_resource,
-              bool inject_error);
+              bool inject_error, int64_t cost);
 
   static std::unique_ptr<Thunk> Create(
       std::string name, std::vector<BufferAllocation::Slice> srcs,
       std::vector<BufferAllocation::Slice> dsts,
       std::vector<std::string>* trace = nullptr,
-      bool use_shared_resource = false, bool inject_error = false);
+      bool use_shared_resource = false, bool inject_error = false,
+      int64_t cost = 0);
 
   // Executes `dst += src` for a single src/dst pair.
   static absl::Status Execute(const BufferAllocations* allocations,
@@ -137,18 +140,20 @@ class AddI32Thunk final : public Thunk {
 std::unique_ptr<Thunk> AddI32Thunk::Create(
     std::string name, std::vector<BufferAllocation::Slice> srcs,
     std::vector<BufferAllocation::Slice> dsts, std::vector<std::string>* trace,
-    bool use_shared_resource, bool inject_error) {
+    bool use_shared_resource, bool inject_error, int64_t cost) {
   return std::make_unique<AddI32Thunk>(std::move(name), std::move(srcs),
                                        std::move(dsts), trace,
-                                       use_shared_resource, inject_error);
+                                       use_shared_resource, inject_error, cost);
 }
 
 AddI32Thunk::AddI32Thunk(std::string name,
                          std::vector<BufferAllocation::Slice> srcs,
                          std::vector<BufferAllocation::Slice> dsts,
                          std::vector<std::string>* trace,
-                         bool use_shared_resource, bool inject_error)
-    : Thunk(Kind::kKernel, Info{name}),
+                         bool use_shared_resource, bool inject_error,
+                         int64_t cost)
+    : Thunk(Kind::kKernel, Info{name, /*module_name=*/"", /*module_id=*/0,
+                                /*cost=*/cost}),
       srcs_(std::move(srcs)),
       dsts_(std::move(dsts)),
       trace_(trace),
@@ -415,6 +420,54 @@ TEST(ThunkExecutorTest, PriorityReadyQueueTest) {
   EXPECT_EQ(half2.Pop(), 1);
 }
 
+TEST(ThunkExecutorTest, WorkStealingReadyQueueTest) {
+  ThunkExecutor::WorkStealingReadyQueue queue(/*num_deques=*/2, {});
+
+  // Check basic queue properties.
+  EXPECT_TRUE(queue.Empty());
+  EXPECT_EQ(queue.Size(), 0);
+
+  queue.Push(1);
+  queue.Push(2);
+  queue.Push(3);
+
+  ASSERT_EQ(queue.Size(), 3);
+
+  // Owner pops nodes from the back of its deque.
+  EXPECT_EQ(queue.Pop(), 3);
+  EXPECT_EQ(queue.Pop(), 2);
+  EXPECT_EQ(queue.Pop(), 1);
+
+  EXPECT_TRUE(queue.Empty());
+  ASSERT_EQ(queue.Size(), 0);
+
+  // Prepare queue for PopHalf test case.
+  queue.Push(1);
+  queue.Push(2);
+  queue.Push(3);
+  queue.Push(4);
+  queue.Push(5);
+
+  // Pop the oldest half of the queue into the second deque.
+  ThunkExecutor::WorkStealingReadyQueue half0 = queue.PopHalf();
+  ASSERT_EQ(half0.Size(), 3);
+  ASSERT_EQ(queue.Size(), 2);
+
+  EXPECT_EQ(half0.Pop(), 1);
+  EXPECT_EQ(half0.Pop(), 3);
+  EXPECT_EQ(half0.Pop(), 2);
+
+  // When the local deque is empty, the queue steals the oldest nodes from the
+  // front of the other deque.
+  EXPECT_FALSE(half0.Empty());
+  EXPECT_EQ(half0.Pop(), 4);
+  ASSERT_EQ(queue.Size(), 1);
+  EXPECT_EQ(queue.Pop(), 5);
+
+  EXPECT_TRUE(queue.Empty());
+  EXPECT_TRUE(half0.Empty());
+}
+
 TEST(ThunkExecutorTest, Execute) {
   BufferAllocation alloc(/*index=*/0, /*size=*/80, /*color=*/0);
 
@@ -462,6 +515,90 @@ TEST(ThunkExecutorTest, Execute) {
                                                   2, 2, 2, 2, 2}));  // slice1
 }
 
+TEST(ThunkExecutorTest, ExecuteWithCriticalPathPriority) {
+  BufferAllocation alloc(/*index=*/0, /*size=*/80, /*color=*/0);
+
+  BufferAllocation::Slice slice0(&alloc, /*offset=*/0, /*size=*/40);
+  BufferAllocation::Slice slice1(&alloc, /*offset=*/40, /*size=*/40);
+  BufferAllocation::Slice slice2(&alloc, /*offset=*/20, /*size=*/40);
+
+  std::vector<std::string> trace;
+
+  // Thunk `b` is on the critical path and must be executed first.
+  ThunkSequence sequence;
+  sequence.push_back(AddI32Thunk::Create("a", {slice0}, {slice0}, &trace,
+                                         /*use_shared_resource=*/false,
+                                         /*inject_error=*/false, /*cost=*/1));
+  sequence.push_back(AddI32Thunk::Create("b", {slice1}, {slice1}, &trace,
+                                         /*use_shared_resource=*/false,
+                                         /*inject_error=*/false, /*cost=*/100));
+  sequence.push_back(AddI32Thunk::Create("c", {slice2}, {slice2}, &trace,
+                                         /*use_shared_resource=*/false,
+                                         /*inject_error=*/false, /*cost=*/1));
+
+  ThunkExecutor::Options options = OptionsForTest();
+  options.ready_queue_type = ThunkExecutor::Options::ReadyQueueType::kPriority;
+  options.use_critical_path_priority = true;
+
+  TF_ASSERT_OK_AND_ASSIGN(ThunkExecutor executor,
+                          ThunkExecutor::Create(std::move(sequence), options));
+
+  // Shared src and dst allocation.
+  auto data = LiteralUtil::CreateFull({20}, int32_t{1});
+  BufferAllocations allocations = CreateBufferAllocations(data);
+
+  Thunk::ExecuteParams params = {nullptr, &allocations};
+
+  auto execute_event = executor.Execute(params);
+
+  tsl::BlockUntilReady(execute_event);
+  ASSERT_TRUE(execute_event.IsConcrete());
+
+  EXPECT_THAT(trace, ElementsAre("b", "a", "c"));
+}
+
+TEST(ThunkExecutorTest, ExecuteWithProfile) {
+  BufferAllocation alloc(/*index=*/0, /*size=*/80, /*color=*/0);
+
+  BufferAllocation::Slice slice0(&alloc, /*offset=*/0, /*size=*/40);
+  BufferAllocation::Slice slice1(&alloc, /*offset=*/40, /*size=*/40);
+
+  ThunkSequence sequence;
+  sequence.push_back(AddI32Thunk::Create("a", {slice0}, {slice0}));
+  sequence.push_back(AddI32Thunk::Create("b", {slice1}, {slice1}));
+
+  // Sequential execution must not bypass thunks profiling.
+  ThunkExecutor::Options options = OptionsForTest();
+  options.execute_sequential_num_thunks_threshold = 8;
+  options.profile_num_executions = 2;
+
+  TF_ASSERT_OK_AND_ASSIGN(ThunkExecutor executor,
+                          ThunkExecutor::Create(std::move(sequence), options));
+  ASSERT_TRUE(executor.is_sequential());
+  ASSERT_NE(executor.profile(), nullptr);
+
+  auto data = LiteralUtil::CreateFull({20}, int32_t{1});
+  BufferAllocations allocations = CreateBufferAllocations(data);
+
+  Thunk::ExecuteParams params = {nullptr, &allocations};
+
+  for (size_t i = 0; i < 3; ++i) {
+    auto execute_event = executor.Execute(params);
+    tsl::BlockUntilReady(execute_event);
+    ASSERT_TRUE(execute_event.IsConcrete());
+  }
+
+  // Only the first two executions are recorded in the profile.
+  EXPECT_EQ(executor.profile()->num_records(0), 2);
+  EXPECT_EQ(executor.profile()->num_records(1), 2);
+
+  ThunkProfileProto proto =
+      executor.profile()->ToProto(executor.thunk_sequence());
+  ASSERT_EQ(proto.entries_size(), 2);
+  EXPECT_EQ(proto.entries(0).info().op_name(), "a");
+  EXPECT_EQ(proto.entries(1).info().op_name(), "b");
+}
+
 //===----------------------------------------------------------------------===//
 // ThunkExecutor resource isolation testing
 //===----------------------------------------------------------------------===//
@@ -638,11 +775,12 @@ GenerateThunkSequence(size_t num_elements, size_t num_thunks,
 // and optionally uses a thread pool to execute thunk executor tasks.
 class ThunkExecutorStressTest
     : public testing::TestWithParam<
-          std::tuple<int32_t, bool, bool, SharedResourceUse, bool, bool>> {
+          std::tuple<int32_t, bool, bool, SharedResourceUse, bool,
+                     ThunkExecutor::Options::ReadyQueueType>> {
  public:
   void SetUp() override {
     auto& [num_thunks, use_task_runner, use_device, shared_resource_use,
-           inject_errors, use_priority_ready_queue] = GetParam();
+           inject_errors, ready_queue_type] = GetParam();
 
     use_task_runner_ = use_task_runner;
     use_device_ = use_device;
@@ -680,17 +818,15 @@ class ThunkExecutorStressTest
 
 TEST_P(ThunkExecutorStressTest, Execute) {
   auto [num_thunks, use_task_runner, use_device, shared_resource_use,
-        inject_errors, use_priority_ready_queue] = GetParam();
+        inject_errors, ready_queue_type] = GetParam();
 
   TF_ASSERT_OK_AND_ASSIGN(
       std::unique_ptr<GeneratedThunkSequence> g,
       GenerateThunkSequence(/*num_elements=*/1024, num_thunks,
                             shared_resource_use, inject_errors));
 
-  ThunkExecutor::Options executor_options = {
-      /*execute_sequential_buffer_threshold=*/0,
-      /*use_priority_ready_queue=*/use_priority_ready_queue,
-  };
+  ThunkExecutor::Options executor_options = OptionsForTest();
+  executor_options.ready_queue_type = ready_queue_type;
 
   TF_ASSERT_OK_AND_ASSIGN(
       ThunkExecutor executor,
@@ -726,7 +862,12 @@ INSTANTIATE_TEST_SUITE_P(
                                      SharedResourceUse::kAll,
                                      SharedResourceUse::kRandom),
                      /*inject_errors=*/testing::Bool(),
-                     /*use_priority_ready_queue=*/testing::Bool()));
+                     /*ready_queue_type=*/
+                     testing::Values(
+                         ThunkExecutor::Options::ReadyQueueType::kFifo,
+                         ThunkExecutor::Options::ReadyQueueType::kLifo,
+                         ThunkExecutor::Options::ReadyQueueType::kPriority,
+                         ThunkExecutor::Options::ReadyQueueType::kWorkStealing)));
 
 //===----------------------------------------------------------------------===//
 // Performance benchmarks below
@@ -800,6 +941,32 @@ static void BM_PriorityReadyQueuePushPopHalf(benchmark::State& state) {
   }
 }
 
+static void BM_WorkStealingReadyQueuePushPop(benchmark::State& state) {
+  ThunkExecutor::WorkStealingReadyQueue queue(/*num_deques=*/1, {});
+  const size_t num_push_pop = state.range(0);
+
+  for (auto _ : state) {
+    for (int i = 0; i < num_push_pop; ++i) {
+      queue.Push(i);
+    }
+    for (int i = 0; i < num_push_pop; ++i) {
+      benchmark::DoNotOptimize(queue.Pop());
+    }
+  }
+}
+
+static void BM_WorkStealingReadyQueuePushPopHalf(benchmark::State& state) {
+  ThunkExecutor::WorkStealingReadyQueue queue(/*num_deques=*/2, {});
+  const size_t num_push_pop = state.range(0);
+
+  for (auto _ : state) {
+    for (int i = 0; i < num_push_pop; ++i) {
+      queue.Push(i);
+    }
+    benchmark::DoNotOptimize(queue.PopHalf());
+  }
+}
+
 #define BENCHMARK_READY_QUEUE(name) \
   BENCHMARK(name)                   \
       ->MeasureProcessCPUTime()     \
@@ -813,6 +980,8 @@ BENCHMARK_READY_QUEUE(BM_FifoReadyQueuePushPop);
 BENCHMARK_READY_QUEUE(BM_FifoReadyQueuePushPopHalf);
 BENCHMARK_READY_QUEUE(BM_PriorityReadyQueuePushPop);
 BENCHMARK_READY_QUEUE(BM_PriorityReadyQueuePushPopHalf);
+BENCHMARK_READY_QUEUE(BM_WorkStealingReadyQueuePushPop);
+BENCHMARK_READY_QUEUE(BM_WorkStealingReadyQueuePushPopHalf);
 
 static void BM_CreateThunkExecutor(benchmark::State& state) {
   const size_t num_thunks = state.range(0);
@@ -911,5 +1080,96 @@ BENCHMARK_THUNK_EXECUTOR(BM_SequentialThunkExecutor);
 BENCHMARK_THUNK_EXECUTOR(BM_SyncThunkExecutor);
 BENCHMARK_THUNK_EXECUTOR(BM_AsyncThunkExecutor);
 
+// Shape of the thunk DAG for comparing ready queue types.
+enum class DagShape {
+  kWide,   // all thunks are independent
+  kDeep,   // a few long independent chains of thunks
+  kRandom  // random thunk dependencies
+};
+
+static absl::StatusOr<std::unique_ptr<GeneratedThunkSequence>>
+GenerateThunkSequence(DagShape shape, size_t num_thunks) {
+  if (shape == DagShape::kRandom) {
+    return GenerateThunkSequence(/*num_elements=*/1024, num_thunks,
+                                 SharedResourceUse::kNo,
+                                 /*inject_errors=*/false);
+  }
+
+  static constexpr size_t kSliceSize = 32;
+  static constexpr size_t kNumChains = 4;
+
+  // Thunks that write to the same dst slice form a chain of dependencies.
+  size_t num_slices = shape == DagShape::kWide ? num_thunks : kNumChains;
+
+  auto g = std::make_unique<GeneratedThunkSequence>(num_slices * kSliceSize);
+  g->sequence.reserve(num_thunks);
+
+  for (int i = 0; i < num_thunks; ++i) {
+    size_t offset = (i % num_slices) * kSliceSize * sizeof(int32_t);
+    BufferAllocation::Slice src(&g->src_alloc, offset,
+                                kSliceSize * sizeof(int32_t));
+    BufferAllocation::Slice dst(&g->dst_alloc, offset,
+                                kSliceSize * sizeof(int32_t));
+
+    // Pre-compute expected result while building the thunk sequence.
+    BufferAllocations allocations =
+        CreateBufferAllocations(absl::MakeSpan(g->expected_literals));
+    TF_RETURN_IF_ERROR(AddI32Thunk::Execute(&allocations, src, dst));
+
+    g->sequence.push_back(AddI32Thunk::Create(absl::StrCat(i), {src}, {dst}));
+  }
+
+  return g;
+}
+
+static void BM_ReadyQueueThunkExecutor(
+    benchmark::State& state, DagShape shape,
+    ThunkExecutor::Options::ReadyQueueType ready_queue_type) {
+  const size_t num_thunks = state.range(0);
+
+  tsl::thread::ThreadPool thread_pool(tsl::Env::Default(), "thunk-executor", 8);
+  Eigen::ThreadPoolDevice device(thread_pool.AsEigenThreadPool(),
+                                 thread_pool.NumThreads());
+
+  auto g = GenerateThunkSequence(shape, num_thunks);
+
+  ThunkExecutor::Options options = OptionsForTest();
+  options.ready_queue_type = ready_queue_type;
+  auto e = ThunkExecutor::Create(std::move((*g)->sequence), options);
+
+  BufferAllocations allocations =
+      CreateBufferAllocations(absl::MakeSpan((*g)->literals));
+  ThreadPoolTaskRunner task_runner(thread_pool.AsEigenThreadPool());
+
+  Thunk::ExecuteParams params = {nullptr, &allocations, nullptr, &device,
+                                 &task_runner};
+
+  for (auto _ : state) {
+    auto execute_event = e->Execute(params);
+    tsl::BlockUntilReady(execute_event);
+    CHECK(execute_event.IsConcrete());
+  }
+}
+
+#define BENCHMARK_READY_QUEUE_TYPE(shape, type)                   \
+  BENCHMARK_CAPTURE(BM_ReadyQueueThunkExecutor, shape##_##type,   \
+                    DagShape::shape,                              \
+                    ThunkExecutor::Options::ReadyQueueType::type) \
+      ->MeasureProcessCPUTime()                                   \
+      ->Arg(16)                                                   \
+      ->Arg(64)                                                   \
+      ->Arg(256)                                                  \
+      ->Arg(1024)
+
+#define BENCHMARK_READY_QUEUE_TYPES(shape)      \
+  BENCHMARK_READY_QUEUE_TYPE(shape, kFifo);     \
+  BENCHMARK_READY_QUEUE_TYPE(shape, kLifo);     \
+  BENCHMARK_READY_QUEUE_TYPE(shape, kPriority); \
+  BENCHMARK_READY_QUEUE_TYPE(shape, kWorkStealing)
+
+BENCHMARK_READY_QUEUE_TYPES(kWide);
+BENCHMARK_READY_QUEUE_TYPES(kDeep);
+BENCHMARK_READY_QUEUE_TYPES(kRandom);
+
 }  // namespace
 }  // namespace xla::cpu
@@ -0,0 +1,94 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/runtime/thunk_profile.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/log/check.h"
+#include "xla/backends/cpu/runtime/thunk.h"
+#include "xla/backends/cpu/runtime/thunk.pb.h"
+
+namespace xla::cpu {
+
+ThunkProfile::ThunkProfile(size_t num_thunks, size_t num_executions)
+    : entries_(num_thunks),
+      num_executions_(num_executions),
+      num_started_executions_(0) {}
+
+bool ThunkProfile::StartExecution() {
+  // Check the counter before incrementing it to avoid contention on a hot path
+  // once we have recorded all requested executions.
+  if (num_started_executions_.load(std::memory_order_relaxed) >=
+      num_executions_) {
+    return false;
+  }
+  return num_started_executions_.fetch_add(1, std::memory_order_relaxed) <
+         num_executions_;
+}
+
+void ThunkProfile::Record(size_t index, int64_t time_ns) {
+  DCHECK_LT(index, entries_.size()) << "Thunk index is out of bounds";
+  entries_[index].num_records.fetch_add(1, std::memory_order_relaxed);
+  entries_[index].total_time_ns.fetch_add(time_ns, std::memory_order_relaxed);
+}
+
+int64_t ThunkProfile::num_records(size_t index) const {
+  DCHECK_LT(index, entries_.size()) << "Thunk index is out of bounds";
+  return entries_[index].num_records.load(std::memory_order_relaxed);
+}
+
+int64_t ThunkProfile::average_time_ns(size_t index) const {
+  DCHECK_LT(index, entries_.size()) << "Thunk index is out of bounds";
+  int64_t num_records = entries_[index].num_records.load();
+  return num_records ? entries_[index].total_time_ns.load() / num_records : 0;
+}
+
+ThunkProfileProto ThunkProfile::ToProto(
+    const ThunkSequence& thunk_sequence) const {
+  DCHECK_EQ(thunk_sequence.size(), entries_.size())
+      << "Thunk sequence size must match the number of profiled thunks";
+
+  ThunkProfileProto proto;
+  for (size_t i = 0; i < entries_.size(); ++i) {
+    const Thunk::Info& info = thunk_sequence[i]->info();
+
+    ThunkProfileProto::Entry* entry = proto.add_entries();
+    entry->mutable_info()->set_op_name(info.op_name);
+    entry->mutable_info()->set_module_name(info.module_name);
+    entry->mutable_info()->set_module_id(info.module_id);
+    entry->mutable_info()->set_cost(info.cost);
+    entry->set_num_executions(entries_[i].num_records.load());
+    entry->set_total_time_ns(entries_[i].total_time_ns.load());
+  }
+  return proto;
+}
+
+absl::flat_hash_map<std::string, int64_t> GetAverageThunkTimes(
+    const ThunkProfileProto& proto) {
+  absl::flat_hash_map<std::string, int64_t> times;
+  for (const ThunkProfileProto::Entry& entry : proto.entries()) {
+    if (entry.num_executions() == 0) continue;
+    times[entry.info().op_name()] =
+        entry.total_time_ns() / entry.num_executions();
+  }
+  return times;
+}
+
+}  // namespace xla::cpu
@@ -0,0 +1,78 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_BACKENDS_CPU_RUNTIME_THUNK_PROFILE_H_
+#define XLA_BACKENDS_CPU_RUNTIME_THUNK_PROFILE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "absl/container/fixed_array.h"
+#include "absl/container/flat_hash_map.h"
+#include "xla/backends/cpu/runtime/thunk.h"
+#include "xla/backends/cpu/runtime/thunk.pb.h"
+
+namespace xla::cpu {
+
+// ThunkProfile records the wall time of the thunks in a thunk sequence for the
+// first `num_executions` executions of the sequence. It is safe to record
+// thunk execution times concurrently from multiple threads.
+class ThunkProfile {
+ public:
+  ThunkProfile(size_t num_thunks, size_t num_executions);
+
+  // Returns true if the caller should record thunk execution times for the
+  // next execution of the thunk sequence.
+  bool StartExecution();
+
+  // Records the execution time of the thunk at the given index.
+  void Record(size_t index, int64_t time_ns);
+
+  size_t num_thunks() const { return entries_.size(); }
+  size_t num_executions() const { return num_executions_; }
+
+  // Returns the number of recorded executions of the thunk at the given index.
+  int64_t num_records(size_t index) const;
+
+  // Returns the average execution time of the thunk at the given index, or
+  // zero if there are no recorded executions.
+  int64_t average_time_ns(size_t index) const;
+
+  // Converts profile to a proto. Thunk sequence must be the one that was
+  // profiled, we use it to record thunks info that identifies them in later
+  // compilations.
+  ThunkProfileProto ToProto(const ThunkSequence& thunk_sequence) const;
+
+ private:
+  struct Entry {
+    std::atomic<int64_t> num_records = 0;
+    std::atomic<int64_t> total_time_ns = 0;
+  };
+
+  absl::FixedArray<Entry> entries_;
+  size_t num_executions_;
+  std::atomic<size_t> num_started_executions_;
+};
+
+// Returns the average execution time of thunks from the profile keyed by the
+// thunk op name. Thunks that were never executed are not included.
+absl::flat_hash_map<std::string, int64_t> GetAverageThunkTimes(
+    const ThunkProfileProto& proto);
+
+}  // namespace xla::cpu
+
+#endif  // XLA_BACKENDS_CPU_RUNTIME_THUNK_PROFILE_H_
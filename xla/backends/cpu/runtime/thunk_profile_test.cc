@@ -0,0 +1,96 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/runtime/thunk_profile.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "absl/container/flat_hash_map.h"
+#include "xla/backends/cpu/runtime/thunk.h"
+#include "xla/backends/cpu/runtime/thunk.pb.h"
+#include "xla/backends/cpu/runtime/thunk_testlib.h"
+#include "xla/runtime/buffer_use.h"
+#include "xla/service/buffer_assignment.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/test.h"
+#include "xla/tsl/platform/threadpool.h"
+
+namespace xla::cpu {
+namespace {
+
+TEST(ThunkProfileTest, StartExecution) {
+  ThunkProfile profile(/*num_thunks=*/1, /*num_executions=*/2);
+  EXPECT_TRUE(profile.StartExecution());
+  EXPECT_TRUE(profile.StartExecution());
+  EXPECT_FALSE(profile.StartExecution());
+  EXPECT_FALSE(profile.StartExecution());
+}
+
+TEST(ThunkProfileTest, RecordAndAverage) {
+  ThunkProfile profile(/*num_thunks=*/2, /*num_executions=*/2);
+  profile.Record(0, 100);
+  profile.Record(0, 300);
+
+  EXPECT_EQ(profile.num_records(0), 2);
+  EXPECT_EQ(profile.average_time_ns(0), 200);
+  EXPECT_EQ(profile.num_records(1), 0);
+  EXPECT_EQ(profile.average_time_ns(1), 0);
+}
+
+TEST(ThunkProfileTest, ConcurrentRecord) {
+  ThunkProfile profile(/*num_thunks=*/1, /*num_executions=*/1000);
+
+  {
+    tsl::thread::ThreadPool pool(tsl::Env::Default(), "profile", 8);
+    for (int64_t i = 0; i < 1000; ++i) {
+      pool.Schedule([&] {
+        if (profile.StartExecution()) profile.Record(0, 10);
+      });
+    }
+  }
+
+  EXPECT_EQ(profile.num_records(0), 1000);
+  EXPECT_EQ(profile.average_time_ns(0), 10);
+  EXPECT_FALSE(profile.StartExecution());
+}
+
+TEST(ThunkProfileTest, ToProto) {
+  BufferAllocation alloc(/*index=*/0, /*size=*/1024, /*color=*/0);
+  BufferAllocation::Slice slice(&alloc, /*offset=*/0, /*size=*/1024);
+
+  ThunkSequence sequence;
+  sequence.push_back(std::make_unique<BufferUseThunk>(BufferUse::Read(slice)));
+  sequence.push_back(std::make_unique<BufferUseThunk>(BufferUse::Read(slice)));
+
+  ThunkProfile profile(/*num_thunks=*/2, /*num_executions=*/1);
+  profile.Record(0, 100);
+
+  ThunkProfileProto proto = profile.ToProto(sequence);
+  ASSERT_EQ(proto.entries_size(), 2);
+  EXPECT_EQ(proto.entries(0).info().op_name(), "buffer-use");
+  EXPECT_EQ(proto.entries(0).num_executions(), 1);
+  EXPECT_EQ(proto.entries(0).total_time_ns(), 100);
+  EXPECT_EQ(proto.entries(1).num_executions(), 0);
+
+  absl::flat_hash_map<std::string, int64_t> times =
+      GetAverageThunkTimes(proto);
+  ASSERT_EQ(times.size(), 1);
+  EXPECT_EQ(times["buffer-use"], 100);
+}
+
+}  // namespace
+}  // namespace xla::cpu
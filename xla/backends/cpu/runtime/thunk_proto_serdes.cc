@@ -180,6 +180,7 @@ static InfoProto ThunkInfoToProto(const Thunk::Info& info) {
   proto.set_op_name(info.op_name);
   proto.set_module_name(info.module_name);
   proto.set_module_id(info.module_id);
+  proto.set_cost(info.cost);
   return proto;
 }
 
@@ -188,6 +189,7 @@ static absl::StatusOr<Thunk::Info> ThunkInfoFromProto(const InfoProto& proto) {
   info.op_name = proto.op_name();
   info.module_name = proto.module_name();
   info.module_id = proto.module_id();
+  info.cost = proto.cost();
   return info;
 }
 
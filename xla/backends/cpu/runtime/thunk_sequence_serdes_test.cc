@@ -1295,7 +1295,8 @@ class ThunkSequenceSerdesTest : public ::testing::Test {
 
     if (!(thunk_1.info().op_name == thunk_2.info().op_name &&
           thunk_1.info().module_name == thunk_2.info().module_name &&
-          thunk_1.info().module_id == thunk_2.info().module_id)) {
+          thunk_1.info().module_id == thunk_2.info().module_id &&
+          thunk_1.info().cost == thunk_2.info().cost)) {
       return false;
     }
 
@@ -15,12 +15,15 @@ limitations under the License.
 
 #include "xla/backends/cpu/runtime/topk_thunk.h"
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <utility>
 
 #include "absl/memory/memory.h"
 #include "absl/status/statusor.h"
+#include "xla/backends/cpu/runtime/parallel_loop_runner.h"
 #include "xla/backends/cpu/runtime/thunk.h"
 #include "xla/service/buffer_assignment.h"
 #include "xla/service/cpu/runtime_topk.h"
@@ -30,6 +33,10 @@ limitations under the License.
 
 namespace xla::cpu {
 
+// Minimum number of input elements for running TopK batches in parallel in the
+// intra-op thread pool. For smaller inputs thread pool overheads dominate.
+static constexpr int64_t kMinParallelTopKSize = 64 * 1024;
+
 TopKThunk::TopKThunk(Info info, BufferAllocation::Slice values,
                      BufferAllocation::Slice output,
                      BufferAllocation::Slice indices, int64_t batch_size,
@@ -62,11 +69,34 @@ tsl::AsyncValueRef<Thunk::ExecuteEvent> TopKThunk::Execute(
       se::DeviceMemoryBase indices,
       params.buffer_allocations->GetDeviceAddress(indices_buffer_));
 
-  __xla_cpu_runtime_TopKF32(batch_size_, input_size_, k_,
-                            reinterpret_cast<const float*>(values.opaque()),
-                            reinterpret_cast<float*>(output.opaque()),
-                            reinterpret_cast<int32_t*>(indices.opaque()));
-  return OkExecuteEvent();
+  const float* values_ptr = reinterpret_cast<const float*>(values.opaque());
+  float* output_ptr = reinterpret_cast<float*>(output.opaque());
+  int32_t* indices_ptr = reinterpret_cast<int32_t*>(indices.opaque());
+
+  if (params.intra_op_threadpool == nullptr || batch_size_ < 2 ||
+      batch_size_ * input_size_ < kMinParallelTopKSize) {
+    __xla_cpu_runtime_TopKF32(batch_size_, input_size_, k_, values_ptr,
+                              output_ptr, indices_ptr);
+    return OkExecuteEvent();
+  }
+
+  // Split batch dimension into one tile per thread, so that each task reuses
+  // its scratch buffer for all batch rows in the tile.
+  ParallelLoopRunner runner(params.intra_op_threadpool);
+  size_t num_threads = std::max<size_t>(1, runner.num_threads());
+  size_t tile = (batch_size_ + num_threads - 1) / num_threads;
+
+  runner.Parallelize(
+      batch_size_, tile,
+      [input_size = input_size_, k = k_, values_ptr, output_ptr, indices_ptr](
+          size_t offset, size_t extent) {
+        __xla_cpu_runtime_TopKF32(extent, input_size, k,
+                                  values_ptr + offset * input_size,
+                                  output_ptr + offset * k,
+                                  indices_ptr + offset * k);
+      });
+
+  return ParallelLoopRunner::TakeDoneEvent(std::move(runner));
 }
 
 }  // namespace xla::cpu
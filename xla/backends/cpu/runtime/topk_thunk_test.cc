@@ -0,0 +1,120 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+
+#include "xla/backends/cpu/runtime/topk_thunk.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <tuple>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "xla/backends/cpu/runtime/buffer_allocations.h"
+#include "xla/backends/cpu/runtime/thunk.h"
+#include "xla/backends/cpu/runtime/thunk_testlib.h"
+#include "xla/literal.h"
+#include "xla/literal_util.h"
+#include "xla/service/buffer_assignment.h"
+#include "xla/shape_util.h"
+#include "xla/tsl/concurrency/async_value_ref.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/tsl/platform/test.h"
+#include "xla/tsl/platform/threadpool.h"
+#include "xla/xla_data.pb.h"
+
+#define EIGEN_USE_THREADS
+#include "unsupported/Eigen/CXX11/Tensor"
+
+namespace xla::cpu {
+namespace {
+
+// Parametrized by `k` and by whether we run in the intra-op thread pool.
+class TopKThunkTest : public testing::TestWithParam<std::tuple<int64_t, bool>> {
+};
+
+TEST_P(TopKThunkTest, MatchesPartialSort) {
+  auto [k, use_threadpool] = GetParam();
+
+  constexpr int64_t kBatchSize = 8;
+  constexpr int64_t kInputSize = 16 * 1024;
+
+  // Use a narrow range of values to get many ties between elements.
+  std::vector<float> input(kBatchSize * kInputSize);
+  for (int64_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<float>((i * 7919) % 1021) - 510.0f;
+  }
+
+  auto values =
+      LiteralUtil::CreateFromDimensions(F32, {kBatchSize, kInputSize});
+  std::copy(input.begin(), input.end(), values.data<float>().begin());
+  auto output = LiteralUtil::CreateFromDimensions(F32, {kBatchSize, k});
+  auto indices = LiteralUtil::CreateFromDimensions(S32, {kBatchSize, k});
+
+  BufferAllocations allocations =
+      CreateBufferAllocations(values, output, indices);
+
+  auto [values_alloc, output_alloc, indices_alloc] =
+      CreateBufferAllocation(values, output, indices);
+  auto [values_slice, output_slice, indices_slice] =
+      CreateBufferAllocationSlice(values_alloc, output_alloc, indices_alloc);
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto thunk,
+      TopKThunk::Create({"topk"}, values_slice, output_slice, indices_slice,
+                        kBatchSize, kInputSize, k));
+
+  tsl::thread::ThreadPool threads(tsl::Env::Default(), "test", 8);
+  Eigen::ThreadPoolDevice device(threads.AsEigenThreadPool(),
+                                 threads.NumThreads());
+
+  Thunk::ExecuteParams params;
+  params.buffer_allocations = &allocations;
+  params.intra_op_threadpool = use_threadpool ? &device : nullptr;
+
+  auto execute_event = thunk->Execute(params);
+  tsl::BlockUntilReady(execute_event);
+  ASSERT_FALSE(execute_event.IsError()) << execute_event.GetError();
+
+  std::vector<int32_t> expected_indices(kInputSize);
+  for (int64_t batch = 0; batch < kBatchSize; ++batch) {
+    const float* row = input.data() + batch * kInputSize;
+    std::iota(expected_indices.begin(), expected_indices.end(), 0);
+    std::partial_sort(expected_indices.begin(), expected_indices.begin() + k,
+                      expected_indices.end(), [&](int32_t a, int32_t b) {
+                        return row[a] == row[b] ? a < b : row[a] > row[b];
+                      });
+
+    for (int64_t i = 0; i < k; ++i) {
+      ASSERT_EQ(indices.Get<int32_t>({batch, i}), expected_indices[i])
+          << "batch=" << batch << " i=" << i;
+      ASSERT_EQ(output.Get<float>({batch, i}), row[expected_indices[i]])
+          << "batch=" << batch << " i=" << i;
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    TopKThunk, TopKThunkTest,
+    testing::Combine(testing::Values(1, 16, 4096, 16 * 1024), testing::Bool()),
+    [](const testing::TestParamInfo<TopKThunkTest::ParamType>& info) {
+      return absl::StrCat("k_", std::get<0>(info.param),
+                          std::get<1>(info.param) ? "_threadpool" : "");
+    });
+
+}  // namespace
+}  // namespace xla::cpu
@@ -23,6 +23,7 @@ limitations under the License.
 #include <limits>
 #include <new>
 #include <optional>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 
@@ -44,17 +45,46 @@ namespace xla::cpu {
 // partitions processed by parallel workers.
 class WorkQueue {
  public:
-  WorkQueue(size_t num_tasks, size_t num_partitions);
+  // Scheduling policy defines how workers claim tasks from their own
+  // partitions (see `Worker::Pop` for details).
+  enum class SchedulingPolicy {
+    // Workers claim tasks from their own partition one at a time.
+    kDynamic,
+    // Workers claim half of the remaining tasks in their own partition at a
+    // time (similar to OpenMP guided scheduling), which amortizes atomic
+    // operations over exponentially decreasing chunks of tasks, and leaves
+    // the partition tail for work stealing workers.
+    kGuided,
+  };
+
+  WorkQueue(size_t num_tasks, size_t num_partitions,
+            SchedulingPolicy policy = SchedulingPolicy::kDynamic);
 
   // Returns the next task in the given partition. Returns std::nullopt
   // if the partition is complete.
   std::optional<size_t> Pop(size_t partition_index);
 
+  // Claims half (rounded up) of the remaining tasks in the given partition and
+  // returns them as a [begin, end) task range. Returns std::nullopt if the
+  // partition is complete.
+  std::optional<std::pair<size_t, size_t>> PopHalf(size_t partition_index);
+
+  // Returns the index of the partition with the largest number of remaining
+  // tasks, or std::nullopt if all partitions are complete. Partitions are
+  // scanned starting from `start_index` to break ties between concurrent
+  // work stealing workers.
+  std::optional<size_t> FindLargestPartition(size_t start_index) const;
+
+  // Returns the number of remaining tasks in the given partition.
+  size_t num_remaining_tasks(size_t partition_index) const;
+
   // Return the partition [begin, end) task range.
   std::pair<size_t, size_t> partition_range(size_t partition_index) const;
 
   size_t num_partitions() const { return partitions_.size(); }
 
+  SchedulingPolicy policy() const { return policy_; }
+
  private:
   friend class Worker;
 
@@ -89,14 +119,18 @@ class WorkQueue {
   size_t DecrementWorkStealingWorkers(size_t max_workers);
 
   absl::FixedArray<Partition, 32> partitions_;
+  SchedulingPolicy policy_;
   alignas(kAtomicAlignment) std::atomic<bool> empty_;
   alignas(kAtomicAlignment) std::atomic<size_t> num_work_stealing_workers_;
 };
 
 // Worker processes tasks from the work queue starting from the assigned
-// work partition. Once the assigned partition is complete it tries to pop
-// the task from the next partition. Once the work queue is empty (the worker
-// wraps around to the initial partition) it returns and empty task.
+// work partition. Once the assigned partition is complete it switches to the
+// work stealing mode: it finds the partition with the largest number of
+// remaining tasks, and claims half of them into the local task range that it
+// processes without touching shared atomic counters. This adaptively splits
+// large partitions when tasks have skewed costs. Once all partitions are
+// complete, it returns an empty task.
 class Worker {
  public:
   Worker(size_t worker_index, WorkQueue* queue);
@@ -132,8 +166,15 @@ class Worker {
                                      uint16_t start_index, uint16_t end_index);
 
   size_t worker_index_;
-  size_t partition_index_;
   WorkQueue* queue_;
+
+  // Tasks claimed from the work queue with a single atomic operation: a
+  // chunk of the worker's own partition in guided scheduling mode, or a
+  // stolen half of another partition.
+  size_t range_begin_ = 0;
+  size_t range_end_ = 0;
+
+  bool work_stealing_ = false;
 };
 
 inline void WorkQueue::Partition::Initialize(size_t begin, size_t end) {
@@ -142,8 +183,10 @@ inline void WorkQueue::Partition::Initialize(size_t begin, size_t end) {
   this->end = end;
 }
 
-inline WorkQueue::WorkQueue(size_t num_tasks, size_t num_partitions)
+inline WorkQueue::WorkQueue(size_t num_tasks, size_t num_partitions,
+                            SchedulingPolicy policy)
     : partitions_(num_partitions),
+      policy_(policy),
       empty_(num_tasks == 0),
       num_work_stealing_workers_(0) {
   size_t partition_size =
@@ -171,6 +214,52 @@ inline std::optional<size_t> WorkQueue::Pop(size_t partition_index) {
                                                     : std::make_optional(index);
 }
 
+inline std::optional<std::pair<size_t, size_t>> WorkQueue::PopHalf(
+    size_t partition_index) {
+  DCHECK(partition_index < partitions_.size()) << "Invalid partition index";
+  Partition& partition = partitions_.data()[partition_index];
+
+  // Check if partition is already empty.
+  size_t index = partition.index.load(std::memory_order_relaxed);
+  if (ABSL_PREDICT_FALSE(index >= partition.end)) {
+    return std::nullopt;
+  }
+
+  // Try to acquire half of the remaining tasks. Concurrent workers might
+  // acquire tasks in between, so we might get fewer tasks than we asked for.
+  size_t count = tsl::MathUtil::CeilOfRatio<size_t>(partition.end - index, 2);
+  index = partition.index.fetch_add(count, std::memory_order_relaxed);
+  if (ABSL_PREDICT_FALSE(index >= partition.end)) {
+    return std::nullopt;
+  }
+
+  return std::make_pair(index, std::min(index + count, partition.end));
+}
+
+inline size_t WorkQueue::num_remaining_tasks(size_t partition_index) const {
+  DCHECK(partition_index < partitions_.size()) << "Invalid partition index";
+  const Partition& partition = partitions_.data()[partition_index];
+  size_t index = partition.index.load(std::memory_order_relaxed);
+  return index >= partition.end ? 0 : partition.end - index;
+}
+
+inline std::optional<size_t> WorkQueue::FindLargestPartition(
+    size_t start_index) const {
+  std::optional<size_t> largest;
+  size_t largest_size = 0;
+
+  size_t n = partitions_.size();
+  for (size_t i = 0, index = start_index % n; i < n; ++i) {
+    if (size_t size = num_remaining_tasks(index); size > largest_size) {
+      largest = index;
+      largest_size = size;
+    }
+    if (ABSL_PREDICT_FALSE(++index == n)) index = 0;
+  }
+
+  return largest;
+}
+
 inline std::pair<size_t, size_t> WorkQueue::partition_range(
     size_t partition_index) const {
   DCHECK(partition_index < partitions_.size()) << "Invalid partition index";
@@ -195,36 +284,48 @@ inline size_t WorkQueue::DecrementWorkStealingWorkers(size_t max_workers) {
 }
 
 inline Worker::Worker(size_t worker_index, WorkQueue* queue)
-    : worker_index_(worker_index),
-      partition_index_(worker_index),
-      queue_(queue) {}
+    : worker_index_(worker_index), queue_(queue) {}
 
 inline std::optional<size_t> Worker::Pop() {
-  std::optional<size_t> task = queue_->Pop(partition_index_);
-  if (ABSL_PREDICT_TRUE(task)) return task;
+  // Process tasks claimed from the work queue by one of the previous pops.
+  if (ABSL_PREDICT_TRUE(range_begin_ < range_end_)) {
+    return range_begin_++;
+  }
 
-  // If we didn't find a task in the initially assigned partition, notify the
-  // work queue that we are switching to work stealing mode.
-  if (ABSL_PREDICT_FALSE(partition_index_ == worker_index_)) {
+  // Try to pop the next task from the initially assigned partition.
+  if (ABSL_PREDICT_TRUE(!work_stealing_)) {
+    if (queue_->policy() == WorkQueue::SchedulingPolicy::kDynamic) {
+      std::optional<size_t> task = queue_->Pop(worker_index_);
+      if (ABSL_PREDICT_TRUE(task)) return task;
+    } else if (auto range = queue_->PopHalf(worker_index_)) {
+      std::tie(range_begin_, range_end_) = *range;
+      return range_begin_++;
+    }
+
+    // If we didn't find a task in the initially assigned partition, notify
+    // the work queue that we are switching to work stealing mode.
+    work_stealing_ = true;
     queue_->NotifyWorkStealingWorker();
   }
 
-  while (!task.has_value() && !queue_->IsEmpty()) {
-    // Wrap around to the first partition.
-    if (ABSL_PREDICT_FALSE(++partition_index_ >= queue_->num_partitions())) {
-      partition_index_ = 0;
-    }
+  // Steal half of the remaining tasks from the largest partition.
+  while (!queue_->IsEmpty()) {
+    std::optional<size_t> victim =
+        queue_->FindLargestPartition(worker_index_ + 1);
 
-    // We checked all partitions and got back to the partition we started from.
-    if (ABSL_PREDICT_FALSE(partition_index_ == worker_index_)) {
+    // We checked all partitions and all of them are complete.
+    if (ABSL_PREDICT_FALSE(!victim.has_value())) {
       queue_->SetEmpty();
       break;
     }
 
-    task = queue_->Pop(partition_index_);
+    if (auto range = queue_->PopHalf(*victim)) {
+      std::tie(range_begin_, range_end_) = *range;
+      return range_begin_++;
+    }
   }
 
-  return task;
+  return std::nullopt;
 }
 
 template <typename ParallelTask>
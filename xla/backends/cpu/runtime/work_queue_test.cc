@@ -102,6 +102,42 @@ TEST(WorkQueueTest, WorkQueueEmptyPartitions) {
   }
 }
 
+TEST(WorkQueueTest, WorkQueuePopHalf) {
+  auto task_range = [](size_t begin, size_t end) {
+    return std::make_optional(std::make_pair(begin, end));
+  };
+
+  WorkQueue queue(20, 2);
+
+  EXPECT_EQ(queue.PopHalf(0), task_range(0, 5));
+  EXPECT_EQ(queue.PopHalf(0), task_range(5, 8));
+  EXPECT_EQ(queue.Pop(0), std::make_optional(8));
+  EXPECT_EQ(queue.PopHalf(0), task_range(9, 10));
+  EXPECT_EQ(queue.PopHalf(0), std::nullopt);
+  EXPECT_EQ(queue.num_remaining_tasks(0), 0);
+  EXPECT_EQ(queue.num_remaining_tasks(1), 10);
+}
+
+TEST(WorkQueueTest, WorkQueueFindLargestPartition) {
+  WorkQueue queue(9, 3);
+  EXPECT_EQ(queue.FindLargestPartition(0), std::make_optional(0));
+  EXPECT_EQ(queue.FindLargestPartition(1), std::make_optional(1));
+
+  queue.Pop(1);
+  queue.Pop(2);
+  EXPECT_EQ(queue.FindLargestPartition(1), std::make_optional(0));
+
+  while (queue.Pop(0)) {
+  }
+  while (queue.Pop(1)) {
+  }
+  EXPECT_EQ(queue.FindLargestPartition(0), std::make_optional(2));
+
+  while (queue.Pop(2)) {
+  }
+  EXPECT_EQ(queue.FindLargestPartition(0), std::nullopt);
+}
+
 TEST(WorkQueueTest, WorkQueue) {
   for (size_t size : {1, 2, 4, 8, 16, 32, 64}) {
     for (size_t num_partitions : {1, 2, 3, 4, 5, 6, 7, 8}) {
@@ -122,13 +158,16 @@ TEST(WorkQueueTest, WorkQueue) {
   }
 }
 
-TEST(WorkQueueTest, Worker) {
+class WorkerTest
+    : public testing::TestWithParam<WorkQueue::SchedulingPolicy> {};
+
+TEST_P(WorkerTest, Worker) {
   for (size_t size : {1, 2, 4, 8, 16, 32, 64}) {
     for (size_t num_partitions : {1, 2, 3, 4, 5, 6, 7, 8}) {
       // We check that no matter what is the initial partition, the worker
       // processes all tasks in the queue.
       for (size_t i = 0; i < num_partitions; ++i) {
-        WorkQueue queue(size, num_partitions);
+        WorkQueue queue(size, num_partitions, GetParam());
         Worker worker(i, &queue);
 
         std::vector<size_t> expected_tasks(size);
@@ -146,32 +185,57 @@ TEST(WorkQueueTest, Worker) {
   }
 }
 
-TEST(WorkQueueTest, WorkerConcurrency) {
+TEST_P(WorkerTest, WorkerConcurrency) {
   tsl::thread::ThreadPool threads(tsl::Env::Default(), "test", 8);
 
   size_t size = 1024;
   size_t num_partitions = 128;
 
-  WorkQueue queue(size, num_partitions);
+  WorkQueue queue(size, num_partitions, GetParam());
 
-  // Check that we pop exactly `size` tasks.
-  std::atomic<size_t> num_tasks(0);
+  // Check that we pop every task exactly once.
+  std::vector<std::atomic<size_t>> num_pops(size);
 
   absl::BlockingCounter counter(num_partitions);
   for (size_t i = 0; i < num_partitions; ++i) {
     threads.Schedule([&, i] {
       Worker worker(i, &queue);
       while (std::optional<size_t> task = worker.Pop()) {
-        ++num_tasks;
+        ++num_pops[*task];
       }
       counter.DecrementCount();
     });
   }
 
   counter.Wait();
-  EXPECT_EQ(num_tasks.load(), size);
+  EXPECT_TRUE(absl::c_all_of(num_pops, [](auto& n) { return n.load() == 1; }));
 }
 
+TEST(WorkQueueTest, WorkerStealsFromLargestPartition) {
+  WorkQueue queue(/*num_tasks=*/12, /*num_partitions=*/3);
+
+  // Partially drain partitions 0 and 2, so that partition 1 is the largest.
+  while (queue.Pop(0)) {
+  }
+  queue.Pop(2);
+  queue.Pop(2);
+
+  // Worker 0 steals half of the partition 1.
+  Worker worker(0, &queue);
+  EXPECT_EQ(worker.Pop(), std::make_optional(4));
+  EXPECT_EQ(queue.num_remaining_tasks(1), 2);
+  EXPECT_EQ(worker.Pop(), std::make_optional(5));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    WorkerTest, WorkerTest,
+    testing::Values(WorkQueue::SchedulingPolicy::kDynamic,
+                    WorkQueue::SchedulingPolicy::kGuided),
+    [](const testing::TestParamInfo<WorkQueue::SchedulingPolicy>& info) {
+      return info.param == WorkQueue::SchedulingPolicy::kDynamic ? "dynamic"
+                                                                 : "guided";
+    });
+
 TEST(WorkQueueTest, WorkerParallelize) {
   tsl::thread::ThreadPool threads(tsl::Env::Default(), "test", 8);
   Eigen::ThreadPoolDevice device(threads.AsEigenThreadPool(), 8);
@@ -239,5 +303,61 @@ BENCHMARK(BM_PopTaskMultiThreaded)
     ->Arg(32)
     ->Arg(64);
 
+// Simulates a ragged loop (i.e. gather or scatter with ragged rows) where
+// first 1/8 of the tasks are 64x more expensive than the rest, so that
+// workers assigned to the first partitions get most of the work.
+static void BM_SkewedTasksMultiThreaded(benchmark::State& state,
+                                        WorkQueue::SchedulingPolicy policy) {
+  size_t num_threads = state.range(0);
+  tsl::thread::ThreadPool threads(tsl::Env::Default(), "benchmark",
+                                  num_threads);
+
+  static constexpr size_t kNumTasks = 1024 * 10;
+
+  auto task = [](size_t task_index) {
+    size_t cost = task_index < kNumTasks / 8 ? 64 : 1;
+    for (size_t i = 0; i < cost * 16; ++i) {
+      benchmark::DoNotOptimize(i);
+    }
+  };
+
+  for (auto _ : state) {
+    absl::BlockingCounter counter(num_threads);
+    WorkQueue queue(kNumTasks, /*num_partitions=*/num_threads, policy);
+
+    for (size_t i = 0; i < num_threads; ++i) {
+      threads.Schedule([i, &queue, &counter, &task] {
+        Worker worker(i, &queue);
+        while (std::optional<size_t> task_index = worker.Pop()) {
+          task(*task_index);
+        }
+        counter.DecrementCount();
+      });
+    }
+
+    counter.Wait();
+  }
+
+  state.SetItemsProcessed(state.iterations() * kNumTasks);
+}
+
+BENCHMARK_CAPTURE(BM_SkewedTasksMultiThreaded, dynamic,
+                  WorkQueue::SchedulingPolicy::kDynamic)
+    ->MeasureProcessCPUTime()
+    ->UseRealTime()
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->Arg(16);
+
+BENCHMARK_CAPTURE(BM_SkewedTasksMultiThreaded, guided,
+                  WorkQueue::SchedulingPolicy::kGuided)
+    ->MeasureProcessCPUTime()
+    ->UseRealTime()
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->Arg(16);
+
 }  // namespace
 }  // namespace xla::cpu
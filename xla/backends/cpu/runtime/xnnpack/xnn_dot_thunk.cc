@@ -36,6 +36,7 @@ limitations under the License.
 #include "xla/primitive_util.h"
 #include "xla/service/buffer_assignment.h"
 #include "xla/shape.h"
+#include "xla/stream_executor/device_memory.h"
 #include "xla/tsl/platform/errors.h"
 #include "xla/tsl/platform/logging.h"
 #include "xla/tsl/platform/statusor.h"
@@ -45,7 +46,9 @@ limitations under the License.
 namespace xla::cpu {
 
 absl::StatusOr<xnn_subgraph_t> XnnDotThunk::BuildDotSubgraph(
-    absl::Span<const Argument> arguments, absl::Span<const Result> results) {
+    absl::Span<const Argument> arguments, absl::Span<const Result> results,
+    absl::Span<const se::DeviceMemoryBase> arguments_buffers,
+    absl::Span<const se::DeviceMemoryBase> results_buffers) {
   xnn_subgraph_t subgraph = nullptr;
   XNN_RETURN_IF_ERROR(xnn_create_subgraph(/*external_value_ids=*/3,
                                           /*flags=*/0, &subgraph));
@@ -75,9 +78,18 @@ absl::StatusOr<xnn_subgraph_t> XnnDotThunk::BuildDotSubgraph(
       subgraph, input_dtype, lhs_dims.size(), lhs_dims.data(), nullptr,
       /*external_id=*/0, XNN_VALUE_FLAG_EXTERNAL_INPUT, &lhs_id));
 
-  XNN_RETURN_IF_ERROR(xnn_define_tensor_value(
-      subgraph, input_dtype, rhs_dims.size(), rhs_dims.data(), nullptr,
-      /*external_id=*/1, XNN_VALUE_FLAG_EXTERNAL_INPUT, &rhs_id));
+  // Constant rhs (weights) is captured by value, so that XNNPACK can pack it
+  // once when creating the runtime, instead of packing it on every execution.
+  if (IsStaticRhs(dot_slices_)) {
+    XNN_RETURN_IF_ERROR(xnn_define_tensor_value(
+        subgraph, input_dtype, rhs_dims.size(), rhs_dims.data(),
+        /*data=*/arguments_buffers[1].opaque(),
+        /*external_id=*/1, /*flags=*/0, &rhs_id));
+  } else {
+    XNN_RETURN_IF_ERROR(xnn_define_tensor_value(
+        subgraph, input_dtype, rhs_dims.size(), rhs_dims.data(), nullptr,
+        /*external_id=*/1, XNN_VALUE_FLAG_EXTERNAL_INPUT, &rhs_id));
+  }
 
   XNN_RETURN_IF_ERROR(xnn_define_tensor_value(
       subgraph, output_dtype, out_dims.size(), out_dims.data(), nullptr,
@@ -113,6 +125,17 @@ absl::StatusOr<std::unique_ptr<XnnDotThunk>> XnnDotThunk::Create(
                       std::move(dot_shape), std::move(dot_canonical_dims)));
 }
 
+bool XnnDotThunk::IsStaticRhs(const DotSlices& slices) {
+  const BufferAllocation* allocation = slices.rhs_buffer.allocation();
+  return allocation != nullptr && allocation->is_constant() &&
+         slices.rhs_shape.element_type() == F32;
+}
+
+static std::vector<int64_t> DotByValueArguments(const DotSlices& slices) {
+  if (XnnDotThunk::IsStaticRhs(slices)) return {1};
+  return {};
+}
+
 static std::vector<XnnFusionThunk::Argument> DotArguments(
     const DotSlices& slices) {
   return {XnnFusionThunk::Argument{slices.lhs_buffer, slices.lhs_shape},
@@ -130,8 +153,12 @@ XnnDotThunk::XnnDotThunk(Options options, Info info,
     : XnnFusionThunk(
           XnnFusionKind::kDot, std::move(options), std::move(info),
           DotArguments(dot_slices), DotResults(dot_slices),
-          Builder(std::bind(&XnnDotThunk::BuildDotSubgraph, this,
-                            std::placeholders::_1, std::placeholders::_2))),
+          OneUseBuilder(std::bind(&XnnDotThunk::BuildDotSubgraph, this,
+                                  std::placeholders::_1, std::placeholders::_2,
+                                  std::placeholders::_3,
+                                  std::placeholders::_4)),
+          /*by_value_arguments=*/DotByValueArguments(dot_slices),
+          /*by_value_results=*/{}),
       dot_dimensions_(std::move(dot_dimensions)),
       dot_slices_(std::move(dot_slices)),
       dot_shape_(std::move(dot_shape)),
@@ -17,6 +17,7 @@ limitations under the License.
 #define XLA_BACKENDS_CPU_RUNTIME_XNNPACK_XNN_DOT_THUNK_H_
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -28,6 +29,7 @@ limitations under the License.
 #include "xla/backends/cpu/runtime/xnnpack/xnn_fusion_thunk.h"
 #include "xla/service/buffer_assignment.h"
 #include "xla/shape.h"
+#include "xla/stream_executor/device_memory.h"
 
 namespace xla::cpu {
 
@@ -43,6 +45,12 @@ class XnnDotThunk final : public XnnFusionThunk {
   DotDimensionNumbers dot_dimensions() const { return dot_dimensions_; }
   DotSlices dot_slices() const { return dot_slices_; }
 
+  // Returns true if the dot rhs operand is an F32 constant owned by the
+  // executable. Such rhs is captured by value by the XNNPACK subgraph as a
+  // static tensor, which allows XNNPACK to pack weights once and reuse them for
+  // all executions.
+  static bool IsStaticRhs(const DotSlices& slices);
+
  protected:
   std::string fusion_kind() const final;
   std::string fusion_description() const final;
@@ -59,7 +67,9 @@ class XnnDotThunk final : public XnnFusionThunk {
               DotCanonicalDims dot_canonical_dims);
 
   absl::StatusOr<xnn_subgraph_t> BuildDotSubgraph(
-      absl::Span<const Argument> arguments, absl::Span<const Result> results);
+      absl::Span<const Argument> arguments, absl::Span<const Result> results,
+      absl::Span<const se::DeviceMemoryBase> arguments_buffers,
+      absl::Span<const se::DeviceMemoryBase> results_buffers);
 
   DotDimensionNumbers dot_dimensions_;
   DotSlices dot_slices_;
@@ -23,7 +23,9 @@ limitations under the License.
 #include <vector>
 
 #include "xnnpack.h"
+#include "absl/algorithm/container.h"
 #include "absl/base/optimization.h"
+#include "absl/base/thread_annotations.h"
 #include "absl/container/inlined_vector.h"
 #include "absl/functional/function_ref.h"
 #include "absl/log/check.h"
@@ -31,6 +33,7 @@ limitations under the License.
 #include "absl/status/statusor.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
 #include "pthreadpool.h"
 #include "xla/backends/cpu/runtime/parallel_loop_runner.h"
@@ -101,6 +104,9 @@ struct XnnFusionThunk::XnnRuntime {
   std::unique_ptr<ParallelLoopRunner> runner;
   pthreadpool_t threadpool = nullptr;
 
+  // Addresses of the arguments captured by value by the XNNPACK subgraph.
+  absl::InlinedVector<const void*, 2> captured_arguments;
+
   xnn_subgraph_t subgraph = nullptr;
   xnn_workspace_t workspace = nullptr;
   xnn_runtime_t runtime = nullptr;
@@ -124,6 +130,7 @@ auto XnnFusionThunk::XnnRuntime::operator=(XnnRuntime&& other) -> XnnRuntime& {
   other.runtime = nullptr;
 
   runner = std::move(other.runner);
+  captured_arguments = std::move(other.captured_arguments);
   return *this;
 }
 
@@ -176,6 +183,19 @@ void XnnFusionThunk::XnnRuntime::Destroy() {
   if (owned_threadpool) pthreadpool_destroy(threadpool);
 }
 
+// XNNPACK weights cache shared by all pooled runtimes of the fusion.
+struct XnnFusionThunk::XnnWeightsCache {
+  ~XnnWeightsCache() {
+    if (cache != nullptr) XNN_LOG_IF_ERROR(xnn_delete_weights_cache(cache));
+  }
+
+  // Runtimes are created concurrently by the object pool, and the cache must
+  // not be finalized while some other runtime is packing weights into it.
+  absl::Mutex mu;
+  xnn_weights_cache_t cache ABSL_GUARDED_BY(mu) = nullptr;
+  bool finalized ABSL_GUARDED_BY(mu) = false;
+};
+
 absl::StatusOr<XnnFusionThunk::XnnRuntime> XnnFusionThunk::CreateXnnRuntime(
     const Eigen::ThreadPoolDevice* device, bool one_use,
     absl::FunctionRef<absl::StatusOr<xnn_subgraph_t>()> builder) {
@@ -208,15 +228,50 @@ absl::StatusOr<XnnFusionThunk::XnnRuntime> XnnFusionThunk::CreateXnnRuntime(
 
   XNN_RETURN_IF_ERROR(xnn_create_workspace(&runtime.workspace));
 
-  XNN_RETURN_IF_ERROR(
-      xnn_create_runtime_v4(runtime.subgraph, nullptr, runtime.workspace,
-                            runtime.threadpool, 0, &runtime.runtime));
+  // One-use runtimes capture weights that change between executions, so we
+  // don't cache their packed weights.
+  if (one_use || weights_cache_ == nullptr) {
+    XNN_RETURN_IF_ERROR(
+        xnn_create_runtime_v4(runtime.subgraph, nullptr, runtime.workspace,
+                              runtime.threadpool, 0, &runtime.runtime));
+  } else {
+    absl::MutexLock lock(&weights_cache_->mu);
+    if (weights_cache_->cache == nullptr) {
+      XNN_RETURN_IF_ERROR(xnn_create_weights_cache(&weights_cache_->cache));
+    }
+
+    XNN_RETURN_IF_ERROR(xnn_create_runtime_v4(
+        runtime.subgraph, weights_cache_->cache, runtime.workspace,
+        runtime.threadpool, 0, &runtime.runtime));
+
+    // All pooled runtimes pack the same constant weights, so after the first
+    // runtime the cache has everything and only serves lookups. Soft
+    // finalization keeps the packed weights where they are.
+    if (!weights_cache_->finalized) {
+      XNN_RETURN_IF_ERROR(xnn_finalize_weights_cache(
+          weights_cache_->cache, xnn_weights_cache_finalization_kind_soft));
+      weights_cache_->finalized = true;
+    }
+  }
 
   XNN_RETURN_IF_ERROR(xnn_reshape_runtime(runtime.runtime));
 
   return {std::move(runtime)};
 }
 
+// Returns true if all arguments captured by value are constants, and no
+// results are captured by value.
+static bool CapturesOnlyConstants(
+    absl::Span<const XnnFusionThunk::Argument> arguments,
+    absl::Span<const int64_t> by_value_arguments,
+    absl::Span<const int64_t> by_value_results) {
+  if (!by_value_results.empty()) return false;
+  return absl::c_all_of(by_value_arguments, [&](int64_t id) {
+    const BufferAllocation* allocation = arguments[id].slice.allocation();
+    return allocation != nullptr && allocation->is_constant();
+  });
+}
+
 absl::StatusOr<std::unique_ptr<XnnFusionThunk>> XnnFusionThunk::Create(
     Options options, Info info, std::vector<Argument> arguments,
     std::vector<Result> results, Builder builder) {
@@ -249,7 +304,9 @@ XnnFusionThunk::XnnFusionThunk(XnnFusionKind kind, Options options, Info info,
       results_(std::move(results)),
       builder_(std::move(builder)),
       xnn_fusion_kind_(kind),
-      xnn_runtime_pool_([this](const Eigen::ThreadPoolDevice* device) {
+      xnn_runtime_pool_([this](const Eigen::ThreadPoolDevice* device,
+                               absl::Span<const se::DeviceMemoryBase>,
+                               absl::Span<const se::DeviceMemoryBase>) {
         return CreateXnnRuntime(device, /*one_use=*/false, [this] {
           return builder_(arguments_, results_);
         });
@@ -269,10 +326,39 @@ XnnFusionThunk::XnnFusionThunk(XnnFusionKind kind, Options options, Info info,
       xnn_fusion_kind_(kind),
       by_value_arguments_(by_value_arguments.begin(), by_value_arguments.end()),
       by_value_results_(by_value_results.begin(), by_value_results.end()),
-      xnn_runtime_pool_(nullptr) {}
+      captures_only_constants_(CapturesOnlyConstants(
+          arguments_, by_value_arguments, by_value_results)),
+      weights_cache_(captures_only_constants_ && !by_value_arguments.empty()
+                         ? std::make_unique<XnnWeightsCache>()
+                         : nullptr),
+      xnn_runtime_pool_(
+          [this](const Eigen::ThreadPoolDevice* device,
+                 absl::Span<const se::DeviceMemoryBase> arguments_buffers,
+                 absl::Span<const se::DeviceMemoryBase> results_buffers)
+              -> absl::StatusOr<XnnRuntime> {
+            TF_ASSIGN_OR_RETURN(
+                XnnRuntime runtime,
+                CreateXnnRuntime(device, /*one_use=*/false, [&, this] {
+                  return one_use_builder_(arguments_, results_,
+                                          arguments_buffers, results_buffers);
+                }));
+            runtime.captured_arguments = CapturedArguments(arguments_buffers);
+            return {std::move(runtime)};
+          }) {}
 
 XnnFusionThunk::~XnnFusionThunk() = default;
 
+absl::InlinedVector<const void*, 2> XnnFusionThunk::CapturedArguments(
+    absl::Span<const se::DeviceMemoryBase> arguments_buffers) const {
+  absl::InlinedVector<const void*, 2> captured;
+  for (size_t i = 0; i < arguments_buffers.size(); ++i) {
+    if (by_value_arguments_.contains(i)) {
+      captured.push_back(arguments_buffers[i].opaque());
+    }
+  }
+  return captured;
+}
+
 XnnFusionThunk::BufferUses XnnFusionThunk::buffer_uses() const {
   BufferUses buffer_uses;
   for (const Argument& argument : arguments_) {
@@ -337,24 +423,33 @@ tsl::AsyncValueRef<XnnFusionThunk::ExecuteEvent> XnnFusionThunk::Execute(
 
   const Eigen::ThreadPoolDevice* device = params.intra_op_threadpool;
 
-  if (ABSL_PREDICT_TRUE(builder_)) {
+  if (ABSL_PREDICT_TRUE(builder_ || captures_only_constants_)) {
     // Borrow XNNPACK runtime from the pool.
-    TF_ASSIGN_OR_RETURN(auto runtime, xnn_runtime_pool_.GetOrCreate(device));
-    auto executed = invoke(*runtime);
-
-    // Do not return runtime to the pool until the execution is done.
-    executed.AndThen([runtime = std::move(runtime)] {});
-    return executed;
-
-  } else {
-    // Create XNNPACK runtime for one-use only.
-    TF_ASSIGN_OR_RETURN(
-        auto runtime, CreateXnnRuntime(device, /*one_use=*/true, [&, this] {
-          return one_use_builder_(arguments_, results_, arguments_buffers,
-                                  results_buffers);
-        }));
-    return invoke(runtime);
+    TF_ASSIGN_OR_RETURN(auto runtime, xnn_runtime_pool_.GetOrCreate(
+                                          device, arguments_buffers,
+                                          results_buffers));
+
+    // Constants have the same address in all executions, however we check it
+    // explicitly, as reusing a runtime that captured a different buffer would
+    // silently read stale data.
+    bool reusable = builder_ || runtime->captured_arguments ==
+                                    CapturedArguments(arguments_buffers);
+    if (ABSL_PREDICT_TRUE(reusable)) {
+      auto executed = invoke(*runtime);
+
+      // Do not return runtime to the pool until the execution is done.
+      executed.AndThen([runtime = std::move(runtime)] {});
+      return executed;
+    }
   }
+
+  // Create XNNPACK runtime for one-use only.
+  TF_ASSIGN_OR_RETURN(
+      auto runtime, CreateXnnRuntime(device, /*one_use=*/true, [&, this] {
+        return one_use_builder_(arguments_, results_, arguments_buffers,
+                                results_buffers);
+      }));
+  return invoke(runtime);
 }
 
 }  // namespace xla::cpu
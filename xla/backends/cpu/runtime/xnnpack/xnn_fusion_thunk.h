@@ -27,6 +27,7 @@ limitations under the License.
 #include <vector>
 
 #include "absl/container/flat_hash_set.h"
+#include "absl/container/inlined_vector.h"
 #include "absl/functional/any_invocable.h"
 #include "absl/functional/function_ref.h"
 #include "absl/status/statusor.h"
@@ -78,9 +79,12 @@ class XnnFusionThunk : public Thunk {
       absl::Span<const Argument> arguments, absl::Span<const Result> results)>;
 
   // Builder function that constructs XNNPACK subgraph for the fusion operation
-  // using resolved buffers for arguments and results. Such XNNPACK subgraph
-  // can't be reused for multiple executions as it might capture the address of
-  // the buffer(s).
+  // using resolved buffers for arguments and results. In general such XNNPACK
+  // subgraph can't be reused for multiple executions as it might capture the
+  // address of the buffer(s). If all buffers captured by value are constants
+  // owned by the executable (i.e. model weights), their addresses do not
+  // change between executions, and we pool XNNPACK runtimes, so that XNNPACK
+  // packs constant weights only once when the runtime is created.
   using OneUseBuilder = absl::AnyInvocable<absl::StatusOr<xnn_subgraph_t>(
       absl::Span<const Argument> arguments, absl::Span<const Result> results,
       absl::Span<const se::DeviceMemoryBase> arguments_buffers,
@@ -134,10 +138,17 @@ class XnnFusionThunk : public Thunk {
   // XNNPACK runtime instantiated for the fusion operation.
   struct XnnRuntime;
 
+  // XNNPACK weights cache shared by all pooled runtimes of the fusion.
+  struct XnnWeightsCache;
+
   absl::StatusOr<XnnRuntime> CreateXnnRuntime(
       const Eigen::ThreadPoolDevice* device, bool one_use,
       absl::FunctionRef<absl::StatusOr<xnn_subgraph_t>()> builder);
 
+  // Returns addresses of the arguments captured by value by one-use builder.
+  absl::InlinedVector<const void*, 2> CapturedArguments(
+      absl::Span<const se::DeviceMemoryBase> arguments_buffers) const;
+
   Options options_;
 
   std::vector<Argument> arguments_;
@@ -155,9 +166,21 @@ class XnnFusionThunk : public Thunk {
   absl::flat_hash_set<int64_t> by_value_arguments_;
   absl::flat_hash_set<int64_t> by_value_results_;
 
+  // True if one-use builder captures only constant arguments by value, and
+  // XNNPACK runtimes can be reused for multiple executions.
+  bool captures_only_constants_ = false;
+
+  // Constant weights captured by pooled runtimes are packed once into this
+  // cache by the first runtime, and later runtimes reuse the packed weights.
+  // Must outlive all pooled runtimes, so declared before the pool.
+  std::unique_ptr<XnnWeightsCache> weights_cache_;
+
   // XLA:CPU executable can be called concurrently from multiple threads,
   // and we need to keep a pool of XNNPACK runtimes to avoid data races.
-  ObjectPool<XnnRuntime, const Eigen::ThreadPoolDevice*> xnn_runtime_pool_;
+  ObjectPool<XnnRuntime, const Eigen::ThreadPoolDevice*,
+             absl::Span<const se::DeviceMemoryBase>,
+             absl::Span<const se::DeviceMemoryBase>>
+      xnn_runtime_pool_;
 
   // The number of XNNPACK runtimes created for one-use only.
   std::atomic<int64_t> num_one_use_created_{0};
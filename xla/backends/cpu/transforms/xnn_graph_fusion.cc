@@ -18,31 +18,63 @@ limitations under the License.
 #include <cstdint>
 #include <string>
 
+#include "absl/algorithm/container.h"
 #include "absl/log/check.h"
+#include "absl/status/statusor.h"
 #include "xla/backends/cpu/xnn_fusion.h"
 #include "xla/hlo/ir/hlo_casting_utils.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_instructions.h"
 #include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/layout_util.h"
 #include "xla/service/cpu/backend_config.pb.h"
 #include "xla/service/instruction_fusion.h"
+#include "xla/shape.h"
 #include "xla/tsl/platform/status.h"
+#include "xla/xla_data.pb.h"
 
 namespace xla {
 namespace cpu {
 
 FusionDecision XnnGraphFusion::ShouldFuse(HloInstruction* consumer,
                                           int64_t operand_index) {
+  // We start XNNPACK fusions from any supported operation (except broadcasts,
+  // that can't be fusion roots), and then greedily fuse producers into them,
+  // so that, for example, an entire MLP block (dot, bias add, activation, dot)
+  // becomes a single XNNPACK subgraph.
   if (!IsXnnGraphFusion(consumer)) {
-    if (!(consumer->IsRoot() && IsOpSupported(consumer)))
+    if (!IsOpSupported(consumer) ||
+        consumer->opcode() == HloOpcode::kBroadcast)
       return FusionDecision::Forbid("Unsupported consumer");
   }
 
   HloInstruction* producer = consumer->mutable_operand(operand_index);
   if (!(producer->opcode() == HloOpcode::kParameter ||
-        producer->opcode() == HloOpcode::kConstant || IsOpSupported(producer)))
+        (producer->opcode() == HloOpcode::kConstant &&
+         IsShapeSupported(producer->shape())) ||
+        IsOpSupported(producer)))
     return FusionDecision::Forbid("Unsupported producer");
 
+  // Broadcasts are lowered to implicit broadcasting of binary op operands, and
+  // can be fused only into binary ops.
+  if (producer->opcode() == HloOpcode::kBroadcast) {
+    auto is_binary_op = [](const HloInstruction* user) {
+      return IsXnnBinaryOpSupported(user->opcode());
+    };
+    bool used_by_binary_ops =
+        IsXnnGraphFusion(consumer)
+            ? absl::c_all_of(
+                  consumer->fused_parameter(operand_index)->users(),
+                  is_binary_op)
+            : is_binary_op(consumer);
+    if (!used_by_binary_ops)
+      return FusionDecision::Forbid("Broadcast is not used by binary op");
+  }
+
+  // Do not duplicate expensive operations into multiple fusions.
+  if (producer->opcode() == HloOpcode::kDot && producer->user_count() > 1)
+    return FusionDecision::Forbid("Dot producer has multiple users");
+
   return FusionDecision::Allow();
 }
 
@@ -65,16 +97,46 @@ HloInstruction* XnnGraphFusion::Fuse(HloInstruction* producer,
   return fusion;
 }
 
-bool XnnGraphFusion::IsOpSupported(HloInstruction* instr) const {
+bool XnnGraphFusion::IsShapeSupported(const Shape& shape) {
+  // XNNPACK emitter supports only F32 arrays in the default (row-major) layout.
+  return shape.IsArray() && shape.element_type() == F32 &&
+         (!shape.has_layout() ||
+          LayoutUtil::IsMonotonicWithDim0Major(shape.layout()));
+}
+
+bool XnnGraphFusion::IsOpSupported(const HloInstruction* instr) const {
+  if (!IsShapeSupported(instr->shape()) ||
+      !absl::c_all_of(instr->operands(), [](const HloInstruction* operand) {
+        return IsShapeSupported(operand->shape());
+      })) {
+    return false;
+  }
+
+  if (IsXnnUnaryOpSupported(instr->opcode())) {
+    return true;
+  }
+
+  // XNNPACK infers binary op result shape from operands, and at most one of
+  // the operands can be implicitly broadcasted.
+  if (IsXnnBinaryOpSupported(instr->opcode())) {
+    return !(instr->operand(0)->opcode() == HloOpcode::kBroadcast &&
+             instr->operand(1)->opcode() == HloOpcode::kBroadcast);
+  }
+
   switch (instr->opcode()) {
-    case HloOpcode::kAdd:
-    case HloOpcode::kSubtract:
-    case HloOpcode::kMultiply:
-      return true;
+    case HloOpcode::kBroadcast:
+      return IsXnnBroadcastSupported(instr);
+    case HloOpcode::kDot: {
+      absl::StatusOr<bool> is_supported = IsXnnDotSupported(
+          instr->dot_dimension_numbers(), instr->operand(0)->shape(),
+          instr->operand(1)->shape(), instr->shape());
+      return is_supported.ok() && *is_supported;
+    }
     default:
       return false;
   }
 }
+
 bool XnnGraphFusion::IsXnnGraphFusion(const HloInstruction* instr) const {
   if (instr->opcode() != HloOpcode::kFusion) {
     return false;
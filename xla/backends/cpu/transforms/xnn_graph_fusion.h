@@ -21,6 +21,7 @@ limitations under the License.
 #include "absl/container/flat_hash_set.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/service/instruction_fusion.h"
+#include "xla/shape.h"
 
 namespace xla {
 namespace cpu {
@@ -39,7 +40,9 @@ class XnnGraphFusion : public InstructionFusion {
   HloInstruction* Fuse(HloInstruction* producer, HloInstruction* consumer,
                        HloComputation* computation) override;
 
-  bool IsOpSupported(HloInstruction* instr) const;
+  static bool IsShapeSupported(const Shape& shape);
+
+  bool IsOpSupported(const HloInstruction* instr) const;
 
   bool IsXnnGraphFusion(const HloInstruction* instr) const;
 };
@@ -67,5 +67,63 @@ ENTRY entry {
   EXPECT_EQ(backend_config.fusion_config().kind(), kXnnFusionKind);
 }
 
+TEST_F(XnnGraphFusionTest, MlpBlockFusion) {
+  std::string hlo_string = R"(
+HloModule MlpBlock
+
+ENTRY entry {
+   %x = f32[16,32]{1,0} parameter(0)
+   %w0 = f32[32,64]{1,0} parameter(1)
+   %b0 = f32[64]{0} parameter(2)
+   %w1 = f32[64,16]{1,0} parameter(3)
+   %dot.0 = f32[16,64]{1,0} dot(%x, %w0),
+     lhs_contracting_dims={1}, rhs_contracting_dims={0}
+   %bias = f32[16,64]{1,0} broadcast(%b0), dimensions={1}
+   %add = f32[16,64]{1,0} add(%dot.0, %bias)
+   %zero = f32[] constant(0)
+   %zeros = f32[16,64]{1,0} broadcast(%zero), dimensions={}
+   %relu = f32[16,64]{1,0} maximum(%add, %zeros)
+   ROOT %dot.1 = f32[16,16]{1,0} dot(%relu, %w1),
+     lhs_contracting_dims={1}, rhs_contracting_dims={0}
+}
+
+)";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, XnnGraphFusion().Run(module.get()));
+  ASSERT_TRUE(changed);
+
+  HloInstruction* root = module->entry_computation()->root_instruction();
+  ASSERT_EQ(root->opcode(), HloOpcode::kFusion);
+
+  // The whole MLP block must be fused into a single XNNPACK fusion.
+  HloFusionInstruction* fusion = Cast<HloFusionInstruction>(root);
+  EXPECT_THAT(fusion->fused_expression_root(),
+              op::Dot(op::Maximum(op::Add(op::Dot(), op::Broadcast()),
+                                  op::Broadcast(op::Constant())),
+                      op::Parameter()));
+}
+
+TEST_F(XnnGraphFusionTest, DoNotFuseBroadcastIntoDot) {
+  std::string hlo_string = R"(
+HloModule BroadcastDot
+
+ENTRY entry {
+   %p0 = f32[32]{0} parameter(0)
+   %p1 = f32[32,8]{1,0} parameter(1)
+   %broadcast = f32[16,32]{1,0} broadcast(%p0), dimensions={1}
+   ROOT %dot = f32[16,8]{1,0} dot(%broadcast, %p1),
+     lhs_contracting_dims={1}, rhs_contracting_dims={0}
+}
+
+)";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, XnnGraphFusion().Run(module.get()));
+  EXPECT_FALSE(changed);
+}
+
 }  // namespace
 }  // namespace xla::cpu
@@ -21,6 +21,7 @@ limitations under the License.
 #include <vector>
 
 #include "xnnpack.h"
+#include "absl/algorithm/container.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/functional/any_invocable.h"
 #include "absl/status/statusor.h"
@@ -30,6 +31,7 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_computation.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/literal.h"
 #include "xla/primitive_util.h"
 #include "xla/shape.h"
 #include "xla/tsl/platform/logging.h"
@@ -67,12 +69,37 @@ static absl::StatusOr<xnn_binary_operator> XnnBinaryOperator(
       return xnn_binary_multiply;
     case HloOpcode::kSubtract:
       return xnn_binary_subtract;
+    case HloOpcode::kDivide:
+      return xnn_binary_divide;
+    case HloOpcode::kMaximum:
+      return xnn_binary_maximum;
+    case HloOpcode::kMinimum:
+      return xnn_binary_minimum;
     default:
       return InvalidArgument("Unsupported XNNPACK binary operator: %s",
                              HloOpcodeString(opcode));
   }
 }
 
+static absl::StatusOr<xnn_unary_operator> XnnUnaryOperator(
+    const HloOpcode& opcode) {
+  switch (opcode) {
+    case HloOpcode::kAbs:
+      return xnn_unary_abs;
+    case HloOpcode::kExp:
+      return xnn_unary_exp;
+    case HloOpcode::kLogistic:
+      return xnn_unary_sigmoid;
+    case HloOpcode::kNegate:
+      return xnn_unary_negate;
+    case HloOpcode::kTanh:
+      return xnn_unary_tanh;
+    default:
+      return InvalidArgument("Unsupported XNNPACK unary operator: %s",
+                             HloOpcodeString(opcode));
+  }
+}
+
 static std::vector<size_t> XnnDimensions(const Shape& shape) {
   std::vector<size_t> dims;
   for (auto& dim : shape.dimensions()) {
@@ -139,6 +166,71 @@ static absl::StatusOr<uint32_t> DefineParameter(xnn_subgraph_t subgraph,
   return tensor_id;
 }
 
+static absl::StatusOr<uint32_t> DefineConstant(xnn_subgraph_t subgraph,
+                                               const HloInstruction* constant) {
+  VLOG(3) << absl::StreamFormat("Define tensor value for constant: %s",
+                                constant->ToString());
+
+  if (constant->parent()->root_instruction() == constant) {
+    return InvalidArgument("XNNPACK fusion root can't be a constant: %s",
+                           constant->ToString());
+  }
+
+  auto dims = XnnDimensions(constant->shape());
+  TF_ASSIGN_OR_RETURN(auto type, XnnDatatype(constant->shape().element_type()));
+
+  // Constant literal is owned by the HLO module, and outlives XNNPACK subgraph,
+  // so we pass it to XNNPACK as a static tensor, that also allows XNNPACK to
+  // pack constant weights once when creating a runtime.
+  uint32_t tensor_id = XNN_INVALID_VALUE_ID;
+  XNN_RETURN_IF_ERROR(xnn_define_tensor_value(
+      subgraph, type, dims.size(), dims.data(),
+      /*data=*/constant->literal().untyped_data(),
+      /*external_id=*/XNN_INVALID_VALUE_ID, /*flags=*/0, &tensor_id));
+
+  return tensor_id;
+}
+
+static absl::StatusOr<uint32_t> DefineBroadcast(TensorIdMap& tensor_ids,
+                                                const HloInstruction* instr) {
+  VLOG(3) << absl::StreamFormat("Define tensor value for broadcast: %s",
+                                instr->ToString());
+
+  // XNNPACK doesn't have an explicit broadcast operator, and instead we rely
+  // on implicit broadcasting of binary operator operands.
+  bool users_are_binary_ops =
+      absl::c_all_of(instr->users(), [](const HloInstruction* user) {
+        return IsXnnBinaryOpSupported(user->opcode());
+      });
+
+  if (!IsXnnBroadcastSupported(instr) || !users_are_binary_ops ||
+      instr->parent()->root_instruction() == instr) {
+    return InvalidArgument("Unsupported XNNPACK broadcast: %s",
+                           instr->ToString());
+  }
+
+  return FindTensorValue(tensor_ids, instr->operand(0));
+}
+
+static absl::StatusOr<uint32_t> DefineUnaryOp(xnn_subgraph_t subgraph,
+                                              TensorIdMap& tensor_ids,
+                                              const HloInstruction* instr) {
+  VLOG(3) << absl::StreamFormat("Define tensor value for unary op: %s",
+                                instr->ToString());
+
+  TF_ASSIGN_OR_RETURN(auto unary_op, XnnUnaryOperator(instr->opcode()));
+
+  TF_ASSIGN_OR_RETURN(auto in, FindTensorValue(tensor_ids, instr->operand(0)));
+  TF_ASSIGN_OR_RETURN(auto out, DefineTensorValue(subgraph, instr));
+
+  VLOG(3) << absl::StreamFormat("  tensors: in=%d, out=%d", in, out);
+
+  XNN_RETURN_IF_ERROR(xnn_define_unary(subgraph, unary_op, /*params=*/nullptr,
+                                       in, out, /*flags=*/0));
+
+  return out;
+}
+
 static absl::StatusOr<uint32_t> DefineBinaryOp(xnn_subgraph_t subgraph,
                                                TensorIdMap& tensor_ids,
                                                const HloInstruction* instr) {
@@ -147,6 +239,15 @@ static absl::StatusOr<uint32_t> DefineBinaryOp(xnn_subgraph_t subgraph,
 
   TF_ASSIGN_OR_RETURN(auto binary_op, XnnBinaryOperator(instr->opcode()));
 
+  // XNNPACK infers the result shape from (broadcasted) operand shapes, and at
+  // least one of the operands must have the same shape as the result.
+  if (instr->operand(0)->opcode() == HloOpcode::kBroadcast &&
+      instr->operand(1)->opcode() == HloOpcode::kBroadcast) {
+    return InvalidArgument(
+        "Unsupported XNNPACK binary op with broadcasted operands: %s",
+        instr->ToString());
+  }
+
   TF_ASSIGN_OR_RETURN(auto lhs, FindTensorValue(tensor_ids, instr->operand(0)));
   TF_ASSIGN_OR_RETURN(auto rhs, FindTensorValue(tensor_ids, instr->operand(1)));
   TF_ASSIGN_OR_RETURN(auto out, DefineTensorValue(subgraph, instr));
@@ -225,7 +326,28 @@ static absl::StatusOr<xnn_subgraph_t> EmitXnnSubgraph(
                             DefineParameter(subgraph, instr));
       } break;
 
+      case HloOpcode::kConstant: {
+        TF_ASSIGN_OR_RETURN(tensor_ids[instr], DefineConstant(subgraph, instr));
+      } break;
+
+      case HloOpcode::kBroadcast: {
+        TF_ASSIGN_OR_RETURN(tensor_ids[instr],
+                            DefineBroadcast(tensor_ids, instr));
+      } break;
+
+      case HloOpcode::kAbs:
+      case HloOpcode::kExp:
+      case HloOpcode::kLogistic:
+      case HloOpcode::kNegate:
+      case HloOpcode::kTanh: {
+        TF_ASSIGN_OR_RETURN(tensor_ids[instr],
+                            DefineUnaryOp(subgraph, tensor_ids, instr));
+      } break;
+
       case HloOpcode::kAdd:
+      case HloOpcode::kDivide:
+      case HloOpcode::kMaximum:
+      case HloOpcode::kMinimum:
       case HloOpcode::kSubtract:
       case HloOpcode::kMultiply: {
         TF_ASSIGN_OR_RETURN(tensor_ids[instr],
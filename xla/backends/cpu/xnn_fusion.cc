@@ -20,6 +20,7 @@ limitations under the License.
 
 #include "absl/algorithm/container.h"
 #include "absl/status/statusor.h"
+#include "absl/types/span.h"
 #include "xla/backends/cpu/codegen/target_machine_features.h"
 #include "xla/backends/cpu/runtime/dot_lib.h"
 #include "xla/hlo/ir/hlo_computation.h"
@@ -77,6 +78,46 @@ bool XnnShouldUseThreadPool(const HloComputation* computation) {
       [](const HloInstruction* hlo) { return XnnShouldUseThreadPool(hlo); });
 }
 
+bool IsXnnUnaryOpSupported(HloOpcode opcode) {
+  switch (opcode) {
+    case HloOpcode::kAbs:
+    case HloOpcode::kExp:
+    case HloOpcode::kLogistic:
+    case HloOpcode::kNegate:
+    case HloOpcode::kTanh:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool IsXnnBinaryOpSupported(HloOpcode opcode) {
+  switch (opcode) {
+    case HloOpcode::kAdd:
+    case HloOpcode::kDivide:
+    case HloOpcode::kMaximum:
+    case HloOpcode::kMinimum:
+    case HloOpcode::kMultiply:
+    case HloOpcode::kSubtract:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool IsXnnBroadcastSupported(const HloInstruction* broadcast) {
+  if (broadcast->opcode() != HloOpcode::kBroadcast) return false;
+
+  int64_t operand_rank = broadcast->operand(0)->shape().dimensions_size();
+  int64_t result_rank = broadcast->shape().dimensions_size();
+
+  absl::Span<const int64_t> dims = broadcast->dimensions();
+  for (int64_t i = 0; i < operand_rank; ++i) {
+    if (dims[i] != result_rank - operand_rank + i) return false;
+  }
+  return true;
+}
+
 absl::StatusOr<bool> IsXnnDotSupported(
     const DotDimensionNumbers& dot_dimensions, const Shape& lhs_shape,
     const Shape& rhs_shape, const Shape& out_shape,
@@ -21,6 +21,7 @@ limitations under the License.
 #include "xla/backends/cpu/codegen/target_machine_features.h"
 #include "xla/hlo/ir/hlo_computation.h"
 #include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_opcode.h"
 #include "xla/shape.h"
 #include "xla/xla_data.pb.h"
 
@@ -34,6 +35,16 @@ inline constexpr absl::string_view kXnnFusionKind = "__xnn_fusion";
 bool XnnShouldUseThreadPool(const HloInstruction* hlo);
 bool XnnShouldUseThreadPool(const HloComputation* computation);
 
+// Returns true if the elementwise HLO opcode has a corresponding XNNPACK unary
+// or binary operator.
+bool IsXnnUnaryOpSupported(HloOpcode opcode);
+bool IsXnnBinaryOpSupported(HloOpcode opcode);
+
+// Returns true if the broadcast can be lowered to XNNPACK implicit broadcasting
+// of binary operator operands: operand dimensions must map to the trailing
+// dimensions of the result in the same order (numpy-style broadcasting).
+bool IsXnnBroadcastSupported(const HloInstruction* broadcast);
+
 // Returns true if the dot operation is supported by XNNPACK. Returns an error
 // if the dot operation shape is invalid.
 absl::StatusOr<bool> IsXnnDotSupported(
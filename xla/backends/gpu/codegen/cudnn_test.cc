@@ -17,6 +17,7 @@ limitations under the License.
 #include <memory>
 #include <string>
 #include <tuple>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -262,6 +263,50 @@ e {
                                       ErrorSpec{/*aabs=*/1e-3, /*arel=*/1e-3}));
 }
 
+TEST_F(CuDnnFusionExecutionTest, CompiledGraphsAreReadFromCacheDir) {
+  const std::string kHloText = R"(
+fusion1 {
+  p0 = f32[32,96] parameter(0)
+  p1 = f32[96,64] parameter(1)
+  ROOT r = f32[32,64] dot(p0, p1),
+    lhs_contracting_dims={1}, rhs_contracting_dims={0}
+}
+
+ENTRY e {
+  p0 = f32[32,96] parameter(0)
+  p1 = f32[96,64] parameter(1)
+  ROOT _ = f32[32,64] fusion(p0, p1), kind=kCustom, calls=fusion1,
+    backend_config={"fusion_backend_config": {kind: "__cudnn$fusion"}}
+})";
+  const std::string cache_dir =
+      tsl::io::JoinPath(tsl::testing::TmpDir(), "cudnn_graph_cache");
+  auto compile = [&](BinaryMap& dnn_compiled_graphs)
+      -> absl::StatusOr<std::unique_ptr<VerifiedHloModule>> {
+    TF_ASSIGN_OR_RETURN(std::unique_ptr<VerifiedHloModule> module,
+                        ParseAndReturnVerifiedModule(kHloText));
+    module->mutable_config()
+        .mutable_debug_options()
+        .set_xla_gpu_cudnn_graph_cache_dir(cache_dir);
+    CuDnnFusionCompiler cudnn_compiler(*backend().default_stream_executor(),
+                                       dnn_compiled_graphs);
+    TF_RETURN_IF_ERROR(cudnn_compiler.Run(module.get()).status());
+    return module;
+  };
+
+  BinaryMap compiled_graphs;
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<VerifiedHloModule> module,
+                          compile(compiled_graphs));
+  std::vector<std::string> cache_files;
+  TF_ASSERT_OK(tsl::Env::Default()->GetChildren(cache_dir, &cache_files));
+  EXPECT_EQ(cache_files.size(), 1);
+
+  BinaryMap cached_graphs;
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<VerifiedHloModule> cached_module,
+                          compile(cached_graphs));
+  EXPECT_EQ(cached_graphs, compiled_graphs);
+  EXPECT_EQ(cached_module->ToString(), module->ToString());
+}
+
 TEST_F(CuDnnFusionExecutionTest,
        CuDnnFusionCompilerDoesNotFailOnDependentFusions) {
   if (!IsAtLeastCuDnn91()) {
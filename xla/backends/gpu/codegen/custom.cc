@@ -37,6 +37,7 @@ limitations under the License.
 #include "mlir/Support/LLVM.h"
 #include "xla/backends/gpu/codegen/fusion_emitter.h"
 #include "xla/backends/gpu/collectives/gpu_clique_key.h"
+#include "xla/backends/gpu/runtime/all_gather_thunk.h"
 #include "xla/backends/gpu/runtime/all_reduce_thunk.h"
 #include "xla/backends/gpu/runtime/collective_thunk.h"
 #include "xla/backends/gpu/runtime/copy_thunk.h"
@@ -1176,6 +1177,12 @@ absl::StatusOr<FusionEmissionResult> EmitCollective(
     case HloOpcode::kReduceScatter:
       collective_done_thunk_kind = Thunk::kReduceScatterDone;
       break;
+    case HloOpcode::kAllReduce:
+      collective_done_thunk_kind = Thunk::kAllReduceDone;
+      break;
+    case HloOpcode::kAllGather:
+      collective_done_thunk_kind = Thunk::kAllGatherDone;
+      break;
     default:
       return absl::InternalError(
           "Unexpected operation in dynamic slice fusion");
@@ -1349,20 +1356,47 @@ absl::StatusOr<FusionEmissionResult> DynamicSliceFusion::Emit(
     IrEmitterContext& ir_emitter_context,
     const HloFusionInstruction& fusion) const {
   const HloFusionAdaptor& adaptor = analysis_.fusion();
-  // Only reduce-scatter is supported for now.
+  // Reduce-scatter, all-reduce and all-gather are the supported collectives.
   auto maybe_collective =
       HloBfsFindIf(/*roots=*/adaptor.GetRoots(), /*fusion=*/adaptor,
                    /*visit=*/[](HloInstructionAdaptor node) -> bool {
-                     return node.opcode() == HloOpcode::kReduceScatter;
+                     return HloPredicateIsOp<HloOpcode::kReduceScatter,
+                                             HloOpcode::kAllReduce,
+                                             HloOpcode::kAllGather>(
+                         &node.instruction());
                    });
   if (maybe_collective != std::nullopt) {
-    const HloReduceScatterInstruction* rs =
-        Cast<const HloReduceScatterInstruction>(
-            &maybe_collective->instruction());
-    return EmitCollective<ReduceScatterStartThunk, HloReduceScatterInstruction>(
-        ir_emitter_context, adaptor, /*fusion_instr=*/fusion, /*instr=*/rs,
-        /*use_global_device_ids=*/rs->use_global_device_ids(),
-        /*call_graph=*/call_graph_);
+    const HloInstruction* collective = &maybe_collective->instruction();
+    switch (collective->opcode()) {
+      case HloOpcode::kReduceScatter: {
+        const auto* rs = Cast<const HloReduceScatterInstruction>(collective);
+        return EmitCollective<ReduceScatterStartThunk,
+                              HloReduceScatterInstruction>(
+            ir_emitter_context, adaptor, /*fusion_instr=*/fusion,
+            /*instr=*/rs,
+            /*use_global_device_ids=*/rs->use_global_device_ids(),
+            /*call_graph=*/call_graph_);
+      }
+      case HloOpcode::kAllReduce: {
+        const auto* ar = Cast<const HloAllReduceInstruction>(collective);
+        return EmitCollective<AllReduceStartThunk, HloAllReduceInstruction>(
+            ir_emitter_context, adaptor, /*fusion_instr=*/fusion,
+            /*instr=*/ar,
+            /*use_global_device_ids=*/ar->use_global_device_ids(),
+            /*call_graph=*/call_graph_);
+      }
+      case HloOpcode::kAllGather: {
+        const auto* ag = Cast<const HloAllGatherInstruction>(collective);
+        return EmitCollective<AllGatherStartThunk, HloAllGatherInstruction>(
+            ir_emitter_context, adaptor, /*fusion_instr=*/fusion,
+            /*instr=*/ag,
+            /*use_global_device_ids=*/ag->use_global_device_ids(),
+            /*call_graph=*/call_graph_);
+      }
+      default:
+        return absl::InternalError(
+            "Unexpected collective in dynamic slice fusion");
+    }
   }
   auto maybe_custom_call_adaptor = HloBfsFindIf(
       adaptor.GetRoots(), adaptor,
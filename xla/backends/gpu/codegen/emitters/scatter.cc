@@ -249,13 +249,18 @@ class EmitterHelper {
   SmallVector<Value, 4> ExtractOffsets(ImplicitLocOpBuilder& b,
                                        Value slice_id) const;
 
+  // Combines `update_elem` with the output element at `indices`. The update is
+  // atomic, unless the indices are unique or `has_exclusive_access` is set at
+  // runtime, i.e. no other thread writes to this element.
   Value EmitScatterComputation(ImplicitLocOpBuilder& b, ValueRange indices,
-                               Value update_elem, Value output_tensor) const;
+                               Value update_elem, Value output_tensor,
+                               Value has_exclusive_access = nullptr) const;
 
   SmallVector<Value> WriteAccumulatedElementToOutput(
       ImplicitLocOpBuilder& b, Value accumulator,
       ValueRange accumulator_indices, ValueRange slice_indices,
-      ValueRange offsets, Value output_tensor) const;
+      ValueRange offsets, Value output_tensor,
+      Value has_exclusive_access) const;
 
   Value WriteAccumulatorToOutput(ImplicitLocOpBuilder& b,
                                  Value write_to_output_required,
@@ -263,7 +268,8 @@ class EmitterHelper {
                                  Value index_id,
                                  const IndexingMap& slice_indexing,
                                  ValueRange offsets, Value accumulator,
-                                 Value output_tensor) const;
+                                 Value output_tensor,
+                                 Value has_exclusive_access = nullptr) const;
 
  private:
   Value GetElement(ImplicitLocOpBuilder& b, int operand_index,
@@ -294,29 +300,52 @@ SmallVector<Value, 4> EmitterHelper::ExtractOffsets(ImplicitLocOpBuilder& b,
   return offsets;
 }
 
-Value EmitterHelper::EmitScatterComputation(ImplicitLocOpBuilder& b,
-                                            ValueRange indices,
-                                            Value update_elem,
-                                            Value output_tensor) const {
+Value EmitterHelper::EmitScatterComputation(
+    ImplicitLocOpBuilder& b, ValueRange indices, Value update_elem,
+    Value output_tensor, Value has_exclusive_access) const {
   FuncOp reducer = GetReducer();
+  auto emit_update = [&](ImplicitLocOpBuilder& update_b) -> Value {
+    auto operand_elem = GetOperandElement(update_b, indices);
+    auto reduced_val = emitters::InlineBlock(
+        update_b, reducer.getBody().front(), {operand_elem, update_elem})[0];
+    return update_b.create<tensor::InsertOp>(reduced_val, output_tensor,
+                                             indices);
+  };
   if (description_->scatter->unique_indices()) {
-    auto operand_elem = GetOperandElement(b, indices);
-    auto reduced_val = emitters::InlineBlock(b, reducer.getBody().front(),
-                                             {operand_elem, update_elem})[0];
-    return b.create<tensor::InsertOp>(reduced_val, output_tensor, indices);
+    return emit_update(b);
+  }
+  auto emit_atomic_update = [&](ImplicitLocOpBuilder& update_b) -> Value {
+    auto atomic_rmw = update_b.create<AtomicRMWOp>(output_tensor, indices);
+    OpBuilder body_b = atomic_rmw.getBodyBuilder();
+    auto reduced_val =
+        emitters::InlineBlock(body_b, reducer.getBody().front(),
+                              {atomic_rmw.getCurrentValue(), update_elem})[0];
+    body_b.create<xla::YieldOp>(reducer->getLoc(), reduced_val);
+    return atomic_rmw->getResult(0);
+  };
+  if (!has_exclusive_access) {
+    return emit_atomic_update(b);
   }
-  auto atomic_rmw = b.create<AtomicRMWOp>(output_tensor, indices);
-  OpBuilder body_b = atomic_rmw.getBodyBuilder();
-  auto reduced_val =
-      emitters::InlineBlock(body_b, reducer.getBody().front(),
-                            {atomic_rmw.getCurrentValue(), update_elem})[0];
-  body_b.create<xla::YieldOp>(reducer->getLoc(), reduced_val);
-  return atomic_rmw->getResult(0);
+  return b
+      .create<scf::IfOp>(
+          has_exclusive_access,
+          [&](OpBuilder& then_b, Location then_loc) -> void {
+            ImplicitLocOpBuilder implicit_then_b(then_loc, then_b);
+            then_b.create<scf::YieldOp>(then_loc,
+                                        emit_update(implicit_then_b));
+          },
+          [&](OpBuilder& else_b, Location else_loc) -> void {
+            ImplicitLocOpBuilder implicit_else_b(else_loc, else_b);
+            else_b.create<scf::YieldOp>(else_loc,
+                                        emit_atomic_update(implicit_else_b));
+          })
+      .getResult(0);
 }
 
 SmallVector<Value> EmitterHelper::WriteAccumulatedElementToOutput(
     ImplicitLocOpBuilder& b, Value accumulator, ValueRange accumulator_indices,
-    ValueRange slice_indices, ValueRange offsets, Value output_tensor) const {
+    ValueRange slice_indices, ValueRange offsets, Value output_tensor,
+    Value has_exclusive_access) const {
   Value accumulator_elem = b.create<vector::ExtractOp>(
       accumulator, mlir::getAsOpFoldResult(accumulator_indices));
 
@@ -326,14 +355,14 @@ SmallVector<Value> EmitterHelper::WriteAccumulatedElementToOutput(
         b.create<arith::AddIOp>(slice_indices[i + 1], output_indices[i]);
   }
   return {EmitScatterComputation(b, output_indices, accumulator_elem,
-                                 output_tensor)};
+                                 output_tensor, has_exclusive_access)};
 }
 
 Value EmitterHelper::WriteAccumulatorToOutput(
     ImplicitLocOpBuilder& b, Value write_to_output_required,
     ValueRange thread_and_block_ids, Value index_id,
     const IndexingMap& slice_indexing, ValueRange offsets, Value accumulator,
-    Value output_tensor) const {
+    Value output_tensor, Value has_exclusive_access) const {
   SmallVector<Value> dims = Pack({thread_and_block_ids, index_id});
   return EmitUpdateIf(
              b, write_to_output_required, output_tensor,
@@ -345,7 +374,8 @@ Value EmitterHelper::WriteAccumulatorToOutput(
                        ValueRange output_tensors) -> SmallVector<Value> {
                      return WriteAccumulatedElementToOutput(
                          update_loop_b, accumulator, accumulator_indices,
-                         slice_indices, offsets, output_tensors.front());
+                         slice_indices, offsets, output_tensors.front(),
+                         has_exclusive_access);
                    });
              })
       .front();
@@ -682,16 +712,29 @@ absl::Status ScatterWithDistributedIndices::EmitEntryFunctionImpl(
   IndexingMap slice_indexing =
       ConvertRangeVariablesToDimensions(updates_map, {0});
 
+  // If the indices are sorted, all the updates to one index form a single
+  // segment. Only the first and the last segment of a warp can be shared with
+  // the neighbouring warps, so the other segments are written without atomics,
+  // provided that slices at different indices don't overlap.
+  bool inner_segments_are_exclusive =
+      description_.scatter->indices_are_sorted() &&
+      llvm::all_of(ArrayRef<int64_t>(description_.slice_shape)
+                       .take_front(description_.index_vector_length),
+                   [](int64_t dim) { return dim == 1; });
+
   // Prepare loop initial values. Inits are packed as
-  // [index_changed, is_inbounds, index_0,  ..., accumulator].
+  // [slice_id, index_0, ..., is_inbounds, is_first_segment, accumulator,
+  //  output].
   Value is_inbounds_init = b.create<arith::ConstantIntOp>(0, b.getI1Type());
+  Value is_first_segment_init =
+      b.create<arith::ConstantIntOp>(1, b.getI1Type());
   Value slice_id_init = b.create<arith::ConstantIndexOp>(0);
   std::vector<Value> indices_init(description_.index_vector_length,
                                   b.create<arith::ConstantIndexOp>(-1));
   Value accumulator_init = InitializeAccumulator(b);
   SmallVector<Value> inits =
-      Pack({slice_id_init, indices_init, is_inbounds_init, accumulator_init,
-            output_tensor});
+      Pack({slice_id_init, indices_init, is_inbounds_init,
+            is_first_segment_init, accumulator_init, output_tensor});
 
   int64_t output_rank = description_.output_shape.size();
 
@@ -700,12 +743,13 @@ absl::Status ScatterWithDistributedIndices::EmitEntryFunctionImpl(
           ValueRange thread_id_to_index_id_value,
           ValueRange outer_iter_args) -> SmallVector<Value> {
     // Unpack the iter_args.
-    SmallVector<ValueRange> iter_args_unpack =
-        Unpack(outer_iter_args, {1, description_.index_vector_length, 1, 1, 1});
+    SmallVector<ValueRange> iter_args_unpack = Unpack(
+        outer_iter_args, {1, description_.index_vector_length, 1, 1, 1, 1});
     ValueRange trimmed_offsets = iter_args_unpack[1];
     Value iter_is_inbounds = iter_args_unpack[2].front();
-    Value iter_acc = iter_args_unpack[3].front();
-    Value iter_output = iter_args_unpack[4].front();
+    Value iter_is_first_segment = iter_args_unpack[3].front();
+    Value iter_acc = iter_args_unpack[4].front();
+    Value iter_output = iter_args_unpack[5].front();
     CHECK_EQ(ivs.size(), 2);
     Value index_loop_id = ivs.front();
     Value index_vector_id = ivs.back();
@@ -736,12 +780,23 @@ absl::Status ScatterWithDistributedIndices::EmitEntryFunctionImpl(
     Value is_not_first_iteration =
         b.create<arith::CmpIOp>(arith::CmpIPredicate::ne, iter_slice_id,
                                 b.create<arith::ConstantIndexOp>(0));
-    Value write_to_output_required = b.create<arith::AndIOp>(
-        is_not_first_iteration,
-        b.create<arith::AndIOp>(offsets_changed, iter_is_inbounds));
+    Value segment_ended =
+        b.create<arith::AndIOp>(is_not_first_iteration, offsets_changed);
+    Value write_to_output_required =
+        b.create<arith::AndIOp>(segment_ended, iter_is_inbounds);
+    Value has_exclusive_access = nullptr;
+    if (inner_segments_are_exclusive) {
+      has_exclusive_access = b.create<arith::XOrIOp>(
+          iter_is_first_segment,
+          b.create<arith::ConstantIntOp>(1, b.getI1Type()));
+    }
     iter_output = helper.WriteAccumulatorToOutput(
         b, write_to_output_required, thread_and_block_ids, iter_slice_id,
-        slice_indexing, offsets, iter_acc, iter_output);
+        slice_indexing, offsets, iter_acc, iter_output, has_exclusive_access);
+    Value new_is_first_segment = b.create<arith::AndIOp>(
+        iter_is_first_segment,
+        b.create<arith::XOrIOp>(
+            segment_ended, b.create<arith::ConstantIntOp>(1, b.getI1Type())));
 
     // Update `is_inbounds` if the offsets changed.
     Value new_is_inbounds = UpdateIsInbounds(
@@ -808,7 +863,7 @@ absl::Status ScatterWithDistributedIndices::EmitEntryFunctionImpl(
             .front();
     SmallVector<Value> updated_if_loop_results =
         Pack({iter_slice_id, new_trimmed_offsets, new_is_inbounds,
-              updated_accumulator, iter_output});
+              new_is_first_segment, updated_accumulator, iter_output});
     return updated_if_loop_results;
   };
   auto loop_over_indices_results =
@@ -818,13 +873,13 @@ absl::Status ScatterWithDistributedIndices::EmitEntryFunctionImpl(
   // Write the accumulator to the output tensor.
   SmallVector<ValueRange> loop_over_indices_results_unpacked =
       Unpack(loop_over_indices_results,
-             {1, description_.index_vector_length, 1, 1, 1});
+             {1, description_.index_vector_length, 1, 1, 1, 1});
   Value result_slice_id = loop_over_indices_results_unpacked[0].front();
   auto result_offsets =
       PadWithZeros(loop_over_indices_results_unpacked[1], output_rank, b);
   Value result_is_inbounds = loop_over_indices_results_unpacked[2].front();
-  Value result_acc = loop_over_indices_results_unpacked[3].front();
-  Value result_output = loop_over_indices_results_unpacked[4].front();
+  Value result_acc = loop_over_indices_results_unpacked[4].front();
+  Value result_output = loop_over_indices_results_unpacked[5].front();
   result_output = helper.WriteAccumulatorToOutput(
       b, result_is_inbounds, thread_and_block_ids, result_slice_id,
       slice_indexing, result_offsets, result_acc, result_output);
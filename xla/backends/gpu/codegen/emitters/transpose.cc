@@ -28,6 +28,7 @@ limitations under the License.
 #include "absl/types/span.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallVector.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
 #include "mlir/Dialect/Func/IR/FuncOps.h"
 #include "mlir/Dialect/Tensor/IR/Tensor.h"
 #include "mlir/IR/AffineExpr.h"
@@ -79,6 +80,16 @@ constexpr int kNumRows = 4;
 constexpr int kNumThreadsPerBlock = 128;
 constexpr int kMaxVectorizedBytes = 4;
 
+// 4-bit values are stored one per byte in shared memory. Packing two of them
+// into a byte would need atomics, since neighboring values in a shared memory
+// row are written by different threads.
+mlir::Type GetSharedMemoryElementType(mlir::Type elem_type) {
+  if (elem_type.isIntOrFloat() && elem_type.getIntOrFloatBitWidth() == 4) {
+    return mlir::IntegerType::get(elem_type.getContext(), 8);
+  }
+  return elem_type;
+}
+
 }  // namespace
 
 TransposeFusion::TransposeFusion(const HloFusionAnalysis& analysis)
@@ -267,8 +278,8 @@ TransposeFusion::WriteResult TransposeFusion::EmitWriteToShMemMlir(
   for (auto* transpose : shmem_transposes_) {
     auto elem_type = emitters::PrimitiveTypeToMlirType(
         transpose->shape().element_type(), builder);
-    auto shmem = builder.create<AllocateSharedOp>(
-        RankedTensorType::get(shmem_tensor_size, elem_type));
+    auto shmem = builder.create<AllocateSharedOp>(RankedTensorType::get(
+        shmem_tensor_size, GetSharedMemoryElementType(elem_type)));
     auto indexed_vector =
         IndexedVectorType::get(ctx, shmem_tensor_size, elem_type,
                                IndexingMapAttr::get(ctx, write_indexing));
@@ -366,8 +377,19 @@ void TransposeFusion::EmitReadFromShMemMlir(
             transpose_values;
         for (auto [transpose, shmem] :
              llvm::zip(shmem_transposes_, written.shmem_tensors)) {
-          transpose_values[transpose].push_back(
-              nested_b.create<mlir::tensor::ExtractOp>(shmem, shmem_indices));
+          Value value =
+              nested_b.create<mlir::tensor::ExtractOp>(shmem, shmem_indices);
+          auto elem_type = emitters::PrimitiveTypeToMlirType(
+              transpose->shape().element_type(), nested_b);
+          if (value.getType() != elem_type) {
+            value = nested_b.create<mlir::arith::TruncIOp>(
+                nested_b.getIntegerType(elem_type.getIntOrFloatBitWidth()),
+                value);
+            if (value.getType() != elem_type) {
+              value = nested_b.create<mlir::arith::BitcastOp>(elem_type, value);
+            }
+          }
+          transpose_values[transpose].push_back(value);
         }
         llvm::SmallVector<Value> epilogue_indices = thread_and_block_ids;
         absl::c_copy(symbol_values, std::back_inserter(epilogue_indices));
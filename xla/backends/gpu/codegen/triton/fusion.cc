@@ -46,6 +46,7 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_instructions.h"
 #include "xla/hlo/utils/hlo_traversal.h"
 #include "xla/service/gpu/backend_configs.pb.h"
+#include "xla/service/gpu/executable.pb.h"
 #include "xla/service/gpu/ir_emission_utils.h"
 #include "xla/service/gpu/ir_emitter_context.h"
 #include "xla/service/gpu/kernel_arguments.h"
@@ -59,10 +60,28 @@ limitations under the License.
 #include "xla/shape.h"
 #include "xla/status_macros.h"
 #include "xla/stream_executor/device_description.h"
+#include "xla/stream_executor/launch_dim.h"
 #include "tsl/platform/statusor.h"
 
 namespace xla {
 namespace gpu {
+namespace {
+
+KernelReuseCache::Entry CompiledKernelEntry(
+    const std::string& kernel_name, const CompilationCacheEntryProto& proto) {
+  std::optional<se::ClusterDim> cluster_dim;
+  if (proto.has_cluster_dim()) {
+    cluster_dim = se::ClusterDim{proto.cluster_dim().x(),
+                                 proto.cluster_dim().y(),
+                                 proto.cluster_dim().z()};
+  }
+  return {kernel_name,
+          LaunchDimensions{proto.launch_dimensions().num_blocks(),
+                           proto.launch_dimensions().num_threads_per_block()},
+          cluster_dim, proto.shmem_bytes(), /*binary=*/""};
+}
+
+}  // namespace
 
 absl::StatusOr<TritonWrapperResult>
 TritonFusion::GenerateTritonKernelAndWrapper(
@@ -133,6 +152,20 @@ absl::StatusOr<FusionEmissionResult> TritonFusion::Emit(
         ir_emitter_context.name_uniquer()->GetUniqueName(
             llvm_ir::SanitizeFunctionName(
                 absl::StrCat(suggested_kernel_name, "_impl")));
+    const std::string kernel_name =
+        GetSanitizedUniqueName(ir_emitter_context, suggested_kernel_name);
+
+    // When loading thunks from a compilation result, the launch parameters of
+    // the kernel are usually known, and there is no need to run Triton.
+    if (!ir_emitter_context.emit_kernels() &&
+        ir_emitter_context.compiled_kernels() != nullptr) {
+      auto it =
+          ir_emitter_context.compiled_kernels()->entries().find(kernel_name);
+      if (it != ir_emitter_context.compiled_kernels()->entries().end()) {
+        VLOG(3) << "Using compiled kernel parameters for " << kernel_name;
+        return CompiledKernelEntry(kernel_name, it->second);
+      }
+    }
 
     TF_ASSIGN_OR_RETURN(
         TritonWrapperResult triton_wrapper_result,
@@ -195,9 +228,9 @@ absl::StatusOr<FusionEmissionResult> TritonFusion::Emit(
     std::vector<llvm_ir::IrArray> outputs;
     TF_ASSIGN_OR_RETURN(
         std::tie(kernel, inputs, outputs),
-        BuildKernelPrototype(ir_emitter_context, suggested_kernel_name,
-                             kernel_arguments.args(), impl_fn->arg_size(),
-                             launch_dimensions, &builder));
+        BuildKernelPrototypeFromUniqueName(
+            ir_emitter_context, kernel_name, kernel_arguments.args(),
+            impl_fn->arg_size(), launch_dimensions, &builder));
 
     // Move function body into kernel prototype.
     llvm::Function* prototype_func = builder.GetInsertBlock()->getParent();
@@ -221,10 +254,18 @@ absl::StatusOr<FusionEmissionResult> TritonFusion::Emit(
              triton_wrapper_result.tma_metadata}};
   };
 
+  // Tiling parameters are attached to the fusion instruction and not to the
+  // fused computation, so they have to be part of the cache key. Otherwise
+  // kernels loaded from a persistent kernel cache could use stale tilings.
+  const FusionBackendConfig& fusion_backend_config =
+      analysis_.fusion_backend_config();
+  std::string discriminator = absl::StrCat(
+      fusion_backend_config.block_level_fusion_config().ShortDebugString(),
+      fusion_backend_config.triton_gemm_config().ShortDebugString());
+
   auto [status_or_entry, was_cached] =
       ir_emitter_context.kernel_cache().GetWithStatus(
-          hlo_computation, kernel_arguments.args(),
-          /*discriminator=*/"", generate);
+          hlo_computation, kernel_arguments.args(), discriminator, generate);
   TF_ASSIGN_OR_RETURN(const KernelReuseCache::Entry* entry, status_or_entry);
 
   FusionEmissionResult result;
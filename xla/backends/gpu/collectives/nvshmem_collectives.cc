@@ -32,7 +32,12 @@ limitations under the License.
 #include "third_party/nvshmem/nvshmemx.h"  // IWYU pragma: keep
 #include "xla/core/collectives/collectives.h"
 #include "xla/core/collectives/collectives_registry.h"
+#include "xla/core/collectives/rank_id.h"
 #include "xla/pjrt/distributed/key_value_store_interface.h"
+#include "xla/stream_executor/device_memory.h"
+#include "xla/stream_executor/gpu/gpu_stream.h"
+#include "xla/stream_executor/stream.h"
+#include "xla/stream_executor/stream_executor.h"
 #include "xla/tsl/platform/errors.h"
 #include "xla/tsl/platform/statusor.h"
 #include "tsl/platform/casts.h"
@@ -153,6 +158,48 @@ absl::Status NvshmemCollectives::Deallocate(void* buffer) {
   return absl::OkStatus();
 }
 
+absl::Status NvshmemCollectives::PutSignal(se::DeviceMemoryBase dst,
+                                           se::DeviceMemoryBase src,
+                                           uint64_t* signal,
+                                           uint64_t signal_value, RankId peer,
+                                           se::Stream& stream) {
+  TF_RETURN_IF_ERROR(InitializeOnce());
+  if (dst.size() < src.size()) {
+    return absl::InvalidArgumentError(absl::StrFormat(
+        "NVSHMEM put destination is smaller than the source: %d < %d",
+        dst.size(), src.size()));
+  }
+  VLOG(3) << absl::StreamFormat(
+      "Launch NVSHMEM put-signal on device #%d; dst=%p; src=%p; bytes=%d; "
+      "signal=%p; signal_value=%d; peer=%d; stream=%p",
+      stream.parent()->device_ordinal(), dst.opaque(), src.opaque(),
+      src.size(), signal, signal_value, peer.value(), &stream);
+  nvshmemx_putmem_signal_on_stream(dst.opaque(), src.opaque(), src.size(),
+                                   signal, signal_value, NVSHMEM_SIGNAL_SET,
+                                   peer.value(),
+                                   se::gpu::AsGpuStreamValue(&stream));
+  return absl::OkStatus();
+}
+
+absl::Status NvshmemCollectives::WaitSignal(uint64_t* signal,
+                                            uint64_t signal_value,
+                                            se::Stream& stream) {
+  TF_RETURN_IF_ERROR(InitializeOnce());
+  VLOG(3) << absl::StreamFormat(
+      "Launch NVSHMEM signal wait on device #%d; signal=%p; signal_value=%d; "
+      "stream=%p",
+      stream.parent()->device_ordinal(), signal, signal_value, &stream);
+  nvshmemx_signal_wait_until_on_stream(signal, NVSHMEM_CMP_GE, signal_value,
+                                       se::gpu::AsGpuStreamValue(&stream));
+  return absl::OkStatus();
+}
+
+absl::Status NvshmemCollectives::Quiet(se::Stream& stream) {
+  TF_RETURN_IF_ERROR(InitializeOnce());
+  nvshmemx_quiet_on_stream(se::gpu::AsGpuStreamValue(&stream));
+  return absl::OkStatus();
+}
+
 }  // namespace xla::gpu
 
 // NvshmemCollectives currently does not implement GpuCollectives, so it cannot
@@ -31,6 +31,8 @@ limitations under the License.
 #include "xla/core/collectives/communicator.h"
 #include "xla/core/collectives/rank_id.h"
 #include "xla/pjrt/distributed/key_value_store_interface.h"
+#include "xla/stream_executor/device_memory.h"
+#include "xla/stream_executor/stream.h"
 
 namespace xla::gpu {
 
@@ -49,6 +51,24 @@ class NvshmemCollectives : public Collectives {
 
   absl::Status Deallocate(void* buffer);
 
+  // Stream-ordered point-to-point primitives. They are issued by the device,
+  // so once enqueued they do not require any host involvement. All remote
+  // addresses (`dst` and `signal`) must be allocated with `Allocate`, as they
+  // are resolved on the peer through the NVSHMEM symmetric heap.
+
+  // Copies `src` into `dst` on `peer` and then sets `signal` on `peer` to
+  // `signal_value`. The peer observes the signal only after the data.
+  absl::Status PutSignal(se::DeviceMemoryBase dst, se::DeviceMemoryBase src,
+                         uint64_t* signal, uint64_t signal_value, RankId peer,
+                         se::Stream& stream);
+
+  // Makes `stream` wait until the local `signal` is at least `signal_value`.
+  absl::Status WaitSignal(uint64_t* signal, uint64_t signal_value,
+                          se::Stream& stream);
+
+  // Makes `stream` wait for completion of all puts previously issued on it.
+  absl::Status Quiet(se::Stream& stream);
+
   absl::StatusOr<CliqueId> CreateUniqueCliqueId() const final {
     return absl::UnimplementedError("Not implemented.");
   }
@@ -15,21 +15,31 @@ limitations under the License.
 
 #include "xla/backends/gpu/collectives/nvshmem_collectives.h"
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include <gtest/gtest.h>
+#include "absl/algorithm/container.h"
+#include "absl/functional/function_ref.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_format.h"
+#include "absl/strings/string_view.h"
 #include "absl/time/time.h"
 #include "third_party/gpus/cuda/include/cuda_runtime_api.h"
+#include "xla/core/collectives/rank_id.h"
 #include "xla/debug_options_flags.h"
 #include "xla/pjrt/distributed/client.h"
 #include "xla/pjrt/distributed/distributed.h"
 #include "xla/pjrt/distributed/service.h"
 #include "xla/status_macros.h"
+#include "xla/stream_executor/device_memory.h"
+#include "xla/stream_executor/platform.h"
+#include "xla/stream_executor/platform_manager.h"
+#include "xla/stream_executor/stream.h"
+#include "xla/stream_executor/stream_executor.h"
 #include "xla/tsl/platform/errors.h"
 #include "xla/tsl/platform/status.h"
 #include "xla/tsl/platform/statusor.h"
@@ -39,15 +49,15 @@ limitations under the License.
 namespace xla::gpu {
 namespace {
 
-// Tests that NVSHMEM library can be loaded and initialized.
-TEST(NvshmemTest, Initialization) {
-  const int num_nodes = 2;
-  tsl::SubProcess child[num_nodes];
+// Runs `test_case` in `num_nodes` child processes, one per device.
+void RunInSubprocesses(absl::string_view test_case, int num_nodes) {
+  std::vector<tsl::SubProcess> child(num_nodes);
   for (int node_id = 0; node_id < num_nodes; ++node_id) {
     std::vector<std::string> argv;
     argv.push_back("nvshmem_test");
     argv.push_back(absl::StrFormat("--node_id=%d", node_id));
     argv.push_back(absl::StrFormat("--num_nodes=%d", num_nodes));
+    argv.push_back(absl::StrFormat("--test_case=%s", test_case));
     child[node_id].SetProgram("/proc/self/exe", argv);
     child[node_id].SetChannelAction(tsl::CHAN_STDOUT, tsl::ACTION_PIPE);
     child[node_id].SetChannelAction(tsl::CHAN_STDERR, tsl::ACTION_PIPE);
@@ -64,7 +74,17 @@ TEST(NvshmemTest, Initialization) {
   }
 }
 
-absl::Status InitializationTestBody(const int node_id, const int num_nodes) {
+// Tests that NVSHMEM library can be loaded and initialized.
+TEST(NvshmemTest, Initialization) { RunInSubprocesses("initialization", 2); }
+
+// Tests that a put with signal from one device is observed by its peer.
+TEST(NvshmemTest, PutSignal) { RunInSubprocesses("put_signal", 2); }
+
+// Connects to the distributed runtime, which NVSHMEM uses to exchange its
+// unique id, and runs `body` while the connection is alive.
+absl::Status RunWithDistributedRuntime(
+    const int node_id, const int num_nodes,
+    absl::FunctionRef<absl::Status()> body) {
   std::unique_ptr<xla::DistributedRuntimeService> service;
   if (node_id == 0) {
     xla::CoordinationServiceImpl::Options service_options;
@@ -84,12 +104,70 @@ absl::Status InitializationTestBody(const int node_id, const int num_nodes) {
 
   NvshmemCollectives::Default()->SetEnvInfo(node_id, num_nodes, 1, kv_store);
   cudaSetDevice(node_id);
+  return body();
+}
+
+absl::Status InitializationTestBody() {
   TF_ASSIGN_OR_RETURN(void* ptr, NvshmemCollectives::Default()->Allocate(1024));
   TF_RET_CHECK(ptr != nullptr);
   TF_RETURN_IF_ERROR(NvshmemCollectives::Default()->Deallocate(ptr));
   return absl::OkStatus();
 }
 
+absl::Status PutSignalTestBody(const int node_id) {
+  NvshmemCollectives* nvshmem = NvshmemCollectives::Default();
+
+  TF_ASSIGN_OR_RETURN(se::Platform * platform,
+                      se::PlatformManager::PlatformWithName("CUDA"));
+  TF_ASSIGN_OR_RETURN(se::StreamExecutor * executor,
+                      platform->ExecutorForDevice(node_id));
+  TF_ASSIGN_OR_RETURN(std::unique_ptr<se::Stream> stream,
+                      executor->CreateStream());
+
+  // Symmetric allocations are collective, so every node allocates the same
+  // buffers in the same order.
+  constexpr int64_t kNumElements = 256;
+  constexpr uint64_t kBytes = kNumElements * sizeof(int32_t);
+  TF_ASSIGN_OR_RETURN(void* src_ptr, nvshmem->Allocate(kBytes));
+  TF_ASSIGN_OR_RETURN(void* dst_ptr, nvshmem->Allocate(kBytes));
+  TF_ASSIGN_OR_RETURN(void* signal_ptr, nvshmem->Allocate(sizeof(uint64_t)));
+  se::DeviceMemoryBase src(src_ptr, kBytes);
+  se::DeviceMemoryBase dst(dst_ptr, kBytes);
+  se::DeviceMemoryBase signal(signal_ptr, sizeof(uint64_t));
+  uint64_t* signal_addr = static_cast<uint64_t*>(signal_ptr);
+
+  TF_RETURN_IF_ERROR(stream->MemZero(&signal, sizeof(uint64_t)));
+  TF_RETURN_IF_ERROR(stream->MemZero(&dst, kBytes));
+  std::vector<int32_t> data(kNumElements);
+  absl::c_iota(data, node_id * kNumElements);
+  TF_RETURN_IF_ERROR(stream->Memcpy(&src, data.data(), kBytes));
+  TF_RETURN_IF_ERROR(stream->BlockHostUntilDone());
+
+  // Node 0 pushes its data to node 1, which waits on the signal on device.
+  if (node_id == 0) {
+    TF_RETURN_IF_ERROR(nvshmem->PutSignal(dst, src, signal_addr,
+                                          /*signal_value=*/1, RankId(1),
+                                          *stream));
+    TF_RETURN_IF_ERROR(nvshmem->Quiet(*stream));
+  } else {
+    TF_RETURN_IF_ERROR(
+        nvshmem->WaitSignal(signal_addr, /*signal_value=*/1, *stream));
+    std::vector<int32_t> result(kNumElements);
+    TF_RETURN_IF_ERROR(stream->Memcpy(result.data(), dst, kBytes));
+    TF_RETURN_IF_ERROR(stream->BlockHostUntilDone());
+
+    std::vector<int32_t> expected(kNumElements);
+    absl::c_iota(expected, 0);
+    TF_RET_CHECK(result == expected);
+  }
+  TF_RETURN_IF_ERROR(stream->BlockHostUntilDone());
+
+  TF_RETURN_IF_ERROR(nvshmem->Deallocate(signal_ptr));
+  TF_RETURN_IF_ERROR(nvshmem->Deallocate(dst_ptr));
+  TF_RETURN_IF_ERROR(nvshmem->Deallocate(src_ptr));
+  return absl::OkStatus();
+}
+
 }  // namespace
 }  // namespace xla::gpu
 
@@ -97,17 +175,26 @@ int main(int argc, char* argv[]) {
   // Save name of binary so that it may invoke itself.
   int node_id = -1;
   int num_nodes = -1;
+  std::string test_case;
   std::vector<tsl::Flag> flag_list = {
-      tsl::Flag("node_id", &node_id, "Node ID for Initialization test."),
+      tsl::Flag("node_id", &node_id, "Node ID for multi-process tests."),
       tsl::Flag("num_nodes", &num_nodes,
-                "Number of nodes for Initialization test."),
+                "Number of nodes for multi-process tests."),
+      tsl::Flag("test_case", &test_case,
+                "Test case to run in the child process."),
   };
   xla::AppendDebugOptionsFlags(&flag_list);
   std::string usage = tsl::Flags::Usage(argv[0], flag_list);
   tsl::Flags::Parse(&argc, argv, flag_list);
   testing::InitGoogleTest(&argc, argv);
   if (node_id >= 0) {
-    absl::Status result = xla::gpu::InitializationTestBody(node_id, num_nodes);
+    absl::Status result = xla::gpu::RunWithDistributedRuntime(
+        node_id, num_nodes, [&]() -> absl::Status {
+          if (test_case == "put_signal") {
+            return xla::gpu::PutSignalTestBody(node_id);
+          }
+          return xla::gpu::InitializationTestBody();
+        });
     if (!result.ok()) {
       LOG(ERROR) << result;
     }
@@ -16,23 +16,38 @@ limitations under the License.
 #include "xla/backends/gpu/runtime/all_reduce_thunk.h"
 
 #include <cstdint>
+#include <memory>
 #include <optional>
+#include <string>
 #include <utility>
 #include <vector>
 
+#include "absl/algorithm/container.h"
+#include "absl/container/inlined_vector.h"
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_format.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
 #include "xla/backends/gpu/collectives/gpu_clique_key.h"
 #include "xla/backends/gpu/collectives/gpu_collectives.h"
 #include "xla/backends/gpu/runtime/collective_thunk.h"
 #include "xla/backends/gpu/runtime/thunk.h"
 #include "xla/core/collectives/communicator.h"
+#include "xla/core/collectives/rank_id.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_instructions.h"
 #include "xla/service/collective_ops_utils.h"
 #include "xla/service/gpu/backend_configs.pb.h"
+#include "xla/service/gpu/kernels/all_reduce_kernel.h"
+#include "xla/service/gpu/kernels/all_reduce_kernel_common.h"
 #include "xla/service/gpu/transforms/collectives/collective_ops_utils.h"
+#include "xla/service/rendezvous.h"
 #include "xla/status_macros.h"
+#include "xla/stream_executor/device_memory.h"
+#include "xla/stream_executor/event.h"
 #include "xla/stream_executor/stream.h"
+#include "xla/stream_executor/stream_executor.h"
 #include "xla/tsl/platform/errors.h"
 #include "xla/tsl/platform/logging.h"
 #include "xla/tsl/platform/statusor.h"
@@ -60,6 +75,116 @@ absl::Status RunAllReduce(GpuCollectives* collectives,
   return collectives->GroupEnd();
 }
 
+namespace {
+
+// Contains the values that are passed between host threads with rendezvous.
+struct AllReduceRendezvousValue {
+  RankId rank;
+  se::DeviceMemoryBase input_buffer;
+  se::DeviceMemoryBase output_buffer;
+  se::Event* start_event;
+  se::Event* end_event;
+
+  bool operator<(const AllReduceRendezvousValue& other) const {
+    return rank < other.rank;
+  }
+};
+
+// Runs the all-reduce with the custom kernel that reads the inputs of all
+// peers directly (and, with the two-shot strategy, writes their outputs).
+//
+// Peer buffers may only be accessed while all participants are inside the
+// all-reduce, so the kernel is surrounded by two cross-device event barriers:
+// the first one guarantees that all inputs are ready and the second one that
+// no device overwrites its input or reads its output before all peers have
+// finished.
+absl::Status RunAllReduceWithKernel(const GpuCliqueKey& clique_key,
+                                    RankId rank, int64_t num_ranks,
+                                    const DeviceBufferPair& buffer,
+                                    se::Stream& stream, se::Event* start_event,
+                                    se::Event* end_event) {
+  int device_ordinal = stream.parent()->device_ordinal();
+  AllReduceStrategy strategy =
+      GetAllReduceStrategy(buffer.source_buffer.size(), num_ranks);
+  VLOG(3) << "Performing "
+          << (strategy == AllReduceStrategy::kOneShot ? "one-shot"
+                                                      : "two-shot")
+          << " all-reduce kernel from device ordinal: " << device_ordinal
+          << ", rank: " << rank.value();
+
+  AllReduceRendezvousValue rendezvous_value;
+  rendezvous_value.rank = rank;
+  rendezvous_value.input_buffer = buffer.source_buffer;
+  rendezvous_value.output_buffer = buffer.destination_buffer;
+  rendezvous_value.start_event = start_event;
+  rendezvous_value.end_event = end_event;
+
+  // Record that this device has started the all-reduce. We do this before the
+  // rendezvous to make sure that RecordEvent is called before WaitFor on
+  // another stream.
+  TF_RETURN_IF_ERROR(stream.RecordEvent(start_event));
+
+  auto rendezvous_fn =
+      [](absl::Span<const AllReduceRendezvousValue* const> values) {
+        std::vector<AllReduceRendezvousValue> values_copy;
+        for (const auto& value : values) {
+          values_copy.push_back(*value);
+        }
+        // Sort to make sure that values are in the same order as the devices
+        // are ordered in the communicator.
+        absl::c_sort(values_copy);
+        return values_copy;
+      };
+
+  std::string start_rendezvous_key =
+      absl::StrFormat("start all-reduce kernel for rank %d, clique %s",
+                      rank.value(), clique_key.ToString());
+  TF_ASSIGN_OR_RETURN(
+      std::shared_ptr<std::vector<AllReduceRendezvousValue>> rendezvous_values,
+      Rendezvous<std::vector<AllReduceRendezvousValue>>(
+          /*name=*/start_rendezvous_key, /*key=*/clique_key,
+          /*value=*/rendezvous_value, /*num_threads=*/num_ranks,
+          rendezvous_fn));
+
+  absl::InlinedVector<se::DeviceMemoryBase, kMaxNumAllReduceInputPtrs>
+      input_buffers;
+  absl::InlinedVector<se::DeviceMemoryBase, kMaxNumAllReduceInputPtrs>
+      output_buffers;
+  for (auto& value : *rendezvous_values) {
+    // Wait for all devices to reach the start event. This indicates that all
+    // input buffers are ready.
+    TF_RETURN_IF_ERROR(stream.WaitFor(value.start_event));
+    input_buffers.push_back(value.input_buffer);
+    output_buffers.push_back(value.output_buffer);
+  }
+
+  TF_RETURN_IF_ERROR(RunAllReduceKernel(
+      &stream, buffer.element_type, input_buffers, output_buffers,
+      rank.value(), buffer.element_count, strategy));
+
+  // Record that this device has finished the all-reduce kernel.
+  TF_RETURN_IF_ERROR(stream.RecordEvent(end_event));
+
+  // Do another rendezvous to make sure that we call RecordEvent for end_event
+  // before WaitFor on another stream.
+  std::string finish_rendezvous_key =
+      absl::StrFormat("finish all-reduce kernel for rank %d, clique %s",
+                      rank.value(), clique_key.ToString());
+  TF_RETURN_IF_ERROR(Rendezvous(/*name=*/finish_rendezvous_key,
+                                /*key=*/clique_key,
+                                /*num_threads=*/num_ranks));
+
+  // Wait for all devices to reach the end event. This indicates that all peers
+  // are done reading our input and writing our output.
+  for (auto& value : *rendezvous_values) {
+    TF_RETURN_IF_ERROR(stream.WaitFor(value.end_event));
+  }
+
+  return absl::OkStatus();
+}
+
+}  // namespace
+
 namespace impl {
 
 absl::Status CheckImplementableInst(const HloInstruction* inst,
@@ -111,7 +236,12 @@ AllReduceStartThunk::AllReduceStartThunk(ThunkInfo thunk_info,
     : AllReduceReduceScatterThunkBase(Thunk::kAllReduceStart, thunk_info,
                                       impl::GetAllReduceConfigInst(inst),
                                       std::move(buffers),
-                                      IsGPUSyncCollective(*inst)) {}
+                                      IsGPUSyncCollective(*inst)),
+      kernel_threshold_bytes_(
+          inst->GetModule()
+              ->config()
+              .debug_options()
+              .xla_gpu_all_reduce_kernel_threshold_bytes()) {}
 
 absl::Status AllReduceStartThunk::CheckImplementable(
     const HloAllReduceInstruction* inst, int64_t replica_count,
@@ -126,6 +256,56 @@ CollectiveOpGroupMode AllReduceStartThunk::GetGroupMode(
   return impl::GetGroupModeInst(inst);
 }
 
+absl::Status AllReduceStartThunk::Initialize(const InitializeParams& params) {
+  TF_RETURN_IF_ERROR(CollectiveThunk::Initialize(params));
+  if (kernel_threshold_bytes_ <= 0) {
+    return absl::OkStatus();
+  }
+
+  se::StreamExecutor* executor = params.executor;
+  absl::MutexLock lock(&events_mutex_);
+  if (!start_events_.count(executor)) {
+    TF_ASSIGN_OR_RETURN(std::unique_ptr<se::Event> event,
+                        executor->CreateEvent());
+    start_events_.insert({executor, std::move(event)});
+  }
+
+  if (!end_events_.count(executor)) {
+    TF_ASSIGN_OR_RETURN(std::unique_ptr<se::Event> event,
+                        executor->CreateEvent());
+    end_events_.insert({executor, std::move(event)});
+  }
+  return absl::OkStatus();
+}
+
+absl::StatusOr<bool> AllReduceStartThunk::ShouldUseAllReduceKernel(
+    const ExecuteParams& params, const CommunicatorHandle& comm_handle,
+    absl::Span<const DeviceBufferPair> device_buffers) const {
+  // All participants must take the same decision, so it may only depend on
+  // properties that are identical on all of them.
+  if (kernel_threshold_bytes_ <= 0 ||
+      config_.reduction_kind != ReductionKind::SUM ||
+      device_buffers.size() != 1 || !comm_handle.clique_key.is_local()) {
+    return false;
+  }
+
+  const DeviceBufferPair& buffer = device_buffers.front();
+  // In-place all-reduces would overwrite inputs that peers are still reading.
+  int64_t num_bytes = buffer.source_buffer.size();
+  if (num_bytes > kernel_threshold_bytes_ ||
+      buffer.source_buffer.IsSameAs(buffer.destination_buffer)) {
+    return false;
+  }
+
+  TF_ASSIGN_OR_RETURN(int32_t num_ranks, comm_handle.comm->NumRanks());
+  if (!IsAllReduceKernelSupported(num_ranks, buffer.element_type)) {
+    return false;
+  }
+
+  return params.collective_cliques->peer_access_enabled(
+      comm_handle.clique_key);
+}
+
 absl::Status AllReduceStartThunk::RunCollective(
     const ExecuteParams& params, se::Stream& stream,
     CommunicatorHandle comm_handle) {
@@ -133,6 +313,30 @@ absl::Status AllReduceStartThunk::RunCollective(
       std::vector<DeviceBufferPair> device_buffers,
       ConvertToDeviceBuffers(params, buffers_,
                              config_.config.operand_element_type));
+
+  TF_ASSIGN_OR_RETURN(
+      bool use_all_reduce_kernel,
+      ShouldUseAllReduceKernel(params, comm_handle, device_buffers));
+  if (use_all_reduce_kernel) {
+    std::optional<RankId> rank =
+        comm_handle.clique_key.rank(params.collective_params->global_device_id);
+    TF_RET_CHECK(rank.has_value());
+    TF_ASSIGN_OR_RETURN(int32_t num_ranks, comm_handle.comm->NumRanks());
+
+    se::Event* start_event = nullptr;
+    se::Event* end_event = nullptr;
+    {
+      absl::MutexLock lock(&events_mutex_);
+      start_event = start_events_[stream.parent()].get();
+      end_event = end_events_[stream.parent()].get();
+    }
+    TF_RET_CHECK(start_event != nullptr && end_event != nullptr);
+
+    return RunAllReduceWithKernel(comm_handle.clique_key, *rank, num_ranks,
+                                  device_buffers.front(), stream, start_event,
+                                  end_event);
+  }
+
   TF_ASSIGN_OR_RETURN(GpuCollectives * collectives, GetGpuCollectives(params));
   return ::xla::gpu::RunAllReduce(collectives, config_.reduction_kind,
                                   device_buffers, stream, comm_handle.comm);
@@ -17,16 +17,23 @@ limitations under the License.
 #define XLA_BACKENDS_GPU_RUNTIME_ALL_REDUCE_THUNK_H_
 
 #include <cstdint>
+#include <memory>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
 #include "xla/backends/gpu/collectives/gpu_collectives.h"
 #include "xla/backends/gpu/runtime/collective_thunk.h"
 #include "xla/core/collectives/communicator.h"
 #include "xla/hlo/ir/hlo_instructions.h"
 #include "xla/service/collective_ops_utils.h"
+#include "xla/stream_executor/event.h"
 #include "xla/stream_executor/stream.h"
+#include "xla/stream_executor/stream_executor.h"
 
 namespace xla {
 namespace gpu {
@@ -73,9 +80,31 @@ class AllReduceStartThunk : public AllReduceReduceScatterThunkBase {
   static CollectiveOpGroupMode GetGroupMode(
       const HloAllReduceInstruction* inst);
 
+  absl::Status Initialize(const InitializeParams& params) override;
+
  protected:
   absl::Status RunCollective(const ExecuteParams& params, se::Stream& stream,
                              CommunicatorHandle comm_handle) override;
+
+ private:
+  // Returns true if the all-reduce should be performed with the custom
+  // all-reduce kernel instead of NCCL.
+  absl::StatusOr<bool> ShouldUseAllReduceKernel(
+      const ExecuteParams& params, const CommunicatorHandle& comm_handle,
+      absl::Span<const DeviceBufferPair> device_buffers) const;
+
+  // All-reduces of at most this many bytes use the custom all-reduce kernel
+  // when it is supported. Zero disables the kernel.
+  const int64_t kernel_threshold_bytes_;
+
+  absl::Mutex events_mutex_;
+  // Events to synchronize steams on different devices at the start of the
+  // kernel.
+  absl::flat_hash_map<se::StreamExecutor*, std::unique_ptr<se::Event>>
+      start_events_ ABSL_GUARDED_BY(events_mutex_);
+  // Events to synchronize steams on different devices at the end of the kernel.
+  absl::flat_hash_map<se::StreamExecutor*, std::unique_ptr<se::Event>>
+      end_events_ ABSL_GUARDED_BY(events_mutex_);
 };
 
 // -----------------------------------------------------------------------------
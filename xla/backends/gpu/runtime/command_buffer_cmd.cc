@@ -56,6 +56,8 @@ limitations under the License.
 #include "xla/ffi/call_frame.h"
 #include "xla/ffi/ffi_api.h"
 #include "xla/runtime/buffer_use.h"
+#include "xla/runtime/execution_graph.h"
+#include "xla/runtime/resource_use.h"
 #include "xla/service/buffer_assignment.h"
 #include "xla/service/collective_ops_utils.h"
 #include "xla/service/computation_placer.h"
@@ -220,16 +222,68 @@ CommandBufferCmdSequence CommandBufferCmdSequence::Builder::Build(
   return CommandBufferCmdSequence(synchronization_mode, std::move(commands_));
 }
 
+namespace {
+// An adaptor from CommandBufferCmd to ExecutionGraph::Operation for building an
+// execution graph from a command sequence.
+struct CommandOperation : public ExecutionGraph::Operation {
+  CommandOperation(CommandBufferCmd::BufferUseVector buffers,
+                   absl::InlinedVector<ResourceUse, 2> resources)
+      : buffers(std::move(buffers)), resources(std::move(resources)) {}
+
+  absl::Span<const BufferUse> BufferUses() const final { return buffers; }
+  absl::Span<const ResourceUse> ResourceUses() const final { return resources; }
+
+ private:
+  CommandBufferCmd::BufferUseVector buffers;
+  absl::InlinedVector<ResourceUse, 2> resources;
+};
+}  // namespace
+
+// Creates an execution graph for commands from their buffer uses and execution
+// stream assignment. Commands assigned to the same execution stream keep their
+// original order, and commands assigned to different streams depend on each
+// other only if they have buffer conflicts (or if both are collectives).
+static absl::StatusOr<ExecutionGraph> CreateExecutionGraph(
+    absl::Span<const std::unique_ptr<CommandBufferCmd>> commands) {
+  // We model execution streams as token resources to order commands assigned
+  // to the same stream.
+  absl::flat_hash_map<uint64_t, std::shared_ptr<Resource>> streams;
+  std::shared_ptr<Resource> communicator =
+      Resource::Create(Resource::kCollectiveCommunicator);
+
+  std::vector<CommandOperation> operations;
+  operations.reserve(commands.size());
+  for (const std::unique_ptr<CommandBufferCmd>& command : commands) {
+    std::shared_ptr<Resource>& stream =
+        streams[command->execution_stream_id().value()];
+    if (stream == nullptr) stream = Resource::Create(Resource::kToken);
+
+    absl::InlinedVector<ResourceUse, 2> resources = {
+        ResourceUse::Write(stream)};
+    if (dynamic_cast<const CollectiveCmd*>(command.get())) {
+      resources.push_back(ResourceUse::Write(communicator));
+    }
+    operations.emplace_back(command->buffers(), std::move(resources));
+  }
+
+  return ExecutionGraph::Create<CommandOperation>(operations);
+}
+
 CommandBufferCmdSequence::CommandBufferCmdSequence(
     SynchronizationMode synchronization_mode,
     std::vector<std::unique_ptr<CommandBufferCmd>> commands)
     : synchronization_mode_(synchronization_mode),
       commands_(std::move(commands)) {
   // Record all buffers used by commands in the sequence.
+  commands_allocs_indices_.reserve(commands_.size());
   for (const std::unique_ptr<CommandBufferCmd>& cmd : commands_) {
+    auto& cmd_allocs_indices = commands_allocs_indices_.emplace_back();
     for (const BufferUse& buffer : cmd->buffers()) {
       buffers_.insert(buffer);
       allocs_indices_.insert(buffer.slice().index());
+      if (!absl::c_linear_search(cmd_allocs_indices, buffer.slice().index())) {
+        cmd_allocs_indices.push_back(buffer.slice().index());
+      }
     }
   }
 }
@@ -301,13 +355,60 @@ CommandBufferCmdSequence::RecordCreate(
   // Keep a state associated with commands in the sequence in the state manager.
   CommandBufferCmd::StateManager& state = record_params.state;
 
-  for (std::unique_ptr<CommandBufferCmd>& command : commands_) {
+  using Dependencies =
+      absl::InlinedVector<const se::CommandBuffer::Command*, 4>;
+
+  // In automatic synchronization mode we record commands as a DAG defined by
+  // the execution graph, and commands assigned to different execution streams
+  // become concurrent branches of the command buffer.
+  std::optional<ExecutionGraph> execution_graph;
+  if (synchronization_mode_ == SynchronizationMode::kAutomatic) {
+    TF_ASSIGN_OR_RETURN(execution_graph, CreateExecutionGraph(commands_));
+  }
+
+  // Dependencies of the source commands in the execution graph. Empty
+  // dependencies mean an implicit dependency on the last recorded command, so
+  // with multiple source commands we fork them from an empty command.
+  Dependencies source_dependencies(dependencies.begin(), dependencies.end());
+  if (execution_graph && source_dependencies.empty() &&
+      execution_graph->source().size() > 1) {
+    TF_ASSIGN_OR_RETURN(const se::CommandBuffer::Command* fork,
+                        command_buffer->CreateEmptyCmd({}));
+    source_dependencies.push_back(fork);
+  }
+
+  // Commands that signal completion of each command in the sequence. For
+  // skipped commands we forward their own dependencies.
+  std::vector<Dependencies> completions(commands_.size());
+
+  // Returns dependencies of the command at `index` in the execution graph.
+  auto command_dependencies = [&](size_t index) {
+    absl::Span<const ExecutionGraph::NodeId> in_edges =
+        execution_graph->in_edges(index);
+    if (in_edges.empty()) return source_dependencies;
+
+    Dependencies deps;
+    for (ExecutionGraph::NodeId in_edge : in_edges) {
+      for (const se::CommandBuffer::Command* dep : completions[in_edge]) {
+        if (!absl::c_linear_search(deps, dep)) deps.push_back(dep);
+      }
+    }
+    return deps.empty() ? source_dependencies : deps;
+  };
+
+  for (size_t i = 0; i < commands_.size(); ++i) {
+    std::unique_ptr<CommandBufferCmd>& command = commands_[i];
+
     std::optional<tsl::profiler::ScopedAnnotation> annotation =
         GetKernelAnnotation(command->profile_annotation());
 
+    Dependencies command_deps;
+    if (execution_graph) command_deps = command_dependencies(i);
+
     // Skip recording collective commands if mock collectives are enabled.
     if (execute_params.mock_collectives &&
         dynamic_cast<CollectiveCmd*>(command.get())) {
+      completions[i] = std::move(command_deps);
       continue;
     }
 
@@ -317,22 +418,34 @@ CommandBufferCmdSequence::RecordCreate(
     auto* record_state =
         state.GetOrCreate<RecordState>(command.get(), command_buffer);
 
-    // TODO(b/406370928): Fetch command dependencies computed from the command
-    // sequence, today we rely on implicit synchronization of all commands.
-    auto record_action = CommandBufferCmd::RecordCreate{};
+    // In serialize mode dependencies are empty, and we rely on implicit
+    // synchronization of all commands.
+    auto record_action =
+        CommandBufferCmd::RecordCreate{absl::MakeSpan(command_deps)};
 
     TF_ASSIGN_OR_RETURN(
         record_state->command,
         command->Record(execute_params, record_params, std::move(record_action),
                         command_buffer));
+    completions[i] = {record_state->command};
   }
 
   uint64_t end_micros = tsl::Env::Default()->NowMicros();
   VLOG(3) << "Created " << commands_.size() << " commands in "
           << (end_micros - start_micros) << " μs";
 
-  // TODO(b/406370928): Depending on synchronization mode we must collect
-  // commands created for all sink nodes in the execution graph.
+  // In automatic mode the next command sequence must depend on all sink
+  // commands of the execution graph.
+  if (execution_graph) {
+    std::vector<const se::CommandBuffer::Command*> sinks;
+    for (ExecutionGraph::NodeId sink : execution_graph->sink()) {
+      for (const se::CommandBuffer::Command* dep : completions[sink]) {
+        if (!absl::c_linear_search(sinks, dep)) sinks.push_back(dep);
+      }
+    }
+    return sinks;
+  }
+
   auto* last_recorded =
       state.GetOrNull<RecordState>(commands_.back().get(), command_buffer);
   DCHECK(last_recorded) << "Last recorded command state must be not null";
@@ -357,7 +470,14 @@ absl::Status CommandBufferCmdSequence::RecordUpdate(
   // Keep a state associated with commands in the sequence in the state manager.
   CommandBufferCmd::StateManager& state = record_params.state;
 
-  for (std::unique_ptr<CommandBufferCmd>& command : commands_) {
+  size_t num_updated = 0;
+
+  for (size_t i = 0; i < commands_.size(); ++i) {
+    std::unique_ptr<CommandBufferCmd>& command = commands_[i];
+
+    // Skip updating commands that do not reference updated allocations.
+    if (!ShouldUpdateCommand(i, record_params)) continue;
+
     std::optional<tsl::profiler::ScopedAnnotation> annotation =
         GetKernelAnnotation(command->profile_annotation());
 
@@ -379,11 +499,12 @@ absl::Status CommandBufferCmdSequence::RecordUpdate(
         record_state->command,
         command->Record(execute_params, record_params, std::move(record_action),
                         command_buffer));
+    ++num_updated;
   }
 
   uint64_t end_micros = tsl::Env::Default()->NowMicros();
-  VLOG(3) << "Updated " << commands_.size() << " commands in "
-          << (end_micros - start_micros) << " μs";
+  VLOG(3) << "Updated " << num_updated << " out of " << commands_.size()
+          << " commands in " << (end_micros - start_micros) << " μs";
 
   return absl::OkStatus();
 }
@@ -398,6 +519,27 @@ absl::Status CommandBufferCmdSequence::CheckCommandBufferState(
   return absl::OkStatus();
 }
 
+size_t CommandBufferCmdSequence::NumCommandsToUpdate(
+    const RecordParams& record_params) const {
+  size_t num_commands = 0;
+  for (size_t i = 0; i < commands_.size(); ++i) {
+    num_commands += ShouldUpdateCommand(i, record_params);
+  }
+  return num_commands;
+}
+
+bool CommandBufferCmdSequence::ShouldUpdateCommand(
+    size_t index, const RecordParams& record_params) const {
+  if (record_params.updated_allocs == nullptr) return true;
+  if (commands_[index]->force_update()) return true;
+
+  return absl::c_any_of(commands_allocs_indices_[index],
+                        [&](BufferAllocation::Index alloc_index) {
+                          return record_params.updated_allocs->contains(
+                              alloc_index);
+                        });
+}
+
 const absl::flat_hash_set<BufferUse>& CommandBufferCmdSequence::buffers()
     const {
   return buffers_;
@@ -1091,39 +1233,11 @@ CublasLtCmd::CublasLtCmd(
       d_amax_buffer_(d_amax_buffer),
       workspace_buffer_(workspace_buffer) {}
 
-absl::StatusOr<se::gpu::BlasLt::MatmulPlan*> CublasLtCmd::GetMatmulPlan(
+absl::StatusOr<const MatmulPlanCache::Entry*> CublasLtCmd::GetMatmulPlan(
     const se::Stream* stream) {
-  {
-    absl::MutexLock lock(&matmul_plans_cache_mutex_);
-    auto it = matmul_plans_cache_.find(stream);
-    if (it != matmul_plans_cache_.end()) return it->second.get();
-  }
-  TF_ASSIGN_OR_RETURN(auto plan, se::gpu::BlasLt::GetMatmulPlan(
-                                     stream, gemm_config_, epilogue_));
-
-  absl::MutexLock lock(&matmul_plans_cache_mutex_);
-  auto [it_insert, _] = matmul_plans_cache_.emplace(stream, std::move(plan));
-  return it_insert->second.get();
-}
-
-absl::StatusOr<se::gpu::BlasLt::MatmulAlgorithm>
-CublasLtCmd::GetMatmulAlgorithm(const se::Stream* stream,
-                                const se::gpu::BlasLt::MatmulPlan* plan,
-                                int64_t max_workspace) {
-  {
-    absl::MutexLock lock(&matmul_algorithm_cache_mutex_);
-    auto it = matmul_algorithm_cache_.find(plan);
-    if (it != matmul_algorithm_cache_.end()) return it->second;
-  }
-  TF_ASSIGN_OR_RETURN(
-      auto algorithms,
-      plan->GetAlgorithms(stream, /*max_algorithm_count*/ 128,
-                          /*max_workspace_size*/ max_workspace));
-  TF_RET_CHECK(algorithm_idx_ >= 0 && algorithm_idx_ < algorithms.size());
-  absl::MutexLock lock(&matmul_algorithm_cache_mutex_);
-  auto [it_insert, _] =
-      matmul_algorithm_cache_.emplace(plan, algorithms[algorithm_idx_]);
-  return it_insert->second;
+  return MatmulPlanCache::Global().GetOrCreate(stream, gemm_config_, epilogue_,
+                                               algorithm_idx_,
+                                               workspace_buffer_.size());
 }
 
 absl::Status CublasLtCmd::Initialize(const Thunk::InitializeParams& params,
@@ -1132,21 +1246,15 @@ absl::Status CublasLtCmd::Initialize(const Thunk::InitializeParams& params,
     return absl::InternalError("Failed to initialize BLAS support for GemmCmd");
   }
   // Populate plan and algorithm cache;
-  TF_ASSIGN_OR_RETURN(auto plan, GetMatmulPlan(params.stream));
-  TF_RETURN_IF_ERROR(
-      GetMatmulAlgorithm(params.stream, plan, workspace_buffer_.size())
-          .status());
-  return absl::OkStatus();
+  return GetMatmulPlan(params.stream).status();
 }
 
 absl::StatusOr<const se::CommandBuffer::Command*> CublasLtCmd::Record(
     const Thunk::ExecuteParams& execute_params,
     const RecordParams& record_params, RecordAction record_action,
     se::CommandBuffer* command_buffer) {
-  TF_ASSIGN_OR_RETURN(auto plan, GetMatmulPlan(execute_params.stream));
-  TF_ASSIGN_OR_RETURN(auto algorithm,
-                      GetMatmulAlgorithm(execute_params.stream, plan,
-                                         workspace_buffer_.size()));
+  TF_ASSIGN_OR_RETURN(const MatmulPlanCache::Entry* entry,
+                      GetMatmulPlan(execute_params.stream));
 
   const BufferAllocations& allocs = *execute_params.buffer_allocations;
 
@@ -1190,12 +1298,12 @@ absl::StatusOr<const se::CommandBuffer::Command*> CublasLtCmd::Record(
   return RecordTracedCommand(
       execute_params, record_params, std::move(record_action), command_buffer,
       [&](se::Stream* stream) {
-        return plan->ExecuteOnStream(
+        return entry->plan->ExecuteOnStream(
             stream, allocs.GetDeviceAddress(a_buffer_),
             allocs.GetDeviceAddress(b_buffer_),
             allocs.GetDeviceAddress(c_buffer_),
             allocs.GetDeviceAddress(d_buffer_), bias, aux, a_scale, b_scale,
-            c_scale, d_scale, d_amax, algorithm,
+            c_scale, d_scale, d_amax, entry->algorithm,
             allocs.GetDeviceAddress(workspace_buffer_));
       });
 }
@@ -1297,11 +1405,38 @@ CommandBufferCmd::BufferUseVector CuDnnCmd::buffers() {
 // CustomCallCmd
 //===----------------------------------------------------------------------===//
 
+absl::Status CustomCallCmd::Prepare(
+    const Thunk::PrepareParams& params,
+    Thunk::ResourceRequestsInterface& resource_requests) {
+  if (!bundle_ || !bundle_->prepare) {
+    return absl::OkStatus();
+  }
+
+  return CallXlaFfiHandler(
+      params.collective_params ? params.collective_params->run_id : RunId{-1},
+      bundle_->prepare, XLA_FFI_ExecutionStage_PREPARE,
+      /*stream=*/nullptr,
+      /*execution_context=*/nullptr,
+      /*buffer_allocations=*/nullptr);
+}
+
+absl::Status CustomCallCmd::Initialize(const Thunk::InitializeParams& params,
+                                       StateManager& state) {
+  if (!bundle_ || !bundle_->initialize) {
+    return absl::OkStatus();
+  }
+
+  return CallXlaFfiHandler(
+      params.collective_params ? params.collective_params->run_id : RunId{-1},
+      bundle_->initialize, XLA_FFI_ExecutionStage_INITIALIZE, params.stream,
+      params.ffi_execution_context, params.buffer_allocations);
+}
+
 absl::StatusOr<const se::CommandBuffer::Command*> CustomCallCmd::Record(
     const Thunk::ExecuteParams& execute_params,
     const RecordParams& record_params, RecordAction record_action,
     se::CommandBuffer* command_buffer) {
-  if (handler_ == nullptr) {
+  if (!bundle_.has_value()) {
     return RecordLegacyCustomCall(execute_params, record_params,
                                   std::move(record_action), command_buffer);
   }
@@ -1382,26 +1517,56 @@ CustomCallCmd::RecordXlaFfiCall(const Thunk::ExecuteParams& execute_params,
                                 const RecordParams& record_params,
                                 RecordAction record_action,
                                 se::CommandBuffer* command_buffer) {
-  // TODO(ezhulenev): This is not the most optimal approach, as we'll be doing
-  // a lot of extra allocation on every call. We have to keep attributes
-  // separate from arguments, as they do not change after thunk is
-  // constructed.
+  VLOG(5) << "CustomCallCmd: target_name=" << target_name_;
+
+  RunId run_id = execute_params.collective_params->run_id;
+
+  TF_ASSIGN_OR_RETURN(
+      auto nested_cmd,
+      se::TraceCommandBufferFactory::Create(
+          execute_params.stream->parent(),
+          execute_params.command_buffer_trace_stream, [&](se::Stream* stream) {
+            return CallXlaFfiHandler(run_id, bundle_->execute,
+                                     XLA_FFI_ExecutionStage_EXECUTE, stream,
+                                     execute_params.ffi_execution_context,
+                                     execute_params.buffer_allocations);
+          }));
+
+  return Handle(
+      std::move(record_action),
+      [&](absl::Span<const se::CommandBuffer::Command*> dependencies) {
+        return command_buffer->CreateNestedCommand(*nested_cmd, dependencies);
+      },
+      [&](const se::CommandBuffer::Command* command) {
+        return command_buffer->UpdateNestedCommand(command, *nested_cmd);
+      });
+}
+
+absl::Status CustomCallCmd::CallXlaFfiHandler(
+    RunId run_id, XLA_FFI_Handler* handler, XLA_FFI_ExecutionStage stage,
+    se::Stream* stream, const ffi::ExecutionContext* execution_context,
+    const BufferAllocations* buffer_allocations) {
+  // Commands are recorded only when buffer allocations change, so unlike
+  // CustomCallThunk we don't keep a prebuilt call frame around.
   ffi::CallFrameBuilder builder(operands_.size(), results_.size());
 
-  VLOG(5) << "CustomCallCmd: target_name=" << target_name_;
+  auto device_address = [&](const Slice& slice) -> se::DeviceMemoryBase {
+    return buffer_allocations
+               ? buffer_allocations->GetDeviceAddress(slice.slice)
+               : se::DeviceMemoryBase{};
+  };
 
   for (int i = 0; i < operands_.size(); ++i) {
     const std::optional<Slice>& slice = operands_[i];
-    // TODO(ezhulenev): Add a token argument type to XLA:FFI.
     if (!slice.has_value()) {
-      return Internal("FFI handlers do not support tokens (yet)!");
+      builder.AddTokenArg();
+      continue;
     }
 
     if (!slice->slice.allocation())
       return Internal("custom call input missing buffer allocation");
 
-    se::DeviceMemoryBase buffer =
-        execute_params.buffer_allocations->GetDeviceAddress(slice->slice);
+    se::DeviceMemoryBase buffer = device_address(*slice);
     VLOG(5) << "  Operand " << i << ": " << slice->slice << " ("
             << buffer.opaque() << ")";
     builder.AddBufferArg(buffer, slice->shape.element_type(),
@@ -1410,16 +1575,15 @@ CustomCallCmd::RecordXlaFfiCall(const Thunk::ExecuteParams& execute_params,
 
   for (int i = 0; i < results_.size(); ++i) {
     const std::optional<Slice>& slice = results_[i];
-    // TODO(ezhulenev): Add a token argument type to XLA:FFI.
     if (!slice.has_value()) {
-      return Internal("FFI handlers do not support tokens (yet)!");
+      builder.AddTokenRet();
+      continue;
     }
 
     if (!slice->slice.allocation())
       return Internal("custom call input missing buffer allocation");
 
-    se::DeviceMemoryBase buffer =
-        execute_params.buffer_allocations->GetDeviceAddress(slice->slice);
+    se::DeviceMemoryBase buffer = device_address(*slice);
     VLOG(5) << "  Result " << i << ": " << slice->slice << " ("
             << buffer.opaque() << ")";
     builder.AddBufferRet(buffer, slice->shape.element_type(),
@@ -1431,31 +1595,20 @@ CustomCallCmd::RecordXlaFfiCall(const Thunk::ExecuteParams& execute_params,
   builder.AddAttributes(attrs.Build());
   ffi::CallFrame call_frame = builder.Build();
 
-  RunId run_id = execute_params.collective_params->run_id;
-
-  TF_ASSIGN_OR_RETURN(
-      auto nested_cmd,
-      se::TraceCommandBufferFactory::Create(
-          execute_params.stream->parent(),
-          execute_params.command_buffer_trace_stream, [&](se::Stream* stream) {
-            ffi::CallOptions options = {
-                run_id, execute_params.buffer_allocations->device_ordinal(),
-                ffi::CallOptions::GpuOptions{
-                    stream,
-                    execute_params.buffer_allocations->memory_allocator()},
-                /*called_computation=*/nullptr,  // TODO(b/342285364)
-                execute_params.ffi_execution_context};
-            return ffi::Call(handler_, call_frame, options);
-          }));
+  int32_t device_ordinal = -1;
+  se::DeviceMemoryAllocator* allocator = nullptr;
+  if (buffer_allocations) {
+    device_ordinal = buffer_allocations->device_ordinal();
+    allocator = buffer_allocations->memory_allocator();
+  }
 
-  return Handle(
-      std::move(record_action),
-      [&](absl::Span<const se::CommandBuffer::Command*> dependencies) {
-        return command_buffer->CreateNestedCommand(*nested_cmd, dependencies);
-      },
-      [&](const se::CommandBuffer::Command* command) {
-        return command_buffer->UpdateNestedCommand(command, *nested_cmd);
-      });
+  ffi::CallOptions options = {run_id,
+                              device_ordinal,
+                              ffi::CallOptions::GpuOptions{stream, allocator},
+                              called_computation_,
+                              execution_context,
+                              execution_state_.get()};
+  return ffi::Call(handler, call_frame, options, stage);
 }
 
 CommandBufferCmd::BufferUseVector CustomCallCmd::buffers() {
@@ -41,8 +41,12 @@ limitations under the License.
 #include "xla/backends/gpu/runtime/collective_thunk.h"
 #include "xla/backends/gpu/runtime/custom_call_thunk.h"
 #include "xla/backends/gpu/runtime/dynamic_slice_thunk.h"
+#include "xla/backends/gpu/runtime/gpublas_lt_matmul_plan_cache.h"
 #include "xla/backends/gpu/runtime/thunk.h"
+#include "xla/executable_run_options.h"
 #include "xla/ffi/api/c_api.h"
+#include "xla/ffi/execution_context.h"
+#include "xla/ffi/execution_state.h"
 #include "xla/hlo/ir/hlo_computation.h"
 #include "xla/runtime/buffer_use.h"
 #include "xla/service/buffer_assignment.h"
@@ -198,6 +202,14 @@ class CommandBufferCmd {
     // An external state manager that gives efficient access to per-device state
     // to commands without a need to add expensive synchronization.
     StateManager& state;
+
+    // Buffer allocations that changed since the last time commands were
+    // recorded into the command buffer. If not null, updates skip commands that
+    // do not reference any of the updated allocations (unless they require an
+    // update on every call), as their previously recorded parameters are still
+    // valid. If null, all commands are updated.
+    const absl::flat_hash_set<BufferAllocation::Index>* updated_allocs =
+        nullptr;
   };
 
   // Create new commands in the command buffer using the given dependencies.
@@ -396,6 +408,10 @@ class CommandBufferCmdSequence {
                             const RecordParams& record_params,
                             se::CommandBuffer* command_buffer);
 
+  // Returns the number of commands that `RecordUpdate` updates in the command
+  // buffer given the updated allocations in `record_params`.
+  size_t NumCommandsToUpdate(const RecordParams& record_params) const;
+
   // Returns buffers referenced by commands in this sequence.
   const absl::flat_hash_set<BufferUse>& buffers() const;
 
@@ -424,6 +440,11 @@ class CommandBufferCmdSequence {
   absl::Status CheckCommandBufferState(se::CommandBuffer* command_buffer,
                                        se::CommandBuffer::State expected_state);
 
+  // Returns true if the command at `index` has to be updated in the command
+  // buffer given the updated allocations in `record_params`.
+  bool ShouldUpdateCommand(size_t index,
+                           const RecordParams& record_params) const;
+
   SynchronizationMode synchronization_mode_;
   std::vector<std::unique_ptr<CommandBufferCmd>> commands_;
 
@@ -432,6 +453,11 @@ class CommandBufferCmdSequence {
 
   // Buffer allocations indices referenced by commands in this sequence.
   absl::flat_hash_set<BufferAllocation::Index> allocs_indices_;
+
+  // Buffer allocations indices referenced by each command in the sequence,
+  // used to skip updates of commands with unchanged buffers.
+  std::vector<absl::InlinedVector<BufferAllocation::Index, 4>>
+      commands_allocs_indices_;
 };
 
 //===----------------------------------------------------------------------===//
@@ -765,22 +791,11 @@ class CublasLtCmd : public TracedCommandBufferCmd {
   bool IsNestedCommandBuffer() const final { return true; }
 
  private:
-  absl::StatusOr<se::gpu::BlasLt::MatmulPlan*> GetMatmulPlan(
+  // Returns the matmul plan and algorithm of this command from the
+  // process-wide cache shared with the cuBLASLt thunks.
+  absl::StatusOr<const MatmulPlanCache::Entry*> GetMatmulPlan(
       const se::Stream* stream);
 
-  absl::StatusOr<se::gpu::BlasLt::MatmulAlgorithm> GetMatmulAlgorithm(
-      const se::Stream* stream, const se::gpu::BlasLt::MatmulPlan* plan,
-      int64_t max_workspace);
-
-  absl::Mutex matmul_plans_cache_mutex_;
-  absl::flat_hash_map<const se::Stream*, se::gpu::BlasLt::MatmulPlanPtr>
-      matmul_plans_cache_ ABSL_GUARDED_BY(matmul_plans_cache_mutex_);
-
-  absl::Mutex matmul_algorithm_cache_mutex_;
-  absl::flat_hash_map<const se::gpu::BlasLt::MatmulPlan*,
-                      se::gpu::BlasLt::MatmulAlgorithm>
-      matmul_algorithm_cache_ ABSL_GUARDED_BY(matmul_algorithm_cache_mutex_);
-
   const GemmConfig gemm_config_;
   const se::gpu::BlasLt::Epilogue epilogue_;
   const int64_t algorithm_idx_;
@@ -850,21 +865,34 @@ class CustomCallCmd : public CommandBufferCmd {
         operands_(std::move(operands)),
         results_(std::move(results)) {}
 
+  // The execute handler of `bundle` is recorded into the command buffer by
+  // tracing, and the prepare and initialize handlers run with the
+  // corresponding stages of the command buffer. `execution_state` is the state
+  // created by the instantiate handler, usually shared with a CustomCallThunk.
   CustomCallCmd(ExecutionStreamId execution_stream_id, std::string target_name,
-                XLA_FFI_Handler* handler,
+                XLA_FFI_Handler_Bundle bundle,
                 std::vector<std::optional<Slice>> operands,
                 std::vector<std::optional<Slice>> results,
                 AttributesMap attributes,
+                std::shared_ptr<ffi::ExecutionState> execution_state,
                 const HloComputation* called_computation)
       : CommandBufferCmd(CommandBufferCmdType::kCustomCallCmd,
                          execution_stream_id),
         target_name_(std::move(target_name)),
-        handler_(handler),
+        bundle_(bundle),
         attributes_(std::move(attributes)),
+        execution_state_(std::move(execution_state)),
         called_computation_(called_computation),
         operands_(std::move(operands)),
         results_(std::move(results)) {}
 
+  absl::Status Prepare(
+      const Thunk::PrepareParams& params,
+      Thunk::ResourceRequestsInterface& resource_requests) override;
+
+  absl::Status Initialize(const Thunk::InitializeParams& params,
+                          StateManager& state) override;
+
   absl::StatusOr<const se::CommandBuffer::Command*> Record(
       const Thunk::ExecuteParams& execute_params,
       const RecordParams& record_params, RecordAction record_action,
@@ -884,6 +912,14 @@ class CustomCallCmd : public CommandBufferCmd {
       const RecordParams& record_params, RecordAction record_action,
       se::CommandBuffer* command_buffer);
 
+  // Calls an FFI handler of the bundle. Buffer addresses are null if
+  // `buffer_allocations` is null, i.e. at the prepare stage.
+  absl::Status CallXlaFfiHandler(RunId run_id, XLA_FFI_Handler* handler,
+                                 XLA_FFI_ExecutionStage stage,
+                                 se::Stream* stream,
+                                 const ffi::ExecutionContext* execution_context,
+                                 const BufferAllocations* buffer_allocations);
+
   std::string target_name_;
 
   // This is a legacy custom call API that is discouraged, and will be
@@ -894,8 +930,9 @@ class CustomCallCmd : public CommandBufferCmd {
   // XLA FFI provides a right type safe mechanism for registering external
   // functions with XLA runtime. It's under construction, and still misses
   // a lot of features. Long term it will replace legacy custom calls.
-  XLA_FFI_Handler* handler_ = nullptr;
+  std::optional<XLA_FFI_Handler_Bundle> bundle_;
   AttributesMap attributes_;
+  std::shared_ptr<ffi::ExecutionState> execution_state_;
   const HloComputation* called_computation_;
 
   std::vector<std::optional<Slice>> operands_;
@@ -228,8 +228,9 @@ static absl::StatusOr<Command> Convert(const ReplicaIdThunk& thunk) {
 static absl::StatusOr<Command> Convert(const CustomCallThunk& thunk) {
   if (auto bundle = thunk.bundle(); bundle.has_value()) {
     return std::make_unique<CustomCallCmd>(
-        thunk.execution_stream_id(), thunk.target_name(), bundle->execute,
+        thunk.execution_stream_id(), thunk.target_name(), *bundle,
         thunk.operands(), thunk.results(), thunk.attributes(),
+        thunk.execution_state(),
         /*called_computation=*/nullptr);  // TODO(b/342285364)
   } else {
     return std::make_unique<CustomCallCmd>(
@@ -302,8 +303,23 @@ static absl::Status AppendCommands(
       return append(Convert<PartitionIdThunk>(thunk));
     case Thunk::Kind::kReplicaId:
       return append(Convert<ReplicaIdThunk>(thunk));
-    case Thunk::Kind::kWhile:
+    case Thunk::Kind::kWhile: {
+      // Unroll while loops with small known trip counts. Each iteration gets
+      // its own set of commands, as commands can be recorded only once into
+      // the same command buffer.
+      const auto& while_thunk = static_cast<const WhileThunk&>(thunk);
+      std::optional<int64_t> trip_count = while_thunk.trip_count();
+      if (trip_count.has_value() &&
+          *trip_count <= options.max_unrolled_loop_trip_count) {
+        for (int64_t i = 0; i < *trip_count; ++i) {
+          TF_RETURN_IF_ERROR(AppendCommands(
+              cmd_sequence_builder,
+              while_thunk.body_thunk_sequence()->thunks(), options));
+        }
+        return absl::OkStatus();
+      }
       return append(Convert<WhileThunk>(thunk, options));
+    }
     case Thunk::Kind::kCuDnn:
       return append(Convert<CuDnnThunk>(thunk));
     case Thunk::Kind::kDynamicSlice:
@@ -16,6 +16,8 @@ limitations under the License.
 #ifndef XLA_BACKENDS_GPU_RUNTIME_COMMAND_BUFFER_CMD_EMITTER_H_
 #define XLA_BACKENDS_GPU_RUNTIME_COMMAND_BUFFER_CMD_EMITTER_H_
 
+#include <cstdint>
+
 #include "absl/status/statusor.h"
 #include "xla/backends/gpu/runtime/command_buffer_cmd.h"
 #include "xla/backends/gpu/runtime/thunk.h"
@@ -26,6 +28,10 @@ namespace xla::gpu {
 struct ConvertToCommandsOptions {
   CommandBufferCmdSequence::SynchronizationMode synchronization_mode =
       CommandBufferCmdSequence::SynchronizationMode::kSerialize;
+
+  // While loops with a known trip count up to this value are unrolled into the
+  // command sequence instead of being converted to a `WhileCmd`.
+  int64_t max_unrolled_loop_trip_count = 0;
 };
 
 // Converts thunk sequence to a command buffer cmd sequence.
@@ -16,6 +16,7 @@ limitations under the License.
 #include "xla/backends/gpu/runtime/command_buffer_thunk.h"
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <utility>
@@ -30,6 +31,7 @@ limitations under the License.
 #include "xla/backends/gpu/runtime/thunk.h"
 #include "xla/service/buffer_assignment.h"
 #include "xla/service/gpu/buffer_allocations.h"
+#include "xla/service/gpu/metrics.h"
 #include "xla/stream_executor/command_buffer.h"
 #include "xla/stream_executor/device_memory.h"
 #include "xla/stream_executor/stream_executor.h"
@@ -83,11 +85,7 @@ CommandBufferThunk::CommandBufferThunk(
 bool CommandBufferThunk::ExecutorCommandBuffer::ShouldUpdateCommandBuffer(
     const CommandBufferCmdSequence& commands,
     const Thunk::ExecuteParams& params) {
-  if (commands.force_update()) {
-    return true;
-  }
-
-  bool should_update = false;
+  updated_allocs.clear();
   const BufferAllocations* allocs = params.buffer_allocations;
 
   // We check only allocations referenced by commands in a cmd sequence, and
@@ -97,16 +95,16 @@ bool CommandBufferThunk::ExecutorCommandBuffer::ShouldUpdateCommandBuffer(
 
     if (recorded_allocs.size() <= index) {
       recorded_allocs.resize(index + 1);
-      should_update = true;
+      updated_allocs.insert(index);
     }
 
     if (!recorded_allocs[index].IsSameAs(alloc)) {
       recorded_allocs[index] = alloc;
-      should_update = true;
+      updated_allocs.insert(index);
     }
   }
 
-  return should_update;
+  return commands.force_update() || !updated_allocs.empty();
 }
 
 absl::Status CommandBufferThunk::Prepare(
@@ -193,6 +191,8 @@ absl::Status CommandBufferThunk::Initialize(const InitializeParams& params) {
             << params.executor->device_ordinal() << " in "
             << (end_micros - start_micros)
             << " μs; num_commands=" << commands_.size();
+    RecordCommandBufferInitializeDuration(profile_annotation(),
+                                          end_micros - start_micros);
     cmd_buffer->num_executions = 0;
   }
 
@@ -211,6 +211,7 @@ absl::Status CommandBufferThunk::ExecuteOnStream(const ExecuteParams& params) {
       !enable_command_buffers_during_profiling_) {
     VLOG(1) << "Execute command buffer thunk as a regular thunk sequence "
                "because we detected active profiling session";
+    IncrementCommandBufferFallbackCount(profile_annotation(), "profiling");
     TF_RETURN_IF_ERROR(thunks_->ExecuteOnStream(params));
     return absl::OkStatus();
   }
@@ -228,23 +229,33 @@ absl::Status CommandBufferThunk::ExecuteOnStream(const ExecuteParams& params) {
             << cmd_buffer->num_executions << " executions since last update"
             << "; num_commands=" << commands_.size();
 
+    // Update only commands that reference changed buffer allocations.
+    CommandBufferCmd::RecordParams record_params = {
+        cmd_buffer->state, &cmd_buffer->updated_allocs};
+    size_t num_updated_commands =
+        commands_.NumCommandsToUpdate(record_params);
+
     TraceMe trace([&] {
       cmd_buffer->mutex.AssertHeld();
       return TraceMeEncode("command_buffer::update",
                            {{"device", executor->device_ordinal()},
                             {"num_commands", commands_.size()},
+                            {"num_updated_commands", num_updated_commands},
                             {"num_executions", cmd_buffer->num_executions}});
     });
 
     uint64_t start_micros = tsl::Env::Default()->NowMicros();
 
-    CommandBufferCmd::RecordParams record_params = {cmd_buffer->state};
     TF_RETURN_IF_ERROR(commands_.Record(params, record_params,
                                         cmd_buffer->command_buffer.get()));
 
     uint64_t end_micros = tsl::Env::Default()->NowMicros();
     VLOG(3) << "Updated command buffer in " << (end_micros - start_micros)
-            << " μs; num_commands=" << commands_.size();
+            << " μs; num_commands=" << commands_.size()
+            << " num_updated_commands=" << num_updated_commands
+            << " num_updated_allocs=" << cmd_buffer->updated_allocs.size();
+    RecordCommandBufferUpdate(profile_annotation(), end_micros - start_micros,
+                              num_updated_commands);
     cmd_buffer->num_executions = 0;
   }
 
@@ -23,6 +23,7 @@ limitations under the License.
 
 #include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/functional/function_ref.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -30,6 +31,7 @@ limitations under the License.
 #include "xla/backends/gpu/runtime/command_buffer_cmd.h"
 #include "xla/backends/gpu/runtime/sequential_thunk.h"
 #include "xla/backends/gpu/runtime/thunk.h"
+#include "xla/service/buffer_assignment.h"
 #include "xla/stream_executor/command_buffer.h"
 #include "xla/stream_executor/device_memory.h"
 #include "xla/stream_executor/stream_executor.h"
@@ -94,6 +96,12 @@ class CommandBufferThunk : public Thunk {
     // change.
     std::vector<se::DeviceMemoryBase> recorded_allocs ABSL_GUARDED_BY(mutex);
 
+    // Buffer allocations that changed in the last call to
+    // `ShouldUpdateCommandBuffer`. Only commands that reference these
+    // allocations have to be updated in the `command_buffer`.
+    absl::flat_hash_set<BufferAllocation::Index> updated_allocs
+        ABSL_GUARDED_BY(mutex);
+
     // Number of command buffer executions since last update.
     int64_t num_executions ABSL_GUARDED_BY(mutex) = 0;
   };
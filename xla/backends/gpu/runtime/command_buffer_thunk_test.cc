@@ -1128,6 +1128,8 @@ TEST(CommandBufferThunkTest, MultipleLaunchCmd) {
   allocations = BufferAllocations({a, b, c, e}, 0, &allocator);
 
   // Thunk execution should automatically update underlying command buffer.
+  // Only the second launch references the updated allocation, and the first
+  // one must keep its previously recorded arguments.
   TF_ASSERT_OK(thunk.ExecuteOnStream(params));
   TF_ASSERT_OK(stream->BlockHostUntilDone());
 
@@ -18,6 +18,7 @@ limitations under the License.
 #include <cstdint>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "absl/log/log.h"
 #include "absl/status/status.h"
@@ -105,6 +106,29 @@ absl::StatusOr<std::unique_ptr<se::Event>> CopyThunk::AsyncEvents::Extract(
   return absl::InternalError("Async copy event was not found!");
 }
 
+absl::StatusOr<std::unique_ptr<se::Event>> CopyThunk::AsyncEvents::Acquire(
+    se::StreamExecutor* executor) {
+  {
+    absl::MutexLock lock(&mutex_);
+    std::vector<std::unique_ptr<se::Event>>& free_events =
+        free_events_[executor];
+    if (!free_events.empty()) {
+      std::unique_ptr<se::Event> event = std::move(free_events.back());
+      free_events.pop_back();
+      return event;
+    }
+    VLOG(3) << "Create async copy event #" << ++num_created_events_[executor]
+            << " for executor " << executor;
+  }
+  return executor->CreateEvent();
+}
+
+void CopyThunk::AsyncEvents::Release(se::StreamExecutor* executor,
+                                     std::unique_ptr<se::Event> event) {
+  absl::MutexLock lock(&mutex_);
+  free_events_[executor].push_back(std::move(event));
+}
+
 //===----------------------------------------------------------------------===//
 // DeviceToHostCopyThunk
 //===----------------------------------------------------------------------===//
@@ -135,7 +159,7 @@ absl::Status DeviceToHostCopyThunk::ExecuteOnStream(
   }
   VLOG(2) << "Memcpy D2H from the other stream";
   se::StreamExecutor* executor = params.stream->parent();
-  TF_ASSIGN_OR_RETURN(auto event, executor->CreateEvent());
+  TF_ASSIGN_OR_RETURN(auto event, async_events_->Acquire(executor));
   // Record memcpy operation completion.
   TF_RETURN_IF_ERROR(stream->RecordEvent(event.get()));
   VLOG(3) << "Emplace events: " << event.get()
@@ -173,7 +197,7 @@ absl::Status HostToDeviceCopyThunk::ExecuteOnStream(
   }
   VLOG(2) << "Memcpy H2D from the other stream";
   se::StreamExecutor* executor = params.stream->parent();
-  TF_ASSIGN_OR_RETURN(auto event, executor->CreateEvent());
+  TF_ASSIGN_OR_RETURN(auto event, async_events_->Acquire(executor));
   // Record memcpy operation completion.
   TF_RETURN_IF_ERROR(stream->RecordEvent(event.get()));
   VLOG(3) << "Emplace events: " << event.get()
@@ -199,7 +223,9 @@ absl::Status CopyDoneThunk::ExecuteOnStream(const ExecuteParams& params) {
   se::StreamExecutor* executor = params.stream->parent();
   TF_ASSIGN_OR_RETURN(std::unique_ptr<se::Event> event,
                       async_events_->Extract(executor, copy_start_instr_));
-  return params.stream->WaitFor(event.get());
+  absl::Status status = params.stream->WaitFor(event.get());
+  async_events_->Release(executor, std::move(event));
+  return status;
 }
 
 //===----------------------------------------------------------------------===//
@@ -80,11 +80,29 @@ class CopyThunk : public Thunk {
     absl::StatusOr<std::unique_ptr<se::Event>> Extract(
         se::StreamExecutor* executor, const HloInstruction* instr);
 
+    // Returns an event for a copy-start completion, reusing a released event
+    // of `executor` if there is one. Events are created only while the number
+    // of copies in flight grows, instead of on every execution.
+    absl::StatusOr<std::unique_ptr<se::Event>> Acquire(
+        se::StreamExecutor* executor);
+
+    // Returns an event that was waited on to the pool of `executor`. Waits
+    // capture the state of the event at the time they are enqueued, so the
+    // event can be recorded again right away.
+    void Release(se::StreamExecutor* executor,
+                 std::unique_ptr<se::Event> event);
+
    private:
     using Key = std::pair<se::StreamExecutor*, const HloInstruction*>;
     absl::Mutex mutex_;
     absl::flat_hash_map<Key, std::unique_ptr<se::Event>> events_
         ABSL_GUARDED_BY(mutex_);
+    absl::flat_hash_map<se::StreamExecutor*,
+                        std::vector<std::unique_ptr<se::Event>>>
+        free_events_ ABSL_GUARDED_BY(mutex_);
+    // The number of events created per executor, for logging.
+    absl::flat_hash_map<se::StreamExecutor*, int64_t> num_created_events_
+        ABSL_GUARDED_BY(mutex_);
   };
   CopyThunk(ThunkInfo thunk_info, const BufferAllocation::Slice& source_buffer,
             const BufferAllocation::Slice& destination_buffer,
@@ -21,7 +21,6 @@ limitations under the License.
 #include <memory>
 #include <optional>
 #include <utility>
-#include <vector>
 
 #include "absl/container/inlined_vector.h"
 #include "absl/log/check.h"
@@ -38,30 +37,11 @@ limitations under the License.
 #include "xla/stream_executor/stream.h"
 #include "xla/util.h"
 #include "xla/xla_data.pb.h"
-#include "tsl/platform/errors.h"
 
 namespace xla {
 namespace gpu {
 namespace {
 
-// N pairs of [start_offset, end_offset) require (N+1) storage.
-// The size of each offset is selected to be 32-bits (int type).
-uint64_t GetOffsetsSize(int64_t batch_size) {
-  return (batch_size + 1) * sizeof(int);
-}
-
-// Copies segment offsets to the device memory.
-absl::Status CopyOffsets(se::Stream* stream, se::DeviceMemoryBase scratch,
-                         int64_t batch_size, int64_t segment_size) {
-  uint64_t offsets_size = GetOffsetsSize(batch_size);
-  char* offsets_buffer =
-      static_cast<char*>(scratch.opaque()) + scratch.size() - offsets_size;
-  se::DeviceMemoryBase d_offsets(offsets_buffer, offsets_size);
-  std::vector<int> h_offsets(batch_size + 1);
-  for (int i = 0; i <= batch_size; ++i) h_offsets[i] = i * segment_size;
-  return stream->Memcpy(&d_offsets, h_offsets.data(), offsets_size);
-}
-
 // Template class for sorting a single tensor.
 class CubSortKeysImpl : public CubSortRunnerInterface {
  public:
@@ -98,11 +78,6 @@ absl::Status CubSortKeysImpl::Run(se::DeviceMemoryBase input_keys,
   size_t num_items = input_keys.size() * 8 / primitive_util::BitWidth(type_);
   CHECK(input_values.is_null());
   CHECK(output_values.is_null());
-  if (batch_size > 1) {
-    TF_RETURN_IF_ERROR(
-        CopyOffsets(stream, scratch, batch_size, num_items / batch_size));
-    temp_bytes -= GetOffsetsSize(batch_size);
-  }
   const char* error = sort_keys_fn_(
       scratch.opaque(), temp_bytes, input_keys.opaque(), output_keys.opaque(),
       num_items, descending, batch_size, se::gpu::AsGpuStreamValue(stream));
@@ -169,11 +144,6 @@ absl::Status CubSortPairsImpl::Run(se::DeviceMemoryBase input_keys,
                                    se::Stream* stream) {
   size_t temp_bytes = scratch.size();
   size_t num_items = input_keys.size() * 8 / primitive_util::BitWidth(type_);
-  if (batch_size > 1) {
-    TF_RETURN_IF_ERROR(
-        CopyOffsets(stream, scratch, batch_size, num_items / batch_size));
-    temp_bytes -= GetOffsetsSize(batch_size);
-  }
   const char* error = sort_pairs_fn_(
       scratch.opaque(), temp_bytes, input_keys.opaque(), output_keys.opaque(),
       input_values.opaque(), output_values.opaque(), num_items, descending,
@@ -22,6 +22,7 @@ limitations under the License.
 #include <utility>
 #include <vector>
 
+#include "absl/container/inlined_vector.h"
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -41,6 +42,7 @@ limitations under the License.
 #include "xla/stream_executor/device_memory_allocator.h"
 #include "xla/stream_executor/stream.h"
 #include "xla/tsl/platform/errors.h"
+#include "xla/tsl/platform/statusor.h"
 #include "xla/util.h"
 
 namespace xla {
@@ -50,6 +52,47 @@ using xla::ffi::CallFrame;
 using xla::ffi::CallFrameBuilder;
 using xla::ffi::CallOptions;
 
+// Builds the call frame of an FFI custom call with null buffers. Attributes
+// don't change after the thunk is constructed, so they are encoded once here,
+// and only the buffer addresses are filled in on every call.
+static absl::StatusOr<CallFrame> BuildCallFrame(
+    const std::vector<std::optional<CustomCallThunk::Slice>>& operands,
+    const std::vector<std::optional<CustomCallThunk::Slice>>& results,
+    const CustomCallThunk::AttributesMap& attributes) {
+  CallFrameBuilder builder(operands.size(), results.size());
+  for (const std::optional<CustomCallThunk::Slice>& operand : operands) {
+    if (!operand.has_value()) {
+      builder.AddTokenArg();
+      continue;
+    }
+
+    if (!operand->slice.allocation())
+      return Internal("custom call argument missing buffer allocation");
+
+    builder.AddBufferArg(se::DeviceMemoryBase{}, operand->shape.element_type(),
+                         operand->shape.dimensions());
+  }
+
+  for (const std::optional<CustomCallThunk::Slice>& result : results) {
+    if (!result.has_value()) {
+      builder.AddTokenRet();
+      continue;
+    }
+
+    if (!result->slice.allocation())
+      return Internal("custom call result missing buffer allocation");
+
+    builder.AddBufferRet(se::DeviceMemoryBase{}, result->shape.element_type(),
+                         result->shape.dimensions());
+  }
+
+  CallFrameBuilder::AttributesBuilder attrs;
+  attrs.Append(attributes);
+
+  builder.AddAttributes(attrs.Build());
+  return builder.Build();
+}
+
 absl::StatusOr<std::unique_ptr<CustomCallThunk>> CustomCallThunk::Create(
     ThunkInfo thunk_info, std::string target_name, CustomCallTarget call_target,
     std::vector<std::optional<Slice>> operands,
@@ -84,10 +127,13 @@ absl::StatusOr<std::unique_ptr<CustomCallThunk>> CustomCallThunk::Create(
                             XLA_FFI_ExecutionStage_INSTANTIATE));
   }
 
+  TF_ASSIGN_OR_RETURN(CallFrame call_frame,
+                      BuildCallFrame(operands, results, attributes));
+
   return absl::WrapUnique(new CustomCallThunk(
       thunk_info, std::move(target_name), bundle, std::move(operands),
-      std::move(results), std::move(attributes), std::move(execution_state),
-      called_computation));
+      std::move(results), std::move(attributes), std::move(call_frame),
+      std::move(execution_state), called_computation));
 }
 
 CustomCallThunk::CustomCallThunk(ThunkInfo thunk_info, std::string target_name,
@@ -106,7 +152,7 @@ CustomCallThunk::CustomCallThunk(
     ThunkInfo thunk_info, std::string target_name,
     XLA_FFI_Handler_Bundle bundle, std::vector<std::optional<Slice>> operands,
     std::vector<std::optional<Slice>> results, AttributesMap attributes,
-    std::unique_ptr<ffi::ExecutionState> execution_state,
+    CallFrame call_frame, std::unique_ptr<ffi::ExecutionState> execution_state,
     const HloComputation* called_computation)
     : Thunk(Thunk::kCustomCall, thunk_info),
       target_name_(std::move(target_name)),
@@ -114,6 +160,7 @@ CustomCallThunk::CustomCallThunk(
       results_(std::move(results)),
       bundle_(bundle),
       attributes_(std::move(attributes)),
+      call_frame_(std::move(call_frame)),
       execution_state_(std::move(execution_state)),
       called_computation_(called_computation) {}
 
@@ -162,50 +209,25 @@ absl::Status CustomCallThunk::ExecuteFfiHandler(
     return absl::InternalError("buffer allocations and stream are required");
   }
 
-  // TODO(ezhulenev): This is not the most optimal approach, as we'll be doing
-  // a lot of extra allocation on every call. We have to keep attributes
-  // separate from arguments, as they do not change after thunk is constructed.
-  CallFrameBuilder builder(operands_.size(), results_.size());
-  auto device_address =
-      [buffer_allocations](
-          BufferAllocation::Slice slice) -> se::DeviceMemoryBase {
-    return buffer_allocations ? buffer_allocations->GetDeviceAddress(slice)
-                              : se::DeviceMemoryBase{};
-  };
-
-  for (auto& operand : operands_) {
-    if (!operand.has_value()) {
-      builder.AddTokenArg();
-      continue;
-    }
-
-    if (!operand->slice.allocation())
-      return Internal("custom call argument missing buffer allocation");
-
-    builder.AddBufferArg(device_address(operand->slice),
-                         operand->shape.element_type(),
-                         operand->shape.dimensions());
-  }
-
-  for (auto& result : results_) {
-    if (!result.has_value()) {
-      builder.AddTokenRet();
-      continue;
+  // Tokens and all buffers at the prepare stage have null addresses.
+  auto device_addresses = [buffer_allocations](
+                              const std::vector<std::optional<Slice>>& slices) {
+    absl::InlinedVector<se::DeviceMemoryBase, 8> addresses;
+    addresses.reserve(slices.size());
+    for (const std::optional<Slice>& slice : slices) {
+      addresses.push_back(slice.has_value() && buffer_allocations
+                              ? buffer_allocations->GetDeviceAddress(
+                                    slice->slice)
+                              : se::DeviceMemoryBase{});
     }
+    return addresses;
+  };
 
-    if (!result->slice.allocation())
-      return Internal("custom call result missing buffer allocation");
-
-    builder.AddBufferRet(device_address(result->slice),
-                         result->shape.element_type(),
-                         result->shape.dimensions());
-  }
-
-  CallFrameBuilder::AttributesBuilder attrs;
-  attrs.Append(attributes_);
-
-  builder.AddAttributes(attrs.Build());
-  CallFrame call_frame = builder.Build();
+  // The thunk can be executed concurrently, so the buffers are set on a copy
+  // of the call frame, which shares the encoded attributes.
+  TF_ASSIGN_OR_RETURN(CallFrame call_frame,
+                      call_frame_->CopyWithBuffers(device_addresses(operands_),
+                                                   device_addresses(results_)));
 
   int32_t device_ordinal = -1;
   se::DeviceMemoryAllocator* allocator = nullptr;
@@ -91,6 +91,12 @@ class CustomCallThunk : public Thunk {
   std::optional<XLA_FFI_Handler_Bundle> bundle() const { return bundle_; }
   const AttributesMap& attributes() const { return attributes_; }
 
+  // The state created by the FFI handler instantiate callback, shared with the
+  // command that replaces this thunk in a command buffer.
+  const std::shared_ptr<ffi::ExecutionState>& execution_state() const {
+    return execution_state_;
+  }
+
   const std::vector<std::optional<Slice>>& operands() const {
     return operands_;
   }
@@ -109,7 +115,7 @@ class CustomCallThunk : public Thunk {
                   XLA_FFI_Handler_Bundle bundle,
                   std::vector<std::optional<Slice>> operands,
                   std::vector<std::optional<Slice>> results,
-                  AttributesMap attributes,
+                  AttributesMap attributes, ffi::CallFrame call_frame,
                   std::unique_ptr<ffi::ExecutionState> execution_state,
                   const HloComputation* called_computation);
 
@@ -137,8 +143,12 @@ class CustomCallThunk : public Thunk {
   std::optional<XLA_FFI_Handler_Bundle> bundle_;
   AttributesMap attributes_;
 
+  // The call frame of the FFI handler with encoded attributes and null
+  // buffers, copied with the actual buffers on every call.
+  std::optional<ffi::CallFrame> call_frame_;
+
   // Execution state bound to the FFI handler. Optional.
-  std::unique_ptr<ffi::ExecutionState> execution_state_;
+  std::shared_ptr<ffi::ExecutionState> execution_state_;
 
   // TODO(ezhulenev): Currently we assume that HloModule that owns this
   // computation is owned by a GpuExecutable and stays alive for as long as
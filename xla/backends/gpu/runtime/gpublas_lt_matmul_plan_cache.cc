@@ -0,0 +1,110 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/gpu/runtime/gpublas_lt_matmul_plan_cache.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/log/log.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
+#include "xla/status_macros.h"
+#include "xla/stream_executor/gpu/gpu_blas_lt.h"
+#include "xla/stream_executor/stream.h"
+#include "xla/tsl/platform/statusor.h"
+
+namespace xla::gpu {
+
+namespace {
+
+void AppendLayout(std::string* key, const se::gpu::MatrixLayout& layout) {
+  absl::StrAppend(key, static_cast<int>(layout.dtype), ",", layout.num_rows,
+                  ",", layout.num_cols, ",", static_cast<int>(layout.order),
+                  ",", layout.batch_size, ",", layout.leading_dim_stride, ",",
+                  layout.batch_stride, ",", static_cast<int>(layout.transpose),
+                  ";");
+}
+
+// Returns a key that identifies the plan built for `config` and `epilogue`,
+// and the algorithm picked for it.
+std::string MakeKey(const se::gpu::GemmConfig& config,
+                    se::gpu::BlasLt::Epilogue epilogue, int64_t algorithm_idx,
+                    int64_t max_workspace) {
+  std::string key;
+  AppendLayout(&key, config.lhs_layout);
+  AppendLayout(&key, config.rhs_layout);
+  AppendLayout(&key, config.c_layout);
+  AppendLayout(&key, config.output_layout);
+  absl::StrAppend(
+      &key, config.alpha.real(), ",", config.alpha.imag(), ",", config.beta,
+      ",", config.compute_precision, ",",
+      static_cast<int>(config.precision_algorithm), ",",
+      config.algorithm.value_or(-1), ",", config.grad_x, ",", config.grad_y,
+      ",",
+      config.compute_type ? static_cast<int>(*config.compute_type) : -1, ";",
+      static_cast<int>(epilogue), ",", algorithm_idx, ",", max_workspace);
+  return key;
+}
+
+}  // namespace
+
+MatmulPlanCache& MatmulPlanCache::Global() {
+  static auto* cache = new MatmulPlanCache();
+  return *cache;
+}
+
+absl::StatusOr<const MatmulPlanCache::Entry*> MatmulPlanCache::GetOrCreate(
+    const se::Stream* stream, const se::gpu::GemmConfig& config,
+    se::gpu::BlasLt::Epilogue epilogue, int64_t algorithm_idx,
+    int64_t max_workspace) {
+  Key key(stream->parent(),
+          MakeKey(config, epilogue, algorithm_idx, max_workspace));
+  {
+    absl::MutexLock lock(&mu_);
+    auto it = entries_.find(key);
+    if (it != entries_.end()) return it->second.get();
+  }
+
+  // Build the plan without holding the lock, as picking the algorithm queries
+  // the BLAS library.
+  auto entry = std::make_unique<Entry>();
+  TF_ASSIGN_OR_RETURN(entry->plan, se::gpu::BlasLt::GetMatmulPlan(
+                                       stream, config, epilogue));
+  TF_ASSIGN_OR_RETURN(
+      auto algorithms,
+      entry->plan->GetAlgorithms(stream, /*max_algorithm_count*/ 128,
+                                 /*max_workspace_size*/ max_workspace));
+  TF_RET_CHECK(algorithm_idx >= 0 && algorithm_idx < algorithms.size());
+  entry->algorithm = algorithms[algorithm_idx];
+
+  absl::MutexLock lock(&mu_);
+  auto [it, inserted] = entries_.emplace(std::move(key), std::move(entry));
+  if (inserted) {
+    VLOG(3) << "Cached a BlasLt matmul plan, " << entries_.size()
+            << " plans cached";
+  }
+  return it->second.get();
+}
+
+int64_t MatmulPlanCache::size() const {
+  absl::MutexLock lock(&mu_);
+  return entries_.size();
+}
+
+}  // namespace xla::gpu
@@ -0,0 +1,72 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_BACKENDS_GPU_RUNTIME_GPUBLAS_LT_MATMUL_PLAN_CACHE_H_
+#define XLA_BACKENDS_GPU_RUNTIME_GPUBLAS_LT_MATMUL_PLAN_CACHE_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "xla/stream_executor/gpu/gpu_blas_lt.h"
+#include "xla/stream_executor/stream.h"
+#include "xla/stream_executor/stream_executor.h"
+
+namespace xla::gpu {
+
+// A process-wide cache of BlasLt matmul plans and of the algorithms picked for
+// them.
+//
+// Matmul plans only depend on the GEMM config and the epilogue, and are owned
+// by the BlasLt instance of a StreamExecutor, so all the cuBLASLt thunks and
+// commands of all executables that run the same matmul on the same device
+// share one plan, instead of building and holding one each.
+class MatmulPlanCache {
+ public:
+  struct Entry {
+    se::gpu::BlasLt::MatmulPlanPtr plan;
+    se::gpu::BlasLt::MatmulAlgorithm algorithm;
+  };
+
+  static MatmulPlanCache& Global();
+
+  // Returns the plan for running a matmul with `config` and `epilogue` on the
+  // executor of `stream`, with the `algorithm_idx`-th algorithm among the ones
+  // that need at most `max_workspace` bytes of workspace. The returned entry
+  // lives as long as the process.
+  absl::StatusOr<const Entry*> GetOrCreate(
+      const se::Stream* stream, const se::gpu::GemmConfig& config,
+      se::gpu::BlasLt::Epilogue epilogue, int64_t algorithm_idx,
+      int64_t max_workspace);
+
+  // Returns the number of cached plans.
+  int64_t size() const;
+
+ private:
+  using Key = std::pair<const se::StreamExecutor*, std::string>;
+
+  mutable absl::Mutex mu_;
+  absl::flat_hash_map<Key, std::unique_ptr<Entry>> entries_
+      ABSL_GUARDED_BY(mu_);
+};
+
+}  // namespace xla::gpu
+
+#endif  // XLA_BACKENDS_GPU_RUNTIME_GPUBLAS_LT_MATMUL_PLAN_CACHE_H_
@@ -20,7 +20,8 @@ limitations under the License.
 #include <utility>
 
 #include "absl/status/status.h"
-#include "absl/synchronization/mutex.h"
+#include "absl/status/statusor.h"
+#include "xla/backends/gpu/runtime/gpublas_lt_matmul_plan_cache.h"
 #include "xla/backends/gpu/runtime/thunk.h"
 #include "xla/service/buffer_assignment.h"
 #include "xla/service/gpu/buffer_allocations.h"
@@ -63,13 +64,8 @@ CublasLtMatmulThunk::CublasLtMatmulThunk(
       workspace_buffer_(workspace_buffer) {}
 
 absl::Status CublasLtMatmulThunk::ExecuteOnStream(const ExecuteParams& params) {
-  TF_ASSIGN_OR_RETURN(auto plan, GetMatmulPlan(params.stream));
-
-  TF_ASSIGN_OR_RETURN(auto algorithm,
-                      GetMatmulAlgorithm(params.stream, plan,
-                                         workspace_buffer_.has_value()
-                                             ? workspace_buffer_.value().size()
-                                             : 0));
+  TF_ASSIGN_OR_RETURN(const MatmulPlanCache::Entry* entry,
+                      GetMatmulPlan(params.stream));
 
   VLOG(3) << "Running cublas_lt matmul thunk";
   const BufferAllocations& allocs = *params.buffer_allocations;
@@ -104,48 +100,18 @@ absl::Status CublasLtMatmulThunk::ExecuteOnStream(const ExecuteParams& params) {
     workspace = allocs.GetDeviceAddress(workspace_buffer_.value());
   }
 
-  return plan->ExecuteOnStream(
+  return entry->plan->ExecuteOnStream(
       params.stream, allocs.GetDeviceAddress(a_buffer_),
       allocs.GetDeviceAddress(b_buffer_), allocs.GetDeviceAddress(c_buffer_),
       allocs.GetDeviceAddress(d_buffer_), bias, aux, a_scale, b_scale, c_scale,
-      d_scale, d_amax, algorithm, workspace);
-}
-
-absl::StatusOr<se::gpu::BlasLt::MatmulPlan*> CublasLtMatmulThunk::GetMatmulPlan(
-    const se::Stream* stream) {
-  {
-    absl::MutexLock lock(&matmul_plans_cache_mutex_);
-    auto it = matmul_plans_cache_.find(stream);
-    if (it != matmul_plans_cache_.end()) return it->second.get();
-  }
-  TF_ASSIGN_OR_RETURN(auto plan, se::gpu::BlasLt::GetMatmulPlan(
-                                     stream, gemm_config_, epilogue_));
-
-  absl::MutexLock lock(&matmul_plans_cache_mutex_);
-  auto [it, _] = matmul_plans_cache_.emplace(stream, std::move(plan));
-  return it->second.get();
+      d_scale, d_amax, entry->algorithm, workspace);
 }
 
-absl::StatusOr<se::gpu::BlasLt::MatmulAlgorithm>
-CublasLtMatmulThunk::GetMatmulAlgorithm(const se::Stream* stream,
-                                        const se::gpu::BlasLt::MatmulPlan* plan,
-                                        int64_t max_workspace) {
-  {
-    absl::MutexLock lock(&matmul_algorithm_cache_mutex_);
-    auto it = matmul_algorithm_cache_.find(plan);
-    if (it != matmul_algorithm_cache_.end()) return it->second;
-  }
-  TF_ASSIGN_OR_RETURN(
-      auto algorithms,
-      plan->GetAlgorithms(stream,
-                          /*max_algorithm_count*/ 128,
-                          /*max_workspace_size*/ max_workspace));
-  TF_RET_CHECK(algorithm_idx_ >= 0 && algorithm_idx_ < algorithms.size());
-
-  absl::MutexLock lock(&matmul_algorithm_cache_mutex_);
-  auto [it, _] =
-      matmul_algorithm_cache_.emplace(plan, algorithms[algorithm_idx_]);
-  return it->second;
+absl::StatusOr<const MatmulPlanCache::Entry*>
+CublasLtMatmulThunk::GetMatmulPlan(const se::Stream* stream) {
+  return MatmulPlanCache::Global().GetOrCreate(
+      stream, gemm_config_, epilogue_, algorithm_idx_,
+      workspace_buffer_.has_value() ? workspace_buffer_->size() : 0);
 }
 
 absl::Status CublasLtMatmulThunk::Initialize(const InitializeParams& params) {
@@ -48,9 +48,16 @@ absl::Status InfeedThunk::ExecuteOnStream(const ExecuteParams& params) {
   const BufferAllocations& buffer_allocations = *params.buffer_allocations;
 
   VLOG(2) << "Infeeding to GPU";
-  ShapeTree<se::DeviceMemoryHandle> source_buffers =
-      GpuTransferManager::GetOrCreateInfeedManager(stream.parent())
-          ->BlockingGetNextDestination();
+  InfeedManager* infeed_manager =
+      GpuTransferManager::GetOrCreateInfeedManager(stream.parent());
+  InfeedBuffers infeed = infeed_manager->BlockingGetNextDestination();
+  ShapeTree<se::DeviceMemoryHandle>& source_buffers = infeed.buffers;
+
+  // Wait on the device for the copies to the source buffers, if they are still
+  // in flight.
+  if (infeed.ready != nullptr) {
+    TF_RETURN_IF_ERROR(stream.WaitFor(infeed.ready.get()));
+  }
 
   size_t index = 0;
   for (auto& source : source_buffers.leaves()) {
@@ -75,11 +82,10 @@ absl::Status InfeedThunk::ExecuteOnStream(const ExecuteParams& params) {
   CHECK_EQ(index, dest_slices_.size())
       << "Infeed did not populate all destination buffers";
 
-  absl::Status block_status = stream.BlockHostUntilDone();
-  if (!block_status.ok()) {
-    return Internal("Failed to complete data transfer on stream %p: %s",
-                    &stream, block_status.message());
-  }
+  // The source buffers are freed once the copies above are done, without
+  // blocking the host on the stream.
+  TF_RETURN_IF_ERROR(
+      infeed_manager->ReleaseAfter(&stream, std::move(source_buffers)));
 
   VLOG(2) << "Infeeding to GPU complete";
   return absl::OkStatus();
@@ -91,6 +91,10 @@ absl::Status KernelThunk::Initialize(const InitializeParams& params) {
   // profiles.
   auto it = kernel_cache_.find(params.executor);
   if (kernel_cache_.end() == it) {
+    if (params.lazy_kernel_loading) {
+      lazy_sources_.emplace(params.executor, params.src);
+      return absl::OkStatus();
+    }
     TF_ASSIGN_OR_RETURN(
         std::unique_ptr<se::Kernel> kernel,
         CreateKernel(kernel_name_, args_.size(), params.src.text,
@@ -133,8 +137,18 @@ absl::Status KernelThunk::ExecuteOnStream(const ExecuteParams& params) {
   {
     absl::MutexLock lock(&mutex_);
     auto it = kernel_cache_.find(executor);
-    CHECK(it != kernel_cache_.end())
-        << "Initialize() not called for StreamExecutor " << executor;
+    if (it == kernel_cache_.end()) {
+      auto src = lazy_sources_.find(executor);
+      CHECK(src != lazy_sources_.end())
+          << "Initialize() not called for StreamExecutor " << executor;
+      VLOG(3) << "Lazily loading kernel " << kernel_name_;
+      TF_ASSIGN_OR_RETURN(
+          std::unique_ptr<se::Kernel> loaded_kernel,
+          CreateKernel(kernel_name_, args_.size(), src->second.text,
+                       src->second.binary, executor, shmem_bytes_));
+      it = kernel_cache_.emplace(executor, std::move(loaded_kernel)).first;
+      lazy_sources_.erase(src);
+    }
     launch_dimensions = launch_dimensions_;
     cluster_dim = cluster_dim_;
     kernel = it->second.get();
@@ -93,8 +93,15 @@ class KernelThunk : public Thunk {
   const LaunchDimensions& launch_dimensions() const {
     return launch_dimensions_;
   }
+  const std::optional<se::ClusterDim>& cluster_dim() const {
+    return cluster_dim_;
+  }
   // The shared memory required by the kernel.
   int64_t shmem_bytes() const { return shmem_bytes_; }
+  const std::optional<stream_executor::gpu::TmaMetadata>& tma_metadata()
+      const {
+    return tma_metadata_;
+  }
 
  private:
   // Buffer slices passed to the kernel as arguments.
@@ -122,6 +129,12 @@ class KernelThunk : public Thunk {
   mutable absl::Mutex mutex_;
   absl::flat_hash_map<se::StreamExecutor*, std::unique_ptr<se::Kernel>>
       kernel_cache_ ABSL_GUARDED_BY(mutex_);
+
+  // Executable sources for kernels that were not loaded at initialization
+  // time because lazy kernel loading is enabled. The kernel is loaded from the
+  // source on its first launch on the corresponding `StreamExecutor`.
+  absl::flat_hash_map<se::StreamExecutor*, ExecutableSource> lazy_sources_
+      ABSL_GUARDED_BY(mutex_);
 };
 
 //===----------------------------------------------------------------------===//
@@ -345,6 +345,10 @@ class Thunk {
     int local_device_count = 0;
 
     bool requires_exclusive_lock_on_gpu = false;
+
+    // If true, thunks may defer loading device kernels until their first
+    // execution instead of loading them at initialization time.
+    bool lazy_kernel_loading = false;
   };
 
   //===--------------------------------------------------------------------===//
@@ -366,6 +366,16 @@ struct RewriteInsert : mlir::OpRewritePattern<gpu::InsertOp> {
             scalar = b.create<mlir::vector::ExtractOp>(convert, vector_offset)
                          .getResult();
           }
+          // Sub-byte values may be inserted into a tensor of bytes.
+          auto dest_type = op.getDest().getType().getElementType();
+          if (scalar.getType() != dest_type) {
+            int64_t bit_width = scalar.getType().getIntOrFloatBitWidth();
+            if (!scalar.getType().isInteger()) {
+              scalar = b.create<mlir::arith::BitcastOp>(
+                  b.getIntegerType(bit_width), scalar);
+            }
+            scalar = b.create<mlir::arith::ExtUIOp>(dest_type, scalar);
+          }
           auto tensor_indices = b.create<ApplyIndexingOp>(
               map_results, ValueRange(), op.getMap().getIndexingMap());
           Value new_tensor = b.create<mlir::tensor::InsertOp>(
@@ -179,6 +179,23 @@ func.func @insert(%input: !xla_gpu.indexed_vector<32x64xf32, #map>,
 
 // -----
 
+#map = #xla.indexing_map<"(d0, d1)[s0, s1] -> (d1*32+d0*2+s0, s1), domain: d0 in [0, 32], d1 in [0, 8], s0 in [0, 1], s1 in [0, 1]">
+#map1 = #xla.indexing_map<"(d0, d1) -> (d0 mod 16, d1), domain: d0 in [0, 32], d1 in [0, 2]">
+
+func.func @insert_i4_into_i8(%input: !xla_gpu.indexed_vector<32x64xi4, #map>,
+    %i: index, %j: index, %output: tensor<32x64xi8>) -> tensor<32x64xi8> {
+  %0 = xla_gpu.insert %input(%i, %j) into %output at #map1
+    : !xla_gpu.indexed_vector<32x64xi4, #map> -> tensor<32x64xi8>
+  func.return %0 : tensor<32x64xi8>
+}
+// CHECK-LABEL: @insert_i4_into_i8
+// CHECK: %[[SCALAR:.*]] = vector.extract
+// CHECK-SAME: : i4 from vector<2x2xi4>
+// CHECK: %[[WIDENED:.*]] = arith.extui %[[SCALAR]] : i4 to i8
+// CHECK: tensor.insert %[[WIDENED]]
+
+// -----
+
 func.func private @exp(%p0: tensor<32x64xf32>, %i: index, %j: index) -> f32
 
 #map = #xla.indexing_map<"(d0, d1)[s0, s1] -> (d1*32+d0*2+s0, s1), domain: d0 in [0, 32], d1 in [0, 8], s0 in [0, 1], s1 in [0, 1]">
@@ -71,6 +71,8 @@ DebugOptions DefaultDebugOptionsIgnoringFlags() {
   opts.set_xla_backend_optimization_level(3);
   opts.set_xla_gpu_autotune_level(4);
   opts.set_xla_gpu_autotune_max_solutions(0);
+  opts.set_xla_gpu_autotune_max_triton_configs(0);
+  opts.set_xla_gpu_autotune_max_devices(1);
   opts.set_xla_cpu_multi_thread_eigen(true);
   opts.set_xla_gpu_cuda_data_dir("./cuda_sdk_lib");
   opts.set_xla_gpu_generate_debug_info(false);
@@ -89,6 +91,9 @@ DebugOptions DefaultDebugOptionsIgnoringFlags() {
   opts.set_xla_dump_fusion_visualization(false);
   opts.set_xla_dump_include_timestamp(false);
   opts.set_xla_dump_max_hlo_modules(-1);
+  opts.set_xla_dump_async(false);
+  opts.set_xla_dump_async_max_queue_bytes(int64_t{1} << 30);
+  opts.set_xla_dump_module_sample_period(1);
   opts.set_xla_dump_module_metadata(false);
   opts.set_xla_dump_hlo_as_long_text(true);
   opts.set_xla_dump_large_constants(false);
@@ -110,6 +115,10 @@ DebugOptions DefaultDebugOptionsIgnoringFlags() {
   opts.set_xla_cpu_parallel_codegen_split_count(32);
   opts.set_xla_cpu_copy_insertion_use_region_analysis(false);
   opts.set_xla_cpu_enable_concurrency_optimized_scheduler(true);
+  opts.set_xla_cpu_enable_critical_path_thunk_priority(false);
+  opts.set_xla_cpu_experimental_object_cache_dir("");
+  opts.set_xla_cpu_experimental_thunk_profile_num_executions(0);
+  opts.set_xla_cpu_experimental_thunk_profile_path("");
   opts.set_xla_cpu_prefer_vector_width(256);
   opts.set_xla_cpu_max_isa(DefaultMaxIsa());
   opts.set_xla_cpu_generate_unique_c_style_kernel_entry_points(false);
@@ -270,6 +279,15 @@ DebugOptions DefaultDebugOptionsIgnoringFlags() {
   opts.set_xla_gpu_enable_triton_hopper(false);
   opts.set_xla_gpu_experimental_enable_dynamic_dot_search_space(false);
   opts.set_xla_gpu_experimental_enable_fusion_block_level_rewriter(false);
+  opts.set_xla_gpu_experimental_enable_horizontal_reduction_fusion(false);
+  opts.set_xla_gpu_experimental_enable_multi_output_normalization_fusion(false);
+  opts.set_xla_gpu_experimental_enable_windowed_einsum_cost_model(false);
+  opts.set_xla_gpu_experimental_enable_cost_based_conv_layout(false);
+  opts.set_xla_gpu_experimental_enable_launch_bound_loop_unrolling(false);
+  opts.set_xla_gpu_experimental_enable_associative_scan_rewrite(false);
+  opts.set_xla_gpu_experimental_enable_post_scheduling_region_analysis(false);
+  opts.set_xla_gpu_experimental_enable_host_offload_streaming(false);
+  opts.set_xla_gpu_experimental_enable_host_parameter_prefetch(false);
 
   opts.set_xla_gpu_enable_llvm_module_compilation_parallelism(false);
   opts.set_xla_gpu_enable_libnvptxcompiler(
@@ -313,6 +331,7 @@ DebugOptions DefaultDebugOptionsIgnoringFlags() {
   opts.set_xla_enable_command_buffers_during_profiling(false);
 
   opts.set_xla_gpu_cudnn_gemm_max_plans(5);
+  opts.set_xla_gpu_cudnn_graph_cache_dir("");
 
   opts.set_xla_gpu_pgle_accuracy_checker(
       DebugOptions::PGLE_STRICTNESS_LEVEL_WARN);
@@ -321,17 +340,34 @@ DebugOptions DefaultDebugOptionsIgnoringFlags() {
   opts.set_xla_gpu_executable_terminate_timeout_seconds(30);
   opts.set_xla_gpu_experimental_collective_perf_table_path("");
   opts.set_xla_gpu_experimental_matmul_perf_table_path("");
+  opts.set_xla_gpu_experimental_kernel_profiling_interval(0);
+  opts.set_xla_gpu_experimental_kernel_profile_directory("");
+  opts.set_xla_gpu_experimental_lazy_kernel_loading(false);
+  opts.set_xla_gpu_experimental_enable_early_output_events(false);
   opts.set_xla_gpu_experimental_disable_binary_libraries(false);
   // --xla_ignore_channel_id should be kept false by default while channel ids
   // are load-bearing.
   opts.set_xla_ignore_channel_id(false);
   opts.set_xla_gpu_dot_merger_threshold_mb(32);
+  opts.set_xla_gpu_dot_batcher_threshold_mb(0);
   opts.set_xla_enable_fast_math(false);
   opts.set_xla_gpu_experimental_parallel_collective_overlap_limit(1);
   opts.set_xla_pjrt_allow_auto_layout_in_hlo(false);
   opts.set_xla_gpu_enable_scatter_determinism_expander(true);
   opts.set_xla_gpu_unsupported_enable_ragged_all_to_all_decomposer(false);
+  opts.set_xla_gpu_experimental_ragged_all_to_all_num_chunks(1);
+  opts.set_xla_gpu_experimental_collective_quantization_type(
+      PRIMITIVE_TYPE_INVALID);
+  opts.set_xla_gpu_experimental_collective_quantization_error_feedback(false);
+  opts.set_xla_gpu_experimental_all_gather_pipelining_depth(1);
+  opts.set_xla_gpu_enable_latency_hiding_schedule_cache(false);
+  opts.set_xla_gpu_latency_hiding_scheduler_memory_search_steps(0);
+  opts.set_xla_gpu_rematerialization_time_budget_seconds(0);
+  opts.set_xla_gpu_enable_parallel_rematerialization(false);
+  opts.set_xla_gpu_rematerialization_minimize_added_time(false);
+  opts.set_xla_gpu_all_reduce_blueconnect_inter_host_bandwidth_gbps(0);
   opts.set_xla_gpu_unsupported_use_ragged_all_to_all_one_shot_kernel(true);
+  opts.set_xla_gpu_all_reduce_kernel_threshold_bytes(0);
   opts.set_xla_gpu_unsupported_enable_all_reduce_decomposer(false);
   opts.set_xla_gpu_experimental_pack_dot_operands_along_k_dimension(true);
   opts.set_xla_unsupported_crash_on_hlo_pass_fix_max_iterations(false);
@@ -801,6 +837,19 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
         return true;
       };
 
+  // Custom "sub-parser" lambda for
+  // xla_gpu_experimental_collective_quantization_type.
+  auto setter_for_xla_gpu_experimental_collective_quantization_type =
+      [debug_options](const std::string& value) {
+        PrimitiveType type;
+        if (!PrimitiveType_Parse(absl::AsciiStrToUpper(value), &type)) {
+          return false;
+        }
+        debug_options->set_xla_gpu_experimental_collective_quantization_type(
+            type);
+        return true;
+      };
+
   // Don't use an initializer list for initializing the vector; this would
   // create a temporary copy, and exceeds the stack space when compiling with
   // certain configurations.
@@ -1020,6 +1069,34 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
       debug_options->xla_cpu_enable_concurrency_optimized_scheduler(),
       "Use HLO module scheduler that is optimized for extracting concurrency "
       "from an HLO module by trading off extra memory pressure."));
+  flag_list->push_back(tsl::Flag(
+      "xla_cpu_enable_critical_path_thunk_priority",
+      bool_setter_for(
+          &DebugOptions::set_xla_cpu_enable_critical_path_thunk_priority),
+      debug_options->xla_cpu_enable_critical_path_thunk_priority(),
+      "Schedule ready thunks by the length of the critical path computed from "
+      "the HloCostAnalysis thunk cost estimates."));
+  flag_list->push_back(tsl::Flag(
+      "xla_cpu_experimental_object_cache_dir",
+      string_setter_for(
+          &DebugOptions::set_xla_cpu_experimental_object_cache_dir),
+      debug_options->xla_cpu_experimental_object_cache_dir(),
+      "Directory of a persistent cache of object files compiled for the CPU "
+      "backend, used to avoid recompiling unchanged kernels."));
+  flag_list->push_back(tsl::Flag(
+      "xla_cpu_experimental_thunk_profile_num_executions",
+      int32_setter_for(
+          &DebugOptions::set_xla_cpu_experimental_thunk_profile_num_executions),
+      debug_options->xla_cpu_experimental_thunk_profile_num_executions(),
+      "Record execution time of all thunks for the given number of first "
+      "executions and dump the thunk profile to the dump directory."));
+  flag_list->push_back(tsl::Flag(
+      "xla_cpu_experimental_thunk_profile_path",
+      string_setter_for(
+          &DebugOptions::set_xla_cpu_experimental_thunk_profile_path),
+      debug_options->xla_cpu_experimental_thunk_profile_path(),
+      "Path to a thunk profile recorded by a previous run, used to override "
+      "thunk cost estimates."));
   flag_list->push_back(tsl::Flag(
       "xla_cpu_prefer_vector_width",
       int32_setter_for(&DebugOptions::set_xla_cpu_prefer_vector_width),
@@ -1064,6 +1141,19 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
       debug_options->xla_gpu_autotune_max_solutions(),
       "Maximal number of GEMM solutions to consider for autotuning: 0 means "
       "consider all solutions returned by the GEMM library."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_autotune_max_triton_configs",
+      int32_setter_for(&DebugOptions::set_xla_gpu_autotune_max_triton_configs),
+      debug_options->xla_gpu_autotune_max_triton_configs(),
+      "Maximal number of Triton GEMM configs to benchmark per fusion, chosen by "
+      "their estimated run time: 0 means benchmark all generated configs."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_autotune_max_devices",
+      int32_setter_for(&DebugOptions::set_xla_gpu_autotune_max_devices),
+      debug_options->xla_gpu_autotune_max_devices(),
+      "Maximal number of local devices on which the GEMM fusion autotuner "
+      "profiles different fusions in parallel. Only devices identical to the "
+      "compilation device are used."));
   flag_list->push_back(tsl::Flag(
       "xla_gpu_autotune_gemm_rtol",
       float_setter_for(&DebugOptions::set_xla_gpu_autotune_gemm_rtol),
@@ -1230,6 +1320,24 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
                 bool_setter_for(&DebugOptions::set_xla_dump_compress_protos),
                 debug_options->xla_dump_compress_protos(),
                 "Gzip-compress protos dumped by --xla_dump_hlo_as_proto."));
+  flag_list->push_back(
+      tsl::Flag("xla_dump_async",
+                bool_setter_for(&DebugOptions::set_xla_dump_async),
+                debug_options->xla_dump_async(),
+                "Write dump files on a background thread instead of the "
+                "compiling thread."));
+  flag_list->push_back(tsl::Flag(
+      "xla_dump_async_max_queue_bytes",
+      int64_setter_for(&DebugOptions::set_xla_dump_async_max_queue_bytes),
+      debug_options->xla_dump_async_max_queue_bytes(),
+      "Max number of bytes waiting to be written by --xla_dump_async. "
+      "Dumping blocks while the queue is full."));
+  flag_list->push_back(tsl::Flag(
+      "xla_dump_module_sample_period",
+      int64_setter_for(&DebugOptions::set_xla_dump_module_sample_period),
+      debug_options->xla_dump_module_sample_period(),
+      "Only dump every n-th module, as chosen by a hash of the module name. "
+      "Set to <= 1 to dump all modules."));
   flag_list->push_back(tsl::Flag(
       "xla_hlo_graph_addresses",
       bool_setter_for(&DebugOptions::set_xla_hlo_graph_addresses),
@@ -1419,6 +1527,19 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
       "ReduceScatter-AllReduce-AllGather sequence, with the initial "
       "ReduceScatter being performed over all of the devices in the same host. "
       "Set to < 1 to disable all-reduce decomposition."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_all_reduce_blueconnect_inter_host_bandwidth_gbps",
+      float_setter_for(
+          &DebugOptions::
+              set_xla_gpu_all_reduce_blueconnect_inter_host_bandwidth_gbps),
+      debug_options->xla_gpu_all_reduce_blueconnect_inter_host_bandwidth_gbps(),
+      "Bus bandwidth (in GB/s) of the network between hosts for the "
+      "BlueConnect decomposition. If set, all-reduces are only decomposed when "
+      "the decomposition is estimated to be faster than the original "
+      "all-reduce. For multi-host NVLink slices, set "
+      "xla_gpu_all_reduce_blueconnect_num_devices_per_host to the number of "
+      "devices in the slice. Set to <= 0 to decompose all eligible "
+      "all-reduces."));
   flag_list->push_back(tsl::Flag(
       "xla_gpu_enable_while_loop_reduce_scatter_code_motion",
       bool_setter_for(
@@ -1511,6 +1632,22 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
       debug_options->xla_gpu_graph_min_graph_size(),
       "Capture a region as a function to be launched as cuda graph if the "
       "number of moved instructions reaches this threshold."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_graph_max_unrolled_loop_trip_count",
+      int64_setter_for(
+          &DebugOptions::set_xla_gpu_graph_max_unrolled_loop_trip_count),
+      debug_options->xla_gpu_graph_max_unrolled_loop_trip_count(),
+      "Unroll while loops with a known trip count up to this value into "
+      "command buffers instead of using conditional nodes. Zero disables "
+      "unrolling."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_graph_min_launch_overhead_ratio",
+      float_setter_for(
+          &DebugOptions::set_xla_gpu_graph_min_launch_overhead_ratio),
+      debug_options->xla_gpu_graph_min_launch_overhead_ratio(),
+      "Capture a region as a function to be launched as cuda graph only if "
+      "the estimated kernel launch overhead is at least this share of the "
+      "region runtime. Zero captures regions regardless of their runtime."));
   flag_list->push_back(
       tsl::Flag("xla_gpu_graph_enable_concurrent_region",
                 bool_setter_for(
@@ -2021,6 +2158,90 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
       debug_options->xla_gpu_experimental_enable_fusion_block_level_rewriter(),
       "Enabling this flag will attempt to redirect every fusion possible to "
       "the Triton emitter"));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_experimental_enable_horizontal_reduction_fusion",
+      bool_setter_for(
+          &DebugOptions::
+              set_xla_gpu_experimental_enable_horizontal_reduction_fusion),
+      debug_options->xla_gpu_experimental_enable_horizontal_reduction_fusion(),
+      "Combine small, independent row reductions into a single reduction "
+      "before fusion."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_experimental_enable_multi_output_normalization_fusion",
+      bool_setter_for(
+          &DebugOptions::
+              set_xla_gpu_experimental_enable_multi_output_normalization_fusion),
+      debug_options
+          ->xla_gpu_experimental_enable_multi_output_normalization_fusion(),
+      "Fuse normalization diamonds into Triton fusions even if their "
+      "reduction is also used outside of the diamond."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_experimental_enable_windowed_einsum_cost_model",
+      bool_setter_for(
+          &DebugOptions::
+              set_xla_gpu_experimental_enable_windowed_einsum_cost_model),
+      debug_options->xla_gpu_experimental_enable_windowed_einsum_cost_model(),
+      "Only use windowed einsum (collective matmul) for the einsums above the "
+      "size threshold where the estimated overlap of computation and "
+      "communication outweighs its overheads."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_experimental_enable_cost_based_conv_layout",
+      bool_setter_for(
+          &DebugOptions::
+              set_xla_gpu_experimental_enable_cost_based_conv_layout),
+      debug_options->xla_gpu_experimental_enable_cost_based_conv_layout(),
+      "Keep the NCHW layout of the cuDNN convolutions whose operands or result "
+      "have a fixed NCHW layout when transposing them to NHWC is estimated to "
+      "cost more than the convolution itself."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_experimental_enable_launch_bound_loop_unrolling",
+      bool_setter_for(
+          &DebugOptions::
+              set_xla_gpu_experimental_enable_launch_bound_loop_unrolling),
+      debug_options->xla_gpu_experimental_enable_launch_bound_loop_unrolling(),
+      "With the automatic while loop unrolling strategy, also unroll the "
+      "loops without collectives that launch few kernels per iteration, "
+      "within a code size budget."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_experimental_enable_associative_scan_rewrite",
+      bool_setter_for(
+          &DebugOptions::
+              set_xla_gpu_experimental_enable_associative_scan_rewrite),
+      debug_options->xla_gpu_experimental_enable_associative_scan_rewrite(),
+      "Rewrite sequential scan loops with an associative combiner, e.g. "
+      "cumulative sums, into parallel prefix scans of logarithmic depth. This "
+      "reassociates floating-point computations."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_experimental_enable_post_scheduling_region_analysis",
+      bool_setter_for(
+          &DebugOptions::
+              set_xla_gpu_experimental_enable_post_scheduling_region_analysis),
+      debug_options
+          ->xla_gpu_experimental_enable_post_scheduling_region_analysis(),
+      "After scheduling, remove copies with the region-based live range "
+      "analysis up to a bounded cost per copy, even if "
+      "--xla_gpu_copy_insertion_use_region_analysis is off. The sequential "
+      "order of the schedule lets this analysis prove more copies "
+      "unnecessary."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_experimental_enable_host_offload_streaming",
+      bool_setter_for(
+          &DebugOptions::
+              set_xla_gpu_experimental_enable_host_offload_streaming),
+      debug_options->xla_gpu_experimental_enable_host_offload_streaming(),
+      "Split elementwise updates of host-offloaded tensors, such as optimizer "
+      "state, into chunks that are moved to and from the device separately, "
+      "so that the transfers overlap with the update."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_experimental_enable_host_parameter_prefetch",
+      bool_setter_for(
+          &DebugOptions::
+              set_xla_gpu_experimental_enable_host_parameter_prefetch),
+      debug_options->xla_gpu_experimental_enable_host_parameter_prefetch(),
+      "Move entry parameters in host memory to the device right before each "
+      "of their uses. The transfers become asynchronous copies that the "
+      "scheduler starts shortly ahead of the uses, so that the weights of "
+      "models larger than device memory stream in layer by layer."));
   flag_list->push_back(tsl::Flag(
       "xla_gpu_enable_libnvptxcompiler",
       [debug_options](bool enabled) {
@@ -2120,6 +2341,14 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
                 "reused in further compilations; not yet cached kernels are "
                 "compiled as usual and get appended to the cache file whenever "
                 "possible."));
+  flag_list->push_back(
+      tsl::Flag("xla_gpu_kernel_cache_dir",
+                string_setter_for(&DebugOptions::set_xla_gpu_kernel_cache_dir),
+                debug_options->xla_gpu_kernel_cache_dir(),
+                "Path to a directory to cache compiled kernels in. The "
+                "directory can be shared between processes; kernels are "
+                "stored in one cache file per GPU compute capability. Ignored "
+                "if xla_gpu_kernel_cache_file is set."));
   flag_list->push_back(tsl::Flag(
       "xla_gpu_per_fusion_autotune_cache_dir",
       string_setter_for(
@@ -2142,6 +2371,14 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
       "cache. Supported modes: read (provides readonly access to "
       "the cache), update (loads if the cache exists, runs autotuning "
       "and dumps the result otherwise). Default: update."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_experimental_autotune_in_background",
+      bool_setter_for(
+          &DebugOptions::set_xla_gpu_experimental_autotune_in_background),
+      debug_options->xla_gpu_experimental_autotune_in_background(),
+      "Experimental: Compile modules with default autotuning configs and run "
+      "autotuning in the background. Later compilations of the same module "
+      "use the autotuning results."));
   flag_list->push_back(tsl::Flag(
       "xla_enable_command_buffers_during_profiling",
       bool_setter_for(
@@ -2157,6 +2394,14 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
       debug_options->xla_gpu_cudnn_gemm_max_plans(),
       "Limit for the number of kernel configurations (plans) to use during "
       "autotuning of cuDNN GEMM fusions."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_cudnn_graph_cache_dir",
+      string_setter_for(&DebugOptions::set_xla_gpu_cudnn_graph_cache_dir),
+      debug_options->xla_gpu_cudnn_graph_cache_dir(),
+      "Experimental: cache the compiled cuDNN graphs of cuDNN fusions in the "
+      "given directory, keyed by fusion, device and cuDNN version, and reuse "
+      "them in later compilations. Cache invalidation has to be handled by "
+      "the user."));
 
   flag_list->push_back(tsl::Flag("xla_gpu_enable_triton_gemm_int4",
                                  noop_flag_setter<bool>, true,
@@ -2212,6 +2457,12 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
       int32_setter_for(&DebugOptions::set_xla_gpu_dot_merger_threshold_mb),
       debug_options->xla_gpu_dot_merger_threshold_mb(),
       "Dot merger pass threshold to be set in MB."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_dot_batcher_threshold_mb",
+      int32_setter_for(&DebugOptions::set_xla_gpu_dot_batcher_threshold_mb),
+      debug_options->xla_gpu_dot_batcher_threshold_mb(),
+      "Dot batcher pass threshold to be set in MB. Independent dots of equal "
+      "shapes below it are batched into one dot. 0 disables the pass."));
   flag_list->push_back(
       tsl::Flag("xla_enable_fast_math",
                 bool_setter_for(&DebugOptions::set_xla_enable_fast_math),
@@ -2265,6 +2516,79 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
       debug_options->xla_gpu_unsupported_enable_ragged_all_to_all_decomposer(),
       "Internal: Enable the RaggedAllToAllDecomposer, an experimental pass "
       "that rewrites ragged-all-to-all as a dense all-to-all operation."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_experimental_ragged_all_to_all_num_chunks",
+      int32_setter_for(
+          &DebugOptions::set_xla_gpu_experimental_ragged_all_to_all_num_chunks),
+      debug_options->xla_gpu_experimental_ragged_all_to_all_num_chunks(),
+      "Splits ragged-all-to-all operations with several updates per replica "
+      "into this many chained ragged-all-to-alls, each exchanging a group of "
+      "the updates, so that they can be overlapped with compute. Values <= 1 "
+      "disable the split."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_experimental_collective_quantization_type",
+      setter_for_xla_gpu_experimental_collective_quantization_type,
+      PrimitiveType_Name(
+          debug_options->xla_gpu_experimental_collective_quantization_type()),
+      "Compresses the payloads of large bf16 and f32 sum all-reduces and "
+      "reduce-scatters to this type (S8, F8E4M3FN or F8E5M2) with per-block "
+      "scales. Changes numerics. PRIMITIVE_TYPE_INVALID disables the "
+      "compression."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_experimental_collective_quantization_error_feedback",
+      bool_setter_for(
+          &DebugOptions::
+              set_xla_gpu_experimental_collective_quantization_error_feedback),
+      debug_options
+          ->xla_gpu_experimental_collective_quantization_error_feedback(),
+      "With collective quantization, carries the quantization error of "
+      "collectives in while loops over to the next iteration."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_experimental_all_gather_pipelining_depth",
+      int32_setter_for(
+          &DebugOptions::set_xla_gpu_experimental_all_gather_pipelining_depth),
+      debug_options->xla_gpu_experimental_all_gather_pipelining_depth(),
+      "Number of loop iterations ahead of their uses that pipelined "
+      "all-gathers are started. Every extra iteration keeps one more copy of "
+      "the gathered values in the loop state."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_enable_latency_hiding_schedule_cache",
+      bool_setter_for(
+          &DebugOptions::set_xla_gpu_enable_latency_hiding_schedule_cache),
+      debug_options->xla_gpu_enable_latency_hiding_schedule_cache(),
+      "Reuses latency hiding schedules of computations that were scheduled "
+      "before in the same process, e.g. when a module is recompiled after an "
+      "edit."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_latency_hiding_scheduler_memory_search_steps",
+      int32_setter_for(
+          &DebugOptions::
+              set_xla_gpu_latency_hiding_scheduler_memory_search_steps),
+      debug_options->xla_gpu_latency_hiding_scheduler_memory_search_steps(),
+      "If positive and the latency hiding schedule does not fit in memory, "
+      "the number of reschedules spent bisecting the scheduler memory limit "
+      "for the fitting schedule with the most overlap."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_rematerialization_time_budget_seconds",
+      int32_setter_for(
+          &DebugOptions::set_xla_gpu_rematerialization_time_budget_seconds),
+      debug_options->xla_gpu_rematerialization_time_budget_seconds(),
+      "If positive, rematerialization stops after this many seconds and keeps "
+      "the rematerializations done so far."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_enable_parallel_rematerialization",
+      bool_setter_for(
+          &DebugOptions::set_xla_gpu_enable_parallel_rematerialization),
+      debug_options->xla_gpu_enable_parallel_rematerialization(),
+      "Evaluates rematerialization candidates on a thread pool."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_rematerialization_minimize_added_time",
+      bool_setter_for(
+          &DebugOptions::set_xla_gpu_rematerialization_minimize_added_time),
+      debug_options->xla_gpu_rematerialization_minimize_added_time(),
+      "Makes rematerialization choose between recomputing, compressing and "
+      "offloading to host by the run time each adds per byte of memory freed, "
+      "estimated from the device description."));
   flag_list->push_back(tsl::Flag(
       "xla_gpu_unsupported_use_ragged_all_to_all_one_shot_kernel",
       bool_setter_for(
@@ -2274,6 +2598,14 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
           ->xla_gpu_unsupported_use_ragged_all_to_all_one_shot_kernel(),
       "Internal: Enable the one-shot kernel for single-host ragged-all-to-all "
       "operations."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_all_reduce_kernel_threshold_bytes",
+      int64_setter_for(
+          &DebugOptions::set_xla_gpu_all_reduce_kernel_threshold_bytes),
+      debug_options->xla_gpu_all_reduce_kernel_threshold_bytes(),
+      "Size threshold (in bytes) below which single-host all-reduces with peer "
+      "access use a custom one-shot or two-shot kernel instead of NCCL. Zero "
+      "disables the kernel."));
   flag_list->push_back(tsl::Flag(
       "xla_gpu_experimental_enable_alltoall_windowed_einsum",
       bool_setter_for(
@@ -2322,9 +2654,11 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
       string_setter_for(
           &DebugOptions::set_xla_gpu_experimental_collective_perf_table_path),
       debug_options->xla_gpu_experimental_collective_perf_table_path(),
-      "If non empty will interpret this variable as a path for performance "
-      "tables for collectives. Expects `xla.gpu.DeviceHloInstructionProfiles` "
-      "proto."));
+      "If non empty will interpret this variable as a comma-separated list of "
+      "paths for performance tables for collectives. Expects "
+      "`xla.gpu.DeviceHloInstructionProfiles` protos. The tables are merged "
+      "over the default tables shipped with XLA, later tables taking "
+      "precedence for the same collective."));
   flag_list->push_back(tsl::Flag(
       "xla_unsupported_crash_on_hlo_pass_silent_hlo_change",
       bool_setter_for(
@@ -2348,6 +2682,38 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
       "If non empty will interpret this variable as a path for performance "
       "tables for matmuls. Expects `xla.gpu.DeviceHloInstructionProfiles` "
       "proto."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_experimental_kernel_profiling_interval",
+      int32_setter_for(
+          &DebugOptions::set_xla_gpu_experimental_kernel_profiling_interval),
+      debug_options->xla_gpu_experimental_kernel_profiling_interval(),
+      "If positive, every Nth execution of a GPU executable times its kernels "
+      "and writes their average execution times to "
+      "--xla_gpu_experimental_kernel_profile_directory as a profile for the "
+      "profile guided latency estimator."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_experimental_kernel_profile_directory",
+      string_setter_for(
+          &DebugOptions::set_xla_gpu_experimental_kernel_profile_directory),
+      debug_options->xla_gpu_experimental_kernel_profile_directory(),
+      "Directory where kernel timings sampled at runtime are written, see "
+      "--xla_gpu_experimental_kernel_profiling_interval."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_experimental_lazy_kernel_loading",
+      bool_setter_for(
+          &DebugOptions::set_xla_gpu_experimental_lazy_kernel_loading),
+      debug_options->xla_gpu_experimental_lazy_kernel_loading(),
+      "If true, GPU kernels are loaded on their first launch instead of when "
+      "the executable is initialized. Reduces load time of large executables "
+      "where many kernels are rarely or never launched."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_experimental_enable_early_output_events",
+      bool_setter_for(
+          &DebugOptions::set_xla_gpu_experimental_enable_early_output_events),
+      debug_options->xla_gpu_experimental_enable_early_output_events(),
+      "If true, GPU executables mark each output as ready once the thunks "
+      "writing it have been enqueued, so that device-to-host copies of early "
+      "outputs can overlap with the rest of the program."));
   flag_list->push_back(tsl::Flag(
       "xla_gpu_experimental_enable_split_k_rewrite",
       bool_setter_for(
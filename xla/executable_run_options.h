@@ -119,6 +119,14 @@ using RecvDeviceMemoryFunction = std::function<
         stream_executor::DeviceMemoryBase* dst,
         const absl::flat_hash_map<std::string, std::string>& frontend_attrs)>;
 
+// Callback used by the GPU backend only. Called while the executable is being
+// enqueued, as soon as all work writing the top-level output `output_index`
+// (or the whole result if it is not a tuple) has been enqueued on `stream`.
+// Callers can record an event on `stream` to find out when that output is
+// ready, before the rest of the executable completes.
+using OutputReadyFunction =
+    std::function<void(int64_t output_index, stream_executor::Stream* stream)>;
+
 // Class containing options for running a LocalExecutable.
 class ExecutableRunOptions {
  public:
@@ -229,6 +237,15 @@ class ExecutableRunOptions {
     return recv_device_memory_function_;
   }
 
+  // See documentation on OutputReadyFunction.
+  ExecutableRunOptions& set_output_ready_function(OutputReadyFunction* f) {
+    output_ready_function_ = f;
+    return *this;
+  }
+  OutputReadyFunction* output_ready_function() const {
+    return output_ready_function_;
+  }
+
   // CPU-backend specific options. These are kept out-of-line to avoid bloating
   // the size of this dependency for CPU-only AOT builds.
   ExecutableRunOptions& set_cpu_executable_run_options(
@@ -270,6 +287,7 @@ class ExecutableRunOptions {
   ThenExecuteFunction* then_execute_function_ = nullptr;
   SendDeviceMemoryFunction* send_device_memory_function_ = nullptr;
   RecvDeviceMemoryFunction* recv_device_memory_function_ = nullptr;
+  OutputReadyFunction* output_ready_function_ = nullptr;
   RunId run_id_;
   const cpu::CpuExecutableRunOptions* cpu_executable_run_options_ = nullptr;
   const gpu::GpuExecutableRunOptions* gpu_executable_run_options_ = nullptr;
@@ -32,6 +32,7 @@ limitations under the License.
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
+#include "absl/types/span.h"
 #include "xla/comparison_util.h"
 #include "xla/hlo/ir/hlo_computation.h"
 #include "xla/hlo/ir/hlo_instruction.h"
@@ -43,6 +44,7 @@ limitations under the License.
 #include "xla/util.h"
 #include "tsl/platform/errors.h"
 #include "tsl/platform/logging.h"
+#include "tsl/platform/statusor.h"
 
 namespace xla {
 
@@ -401,27 +403,193 @@ absl::StatusOr<std::unique_ptr<HloAliasAnalysis>> HloAliasAnalysis::Run(
 
   size_t num_values = alias_analysis->dataflow_analysis_->values().size();
   alias_analysis->buffers_ = CreateBuffers(alias_analysis->dataflow_analysis());
-  alias_analysis->value_to_buffer_.reserve(num_values);
+  alias_analysis->ComputeValueToBuffer();
 
-  for (HloBuffer& buffer : alias_analysis->buffers_) {
+  CHECK_EQ(alias_analysis->value_to_buffer_.size(), num_values);
+  TF_DCHECK_OK(alias_analysis->Verify());
+
+  alias_analysis->ComputeLiveOutBuffers();
+
+  XLA_VLOG_LINES(2, alias_analysis->ToString());
+  return alias_analysis;
+}
+
+void HloAliasAnalysis::ComputeValueToBuffer() {
+  value_to_buffer_.clear();
+  value_to_buffer_.reserve(dataflow_analysis_->values().size());
+  for (HloBuffer& buffer : buffers_) {
     for (const HloValue* value : buffer.values()) {
-      alias_analysis->value_to_buffer_[value] = &buffer;
+      value_to_buffer_[value] = &buffer;
     }
   }
+}
 
-  CHECK_EQ(alias_analysis->value_to_buffer_.size(), num_values);
-  TF_DCHECK_OK(alias_analysis->Verify());
+void HloAliasAnalysis::ComputeLiveOutBuffers() {
+  live_out_buffers_.clear();
+  HloInstruction* root = module_->entry_computation()->root_instruction();
+  ShapeUtil::ForEachSubshape(
+      root->shape(), [&](const Shape& /*subshape*/, const ShapeIndex& index) {
+        std::vector<const HloBuffer*> buffers = ComputeBuffersAt(root, index);
+        live_out_buffers_.insert(buffers.begin(), buffers.end());
+      });
+}
+
+bool HloAliasAnalysis::UpdateBuffers(
+    absl::Span<HloValue* const> changed_values) {
+  // Collect the changed values, the values aliased with them and the other
+  // values of their buffers, and union the values that must share a buffer.
+  FlatValueSet values;
+  std::vector<const HloValue*> worklist;
+  absl::flat_hash_map<const HloValue*, const HloValue*> representatives;
+  auto add_value = [&](const HloValue* value) {
+    if (values.insert(value).second) {
+      representatives[value] = value;
+      worklist.push_back(value);
+    }
+  };
+  auto find_representative = [&](const HloValue* value) {
+    while (representatives.at(value) != value) {
+      value = representatives.at(value);
+    }
+    return value;
+  };
+  for (const HloValue* value : changed_values) {
+    add_value(value);
+  }
+  while (!worklist.empty()) {
+    const HloValue* value = worklist.back();
+    worklist.pop_back();
+    if (auto it = value_to_buffer_.find(value); it != value_to_buffer_.end()) {
+      for (const HloValue* buffer_value : it->second->values()) {
+        add_value(buffer_value);
+      }
+    }
+    for (const HloValue* aliased_value :
+         ComputeAliasedValues(*value, *dataflow_analysis_)) {
+      add_value(aliased_value);
+      const HloValue* representative = find_representative(value);
+      const HloValue* aliased_representative =
+          find_representative(aliased_value);
+      if (representative != aliased_representative) {
+        representatives[aliased_representative] = representative;
+      }
+    }
+  }
+
+  // Each set of aliased values may contain the values of at most one existing
+  // buffer, and all of them.
+  absl::flat_hash_map<const HloValue*, HloBuffer*> representative_to_buffer;
+  absl::flat_hash_map<const HloBuffer*, const HloValue*>
+      buffer_to_representative;
+  for (const HloValue* value : values) {
+    auto it = value_to_buffer_.find(value);
+    if (it == value_to_buffer_.end()) {
+      continue;
+    }
+    const HloValue* representative = find_representative(value);
+    if (representative_to_buffer.insert({representative, it->second})
+                .first->second != it->second ||
+        buffer_to_representative.insert({it->second, representative})
+                .first->second != representative) {
+      VLOG(1) << "Cannot update the buffer of " << *value << " locally";
+      return false;
+    }
+  }
 
-  HloInstruction* root = module->entry_computation()->root_instruction();
-  ShapeUtil::ForEachSubshape(root->shape(), [&](const Shape& /*subshape*/,
-                                                const ShapeIndex& index) {
-    std::vector<const HloBuffer*> buffers =
-        alias_analysis->ComputeBuffersAt(root, index);
-    alias_analysis->live_out_buffers_.insert(buffers.begin(), buffers.end());
+  absl::flat_hash_map<const HloValue*, std::vector<const HloValue*>>
+      aliased_sets;
+  for (const HloValue* value : values) {
+    aliased_sets[find_representative(value)].push_back(value);
+  }
+  std::vector<HloBuffer::Id> updated_buffer_ids;
+  std::vector<std::vector<const HloValue*>> new_buffer_values;
+  for (auto& [representative, aliased_values] : aliased_sets) {
+    absl::c_sort(aliased_values, HloValue::IdLessThan);
+    auto it = representative_to_buffer.find(representative);
+    if (it == representative_to_buffer.end()) {
+      new_buffer_values.push_back(std::move(aliased_values));
+    } else if (it->second->values() != aliased_values) {
+      *it->second = HloBuffer(it->second->id(), std::move(aliased_values));
+      updated_buffer_ids.push_back(it->second->id());
+    }
+  }
+  // Number the new buffers in the order of their values, for determinism.
+  absl::c_sort(new_buffer_values, [](const auto& a, const auto& b) {
+    return a.front()->id() < b.front()->id();
   });
+  const HloBuffer* old_buffers = buffers_.data();
+  for (std::vector<const HloValue*>& buffer_values : new_buffer_values) {
+    updated_buffer_ids.push_back(buffers_.size());
+    buffers_.emplace_back(buffers_.size(), std::move(buffer_values));
+  }
 
-  XLA_VLOG_LINES(2, alias_analysis->ToString());
-  return alias_analysis;
+  if (buffers_.data() != old_buffers) {
+    ComputeValueToBuffer();
+  } else {
+    for (HloBuffer::Id id : updated_buffer_ids) {
+      for (const HloValue* value : buffers_[id].values()) {
+        value_to_buffer_[value] = &buffers_[id];
+      }
+    }
+  }
+  ComputeLiveOutBuffers();
+  TF_DCHECK_OK(Verify());
+  return true;
+}
+
+absl::StatusOr<bool> HloAliasAnalysis::UpdateAfterAddingInstruction(
+    HloInstruction* instruction) {
+  std::vector<HloValue*> changed_values;
+  TF_ASSIGN_OR_RETURN(bool updated,
+                      dataflow_analysis_->UpdateAfterAddingInstruction(
+                          instruction, &changed_values));
+  return updated && UpdateBuffers(changed_values);
+}
+
+bool HloAliasAnalysis::UpdateAfterReplacingOperand(
+    HloInstruction* user, const HloInstruction* old_operand) {
+  std::vector<HloValue*> changed_values;
+  return dataflow_analysis_->UpdateAfterReplacingOperand(user, old_operand,
+                                                         &changed_values) &&
+         UpdateBuffers(changed_values);
+}
+
+bool HloAliasAnalysis::RemoveInstruction(HloInstruction* instruction) {
+  if (!instruction->called_computations().empty()) {
+    return false;
+  }
+  // Without users, the values defined by the instruction alias at most their
+  // in-place operands, so removing them never splits a buffer.
+  bool emptied_buffer = false;
+  for (const auto& [index, value_set] :
+       dataflow_analysis_->GetInstructionValueSet(instruction)) {
+    for (const HloValue* value : value_set.values()) {
+      if (value->defining_instruction() != instruction) {
+        continue;
+      }
+      HloBuffer* buffer = value_to_buffer_.at(value);
+      std::vector<const HloValue*> buffer_values = buffer->values();
+      buffer_values.erase(absl::c_find(buffer_values, value));
+      emptied_buffer |= buffer_values.empty();
+      *buffer = HloBuffer(buffer->id(), std::move(buffer_values));
+      value_to_buffer_.erase(value);
+    }
+  }
+  CHECK(dataflow_analysis_->RemoveInstruction(instruction));
+
+  if (emptied_buffer) {
+    std::vector<HloBuffer> buffers;
+    for (const HloBuffer& buffer : buffers_) {
+      if (!buffer.values().empty()) {
+        buffers.emplace_back(buffers.size(), buffer.values());
+      }
+    }
+    buffers_ = std::move(buffers);
+    ComputeValueToBuffer();
+  }
+  ComputeLiveOutBuffers();
+  TF_DCHECK_OK(Verify());
+  return true;
 }
 
 }  // namespace xla
@@ -101,12 +101,32 @@ class HloAliasAnalysis {
     return results;
   }
 
+  // Incremental counterparts of the HloDataflowAnalysis methods of the same
+  // names, which also update the buffers of the changed values. Buffer ids are
+  // kept, except that RemoveInstruction renumbers the buffers if one becomes
+  // empty. Return false if the edit cannot be handled locally, including when
+  // it merges or splits existing buffers; the analysis is then stale until it
+  // is recomputed with Run.
+  absl::StatusOr<bool> UpdateAfterAddingInstruction(
+      HloInstruction* instruction);
+  bool UpdateAfterReplacingOperand(HloInstruction* user,
+                                   const HloInstruction* old_operand);
+  bool RemoveInstruction(HloInstruction* instruction);
+
  protected:
   explicit HloAliasAnalysis(const HloModule* module);
 
   // Verify various invariants of the alias analysis.
   absl::Status Verify() const;
 
+  // Recomputes the buffers of `changed_values`, and of the values aliased with
+  // them. Returns false if that merges or splits existing buffers.
+  bool UpdateBuffers(absl::Span<HloValue* const> changed_values);
+
+  // Rebuild value_to_buffer_ and live_out_buffers_ from buffers_.
+  void ComputeValueToBuffer();
+  void ComputeLiveOutBuffers();
+
   const HloModule* module_;
 
   // A set of buffers that live out the module.
@@ -17,10 +17,14 @@ limitations under the License.
 
 #include <memory>
 #include <set>
+#include <string>
 #include <vector>
 
+#include "absl/algorithm/container.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/log/log.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
 #include "absl/strings/string_view.h"
 #include "xla/hlo/analysis/hlo_ordering.h"
 #include "xla/hlo/ir/hlo_computation.h"
@@ -37,6 +41,7 @@ limitations under the License.
 #include "xla/shape.h"
 #include "xla/shape_util.h"
 #include "xla/tsl/lib/core/status_test_util.h"
+#include "xla/tsl/platform/status_matchers.h"
 #include "xla/xla_data.pb.h"
 #include "tsl/platform/logging.h"
 #include "tsl/platform/statusor.h"
@@ -46,6 +51,7 @@ namespace xla {
 namespace {
 
 using ::testing::UnorderedElementsAre;
+using ::tsl::testing::IsOkAndHolds;
 
 class HloAliasAnalysisTest : public HloHardwareIndependentTestBase {
  protected:
@@ -1017,5 +1023,96 @@ ENTRY main {
             analysis.GetUniqueBufferAt(fusion));
 }
 
+// Returns the buffers of the analysis and whether they live out, with values
+// named by their defining positions rather than their ids.
+std::vector<std::string> DescribeBuffers(const HloAliasAnalysis& analysis) {
+  std::vector<std::string> buffers;
+  for (const HloBuffer& buffer : analysis.buffers()) {
+    std::vector<std::string> values;
+    for (const HloValue* value : buffer.values()) {
+      values.push_back(value->defining_position().ToString());
+    }
+    absl::c_sort(values);
+    buffers.push_back(absl::StrCat(absl::StrJoin(values, ", "),
+                                   analysis.BufferLivesOut(buffer)
+                                       ? " (live out)"
+                                       : ""));
+  }
+  absl::c_sort(buffers);
+  return buffers;
+}
+
+TEST_F(HloAliasAnalysisTest, UpdateAfterLocalEdits) {
+  absl::string_view hlo_string = R"(
+HloModule m
+
+ENTRY entry {
+  p0 = f32[8] parameter(0)
+  p1 = f32[2] parameter(1)
+  i = s32[] parameter(2)
+  copy = f32[8] copy(p0)
+  ROOT negate = f32[8] negate(copy)
+}
+)";
+  TF_ASSERT_OK_AND_ASSIGN(module_, ParseAndReturnVerifiedModule(hlo_string));
+  HloAliasAnalysis& analysis = RunAnalysis();
+  HloComputation* entry = module_->entry_computation();
+  HloInstruction* p0 = entry->GetInstructionWithName("p0");
+  HloInstruction* copy = entry->GetInstructionWithName("copy");
+  HloInstruction* negate = entry->GetInstructionWithName("negate");
+
+  // The dynamic-update-slice is in place, so it joins the buffer of its
+  // operand.
+  HloInstruction* dus =
+      entry->AddInstruction(HloInstruction::CreateDynamicUpdateSlice(
+          copy->shape(), copy, entry->GetInstructionWithName("p1"),
+          {entry->GetInstructionWithName("i")}));
+  EXPECT_THAT(analysis.UpdateAfterAddingInstruction(dus), IsOkAndHolds(true));
+  EXPECT_EQ(analysis.GetUniqueBufferAt(dus), analysis.GetUniqueBufferAt(copy));
+  TF_ASSERT_OK(negate->ReplaceOperandWith(0, dus));
+  EXPECT_TRUE(analysis.UpdateAfterReplacingOperand(negate, copy));
+
+  // A new buffer, removed again before the next analysis.
+  HloInstruction* unused = entry->AddInstruction(
+      HloInstruction::CreateUnary(p0->shape(), HloOpcode::kCopy, p0));
+  EXPECT_THAT(analysis.UpdateAfterAddingInstruction(unused),
+              IsOkAndHolds(true));
+  EXPECT_EQ(analysis.GetUniqueBufferAt(unused).values().size(), 1);
+  EXPECT_TRUE(analysis.RemoveInstruction(unused));
+  TF_ASSERT_OK(entry->RemoveInstruction(unused));
+
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloAliasAnalysis> expected,
+                          HloAliasAnalysis::Run(module_.get()));
+  EXPECT_EQ(DescribeBuffers(analysis), DescribeBuffers(*expected));
+  EXPECT_EQ(analysis.buffers().size(), expected->buffers().size());
+}
+
+TEST_F(HloAliasAnalysisTest, UpdateThatChangesBuffersIsNotLocal) {
+  absl::string_view hlo_string = R"(
+HloModule m
+
+ENTRY entry {
+  p0 = f32[8] parameter(0)
+  p1 = f32[2] parameter(1)
+  i = s32[] parameter(2)
+  copy0 = f32[8] copy(p0)
+  copy1 = f32[8] copy(p0)
+  dus = f32[8] dynamic-update-slice(copy0, p1, i)
+  ROOT t = (f32[8], f32[8]) tuple(dus, copy1)
+}
+)";
+  TF_ASSERT_OK_AND_ASSIGN(module_, ParseAndReturnVerifiedModule(hlo_string));
+  HloAliasAnalysis& analysis = RunAnalysis();
+  HloInstruction* dus = module_->entry_computation()->GetInstructionWithName(
+      "dus");
+  HloInstruction* copy0 = dus->mutable_operand(0);
+
+  // The dynamic-update-slice now updates copy1 in place, which moves it from
+  // the buffer of copy0 to the buffer of copy1.
+  TF_ASSERT_OK(dus->ReplaceOperandWith(
+      0, module_->entry_computation()->GetInstructionWithName("copy1")));
+  EXPECT_FALSE(analysis.UpdateAfterReplacingOperand(dus, copy0));
+}
+
 }  // namespace
 }  // namespace xla
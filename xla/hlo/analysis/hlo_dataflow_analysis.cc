@@ -15,6 +15,8 @@ limitations under the License.
 
 #include "xla/hlo/analysis/hlo_dataflow_analysis.h"
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <memory>
@@ -1438,6 +1440,123 @@ void HloDataflowAnalysis::Propagate() {
   }
 }
 
+bool HloDataflowAnalysis::CanUpdateLocally(
+    const HloInstruction* instruction) const {
+  switch (instruction->opcode()) {
+    // The value sets of these flow from or into other computations.
+    case HloOpcode::kParameter:
+    case HloOpcode::kAsyncStart:
+    case HloOpcode::kAsyncUpdate:
+    case HloOpcode::kAsyncDone:
+      return false;
+    default:
+      break;
+  }
+  return absl::c_all_of(instruction->called_computations(),
+                        [&](const HloComputation* called_computation) {
+                          return call_graph_->GetNode(called_computation)
+                                     .context() == CallContext::kEmbedded;
+                        });
+}
+
+bool HloDataflowAnalysis::PropagateLocally(
+    absl::Span<HloInstruction* const> instructions,
+    absl::flat_hash_set<HloValue*>& changed_values) {
+  std::vector<HloInstruction*> worklist(instructions.begin(),
+                                        instructions.end());
+  absl::flat_hash_set<HloInstruction*> workset(instructions.begin(),
+                                               instructions.end());
+  while (!worklist.empty()) {
+    HloInstruction* instruction = worklist.back();
+    worklist.pop_back();
+    workset.erase(instruction);
+
+    if (!CanUpdateLocally(instruction)) {
+      VLOG(1) << "Cannot update the value set of " << instruction->name()
+              << " locally";
+      return false;
+    }
+    InstructionValueSet prev_value_set = GetInstructionValueSet(instruction);
+    if (!UpdateInstructionValueSet(instruction)) {
+      continue;
+    }
+    UpdatePositionsOfValuesAt(instruction, GetInstructionValueSet(instruction),
+                              &prev_value_set, &changed_values);
+
+    if (instruction->IsRoot()) {
+      const CallGraphNode& call_graph_node =
+          call_graph_->GetNode(instruction->parent());
+      if (call_graph_node.context() != CallContext::kEmbedded &&
+          !call_graph_node.caller_callsites().empty()) {
+        VLOG(1) << "Cannot propagate out of " << instruction->name()
+                << " locally";
+        return false;
+      }
+    }
+    for (HloInstruction* user : instruction->users()) {
+      if (workset.insert(user).second) {
+        worklist.push_back(user);
+      }
+    }
+  }
+  return true;
+}
+
+void HloDataflowAnalysis::UpdatePositionsOfValuesAt(
+    HloInstruction* instruction, const InstructionValueSet& new_value_set,
+    const InstructionValueSet* prev_value_set,
+    absl::flat_hash_set<HloValue*>* changed_values) {
+  auto contains = [](const HloValueSet& value_set, const HloValue* value) {
+    return absl::c_binary_search(value_set.values(), value,
+                                 HloValue::IdLessThan);
+  };
+  auto is_defined_at = [&](const HloValue* value, const ShapeIndex& index) {
+    return value->defining_instruction() == instruction &&
+           value->defining_index() == index;
+  };
+  auto update_value = [&](const HloValue* value) -> HloValue& {
+    HloValue& mutable_value = GetValue(value->id());
+    if (changed_values != nullptr) {
+      changed_values->insert(&mutable_value);
+    }
+    return mutable_value;
+  };
+
+  if (prev_value_set != nullptr) {
+    for (const auto& [index, value_set] : *prev_value_set) {
+      for (const HloValue* value : value_set.values()) {
+        if (!is_defined_at(value, index) &&
+            !contains(new_value_set.element(index), value)) {
+          update_value(value).RemovePosition(instruction, index);
+        }
+      }
+    }
+  }
+  for (const auto& [index, value_set] : new_value_set) {
+    for (const HloValue* value : value_set.values()) {
+      if (!is_defined_at(value, index) &&
+          (prev_value_set == nullptr ||
+           !contains(prev_value_set->element(index), value))) {
+        update_value(value).AddPosition(instruction, index);
+      }
+    }
+  }
+}
+
+void HloDataflowAnalysis::InvalidateUsesOfValuesAt(
+    const HloInstruction* instruction,
+    absl::flat_hash_set<HloValue*>* changed_values) {
+  for (const auto& [index, value_set] : GetInstructionValueSet(instruction)) {
+    for (const HloValue* value : value_set.values()) {
+      HloValue& mutable_value = GetValue(value->id());
+      mutable_value.InvalidateUses();
+      if (changed_values != nullptr) {
+        changed_values->insert(&mutable_value);
+      }
+    }
+  }
+}
+
 const InstructionValueSet& HloDataflowAnalysis::GetInstructionValueSet(
     const HloInstruction* instruction) const {
   DCHECK(value_sets_.contains(instruction))
@@ -1458,205 +1577,207 @@ absl::Status HloDataflowAnalysis::InitializeInstructionValueSets() {
                                           execution_threads_)) {
       continue;
     }
-    const CallGraphNode& call_graph_node = call_graph_->GetNode(computation);
     for (HloInstruction* instruction :
          computation->MakeInstructionPostOrder()) {
-      // Create an empty shape tree.
-      value_sets_.insert({instruction, std::make_unique<InstructionValueSet>(
-                                           &instruction->shape())});
-
-      // For each sub-shape of the instruction shape, add a new HloValue to its
-      // HloValueSet. should_define may be provided to define a subset of
-      // values.
-      auto define_all_values =
-          [this, &instruction](
-              absl::FunctionRef<bool(const ShapeIndex&)> should_define =
-                  [](const ShapeIndex&) { return true; }) {
-            for (auto& pair : GetInstructionValueSet(instruction)) {
-              const ShapeIndex& index = pair.first;
-
-              bool defines_value;
-              if (forwards_value_ != nullptr &&
-                  forwards_value_(instruction, index).has_value()) {
-                defines_value = false;
-              } else {
-                defines_value = should_define(index);
-              }
-
-              if (defines_value) {
-                HloValue* value =
-                    NewHloValue(instruction, index, /*is_phi=*/false);
-                GetValueSet(instruction, index).AddValue(value);
-              }
-            }
-          };
+      TF_RETURN_IF_ERROR(InitializeInstructionValueSet(instruction));
+    }
+  }
 
-      // Add a new HloValue to the HloValueSet corresponding to the given index
-      // of the instruction shape.
-      auto define_value_at = [this, &instruction](const ShapeIndex& index) {
-        HloValue* value = NewHloValue(instruction, index, /*is_phi=*/false);
-        GetValueSet(instruction, index).AddValue(value);
-      };
+  return absl::OkStatus();
+}
 
-      switch (instruction->opcode()) {
-        case HloOpcode::kBitcast:
-          if (bitcast_defines_value_) {
-            define_all_values();
-          }
-          break;
-        case HloOpcode::kAddDependency:
-        case HloOpcode::kWhile:
-        case HloOpcode::kCall:
-        case HloOpcode::kConditional:
-        case HloOpcode::kGetTupleElement:
-        case HloOpcode::kDomain:
-        case HloOpcode::kOptimizationBarrier:
-          // These instructions define no values. The values in their output
-          // flow from their operands or from cross computation dataflow.
-          break;
-        case HloOpcode::kParameter:
-          if (call_graph_node.context() == CallContext::kBoth) {
-            // We do not support a subcomputation that is called from both a
-            // parallel and sequential context. In this case, the parameter
-            // would both define a value and propagate a value from its
-            // caller. This limitation is not really a problem because the call
-            // graph is typically flattened.
-            return Unimplemented(
-                "Computation %s is called in both a parallel (eg, kMap) and "
-                "sequential (eg, kCall) context",
-                computation->name());
+absl::Status HloDataflowAnalysis::InitializeInstructionValueSet(
+    HloInstruction* instruction) {
+  const CallGraphNode& call_graph_node =
+      call_graph_->GetNode(instruction->parent());
+  // Create an empty shape tree.
+  value_sets_.insert({instruction, std::make_unique<InstructionValueSet>(
+                                       &instruction->shape())});
+
+  // For each sub-shape of the instruction shape, add a new HloValue to its
+  // HloValueSet. should_define may be provided to define a subset of values.
+  auto define_all_values =
+      [this, &instruction](
+          absl::FunctionRef<bool(const ShapeIndex&)> should_define =
+              [](const ShapeIndex&) { return true; }) {
+        for (auto& pair : GetInstructionValueSet(instruction)) {
+          const ShapeIndex& index = pair.first;
+
+          bool defines_value;
+          if (forwards_value_ != nullptr &&
+              forwards_value_(instruction, index).has_value()) {
+            defines_value = false;
+          } else {
+            defines_value = should_define(index);
           }
-          if (call_graph_node.caller_callsites().empty() ||
-              call_graph_node.context() == CallContext::kEmbedded) {
-            // Parameters of computations called in a parallel context (eg, map
-            // and reduce) as well as parameters of dead computations define all
-            // values in their output. Otherwise the values of the parameter
-            // come from the caller (eg, operands to the kCall instruction).
-            define_all_values();
+
+          if (defines_value) {
+            HloValue* value = NewHloValue(instruction, index, /*is_phi=*/false);
+            GetValueSet(instruction, index).AddValue(value);
           }
-          break;
-        case HloOpcode::kCopy:
-        case HloOpcode::kTuple:
-          // These instructions only define their top-level values. Any other
-          // values flow from their operands.
-          define_value_at(/*index=*/{});
-          break;
-        case HloOpcode::kAsyncStart: {
-          // AsyncStart produces a tuple of {{aliased operands}, {destination},
-          // contexts}. It defines all of the tuple-shaped values and the
-          // contexts.
-          // If the thread is excluded, then we don't track the contained
-          // dataflow, and define the destination values too.
-          bool thread_included = HloInstruction::IsThreadIncluded(
-              instruction->async_execution_thread(), execution_threads_);
-          define_all_values([&](const ShapeIndex& index) {
-            return ShapeUtil::GetSubshape(instruction->shape(), index)
-                       .IsTuple() ||
-                   (!thread_included && index.front() == 1) ||
-                   (index.front() > 1);
-          });
-          break;
         }
-        case HloOpcode::kAsyncUpdate:
-          // AsyncUpdate produces a tuple of {{aliased operands}, {destination},
-          // contexts} where all of the array-typed values alias with the
-          // operand. So, only tuple-shaped values are defined by AsyncUpdate.
-          define_all_values([&](const ShapeIndex& index) {
-            return ShapeUtil::GetSubshape(instruction->shape(), index)
-                .IsTuple();
-          });
-          break;
-        case HloOpcode::kAsyncDone:
-          // AsyncDone's output aliases its output. It defines all remaining
-          // tuple-shaped values.
-          define_all_values([&](const ShapeIndex& index) {
-            return ShapeUtil::GetSubshape(instruction->shape(), index)
-                .IsTuple();
-          });
-          break;
-        case HloOpcode::kCopyStart:
-          // CopyStart produces a tuple of {destination buffer, aliased operand,
-          // U32 context}.
-          define_value_at(/*index=*/{});
-          define_value_at(/*index=*/{0});
-          define_value_at(/*index=*/{2});
-          break;
-        case HloOpcode::kCopyDone:
-          // CopyDone consumes a tuple produced by CopyStart and produces an
-          // element. Its output aliases its input tuple element {0}.
-          break;
-        case HloOpcode::kAllGatherStart:
-          // AllGatherStart produces a tuple of
-          // {aliased operands, destination buffers}. If there is more than
-          // one operand, then both aliased operands and destination buffers
-          // will be tuples themselves. all-gather-start will define all tuples
-          // and all tuple leaves (arrays) in tuple sub-index 1 (destination
-          // buffers).
-          define_all_values([&](const ShapeIndex& index) {
-            return ShapeUtil::GetSubshape(instruction->shape(), index)
-                       .IsTuple() ||
-                   index.front() == 1;
-          });
-          break;
-        case HloOpcode::kAllGatherDone:
-          // AllGatherDone's output aliases its input tuple element {1}.
-          if (instruction->shape().IsTuple()) {
-            define_value_at(/*index=*/{});
-          }
-          break;
-        case HloOpcode::kAllReduceDone:
-          // AllReduceDone's output aliases its input.
-          break;
-        case HloOpcode::kCollectivePermuteStart:
-          // CollectivePermuteStart produces a tuple of {{aliased operand(s)},
-          // {destination buffer(s)}, contexts}, where the context data are
-          // optional.
-          define_value_at(/*index=*/{});
-          define_value_at(/*index=*/{1});
-          for (int i = 2; i < instruction->shape().tuple_shapes_size(); ++i) {
-            define_value_at(/*index=*/{i});
-          }
+      };
 
-          if (Cast<HloCollectivePermuteInstruction>(instruction)->inplace()) {
-            CHECK_EQ(instruction->operand_count(), 4);
-            if (instruction->operand(1)->shape().IsTuple()) {
-              for (int i = 0; i < ShapeUtil::TupleElementCount(
-                                      instruction->operand(1)->shape());
-                   ++i) {
-                define_value_at(/*index=*/{1, i});
-              }
-            }
-          } else if (instruction->operand_count() > 1) {
-            for (int i = 0; i < instruction->operand_count(); ++i) {
-              define_value_at(/*index=*/{1, i});
-            }
-          }
-          break;
-        case HloOpcode::kCollectivePermuteDone:
-          // CollectivePermuteDone's output aliases its input tuple element {1}.
-          if (instruction->shape().IsTuple()) {
-            define_value_at(/*index=*/{});
-          }
-          break;
-        case HloOpcode::kRecvDone:
-          // RecvDone produces a two-element tuple. Element zero aliases its
-          // input tuple element {0}; element one is a token.
-          define_value_at(/*index=*/{});
-          define_value_at(/*index=*/{1});
-          break;
-        case HloOpcode::kSend:
-          // Send produces a tuple of {aliased operand, U32 context, token},
-          // therefore only defines the top-level tuple and the tuple elements
-          // at {1} and {2}.
-          define_value_at(/*index=*/{});
-          define_value_at(/*index=*/{1});
-          define_value_at(/*index=*/{2});
-          break;
-        default:
-          define_all_values();
-          break;
+  // Add a new HloValue to the HloValueSet corresponding to the given index
+  // of the instruction shape.
+  auto define_value_at = [this, &instruction](const ShapeIndex& index) {
+    HloValue* value = NewHloValue(instruction, index, /*is_phi=*/false);
+    GetValueSet(instruction, index).AddValue(value);
+  };
+
+  switch (instruction->opcode()) {
+    case HloOpcode::kBitcast:
+      if (bitcast_defines_value_) {
+        define_all_values();
       }
+      break;
+    case HloOpcode::kAddDependency:
+    case HloOpcode::kWhile:
+    case HloOpcode::kCall:
+    case HloOpcode::kConditional:
+    case HloOpcode::kGetTupleElement:
+    case HloOpcode::kDomain:
+    case HloOpcode::kOptimizationBarrier:
+      // These instructions define no values. The values in their output
+      // flow from their operands or from cross computation dataflow.
+      break;
+    case HloOpcode::kParameter:
+      if (call_graph_node.context() == CallContext::kBoth) {
+        // We do not support a subcomputation that is called from both a
+        // parallel and sequential context. In this case, the parameter
+        // would both define a value and propagate a value from its
+        // caller. This limitation is not really a problem because the call
+        // graph is typically flattened.
+        return Unimplemented(
+            "Computation %s is called in both a parallel (eg, kMap) and "
+            "sequential (eg, kCall) context",
+            instruction->parent()->name());
+      }
+      if (call_graph_node.caller_callsites().empty() ||
+          call_graph_node.context() == CallContext::kEmbedded) {
+        // Parameters of computations called in a parallel context (eg, map
+        // and reduce) as well as parameters of dead computations define all
+        // values in their output. Otherwise the values of the parameter
+        // come from the caller (eg, operands to the kCall instruction).
+        define_all_values();
+      }
+      break;
+    case HloOpcode::kCopy:
+    case HloOpcode::kTuple:
+      // These instructions only define their top-level values. Any other
+      // values flow from their operands.
+      define_value_at(/*index=*/{});
+      break;
+    case HloOpcode::kAsyncStart: {
+      // AsyncStart produces a tuple of {{aliased operands}, {destination},
+      // contexts}. It defines all of the tuple-shaped values and the
+      // contexts.
+      // If the thread is excluded, then we don't track the contained
+      // dataflow, and define the destination values too.
+      bool thread_included = HloInstruction::IsThreadIncluded(
+          instruction->async_execution_thread(), execution_threads_);
+      define_all_values([&](const ShapeIndex& index) {
+        return ShapeUtil::GetSubshape(instruction->shape(), index).IsTuple() ||
+               (!thread_included && index.front() == 1) ||
+               (index.front() > 1);
+      });
+      break;
     }
+    case HloOpcode::kAsyncUpdate:
+      // AsyncUpdate produces a tuple of {{aliased operands}, {destination},
+      // contexts} where all of the array-typed values alias with the
+      // operand. So, only tuple-shaped values are defined by AsyncUpdate.
+      define_all_values([&](const ShapeIndex& index) {
+        return ShapeUtil::GetSubshape(instruction->shape(), index).IsTuple();
+      });
+      break;
+    case HloOpcode::kAsyncDone:
+      // AsyncDone's output aliases its output. It defines all remaining
+      // tuple-shaped values.
+      define_all_values([&](const ShapeIndex& index) {
+        return ShapeUtil::GetSubshape(instruction->shape(), index).IsTuple();
+      });
+      break;
+    case HloOpcode::kCopyStart:
+      // CopyStart produces a tuple of {destination buffer, aliased operand,
+      // U32 context}.
+      define_value_at(/*index=*/{});
+      define_value_at(/*index=*/{0});
+      define_value_at(/*index=*/{2});
+      break;
+    case HloOpcode::kCopyDone:
+      // CopyDone consumes a tuple produced by CopyStart and produces an
+      // element. Its output aliases its input tuple element {0}.
+      break;
+    case HloOpcode::kAllGatherStart:
+      // AllGatherStart produces a tuple of
+      // {aliased operands, destination buffers}. If there is more than
+      // one operand, then both aliased operands and destination buffers
+      // will be tuples themselves. all-gather-start will define all tuples
+      // and all tuple leaves (arrays) in tuple sub-index 1 (destination
+      // buffers).
+      define_all_values([&](const ShapeIndex& index) {
+        return ShapeUtil::GetSubshape(instruction->shape(), index).IsTuple() ||
+               index.front() == 1;
+      });
+      break;
+    case HloOpcode::kAllGatherDone:
+      // AllGatherDone's output aliases its input tuple element {1}.
+      if (instruction->shape().IsTuple()) {
+        define_value_at(/*index=*/{});
+      }
+      break;
+    case HloOpcode::kAllReduceDone:
+      // AllReduceDone's output aliases its input.
+      break;
+    case HloOpcode::kCollectivePermuteStart:
+      // CollectivePermuteStart produces a tuple of {{aliased operand(s)},
+      // {destination buffer(s)}, contexts}, where the context data are
+      // optional.
+      define_value_at(/*index=*/{});
+      define_value_at(/*index=*/{1});
+      for (int i = 2; i < instruction->shape().tuple_shapes_size(); ++i) {
+        define_value_at(/*index=*/{i});
+      }
+
+      if (Cast<HloCollectivePermuteInstruction>(instruction)->inplace()) {
+        CHECK_EQ(instruction->operand_count(), 4);
+        if (instruction->operand(1)->shape().IsTuple()) {
+          for (int i = 0; i < ShapeUtil::TupleElementCount(
+                                  instruction->operand(1)->shape());
+               ++i) {
+            define_value_at(/*index=*/{1, i});
+          }
+        }
+      } else if (instruction->operand_count() > 1) {
+        for (int i = 0; i < instruction->operand_count(); ++i) {
+          define_value_at(/*index=*/{1, i});
+        }
+      }
+      break;
+    case HloOpcode::kCollectivePermuteDone:
+      // CollectivePermuteDone's output aliases its input tuple element {1}.
+      if (instruction->shape().IsTuple()) {
+        define_value_at(/*index=*/{});
+      }
+      break;
+    case HloOpcode::kRecvDone:
+      // RecvDone produces a two-element tuple. Element zero aliases its
+      // input tuple element {0}; element one is a token.
+      define_value_at(/*index=*/{});
+      define_value_at(/*index=*/{1});
+      break;
+    case HloOpcode::kSend:
+      // Send produces a tuple of {aliased operand, U32 context, token},
+      // therefore only defines the top-level tuple and the tuple elements
+      // at {1} and {2}.
+      define_value_at(/*index=*/{});
+      define_value_at(/*index=*/{1});
+      define_value_at(/*index=*/{2});
+      break;
+    default:
+      define_all_values();
+      break;
   }
 
   return absl::OkStatus();
@@ -1812,6 +1933,106 @@ absl::Status HloDataflowAnalysis::Verify() const {
   return absl::OkStatus();
 }
 
+namespace {
+
+void AppendSortedById(const absl::flat_hash_set<HloValue*>& values,
+                      std::vector<HloValue*>* out) {
+  if (out == nullptr) {
+    return;
+  }
+  const size_t begin = out->size();
+  out->insert(out->end(), values.begin(), values.end());
+  std::sort(out->begin() + begin, out->end(), HloValue::IdLessThan);
+}
+
+}  // namespace
+
+absl::StatusOr<bool> HloDataflowAnalysis::UpdateAfterAddingInstruction(
+    HloInstruction* instruction, std::vector<HloValue*>* changed_values) {
+  if (!HloInstruction::IsThreadIncluded(
+          instruction->parent()->execution_thread(), execution_threads_)) {
+    return true;
+  }
+  // The call graph does not know about the computations of new instructions.
+  if (!instruction->called_computations().empty() ||
+      instruction->opcode() == HloOpcode::kParameter) {
+    return false;
+  }
+
+  const HloValue::Id first_new_value_id = next_value_id_;
+  TF_RETURN_IF_ERROR(InitializeInstructionValueSet(instruction));
+  absl::flat_hash_set<HloValue*> changed;
+  // New values have the highest ids, so values_vector_ stays sorted.
+  for (HloValue::Id id = first_new_value_id; id < next_value_id_; ++id) {
+    HloValue* value = values_.at(id).get();
+    values_vector_.push_back(value);
+    changed.insert(value);
+  }
+  for (const HloInstruction* operand : instruction->operands()) {
+    InvalidateUsesOfValuesAt(operand, &changed);
+  }
+  bool updated = PropagateLocally({instruction}, changed);
+  AppendSortedById(changed, changed_values);
+  return updated;
+}
+
+bool HloDataflowAnalysis::UpdateAfterReplacingOperand(
+    HloInstruction* user, const HloInstruction* old_operand,
+    std::vector<HloValue*>* changed_values) {
+  if (!HloInstruction::IsThreadIncluded(user->parent()->execution_thread(),
+                                        execution_threads_)) {
+    return true;
+  }
+  absl::flat_hash_set<HloValue*> changed;
+  InvalidateUsesOfValuesAt(old_operand, &changed);
+  for (const HloInstruction* operand : user->operands()) {
+    InvalidateUsesOfValuesAt(operand, &changed);
+  }
+  bool updated = PropagateLocally({user}, changed);
+  AppendSortedById(changed, changed_values);
+  return updated;
+}
+
+bool HloDataflowAnalysis::RemoveInstruction(HloInstruction* instruction) {
+  if (!HloInstruction::IsThreadIncluded(
+          instruction->parent()->execution_thread(), execution_threads_)) {
+    return true;
+  }
+  if (!instruction->called_computations().empty()) {
+    return false;
+  }
+  CHECK_EQ(instruction->user_count(), 0) << instruction->name();
+  CHECK(!instruction->IsRoot()) << instruction->name();
+
+  absl::flat_hash_set<HloValue::Id> deleted_value_ids;
+  for (const auto& [index, value_set] : GetInstructionValueSet(instruction)) {
+    for (const HloValue* value : value_set.values()) {
+      if (value->defining_instruction() == instruction) {
+        // Without users, the value cannot flow anywhere else.
+        CHECK_EQ(value->positions().size(), 1) << value->ToShortString();
+        deleted_value_ids.insert(value->id());
+      } else {
+        GetValue(value->id()).RemovePosition(instruction, index);
+      }
+    }
+  }
+  for (const HloInstruction* operand : instruction->operands()) {
+    InvalidateUsesOfValuesAt(operand, /*changed_values=*/nullptr);
+  }
+
+  value_sets_.erase(instruction);
+  values_vector_.erase(
+      std::remove_if(values_vector_.begin(), values_vector_.end(),
+                     [&](const HloValue* value) {
+                       return deleted_value_ids.contains(value->id());
+                     }),
+      values_vector_.end());
+  for (HloValue::Id value_id : deleted_value_ids) {
+    values_.erase(value_id);
+  }
+  return true;
+}
+
 bool HloDataflowAnalysis::DoesNotUseOperandBuffer(
     const HloInstruction* operand, const ShapeIndex& index,
     const HloInstruction* user) const {
@@ -241,6 +241,34 @@ class HloDataflowAnalysis {
   // Verifies various invariants of the dataflow analysis.
   absl::Status Verify() const;
 
+  // The following methods update the analysis after a small edit of the
+  // module, instead of rerunning it. Only the value sets reached by the edit
+  // are recomputed, and all other values keep their ids. If `changed_values`
+  // is not null, the values that were created, or whose positions or uses
+  // changed, are appended to it.
+  //
+  // Edits whose dataflow crosses computation boundaries, e.g. into a while body
+  // or out of a called computation, and new instructions that call
+  // computations are not handled locally. The methods then return false, and
+  // the analysis is stale until it is recomputed with Run.
+
+  // Updates the analysis after `instruction` was added to its computation.
+  absl::StatusOr<bool> UpdateAfterAddingInstruction(
+      HloInstruction* instruction,
+      std::vector<HloValue*>* changed_values = nullptr);
+
+  // Updates the analysis after `old_operand` was replaced as an operand of
+  // `user`. `old_operand` must not have been removed from the module yet.
+  bool UpdateAfterReplacingOperand(
+      HloInstruction* user, const HloInstruction* old_operand,
+      std::vector<HloValue*>* changed_values = nullptr);
+
+  // Removes `instruction`, and the values it defines, from the analysis. Must
+  // be called right before `instruction` is removed from its computation. The
+  // instruction must have no users and not be a root. Returns false without
+  // changing the analysis if the instruction calls computations.
+  bool RemoveInstruction(HloInstruction* instruction);
+
  private:
   static bool AreTransitiveUsesElementwiseOrTuple(const HloInstruction* inst);
 
@@ -279,6 +307,9 @@ class HloDataflowAnalysis {
   // then propagated throughout the HLO graph by calling Propagate.
   absl::Status InitializeInstructionValueSets();
 
+  // Constructs and initializes the InstructionValueSet of `instruction`.
+  absl::Status InitializeInstructionValueSet(HloInstruction* instruction);
+
   // Updates the value set of the given instruction based on the values flowing
   // into the instruction (operands and cross-computation dataflow).
   bool UpdateInstructionValueSet(HloInstruction* instruction);
@@ -327,6 +358,21 @@ class HloDataflowAnalysis {
   // instructions.
   void Propagate();
 
+  // Propagates the dataflow from `instructions` within their computation, and
+  // updates the positions of the values whose value sets changed. Returns false
+  // if the dataflow reaches other computations.
+  bool PropagateLocally(absl::Span<HloInstruction* const> instructions,
+                        absl::flat_hash_set<HloValue*>& changed_values);
+
+  // Returns whether the value set of `instruction` can be updated without
+  // updating the value sets of other computations.
+  bool CanUpdateLocally(const HloInstruction* instruction) const;
+
+  // Invalidates the uses of the values in the output of `instruction`, e.g.
+  // after its users changed.
+  void InvalidateUsesOfValuesAt(const HloInstruction* instruction,
+                                absl::flat_hash_set<HloValue*>* changed_values);
+
   // Returns the result of the SSA Phi function applied to the given inputs at
   // the given instruction.
   bool Phi(HloInstruction* instruction,
@@ -338,10 +384,12 @@ class HloDataflowAnalysis {
   // state of the value set prior to the change. 'prev_value_set' may be null if
   // this is the first time positions are being computed. The previous state is
   // necessary to efficiently remove positions which have been eliminated due to
-  // changes in the instructions' InstructionValueSet.
+  // changes in the instructions' InstructionValueSet. The values whose
+  // positions changed are added to 'changed_values', if not null.
   void UpdatePositionsOfValuesAt(
       HloInstruction* instruction, const InstructionValueSet& new_value_set,
-      const InstructionValueSet* prev_value_set = nullptr);
+      const InstructionValueSet* prev_value_set = nullptr,
+      absl::flat_hash_set<HloValue*>* changed_values = nullptr);
 
   const HloModule& module_;
   const absl::flat_hash_set<absl::string_view> execution_threads_;
@@ -26,7 +26,9 @@ limitations under the License.
 #include <gtest/gtest.h>
 #include "absl/log/check.h"
 #include "absl/status/status.h"
+#include "absl/algorithm/container.h"
 #include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
 #include "xla/comparison_util.h"
 #include "xla/hlo/analysis/hlo_ordering.h"
 #include "xla/hlo/ir/hlo_computation.h"
@@ -43,6 +45,7 @@ limitations under the License.
 #include "xla/shape.h"
 #include "xla/shape_util.h"
 #include "xla/tsl/lib/core/status_test_util.h"
+#include "xla/tsl/platform/status_matchers.h"
 #include "xla/tsl/platform/statusor.h"
 #include "xla/xla_data.pb.h"
 #include "tsl/platform/statusor.h"
@@ -53,6 +56,7 @@ namespace {
 
 using ::testing::ElementsAre;
 using ::testing::IsEmpty;
+using ::tsl::testing::IsOkAndHolds;
 using ::testing::UnorderedElementsAre;
 
 // Test is parameterized on a bool which is whether the dataflow analysis is
@@ -2266,6 +2270,112 @@ TEST_F(HloDataflowAnalysisTest, AllGatherStartAndDoneWithTuple) {
               UnorderedElementsAre(&analysis.GetValueDefinedAt(start, {1, 1})));
 }
 
+// Returns the value sets, positions and uses of the analysis, with values named
+// by their defining positions rather than their ids.
+std::vector<std::string> DescribeAnalysis(const HloDataflowAnalysis& analysis) {
+  std::vector<std::string> lines;
+  for (const HloComputation* computation : analysis.module().computations()) {
+    for (const HloInstruction* instruction : computation->instructions()) {
+      for (const auto& [index, value_set] :
+           analysis.GetInstructionValueSet(instruction)) {
+        std::string line = absl::StrCat(instruction->name(), index.ToString());
+        for (const HloValue* value : value_set.values()) {
+          absl::StrAppend(&line, " ", value->defining_position().ToString());
+        }
+        lines.push_back(line);
+      }
+    }
+  }
+  for (const HloValue* value : analysis.values()) {
+    std::vector<std::string> positions_and_uses;
+    for (const HloPosition& position : value->positions()) {
+      positions_and_uses.push_back(position.ToString());
+    }
+    for (const HloUse& use : value->GetUses()) {
+      positions_and_uses.push_back(use.ToString());
+    }
+    absl::c_sort(positions_and_uses);
+    lines.push_back(absl::StrCat(value->defining_position().ToString(), ": ",
+                                 absl::StrJoin(positions_and_uses, ", ")));
+  }
+  absl::c_sort(lines);
+  return lines;
+}
+
+TEST_P(HloDataflowAnalysisTest, UpdateAfterLocalEdits) {
+  const char* hlo_text = R"(
+HloModule m
+
+ENTRY entry {
+  p0 = f32[] parameter(0)
+  p1 = f32[] parameter(1)
+  add = f32[] add(p0, p1)
+  t = (f32[], f32[]) tuple(add, p1)
+  ROOT gte = f32[] get-tuple-element(t), index=0
+})";
+  TF_ASSERT_OK_AND_ASSIGN(module_, ParseAndReturnVerifiedModule(hlo_text));
+  const bool ssa_form = GetParam();
+  RunAnalysis(ssa_form);
+  HloComputation* entry = module_->entry_computation();
+  HloInstruction* p1 = entry->GetInstructionWithName("p1");
+  HloInstruction* add = entry->GetInstructionWithName("add");
+  HloInstruction* t = entry->GetInstructionWithName("t");
+
+  HloInstruction* negate = entry->AddInstruction(
+      HloInstruction::CreateUnary(scalar_shape_, HloOpcode::kNegate, p1));
+  std::vector<HloValue*> changed_values;
+  EXPECT_THAT(analysis_->UpdateAfterAddingInstruction(negate, &changed_values),
+              IsOkAndHolds(true));
+  EXPECT_TRUE(absl::c_linear_search(changed_values,
+                                    &analysis_->GetValueDefinedAt(negate)));
+
+  TF_ASSERT_OK(t->ReplaceOperandWith(0, negate));
+  EXPECT_TRUE(analysis_->UpdateAfterReplacingOperand(t, add));
+  EXPECT_TRUE(analysis_->RemoveInstruction(add));
+  TF_ASSERT_OK(entry->RemoveInstruction(add));
+  TF_EXPECT_OK(analysis_->Verify());
+
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloDataflowAnalysis> expected,
+                          HloDataflowAnalysis::Run(*module_, ssa_form));
+  EXPECT_EQ(DescribeAnalysis(*analysis_), DescribeAnalysis(*expected));
+  EXPECT_EQ(analysis_->values().size(), expected->values().size());
+}
+
+TEST_P(HloDataflowAnalysisTest, UpdateIntoWhileIsNotLocal) {
+  const char* hlo_text = R"(
+HloModule m
+
+body {
+  p = (f32[]) parameter(0)
+  x = f32[] get-tuple-element(p), index=0
+  y = f32[] add(x, x)
+  ROOT t = (f32[]) tuple(y)
+}
+
+cond {
+  p = (f32[]) parameter(0)
+  ROOT c = pred[] constant(false)
+}
+
+ENTRY entry {
+  p0 = f32[] parameter(0)
+  init = (f32[]) tuple(p0)
+  ROOT w = (f32[]) while(init), condition=cond, body=body
+})";
+  TF_ASSERT_OK_AND_ASSIGN(module_, ParseAndReturnVerifiedModule(hlo_text));
+  RunAnalysis(GetParam());
+  HloComputation* entry = module_->entry_computation();
+  HloInstruction* p0 = entry->GetInstructionWithName("p0");
+  HloInstruction* init = entry->GetInstructionWithName("init");
+
+  HloInstruction* negate = entry->AddInstruction(
+      HloInstruction::CreateUnary(scalar_shape_, HloOpcode::kNegate, p0));
+  EXPECT_THAT(analysis_->UpdateAfterAddingInstruction(negate),
+              IsOkAndHolds(true));
+  TF_ASSERT_OK(init->ReplaceOperandWith(0, negate));
+  EXPECT_FALSE(analysis_->UpdateAfterReplacingOperand(init, p0));
+}
+
 INSTANTIATE_TEST_SUITE_P(HloDataflowAnalysisInstantiation,
                          HloDataflowAnalysisTest,
                          ::testing::Values(false, true));
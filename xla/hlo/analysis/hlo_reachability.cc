@@ -15,7 +15,9 @@ limitations under the License.
 
 #include "xla/hlo/analysis/hlo_reachability.h"
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <queue>
 #include <vector>
@@ -24,15 +26,18 @@ limitations under the License.
 #include "absl/container/inlined_vector.h"
 #include "absl/functional/function_ref.h"
 #include "absl/types/span.h"
+#include "xla/hlo/ir/hlo_computation.h"
 #include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/tsl/platform/threadpool.h"
 
 namespace xla {
 
 HloReachabilityMap::HloReachabilityMap(
-    absl::Span<const HloInstruction* const> instructions)
-    : bit_sets_(instructions.size(), BitSet(instructions.size())) {
+    absl::Span<const HloInstruction* const> instructions) {
+  bit_sets_.reserve(instructions.size());
   indices_.reserve(instructions.size());
   for (size_t i = 0; i < instructions.size(); ++i) {
+    bit_sets_.emplace_back(instructions.size(), /*capacity=*/i + 1);
     bit_sets_[i].Set(i);  // Instructions are reachable from themselves.
     indices_[GetKey(instructions[i])] = i;
   }
@@ -109,39 +114,71 @@ std::unique_ptr<HloReachabilityMap> HloReachabilityMap::BuildWithRestrictions(
   return result;
 }
 
+void HloReachabilityMap::SetReachabilityToUnionOfInputs(
+    absl::Span<const absl::InlinedVector<Index, 4>> inputs,
+    tsl::thread::ThreadPool* thread_pool) {
+  // Store all words of the unions up front, so that different ranges of words
+  // can be computed concurrently.
+  size_t num_words = 0;
+  for (Index index = 0; index < inputs.size(); ++index) {
+    BitSet& bit_set = bit_sets_[index];
+    for (Index input_index : inputs[index]) {
+      DCHECK_LT(input_index, index);
+      bit_set.StoreWords(bit_sets_[input_index].num_words());
+    }
+    num_words = std::max(num_words, bit_set.num_words());
+  }
+
+  auto union_words = [&](size_t begin, size_t end) {
+    for (Index index = 0; index < inputs.size(); ++index) {
+      for (Index input_index : inputs[index]) {
+        bit_sets_[index].UnionWords(bit_sets_[input_index], begin, end);
+      }
+    }
+  };
+
+  // Each shard holds the bits of 1024 instructions.
+  constexpr size_t kWordsPerShard = 16;
+  const size_t num_shards = (num_words + kWordsPerShard - 1) / kWordsPerShard;
+  if (thread_pool == nullptr || num_shards < 2) {
+    union_words(0, num_words);
+    return;
+  }
+  thread_pool->ParallelFor(num_shards, [&](int64_t begin, int64_t end) {
+    union_words(begin * kWordsPerShard,
+                std::min(end * kWordsPerShard, num_words));
+  });
+}
+
 std::unique_ptr<HloReachabilityMap> HloReachabilityMap::Build(
-    const HloComputation* computation) {
+    const HloComputation* computation, tsl::thread::ThreadPool* thread_pool) {
   HloComputation::ChannelDependencies channel_dependencies =
       computation->ComputeChannelDependencies();
   std::vector<HloInstruction*> instructions =
       computation->MakeInstructionPostOrder(channel_dependencies);
   auto result = std::make_unique<HloReachabilityMap>(instructions);
 
-  auto get_bit_set = [&](const HloInstruction* instruction) -> BitSet& {
-    return result->bit_sets_[result->GetIndex(instruction)];
-  };
-
-  for (const HloInstruction* instruction : instructions) {
-    BitSet& bit_set = get_bit_set(instruction);
-
+  std::vector<absl::InlinedVector<Index, 4>> inputs(instructions.size());
+  for (Index index = 0; index < instructions.size(); ++index) {
     auto add_dependencies = [&](const HloInstruction* instruction) {
       for (const HloInstruction* operand : instruction->operands()) {
-        bit_set |= get_bit_set(operand);
+        inputs[index].push_back(result->GetIndex(operand));
       }
       for (const HloInstruction* predecessor :
            instruction->control_predecessors()) {
-        bit_set |= get_bit_set(predecessor);
+        inputs[index].push_back(result->GetIndex(predecessor));
       }
     };
 
-    add_dependencies(instruction);
+    add_dependencies(instructions[index]);
 
     // If an instruction has channel depencencies, they are also reachable.
-    auto it = channel_dependencies.find(instruction);
+    auto it = channel_dependencies.find(instructions[index]);
     if (it != channel_dependencies.end()) {
       absl::c_for_each(it->second, add_dependencies);
     }
   }
+  result->SetReachabilityToUnionOfInputs(inputs, thread_pool);
   return result;
 }
 
@@ -16,18 +16,23 @@ limitations under the License.
 #ifndef XLA_HLO_ANALYSIS_HLO_REACHABILITY_H_
 #define XLA_HLO_ANALYSIS_HLO_REACHABILITY_H_
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <utility>
 #include <vector>
 
 #include "absl/algorithm/container.h"
 #include "absl/container/flat_hash_map.h"
+#include "absl/container/inlined_vector.h"
 #include "absl/functional/function_ref.h"
 #include "absl/log/check.h"
 #include "absl/types/span.h"
 #include "xla/hlo/ir/hlo_computation.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_module.h"
+#include "xla/tsl/platform/threadpool.h"
 #include "xla/types.h"
 
 namespace xla {
@@ -44,7 +49,9 @@ class HloReachabilityMap {
   using Index = size_t;
 
   // Sets up a graph with no edges and where the nodes correspond to the given
-  // instructions.
+  // instructions. The instructions are expected in post order: the bit-set of
+  // each instruction then only stores the bits of the instructions before it,
+  // which halves the memory of the map.
   explicit HloReachabilityMap(
       absl::Span<const HloInstruction* const> instructions);
 
@@ -54,8 +61,12 @@ class HloReachabilityMap {
   // directed path (from producer to consumer) from 'a' to 'b'. Both data
   // dependencies (operands) and control dependencies are considered for
   // reachability. Trivially an instruction is reachable from itself.
+  //
+  // If `thread_pool` is not null, large maps are built in parallel, each
+  // thread computing the bits of a different range of instructions.
   static std::unique_ptr<HloReachabilityMap> Build(
-      const HloComputation* computation);
+      const HloComputation* computation,
+      tsl::thread::ThreadPool* thread_pool = nullptr);
 
   // Similar to the above Build operation except that it tries to identify
   // paths between instructions that do not contain control instructions
@@ -143,21 +154,29 @@ class HloReachabilityMap {
  private:
   // A dynamically sized bit-set implementation specialized for this use case
   // providing fast bitwise OR (not available in tsl::gtl::BitMap).
+  //
+  // Only the words up to the highest set bit need to be stored; the bits of
+  // the words that are not stored are zero.
   class BitSet {
    public:
     BitSet() = default;
-    explicit BitSet(size_t size)
-        : size_(size), vector_((size + kBits - 1) / kBits, 0) {}
+    explicit BitSet(size_t size) : BitSet(size, size) {}
+    // Stores only the bits below `capacity` up front.
+    BitSet(size_t size, size_t capacity)
+        : size_(size), vector_((capacity + kBits - 1) / kBits, 0) {}
 
     // Returns the bit at the given index.
     bool Get(Index index) const {
       DCHECK(index >= 0 && index < size_);
-      return vector_[index / kBits] & (1ull << (index % kBits));
+      const size_t word = index / kBits;
+      return word < vector_.size() &&
+             (vector_[word] & (1ull << (index % kBits)));
     }
 
     // Sets the bit at the given index.
     void Set(Index index) {
       DCHECK(index >= 0 && index < size_);
+      StoreWords(index / kBits + 1);
       vector_[index / kBits] |= 1ull << (index % kBits);
     }
 
@@ -165,22 +184,45 @@ class HloReachabilityMap {
     void operator|=(const BitSet& other) {
       if (this == &other) return;
       DCHECK(size_ == other.size_);
+      StoreWords(other.num_words());
+      UnionWords(other, 0, other.num_words());
+    }
+
+    // Sets the words [begin, end) of this bit-set to their union with the same
+    // words of `other`. The words must already be stored in this bit-set.
+    // Different ranges of words may be updated concurrently.
+    void UnionWords(const BitSet& other, size_t begin, size_t end) {
+      end = std::min(end, other.num_words());
+      DCHECK_LE(end, num_words());
 
       // Ease the work of the auto-vectorizer.
       const Word* a = vector_.data();
       const Word* b = other.vector_.data();
       Word* __restrict out = vector_.data();
-      size_t num_words = vector_.size();
-      for (size_t i = 0; i < num_words; ++i) {
+      for (size_t i = begin; i < end; ++i) {
         out[i] = a[i] | b[i];
       }
     }
 
+    // Makes sure that at least the first `num_words` words are stored.
+    void StoreWords(size_t num_words) {
+      if (num_words > vector_.size()) {
+        vector_.resize(num_words, 0);
+      }
+    }
+    size_t num_words() const { return vector_.size(); }
+
     // Sets the bitvector to all zeros.
     void SetToZero() { absl::c_fill(vector_, 0); }
 
     bool operator==(const BitSet& other) const {
-      return vector_ == other.vector_;
+      const std::vector<Word>& shorter =
+          num_words() < other.num_words() ? vector_ : other.vector_;
+      const std::vector<Word>& longer =
+          num_words() < other.num_words() ? other.vector_ : vector_;
+      return std::equal(shorter.begin(), shorter.end(), longer.begin()) &&
+             std::all_of(longer.begin() + shorter.size(), longer.end(),
+                         [](Word word) { return word == 0; });
     }
     bool operator!=(const BitSet& other) const { return !(*this == other); }
 
@@ -188,7 +230,7 @@ class HloReachabilityMap {
     using Word = uint64_t;
     static constexpr size_t kBits = 64;
 
-    size_t size_;  // Number of bits in the set.
+    size_t size_ = 0;  // Number of bits in the set.
     std::vector<Word> vector_;
   };
 
@@ -205,6 +247,13 @@ class HloReachabilityMap {
   void SetReachabilityToUnionHelper(absl::Span<const Index> input_indices,
                                     Index index);
 
+  // Sets the bit-set of each instruction to the union of the bit-sets of its
+  // `inputs`, in index order, like FastSetReachabilityToUnion. The indices of
+  // the inputs must be smaller than the index of the instruction.
+  void SetReachabilityToUnionOfInputs(
+      absl::Span<const absl::InlinedVector<Index, 4>> inputs,
+      tsl::thread::ThreadPool* thread_pool);
+
   // Map from instruction to index. The index is used for bit_set_ and the bits
   // within a BitSet.
   absl::flat_hash_map<Key, Index> indices_;
@@ -17,6 +17,7 @@ limitations under the License.
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "absl/random/random.h"
 #include "absl/strings/string_view.h"
@@ -30,6 +31,8 @@ limitations under the License.
 #include "xla/service/hlo_module_config.h"
 #include "xla/shape.h"
 #include "xla/shape_util.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/threadpool.h"
 #include "xla/xla_data.pb.h"
 #include "tsl/platform/status.h"
 #include "tsl/platform/test_benchmark.h"
@@ -253,6 +256,65 @@ TEST_F(HloReachabilityTest, ReplaceInstructions) {
   EXPECT_TRUE(reachability->IsReachable(p0, fusion));
 }
 
+TEST_F(HloReachabilityTest, SetReachableFromLaterInstruction) {
+  // The bit-set of an instruction initially only stores the bits of the
+  // instructions before it.
+  auto builder = HloComputation::Builder(TestName());
+  std::vector<HloInstruction*> instructions;
+  for (int i = 0; i < 130; ++i) {
+    instructions.push_back(builder.AddInstruction(
+        HloInstruction::CreateConstant(LiteralUtil::CreateR0<float>(i))));
+  }
+  auto module = CreateNewVerifiedModule();
+  module->AddEntryComputation(builder.Build(instructions.back()));
+
+  HloReachabilityMap reachability(instructions);
+  EXPECT_FALSE(reachability.IsReachable(instructions[129], instructions[0]));
+  reachability.SetReachable(instructions[129], instructions[0]);
+  EXPECT_TRUE(reachability.IsReachable(instructions[129], instructions[0]));
+  EXPECT_FALSE(reachability.IsReachable(instructions[128], instructions[0]));
+
+  EXPECT_TRUE(reachability.SetReachabilityToUnion({instructions[1]},
+                                                  instructions[2]));
+  EXPECT_TRUE(reachability.IsReachable(instructions[1], instructions[2]));
+  EXPECT_FALSE(reachability.SetReachabilityToUnion({instructions[1]},
+                                                   instructions[2]));
+  EXPECT_TRUE(reachability.SetReachabilityToUnion({instructions[0]},
+                                                  instructions[2]));
+  EXPECT_TRUE(reachability.IsReachable(instructions[129], instructions[2]));
+}
+
+TEST_F(HloReachabilityTest, ParallelBuildMatchesSerialBuild) {
+  // A computation large enough to be built in several shards, where each
+  // instruction adds two earlier ones.
+  const Shape r0f32 = ShapeUtil::MakeShape(F32, {});
+  auto builder = HloComputation::Builder(TestName());
+  std::vector<HloInstruction*> instructions = {
+      builder.AddInstruction(HloInstruction::CreateParameter(0, r0f32, "p0")),
+      builder.AddInstruction(HloInstruction::CreateParameter(1, r0f32, "p1"))};
+  for (int i = 2; i < 5000; ++i) {
+    instructions.push_back(builder.AddInstruction(HloInstruction::CreateBinary(
+        r0f32, HloOpcode::kAdd, instructions[i - 1],
+        instructions[(i * 7919) % (i - 1)])));
+  }
+  auto module = CreateNewVerifiedModule();
+  HloComputation* computation =
+      module->AddEntryComputation(builder.Build(instructions.back()));
+
+  tsl::thread::ThreadPool thread_pool(tsl::Env::Default(), "test", 4);
+  auto serial = HloReachabilityMap::Build(computation);
+  auto parallel = HloReachabilityMap::Build(computation, &thread_pool);
+  for (size_t i = 0; i < instructions.size(); i += 7) {
+    for (size_t j = 0; j < instructions.size(); j += 3) {
+      ASSERT_EQ(serial->IsReachable(instructions[i], instructions[j]),
+                parallel->IsReachable(instructions[i], instructions[j]))
+          << i << " " << j;
+    }
+  }
+  EXPECT_TRUE(parallel->IsReachable(instructions[0], instructions.back()));
+  EXPECT_FALSE(parallel->IsReachable(instructions.back(), instructions[0]));
+}
+
 }  // namespace
 
 class HloReachabilityMapBitSetBenchmark {
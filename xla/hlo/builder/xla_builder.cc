@@ -771,6 +771,10 @@ absl::StatusOr<XlaComputation> XlaBuilder::Build(
       }
     };
     for (size_t index = 0; index < instructions_.size(); ++index) {
+      // Most shapes are static, and re-serializing them would be a waste.
+      if (instruction_shapes_[index]->is_static()) {
+        continue;
+      }
       remove_dynamic_dimension(instruction_shapes_[index].get());
       *instructions_[index].mutable_shape() =
           instruction_shapes_[index]->ToProto();
@@ -783,6 +787,7 @@ absl::StatusOr<XlaComputation> XlaBuilder::Build(
   *entry.mutable_program_shape() = program_shape.ToProto();
   entry.set_root_id(root_id);
 
+  entry.mutable_instructions()->Reserve(instructions_.size());
   for (auto& instruction : instructions_) {
     // Ensures that the instruction names are unique among the whole graph.
     instruction.set_name(
@@ -797,6 +802,7 @@ absl::StatusOr<XlaComputation> XlaBuilder::Build(
   module->set_entry_computation_name(entry.name());
   module->set_entry_computation_id(entry.id());
   *module->mutable_host_program_shape() = entry.program_shape();
+  module->mutable_computations()->Reserve(embedded_.size() + 1);
   for (auto& e : embedded_) {
     module->add_computations()->Swap(&e.second);
   }
@@ -4848,16 +4854,24 @@ absl::StatusOr<XlaOp> XlaBuilder::AddInstruction(
     instr.add_operand_ids(operand.handle());
   }
 
+  // Empty metadata and frontend attributes are cleared rather than copied, so
+  // that large graphs don't allocate two empty submessages per instruction.
   if (one_shot_metadata_.has_value()) {
-    *instr.mutable_metadata() = one_shot_metadata_.value();
+    *instr.mutable_metadata() = std::move(*one_shot_metadata_);
     one_shot_metadata_.reset();
-  } else {
+  } else if (metadata_.ByteSizeLong() != 0) {
     *instr.mutable_metadata() = metadata_;
+  } else {
+    instr.clear_metadata();
   }
   if (sharding_) {
     TF_RETURN_IF_ERROR(NormalizeAndAssignSharing(&instr, *sharding_));
   }
-  *instr.mutable_frontend_attributes() = frontend_attributes_;
+  if (!frontend_attributes_.map().empty()) {
+    *instr.mutable_frontend_attributes() = frontend_attributes_;
+  } else {
+    instr.clear_frontend_attributes();
+  }
 
   handle_to_index_[handle] = instructions_.size();
   instructions_.push_back(std::move(instr));
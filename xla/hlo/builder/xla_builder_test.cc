@@ -1935,6 +1935,28 @@ TEST(XlaBuilderTest, SimpleSetFrontendAttributes) {
   ExpectInstructionsAttributesMatch(*module, expected);
 }
 
+TEST(XlaBuilderTest, EmptyMetadataAndFrontendAttributesAreNotSet) {
+  XlaBuilder b(TestName());
+  ConstantR0(&b, 0);  // No metadata or attribute set
+
+  FrontendAttributes attributes;
+  (*attributes.mutable_map())["attr_a"] = "a";
+  b.SetFrontendAttributes(attributes);
+  OpMetadata metadata;
+  metadata.set_op_name("op_b");
+  b.SetOpMetadata(metadata);
+  ConstantR0(&b, 1);
+
+  TF_ASSERT_OK_AND_ASSIGN(const XlaComputation computation, b.Build());
+  const HloComputationProto& entry = computation.proto().computations(0);
+  ASSERT_EQ(entry.instructions_size(), 2);
+  EXPECT_FALSE(entry.instructions(0).has_metadata());
+  EXPECT_FALSE(entry.instructions(0).has_frontend_attributes());
+  EXPECT_EQ(entry.instructions(1).metadata().op_name(), "op_b");
+  EXPECT_EQ(entry.instructions(1).frontend_attributes().map().at("attr_a"),
+            "a");
+}
+
 TEST(XlaBuilderTest, ComplexSetFrontendAttributes) {
   XlaBuilder b(TestName());
 
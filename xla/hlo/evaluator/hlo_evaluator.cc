@@ -62,6 +62,7 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_computation.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_instructions.h"
+#include "xla/hlo/ir/hlo_module.h"
 #include "xla/hlo/ir/hlo_opcode.h"
 #include "xla/index_util.h"
 #include "xla/layout.h"
@@ -1569,8 +1570,8 @@ absl::Status HloEvaluator::HandleComplex(const HloInstruction* complex) {
       [&](auto primitive_type_constant) -> absl::Status {
         if constexpr (primitive_util::IsComplexType(primitive_type_constant)) {
           using NativeT = primitive_util::NativeTypeOf<primitive_type_constant>;
-          TF_RETURN_IF_ERROR(result.Populate<NativeT>(
-              [&](absl::Span<const int64_t> multi_index) {
+          TF_RETURN_IF_ERROR(result.PopulateParallel<NativeT>(
+              [&](absl::Span<const int64_t> multi_index, int /*thread_id*/) {
                 return NativeT(
                     real.Get<typename NativeT::value_type>(multi_index),
                     imag.Get<typename NativeT::value_type>(multi_index));
@@ -3385,7 +3386,162 @@ absl::Status HloEvaluator::HandleCall(const HloInstruction* call) {
   return absl::OkStatus();
 }
 
+namespace {
+
+// Fusions with fewer elements are evaluated in one go.
+constexpr int64_t kFusionBlockElements = 4096;
+
+// Returns whether each element of the result of `fusion` only depends on the
+// operand elements at the same index: every fused instruction is a parameter
+// or an elementwise op of the shape of the fusion, a scalar constant, or a
+// broadcast of a scalar to the shape of the fusion.
+bool IsBlockwiseElementwiseFusion(const HloInstruction* fusion) {
+  const Shape& shape = fusion->shape();
+  if (!shape.IsArray() || !shape.is_static() ||
+      ShapeUtil::IsEffectiveScalar(shape)) {
+    return false;
+  }
+  for (const HloInstruction* instruction :
+       fusion->fused_instructions_computation()->instructions()) {
+    if (ShapeUtil::IsScalar(instruction->shape())) {
+      if (instruction->opcode() != HloOpcode::kConstant) {
+        return false;
+      }
+      continue;
+    }
+    if (!instruction->shape().IsArray() ||
+        !ShapeUtil::SameDimensions(instruction->shape(), shape)) {
+      return false;
+    }
+    const bool is_scalar_broadcast =
+        instruction->opcode() == HloOpcode::kBroadcast &&
+        ShapeUtil::IsScalar(instruction->operand(0)->shape());
+    if (instruction->opcode() != HloOpcode::kParameter &&
+        !is_scalar_broadcast &&
+        (!instruction->IsElementwise() ||
+         instruction->opcode() == HloOpcode::kRng)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns a copy of the fused computation of a blockwise elementwise fusion in
+// which every array has `block_elements` elements in one dimension.
+std::unique_ptr<HloComputation> CreateBlockComputation(
+    const HloComputation& fused_computation, int64_t block_elements) {
+  HloComputation::Builder builder(
+      absl::StrCat(fused_computation.name(), "_block"));
+  absl::flat_hash_map<const HloInstruction*, HloInstruction*>
+      block_instructions;
+  for (const HloInstruction* instruction :
+       fused_computation.MakeInstructionPostOrder()) {
+    std::vector<HloInstruction*> operands;
+    operands.reserve(instruction->operand_count());
+    for (const HloInstruction* operand : instruction->operands()) {
+      operands.push_back(block_instructions.at(operand));
+    }
+    Shape shape = instruction->shape();
+    if (!ShapeUtil::IsScalar(shape)) {
+      shape = ShapeUtil::MakeShapeWithDescendingLayout(shape.element_type(),
+                                                       {block_elements});
+    }
+    block_instructions[instruction] = builder.AddInstruction(
+        instruction->CloneWithNewOperands(shape, operands));
+  }
+  return builder.Build(
+      block_instructions.at(fused_computation.root_instruction()));
+}
+
+}  // namespace
+
+absl::StatusOr<bool> HloEvaluator::TryHandleFusionBlockwise(
+    const HloInstruction* fusion) {
+  if (!IsBlockwiseElementwiseFusion(fusion)) {
+    return false;
+  }
+  Shape result_shape = fusion->shape();
+  if (!LayoutUtil::HasLayout(result_shape)) {
+    LayoutUtil::SetToDefaultLayout(&result_shape);
+  }
+  const int64_t num_elements = ShapeUtil::ElementsIn(result_shape);
+  if (num_elements <= 2 * kFusionBlockElements) {
+    return false;
+  }
+  // Elements at the same offset in the operands and the result have the same
+  // index only if they all have the same layout.
+  std::vector<const Literal*> operand_literals;
+  operand_literals.reserve(fusion->operand_count());
+  for (const HloInstruction* operand : fusion->operands()) {
+    const Literal& literal = GetEvaluatedLiteralFor(operand);
+    if (!ShapeUtil::SameDimensions(literal.shape(), result_shape) ||
+        !LayoutUtil::Equal(literal.shape().layout(), result_shape.layout())) {
+      return false;
+    }
+    operand_literals.push_back(&literal);
+  }
+
+  HloModule block_module("BlockModuleForFusion", HloModuleConfig(),
+                         std::make_unique<CompilationEnvironments>(
+                             fusion->GetModule()->comp_envs()));
+  HloComputation* block_computation = block_module.AddEntryComputation(
+      CreateBlockComputation(*fusion->fused_instructions_computation(),
+                             kFusionBlockElements));
+  HloComputation* tail_computation = nullptr;
+  if (const int64_t tail_elements = num_elements % kFusionBlockElements;
+      tail_elements != 0) {
+    tail_computation = block_module.AddEmbeddedComputation(
+        CreateBlockComputation(*fusion->fused_instructions_computation(),
+                               tail_elements));
+  }
+
+  std::unique_ptr<HloEvaluator> embedded_evaluator =
+      CreateEmbedded(max_loop_iterations_);
+  embedded_evaluator->set_dynamic_dimension_inference(
+      dynamic_dimension_inference_);
+  Literal result(result_shape);
+  const int64_t result_element_bytes =
+      primitive_util::ByteWidth(result_shape.element_type());
+  std::vector<Literal> block_args(operand_literals.size());
+  std::vector<const Literal*> block_arg_ptrs(operand_literals.size());
+  for (int64_t start = 0; start < num_elements;
+       start += kFusionBlockElements) {
+    const int64_t block_elements =
+        std::min(kFusionBlockElements, num_elements - start);
+    for (int64_t i = 0; i < operand_literals.size(); ++i) {
+      const PrimitiveType type = operand_literals[i]->shape().element_type();
+      const int64_t element_bytes = primitive_util::ByteWidth(type);
+      block_args[i] = Literal(
+          ShapeUtil::MakeShapeWithDescendingLayout(type, {block_elements}));
+      std::memcpy(
+          block_args[i].untyped_data(),
+          static_cast<const char*>(operand_literals[i]->untyped_data()) +
+              start * element_bytes,
+          block_elements * element_bytes);
+      block_arg_ptrs[i] = &block_args[i];
+    }
+    TF_ASSIGN_OR_RETURN(
+        Literal block_result,
+        embedded_evaluator->Evaluate(block_elements == kFusionBlockElements
+                                         ? *block_computation
+                                         : *tail_computation,
+                                     block_arg_ptrs));
+    std::memcpy(static_cast<char*>(result.untyped_data()) +
+                    start * result_element_bytes,
+                block_result.untyped_data(),
+                block_elements * result_element_bytes);
+  }
+  SetEvaluatedLiteralFor(fusion, std::move(result));
+  return true;
+}
+
 absl::Status HloEvaluator::HandleFusion(const HloInstruction* fusion) {
+  TF_ASSIGN_OR_RETURN(bool evaluated_blockwise,
+                      TryHandleFusionBlockwise(fusion));
+  if (evaluated_blockwise) {
+    return absl::OkStatus();
+  }
+
   HloModuleConfig config;
   // Attach cloned computation to an empty HLO module so the existing ones are
   // not modified.
@@ -3491,12 +3647,13 @@ absl::Status HloEvaluator::HandleDynamicSlice(
         operand_literal.shape().dimensions(i) - result_shape.dimensions(i));
   }
 
-  std::vector<int64_t> operand_index(start.size());
   Literal result(result_shape);
   const size_t element_byte_size =
       primitive_util::ByteWidth(result_shape.element_type());
   auto* operand_base = static_cast<const char*>(operand_literal.untyped_data());
-  auto func = [&](void* dest, absl::Span<const int64_t> result_index) {
+  auto func = [&](void* dest, absl::Span<const int64_t> result_index,
+                  int /*thread_id*/) {
+    DimensionVector operand_index(start.size());
     for (int64_t i = 0; i < operand_index.size(); ++i) {
       CHECK_GE(result_index[i] + start[i], 0);
       operand_index[i] = result_index[i] + start[i];
@@ -3509,7 +3666,7 @@ absl::Status HloEvaluator::HandleDynamicSlice(
     std::memcpy(dest, src, element_byte_size);
     return true;
   };
-  TF_RETURN_IF_ERROR(result.PopulateInplace(func));
+  TF_RETURN_IF_ERROR(result.PopulateInplaceParallel(func));
   SetEvaluatedLiteralFor(dynamic_slice, std::move(result));
   return absl::OkStatus();
 }
@@ -3834,8 +3991,8 @@ absl::StatusOr<Literal> StochasticConvertOp(const Literal& operand_literal,
   };
 
   Literal result(result_shape);
-  TF_RETURN_IF_ERROR(
-      result.Populate<ResultT>([&](absl::Span<const int64_t> multi_index) {
+  TF_RETURN_IF_ERROR(result.PopulateParallel<ResultT>(
+      [&](absl::Span<const int64_t> multi_index, int /*thread_id*/) {
         return stochastic_convert_op(operand_literal.Get<Fp>(multi_index),
                                      random_literal.Get<Uint>(multi_index));
       }));
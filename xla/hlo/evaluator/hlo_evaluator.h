@@ -543,6 +543,12 @@ class HloEvaluator : public ConstDfsHloVisitorWithDefault {
     EvaluationState* state_;
   };
 
+  // Evaluates `fusion` a block of elements at a time if every element of its
+  // result only depends on the operand elements at the same index, so that the
+  // intermediate results of the fused computation are never materialized at
+  // full size. Returns false if `fusion` can't be evaluated that way.
+  absl::StatusOr<bool> TryHandleFusionBlockwise(const HloInstruction* fusion);
+
   template <typename ReturnT, typename NativeT, typename UnaryOp>
   static absl::StatusOr<Literal> ElementWiseUnaryOpImpl(
       const HloInstruction* instruction, UnaryOp&& unary_op,
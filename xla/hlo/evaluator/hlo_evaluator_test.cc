@@ -4794,6 +4794,52 @@ TEST_F(HloEvaluatorTest, PreserveMOFusionOutputLayout) {
       absl::c_equal(args[0].data<float>(), actual_literals[0].data<float>()));
 }
 
+TEST_F(HloEvaluatorTest, EvaluateLargeElementwiseFusionBlockwise) {
+  // 10000 elements are evaluated in blocks, including a partial one.
+  constexpr absl::string_view kFusedHlo = R"(
+    HloModule LargeElementwiseFusion
+
+    fused_computation {
+      p0 = f32[100,100]{0,1} parameter(0)
+      p1 = s32[100,100]{0,1} parameter(1)
+      c = f32[] constant(2)
+      b = f32[100,100]{0,1} broadcast(c), dimensions={}
+      convert = f32[100,100]{0,1} convert(p1)
+      multiply = f32[100,100]{0,1} multiply(p0, b)
+      compare = pred[100,100]{0,1} compare(multiply, convert), direction=GT
+      ROOT select = f32[100,100]{0,1} select(compare, multiply, convert)
+    }
+
+    ENTRY entry {
+      p0 = f32[100,100]{0,1} parameter(0)
+      p1 = s32[100,100]{0,1} parameter(1)
+      ROOT fusion = f32[100,100]{0,1} fusion(p0, p1), kind=kLoop,
+        calls=fused_computation
+    })";
+  constexpr absl::string_view kUnfusedHlo = R"(
+    HloModule LargeElementwise
+
+    ENTRY entry {
+      p0 = f32[100,100]{0,1} parameter(0)
+      p1 = s32[100,100]{0,1} parameter(1)
+      c = f32[] constant(2)
+      b = f32[100,100]{0,1} broadcast(c), dimensions={}
+      convert = f32[100,100]{0,1} convert(p1)
+      multiply = f32[100,100]{0,1} multiply(p0, b)
+      compare = pred[100,100]{0,1} compare(multiply, convert), direction=GT
+      ROOT select = f32[100,100]{0,1} select(compare, multiply, convert)
+    })";
+
+  TF_ASSERT_OK_AND_ASSIGN(m_, ParseAndReturnVerifiedModule(kFusedHlo));
+  TF_ASSERT_OK_AND_ASSIGN(std::vector<Literal> args,
+                          MakeFakeArguments(m_.get()));
+  TF_ASSERT_OK_AND_ASSIGN(Literal actual, Evaluate({&args[0], &args[1]}));
+
+  TF_ASSERT_OK_AND_ASSIGN(m_, ParseAndReturnVerifiedModule(kUnfusedHlo));
+  TF_ASSERT_OK_AND_ASSIGN(Literal expected, Evaluate({&args[0], &args[1]}));
+  EXPECT_TRUE(LiteralTestUtil::Equal(expected, actual));
+}
+
 // Tests that custom_calls fail to evaluate when no handler is specified.
 TEST_F(HloEvaluatorTest, EvaluateCustomCall_NoHandler) {
   const absl::string_view hlo_text = R"(
@@ -4945,6 +4991,39 @@ TEST_F(HloEvaluatorTest, ZeroSizedIotaWithHugeDimension) {
   EXPECT_THAT(actual_literal.data<float>(), ::testing::IsEmpty());
 }
 
+TEST_F(HloEvaluatorTest, LargeIotaWithNonDefaultLayout) {
+  const absl::string_view hlo_text = R"(
+  HloModule test
+  ENTRY t {
+    ROOT i = s32[300,400]{0,1} iota(), iota_dimension=1
+  })";
+  TF_ASSERT_OK_AND_ASSIGN(m_, ParseAndReturnVerifiedModule(hlo_text));
+  TF_ASSERT_OK_AND_ASSIGN(
+      Literal actual_literal,
+      HloEvaluator().Evaluate(*m_->entry_computation(), {}));
+  actual_literal.EachCell<int32_t>(
+      [](absl::Span<const int64_t> indices, int32_t value) {
+        EXPECT_EQ(value, indices[1]);
+      });
+}
+
+TEST_F(HloEvaluatorTest, LargeBroadcast) {
+  const absl::string_view hlo_text = R"(
+  HloModule test
+  ENTRY t {
+    i = s32[300] iota(), iota_dimension=0
+    ROOT b = s32[400,300]{0,1} broadcast(i), dimensions={1}
+  })";
+  TF_ASSERT_OK_AND_ASSIGN(m_, ParseAndReturnVerifiedModule(hlo_text));
+  TF_ASSERT_OK_AND_ASSIGN(
+      Literal actual_literal,
+      HloEvaluator().Evaluate(*m_->entry_computation(), {}));
+  actual_literal.EachCell<int32_t>(
+      [](absl::Span<const int64_t> indices, int32_t value) {
+        EXPECT_EQ(value, indices[1]);
+      });
+}
+
 TEST_F(HloEvaluatorTest, CopyStartCopyDone) {
   const absl::string_view hlo_text = R"(
   HloModule test
@@ -1551,11 +1551,11 @@ class HloEvaluatorTypedVisitor : public ConstDfsHloVisitorWithDefault {
                   is_complex_v<ElementwiseT> ||
                   std::is_floating_point_v<ElementwiseT>) {
       Literal result(iota->shape());
-      ShapeUtil::ForEachIndexNoStatus(
-          iota->shape(), [&](absl::Span<const int64_t> idx) {
-            result.Set(idx, static_cast<ReturnT>(idx[iota->iota_dimension()]));
-            return true;
-          });
+      const int64_t iota_dimension = iota->iota_dimension();
+      TF_RETURN_IF_ERROR(result.PopulateParallel<ReturnT>(
+          [&](absl::Span<const int64_t> idx, int /*thread_id*/) {
+            return static_cast<ReturnT>(idx[iota_dimension]);
+          }));
       parent_->SetEvaluatedLiteralFor(iota, std::move(result));
       return absl::OkStatus();
     }
@@ -64,9 +64,10 @@ class BackendConfigWrapper {
       : raw_string_(std::move(raw_string)) {}
   explicit BackendConfigWrapper(const tsl::protobuf::Message& proto)
       : proto_(CloneBackendConfigProto(&proto)) {}
+  // The proto is immutable, so copies share it instead of cloning it.
   BackendConfigWrapper(const BackendConfigWrapper& other) {
     absl::MutexLock other_lock{&other.mutex_};
-    proto_ = CloneBackendConfigProto(other.proto_.get());
+    proto_ = other.proto_;
     raw_string_ = other.raw_string_;
   }
 
@@ -108,7 +109,7 @@ class BackendConfigWrapper {
   // Unfortunately, all members have to be mutable, since either of them can be
   // the cached one.
   mutable absl::Mutex mutex_;
-  mutable std::unique_ptr<tsl::protobuf::Message> proto_
+  mutable std::shared_ptr<const tsl::protobuf::Message> proto_
       ABSL_GUARDED_BY(mutex_);
   mutable std::string raw_string_ ABSL_GUARDED_BY(mutex_);
 };
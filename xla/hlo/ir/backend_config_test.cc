@@ -84,6 +84,18 @@ TEST(BackendConfigWrapperTest, ConcurrentGetRawString) {
   });
 }
 
+TEST(BackendConfigWrapperTest, CopyIsIndependentOfSource) {
+  gpu::GpuBackendConfig proto;
+  proto.set_operation_queue_id(1);
+  BackendConfigWrapper source(proto);
+  BackendConfigWrapper copy(source);
+  source = BackendConfigWrapper(std::string{kRawString});
+  gpu::GpuBackendConfig copied_proto;
+  TF_EXPECT_OK(copy.GetProto(&copied_proto));
+  EXPECT_EQ(copied_proto.operation_queue_id(), 1);
+  EXPECT_TRUE(copy == BackendConfigWrapper(proto));
+}
+
 TEST(BackendConfigWrapperTest, AssignmentToNonEmptyIsOK) {
   BackendConfigWrapper a(std::string{kRawString});
   BackendConfigWrapper b(std::string{kRawString});
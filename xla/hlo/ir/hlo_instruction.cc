@@ -1342,7 +1342,7 @@ absl::StatusOr<std::unique_ptr<HloInstruction>> HloInstruction::CreateFromProto(
 
   TF_RET_CHECK(!proto.name().empty());
   instruction->SetAndSanitizeName(proto.name());
-  *instruction->metadata_ = proto.metadata();
+  *instruction->mutable_metadata() = proto.metadata();
   instruction->backend_config_ = BackendConfigWrapper(proto.backend_config());
 
   TF_RET_CHECK(proto.id() >= 0)
@@ -2350,11 +2350,12 @@ void HloInstruction::SetupDerivedInstruction(
     // Only copy sharding if the tuple tree shape of the two instruction is
     // compatible because copying it between differently shaped instructions
     // can produce invalid shardings.
-    derived_instruction->set_sharding(*sharding_);
+    derived_instruction->copy_sharding(this);
   } else if (!ShapeUtil::CompatibleKind(shape_, derived_instruction->shape())) {
     derived_instruction->clear_sharding();
   }
-  derived_instruction->set_metadata(*metadata_);
+  // The metadata is shared until either instruction modifies it.
+  derived_instruction->metadata_ = metadata_;
   if (has_rare()) {
     derived_instruction->set_result_accuracy(result_accuracy());
     derived_instruction->set_frontend_attributes(frontend_attributes());
@@ -3501,6 +3502,12 @@ absl::Status HloInstruction::ReplaceAllUsesWith(HloInstruction* new_producer,
 
 absl::Status HloInstruction::ReplaceAllUsesWithDifferentShape(
     HloInstruction* new_producer) {
+  // If new_producer has no users of its own, as is the case for a freshly
+  // created replacement, it takes over the user list of this instruction as a
+  // whole instead of adding the users one at a time. The users are in the same
+  // order either way.
+  const bool take_users =
+      new_producer->users_.empty() && !users_.Contains(new_producer);
   bool new_producer_is_user = false;
   // Make a copy since users span might get mutated during the loop
   std::vector<HloInstruction*> users_vector(users().begin(), users().end());
@@ -3514,13 +3521,18 @@ absl::Status HloInstruction::ReplaceAllUsesWithDifferentShape(
     } else {
       std::replace(user->operands_.begin(), user->operands_.end(), this,
                    new_producer);
-      new_producer->AddUser(user);
+      if (!take_users) {
+        new_producer->AddUser(user);
+      }
       if (user->opcode() == HloOpcode::kFusion) {
         TF_RETURN_IF_ERROR(
             Cast<HloFusionInstruction>(user)->DeduplicateFusionOperands());
       }
     }
   }
+  if (take_users) {
+    new_producer->users_ = std::move(users_);
+  }
   users_.Clear();
   if (new_producer_is_user) {
     AddUser(new_producer);
@@ -2005,24 +2005,26 @@ class HloInstruction {
 
   // Sets the debug metadata for this instruction, excluding creation_pass_id,
   // which should never be copied anywhere.
-  void set_metadata(const OpMetadata& metadata) { *metadata_ = metadata; }
+  void set_metadata(const OpMetadata& metadata) {
+    *mutable_metadata() = metadata;
+  }
 
   void set_size_of_generated_code_in_bytes(int64_t code_size_in_bytes) {
-    metadata_->set_size_of_generated_code_in_bytes(code_size_in_bytes);
+    mutable_metadata()->set_size_of_generated_code_in_bytes(code_size_in_bytes);
   }
   void set_size_of_memory_working_set_in_bytes(
       int64_t working_set_size_in_bytes) {
-    metadata_->set_size_of_memory_working_set_in_bytes(
+    mutable_metadata()->set_size_of_memory_working_set_in_bytes(
         working_set_size_in_bytes);
   }
   void set_metadata_op_name(const std::string& name) {
-    metadata_->set_op_name(name);
+    mutable_metadata()->set_op_name(name);
   }
   void set_metadata_deduplicated_name(std::string deduplicated_name) {
-    metadata_->set_deduplicated_name(std::move(deduplicated_name));
+    mutable_metadata()->set_deduplicated_name(std::move(deduplicated_name));
   }
   void set_metadata_scheduling_name(absl::string_view name) {
-    metadata_->set_scheduling_name(std::string(name));
+    mutable_metadata()->set_scheduling_name(std::string(name));
   }
   const OpMetadata& metadata() const { return *metadata_; }
 
@@ -2546,6 +2548,10 @@ class HloInstruction {
     Users(const Users&) = delete;
     Users& operator=(const Users&) = delete;
 
+    // Moving transfers the whole list, including the membership map.
+    Users(Users&&) = default;
+    Users& operator=(Users&&) = default;
+
     bool empty() const { return users_.empty(); }
     int64_t size() const { return users_.size(); }
     const PtrVec<HloInstruction*>& vec() const { return users_; }
@@ -2630,9 +2636,19 @@ class HloInstruction {
   // graph.
   std::shared_ptr<OriginalValue> original_value_ = nullptr;
 
+  // Returns the metadata for modification, copying it first if it is shared
+  // with instructions derived from this one.
+  OpMetadata* mutable_metadata() {
+    if (metadata_.use_count() > 1) {
+      metadata_ = std::make_shared<OpMetadata>(*metadata_);
+    }
+    return metadata_.get();
+  }
+
   // Metadata for debugging.  Allocate it on heap, so that it does not increase
-  // the memory footprint of HloInstruction.
-  std::unique_ptr<OpMetadata> metadata_ = std::make_unique<OpMetadata>();
+  // the memory footprint of HloInstruction. Clones and derived instructions
+  // share it until one of them modifies it.
+  std::shared_ptr<OpMetadata> metadata_ = std::make_shared<OpMetadata>();
 };
 
 // Explicit instantiations in hlo_instruction.cc.
@@ -17,6 +17,7 @@ limitations under the License.
 
 #include <gtest/gtest.h>
 #include "xla/hlo/ir/hlo_instructions.h"
+#include "xla/hlo/ir/hlo_sharding.h"
 #include "xla/service/hlo.pb.h"
 #include "xla/shape_util.h"
 #include "xla/side_effect_util.h"
@@ -92,5 +93,22 @@ TEST(HloInstruction, DeriveComputeTypeAttribute) {
   EXPECT_FALSE(instr1.has_frontend_attributes());
 }
 
+TEST(HloInstruction, DerivedInstructionSharesMetadataUntilModified) {
+  HloConstantInstruction instr0(ShapeUtil::MakeShape(U32, {3, 2}));
+  OpMetadata metadata;
+  metadata.set_op_name("op");
+  instr0.set_metadata(metadata);
+  instr0.set_sharding(HloSharding::Replicate());
+  HloConstantInstruction instr1(ShapeUtil::MakeShape(U32, {3, 2}));
+  instr0.SetupDerivedInstruction(&instr1);
+  EXPECT_EQ(&instr1.metadata(), &instr0.metadata());
+  EXPECT_EQ(instr1.sharding_ptr(), instr0.sharding_ptr());
+
+  instr1.set_metadata_op_name("derived");
+  EXPECT_NE(&instr1.metadata(), &instr0.metadata());
+  EXPECT_EQ(instr0.metadata().op_name(), "op");
+  EXPECT_EQ(instr1.metadata().op_name(), "derived");
+}
+
 }  // namespace
 }  // namespace xla
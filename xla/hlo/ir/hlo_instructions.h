@@ -1313,15 +1313,22 @@ class HloConstantInstruction : public HloInstruction {
   // Returns the literal associated with this instruction.
   const Literal& literal() const { return *literal_; }
   // Returns the (mutable) literal associated with this instruction.
-  // Clone the literal if necessary (do not modify the shared instance).
+  // Clone the literal if necessary (do not modify the shared instance, nor a
+  // shared buffer that may be read-only).
   Literal* mutable_literal() {
-    if (literal_.use_count() > 1) {
+    if (literal_.use_count() > 1 ||
+        (literal_ && literal_->shared_buffer_owner() != nullptr)) {
       literal_.reset(new Literal(literal_->Clone()));
     }
     return literal_.get();
   }
   // Returns whether there is literal associated with this instruction.
   bool HasLiteral() const { return static_cast<bool>(literal_); }
+  // Sets the literal, e.g. of a constant whose literal was dropped. The shape
+  // of `literal` must be compatible with the shape of the instruction.
+  void set_literal(Literal literal) {
+    literal_ = std::make_shared<Literal>(std::move(literal));
+  }
   // Returns a serialized representation of this instruction.
   HloInstructionProto ToProto() const override;
 
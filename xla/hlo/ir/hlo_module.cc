@@ -464,6 +464,10 @@ void HloModule::Print(Printer* printer, const HloPrintOptions& options) const {
 }
 
 std::string HloModule::ToString() const {
+  return ToString(PrintOptionsFromDebugOptions());
+}
+
+HloPrintOptions HloModule::PrintOptionsFromDebugOptions() const {
   const DebugOptions& db_options = config().debug_options();
   HloPrintOptions print_options = db_options.xla_dump_hlo_as_long_text()
                                       ? HloPrintOptions::Default()
@@ -473,7 +477,7 @@ std::string HloModule::ToString() const {
   print_options.set_print_metadata(!db_options.xla_dump_disable_metadata());
   print_options.set_syntax_sugar_async_ops(
       db_options.xla_syntax_sugar_async_ops());
-  return ToString(print_options);
+  return print_options;
 }
 
 std::string HloModule::ToString(const HloPrintOptions& options) const {
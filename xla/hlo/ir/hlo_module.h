@@ -418,6 +418,10 @@ class HloModule {
   std::string ToString() const;
   std::string ToString(const HloPrintOptions& options) const;
 
+  // Returns the options ToString() uses: the default print options adjusted
+  // based on debug options flags.
+  HloPrintOptions PrintOptionsFromDebugOptions() const;
+
   // Returns a Cord representation of the module.
   //
   // (We express the default options using an overload rather than a default
@@ -598,6 +602,8 @@ class HloModule {
         CrossProgramPrefetchInfo{parameter, index, alt_memory_offset});
   }
 
+  void ClearCrossProgramPrefetches() { cross_program_prefetches_.clear(); }
+
   absl::Status SetCrossProgramPrefetchOffset(int64_t prefetch_index,
                                              int64_t offset) {
     TF_RET_CHECK(prefetch_index < cross_program_prefetches_.size());
@@ -384,6 +384,9 @@ class HloSharding {
                            bool overwrite) const;
 
   bool operator==(const HloSharding& other) const {
+    if (this == &other) {
+      return true;
+    }
     return replicated_ == other.replicated_ && maximal_ == other.maximal_ &&
            manual_ == other.manual_ && unknown_ == other.unknown_ &&
            tile_assignment_ == other.tile_assignment_ &&
@@ -400,9 +403,9 @@ class HloSharding {
       return H::combine(std::move(h), sharding.tuple_elements_);
     }
     return H::combine(std::move(h), sharding.replicated_, sharding.manual_,
-                      sharding.unknown_, sharding.tile_assignment_.array(),
+                      sharding.unknown_, sharding.tile_assignment_,
                       sharding.replicate_on_last_tile_dim_,
-                      sharding.shard_group_.ToString());
+                      sharding.shard_group_);
   }
 
   // Gets the tile assignment tensor.
@@ -501,6 +504,12 @@ class HloSharding {
              shard_like == rhs.shard_like;
     }
 
+    template <typename H>
+    friend H AbslHashValue(H h, const ShardGroup& shard_group) {
+      return H::combine(std::move(h), shard_group.shard_group_id,
+                        shard_group.shard_as, shard_group.shard_like);
+    }
+
     std::string ToString() const {
       std::ostringstream result;
       if (shard_as) {
@@ -384,9 +384,18 @@ int64_t IotaTileAssignment::value_at(absl::Span<const int64_t> index) const {
 }
 
 bool TileAssignment::operator==(const TileAssignment& other) const {
+  // Copies share the materialized array, so they compare without looking at
+  // the devices.
+  if (array_ != nullptr && array_ == other.array_) {
+    return true;
+  }
   if (iota_ && other.iota_) {
     return *iota_ == *other.iota_;
   }
+  // Don't materialize the arrays if the shapes differ.
+  if (dimensions() != other.dimensions()) {
+    return false;
+  }
   return array() == other.array();
 }
 
@@ -409,6 +418,16 @@ int64_t TileAssignment::num_elements() const {
   return array_ ? array_->num_elements() : iota_->num_elements();
 }
 
+int64_t TileAssignment::ValueAtLinearIndex(int64_t linear_index) const {
+  absl::Span<const int64_t> dims = dimensions();
+  absl::InlinedVector<int64_t, 6> index(dims.size());
+  for (int64_t i = dims.size() - 1; i >= 0; --i) {
+    index[i] = linear_index % dims[i];
+    linear_index /= dims[i];
+  }
+  return (*this)(index);
+}
+
 int64_t TileAssignment::first() const { return array_ ? *array_->begin() : 0; }
 
 void TileAssignment::Each(
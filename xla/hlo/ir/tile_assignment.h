@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef XLA_HLO_IR_TILE_ASSIGNMENT_H_
 #define XLA_HLO_IR_TILE_ASSIGNMENT_H_
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <functional>
@@ -247,11 +248,18 @@ class TileAssignment {
 
   template <typename H>
   friend H AbslHashValue(H h, const TileAssignment& tile) {
-    // TODO(b/281892190): Ideally hashing a TileAssignment should not force iota
-    // -> full array conversion, but a requirement is that they should have
-    // equivalence. Consider providing a faster hash function for iota tile
-    // assignment.
-    return H::combine(std::move(h), tile.array());
+    // Equal tile assignments may be held in different formats, so the hash
+    // can't depend on the format. Hashing only the dimensions and a few evenly
+    // spaced values keeps iota tile assignments from being materialized, which
+    // is expensive for large device counts.
+    h = H::combine(std::move(h), tile.dimensions());
+    const int64_t num_elements = tile.num_elements();
+    const int64_t num_hashed = std::min(num_elements, kMaxHashedValues);
+    for (int64_t i = 0; i < num_hashed; ++i) {
+      h = H::combine(std::move(h),
+                     tile.ValueAtLinearIndex(i * num_elements / num_hashed));
+    }
+    return h;
   }
 
  private:
@@ -266,6 +274,13 @@ class TileAssignment {
 
   void MaybeMaterializeFullArray() const;
 
+  // Returns the device at `linear_index` in row-major order, without
+  // materializing an iota tile assignment.
+  int64_t ValueAtLinearIndex(int64_t linear_index) const;
+
+  // The number of values that AbslHashValue hashes.
+  static constexpr int64_t kMaxHashedValues = 16;
+
   static const Array<int64_t>* ReplicatedArray() {
     static auto* array = new Array<int64_t>({0});
     return array;
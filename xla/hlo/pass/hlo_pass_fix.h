@@ -56,6 +56,10 @@ class HloPassFix : public Pass {
     return absl::OkStatus();
   }
 
+  // The pipeline must call Run, which runs the pass to a fix point, rather than
+  // running the pass on each computation once.
+  bool IsComputationLocal() const override { return false; }
+
   using HloPassInterface::Run;
   absl::StatusOr<bool> Run(HloModule* module,
                            const absl::flat_hash_set<absl::string_view>&
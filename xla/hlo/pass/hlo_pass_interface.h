@@ -124,6 +124,10 @@ class HloPassInterface {
 
   virtual bool IsPassPipeline() const { return false; }
 
+  // Returns true if the pass changes each computation independently of the
+  // others. Only HloComputationPass returns true.
+  virtual bool IsComputationLocal() const { return false; }
+
   // If an HloPassMetadata has previously been created, it adds a (key, value)
   // pair metric if none was already set or updates the existing value.
   // If an HloPassMetadata doesn't exist, it simply returns.
@@ -167,6 +171,42 @@ class HloModulePass : public HloPassInterface {
   }
 };
 
+// Base class for passes which change each computation independently of the
+// others, which lets HloPassPipeline run them on several computations of a
+// module in parallel.
+//
+// RunOnComputation may only change the given computation. It may replace,
+// remove and rewire its instructions and change their attributes, but must not
+// add instructions or computations, or remove instructions that call
+// computations: these update state shared by the module, e.g. unique ids and
+// the callers of the called computations. It must not read other computations
+// either, and any state of the pass other than its options must be
+// thread-safe. Under these rules the result does not depend on the order in
+// which the computations are processed.
+class HloComputationPass : public HloModulePass {
+ public:
+  // Runs the pass on a single non-fusion computation. Returns whether it
+  // modified the computation.
+  virtual absl::StatusOr<bool> RunOnComputation(
+      HloComputation* computation) = 0;
+
+  using HloPassInterface::Run;
+  absl::StatusOr<bool> Run(HloModule* module,
+                           const absl::flat_hash_set<absl::string_view>&
+                               execution_threads) override {
+    bool changed = false;
+    for (HloComputation* computation :
+         module->MakeNonfusionComputations(execution_threads)) {
+      TF_ASSIGN_OR_RETURN(bool computation_changed,
+                          RunOnComputation(computation));
+      changed |= computation_changed;
+    }
+    return changed;
+  }
+
+  bool IsComputationLocal() const override { return true; }
+};
+
 // Base class for passes which are module-group scoped. These passes cannot run
 // on an HLO module.
 class HloModuleGroupPass : public HloPassInterface {
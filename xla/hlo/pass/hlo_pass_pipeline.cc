@@ -16,16 +16,25 @@ limitations under the License.
 #include "xla/hlo/pass/hlo_pass_pipeline.h"
 
 #include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
 #include "absl/container/flat_hash_set.h"
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
 #include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_module.h"
 #include "xla/hlo/ir/hlo_module_group.h"
 #include "xla/hlo/pass/hlo_pass_interface.h"
 #include "xla/service/dump.h"
@@ -35,6 +44,7 @@ limitations under the License.
 #include "xla/tsl/platform/errors.h"
 #include "xla/tsl/platform/logging.h"
 #include "xla/tsl/platform/status.h"
+#include "xla/tsl/platform/threadpool.h"
 #include "xla/types.h"
 #include "xla/util.h"
 #include "xla/xla.pb.h"
@@ -45,12 +55,32 @@ namespace xla {
 
 namespace {
 
+// Returns the peak resident set size of the process in bytes, or 0 if the
+// platform does not report it.
+int64_t GetPeakRssBytes() {
+#if defined(__linux__) || defined(__APPLE__)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+#if defined(__APPLE__)
+  return usage.ru_maxrss;
+#else
+  return int64_t{usage.ru_maxrss} * 1024;  // Linux reports kilobytes.
+#endif
+#else
+  return 0;
+#endif
+}
+
 void RecordPassStartMetadata(HloModule& module, const std::string& pass_name,
                              const std::string& pipeline_name) {
   module.metadata()->RecordPassStart();
   // An HloPassMetadata was just created so absl::Status should always be OK.
   TF_CHECK_OK(module.metadata()->set_current_pass_name(pass_name));
   TF_CHECK_OK(module.metadata()->set_current_pass_pipeline_name(pipeline_name));
+  TF_CHECK_OK(module.metadata()->set_current_pass_instruction_count_before(
+      module.instruction_count()));
 }
 
 void RecordPassStartMetadata(HloModuleGroup& module_group,
@@ -63,21 +93,29 @@ void RecordPassStartMetadata(HloModuleGroup& module_group,
 
 absl::Status AttemptRecordPassEndMetadata(HloModule& module,
                                           const std::string& pass_name,
-                                          bool module_changed) {
+                                          bool module_changed,
+                                          int64_t peak_rss_increase_bytes) {
   // Module id is set here instead of RecordPassStartMetadata because it may
   // change in the middle of the pass, and we want the final id.
   TF_RETURN_IF_ERROR(
       module.metadata()->set_current_pass_module_id(module.unique_id()));
   TF_RETURN_IF_ERROR(
       module.metadata()->set_current_pass_module_changed(module_changed));
+  TF_RETURN_IF_ERROR(
+      module.metadata()->set_current_pass_instruction_count_after(
+          module.instruction_count()));
+  TF_RETURN_IF_ERROR(
+      module.metadata()->set_current_pass_peak_rss_increase_bytes(
+          peak_rss_increase_bytes));
   TF_RETURN_IF_ERROR(module.metadata()->RecordPassEnd());
   return absl::OkStatus();
 }
 
 void RecordPassEndMetadata(HloModule& module, const std::string& pass_name,
-                           bool module_changed) {
-  absl::Status status =
-      AttemptRecordPassEndMetadata(module, pass_name, module_changed);
+                           bool module_changed,
+                           int64_t peak_rss_increase_bytes) {
+  absl::Status status = AttemptRecordPassEndMetadata(
+      module, pass_name, module_changed, peak_rss_increase_bytes);
   if (!status.ok()) {
     LOG(FATAL) << status;
   }
@@ -85,23 +123,25 @@ void RecordPassEndMetadata(HloModule& module, const std::string& pass_name,
 
 absl::Status AttemptRecordPassEndMetadata(HloModuleGroup& module_group,
                                           const std::string& pass_name,
-                                          bool module_changed) {
+                                          bool module_changed,
+                                          int64_t peak_rss_increase_bytes) {
   for (HloModule* module : module_group.modules()) {
     for (HloModule* other_module : module_group.modules()) {
       TF_RETURN_IF_ERROR(
           module->metadata()->add_current_pass_module_group_module_id(
               other_module->unique_id()));
     }
-    TF_RETURN_IF_ERROR(
-        AttemptRecordPassEndMetadata(*module, pass_name, module_changed));
+    TF_RETURN_IF_ERROR(AttemptRecordPassEndMetadata(
+        *module, pass_name, module_changed, peak_rss_increase_bytes));
   }
   return absl::OkStatus();
 }
 
 void RecordPassEndMetadata(HloModuleGroup& module_group,
-                           const std::string& pass_name, bool module_changed) {
-  absl::Status status =
-      AttemptRecordPassEndMetadata(module_group, pass_name, module_changed);
+                           const std::string& pass_name, bool module_changed,
+                           int64_t peak_rss_increase_bytes) {
+  absl::Status status = AttemptRecordPassEndMetadata(
+      module_group, pass_name, module_changed, peak_rss_increase_bytes);
   if (!status.ok()) {
     LOG(FATAL) << status;
   }
@@ -170,7 +210,8 @@ absl::StatusOr<bool> HloPassPipeline::RunPassesInternal(
                                    ? kPipelineEnd
                                    : passes.front()->name());
   RecordPassEndMetadata(*hlo, std::string(kPipelineStart),
-                        /*module_changed=*/false);
+                        /*module_changed=*/false,
+                        /*peak_rss_increase_bytes=*/0);
 
   bool changed = false;
   bool verify_pass_changed_report =
@@ -194,6 +235,7 @@ absl::StatusOr<bool> HloPassPipeline::RunPassesInternal(
     if (!pass->IsPassPipeline()) {
       compilation_stats_->StartPass(pass_name);
     }
+    const int64_t peak_rss_before = GetPeakRssBytes();
     RecordPassStartMetadata(*hlo, pass_name, pipeline_name);
     auto status_or_changed = RunHelper(pass, hlo, execution_threads);
     if (auto status = status_or_changed.status(); !status.ok()) {
@@ -229,7 +271,8 @@ absl::StatusOr<bool> HloPassPipeline::RunPassesInternal(
                                        ? kPipelineEnd
                                        : passes[i + 1]->name());
     }
-    RecordPassEndMetadata(*hlo, pass_name, pass_changed);
+    RecordPassEndMetadata(*hlo, pass_name, pass_changed,
+                          GetPeakRssBytes() - peak_rss_before);
     changed |= pass_changed;
     if (pass_changed) {
       VLOG(3) << "  Pass caused changes " << pass_name;
@@ -324,6 +367,37 @@ void HloPassPipeline::MaybeDumpHloAndSaveFilenames(
   }
 }
 
+absl::StatusOr<bool> HloPassPipeline::RunComputationLocalPass(
+    HloComputationPass* pass, HloModule* module,
+    const absl::flat_hash_set<absl::string_view>& execution_threads) {
+  std::vector<HloComputation*> computations =
+      module->MakeNonfusionComputations(execution_threads);
+  if (computations.size() < 2) {
+    return pass->Run(module, execution_threads);
+  }
+
+  const int64_t computation_count = module->computation_count();
+  std::vector<absl::StatusOr<bool>> results(computations.size(), false);
+  thread_pool_->ParallelFor(computations.size(),
+                            [&](int64_t begin, int64_t end) {
+                              for (int64_t i = begin; i < end; ++i) {
+                                results[i] =
+                                    pass->RunOnComputation(computations[i]);
+                              }
+                            });
+  TF_RET_CHECK(module->computation_count() == computation_count)
+      << "Computation-local pass " << pass->name()
+      << " added or removed computations";
+
+  // Errors are returned in computation order, like when running serially.
+  bool changed = false;
+  for (absl::StatusOr<bool>& result : results) {
+    TF_ASSIGN_OR_RETURN(bool computation_changed, std::move(result));
+    changed |= computation_changed;
+  }
+  return changed;
+}
+
 absl::StatusOr<bool> HloPassPipeline::Run(
     HloModule* module,
     const absl::flat_hash_set<absl::string_view>& execution_threads) {
@@ -30,6 +30,7 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_module.h"
 #include "xla/hlo/pass/hlo_pass_interface.h"
 #include "xla/service/compilation_stats.h"
+#include "xla/tsl/platform/threadpool.h"
 #include "xla/types.h"
 #include "xla/xla.pb.h"
 
@@ -98,6 +99,14 @@ class HloPassPipeline : public HloPassInterface {
 
   bool IsPassPipeline() const override { return true; }
 
+  // Runs computation-local passes (see HloComputationPass) on the
+  // computations of a module in parallel on the given thread pool. Not owned;
+  // null runs all passes serially, which is the default. Nested pipelines use
+  // their own thread pool.
+  void set_thread_pool(tsl::thread::ThreadPool* thread_pool) {
+    thread_pool_ = thread_pool;
+  }
+
   // Return size of passes_.
   int PassesSize() { return passes_.size(); }
   // Return reference to pass specified by index.
@@ -144,10 +153,15 @@ class HloPassPipeline : public HloPassInterface {
   // empty thread list means all `execution_threads` are considered. These
   // helpers enable templating of the core of the pipeline logic by providing
   // HloModule and HloModuleGroup specific methods with the same name.
-  static absl::StatusOr<bool> RunHelper(
+  absl::StatusOr<bool> RunHelper(
       HloPassInterface* pass, HloModule* module,
       const absl::flat_hash_set<absl::string_view>& execution_threads) {
-    TF_ASSIGN_OR_RETURN(bool changed, pass->Run(module, execution_threads));
+    TF_ASSIGN_OR_RETURN(
+        bool changed,
+        thread_pool_ != nullptr && pass->IsComputationLocal()
+            ? RunComputationLocalPass(static_cast<HloComputationPass*>(pass),
+                                      module, execution_threads)
+            : pass->Run(module, execution_threads));
     module->Cleanup();
     return changed;
   }
@@ -160,10 +174,16 @@ class HloPassPipeline : public HloPassInterface {
     return changed;
   }
 
+  // Runs `pass` on the non-fusion computations of `module` on thread_pool_.
+  absl::StatusOr<bool> RunComputationLocalPass(
+      HloComputationPass* pass, HloModule* module,
+      const absl::flat_hash_set<absl::string_view>& execution_threads);
+
   const std::string name_;
   std::vector<std::unique_ptr<HloPassInterface>> passes_;
   std::vector<std::unique_ptr<HloPassInterface>> invariant_checkers_;
   bool run_called_ = false;
+  tsl::thread::ThreadPool* thread_pool_ = nullptr;
 
   CompilationStats* compilation_stats_;
   // Default stats instance for when one is not passed in the constructor.
@@ -32,13 +32,18 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_module.h"
 #include "xla/hlo/ir/hlo_module_group.h"
+#include "xla/hlo/ir/hlo_opcode.h"
 #include "xla/hlo/parser/hlo_parser.h"
 #include "xla/hlo/pass/hlo_pass_interface.h"
 #include "xla/hlo/testlib/hlo_hardware_independent_test_base.h"
 #include "xla/hlo/testlib/test_helpers.h"
 #include "xla/service/hlo.pb.h"
 #include "xla/tsl/lib/core/status_test_util.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/errors.h"
+#include "xla/tsl/platform/status_matchers.h"
 #include "xla/tsl/platform/statusor.h"
+#include "xla/tsl/platform/threadpool.h"
 #include "xla/util.h"
 
 namespace xla {
@@ -47,6 +52,7 @@ namespace {
 using ::testing::ElementsAre;
 using ::testing::SizeIs;
 using ::testing::StrEq;
+using ::tsl::testing::IsOkAndHolds;
 
 class HloPassPipelineTest : public HloHardwareIndependentTestBase {
  protected:
@@ -106,6 +112,24 @@ class ReverseStringModulePass : public HloModulePass {
   }
 };
 
+// A computation pass which removes copy instructions.
+class RemoveCopiesComputationPass : public HloComputationPass {
+  absl::string_view name() const override { return "remove-copies"; }
+
+  absl::StatusOr<bool> RunOnComputation(HloComputation* computation) override {
+    bool changed = false;
+    for (HloInstruction* instruction :
+         computation->MakeInstructionPostOrder()) {
+      if (instruction->opcode() == HloOpcode::kCopy) {
+        TF_RETURN_IF_ERROR(computation->ReplaceInstruction(
+            instruction, instruction->mutable_operand(0)));
+        changed = true;
+      }
+    }
+    return changed;
+  }
+};
+
 // A module group pass which renames instructions named 'baz' to 'qux'.
 class BazToQuxModuleGroupPass : public HloModuleGroupPass {
   absl::string_view name() const override { return "baz2qux"; }
@@ -381,6 +405,60 @@ ENTRY main {
       ::testing::HasSubstr("Module group pass cannot be run on a module"));
 }
 
+TEST_F(HloPassPipelineTest, ComputationPassRunsInParallel) {
+  const std::string module_str = R"(
+HloModule ComputationPassRunsInParallel
+
+f0 {
+  p = f32[] parameter(0)
+  c = f32[] copy(p)
+  ROOT n = f32[] negate(c)
+}
+
+f1 {
+  p = f32[] parameter(0)
+  c = f32[] copy(p)
+  ROOT e = f32[] exponential(c)
+}
+
+f2 {
+  p = f32[] parameter(0)
+  ROOT c = f32[] copy(p)
+}
+
+ENTRY main {
+  a = f32[] parameter(0)
+  b = f32[] copy(a)
+  c0 = f32[] call(b), to_apply=f0
+  c1 = f32[] call(c0), to_apply=f1
+  ROOT c2 = f32[] call(c1), to_apply=f2
+}
+)";
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<VerifiedHloModule> serial_module,
+                          ParseAndReturnVerifiedModule(module_str));
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<VerifiedHloModule> parallel_module,
+                          ParseAndReturnVerifiedModule(module_str));
+
+  HloPassPipeline serial_pipeline(TestName());
+  serial_pipeline.AddPass<RemoveCopiesComputationPass>();
+  EXPECT_THAT(serial_pipeline.Run(serial_module.get()), IsOkAndHolds(true));
+
+  tsl::thread::ThreadPool thread_pool(tsl::Env::Default(), "test", 4);
+  HloPassPipeline parallel_pipeline(TestName());
+  parallel_pipeline.set_thread_pool(&thread_pool);
+  parallel_pipeline.AddPass<RemoveCopiesComputationPass>();
+  EXPECT_THAT(parallel_pipeline.Run(parallel_module.get()),
+              IsOkAndHolds(true));
+
+  for (const HloComputation* computation : parallel_module->computations()) {
+    for (const HloInstruction* instruction : computation->instructions()) {
+      EXPECT_NE(instruction->opcode(), HloOpcode::kCopy)
+          << instruction->ToString();
+    }
+  }
+  EXPECT_EQ(parallel_module->ToString(), serial_module->ToString());
+}
+
 // Test that metadata is set when a module group goes through a pass pipeline.
 TEST_F(HloPassPipelineTest, SetHloModuleMetadata) {
   HloModuleGroup module_group(TestName());
@@ -415,6 +493,11 @@ TEST_F(HloPassPipelineTest, SetHloModuleMetadata) {
       EXPECT_GT(pass_metadata.start_timestamp_usec(), 0);
       EXPECT_LE(pass_metadata.start_timestamp_usec(),
                 pass_metadata.end_timestamp_usec());
+      EXPECT_EQ(pass_metadata.instruction_count_before(),
+                module->instruction_count());
+      EXPECT_EQ(pass_metadata.instruction_count_after(),
+                module->instruction_count());
+      EXPECT_GE(pass_metadata.peak_rss_increase_bytes(), 0);
     }
   }
 }
@@ -26,16 +26,19 @@ limitations under the License.
 #include <utility>
 #include <vector>
 
+#include "absl/algorithm/container.h"
 #include "absl/base/const_init.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/log/check.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
 #include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
 #include "xla/hlo/analysis/indexed_array_analysis.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_module.h"
@@ -92,6 +95,7 @@ limitations under the License.
 #include "xla/hlo/transforms/simplifiers/convert_operand_folder.h"
 #include "xla/hlo/transforms/simplifiers/convolution_group_converter.h"
 #include "xla/hlo/transforms/simplifiers/dot_dimension_merger.h"
+#include "xla/hlo/transforms/simplifiers/dot_batcher.h"
 #include "xla/hlo/transforms/simplifiers/dot_merger.h"
 #include "xla/hlo/transforms/simplifiers/dynamic_dimension_simplifier.h"
 #include "xla/hlo/transforms/simplifiers/flatten_call_graph.h"
@@ -192,6 +196,7 @@ absl::StatusOr<std::string> OptProvider::BuildAndRunTransformPipeline(
     }
   }
   CHECK_OK(transforms_pipeline.Run(module.get(), {}));
+  RecordPassMetadata(*module);
   return module->ToString();
 }
 
@@ -218,6 +223,60 @@ std::string OptProvider::GetRegisteredPassNamesHelper(
   return absl::StrJoin(names, ",");
 }
 
+std::string FormatPassProfile(
+    absl::Span<const HloModuleMetadataProto> metadata) {
+  struct PassProfile {
+    std::string pipeline_name;
+    std::string pass_name;
+    int64_t runs = 0;
+    int64_t changed_runs = 0;
+    int64_t total_time_usec = 0;
+    int64_t max_peak_rss_increase_bytes = 0;
+    int64_t instruction_count_change = 0;
+  };
+  std::vector<PassProfile> profiles;
+  absl::flat_hash_map<std::pair<std::string, std::string>, int64_t> indices;
+  for (const HloModuleMetadataProto& module_metadata : metadata) {
+    for (const HloPassMetadata& pass : module_metadata.pass_metadata()) {
+      if (pass.pass_name() == "pipeline-start") {
+        continue;
+      }
+      auto [it, inserted] = indices.try_emplace(
+          std::make_pair(pass.pipeline_name(), pass.pass_name()),
+          profiles.size());
+      if (inserted) {
+        profiles.push_back({pass.pipeline_name(), pass.pass_name()});
+      }
+      PassProfile& profile = profiles[it->second];
+      const int64_t time_usec =
+          pass.end_timestamp_usec() - pass.start_timestamp_usec();
+      ++profile.runs;
+      profile.changed_runs += pass.module_changed() ? 1 : 0;
+      profile.total_time_usec += time_usec;
+      profile.max_peak_rss_increase_bytes = std::max(
+          profile.max_peak_rss_increase_bytes, pass.peak_rss_increase_bytes());
+      profile.instruction_count_change +=
+          pass.instruction_count_after() - pass.instruction_count_before();
+    }
+  }
+  absl::c_stable_sort(profiles, [](const PassProfile& a, const PassProfile& b) {
+    return a.total_time_usec > b.total_time_usec;
+  });
+
+  std::string table = absl::StrFormat(
+      "%-40s %-40s %6s %8s %12s %14s %12s\n", "pipeline", "pass", "runs",
+      "changed", "time (ms)", "peak RSS (MB)", "instructions");
+  for (const PassProfile& profile : profiles) {
+    absl::StrAppendFormat(
+        &table, "%-40s %-40s %6d %8d %12.3f %14.1f %+12d\n",
+        profile.pipeline_name, profile.pass_name, profile.runs,
+        profile.changed_runs, profile.total_time_usec / 1e3,
+        profile.max_peak_rss_increase_bytes / (1024.0 * 1024.0),
+        profile.instruction_count_change);
+  }
+  return table;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Registration of Hardware-independent HLO Passes                            //
 ////////////////////////////////////////////////////////////////////////////////
@@ -273,6 +332,8 @@ void OptProvider::RegisterAllHardwareIndependentPasses() {
   RegisterPass<DeconstructReduceWindowToReduceBroadcast>();
   RegisterPass<Defuser>();
   RegisterPass<Despecializer>();
+  RegisterPass<DotBatcher>(
+      /*max_size_to_batch=*/std::numeric_limits<int64_t>::max());
   RegisterPass<DotDecomposer>();
   RegisterPass<DotDimensionMerger>();
   RegisterPass<DotMerger>(
@@ -22,13 +22,16 @@ limitations under the License.
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/log/log.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "xla/hlo/ir/hlo_module.h"
 #include "xla/hlo/pass/hlo_pass_pipeline.h"
+#include "xla/service/hlo.pb.h"
 
 namespace xla {
 
@@ -67,7 +70,20 @@ class OptProvider {
   // Returns a string of all registered pass names.
   virtual std::string GetRegisteredPassNames();
 
+  // Returns the pass metadata of the modules that the provider ran passes on,
+  // in order.
+  const std::vector<HloModuleMetadataProto>& pass_metadata() const {
+    return pass_metadata_;
+  }
+
  protected:
+  // Records the pass metadata of `module` after passes ran on it.
+  void RecordPassMetadata(const HloModule& module) {
+    pass_metadata_.push_back(module.metadata().proto());
+  }
+
+  std::vector<HloModuleMetadataProto> pass_metadata_;
+
   // Map of pass names to pass registration functions. The pass registration
   // function takes a HloPassPipeline and adds the corresponding pass to it.
   absl::flat_hash_map<std::string, std::function<void(HloPassPipeline&)>>
@@ -96,6 +112,14 @@ class OptProvider {
           std::string, std::function<void(HloPassPipeline&)>>& pass_registry_);
 };
 
+// Aggregates the passes in `metadata` per pipeline and pass name, and formats
+// the number of runs, the total time, the largest peak RSS growth and the
+// change in instruction count of each as a table, sorted by decreasing time.
+// Nested pipelines are listed like passes, so their time includes the time of
+// their passes.
+std::string FormatPassProfile(
+    absl::Span<const HloModuleMetadataProto> metadata);
+
 }  // namespace xla
 
 #endif  // XLA_HLO_TOOLS_HLO_OPT_OPT_LIB_H_
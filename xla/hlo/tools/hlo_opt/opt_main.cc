@@ -16,6 +16,7 @@ limitations under the License.
 // A tool for reading a HloModule from a HloProto file and execute the module on
 // given platform(s). See kUsage for details.
 
+#include <cstdint>
 #include <cstdio>
 #include <iostream>
 #include <memory>
@@ -24,6 +25,7 @@ limitations under the License.
 #include <utility>
 #include <vector>
 
+#include "absl/algorithm/container.h"
 #include "absl/log/check.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
@@ -32,6 +34,8 @@ limitations under the License.
 #include "absl/strings/str_join.h"
 #include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
 #include "xla/debug_options_flags.h"
 #include "xla/hlo/ir/hlo_module.h"
 #include "xla/hlo/tools/hlo_opt/opt_lib.h"
@@ -58,6 +62,12 @@ You can also pass in debug option flags for the HloModule.
 Usage:
 
   bazel run opt -- --platform=[gpu|cpu|...] path/to/hlo_module
+
+To measure the compile time of each pass, or of a single pass over the same
+module:
+
+  bazel run opt -- --platform=gpu --profile-passes path/to/hlo_module
+  bazel run opt -- --passes=algsimp --repeat=20 path/to/hlo_module
 )";
 
 struct HloOptConfig {
@@ -73,6 +83,8 @@ struct HloOptConfig {
   std::string passes{""};
   bool list_passes{false};
   bool emit_proto{false};
+  bool profile_passes{false};
+  int32_t repeat{1};
 };
 
 }  // namespace
@@ -189,23 +201,47 @@ absl::StatusOr<std::string> TranslateToStage(int argc, char** argv,
   // Assumption: All input modules have same HloModuleConfig.
   provider->RegisterProviderPasses(*modules[0].get());
 
+  if (opts.repeat < 1) {
+    return absl::InvalidArgumentError("--repeat must be positive.");
+  }
+
   std::string out_combined;
 
   for (std::unique_ptr<HloModule>& m : modules) {
     std::optional<std::string> out;
-    if (!opts.passes.empty()) {
-      TF_ASSIGN_OR_RETURN(out, provider->BuildAndRunTransformPipeline(
-                                   std::move(m), opts.passes));
-    } else {
-      TF_ASSIGN_OR_RETURN(out,
-                          provider->GenerateStage(std::move(m), opts.stage));
+    std::vector<absl::Duration> run_times;
+    for (int32_t i = 0; i < opts.repeat; ++i) {
+      // Every repetition starts from the input module, so only the last one
+      // may consume it.
+      std::unique_ptr<HloModule> module =
+          i + 1 < opts.repeat ? m->Clone("") : std::move(m);
+      absl::Time start = absl::Now();
+      if (!opts.passes.empty()) {
+        TF_ASSIGN_OR_RETURN(out, provider->BuildAndRunTransformPipeline(
+                                     std::move(module), opts.passes));
+      } else {
+        TF_ASSIGN_OR_RETURN(
+            out, provider->GenerateStage(std::move(module), opts.stage));
+      }
+      run_times.push_back(absl::Now() - start);
+      if (!out.has_value()) {
+        return absl::UnimplementedError("Stage not supported");
+      }
     }
-    if (!out.has_value()) {
-      return absl::UnimplementedError("Stage not supported");
+    if (opts.repeat > 1) {
+      absl::c_sort(run_times);
+      std::cerr << "Ran " << opts.repeat
+                << " times: min=" << run_times.front()
+                << " median=" << run_times[run_times.size() / 2]
+                << " max=" << run_times.back() << "\n";
     }
     absl::StrAppend(&out_combined, *out, "\n");
   }
 
+  if (opts.profile_passes) {
+    std::cerr << FormatPassProfile(provider->pass_metadata());
+  }
+
   return out_combined;
 }
 
@@ -258,7 +294,13 @@ int main(int argc, char** argv) {
                 "Print all supported passes for a given platform and exit"),
       tsl::Flag("emit-proto", &opts.emit_proto,
                 "Emit HLO in `textproto` format, "
-                "no optimization passes are applied.")};
+                "no optimization passes are applied."),
+      tsl::Flag("profile-passes", &opts.profile_passes,
+                "Print the time, peak RSS growth and instruction count change "
+                "of every pass that ran to stderr"),
+      tsl::Flag("repeat", &opts.repeat,
+                "Run the passes or the stage this many times on the same "
+                "module and print the min, median and max times to stderr")};
 
   // Modifies global DebugOptions, populates flags with every flag available
   // from xla.proto.
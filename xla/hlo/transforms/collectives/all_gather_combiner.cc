@@ -260,9 +260,9 @@ absl::StatusOr<bool> AllGatherCombiner::RunWithKeyCombiner(
 
     TF_ASSIGN_OR_RETURN(
         bool computation_changed,
-        CombineInstructionsByKey<GroupKey>(computation, key_fn, combine_fn,
-                                           combine_threshold_in_bytes_,
-                                           combine_threshold_count_));
+        CombineInstructionsByKey<GroupKey>(
+            computation, key_fn, combine_fn,
+            CombineThresholdInBytes(*computation), combine_threshold_count_));
     changed |= computation_changed;
   }
 
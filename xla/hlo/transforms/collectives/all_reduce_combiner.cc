@@ -162,7 +162,7 @@ absl::StatusOr<bool> AllReduceCombiner::RunWithKeyCombiner(
         bool computation_changed,
         CombineInstructionsByKey<AllReduceCombiner::GroupKey>(
             computation, key_fn, &CombineAllReduces,
-            combine_threshold_in_bytes_, combine_threshold_count_));
+            CombineThresholdInBytes(*computation), combine_threshold_count_));
     changed |= computation_changed;
   }
 
@@ -25,6 +25,7 @@ limitations under the License.
 #include "absl/functional/function_ref.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_computation.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_module.h"
 #include "xla/hlo/pass/hlo_pass_interface.h"
@@ -67,6 +68,14 @@ class AllReduceCombiner : public HloModulePass {
           const HloInstruction*, const HloDomainMap&)>
           combine_key);
 
+  // Returns the byte threshold used when combining ops in `computation`.
+  // Subclasses may override this to pick thresholds per computation, e.g.
+  // based on the memory available in the part of the schedule it occupies.
+  virtual int64_t CombineThresholdInBytes(
+      const HloComputation& computation) const {
+    return combine_threshold_in_bytes_;
+  }
+
   // Combine all reduce ops up to this threshold.
   int64_t combine_threshold_in_bytes_;
 
@@ -0,0 +1,257 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/hlo/transforms/host_offload_streaming.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "absl/algorithm/container.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/service/hlo_creation_utils.h"
+#include "xla/service/memory_annotations.h"
+#include "xla/shape.h"
+#include "xla/shape_util.h"
+#include "xla/tsl/platform/errors.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/util.h"
+
+namespace xla {
+
+namespace {
+
+using memory_annotations::kMoveToDeviceCustomCallTarget;
+using memory_annotations::kMoveToHostCustomCallTarget;
+
+// An elementwise update whose result is moved to the host.
+struct StreamedUpdate {
+  // The elementwise instructions of the update in post order. The last one is
+  // the operand of the MoveToHost.
+  std::vector<HloInstruction*> instructions;
+  // The MoveToDevice custom calls read by the update.
+  absl::flat_hash_set<const HloInstruction*> moves_to_device;
+};
+
+bool IsStreamableElementwise(const HloInstruction* instr, const Shape& shape) {
+  return instr->IsElementwise() && instr->operand_count() > 0 &&
+         !instr->HasSideEffect() && instr->shape().IsArray() &&
+         instr->shape().dimensions() == shape.dimensions();
+}
+
+std::optional<StreamedUpdate> FindStreamedUpdate(
+    HloInstruction* move_to_host) {
+  const Shape& shape = move_to_host->shape();
+  HloInstruction* root = move_to_host->mutable_operand(0);
+  if (!IsStreamableElementwise(root, shape) || root->user_count() != 1) {
+    return std::nullopt;
+  }
+
+  StreamedUpdate update;
+  absl::flat_hash_set<const HloInstruction*> visited;
+  // Instructions paired with whether their operands have been visited.
+  std::vector<std::pair<HloInstruction*, bool>> stack = {{root, false}};
+  while (!stack.empty()) {
+    auto [instr, operands_visited] = stack.back();
+    stack.pop_back();
+    if (operands_visited) {
+      update.instructions.push_back(instr);
+      continue;
+    }
+    if (!visited.insert(instr).second) {
+      continue;
+    }
+    if (instr->IsCustomCall(kMoveToDeviceCustomCallTarget) &&
+        instr->shape().dimensions() == shape.dimensions()) {
+      update.moves_to_device.insert(instr);
+      continue;
+    }
+    if (!IsStreamableElementwise(instr, shape)) {
+      // Other operands are sliced, so they must have the dimensions of the
+      // update, or be scalars.
+      if (!instr->shape().IsArray() ||
+          (instr->shape().dimensions() != shape.dimensions() &&
+           !instr->shape().dimensions().empty())) {
+        return std::nullopt;
+      }
+      continue;
+    }
+    stack.push_back({instr, true});
+    for (HloInstruction* operand : instr->operands()) {
+      stack.push_back({operand, false});
+    }
+  }
+  if (update.moves_to_device.empty()) {
+    return std::nullopt;
+  }
+
+  // The full tensors must not be needed outside of the update, otherwise
+  // streaming it doesn't reduce the memory it needs on device.
+  absl::flat_hash_set<const HloInstruction*> interior(
+      update.instructions.begin(), update.instructions.end());
+  auto used_only_in_update = [&](const HloInstruction* instr) {
+    return absl::c_all_of(instr->users(), [&](const HloInstruction* user) {
+      return interior.contains(user);
+    });
+  };
+  for (const HloInstruction* instr : update.instructions) {
+    if (instr != root && !used_only_in_update(instr)) {
+      return std::nullopt;
+    }
+  }
+  if (!absl::c_all_of(update.moves_to_device, used_only_in_update)) {
+    return std::nullopt;
+  }
+  return update;
+}
+
+Shape ChunkShape(const Shape& shape, int64_t rows) {
+  Shape chunk_shape = shape;
+  chunk_shape.set_dimensions(0, rows);
+  return chunk_shape;
+}
+
+absl::StatusOr<HloInstruction*> SliceRows(HloInstruction* operand,
+                                          int64_t start, int64_t limit) {
+  std::vector<int64_t> start_indices(operand->shape().dimensions().size(), 0);
+  std::vector<int64_t> limit_indices(operand->shape().dimensions().begin(),
+                                     operand->shape().dimensions().end());
+  std::vector<int64_t> strides(start_indices.size(), 1);
+  start_indices[0] = start;
+  limit_indices[0] = limit;
+  return MakeSliceHlo(operand, start_indices, limit_indices, strides);
+}
+
+// Replaces `move_to_host` with a chain of dynamic-update-slices of the chunks
+// of `update`, each computed from the chunks of its operands and moved to the
+// host separately.
+absl::Status StreamUpdate(HloInstruction* move_to_host,
+                          const StreamedUpdate& update,
+                          int64_t rows_per_chunk) {
+  HloComputation* computation = move_to_host->parent();
+  const Shape& shape = move_to_host->shape();
+  const int64_t rows = shape.dimensions(0);
+  HloInstruction* buffer = MakeScalarLike(move_to_host, 0);
+  HloInstruction* zero_index = MakeR0ConstantHlo<int32_t>(computation, 0);
+  for (int64_t start = 0; start < rows; start += rows_per_chunk) {
+    const int64_t limit = std::min(rows, start + rows_per_chunk);
+    absl::flat_hash_map<const HloInstruction*, HloInstruction*> chunks;
+    auto get_chunk =
+        [&](HloInstruction* operand) -> absl::StatusOr<HloInstruction*> {
+      if (auto it = chunks.find(operand); it != chunks.end()) {
+        return it->second;
+      }
+      HloInstruction* chunk = operand;
+      if (operand->shape().dimensions().empty()) {
+        // Scalar operands, e.g. of clamp, are shared by all the chunks.
+      } else if (update.moves_to_device.contains(operand)) {
+        TF_ASSIGN_OR_RETURN(
+            HloInstruction * slice,
+            SliceRows(operand->mutable_operand(0), start, limit));
+        chunk = computation->AddInstruction(operand->CloneWithNewOperands(
+            ChunkShape(operand->shape(), limit - start), {slice}));
+      } else if (operand->opcode() == HloOpcode::kBroadcast &&
+                 operand->operand(0)->shape().dimensions().empty()) {
+        chunk = MakeBroadcastHlo(operand->mutable_operand(0), {},
+                                 ChunkShape(operand->shape(), limit - start));
+      } else {
+        TF_ASSIGN_OR_RETURN(chunk, SliceRows(operand, start, limit));
+      }
+      chunks[operand] = chunk;
+      return chunk;
+    };
+    for (HloInstruction* instr : update.instructions) {
+      std::vector<HloInstruction*> new_operands;
+      new_operands.reserve(instr->operand_count());
+      for (HloInstruction* operand : instr->operands()) {
+        TF_ASSIGN_OR_RETURN(HloInstruction * chunk, get_chunk(operand));
+        new_operands.push_back(chunk);
+      }
+      chunks[instr] = computation->AddInstruction(instr->CloneWithNewOperands(
+          ChunkShape(instr->shape(), limit - start), new_operands));
+    }
+    HloInstruction* chunk_to_host =
+        computation->AddInstruction(move_to_host->CloneWithNewOperands(
+            ChunkShape(shape, limit - start),
+            {chunks.at(update.instructions.back())}));
+    std::vector<HloInstruction*> start_indices(shape.dimensions().size(),
+                                               zero_index);
+    start_indices[0] = MakeR0ConstantHlo<int32_t>(computation, start);
+    TF_ASSIGN_OR_RETURN(buffer, MakeDynamicUpdateSliceHlo(
+                                    buffer, chunk_to_host, start_indices));
+  }
+  return computation->ReplaceInstruction(move_to_host, buffer);
+}
+
+}  // namespace
+
+absl::StatusOr<bool> HostOffloadStreaming::RunOnComputation(
+    HloComputation* computation) {
+  std::vector<HloInstruction*> moves_to_host;
+  for (HloInstruction* instr : computation->MakeInstructionPostOrder()) {
+    if (instr->IsCustomCall(kMoveToHostCustomCallTarget) &&
+        instr->operand_count() == 1 && instr->shape().IsArray() &&
+        instr->shape().is_static() && !instr->shape().dimensions().empty()) {
+      moves_to_host.push_back(instr);
+    }
+  }
+
+  bool changed = false;
+  for (HloInstruction* move_to_host : moves_to_host) {
+    const Shape& shape = move_to_host->shape();
+    const int64_t rows = shape.dimensions(0);
+    const int64_t size_bytes = ShapeUtil::ByteSizeOfElements(shape);
+    if (rows < 2 || size_bytes <= chunk_size_bytes_) {
+      continue;
+    }
+    std::optional<StreamedUpdate> update = FindStreamedUpdate(move_to_host);
+    if (!update.has_value()) {
+      continue;
+    }
+    const int64_t rows_per_chunk =
+        std::max<int64_t>(1, chunk_size_bytes_ / (size_bytes / rows));
+    VLOG(2) << "Streaming the update of " << move_to_host->name() << " in "
+            << CeilOfRatio(rows, rows_per_chunk) << " chunks";
+    TF_RETURN_IF_ERROR(StreamUpdate(move_to_host, *update, rows_per_chunk));
+    changed = true;
+  }
+  return changed;
+}
+
+absl::StatusOr<bool> HostOffloadStreaming::Run(
+    HloModule* module,
+    const absl::flat_hash_set<absl::string_view>& execution_threads) {
+  bool changed = false;
+  for (HloComputation* computation :
+       module->MakeNonfusionComputations(execution_threads)) {
+    TF_ASSIGN_OR_RETURN(bool computation_changed,
+                        RunOnComputation(computation));
+    changed |= computation_changed;
+  }
+  return changed;
+}
+
+}  // namespace xla
@@ -0,0 +1,83 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_HLO_TRANSFORMS_HOST_OFFLOAD_STREAMING_H_
+#define XLA_HLO_TRANSFORMS_HOST_OFFLOAD_STREAMING_H_
+
+#include <cstdint>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/pass/hlo_pass_interface.h"
+
+namespace xla {
+
+// Streams elementwise updates of host-resident tensors, such as optimizer
+// state, through the device in chunks.
+//
+// An update annotated to run on the device and to be written back to the host
+//
+//   d = f32[N,K] custom-call(host_state), custom_call_target="MoveToDevice"
+//   new_state = f32[N,K] add(d, grad)
+//   h = f32[N,K] custom-call(new_state), custom_call_target="MoveToHost"
+//
+// needs the whole tensor in device memory at once, and the update can't start
+// before the whole tensor has been transferred. This pass splits the rows of
+// the update into chunks of at most `chunk_size_bytes`:
+//
+//   d_i = custom-call(slice(host_state)), custom_call_target="MoveToDevice"
+//   h_i = custom-call(add(d_i, slice(grad))), custom_call_target="MoveToHost"
+//   buffer_i = dynamic-update-slice(buffer_{i-1}, h_i, row_i, 0)
+//
+// where buffer_0 is a broadcast of zero. HostOffloader turns the slices into
+// device-to-host transfers of each chunk and the dynamic-update-slices into
+// writes to a host buffer. The chunks are independent, so once
+// HostMemoryTransferAsyncifier has made the transfers asynchronous, the
+// scheduler can overlap the transfers of a chunk with the update of another,
+// and only a few chunks are live in device memory at a time.
+//
+// The update is the set of elementwise instructions of the same dimensions
+// that the MoveToHost operand is computed from. It must read at least one
+// MoveToDevice, and all of its uses, including the MoveToDevice ones, must stay
+// inside the update. All the other operands of the update are sliced.
+//
+// This pass runs before layout assignment.
+class HostOffloadStreaming : public HloModulePass {
+ public:
+  static constexpr int64_t kDefaultChunkSizeBytes = 64 * 1024 * 1024;
+
+  explicit HostOffloadStreaming(
+      int64_t chunk_size_bytes = kDefaultChunkSizeBytes)
+      : chunk_size_bytes_(chunk_size_bytes) {}
+
+  absl::string_view name() const override { return "host-offload-streaming"; }
+
+  using HloPassInterface::Run;
+  absl::StatusOr<bool> Run(
+      HloModule* module,
+      const absl::flat_hash_set<absl::string_view>& execution_threads) override;
+
+ private:
+  absl::StatusOr<bool> RunOnComputation(HloComputation* computation);
+
+  const int64_t chunk_size_bytes_;
+};
+
+}  // namespace xla
+
+#endif  // XLA_HLO_TRANSFORMS_HOST_OFFLOAD_STREAMING_H_
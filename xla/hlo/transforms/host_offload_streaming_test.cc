@@ -0,0 +1,145 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/hlo/transforms/host_offload_streaming.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/testlib/hlo_hardware_independent_test_base.h"
+#include "xla/hlo/testlib/pattern_matcher_gmock.h"
+#include "xla/service/memory_annotations.h"
+#include "xla/service/pattern_matcher.h"
+#include "xla/tsl/platform/statusor.h"
+
+namespace xla {
+namespace {
+
+namespace m = ::xla::match;
+
+using HostOffloadStreamingTest = HloHardwareIndependentTestBase;
+
+// Returns the number of rows of each chunk moved to the host, in order.
+std::vector<int64_t> ChunkRows(const HloModule& module) {
+  std::vector<int64_t> rows;
+  for (const HloInstruction* instr :
+       module.entry_computation()->MakeInstructionPostOrder()) {
+    if (instr->IsCustomCall(memory_annotations::kMoveToHostCustomCallTarget)) {
+      rows.push_back(instr->shape().dimensions(0));
+    }
+  }
+  return rows;
+}
+
+TEST_F(HostOffloadStreamingTest, StreamsUpdateInChunks) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(R"(
+HloModule StreamsUpdateInChunks
+
+ENTRY entry {
+  state = f32[8,256] parameter(0)
+  grad = f32[8,256] parameter(1)
+  to_device = f32[8,256] custom-call(state), custom_call_target="MoveToDevice"
+  c = f32[] constant(0.9)
+  decay = f32[8,256] broadcast(c), dimensions={}
+  scaled = f32[8,256] multiply(to_device, decay)
+  new_state = f32[8,256] add(scaled, grad)
+  ROOT to_host = f32[8,256] custom-call(new_state), custom_call_target="MoveToHost"
+})"));
+
+  // Each row is 1KiB.
+  HostOffloadStreaming pass(/*chunk_size_bytes=*/2048);
+  EXPECT_TRUE(pass.Run(module.get()).value());
+
+  EXPECT_THAT(ChunkRows(*module), ::testing::ElementsAre(2, 2, 2, 2));
+  const HloInstruction* slice = nullptr;
+  EXPECT_THAT(
+      module->entry_computation()->root_instruction(),
+      GmockMatch(m::DynamicUpdateSlice(
+          m::DynamicUpdateSlice(),
+          m::CustomCall(
+              {"MoveToHost"},
+              m::Add(m::Multiply(m::CustomCall({"MoveToDevice"},
+                                               m::Slice(&slice,
+                                                        m::Parameter(0))),
+                                 m::Broadcast(m::Constant())),
+                     m::Slice(m::Parameter(1)))),
+          m::ConstantScalar(6), m::ConstantScalar(0))));
+  ASSERT_NE(slice, nullptr);
+  EXPECT_EQ(slice->slice_starts(0), 6);
+}
+
+TEST_F(HostOffloadStreamingTest, StreamsUnevenChunks) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(R"(
+HloModule StreamsUnevenChunks
+
+ENTRY entry {
+  state = f32[5,256] parameter(0)
+  grad = f32[5,256] parameter(1)
+  to_device = f32[5,256] custom-call(state), custom_call_target="MoveToDevice"
+  new_state = f32[5,256] subtract(to_device, grad)
+  ROOT to_host = f32[5,256] custom-call(new_state), custom_call_target="MoveToHost"
+})"));
+
+  HostOffloadStreaming pass(/*chunk_size_bytes=*/2048);
+  EXPECT_TRUE(pass.Run(module.get()).value());
+
+  EXPECT_THAT(ChunkRows(*module), ::testing::ElementsAre(2, 2, 1));
+}
+
+TEST_F(HostOffloadStreamingTest, DoesNotStreamSmallUpdates) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(R"(
+HloModule DoesNotStreamSmallUpdates
+
+ENTRY entry {
+  state = f32[8,256] parameter(0)
+  grad = f32[8,256] parameter(1)
+  to_device = f32[8,256] custom-call(state), custom_call_target="MoveToDevice"
+  new_state = f32[8,256] add(to_device, grad)
+  ROOT to_host = f32[8,256] custom-call(new_state), custom_call_target="MoveToHost"
+})"));
+
+  HostOffloadStreaming pass(/*chunk_size_bytes=*/8192);
+  EXPECT_FALSE(pass.Run(module.get()).value());
+}
+
+TEST_F(HostOffloadStreamingTest, DoesNotStreamUpdateUsedOnDevice) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(R"(
+HloModule DoesNotStreamUpdateUsedOnDevice
+
+ENTRY entry {
+  state = f32[8,256] parameter(0)
+  grad = f32[8,256] parameter(1)
+  to_device = f32[8,256] custom-call(state), custom_call_target="MoveToDevice"
+  scaled = f32[8,256] multiply(to_device, grad)
+  new_state = f32[8,256] add(scaled, grad)
+  to_host = f32[8,256] custom-call(new_state), custom_call_target="MoveToHost"
+  ROOT tuple = (f32[8,256], f32[8,256]) tuple(to_host, scaled)
+})"));
+
+  HostOffloadStreaming pass(/*chunk_size_bytes=*/2048);
+  EXPECT_FALSE(pass.Run(module.get()).value());
+}
+
+}  // namespace
+}  // namespace xla
@@ -0,0 +1,109 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/hlo/transforms/host_parameter_prefetch.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/log/log.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/layout.h"
+#include "xla/service/computation_layout.h"
+#include "xla/service/host_offload_utils.h"
+#include "xla/service/memory_annotations.h"
+#include "xla/shape.h"
+#include "xla/tsl/platform/errors.h"
+#include "xla/tsl/platform/statusor.h"
+
+namespace xla {
+
+namespace {
+
+bool IsDeviceUse(const HloInstruction* user) {
+  return !host_offload_utils::IsValidDuringPureMemoryOffload(user) &&
+         !host_offload_utils::ComputeTypeIsHost(user);
+}
+
+HloInstruction* AddMoveToDevice(HloInstruction* operand) {
+  Shape shape = operand->shape();
+  if (shape.has_layout()) {
+    shape.mutable_layout()->set_memory_space(Layout::kDefaultMemorySpace);
+  }
+  return operand->AddInstruction(HloInstruction::CreateCustomCall(
+      shape, {operand}, memory_annotations::kMoveToDeviceCustomCallTarget));
+}
+
+// Gives each device use of `instr`, which lives in host memory, its own
+// MoveToDevice. If `annotate_slices` is true, the device uses of slices of
+// `instr` are annotated instead of the slices. Returns whether any use was
+// annotated.
+absl::StatusOr<bool> AnnotateDeviceUses(HloInstruction* instr,
+                                        bool annotate_slices) {
+  bool changed = false;
+  // Copy the users, since annotating a use changes them.
+  const std::vector<HloInstruction*> users = instr->users();
+  for (HloInstruction* user : users) {
+    if (!IsDeviceUse(user)) {
+      continue;
+    }
+    if (annotate_slices &&
+        (user->opcode() == HloOpcode::kSlice ||
+         user->opcode() == HloOpcode::kDynamicSlice) &&
+        user->operand(0) == instr) {
+      TF_ASSIGN_OR_RETURN(bool slice_changed,
+                          AnnotateDeviceUses(user, /*annotate_slices=*/false));
+      changed |= slice_changed;
+      continue;
+    }
+    HloInstruction* move_to_device = AddMoveToDevice(instr);
+    VLOG(2) << "Prefetching " << instr->name() << " for " << user->name()
+            << " with " << move_to_device->name();
+    TF_RETURN_IF_ERROR(instr->ReplaceUseWith(user, move_to_device));
+    changed = true;
+  }
+  return changed;
+}
+
+}  // namespace
+
+absl::StatusOr<bool> HostParameterPrefetch::Run(
+    HloModule* module,
+    const absl::flat_hash_set<absl::string_view>& execution_threads) {
+  const ComputationLayout& entry_layout = module->entry_computation_layout();
+  HloComputation* entry = module->entry_computation();
+  bool changed = false;
+  for (int64_t i = 0; i < entry->num_parameters(); ++i) {
+    const Shape& shape = entry_layout.parameter_shape(i);
+    if (!shape.IsArray() || !shape.has_layout() ||
+        shape.layout().memory_space() != Layout::kHostMemorySpace) {
+      continue;
+    }
+    TF_ASSIGN_OR_RETURN(
+        bool parameter_changed,
+        AnnotateDeviceUses(entry->parameter_instruction(i),
+                           /*annotate_slices=*/true));
+    changed |= parameter_changed;
+  }
+  return changed;
+}
+
+}  // namespace xla
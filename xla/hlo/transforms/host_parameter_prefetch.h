@@ -0,0 +1,68 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_HLO_TRANSFORMS_HOST_PARAMETER_PREFETCH_H_
+#define XLA_HLO_TRANSFORMS_HOST_PARAMETER_PREFETCH_H_
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/pass/hlo_pass_interface.h"
+
+namespace xla {
+
+// Moves entry parameters that live in host memory to the device right before
+// each of their uses, instead of computing on them in host memory.
+//
+// An entry parameter with the host memory space in the entry computation layout
+// that is used by device compute without a MoveToDevice annotation is turned
+// into host compute by HostOffloader. This pass annotates each such use with
+// its own MoveToDevice instead:
+//
+//   p = f32[N,K]{1,0:S(5)} parameter(0)
+//   a = f32[N,K] add(p, x)
+//   b = f32[N,K] multiply(p, y)
+//
+// becomes
+//
+//   p0 = f32[N,K] custom-call(p), custom_call_target="MoveToDevice"
+//   a = f32[N,K] add(p0, x)
+//   p1 = f32[N,K] custom-call(p), custom_call_target="MoveToDevice"
+//   b = f32[N,K] multiply(p1, y)
+//
+// A (dynamic-)slice of the parameter is annotated after the slice, so that only
+// the slice is transferred. HostOffloader then turns each annotation into a
+// copy from the host, which HostMemoryTransferAsyncifier makes asynchronous.
+// The scheduler starts these copies shortly ahead of their uses, so the
+// weights of a layer stream in while the previous layer runs, rather than
+// all of them being copied before execution.
+//
+// Uses that are valid on host memory, such as tuples, calls and custom calls,
+// and uses that are already annotated for host compute are left alone. Only
+// array parameters are handled.
+class HostParameterPrefetch : public HloModulePass {
+ public:
+  absl::string_view name() const override { return "host-parameter-prefetch"; }
+
+  using HloPassInterface::Run;
+  absl::StatusOr<bool> Run(
+      HloModule* module,
+      const absl::flat_hash_set<absl::string_view>& execution_threads) override;
+};
+
+}  // namespace xla
+
+#endif  // XLA_HLO_TRANSFORMS_HOST_PARAMETER_PREFETCH_H_
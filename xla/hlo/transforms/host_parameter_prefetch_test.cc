@@ -0,0 +1,102 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/hlo/transforms/host_parameter_prefetch.h"
+
+#include <memory>
+
+#include <gtest/gtest.h>
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/testlib/hlo_hardware_independent_test_base.h"
+#include "xla/hlo/testlib/pattern_matcher_gmock.h"
+#include "xla/service/pattern_matcher.h"
+#include "xla/tsl/platform/statusor.h"
+
+namespace xla {
+namespace {
+
+namespace m = ::xla::match;
+
+using HostParameterPrefetchTest = HloHardwareIndependentTestBase;
+
+TEST_F(HostParameterPrefetchTest, MovesEachUseToDevice) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(R"(
+HloModule MovesEachUseToDevice, entry_computation_layout={(f32[16,16]{1,0:S(5)}, f32[16,16]{1,0})->f32[16,16]{1,0}}
+
+ENTRY entry {
+  weights = f32[16,16] parameter(0)
+  x = f32[16,16] parameter(1)
+  layer0 = f32[16,16] dot(x, weights), lhs_contracting_dims={1}, rhs_contracting_dims={0}
+  ROOT layer1 = f32[16,16] dot(layer0, weights), lhs_contracting_dims={1}, rhs_contracting_dims={0}
+})"));
+
+  EXPECT_TRUE(HostParameterPrefetch().Run(module.get()).value());
+
+  const HloInstruction* prefetch0 = nullptr;
+  const HloInstruction* prefetch1 = nullptr;
+  ASSERT_THAT(module->entry_computation()->root_instruction(),
+              GmockMatch(m::Dot(
+                  m::Dot(m::Parameter(1),
+                         m::CustomCall(&prefetch0, {"MoveToDevice"},
+                                       m::Parameter(0))),
+                  m::CustomCall(&prefetch1, {"MoveToDevice"},
+                                m::Parameter(0)))));
+  EXPECT_NE(prefetch0, prefetch1);
+}
+
+TEST_F(HostParameterPrefetchTest, MovesSliceToDevice) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(R"(
+HloModule MovesSliceToDevice, entry_computation_layout={(f32[4,16]{1,0:S(5)}, f32[1,16]{1,0}, s32[])->f32[1,16]{1,0}}
+
+ENTRY entry {
+  weights = f32[4,16] parameter(0)
+  x = f32[1,16] parameter(1)
+  layer = s32[] parameter(2)
+  zero = s32[] constant(0)
+  slice = f32[1,16] dynamic-slice(weights, layer, zero), dynamic_slice_sizes={1,16}
+  ROOT add = f32[1,16] add(x, slice)
+})"));
+
+  EXPECT_TRUE(HostParameterPrefetch().Run(module.get()).value());
+
+  EXPECT_THAT(module->entry_computation()->root_instruction(),
+              GmockMatch(m::Add(m::Parameter(1),
+                                m::CustomCall({"MoveToDevice"},
+                                              m::DynamicSlice(m::Parameter(0),
+                                                              m::Parameter(2),
+                                                              m::Constant())))));
+}
+
+TEST_F(HostParameterPrefetchTest, IgnoresAnnotatedAndDeviceParameters) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(R"(
+HloModule IgnoresAnnotatedAndDeviceParameters, entry_computation_layout={(f32[16]{0:S(5)}, f32[16]{0})->f32[16]{0}}
+
+ENTRY entry {
+  weights = f32[16] parameter(0)
+  x = f32[16] parameter(1)
+  to_device = f32[16] custom-call(weights), custom_call_target="MoveToDevice"
+  add = f32[16] add(x, to_device)
+  ROOT multiply = f32[16] multiply(add, x)
+})"));
+
+  EXPECT_FALSE(HostParameterPrefetch().Run(module.get()).value());
+}
+
+}  // namespace
+}  // namespace xla
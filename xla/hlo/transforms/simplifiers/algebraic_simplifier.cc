@@ -41,6 +41,8 @@ limitations under the License.
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
 #include "absl/types/span.h"
 #include "xla/comparison_util.h"
 #include "xla/hlo/evaluator/hlo_evaluator.h"
@@ -570,6 +572,45 @@ bool AlgebraicSimplifierVisitor::IsNonNegative(
   }
 }
 
+AlgebraicSimplifierVisitor::~AlgebraicSimplifierVisitor() {
+  if (handler_stats_.empty()) {
+    return;
+  }
+  std::vector<std::pair<HloOpcode, HandlerStats>> stats(handler_stats_.begin(),
+                                                        handler_stats_.end());
+  absl::c_sort(stats, [](const auto& a, const auto& b) {
+    return a.second.time > b.second.time;
+  });
+  for (const auto& [opcode, opcode_stats] : stats) {
+    VLOG(1) << "Simplified " << opcode_stats.simplified << " of "
+            << opcode_stats.visited << " " << HloOpcodeString(opcode)
+            << " instructions in " << absl::FormatDuration(opcode_stats.time);
+  }
+}
+
+absl::Status AlgebraicSimplifierVisitor::Preprocess(HloInstruction* hlo) {
+  if (VLOG_IS_ON(1)) {
+    changed_before_handler_ = changed();
+    handler_start_ = absl::Now();
+  }
+  return DfsHloRewriteVisitor::Preprocess(hlo);
+}
+
+absl::Status AlgebraicSimplifierVisitor::Postprocess(HloInstruction* hlo) {
+  if (VLOG_IS_ON(1)) {
+    HandlerStats& stats = handler_stats_[hlo->opcode()];
+    ++stats.visited;
+    // Most simplifications replace the instruction. The others are only
+    // counted if they are the first change of the visitor, as changed() stays
+    // set.
+    if (hlo->IsMarkedAsDead() || (!changed_before_handler_ && changed())) {
+      ++stats.simplified;
+    }
+    stats.time += absl::Now() - handler_start_;
+  }
+  return DfsHloRewriteVisitor::Postprocess(hlo);
+}
+
 void AlgebraicSimplifierVisitor::ResetState(HloComputation* computation) {
   ResetVisitStates();
   computation_ = computation;
@@ -9865,4 +9906,47 @@ absl::StatusOr<bool> AlgebraicSimplifier::Run(
   return changed;
 }
 
+absl::Status AlgebraicSimplifier::RunOnChangedComputations(
+    HloModule* module, RunState* run_state,
+    const absl::flat_hash_set<absl::string_view>& execution_threads) {
+  AlgebraicSimplifierVisitor visitor(options_, this);
+  return RunVisitorOnChangedComputations(visitor, module, run_state,
+                                         execution_threads);
+}
+
+absl::Status AlgebraicSimplifier::RunVisitorOnChangedComputations(
+    AlgebraicSimplifierVisitor& visitor, HloModule* module,
+    RunState* run_state,
+    const absl::flat_hash_set<absl::string_view>& execution_threads) {
+  // Some simplifications look at the computations an instruction calls, e.g.
+  // the reducer of a reduce, so the callers of a changed computation are
+  // revisited too. Computations from the last iteration may have been removed
+  // since, so they are only compared, never dereferenced.
+  auto needs_visit = [&](HloComputation* computation) {
+    if (run_state->changed_last_iteration.contains(computation)) {
+      return true;
+    }
+    for (const auto& [callee, count] : computation->callee_computations()) {
+      if (run_state->changed_last_iteration.contains(callee)) {
+        return true;
+      }
+    }
+    return false;
+  };
+  for (HloComputation* computation :
+       module->MakeNonfusionComputations(execution_threads)) {
+    if (!needs_visit(computation) ||
+        !visitor.Run(computation, options_, this)) {
+      continue;
+    }
+    // Simplifying a computation may edit or create the computations it calls,
+    // which the next iteration must then visit.
+    run_state->changed_this_iteration.insert(computation);
+    for (const auto& [callee, count] : computation->callee_computations()) {
+      run_state->changed_this_iteration.insert(callee);
+    }
+  }
+  return absl::OkStatus();
+}
+
 }  // namespace xla
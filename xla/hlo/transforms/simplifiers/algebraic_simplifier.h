@@ -30,6 +30,7 @@ limitations under the License.
 #include "absl/log/log.h"
 #include "absl/status/status.h"
 #include "absl/strings/string_view.h"
+#include "absl/time/time.h"
 #include "absl/types/span.h"
 #include "xla/hlo/ir/dfs_hlo_visitor_with_default.h"
 #include "xla/hlo/ir/hlo_instruction.h"
@@ -405,6 +406,8 @@ class AlgebraicSimplifierOptions {
   Metadata metadata_;
 };
 
+class AlgebraicSimplifierVisitor;
+
 // A pass which performs algebraic simplifications.
 class AlgebraicSimplifier : public HloModulePass {
  public:
@@ -422,6 +425,13 @@ class AlgebraicSimplifier : public HloModulePass {
       HloModule* module,
       const absl::flat_hash_set<absl::string_view>& execution_threads) override;
 
+  // Only revisits the computations that changed in the last iteration, and
+  // their callers, so that HloPassFix<AlgebraicSimplifier> does not simplify
+  // the whole module again on every iteration.
+  absl::Status RunOnChangedComputations(
+      HloModule* module, RunState* run_state,
+      const absl::flat_hash_set<absl::string_view>& execution_threads) override;
+
   // Create constant from literal with tiles and element size updated in the
   // constant's layout.
   std::unique_ptr<HloInstruction> CreateConstantWithLayoutUpdated(
@@ -432,6 +442,13 @@ class AlgebraicSimplifier : public HloModulePass {
   }
 
  protected:
+  // Implements RunOnChangedComputations with the given visitor, for
+  // subclasses that simplify with their own visitor.
+  absl::Status RunVisitorOnChangedComputations(
+      AlgebraicSimplifierVisitor& visitor, HloModule* module,
+      RunState* run_state,
+      const absl::flat_hash_set<absl::string_view>& execution_threads);
+
   AlgebraicSimplifierOptions options_;
 };
 
@@ -445,6 +462,15 @@ class AlgebraicSimplifierVisitor : public DfsHloRewriteVisitor {
                                       AlgebraicSimplifier* simplifier)
       : options_(options), simplifier_(simplifier) {}
 
+  // Logs the handler statistics if VLOG(1) is on, see Preprocess.
+  ~AlgebraicSimplifierVisitor() override;
+
+  // With VLOG(1) on, they count per opcode the instructions visited and
+  // simplified, and the time spent in their handlers, to find the costly
+  // simplifications that rarely fire.
+  absl::Status Preprocess(HloInstruction* hlo) override;
+  absl::Status Postprocess(HloInstruction* hlo) override;
+
   absl::Status HandleAbs(HloInstruction* abs) override;
 
   absl::Status HandleAdd(HloInstruction* add) override;
@@ -827,6 +853,15 @@ class AlgebraicSimplifierVisitor : public DfsHloRewriteVisitor {
   absl::flat_hash_map<PrimitiveType, HloComputation*> scalar_add_computations_;
 
   AlgebraicSimplifier* simplifier_ = nullptr;
+
+  struct HandlerStats {
+    int64_t visited = 0;
+    int64_t simplified = 0;
+    absl::Duration time;
+  };
+  absl::flat_hash_map<HloOpcode, HandlerStats> handler_stats_;
+  absl::Time handler_start_;
+  bool changed_before_handler_ = false;
 };
 
 }  // namespace xla
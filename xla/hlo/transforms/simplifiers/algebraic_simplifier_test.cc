@@ -13011,5 +13011,54 @@ TEST_F(AlgebraicSimplifierTest, CopyReshapeToReshapeCopyWithHostCopies) {
   EXPECT_FALSE(simplifier.Run(m.get()).value());
 }
 
+TEST_F(AlgebraicSimplifierTest, RunOnChangedComputationsRevisitsCallers) {
+  const char* hlo = R"(
+  HloModule module
+
+  callee {
+    p = f32[4] parameter(0)
+    n = f32[4] negate(p)
+    ROOT nn = f32[4] negate(n)
+  }
+
+  other {
+    p = f32[4] parameter(0)
+    n = f32[4] negate(p)
+    ROOT nn = f32[4] negate(n)
+  }
+
+  ENTRY main {
+    p0 = f32[4] parameter(0)
+    zero = f32[] constant(0)
+    b = f32[4] broadcast(zero), dimensions={}
+    add = f32[4] add(p0, b)
+    c = f32[4] call(add), to_apply=callee
+    ROOT o = f32[4] call(c), to_apply=other
+  })";
+  TF_ASSERT_OK_AND_ASSIGN(auto m, ParseAndReturnVerifiedModule(hlo));
+  HloComputation* callee = FindComputation(m.get(), "callee");
+  HloComputation* other = FindComputation(m.get(), "other");
+
+  // The entry computation calls a computation that changed, so it is visited,
+  // but the unrelated computation is not.
+  AlgebraicSimplifier simplifier(default_options_);
+  AlgebraicSimplifier::RunState run_state;
+  run_state.changed_last_iteration.insert(callee);
+  TF_ASSERT_OK(simplifier.RunOnChangedComputations(m.get(), &run_state, {}));
+  EXPECT_THAT(callee->root_instruction(), GmockMatch(m::Parameter(0)));
+  EXPECT_THAT(other->root_instruction(), GmockMatch(m::Negate()));
+  EXPECT_THAT(m->entry_computation()->root_instruction(),
+              GmockMatch(m::Call(m::Call(m::Parameter(0)))));
+  EXPECT_TRUE(run_state.changed_this_iteration.contains(callee));
+  EXPECT_TRUE(
+      run_state.changed_this_iteration.contains(m->entry_computation()));
+  EXPECT_FALSE(run_state.changed_this_iteration.contains(other));
+
+  // Running to a fix point from scratch still visits every computation.
+  EXPECT_THAT(HloPassFix<AlgebraicSimplifier>(default_options_).Run(m.get()),
+              IsOkAndHolds(true));
+  EXPECT_THAT(other->root_instruction(), GmockMatch(m::Parameter(0)));
+}
+
 }  // namespace
 }  // namespace xla
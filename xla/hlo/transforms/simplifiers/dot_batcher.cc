@@ -0,0 +1,270 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/hlo/transforms/simplifiers/dot_batcher.h"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "absl/algorithm/container.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/log/check.h"
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_instructions.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/service/graphcycles/graphcycles.h"
+#include "xla/shape.h"
+#include "xla/shape_util.h"
+#include "xla/util.h"
+#include "xla/xla_data.pb.h"
+#include "tsl/platform/errors.h"
+#include "tsl/platform/statusor.h"
+
+namespace xla {
+namespace {
+
+// Returns a key that is equal for dots that can be batched together: dots with
+// the same operand and result shapes, dimension numbers and precisions.
+std::string BatchKey(const HloInstruction* dot) {
+  std::string key = absl::StrCat(
+      dot->operand(0)->shape().ToString(/*print_layout=*/true), ";",
+      dot->operand(1)->shape().ToString(/*print_layout=*/true), ";",
+      dot->shape().ToString(/*print_layout=*/true), ";",
+      DotDimensionNumbersToString(dot->dot_dimension_numbers()));
+  for (int precision : dot->precision_config().operand_precision()) {
+    absl::StrAppend(&key, ";", precision);
+  }
+  absl::StrAppend(&key, ";",
+                  static_cast<int>(dot->precision_config().algorithm()));
+  return key;
+}
+
+// Replaces `dots`, which have the same BatchKey, by slices of a single dot with
+// an extra major batch dimension.
+absl::Status BatchDots(HloComputation* comp,
+                       absl::Span<HloInstruction* const> dots) {
+  VLOG(2) << "Batching " << dots.size() << " dots like "
+          << dots.front()->ToString();
+  const int64_t batch_size = dots.size();
+  const HloInstruction* first = dots.front();
+
+  // Stacks operand `operand_index` of the dots along a new major dimension.
+  auto stack_operands = [&](int64_t operand_index) {
+    const Shape& shape = first->operand(operand_index)->shape();
+    Shape reshaped_shape = ShapeUtil::PrependMajorDimension(1, shape);
+    std::vector<HloInstruction*> reshaped;
+    reshaped.reserve(batch_size);
+    for (HloInstruction* dot : dots) {
+      reshaped.push_back(comp->AddInstruction(HloInstruction::CreateReshape(
+          reshaped_shape, dot->mutable_operand(operand_index))));
+    }
+    return comp->AddInstruction(HloInstruction::CreateConcatenate(
+        ShapeUtil::PrependMajorDimension(batch_size, shape), reshaped,
+        /*dimension=*/0));
+  };
+  HloInstruction* lhs = stack_operands(0);
+  HloInstruction* rhs = stack_operands(1);
+
+  // The existing dimensions all move up by one.
+  const DotDimensionNumbers& dnums = first->dot_dimension_numbers();
+  DotDimensionNumbers batched_dnums;
+  batched_dnums.add_lhs_batch_dimensions(0);
+  batched_dnums.add_rhs_batch_dimensions(0);
+  for (int64_t dim : dnums.lhs_batch_dimensions()) {
+    batched_dnums.add_lhs_batch_dimensions(dim + 1);
+  }
+  for (int64_t dim : dnums.rhs_batch_dimensions()) {
+    batched_dnums.add_rhs_batch_dimensions(dim + 1);
+  }
+  for (int64_t dim : dnums.lhs_contracting_dimensions()) {
+    batched_dnums.add_lhs_contracting_dimensions(dim + 1);
+  }
+  for (int64_t dim : dnums.rhs_contracting_dimensions()) {
+    batched_dnums.add_rhs_contracting_dimensions(dim + 1);
+  }
+
+  // Batch dimensions come first in the result of a dot, so the new batch
+  // dimension is the major dimension of the result.
+  Shape batched_shape =
+      ShapeUtil::PrependMajorDimension(batch_size, first->shape());
+  HloInstruction* batched_dot = comp->AddInstruction(HloInstruction::CreateDot(
+      batched_shape, lhs, rhs, batched_dnums, first->precision_config()));
+  for (const HloInstruction* dot : dots) {
+    if (!dot->metadata().op_name().empty()) {
+      batched_dot->set_metadata(dot->metadata());
+      break;
+    }
+  }
+
+  Shape slice_shape = ShapeUtil::PrependMajorDimension(1, first->shape());
+  DimensionVector start_indices(batched_shape.dimensions_size(), 0);
+  DimensionVector limit_indices(batched_shape.dimensions().begin(),
+                                batched_shape.dimensions().end());
+  DimensionVector strides(batched_shape.dimensions_size(), 1);
+  for (int64_t i = 0; i < batch_size; ++i) {
+    HloInstruction* dot = dots[i];
+    start_indices[0] = i;
+    limit_indices[0] = i + 1;
+    HloInstruction* slice = comp->AddInstruction(HloInstruction::CreateSlice(
+        slice_shape, batched_dot, start_indices, limit_indices, strides));
+    HloInstruction* result = comp->AddInstruction(
+        HloInstruction::CreateReshape(dot->shape(), slice));
+    TF_RETURN_IF_ERROR(comp->ReplaceInstruction(dot, result));
+  }
+  return absl::OkStatus();
+}
+
+absl::StatusOr<bool> BatchDotsInComputation(
+    HloComputation* comp, int64_t max_size_to_batch,
+    const std::function<bool(const HloInstruction* dot_a,
+                             const HloInstruction* dot_b)>& can_batch) {
+  auto is_batch_candidate = [&](const HloInstruction* instr) {
+    // Cowardly skip instructions with control dependencies, and sparse dots.
+    if (instr->opcode() != HloOpcode::kDot ||
+        instr->operand_count() != HloDotInstruction::kOperands ||
+        !instr->control_predecessors().empty() ||
+        !instr->control_successors().empty() || !instr->shape().IsArray()) {
+      return false;
+    }
+    int64_t bytes = ShapeUtil::ByteSizeOfElements(instr->shape());
+    for (const HloInstruction* operand : instr->operands()) {
+      bytes += ShapeUtil::ByteSizeOfElements(operand->shape());
+    }
+    return bytes <= max_size_to_batch;
+  };
+
+  // Group the candidate dots by their batch key, in instruction order for
+  // determinism.
+  std::vector<std::vector<HloInstruction*>> groups;
+  absl::flat_hash_map<std::string, int64_t> group_index;
+  for (HloInstruction* instr : comp->instructions()) {
+    if (!is_batch_candidate(instr)) {
+      continue;
+    }
+    auto [it, inserted] = group_index.emplace(BatchKey(instr), groups.size());
+    if (inserted) {
+      groups.emplace_back();
+    }
+    groups[it->second].push_back(instr);
+  }
+  if (absl::c_none_of(groups, [](const std::vector<HloInstruction*>& group) {
+        return group.size() > 1;
+      })) {
+    return false;
+  }
+
+  // Build a dependency graph representing the whole computation.
+  GraphCycles graph;
+  absl::flat_hash_map<HloInstruction*, int32_t> graph_ids_map;
+  auto graph_id = [&](HloInstruction* instr) {
+    auto [it, inserted] = graph_ids_map.emplace(instr, -1);
+    if (inserted) {
+      it->second = graph.NewNode();
+    }
+    return it->second;
+  };
+  // Iteration order doesn't matter for correctness, but graph.InsertEdge() is
+  // *much* faster if we iterate in topological order.
+  for (HloInstruction* instr : comp->MakeInstructionPostOrder()) {
+    int32_t id = graph_id(instr);
+    for (HloInstruction* operand : instr->operands()) {
+      CHECK(graph.InsertEdge(graph_id(operand), id));
+    }
+    for (HloInstruction* control_pred : instr->control_predecessors()) {
+      CHECK(graph.InsertEdge(graph_id(control_pred), id));
+    }
+  }
+
+  // Greedily add each dot to the first batch of its group it is independent
+  // of. A batch is represented in the graph by a node that depends on all its
+  // dots and that all their users depend on, so that batches of different
+  // groups cannot form a cycle either.
+  struct Batch {
+    std::vector<HloInstruction*> dots;
+    int32_t node;
+  };
+  std::vector<Batch> batches;
+  for (const std::vector<HloInstruction*>& group : groups) {
+    if (group.size() < 2) {
+      continue;
+    }
+    const int64_t first_batch = batches.size();
+    for (HloInstruction* dot : group) {
+      int32_t dot_id = graph_id(dot);
+      bool added = false;
+      for (int64_t i = first_batch; i < batches.size(); ++i) {
+        Batch& batch = batches[i];
+        // Perform reachability checks last since they can be expensive.
+        if (!can_batch(batch.dots.front(), dot) ||
+            graph.IsReachableNonConst(batch.node, dot_id) ||
+            graph.IsReachableNonConst(dot_id, batch.node)) {
+          continue;
+        }
+        int32_t node = graph.NewNode();
+        for (int32_t pred : {batch.node, dot_id}) {
+          for (int32_t succ : graph.SuccessorsCopy(pred)) {
+            graph.InsertEdge(node, succ);
+          }
+          graph.InsertEdge(pred, node);
+        }
+        batch.dots.push_back(dot);
+        batch.node = node;
+        added = true;
+        break;
+      }
+      if (!added) {
+        batches.push_back(Batch{{dot}, dot_id});
+      }
+    }
+  }
+
+  bool changed = false;
+  for (const Batch& batch : batches) {
+    if (batch.dots.size() < 2) {
+      continue;
+    }
+    TF_RETURN_IF_ERROR(BatchDots(comp, batch.dots));
+    changed = true;
+  }
+  return changed;
+}
+
+}  // anonymous namespace
+
+absl::StatusOr<bool> DotBatcher::Run(
+    HloModule* module,
+    const absl::flat_hash_set<absl::string_view>& execution_threads) {
+  bool changed = false;
+  for (HloComputation* comp :
+       module->MakeNonfusionComputations(execution_threads)) {
+    TF_ASSIGN_OR_RETURN(
+        bool changed_computation,
+        BatchDotsInComputation(comp, max_size_to_batch_, can_batch_));
+    changed |= changed_computation;
+  }
+  return changed;
+}
+
+}  // namespace xla
@@ -0,0 +1,81 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_HLO_TRANSFORMS_SIMPLIFIERS_DOT_BATCHER_H_
+#define XLA_HLO_TRANSFORMS_SIMPLIFIERS_DOT_BATCHER_H_
+
+#include <cstdint>
+#include <functional>
+#include <utility>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/pass/hlo_pass_interface.h"
+
+namespace xla {
+
+// Batches independent dots of the same shapes into a single dot with an extra
+// batch dimension.  Transforms
+//
+//   x = f32[M,N] dot(f32[M,K] a, f32[K,N] b)
+//   y = f32[M,N] dot(f32[M,K] c, f32[K,N] d)
+//
+// into
+//
+//   lhs = f32[2,M,K] concat(reshape(a), reshape(c))
+//   rhs = f32[2,K,N] concat(reshape(b), reshape(d))
+//   z = f32[2,M,N] dot(lhs, rhs), lhs_batch_dims={0}, rhs_batch_dims={0}
+//   x = reshape(slice(z))
+//   y = reshape(slice(z)).
+//
+// This requires that x and y are independent -- that is, x does not
+// transitively depend on y, and y does not transitively depend on x.  Models
+// with many small and equally shaped GEMMs, such as per-head or per-expert
+// matmuls, then run one batched GEMM instead of many small ones that cannot
+// saturate the device.  Dots that share an operand are better merged by
+// DotMerger, which should run first.
+//
+// Like DotMerger, this concatenates the operands and keeps the outputs alive
+// together, so only dots whose input+output bytes are at most
+// `max_size_to_batch` are batched.
+class DotBatcher : public HloModulePass {
+ public:
+  explicit DotBatcher(
+      int64_t max_size_to_batch,
+      std::function<bool(const HloInstruction* a, const HloInstruction* b)>
+          can_batch = [](const HloInstruction* dot_a,
+                         const HloInstruction* dot_b) -> bool { return true; })
+      : max_size_to_batch_(max_size_to_batch),
+        can_batch_(std::move(can_batch)) {}
+
+  absl::string_view name() const override { return "dot-batcher"; }
+  using HloPassInterface::Run;
+  absl::StatusOr<bool> Run(
+      HloModule* module,
+      const absl::flat_hash_set<absl::string_view>& execution_threads) override;
+
+ private:
+  int64_t max_size_to_batch_;
+  // Predicate function for backend-specific compatibility check.
+  std::function<bool(const HloInstruction* dot_a, const HloInstruction* dot_b)>
+      can_batch_;
+};
+
+}  // namespace xla
+
+#endif  // XLA_HLO_TRANSFORMS_SIMPLIFIERS_DOT_BATCHER_H_
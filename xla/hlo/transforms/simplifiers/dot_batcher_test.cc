@@ -0,0 +1,212 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/hlo/transforms/simplifiers/dot_batcher.h"
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/hlo/testlib/hlo_hardware_independent_test_base.h"
+#include "xla/hlo/testlib/pattern_matcher_gmock.h"
+#include "xla/service/pattern_matcher.h"
+#include "xla/shape_util.h"
+#include "xla/xla_data.pb.h"
+#include "tsl/platform/statusor.h"
+
+namespace xla {
+namespace {
+
+namespace m = ::xla::match;
+
+class DotBatcherTest : public HloHardwareIndependentTestBase {
+ public:
+  DotBatcherTest()
+      : HloHardwareIndependentTestBase(
+            /*verifier_layout_sensitive=*/false,
+            /*allow_mixed_precision_in_hlo_verifier=*/false) {}
+};
+
+TEST_F(DotBatcherTest, BatchIndependentDots) {
+  absl::string_view module_string = R"(
+  HloModule module
+
+  ENTRY main {
+    lhs0 = f32[16,32] parameter(0)
+    rhs0 = f32[32,8] parameter(1)
+    lhs1 = f32[16,32] parameter(2)
+    rhs1 = f32[32,8] parameter(3)
+    lhs2 = f32[16,32] parameter(4)
+    rhs2 = f32[32,8] parameter(5)
+    dot0 = f32[16,8] dot(lhs0, rhs0), lhs_contracting_dims={1}, rhs_contracting_dims={0}
+    dot1 = f32[16,8] dot(lhs1, rhs1), lhs_contracting_dims={1}, rhs_contracting_dims={0}
+    dot2 = f32[16,8] dot(lhs2, rhs2), lhs_contracting_dims={1}, rhs_contracting_dims={0}
+    ROOT tuple = (f32[16,8], f32[16,8], f32[16,8]) tuple(dot0, dot1, dot2)
+  })";
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(module_string));
+  DotBatcher pass(/*max_size_to_batch=*/std::numeric_limits<int64_t>::max());
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, this->RunHloPass(&pass, module.get()));
+  EXPECT_TRUE(changed);
+  const HloInstruction* dot0 = nullptr;
+  const HloInstruction* dot1 = nullptr;
+  const HloInstruction* dot2 = nullptr;
+  ASSERT_THAT(module->entry_computation()->root_instruction(),
+              GmockMatch(m::Tuple(m::Reshape(m::Slice(m::Dot(&dot0))),
+                                  m::Reshape(m::Slice(m::Dot(&dot1))),
+                                  m::Reshape(m::Slice(m::Dot(&dot2))))));
+  EXPECT_EQ(dot0, dot1);
+  EXPECT_EQ(dot0, dot2);
+  EXPECT_TRUE(ShapeUtil::Equal(dot0->shape(),
+                               ShapeUtil::MakeShape(F32, {3, 16, 8})));
+  EXPECT_THAT(dot0, GmockMatch(m::Dot(
+                        m::Concatenate(m::Reshape(m::Parameter(0)),
+                                       m::Reshape(m::Parameter(2)),
+                                       m::Reshape(m::Parameter(4))),
+                        m::Concatenate(m::Reshape(m::Parameter(1)),
+                                       m::Reshape(m::Parameter(3)),
+                                       m::Reshape(m::Parameter(5))))));
+  const DotDimensionNumbers& dnums = dot0->dot_dimension_numbers();
+  EXPECT_THAT(dnums.lhs_batch_dimensions(), ::testing::ElementsAre(0));
+  EXPECT_THAT(dnums.rhs_batch_dimensions(), ::testing::ElementsAre(0));
+  EXPECT_THAT(dnums.lhs_contracting_dimensions(), ::testing::ElementsAre(2));
+  EXPECT_THAT(dnums.rhs_contracting_dimensions(), ::testing::ElementsAre(1));
+}
+
+TEST_F(DotBatcherTest, BatchDotsWithBatchDimensions) {
+  absl::string_view module_string = R"(
+  HloModule module
+
+  ENTRY main {
+    lhs0 = f32[4,16,32] parameter(0)
+    rhs0 = f32[4,32,8] parameter(1)
+    lhs1 = f32[4,16,32] parameter(2)
+    rhs1 = f32[4,32,8] parameter(3)
+    dot0 = f32[4,16,8] dot(lhs0, rhs0), lhs_batch_dims={0}, rhs_batch_dims={0}, lhs_contracting_dims={2}, rhs_contracting_dims={1}
+    dot1 = f32[4,16,8] dot(lhs1, rhs1), lhs_batch_dims={0}, rhs_batch_dims={0}, lhs_contracting_dims={2}, rhs_contracting_dims={1}
+    ROOT add = f32[4,16,8] add(dot0, dot1)
+  })";
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(module_string));
+  DotBatcher pass(/*max_size_to_batch=*/std::numeric_limits<int64_t>::max());
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, this->RunHloPass(&pass, module.get()));
+  EXPECT_TRUE(changed);
+  const HloInstruction* dot = nullptr;
+  ASSERT_THAT(module->entry_computation()->root_instruction(),
+              GmockMatch(m::Add(m::Reshape(m::Slice(m::Dot(&dot))),
+                                m::Reshape(m::Slice(m::Dot())))));
+  const DotDimensionNumbers& dnums = dot->dot_dimension_numbers();
+  EXPECT_THAT(dnums.lhs_batch_dimensions(), ::testing::ElementsAre(0, 1));
+  EXPECT_THAT(dnums.rhs_batch_dimensions(), ::testing::ElementsAre(0, 1));
+  EXPECT_THAT(dnums.lhs_contracting_dimensions(), ::testing::ElementsAre(3));
+  EXPECT_THAT(dnums.rhs_contracting_dimensions(), ::testing::ElementsAre(2));
+}
+
+TEST_F(DotBatcherTest, NoBatchDependentDots) {
+  absl::string_view module_string = R"(
+  HloModule module
+
+  ENTRY main {
+    lhs0 = f32[16,16] parameter(0)
+    rhs0 = f32[16,16] parameter(1)
+    rhs1 = f32[16,16] parameter(2)
+    dot0 = f32[16,16] dot(lhs0, rhs0), lhs_contracting_dims={1}, rhs_contracting_dims={0}
+    ROOT dot1 = f32[16,16] dot(dot0, rhs1), lhs_contracting_dims={1}, rhs_contracting_dims={0}
+  })";
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(module_string));
+  DotBatcher pass(/*max_size_to_batch=*/std::numeric_limits<int64_t>::max());
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, this->RunHloPass(&pass, module.get()));
+  EXPECT_FALSE(changed);
+}
+
+TEST_F(DotBatcherTest, NoBatchDifferentShapes) {
+  absl::string_view module_string = R"(
+  HloModule module
+
+  ENTRY main {
+    lhs0 = f32[16,32] parameter(0)
+    rhs0 = f32[32,8] parameter(1)
+    lhs1 = f32[16,32] parameter(2)
+    rhs1 = f32[32,4] parameter(3)
+    dot0 = f32[16,8] dot(lhs0, rhs0), lhs_contracting_dims={1}, rhs_contracting_dims={0}
+    dot1 = f32[16,4] dot(lhs1, rhs1), lhs_contracting_dims={1}, rhs_contracting_dims={0}
+    ROOT tuple = (f32[16,8], f32[16,4]) tuple(dot0, dot1)
+  })";
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(module_string));
+  DotBatcher pass(/*max_size_to_batch=*/std::numeric_limits<int64_t>::max());
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, this->RunHloPass(&pass, module.get()));
+  EXPECT_FALSE(changed);
+}
+
+TEST_F(DotBatcherTest, NoBatchLargeDots) {
+  absl::string_view module_string = R"(
+  HloModule module
+
+  ENTRY main {
+    lhs0 = f32[16,32] parameter(0)
+    rhs0 = f32[32,8] parameter(1)
+    lhs1 = f32[16,32] parameter(2)
+    rhs1 = f32[32,8] parameter(3)
+    dot0 = f32[16,8] dot(lhs0, rhs0), lhs_contracting_dims={1}, rhs_contracting_dims={0}
+    dot1 = f32[16,8] dot(lhs1, rhs1), lhs_contracting_dims={1}, rhs_contracting_dims={0}
+    ROOT tuple = (f32[16,8], f32[16,8]) tuple(dot0, dot1)
+  })";
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(module_string));
+  DotBatcher pass(/*max_size_to_batch=*/1024);
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, this->RunHloPass(&pass, module.get()));
+  EXPECT_FALSE(changed);
+}
+
+TEST_F(DotBatcherTest, NoCycleAcrossBatches) {
+  // Batching both {dot0, dot3} and {dot1, dot2} would make each batch depend
+  // on the other.
+  absl::string_view module_string = R"(
+  HloModule module
+
+  ENTRY main {
+    a = f32[8,8] parameter(0)
+    b = f32[8,4] parameter(1)
+    dot0 = f32[8,8] dot(a, a), lhs_contracting_dims={1}, rhs_contracting_dims={0}
+    dot1 = f32[8,4] dot(dot0, b), lhs_contracting_dims={1}, rhs_contracting_dims={0}
+    dot2 = f32[8,4] dot(a, b), lhs_contracting_dims={1}, rhs_contracting_dims={0}
+    concat = f32[8,8] concatenate(dot2, dot2), dimensions={1}
+    dot3 = f32[8,8] dot(a, concat), lhs_contracting_dims={1}, rhs_contracting_dims={0}
+    ROOT tuple = (f32[8,4], f32[8,8]) tuple(dot1, dot3)
+  })";
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(module_string));
+  DotBatcher pass(/*max_size_to_batch=*/std::numeric_limits<int64_t>::max());
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, this->RunHloPass(&pass, module.get()));
+  EXPECT_TRUE(changed);
+  // Only one of the two pairs can be batched.
+  int64_t num_dots = 0;
+  for (const HloInstruction* instr :
+       module->entry_computation()->instructions()) {
+    num_dots += instr->opcode() == HloOpcode::kDot;
+  }
+  EXPECT_EQ(num_dots, 3);
+}
+
+}  // namespace
+}  // namespace xla
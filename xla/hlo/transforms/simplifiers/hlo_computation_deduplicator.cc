@@ -15,12 +15,16 @@ limitations under the License.
 
 #include "xla/hlo/transforms/simplifiers/hlo_computation_deduplicator.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/algorithm/container.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
+#include "absl/hash/hash.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
 #include "xla/hlo/ir/hlo_computation.h"
@@ -87,6 +91,11 @@ absl::StatusOr<bool> HloComputationDeduplicator::Run(
     }
     return false;
   };
+  // Duplicates have the same structural hash, which doesn't depend on the
+  // called computations and is much cheaper to compute than the string. Only
+  // the computations whose hash collides with another one's are stringified.
+  std::vector<std::pair<HloComputation*, size_t>> candidates;
+  absl::flat_hash_map<size_t, int64_t> hash_counts;
   for (HloComputation* comp :
        module->MakeComputationPostOrder(execution_threads)) {
     // Ignore entry computation since it is called from outside and computations
@@ -103,7 +112,15 @@ absl::StatusOr<bool> HloComputationDeduplicator::Run(
             })) {
       continue;
     }
+    const size_t hash = absl::HashOf(*comp);
+    candidates.push_back({comp, hash});
+    ++hash_counts[hash];
+  }
 
+  for (const auto& [comp, hash] : candidates) {
+    if (hash_counts[hash] == 1) {
+      continue;
+    }
     std::string comp_str = comp->ToString(options);
     auto poss_dup = unique_comps.find(comp_str);
     if (poss_dup != unique_comps.end() &&
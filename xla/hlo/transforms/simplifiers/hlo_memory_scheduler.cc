@@ -16,12 +16,14 @@ limitations under the License.
 #include "xla/hlo/transforms/simplifiers/hlo_memory_scheduler.h"
 
 #include <algorithm>
+#include <array>
 #include <climits>
 #include <cstddef>
 #include <cstdint>
 #include <limits>
 #include <map>
 #include <memory>
+#include <optional>
 #include <queue>
 #include <utility>
 #include <vector>
@@ -48,6 +50,7 @@ limitations under the License.
 #include "xla/tsl/platform/errors.h"
 #include "xla/tsl/platform/logging.h"
 #include "xla/tsl/platform/statusor.h"
+#include "xla/tsl/platform/threadpool.h"
 #include "xla/util.h"
 #include "tsl/platform/numbers.h"
 #include "tsl/profiler/lib/scoped_annotation.h"
@@ -570,46 +573,54 @@ absl::StatusOr<HloSchedule> DefaultMemoryScheduler::Run(
   // - Postorder does not use any heuristics.
   // List wins for most of our benchmarks; postorder-based schedulers win for
   // some RNNs.
-  int64_t list_memory;
-  TF_ASSIGN_OR_RETURN(
-      HloSchedule list_sequence,
-      list_scheduler_.Run(module, points_to_analysis, alias_analysis,
-                          execution_threads, &list_memory));
-  VLOG(2) << "Min-memory list sequence: " << HumanReadableNumBytes(list_memory);
-
-  int64_t dfs_memory;
-  TF_ASSIGN_OR_RETURN(
-      HloSchedule dfs_sequence,
-      dfs_scheduler_.Run(module, points_to_analysis, alias_analysis,
-                         execution_threads, &dfs_memory));
-  VLOG(2) << "Min-memory dfs sequence: " << HumanReadableNumBytes(dfs_memory);
-
-  int64_t post_order_memory;
-  TF_ASSIGN_OR_RETURN(
-      HloSchedule post_order_sequence,
-      post_order_scheduler_.Run(module, points_to_analysis, alias_analysis,
-                                execution_threads, &post_order_memory));
-  VLOG(2) << "Min-memory post order sequence: "
-          << HumanReadableNumBytes(post_order_memory);
-
-  auto min_memory = std::min({dfs_memory, post_order_memory, list_memory});
-  if (peak_memory) {
-    *peak_memory = min_memory;
+  //
+  // The schedulers only read the module and the analyses, so they can run
+  // concurrently.
+  struct Candidate {
+    absl::string_view name;
+    const ModuleSchedulerAlgorithm* algorithm;
+    std::optional<absl::StatusOr<HloSchedule>> schedule;
+    int64_t memory = 0;
+  };
+  // On ties, the earlier candidate wins.
+  std::array<Candidate, 3> candidates = {
+      Candidate{"list", &list_scheduler_},
+      Candidate{"dfs", &dfs_scheduler_},
+      Candidate{"post_order", &post_order_scheduler_},
+  };
+  auto run_candidate = [&](Candidate& candidate) {
+    candidate.schedule =
+        candidate.algorithm->Run(module, points_to_analysis, alias_analysis,
+                                 execution_threads, &candidate.memory);
+  };
+  if (thread_pool_ != nullptr) {
+    thread_pool_->ParallelFor(candidates.size(),
+                              [&](int64_t begin, int64_t end) {
+                                for (int64_t i = begin; i < end; ++i) {
+                                  run_candidate(candidates[i]);
+                                }
+                              });
+  } else {
+    for (Candidate& candidate : candidates) {
+      run_candidate(candidate);
+    }
   }
 
-  if (min_memory == list_memory) {
-    VLOG(2) << "Chose min-memory list sequence: "
-            << HumanReadableNumBytes(list_memory);
-    return list_sequence;
-  } else if (min_memory == dfs_memory) {
-    VLOG(2) << "Chose min-memory dfs sequence: "
-            << HumanReadableNumBytes(dfs_memory);
-    return dfs_sequence;
-  } else {
-    VLOG(2) << "Chose min-memory post_order sequence: "
-            << HumanReadableNumBytes(post_order_memory);
-    return post_order_sequence;
+  Candidate* best = nullptr;
+  for (Candidate& candidate : candidates) {
+    TF_RETURN_IF_ERROR(candidate.schedule->status());
+    VLOG(2) << "Min-memory " << candidate.name
+            << " sequence: " << HumanReadableNumBytes(candidate.memory);
+    if (best == nullptr || candidate.memory < best->memory) {
+      best = &candidate;
+    }
+  }
+  if (peak_memory) {
+    *peak_memory = best->memory;
   }
+  VLOG(2) << "Chose min-memory " << best->name
+          << " sequence: " << HumanReadableNumBytes(best->memory);
+  return *std::move(*best->schedule);
 }
 
 absl::StatusOr<HloSchedule> ScheduleModule(
@@ -31,6 +31,7 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_schedule.h"
 #include "xla/hlo/pass/hlo_pass_interface.h"
 #include "xla/service/buffer_value.h"
+#include "xla/tsl/platform/threadpool.h"
 
 namespace xla {
 
@@ -154,12 +155,17 @@ class PostOrderScheduler : public ComputationSchedulerAlgorithm {
 // to the peak memory of the resulting schedule according to the HeapSimulator.
 class DefaultMemoryScheduler : public ModuleSchedulerAlgorithm {
  public:
+  // If `thread_pool` is not null, the candidate schedulers run concurrently on
+  // it, so `size_function` and `postprocessor` must be safe to call from
+  // several threads. The chosen schedule is the same either way.
   explicit DefaultMemoryScheduler(
       const BufferValue::SizeFunction& size_function,
-      const SchedulerPostprocessor& postprocessor = {})
+      const SchedulerPostprocessor& postprocessor = {},
+      tsl::thread::ThreadPool* thread_pool = nullptr)
       : list_scheduler_(size_function, postprocessor),
         dfs_scheduler_(size_function, postprocessor),
-        post_order_scheduler_(size_function, postprocessor) {}
+        post_order_scheduler_(size_function, postprocessor),
+        thread_pool_(thread_pool) {}
   absl::StatusOr<HloSchedule> Run(
       const HloModule* module, const TuplePointsToAnalysis& points_to_analysis,
       const HloAliasAnalysis& alias_analysis,
@@ -170,6 +176,7 @@ class DefaultMemoryScheduler : public ModuleSchedulerAlgorithm {
   ListMemoryScheduler list_scheduler_;
   DFSMemoryScheduler dfs_scheduler_;
   PostOrderScheduler post_order_scheduler_;
+  tsl::thread::ThreadPool* thread_pool_;
 };
 
 // Returns an HloSchedule which seeks to minimize the memory required for the
@@ -41,6 +41,9 @@ limitations under the License.
 #include "xla/shape.h"
 #include "xla/shape_util.h"
 #include "xla/tsl/lib/core/status_test_util.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/tsl/platform/threadpool.h"
 #include "xla/xla_data.pb.h"
 
 namespace xla {
@@ -312,6 +315,71 @@ TEST_F(HloSchedulingTest, MultiOutputFusionAccountedCorrectly) {
   EXPECT_TRUE(ordering.ExecutesBefore(exp, fusion));
 }
 
+TEST_F(HloSchedulingTest, DefaultSchedulerOnThreadPoolMatchesSequential) {
+  const char* const hlo_string = R"(
+HloModule module
+
+body {
+  p = (s32[], f32[64]) parameter(0)
+  i = s32[] get-tuple-element(p), index=0
+  one = s32[] constant(1)
+  next_i = s32[] add(i, one)
+  x = f32[64] get-tuple-element(p), index=1
+  e = f32[64] exponential(x)
+  n = f32[64] negate(x)
+  a = f32[64] add(e, n)
+  ROOT t = (s32[], f32[64]) tuple(next_i, a)
+}
+
+cond {
+  p = (s32[], f32[64]) parameter(0)
+  i = s32[] get-tuple-element(p), index=0
+  limit = s32[] constant(10)
+  ROOT lt = pred[] compare(i, limit), direction=LT
+}
+
+ENTRY entry {
+  param = f32[64] parameter(0)
+  abs = f32[64] abs(param)
+  exp = f32[64] exponential(param)
+  add = f32[64] add(abs, exp)
+  zero = s32[] constant(0)
+  init = (s32[], f32[64]) tuple(zero, add)
+  while = (s32[], f32[64]) while(init), condition=cond, body=body
+  result = f32[64] get-tuple-element(while), index=1
+  negate = f32[64] negate(exp)
+  ROOT sub = f32[64] subtract(result, negate)
+}
+)";
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+  auto size_fn = [](const BufferValue& buffer) {
+    return ShapeUtil::ByteSizeOf(buffer.shape(), /*pointer_size=*/8);
+  };
+
+  int64_t sequential_memory;
+  TF_ASSERT_OK_AND_ASSIGN(
+      HloSchedule sequential_schedule,
+      ScheduleModule(module.get(), DefaultMemoryScheduler(size_fn),
+                     /*execution_threads=*/{}, &sequential_memory));
+
+  tsl::thread::ThreadPool thread_pool(tsl::Env::Default(), "test", 3);
+  int64_t parallel_memory;
+  TF_ASSERT_OK_AND_ASSIGN(
+      HloSchedule parallel_schedule,
+      ScheduleModule(module.get(),
+                     DefaultMemoryScheduler(size_fn, /*postprocessor=*/{},
+                                            &thread_pool),
+                     /*execution_threads=*/{}, &parallel_memory));
+
+  EXPECT_EQ(sequential_memory, parallel_memory);
+  for (const HloComputation* computation : module->computations()) {
+    EXPECT_EQ(sequential_schedule.sequence(computation).ids(),
+              parallel_schedule.sequence(computation).ids())
+        << computation->name();
+  }
+}
+
 TEST_F(HloSchedulingTest, TrivialScheduler) {
   const char* const hlo_string = R"(
 HloModule ModuleWithWhile
@@ -41,6 +41,7 @@ limitations under the License.
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
 #include "absl/strings/string_view.h"
+#include "absl/time/time.h"
 #include "absl/types/span.h"
 #include "xla/hlo/analysis/hlo_dataflow_analysis.h"
 #include "xla/hlo/analysis/tuple_points_to_analysis.h"
@@ -62,6 +63,7 @@ limitations under the License.
 #include "xla/shape.h"
 #include "xla/shape_util.h"
 #include "xla/status_macros.h"
+#include "xla/tsl/platform/threadpool.h"
 #include "xla/util.h"
 #include "xla/xla_data.pb.h"
 #include "tsl/platform/errors.h"
@@ -552,10 +554,25 @@ class MemoryUsageTracker {
     }
 
     CHECK_GT(memory_reduced, 0);
+    if (options_.minimize_added_time) {
+      float recompute_seconds = 0;
+      for (auto* item : items) {
+        recompute_seconds +=
+            std::max(0.0f, options_.hlo_cost_analysis.optimal_seconds(
+                               *item->instruction));
+      }
+      return AddedTimeCost(recompute_seconds, memory_reduced);
+    }
     // Return the inverse of the benefit of rematerialization.
     return memory_limit_bytes / memory_reduced;
   }
 
+  // Returns the cost of a rematerialization that adds `seconds` to the run time
+  // and frees `memory_reduced` bytes, in femtoseconds per byte freed.
+  static int64_t AddedTimeCost(float seconds, int64_t memory_reduced) {
+    return static_cast<int64_t>(1e15 * seconds / memory_reduced);
+  }
+
   // Finishes the placement of the current instruction. This frees any dead
   // operands or dead result of the instruction. This must be called after
   // each call to BeginInstruction.
@@ -1681,6 +1698,15 @@ std::optional<int64_t> MemoryUsageTracker::GetCostOfCompression(
       options_.hlo_cost_analysis.GetShapeSize(*compact_shape);
   // TODO(victorstone): I don't think this size check is right.
   if (memory_reduced > 0 && size + reduced_size < peak_memory_bytes) {
+    if (options_.minimize_added_time) {
+      // Compressing and uncompressing each read one layout and write the other.
+      const float bytes_per_second = options_.hlo_cost_analysis.per_second_rate(
+          HloCostAnalysis::kBytesAccessedKey);
+      const float copy_seconds =
+          bytes_per_second > 0 ? 2 * (size + reduced_size) / bytes_per_second
+                               : 0;
+      return AddedTimeCost(copy_seconds, memory_reduced);
+    }
     return memory_limit_bytes / memory_reduced;
   } else {
     return {};
@@ -1809,16 +1835,24 @@ std::optional<int64_t> MemoryUsageTracker::GetCostOfHostOffload(
         0.0f, options_.hlo_cost_analysis.optimal_seconds(*item->instruction));
   }
 
-  if (time_spent_before_next_use <= 0.0) {
-    // Instructions between take no time.
-    return {};
-  }
-
   const float time_spent_on_copies =
       bytes_used_by_buffers / options_.host_memory_offload_config
                                   ->bandwidth_to_host_bytes_per_second +
       bytes_used_by_buffers / options_.host_memory_offload_config
                                   ->bandwidth_from_host_bytes_per_second;
+  if (options_.minimize_added_time) {
+    // Only the part of the round trip that the instructions in between can not
+    // hide adds to the run time.
+    return AddedTimeCost(
+        std::max(0.0f, time_spent_on_copies - time_spent_before_next_use),
+        bytes_used_by_buffers);
+  }
+
+  if (time_spent_before_next_use <= 0.0) {
+    // Instructions between take no time.
+    return {};
+  }
+
   if (time_spent_before_next_use < time_spent_on_copies) {
     // Host offload only considers cases where we can completely hide the copy
     // times. In this case, there is not enough compute time to hide offloading
@@ -1883,6 +1917,24 @@ MemoryUsageTracker::PickRematerializationCandidates(
   VLOG(5) << "Picking candidate block with size in [" << min_block_size << ", "
           << max_block_size << "]";
 
+  // The candidates starting at one item. Compression and host offload costs
+  // are computed while scanning the instruction list. Recompute costs only
+  // read the tracker, so they are computed afterwards, possibly in parallel.
+  struct StartCandidates {
+    // The initial block of at least `min_block_size` items.
+    std::vector<Item*> block;
+    std::optional<int64_t> compress_cost;
+    Shape compact_shape;
+    std::optional<int64_t> host_offload_cost;
+    // The longest block to recompute. Its prefixes of at least
+    // `min_recompute_size` items are candidates too.
+    std::vector<Item*> recompute_block;
+    int64_t min_recompute_size = 0;
+    std::optional<int64_t> recompute_cost;
+    int64_t recompute_size = 0;
+  };
+  std::vector<StartCandidates> candidates;
+
   for (auto* start_item = instruction_list.first_skip_node();
        start_item != nullptr;
        start_item = instruction_list.next_skip_node(start_item)) {
@@ -1900,67 +1952,43 @@ MemoryUsageTracker::PickRematerializationCandidates(
     if (AnyDenylistedOrNonRematerializable(block, rematerializable_map)) {
       continue;
     }
+    StartCandidates& candidate = candidates.emplace_back();
+    candidate.block = block;
 
     // First, calculate the cost of compression rematerialization for this
     // instruction.
     if (options_.remat_mode_config.compress && block.size() == 1) {
-      auto cost =
+      candidate.compress_cost =
           GetCostOfCompression(block[0], memory_limit_bytes, peak_memory_bytes);
       ++effort;
-      if (cost && *cost < best_cost) {
-        VLOG(1) << "Found new best cost; from " << best_cost << " to " << *cost
-                << " with strategy kCompress on block of size " << block.size();
-        best_strategy.kind = RematStrategy::kCompress;
-        // TODO(b/293323448): This `best_strategy.compact_shape` is already
-        // computed inside GetCostOfCompression, should we get it from there? Or
-        // is it ok to recompute?
-        best_strategy.compact_shape =
+      if (candidate.compress_cost) {
+        // TODO(b/293323448): This `compact_shape` is already computed inside
+        // GetCostOfCompression, should we get it from there? Or is it ok to
+        // recompute?
+        candidate.compact_shape =
             *GetCompactShape(block[0]->instruction).value();
-        best_items = block;
-        best_cost = *cost;
       }
     }
 
     // Second, calculate the cost of host offload rematerialization for this
     // instruction.
     if (options_.remat_mode_config.host_offload && block.size() == 1) {
-      auto cost = GetCostOfHostOffload(block[0], memory_limit_bytes);
+      candidate.host_offload_cost =
+          GetCostOfHostOffload(block[0], memory_limit_bytes);
       ++effort;
-      if (cost && *cost < best_cost) {
-        VLOG(1) << "Found new best cost; from " << best_cost << " to " << *cost
-                << " with strategy kHostOffload on block of size "
-                << block.size();
-        best_strategy.kind = RematStrategy::kHostOffload;
-        best_items = block;
-        best_cost = *cost;
-      }
     }
 
-    // Finally, calculate the cost of recompute rematerialization for this
-    // instruction block. There is one difference between this rematerialization
-    // strategy and the other two: recompute can rematerialize more than one
-    // instruction at a time. Evaluate the cost of rematerializing the current
-    // block, add the next instruction to the block, and then repeat until we
-    // reach the configured max block size.
+    // Finally, collect the blocks for recompute rematerialization. There is
+    // one difference between this rematerialization strategy and the other
+    // two: recompute can rematerialize more than one instruction at a time.
+    // The current block and each block obtained by adding the next
+    // instruction to it, up to the configured max block size, are candidates.
     if (!options_.remat_mode_config.recompute) {
       // Recompute is not enabled, nothing else to do for this block.
       continue;
     }
-
-    while (block.size() <= max_block_size) {
-      auto cost = GetCostOfRecompute(block, memory_limit_bytes);
-      ++effort;
-      if (cost && *cost < best_cost) {
-        VLOG(1) << "Found new best cost; from " << best_cost << " to " << *cost
-                << " with strategy kRecompute on block of size "
-                << block.size();
-        best_strategy.kind = RematStrategy::kRecompute;
-        best_items = block;
-        best_cost = *cost;
-      }
-
-      // Try to add the next instruction to this block to evaluate as a possibly
-      // better candidate for rematerialization.
+    candidate.min_recompute_size = block.size();
+    while (block.size() < max_block_size) {
       auto* last_item = block[block.size() - 1];
       auto* next_item = instruction_list.next(last_item);
       if (next_item == nullptr || next_item->denylisted || !next_item->placed ||
@@ -1970,6 +1998,77 @@ MemoryUsageTracker::PickRematerializationCandidates(
       }
       block.push_back(next_item);
     }
+    effort += block.size() - candidate.min_recompute_size + 1;
+    candidate.recompute_block = std::move(block);
+  }
+
+  auto evaluate_recompute = [&](StartCandidates& candidate) {
+    std::vector<Item*> block(
+        candidate.recompute_block.begin(),
+        candidate.recompute_block.begin() + candidate.min_recompute_size);
+    while (true) {
+      auto cost = GetCostOfRecompute(block, memory_limit_bytes);
+      if (cost && (!candidate.recompute_cost ||
+                   *cost < *candidate.recompute_cost)) {
+        candidate.recompute_cost = cost;
+        candidate.recompute_size = block.size();
+      }
+      if (block.size() == candidate.recompute_block.size()) {
+        break;
+      }
+      block.push_back(candidate.recompute_block[block.size()]);
+    }
+  };
+  if (options_.thread_pool != nullptr && candidates.size() > 1) {
+    options_.thread_pool->ParallelFor(
+        candidates.size(), [&](int64_t begin, int64_t end) {
+          for (int64_t i = begin; i < end; ++i) {
+            if (!candidates[i].recompute_block.empty()) {
+              evaluate_recompute(candidates[i]);
+            }
+          }
+        });
+  } else {
+    for (StartCandidates& candidate : candidates) {
+      if (!candidate.recompute_block.empty()) {
+        evaluate_recompute(candidate);
+      }
+    }
+  }
+
+  // Pick the cheapest candidate, in the order they were found on ties.
+  for (StartCandidates& candidate : candidates) {
+    if (candidate.compress_cost && *candidate.compress_cost < best_cost) {
+      VLOG(1) << "Found new best cost; from " << best_cost << " to "
+              << *candidate.compress_cost
+              << " with strategy kCompress on block of size "
+              << candidate.block.size();
+      best_strategy.kind = RematStrategy::kCompress;
+      best_strategy.compact_shape = candidate.compact_shape;
+      best_items = candidate.block;
+      best_cost = *candidate.compress_cost;
+    }
+    if (candidate.host_offload_cost &&
+        *candidate.host_offload_cost < best_cost) {
+      VLOG(1) << "Found new best cost; from " << best_cost << " to "
+              << *candidate.host_offload_cost
+              << " with strategy kHostOffload on block of size "
+              << candidate.block.size();
+      best_strategy.kind = RematStrategy::kHostOffload;
+      best_items = candidate.block;
+      best_cost = *candidate.host_offload_cost;
+    }
+    if (candidate.recompute_cost && *candidate.recompute_cost < best_cost) {
+      VLOG(1) << "Found new best cost; from " << best_cost << " to "
+              << *candidate.recompute_cost
+              << " with strategy kRecompute on block of size "
+              << candidate.recompute_size;
+      best_strategy.kind = RematStrategy::kRecompute;
+      best_items.assign(
+          candidate.recompute_block.begin(),
+          candidate.recompute_block.begin() + candidate.recompute_size);
+      best_cost = *candidate.recompute_cost;
+    }
   }
   return {best_items, best_strategy, effort};
 }
@@ -2715,7 +2814,8 @@ absl::StatusOr<bool> HloRematerialization::RematerializeComputation(
       int64_t first_phase_effort = 0;
       int64_t second_phase_effort = 0;
       while (memory_tracker.memory_usage() + callee_usage >
-             memory_limit_bytes) {
+                 memory_limit_bytes &&
+             absl::Now() < deadline_) {
         VLOG(2) << "Over memory limit at instruction " << instruction->name()
                 << ", using "
                 << HumanReadableNumBytes(memory_tracker.memory_usage() +
@@ -2778,6 +2878,7 @@ absl::StatusOr<bool> HloRematerialization::RematerializeComputation(
       for (HloComputation* called_computation :
            callsite->called_computations()) {
         if (!ContainsKey(rematerialized_computations_, called_computation) &&
+            absl::Now() < deadline_ &&
             HloInstruction::IsThreadIncluded(
                 called_computation->execution_thread(), execution_threads)) {
           // Memory limit for the subcomputation is the memory limit less the
@@ -2863,6 +2964,7 @@ absl::StatusOr<bool> HloRematerialization::Run(
   rematerialized_computations_.clear();
   instructions_rematerialized_ = 0;
   net_instructions_added_ = 0;
+  deadline_ = absl::Now() + options_.time_budget;
 
   TF_RET_CHECK(module->has_schedule());
   TF_ASSIGN_OR_RETURN(points_to_analysis_, TuplePointsToAnalysis::Run(module));
@@ -2982,6 +3084,11 @@ absl::StatusOr<bool> HloRematerialization::Run(
       RematerializeComputation(module->entry_computation(), &module->schedule(),
                                adjusted_memory_limit_bytes,
                                options_.min_remat_size, execution_threads));
+  if (absl::Now() >= deadline_) {
+    LOG(WARNING) << "Rematerialization stopped after its time budget of "
+                 << absl::FormatDuration(options_.time_budget)
+                 << ", the module may not fit in the memory limit.";
+  }
   // Rematerialization can introduce dead code. This occurs if all uses of an
   // instruction are replaced with rematerializations of the instruction.
 
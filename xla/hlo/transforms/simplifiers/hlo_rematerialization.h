@@ -25,6 +25,7 @@
 #include "absl/container/flat_hash_set.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
+#include "absl/time/time.h"
 #include "xla/hlo/analysis/tuple_points_to_analysis.h"
 #include "xla/hlo/ir/hlo_computation.h"
 #include "xla/hlo/ir/hlo_instruction.h"
@@ -34,6 +35,7 @@
 #include "xla/service/call_graph.h"
 #include "xla/service/hlo_cost_analysis.h"
 #include "xla/shape.h"
+#include "xla/tsl/platform/threadpool.h"
 
 namespace xla {
 
@@ -154,6 +156,24 @@ class HloRematerialization : public HloModulePass {
     // Collection of async entry computations and their number of parallel
     // invocations.
     absl::flat_hash_map<HloComputation*, int64_t> async_computation_parallelism;
+
+    // If set, the costs of recomputing candidate blocks are evaluated on this
+    // thread pool.
+    tsl::thread::ThreadPool* thread_pool = nullptr;
+
+    // If true, recompute, compression and host offload candidates are compared
+    // by the time they add per byte of memory freed, estimated from
+    // `hlo_cost_analysis`: the optimal time of the recomputed instructions,
+    // the time to read and write both layouts for compression, and the part
+    // of the host round trip that the instructions before the next use do not
+    // hide. Otherwise candidates are compared by the memory they free only,
+    // and host offload is only considered if the round trip can be hidden.
+    bool minimize_added_time = false;
+
+    // Time after which no more instructions are rematerialized. The
+    // rematerializations done until then are kept, even if the module does
+    // not fit in the memory limit yet.
+    absl::Duration time_budget = absl::InfiniteDuration();
   };
 
   explicit HloRematerialization(Options options, RematerializationSizes& sizes)
@@ -244,6 +264,9 @@ class HloRematerialization : public HloModulePass {
   // Tracking available channel id numbers to use to apply to rematerialized
   // channel instructions
   int64_t next_channel_id_;
+
+  // Rematerialization stops at this time, see Options::time_budget.
+  absl::Time deadline_ = absl::InfiniteFuture();
 };
 
 }  // namespace xla
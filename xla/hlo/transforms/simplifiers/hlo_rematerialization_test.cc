@@ -23,11 +23,13 @@ limitations under the License.
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include "absl/algorithm/container.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/match.h"
 #include "absl/strings/string_view.h"
+#include "absl/time/time.h"
 #include "xla/hlo/ir/hlo_computation.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_opcode.h"
@@ -40,7 +42,9 @@ limitations under the License.
 #include "xla/shape.h"
 #include "xla/shape_util.h"
 #include "xla/tsl/lib/core/status_test_util.h"
+#include "xla/tsl/platform/env.h"
 #include "xla/tsl/platform/statusor.h"
+#include "xla/tsl/platform/threadpool.h"
 #include "xla/util.h"
 #include "xla/xla_data.pb.h"
 
@@ -137,9 +141,10 @@ ENTRY %main {
 class RecomputeAndCompressHloRematerializationTest
     : public RematerializationTestBase {
  protected:
-  absl::StatusOr<bool> RunHloRematerialization(int64_t memory_limit_bytes,
-                                               HloModule* module,
-                                               int64_t min_remat_size = 0) {
+  absl::StatusOr<bool> RunHloRematerialization(
+      int64_t memory_limit_bytes, HloModule* module, int64_t min_remat_size = 0,
+      tsl::thread::ThreadPool* thread_pool = nullptr,
+      absl::Duration time_budget = absl::InfiniteDuration()) {
     TF_EXPECT_OK(verifier().Run(module).status());
     if (!module->has_schedule()) {
       HloMemoryScheduler scheduler(
@@ -166,6 +171,8 @@ class RecomputeAndCompressHloRematerializationTest
         min_remat_size, /*compact_shape_function=*/nullptr,
         /*host_memory_offload_config=*/std::nullopt,
         /*async_threads=*/{});
+    options.thread_pool = thread_pool;
+    options.time_budget = time_budget;
     HloRematerialization::RematerializationSizes sizes;
     HloRematerialization remat(options, sizes);
     absl::StatusOr<bool> result = remat.Run(module);
@@ -247,6 +254,48 @@ TEST_F(RecomputeAndCompressHloRematerializationTest, SingleComputation) {
       ::testing::UnitTest::GetInstance()->current_test_info()->name());
 }
 
+// Test that evaluating candidates on a thread pool picks the same
+// rematerialization as SingleComputation.
+TEST_F(RecomputeAndCompressHloRematerializationTest,
+       SingleComputationOnThreadPool) {
+  auto module = CreateNewVerifiedModule();
+  HloComputation* computation =
+      module->AddEntryComputation(MakeRematerializableComputation());
+  const HloInstruction* slice = computation->root_instruction();
+  ASSERT_THAT(slice, op::Slice(op::Concatenate(op::Broadcast(_), _)));
+  const HloInstruction* concat = slice->operand(0);
+  const HloInstruction* bcast = concat->operand(0);
+
+  tsl::thread::ThreadPool thread_pool(tsl::Env::Default(), "remat",
+                                      /*num_threads=*/4);
+  TF_ASSERT_OK_AND_ASSIGN(
+      bool changed,
+      RunHloRematerialization(/*memory_limit_bytes=*/14 * 1024, module.get(),
+                              /*min_remat_size=*/0, &thread_pool));
+  EXPECT_TRUE(changed);
+  EXPECT_EQ(computation->root_instruction(), slice);
+  const HloInstruction* remat_bcast = concat->operand(0);
+  EXPECT_THAT(remat_bcast, op::Broadcast(::testing::Ne(bcast)));
+  EXPECT_EQ(module->schedule()
+                .sequence(computation)
+                .instructions()[computation->instruction_count() - 3],
+            remat_bcast);
+}
+
+// Test that no instructions are rematerialized once the time budget is spent.
+TEST_F(RecomputeAndCompressHloRematerializationTest,
+       SingleComputationWithoutTimeBudget) {
+  auto module = CreateNewVerifiedModule();
+  module->AddEntryComputation(MakeRematerializableComputation());
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      bool changed,
+      RunHloRematerialization(/*memory_limit_bytes=*/14 * 1024, module.get(),
+                              /*min_remat_size=*/0, /*thread_pool=*/nullptr,
+                              /*time_budget=*/absl::ZeroDuration()));
+  EXPECT_FALSE(changed);
+}
+
 // Test rematerialization of a single computation that contains nodes that
 // doesn't contain node worth using remat.
 TEST_F(RecomputeAndCompressHloRematerializationTest,
@@ -1372,9 +1421,9 @@ ENTRY %entry {
 
 class OffloadingRematerializationTest : public RematerializationTestBase {
  protected:
-  absl::StatusOr<bool> RunHloRematerialization(int64_t memory_limit_bytes,
-                                               HloModule* module,
-                                               int64_t min_remat_size = 0) {
+  absl::StatusOr<bool> RunHloRematerialization(
+      int64_t memory_limit_bytes, HloModule* module, int64_t min_remat_size = 0,
+      bool recompute = false, bool minimize_added_time = false) {
     TF_EXPECT_OK(verifier().Run(module).status());
     if (!module->has_schedule()) {
       HloMemoryScheduler scheduler(
@@ -1392,7 +1441,7 @@ class OffloadingRematerializationTest : public RematerializationTestBase {
         transcendentals_per_second_);
     HloCostAnalysis cost_analysis(hlo_cost_analysis_options);
     HloRematerialization::RematerializationModeConfig config(
-        /*recompute=*/false, /*compress=*/false, /*host_offload=*/true);
+        recompute, /*compress=*/false, /*host_offload=*/true);
     HloRematerialization::HostMemoryOffloadConfig host_memory_offload_config(
         kHostMemorySpaceColor, copy_to_host_speed_, copy_from_host_speed_);
     HloRematerialization::Options options(
@@ -1401,6 +1450,7 @@ class OffloadingRematerializationTest : public RematerializationTestBase {
         min_remat_size, /*compact_shape_function=*/nullptr,
         host_memory_offload_config,
         /*async_threads=*/{});
+    options.minimize_added_time = minimize_added_time;
     HloRematerialization::RematerializationSizes sizes;
     HloRematerialization remat(options, sizes);
     return remat.Run(module);
@@ -1541,6 +1591,69 @@ ENTRY MyModule {
               op::Tanh(res_10_matcher));
 }
 
+constexpr absl::string_view kOffloadOrRecomputeHlo = R"(
+HloModule MyModule, is_scheduled=true, entry_computation_layout={(f32[1024]{0}, f32[1024]{0})->f32[1024]{0}}
+
+ENTRY MyModule {
+  param_0 = f32[1024]{0} parameter(0)
+  param_1 = f32[1024]{0} parameter(1)
+  res_3 = f32[1024]{0} add(param_0, param_1)
+  res_4 = f32[1024]{0} tanh(res_3)
+  res_5 = f32[1024]{0} tanh(res_4)
+  res_6 = f32[1024]{0} tanh(res_5)
+  res_7 = f32[1024]{0} add(res_6, res_6)
+  res_8 = f32[1024]{0} add(res_7, res_5)
+  res_9 = f32[1024]{0} add(res_8, res_4)
+  res_10 = f32[1024]{0} add(res_9, res_3)
+  ROOT res_11 = f32[1024]{0} tanh(res_10)
+}
+)";
+
+int64_t CountOpcode(const HloModule& module, HloOpcode opcode) {
+  return absl::c_count_if(
+      module.entry_computation()->instructions(),
+      [&](const HloInstruction* instr) { return instr->opcode() == opcode; });
+}
+
+TEST_F(OffloadingRematerializationTest, PrefersHiddenOffloadOverRecompute) {
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          ParseAndReturnVerifiedModule(kOffloadOrRecomputeHlo));
+
+  // As in BasicSuccessfulHostOffload, the copies can be hidden behind the
+  // compute, while recomputing takes time.
+  SetCopyToHostSpeed(4.0 * 1024);
+  SetCopyFromHostSpeed(4.0 * 1024);
+  SetFlopsPerSecond(2 * 1024);
+  SetTranscendentalsPerSecond(2 * 1024);
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      bool changed,
+      RunHloRematerialization(/*memory_limit_bytes=*/10 * 1024, module.get(),
+                              /*min_remat_size=*/0, /*recompute=*/true,
+                              /*minimize_added_time=*/true));
+  ASSERT_TRUE(changed);
+  EXPECT_GT(CountOpcode(*module, HloOpcode::kCopyStart), 0);
+}
+
+TEST_F(OffloadingRematerializationTest, PrefersRecomputeOverSlowOffload) {
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          ParseAndReturnVerifiedModule(kOffloadOrRecomputeHlo));
+
+  // The copies take far longer than recomputing.
+  SetCopyToHostSpeed(1.0);
+  SetCopyFromHostSpeed(1.0);
+  SetFlopsPerSecond(1024 * 1024 * 1024);
+  SetTranscendentalsPerSecond(1024 * 1024 * 1024);
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      bool changed,
+      RunHloRematerialization(/*memory_limit_bytes=*/10 * 1024, module.get(),
+                              /*min_remat_size=*/0, /*recompute=*/true,
+                              /*minimize_added_time=*/true));
+  ASSERT_TRUE(changed);
+  EXPECT_EQ(CountOpcode(*module, HloOpcode::kCopyStart), 0);
+}
+
 class IndirectUseTest : public RecomputeAndCompressHloRematerializationTest,
                         public ::testing::WithParamInterface<bool> {};
 
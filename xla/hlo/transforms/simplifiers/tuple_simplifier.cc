@@ -18,6 +18,7 @@ limitations under the License.
 #include <cstdint>
 
 #include "absl/container/flat_hash_set.h"
+#include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
 #include "xla/hlo/ir/hlo_computation.h"
@@ -59,63 +60,70 @@ absl::StatusOr<bool> TupleSimplifier::RemoveWholeTuple(HloInstruction* tuple) {
   return changed;
 }
 
+absl::StatusOr<bool> TupleSimplifier::RunOnComputation(
+    HloComputation* computation) {
+  bool changed = false;
+  for (auto* instruction : computation->MakeInstructionPostOrder()) {
+    if (instruction->opcode() == HloOpcode::kTuple) {
+      TF_ASSIGN_OR_RETURN(bool c, RemoveWholeTuple(instruction));
+      changed |= c;
+    } else {
+      auto [ancestor, index] = instruction->LatestNonGteAncestorAndIndex();
+      if (ancestor == instruction) {
+        continue;
+      }
+      // If possible replace a chain of GTE with the operation which produces
+      // the element. For example, replace uses of GTE with below with just
+      // 'Op' (assuming 'Op' is at the index of the GTE instruction):
+      //
+      //     ...  Op ...
+      //       \  |   /
+      //        Tuple
+      //          |
+      //         GTE
+      //         ...
+      //          |
+      //         GTE
+      //          |
+      //         GTE
+      //
+      // Note that this deletes the Tuple instruction altogether. In addition,
+      // if only a subset of tuple's elements are used, this transform
+      // optimizes them one at a time, and after the last use is optimized,
+      // the Tuple will also be deleted.
+      HloInstruction* replacement = ancestor;
+      for (int i = 0; i < index.size(); ++i) {
+        if (replacement->opcode() != HloOpcode::kTuple) {
+          replacement = nullptr;
+          break;
+        }
+        replacement = replacement->mutable_operand(index[i]);
+      }
+
+      if (replacement) {
+        TF_ASSIGN_OR_RETURN(bool replaced,
+                            computation->ReplaceInstruction(
+                                instruction, replacement,
+                                /*preserve_sharding=*/true,
+                                /*relay_control_dependency=*/true));
+        changed |= replaced;
+      }
+    }
+  }
+  return changed;
+}
+
 absl::StatusOr<bool> TupleSimplifier::Run(
     HloModule* module,
     const absl::flat_hash_set<absl::string_view>& execution_threads) {
-  // Initially add all GTE and Tuple instructions to the worklist.
   bool changed = false;
   for (auto* computation : module->computations(execution_threads)) {
     if (exclude_entry_computation_ &&
         computation == module->entry_computation()) {
       continue;
     }
-    for (auto* instruction : computation->MakeInstructionPostOrder()) {
-      if (instruction->opcode() == HloOpcode::kTuple) {
-        TF_ASSIGN_OR_RETURN(bool c, RemoveWholeTuple(instruction));
-        changed |= c;
-      } else {
-        auto [ancestor, index] = instruction->LatestNonGteAncestorAndIndex();
-        if (ancestor == instruction) {
-          continue;
-        }
-        // If possible replace a chain of GTE with the operation which produces
-        // the element. For example, replace uses of GTE with below with just
-        // 'Op' (assuming 'Op' is at the index of the GTE instruction):
-        //
-        //     ...  Op ...
-        //       \  |   /
-        //        Tuple
-        //          |
-        //         GTE
-        //         ...
-        //          |
-        //         GTE
-        //          |
-        //         GTE
-        //
-        // Note that this deletes the Tuple instruction altogether. In addition,
-        // if only a subset of tuple's elements are used, this transform
-        // optimizes them one at a time, and after the last use is optimized,
-        // the Tuple will also be deleted.
-        HloInstruction* replacement = ancestor;
-        for (int i = 0; i < index.size(); ++i) {
-          if (replacement->opcode() != HloOpcode::kTuple) {
-            replacement = nullptr;
-            break;
-          }
-          replacement = replacement->mutable_operand(index[i]);
-        }
-
-        if (replacement) {
-          TF_ASSIGN_OR_RETURN(bool replaced,
-                              computation->ReplaceInstruction(
-                                  instruction, replacement,
-                                  /*preserve_sharding=*/true,
-                                  /*relay_control_dependency=*/true));
-          changed |= replaced;
-        }
-      }
-    }
+    TF_ASSIGN_OR_RETURN(bool c, RunOnComputation(computation));
+    changed |= c;
   }
 
   if (module->has_schedule()) {
@@ -125,4 +133,28 @@ absl::StatusOr<bool> TupleSimplifier::Run(
   return changed;
 }
 
+absl::Status TupleSimplifier::RunOnChangedComputations(
+    HloModule* module, RunState* run_state,
+    const absl::flat_hash_set<absl::string_view>& execution_threads) {
+  bool changed = false;
+  for (auto* computation : module->computations(execution_threads)) {
+    if ((exclude_entry_computation_ &&
+         computation == module->entry_computation()) ||
+        !run_state->changed_last_iteration.contains(computation)) {
+      continue;
+    }
+    TF_ASSIGN_OR_RETURN(bool c, RunOnComputation(computation));
+    if (c) {
+      run_state->changed_this_iteration.insert(computation);
+    }
+    changed |= c;
+  }
+
+  if (changed && module->has_schedule()) {
+    TF_RETURN_IF_ERROR(module->schedule().Update());
+  }
+
+  return absl::OkStatus();
+}
+
 }  // namespace xla
@@ -17,8 +17,10 @@ limitations under the License.
 #define XLA_HLO_TRANSFORMS_SIMPLIFIERS_TUPLE_SIMPLIFIER_H_
 
 #include "absl/container/flat_hash_set.h"
+#include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_computation.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_module.h"
 #include "xla/hlo/pass/hlo_pass_interface.h"
@@ -42,7 +44,18 @@ class TupleSimplifier : public HloModulePass {
       HloModule* module,
       const absl::flat_hash_set<absl::string_view>& execution_threads) override;
 
+  // Tuple simplification only looks inside a computation, so
+  // HloPassFix<TupleSimplifier> only revisits the computations that changed in
+  // the last iteration.
+  absl::Status RunOnChangedComputations(
+      HloModule* module, RunState* run_state,
+      const absl::flat_hash_set<absl::string_view>& execution_threads) override;
+
  private:
+  // Runs tuple simplification on a single computation. Returns whether it was
+  // changed.
+  absl::StatusOr<bool> RunOnComputation(HloComputation* computation);
+
   // When set, this pipeline stage will perform optimization of all computations
   // apart from the module's entry computation. This is used by Graphcore's
   // backend.
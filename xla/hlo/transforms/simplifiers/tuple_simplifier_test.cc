@@ -385,5 +385,53 @@ TEST_F(TupleSimplifierTest, NestedTuple) {
   EXPECT_EQ(module->entry_computation()->root_instruction()->operand(1), gte3);
 }
 
+TEST_F(TupleSimplifierTest, OnlyRevisitsChangedComputations) {
+  constexpr absl::string_view kModuleStr = R"(
+    HloModule m
+
+    callee {
+      p = (f32[], f32[]) parameter(0)
+      gte0 = f32[] get-tuple-element(p), index=0
+      gte1 = f32[] get-tuple-element(p), index=1
+      t = (f32[], f32[]) tuple(gte1, gte0)
+      ROOT gte = f32[] get-tuple-element(t), index=0
+    }
+
+    ENTRY test {
+      p0 = f32[] parameter(0)
+      p1 = f32[] parameter(1)
+      t = (f32[], f32[]) tuple(p0, p1)
+      c = f32[] call(t), to_apply=callee
+      gte = f32[] get-tuple-element(t), index=1
+      ROOT add = f32[] add(c, gte)
+    }
+  )";
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          ParseAndReturnVerifiedModule(kModuleStr));
+  HloComputation* callee = FindComputation(module.get(), "callee");
+
+  // Only the entry computation changed in the last iteration, so the callee is
+  // left alone.
+  TupleSimplifier simplifier;
+  TupleSimplifier::RunState run_state;
+  run_state.changed_last_iteration.insert(module->entry_computation());
+  TF_ASSERT_OK(
+      simplifier.RunOnChangedComputations(module.get(), &run_state, {}));
+  EXPECT_THAT(module->entry_computation()->root_instruction(),
+              op::Add(op::Call(), op::Parameter(1)));
+  EXPECT_THAT(callee->root_instruction(), op::GetTupleElement(op::Tuple()));
+  EXPECT_TRUE(run_state.changed_this_iteration.contains(
+      module->entry_computation()));
+
+  run_state.IncrementIteration();
+  run_state.changed_last_iteration.insert(callee);
+  TF_ASSERT_OK(
+      simplifier.RunOnChangedComputations(module.get(), &run_state, {}));
+  EXPECT_THAT(callee->root_instruction(),
+              op::GetTupleElement(op::Parameter(0), 1));
+  EXPECT_FALSE(run_state.changed_this_iteration.contains(
+      module->entry_computation()));
+}
+
 }  // namespace
 }  // namespace xla
@@ -0,0 +1,97 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/hlo/utils/hlo_fingerprint_cache.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/strings/escaping.h"
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/printer.h"
+#include "tsl/platform/fingerprint.h"
+
+namespace xla {
+namespace {
+
+std::string ToHexString(const tsl::Fprint128& fingerprint) {
+  return absl::BytesToHexString(
+      absl::string_view(reinterpret_cast<const char*>(&fingerprint),
+                        sizeof(tsl::Fprint128)));
+}
+
+}  // namespace
+
+tsl::Fprint128 HloFingerprintCache::GetFingerprint(
+    const HloComputation* computation) {
+  auto it = fingerprints_.find(computation);
+  if (it != fingerprints_.end()) {
+    return it->second;
+  }
+  FingerprintPrinter printer;
+  computation->Print(&printer, options_);
+  tsl::Fprint128 fingerprint = std::move(printer).ToFingerprint();
+  fingerprints_.emplace(computation, fingerprint);
+  return fingerprint;
+}
+
+tsl::Fprint128 HloFingerprintCache::GetFingerprint(const HloModule& module) {
+  tsl::Fprint128 fingerprint = {0, 0};
+  if (module.config().has_entry_computation_layout()) {
+    fingerprint = tsl::FingerprintCat128(
+        fingerprint,
+        tsl::Fingerprint128(module.entry_computation_layout().ToString()));
+  }
+  for (const HloComputation* computation : module.MakeComputationSorted()) {
+    if (computation->IsFusionComputation()) {
+      continue;
+    }
+    fingerprint =
+        tsl::FingerprintCat128(fingerprint, GetFingerprint(computation));
+  }
+  return fingerprint;
+}
+
+std::string HloFingerprintCache::GetFingerprintString(
+    const HloComputation* computation) {
+  return ToHexString(GetFingerprint(computation));
+}
+
+std::string HloFingerprintCache::GetFingerprintString(const HloModule& module) {
+  return ToHexString(GetFingerprint(module));
+}
+
+void HloFingerprintCache::Invalidate(const HloComputation* computation) {
+  // Callers may print the body of the computation, so they are invalidated
+  // too, whether or not the computation itself was fingerprinted.
+  absl::flat_hash_set<const HloComputation*> visited = {computation};
+  std::vector<const HloComputation*> worklist = {computation};
+  while (!worklist.empty()) {
+    const HloComputation* current = worklist.back();
+    worklist.pop_back();
+    fingerprints_.erase(current);
+    for (const auto& [caller, count] : current->caller_computations()) {
+      if (visited.insert(caller).second) {
+        worklist.push_back(caller);
+      }
+    }
+  }
+}
+
+}  // namespace xla
@@ -0,0 +1,70 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_HLO_UTILS_HLO_FINGERPRINT_CACHE_H_
+#define XLA_HLO_UTILS_HLO_FINGERPRINT_CACHE_H_
+
+#include <string>
+
+#include "absl/container/flat_hash_map.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/ir/hlo_print_options.h"
+#include "tsl/platform/fingerprint.h"
+
+namespace xla {
+
+// Caches 128-bit fingerprints of HLO computations, so that code that keys on
+// the same computations many times, like autotuners and compilation caches,
+// prints each of them only once.
+//
+// A computation is fingerprinted by printing it with the options of the cache
+// into a FingerprintPrinter, so two computations have the same fingerprint iff
+// they print the same. The fingerprint of a module combines the fingerprints of
+// its computations.
+//
+// The cache doesn't observe changes to the computations. Callers must
+// Invalidate() the computations they change, which also drops the fingerprints
+// of the computations that call them, as they may print their bodies.
+//
+// Thread-compatible.
+class HloFingerprintCache {
+ public:
+  explicit HloFingerprintCache(
+      HloPrintOptions options = HloPrintOptions::Fingerprint())
+      : options_(options) {}
+
+  tsl::Fprint128 GetFingerprint(const HloComputation* computation);
+
+  // Combines the fingerprints of the computations of `module` that are not
+  // fusion computations, in MakeComputationSorted() order, and the entry
+  // computation layout. Fusion computations are printed by their callers.
+  tsl::Fprint128 GetFingerprint(const HloModule& module);
+
+  // Same as GetFingerprint, as a hex string.
+  std::string GetFingerprintString(const HloComputation* computation);
+  std::string GetFingerprintString(const HloModule& module);
+
+  void Invalidate(const HloComputation* computation);
+  void Clear() { fingerprints_.clear(); }
+
+ private:
+  HloPrintOptions options_;
+  absl::flat_hash_map<const HloComputation*, tsl::Fprint128> fingerprints_;
+};
+
+}  // namespace xla
+
+#endif  // XLA_HLO_UTILS_HLO_FINGERPRINT_CACHE_H_
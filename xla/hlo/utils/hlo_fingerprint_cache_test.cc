@@ -0,0 +1,116 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/hlo/utils/hlo_fingerprint_cache.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <gtest/gtest.h>
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/testlib/hlo_hardware_independent_test_base.h"
+#include "xla/literal_util.h"
+#include "xla/printer.h"
+#include "xla/tsl/lib/core/status_test_util.h"
+#include "tsl/platform/fingerprint.h"
+#include "tsl/platform/statusor.h"
+
+namespace xla {
+namespace {
+
+using HloFingerprintCacheTest = HloHardwareIndependentTestBase;
+
+constexpr absl::string_view kHlo = R"(
+HloModule test
+
+fused_computation {
+  p = s32[8] parameter(0)
+  c = s32[] constant(1)
+  b = s32[8] broadcast(c), dimensions={}
+  ROOT a = s32[8] add(p, b)
+}
+
+ENTRY main {
+  p = s32[8] parameter(0)
+  ROOT f = s32[8] fusion(p), kind=kLoop, calls=fused_computation
+})";
+
+TEST_F(HloFingerprintCacheTest, IdenticalModulesHaveTheSameFingerprint) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module1,
+                          ParseAndReturnVerifiedModule(kHlo));
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module2,
+                          ParseAndReturnVerifiedModule(kHlo));
+  HloFingerprintCache cache;
+  EXPECT_EQ(cache.GetFingerprint(*module1), cache.GetFingerprint(*module2));
+  EXPECT_EQ(cache.GetFingerprintString(*module1),
+            cache.GetFingerprintString(*module2));
+  EXPECT_EQ(cache.GetFingerprint(module1->entry_computation()),
+            cache.GetFingerprint(module2->entry_computation()));
+}
+
+TEST_F(HloFingerprintCacheTest, InvalidatingACalleeInvalidatesItsCallers) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(kHlo));
+  HloFingerprintCache cache;
+  const tsl::Fprint128 entry_fingerprint =
+      cache.GetFingerprint(module->entry_computation());
+  const tsl::Fprint128 module_fingerprint = cache.GetFingerprint(*module);
+
+  HloComputation* fused_computation =
+      module->GetComputationWithName("fused_computation");
+  ASSERT_NE(fused_computation, nullptr);
+  HloInstruction* constant = fused_computation->GetInstructionWithName("c");
+  TF_ASSERT_OK(fused_computation->ReplaceWithNewInstruction(
+      constant,
+      HloInstruction::CreateConstant(LiteralUtil::CreateR0<int32_t>(2))));
+
+  // The cache doesn't observe the change.
+  EXPECT_EQ(cache.GetFingerprint(module->entry_computation()),
+            entry_fingerprint);
+
+  cache.Invalidate(fused_computation);
+  HloFingerprintCache fresh_cache;
+  EXPECT_EQ(cache.GetFingerprint(module->entry_computation()),
+            fresh_cache.GetFingerprint(module->entry_computation()));
+  EXPECT_FALSE(cache.GetFingerprint(module->entry_computation()) ==
+               entry_fingerprint);
+  EXPECT_FALSE(cache.GetFingerprint(*module) == module_fingerprint);
+}
+
+TEST(FingerprintPrinterTest, DependsOnlyOnThePrintedText) {
+  const std::string text(100000, 'x');
+  FingerprintPrinter whole;
+  whole.Append(text);
+  FingerprintPrinter pieces;
+  for (size_t i = 0; i < text.size(); i += 7) {
+    pieces.Append(absl::string_view(text).substr(i, 7));
+  }
+  FingerprintPrinter other;
+  other.Append(text);
+  other.Append("y");
+
+  const tsl::Fprint128 whole_fingerprint = std::move(whole).ToFingerprint();
+  EXPECT_EQ(std::move(pieces).ToFingerprint(), whole_fingerprint);
+  EXPECT_FALSE(std::move(other).ToFingerprint() == whole_fingerprint);
+}
+
+}  // namespace
+}  // namespace xla
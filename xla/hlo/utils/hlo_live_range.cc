@@ -25,6 +25,7 @@ limitations under the License.
 #include <vector>
 
 #include "absl/algorithm/container.h"
+#include "absl/log/check.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_format.h"
@@ -37,9 +38,23 @@ limitations under the License.
 #include "xla/service/hlo_buffer.h"
 #include "xla/service/hlo_value.h"
 #include "xla/shape_util.h"
+#include "xla/tsl/platform/statusor.h"
 #include "tsl/platform/logging.h"
 
 namespace xla {
+namespace {
+
+// Returns the higher of two peaks, or the earlier one if they are as high.
+HloLiveRangeIndex::PeakMemory MaxPeakMemory(
+    const HloLiveRangeIndex::PeakMemory& a,
+    const HloLiveRangeIndex::PeakMemory& b) {
+  if (a.bytes != b.bytes) {
+    return a.bytes > b.bytes ? a : b;
+  }
+  return a.time <= b.time ? a : b;
+}
+
+}  // namespace
 /*static*/
 absl::StatusOr<std::unique_ptr<HloLiveRange>> HloLiveRange::Run(
     const HloSchedule& schedule, const HloAliasAnalysis& alias_analysis,
@@ -87,11 +102,13 @@ void HloLiveRange::FlattenSchedule(const HloComputation& computation,
   auto it = schedule_.sequences().find(computation.unique_id());
   if (it == schedule_.sequences().end()) {
     total_order_scheduled_ = false;
+    flattened_sequence_ids_.try_emplace(computation.unique_id());
     return;
   }
 
   // Check if we've already processed this computation.
   if (computation_span_times_.contains(&computation)) return;
+  flattened_sequence_ids_[computation.unique_id()] = it->second.ids();
 
   // Mark this computation into the async context, if available.
   if (async_context != nullptr) {
@@ -292,6 +309,17 @@ int64_t HloLiveRange::ComputePeakMemoryMoment() const {
   return peak_time.value_or(0);
 }
 
+bool HloLiveRange::IsUpToDate() const {
+  for (const auto& [computation_id, ids] : flattened_sequence_ids_) {
+    auto it = schedule_.sequences().find(computation_id);
+    if (it == schedule_.sequences().end() ? !ids.empty()
+                                          : it->second.ids() != ids) {
+      return false;
+    }
+  }
+  return true;
+}
+
 std::string HloLiveRange::ToString() const {
   std::string output;
   absl::StrAppendFormat(&output, "HloLiveRange (max %d):\n",
@@ -331,4 +359,121 @@ std::string HloLiveRange::ToString() const {
   return output;
 }
 
+HloLiveRangeIndex::HloLiveRangeIndex(const HloLiveRange& live_range,
+                                     const SizeFunction& size_fn)
+    : num_times_(live_range.schedule_end_time() + 1),
+      peak_memory_(2 * num_times_) {
+  // Every live range is stored at the O(log n) nodes that cover it.
+  std::vector<std::pair<int64_t, const HloValue*>> node_values;
+  std::vector<int64_t> usage_deltas(num_times_ + 1, 0);
+  for (const auto& [value, time_bound] : live_range.buffer_live_ranges()) {
+    LogicalTime start = std::max<LogicalTime>(time_bound.start, 0);
+    LogicalTime end = std::min(time_bound.end, num_times_ - 1);
+    if (start > end) {
+      continue;
+    }
+    for (int64_t lo = start + num_times_, hi = end + 1 + num_times_; lo < hi;
+         lo /= 2, hi /= 2) {
+      if (lo & 1) {
+        node_values.push_back({lo++, value});
+      }
+      if (hi & 1) {
+        node_values.push_back({--hi, value});
+      }
+    }
+    int64_t size = size_fn(*value);
+    usage_deltas[start] += size;
+    usage_deltas[end + 1] -= size;
+  }
+
+  live_values_offsets_.assign(2 * num_times_ + 1, 0);
+  for (const auto& [node, value] : node_values) {
+    ++live_values_offsets_[node + 1];
+  }
+  for (int64_t node = 0; node < 2 * num_times_; ++node) {
+    live_values_offsets_[node + 1] += live_values_offsets_[node];
+  }
+  live_values_.resize(node_values.size());
+  std::vector<int64_t> next_offsets(live_values_offsets_.begin(),
+                                    live_values_offsets_.end() - 1);
+  for (const auto& [node, value] : node_values) {
+    live_values_[next_offsets[node]++] = value;
+  }
+
+  int64_t usage = 0;
+  for (LogicalTime time = 0; time < num_times_; ++time) {
+    usage += usage_deltas[time];
+    peak_memory_[num_times_ + time] = {usage, time};
+  }
+  for (int64_t node = num_times_ - 1; node > 0; --node) {
+    peak_memory_[node] =
+        MaxPeakMemory(peak_memory_[2 * node], peak_memory_[2 * node + 1]);
+  }
+}
+
+std::vector<const HloValue*> HloLiveRangeIndex::ValuesLiveAt(
+    LogicalTime time) const {
+  CHECK_GE(time, 0);
+  CHECK_LT(time, num_times_);
+  std::vector<const HloValue*> values;
+  for (int64_t node = time + num_times_; node > 0; node /= 2) {
+    values.insert(values.end(),
+                  live_values_.begin() + live_values_offsets_[node],
+                  live_values_.begin() + live_values_offsets_[node + 1]);
+  }
+  absl::c_sort(values, HloValue::IdLessThan);
+  return values;
+}
+
+int64_t HloLiveRangeIndex::MemoryUsageAt(LogicalTime time) const {
+  CHECK_GE(time, 0);
+  CHECK_LT(time, num_times_);
+  return peak_memory_[time + num_times_].bytes;
+}
+
+HloLiveRangeIndex::PeakMemory HloLiveRangeIndex::PeakMemoryIn(
+    LogicalTime start, LogicalTime end) const {
+  CHECK_GE(start, 0);
+  CHECK_LE(start, end);
+  CHECK_LT(end, num_times_);
+  PeakMemory peak = peak_memory_[start + num_times_];
+  for (int64_t lo = start + num_times_, hi = end + 1 + num_times_; lo < hi;
+       lo /= 2, hi /= 2) {
+    if (lo & 1) {
+      peak = MaxPeakMemory(peak, peak_memory_[lo++]);
+    }
+    if (hi & 1) {
+      peak = MaxPeakMemory(peak, peak_memory_[--hi]);
+    }
+  }
+  return peak;
+}
+
+int64_t HloLiveRangeIndex::DefaultSize(const HloValue& value) {
+  return ShapeUtil::ByteSizeOf(value.shape(), /*pointer_size=*/8);
+}
+
+absl::StatusOr<const HloLiveRange*> HloLiveRangeCache::Get(
+    const HloComputation* computation, bool module_scoped_analysis) {
+  Entry& entry = entries_[{computation, module_scoped_analysis}];
+  if (entry.live_range == nullptr || !entry.live_range->IsUpToDate()) {
+    entry.index = nullptr;
+    TF_ASSIGN_OR_RETURN(entry.live_range,
+                        HloLiveRange::Run(schedule_, alias_analysis_,
+                                          computation, module_scoped_analysis));
+  }
+  return entry.live_range.get();
+}
+
+absl::StatusOr<const HloLiveRangeIndex*> HloLiveRangeCache::GetIndex(
+    const HloComputation* computation, bool module_scoped_analysis) {
+  TF_ASSIGN_OR_RETURN(const HloLiveRange* live_range,
+                      Get(computation, module_scoped_analysis));
+  Entry& entry = entries_.at({computation, module_scoped_analysis});
+  if (entry.index == nullptr) {
+    entry.index = std::make_unique<HloLiveRangeIndex>(*live_range);
+  }
+  return entry.index.get();
+}
+
 }  // namespace xla
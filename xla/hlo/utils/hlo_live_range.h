@@ -16,8 +16,11 @@ the License.
 #define XLA_HLO_UTILS_HLO_LIVE_RANGE_H_
 
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/status/statusor.h"
@@ -99,6 +102,11 @@ class HloLiveRange {
   // range is not available if the module is partially ordered.
   bool total_order_scheduled() const { return total_order_scheduled_; }
 
+  // Returns whether the schedule still orders every computation flattened into
+  // this live range as it did when the live range was computed. Takes time
+  // linear in the length of the flattened schedule.
+  bool IsUpToDate() const;
+
  private:
   explicit HloLiveRange(const HloSchedule& schedule,
                         const HloAliasAnalysis& alias_analysis,
@@ -221,6 +229,80 @@ class HloLiveRange {
   absl::flat_hash_map<const HloValue*, TimeBound> buffer_live_ranges_;
   absl::flat_hash_map<const HloComputation*, const HloComputation*>
       computations_in_async_context_;
+  // The instruction ids of the schedule sequence of each flattened computation,
+  // keyed by computation unique id. Empty for unscheduled computations.
+  absl::flat_hash_map<int64_t, std::vector<int>> flattened_sequence_ids_;
+};
+
+// Answers queries about the values live at a time, and the memory they use, in
+// logarithmic time in the length of the schedule of an HloLiveRange.
+class HloLiveRangeIndex {
+ public:
+  using LogicalTime = HloLiveRange::LogicalTime;
+  using SizeFunction = std::function<int64_t(const HloValue&)>;
+
+  struct PeakMemory {
+    int64_t bytes = 0;
+    // The earliest time the peak is reached at.
+    LogicalTime time = 0;
+  };
+
+  // Sizes the values with `size_fn`, by default the byte size of their shape
+  // with 8-byte pointers. The live range must outlive the index.
+  explicit HloLiveRangeIndex(const HloLiveRange& live_range,
+                             const SizeFunction& size_fn = DefaultSize);
+
+  // Returns the values live at `time`, ordered by id.
+  std::vector<const HloValue*> ValuesLiveAt(LogicalTime time) const;
+
+  // Returns the total size of the values live at `time`.
+  int64_t MemoryUsageAt(LogicalTime time) const;
+
+  // Returns the highest memory usage at any time in [start, end].
+  PeakMemory PeakMemoryIn(LogicalTime start, LogicalTime end) const;
+
+ private:
+  static int64_t DefaultSize(const HloValue& value);
+
+  // The number of logical times, schedule_end_time() + 1 since values live out
+  // of the schedule end at schedule_end_time().
+  int64_t num_times_;
+  // Segment trees over [0, num_times_) with leaves at [num_times_,
+  // 2 * num_times_). The values of every node are stored contiguously in
+  // live_values_, starting at live_values_offsets_[node].
+  std::vector<int64_t> live_values_offsets_;
+  std::vector<const HloValue*> live_values_;
+  std::vector<PeakMemory> peak_memory_;
+};
+
+// Shares the live ranges of the computations of a module between their users,
+// e.g. passes that run one after the other. A live range is recomputed when the
+// schedule of a computation flattened into it changed since it was computed.
+// The alias analysis must stay valid for the lifetime of the cache.
+class HloLiveRangeCache {
+ public:
+  HloLiveRangeCache(const HloSchedule& schedule,
+                    const HloAliasAnalysis& alias_analysis)
+      : schedule_(schedule), alias_analysis_(alias_analysis) {}
+
+  // Returns the live range of `computation`. The result is invalidated by the
+  // next call for the same computation after a schedule change.
+  absl::StatusOr<const HloLiveRange*> Get(const HloComputation* computation,
+                                          bool module_scoped_analysis = true);
+
+  // Returns an index, with default sizes, over the live range returned by Get.
+  absl::StatusOr<const HloLiveRangeIndex*> GetIndex(
+      const HloComputation* computation, bool module_scoped_analysis = true);
+
+ private:
+  struct Entry {
+    std::unique_ptr<HloLiveRange> live_range;
+    std::unique_ptr<HloLiveRangeIndex> index;
+  };
+
+  const HloSchedule& schedule_;
+  const HloAliasAnalysis& alias_analysis_;
+  absl::flat_hash_map<std::pair<const HloComputation*, bool>, Entry> entries_;
 };
 
 }  // namespace xla
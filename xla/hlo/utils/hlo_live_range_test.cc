@@ -21,8 +21,10 @@ limitations under the License.
 #include <utility>
 #include <vector>
 
+#include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
 #include "xla/comparison_util.h"
 #include "xla/hlo/analysis/hlo_alias_analysis.h"
 #include "xla/hlo/ir/hlo_computation.h"
@@ -520,5 +522,71 @@ TEST_F(HloLiveRangeTest, Call) {
   EXPECT_EQ(inst_ranges["e"], std::make_pair(6, 7));
 }
 
+constexpr absl::string_view kIndependentNegatesHlo = R"(
+    HloModule IndependentNegates, is_scheduled=true
+
+    ENTRY %main (a: f32[4]) -> f32[4] {
+      %a = f32[4]{0} parameter(0)
+      %b = f32[4]{0} negate(%a)
+      %c = f32[4]{0} exponential(%a)
+      ROOT %d = f32[4]{0} add(%b, %c)
+    })";
+
+TEST_F(HloLiveRangeTest, IndexQueries) {
+  TF_ASSERT_OK_AND_ASSIGN(module_,
+                          ParseAndReturnVerifiedModule(kIndependentNegatesHlo));
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloAliasAnalysis> aa,
+                          HloAliasAnalysis::Run(module_.get()));
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloLiveRange> hlo_live_range,
+                          HloLiveRange::Run(module_->schedule(), *aa,
+                                            module_->entry_computation()));
+  HloLiveRangeIndex index(*hlo_live_range);
+
+  // a: [0, 4], b: [1, 3], c: [2, 3], d: [3, 4], 16 bytes each.
+  std::vector<std::string> live_at_2;
+  for (const HloValue* value : index.ValuesLiveAt(2)) {
+    live_at_2.push_back(value->instruction()->name());
+  }
+  EXPECT_THAT(live_at_2, ::testing::UnorderedElementsAre("a", "b", "c"));
+  EXPECT_EQ(index.MemoryUsageAt(0), 16);
+  EXPECT_EQ(index.MemoryUsageAt(4), 32);
+
+  HloLiveRangeIndex::PeakMemory peak = index.PeakMemoryIn(0, 4);
+  EXPECT_EQ(peak.bytes, 64);
+  EXPECT_EQ(peak.time, 3);
+  peak = index.PeakMemoryIn(0, 2);
+  EXPECT_EQ(peak.bytes, 48);
+  EXPECT_EQ(peak.time, 2);
+}
+
+TEST_F(HloLiveRangeTest, CacheRecomputesAfterScheduleChange) {
+  TF_ASSERT_OK_AND_ASSIGN(module_,
+                          ParseAndReturnVerifiedModule(kIndependentNegatesHlo));
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloAliasAnalysis> aa,
+                          HloAliasAnalysis::Run(module_.get()));
+  HloComputation* entry = module_->entry_computation();
+  HloInstruction* a = FindInstruction(module_.get(), "a");
+  HloInstruction* b = FindInstruction(module_.get(), "b");
+  HloInstruction* c = FindInstruction(module_.get(), "c");
+  HloInstruction* d = FindInstruction(module_.get(), "d");
+  HloLiveRangeCache cache(module_->schedule(), *aa);
+
+  TF_ASSERT_OK_AND_ASSIGN(const HloLiveRange* live_range, cache.Get(entry));
+  TF_ASSERT_OK_AND_ASSIGN(const HloLiveRange* cached_live_range,
+                          cache.Get(entry));
+  EXPECT_EQ(live_range, cached_live_range);
+  EXPECT_EQ(live_range->instruction_schedule().at(b), 1);
+
+  module_->schedule().set_sequence(entry, {a, c, b, d});
+  EXPECT_FALSE(live_range->IsUpToDate());
+
+  TF_ASSERT_OK_AND_ASSIGN(live_range, cache.Get(entry));
+  EXPECT_TRUE(live_range->IsUpToDate());
+  EXPECT_EQ(live_range->instruction_schedule().at(b), 2);
+  TF_ASSERT_OK_AND_ASSIGN(const HloLiveRangeIndex* index,
+                          cache.GetIndex(entry));
+  EXPECT_EQ(index->PeakMemoryIn(0, 4).bytes, 64);
+}
+
 }  // namespace
 }  // namespace xla
@@ -16,6 +16,8 @@ limitations under the License.
 #include "xla/literal.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <complex>
 #include <cstdint>
 #include <cstring>
@@ -303,6 +305,18 @@ Literal::Literal(const Shape& shape, bool allocate_arrays,
   SetPiece(*shape_, &root_piece_, allocate_arrays, leaf_array_value_state);
 }
 
+Literal Literal::CreateFromSharedBuffer(const Shape& shape,
+                                        std::shared_ptr<const void> owner,
+                                        const void* data) {
+  CHECK(LayoutUtil::IsDenseArray(shape))
+      << "shared literal buffers are only supported for dense arrays: "
+      << shape;
+  Literal literal(shape, /*allocate_arrays=*/false);
+  literal.root_piece_.set_shared_buffer(
+      std::move(owner), static_cast<char*>(const_cast<void*>(data)));
+  return literal;
+}
+
 Literal::~Literal() { DeallocateBuffers(); }
 
 void Literal::DeallocateBuffers() {
@@ -585,6 +599,108 @@ std::vector<Literal> Literal::DecomposeTuple() {
 
 namespace {
 
+// Literals are split into partitions of at least this many elements when they
+// are copied, converted or compared in parallel.
+constexpr int64_t kMinElementsPerPartition = 64 * 1024;
+
+// Calls `fn` on consecutive [start, end) partitions of [0, num_elements), in
+// parallel when there is enough work for more than one partition. Returns false
+// if `fn` returned false for any partition.
+bool ForEachPartition(int64_t num_elements,
+                      absl::FunctionRef<bool(int64_t, int64_t)> fn) {
+  const int64_t num_partitions = std::min<int64_t>(
+      tsl::MathUtil::CeilOfRatio(num_elements, kMinElementsPerPartition),
+      ShapeUtil::GetForEachIndexParallelThreadCount());
+  if (num_partitions <= 1) {
+    return fn(0, num_elements);
+  }
+  const int64_t partition_size =
+      tsl::MathUtil::CeilOfRatio(num_elements, num_partitions);
+
+  std::atomic<bool> result = true;
+  // We create a fake shape of the work, so we can rely on the existing
+  // `ForEachIndexParallel` implementation.
+  Shape work_shape = ShapeUtil::MakeShape(S64, {num_partitions});
+  ShapeUtil::ForEachIndexParallel(
+      work_shape,
+      [&](absl::Span<const int64_t> partition_index,
+          int thread_id) -> absl::StatusOr<bool> {
+        int64_t start = partition_index[0] * partition_size;
+        int64_t end = std::min(start + partition_size, num_elements);
+        if (result.load(std::memory_order_relaxed) && !fn(start, end)) {
+          result.store(false, std::memory_order_relaxed);
+        }
+        return true;
+      });
+  return result.load();
+}
+
+// Calls `fn(linear_index, other_linear_index)` for the elements of `shape` in
+// the [start, end) range of linear indices, where `other_linear_index` is the
+// linear index of the same element in `other_shape`. Instead of converting
+// every multidimensional index, only the linear index into `other_shape` is
+// updated as the index is bumped in the physical order of `shape`. Stops and
+// returns false as soon as `fn` returns false.
+template <typename Fn>
+bool ForEachLinearIndexPair(const Shape& shape, const Shape& other_shape,
+                            int64_t start, int64_t end, Fn&& fn) {
+  if (start == end) {
+    return true;
+  }
+  const int64_t rank = shape.dimensions_size();
+  if (rank == 0) {
+    return fn(0, 0);
+  }
+
+  // Strides of the logical dimensions in `other_shape`, in elements.
+  DimensionVector other_strides(rank);
+  int64_t stride = 1;
+  for (int64_t dim : other_shape.layout().minor_to_major()) {
+    other_strides[dim] = stride;
+    stride *= other_shape.dimensions(dim);
+  }
+
+  std::vector<int64_t> index =
+      IndexUtil::LinearIndexToMultidimensionalIndex(shape, start);
+  int64_t other_linear_index = 0;
+  for (int64_t dim = 0; dim < rank; ++dim) {
+    other_linear_index += index[dim] * other_strides[dim];
+  }
+
+  absl::Span<const int64_t> minor_to_major = shape.layout().minor_to_major();
+  const int64_t minor_dim = minor_to_major[0];
+  const int64_t minor_size = shape.dimensions(minor_dim);
+  const int64_t minor_stride = other_strides[minor_dim];
+
+  for (int64_t linear_index = start; linear_index < end;) {
+    // Visit the remaining elements along the most minor dimension first.
+    const int64_t count =
+        std::min(minor_size - index[minor_dim], end - linear_index);
+    for (int64_t i = 0; i < count; ++i) {
+      if (!fn(linear_index + i, other_linear_index + i * minor_stride)) {
+        return false;
+      }
+    }
+    linear_index += count;
+    other_linear_index += count * minor_stride;
+    index[minor_dim] += count;
+
+    // Carry the overflowing dimensions into the more major ones.
+    for (int64_t i = 0; i + 1 < rank; ++i) {
+      const int64_t dim = minor_to_major[i];
+      if (index[dim] < shape.dimensions(dim)) {
+        break;
+      }
+      other_linear_index -= index[dim] * other_strides[dim];
+      index[dim] = 0;
+      const int64_t next_dim = minor_to_major[i + 1];
+      ++index[next_dim];
+      other_linear_index += other_strides[next_dim];
+    }
+  }
+  return true;
+}
+
 // Copies the elements in 'src' to 'dest'. The shape and layout of the data in
 // the array slices are indicated by dest_shape and src_shape respectively.
 template <typename NativeT>
@@ -597,11 +713,15 @@ void CopyElementsBetween(absl::Span<NativeT> dest,
   if (ShapeUtil::IsZeroElementArray(dest_shape)) {
     return;
   }
-  std::vector<int64_t> index(dest_shape.dimensions_size());
-  do {
-    dest[IndexUtil::MultidimensionalIndexToLinearIndex(dest_shape, index)] =
-        src[IndexUtil::MultidimensionalIndexToLinearIndex(src_shape, index)];
-  } while (IndexUtil::BumpIndices(dest_shape, absl::MakeSpan(index)));
+  ForEachPartition(ShapeUtil::ElementsIn(dest_shape),
+                   [&](int64_t start, int64_t end) {
+                     return ForEachLinearIndexPair(
+                         dest_shape, src_shape, start, end,
+                         [&](int64_t dest_index, int64_t src_index) {
+                           dest[dest_index] = src[src_index];
+                           return true;
+                         });
+                   });
 }
 }  // namespace
 
@@ -636,6 +756,8 @@ void LiteralBase::Piece::DeallocateBuffers() {
   if (auto* array_rep = storage_.GetDenseRep()) {
     tsl::port::AlignedFree(array_rep->data);
     storage_.Emplace<Uninitialized>();
+  } else if (storage_.Isa<SharedDenseRep>()) {
+    storage_.Emplace<Uninitialized>();
   }
 }
 
@@ -1116,7 +1238,7 @@ absl::StatusOr<Literal> BroadcastHelper(const LiteralBase& src,
   auto src_minor_to_major = LayoutUtil::MinorToMajor(src_shape);
   auto result_minor_to_major = LayoutUtil::MinorToMajor(result_shape);
 
-  ShapeUtil::ForEachIndex(src_shape, [&](absl::Span<const int64_t> src_index) {
+  auto broadcast_element = [&](absl::Span<const int64_t> src_index) {
     // Linear index into the source literal.
     size_t src_linear_index = IndexUtil::MultidimensionalIndexToLinearIndex(
         src_shape, src_minor_to_major, src_index);
@@ -1144,7 +1266,19 @@ absl::StatusOr<Literal> BroadcastHelper(const LiteralBase& src,
     } while (IndexUtil::BumpIndices(broadcast_shape, broadcast_index_span));
 
     return true;
-  });
+  };
+
+  // Each source element is copied to a disjoint set of result elements, so the
+  // source elements can be visited in parallel when the result is large.
+  constexpr int64_t kMinParallelBroadcastElements = int64_t{1} << 16;
+  if (ShapeUtil::ElementsIn(result_shape) >= kMinParallelBroadcastElements) {
+    ShapeUtil::ForEachIndexParallel(
+        src_shape, [&](absl::Span<const int64_t> src_index, int /*thread_id*/) {
+          return broadcast_element(src_index);
+        });
+  } else {
+    ShapeUtil::ForEachIndex(src_shape, broadcast_element);
+  }
 
   return result;
 }
@@ -1754,9 +1888,33 @@ void ConvertBetweenNativeTypes(absl::Span<const NativeSrcT> src_data,
   };
 
   NativeDestT* dest_data = static_cast<NativeDestT*>(dst_base);
-  for (const NativeSrcT& src : src_data) {
-    *(dest_data++) = converter(src);
+
+  // There are only 256 values of a one byte type (e.g. s8 or any f8 type), so
+  // for large literals it is cheaper to convert all of them once and look up
+  // the results. Bools are skipped, as only two bit patterns of them are valid.
+  if constexpr (sizeof(NativeSrcT) == 1 && !std::is_same_v<NativeSrcT, bool>) {
+    if (src_data.size() > 1024) {
+      std::array<NativeDestT, 256> table;
+      for (int i = 0; i < 256; ++i) {
+        table[i] =
+            converter(absl::bit_cast<NativeSrcT>(static_cast<uint8_t>(i)));
+      }
+      ForEachPartition(src_data.size(), [&](int64_t start, int64_t end) {
+        for (int64_t i = start; i < end; ++i) {
+          dest_data[i] = table[absl::bit_cast<uint8_t>(src_data[i])];
+        }
+        return true;
+      });
+      return;
+    }
   }
+
+  ForEachPartition(src_data.size(), [&](int64_t start, int64_t end) {
+    for (int64_t i = start; i < end; ++i) {
+      dest_data[i] = converter(src_data[i]);
+    }
+    return true;
+  });
 }
 
 template <PrimitiveType kSrcType>
@@ -1947,6 +2105,28 @@ bool LiteralBase::Piece::EqualElements(const LiteralBase::Piece& other) const {
     return memcmp(buffer(), other.buffer(), size_bytes_dense()) == 0;
   }
 
+  // Static arrays with different layouts are compared in the physical order of
+  // this array, without converting every multidimensional index.
+  if (subshape().is_static() && other.subshape().is_static() &&
+      LayoutUtil::IsDenseArray(subshape()) &&
+      LayoutUtil::IsDenseArray(other.subshape())) {
+    return primitive_util::ArrayTypeSwitch<bool>(
+        [&](auto primitive_type_constant) -> bool {
+          using NativeT = NativeTypeOf<primitive_type_constant>;
+          absl::Span<const NativeT> data = this->data<NativeT>();
+          absl::Span<const NativeT> other_data = other.data<NativeT>();
+          return ForEachPartition(
+              data.size(), [&](int64_t start, int64_t end) {
+                return ForEachLinearIndexPair(
+                    subshape(), other.subshape(), start, end,
+                    [&](int64_t index, int64_t other_index) {
+                      return data[index] == other_data[other_index];
+                    });
+              });
+        },
+        subshape().element_type());
+  }
+
   std::vector<int64_t> multi_index;
   return primitive_util::ArrayTypeSwitch<bool>(
       [&](auto primitive_type_constant) -> bool {
@@ -2729,6 +2909,11 @@ int64_t LiteralBase::size_bytes(const ShapeIndex& shape_index) const {
   return piece(shape_index).size_bytes_dense();
 }
 
+std::shared_ptr<const void> LiteralBase::shared_buffer_owner(
+    const ShapeIndex& shape_index) const {
+  return piece(shape_index).shared_buffer_owner();
+}
+
 std::string LiteralBase::GetR1U8AsString() const {
   CHECK(shape().IsArray());
   CHECK_EQ(shape().dimensions_size(), 1);
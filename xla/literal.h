@@ -110,6 +110,12 @@ class LiteralBase {
   const void* untyped_data(const ShapeIndex& shape_index = {}) const;
   int64_t size_bytes(const ShapeIndex& shape_index = {}) const;
 
+  // Returns the owner of the buffer holding the array at the given shape index
+  // if the buffer is shared (see Literal::CreateFromSharedBuffer), or nullptr
+  // if the buffer belongs to the literal.
+  std::shared_ptr<const void> shared_buffer_owner(
+      const ShapeIndex& shape_index = {}) const;
+
   // Computes the size in bytes of the output of the Serialize method.
   absl::StatusOr<int64_t> SerializedSize() const {
     return ShapeUtil::SerializedSize(shape());
@@ -868,11 +874,29 @@ class LiteralBase {
       DCHECK(LayoutUtil::IsDenseArray(*subshape_));
       storage_.Emplace<DenseRep>(buffer);
     }
+    // Sets a buffer that is kept alive by `owner` instead of being freed by
+    // the piece.
+    void set_shared_buffer(std::shared_ptr<const void> owner, char* buffer) {
+      DCHECK(LayoutUtil::IsDenseArray(*subshape_));
+      DCHECK_EQ(reinterpret_cast<uintptr_t>(buffer) % kMinimumAlignment, 0);
+      storage_.Emplace<SharedDenseRep>(std::move(owner), buffer);
+    }
+    // Returns the owner of the buffer, or nullptr if the buffer is not shared.
+    std::shared_ptr<const void> shared_buffer_owner() const {
+      if (auto* shared_rep = storage_.GetSharedDenseRep()) {
+        return shared_rep->owner;
+      }
+      return nullptr;
+    }
     void MoveDataFrom(Piece& from) {
       DCHECK(!storage_.Isa<DenseRep>());
+      DCHECK(!storage_.Isa<SharedDenseRep>());
       DCHECK(!storage_.Isa<TupleRep>());
       if (auto* dense_rep = from.storage_.GetDenseRep()) {
         storage_.Emplace<DenseRep>(dense_rep->data);
+      } else if (auto* shared_rep = from.storage_.GetSharedDenseRep()) {
+        storage_.Emplace<SharedDenseRep>(std::move(shared_rep->owner),
+                                         shared_rep->data);
       } else if (auto* inlined_rep = from.storage_.GetDenseInlinedRep()) {
         storage_.Emplace<DenseInlinedRep>(inlined_rep->data,
                                           from.total_bytes_dense());
@@ -1088,6 +1112,17 @@ class LiteralBase {
       char* data = nullptr;
     };
 
+    // Out of line dense array storage owned by someone else, e.g. a
+    // memory-mapped file, which `owner` keeps alive.
+    struct SharedDenseRep {
+      SharedDenseRep() = default;
+      SharedDenseRep(std::shared_ptr<const void> owner, char* data)
+          : owner(std::move(owner)), data(data) {}
+
+      std::shared_ptr<const void> owner;
+      char* data = nullptr;
+    };
+
     // Inlined dense array storage.
     struct DenseInlinedRep {
       DenseInlinedRep() = default;
@@ -1128,6 +1163,7 @@ class LiteralBase {
       Rep& Emplace(Args... args) {
         Rep& emplaced = rep_.emplace<Rep>(std::forward<Args>(args)...);
         if constexpr (std::is_same_v<Rep, DenseRep> ||
+                      std::is_same_v<Rep, SharedDenseRep> ||
                       std::is_same_v<Rep, DenseInlinedRep>) {
           data_ = emplaced.data;
         } else {
@@ -1150,6 +1186,14 @@ class LiteralBase {
 
       DenseRep* GetDenseRep() { return std::get_if<DenseRep>(&rep_); }
 
+      const SharedDenseRep* GetSharedDenseRep() const {
+        return std::get_if<SharedDenseRep>(&rep_);
+      }
+
+      SharedDenseRep* GetSharedDenseRep() {
+        return std::get_if<SharedDenseRep>(&rep_);
+      }
+
       const TupleRep* GetTupleRep() const {
         return std::get_if<TupleRep>(&rep_);
       }
@@ -1169,11 +1213,14 @@ class LiteralBase {
      private:
       const char* dense_data() const {
         if (auto* rep = GetDenseRep()) return rep->data;
+        if (auto* rep = GetSharedDenseRep()) return rep->data;
         if (auto* rep = GetDenseInlinedRep()) return rep->data;
         return nullptr;
       }
 
-      std::variant<Uninitialized, TupleRep, DenseRep, DenseInlinedRep> rep_;
+      std::variant<Uninitialized, TupleRep, DenseRep, SharedDenseRep,
+                   DenseInlinedRep>
+          rep_;
       char* data_ = nullptr;  // cached `rep_.data` value for dense reps
     };
 
@@ -1545,6 +1592,16 @@ class Literal : public MutableLiteralBase {
           ArrayValueState leaf_array_value_state = ArrayValueState::kKnown);
   Literal& operator=(Literal&& other);
 
+  // Creates a dense array literal of the given shape whose data is the buffer
+  // at `data`, without copying it. `data` must be 64-byte aligned, and is kept
+  // alive by `owner` for as long as the literal (or a literal its buffer is
+  // moved to) refers to it, e.g. to use a memory-mapped file region as the
+  // literal. If the buffer is read-only the literal must not be mutated; Clone
+  // it first.
+  static Literal CreateFromSharedBuffer(const Shape& shape,
+                                        std::shared_ptr<const void> owner,
+                                        const void* data);
+
   // Similar to CopyFrom, but with move semantics. The subshape of this literal
   // rooted at 'dest_shape_index' must be *equal* to the shape 'src_literal'
   // (layouts and shapes must match), but need not be arrays. The memory
@@ -19,6 +19,7 @@ limitations under the License.
 #include <cstddef>
 #include <iterator>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "absl/synchronization/mutex.h"
@@ -93,7 +94,16 @@ std::shared_ptr<Literal> LiteralPool::GetCanonicalLiteral(
     return ptr;
   }
 
-  std::shared_ptr<Literal> new_literal = literal.CloneToUnique();
+  // Literals backed by a shared buffer, e.g. a memory-mapped file, share it
+  // with the pool instead of being copied.
+  std::shared_ptr<Literal> new_literal;
+  if (auto owner = literal.shared_buffer_owner();
+      owner != nullptr && literal.shape().IsArray()) {
+    new_literal = std::make_shared<Literal>(Literal::CreateFromSharedBuffer(
+        literal.shape(), std::move(owner), literal.untyped_data()));
+  } else {
+    new_literal = literal.CloneToUnique();
+  }
   literals.push_back(new_literal);
   return new_literal;
 }
@@ -15,7 +15,11 @@ limitations under the License.
 
 #include "xla/literal_pool.h"
 
+#include <memory>
+
+#include "xla/literal.h"
 #include "xla/literal_util.h"
+#include "xla/shape_util.h"
 #include "xla/tsl/platform/test.h"
 
 namespace xla {
@@ -41,5 +45,20 @@ TEST(LiteralPoolTest, GetCanonicalLiteral) {
   ASSERT_EQ(pool.GarbageCollect(), 2);
 }
 
+TEST(LiteralPoolTest, GetCanonicalLiteralSharesSharedBuffers) {
+  LiteralPool pool;
+
+  struct alignas(64) Buffer {
+    float values[4] = {1.0f, 2.0f, 3.0f, 4.0f};
+  };
+  auto buffer = std::make_shared<Buffer>();
+  Literal literal = Literal::CreateFromSharedBuffer(
+      ShapeUtil::MakeShape(F32, {4}), buffer, buffer->values);
+
+  auto canonical = pool.GetCanonicalLiteral(literal);
+  EXPECT_EQ(canonical->untyped_data(), buffer->values);
+  EXPECT_EQ(*canonical, literal);
+}
+
 }  // namespace
 }  // namespace xla
@@ -21,6 +21,7 @@ limitations under the License.
 #include <cstdint>
 #include <functional>
 #include <limits>
+#include <memory>
 #include <random>
 #include <string>
 #include <tuple>
@@ -1066,6 +1067,27 @@ TEST_F(LiteralUtilTest, TestR4RelayoutEquivalence) {
   EXPECT_EQ(literal_r4_2x2x3x3_dim0minor_, dim0major_relaid_to_dim0minor);
 }
 
+TEST_F(LiteralUtilTest, LargeRelayoutEquivalence) {
+  // Large enough to be relaid out and compared in several partitions.
+  Literal literal(
+      ShapeUtil::MakeShapeWithDenseLayout(S32, {64, 48, 40}, {2, 1, 0}));
+  TF_ASSERT_OK(literal.Populate<int32_t>([](absl::Span<const int64_t> index) {
+    return (index[0] * 48 + index[1]) * 40 + index[2];
+  }));
+
+  Layout layout = LayoutUtil::MakeLayout({1, 0, 2});
+  Literal relaid = literal.Relayout(layout);
+  EXPECT_EQ(relaid.shape().layout(), layout);
+  relaid.EachCell<int32_t>(
+      [&](absl::Span<const int64_t> index, int32_t value) {
+        EXPECT_EQ(value, literal.Get<int32_t>(index));
+      });
+  EXPECT_EQ(literal, relaid);
+
+  relaid.Set<int32_t>({63, 0, 39}, -1);
+  EXPECT_NE(literal, relaid);
+}
+
 template <bool kIsLayoutSensitive>
 struct HashTester {
   template <typename H>
@@ -1657,6 +1679,25 @@ TEST_F(LiteralUtilTest, ConvertR4) {
   EXPECT_EQ(expected, converted);
 }
 
+TEST_F(LiteralUtilTest, ConvertLargeF8ToF32) {
+  Literal literal(ShapeUtil::MakeShape(F8E4M3FN, {4096}));
+  TF_ASSERT_OK(literal.PopulateLinear<tsl::float8_e4m3fn>(
+      [](int64_t index) -> tsl::float8_e4m3fn {
+        return absl::bit_cast<tsl::float8_e4m3fn>(
+            static_cast<uint8_t>(index % 256));
+      }));
+  TF_ASSERT_OK_AND_ASSIGN(Literal converted, literal.Convert(F32));
+  for (int64_t i = 0; i < 4096; ++i) {
+    float expected = static_cast<float>(literal.Get<tsl::float8_e4m3fn>({i}));
+    float actual = converted.Get<float>({i});
+    if (std::isnan(expected)) {
+      EXPECT_TRUE(std::isnan(actual)) << i;
+    } else {
+      EXPECT_EQ(actual, expected) << i;
+    }
+  }
+}
+
 TEST_F(LiteralUtilTest, ConvertIfTypesMatch) {
   // clang-format off
   auto s8 = LiteralUtil::CreateR4WithLayout<int8_t>({{
@@ -2212,6 +2253,36 @@ TEST_F(LiteralUtilTest, DecomposeTuple) {
   EXPECT_TRUE(ShapeUtil::Compatible(elements[2].shape(), ShapeUtil::MakeNil()));
 }
 
+TEST_F(LiteralUtilTest, CreateFromSharedBuffer) {
+  struct alignas(64) Buffer {
+    float values[4] = {1.0f, 2.0f, 3.0f, 4.0f};
+  };
+  auto buffer = std::make_shared<Buffer>();
+  const Shape shape = ShapeUtil::MakeShape(F32, {2, 2});
+  {
+    Literal literal =
+        Literal::CreateFromSharedBuffer(shape, buffer, buffer->values);
+    EXPECT_EQ(literal.untyped_data(), buffer->values);
+    EXPECT_EQ(literal.shared_buffer_owner(), buffer);
+    EXPECT_EQ(literal, LiteralUtil::CreateR2<float>({{1.0f, 2.0f},
+                                                     {3.0f, 4.0f}}));
+
+    // Clones own their buffer.
+    Literal clone = literal.Clone();
+    EXPECT_NE(clone.untyped_data(), buffer->values);
+    EXPECT_EQ(clone.shared_buffer_owner(), nullptr);
+    EXPECT_EQ(clone, literal);
+
+    // Moving the literal into a tuple keeps the buffer shared.
+    Literal shared_tuple = LiteralUtil::MakeTupleOwned(
+        std::move(literal), LiteralUtil::CreateR0<int32_t>(2));
+    EXPECT_EQ(shared_tuple.untyped_data({0}), buffer->values);
+    EXPECT_EQ(shared_tuple.shared_buffer_owner({0}), buffer);
+    EXPECT_EQ(buffer.use_count(), 2);
+  }
+  EXPECT_EQ(buffer.use_count(), 1);
+}
+
 TEST_F(LiteralUtilTest, DecomposeEmptyTuple) {
   Literal nil_literal(ShapeUtil::MakeNil());
   std::vector<Literal> elements = nil_literal.DecomposeTuple();
@@ -21,7 +21,6 @@ limitations under the License.
 #include <string>
 #include <utility>
 
-#include "absl/base/casts.h"
 #include "absl/log/check.h"
 #include "absl/log/log.h"
 #include "absl/status/statusor.h"
@@ -30,6 +29,7 @@ limitations under the License.
 #include "xla/layout.h"
 #include "xla/layout_util.h"
 #include "xla/literal.h"
+#include "xla/primitive_util.h"
 #include "xla/shape.h"
 #include "xla/shape_util.h"
 #include "xla/tsl/platform/errors.h"
@@ -56,31 +56,49 @@ absl::StatusOr<Literal> PackedLiteralReader::Read(const Shape& shape,
     *literal_shape.mutable_layout() = *layout;
   }
 
-  if (shape.element_type() != F32) {
+  const PrimitiveType element_type = shape.element_type();
+  const bool is_sub_byte = primitive_util::IsSubByteNonPredType(element_type);
+  if (element_type != F32 && !is_sub_byte) {
     return Unimplemented(
         "not yet implemented element type for packed literal reading: %s",
-        PrimitiveType_Name(shape.element_type()));
+        PrimitiveType_Name(element_type));
   }
 
   Literal result(literal_shape);
-  result.PopulateWithValue(std::numeric_limits<float>::quiet_NaN());
+  if (element_type == F32) {
+    result.PopulateWithValue(std::numeric_limits<float>::quiet_NaN());
+  }
 
+  // Sub-byte elements are stored packed in the file, as many to a byte as fit,
+  // and are unpacked into the one byte per element representation of literals
+  // after reading.
   int64_t elements = ShapeUtil::ElementsIn(shape);
-  absl::Span<const float> field = result.data<float>();
-  char* data = absl::bit_cast<char*>(field.data());
-  uint64_t bytes = elements * sizeof(float);
+  char* data = static_cast<char*>(result.untyped_data());
+  uint64_t bytes =
+      is_sub_byte
+          ? CeilOfRatio<int64_t>(
+                elements * primitive_util::BitWidth(element_type), 8)
+          : elements * sizeof(float);
+  std::string packed;
+  if (is_sub_byte) {
+    packed.resize(bytes);
+  }
+  char* scratch = is_sub_byte ? packed.data() : data;
   absl::string_view sp;
-  auto s = file_->Read(offset_, bytes, &sp, data);
+  auto s = file_->Read(offset_, bytes, &sp, scratch);
   offset_ += sp.size();
   if (!s.ok()) {
     return s;
-  } else {
-    // Success: make sure we move the data into the right place if the Read
-    // call decided to return data in somewhere other than "data".
-    CHECK_EQ(sp.size(), bytes);
-    if (sp.data() != data) {
-      memcpy(data, sp.data(), sp.size());
-    }
+  }
+  CHECK_EQ(sp.size(), bytes);
+  if (is_sub_byte) {
+    primitive_util::UnpackIntN(element_type,
+                               absl::MakeConstSpan(sp.data(), sp.size()),
+                               absl::MakeSpan(data, elements));
+  } else if (sp.data() != data) {
+    // Make sure we move the data into the right place if the Read call decided
+    // to return data in somewhere other than "data".
+    memcpy(data, sp.data(), sp.size());
   }
   VLOG(3) << "read shape from file: " << ShapeUtil::HumanString(shape);
   return std::move(result);
@@ -44,6 +44,10 @@ class PackedLiteralReader {
   //
   // Layout is optional. If it is not provided, no layout is set on the literal
   // that is produced.
+  //
+  // F32 and sub-byte element types are supported. Sub-byte elements are read
+  // packed, as many to a byte as fit with the first element in the low-order
+  // bits, which is how XLA stores them on device.
   absl::StatusOr<Literal> Read(const Shape& shape,
                                const Layout* layout = nullptr);
 
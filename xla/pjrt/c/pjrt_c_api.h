@@ -48,6 +48,7 @@ typedef enum {
   PJRT_Extension_Type_MemoryDescriptions,
   PJRT_Extension_Type_Triton,
   PJRT_Extension_Type_RawBuffer,  // Experimental.
+  PJRT_Extension_Type_CompilationCache,  // Experimental.
 } PJRT_Extension_Type;
 
 // PJRT_Extension_Base contains a type and a pointer to next
@@ -82,7 +83,7 @@ PJRT_DEFINE_STRUCT_TRAITS(PJRT_Extension_Base, next);
 // Changes include:
 // * Adding a new field to the PJRT_Api or argument structs
 // * Renaming a method or argument (doesn't affect ABI)
-#define PJRT_API_MINOR 68
+#define PJRT_API_MINOR 69
 
 // The plugin should set the major_version and minor_version of
 // PJRT_Api.pjrt_api_version to be the `PJRT_API_MAJOR` and `PJRT_API_MINOR` in
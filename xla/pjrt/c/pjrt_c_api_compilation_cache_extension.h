@@ -0,0 +1,95 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_PJRT_C_PJRT_C_API_COMPILATION_CACHE_EXTENSION_H_
+#define XLA_PJRT_C_PJRT_C_API_COMPILATION_CACHE_EXTENSION_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "xla/pjrt/c/pjrt_c_api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// This extension compiles programs through a persistent compilation cache, so
+// that frameworks don't each have to implement one. The extension is both
+// optional and experimental, meaning ABI-breaking and other incompatible
+// changes may be introduced at any time.
+//
+// Cache keys are computed by the plugin from the program, the serialized
+// CompileOptionsProto, and the platform name and version of the client, so
+// executables are never shared between incompatible plugins. The values are
+// serialized executables. They are stored either in a local directory or in a
+// storage backend provided by the caller, such as a key-value store.
+
+#define PJRT_API_COMPILATION_CACHE_EXTENSION_VERSION 1
+
+// A storage backend for the cache, implemented by the caller. The callbacks
+// may be called from any thread.
+struct PJRT_CompilationCache_Storage {
+  size_t struct_size;
+  void* user_arg;
+  // Looks up `key`. Returns true and sets `value` and `value_size` if found.
+  // `value` must stay valid until it is passed to `release_value`.
+  bool (*get)(void* user_arg, const char* key, size_t key_size,
+              const char** value, size_t* value_size);
+  // Releases a value returned by `get`.
+  void (*release_value)(void* user_arg, const char* value);
+  // Stores `value` under `key`. Failing to store is not an error.
+  void (*put)(void* user_arg, const char* key, size_t key_size,
+              const char* value, size_t value_size);
+};
+PJRT_DEFINE_STRUCT_TRAITS(PJRT_CompilationCache_Storage, put);
+
+struct PJRT_CompilationCache_Compile_Args {
+  size_t struct_size;
+  PJRT_Extension_Base* extension_start;
+  PJRT_Client* client;
+  // Same as in PJRT_Client_Compile_Args.
+  const PJRT_Program* program;
+  const char* compile_options;
+  size_t compile_options_size;
+  // If not null, the cache is kept in `storage`, which only needs to stay
+  // alive for the duration of the call. Otherwise it is kept in files in
+  // `directory`, which is created if needed.
+  const PJRT_CompilationCache_Storage* storage;
+  const char* directory;
+  size_t directory_size;
+  PJRT_LoadedExecutable* executable;  // out
+  // Whether `executable` was loaded from the cache rather than compiled.
+  bool cache_hit;  // out
+};
+PJRT_DEFINE_STRUCT_TRAITS(PJRT_CompilationCache_Compile_Args, cache_hit);
+
+// Looks up the executable for `program` in the cache, and loads it if found.
+// Otherwise compiles `program` like PJRT_Client_Compile, and saves the
+// executable to the cache if the client can serialize it. Cache misses and
+// failures to read or write the cache are not errors.
+typedef PJRT_Error* PJRT_CompilationCache_Compile(
+    PJRT_CompilationCache_Compile_Args* args);
+
+typedef struct PJRT_CompilationCache_Extension {
+  PJRT_Extension_Base base;
+  PJRT_CompilationCache_Compile* compile;
+} PJRT_CompilationCache_Extension;
+PJRT_DEFINE_STRUCT_TRAITS(PJRT_CompilationCache_Extension, compile);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // XLA_PJRT_C_PJRT_C_API_COMPILATION_CACHE_EXTENSION_H_
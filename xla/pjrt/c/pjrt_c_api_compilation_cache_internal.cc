@@ -0,0 +1,176 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/pjrt/c/pjrt_c_api_compilation_cache_internal.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/string_view.h"
+#include "xla/pjrt/c/pjrt_c_api.h"
+#include "xla/pjrt/c/pjrt_c_api_compilation_cache_extension.h"
+#include "xla/pjrt/c/pjrt_c_api_helpers.h"
+#include "xla/pjrt/c/pjrt_c_api_wrapper_impl.h"
+#include "xla/pjrt/pjrt_client.h"
+#include "xla/pjrt/pjrt_executable.h"
+#include "xla/tsl/platform/env.h"
+#include "tsl/platform/fingerprint.h"
+#include "tsl/platform/path.h"
+
+namespace pjrt {
+namespace {
+
+// Returns the serialized executable stored under `key`, or nullopt if there is
+// none.
+std::optional<std::string> ReadFromCache(
+    const PJRT_CompilationCache_Compile_Args* args, absl::string_view key) {
+  if (args->storage != nullptr) {
+    const PJRT_CompilationCache_Storage* storage = args->storage;
+    const char* value;
+    size_t value_size;
+    if (!storage->get(storage->user_arg, key.data(), key.size(), &value,
+                      &value_size)) {
+      return std::nullopt;
+    }
+    std::string serialized(value, value_size);
+    storage->release_value(storage->user_arg, value);
+    return serialized;
+  }
+  std::string path = tsl::io::JoinPath(
+      absl::string_view(args->directory, args->directory_size), key);
+  tsl::Env* env = tsl::Env::Default();
+  std::string serialized;
+  if (!env->FileExists(path).ok() ||
+      !tsl::ReadFileToString(env, path, &serialized).ok()) {
+    return std::nullopt;
+  }
+  return serialized;
+}
+
+void WriteToCache(const PJRT_CompilationCache_Compile_Args* args,
+                  absl::string_view key, absl::string_view serialized) {
+  if (args->storage != nullptr) {
+    const PJRT_CompilationCache_Storage* storage = args->storage;
+    storage->put(storage->user_arg, key.data(), key.size(), serialized.data(),
+                 serialized.size());
+    return;
+  }
+  absl::string_view directory(args->directory, args->directory_size);
+  tsl::Env* env = tsl::Env::Default();
+  std::string path = tsl::io::JoinPath(directory, key);
+  // Writes to a temporary file first, so that concurrent processes never load
+  // a partially written executable.
+  std::string tmp_path = absl::StrCat(path, ".tmp.", env->NowMicros(), ".",
+                                      reinterpret_cast<uintptr_t>(args));
+  absl::Status status = env->RecursivelyCreateDir(std::string(directory));
+  if (status.ok()) {
+    status = tsl::WriteStringToFile(env, tmp_path, serialized);
+  }
+  if (status.ok()) {
+    status = env->RenameFile(tmp_path, path);
+  }
+  if (!status.ok()) {
+    LOG(WARNING) << "Failed to write " << path
+                 << " to the compilation cache: " << status;
+  }
+}
+
+}  // namespace
+
+std::string CompilationCacheKey(PJRT_Client* client,
+                                const PJRT_Program* program,
+                                absl::string_view compile_options) {
+  absl::string_view format(program->format, program->format_size);
+  absl::string_view code(program->code, program->code_size);
+  // Every part is prefixed by its size, so that different parts can't make the
+  // same key.
+  std::string contents = absl::StrCat(
+      format.size(), ":", format, code.size(), ":", code,
+      compile_options.size(), ":", compile_options,
+      client->client->platform_name(), ":", client->client->platform_version(),
+      ":", PJRT_API_MAJOR, ".", PJRT_API_MINOR);
+  tsl::Fprint128 fingerprint = tsl::Fingerprint128(contents);
+  return absl::StrFormat("pjrt-%s-%016x%016x", client->client->platform_name(),
+                         fingerprint.high64, fingerprint.low64);
+}
+
+PJRT_Error* PJRT_CompilationCache_Compile(
+    PJRT_CompilationCache_Compile_Args* args) {
+  PJRT_RETURN_IF_ERROR(ActualStructSizeIsGreaterOrEqual(
+      "PJRT_CompilationCache_Compile_Args",
+      PJRT_CompilationCache_Compile_Args_STRUCT_SIZE, args->struct_size));
+  PJRT_RETURN_IF_ERROR(ActualStructSizeIsGreaterOrEqual(
+      "PJRT_Program", PJRT_Program_STRUCT_SIZE, args->program->struct_size));
+  if (args->storage != nullptr) {
+    PJRT_RETURN_IF_ERROR(ActualStructSizeIsGreaterOrEqual(
+        "PJRT_CompilationCache_Storage",
+        PJRT_CompilationCache_Storage_STRUCT_SIZE, args->storage->struct_size));
+  } else if (args->directory_size == 0) {
+    return new PJRT_Error{absl::InvalidArgumentError(
+        "PJRT_CompilationCache_Compile: either storage or directory must be "
+        "set")};
+  }
+
+  std::string key = CompilationCacheKey(
+      args->client, args->program,
+      absl::string_view(args->compile_options, args->compile_options_size));
+  if (std::optional<std::string> serialized = ReadFromCache(args, key)) {
+    absl::StatusOr<std::unique_ptr<xla::PjRtLoadedExecutable>> executable =
+        args->client->client->LoadSerializedExecutable(
+            *serialized, /*options=*/std::nullopt, xla::LoadOptions());
+    if (executable.ok()) {
+      VLOG(1) << "Loaded " << key << " from the compilation cache";
+      args->executable =
+          new PJRT_LoadedExecutable(*std::move(executable), args->client);
+      args->cache_hit = true;
+      return nullptr;
+    }
+    LOG(WARNING) << "Failed to load " << key
+                 << " from the compilation cache: " << executable.status();
+  }
+
+  PJRT_Client_Compile_Args compile_args;
+  compile_args.struct_size = PJRT_Client_Compile_Args_STRUCT_SIZE;
+  compile_args.extension_start = nullptr;
+  compile_args.client = args->client;
+  compile_args.program = args->program;
+  compile_args.compile_options = args->compile_options;
+  compile_args.compile_options_size = args->compile_options_size;
+  if (PJRT_Error* error = PJRT_Client_Compile(&compile_args)) {
+    return error;
+  }
+  args->executable = compile_args.executable;
+  args->cache_hit = false;
+
+  absl::StatusOr<std::string> serialized =
+      args->executable->executable->SerializeExecutable();
+  if (serialized.ok()) {
+    WriteToCache(args, key, *serialized);
+  } else {
+    VLOG(1) << "Not saving " << key
+            << " to the compilation cache: " << serialized.status();
+  }
+  return nullptr;
+}
+
+}  // namespace pjrt
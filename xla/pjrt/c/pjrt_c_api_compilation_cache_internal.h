@@ -0,0 +1,50 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_PJRT_C_PJRT_C_API_COMPILATION_CACHE_INTERNAL_H_
+#define XLA_PJRT_C_PJRT_C_API_COMPILATION_CACHE_INTERNAL_H_
+
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "xla/pjrt/c/pjrt_c_api.h"
+#include "xla/pjrt/c/pjrt_c_api_compilation_cache_extension.h"
+
+namespace pjrt {
+
+// Returns the cache key of compiling `program` with the serialized
+// `compile_options` on `client`.
+std::string CompilationCacheKey(PJRT_Client* client,
+                                const PJRT_Program* program,
+                                absl::string_view compile_options);
+
+PJRT_Error* PJRT_CompilationCache_Compile(
+    PJRT_CompilationCache_Compile_Args* args);
+
+inline PJRT_CompilationCache_Extension CreateCompilationCacheExtension(
+    PJRT_Extension_Base* next) {
+  return {
+      PJRT_Extension_Base{
+          /*struct_size=*/PJRT_CompilationCache_Extension_STRUCT_SIZE,
+          /*type=*/PJRT_Extension_Type::PJRT_Extension_Type_CompilationCache,
+          /*next=*/next,
+      },
+      /*compile=*/PJRT_CompilationCache_Compile,
+  };
+}
+
+}  // namespace pjrt
+
+#endif  // XLA_PJRT_C_PJRT_C_API_COMPILATION_CACHE_INTERNAL_H_
@@ -20,6 +20,8 @@ limitations under the License.
 
 #include "absl/status/status.h"
 #include "xla/pjrt/c/pjrt_c_api.h"
+#include "xla/pjrt/c/pjrt_c_api_compilation_cache_extension.h"
+#include "xla/pjrt/c/pjrt_c_api_compilation_cache_internal.h"
 #include "xla/pjrt/c/pjrt_c_api_ffi_extension.h"
 #include "xla/pjrt/c/pjrt_c_api_ffi_internal.h"
 #include "xla/pjrt/c/pjrt_c_api_helpers.h"
@@ -74,11 +76,14 @@ const PJRT_Api* GetCpuPjrtApi() {
   static PJRT_FFI_Extension ffi_extension =
       pjrt::CreateFfiExtension(&memory_descriptions_extension.base);
 
+  static PJRT_CompilationCache_Extension compilation_cache_extension =
+      pjrt::CreateCompilationCacheExtension(&ffi_extension.base);
+
   static const PJRT_Api pjrt_api = pjrt::CreatePjrtApi(
       pjrt::cpu_plugin::PJRT_Client_Create,
       pjrt::cpu_plugin::PJRT_ExecuteContext_Create,
       pjrt::cpu_plugin::PJRT_CpuDeviceTopology_Create,
-      pjrt::PJRT_Plugin_Initialize_NoOp, &ffi_extension.base,
+      pjrt::PJRT_Plugin_Initialize_NoOp, &compilation_cache_extension.base,
       pjrt::PJRT_Plugin_Attributes_Xla);
 
   return &pjrt_api;
@@ -43,6 +43,7 @@ limitations under the License.
 #include "xla/literal.h"
 #include "xla/literal_util.h"
 #include "xla/pjrt/c/pjrt_c_api.h"
+#include "xla/pjrt/c/pjrt_c_api_compilation_cache_extension.h"
 #include "xla/pjrt/c/pjrt_c_api_helpers.h"
 #include "xla/pjrt/c/pjrt_c_api_memory_descriptions_extension.h"
 #include "xla/pjrt/c/pjrt_c_api_test_base.h"
@@ -383,6 +384,95 @@ TEST_F(PjrtCApiTest, Compile) {
   destroy_executable(args.executable, api_);
 }
 
+// An in-memory storage backend for the compilation cache extension.
+class InMemoryCompilationCacheStorage {
+ public:
+  PJRT_CompilationCache_Storage storage() {
+    return PJRT_CompilationCache_Storage{
+        .struct_size = PJRT_CompilationCache_Storage_STRUCT_SIZE,
+        .user_arg = this,
+        .get = &Get,
+        .release_value = [](void* user_arg, const char* value) {},
+        .put = &Put,
+    };
+  }
+
+  int size() const { return values_.size(); }
+
+ private:
+  static bool Get(void* user_arg, const char* key, size_t key_size,
+                  const char** value, size_t* value_size) {
+    auto* self = static_cast<InMemoryCompilationCacheStorage*>(user_arg);
+    auto it = self->values_.find(absl::string_view(key, key_size));
+    if (it == self->values_.end()) {
+      return false;
+    }
+    *value = it->second.data();
+    *value_size = it->second.size();
+    return true;
+  }
+
+  static void Put(void* user_arg, const char* key, size_t key_size,
+                  const char* value, size_t value_size) {
+    auto* self = static_cast<InMemoryCompilationCacheStorage*>(user_arg);
+    self->values_[std::string(key, key_size)] = std::string(value, value_size);
+  }
+
+  absl::flat_hash_map<std::string, std::string> values_;
+};
+
+TEST_F(PjrtCApiTest, CompileWithCompilationCache) {
+  const auto* extension =
+      pjrt::FindExtension<PJRT_CompilationCache_Extension>(
+          api_, PJRT_Extension_Type::PJRT_Extension_Type_CompilationCache);
+  if (extension == nullptr) {
+    GTEST_SKIP() << "The plugin has no compilation cache extension.";
+  }
+  InMemoryCompilationCacheStorage cache;
+  PJRT_CompilationCache_Storage storage = cache.storage();
+
+  std::string options_str = BuildSingleDeviceCompileOptionStr();
+  std::string format(::pjrt::kMlirFormat);
+  std::string program_code{module_add_one};
+  PJRT_Program program = PJRT_Program{
+      .struct_size = PJRT_Program_STRUCT_SIZE,
+      .extension_start = nullptr,
+      .code = program_code.data(),
+      .code_size = program_code.length(),
+      .format = format.c_str(),
+      .format_size = format.size(),
+  };
+  auto compile = [&]() {
+    PJRT_CompilationCache_Compile_Args args =
+        PJRT_CompilationCache_Compile_Args{
+            .struct_size = PJRT_CompilationCache_Compile_Args_STRUCT_SIZE,
+            .extension_start = nullptr,
+            .client = client_,
+            .program = &program,
+            .compile_options = options_str.c_str(),
+            .compile_options_size = options_str.size(),
+            .storage = &storage,
+            .directory = nullptr,
+            .directory_size = 0,
+        };
+    PJRT_Error* error = extension->compile(&args);
+    ::pjrt::LogFatalIfPjrtError(error, api_);
+    return args;
+  };
+
+  PJRT_CompilationCache_Compile_Args first = compile();
+  EXPECT_FALSE(first.cache_hit);
+  destroy_executable(first.executable, api_);
+  if (cache.size() == 0) {
+    GTEST_SKIP() << "The plugin cannot serialize executables.";
+  }
+
+  PJRT_CompilationCache_Compile_Args second = compile();
+  EXPECT_TRUE(second.cache_hit);
+  EXPECT_EQ(cache.size(), 1);
+  destroy_executable(second.executable, api_);
+}
+
 TEST_F(PjrtCApiTest, CompileXlaComputation) {
   PJRT_Client_Compile_Args args = PJRT_Client_Compile_Args{
       .struct_size = PJRT_Client_Compile_Args_STRUCT_SIZE,
@@ -86,6 +86,27 @@ void UnpackIntNToLiteral(PrimitiveType input_element_type,
   primitive_util::UnpackIntN(input_element_type, input_span, output_span);
 }
 
+// Returns true if a host buffer with `byte_strides` is laid out densely in the
+// layout of `shape`.
+bool HostBufferHasLayoutOf(const Shape& shape,
+                           absl::Span<int64_t const> byte_strides) {
+  absl::InlinedVector<int64_t, 4> device_strides(byte_strides.size());
+  if (!ShapeUtil::ByteStrides(shape, absl::MakeSpan(device_strides)).ok()) {
+    return false;
+  }
+  // If the array is size 0, the strides are irrelevant.
+  if (absl::c_linear_search(shape.dimensions(), 0)) {
+    return true;
+  }
+  for (size_t i = 0; i < byte_strides.size(); ++i) {
+    // If a dimension is of size 1, its stride is irrelevant.
+    if (shape.dimensions(i) != 1 && byte_strides[i] != device_strides[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
 // `device_buffer`'s definition event must be ready before calling this
 // function.
 void CopyCpuBufferToLiteral(const Shape& device_shape,
@@ -625,15 +646,25 @@ AbstractTfrtCpuBuffer::BufferFromHostBufferHelper(
     std::optional<absl::Span<int64_t const>> byte_strides,
     PjRtClient::HostBufferSemantics host_buffer_semantics,
     absl::AnyInvocable<void() &&> on_done_with_host_buffer, const Shape& shape,
-    AsyncWorkRunner* async_work_runner, absl::Mutex* transpose_mu,
-    TransposePlanCache* transpose_cache) {
-  bool has_default_layout =
-      !byte_strides || HasMajorToMinorLayout(type, dims, *byte_strides);
+    AsyncWorkRunner* async_work_runner, TransposePlanCache* transpose_cache) {
+  // The device buffer is laid out as in `shape`, which is major-to-minor
+  // unless the caller asked for another device layout.
+  const bool device_layout_is_default =
+      !shape.has_layout() ||
+      LayoutUtil::IsMonotonicWithDim0Major(shape.layout());
+  bool has_device_layout;
+  if (device_layout_is_default) {
+    has_device_layout =
+        !byte_strides || HasMajorToMinorLayout(type, dims, *byte_strides);
+  } else {
+    has_device_layout =
+        byte_strides && HostBufferHasLayoutOf(shape, *byte_strides);
+  }
   const int bit_width = primitive_util::BitWidth(type);
   // Packed arrays are unpacked on host and packed on device.
   bool is_packed = primitive_util::IsSubByteNonPredType(type);
 
-  // If the input buffer has a default layout and is sufficiently aligned, we
+  // If the input buffer has the device layout and is sufficiently aligned, we
   // can simply point to the input array's data without any further copies. At
   // the time of writing we require a 16-byte alignment because XLA may generate
   // code which requires it.
@@ -647,7 +678,7 @@ AbstractTfrtCpuBuffer::BufferFromHostBufferHelper(
       host_buffer_semantics == HostBufferSemantics::kMutableZeroCopy;
 
   bool can_use_zero_copy =
-      has_default_layout && !is_packed && is_aligned_data &&
+      has_device_layout && !is_packed && is_aligned_data &&
       (immutable_zero_copy_semantics || mutable_zero_copy_semantics);
 
   absl::InlinedVector<tsl::AsyncValueRef<CpuDeviceMemory>, 4> buffers;
@@ -675,16 +706,22 @@ AbstractTfrtCpuBuffer::BufferFromHostBufferHelper(
                         CpuDeviceMemory::AllocateAvailable(dst_byte_size));
     auto dst_data_ptr = device_buffer->untyped_data();
     buffers.push_back(device_buffer);
-    if (!has_default_layout || is_packed) {
-      // If the input array does not have a major-to-minor layout, transpose it
-      // into major-to-minor layout. Currently we choose to always do this
+    if (!has_device_layout || is_packed) {
+      // If the input array does not have the device layout, transpose it into
+      // the device layout. Currently we choose to always do this
       // synchronously.
       // TODO(phawkins): consider performing the transpose asynchronously.
       // TODO(phawkins): parallelize the transpose.
       std::shared_ptr<TransposePlan> transpose;
       {
+        // The transpose writes the dimensions in major-to-minor order of the
+        // device layout.
         absl::InlinedVector<int64_t, 4> permutation(dims.size());
-        absl::c_iota(permutation, 0);
+        if (device_layout_is_default) {
+          absl::c_iota(permutation, 0);
+        } else {
+          absl::c_copy(shape.layout().minor_to_major(), permutation.rbegin());
+        }
         TransposePlan::Options options;
         options.elem_size_in_bytes = primitive_util::ByteWidth(type);
         options.dims = dims;
@@ -692,7 +729,6 @@ AbstractTfrtCpuBuffer::BufferFromHostBufferHelper(
         if (byte_strides) {
           options.input_layout = TransposePlan::Striding{*byte_strides};
         }
-        absl::MutexLock lock(transpose_mu);
         TF_ASSIGN_OR_RETURN(transpose, transpose_cache->GetOrCreate(options));
       }
       if (!is_packed) {
@@ -176,8 +176,9 @@ class AbstractTfrtCpuBuffer : public CommonPjRtBuffer {
 
   // A helper function for PjRtClient::BufferFromHostBuffer. Creates a new cpu
   // device buffer from the host buffer (maybe zero-copy or async).
-  // `transpose_mu` and `transpose_cache` are used to transpose the input
-  // layout.
+  // The device buffer has the layout of `shape`. The host buffer is used
+  // without a copy if the semantics allow it and it already has that layout,
+  // otherwise `transpose_cache` is used to transpose the input layout.
   static absl::StatusOr<std::unique_ptr<TrackedCpuDeviceBuffer>>
   BufferFromHostBufferHelper(
       const void* data, PrimitiveType type, absl::Span<int64_t const> dims,
@@ -185,7 +186,7 @@ class AbstractTfrtCpuBuffer : public CommonPjRtBuffer {
       PjRtClient::HostBufferSemantics host_buffer_semantics,
       absl::AnyInvocable<void() &&> on_done_with_host_buffer,
       const Shape& shape, AsyncWorkRunner* async_work_runner,
-      absl::Mutex* transpose_mu, TransposePlanCache* transpose_cache);
+      TransposePlanCache* transpose_cache);
 
   // Returns a hold on the TrackedTfrtTpuDeviceBuffer holding the device
   // buffers. See comment on ScopedHold.
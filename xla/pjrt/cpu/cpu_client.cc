@@ -55,6 +55,7 @@ limitations under the License.
 #include "xla/backends/cpu/collectives/cpu_collectives.h"
 #include "xla/backends/cpu/constant_allocation.h"
 #include "xla/backends/cpu/runtime/buffer_allocations.h"
+#include "xla/backends/cpu/runtime/object_pool.h"
 #include "xla/backends/cpu/runtime/thread_pool_task_runner.h"
 #include "xla/backends/cpu/runtime/thunk.h"
 #include "xla/backends/cpu/runtime/thunk_executor.h"
@@ -129,6 +130,8 @@ limitations under the License.
 #include "tsl/platform/casts.h"
 #include "tsl/platform/denormal.h"
 #include "tsl/platform/fingerprint.h"
+#include "tsl/platform/mem.h"
+#include "tsl/platform/numa.h"
 #include "tsl/platform/setround.h"
 #include "tsl/profiler/lib/connected_traceme.h"
 #include "tsl/profiler/lib/context_types.h"
@@ -320,7 +323,7 @@ absl::StatusOr<std::unique_ptr<PjRtClient>> GetTfrtCpuClient(
   return std::unique_ptr<PjRtClient>(std::make_unique<TfrtCpuClient>(
       options.process_id, std::move(devices), std::move(options.collectives),
       num_threads, options.asynchronous,
-      std::move(options.customize_hlo_module_config)));
+      std::move(options.customize_hlo_module_config), options.numa_aware));
 }
 
 // An upper bound on the number of threads to use for intra-op parallelism. It
@@ -328,30 +331,60 @@ absl::StatusOr<std::unique_ptr<PjRtClient>> GetTfrtCpuClient(
 // intensive operations that are supposed to run inside the intra-op threadpool.
 static const size_t kMaxIntraOpThreads = 256;
 
-static tsl::ThreadOptions GetThreadOptions() {
+static tsl::ThreadOptions GetThreadOptions(
+    int numa_node = tsl::port::kNUMANoAffinity) {
   tsl::ThreadOptions thread_options;
   // On Mac OS the default stack size is 512KiB, which is too small for some
   // BLAS and LAPACK functions (https://github.com/google/jax/issues/20428).
   // On Linux we also observed that 2MB wasn't enough to run some OpenBLAS
   // functions.
   thread_options.stack_size = 8 * 1024 * 1024;
+  thread_options.numa_node = numa_node;
   return thread_options;
 }
 
+// Returns the number of NUMA nodes to partition intra-op thread pool into.
+static int NumIntraOpNumaNodes(bool numa_aware) {
+  if (!numa_aware || !tsl::port::NUMAEnabled()) return 1;
+  return std::max(1, tsl::port::NUMANumNodes());
+}
+
+// Creates intra-op thread pools: a single pool without NUMA affinity, or if
+// there are multiple NUMA nodes, one pool per node with `num_threads` evenly
+// split between them.
+static std::vector<std::unique_ptr<tsl::thread::ThreadPool>>
+CreateIntraOpThreadPools(size_t num_threads, int num_numa_nodes) {
+  std::vector<std::unique_ptr<tsl::thread::ThreadPool>> pools;
+  if (num_numa_nodes == 1) {
+    pools.push_back(std::make_unique<tsl::thread::ThreadPool>(
+        tsl::Env::Default(), GetThreadOptions(), "XLAEigen", num_threads));
+    return pools;
+  }
+
+  size_t num_node_threads = std::max<size_t>(1, num_threads / num_numa_nodes);
+  for (int node = 0; node < num_numa_nodes; ++node) {
+    pools.push_back(std::make_unique<tsl::thread::ThreadPool>(
+        tsl::Env::Default(), GetThreadOptions(node),
+        absl::StrCat("XLAEigenNuma", node), num_node_threads));
+  }
+
+  VLOG(1) << "Created " << num_numa_nodes << " NUMA-pinned intra-op thread "
+          << "pools with " << num_node_threads << " threads each";
+  return pools;
+}
+
 TfrtCpuClient::TfrtCpuClient(
     int process_index, std::vector<std::unique_ptr<TfrtCpuDevice>> devices,
     std::shared_ptr<cpu::CpuCollectives> collectives, size_t num_threads,
     bool asynchronous,
-    std::function<void(HloModuleConfig&)> customize_hlo_module_config)
+    std::function<void(HloModuleConfig&)> customize_hlo_module_config,
+    bool numa_aware)
     : process_index_(process_index),
       owned_devices_(std::move(devices)),
       computation_placer_(std::make_unique<ComputationPlacer>()),
-      eigen_intraop_pool_(new tsl::thread::ThreadPool(
-          tsl::Env::Default(), GetThreadOptions(), "XLAEigen",
-          std::min(num_threads, kMaxIntraOpThreads))),
-      eigen_intraop_device_(
-          new Eigen::ThreadPoolDevice(eigen_intraop_pool_->AsEigenThreadPool(),
-                                      eigen_intraop_pool_->NumThreads())),
+      eigen_intraop_pools_(
+          CreateIntraOpThreadPools(std::min(num_threads, kMaxIntraOpThreads),
+                                   NumIntraOpNumaNodes(numa_aware))),
       pjrt_client_thread_pool_(
           new tsl::thread::ThreadPool(tsl::Env::Default(), GetThreadOptions(),
                                       "XLATfrtCpuClient", num_threads)),
@@ -359,13 +392,18 @@ TfrtCpuClient::TfrtCpuClient(
           pjrt_client_thread_pool_.get())),
       last_collective_launch_event_(
           tsl::MakeAvailableAsyncValueRef<CpuEvent>()),
-      transpose_cache_(1024),
+      transpose_cache_(1024, /*num_shards=*/16),
       collectives_(std::move(collectives)),
       topology_(CpuTopologyDescription::Create(
           platform_id(), platform_name(), platform_version(),
           GetPjRtDeviceSpan(owned_devices_), cpu::DetectMachineAttributes())),
       asynchronous_(asynchronous),
       customize_hlo_module_config_(std::move(customize_hlo_module_config)) {
+  for (const auto& pool : eigen_intraop_pools_) {
+    eigen_intraop_devices_.push_back(std::make_unique<Eigen::ThreadPoolDevice>(
+        pool->AsEigenThreadPool(), pool->NumThreads()));
+  }
+
   for (const std::unique_ptr<TfrtCpuDevice>& device : owned_devices_) {
     devices_.push_back(device.get());
     CHECK(
@@ -399,6 +437,22 @@ TfrtCpuClient::TfrtCpuClient(
   VLOG(1) << "TfrtCpuClient created.";
 }
 
+Eigen::ThreadPoolDevice* TfrtCpuClient::eigen_intraop_device(
+    const PjRtDevice* device) const {
+  if (eigen_intraop_devices_.size() == 1) {
+    return eigen_intraop_devices_.front().get();
+  }
+
+  // Assign contiguous ranges of local devices to NUMA nodes, so that devices
+  // are evenly distributed across the nodes.
+  size_t num_devices = std::max<size_t>(1, addressable_devices_.size());
+  size_t local_id = device->local_hardware_id().value();
+  size_t node = local_id * eigen_intraop_devices_.size() / num_devices;
+  return eigen_intraop_devices_[std::min(node,
+                                         eigen_intraop_devices_.size() - 1)]
+      .get();
+}
+
 TfrtCpuClient::~TfrtCpuClient() { VLOG(1) << "TfrtCpuClient destroyed."; }
 
 absl::StatusOr<PjRtDevice*> TfrtCpuClient::LookupDevice(
@@ -1066,6 +1120,20 @@ absl::StatusOr<std::unique_ptr<PjRtBuffer>> TfrtCpuClient::BufferFromHostBuffer(
   PjRtDevice* device = memory_space->devices().front();
   tsl::profiler::TraceMe traceme("TfrtCpuClient::BufferFromHostBuffer");
   Shape shape = ShapeUtil::MakeShape(type, dims);
+  if (device_layout != nullptr) {
+    // Executables compiled for a non-default argument layout can read a host
+    // buffer that already has that layout without copying it.
+    if (!device_layout->tiles().empty()) {
+      return Unimplemented(
+          "TfrtCpuClient::BufferFromHostBuffer does not support tiled device "
+          "layouts: %s",
+          device_layout->ToString());
+    }
+    TF_RETURN_IF_ERROR(
+        LayoutUtil::ValidateLayoutForShape(*device_layout, shape));
+    shape = ShapeUtil::MakeShapeWithDenseLayout(
+        type, dims, device_layout->minor_to_major());
+  }
   VLOG(2) << "TfrtCpuClient::BufferFromHostBuffer: shape: " << shape.ToString()
           << " device: " << device->DebugString();
 
@@ -1078,7 +1146,7 @@ absl::StatusOr<std::unique_ptr<PjRtBuffer>> TfrtCpuClient::BufferFromHostBuffer(
       AbstractTfrtCpuBuffer::BufferFromHostBufferHelper(
           data, type, dims, byte_strides, host_buffer_semantics,
           std::move(on_done_with_host_buffer), shape, async_work_runner(),
-          &transpose_mu_, &transpose_cache_));
+          &transpose_cache_));
 
   return std::unique_ptr<PjRtBuffer>(std::make_unique<TfrtCpuBuffer>(
       shape, std::move(tracked_device_buffer), this,
@@ -1173,6 +1241,20 @@ absl::StatusOr<std::unique_ptr<PjRtBuffer>> TfrtCpuBuffer::CopyToMemorySpace(
       *dst_device->default_memory_space()));
 }
 
+void CpuTempArena::Deleter::operator()(std::byte* ptr) const {
+  tsl::port::AlignedFree(ptr);
+}
+
+absl::StatusOr<CpuTempArena> CpuTempArena::Allocate(size_t size_bytes) {
+  if (void* data = tsl::port::AlignedMalloc(size_bytes,
+                                            cpu_function_runtime::MinAlign())) {
+    ABSL_ANNOTATE_MEMORY_IS_INITIALIZED(data, size_bytes);
+    return CpuTempArena(static_cast<std::byte*>(data), size_bytes);
+  }
+  return ResourceExhausted("Out of memory allocating %d bytes temp arena.",
+                           size_bytes);
+}
+
 TfrtCpuExecutable::TfrtCpuExecutable(
     int num_replicas, int num_partitions,
     std::shared_ptr<DeviceAssignment> device_assignment,
@@ -1204,6 +1286,29 @@ TfrtCpuExecutable::TfrtCpuExecutable(
   // switch time (~5us).
   cheap_computation_ = hlo_cost_analysis->flop_count() < 1000;
 
+  // Assign temp allocations that do not outlive the execution to offsets in
+  // the temp arena, all other allocations are allocated separately for each
+  // execution (or forwarded from arguments and constants).
+  const BufferAssignment& buffer_assignment =
+      tensorflow::down_cast<cpu::CpuExecutable*>(cpu_executable_.get())
+          ->buffer_assignment();
+  size_t temp_arena_size = 0;
+  temp_arena_offsets_.resize(buffer_assignment.Allocations().size());
+  for (const BufferAllocation& allocation : buffer_assignment.Allocations()) {
+    if (allocation.is_entry_computation_parameter() ||
+        allocation.is_constant() || allocation.is_thread_local() ||
+        allocation.maybe_live_out() || allocation.size() == 0) {
+      continue;
+    }
+    temp_arena_offsets_[allocation.index()] = temp_arena_size;
+    temp_arena_size += RoundUpTo<size_t>(allocation.size(),
+                                         cpu_function_runtime::MinAlign());
+  }
+  if (temp_arena_size > 0) {
+    temp_arena_pool_ = std::make_shared<CpuTempArenaPool>(
+        [temp_arena_size] { return CpuTempArena::Allocate(temp_arena_size); });
+  }
+
   const auto& computation_layout =
       cpu_executable_->module().entry_computation_layout();
   if (computation_layout.parameter_count() == 0) {
@@ -1257,12 +1362,46 @@ struct BufferInfo {
   size_t buffer_size;
 };
 
+// Device memory for a temp allocation carved out of a temp arena. Memory is
+// owned by the arena, and returned to the arena pool with it.
+class CpuDeviceMemoryTemp final : public CpuDeviceMemory {
+ protected:
+  friend class tsl::internal::ConcreteAsyncValue<CpuDeviceMemoryTemp>;
+  using CpuDeviceMemory::CpuDeviceMemory;
+};
+
 struct BufferAlloc {
   // All data members should have the same size.
   absl::InlinedVector<tsl::AsyncValueRef<CpuDeviceMemoryOwned>, 4> buffers;
   absl::InlinedVector<size_t, 4> allocation_sizes;
 
+  // Temp buffers carved out of a temp arena borrowed from `temp_arena_pool`.
+  // The arena is returned to the pool when `BufferAlloc` is destroyed, which
+  // must happen only after the execution is completed. All data members below
+  // `temp_arena` should have the same size.
+  std::shared_ptr<CpuTempArenaPool> temp_arena_pool;
+  std::optional<CpuTempArenaPool::BorrowedObject> temp_arena;
+  absl::InlinedVector<tsl::AsyncValueRef<CpuDeviceMemoryTemp>, 4> temp_buffers;
+  absl::InlinedVector<size_t, 4> temp_offsets;
+  absl::InlinedVector<size_t, 4> temp_sizes;
+
   void Allocate() {
+    if (!temp_buffers.empty()) {
+      absl::StatusOr<CpuTempArenaPool::BorrowedObject> arena =
+          temp_arena_pool->GetOrCreate();
+      if (!arena.ok()) {
+        for (auto& temp_buffer : temp_buffers) {
+          temp_buffer.SetError(arena.status());
+        }
+        return;
+      }
+      temp_arena.emplace(*std::move(arena));
+      for (int i = 0; i < temp_buffers.size(); ++i) {
+        temp_buffers[i].emplace((*temp_arena)->data() + temp_offsets[i],
+                                temp_sizes[i]);
+      }
+    }
+
     for (int i = 0; i < buffers.size(); ++i) {
       auto status =
           CpuDeviceMemoryOwned::AllocateInto(allocation_sizes[i], buffers[i]);
@@ -1305,7 +1444,7 @@ static absl::StatusOr<BufferInfo> MemoryForAllocation(
     const BufferAllocation& allocation,
     absl::Span<const cpu::ConstantAllocation> constants,
     absl::Span<std::pair<bool, TrackedCpuDeviceBuffer*> const> arguments,
-    BufferAlloc& buffer_alloc, BufferAllocAndCopy& buffer_alloc_and_copy,
+    std::optional<size_t> temp_arena_offset, BufferAlloc& buffer_alloc, BufferAllocAndCopy& buffer_alloc_and_copy,
     const tsl::AsyncValueRef<CpuDeviceMemory>& tuple_index_table) {
   BufferInfo buffer_info;
   if (allocation.is_entry_computation_parameter()) {
@@ -1381,6 +1520,20 @@ static absl::StatusOr<BufferInfo> MemoryForAllocation(
     return buffer_info;
   }
 
+  // Temporary buffer carved out of the temp arena.
+  if (temp_arena_offset.has_value()) {
+    auto out = tsl::MakeUnconstructedAsyncValueRef<CpuDeviceMemoryTemp>();
+
+    buffer_alloc.temp_buffers.push_back(out);
+    buffer_alloc.temp_offsets.push_back(*temp_arena_offset);
+    buffer_alloc.temp_sizes.push_back(allocation.size());
+
+    buffer_info.buffer = std::move(out);
+    buffer_info.owns_buffer = true;
+    buffer_info.buffer_size = allocation.size();
+    return buffer_info;
+  }
+
   // Output and temporary buffer.
   auto out = tsl::MakeUnconstructedAsyncValueRef<CpuDeviceMemoryOwned>();
 
@@ -1397,6 +1550,7 @@ static absl::StatusOr<std::vector<BufferInfo>> CreateBufferTable(
     const BufferAssignment& assignment,
     absl::Span<const cpu::ConstantAllocation> constants,
     absl::Span<std::pair<bool, TrackedCpuDeviceBuffer*> const> arguments,
+    absl::Span<const std::optional<size_t>> temp_arena_offsets,
     BufferAlloc& buffer_alloc, BufferAllocAndCopy& buffer_alloc_and_copy,
     const tsl::AsyncValueRef<CpuDeviceMemory>& tuple_index_table) {
   std::vector<BufferInfo> buffer_table(assignment.Allocations().size());
@@ -1404,7 +1558,8 @@ static absl::StatusOr<std::vector<BufferInfo>> CreateBufferTable(
     const BufferAllocation& allocation = assignment.GetAllocation(i);
     TF_ASSIGN_OR_RETURN(
         buffer_table[i],
-        MemoryForAllocation(allocation, constants, arguments, buffer_alloc,
+        MemoryForAllocation(allocation, constants, arguments,
+                            temp_arena_offsets[i], buffer_alloc,
                             buffer_alloc_and_copy, tuple_index_table));
   }
   return std::move(buffer_table);
@@ -1601,13 +1756,14 @@ absl::StatusOr<PjRtLoadedExecutable::Result> TfrtCpuExecutable::ExecuteHelper(
   // `buffer_alloc` and `buffer_alloc_and_copy` are used to do real memory
   // allocation and copy work.
   BufferAlloc buffer_alloc;
+  buffer_alloc.temp_arena_pool = temp_arena_pool_;
   BufferAllocAndCopy buffer_alloc_and_copy;
   TF_ASSIGN_OR_RETURN(
       std::vector<BufferInfo> buffer_table,
       CreateBufferTable(cpu_executable->buffer_assignment(),
                         cpu_executable->constants(), tracked_buffers,
-                        buffer_alloc, buffer_alloc_and_copy,
-                        tuple_index_table));
+                        temp_arena_offsets_, buffer_alloc,
+                        buffer_alloc_and_copy, tuple_index_table));
   auto result_buffers_info =
       CreateResultBufferInfo(result_buffer_indices_, buffer_table);
 
@@ -1623,7 +1779,7 @@ absl::StatusOr<PjRtLoadedExecutable::Result> TfrtCpuExecutable::ExecuteHelper(
   run_options.set_run_id(run_id);
   // Need to keep device_assignment alive until execution completes.
   run_options.set_device_assignment(device_assignment.get());
-  run_options.set_intra_op_thread_pool(client_->eigen_intraop_device());
+  run_options.set_intra_op_thread_pool(client_->eigen_intraop_device(device));
 
   auto cpu_run_options = std::make_shared<cpu::CpuExecutableRunOptions>();
   run_options.set_cpu_executable_run_options(cpu_run_options.get());
@@ -1804,7 +1960,7 @@ absl::StatusOr<PjRtLoadedExecutable::Result> TfrtCpuExecutable::ExecuteHelper(
          donation_transactions = std::move(donation_transactions),
          scoped_async_execution = std::move(scoped_async_execution),
          input_deps_avs = std::move(input_deps_avs_copy),
-         eigen_device = client()->eigen_intraop_device()]() mutable {
+         eigen_device = client()->eigen_intraop_device(device)]() mutable {
           // Because `input_deps` contains the definition events of all inputs,
           // when it is ready, all input buffers must have been allocated. So,
           // we are safe to allocate and copy memory here. Since `execute_event`
@@ -2130,6 +2286,93 @@ TfrtCpuExecutable::Execute(
   return wrapped_results;
 }
 
+absl::StatusOr<std::vector<std::vector<std::unique_ptr<PjRtBuffer>>>>
+TfrtCpuExecutable::ExecuteBatch(
+    absl::Span<const std::vector<PjRtBuffer*>> argument_sets,
+    const ExecuteOptions& options,
+    std::optional<std::vector<PjRtFuture<>>>& returned_futures) {
+  RunId run_id(options.launch_id);
+  tsl::profiler::TraceMeProducer activity("TfrtCpuExecutable::ExecuteBatch",
+                                          tsl::profiler::ContextType::kPjRt,
+                                          run_id.ToInt());
+  if (!options.untuple_result && cpu_executable_->module()
+                                     .config()
+                                     .entry_computation_layout()
+                                     .result_shape()
+                                     .IsTuple()) {
+    return InvalidArgument(
+        "Tuple results must be untupled using ExecuteOptions::untuple_result.");
+  }
+  if (device_assignment_ == nullptr) {
+    return InvalidArgument("ExecuteBatch expects a non-null device_assignment");
+  }
+  if (addressable_devices_.size() != 1) {
+    return InvalidArgument(
+        "ExecuteBatch expects an executable with a single addressable device, "
+        "got %d addressable devices",
+        addressable_devices_.size());
+  }
+
+  const int replica = addressable_device_logical_ids_[0].replica;
+  const int partition = addressable_device_logical_ids_[0].partition;
+
+  VLOG(1) << "Executing computation " << name() << " for a batch of "
+          << argument_sets.size() << " argument sets";
+
+  std::vector<std::vector<std::unique_ptr<PjRtBuffer>>> wrapped_results;
+  wrapped_results.reserve(argument_sets.size());
+  if (returned_futures.has_value()) {
+    returned_futures->clear();
+    returned_futures->reserve(argument_sets.size());
+  }
+
+  // All executions in the batch depend only on the computations enqueued
+  // before the batch. We collect their execute events to make the whole batch
+  // the last enqueued computation once all executions are dispatched.
+  tsl::AsyncValueRef<CpuEvent> last_enqueue_event =
+      client_->GetLastEnqueueEvent();
+  std::vector<tsl::RCReference<tsl::AsyncValue>> execute_events;
+  execute_events.reserve(argument_sets.size());
+
+  for (size_t i = 0; i < argument_sets.size(); ++i) {
+    // Dispatch all but the last execution asynchronously to run them
+    // concurrently with the last one executed in the caller thread.
+    ExecuteOptions batch_options = options;
+    if (i + 1 < argument_sets.size() &&
+        options.execution_mode != ExecuteOptions::ExecutionMode::kSynchronous) {
+      batch_options.execution_mode = ExecuteOptions::ExecutionMode::kAsynchronous;
+    }
+
+    client_->SetLastEnqueueEvent(last_enqueue_event.CopyRef());
+    auto result = ExecuteHelper(
+        argument_sets[i], replica, partition, run_id, batch_options,
+        /*last_collective_launch_event=*/tsl::AsyncValueRef<CpuEvent>(),
+        returned_futures.has_value());
+    execute_events.push_back(client_->GetLastEnqueueEvent().CopyRCRef());
+
+    if (!result.ok()) {
+      client_->SetLastEnqueueEvent(last_enqueue_event.CopyRef());
+      return AppendStatus(
+          std::move(result).status(),
+          absl::StrFormat("while running argument set %d of a batch", i));
+    }
+
+    wrapped_results.push_back(std::move(result->buffers));
+    if (returned_futures.has_value()) {
+      returned_futures->push_back(std::move(*result->future));
+    }
+  }
+
+  // Make the batch the last enqueued computation.
+  auto batch_done_event = tsl::MakeConstructedAsyncValueRef<CpuEvent>();
+  tsl::RunWhenReady(absl::MakeConstSpan(execute_events),
+                    [batch_done_event] { batch_done_event.SetStateConcrete(); });
+  client_->SetLastEnqueueEvent(std::move(batch_done_event));
+
+  VLOG(1) << "Batched execution complete.";
+  return wrapped_results;
+}
+
 absl::StatusOr<std::vector<std::unique_ptr<PjRtBuffer>>>
 TfrtCpuExecutable::ExecuteSharded(
     absl::Span<PjRtBuffer* const> argument_handles, PjRtDevice* device,
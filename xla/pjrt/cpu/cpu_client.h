@@ -40,6 +40,7 @@ limitations under the License.
 #include "unsupported/Eigen/CXX11/Tensor"
 #include "mlir/IR/BuiltinOps.h"
 #include "xla/backends/cpu/collectives/cpu_collectives.h"
+#include "xla/backends/cpu/runtime/object_pool.h"
 #include "xla/executable_run_options.h"
 #include "xla/hlo/builder/xla_computation.h"
 #include "xla/hlo/ir/hlo_module.h"
@@ -81,7 +82,8 @@ class TfrtCpuClient final : public PjRtClient {
       int process_index, std::vector<std::unique_ptr<TfrtCpuDevice>> devices,
       std::shared_ptr<cpu::CpuCollectives> collectives, size_t num_threads,
       bool asynchronous,
-      std::function<void(HloModuleConfig&)> customize_hlo_module_config);
+      std::function<void(HloModuleConfig&)> customize_hlo_module_config,
+      bool numa_aware = false);
   ~TfrtCpuClient() override;
 
   int process_index() const override { return process_index_; }
@@ -190,8 +192,22 @@ class TfrtCpuClient final : public PjRtClient {
     return async_work_runner_.get();
   }
 
+  // Returns the intra-op thread pool device of the first NUMA node (or the
+  // only intra-op thread pool device if the client is not NUMA aware). All
+  // per-node thread pools have the same number of threads.
   Eigen::ThreadPoolDevice* eigen_intraop_device() const {
-    return eigen_intraop_device_.get();
+    return eigen_intraop_devices_.front().get();
+  }
+
+  // Returns the intra-op thread pool device of the NUMA node assigned to the
+  // given addressable device.
+  Eigen::ThreadPoolDevice* eigen_intraop_device(
+      const PjRtDevice* device) const;
+
+  // Returns the number of intra-op thread pools, one per NUMA node if the
+  // client is NUMA aware, or one otherwise.
+  size_t num_eigen_intraop_devices() const {
+    return eigen_intraop_devices_.size();
   }
 
   tsl::AsyncValueRef<CpuEvent> GetLastCollectiveLaunchEvent() {
@@ -244,8 +260,11 @@ class TfrtCpuClient final : public PjRtClient {
   std::vector<PjRtMemorySpace*> memory_spaces_;
 
   // TODO(zhangqiaorjc): Use tsl::compat::EigenHostContextThreadPool.
-  std::unique_ptr<tsl::thread::ThreadPool> eigen_intraop_pool_;
-  std::unique_ptr<Eigen::ThreadPoolDevice> eigen_intraop_device_;
+  //
+  // If the client is NUMA aware we have one intra-op thread pool per NUMA
+  // node, with all threads pinned to the corresponding node.
+  std::vector<std::unique_ptr<tsl::thread::ThreadPool>> eigen_intraop_pools_;
+  std::vector<std::unique_ptr<Eigen::ThreadPoolDevice>> eigen_intraop_devices_;
 
   // Thread pool for running PjRtClient tasks.
   std::unique_ptr<tsl::thread::ThreadPool> pjrt_client_thread_pool_;
@@ -268,8 +287,7 @@ class TfrtCpuClient final : public PjRtClient {
   // A cache for transpose plans. We use transposes to convert
   // (possibly strided) buffers provided to BufferFromHostBuffer into dense
   // major-to-minor layout.
-  absl::Mutex transpose_mu_;
-  TransposePlanCache transpose_cache_ ABSL_GUARDED_BY(transpose_mu_);
+  TransposePlanCache transpose_cache_;
 
   std::shared_ptr<cpu::CpuCollectives> collectives_;
 
@@ -326,6 +344,31 @@ class TfrtCpuBuffer final : public AbstractTfrtCpuBuffer {
   PjRtMemorySpace* const memory_space_;
 };
 
+// A memory arena that holds all temp allocations of a single execution of an
+// executable. Arenas are recycled across executions via a pool owned by the
+// executable, so that temp buffers do not go through the allocator (and do not
+// page fault on first touch) on every execution.
+class CpuTempArena {
+ public:
+  static absl::StatusOr<CpuTempArena> Allocate(size_t size_bytes);
+
+  std::byte* data() const { return data_.get(); }
+  size_t size_bytes() const { return size_bytes_; }
+
+ private:
+  struct Deleter {
+    void operator()(std::byte* ptr) const;
+  };
+
+  CpuTempArena(std::byte* data, size_t size_bytes)
+      : data_(data), size_bytes_(size_bytes) {}
+
+  std::unique_ptr<std::byte, Deleter> data_;
+  size_t size_bytes_;
+};
+
+using CpuTempArenaPool = cpu::ObjectPool<CpuTempArena>;
+
 class TfrtCpuExecutable final : public PjRtLoadedExecutable {
  public:
   TfrtCpuExecutable(
@@ -398,6 +441,21 @@ class TfrtCpuExecutable final : public PjRtLoadedExecutable {
       const ExecuteOptions& options,
       std::optional<std::vector<PjRtFuture<>>>& returned_futures) override;
 
+  // Executes the computation for a batch of independent argument sets on the
+  // single addressable device of the executable, and returns a vector of
+  // results for each argument set.
+  //
+  // Unlike calling `Execute` for each argument set, executions in the batch do
+  // not depend on each other (they all depend only on the computations enqueued
+  // before the batch), and all but the last one are dispatched asynchronously,
+  // so that their thunks run concurrently in the intra-op thread pool. If the
+  // execution mode is explicitly set to synchronous in `options`, executions
+  // run one by one in the caller thread.
+  absl::StatusOr<std::vector<std::vector<std::unique_ptr<PjRtBuffer>>>>
+  ExecuteBatch(absl::Span<const std::vector<PjRtBuffer*>> argument_sets,
+               const ExecuteOptions& options,
+               std::optional<std::vector<PjRtFuture<>>>& returned_futures);
+
   using PjRtLoadedExecutable::ExecuteSharded;
   absl::StatusOr<std::vector<std::unique_ptr<PjRtBuffer>>> ExecuteSharded(
       absl::Span<PjRtBuffer* const> argument_handles, PjRtDevice* device,
@@ -473,6 +531,16 @@ class TfrtCpuExecutable final : public PjRtLoadedExecutable {
   // be donated when executing the computation.
   std::vector<int> parameters_that_must_be_donated_;
 
+  // Offsets of temp allocations in the temp arena indexed by buffer allocation
+  // index; std::nullopt for allocations that are not carved out of the arena
+  // (parameters, constants and live out buffers).
+  std::vector<std::optional<size_t>> temp_arena_offsets_;
+
+  // A pool of temp arenas shared by all executions of the executable. Pool is
+  // shared with in-flight asynchronous executions that return borrowed arenas
+  // back to the pool when they complete. Null if there are no temp buffers.
+  std::shared_ptr<CpuTempArenaPool> temp_arena_pool_;
+
   // The replica and partition indices of device_assignment_ to be run by this
   // client. On single-host platforms without partitioning, this is all
   // replicas (i.e. addressable_device_logical_ids_[i] = (i, 0)), but this may
@@ -36,6 +36,8 @@ limitations under the License.
 #include "xla/ffi/ffi_api.h"
 #include "xla/hlo/builder/xla_computation.h"
 #include "xla/hlo/parser/hlo_parser.h"
+#include "xla/layout.h"
+#include "xla/layout_util.h"
 #include "xla/literal.h"
 #include "xla/literal_util.h"
 #include "xla/pjrt/cpu/cpu_client.h"
@@ -220,6 +222,168 @@ TEST(TfrtCpuClientTest, HloSnapshot) {
       LiteralUtil::CreateR2<float>({{11.0, 22.0}, {33.0, 44.0}, {55.0, 66.0}}));
 }
 
+TEST(TfrtCpuClientTest, NumaAwareExecute) {
+  static constexpr char kProgram[] = R"(
+    HloModule add
+    ENTRY add {
+      x = f32[3,2] parameter(0)
+      y = f32[3,2] parameter(1)
+      ROOT add = f32[3,2] add(x, y)
+    })";
+
+  CpuClientOptions cpu_options;
+  cpu_options.cpu_device_count = 2;
+  cpu_options.numa_aware = true;
+  TF_ASSERT_OK_AND_ASSIGN(auto client,
+                          GetTfrtCpuClient(std::move(cpu_options)));
+
+  // Every device must be assigned to one of the per-node intra-op pools, and
+  // on single node hosts we must fall back to a single intra-op pool.
+  auto* cpu_client = static_cast<TfrtCpuClient*>(client.get());
+  ASSERT_GE(cpu_client->num_eigen_intraop_devices(), 1);
+  for (PjRtDevice* device : client->addressable_devices()) {
+    EXPECT_NE(cpu_client->eigen_intraop_device(device), nullptr);
+  }
+
+  TF_ASSERT_OK_AND_ASSIGN(auto hlo_module,
+                          ParseAndReturnUnverifiedModule(kProgram, {}));
+  XlaComputation xla_computation(hlo_module->ToProto());
+  TF_ASSERT_OK_AND_ASSIGN(auto pjrt_executable,
+                          client->CompileAndLoad(xla_computation, {}));
+
+  std::vector<float> data{1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+  Shape shape = ShapeUtil::MakeShape(F32, {3, 2});
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto buffer,
+      client->BufferFromHostBuffer(
+          data.data(), shape.element_type(), shape.dimensions(),
+          /*byte_strides=*/std::nullopt,
+          PjRtClient::HostBufferSemantics::kImmutableOnlyDuringCall, nullptr,
+          client->memory_spaces()[0], /*device_layout=*/nullptr));
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto result, pjrt_executable->Execute(
+                       /*argument_handles=*/{{buffer.get(), buffer.get()}},
+                       /*options=*/{}));
+  ASSERT_EQ(result.size(), 1);
+  ASSERT_EQ(result[0].size(), 1);
+
+  TF_ASSERT_OK_AND_ASSIGN(auto literal, result[0][0]->ToLiteralSync());
+  EXPECT_TRUE(LiteralTestUtil::Equal(
+      LiteralUtil::CreateR2<float>({{2.0, 4.0}, {6.0, 8.0}, {10.0, 12.0}}),
+      *literal));
+}
+
+TEST(TfrtCpuClientTest, ExecuteBatch) {
+  static constexpr char kProgram[] = R"(
+    HloModule add
+    ENTRY add {
+      x = f32[3,2] parameter(0)
+      y = f32[3,2] parameter(1)
+      ROOT add = f32[3,2] add(x, y)
+    })";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto client, GetTfrtCpuClient(CpuClientOptions()));
+  TF_ASSERT_OK_AND_ASSIGN(auto hlo_module,
+                          ParseAndReturnUnverifiedModule(kProgram, {}));
+  XlaComputation xla_computation(hlo_module->ToProto());
+  TF_ASSERT_OK_AND_ASSIGN(auto pjrt_executable,
+                          client->CompileAndLoad(xla_computation, {}));
+  auto* executable = static_cast<TfrtCpuExecutable*>(pjrt_executable.get());
+
+  static constexpr int kBatchSize = 3;
+  Shape shape = ShapeUtil::MakeShape(F32, {3, 2});
+
+  std::vector<std::unique_ptr<PjRtBuffer>> buffers;
+  std::vector<std::vector<PjRtBuffer*>> argument_sets;
+  for (int i = 0; i < kBatchSize; ++i) {
+    std::vector<float> data(6, static_cast<float>(i + 1));
+    TF_ASSERT_OK_AND_ASSIGN(
+        buffers.emplace_back(),
+        client->BufferFromHostBuffer(
+            data.data(), shape.element_type(), shape.dimensions(),
+            /*byte_strides=*/std::nullopt,
+            PjRtClient::HostBufferSemantics::kImmutableOnlyDuringCall, nullptr,
+            client->memory_spaces()[0], /*device_layout=*/nullptr));
+    argument_sets.push_back({buffers.back().get(), buffers.back().get()});
+  }
+
+  std::optional<std::vector<PjRtFuture<>>> futures;
+  futures.emplace();
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto results, executable->ExecuteBatch(argument_sets, /*options=*/{},
+                                             futures));
+  ASSERT_EQ(results.size(), kBatchSize);
+  ASSERT_EQ(futures->size(), kBatchSize);
+
+  for (int i = 0; i < kBatchSize; ++i) {
+    TF_ASSERT_OK((*futures)[i].Await());
+    ASSERT_EQ(results[i].size(), 1);
+    TF_ASSERT_OK_AND_ASSIGN(auto literal, results[i][0]->ToLiteralSync());
+    float expected = 2.0f * (i + 1);
+    EXPECT_TRUE(LiteralTestUtil::Equal(
+        LiteralUtil::CreateR2<float>({{expected, expected},
+                                      {expected, expected},
+                                      {expected, expected}}),
+        *literal));
+  }
+}
+
+TEST(TfrtCpuClientTest, ConcurrentExecuteWithTempBuffers) {
+  // `dot` result is a temp buffer that is carved out of a temp arena, and
+  // concurrent executions must use different arenas.
+  static constexpr char kProgram[] = R"(
+    HloModule dot_add
+    ENTRY dot_add {
+      x = f32[2,2] parameter(0)
+      y = f32[2,2] parameter(1)
+      dot = f32[2,2] dot(x, y),
+        lhs_contracting_dims={1}, rhs_contracting_dims={0}
+      ROOT add = f32[2,2] add(dot, x)
+    })";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto client, GetTfrtCpuClient(CpuClientOptions()));
+  TF_ASSERT_OK_AND_ASSIGN(auto hlo_module,
+                          ParseAndReturnUnverifiedModule(kProgram, {}));
+  XlaComputation xla_computation(hlo_module->ToProto());
+  TF_ASSERT_OK_AND_ASSIGN(auto pjrt_executable,
+                          client->CompileAndLoad(xla_computation, {}));
+
+  static constexpr int kNumExecutions = 8;
+  Shape shape = ShapeUtil::MakeShape(F32, {2, 2});
+
+  std::vector<std::unique_ptr<PjRtBuffer>> buffers;
+  std::vector<std::vector<std::unique_ptr<PjRtBuffer>>> results;
+  ExecuteOptions options;
+  options.execution_mode = ExecuteOptions::ExecutionMode::kAsynchronous;
+  for (int i = 0; i < kNumExecutions; ++i) {
+    std::vector<float> data(4, static_cast<float>(i));
+    TF_ASSERT_OK_AND_ASSIGN(
+        buffers.emplace_back(),
+        client->BufferFromHostBuffer(
+            data.data(), shape.element_type(), shape.dimensions(),
+            /*byte_strides=*/std::nullopt,
+            PjRtClient::HostBufferSemantics::kImmutableOnlyDuringCall, nullptr,
+            client->memory_spaces()[0], /*device_layout=*/nullptr));
+    TF_ASSERT_OK_AND_ASSIGN(
+        auto result,
+        pjrt_executable->Execute({{buffers.back().get(), buffers.back().get()}},
+                                 options));
+    ASSERT_EQ(result.size(), 1);
+    ASSERT_EQ(result[0].size(), 1);
+    results.push_back(std::move(result[0]));
+  }
+
+  for (int i = 0; i < kNumExecutions; ++i) {
+    TF_ASSERT_OK_AND_ASSIGN(auto literal, results[i][0]->ToLiteralSync());
+    float expected = 2.0f * i * i + i;
+    EXPECT_TRUE(LiteralTestUtil::Equal(
+        LiteralUtil::CreateR2<float>(
+            {{expected, expected}, {expected, expected}}),
+        *literal));
+  }
+}
+
 TEST(TfrtCpuClientTest, AsyncTransferRawData) {
   TF_ASSERT_OK_AND_ASSIGN(auto client, GetTfrtCpuClient(CpuClientOptions()));
   xla::Shape shape = ShapeUtil::MakeShape(U32, {3, 2});
@@ -305,6 +469,50 @@ TEST(TfrtCpuClientTest, BufferFromLiteralInt4) {
               ElementsAreArray(literal.data<s4>()));
 }
 
+TEST(TfrtCpuClientTest, ZeroCopyBufferWithDeviceLayout) {
+  TF_ASSERT_OK_AND_ASSIGN(auto client, GetTfrtCpuClient(CpuClientOptions()));
+  // A column-major f32[2,3] array.
+  alignas(64) float data[] = {1, 4, 2, 5, 3, 6};
+  const std::vector<int64_t> dims = {2, 3};
+  const std::vector<int64_t> byte_strides = {4, 8};
+  const Layout layout = LayoutUtil::MakeLayout({0, 1});
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto buffer,
+      client->BufferFromHostBuffer(
+          data, F32, dims, byte_strides,
+          PjRtClient::HostBufferSemantics::kImmutableZeroCopy, nullptr,
+          client->memory_spaces()[0], &layout));
+
+  EXPECT_EQ(buffer->on_device_shape().layout(), layout);
+  TF_ASSERT_OK_AND_ASSIGN(auto external_reference,
+                          buffer->AcquireExternalReference());
+  EXPECT_EQ(external_reference->OpaqueDeviceMemoryDataPointer(), data);
+  TF_ASSERT_OK_AND_ASSIGN(auto literal, buffer->ToLiteralSync());
+  EXPECT_TRUE(LiteralTestUtil::Equal(
+      LiteralUtil::CreateR2<float>({{1, 2, 3}, {4, 5, 6}}), *literal));
+}
+
+TEST(TfrtCpuClientTest, TransposesBufferIntoDeviceLayout) {
+  TF_ASSERT_OK_AND_ASSIGN(auto client, GetTfrtCpuClient(CpuClientOptions()));
+  alignas(64) float data[] = {1, 2, 3, 4, 5, 6};
+  const std::vector<int64_t> dims = {2, 3};
+  const Layout layout = LayoutUtil::MakeLayout({0, 1});
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto buffer,
+      client->BufferFromHostBuffer(
+          data, F32, dims, /*byte_strides=*/std::nullopt,
+          PjRtClient::HostBufferSemantics::kImmutableZeroCopy, nullptr,
+          client->memory_spaces()[0], &layout));
+
+  EXPECT_EQ(buffer->on_device_shape().layout(), layout);
+  TF_ASSERT_OK_AND_ASSIGN(auto external_reference,
+                          buffer->AcquireExternalReference());
+  EXPECT_NE(external_reference->OpaqueDeviceMemoryDataPointer(), data);
+  TF_ASSERT_OK_AND_ASSIGN(auto literal, buffer->ToLiteralSync());
+  EXPECT_TRUE(LiteralTestUtil::Equal(
+      LiteralUtil::CreateR2<float>({{1, 2, 3}, {4, 5, 6}}), *literal));
+}
+
 TEST(TfrtCpuClientTest, CopyToMemorySpace) {
   TF_ASSERT_OK_AND_ASSIGN(auto client, GetTfrtCpuClient(CpuClientOptions()));
   xla::Shape shape = xla::ShapeUtil::MakeShape(S32, {128, 256});
@@ -25,6 +25,7 @@ limitations under the License.
 #include "absl/log/log.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "absl/time/time.h"
@@ -260,6 +261,21 @@ class DistributedKeyValueStore : public KeyValueStoreInterface {
     return client_->KeyValueTryGet(absl::StrCat(prefix_, key));
   }
 
+  absl::StatusOr<std::vector<std::pair<std::string, std::string>>>
+  TryGetWithPrefix(absl::string_view key_prefix) override {
+    TF_ASSIGN_OR_RETURN(
+        auto kvs, client_->KeyValueDirGet(absl::StrCat(prefix_, key_prefix)));
+    std::vector<std::pair<std::string, std::string>> result;
+    result.reserve(kvs.size());
+    for (auto& [key, value] : kvs) {
+      absl::string_view stripped_key = key;
+      if (absl::ConsumePrefix(&stripped_key, prefix_)) {
+        result.emplace_back(std::string(stripped_key), std::move(value));
+      }
+    }
+    return result;
+  }
+
   absl::Status Set(absl::string_view key, absl::string_view value) override {
     return client_->KeyValueSet(absl::StrCat(prefix_, key), value);
   }
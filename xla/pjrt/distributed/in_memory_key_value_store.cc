@@ -16,9 +16,12 @@ limitations under the License.
 #include "xla/pjrt/distributed/in_memory_key_value_store.h"
 
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
@@ -52,6 +55,18 @@ absl::StatusOr<std::string> InMemoryKeyValueStore::TryGet(
   return it->second;
 }
 
+absl::StatusOr<std::vector<std::pair<std::string, std::string>>>
+InMemoryKeyValueStore::TryGetWithPrefix(absl::string_view key_prefix) {
+  absl::MutexLock lock(&mu_);
+  std::vector<std::pair<std::string, std::string>> kvs;
+  for (const auto& [key, value] : kv_store_) {
+    if (absl::StartsWith(key, key_prefix)) {
+      kvs.emplace_back(key, value);
+    }
+  }
+  return kvs;
+}
+
 absl::Status InMemoryKeyValueStore::Set(absl::string_view key,
                                         absl::string_view value) {
   absl::MutexLock lock(&mu_);
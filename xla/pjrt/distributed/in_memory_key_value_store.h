@@ -17,6 +17,8 @@ limitations under the License.
 #define XLA_PJRT_DISTRIBUTED_IN_MEMORY_KEY_VALUE_STORE_H_
 
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/status/status.h"
@@ -40,6 +42,9 @@ class InMemoryKeyValueStore : public KeyValueStoreInterface {
 
   absl::StatusOr<std::string> TryGet(absl::string_view key) override;
 
+  absl::StatusOr<std::vector<std::pair<std::string, std::string>>>
+  TryGetWithPrefix(absl::string_view key_prefix) override;
+
   absl::Status Set(absl::string_view key, absl::string_view value) override;
 
  private:
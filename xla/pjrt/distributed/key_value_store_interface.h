@@ -18,6 +18,8 @@ limitations under the License.
 
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -50,6 +52,16 @@ class KeyValueStoreInterface {
   // on potentially concurrent ops (e.g. set, delete), use WaitAtBarrier().
   virtual absl::StatusOr<std::string> TryGet(absl::string_view key) = 0;
 
+  // Returns all the key-value pairs whose keys start with `key_prefix`, without
+  // waiting for any of them to be set. Keys are returned as passed to Set().
+  // Useful for reading many keys in a single round trip instead of one per key.
+  // There are no concurrency guarantees. Stores that can't list keys return
+  // `UnimplementedError`.
+  virtual absl::StatusOr<std::vector<std::pair<std::string, std::string>>>
+  TryGetWithPrefix(absl::string_view key_prefix) {
+    return absl::UnimplementedError("TryGetWithPrefix is not supported.");
+  }
+
   virtual absl::Status Set(absl::string_view key, absl::string_view value) = 0;
 };
 
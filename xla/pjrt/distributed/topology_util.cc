@@ -20,12 +20,15 @@ limitations under the License.
 #include <map>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/ascii.h"
+#include "absl/strings/match.h"
+#include "absl/strings/numbers.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_join.h"
 #include "absl/strings/substitute.h"
@@ -109,9 +112,13 @@ absl::StatusOr<std::string> GetBootIdString() {
   return boot_id_str;
 }
 
+static std::string GetLocalTopologyKeyPrefix(absl::string_view platform) {
+  return absl::StrCat("local_topology/", platform, "/");
+}
+
 static std::string GetLocalTopologyKey(absl::string_view platform,
                                        int node_id) {
-  return absl::StrCat("local_topology/", platform, "/", node_id);
+  return absl::StrCat(GetLocalTopologyKeyPrefix(platform), node_id);
 }
 
 static std::string GetGlobalTopologyKey(absl::string_view platform) {
@@ -123,13 +130,45 @@ static absl::StatusOr<std::vector<LocalTopologyProto>> GetAllLocalTopologies(
     absl::Duration timeout) {
   std::vector<absl::StatusOr<std::string>> local_topology_strs(num_nodes);
 
+  // Reads the local topologies that are already published in one round trip,
+  // so that only the nodes that haven't published theirs yet need a blocking
+  // Get(). With many nodes, this avoids one request per node to the store.
+  std::vector<bool> found(num_nodes, false);
+  const std::string key_prefix = GetLocalTopologyKeyPrefix(platform);
+  absl::StatusOr<std::vector<std::pair<std::string, std::string>>> published =
+      kv_store->TryGetWithPrefix(key_prefix);
+  if (published.ok()) {
+    for (auto& [key, value] : *published) {
+      absl::string_view node_id_str = key;
+      int node_id;
+      if (absl::ConsumePrefix(&node_id_str, key_prefix) &&
+          absl::SimpleAtoi(node_id_str, &node_id) && node_id >= 0 &&
+          node_id < num_nodes) {
+        local_topology_strs[node_id] = std::move(value);
+        found[node_id] = true;
+      }
+    }
+  } else if (!absl::IsUnimplemented(published.status())) {
+    VLOG(1) << "Failed to list the local topologies, falling back to getting "
+               "them one by one: "
+            << published.status();
+  }
+  std::vector<int> missing_nodes;
+  for (int i = 0; i < num_nodes; i++) {
+    if (!found[i]) {
+      missing_nodes.push_back(i);
+    }
+  }
+  VLOG(2) << "Found " << num_nodes - missing_nodes.size() << " of "
+          << num_nodes << " local topologies already published";
+
   // TODO(ezhulenev): Should a thread pool become a function argument?
   tsl::thread::ThreadPool thread_pool(
       tsl::Env::Default(), "GetAllLocalTopologies", DefaultThreadPoolSize());
 
-  absl::BlockingCounter blocking_counter(num_nodes);
+  absl::BlockingCounter blocking_counter(missing_nodes.size());
   absl::Mutex mu;
-  for (int i = 0; i < num_nodes; i++) {
+  for (int i : missing_nodes) {
     thread_pool.Schedule([&, i] {
       absl::StatusOr<std::string> local_topology_str =
           kv_store->Get(GetLocalTopologyKey(platform, i), timeout);
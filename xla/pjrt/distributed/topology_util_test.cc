@@ -15,11 +15,15 @@ limitations under the License.
 
 #include "xla/pjrt/distributed/topology_util.h"
 
+#include <atomic>
 #include <string>
 #include <vector>
 
 #include <gmock/gmock.h>
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
 #include "absl/time/time.h"
 #include "absl/types/span.h"
 #include "xla/pjrt/distributed/in_memory_key_value_store.h"
@@ -163,6 +167,45 @@ TEST(TopologyTest, ExchangeTopology) {
   }
 }
 
+// Counts the blocking Get() calls.
+class CountingKeyValueStore : public InMemoryKeyValueStore {
+ public:
+  absl::StatusOr<std::string> Get(absl::string_view key,
+                                  absl::Duration timeout) override {
+    ++num_gets_;
+    return InMemoryKeyValueStore::Get(key, timeout);
+  }
+
+  int num_gets() const { return num_gets_; }
+
+ private:
+  std::atomic<int> num_gets_ = 0;
+};
+
+TEST(TopologyTest, ExchangeTopology_PublishedLocalTopologies_NoBlockingGets) {
+  int num_nodes = 3;
+  std::vector<LocalTopologyProto> locals(num_nodes);
+  for (int i = 0; i < num_nodes; i++) {
+    locals[i].set_node_id(i);
+    locals[i].add_devices()->set_local_device_ordinal(0);
+  }
+
+  CountingKeyValueStore kv_store;
+  for (int i = 1; i < num_nodes; i++) {
+    TF_ASSERT_OK(kv_store.Set(absl::StrCat("local_topology/cuda/", i),
+                              locals[i].SerializeAsString()));
+  }
+  GlobalTopologyProto global;
+  TF_ASSERT_OK(ExchangeTopologies(
+      /*platform=*/"cuda", /*node_id=*/0, num_nodes,
+      /*get_local_topology_timeout=*/absl::Seconds(10),
+      /*get_global_topology_timeout=*/absl::Seconds(10), &kv_store, locals[0],
+      &global, /*assign_global_device_ids=*/true));
+
+  EXPECT_EQ(global.nodes_size(), num_nodes);
+  EXPECT_EQ(kv_store.num_gets(), 0);
+}
+
 TEST(TopologyTest, ExchangeTopology_Twice_Succeeds) {
   int num_nodes = 2;
   std::vector<LocalTopologyProto> locals(num_nodes);
@@ -15,10 +15,15 @@ limitations under the License.
 
 #include "xla/pjrt/gpu/nccl_id_store.h"
 
+#include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
+#include "absl/log/log.h"
+#include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
 #include "absl/synchronization/mutex.h"
 #include "absl/time/time.h"
 #include "xla/backends/gpu/collectives/gpu_clique_key.h"
@@ -33,6 +38,43 @@ limitations under the License.
 
 namespace xla {
 
+// Prefix of the key-value store keys of the ids, so that they can be listed.
+static constexpr char kNcclIdKeyPrefix[] = "nccl_id/";
+
+std::optional<CliqueId> NcclIdStore::GetPublishedNcclUniqueId(
+    const std::string& kv_key) {
+  {
+    absl::MutexLock lock(&mu_);
+    auto it = published_.find(kv_key);
+    if (it != published_.end()) {
+      return it->second;
+    }
+    if (listing_unsupported_) {
+      return std::nullopt;
+    }
+  }
+  absl::StatusOr<std::vector<std::pair<std::string, std::string>>> kvs =
+      kv_store_->TryGetWithPrefix(kNcclIdKeyPrefix);
+  absl::MutexLock lock(&mu_);
+  if (!kvs.ok()) {
+    if (absl::IsUnimplemented(kvs.status())) {
+      listing_unsupported_ = true;
+    } else {
+      VLOG(1) << "Failed to list the published NCCL ids: " << kvs.status();
+    }
+    return std::nullopt;
+  }
+  VLOG(3) << "Fetched " << kvs->size() << " published NCCL ids";
+  for (auto& [key, value] : *kvs) {
+    published_.try_emplace(key, value);
+  }
+  auto it = published_.find(kv_key);
+  if (it == published_.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
 absl::StatusOr<CliqueId> NcclIdStore::GetNcclUniqueId(const CliqueKey& key) {
   auto* gpu_key = tsl::down_cast<const gpu::GpuCliqueKey*>(&key);
   if (gpu_key == nullptr) {
@@ -49,15 +91,19 @@ absl::StatusOr<CliqueId> NcclIdStore::GetNcclUniqueId(const CliqueKey& key) {
     }
   }
   CliqueId clique_id;
+  const std::string kv_key =
+      absl::StrCat(kNcclIdKeyPrefix, gpu_key->ToString());
   int primary_node_id = device_to_node_.at(gpu_key->root_device());
   if (node_id_ == primary_node_id) {
     TF_ASSIGN_OR_RETURN(clique_id,
                         gpu::GpuCollectives::Default()->CreateUniqueCliqueId());
-    TF_RETURN_IF_ERROR(
-        kv_store_->Set(gpu_key->ToString(), clique_id.ToString()));
+    TF_RETURN_IF_ERROR(kv_store_->Set(kv_key, clique_id.ToString()));
+  } else if (std::optional<CliqueId> published =
+                 GetPublishedNcclUniqueId(kv_key)) {
+    clique_id = *std::move(published);
   } else {
     TF_ASSIGN_OR_RETURN(std::string id_str,
-                        kv_store_->Get(gpu_key->ToString(), absl::Minutes(10)));
+                        kv_store_->Get(kv_key, absl::Minutes(10)));
     clique_id = CliqueId(id_str);
   }
   absl::MutexLock lock(&mu_);
@@ -17,6 +17,8 @@ limitations under the License.
 #define XLA_PJRT_GPU_NCCL_ID_STORE_H_
 
 #include <memory>
+#include <optional>
+#include <string>
 #include <utility>
 
 #include "absl/base/thread_annotations.h"
@@ -34,6 +36,11 @@ namespace xla {
 // A table mapping GpuCliqueKeys to CliqueIds. In a distributed setup the
 // table of NCCL IDs is kept on the master node (node 0). The node of the first
 // participating device will create the unique id.
+//
+// The other nodes read all the ids published so far in a single round trip to
+// the key-value store when they miss one, so that the ids of the cliques they
+// need next are usually already fetched, and only block on ids that haven't
+// been published yet.
 class NcclIdStore {
  public:
   NcclIdStore(int node_id,
@@ -46,12 +53,20 @@ class NcclIdStore {
   absl::StatusOr<CliqueId> GetNcclUniqueId(const CliqueKey& key);
 
  private:
+  // Returns the id published under `kv_key`, if it has been published already.
+  // Caches all the other published ids for later lookups.
+  std::optional<CliqueId> GetPublishedNcclUniqueId(const std::string& kv_key);
+
   const int node_id_;
   const absl::flat_hash_map<GlobalDeviceId, int> device_to_node_;
   const std::shared_ptr<KeyValueStoreInterface> kv_store_;
 
   absl::Mutex mu_;
   absl::flat_hash_map<gpu::GpuCliqueKey, CliqueId> cache_ ABSL_GUARDED_BY(mu_);
+  // Ids published by other nodes, keyed by their key-value store key.
+  absl::flat_hash_map<std::string, CliqueId> published_ ABSL_GUARDED_BY(mu_);
+  // Whether the key-value store can't list the published ids.
+  bool listing_unsupported_ ABSL_GUARDED_BY(mu_) = false;
 };
 
 }  // namespace xla
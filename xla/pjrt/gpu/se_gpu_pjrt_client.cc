@@ -16,10 +16,12 @@ limitations under the License.
 #include "xla/pjrt/gpu/se_gpu_pjrt_client.h"
 
 #include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <iterator>
 #include <map>
 #include <memory>
 #include <optional>
@@ -73,9 +75,11 @@ limitations under the License.
 #include "xla/pjrt/stream_executor_executable.h"
 #include "xla/pjrt/tracked_device_buffer.h"
 #include "xla/pjrt/worker_thread.h"
+#include "xla/primitive_util.h"
 #include "xla/service/compiler.h"
 #include "xla/service/computation_placer.h"
 #include "xla/service/global_device_id.h"
+#include "xla/service/service_executable_run_options.h"
 #include "xla/service/shaped_buffer.h"
 #include "xla/service/transfer_manager.h"
 #include "xla/shape.h"
@@ -94,6 +98,7 @@ limitations under the License.
 #include "tsl/platform/casts.h"
 #include "tsl/platform/errors.h"
 #include "tsl/platform/fingerprint.h"
+#include "tsl/platform/mem.h"
 #include "tsl/platform/protobuf.h"
 #include "tsl/platform/status.h"
 #include "tsl/platform/statusor.h"
@@ -782,6 +787,266 @@ PjRtFuture<> StreamExecutorGpuClient::CopyRawSubBufferToHost(
       });
 }
 
+PjRtFuture<> StreamExecutorGpuClient::CopyToHostBatch(
+    absl::Span<PjRtBuffer* const> buffers,
+    absl::Span<MutableLiteralBase* const> literals) {
+  if (buffers.size() != literals.size()) {
+    return PjRtFuture<>(InvalidArgument(
+        "CopyToHostBatch called with %d buffers and %d literals",
+        buffers.size(), literals.size()));
+  }
+
+  // Buffers packed into the batched transfer, at `offset` bytes into the
+  // staging buffers.
+  struct PackedBuffer {
+    tsl::RCReference<RawSEDeviceMemory> device_memory;
+    MutableLiteralBase* literal;
+    int64_t offset;
+  };
+  std::vector<PackedBuffer> packed_buffers;
+  std::vector<std::shared_ptr<BufferSequencingEvent>> definition_events;
+  std::vector<PjRtFuture<>> futures;
+  int64_t total_size = 0;
+
+  PjRtStreamExecutorDevice* device = nullptr;
+  se::Stream* stream = nullptr;
+  auto usage_event =
+      std::make_shared<BufferSequencingEvent>(this->thread_pool());
+
+  for (int i = 0; i < buffers.size(); ++i) {
+    auto* buffer = tensorflow::down_cast<PjRtStreamExecutorBuffer*>(buffers[i]);
+    const Shape& shape = buffer->on_device_shape();
+    // Only buffers whose device bytes are exactly the literal's bytes can be
+    // unpacked with a plain memcpy.
+    bool can_pack =
+        shape.IsArray() && shape.is_static() &&
+        !primitive_util::IsSubByteNonPredType(shape.element_type()) &&
+        Shape::Equal().IgnoreMemorySpaceInLayout()(shape,
+                                                   literals[i]->shape()) &&
+        buffer->memory_space()->kind_id() ==
+            StreamExecutorGpuHbmMemorySpace::kKindId &&
+        (device == nullptr || device == buffer->device());
+    if (!can_pack) {
+      futures.push_back(buffer->ToLiteral(literals[i]));
+      continue;
+    }
+
+    PjRtStreamExecutorBuffer::ScopedHold hold(buffer->GetBufferWithUsageHold());
+    if (!hold.ok()) {
+      futures.push_back(PjRtFuture<>(InvalidArgument(
+          "CopyToHostBatch() called on deleted or donated buffer: %s",
+          hold.status().ToString())));
+      continue;
+    }
+
+    if (device == nullptr) {
+      device = buffer->device();
+      stream = device->local_device_state()->GetDeviceToHostStream();
+    }
+    int64_t size = hold->device_memory()->mem().size();
+    packed_buffers.push_back({hold->device_memory(), literals[i], total_size});
+    total_size += size;
+    absl::c_copy(hold->definition_events(),
+                 std::back_inserter(definition_events));
+
+    // See CopyRawSubBufferToHost for why a reference to the buffer is held
+    // until the copy completes.
+    hold.ConvertUsageHold(stream, usage_event, /*reference_held=*/true);
+  }
+
+  if (packed_buffers.empty()) {
+    return JoinFutures(futures);
+  }
+
+  LocalDeviceState* local_device = device->local_device_state();
+  auto promise = PjRtFuture<>::CreatePromise();
+  futures.push_back(PjRtFuture<>(promise));
+
+  auto async_copy = [this, promise, stream, local_device, total_size,
+                     packed_buffers = std::move(packed_buffers),
+                     definition_events,
+                     usage_event = std::move(usage_event)]() mutable {
+    tsl::profiler::TraceMe traceme("StreamExecutorGpuClient::CopyToHostBatch");
+    absl::StatusOr<EventPool::Handle> event =
+        local_device->event_pool().AllocateEvent(stream->parent());
+    if (!event.ok()) {
+      promise.Set(event.status());
+      return;
+    }
+
+    for (const std::shared_ptr<BufferSequencingEvent>& definition_event :
+         definition_events) {
+      absl::Status defined_status = definition_event->GetDefinedStatus();
+      if (!defined_status.ok()) {
+        promise.Set(defined_status);
+        return;
+      }
+    }
+
+    absl::StatusOr<se::OwningDeviceMemory> device_staging =
+        allocator()->Allocate(stream->parent()->device_ordinal(), total_size);
+    if (!device_staging.ok()) {
+      promise.Set(device_staging.status());
+      return;
+    }
+    // The staging buffer is allocated in compute stream order, so it is only
+    // safe to write to it once the compute stream has passed this point.
+    if (local_device->allocation_model() ==
+        LocalDeviceState::kComputeSynchronized) {
+      if (absl::Status status = stream->WaitFor(local_device->compute_stream());
+          !status.ok()) {
+        promise.Set(std::move(status));
+        return;
+      }
+    }
+
+    std::shared_ptr<void> host_staging;
+    if (host_memory_allocator() != nullptr) {
+      host_staging = std::shared_ptr<void>(
+          host_memory_allocator()->AllocateRaw(
+              tsl::Allocator::kAllocatorAlignment, total_size),
+          [host_memory_allocator = host_memory_allocator()](void* ptr) {
+            host_memory_allocator->DeallocateRaw(ptr);
+          });
+    } else {
+      host_staging = std::shared_ptr<void>(
+          tsl::port::AlignedMalloc(total_size,
+                                   tsl::Allocator::kAllocatorAlignment),
+          tsl::port::AlignedFree);
+    }
+
+    WaitForBufferDefinitionEventsOnStream(absl::MakeSpan(definition_events),
+                                          stream);
+
+    // Gather the buffers into the contiguous device staging buffer, then
+    // fetch all of them with a single device-to-host transfer.
+    se::DeviceMemoryBase staging_memory = device_staging->cref();
+    for (const PackedBuffer& packed : packed_buffers) {
+      const se::DeviceMemoryBase& src = packed.device_memory->mem();
+      if (src.size() == 0) {
+        continue;
+      }
+      se::DeviceMemoryBase dst =
+          staging_memory.GetByteSlice(packed.offset, src.size());
+      if (absl::Status status = stream->MemcpyD2D(&dst, src, src.size());
+          !status.ok()) {
+        promise.Set(std::move(status));
+        return;
+      }
+    }
+    if (total_size != 0) {
+      if (absl::Status status =
+              stream->Memcpy(host_staging.get(), staging_memory, total_size);
+          !status.ok()) {
+        promise.Set(std::move(status));
+        return;
+      }
+    }
+
+    local_device->event_pool().ThenRecordEvent(stream, event.value());
+    usage_event->SetSequencingEvent(std::move(event).value(), stream);
+
+    auto callback_status = local_device->ThenExecuteCallback(
+        stream, [promise, host_staging = std::move(host_staging),
+                 device_staging = std::move(device_staging).value(),
+                 packed_buffers = std::move(packed_buffers)]() mutable {
+          for (const PackedBuffer& packed : packed_buffers) {
+            std::memcpy(packed.literal->untyped_data(),
+                        static_cast<const char*>(host_staging.get()) +
+                            packed.offset,
+                        packed.device_memory->mem().size());
+          }
+          promise.Set();
+        });
+    if (!callback_status.ok()) {
+      promise.Set(std::move(callback_status));
+    }
+  };
+
+  // Start the copy once all packed buffers have their definition events
+  // recorded. Trampoline through a thread pool since GPUs do not allow calling
+  // D2H inside the callback's context.
+  auto pending =
+      std::make_shared<std::atomic<int64_t>>(definition_events.size());
+  auto shared_copy =
+      std::make_shared<decltype(async_copy)>(std::move(async_copy));
+  for (const std::shared_ptr<BufferSequencingEvent>& definition_event :
+       definition_events) {
+    definition_event->ExecuteOrAddToFutureTasks(
+        absl::StrFormat("async_copy_to_host_batch_%p", shared_copy.get()),
+        [this, pending, shared_copy]() {
+          if (pending->fetch_sub(1) == 1) {
+            thread_pool()->Schedule([shared_copy]() { (*shared_copy)(); });
+          }
+        });
+  }
+
+  return JoinFutures(futures);
+}
+
+absl::Status StreamExecutorGpuClient::WarmUpCollectiveCliques(
+    PjRtLoadedExecutable& executable) {
+  auto* se_executable =
+      tensorflow::down_cast<PjRtStreamExecutorLoadedExecutable*>(&executable);
+  absl::Span<const std::shared_ptr<LocalExecutable>> executables =
+      se_executable->executables();
+  absl::Span<PjRtDevice* const> devices = se_executable->addressable_devices();
+  absl::Span<const PjRtLoadedExecutable::LogicalDeviceIds> logical_ids =
+      se_executable->addressable_device_logical_ids();
+  DeviceAssignment device_assignment = se_executable->device_assignment();
+  RunId run_id;
+
+  tsl::profiler::TraceMe traceme(
+      "StreamExecutorGpuClient::WarmUpCollectiveCliques");
+
+  // Clique initialization is a rendezvous of all local participants, so warm
+  // up all devices concurrently, like an execution does.
+  absl::Mutex mu;
+  int running = devices.size();
+  std::vector<absl::Status> statuses(devices.size());
+  for (int i = 0; i < devices.size(); ++i) {
+    LocalDeviceState* device_state =
+        tensorflow::down_cast<PjRtStreamExecutorDevice*>(devices[i])
+            ->local_device_state();
+    device_state->execute_thread()->Schedule([&, device_state, i] {
+      int executable_idx =
+          executables.size() > 1 ? logical_ids[i].partition : 0;
+      ExecutableRunOptions run_options;
+      run_options.set_stream(device_state->compute_stream());
+      run_options.set_device_ordinal(device_state->local_device_id().value());
+      run_options.set_local_device_count(client()->device_count());
+      run_options.set_physical_device_ordinal(
+          device_state->local_hardware_id().value());
+      run_options.set_allocator(allocator());
+      run_options.set_device_assignment(&device_assignment);
+      run_options.set_run_id(run_id);
+      run_options.set_gpu_executable_run_options(gpu_run_options());
+      ServiceExecutableRunOptions service_run_options(run_options);
+
+      auto* gpu_executable = tensorflow::down_cast<gpu::GpuExecutable*>(
+          executables[executable_idx]->executable());
+      statuses[i] =
+          gpu_executable->WarmUpCollectiveCliques(&service_run_options);
+
+      absl::MutexLock lock(&mu);
+      --running;
+    });
+  }
+
+  {
+    absl::MutexLock lock(&mu);
+    auto done = [&]() {
+      mu.AssertHeld();
+      return running == 0;
+    };
+    mu.Await(absl::Condition(&done));
+  }
+  for (const absl::Status& status : statuses) {
+    TF_RETURN_IF_ERROR(status);
+  }
+  return absl::OkStatus();
+}
+
 PjRtFuture<> StreamExecutorGpuClient::CopyRawHostToDevice(
     LocalDeviceState* local_device,
     tsl::RCReference<RawSEDeviceMemory> device_buffer, const void* src,
@@ -34,6 +34,7 @@ limitations under the License.
 #include "xla/client/local_client.h"
 #include "xla/hlo/builder/xla_computation.h"
 #include "xla/layout.h"
+#include "xla/literal.h"
 #include "xla/pjrt/distributed/key_value_store_interface.h"
 #include "xla/pjrt/gpu/gpu_topology.h"
 #include "xla/pjrt/gpu/gpu_topology.pb.h"
@@ -125,6 +126,22 @@ class StreamExecutorGpuClient : public xla::PjRtStreamExecutorClient {
                                       int64_t offset,
                                       int64_t transfer_size) override;
 
+  // Copies `buffers` to the corresponding `literals`. Intended for many small
+  // outputs such as scalars and metrics: instead of one device-to-host transfer
+  // and event per buffer, dense arrays in device memory on the same device are
+  // packed into one contiguous device buffer and fetched with a single
+  // transfer, then unpacked on the host. Other buffers fall back to
+  // `PjRtBuffer::ToLiteral`.
+  PjRtFuture<> CopyToHostBatch(absl::Span<PjRtBuffer* const> buffers,
+                               absl::Span<MutableLiteralBase* const> literals);
+
+  // Creates the collective communicators that `executable` needs on all of its
+  // addressable devices, so that its first execution doesn't stall on
+  // communicator initialization. Communicators are cached per process and
+  // shared with other executables that use the same replica groups. In a
+  // multi-process job all processes must warm up the executable together.
+  absl::Status WarmUpCollectiveCliques(PjRtLoadedExecutable& executable);
+
   PjRtFuture<> CopyRawHostToDevice(
       LocalDeviceState* local_device,
       tsl::RCReference<RawSEDeviceMemory> device_buffer, const void* src,
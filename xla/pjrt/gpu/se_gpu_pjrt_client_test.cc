@@ -30,6 +30,7 @@ limitations under the License.
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include "absl/algorithm/container.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/log/check.h"
 #include "absl/log/log.h"
@@ -993,6 +994,148 @@ TEST(StreamExecutorGpuClientTest, CopyRawToHostFuture) {
   tsl::port::AlignedSizedFree(dst, tsl::Allocator::kAllocatorAlignment, size);
 }
 
+TEST(StreamExecutorGpuClientTest, CopyToHostBatch) {
+  TF_ASSERT_OK_AND_ASSIGN(auto client,
+                          GetStreamExecutorGpuClient(GpuClientOptions()));
+  std::vector<Literal> literals = {
+      LiteralUtil::CreateR0<float>(41.0f),
+      LiteralUtil::CreateR1<int32_t>({1, 2, 3}),
+      LiteralUtil::CreateR0<bool>(true),
+      LiteralUtil::CreateR2<float>({{1.0f, 2.0f}, {3.0f, 4.0f}}),
+  };
+
+  std::vector<std::unique_ptr<PjRtBuffer>> buffers;
+  std::vector<PjRtBuffer*> buffer_ptrs;
+  std::vector<Literal> results;
+  std::vector<MutableLiteralBase*> result_ptrs;
+  for (const Literal& literal : literals) {
+    TF_ASSERT_OK_AND_ASSIGN(
+        std::unique_ptr<PjRtBuffer> buffer,
+        client->BufferFromHostLiteral(literal, client->memory_spaces()[0]));
+    buffer_ptrs.push_back(buffer.get());
+    buffers.push_back(std::move(buffer));
+    results.emplace_back(buffers.back()->on_device_shape());
+  }
+  for (Literal& result : results) {
+    result_ptrs.push_back(&result);
+  }
+
+  auto* gpu_client =
+      tensorflow::down_cast<StreamExecutorGpuClient*>(client.get());
+  TF_ASSERT_OK(gpu_client->CopyToHostBatch(buffer_ptrs, result_ptrs).Await());
+
+  for (int i = 0; i < literals.size(); ++i) {
+    EXPECT_TRUE(LiteralTestUtil::Equal(literals[i], results[i]));
+  }
+}
+
+TEST(StreamExecutorGpuClientTest, WarmUpCollectiveCliquesBeforeExecution) {
+  static constexpr char const* kProgram = R"(
+HloModule warm_up, entry_computation_layout={(f32[4])->f32[4]}
+
+ENTRY main {
+  p0 = f32[4] parameter(0)
+  ROOT add = f32[4] add(p0, p0)
+})";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto client,
+                          GetStreamExecutorGpuClient(GpuClientOptions()));
+  TF_ASSERT_OK_AND_ASSIGN(auto executable,
+                          CompileExecutable(kProgram, *client));
+  auto* gpu_client =
+      tensorflow::down_cast<StreamExecutorGpuClient*>(client.get());
+  TF_ASSERT_OK(gpu_client->WarmUpCollectiveCliques(*executable));
+
+  Literal input = LiteralUtil::CreateR1<float>({1.0f, 2.0f, 3.0f, 4.0f});
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<PjRtBuffer> buffer,
+      client->BufferFromHostLiteral(input, client->memory_spaces()[0]));
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto result, executable->Execute({{buffer.get()}}, ExecuteOptions()));
+  TF_ASSERT_OK_AND_ASSIGN(std::shared_ptr<Literal> literal,
+                          result[0][0]->ToLiteralSync());
+  EXPECT_TRUE(LiteralTestUtil::Equal(
+      LiteralUtil::CreateR1<float>({2.0f, 4.0f, 6.0f, 8.0f}), *literal));
+}
+
+TEST(StreamExecutorGpuClientTest, CompiledMemoryStatsIncludeUsageOverTime) {
+  static constexpr char const* kProgram = R"(
+HloModule memory_stats, entry_computation_layout={(f32[1024])->f32[1024]}
+
+ENTRY main {
+  p0 = f32[1024] parameter(0)
+  a = f32[1024] add(p0, p0)
+  b = f32[1024] multiply(a, p0)
+  ROOT c = f32[1024] subtract(b, a)
+})";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto client,
+                          GetStreamExecutorGpuClient(GpuClientOptions()));
+  TF_ASSERT_OK_AND_ASSIGN(auto executable,
+                          CompileExecutable(kProgram, *client));
+  TF_ASSERT_OK_AND_ASSIGN(CompiledMemoryStats stats,
+                          executable->GetCompiledMemoryStats());
+
+  ASSERT_FALSE(stats.memory_usage_over_time_in_bytes.empty());
+  EXPECT_EQ(stats.peak_memory_in_bytes,
+            *absl::c_max_element(stats.memory_usage_over_time_in_bytes));
+  EXPECT_EQ(stats.memory_usage_over_time_in_bytes[stats.peak_memory_time],
+            stats.peak_memory_in_bytes);
+  // The parameter is live during the whole program.
+  EXPECT_GE(stats.peak_memory_in_bytes, 1024 * sizeof(float));
+
+  int64_t peak_live_bytes = 0;
+  for (const auto& [name, size] : stats.peak_live_bytes_by_instruction) {
+    peak_live_bytes += size;
+  }
+  EXPECT_EQ(peak_live_bytes, stats.peak_memory_in_bytes);
+
+  CompiledMemoryStats round_trip =
+      CompiledMemoryStats::FromProto(stats.ToProto());
+  EXPECT_EQ(round_trip.memory_usage_over_time_in_bytes,
+            stats.memory_usage_over_time_in_bytes);
+  EXPECT_EQ(round_trip.peak_live_bytes_by_instruction,
+            stats.peak_live_bytes_by_instruction);
+}
+
+TEST(StreamExecutorGpuClientTest, EarlyOutputEventsProduceCorrectResults) {
+  static constexpr char const* kProgram = R"(
+HloModule early_outputs, entry_computation_layout={(f32[4])->(f32[4], f32[4])}
+
+ENTRY main {
+  p0 = f32[4] parameter(0)
+  early = f32[4] add(p0, p0)
+  late = f32[4] multiply(early, p0)
+  ROOT result = (f32[4], f32[4]) tuple(early, late)
+})";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto client,
+                          GetStreamExecutorGpuClient(GpuClientOptions()));
+  xla::CompileOptions options;
+  options.executable_build_options.mutable_debug_options()
+      ->set_xla_gpu_experimental_enable_early_output_events(true);
+  TF_ASSERT_OK_AND_ASSIGN(auto executable,
+                          CompileExecutable(kProgram, *client, options));
+
+  Literal input = LiteralUtil::CreateR1<float>({1.0f, 2.0f, 3.0f, 4.0f});
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<PjRtBuffer> buffer,
+      client->BufferFromHostLiteral(input, client->memory_spaces()[0]));
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto result, executable->Execute({{buffer.get()}}, ExecuteOptions()));
+  ASSERT_EQ(result.size(), 1);
+  ASSERT_EQ(result[0].size(), 2);
+
+  TF_ASSERT_OK_AND_ASSIGN(std::shared_ptr<Literal> early,
+                          result[0][0]->ToLiteralSync());
+  TF_ASSERT_OK_AND_ASSIGN(std::shared_ptr<Literal> late,
+                          result[0][1]->ToLiteralSync());
+  EXPECT_TRUE(LiteralTestUtil::Equal(
+      LiteralUtil::CreateR1<float>({2.0f, 4.0f, 6.0f, 8.0f}), *early));
+  EXPECT_TRUE(LiteralTestUtil::Equal(
+      LiteralUtil::CreateR1<float>({2.0f, 8.0f, 18.0f, 32.0f}), *late));
+}
+
 TEST(StreamExecutorGpuClientTest, AsyncCopyToDevice) {
   TF_ASSERT_OK_AND_ASSIGN(auto client,
                           GetStreamExecutorGpuClient(GpuClientOptions()));
@@ -1262,6 +1405,34 @@ TEST(StreamExecutorGpuClientTest, ShouldStageHostToDeviceTransfersSetToTrue) {
       *literal, LiteralUtil::CreateR1<float>(std::vector<float>(1024, 1.0f))));
 }
 
+TEST(StreamExecutorGpuClientTest, StagesLargeHostToDeviceTransfersInChunks) {
+  GpuClientOptions options_staging;
+  options_staging.should_stage_host_to_device_transfers = true;
+  TF_ASSERT_OK_AND_ASSIGN(auto client_staging,
+                          GetStreamExecutorGpuClient(options_staging));
+
+  // Larger than a single staging chunk and not a multiple of its size, so the
+  // transfer goes through the staging ring and ends with a partial chunk.
+  constexpr int64_t kNumElements = (int64_t{80} << 20) / sizeof(int32_t) + 3;
+  std::vector<int32_t> data(kNumElements);
+  std::iota(data.begin(), data.end(), 0);
+  Shape shape = ShapeUtil::MakeShape(S32, {kNumElements});
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto buffer,
+      client_staging->BufferFromHostBuffer(
+          data.data(), shape.element_type(), shape.dimensions(),
+          /*byte_strides=*/std::nullopt,
+          PjRtClient::HostBufferSemantics::kImmutableUntilTransferCompletes,
+          /*on_done_with_host_buffer=*/nullptr,
+          client_staging->addressable_devices()[0]->memory_spaces()[0],
+          /*device_layout=*/nullptr));
+
+  TF_ASSERT_OK_AND_ASSIGN(auto literal, buffer->ToLiteralSync());
+  EXPECT_TRUE(
+      LiteralTestUtil::Equal(*literal, LiteralUtil::CreateR1<int32_t>(data)));
+}
+
 TEST(StreamExecutorGpuClientTest, ShouldStageHostToDeviceTransfersSetToFalse) {
   GpuClientOptions options_no_staging;
   options_no_staging.should_stage_host_to_device_transfers = false;
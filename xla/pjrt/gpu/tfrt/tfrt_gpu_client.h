@@ -404,8 +404,7 @@ class TfrtGpuClient final : public PjRtClient {
   // A cache for transpose plans. We use transposes to convert
   // (possibly strided) buffers provided to BufferFromHostBuffer into dense
   // major-to-minor layout.
-  absl::Mutex transpose_mu_;
-  TransposePlanCache transpose_cache_ ABSL_GUARDED_BY(transpose_mu_);
+  TransposePlanCache transpose_cache_;
 
   const std::string platform_name_;
   StreamExecutorGpuTopologyDescription topology_;
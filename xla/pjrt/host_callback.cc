@@ -16,6 +16,7 @@ limitations under the License.
 #include "xla/pjrt/host_callback.h"
 
 #include <cstddef>
+#include <deque>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -23,6 +24,7 @@ limitations under the License.
 #include "absl/log/check.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
 #include "xla/ffi/ffi_api.h"
 #include "xla/pjrt/pjrt_client.h"
 #include "xla/pjrt/pjrt_executable.h"
@@ -73,13 +75,73 @@ absl::Status HostCallbackContext::OnSend(int arg_num,
   // supposed to be invoked sequentially.
   ready_count_.store(args_.size());
 
+  if (host_callback_.async_work_runner) {
+    // The send completes right away, and the callback runs later on its own
+    // copy of the arguments.
+    std::vector<PjRtChunk> args(args_.size());
+    args.swap(args_);
+    bool schedule_drain = false;
+    {
+      absl::MutexLock lock(&async_mu_);
+      async_invocations_.push_back(std::move(args));
+      schedule_drain = !std::exchange(async_draining_, true);
+    }
+    // The work may run on this thread, so it's scheduled without the lock.
+    if (schedule_drain) {
+      host_callback_.async_work_runner->Schedule(
+          [this] { DrainAsyncInvocations(); });
+    }
+    return absl::OkStatus();
+  }
+
+  std::vector<PjRtChunk> results;
+  absl::Status status = Invoke(args_, results);
+
+  // Sending the results to recv callbacks if there is any. Note that after
+  // this point, this callback can be invoked again (e.g. in a loop) anytime.
+  for (int i = 0; i < result_channels_.size(); ++i) {
+    auto& result_channel = result_channels_[i];
+    result_channel->Push(std::move(results[i]));
+  }
+
+  return status;
+}
+
+HostCallbackContext::~HostCallbackContext() {
+  absl::MutexLock lock(&async_mu_);
+  async_mu_.Await(absl::Condition(
+      +[](bool* draining) { return !*draining; }, &async_draining_));
+}
+
+void HostCallbackContext::DrainAsyncInvocations() {
+  std::deque<std::vector<PjRtChunk>> invocations;
+  while (true) {
+    {
+      absl::MutexLock lock(&async_mu_);
+      if (async_invocations_.empty()) {
+        async_draining_ = false;
+        return;
+      }
+      invocations.swap(async_invocations_);
+    }
+    for (std::vector<PjRtChunk>& args : invocations) {
+      std::vector<PjRtChunk> results;
+      absl::Status status = Invoke(args, results);
+      LOG_IF(ERROR, !status.ok())
+          << "Asynchronous host callback failed: " << status;
+    }
+    invocations.clear();
+  }
+}
+
+absl::Status HostCallbackContext::Invoke(std::vector<PjRtChunk>& args,
+                                         std::vector<PjRtChunk>& results) {
   std::vector<void*> arg_ptrs;
-  arg_ptrs.reserve(args_.size());
-  for (auto& arg : args_) {
+  arg_ptrs.reserve(args.size());
+  for (auto& arg : args) {
     arg_ptrs.push_back(arg.data());
   }
 
-  std::vector<PjRtChunk> results;
   std::vector<void*> result_ptrs;
   results.reserve(result_channels_.size());
   result_ptrs.reserve(result_channels_.size());
@@ -98,17 +160,10 @@ absl::Status HostCallbackContext::OnSend(int arg_num,
 
   // Clear the arguments for this invocation. This won't race with next
   // invocation as send callbacks are supposed to be invoked sequentially.
-  for (auto& arg : args_) {
+  for (auto& arg : args) {
     arg = PjRtChunk{};
   }
 
-  // Sending the results to recv callbacks if there is any. Note that after
-  // this point, this callback can be invoked again (e.g. in a loop) anytime.
-  for (int i = 0; i < result_channels_.size(); ++i) {
-    auto& result_channel = result_channels_[i];
-    result_channel->Push(std::move(results[i]));
-  }
-
   return status;
 }
 
@@ -30,6 +30,7 @@ limitations under the License.
 #include "absl/status/statusor.h"
 #include "absl/synchronization/mutex.h"
 #include "xla/ffi/api/ffi.h"
+#include "xla/pjrt/async_work_runner.h"
 #include "xla/pjrt/pjrt_client.h"
 #include "xla/pjrt/pjrt_executable.h"
 #include "xla/pjrt/pjrt_future.h"
@@ -106,6 +107,13 @@ struct HostCallback {
   // callback can also return error status to indicate the entire execution
   // should fail.
   std::function<absl::Status(void**, void**)> callback;
+
+  // If set, the callback runs asynchronously on this work runner and the
+  // device doesn't wait for it, e.g. for logging and metrics. Only callbacks
+  // without results can be asynchronous, and their errors are logged instead
+  // of failing the execution. Invocations that queue up while the callback is
+  // running are delivered together, in order, by a single work item.
+  AsyncWorkRunner* async_work_runner = nullptr;
 };
 
 // A helper class that maintains the send/recv states for a host callback.
@@ -125,11 +133,18 @@ class HostCallbackContext {
     if (!use_major_to_minor_data_layout_for_callbacks_) {
       CHECK(host_memory_for_device_manager_);
     }
+    if (host_callback_.async_work_runner) {
+      CHECK(host_callback_.results.empty())
+          << "Asynchronous host callbacks can't have results";
+    }
     for (auto& channel : result_channels_) {
       channel = std::make_unique<ThreadSafePjRtChunkQueue>();
     }
   }
 
+  // Waits for the pending asynchronous invocations of the callback.
+  ~HostCallbackContext();
+
   absl::Status OnSend(int arg_num, const PjRtTransferMetadata& metadata,
                       PjRtChunk data);
 
@@ -139,12 +154,27 @@ class HostCallbackContext {
   const HostCallback& host_callback() const { return host_callback_; }
 
  private:
+  // Runs the callback on `args` into newly allocated `results`, and clears
+  // `args`.
+  absl::Status Invoke(std::vector<PjRtChunk>& args,
+                      std::vector<PjRtChunk>& results);
+
+  // Runs the queued asynchronous invocations until there are none left.
+  void DrainAsyncInvocations();
+
   HostCallback host_callback_;
   bool use_major_to_minor_data_layout_for_callbacks_;
   PjRtHostMemoryForDeviceManager* host_memory_for_device_manager_ = nullptr;
   std::vector<PjRtChunk> args_;
   std::vector<std::unique_ptr<ThreadSafePjRtChunkQueue>> result_channels_;
   std::atomic<int> ready_count_;
+
+  absl::Mutex async_mu_;
+  // The arguments of asynchronous invocations that haven't run yet.
+  std::deque<std::vector<PjRtChunk>> async_invocations_
+      ABSL_GUARDED_BY(async_mu_);
+  // Whether a work item that drains `async_invocations_` is scheduled.
+  bool async_draining_ ABSL_GUARDED_BY(async_mu_) = false;
 };
 
 // The execution states for host callbacks for all replicas. The states are kept
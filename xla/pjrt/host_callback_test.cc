@@ -19,14 +19,20 @@ limitations under the License.
 #include <cstring>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include <gtest/gtest.h>
+#include "absl/functional/any_invocable.h"
 #include "absl/log/check.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/synchronization/notification.h"
+#include "absl/types/span.h"
+#include "xla/pjrt/async_work_runner.h"
 #include "xla/pjrt/pjrt_client.h"
 #include "xla/tests/literal_test_util.h"
+#include "xla/tsl/concurrency/async_value.h"
+#include "xla/tsl/concurrency/ref_count.h"
 #include "xla/tsl/lib/core/status_test_util.h"
 #include "xla/xla_data.pb.h"
 
@@ -175,5 +181,61 @@ TEST(HostCallbackTest, NonBlockingRecv) {
   EXPECT_TRUE(LiteralTestUtil::Equal(literal, borrowing_literal));
 }
 
+// Runs the scheduled work only when asked to.
+class DeferredAsyncWorkRunner : public AsyncWorkRunner {
+ public:
+  void Schedule(absl::AnyInvocable<void()> work) override {
+    work_.push_back(std::move(work));
+  }
+  void ScheduleWhenReady(
+      absl::Span<const tsl::RCReference<tsl::AsyncValue>> values,
+      absl::AnyInvocable<void()> work) override {
+    work_.push_back(std::move(work));
+  }
+
+  std::vector<absl::AnyInvocable<void()>>& work() { return work_; }
+
+ private:
+  std::vector<absl::AnyInvocable<void()>> work_;
+};
+
+TEST(HostCallbackTest, AsyncBatchedDelivery) {
+  DeferredAsyncWorkRunner async_work_runner;
+  std::vector<float> received;
+
+  HostCallback host_callback;
+  Shape shape = ShapeUtil::MakeShape(F32, {});
+  host_callback.operands = {HostCallbackArgInfo{/*channel_id=*/1, shape}};
+  host_callback.callback = [&](void** outputs, void** inputs) {
+    received.push_back(*static_cast<float*>(inputs[0]));
+    return absl::InternalError("Ignored");
+  };
+  host_callback.async_work_runner = &async_work_runner;
+
+  HostCallbackStates states;
+  auto& send_callbacks = states.send_callbacks.emplace_back();
+  auto& recv_callbacks = states.recv_callbacks.emplace_back();
+
+  auto context = CreateHostCallbackStateAndAppendSendRecvCallbacks(
+      std::move(host_callback), /*host_memory_for_device_manager=*/nullptr,
+      send_callbacks, recv_callbacks,
+      /*use_major_to_minor_data_layout_for_callbacks=*/true);
+
+  PjRtTransferMetadata metadata;
+  metadata.device_shape = shape;
+  for (float value : {1.0f, 2.0f}) {
+    auto chunk = PjRtChunk::AllocateDefault(/*size=*/sizeof(float));
+    std::memcpy(chunk.data(), &value, sizeof(float));
+    // Sends don't wait for the callback, and don't see its errors.
+    TF_ASSERT_OK(context->OnSend(/*arg_num=*/0, metadata, std::move(chunk)));
+  }
+  EXPECT_TRUE(received.empty());
+
+  // Both invocations are delivered in order by a single work item.
+  ASSERT_EQ(async_work_runner.work().size(), 1);
+  std::move(async_work_runner.work()[0])();
+  EXPECT_EQ(received, std::vector<float>({1.0f, 2.0f}));
+}
+
 }  // namespace
 }  // namespace xla
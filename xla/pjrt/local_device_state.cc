@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "xla/pjrt/local_device_state.h"
 
+#include <algorithm>
 #include <functional>
 #include <limits>
 #include <memory>
@@ -49,6 +50,8 @@ LocalDeviceState::LocalDeviceState(se::StreamExecutor* executor,
       event_pool_(allow_event_reuse),
       compute_semaphore_(
           /*capacity=*/max_inflight_computations),
+      batch_compute_semaphore_(
+          /*capacity=*/std::max(1, max_inflight_computations / 2)),
       executor_(executor),
       client_(client),
       prng_seed_generator_(prng_seed_device_()),
@@ -287,6 +290,36 @@ void LocalDeviceState::ReturnStreamToPool(std::unique_ptr<se::Stream> stream) {
   usage_stream_pool_.push(std::move(stream));
 }
 
+LocalDeviceState::ComputeReservation LocalDeviceState::AcquireComputeSlot(
+    ComputePriority priority) {
+  switch (priority) {
+    case ComputePriority::kDefault:
+      return ComputeReservation{compute_semaphore_.ScopedAcquire(1)};
+    case ComputePriority::kLatencyCritical: {
+      {
+        absl::MutexLock lock(&admission_mu_);
+        ++waiting_latency_critical_;
+      }
+      ComputeReservation reservation{compute_semaphore_.ScopedAcquire(1)};
+      absl::MutexLock lock(&admission_mu_);
+      --waiting_latency_critical_;
+      return reservation;
+    }
+    case ComputePriority::kBatch: {
+      Semaphore::ScopedReservation batch =
+          batch_compute_semaphore_.ScopedAcquire(1);
+      {
+        absl::MutexLock lock(&admission_mu_);
+        admission_mu_.Await(absl::Condition(
+            +[](int* waiting) { return *waiting == 0; },
+            &waiting_latency_critical_));
+      }
+      return ComputeReservation{compute_semaphore_.ScopedAcquire(1),
+                                std::move(batch)};
+    }
+  }
+}
+
 int LocalDeviceState::GetNewPrngSeed() {
   absl::MutexLock lock(&mu_);
   int x = 0;
@@ -198,6 +198,22 @@ class LocalDeviceState {
 
   Semaphore& compute_semaphore() { return compute_semaphore_; }
 
+  // Priority classes used to admit programs onto the compute stream.
+  enum class ComputePriority { kDefault, kLatencyCritical, kBatch };
+
+  // Slots on the compute stream held by an enqueued program.
+  struct ComputeReservation {
+    Semaphore::ScopedReservation compute;
+    std::optional<Semaphore::ScopedReservation> batch;
+  };
+
+  // Reserves a slot on the compute stream for a program of the given priority,
+  // blocking until one is available. Batch programs can hold at most half of
+  // the slots, so that latency-critical programs never queue behind more than
+  // that many of them, and batch programs yield to latency-critical programs
+  // that are waiting for a slot.
+  ComputeReservation AcquireComputeSlot(ComputePriority priority);
+
   // Returns a fresh, PRNG-generated random seed for an XLA computation.
   int GetNewPrngSeed();
 
@@ -218,6 +234,14 @@ class LocalDeviceState {
   // stream by the host ahead of the device.
   Semaphore compute_semaphore_;
 
+  // Semaphore used to limit how many of the compute slots can be taken by
+  // batch programs.
+  Semaphore batch_compute_semaphore_;
+
+  absl::Mutex admission_mu_;
+  // Number of latency-critical programs waiting for a compute slot.
+  int waiting_latency_critical_ ABSL_GUARDED_BY(admission_mu_) = 0;
+
   PjRtLocalDeviceId local_device_id_;
   PjRtLocalHardwareId local_hardware_id_;
   se::StreamExecutor* const executor_;
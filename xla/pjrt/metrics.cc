@@ -15,10 +15,12 @@ limitations under the License.
 
 #include "xla/pjrt/metrics.h"
 
+#include <atomic>
 #include <cstdint>
 
 #include "xla/tsl/lib/monitoring/counter.h"
 #include "xla/tsl/lib/monitoring/gauge.h"
+#include "xla/tsl/lib/monitoring/sampler.h"
 
 namespace xla {
 namespace {
@@ -32,6 +34,37 @@ auto* pjrt_executable_execution_time_usecs = tsl::monitoring::Counter<0>::New(
     "The total time spent on PjRtExecutable::ExecuteHelper in "
     "microseconds.");
 
+// These exponential buckets cover the following range:
+// Minimum: 1 us
+// Maximum: 1 us * 2 ^ 24 == ~16.8 seconds
+auto* pjrt_sampled_execution_enqueue_time_usecs =
+    tsl::monitoring::Sampler<0>::New(
+        {metrics::kPjrtExecutionEnqueueTimeMetricName,
+         "The time spent on enqueueing sampled executions in microseconds."},
+        {tsl::monitoring::Buckets::Exponential(1, 2, 25)});
+
+auto* pjrt_sampled_execution_time_usecs = tsl::monitoring::Sampler<0>::New(
+    {metrics::kPjrtExecutionTimeMetricName,
+     "The time from the start of the enqueue of sampled executions to their "
+     "completion on the device in microseconds."},
+    {tsl::monitoring::Buckets::Exponential(1, 2, 25)});
+
+// Minimum: 1 KiB, maximum: 1 KiB * 2 ^ 29 == 512 GiB.
+auto* pjrt_sampled_execution_argument_bytes = tsl::monitoring::Sampler<0>::New(
+    {metrics::kPjrtExecutionArgumentBytesMetricName,
+     "The total on-device size of the arguments of sampled executions."},
+    {tsl::monitoring::Buckets::Exponential(1024, 2, 30)});
+
+auto* pjrt_sampled_execution_queue_depth = tsl::monitoring::Sampler<0>::New(
+    {metrics::kPjrtExecutionQueueDepthMetricName,
+     "The number of executions in flight on the device when sampled "
+     "executions are enqueued."},
+    {tsl::monitoring::Buckets::Exponential(1, 2, 12)});
+
+std::atomic<int64_t> execution_sampling_period =
+    metrics::kDefaultExecutionSamplingPeriod;
+std::atomic<uint64_t> num_executions = 0;
+
 auto* pjrt_compiler_is_compiling_computation =
     tsl::monitoring::Gauge<bool, 0>::New(
         metrics::kPjrtCompilerCompileComputationMetricName,
@@ -56,6 +89,32 @@ void ReportExecutableEnqueueTime(const uint64_t running_time_usecs) {
   }
 }
 
+void SetExecutionSamplingPeriod(int64_t period) {
+  execution_sampling_period.store(period, std::memory_order_relaxed);
+}
+
+bool ShouldSampleExecution() {
+  const int64_t period =
+      execution_sampling_period.load(std::memory_order_relaxed);
+  if (period <= 0) {
+    return false;
+  }
+  return num_executions.fetch_add(1, std::memory_order_relaxed) % period == 0;
+}
+
+void ReportSampledExecutionEnqueue(const uint64_t enqueue_time_usecs,
+                                   const int64_t argument_bytes,
+                                   const int64_t queue_depth) {
+  pjrt_sampled_execution_enqueue_time_usecs->GetCell()->Add(
+      enqueue_time_usecs);
+  pjrt_sampled_execution_argument_bytes->GetCell()->Add(argument_bytes);
+  pjrt_sampled_execution_queue_depth->GetCell()->Add(queue_depth);
+}
+
+void ReportSampledExecutionTime(const uint64_t execution_time_usecs) {
+  pjrt_sampled_execution_time_usecs->GetCell()->Add(execution_time_usecs);
+}
+
 void RecordPjrtCompilerCompileComputationStatus(bool is_compiling) {
   pjrt_compiler_is_compiling_computation->GetCell()->Set(is_compiling);
 }
@@ -16,6 +16,8 @@ limitations under the License.
 #ifndef XLA_PJRT_METRICS_H_
 #define XLA_PJRT_METRICS_H_
 
+#include <cstdint>
+
 #include "absl/base/attributes.h"
 #include "absl/strings/string_view.h"
 #include "xla/tsl/lib/monitoring/counter.h"
@@ -29,9 +31,37 @@ inline constexpr absl::string_view kPjrtCompilerCompileComputationMetricName =
     "/pjrt/compiler/is_compiling_computation";
 inline constexpr absl::string_view kPjrtCompilerCompileModuleMetricName =
     "/pjrt/compiler/is_compiling_module";
+inline constexpr absl::string_view kPjrtExecutionEnqueueTimeMetricName =
+    "/jax/pjrt/sampled_execution_enqueue_time_usecs";
+inline constexpr absl::string_view kPjrtExecutionTimeMetricName =
+    "/jax/pjrt/sampled_execution_time_usecs";
+inline constexpr absl::string_view kPjrtExecutionArgumentBytesMetricName =
+    "/jax/pjrt/sampled_execution_argument_bytes";
+inline constexpr absl::string_view kPjrtExecutionQueueDepthMetricName =
+    "/jax/pjrt/sampled_execution_queue_depth";
+
+// By default, one in this many executions is sampled.
+inline constexpr int64_t kDefaultExecutionSamplingPeriod = 100;
 
 void ReportExecutableEnqueueTime(uint64_t running_time_usecs);
 
+// Sets how often executions are sampled: one in `period` executions is, or
+// none if `period` is 0.
+void SetExecutionSamplingPeriod(int64_t period);
+
+// Returns whether the current execution should be sampled. This is cheap, so
+// that the sampled metrics below can always be on.
+bool ShouldSampleExecution();
+
+// Reports the enqueue time, argument size and number of executions already in
+// flight on the device of a sampled execution.
+void ReportSampledExecutionEnqueue(uint64_t enqueue_time_usecs,
+                                   int64_t argument_bytes, int64_t queue_depth);
+
+// Reports the time between the start of the enqueue of a sampled execution and
+// its completion on the device.
+void ReportSampledExecutionTime(uint64_t execution_time_usecs);
+
 void RecordPjrtCompilerCompileComputationStatus(bool is_compiling);
 
 void RecordPjrtCompilerCompileModuleStatus(bool is_compiling);
@@ -0,0 +1,68 @@
+/* Copyright 2021 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/pjrt/metrics.h"
+
+#include <string>
+
+#include <gtest/gtest.h>
+#include "xla/tsl/lib/monitoring/cell_reader.h"
+#include "xla/tsl/lib/monitoring/test_utils.h"
+
+namespace xla {
+namespace {
+
+using ::tsl::monitoring::testing::CellReader;
+using ::tsl::monitoring::testing::Histogram;
+
+TEST(MetricsTest, SamplesOneInPeriodExecutions) {
+  metrics::SetExecutionSamplingPeriod(3);
+  int num_sampled = 0;
+  for (int i = 0; i < 9; ++i) {
+    num_sampled += metrics::ShouldSampleExecution();
+  }
+  EXPECT_EQ(num_sampled, 3);
+
+  metrics::SetExecutionSamplingPeriod(0);
+  for (int i = 0; i < 9; ++i) {
+    EXPECT_FALSE(metrics::ShouldSampleExecution());
+  }
+  metrics::SetExecutionSamplingPeriod(
+      metrics::kDefaultExecutionSamplingPeriod);
+}
+
+TEST(MetricsTest, ReportsSampledExecutions) {
+  CellReader<Histogram> enqueue_time(
+      std::string(metrics::kPjrtExecutionEnqueueTimeMetricName));
+  CellReader<Histogram> execution_time(
+      std::string(metrics::kPjrtExecutionTimeMetricName));
+  CellReader<Histogram> argument_bytes(
+      std::string(metrics::kPjrtExecutionArgumentBytesMetricName));
+  CellReader<Histogram> queue_depth(
+      std::string(metrics::kPjrtExecutionQueueDepthMetricName));
+
+  metrics::ReportSampledExecutionEnqueue(/*enqueue_time_usecs=*/10,
+                                         /*argument_bytes=*/4096,
+                                         /*queue_depth=*/2);
+  metrics::ReportSampledExecutionTime(/*execution_time_usecs=*/100);
+
+  EXPECT_FLOAT_EQ(enqueue_time.Delta().sum(), 10.0);
+  EXPECT_FLOAT_EQ(execution_time.Delta().sum(), 100.0);
+  EXPECT_FLOAT_EQ(argument_bytes.Delta().sum(), 4096.0);
+  EXPECT_FLOAT_EQ(queue_depth.Delta().sum(), 2.0);
+}
+
+}  // namespace
+}  // namespace xla
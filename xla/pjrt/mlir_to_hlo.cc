@@ -43,9 +43,11 @@ limitations under the License.
 #include "mlir/IR/BuiltinOps.h"
 #include "mlir/IR/BuiltinTypes.h"
 #include "mlir/IR/Diagnostics.h"
+#include "mlir/IR/Dialect.h"
 #include "mlir/IR/Location.h"
 #include "mlir/IR/MLIRContext.h"
 #include "mlir/IR/OwningOpRef.h"
+#include "mlir/IR/Verifier.h"
 #include "mlir/IR/Visitors.h"
 #include "mlir/Parser/Parser.h"
 #include "mlir/Pass/PassManager.h"
@@ -72,17 +74,42 @@ limitations under the License.
 #include "xla/service/spmd/shardy/utils.h"
 #include "xla/util.h"
 #include "tsl/platform/statusor.h"
+#include "tsl/profiler/lib/traceme.h"
 
 namespace xla {
 
+namespace {
+
+// Returns true if `module` is a portable artifact, i.e. contains VHLO ops
+// that need to be upgraded to StableHLO. Portable artifacts only have VHLO
+// functions at the top level, so we don't need to walk the whole module.
+bool IsVersionedStablehlo(mlir::ModuleOp module) {
+  for (mlir::Operation& op : module.getBody()->getOperations()) {
+    mlir::Dialect* dialect = op.getDialect();
+    if (dialect != nullptr && dialect->getNamespace() == "vhlo") {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
 absl::Status MlirToXlaComputation(mlir::ModuleOp module,
                                   XlaComputation& xla_computation,
                                   bool use_tuple_args, bool return_tuple,
                                   bool use_shardy) {
+  tsl::profiler::TraceMe trace("MlirToXlaComputation");
   mlir::MLIRContext* context = module->getContext();
   mlir::BaseScopedDiagnosticHandler diagnostic_handler(context);
   {
+    tsl::profiler::TraceMe trace_passes("MlirToXlaComputation:LoweringPasses");
     mlir::PassManager pm(context);
+    // The module is verified once after all the passes below instead of after
+    // each of them, which takes a significant part of the conversion time of
+    // large programs. Nested passes run on the functions in parallel if the
+    // context is multithreaded.
+    pm.enableVerifier(false);
 
     // CHLO -> MHLO for high level ops (TopK, Erf, RaggedDot, etc.)
     // CHLO -> StableHLO otherwise
@@ -103,7 +130,7 @@ absl::Status MlirToXlaComputation(mlir::ModuleOp module,
     pm.addNestedPass<mlir::func::FuncOp>(
         mlir::stablehlo_ext::createSinkConstantsToControlFlowPass());
 
-    if (failed(pm.run(module))) {
+    if (failed(pm.run(module)) || failed(mlir::verify(module))) {
       VLOG(1) << "MHLO->HLO lowering passes failed.";
       module->dump();
       return diagnostic_handler.ConsumeStatus();
@@ -125,16 +152,21 @@ absl::Status MlirToXlaComputation(mlir::ModuleOp module,
     use_tuple_args = false;
   }
 
-  TF_ASSIGN_OR_RETURN(std::unique_ptr<HloModule> hlo_module,
-                      xla::ConvertStablehloToHloWithOptions(
-                          module, use_tuple_args, return_tuple));
+  std::unique_ptr<HloModule> hlo_module;
+  {
+    tsl::profiler::TraceMe trace_convert("MlirToXlaComputation:ConvertToHlo");
+    TF_ASSIGN_OR_RETURN(hlo_module, xla::ConvertStablehloToHloWithOptions(
+                                        module, use_tuple_args, return_tuple));
+  }
 
+  tsl::profiler::TraceMe trace_to_proto("MlirToXlaComputation:ToProto");
   xla_computation = XlaComputation(hlo_module->ToProto());
   return absl::OkStatus();
 }
 
 absl::StatusOr<mlir::OwningOpRef<mlir::ModuleOp>> ParseMlirModuleString(
     absl::string_view mlir_module_str, mlir::MLIRContext& context) {
+  tsl::profiler::TraceMe trace("ParseMlirModuleString");
   mlir::DialectRegistry registry;
   registry.insert<mlir::arith::ArithDialect>();
   registry.insert<mlir::func::FuncDialect>();
@@ -277,7 +309,13 @@ absl::StatusOr<std::string> SerializeUsingVersionedStablehlo(
 }
 
 absl::Status UpgradeVersionedStablehlo(mlir::ModuleOp mlir_module) {
-  // Upgrade if VHLO
+  // Upgrade if VHLO. Running the deserialization pipeline on a module that is
+  // already StableHLO, e.g. native bytecode, would walk the whole module for
+  // nothing.
+  if (!IsVersionedStablehlo(mlir_module)) {
+    return absl::OkStatus();
+  }
+  tsl::profiler::TraceMe trace("UpgradeVersionedStablehlo");
   mlir::PassManager pm(mlir_module->getContext());
   mlir::stablehlo::createStablehloDeserializePipeline(pm);
   if (!mlir::succeeded(pm.run(mlir_module)))
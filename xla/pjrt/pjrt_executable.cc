@@ -15,15 +15,18 @@ limitations under the License.
 
 #include "xla/pjrt/pjrt_executable.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <limits>
 #include <memory>
 #include <optional>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <variant>
 #include <vector>
 
+#include "absl/algorithm/container.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
@@ -34,6 +37,7 @@ limitations under the License.
 #include "absl/strings/string_view.h"
 #include "absl/types/span.h"
 #include "xla/client/executable_build_options.h"
+#include "xla/hlo/utils/hlo_live_range.h"
 #include "xla/layout.h"
 #include "xla/pjrt/compile_options.pb.h"
 #include "xla/pjrt/execute_options.pb.h"
@@ -171,6 +175,18 @@ absl::StatusOr<ExecuteOptionsProto> ExecuteOptions::ToProto() const {
   proto.mutable_non_donatable_input_indices()->Add(
       non_donatable_input_indices.begin(), non_donatable_input_indices.end());
 
+  switch (priority) {
+    case ExecutionPriority::kDefault:
+      proto.set_priority(EXECUTION_PRIORITY_DEFAULT);
+      break;
+    case ExecutionPriority::kLatencyCritical:
+      proto.set_priority(EXECUTION_PRIORITY_LATENCY_CRITICAL);
+      break;
+    case ExecutionPriority::kBatch:
+      proto.set_priority(EXECUTION_PRIORITY_BATCH);
+      break;
+  }
+
   if (execution_profile != nullptr) {
     return absl::UnimplementedError(
         "ExecuteOptions with non-nullptr execution_profile is not "
@@ -210,6 +226,21 @@ absl::StatusOr<ExecuteOptions> ExecuteOptions::FromProto(
       proto.non_donatable_input_indices().begin(),
       proto.non_donatable_input_indices().end());
 
+  switch (proto.priority()) {
+    case EXECUTION_PRIORITY_DEFAULT:
+      options.priority = ExecutionPriority::kDefault;
+      break;
+    case EXECUTION_PRIORITY_LATENCY_CRITICAL:
+      options.priority = ExecutionPriority::kLatencyCritical;
+      break;
+    case EXECUTION_PRIORITY_BATCH:
+      options.priority = ExecutionPriority::kBatch;
+      break;
+    default:
+      return absl::UnimplementedError(
+          absl::StrCat("Unknown execution priority: ", proto.priority()));
+  }
+
   return options;
 }
 
@@ -227,6 +258,17 @@ CompiledMemoryStatsProto CompiledMemoryStats::ToProto() const {
   proto.set_host_output_size_in_bytes(host_output_size_in_bytes);
   proto.set_host_alias_size_in_bytes(host_alias_size_in_bytes);
   proto.set_host_temp_size_in_bytes(host_temp_size_in_bytes);
+  proto.mutable_memory_usage_over_time_in_bytes()->Add(
+      memory_usage_over_time_in_bytes.begin(),
+      memory_usage_over_time_in_bytes.end());
+  proto.set_peak_memory_in_bytes(peak_memory_in_bytes);
+  proto.set_peak_memory_time(peak_memory_time);
+  for (const auto& [name, size] : peak_live_bytes_by_instruction) {
+    CompiledMemoryStatsProto::LiveBytes* live_bytes =
+        proto.add_peak_live_bytes_by_instruction();
+    live_bytes->set_instruction_name(name);
+    live_bytes->set_size_in_bytes(size);
+  }
   return proto;
 }
 
@@ -245,6 +287,15 @@ CompiledMemoryStats CompiledMemoryStats::FromProto(
   stats.host_output_size_in_bytes = proto.host_output_size_in_bytes();
   stats.host_alias_size_in_bytes = proto.host_alias_size_in_bytes();
   stats.host_temp_size_in_bytes = proto.host_temp_size_in_bytes();
+  stats.memory_usage_over_time_in_bytes.assign(
+      proto.memory_usage_over_time_in_bytes().begin(),
+      proto.memory_usage_over_time_in_bytes().end());
+  stats.peak_memory_in_bytes = proto.peak_memory_in_bytes();
+  stats.peak_memory_time = proto.peak_memory_time();
+  for (const auto& live_bytes : proto.peak_live_bytes_by_instruction()) {
+    stats.peak_live_bytes_by_instruction.emplace_back(
+        live_bytes.instruction_name(), live_bytes.size_in_bytes());
+  }
   return stats;
 }
 
@@ -792,4 +843,88 @@ absl::Status CompileOptions::ApplyOptionFromString(
   return absl::OkStatus();
 }
 
+// Computes the memory usage curve from the live ranges of the values in the
+// buffer assignment. Values that share an allocation slice with overlapping
+// live ranges alias each other (e.g. in-place updates) and are counted once,
+// while values reusing a slice at different times are counted separately.
+void CompiledMemoryStats::PopulateMemoryUsageFromBufferAssignment(
+    const BufferAssignment& assignment) {
+  struct Interval {
+    int64_t start;
+    int64_t end;
+    const HloValue* value;
+  };
+  const HloLiveRange& live_range = assignment.hlo_live_range();
+  absl::flat_hash_map<std::tuple<int64_t, int64_t, int64_t>,
+                      std::vector<Interval>>
+      slices;
+  for (const BufferAllocation& alloc : assignment.Allocations()) {
+    for (const auto& [value, offset_size] : alloc.assigned_buffers()) {
+      const Shape& shape = value->defining_position().shape();
+      if (shape.has_layout() &&
+          shape.layout().memory_space() == Layout::kHostMemorySpace) {
+        continue;
+      }
+      auto it = live_range.buffer_live_ranges().find(value);
+      if (it == live_range.buffer_live_ranges().end()) {
+        continue;
+      }
+      slices[{alloc.index(), offset_size.offset, offset_size.size}].push_back(
+          {it->second.start, it->second.end, value});
+    }
+  }
+
+  // Merge the aliasing intervals of each slice.
+  std::vector<std::pair<Interval, int64_t>> live_slices;
+  for (auto& [slice, intervals] : slices) {
+    absl::c_sort(intervals, [](const Interval& a, const Interval& b) {
+      return a.start < b.start;
+    });
+    Interval merged = intervals.front();
+    for (const Interval& interval : absl::MakeSpan(intervals).subspan(1)) {
+      if (interval.start <= merged.end) {
+        merged.end = std::max(merged.end, interval.end);
+      } else {
+        live_slices.push_back({merged, std::get<2>(slice)});
+        merged = interval;
+      }
+    }
+    live_slices.push_back({merged, std::get<2>(slice)});
+  }
+
+  int64_t num_times = live_range.schedule_end_time() + 1;
+  std::vector<int64_t> delta(num_times + 1, 0);
+  for (const auto& [interval, size] : live_slices) {
+    delta[std::clamp<int64_t>(interval.start, 0, num_times)] += size;
+    delta[std::clamp<int64_t>(interval.end + 1, 0, num_times)] -= size;
+  }
+  memory_usage_over_time_in_bytes.assign(num_times, 0);
+  peak_memory_in_bytes = 0;
+  peak_memory_time = 0;
+  int64_t live_bytes = 0;
+  for (int64_t time = 0; time < num_times; ++time) {
+    live_bytes += delta[time];
+    memory_usage_over_time_in_bytes[time] = live_bytes;
+    if (live_bytes > peak_memory_in_bytes) {
+      peak_memory_in_bytes = live_bytes;
+      peak_memory_time = time;
+    }
+  }
+
+  absl::flat_hash_map<std::string, int64_t> live_bytes_by_instruction;
+  for (const auto& [interval, size] : live_slices) {
+    if (interval.start <= peak_memory_time &&
+        peak_memory_time <= interval.end) {
+      live_bytes_by_instruction[interval.value->instruction()->name()] += size;
+    }
+  }
+  peak_live_bytes_by_instruction.assign(live_bytes_by_instruction.begin(),
+                                        live_bytes_by_instruction.end());
+  absl::c_sort(peak_live_bytes_by_instruction,
+               [](const auto& a, const auto& b) {
+                 return std::tie(b.second, a.first) <
+                        std::tie(a.second, b.first);
+               });
+}
+
 }  // namespace xla
@@ -257,6 +257,12 @@ struct ExecuteOptions {
   enum class ExecutionMode { kDefault = 0, kSynchronous, kAsynchronous };
   ExecutionMode execution_mode = ExecutionMode::kDefault;
 
+  // The `priority` class of the execution. Implementations that share a
+  // device between several programs may use it to admit latency-critical
+  // executions ahead of batch ones.
+  enum class ExecutionPriority { kDefault = 0, kLatencyCritical, kBatch };
+  ExecutionPriority priority = ExecutionPriority::kDefault;
+
   // If not null, measure the execution profile and store it.
   ExecutionProfile* execution_profile = nullptr;
 
@@ -296,6 +302,21 @@ struct CompiledMemoryStats {
   int64_t host_temp_size_in_bytes = 0;
 
   std::string serialized_hlo_proto = "";
+
+  // Device memory usage over the course of the program, derived from the live
+  // ranges of the buffers in the buffer assignment. Empty if the executable
+  // doesn't retain its buffer assignment.
+  //
+  // Bytes of device memory live at each point of the flattened HLO schedule.
+  std::vector<int64_t> memory_usage_over_time_in_bytes;
+  // The largest value in `memory_usage_over_time_in_bytes`, and the first
+  // point of the schedule where it is reached.
+  int64_t peak_memory_in_bytes = 0;
+  int64_t peak_memory_time = 0;
+  // Bytes live at `peak_memory_time` by the HLO instruction defining them,
+  // sorted by decreasing size.
+  std::vector<std::pair<std::string, int64_t>> peak_live_bytes_by_instruction;
+
   std::string DebugString() const;
 
   CompiledMemoryStatsProto ToProto() const;
@@ -304,6 +325,9 @@ struct CompiledMemoryStats {
 
   void PopulateBufferStatsFromAllocations(
       absl::Span<const BufferAllocation> allocs);
+
+  void PopulateMemoryUsageFromBufferAssignment(
+      const BufferAssignment& assignment);
 };
 
 class PjRtExecutable {
@@ -72,6 +72,7 @@ TEST(ExecuteOptionsTest, Serialization) {
   src.strict_shape_checking = true;
   src.execution_mode = ExecuteOptions::ExecutionMode::kAsynchronous;
   src.non_donatable_input_indices = {2, 3};
+  src.priority = ExecuteOptions::ExecutionPriority::kLatencyCritical;
 
   TF_ASSERT_OK_AND_ASSIGN(ExecuteOptionsProto proto, src.ToProto());
   TF_ASSERT_OK_AND_ASSIGN(ExecuteOptions output,
@@ -79,6 +80,8 @@ TEST(ExecuteOptionsTest, Serialization) {
   TF_ASSERT_OK_AND_ASSIGN(ExecuteOptionsProto output_proto, src.ToProto());
 
   EXPECT_EQ(proto.SerializeAsString(), output_proto.SerializeAsString());
+  EXPECT_EQ(output.priority,
+            ExecuteOptions::ExecutionPriority::kLatencyCritical);
 }
 
 TEST(ExecuteOptionsTest, SendRecvNotSupported) {
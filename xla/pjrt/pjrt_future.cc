@@ -25,9 +25,24 @@ limitations under the License.
 #include "absl/status/status.h"
 #include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
+#include "xla/tsl/concurrency/async_value_ref.h"
 
 namespace xla {
 
+namespace internal {
+
+tsl::AsyncValueRef<absl::Status> ReadyOkStatus() {
+  static tsl::AsyncValueOwningRef<absl::Status>* ready = [] {
+    auto* storage = new tsl::internal::AsyncValueStorage<absl::Status>();
+    return new tsl::AsyncValueOwningRef<absl::Status>(
+        tsl::MakeAvailableAsyncValueRef<absl::Status>(*storage,
+                                                      absl::OkStatus()));
+  }();
+  return ready->AsRef();
+}
+
+}  // namespace internal
+
 namespace {
 struct State {
   explicit State(int32_t size)
@@ -98,6 +98,11 @@ struct PjRtFutureHelpers {
 
 namespace internal {
 
+// Returns an available async value holding an OK status. It is shared by all
+// the ready stateless futures, so that returning an OK future, which happens
+// for most executions and transfers, doesn't allocate.
+tsl::AsyncValueRef<absl::Status> ReadyOkStatus();
+
 // Detects absl::StatusOr<T> specializations to disable them for PjRtFuture<T>.
 template <typename T>
 struct IsStatusOr : public std::false_type {};
@@ -488,6 +493,17 @@ class PjRtFuture<void> : public internal::PjRtFutureBase<absl::Status> {
   // Bring PjRtFutureBase constructors in scope.
   using Base::Base;
 
+  // Constructor for an already-available PjRtFuture. Futures with an OK status
+  // share a single async value.
+  explicit PjRtFuture(
+      absl::Status status,
+      PjRtFutureHelpers::OnBlockStartFn on_block_start = nullptr,
+      PjRtFutureHelpers::OnBlockEndFn on_block_end = nullptr)
+      : Base(status.ok() ? internal::ReadyOkStatus()
+                         : tsl::MakeAvailableAsyncValueRef<absl::Status>(
+                               std::move(status)),
+             std::move(on_block_start), std::move(on_block_end)) {}
+
   // Constructor for unavailable future that will be fulfilled later via the
   // promise object.
   //
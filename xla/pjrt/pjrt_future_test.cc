@@ -141,6 +141,17 @@ TEST(PjRtFutureTest, StatelessImmediate) {
   });
 }
 
+TEST(PjRtFutureTest, StatelessImmediateOkIsReusable) {
+  for (int i = 0; i < 3; ++i) {
+    PjRtFuture<> future(absl::OkStatus());
+    PjRtFuture<> copy = future;
+    EXPECT_TRUE(future.IsReady());
+    EXPECT_EQ(std::move(future).Await(), absl::OkStatus());
+    std::move(copy).OnReady(
+        [](absl::Status status) { EXPECT_EQ(status, absl::OkStatus()); });
+  }
+}
+
 TEST(PjRtFutureTest, StatefulFuture) {
   auto promise = PjRtFuture<int32_t>::CreatePromise();
   PjRtFuture<int32_t> future(promise);
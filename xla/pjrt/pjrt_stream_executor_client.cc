@@ -65,6 +65,7 @@ limitations under the License.
 #include "xla/pjrt/pjrt_stream_executor_client.h"
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
@@ -80,6 +81,7 @@ limitations under the License.
 #include <vector>
 
 #include "absl/algorithm/container.h"
+#include "absl/base/call_once.h"
 #include "absl/base/casts.h"
 #include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_map.h"
@@ -94,6 +96,7 @@ limitations under the License.
 #include "absl/strings/str_format.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/synchronization/notification.h"
 #include "absl/time/time.h"
 #include "absl/types/span.h"
 #include "mlir/IR/BuiltinOps.h"
@@ -253,7 +256,7 @@ PjRtStreamExecutorClient::PjRtStreamExecutorClient(
       thread_pool_(
           tsl::Env::Default(), "pjrt_thread_pool",
           std::max<int>(DefaultThreadPoolSize(), client->device_count())),
-      transpose_cache_(1024) {
+      transpose_cache_(1024, /*num_shards=*/16) {
   if (owned_allocator_ != nullptr) {
     allocator_ = owned_allocator_.get();
   } else {
@@ -706,6 +709,77 @@ PjRtStreamExecutorBuffer::DonateWithControlDependency(PjRtFuture<> dependency) {
   return new_buffer;
 }
 
+namespace {
+
+// Size of each pinned staging buffer used for chunked host-to-device
+// transfers.
+constexpr int64_t kStagingChunkSize = int64_t{64} << 20;
+
+// Copies `size` bytes from pageable host memory at `src` to `dst` on `stream`
+// through a ring of two pinned staging buffers. Copying the next chunk into
+// pinned memory on the host overlaps with the DMA of the previous chunk to the
+// device, which avoids both allocating a pinned buffer for the whole transfer
+// and the slow DMA path for pageable memory.
+absl::Status TransferToDeviceThroughStagingRing(
+    se::Stream* stream, tsl::Allocator* host_memory_allocator, const void* src,
+    int64_t size, se::DeviceMemoryBase& dst) {
+  int64_t chunk_size = std::min(size, kStagingChunkSize);
+
+  struct StagingSlot {
+    std::shared_ptr<void> buffer;
+    // Notified when the DMA from `buffer` has completed.
+    std::shared_ptr<absl::Notification> done;
+  };
+  std::array<StagingSlot, 2> slots;
+  for (StagingSlot& slot : slots) {
+    void* ptr = host_memory_allocator->AllocateRaw(
+        tsl::Allocator::kAllocatorAlignment, chunk_size);
+    if (ptr == nullptr) {
+      return ResourceExhausted(
+          "Failed to allocate %d bytes of pinned host memory for staging "
+          "host-to-device transfer.",
+          chunk_size);
+    }
+    slot.buffer = std::shared_ptr<void>(
+        ptr, [host_memory_allocator](void* ptr) {
+          host_memory_allocator->DeallocateRaw(ptr);
+        });
+  }
+
+  auto transfer_chunks = [&]() -> absl::Status {
+    for (int64_t offset = 0, i = 0; offset < size; offset += chunk_size, ++i) {
+      StagingSlot& slot = slots[i % slots.size()];
+      if (slot.done) {
+        slot.done->WaitForNotification();
+      }
+      int64_t transfer_size = std::min(chunk_size, size - offset);
+      std::memcpy(slot.buffer.get(), static_cast<const char*>(src) + offset,
+                  transfer_size);
+      se::DeviceMemoryBase dst_chunk = dst.GetByteSlice(offset, transfer_size);
+      TF_RETURN_IF_ERROR(
+          stream->Memcpy(&dst_chunk, slot.buffer.get(), transfer_size));
+      slot.done = std::make_shared<absl::Notification>();
+      TF_RETURN_IF_ERROR(stream->DoHostCallback(
+          [done = slot.done]() { done->Notify(); }));
+    }
+    return absl::OkStatus();
+  };
+
+  if (absl::Status status = transfer_chunks(); !status.ok()) {
+    // Make sure no DMA still reads from the staging buffers before they are
+    // released.
+    stream->BlockHostUntilDone().IgnoreError();
+    return status;
+  }
+
+  // Keep the staging buffers alive until the last DMAs have completed.
+  return stream->DoHostCallback(
+      [buffers = std::array<std::shared_ptr<void>, 2>{
+           slots[0].buffer, slots[1].buffer}]() {});
+}
+
+}  // namespace
+
 // BufferFromHostBuffer() is used to create a buffer either for a device, or
 // for a host memory, depending on `memory_space`. The memory copy is needed
 // for both cases, either from the unpinned host memory to device, or from
@@ -770,7 +844,6 @@ PjRtStreamExecutorClient::BufferFromHostBufferInternal(
     options.dims = dims;
     options.permutation = permutation;
     options.input_layout = TransposePlan::Striding{*byte_strides};
-    absl::MutexLock lock(&transpose_mu_);
     TF_ASSIGN_OR_RETURN(transpose, transpose_cache_.GetOrCreate(options));
   }
 
@@ -790,12 +863,16 @@ PjRtStreamExecutorClient::BufferFromHostBufferInternal(
   bool must_use_staging_buffer =
       host_buffer_semantics == HostBufferSemantics::kImmutableOnlyDuringCall ||
       !host_and_device_strides_equal || packed_size != size;
-  // Allocating multigigabyte pinned buffers can be very slow. In that case,
-  // using a staging buffer is probably worse than not using one.
-  // TODO(phawkins): add chunking for transfers.
-  if (must_use_staging_buffer || (!IsDmaMapped(data, packed_size) &&
-                                  (should_stage_host_to_device_transfers() &&
-                                   packed_size < (int64_t{1} << 30)))) {
+  // Allocating multigigabyte pinned buffers can be very slow, so large
+  // transfers that don't need a full copy of the data are staged through a
+  // ring of smaller pinned buffers instead.
+  bool use_staging_ring = !must_use_staging_buffer &&
+                          !IsDmaMapped(data, packed_size) &&
+                          should_stage_host_to_device_transfers() &&
+                          packed_size > kStagingChunkSize;
+  if (must_use_staging_buffer ||
+      (!use_staging_ring && !IsDmaMapped(data, packed_size) &&
+       should_stage_host_to_device_transfers())) {
     void* ptr = host_memory_allocator()->AllocateRaw(
         tsl::Allocator::kAllocatorAlignment, transpose ? size : packed_size);
     staging_buffer = std::shared_ptr<void>(
@@ -848,7 +925,9 @@ PjRtStreamExecutorClient::BufferFromHostBufferInternal(
       [local_client = client(), transfer_manager, local_device, data, size,
        type, packed_size, event,
        device_memory_owned = device_buffer->device_memory(), device_shape,
-       should_pack, py_buffer{py_buffer.get()},
+       should_pack, use_staging_ring,
+       host_memory_allocator = host_memory_allocator(),
+       py_buffer{py_buffer.get()},
        on_device_shape{py_buffer->on_device_shape()},
        staging_buffer{std::move(staging_buffer)},
        on_done_with_host_buffer =
@@ -897,6 +976,10 @@ PjRtStreamExecutorClient::BufferFromHostBufferInternal(
           }
           TF_CHECK_OK(local_device->host_to_device_stream()->Memcpy(
               &device_memory, staging_buffer.get(), packed_size));
+        } else if (use_staging_ring) {
+          TF_CHECK_OK(TransferToDeviceThroughStagingRing(
+              local_device->host_to_device_stream(), host_memory_allocator,
+              data, packed_size, device_memory));
         } else {
           TF_CHECK_OK(local_device->host_to_device_stream()->Memcpy(
               &device_memory, data, packed_size));
@@ -1986,11 +2069,24 @@ MakeTupleHelper(
   return std::make_pair(std::move(execution_input), std::move(transfer_event));
 }
 
+LocalDeviceState::ComputePriority ToComputePriority(
+    ExecuteOptions::ExecutionPriority priority) {
+  switch (priority) {
+    case ExecuteOptions::ExecutionPriority::kDefault:
+      return LocalDeviceState::ComputePriority::kDefault;
+    case ExecuteOptions::ExecutionPriority::kLatencyCritical:
+      return LocalDeviceState::ComputePriority::kLatencyCritical;
+    case ExecuteOptions::ExecutionPriority::kBatch:
+      return LocalDeviceState::ComputePriority::kBatch;
+  }
+}
+
 // Converts a ScopedShapedBuffer returned from an execution into a
 // PjRtBuffer.
 absl::StatusOr<std::unique_ptr<PjRtBuffer>> OutputBufferHelper(
     ShapeTree<tsl::RCReference<RawSEDeviceMemory>> result_buffer,
-    std::shared_ptr<BufferSequencingEvent> definition_event, PjRtClient* client,
+    std::shared_ptr<BufferSequencingEvent> definition_event,
+    std::shared_ptr<BufferSequencingEvent> usage_event, PjRtClient* client,
     PjRtDevice* device, LocalDeviceState* local_device,
     std::vector<tsl::RCReference<RawSEDeviceMemory>>& buffers_to_release) {
   if (result_buffer.shape().IsTuple()) {
@@ -2030,7 +2126,7 @@ absl::StatusOr<std::unique_ptr<PjRtBuffer>> OutputBufferHelper(
       result_buffer.shape(), std::move(out_buffer), client, device,
       memory_space);
   RecordUsage(pjrt_buffer->GetBufferWithUsageHold(), local_device, local_device,
-              definition_event, local_device->compute_stream(),
+              usage_event, local_device->compute_stream(),
               &buffers_to_release);
   return std::unique_ptr<PjRtBuffer>(std::move(pjrt_buffer));
 }
@@ -2508,7 +2604,8 @@ PjRtStreamExecutorLoadedExecutable::EnqueueExecution(
     PjRtDevice* device,
     std::vector<PjRtStreamExecutorBuffer::ScopedHold>* device_buffers,
     std::shared_ptr<DeviceAssignment> device_assignment,
-    std::vector<absl::AnyInvocable<void() &&>>& compute_callbacks) const {
+    std::vector<absl::AnyInvocable<void() &&>>& compute_callbacks,
+    OutputReadyFunction* output_ready_function) const {
   int device_ordinal = tensorflow::down_cast<PjRtStreamExecutorDevice*>(device)
                            ->local_device_state()
                            ->local_device_id()
@@ -2625,6 +2722,7 @@ PjRtStreamExecutorLoadedExecutable::EnqueueExecution(
   run_options.set_launch_id(options.launch_id);
   run_options.set_send_device_memory_function(&send_device_memory);
   run_options.set_recv_device_memory_function(&recv_device_memory);
+  run_options.set_output_ready_function(output_ready_function);
   run_options.set_execution_profile(options.execution_profile);
   if (run_options.launch_id() != 0) {
     VLOG(3) << "launch id for " << name() << ": " << run_options.launch_id();
@@ -2637,11 +2735,13 @@ PjRtStreamExecutorLoadedExecutable::EnqueueExecution(
   // too far, not for correctness. Placing it before the executable launch
   // allows the inputs for the next executable to be fetched even if the
   // launch is delayed.
-  std::shared_ptr<Semaphore::ScopedReservation> compute_reservation;
+  std::shared_ptr<LocalDeviceState::ComputeReservation> compute_reservation;
   {
     tsl::profiler::TraceMe traceme("ComputeSemaphoreAcquire");
-    compute_reservation = std::make_shared<Semaphore::ScopedReservation>(
-        device_state->compute_semaphore().ScopedAcquire(1));
+    compute_reservation =
+        std::make_shared<LocalDeviceState::ComputeReservation>(
+            device_state->AcquireComputeSlot(
+                ToComputePriority(options.priority)));
   }
 
   auto start_time_ns = std::make_shared<uint64_t>();
@@ -2718,11 +2818,20 @@ absl::StatusOr<std::vector<std::unique_ptr<PjRtBuffer>>>
 PjRtStreamExecutorLoadedExecutable::MakeOutputBuffers(
     int device_ordinal, const ExecuteOptions& options,
     ShapeTree<tsl::RCReference<RawSEDeviceMemory>> result_buffer,
-    std::shared_ptr<BufferSequencingEvent> definition_event, PjRtDevice* device,
+    std::shared_ptr<BufferSequencingEvent> definition_event,
+    const absl::flat_hash_map<int64_t, std::shared_ptr<BufferSequencingEvent>>&
+        output_definition_events,
+    PjRtDevice* device,
     std::vector<absl::AnyInvocable<void() &&>>& compute_callbacks,
     std::vector<tsl::RCReference<RawSEDeviceMemory>>& buffers_to_release)
     const {
   tsl::profiler::TraceMe traceme("MakeOutputBuffers");
+  // Outputs that the executable signalled early are defined by their own event,
+  // but are still in use by the executable until it completes.
+  auto output_definition_event = [&](int64_t output_index) {
+    auto it = output_definition_events.find(output_index);
+    return it != output_definition_events.end() ? it->second : definition_event;
+  };
   std::vector<std::unique_ptr<PjRtBuffer>> outputs;
   LocalDeviceState* device_state = &(client_->device_state(device_ordinal));
   if (result_buffer.shape().IsTuple()) {
@@ -2736,8 +2845,10 @@ PjRtStreamExecutorLoadedExecutable::MakeOutputBuffers(
           result_buffer.SubShapeTree({i}));
       TF_ASSIGN_OR_RETURN(
           std::unique_ptr<PjRtBuffer> buffer,
-          OutputBufferHelper(std::move(tuple_buffer), definition_event, client_,
-                             device, device_state, buffers_to_release));
+          OutputBufferHelper(std::move(tuple_buffer),
+                             output_definition_event(i), definition_event,
+                             client_, device, device_state,
+                             buffers_to_release));
       outputs.push_back(std::move(buffer));
     }
     if (device_state->allocation_model() == LocalDeviceState::kSynchronous) {
@@ -2748,8 +2859,9 @@ PjRtStreamExecutorLoadedExecutable::MakeOutputBuffers(
   } else {
     TF_ASSIGN_OR_RETURN(
         std::unique_ptr<PjRtBuffer> buffer,
-        OutputBufferHelper(std::move(result_buffer), definition_event, client_,
-                           device, device_state, buffers_to_release));
+        OutputBufferHelper(std::move(result_buffer),
+                           output_definition_event(0), definition_event,
+                           client_, device, device_state, buffers_to_release));
     outputs.push_back(std::move(buffer));
   }
   return outputs;
@@ -2825,14 +2937,52 @@ PjRtStreamExecutorLoadedExecutable::ExecuteHelper(
   // SPMD sharding produces a single executable for multiple partitions.
   int executable_idx = executables_.size() > 1 ? partition : 0;
 
+  LocalDeviceState* device_state = &(client_->device_state(device_ordinal));
+
+  // Outputs that the executable reports as ready before it completes get
+  // their own definition event, so that consumers such as device-to-host
+  // copies can start while the rest of the program is still running.
+  absl::flat_hash_map<int64_t, std::shared_ptr<BufferSequencingEvent>>
+      output_definition_events;
+  OutputReadyFunction output_ready_function = [&](int64_t output_index,
+                                                  se::Stream* stream) {
+    absl::StatusOr<EventPool::Handle> event_or =
+        device_state->event_pool().ThenAllocateAndRecordEvent(stream);
+    if (!event_or.ok()) {
+      VLOG(1) << "Failed to record early definition event for output "
+              << output_index << ": " << event_or.status();
+      return;
+    }
+    auto definition_event =
+        std::make_shared<BufferSequencingEvent>(client_->thread_pool());
+    definition_event->SetSequencingEvent(std::move(event_or).value(), stream);
+    output_definition_events[output_index] = std::move(definition_event);
+  };
+
+  // Sampled executions also report the size of their arguments, the number of
+  // executions already in flight on the device and their completion time.
+  const bool sampled = metrics::ShouldSampleExecution();
+  int64_t argument_bytes = 0;
+  int64_t queue_depth = 0;
+  if (sampled) {
+    for (PjRtBuffer* handle : argument_handles) {
+      absl::StatusOr<size_t> size = handle->GetOnDeviceSizeInBytes();
+      if (size.ok()) {
+        argument_bytes += *size;
+      }
+    }
+    Semaphore& compute_semaphore = device_state->compute_semaphore();
+    queue_depth = compute_semaphore.capacity() - compute_semaphore.available();
+  }
+
   std::vector<absl::AnyInvocable<void() &&>> compute_callbacks;
   std::vector<PjRtStreamExecutorBuffer::ScopedHold> device_buffers;
   device_buffers.reserve(argument_handles.size());
   absl::StatusOr<ShapeTree<tsl::RCReference<RawSEDeviceMemory>>>
-      result_buffer_or_status =
-          EnqueueExecution(argument_handles, replica, partition, executable_idx,
-                           run_id, options, device, &device_buffers,
-                           std::move(device_assignment), compute_callbacks);
+      result_buffer_or_status = EnqueueExecution(
+          argument_handles, replica, partition, executable_idx, run_id,
+          options, device, &device_buffers, std::move(device_assignment),
+          compute_callbacks, &output_ready_function);
 
   if (!result_buffer_or_status.ok()) {
     LOG(ERROR) << "Execution of replica " << replica
@@ -2842,7 +2992,6 @@ PjRtStreamExecutorLoadedExecutable::ExecuteHelper(
   ShapeTree<tsl::RCReference<RawSEDeviceMemory>> result_buffer =
       std::move(result_buffer_or_status).value();
 
-  LocalDeviceState* device_state = &(client_->device_state(device_ordinal));
   se::Stream* stream = device_state->compute_stream();
   absl::StatusOr<EventPool::Handle> event_or =
       device_state->event_pool().ThenAllocateAndRecordEvent(stream);
@@ -2865,8 +3014,8 @@ PjRtStreamExecutorLoadedExecutable::ExecuteHelper(
   TF_ASSIGN_OR_RETURN(
       std::vector<std::unique_ptr<PjRtBuffer>> outputs,
       MakeOutputBuffers(device_ordinal, options, std::move(result_buffer),
-                        definition_event, device, compute_callbacks,
-                        buffers_to_release));
+                        definition_event, output_definition_events, device,
+                        compute_callbacks, buffers_to_release));
 
   for (PjRtStreamExecutorBuffer::ScopedHold& b : device_buffers) {
     if (b.type() == PjRtStreamExecutorBuffer::ScopedHold::kUsage) {
@@ -2885,6 +3034,12 @@ PjRtStreamExecutorLoadedExecutable::ExecuteHelper(
     compute_callbacks.push_back(
         [promise = std::move(promise)]() mutable { promise.Set(); });
   }
+  if (sampled) {
+    compute_callbacks.push_back([start_time_usecs]() {
+      metrics::ReportSampledExecutionTime(tsl::Env::Default()->NowMicros() -
+                                          start_time_usecs);
+    });
+  }
   TF_RETURN_IF_ERROR(device_state->ThenExecuteCallback(
       stream, [callbacks{std::move(compute_callbacks)},
                buffers_to_release{std::move(buffers_to_release)}]() mutable {
@@ -2893,8 +3048,13 @@ PjRtStreamExecutorLoadedExecutable::ExecuteHelper(
         }
         callbacks.clear();
       }));
-  metrics::ReportExecutableEnqueueTime(tsl::Env::Default()->NowMicros() -
-                                       start_time_usecs);
+  const uint64_t enqueue_time_usecs =
+      tsl::Env::Default()->NowMicros() - start_time_usecs;
+  metrics::ReportExecutableEnqueueTime(enqueue_time_usecs);
+  if (sampled) {
+    metrics::ReportSampledExecutionEnqueue(enqueue_time_usecs, argument_bytes,
+                                           queue_depth);
+  }
   return Result({/*future=*/std::move(future), /*buffers=*/std::move(outputs)});
 }
 
@@ -2954,7 +3114,10 @@ PjRtStreamExecutorLoadedExecutable::Execute(
         num_partitions());
   }
 
-  TF_RETURN_IF_ERROR(VerifyCompatibleDevices());
+  absl::call_once(compatible_devices_once_, [this] {
+    compatible_devices_status_ = VerifyCompatibleDevices();
+  });
+  TF_RETURN_IF_ERROR(compatible_devices_status_);
   VLOG(1) << "Executing computation " << name()
           << "; num_replicas=" << num_replicas()
           << " num_partitions=" << num_partitions()
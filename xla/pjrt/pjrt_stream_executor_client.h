@@ -28,6 +28,7 @@ limitations under the License.
 #include <utility>
 #include <vector>
 
+#include "absl/base/call_once.h"
 #include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
@@ -499,8 +500,7 @@ class PjRtStreamExecutorClient : public PjRtClient {
 
   tsl::thread::ThreadPool thread_pool_;
 
-  absl::Mutex transpose_mu_;
-  TransposePlanCache transpose_cache_ ABSL_GUARDED_BY(transpose_mu_);
+  TransposePlanCache transpose_cache_;
 
   absl::Mutex dma_maps_mutex_;
   // Maps dma mapped start pointers to their sizes.
@@ -744,6 +744,10 @@ class PjRtStreamExecutorLoadedExecutable : public PjRtLoadedExecutable {
     }
     memory_stats.PopulateBufferStatsFromAllocations(
         executables_[0]->executable()->GetAllocations());
+    if (const BufferAssignment* assignment =
+            executables_[0]->executable()->GetBufferAssignment()) {
+      memory_stats.PopulateMemoryUsageFromBufferAssignment(*assignment);
+    }
     return memory_stats;
   }
 
@@ -847,13 +851,17 @@ class PjRtStreamExecutorLoadedExecutable : public PjRtLoadedExecutable {
       const ExecuteOptions& options, PjRtDevice* device,
       std::vector<PjRtStreamExecutorBuffer::ScopedHold>* device_buffers,
       std::shared_ptr<DeviceAssignment> device_assignment,
-      std::vector<absl::AnyInvocable<void() &&>>& compute_callbacks) const;
+      std::vector<absl::AnyInvocable<void() &&>>& compute_callbacks,
+      OutputReadyFunction* output_ready_function) const;
 
   virtual absl::StatusOr<std::vector<std::unique_ptr<PjRtBuffer>>>
   MakeOutputBuffers(
       int device_ordinal, const ExecuteOptions& options,
       ShapeTree<tsl::RCReference<RawSEDeviceMemory>> result_buffer,
       std::shared_ptr<BufferSequencingEvent> definition_event,
+      const absl::flat_hash_map<int64_t,
+                                std::shared_ptr<BufferSequencingEvent>>&
+          output_definition_events,
       PjRtDevice* device,
       std::vector<absl::AnyInvocable<void() &&>>& compute_callbacks,
       std::vector<tsl::RCReference<RawSEDeviceMemory>>& buffers_to_release)
@@ -897,6 +905,12 @@ class PjRtStreamExecutorLoadedExecutable : public PjRtLoadedExecutable {
   std::vector<PjRtDevice*> addressable_devices_;
   std::string fingerprint_;
 
+  // The result of VerifyCompatibleDevices(). It only depends on the executables
+  // and the addressable devices, so it is computed once on the first Execute()
+  // instead of on every call.
+  absl::once_flag compatible_devices_once_;
+  absl::Status compatible_devices_status_;
+
   struct InputHloSnapshotBits {
     HloModuleProto hlo_module;
     DebugOptions debug_options;
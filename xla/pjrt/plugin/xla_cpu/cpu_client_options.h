@@ -43,6 +43,14 @@ struct CpuClientOptions {
   // My process ID.
   int process_id = 0;
 
+  // If true and the host has multiple NUMA nodes, XLA:CPU partitions the
+  // intra-op thread pool into per-NUMA-node thread pools with threads pinned to
+  // the corresponding node, and runs all computations of a device on the pool
+  // of the NUMA node assigned to that device. Buffers written by the
+  // computation are first touched by the pinned threads, and with the default
+  // Linux first-touch policy they are placed in the node-local memory.
+  bool numa_aware = false;
+
   // Distributed collectives implementation. Optional. If not provided, an
   // in-process collectives implementation will be used.
   std::shared_ptr<cpu::CpuCollectives> collectives;
@@ -53,6 +53,11 @@ bool Semaphore::TryAcquire(int64_t amount) {
   return false;
 }
 
+int64_t Semaphore::available() {
+  absl::MutexLock lock(&mu_);
+  return value_;
+}
+
 void Semaphore::Release(int64_t amount) {
   CHECK_GE(amount, 0);
   absl::MutexLock lock(&mu_);
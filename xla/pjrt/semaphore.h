@@ -40,6 +40,9 @@ class Semaphore {
   // Returns the capacity of the semaphore.
   int64_t capacity() const { return max_capacity_; }
 
+  // Returns the amount that can currently be acquired without blocking.
+  int64_t available();
+
   class ScopedReservation {
    public:
     ScopedReservation(Semaphore* semaphore, int64_t amount)
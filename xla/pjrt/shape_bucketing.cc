@@ -0,0 +1,163 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/pjrt/shape_bucketing.h"
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/algorithm/container.h"
+#include "absl/log/log.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
+#include "xla/hlo/builder/xla_computation.h"
+#include "xla/literal.h"
+#include "xla/pjrt/pjrt_client.h"
+#include "xla/pjrt/pjrt_executable.h"
+#include "xla/shape.h"
+#include "xla/shape_util.h"
+#include "xla/tsl/platform/errors.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/util.h"
+
+namespace xla {
+
+absl::StatusOr<Shape> GetBucketedShape(
+    const Shape& shape, absl::Span<const int64_t> dynamic_dimensions,
+    absl::Span<const int64_t> bucket_sizes) {
+  if (!shape.IsArray()) {
+    return InvalidArgument("Only array shapes can be bucketed, got %s.",
+                           ShapeUtil::HumanString(shape));
+  }
+  Shape bucketed_shape = shape;
+  for (int64_t dim : dynamic_dimensions) {
+    if (dim < 0 || dim >= shape.dimensions_size()) {
+      return InvalidArgument("Dimension %d is out of bounds of %s.", dim,
+                             ShapeUtil::HumanString(shape));
+    }
+    auto bucket = absl::c_lower_bound(bucket_sizes, shape.dimensions(dim));
+    if (bucket == bucket_sizes.end()) {
+      return InvalidArgument(
+          "Dimension %d of %s is larger than the largest bucket size.", dim,
+          ShapeUtil::HumanString(shape));
+    }
+    bucketed_shape.set_dimensions(dim, *bucket);
+    bucketed_shape.set_dynamic_dimension(dim, true);
+  }
+  return bucketed_shape;
+}
+
+Literal PadToBucketedShape(const Literal& literal,
+                           const Shape& bucketed_shape) {
+  if (!bucketed_shape.is_dynamic()) {
+    return literal.Clone();
+  }
+  return literal.ToBoundedDynamic(bucketed_shape);
+}
+
+BucketedExecutableCache::BucketedExecutableCache(PjRtClient* client,
+                                                 ShapeBuckets buckets,
+                                                 ComputationBuilder builder,
+                                                 CompileOptions compile_options)
+    : client_(client),
+      buckets_(std::move(buckets)),
+      compile_options_(std::move(compile_options)),
+      builder_(std::move(builder)) {}
+
+absl::StatusOr<std::vector<Shape>> BucketedExecutableCache::GetBucketedShapes(
+    absl::Span<const Shape> argument_shapes) const {
+  if (argument_shapes.size() != buckets_.dynamic_dimensions.size()) {
+    return InvalidArgument("Expected %d arguments, got %d.",
+                           buckets_.dynamic_dimensions.size(),
+                           argument_shapes.size());
+  }
+  std::vector<Shape> bucketed_shapes;
+  bucketed_shapes.reserve(argument_shapes.size());
+  for (int64_t i = 0; i < argument_shapes.size(); ++i) {
+    TF_ASSIGN_OR_RETURN(
+        Shape bucketed_shape,
+        GetBucketedShape(argument_shapes[i], buckets_.dynamic_dimensions[i],
+                         buckets_.sizes));
+    bucketed_shapes.push_back(std::move(bucketed_shape));
+  }
+  return bucketed_shapes;
+}
+
+absl::StatusOr<PjRtLoadedExecutable*> BucketedExecutableCache::GetOrCompile(
+    absl::Span<const Shape> bucketed_shapes) {
+  std::vector<Shape> key(bucketed_shapes.begin(), bucketed_shapes.end());
+  // Compiling under the lock makes concurrent requests of a new bucket wait for
+  // a single compilation.
+  absl::MutexLock lock(&mu_);
+  auto it = executables_.find(key);
+  if (it != executables_.end()) {
+    return it->second.get();
+  }
+  VLOG(1) << "Compiling the executable for bucket " << executables_.size()
+          << ": " << ShapeUtil::HumanString(ShapeUtil::MakeTupleShape(key));
+  TF_ASSIGN_OR_RETURN(XlaComputation computation, builder_(bucketed_shapes));
+  TF_ASSIGN_OR_RETURN(std::unique_ptr<PjRtLoadedExecutable> executable,
+                      client_->CompileAndLoad(computation, compile_options_));
+  return executables_.emplace(std::move(key), std::move(executable))
+      .first->second.get();
+}
+
+absl::StatusOr<std::vector<std::unique_ptr<PjRtBuffer>>>
+BucketedExecutableCache::Execute(absl::Span<const Literal> arguments,
+                                 PjRtDevice* device,
+                                 const ExecuteOptions& options) {
+  std::vector<Shape> argument_shapes;
+  argument_shapes.reserve(arguments.size());
+  for (const Literal& argument : arguments) {
+    argument_shapes.push_back(argument.shape());
+  }
+  TF_ASSIGN_OR_RETURN(std::vector<Shape> bucketed_shapes,
+                      GetBucketedShapes(argument_shapes));
+  TF_ASSIGN_OR_RETURN(PjRtLoadedExecutable * executable,
+                      GetOrCompile(bucketed_shapes));
+  TF_ASSIGN_OR_RETURN(PjRtMemorySpace * memory_space,
+                      device->default_memory_space());
+
+  std::vector<Literal> padded_arguments;
+  std::vector<std::unique_ptr<PjRtBuffer>> buffers;
+  std::vector<PjRtBuffer*> argument_handles;
+  padded_arguments.reserve(arguments.size());
+  buffers.reserve(arguments.size());
+  argument_handles.reserve(arguments.size());
+  for (int64_t i = 0; i < arguments.size(); ++i) {
+    padded_arguments.push_back(
+        PadToBucketedShape(arguments[i], bucketed_shapes[i]));
+    TF_ASSIGN_OR_RETURN(
+        std::unique_ptr<PjRtBuffer> buffer,
+        client_->BufferFromHostLiteral(padded_arguments.back(), memory_space));
+    argument_handles.push_back(buffer.get());
+    buffers.push_back(std::move(buffer));
+  }
+  // The padded literals have to outlive the transfers.
+  for (const std::unique_ptr<PjRtBuffer>& buffer : buffers) {
+    TF_RETURN_IF_ERROR(buffer->GetReadyFuture().Await());
+  }
+  return executable->ExecuteSharded(argument_handles, device, options);
+}
+
+int64_t BucketedExecutableCache::num_compilations() const {
+  absl::MutexLock lock(&mu_);
+  return executables_.size();
+}
+
+}  // namespace xla
@@ -0,0 +1,108 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_PJRT_SHAPE_BUCKETING_H_
+#define XLA_PJRT_SHAPE_BUCKETING_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/functional/any_invocable.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
+#include "xla/hlo/builder/xla_computation.h"
+#include "xla/literal.h"
+#include "xla/pjrt/pjrt_client.h"
+#include "xla/pjrt/pjrt_executable.h"
+#include "xla/shape.h"
+
+namespace xla {
+
+// The sizes that the dynamic dimensions of the arguments of a computation are
+// padded to.
+struct ShapeBuckets {
+  // The bucket sizes, in increasing order.
+  std::vector<int64_t> sizes;
+  // For each argument, the dimensions that are padded to a bucket size.
+  std::vector<std::vector<int64_t>> dynamic_dimensions;
+};
+
+// Returns `shape` with each of `dynamic_dimensions` rounded up to the smallest
+// of `bucket_sizes` that fits it, and marked as a bounded dynamic dimension.
+absl::StatusOr<Shape> GetBucketedShape(
+    const Shape& shape, absl::Span<const int64_t> dynamic_dimensions,
+    absl::Span<const int64_t> bucket_sizes);
+
+// Pads `literal` to `bucketed_shape`, keeping its original sizes as the
+// dynamic sizes of the result.
+Literal PadToBucketedShape(const Literal& literal, const Shape& bucketed_shape);
+
+// Compiles a computation once per bucket of argument shapes instead of once per
+// argument shape.
+//
+// Arguments are padded to their bucketed shapes, whose bucketed dimensions are
+// bounded dynamic dimensions. The compiler then propagates the actual sizes
+// with DynamicDimensionInference, so the padding doesn't change the results.
+// The executables are cached per bucketed shapes, so only the first request of
+// each bucket pays for the compilation.
+//
+// This class is thread-safe.
+class BucketedExecutableCache {
+ public:
+  // Builds the computation for the given bucketed argument shapes.
+  using ComputationBuilder = absl::AnyInvocable<absl::StatusOr<XlaComputation>(
+      absl::Span<const Shape> argument_shapes)>;
+
+  BucketedExecutableCache(PjRtClient* client, ShapeBuckets buckets,
+                          ComputationBuilder builder,
+                          CompileOptions compile_options);
+
+  // Returns the bucketed shapes of arguments of `argument_shapes`.
+  absl::StatusOr<std::vector<Shape>> GetBucketedShapes(
+      absl::Span<const Shape> argument_shapes) const;
+
+  // Returns the executable for `bucketed_shapes`, compiling it on first use.
+  absl::StatusOr<PjRtLoadedExecutable*> GetOrCompile(
+      absl::Span<const Shape> bucketed_shapes);
+
+  // Pads `arguments` to their buckets, transfers them to `device` and runs the
+  // executable of their bucket. The outputs have dynamic shapes bounded by
+  // their buckets.
+  absl::StatusOr<std::vector<std::unique_ptr<PjRtBuffer>>> Execute(
+      absl::Span<const Literal> arguments, PjRtDevice* device,
+      const ExecuteOptions& options = {});
+
+  // The number of executables compiled so far.
+  int64_t num_compilations() const;
+
+ private:
+  PjRtClient* client_;
+  const ShapeBuckets buckets_;
+  const CompileOptions compile_options_;
+
+  mutable absl::Mutex mu_;
+  ComputationBuilder builder_ ABSL_GUARDED_BY(mu_);
+  absl::flat_hash_map<std::vector<Shape>,
+                      std::unique_ptr<PjRtLoadedExecutable>>
+      executables_ ABSL_GUARDED_BY(mu_);
+};
+
+}  // namespace xla
+
+#endif  // XLA_PJRT_SHAPE_BUCKETING_H_
@@ -0,0 +1,124 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/pjrt/shape_bucketing.h"
+
+#include <memory>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/types/span.h"
+#include "xla/hlo/builder/lib/arithmetic.h"
+#include "xla/hlo/builder/xla_builder.h"
+#include "xla/hlo/builder/xla_computation.h"
+#include "xla/literal.h"
+#include "xla/literal_util.h"
+#include "xla/pjrt/pjrt_client.h"
+#include "xla/pjrt/pjrt_executable.h"
+#include "xla/pjrt/plugin/xla_cpu/cpu_client_options.h"
+#include "xla/pjrt/plugin/xla_cpu/xla_cpu_pjrt_client.h"
+#include "xla/shape.h"
+#include "xla/shape_util.h"
+#include "xla/tsl/lib/core/status_test_util.h"
+#include "xla/tsl/platform/status_matchers.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/xla_data.pb.h"
+
+namespace xla {
+namespace {
+
+using ::absl_testing::StatusIs;
+
+TEST(ShapeBucketingTest, RoundsDynamicDimensionsUpToBuckets) {
+  TF_ASSERT_OK_AND_ASSIGN(
+      Shape bucketed_shape,
+      GetBucketedShape(ShapeUtil::MakeShape(F32, {3, 100}),
+                       /*dynamic_dimensions=*/{1},
+                       /*bucket_sizes=*/{64, 128, 256}));
+  EXPECT_EQ(bucketed_shape, ShapeUtil::MakeShape(F32, {3, 128},
+                                                 /*dynamic_dimensions=*/
+                                                 {false, true}));
+}
+
+TEST(ShapeBucketingTest, KeepsSizesThatMatchABucket) {
+  TF_ASSERT_OK_AND_ASSIGN(
+      Shape bucketed_shape,
+      GetBucketedShape(ShapeUtil::MakeShape(F32, {64}),
+                       /*dynamic_dimensions=*/{0},
+                       /*bucket_sizes=*/{64, 128}));
+  EXPECT_EQ(bucketed_shape, ShapeUtil::MakeShape(F32, {64},
+                                                 /*dynamic_dimensions=*/
+                                                 {true}));
+}
+
+TEST(ShapeBucketingTest, FailsForSizesLargerThanTheLargestBucket) {
+  EXPECT_THAT(GetBucketedShape(ShapeUtil::MakeShape(F32, {300}),
+                               /*dynamic_dimensions=*/{0},
+                               /*bucket_sizes=*/{64, 128}),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(ShapeBucketingTest, PadsLiteralAndKeepsDynamicSize) {
+  Literal literal = LiteralUtil::CreateR1<float>({1, 2, 3});
+  TF_ASSERT_OK_AND_ASSIGN(
+      Shape bucketed_shape,
+      GetBucketedShape(literal.shape(), /*dynamic_dimensions=*/{0},
+                       /*bucket_sizes=*/{4, 8}));
+
+  Literal padded = PadToBucketedShape(literal, bucketed_shape);
+
+  EXPECT_EQ(padded.shape().dimensions(0), 4);
+  EXPECT_EQ(padded.GetDynamicSize(0), 3);
+  EXPECT_EQ(padded.ToStatic(), literal);
+}
+
+TEST(ShapeBucketingTest, CompilesOncePerBucket) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<PjRtClient> client,
+                          GetXlaPjrtCpuClient(CpuClientOptions()));
+  BucketedExecutableCache cache(
+      client.get(),
+      ShapeBuckets{/*sizes=*/{4, 8}, /*dynamic_dimensions=*/{{0}}},
+      [](absl::Span<const Shape> argument_shapes)
+          -> absl::StatusOr<XlaComputation> {
+        XlaBuilder builder("sum");
+        XlaOp x = Parameter(&builder, 0, argument_shapes[0], "x");
+        ReduceAll(x, ConstantR0<float>(&builder, 0),
+                  CreateScalarAddComputation(F32, &builder));
+        return builder.Build();
+      },
+      CompileOptions());
+  PjRtDevice* device = client->addressable_devices()[0];
+
+  std::vector<Literal> arguments;
+  arguments.push_back(LiteralUtil::CreateR1<float>({1, 2, 3}));
+  TF_ASSERT_OK_AND_ASSIGN(auto result, cache.Execute(arguments, device));
+  TF_ASSERT_OK_AND_ASSIGN(std::shared_ptr<Literal> sum,
+                          result[0]->ToLiteralSync());
+  EXPECT_EQ(*sum, LiteralUtil::CreateR0<float>(6));
+
+  arguments[0] = LiteralUtil::CreateR1<float>({1, 2, 3, 4});
+  TF_ASSERT_OK(cache.Execute(arguments, device).status());
+  EXPECT_EQ(cache.num_compilations(), 1);
+
+  arguments[0] = LiteralUtil::CreateR1<float>({1, 2, 3, 4, 5});
+  TF_ASSERT_OK(cache.Execute(arguments, device).status());
+  EXPECT_EQ(cache.num_compilations(), 2);
+}
+
+}  // namespace
+}  // namespace xla
@@ -110,6 +110,10 @@ class StreamExecutorExecutable : public PjRtExecutable {
     }
     memory_stats.PopulateBufferStatsFromAllocations(
         local_executables[0]->executable()->GetAllocations());
+    if (const BufferAssignment* assignment =
+            local_executables[0]->executable()->GetBufferAssignment()) {
+      memory_stats.PopulateMemoryUsageFromBufferAssignment(*assignment);
+    }
     return memory_stats;
   }
 
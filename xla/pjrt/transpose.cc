@@ -89,11 +89,13 @@ limitations under the License.
 #include "absl/base/optimization.h"
 #include "absl/container/inlined_vector.h"
 #include "absl/functional/function_ref.h"
+#include "absl/hash/hash.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
 #include "absl/synchronization/blocking_counter.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
 #include "absl/types/variant.h"
 #include "xla/ef57.h"
@@ -331,14 +333,26 @@ void Transpose(const char* __restrict a, int outer_bs_a, char* __restrict b,
   }
 }
 
-template <typename T>
+// Copies `num_bytes` bytes from `a` to `b`, bypassing the cache if
+// `nontemporal`.
+template <bool nontemporal>
+void CopyBytes(char* __restrict b, const char* __restrict a,
+               int64_t num_bytes) {
+  if constexpr (nontemporal) {
+    NonTemporalMemcpy(b, a, num_bytes);
+  } else {
+    CopyBytes<nontemporal>(b, a, num_bytes);
+  }
+}
+
+template <typename T, bool nontemporal>
 void TransposeConstStride1(const char* __restrict a, char* __restrict b,
                            TransposePlan::Node const* __restrict node) {
   a += node[0].start * node[0].lda;
   b += node[0].start * node[0].ldb;
   if (node[0].is_inner_dim_in_a) {
     int64_t num_bytes = (node->end - node->start) * sizeof(T);
-    std::memcpy(b, a, num_bytes);
+    CopyBytes<nontemporal>(b, a, num_bytes);
   } else if (node[1].is_inner_dim_in_a) {
     int64_t offset_a = node[1].start * node[1].lda;
     int64_t offset_b = node[1].start * node[1].ldb;
@@ -346,12 +360,12 @@ void TransposeConstStride1(const char* __restrict a, char* __restrict b,
     a += offset_a;
     b += offset_b;
     for (int64_t i = node[0].start; i < node[0].end; ++i) {
-      std::memcpy(b, a, num_bytes);
+      CopyBytes<nontemporal>(b, a, num_bytes);
       a += node[0].lda;
       b += node[0].ldb;
     }
     if (node[0].trailing_tile_next_node_inc) {
-      TransposeConstStride1<T>(a - offset_a, b - offset_b,
+      TransposeConstStride1<T, nontemporal>(a - offset_a, b - offset_b,
                                node + node[0].trailing_tile_next_node_inc);
     }
   } else if (node[2].is_inner_dim_in_a) {
@@ -366,12 +380,12 @@ void TransposeConstStride1(const char* __restrict a, char* __restrict b,
       const char* a1 = a;
       char* b1 = b;
       for (int64_t j = node[1].start; j < node[1].end; ++j) {
-        std::memcpy(b1, a1, num_bytes);
+        CopyBytes<nontemporal>(b1, a1, num_bytes);
         a1 += node[1].lda;
         b1 += node[1].ldb;
       }
       if (node[1].trailing_tile_next_node_inc) {
-        TransposeConstStride1<T>(
+        TransposeConstStride1<T, nontemporal>(
             a1 - offset_a2, b1 - offset_b2,
             &node[1] + node[1].trailing_tile_next_node_inc);
       }
@@ -379,7 +393,7 @@ void TransposeConstStride1(const char* __restrict a, char* __restrict b,
       b += node[0].ldb;
     }
     if (node[0].trailing_tile_next_node_inc) {
-      TransposeConstStride1<T>(a - offset_a1 - offset_a2,
+      TransposeConstStride1<T, nontemporal>(a - offset_a1 - offset_a2,
                                b - offset_b1 - offset_b2,
                                node + node[0].trailing_tile_next_node_inc);
     }
@@ -388,19 +402,19 @@ void TransposeConstStride1(const char* __restrict a, char* __restrict b,
       const char* a1 = a + node[1].start * node[1].lda;
       char* b1 = b + node[1].start * node[1].ldb;
       for (int64_t j = node[1].start; j < node[1].end; ++j) {
-        TransposeConstStride1<T>(a1, b1, node + 2);
+        TransposeConstStride1<T, nontemporal>(a1, b1, node + 2);
         a1 += node[1].lda;
         b1 += node[1].ldb;
       }
       if (node[1].trailing_tile_next_node_inc) {
-        TransposeConstStride1<T>(
+        TransposeConstStride1<T, nontemporal>(
             a1, b1, &node[1] + node[1].trailing_tile_next_node_inc);
       }
       a += node[0].lda;
       b += node[0].ldb;
     }
     if (node[0].trailing_tile_next_node_inc) {
-      TransposeConstStride1<T>(a, b,
+      TransposeConstStride1<T, nontemporal>(a, b,
                                node + node[0].trailing_tile_next_node_inc);
     }
   }
@@ -418,7 +432,12 @@ void TransposePlan::ExecuteTyped(const char* a, char* b,
 
   if (inner_kernel_is_memcpy_) {
     DCHECK(transformation_ == Transformation::kNone);
-    TransposeConstStride1<T>(a, b, nodes.data());
+    if (use_nontemporal_stores_) {
+      TransposeConstStride1<T, /*nontemporal=*/true>(a, b, nodes.data());
+      StoreFence();
+    } else {
+      TransposeConstStride1<T, /*nontemporal=*/false>(a, b, nodes.data());
+    }
   } else {
     std::unique_ptr<char[]> scratch;
     if (scratch_size_ > 0) {
@@ -1157,6 +1176,14 @@ void TransposePlan::Initialize() {
     outer_block_elems_b_ = std::max<int64_t>(outer_block_elems_b_, 1);
   }
 
+  // An output much larger than the last-level cache would only evict the input
+  // from the cache, so write it with non-temporal stores. Short copies are
+  // left alone, since their unaligned head and tail use ordinary stores.
+  use_nontemporal_stores_ =
+      inner_kernel_is_memcpy_ &&
+      OutputNumElems() * elem_size_in_bytes_ >= kMinNonTemporalOutputBytes &&
+      a_stride1_size * elem_size_in_bytes_ >= kMinNonTemporalCopyBytes;
+
   // Loop order heuristic: try to make loops with small strides innermost.
   auto cost = [&](const Loop& l) {
     int64_t a_stride =
@@ -1326,7 +1353,7 @@ std::string TransposePlan::ToString() const {
       "elem_size=%d a_dims=%s b_dims=%s permutation=%s a_tiling=%s b_tiling=%s "
       "lda=%s lda_tile=%s ldb=%s ldb_tile=%s loop_order=%s "
       "loop_parallelism=%s outer_bs=[%d,%d] inner_bs=%d "
-      "transformation=%s scratch_size=%d\n"
+      "transformation=%s scratch_size=%d nontemporal_stores=%d\n"
       "nodes:\n%s",
       elem_size_in_bytes_, absl::StrJoin(a_dims_, ","),
       absl::StrJoin(Permute(a_dims_, permutation_), ","),
@@ -1337,7 +1364,7 @@ std::string TransposePlan::ToString() const {
       absl::StrJoin(loop_order_, ",", format_loop_order),
       absl::StrJoin(loop_parallelism_, ","), outer_block_elems_a_,
       outer_block_elems_b_, inner_block_elems_, transformation_str,
-      scratch_size_, nodes_str);
+      scratch_size_, use_nontemporal_stores_, nodes_str);
 }
 
 bool TransposePlanCacheKey::operator==(
@@ -1359,8 +1386,15 @@ H AbslHashValue(H h, const TransposePlanCacheKey& key) {
                     key.input_layout, key.output_tiling);
 }
 
-TransposePlanCache::TransposePlanCache(int capacity)
-    : lru_list_(capacity), cache_(&lru_list_) {}
+TransposePlanCache::TransposePlanCache(int capacity, int num_shards) {
+  CHECK_GE(num_shards, 1);
+  shards_.reserve(num_shards);
+  for (int i = 0; i < num_shards; ++i) {
+    // Spreads the remainder of the capacity over the first shards.
+    shards_.push_back(std::make_unique<Shard>(capacity / num_shards +
+                                              (i < capacity % num_shards)));
+  }
+}
 
 TransposePlanCache::~TransposePlanCache() = default;
 
@@ -1389,7 +1423,10 @@ absl::StatusOr<std::shared_ptr<TransposePlan>> TransposePlanCache::GetOrCreate(
   absl::c_copy(o.output_tiling.tiling, key.output_tiling.begin());
   key.transformation = o.transformation;
   key.num_threads = o.num_threads;
-  return cache_.GetOrCreateIfAbsent(
+  Shard& shard =
+      *shards_[absl::HashOf(key) % static_cast<size_t>(shards_.size())];
+  absl::MutexLock lock(&shard.mu);
+  return shard.cache.GetOrCreateIfAbsent(
       key,
       [&](const TransposePlanCacheKey& key)
           -> absl::StatusOr<std::shared_ptr<TransposePlan>> {
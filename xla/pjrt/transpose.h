@@ -35,9 +35,11 @@ limitations under the License.
 #include <variant>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
 #include "absl/container/inlined_vector.h"
 #include "absl/functional/function_ref.h"
 #include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
 #include "absl/types/variant.h"
 #include "xla/pjrt/lru_cache.h"
@@ -172,6 +174,11 @@ class TransposePlan {
   template <typename T, Transformation transformation>
   void ExecuteTyped(const char* a, char* b, absl::Span<Node const> nodes) const;
 
+  // Outputs of at least this size are written with non-temporal stores when
+  // the inner kernel is a memcpy of at least kMinNonTemporalCopyBytes.
+  static constexpr int64_t kMinNonTemporalOutputBytes = int64_t{32} << 20;
+  static constexpr int64_t kMinNonTemporalCopyBytes = 256;
+
   // Number of threads requested.
   int num_threads_requested_ = 1;
 
@@ -237,6 +244,9 @@ class TransposePlan {
   int outer_block_elems_a_ = 4;
   int outer_block_elems_b_ = 4;
 
+  // Whether the memcpy inner kernel uses non-temporal stores.
+  bool use_nontemporal_stores_ = false;
+
   // Transformations to apply to the input before transposition.
   // Currently the only supported transformation is EF57 conversion, which is
   // a pair-of-floats extended precision representation used on TPU. We
@@ -269,13 +279,18 @@ struct TransposePlanCacheKey {
 template <typename H>
 H AbslHashValue(H h, const TransposePlanCacheKey& key);
 
-// An LRU cache for transpose plans. Not thread-safe.
+// An LRU cache for transpose plans. Thread-safe.
 // Transpose plans aren't cheap to build, but once computed for a particular set
 // of inputs can be cached and reused for arrays. TransposePlanCache implements
 // such a cache.
+//
+// The cache is split into `num_shards` shards by key hash, each with its own
+// lock and an equal share of `capacity`, so that concurrent lookups of
+// different plans don't contend. Each shard evicts its own least recently used
+// plans.
 class TransposePlanCache {
  public:
-  explicit TransposePlanCache(int capacity);
+  explicit TransposePlanCache(int capacity, int num_shards = 1);
   ~TransposePlanCache();
 
   TransposePlanCache(const TransposePlanCache&) = delete;
@@ -288,11 +303,18 @@ class TransposePlanCache {
       const TransposePlan::Options& options);
 
  private:
-  LRUCache<TransposePlanCacheKey,
-           absl::StatusOr<std::shared_ptr<TransposePlan>>>::LRUList lru_list_;
-  LRUCache<TransposePlanCacheKey,
-           absl::StatusOr<std::shared_ptr<TransposePlan>>>
-      cache_;
+  using Cache = LRUCache<TransposePlanCacheKey,
+                         absl::StatusOr<std::shared_ptr<TransposePlan>>>;
+
+  struct Shard {
+    explicit Shard(int capacity) : lru_list(capacity), cache(&lru_list) {}
+
+    absl::Mutex mu;
+    Cache::LRUList lru_list;
+    Cache cache ABSL_GUARDED_BY(mu);
+  };
+
+  std::vector<std::unique_ptr<Shard>> shards_;
 };
 
 }  // namespace xla
@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef XLA_PJRT_TRANSPOSE_KERNELS_H_
 #define XLA_PJRT_TRANSPOSE_KERNELS_H_
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstdint>
@@ -691,6 +692,49 @@ struct TransposeMicroKernel {
   }
 };
 
+// Copies `num_bytes` bytes from `a` to `b`, with stores that bypass the cache
+// where the target supports them. Callers must issue a StoreFence() before
+// another thread reads `b`.
+inline void NonTemporalMemcpy(char* __restrict b, const char* __restrict a,
+                              int64_t num_bytes) {
+#ifdef XLA_HAS_SSE2
+  // Streaming stores must be 16-byte aligned, so the bytes before the first
+  // aligned address of `b` are copied with an ordinary memcpy.
+  int64_t head = std::min<int64_t>(
+      num_bytes, -reinterpret_cast<uintptr_t>(b) & (sizeof(__m128i) - 1));
+  std::memcpy(b, a, head);
+  a += head;
+  b += head;
+  num_bytes -= head;
+  for (; num_bytes >= 4 * sizeof(__m128i); num_bytes -= 4 * sizeof(__m128i)) {
+    __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a));
+    __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a) + 1);
+    __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a) + 2);
+    __m128i v3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a) + 3);
+    _mm_stream_si128(reinterpret_cast<__m128i*>(b), v0);
+    _mm_stream_si128(reinterpret_cast<__m128i*>(b) + 1, v1);
+    _mm_stream_si128(reinterpret_cast<__m128i*>(b) + 2, v2);
+    _mm_stream_si128(reinterpret_cast<__m128i*>(b) + 3, v3);
+    a += 4 * sizeof(__m128i);
+    b += 4 * sizeof(__m128i);
+  }
+  for (; num_bytes >= sizeof(__m128i); num_bytes -= sizeof(__m128i)) {
+    _mm_stream_si128(reinterpret_cast<__m128i*>(b),
+                     _mm_loadu_si128(reinterpret_cast<const __m128i*>(a)));
+    a += sizeof(__m128i);
+    b += sizeof(__m128i);
+  }
+#endif
+  std::memcpy(b, a, num_bytes);
+}
+
+// Orders the preceding NonTemporalMemcpy stores before any later stores.
+inline void StoreFence() {
+#ifdef XLA_HAS_SSE2
+  _mm_sfence();
+#endif
+}
+
 }  // namespace xla
 
 #endif  // XLA_PJRT_TRANSPOSE_KERNELS_H_
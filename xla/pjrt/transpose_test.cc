@@ -19,6 +19,7 @@ limitations under the License.
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <memory>
 #include <numeric>
 #include <ostream>
 #include <string>
@@ -28,6 +29,8 @@ limitations under the License.
 
 #include "absl/container/inlined_vector.h"
 #include "absl/numeric/int128.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/blocking_counter.h"
 #include "unsupported/Eigen/CXX11/Tensor"
 #include "xla/array.h"
 #include "xla/hlo/testlib/test.h"
@@ -474,6 +477,33 @@ TEST(TransposeTest, NegativeStrides2D) {
   EXPECT_EQ(expected, output);
 }
 
+TEST(TransposeTest, LargeMemcpyUsesNonTemporalStores) {
+  // A 32MiB output whose minor dimension is copied unchanged.
+  const int64_t n0 = 8, n1 = 1024, n2 = 1024;
+  std::vector<int32_t> input(n0 * n1 * n2);
+  absl::c_iota(input, int32_t{0});
+  std::vector<int64_t> dims = {n0, n1, n2};
+  std::vector<int64_t> permutation = {1, 0, 2};
+  TransposePlan::Options options;
+  options.elem_size_in_bytes = sizeof(int32_t);
+  options.dims = dims;
+  options.permutation = permutation;
+  TF_ASSERT_OK_AND_ASSIGN(auto plan, TransposePlan::Create(options));
+  EXPECT_THAT(plan->ToString(), testing::HasSubstr("nontemporal_stores=1"));
+
+  // Offsets the output so that the copies don't start 16-byte aligned.
+  std::vector<int32_t> output(input.size() + 1);
+  plan->Execute(input.data(), output.data() + 1);
+  for (int64_t i = 0; i < n0; ++i) {
+    for (int64_t j = 0; j < n1; ++j) {
+      for (int64_t k = 0; k < n2; ++k) {
+        ASSERT_EQ(output[1 + (j * n0 + i) * n2 + k],
+                  input[(i * n1 + j) * n2 + k]);
+      }
+    }
+  }
+}
+
 static std::vector<TransposeTestCase> BenchmarkCases() {
   return std::vector<TransposeTestCase>{
       TransposeTestCase(/*dims=*/{256, 256},
@@ -626,4 +656,37 @@ TEST(TransposePlanCache, Basics) {
   EXPECT_TRUE(p1.get() != p1b.get());
 }
 
+TEST(TransposePlanCache, ConcurrentShardedLookups) {
+  std::vector<int64_t> dims = {4, 5, 6};
+  std::vector<std::vector<int64_t>> permutations = {
+      {0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}};
+  TransposePlanCache cache(64, /*num_shards=*/4);
+  std::vector<std::shared_ptr<TransposePlan>> plans(permutations.size());
+  for (size_t i = 0; i < permutations.size(); ++i) {
+    TransposePlan::Options o;
+    o.elem_size_in_bytes = 4;
+    o.dims = dims;
+    o.permutation = permutations[i];
+    TF_ASSERT_OK_AND_ASSIGN(plans[i], cache.GetOrCreate(o));
+  }
+
+  // Every thread must find the plans created above.
+  tsl::thread::ThreadPool threadpool(tsl::Env::Default(), "test", 8);
+  absl::BlockingCounter counter(64);
+  for (int t = 0; t < 64; ++t) {
+    threadpool.Schedule([&, t] {
+      size_t i = t % permutations.size();
+      TransposePlan::Options o;
+      o.elem_size_in_bytes = 4;
+      o.dims = dims;
+      o.permutation = permutations[i];
+      absl::StatusOr<std::shared_ptr<TransposePlan>> plan =
+          cache.GetOrCreate(o);
+      EXPECT_TRUE(plan.ok() && plan->get() == plans[i].get());
+      counter.DecrementCount();
+    });
+  }
+  counter.Wait();
+}
+
 }  // namespace xla
@@ -926,14 +926,14 @@ constexpr bool IsSubByteNonPredType(PrimitiveType type) {
 }
 
 // Packs the given input of sub-byte values into the given output. The bit width
-// of the input type must be 2 or 4, or this function will crash.
+// of the input type must be 1, 2 or 4, or this function will crash.
 inline void PackIntN(PrimitiveType input_type, absl::Span<const char> input,
                      absl::Span<char> output) {
   xla::PackIntN(primitive_util::BitWidth(input_type), input, output);
 }
 
 // Unpacks the given input of sub-byte values into the given output. The bit
-// width of the input type must be 2 or 4, or this function will crash.
+// width of the input type must be 1, 2 or 4, or this function will crash.
 inline void UnpackIntN(PrimitiveType input_type, absl::Span<const char> input,
                        absl::Span<char> output) {
   xla::UnpackIntN(primitive_util::BitWidth(input_type), input, output);
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "xla/printer.h"
 
+#include <cstddef>
 #include <cstring>
 #include <string>
 #include <utility>
@@ -23,7 +24,9 @@ limitations under the License.
 #include "absl/strings/cord.h"
 #include "absl/strings/cord_buffer.h"
 #include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
 #include "xla/tsl/platform/logging.h"
+#include "tsl/platform/fingerprint.h"
 
 namespace xla {
 
@@ -68,4 +71,34 @@ absl::Cord CordPrinter::ToCord() && {
   return std::move(result_);
 }
 
+namespace {
+constexpr size_t kFingerprintChunkSize = 16 << 10;
+}  // namespace
+
+FingerprintPrinter::FingerprintPrinter() {
+  buffer_.reserve(kFingerprintChunkSize);
+}
+
+void FingerprintPrinter::Append(const absl::AlphaNum& a) {
+  absl::string_view piece = a.Piece();
+  while (buffer_.size() + piece.size() >= kFingerprintChunkSize) {
+    const size_t length = kFingerprintChunkSize - buffer_.size();
+    buffer_.append(piece.data(), length);
+    piece.remove_prefix(length);
+    AppendBuffer();
+  }
+  buffer_.append(piece.data(), piece.size());
+}
+
+void FingerprintPrinter::AppendBuffer() {
+  fingerprint_ =
+      tsl::FingerprintCat128(fingerprint_, tsl::Fingerprint128(buffer_));
+  buffer_.clear();
+}
+
+tsl::Fprint128 FingerprintPrinter::ToFingerprint() && {
+  if (!buffer_.empty()) AppendBuffer();
+  return fingerprint_;
+}
+
 }  // namespace xla
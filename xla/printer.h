@@ -24,6 +24,7 @@ limitations under the License.
 #include "absl/strings/cord_buffer.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "tsl/platform/fingerprint.h"
 
 namespace xla {
 
@@ -67,6 +68,25 @@ class CordPrinter : public Printer {
   absl::Cord result_;
 };
 
+// A printer implementation that computes a 128-bit fingerprint of the printed
+// strings without keeping them in memory. The strings are fingerprinted in
+// fixed-size chunks, so the result only depends on the printed text, but it is
+// not tsl::Fingerprint128 of the text.
+class FingerprintPrinter : public Printer {
+ public:
+  FingerprintPrinter();
+
+  void Append(const absl::AlphaNum& a) override;
+
+  tsl::Fprint128 ToFingerprint() &&;
+
+ private:
+  void AppendBuffer();
+
+  std::string buffer_;
+  tsl::Fprint128 fingerprint_ = {0, 0};
+};
+
 // Utility functions that appends a list of elements to a Printer as if by
 // calling printer->Append(absl::StrJoin(...)), but does it in-place.
 template <typename Range, typename PrintFunc>
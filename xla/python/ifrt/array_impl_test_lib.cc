@@ -702,6 +702,49 @@ TEST(ArrayImplTest, AssembleArray) {
             assembled_sharding.get());
 }
 
+TEST(ArrayImplTest, AssembleArrays) {
+  TF_ASSERT_OK_AND_ASSIGN(auto client, test_util::GetClient());
+
+  DType dtype(DType::kF32);
+  Shape shape({2, 3});
+  std::vector<float> data(6);
+  std::iota(data.begin(), data.end(), 0);
+  Device* device0 = client->addressable_devices().at(0);
+  Device* device1 = client->addressable_devices().at(1);
+  auto make_array = [&](Device* device) {
+    return client->MakeArrayFromHostBuffer(
+        data.data(), dtype, shape,
+        /*byte_strides=*/std::nullopt,
+        SingleDeviceSharding::Create(device, MemoryKind()),
+        Client::HostBufferSemantics::kImmutableOnlyDuringCall,
+        /*on_done_with_host_buffer=*/{});
+  };
+
+  Shape assembled_shape({4, 3});
+  std::shared_ptr<const Sharding> assembled_sharding = OpaqueSharding::Create(
+      client->MakeDeviceList({device0, device1}), MemoryKind());
+  std::vector<Client::AssembleArraySpec> specs;
+  for (int i = 0; i < 2; ++i) {
+    TF_ASSERT_OK_AND_ASSIGN(auto array0, make_array(device0));
+    TF_ASSERT_OK_AND_ASSIGN(auto array1, make_array(device1));
+    specs.push_back({dtype, assembled_shape, assembled_sharding,
+                     {std::move(array0), std::move(array1)}});
+  }
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto assembled_arrays,
+      client->AssembleArraysFromSingleDeviceArrays(
+          absl::MakeSpan(specs), ArrayCopySemantics::kAlwaysCopy,
+          SingleDeviceShardSemantics::kAddressableShards));
+
+  ASSERT_EQ(assembled_arrays.size(), 2);
+  for (const auto& assembled_array : assembled_arrays) {
+    EXPECT_EQ(assembled_array->dtype(), dtype);
+    EXPECT_EQ(assembled_array->shape(), assembled_shape);
+    EXPECT_EQ(assembled_array->shared_ptr_sharding().get(),
+              assembled_sharding.get());
+  }
+}
+
 TEST(ArrayImplTest, AssembleAndDisassembleArray) {
   TF_ASSERT_OK_AND_ASSIGN(auto client, test_util::GetClient());
 
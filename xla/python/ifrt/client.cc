@@ -15,10 +15,38 @@ limitations under the License.
 
 #include "xla/python/ifrt/client.h"
 
+#include <utility>
+#include <vector>
+
+#include "absl/status/statusor.h"
+#include "absl/types/span.h"
+#include "xla/python/ifrt/array.h"
+#include "xla/tsl/concurrency/ref_count.h"
+#include "xla/tsl/platform/statusor.h"
+
 namespace xla {
 namespace ifrt {
 
 char Client::ID = 0;
 
+absl::StatusOr<std::vector<tsl::RCReference<Array>>>
+Client::AssembleArraysFromSingleDeviceArrays(
+    absl::Span<AssembleArraySpec> specs,
+    ArrayCopySemantics array_copy_semantics,
+    SingleDeviceShardSemantics single_device_shard_semantics) {
+  std::vector<tsl::RCReference<Array>> arrays;
+  arrays.reserve(specs.size());
+  for (AssembleArraySpec& spec : specs) {
+    TF_ASSIGN_OR_RETURN(
+        tsl::RCReference<Array> array,
+        AssembleArrayFromSingleDeviceArrays(
+            spec.dtype, std::move(spec.shape), std::move(spec.sharding),
+            absl::MakeSpan(spec.arrays), array_copy_semantics,
+            single_device_shard_semantics));
+    arrays.push_back(std::move(array));
+  }
+  return arrays;
+}
+
 }  // namespace ifrt
 }  // namespace xla
@@ -226,6 +226,29 @@ class Client : public llvm::RTTIExtends<Client, llvm::RTTIRoot> {
       ArrayCopySemantics array_copy_semantics,
       SingleDeviceShardSemantics single_device_shard_semantics) = 0;
 
+  // Specification of one array assembled by
+  // `AssembleArraysFromSingleDeviceArrays()`.
+  struct AssembleArraySpec {
+    DType dtype;
+    Shape shape;
+    absl::Nonnull<std::shared_ptr<const Sharding>> sharding;
+    std::vector<tsl::RCReference<Array>> arrays;
+  };
+
+  // Builds larger arrays out of individual per-device shards, one for each of
+  // `specs`. Equivalent to calling `AssembleArrayFromSingleDeviceArrays()` for
+  // each spec, but lets callers that assemble many arrays at once, e.g., the
+  // leaves of a pytree, do so with a single call that implementations can
+  // batch.
+  //
+  // `specs` may be consumed by the implementation. The default implementation
+  // assembles the arrays one at a time and fails on the first error.
+  virtual absl::StatusOr<std::vector<tsl::RCReference<Array>>>
+  AssembleArraysFromSingleDeviceArrays(
+      absl::Span<AssembleArraySpec> specs,
+      ArrayCopySemantics array_copy_semantics,
+      SingleDeviceShardSemantics single_device_shard_semantics);
+
   ABSL_DEPRECATE_AND_INLINE()
   absl::StatusOr<tsl::RCReference<Array>> AssembleArrayFromSingleDeviceArrays(
       Shape shape, absl::Nonnull<std::shared_ptr<const Sharding>> sharding,
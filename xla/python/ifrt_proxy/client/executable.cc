@@ -390,6 +390,12 @@ LoadedExecutable::~LoadedExecutable() {
   tsl::profiler::TraceMe traceme_ifrt_entrypoint(
       "IfrtProxyEntrypointLoadedExecutableDestruct");
 
+  if (rpc_helper_->version().protocol_version() >=
+      protocol_version::kBatchedLoadedExecutableDestruct) {
+    rpc_helper_->Batch(RpcHelper::kDestructLoadedExecutable, handle_);
+    return;
+  }
+
   auto req = std::make_unique<LoadedExecutableDestructRequest>();
   req->set_loaded_executable_handle(handle_);
 
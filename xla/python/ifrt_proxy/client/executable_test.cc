@@ -357,12 +357,15 @@ TEST_F(LoadedExecutableTest, Execute) {
 #if defined(PLATFORM_GOOGLE)
 TEST_F(LoadedExecutableTest, Delete) {
   MockClient client;
-  LoadedExecutable executable(
+  auto executable = std::make_unique<LoadedExecutable>(
       &client, rpc_helper_, /*handle=*/1234, /*name=*/"foo",
-      /*num_devices=*/2, /*addressable_devices=*/{},
+      /*num_devices=*/2,
+      /*addressable_devices=*/std::vector<xla::ifrt::Device*>(),
       /*fingerprint=*/"fingerprint",
       /*ready_future=*/Future<>(absl::OkStatus()),
-      /*loaded_host_callbacks=*/{}, /*loaded_host_callback_handles=*/{});
+      /*loaded_host_callbacks=*/
+      std::vector<tsl::RCReference<xla::ifrt::LoadedHostCallback>>(),
+      /*loaded_host_callback_handles=*/std::vector<uint64_t>());
 
   {
     IfrtResponse response;
@@ -394,7 +397,7 @@ TEST_F(LoadedExecutableTest, Delete) {
                                                     })pb")))))
         .WillOnce(MockClientSessionReturnResponse(response));
 
-    Future<> result = executable.Delete();
+    Future<> result = executable->Delete();
     EXPECT_THAT(result.Await(),
                 StatusIs(absl::StatusCode::kUnknown, StrEq("injected error")));
   }
@@ -412,7 +415,7 @@ TEST_F(LoadedExecutableTest, Delete) {
                                     })pb")))))
         .WillOnce(MockClientSessionReturnResponse(response));
 
-    EXPECT_TRUE(executable.IsDeleted());
+    EXPECT_TRUE(executable->IsDeleted());
   }
 
   IfrtResponse response;
@@ -423,9 +426,15 @@ TEST_F(LoadedExecutableTest, Delete) {
       &response));
   EXPECT_CALL(*session_, Enqueue(Pointee(Partially(EquivToProto(
                              R"pb(loaded_executable_destruct_request {
-                                    loaded_executable_handle: 1234
+                                    loaded_executable_handles: 1234
                                   })pb")))))
       .WillOnce(MockClientSessionReturnResponse(response));
+  executable.reset();
+
+  // Destruction is batched, so send an unbatched request to flush it.
+  auto check_future_request = std::make_unique<CheckFutureRequest>();
+  check_future_request->set_future_handle(1);
+  rpc_helper_->CheckFuture(std::move(check_future_request));
 }
 #endif
 
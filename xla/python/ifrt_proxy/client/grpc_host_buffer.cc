@@ -16,9 +16,11 @@
 
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 
+#include "absl/cleanup/cleanup.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -34,6 +36,8 @@
 #include "xla/python/ifrt_proxy/common/grpc_ifrt_service.grpc.pb.h"
 #include "xla/python/ifrt_proxy/common/grpc_ifrt_service.pb.h"
 #include "xla/python/ifrt_proxy/common/prof_util.h"
+#include "xla/python/ifrt_proxy/common/shared_memory.h"
+#include "xla/python/ifrt_proxy/common/versions.h"
 #include "xla/tsl/protobuf/status.pb.h"
 #include "tsl/platform/unbounded_work_queue.h"
 #include "tsl/profiler/lib/traceme.h"
@@ -60,6 +64,8 @@ GrpcClientHostBufferStore::GrpcClientHostBufferStore(
     : stub_(std::move(stub)),
       version_(std::move(version)),
       session_id_(session_id),
+      use_shared_memory_(version_.protocol_version() >=
+                         protocol_version::kHostBufferSharedMemory),
       work_queue_(std::make_unique<tsl::UnboundedWorkQueue>(
           tsl::Env::Default(), "HostBufferStoreLookupsWorkQueue")) {}
 
@@ -69,6 +75,56 @@ GrpcClientHostBufferStore::~GrpcClientHostBufferStore() {
   LOG(INFO) << "Destructed HostBufferStoreLookupsWorkQueue.";
 }
 
+std::optional<absl::Status>
+GrpcClientHostBufferStore::MaybeStoreViaSharedMemory(uint64_t handle,
+                                                     const absl::Cord& data) {
+  // Buffers that fit in a single chunk are cheap to stream.
+  if (data.size() <= kChunkSize ||
+      !use_shared_memory_.load(std::memory_order_relaxed)) {
+    return std::nullopt;
+  }
+  const std::string name = HostBufferSharedMemoryName(session_id_, handle);
+  if (absl::Status s = WriteSharedMemory(name, data); !s.ok()) {
+    LOG(WARNING) << "Streaming host buffers instead of using shared memory: "
+                 << s;
+    use_shared_memory_.store(false, std::memory_order_relaxed);
+    return std::nullopt;
+  }
+  // The server has copied the data out once the RPC is done.
+  absl::Cleanup unlink = [&name]() { UnlinkSharedMemory(name); };
+
+  tsl::profiler::TraceMe traceme([size = data.size()]() {
+    return tsl::profiler::TraceMeEncode(
+        "GrpcClientHostBufferStore::StoreViaSharedMemory", {{"size", size}});
+  });
+  GrpcHostBufferStoreMetadata metadata;
+  metadata.set_session_id(session_id_);
+  metadata.set_handle(handle);
+  metadata.set_buffer_size(data.size());
+  metadata.set_shared_memory_name(name);
+  VLOG(3) << "GrpcClientHostBufferStore::Store start "
+          << metadata.ShortDebugString();
+
+  ::grpc::ClientContext context;
+  context.AddMetadata("ifrt-proxy-grpc-host-buffer-store-metadata-bin",
+                      metadata.SerializeAsString());
+
+  GrpcHostBufferStoreResponse response;
+  auto writer = stub_->HostBufferStore(&context, &response);
+  writer->WritesDone();
+  absl::Status status = xla::FromGrpcStatus(writer->Finish());
+  if (absl::IsFailedPrecondition(status)) {
+    LOG(INFO) << "IFRT proxy server cannot read host buffers from shared "
+                 "memory, streaming them instead: "
+              << status;
+    use_shared_memory_.store(false, std::memory_order_relaxed);
+    return std::nullopt;
+  }
+  VLOG(3) << "GrpcClientHostBufferStore::Store done "
+          << metadata.ShortDebugString();
+  return status;
+}
+
 Future<> GrpcClientHostBufferStore::Store(uint64_t handle,
                                           absl::string_view data) {
   auto promise = Future<>::CreatePromise();
@@ -80,6 +136,13 @@ Future<> GrpcClientHostBufferStore::Store(uint64_t handle,
 
   work_queue_->Schedule([this, handle, promise, data, flow]() mutable -> void {
     auto span = flow.Span<XFlowHelper::kRecv>();
+    if (std::optional<absl::Status> status = MaybeStoreViaSharedMemory(
+            handle, absl::MakeCordFromExternal(data, []() {}));
+        status.has_value()) {
+      promise.Set(*std::move(status));
+      return;
+    }
+
     GrpcHostBufferStoreMetadata metadata;
     metadata.set_session_id(session_id_);
     metadata.set_handle(handle);
@@ -126,6 +189,11 @@ Future<> GrpcClientHostBufferStore::Store(uint64_t handle,
   // The current implementation synchronously sends host buffer chunks. We may
   // consider making it asynchronous if the caller can leverage such asynchrony.
   tsl::profiler::TraceMe traceme("GrpcClientHostBufferStore::StoreSync");
+  if (std::optional<absl::Status> status =
+          MaybeStoreViaSharedMemory(handle, data);
+      status.has_value()) {
+    return Future<>(*std::move(status));
+  }
 
   GrpcHostBufferStoreMetadata metadata;
   metadata.set_session_id(session_id_);
@@ -17,9 +17,12 @@
 #ifndef XLA_PYTHON_IFRT_PROXY_CLIENT_GRPC_HOST_BUFFER_H_
 #define XLA_PYTHON_IFRT_PROXY_CLIENT_GRPC_HOST_BUFFER_H_
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
+#include <optional>
 
+#include "absl/status/status.h"
 #include "absl/strings/cord.h"
 #include "absl/strings/string_view.h"
 #include "xla/python/ifrt/future.h"
@@ -48,10 +51,21 @@ class GrpcClientHostBufferStore : public ClientHostBufferStore {
   Future<> Delete(uint64_t handle) override;
 
  private:
+  // Stores `data` by passing it to the server through shared memory. Returns
+  // nullopt if the data should be streamed instead, e.g., because the buffer
+  // is small or the server runs on another host.
+  std::optional<absl::Status> MaybeStoreViaSharedMemory(
+      uint64_t handle, const absl::Cord& data);
+
   const std::shared_ptr<grpc::GrpcIfrtService::StubInterface> stub_;
   const IfrtProxyVersion version_;
   const uint64_t session_id_;
 
+  // Whether to try storing large buffers through shared memory. Cleared once
+  // the server fails to read a buffer from it, so that later buffers of the
+  // session are streamed right away.
+  std::atomic<bool> use_shared_memory_;
+
   // Implementation note: `work_queue_` may have closures that invoke
   // user-defined code. Each `Store()` and `Lookup()` call is associated with a
   // scheduled closure, and the closure is used to first perform synchronous
@@ -57,7 +57,7 @@ class BatchedOps {
  public:
   using BatchOperation = RpcHelper::BatchOperation;
 
-  void Add(BatchOperation op, ArrayHandle handle) {
+  void Add(BatchOperation op, uint64_t handle) {
     absl::MutexLock l(&mu_);
     batched_[op].push_back(handle);
   }
@@ -65,6 +65,7 @@ class BatchedOps {
   struct IfrtRequests {
     std::unique_ptr<IfrtRequest> delete_req;
     std::unique_ptr<IfrtRequest> destruct_req;
+    std::unique_ptr<IfrtRequest> executable_destruct_req;
   };
 
   IfrtRequests Consume() {
@@ -72,26 +73,37 @@ class BatchedOps {
     absl::MutexLock l(&mu_);
     if (!batched_[BatchOperation::kDeleteArray].empty()) {
       result.delete_req = std::make_unique<IfrtRequest>();
-      for (const auto& arr_handle : batched_[BatchOperation::kDeleteArray]) {
+      for (const uint64_t arr_handle : batched_[BatchOperation::kDeleteArray]) {
         result.delete_req->mutable_delete_array_request()->add_array_handle(
-            arr_handle.handle);
+            arr_handle);
       }
       batched_[BatchOperation::kDeleteArray].clear();
     }
     if (!batched_[BatchOperation::kDestructArray].empty()) {
       result.destruct_req = std::make_unique<IfrtRequest>();
-      for (const auto& arr_handle : batched_[BatchOperation::kDestructArray]) {
+      for (const uint64_t arr_handle :
+           batched_[BatchOperation::kDestructArray]) {
         result.destruct_req->mutable_destruct_array_request()->add_array_handle(
-            arr_handle.handle);
+            arr_handle);
       }
       batched_[BatchOperation::kDestructArray].clear();
     }
+    if (!batched_[BatchOperation::kDestructLoadedExecutable].empty()) {
+      result.executable_destruct_req = std::make_unique<IfrtRequest>();
+      auto* req = result.executable_destruct_req
+                      ->mutable_loaded_executable_destruct_request();
+      for (const uint64_t executable_handle :
+           batched_[BatchOperation::kDestructLoadedExecutable]) {
+        req->add_loaded_executable_handles(executable_handle);
+      }
+      batched_[BatchOperation::kDestructLoadedExecutable].clear();
+    }
     return result;
   }
 
  private:
   absl::Mutex mu_;
-  std::array<std::vector<ArrayHandle>, BatchOperation::kSentinelDoNotUse>
+  std::array<std::vector<uint64_t>, BatchOperation::kSentinelDoNotUse>
       batched_ ABSL_GUARDED_BY(mu_);
 };
 
@@ -126,9 +138,7 @@ class RpcHelper::Batcher {
 
   // Enqueues an operation to be sent later. Guaranteed to not be blocked by the
   // underlying transport.
-  void Batch(BatchOperation op, ArrayHandle handle) {
-    batched_.Add(op, handle);
-  }
+  void Batch(BatchOperation op, uint64_t handle) { batched_.Add(op, handle); }
 
   // Asks the underlying transport to terminate.
   void Finish(absl::Status s) {
@@ -144,6 +154,10 @@ class RpcHelper::Batcher {
         LOG(WARNING) << "RpcHelper::Batch: Finish() called while there are "
                         "still batched destruct operations";
       }
+      if (remaining.executable_destruct_req != nullptr) {
+        LOG(WARNING) << "RpcHelper::Batch: Finish() called while there are "
+                        "still batched loaded executable destruct operations";
+      }
     }
     thread_pool_.reset();
     session_->Finish(s);
@@ -189,6 +203,15 @@ class RpcHelper::Batcher {
           .OnReady(
               absl::bind_front(HandleBatchResponse, session_, x_flow_helper));
     }
+    if (reqs.executable_destruct_req != nullptr) {
+      XFlowHelper x_flow_helper("batch_loaded_executable_destruct");
+      auto traceme = x_flow_helper.Span<XFlowHelper::kSend>();
+      VLOG(3) << "Sending req: "
+              << reqs.executable_destruct_req->ShortDebugString();
+      session_->Enqueue(std::move(reqs.executable_destruct_req))
+          .OnReady(
+              absl::bind_front(HandleBatchResponse, session_, x_flow_helper));
+    }
   }
 
   // Handles a response from the server of a previous batched operation;
@@ -213,6 +236,7 @@ class RpcHelper::Batcher {
           .OnReady(
               absl::bind_front(HandleBatchResponse, session, x_flow_helper));
     } else if (r.value()->has_destruct_array_response() ||
+               r.value()->has_loaded_executable_destruct_response() ||
                r.value()->has_check_future_response()) {
       x_flow_helper.InstantActivity<XFlowHelper::kRecv>();
     } else {
@@ -365,7 +389,11 @@ RpcHelper::RpcHelper(IfrtProxyVersion version,
 RpcHelper::~RpcHelper() { Disconnect(); }
 
 void RpcHelper::Batch(BatchOperation op, ArrayHandle handle) {
-  return batcher_->Batch(op, handle);
+  return batcher_->Batch(op, handle.handle);
+}
+
+void RpcHelper::Batch(BatchOperation op, uint64_t loaded_executable_handle) {
+  return batcher_->Batch(op, loaded_executable_handle);
 }
 
 void RpcHelper::Disconnect() {
@@ -71,7 +71,12 @@ class RpcHelper {
   using ResponseFuture = Future<std::shared_ptr<T>>;
 
   class Batcher;
-  enum BatchOperation { kDeleteArray, kDestructArray, kSentinelDoNotUse };
+  enum BatchOperation {
+    kDeleteArray,
+    kDestructArray,
+    kDestructLoadedExecutable,
+    kSentinelDoNotUse
+  };
 
   // Adds the given operation to an impending batch of operations and returns
   // immediately. The batch of operation is sent later (as a single logical
@@ -79,6 +84,10 @@ class RpcHelper {
   // from the wrapper functions below.
   void Batch(BatchOperation op, ArrayHandle handle);
 
+  // Same as above, for operations on loaded executables, i.e.,
+  // `kDestructLoadedExecutable`.
+  void Batch(BatchOperation op, uint64_t loaded_executable_handle);
+
   // Wrapper function for various logical RPCs defined in ifrt_service.proto.
   // Whenever the RPC finishes, `on_done` will be called with the result or the
   // return status. `on_done` can be called with various locks held and should
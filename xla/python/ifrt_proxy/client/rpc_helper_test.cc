@@ -14,6 +14,7 @@
 
 #include "xla/python/ifrt_proxy/client/rpc_helper.h"
 
+#include <cstdint>
 #include <memory>
 #include <utility>
 
@@ -117,6 +118,18 @@ TEST_F(RpcHelperTest, BatchedPeriodicFlush) {
               UnorderedElementsAre(2, 4, 8, 6));
 }
 
+TEST_F(RpcHelperTest, BatchedLoadedExecutableDestruct) {
+  PausePeriodicFlushes();
+  rpc_helper_->Batch(RpcHelper::kDestructLoadedExecutable, uint64_t{1});
+  rpc_helper_->Batch(RpcHelper::kDestructLoadedExecutable, uint64_t{2});
+  ResumePeriodicFlushes();
+
+  auto destruct_req = requests_.Pop();
+  EXPECT_THAT(destruct_req->loaded_executable_destruct_request()
+                  .loaded_executable_handles(),
+              UnorderedElementsAre(1, 2));
+}
+
 TEST_F(RpcHelperTest, BatchedNoPeriodicFlush) {
   PausePeriodicFlushes();
   rpc_helper_->Batch(RpcHelper::kDestructArray, ArrayHandle{1});
@@ -0,0 +1,146 @@
+/*
+ * Copyright 2025 The OpenXLA Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "xla/python/ifrt_proxy/common/shared_memory.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif  // defined(__linux__)
+
+namespace xla {
+namespace ifrt {
+namespace proxy {
+
+#if defined(__linux__)
+
+namespace {
+
+absl::Status ErrnoStatus(absl::string_view what, absl::string_view name) {
+  const int error = errno;
+  const std::string message =
+      absl::StrCat(what, " of shared memory ", name, " failed: ",
+                   std::strerror(error));
+  return error == ENOENT ? absl::NotFoundError(message)
+                         : absl::InternalError(message);
+}
+
+}  // namespace
+
+std::string HostBufferSharedMemoryName(uint64_t session_id, uint64_t handle) {
+  return absl::StrCat("/ifrt_proxy_", getpid(), "_", session_id, "_", handle);
+}
+
+absl::Status WriteSharedMemory(absl::string_view name, const absl::Cord& data) {
+  const std::string name_str(name);
+  const int fd =
+      shm_open(name_str.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+  if (fd < 0) {
+    return ErrnoStatus("Creation", name);
+  }
+  absl::Status status;
+  if (ftruncate(fd, data.size()) != 0) {
+    status = ErrnoStatus("Resizing", name);
+  } else if (!data.empty()) {
+    void* addr =
+        mmap(nullptr, data.size(), PROT_WRITE, MAP_SHARED, fd, /*offset=*/0);
+    if (addr == MAP_FAILED) {
+      status = ErrnoStatus("Mapping", name);
+    } else {
+      char* dst = static_cast<char*>(addr);
+      for (absl::string_view chunk : data.Chunks()) {
+        std::memcpy(dst, chunk.data(), chunk.size());
+        dst += chunk.size();
+      }
+      munmap(addr, data.size());
+    }
+  }
+  close(fd);
+  if (!status.ok()) {
+    shm_unlink(name_str.c_str());
+  }
+  return status;
+}
+
+absl::StatusOr<std::string> ReadSharedMemory(absl::string_view name,
+                                             int64_t size) {
+  const std::string name_str(name);
+  const int fd = shm_open(name_str.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    return ErrnoStatus("Opening", name);
+  }
+  absl::StatusOr<std::string> data;
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    data = ErrnoStatus("Inspecting", name);
+  } else if (st.st_size != size) {
+    data = absl::InvalidArgumentError(
+        absl::StrCat("Shared memory ", name, " has ", st.st_size,
+                     " bytes, but ", size, " bytes were expected"));
+  } else if (size == 0) {
+    data = std::string();
+  } else {
+    void* addr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, /*offset=*/0);
+    if (addr == MAP_FAILED) {
+      data = ErrnoStatus("Mapping", name);
+    } else {
+      data = std::string(static_cast<const char*>(addr), size);
+      munmap(addr, size);
+    }
+  }
+  close(fd);
+  return data;
+}
+
+void UnlinkSharedMemory(absl::string_view name) {
+  shm_unlink(std::string(name).c_str());
+}
+
+#else  // defined(__linux__)
+
+std::string HostBufferSharedMemoryName(uint64_t session_id, uint64_t handle) {
+  return absl::StrCat("/ifrt_proxy_", session_id, "_", handle);
+}
+
+absl::Status WriteSharedMemory(absl::string_view name, const absl::Cord& data) {
+  return absl::UnimplementedError("Shared memory is only supported on Linux");
+}
+
+absl::StatusOr<std::string> ReadSharedMemory(absl::string_view name,
+                                             int64_t size) {
+  return absl::UnimplementedError("Shared memory is only supported on Linux");
+}
+
+void UnlinkSharedMemory(absl::string_view name) {}
+
+#endif  // defined(__linux__)
+
+}  // namespace proxy
+}  // namespace ifrt
+}  // namespace xla
@@ -0,0 +1,59 @@
+/*
+ * Copyright 2025 The OpenXLA Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef XLA_PYTHON_IFRT_PROXY_COMMON_SHARED_MEMORY_H_
+#define XLA_PYTHON_IFRT_PROXY_COMMON_SHARED_MEMORY_H_
+
+#include <cstdint>
+#include <string>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/string_view.h"
+
+namespace xla {
+namespace ifrt {
+namespace proxy {
+
+// Helpers for passing host buffers between a client and a server on the same
+// host through POSIX shared memory objects, instead of streaming them over
+// gRPC. Only supported on Linux; elsewhere they return `UNIMPLEMENTED`.
+
+// Returns the name of the shared memory object that holds the host buffer
+// `handle` of the session `session_id`. The name is unique to the calling
+// process.
+std::string HostBufferSharedMemoryName(uint64_t session_id, uint64_t handle);
+
+// Creates the shared memory object `name` and copies `data` into it. Fails if
+// the object already exists.
+absl::Status WriteSharedMemory(absl::string_view name, const absl::Cord& data);
+
+// Returns a copy of the contents of the shared memory object `name`, which
+// must have `size` bytes. Returns `NOT_FOUND` if there is no such object, e.g.,
+// because it was created on another host.
+absl::StatusOr<std::string> ReadSharedMemory(absl::string_view name,
+                                             int64_t size);
+
+// Removes the shared memory object `name`. Its memory is released once no
+// process has it open.
+void UnlinkSharedMemory(absl::string_view name);
+
+}  // namespace proxy
+}  // namespace ifrt
+}  // namespace xla
+
+#endif  // XLA_PYTHON_IFRT_PROXY_COMMON_SHARED_MEMORY_H_
@@ -0,0 +1,70 @@
+/*
+ * Copyright 2025 The OpenXLA Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "xla/python/ifrt_proxy/common/shared_memory.h"
+
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "xla/tsl/platform/status_matchers.h"
+
+namespace xla {
+namespace ifrt {
+namespace proxy {
+
+namespace {
+
+using ::tsl::testing::IsOk;
+using ::tsl::testing::IsOkAndHolds;
+using ::tsl::testing::StatusIs;
+
+#if defined(__linux__)
+
+TEST(SharedMemoryTest, RoundTrip) {
+  const std::string name = HostBufferSharedMemoryName(/*session_id=*/1,
+                                                      /*handle=*/2);
+  absl::Cord data("hello ");
+  data.Append(std::string(4096, 'x'));
+  ASSERT_THAT(WriteSharedMemory(name, data), IsOk());
+  EXPECT_THAT(ReadSharedMemory(name, data.size()),
+              IsOkAndHolds(std::string(data)));
+  EXPECT_THAT(ReadSharedMemory(name, data.size() + 1),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  // Names are not reused while the object exists.
+  EXPECT_FALSE(WriteSharedMemory(name, data).ok());
+  UnlinkSharedMemory(name);
+  EXPECT_THAT(ReadSharedMemory(name, data.size()),
+              StatusIs(absl::StatusCode::kNotFound));
+}
+
+TEST(SharedMemoryTest, EmptyBuffer) {
+  const std::string name = HostBufferSharedMemoryName(/*session_id=*/1,
+                                                      /*handle=*/3);
+  ASSERT_THAT(WriteSharedMemory(name, absl::Cord()), IsOk());
+  EXPECT_THAT(ReadSharedMemory(name, 0), IsOkAndHolds(std::string()));
+  UnlinkSharedMemory(name);
+}
+
+#endif  // defined(__linux__)
+
+}  // namespace
+
+}  // namespace proxy
+}  // namespace ifrt
+}  // namespace xla
@@ -50,6 +50,14 @@ enum {
   // support.
   kMakeArraysFromHostBufferShards,
 
+  // kHostBufferSharedMemory allows a client on the same host as the server to
+  // pass host buffers through shared memory instead of streaming them.
+  kHostBufferSharedMemory,
+
+  // kBatchedLoadedExecutableDestruct allows destructing multiple loaded
+  // executables with a single LoadedExecutableDestructRequest.
+  kBatchedLoadedExecutableDestruct,
+
   // kSentiel is used to derive kCurrent below. Keep this as the last value of
   // the enum.
   kSentiel,
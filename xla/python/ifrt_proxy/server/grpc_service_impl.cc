@@ -24,6 +24,7 @@
 #include "absl/log/check.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
@@ -34,6 +35,7 @@
 #include "xla/python/ifrt/attribute_map.h"
 #include "xla/python/ifrt_proxy/common/grpc_ifrt_service.pb.h"
 #include "xla/python/ifrt_proxy/common/proto_util.h"
+#include "xla/python/ifrt_proxy/common/shared_memory.h"
 #include "xla/python/ifrt_proxy/server/host_buffer.h"
 #include "xla/python/ifrt_proxy/server/version.h"
 #include "tsl/profiler/lib/traceme.h"
@@ -161,17 +163,34 @@ namespace proxy {
                           "Unable to parse GrpcHostBufferStoreMetadata");
   }
 
-  VLOG(3) << "HostBufferStore starting to receive data "
-          << metadata.ShortDebugString();
   std::string data;
-  data.reserve(metadata.buffer_size());
+  if (!metadata.shared_memory_name().empty()) {
+    VLOG(3) << "HostBufferStore reading data from shared memory "
+            << metadata.ShortDebugString();
+    absl::StatusOr<std::string> shared_data = ReadSharedMemory(
+        metadata.shared_memory_name(), metadata.buffer_size());
+    if (!shared_data.ok()) {
+      // Tells the client to stream the data instead, e.g., because it is on
+      // another host.
+      LOG(WARNING) << "Unable to read host buffer from shared memory: "
+                   << shared_data.status();
+      return xla::ToGrpcStatus(absl::FailedPreconditionError(
+          absl::StrCat("Unable to read host buffer from shared memory: ",
+                       shared_data.status().message())));
+    }
+    data = *std::move(shared_data);
+  } else {
+    VLOG(3) << "HostBufferStore starting to receive data "
+            << metadata.ShortDebugString();
+    data.reserve(metadata.buffer_size());
 
-  GrpcHostBufferStoreRequest request;
-  while (stream->Read(&request)) {
-    data.append(request.data());
+    GrpcHostBufferStoreRequest request;
+    while (stream->Read(&request)) {
+      data.append(request.data());
+    }
+    VLOG(3) << "HostBufferStore received all data "
+            << metadata.ShortDebugString();
   }
-  VLOG(3) << "HostBufferStore received all data "
-          << metadata.ShortDebugString();
   if (data.size() != metadata.buffer_size()) {
     std::string error = absl::StrCat(
         "Potential data loss for host buffers: expected ",
@@ -34,6 +34,7 @@
 #include "xla/python/ifrt_proxy/client/grpc_host_buffer.h"
 #include "xla/python/ifrt_proxy/common/grpc_ifrt_service.grpc.pb.h"
 #include "xla/python/ifrt_proxy/common/ifrt_service.pb.h"
+#include "xla/python/ifrt_proxy/common/versions.h"
 #include "xla/python/ifrt_proxy/server/grpc_server.h"
 #include "xla/python/ifrt_proxy/server/host_buffer.h"
 #include "xla/python/ifrt_proxy/server/version.h"
@@ -141,6 +142,23 @@ TEST_P(GrpcIfrtServiceImplHostBufferTest, StoreAndLookupCord) {
   EXPECT_TRUE(impl_.Test_DeleteHostBufferStore(kSessionId));
 }
 
+TEST_P(GrpcIfrtServiceImplHostBufferTest, StoreWithoutSharedMemory) {
+  static constexpr uint64_t kSessionId = 1;
+
+  auto store = std::make_shared<HostBufferStore>();
+  ASSERT_TRUE(impl_.Test_InsertHostBufferStore(kSessionId, store));
+  IfrtProxyVersion version;
+  version.set_protocol_version(protocol_version::kHostBufferSharedMemory - 1);
+  GrpcClientHostBufferStore client(stub_, version, kSessionId);
+
+  constexpr uint64_t kHandle = 2;
+  const std::string data = GetTestData();
+  ASSERT_THAT(client.Store(kHandle, absl::Cord(data)).Await(), IsOk());
+  EXPECT_THAT(client.Lookup(kHandle).Await(), IsOkAndHolds(data));
+
+  EXPECT_TRUE(impl_.Test_DeleteHostBufferStore(kSessionId));
+}
+
 TEST_P(GrpcIfrtServiceImplHostBufferTest, Lookup) {
   static constexpr uint64_t kSessionId = 1;
 
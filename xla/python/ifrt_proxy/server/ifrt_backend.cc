@@ -1744,20 +1744,34 @@ absl::StatusOr<BackendInterface::Response>
 IfrtBackend::HandleLoadedExecutableDestructRequest(
     std::unique_ptr<IfrtRequest> request) {
   const auto& destruct = request->loaded_executable_destruct_request();
+  std::vector<uint64_t> handles(destruct.loaded_executable_handles().begin(),
+                                destruct.loaded_executable_handles().end());
+  if (destruct.loaded_executable_handle() != 0 || handles.empty()) {
+    handles.push_back(destruct.loaded_executable_handle());
+  }
 
-  std::shared_ptr<LoadedExecutableWithInfo> executable;
+  std::vector<std::shared_ptr<LoadedExecutableWithInfo>> executables;
+  std::vector<uint64_t> missing_handles;
   {
     absl::MutexLock lock(&executables_mutex_);
-    const auto it = executables_.find(destruct.loaded_executable_handle());
-    if (it == executables_.end()) {
-      return absl::NotFoundError(
-          absl::StrCat("Unknown loaded executable handle: ",
-                       destruct.loaded_executable_handle()));
+    for (const uint64_t handle : handles) {
+      const auto it = executables_.find(handle);
+      if (it == executables_.end()) {
+        missing_handles.push_back(handle);
+        continue;
+      }
+      executables.push_back(std::move(it->second));
+      executables_.erase(it);
     }
-    executable = std::move(it->second);
-    executables_.erase(it);
   }
-  executable.reset();
+  // Destroy the executables outside of `executables_mutex_`.
+  executables.clear();
+
+  if (!missing_handles.empty()) {
+    return absl::NotFoundError(
+        absl::StrCat("Unknown loaded executable handle(s): ",
+                     absl::StrJoin(missing_handles, ",")));
+  }
 
   // `RemoteLoadedHostCallback`'s request queue is closed when the host callback
   // objects are destroyed by the underlying IFRT implementation when there are
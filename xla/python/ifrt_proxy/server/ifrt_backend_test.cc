@@ -1604,6 +1604,40 @@ TEST_P(IfrtBackendHandlerTest, LoadedExecutableDestruct) {
   }
 }
 
+TEST_P(IfrtBackendHandlerTest, LoadedExecutableDestructBatched) {
+  std::vector<uint64_t> handles;
+  for (int i = 0; i < 2; ++i) {
+    TF_ASSERT_OK_AND_ASSIGN(
+        CompileResponse response,
+        CompileTestLoadedExecutable(std::make_unique<MockLoadedExecutable>()));
+    handles.push_back(response.loaded_executable_handle());
+  }
+
+  {
+    auto request = NewIfrtRequest(NewOpId());
+    LoadedExecutableDestructRequest* destruct_request =
+        request->mutable_loaded_executable_destruct_request();
+    for (const uint64_t handle : handles) {
+      destruct_request->add_loaded_executable_handles(handle);
+    }
+
+    TF_ASSERT_OK_AND_ASSIGN(std::shared_ptr<IfrtResponse> response,
+                            CallBackend(std::move(request)));
+    ASSERT_TRUE(response->has_loaded_executable_destruct_response());
+  }
+
+  for (const uint64_t handle : handles) {
+    auto request = NewIfrtRequest(NewOpId());
+    LoadedExecutableDestructRequest* destruct_request =
+        request->mutable_loaded_executable_destruct_request();
+    destruct_request->set_loaded_executable_handle(handle);
+
+    EXPECT_THAT(CallBackend(std::move(request)),
+                StatusIs(absl::StatusCode::kNotFound,
+                         HasSubstr("Unknown loaded executable handle")));
+  }
+}
+
 TEST_P(IfrtBackendHandlerTest, LoadedHostCallbackExecute) {
   // Build a remote host callback with one F32 argument and one F32 result.
   std::vector<xla::HostCallbackArgInfo> hcb_args = {{
@@ -637,19 +637,25 @@ class SocketBulkTransportFactory : public BulkTransportFactory {
                                  addrs = addrs_](
                                     const SocketTransferEstablishBulkTransport&
                                         remote_bulk_transport_info) {
+      CHECK_EQ(remote_bulk_transport_info.bulk_transport_address_size(),
+               addrs.size());
+      const size_t connections_per_address = conns.size() / addrs.size();
       uint64_t next_id = remote_bulk_transport_info.bulk_transport_uuid(0);
-      for (uint64_t i = 0;
-           i < remote_bulk_transport_info.bulk_transport_address_size(); ++i) {
+      for (uint64_t i = 0; i < conns.size(); ++i) {
         uint64_t uuid = next_id + i;
+        // Connections over the same address are consecutive.
+        const size_t addr_index = i / connections_per_address;
         SocketAddress addr =
             SocketAddress::Parse(
-                remote_bulk_transport_info.bulk_transport_address(i))
+                remote_bulk_transport_info.bulk_transport_address(addr_index))
                 .value();
-        int cfd =
-            socket(addrs[i].address().sa_family, SOCK_STREAM | SOCK_CLOEXEC, 0);
-        CHECK_EQ(bind(cfd, reinterpret_cast<const struct sockaddr*>(&addrs[i]),
-                      sizeof(SocketAddress)),
-                 0)
+        const SocketAddress& local_addr = addrs[addr_index];
+        int cfd = socket(local_addr.address().sa_family,
+                         SOCK_STREAM | SOCK_CLOEXEC, 0);
+        CHECK_EQ(
+            bind(cfd, reinterpret_cast<const struct sockaddr*>(&local_addr),
+                 sizeof(SocketAddress)),
+            0)
             << strerror(errno) << " " << errno;
         CHECK_EQ(connect(cfd, reinterpret_cast<const struct sockaddr*>(&addr),
                          sizeof(addr)),
@@ -756,8 +762,15 @@ class SocketBulkTransportFactory : public BulkTransportFactory {
 absl::StatusOr<std::shared_ptr<BulkTransportFactory>>
 CreateSocketBulkTransportFactory(std::vector<SocketAddress> addrs,
                                  std::optional<SlabAllocator> allocator,
-                                 SlabAllocator unpinned_allocator) {
-  size_t num_connections = addrs.size();
+                                 SlabAllocator unpinned_allocator,
+                                 size_t connections_per_address) {
+  if (addrs.empty() || connections_per_address == 0) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Socket bulk transport needs at least one connection: ",
+                     addrs.size(), " addresses with ", connections_per_address,
+                     " connections per address"));
+  }
+  size_t num_connections = addrs.size() * connections_per_address;
 
   std::vector<std::shared_ptr<RecvThreadState>> thread_states;
   std::vector<std::shared_ptr<SharedSendWorkQueue>> send_work_queues;
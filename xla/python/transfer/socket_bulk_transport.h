@@ -181,10 +181,18 @@ class RecvThreadState {
 
 // Create a socket transport factory that allocates out of allocator and
 // unpinned_allocator and communicates over all addrs in parallel.
+//
+// Each bulk transport opens connections_per_address connections over each of
+// addrs, each with its own send and recv threads, and stripes messages across
+// all of them. A single TCP stream is usually limited by the send and recv
+// threads well below line rate, so more connections per address can
+// saturate faster NICs. Both ends must use the same number of addrs and the
+// same connections_per_address.
 absl::StatusOr<std::shared_ptr<BulkTransportFactory>>
 CreateSocketBulkTransportFactory(std::vector<SocketAddress> addrs,
                                  std::optional<SlabAllocator> allocator,
-                                 SlabAllocator unpinned_allocator);
+                                 SlabAllocator unpinned_allocator,
+                                 size_t connections_per_address = 1);
 
 }  // namespace aux
 
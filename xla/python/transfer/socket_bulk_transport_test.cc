@@ -22,6 +22,7 @@ limitations under the License.
 #include <cstring>
 #include <deque>
 #include <memory>
+#include <optional>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -154,7 +155,9 @@ TEST(SendQueue, SendAndRecvQueuesArtificialLimit) {
   }
 }
 
-TEST(SocketBulkTransportFactoryTest, SendAndRecvWithFactory) {
+using SocketBulkTransportFactoryTest = ::testing::TestWithParam<size_t>;
+
+TEST_P(SocketBulkTransportFactoryTest, SendAndRecvWithFactory) {
   size_t packet_size = 1024 * 8;
   SlabAllocator allocator(AllocateNetworkPinnedMemory(packet_size * 4).value(),
                           packet_size);
@@ -163,12 +166,13 @@ TEST(SocketBulkTransportFactoryTest, SendAndRecvWithFactory) {
 
   SocketAddress addr;
   SocketAddress addrv4 = SocketAddress::Parse("0.0.0.0:0").value();
-  auto status_or =
-      CreateSocketBulkTransportFactory({addr, addrv4}, allocator, uallocator);
+  const size_t connections_per_address = GetParam();
+  auto status_or = CreateSocketBulkTransportFactory(
+      {addr, addrv4}, allocator, uallocator, connections_per_address);
   ASSERT_TRUE(status_or.ok()) << status_or.status();
   auto factory = status_or.value();
-  status_or =
-      CreateSocketBulkTransportFactory({addr, addrv4}, allocator, uallocator);
+  status_or = CreateSocketBulkTransportFactory(
+      {addr, addrv4}, allocator, uallocator, connections_per_address);
   ASSERT_TRUE(status_or.ok()) << status_or.status();
   auto factory2 = status_or.value();
 
@@ -246,6 +250,18 @@ TEST(SocketBulkTransportFactoryTest, SendAndRecvWithFactory) {
   }
 }
 
+INSTANTIATE_TEST_SUITE_P(ConnectionsPerAddress,
+                         SocketBulkTransportFactoryTest,
+                         ::testing::Values(1, 3));
+
+TEST(SocketBulkTransportFactoryCreateTest, RejectsNoConnections) {
+  SlabAllocator uallocator(AllocateAlignedMemory(1024 * 8).value(), 1024);
+  EXPECT_FALSE(CreateSocketBulkTransportFactory({SocketAddress()}, std::nullopt,
+                                                uallocator,
+                                                /*connections_per_address=*/0)
+                   .ok());
+}
+
 void HandleAckAndExpectDone(ZeroCopySendAckTable& table, uint32_t ack_id,
                             size_t exp_seal_id, std::vector<size_t>& ack_list) {
   EXPECT_EQ(ack_list.size(), 0);
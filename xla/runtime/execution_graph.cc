@@ -15,21 +15,26 @@ limitations under the License.
 
 #include "xla/runtime/execution_graph.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <limits>
 #include <tuple>
 #include <utility>
 #include <vector>
 
 #include "absl/algorithm/container.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/log/check.h"
 #include "absl/log/log.h"
+#include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_format.h"
 #include "absl/types/span.h"
 #include "xla/runtime/buffer_use.h"
 #include "xla/runtime/resource_use.h"
+#include "xla/service/buffer_assignment.h"
 #include "xla/util.h"
 
 namespace xla {
@@ -60,10 +65,25 @@ ExecutionGraph::ExecutionGraph(NodesEdges nodes_in_edges,
     is_sequential_ &= (absl::c_count(nodes_defs_[i].in_edges, i - 1) != 0);
   }
 
+  // Out-edges always point to nodes with larger ids, so by iterating nodes in
+  // reverse order we visit all successors before the node itself.
+  std::vector<int64_t> path_lengths(nodes_defs_.size());
+  for (int64_t i = nodes_defs_.size() - 1; i >= 0; --i) {
+    int64_t max_out_length = 0;
+    for (NodeId out_id : nodes_defs_[i].out_edges) {
+      max_out_length = std::max(max_out_length, path_lengths[out_id]);
+    }
+    path_lengths[i] = 1 + max_out_length;
+    critical_path_length_ = std::max(critical_path_length_, path_lengths[i]);
+    max_fan_out_ = std::max(max_fan_out_, nodes_defs_[i].out_edges.size());
+  }
+
   VLOG(2) << absl::StreamFormat(
       "Constructed execution graph with %d nodes: #source_nodes=%d "
-      "#sink_nodes=%d, is_sequential=%v",
-      nodes_defs_.size(), source_.size(), sink_.size(), is_sequential_);
+      "#sink_nodes=%d, is_sequential=%v, critical_path_length=%d, "
+      "max_fan_out=%d",
+      nodes_defs_.size(), source_.size(), sink_.size(), is_sequential_,
+      critical_path_length_, max_fan_out_);
 
   // Sanity check that all vectors are empty or all vectors are non-empty.
   DCHECK((!source_.empty() && !sink_.empty()) ||
@@ -79,31 +99,7 @@ absl::StatusOr<ExecutionGraph> ExecutionGraph::Create(
   }
 
   std::vector<NodeDefBuilder> builders(operations.size());
-
-  std::vector<BufferUse::ReadWriteSet> buffer_rwsets(operations.size());
-  std::vector<ResourceUse::ReadWriteSet> resource_rwsets(operations.size());
-
-  // TODO(ezhulenev): This is very inefficient O(N^2) complexity algorithm
-  // that will create a lot of redundant edges. We can do much better by
-  // stopping traversal once we prove that we already have dependencies on the
-  // most recent updates that touch the whole buffer slice.
-
-  for (NodeId i = 0; i < operations.size(); ++i) {
-    builders[i].id = i;
-
-    const Operation* op = operations[i];
-    buffer_rwsets[i].AddAll(op->BufferUses());
-    resource_rwsets[i].AddAll(op->ResourceUses());
-
-    for (NodeId j = 0; j < i; ++j) {
-      // Check if node `i` must be executed after node `j`.
-      if (buffer_rwsets[j].HasConflicts(buffer_rwsets[i]) ||
-          resource_rwsets[j].HasConflicts(resource_rwsets[i])) {
-        builders[j].out_edges.push_back(i);
-        builders[i].in_edges.push_back(j);
-      }
-    }
-  }
+  AddConflictEdges(operations, absl::MakeSpan(builders));
 
   // Verify that both in-edges and out-edges are sorted in ascending order as we
   // use this property later.
@@ -124,6 +120,147 @@ absl::StatusOr<ExecutionGraph> ExecutionGraph::Create(
                         std::move(nodes_defs));
 }
 
+void ExecutionGraph::AddConflictEdges(
+    absl::Span<const Operation* const> operations,
+    absl::Span<NodeDefBuilder> builders) {
+  // A buffer slice access that later operations might conflict with.
+  struct BufferAccess {
+    BufferAllocation::Slice slice;
+    BufferUse::MemoryAccess access;
+    NodeId id;
+  };
+
+  // The accesses to a resource since (and including) its last write.
+  struct ResourceAccesses {
+    NodeId last_write = kInvalidNodeId;
+    std::vector<NodeId> reads;
+  };
+
+  // Instead of checking every pair of operations for conflicts, we keep the
+  // live accesses of each buffer allocation and resource. An access is no
+  // longer live once a later write covers its slice: every operation that
+  // conflicts with the access also conflicts with the write, which in turn
+  // depends on the access. This keeps the work per operation proportional to
+  // the number of live accesses, instead of to the number of operations.
+  absl::flat_hash_map<BufferAllocation::Index, std::vector<BufferAccess>>
+      buffer_accesses;
+  absl::flat_hash_map<const Resource*, ResourceAccesses> resource_accesses;
+
+  // Returns true if `slice` must not be accessed concurrently with `other`.
+  auto conflicts = [](const BufferAllocation::Slice& slice,
+                      const BufferAllocation::Slice& other) {
+    return slice == other || slice.OverlapsWith(other);
+  };
+
+  // Returns true if `slice` covers a non-empty `other` slice.
+  auto covers = [](const BufferAllocation::Slice& slice,
+                   const BufferAllocation::Slice& other) {
+    return other.size() > 0 && slice.index() == other.index() &&
+           slice.offset() <= other.offset() &&
+           other.offset() + other.size() <= slice.offset() + slice.size();
+  };
+
+  std::vector<NodeId> in_edges;
+
+  for (NodeId i = 0; i < operations.size(); ++i) {
+    builders[i].id = i;
+    const Operation* op = operations[i];
+
+    // Find all nodes that node `i` must be executed after.
+    in_edges.clear();
+    for (const BufferUse& use : op->BufferUses()) {
+      auto it = buffer_accesses.find(use.slice().index());
+      if (it == buffer_accesses.end()) continue;
+      for (const BufferAccess& access : it->second) {
+        if ((use.access() == BufferUse::kWrite ||
+             access.access == BufferUse::kWrite) &&
+            conflicts(use.slice(), access.slice)) {
+          in_edges.push_back(access.id);
+        }
+      }
+    }
+    for (const ResourceUse& use : op->ResourceUses()) {
+      auto it = resource_accesses.find(use.resource().get());
+      if (it == resource_accesses.end()) continue;
+      if (it->second.last_write != kInvalidNodeId) {
+        in_edges.push_back(it->second.last_write);
+      }
+      if (use.access() == ResourceUse::kWrite) {
+        absl::c_copy(it->second.reads, std::back_inserter(in_edges));
+      }
+    }
+
+    // Node `i` conflicts with itself if it reads and writes the same slice.
+    in_edges.erase(std::remove(in_edges.begin(), in_edges.end(), i),
+                   in_edges.end());
+    absl::c_sort(in_edges);
+    in_edges.erase(std::unique(in_edges.begin(), in_edges.end()),
+                   in_edges.end());
+
+    // Nodes are added in increasing order, which keeps out-edges sorted.
+    for (NodeId j : in_edges) {
+      builders[j].out_edges.push_back(i);
+    }
+    builders[i].in_edges.assign(in_edges.begin(), in_edges.end());
+
+    // Record the accesses of node `i` for the following nodes.
+    for (const BufferUse& use : op->BufferUses()) {
+      std::vector<BufferAccess>& accesses =
+          buffer_accesses[use.slice().index()];
+      if (use.access() == BufferUse::kWrite) {
+        accesses.erase(
+            std::remove_if(accesses.begin(), accesses.end(),
+                           [&](const BufferAccess& access) {
+                             return covers(use.slice(), access.slice);
+                           }),
+            accesses.end());
+      }
+      accesses.push_back(BufferAccess{use.slice(), use.access(), i});
+    }
+    for (const ResourceUse& use : op->ResourceUses()) {
+      ResourceAccesses& accesses = resource_accesses[use.resource().get()];
+      if (use.access() == ResourceUse::kWrite) {
+        accesses.last_write = i;
+        accesses.reads.clear();
+      } else {
+        accesses.reads.push_back(i);
+      }
+    }
+  }
+}
+
+absl::Status ExecutionGraph::UpdatePrioritiesWithCriticalPath(
+    absl::Span<const int64_t> costs) {
+  if (costs.size() != nodes_defs_.size()) {
+    return InvalidArgument(
+        "Number of costs (%d) must match the number of nodes (%d)",
+        costs.size(), nodes_defs_.size());
+  }
+
+  if (absl::c_any_of(costs, [](int64_t cost) { return cost < 0; })) {
+    return InvalidArgument("Node costs must be non-negative");
+  }
+
+  // Out-edges always point to nodes with larger ids, so by iterating nodes in
+  // reverse order we visit all successors before the node itself.
+  for (int64_t i = nodes_defs_.size() - 1; i >= 0; --i) {
+    int64_t max_out_priority = 0;
+    for (NodeId out_id : nodes_defs_[i].out_edges) {
+      max_out_priority =
+          std::max(max_out_priority, nodes_defs_[out_id].priority);
+    }
+    nodes_defs_[i].priority = costs[i] + max_out_priority;
+  }
+
+  critical_path_length_ = 0;
+  for (NodeId id : source_) {
+    critical_path_length_ =
+        std::max(critical_path_length_, nodes_defs_[id].priority);
+  }
+
+  return absl::OkStatus();
+}
+
 std::tuple<ExecutionGraph::NodesEdges, ExecutionGraph::NodesEdges,
            std::vector<ExecutionGraph::NodeDef>>
 ExecutionGraph::CreateNodeDefs(std::vector<NodeDefBuilder> builders) {
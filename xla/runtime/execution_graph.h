@@ -25,6 +25,7 @@ limitations under the License.
 
 #include "absl/container/inlined_vector.h"
 #include "absl/log/check.h"
+#include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/types/span.h"
 #include "xla/runtime/buffer_use.h"
@@ -132,6 +133,23 @@ class ExecutionGraph {
 
   bool is_sequential() const { return is_sequential_; }
 
+  // Returns the length of the longest path from a source node to a sink node.
+  // By default the length is the number of nodes on the path, after
+  // `UpdatePrioritiesWithCriticalPath` it is the sum of their costs.
+  int64_t critical_path_length() const { return critical_path_length_; }
+
+  // Returns the largest number of out-edges of a node, which is the most nodes
+  // that can become ready for execution at once when a node completes.
+  size_t max_fan_out() const { return max_fan_out_; }
+
+  // Updates nodes priorities to the length of the critical path (bottom level)
+  // from each node to a sink node, where the length of the path is the sum of
+  // costs of all nodes on the path, including the node itself. By executing
+  // nodes on the longest chains of dependent operations first, we minimize the
+  // end-to-end latency of the execution graph. Costs must be non-negative.
+  absl::Status UpdatePrioritiesWithCriticalPath(
+      absl::Span<const int64_t> costs);
+
  private:
   // Constructs an execution graph from a sequence of operations.
   static absl::StatusOr<ExecutionGraph> Create(
@@ -163,6 +181,13 @@ class ExecutionGraph {
   // that out and in-edges are sorted and use binary search on a critical path.
   static int64_t EraseEdge(NodeDefBuilder& from, NodeDefBuilder& to);
 
+  // Adds edges to `builders` for all buffer and resource conflicts between
+  // `operations`. Edges that are implied by other edges through a write that
+  // covers the conflicting buffer slice might be skipped, which doesn't change
+  // the transitive reduction of the graph.
+  static void AddConflictEdges(absl::Span<const Operation* const> operations,
+                               absl::Span<NodeDefBuilder> builders);
+
   // Runs a transitive reduction on the NodeDefBuilder graph to remove redundant
   // edges, and updates nodes priorities. Returns the number of removed edges.
   //
@@ -182,6 +207,9 @@ class ExecutionGraph {
   // this property of the execution graph to skip expensive async execution and
   // simply run all operations one by one.
   bool is_sequential_;
+
+  int64_t critical_path_length_ = 0;
+  size_t max_fan_out_ = 0;
 };
 
 }  // namespace xla
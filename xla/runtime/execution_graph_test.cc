@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "xla/runtime/execution_graph.h"
 
+#include <cstdint>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -23,6 +24,7 @@ limitations under the License.
 #include "xla/runtime/buffer_use.h"
 #include "xla/runtime/resource_use.h"
 #include "xla/service/buffer_assignment.h"
+#include "xla/tsl/lib/core/status_test_util.h"
 #include "xla/tsl/platform/statusor.h"
 #include "xla/tsl/platform/test.h"
 
@@ -167,5 +169,114 @@ TEST(ExecutionGraphTest, TransitiveReduction) {
   EXPECT_EQ(execution_graph.priority(2), 0);
 }
 
+TEST(ExecutionGraphTest, PartiallyOverlappingWrites) {
+  BufferAllocation alloc(/*index=*/0, /*size=*/80, /*color=*/0);
+
+  BufferAllocation::Slice slice0(&alloc, /*offset=*/0, /*size=*/40);
+  BufferAllocation::Slice slice1(&alloc, /*offset=*/20, /*size=*/40);
+  BufferAllocation::Slice slice2(&alloc, /*offset=*/40, /*size=*/40);
+  BufferAllocation::Slice slice3(&alloc, /*offset=*/0, /*size=*/80);
+
+  // Node 2 reads a slice that partially overlaps the writes of nodes 0 and 1,
+  // so it depends on both of them.
+  std::vector<Operation> operations;
+  operations.push_back(Operation({BufferUse::Write(slice0)}));
+  operations.push_back(Operation({BufferUse::Write(slice2)}));
+  operations.push_back(Operation({BufferUse::Read(slice1)}));
+  operations.push_back(Operation({BufferUse::Write(slice3)}));
+
+  TF_ASSERT_OK_AND_ASSIGN(ExecutionGraph execution_graph,
+                          ExecutionGraph::Create<Operation>(operations));
+
+  EXPECT_THAT(execution_graph.source(), ElementsAre(0, 1));
+  EXPECT_THAT(execution_graph.sink(), ElementsAre(3));
+
+  EXPECT_THAT(execution_graph.in_edges(2), ElementsAre(0, 1));
+  EXPECT_THAT(execution_graph.in_edges(3), ElementsAre(2));
+
+  EXPECT_EQ(execution_graph.critical_path_length(), 3);
+  EXPECT_EQ(execution_graph.max_fan_out(), 1);
+}
+
+TEST(ExecutionGraphTest, ReadersFanOut) {
+  BufferAllocation alloc(/*index=*/0, /*size=*/80, /*color=*/0);
+  BufferAllocation::Slice slice(&alloc, /*offset=*/0, /*size=*/80);
+
+  // One writer followed by independent readers, and a writer that must wait
+  // for all of them.
+  std::vector<Operation> operations;
+  operations.push_back(Operation({BufferUse::Write(slice)}));
+  operations.push_back(Operation({BufferUse::Read(slice)}));
+  operations.push_back(Operation({BufferUse::Read(slice)}));
+  operations.push_back(Operation({BufferUse::Read(slice)}));
+  operations.push_back(Operation({BufferUse::Write(slice)}));
+  operations.push_back(Operation({BufferUse::Read(slice)}));
+
+  TF_ASSERT_OK_AND_ASSIGN(ExecutionGraph execution_graph,
+                          ExecutionGraph::Create<Operation>(operations));
+
+  EXPECT_THAT(execution_graph.out_edges(0), ElementsAre(1, 2, 3));
+  EXPECT_THAT(execution_graph.in_edges(4), ElementsAre(1, 2, 3));
+  EXPECT_THAT(execution_graph.in_edges(5), ElementsAre(4));
+
+  EXPECT_EQ(execution_graph.critical_path_length(), 4);
+  EXPECT_EQ(execution_graph.max_fan_out(), 3);
+}
+
+TEST(ExecutionGraphTest, LongSequence) {
+  BufferAllocation alloc(/*index=*/0, /*size=*/80, /*color=*/0);
+  BufferAllocation::Slice slice(&alloc, /*offset=*/0, /*size=*/40);
+
+  std::vector<Operation> operations;
+  for (int i = 0; i < 10000; ++i) {
+    operations.push_back(
+        Operation({BufferUse::Read(slice), BufferUse::Write(slice)}));
+  }
+
+  TF_ASSERT_OK_AND_ASSIGN(ExecutionGraph execution_graph,
+                          ExecutionGraph::Create<Operation>(operations));
+
+  EXPECT_TRUE(execution_graph.is_sequential());
+  EXPECT_EQ(execution_graph.critical_path_length(), 10000);
+  EXPECT_EQ(execution_graph.max_fan_out(), 1);
+  EXPECT_THAT(execution_graph.in_edges(9999), ElementsAre(9998));
+}
+
+TEST(ExecutionGraphTest, CriticalPathPriorities) {
+  BufferAllocation alloc(/*index=*/0, /*size=*/80, /*color=*/0);
+
+  BufferAllocation::Slice slice0(&alloc, /*offset=*/0, /*size=*/40);
+  BufferAllocation::Slice slice1(&alloc, /*offset=*/40, /*size=*/40);
+  BufferAllocation::Slice slice2(&alloc, /*offset=*/20, /*size=*/40);
+
+  // Two independent chains: 0 -> 2 and 1 -> 2.
+  std::vector<Operation> operations;
+  operations.push_back(
+      Operation({BufferUse::Read(slice0), BufferUse::Write(slice0)}));
+  operations.push_back(
+      Operation({BufferUse::Read(slice1), BufferUse::Write(slice1)}));
+  operations.push_back(
+      Operation({BufferUse::Read(slice2), BufferUse::Write(slice2)}));
+
+  TF_ASSERT_OK_AND_ASSIGN(ExecutionGraph execution_graph,
+                          ExecutionGraph::Create<Operation>(operations));
+
+  // Number of reachable nodes doesn't distinguish nodes 0 and 1.
+  EXPECT_EQ(execution_graph.priority(0), 1);
+  EXPECT_EQ(execution_graph.priority(1), 1);
+
+  std::vector<int64_t> costs = {10, 100, 5};
+  TF_ASSERT_OK(execution_graph.UpdatePrioritiesWithCriticalPath(costs));
+
+  EXPECT_EQ(execution_graph.priority(0), 15);
+  EXPECT_EQ(execution_graph.priority(1), 105);
+  EXPECT_EQ(execution_graph.priority(2), 5);
+  EXPECT_EQ(execution_graph.critical_path_length(), 105);
+
+  std::vector<int64_t> wrong_size_costs = {1, 2};
+  EXPECT_FALSE(
+      execution_graph.UpdatePrioritiesWithCriticalPath(wrong_size_costs).ok());
+}
+
 }  // namespace
 }  // namespace xla
@@ -0,0 +1,256 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+
+#include "xla/runtime/large_hlo_snapshot_serialization/large_constants.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_casting_utils.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_instructions.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/literal.h"
+#include "xla/service/hlo.pb.h"
+#include "xla/service/hlo_module_config.h"
+#include "xla/shape.h"
+#include "xla/shape_util.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/errors.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/util.h"
+#include "xla/xla.pb.h"
+#include "tsl/platform/protobuf.h"
+
+namespace xla {
+
+constexpr int kMaxSupportedModuleWithLargeConstantsVersion = 0;
+
+namespace {
+
+// Writes `size` bytes, in chunks that fit the int sizes of the coded stream.
+void WriteRaw(const char* data, int64_t size,
+              tsl::protobuf::io::CodedOutputStream* output_stream) {
+  constexpr int64_t kMaxChunkBytes = int64_t{1} << 30;
+  while (size > 0) {
+    const int chunk = static_cast<int>(std::min(size, kMaxChunkBytes));
+    output_stream->WriteRaw(data, chunk);
+    data += chunk;
+    size -= chunk;
+  }
+}
+
+void WritePaddingTo(int64_t offset,
+                    tsl::protobuf::io::CodedOutputStream* output_stream) {
+  const int64_t padding = offset - output_stream->ByteCount();
+  if (padding > 0) {
+    output_stream->WriteString(std::string(padding, '\0'));
+  }
+}
+
+}  // namespace
+
+absl::Status SerializeHloModuleWithLargeConstants(
+    const HloModule& module,
+    tsl::protobuf::io::ZeroCopyOutputStream* zero_copy_output_stream,
+    int64_t min_large_constant_bytes) {
+  absl::flat_hash_map<absl::string_view, const HloConstantInstruction*>
+      large_constants;
+  for (const HloComputation* computation : module.computations()) {
+    for (const HloInstruction* instruction : computation->instructions()) {
+      if (instruction->opcode() != HloOpcode::kConstant) {
+        continue;
+      }
+      const auto* constant = Cast<HloConstantInstruction>(instruction);
+      if (constant->HasLiteral() && constant->literal().shape().IsArray() &&
+          constant->literal().shape().is_static() &&
+          constant->literal().size_bytes() >= min_large_constant_bytes) {
+        large_constants[constant->name()] = constant;
+      }
+    }
+  }
+
+  // Prepare metadata
+  HloModuleWithLargeConstants metadata_proto;
+  *metadata_proto.mutable_hlo_module() = module.ToProto();
+  std::vector<const HloConstantInstruction*> constants;
+  uint64_t offset = 0;
+  for (HloComputationProto& computation :
+       *metadata_proto.mutable_hlo_module()->mutable_computations()) {
+    for (HloInstructionProto& instruction :
+         *computation.mutable_instructions()) {
+      auto it = large_constants.find(instruction.name());
+      if (it == large_constants.end()) {
+        continue;
+      }
+      instruction.clear_literal();
+      const Literal& literal = it->second->literal();
+      HloModuleWithLargeConstants::ConstantDescriptor* descriptor =
+          metadata_proto.add_constants();
+      descriptor->set_instruction_name(instruction.name());
+      *descriptor->mutable_shape() = literal.shape().ToProto();
+      descriptor->set_offset(offset);
+      descriptor->set_size_bytes(literal.size_bytes());
+      offset = RoundUpTo<uint64_t>(offset + literal.size_bytes(),
+                                   kLargeConstantAlignment);
+      constants.push_back(it->second);
+    }
+  }
+
+  // Serialize metadata
+  tsl::protobuf::io::CodedOutputStream output_stream(zero_copy_output_stream);
+  tsl::protobuf::util::SerializeDelimitedToCodedStream(metadata_proto,
+                                                       &output_stream);
+  const int64_t data_start =
+      RoundUpTo<int64_t>(output_stream.ByteCount(), kLargeConstantAlignment);
+
+  // Serialize constants
+  for (int i = 0; i < constants.size(); ++i) {
+    WritePaddingTo(data_start + metadata_proto.constants(i).offset(),
+                   &output_stream);
+    const Literal& literal = constants[i]->literal();
+    WriteRaw(static_cast<const char*>(literal.untyped_data()),
+             literal.size_bytes(), &output_stream);
+  }
+  output_stream.Trim();
+  if (output_stream.HadError()) {
+    return absl::InternalError("Failed to serialize module");
+  }
+  return absl::OkStatus();
+}
+
+namespace {
+
+// Deserializes the module in `serialized`. If `owner` is not null, it keeps
+// `serialized` alive and the large constants refer to it instead of copying
+// it.
+absl::StatusOr<std::unique_ptr<HloModule>> DeserializeModule(
+    absl::string_view serialized, std::shared_ptr<const void> owner,
+    const DebugOptions& debug_options) {
+  // Deserialize metadata. It does not contain the large constants, so it fits
+  // in the int sizes of the coded stream.
+  HloModuleWithLargeConstants metadata;
+  int64_t data_start;
+  {
+    tsl::protobuf::io::ArrayInputStream array_stream(
+        serialized.data(),
+        static_cast<int>(std::min<size_t>(serialized.size(),
+                                          std::numeric_limits<int>::max())));
+    tsl::protobuf::io::CodedInputStream input_stream(&array_stream);
+    if (!tsl::protobuf::util::ParseDelimitedFromCodedStream(
+            &metadata, &input_stream,
+            /*clean_eof=*/nullptr)) {
+      return absl::InternalError("Failed to deserialize metadata");
+    }
+    data_start = RoundUpTo<int64_t>(input_stream.CurrentPosition(),
+                                    kLargeConstantAlignment);
+  }
+  if (metadata.version() > kMaxSupportedModuleWithLargeConstantsVersion) {
+    return absl::InternalError(
+        absl::StrCat("Unsupported module version: ", metadata.version()));
+  }
+
+  TF_ASSIGN_OR_RETURN(HloModuleConfig config,
+                      HloModule::CreateModuleConfigFromProto(
+                          metadata.hlo_module(), debug_options));
+  TF_ASSIGN_OR_RETURN(
+      std::unique_ptr<HloModule> module,
+      HloModule::CreateFromProto(metadata.hlo_module(), config));
+
+  absl::flat_hash_map<absl::string_view, HloConstantInstruction*> constants;
+  for (HloComputation* computation : module->computations()) {
+    for (HloInstruction* instruction : computation->instructions()) {
+      if (instruction->opcode() == HloOpcode::kConstant) {
+        constants[instruction->name()] =
+            Cast<HloConstantInstruction>(instruction);
+      }
+    }
+  }
+
+  // Deserialize constants
+  const uint64_t data_size =
+      serialized.size() - std::min<uint64_t>(serialized.size(), data_start);
+  for (const auto& descriptor : metadata.constants()) {
+    auto it = constants.find(descriptor.instruction_name());
+    if (it == constants.end() || it->second->HasLiteral()) {
+      return absl::InternalError(absl::StrCat(
+          "No constant without literal named ", descriptor.instruction_name()));
+    }
+    if (descriptor.offset() > data_size ||
+        descriptor.size_bytes() > data_size - descriptor.offset()) {
+      return absl::InternalError(absl::StrCat(
+          "Failed to deserialize constant ", descriptor.instruction_name(),
+          " with size ", descriptor.size_bytes()));
+    }
+    const Shape shape(descriptor.shape());
+    TF_RET_CHECK(ShapeUtil::ByteSizeOf(shape) == descriptor.size_bytes())
+        << descriptor.instruction_name();
+    TF_RET_CHECK(
+        Shape::Equal().MinorToMajorOnlyInLayout()(shape, it->second->shape()))
+        << shape.ToString(true) << " vs " << it->second->shape().ToString(true);
+    const char* data = serialized.data() + data_start + descriptor.offset();
+    if (owner != nullptr &&
+        reinterpret_cast<uintptr_t>(data) % kLargeConstantAlignment == 0) {
+      it->second->set_literal(
+          Literal::CreateFromSharedBuffer(shape, owner, data));
+    } else {
+      Literal literal(shape);
+      std::memcpy(literal.untyped_data(), data, descriptor.size_bytes());
+      it->second->set_literal(std::move(literal));
+    }
+  }
+  return module;
+}
+
+}  // namespace
+
+absl::StatusOr<std::unique_ptr<HloModule>>
+DeserializeHloModuleWithLargeConstants(absl::string_view serialized,
+                                       const DebugOptions& debug_options) {
+  return DeserializeModule(serialized, /*owner=*/nullptr, debug_options);
+}
+
+absl::StatusOr<std::unique_ptr<HloModule>> ReadHloModuleWithLargeConstants(
+    const std::string& path, const DebugOptions& debug_options) {
+  std::unique_ptr<tsl::ReadOnlyMemoryRegion> region;
+  if (tsl::Env::Default()
+          ->NewReadOnlyMemoryRegionFromFile(path, &region)
+          .ok()) {
+    absl::string_view serialized(static_cast<const char*>(region->data()),
+                                 region->length());
+    return DeserializeModule(
+        serialized, std::shared_ptr<const void>(std::move(region)),
+        debug_options);
+  }
+  std::string data;
+  TF_RETURN_IF_ERROR(tsl::ReadFileToString(tsl::Env::Default(), path, &data));
+  return DeserializeHloModuleWithLargeConstants(data, debug_options);
+}
+
+}  // namespace xla
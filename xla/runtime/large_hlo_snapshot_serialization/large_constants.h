@@ -0,0 +1,71 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+
+#ifndef XLA_RUNTIME_LARGE_HLO_SNAPSHOT_SERIALIZATION_LARGE_CONSTANTS_H_
+#define XLA_RUNTIME_LARGE_HLO_SNAPSHOT_SERIALIZATION_LARGE_CONSTANTS_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/xla.pb.h"
+#include "tsl/platform/protobuf.h"
+
+namespace xla {
+
+// Alignment of the data of each large constant, relative to the start of the
+// serialized module.
+inline constexpr int64_t kLargeConstantAlignment = 64;
+
+// Serialize an HloModule to a zero copy output stream, storing the data of its
+// large constants outside of the module proto.
+// The module is serialized in the following format order:
+//
+// * Metadata: `HloModuleWithLargeConstants` with the HloModuleProto, from which
+//    the literals of array constants of at least `min_large_constant_bytes`
+//    bytes are removed, and a descriptor for each removed literal.
+// * Raw constants: the untyped data of each removed literal, aligned to
+//    kLargeConstantAlignment bytes.
+//
+// The module proto is still materialized once with all the literals while
+// saving, but loading never copies the data of a large constant into a proto.
+absl::Status SerializeHloModuleWithLargeConstants(
+    const HloModule& module,
+    tsl::protobuf::io::ZeroCopyOutputStream* zero_copy_output_stream,
+    int64_t min_large_constant_bytes = int64_t{1} << 20);
+
+// Deserialization of a module in the format produced by
+// `SerializeHloModuleWithLargeConstants`. The literal of each large constant is
+// allocated once and filled directly from `serialized`.
+absl::StatusOr<std::unique_ptr<HloModule>>
+DeserializeHloModuleWithLargeConstants(absl::string_view serialized,
+                                       const DebugOptions& debug_options);
+
+// Reads a module written by `SerializeHloModuleWithLargeConstants` to `path`.
+// The file is memory-mapped when the file system supports it, and the literals
+// of the large constants then refer to the mapping without copying it (see
+// Literal::CreateFromSharedBuffer). The mapping stays alive as long as any of
+// these literals do.
+absl::StatusOr<std::unique_ptr<HloModule>> ReadHloModuleWithLargeConstants(
+    const std::string& path, const DebugOptions& debug_options);
+
+}  // namespace xla
+
+#endif  // XLA_RUNTIME_LARGE_HLO_SNAPSHOT_SERIALIZATION_LARGE_CONSTANTS_H_
@@ -0,0 +1,160 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+
+#include "xla/runtime/large_hlo_snapshot_serialization/large_constants.h"
+
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "xla/debug_options_flags.h"
+#include "xla/hlo/ir/hlo_casting_utils.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_instructions.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/literal_util.h"
+#include "xla/service/hlo.pb.h"
+#include "xla/service/hlo_module_config.h"
+#include "xla/tsl/lib/core/status_test_util.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/statusor.h"
+#include "tsl/platform/path.h"
+#include "tsl/platform/test.h"
+#include "tsl/platform/protobuf.h"
+
+namespace xla {
+namespace {
+
+using ::testing::HasSubstr;
+
+constexpr int64_t kLargeConstantElements = 4096;
+
+std::unique_ptr<HloModule> CreateModule() {
+  auto module = std::make_unique<HloModule>("test_module", HloModuleConfig());
+  std::vector<float> values(kLargeConstantElements);
+  std::iota(values.begin(), values.end(), 0.0f);
+  HloComputation::Builder builder("entry");
+  HloInstruction* large = builder.AddInstruction(
+      HloInstruction::CreateConstant(LiteralUtil::CreateR1<float>(values)));
+  large->SetAndSanitizeName("large");
+  HloInstruction* small = builder.AddInstruction(
+      HloInstruction::CreateConstant(LiteralUtil::CreateR0<float>(2.0f)));
+  small->SetAndSanitizeName("small");
+  HloInstruction* broadcast =
+      builder.AddInstruction(HloInstruction::CreateBroadcast(
+          large->shape(), small, /*broadcast_dimensions=*/{}));
+  builder.AddInstruction(HloInstruction::CreateBinary(
+      large->shape(), HloOpcode::kMultiply, large, broadcast));
+  module->AddEntryComputation(builder.Build());
+  return module;
+}
+
+absl::StatusOr<std::string> Serialize(const HloModule& module) {
+  std::string serialized;
+  tsl::protobuf::io::StringOutputStream output_stream(&serialized);
+  TF_RETURN_IF_ERROR(SerializeHloModuleWithLargeConstants(
+      module, &output_stream, /*min_large_constant_bytes=*/1024));
+  return serialized;
+}
+
+const Literal& ConstantLiteral(const HloModule& module,
+                               absl::string_view name) {
+  return Cast<HloConstantInstruction>(
+             module.entry_computation()->GetInstructionWithName(name))
+      ->literal();
+}
+
+TEST(LargeConstantsTest, SerializeAndDeserialize) {
+  std::unique_ptr<HloModule> module = CreateModule();
+  TF_ASSERT_OK_AND_ASSIGN(std::string serialized, Serialize(*module));
+
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> deserialized,
+                          DeserializeHloModuleWithLargeConstants(
+                              serialized, GetDebugOptionsFromFlags()));
+  EXPECT_EQ(deserialized->ToString(), module->ToString());
+  EXPECT_EQ(ConstantLiteral(*deserialized, "large"),
+            ConstantLiteral(*module, "large"));
+  EXPECT_EQ(ConstantLiteral(*deserialized, "small"),
+            ConstantLiteral(*module, "small"));
+}
+
+TEST(LargeConstantsTest, OnlyLargeConstantsAreStoredOutsideTheProto) {
+  std::unique_ptr<HloModule> module = CreateModule();
+  TF_ASSERT_OK_AND_ASSIGN(std::string serialized, Serialize(*module));
+
+  HloModuleWithLargeConstants metadata;
+  tsl::protobuf::io::ArrayInputStream input_stream(serialized.data(),
+                                                   serialized.size());
+  ASSERT_TRUE(tsl::protobuf::util::ParseDelimitedFromZeroCopyStream(
+      &metadata, &input_stream, /*clean_eof=*/nullptr));
+  ASSERT_EQ(metadata.constants_size(), 1);
+  EXPECT_EQ(metadata.constants(0).instruction_name(), "large");
+  EXPECT_EQ(metadata.constants(0).size_bytes(),
+            kLargeConstantElements * sizeof(float));
+  for (const HloInstructionProto& instruction :
+       metadata.hlo_module().computations(0).instructions()) {
+    EXPECT_EQ(instruction.has_literal(), instruction.name() == "small")
+        << instruction.name();
+  }
+  EXPECT_GE(serialized.size(), kLargeConstantElements * sizeof(float));
+}
+
+TEST(LargeConstantsTest, SerializeAndDeserializeTruncatedConstant) {
+  std::unique_ptr<HloModule> module = CreateModule();
+  TF_ASSERT_OK_AND_ASSIGN(std::string serialized, Serialize(*module));
+  serialized.resize(serialized.size() - 3);
+
+  auto status = DeserializeHloModuleWithLargeConstants(
+                    serialized, GetDebugOptionsFromFlags())
+                    .status();
+  EXPECT_THAT(status.message(),
+              HasSubstr("Failed to deserialize constant large"));
+}
+
+TEST(LargeConstantsTest, ReadFromFile) {
+  std::unique_ptr<HloModule> module = CreateModule();
+  TF_ASSERT_OK_AND_ASSIGN(std::string serialized, Serialize(*module));
+  std::string path =
+      tsl::io::JoinPath(tsl::testing::TmpDir(), "large_constants.hlo.bin");
+  TF_ASSERT_OK(tsl::WriteStringToFile(tsl::Env::Default(), path, serialized));
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<HloModule> deserialized,
+      ReadHloModuleWithLargeConstants(path, GetDebugOptionsFromFlags()));
+  EXPECT_EQ(ConstantLiteral(*deserialized, "large"),
+            ConstantLiteral(*module, "large"));
+  // The large constant refers to the memory-mapped file, if there is one.
+  std::unique_ptr<tsl::ReadOnlyMemoryRegion> region;
+  if (tsl::Env::Default()
+          ->NewReadOnlyMemoryRegionFromFile(path, &region)
+          .ok()) {
+    EXPECT_NE(ConstantLiteral(*deserialized, "large").shared_buffer_owner(),
+              nullptr);
+  }
+  EXPECT_EQ(ConstantLiteral(*deserialized, "small").shared_buffer_owner(),
+            nullptr);
+}
+
+}  // namespace
+}  // namespace xla
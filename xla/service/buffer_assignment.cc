@@ -65,6 +65,7 @@ limitations under the License.
 #include "xla/tsl/platform/errors.h"
 #include "xla/tsl/platform/logging.h"
 #include "xla/tsl/platform/statusor.h"
+#include "xla/tsl/platform/threadpool.h"
 #include "xla/util.h"
 #include "tsl/platform/numbers.h"
 
@@ -1270,13 +1271,15 @@ absl::StatusOr<std::unique_ptr<BufferAssignment>> BufferAssigner::Run(
     GlobalDecreasingSizeBestFitHeap<HloValue>::BufferIntervalCompare
         heap_buffer_interval_compare,
     std::optional<BufferAssignment::BufferIsolationOptions> isolation_options,
-    std::optional<BufferValue::Color> temp_buffer_color) {
+    std::optional<BufferValue::Color> temp_buffer_color,
+    tsl::thread::ThreadPool* thread_pool) {
   BufferAssigner assigner(allocate_buffers_for_constants, std::move(colorer),
                           must_not_live_out, std::move(preset_assignments));
   return assigner.CreateAssignment(
       module, std::move(hlo_ordering), std::move(buffer_size),
       std::move(color_alignment), std::move(can_share_buffer), private_stacks,
-      heap_buffer_interval_compare, isolation_options, temp_buffer_color);
+      heap_buffer_interval_compare, isolation_options, temp_buffer_color,
+      thread_pool);
 }
 
 bool BufferAssigner::LiveRangeInterferes(const HloValue* buffer1,
@@ -1810,7 +1813,8 @@ absl::Status BufferAssigner::AssignBuffersWithSequentialOrdering(
     const PrivateStacks& private_stacks,
     GlobalDecreasingSizeBestFitHeap<HloValue>::BufferIntervalCompare
         heap_buffer_interval_compare,
-    std::optional<BufferAssignment::BufferIsolationOptions> isolation_options) {
+    std::optional<BufferAssignment::BufferIsolationOptions> isolation_options,
+    tsl::thread::ThreadPool* thread_pool) {
   // Run the sequence of instructions through the heap simulator.  The
   // heuristic that seems to give the best results is lazy-best-fit, with all
   // runs of alloc / free calls sorted in decreasing size order.
@@ -1840,13 +1844,25 @@ absl::Status BufferAssigner::AssignBuffersWithSequentialOrdering(
         std::move(algorithms));
   };
 
+  // The heap simulations of different colors and computations are
+  // independent. They are collected first, so that they can run in parallel,
+  // and their results are assigned in the order they were collected.
+  struct HeapSimulation {
+    LogicalBuffer::Color color;
+    // The computation to simulate. Null to simulate the whole module.
+    const HloComputation* computation = nullptr;
+    flat_hash_set<const HloValue*> buffers_to_assign;
+    std::optional<absl::StatusOr<HeapSimulator::Result<HloValue>>> result;
+  };
+  std::vector<HeapSimulation> simulations;
+  HloSchedule schedule(&assignment->module());
+
   if (run_whole_module_heap_simulation) {
     // Run the heap simulation over the whole module. This reduces memory
     // usage, since buffers for kCall, kWhile, and kConditional
     // sub-computations are only live for the duration of their calling
     // instructions.
     VLOG(1) << "Running whole-module heap simulation";
-    HloSchedule schedule(&assignment->module());
     flat_hash_set<const HloValue*> all_buffers_to_assign;
     for (const auto& pair : buffers_to_assign_sequentially) {
       const HloComputation* computation = pair.first;
@@ -1867,10 +1883,6 @@ absl::Status BufferAssigner::AssignBuffersWithSequentialOrdering(
     }
     absl::c_sort(sorted_colors);
     for (auto color : sorted_colors) {
-      VLOG(2) << "Simulating heap for color " << color;
-      int64_t alignment = assignment->color_alignment_(color);
-      HeapSimulator::Options options;
-      options.alloc_constants = allocate_buffers_for_constants_;
       auto private_stacks_it = private_stacks.find(color);
       if (private_stacks_it != private_stacks.end()) {
         // For private stack colors, we collect all of the buffers that are
@@ -1890,28 +1902,12 @@ absl::Status BufferAssigner::AssignBuffersWithSequentialOrdering(
           auto computation_map_it =
               computation_map.find(private_stack_computation);
           CHECK(computation_map_it != computation_map.end());
-          options.buffers_to_assign = &computation_map_it->second;
-          const HloInstructionSequence* instruction_sequence =
-              hlo_ordering.SequentialOrder(*private_stack_computation);
-          TF_ASSIGN_OR_RETURN(
-              HeapSimulator::Result<HloValue> result,
-              HeapSimulator::Run(
-                  get_heap_algorithm(alignment), *private_stack_computation,
-                  *instruction_sequence, assignment->alias_analysis(),
-                  assignment->buffer_size_, &schedule, options));
-          AssignBuffersFromHeapSimulator(result, assignment, color,
-                                         isolation_options);
+          simulations.push_back({color, private_stack_computation,
+                                 std::move(computation_map_it->second)});
         }
       } else {
-        options.buffers_to_assign = &color_map[color];
-        TF_ASSIGN_OR_RETURN(
-            HeapSimulator::Result<HloValue> result,
-            HeapSimulator::Run(get_heap_algorithm(alignment),
-                               assignment->module(), schedule,
-                               assignment->alias_analysis(),
-                               assignment->buffer_size_, options));
-        AssignBuffersFromHeapSimulator(result, assignment, color,
-                                       isolation_options);
+        simulations.push_back(
+            {color, /*computation=*/nullptr, std::move(color_map[color])});
       }
     }
   } else {
@@ -1922,9 +1918,8 @@ absl::Status BufferAssigner::AssignBuffersWithSequentialOrdering(
     for (const auto& pair : buffers_to_assign_sequentially) {
       const HloComputation* computation = pair.first;
       const flat_hash_set<const HloValue*>& buffers_to_assign = pair.second;
-      const HloInstructionSequence* instruction_sequence =
-          hlo_ordering.SequentialOrder(*computation);
-      CHECK(instruction_sequence != nullptr) << computation->name();
+      CHECK(hlo_ordering.SequentialOrder(*computation) != nullptr)
+          << computation->name();
       auto color_map = SplitBuffersByColor(buffers_to_assign);
       std::vector<LogicalBuffer::Color> sorted_colors;
       sorted_colors.reserve(color_map.size());
@@ -1934,21 +1929,59 @@ absl::Status BufferAssigner::AssignBuffersWithSequentialOrdering(
       }
       absl::c_sort(sorted_colors);
       for (auto color : sorted_colors) {
-        VLOG(2) << "Simulating heap for color " << color;
-        int64_t alignment = assignment->color_alignment_(color);
-        HeapSimulator::Options options;
-        options.buffers_to_assign = &color_map[color];
-        TF_ASSIGN_OR_RETURN(
-            HeapSimulator::Result<HloValue> result,
-            HeapSimulator::Run(get_heap_algorithm(alignment), *computation,
-                               *instruction_sequence,
-                               assignment->alias_analysis(),
-                               assignment->buffer_size_, options));
-        AssignBuffersFromHeapSimulator(result, assignment, color,
-                                       isolation_options);
+        simulations.push_back(
+            {color, computation, std::move(color_map[color])});
       }
     }
   }
+
+  auto simulate = [&](HeapSimulation& simulation) {
+    VLOG(2) << "Simulating heap for color " << simulation.color;
+    int64_t alignment = assignment->color_alignment_(simulation.color);
+    HeapSimulator::Options options;
+    options.buffers_to_assign = &simulation.buffers_to_assign;
+    if (!run_whole_module_heap_simulation) {
+      simulation.result = HeapSimulator::Run(
+          get_heap_algorithm(alignment), *simulation.computation,
+          *hlo_ordering.SequentialOrder(*simulation.computation),
+          assignment->alias_analysis(), assignment->buffer_size_, options);
+      return;
+    }
+    options.alloc_constants = allocate_buffers_for_constants_;
+    if (simulation.computation != nullptr) {
+      simulation.result = HeapSimulator::Run(
+          get_heap_algorithm(alignment), *simulation.computation,
+          *hlo_ordering.SequentialOrder(*simulation.computation),
+          assignment->alias_analysis(), assignment->buffer_size_, &schedule,
+          options);
+    } else {
+      simulation.result = HeapSimulator::Run(
+          get_heap_algorithm(alignment), assignment->module(), schedule,
+          assignment->alias_analysis(), assignment->buffer_size_, options);
+    }
+  };
+  // A custom heap_buffer_interval_compare may share state between the heap
+  // algorithms it is copied into, so it is only called from one thread.
+  if (thread_pool != nullptr && heap_buffer_interval_compare == nullptr &&
+      simulations.size() > 1) {
+    thread_pool->ParallelFor(simulations.size(),
+                             [&](int64_t begin, int64_t end) {
+                               for (int64_t i = begin; i < end; ++i) {
+                                 simulate(simulations[i]);
+                               }
+                             });
+  } else {
+    for (HeapSimulation& simulation : simulations) {
+      simulate(simulation);
+    }
+  }
+
+  for (HeapSimulation& simulation : simulations) {
+    TF_ASSIGN_OR_RETURN(HeapSimulator::Result<HloValue> result,
+                        *std::move(simulation.result));
+    AssignBuffersFromHeapSimulator(result, assignment, simulation.color,
+                                   isolation_options);
+  }
   return absl::OkStatus();
 }
 
@@ -2182,7 +2215,8 @@ BufferAssigner::CreateAssignment(
     GlobalDecreasingSizeBestFitHeap<HloValue>::BufferIntervalCompare
         heap_buffer_interval_compare,
     std::optional<BufferAssignment::BufferIsolationOptions> isolation_options,
-    std::optional<BufferValue::Color> temp_buffer_color) {
+    std::optional<BufferValue::Color> temp_buffer_color,
+    tsl::thread::ThreadPool* thread_pool) {
   TF_ASSIGN_OR_RETURN(std::unique_ptr<HloAliasAnalysis> alias_analysis,
                       HloAliasAnalysis::Run(module, can_share_buffer));
 
@@ -2249,7 +2283,7 @@ BufferAssigner::CreateAssignment(
   TF_RETURN_IF_ERROR(AssignBuffersWithSequentialOrdering(
       buffers_to_assign_sequentially, run_whole_module_heap_simulation,
       assignment.get(), private_stacks, heap_buffer_interval_compare,
-      isolation_options));
+      isolation_options, thread_pool));
 
   std::vector<const HloComputation*> thread_local_computations_no_fusion;
   // Now assign buffers for thread-local computations. All LogicalBuffers get
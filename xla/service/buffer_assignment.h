@@ -50,6 +50,7 @@ limitations under the License.
 #include "xla/service/logical_buffer.h"
 #include "xla/service/memory_space_assignment/memory_space_assignment.h"
 #include "xla/shape_util.h"
+#include "xla/tsl/platform/threadpool.h"
 #include "tsl/platform/logging.h"
 
 namespace xla {
@@ -676,7 +677,9 @@ class BufferAssigner {
   // color_alignment are functions which returns the size and alignment of a
   // LogicalBuffer. If preset_assignments is provided, those pre-set assignment
   // offsets will be used. The caller guarantees that those assignments are
-  // valid and they do not overwrite each other.
+  // valid and they do not overwrite each other. If thread_pool is provided, the
+  // heap simulations of different colors and computations run in parallel on
+  // it.
   static absl::StatusOr<std::unique_ptr<BufferAssignment>> Run(
       const HloModule* module, std::unique_ptr<HloOrdering> hlo_ordering,
       BufferValue::SizeFunction buffer_size,
@@ -692,7 +695,8 @@ class BufferAssigner {
           heap_buffer_interval_compare = nullptr,
       std::optional<BufferAssignment::BufferIsolationOptions>
           isolation_options = std::nullopt,
-      std::optional<BufferValue::Color> temp_buffer_color = std::nullopt);
+      std::optional<BufferValue::Color> temp_buffer_color = std::nullopt,
+      tsl::thread::ThreadPool* thread_pool = nullptr);
 
  private:
   BufferAssigner(bool allocate_buffers_for_constants, Colorer colorer,
@@ -715,7 +719,8 @@ class BufferAssigner {
       GlobalDecreasingSizeBestFitHeap<HloValue>::BufferIntervalCompare
           heap_buffer_interval_compare,
       std::optional<BufferAssignment::BufferIsolationOptions> isolation_options,
-      std::optional<BufferValue::Color> temp_buffer_color);
+      std::optional<BufferValue::Color> temp_buffer_color,
+      tsl::thread::ThreadPool* thread_pool);
 
   // Assigns buffers to the instructions in the given computations. "assignment"
   // is modified to reflect the new buffer assignments. If is_thread_local is
@@ -752,7 +757,8 @@ class BufferAssigner {
   // the HLO instructions will be executed in the sequential order given by
   // assignment->liveness().hlo_ordering().SequentialOrder. If
   // 'run_whole_module_heap_simulation' is true, the heap simulation will be run
-  // assuming all global computations are sequentially ordered.
+  // assuming all global computations are sequentially ordered. The independent
+  // heap simulations run on thread_pool, if it is not null.
   absl::Status AssignBuffersWithSequentialOrdering(
       const absl::flat_hash_map<const HloComputation*,
                                 absl::flat_hash_set<const HloValue*>>&
@@ -761,8 +767,8 @@ class BufferAssigner {
       const PrivateStacks& private_stacks,
       GlobalDecreasingSizeBestFitHeap<HloValue>::BufferIntervalCompare
           heap_buffer_interval_compare,
-      std::optional<BufferAssignment::BufferIsolationOptions>
-          isolation_options);
+      std::optional<BufferAssignment::BufferIsolationOptions> isolation_options,
+      tsl::thread::ThreadPool* thread_pool);
 
   // Isolates the buffers packed by heap simulator using the provided isolation
   // options. Please see the documentation for BufferIsolationConfig for more
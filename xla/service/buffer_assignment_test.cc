@@ -56,6 +56,8 @@ limitations under the License.
 #include "xla/shape_util.h"
 #include "xla/tests/hlo_test_base.h"
 #include "xla/tsl/lib/core/status_test_util.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/threadpool.h"
 #include "xla/xla_data.pb.h"
 #include "tsl/platform/status.h"
 #include "tsl/platform/statusor.h"
@@ -128,7 +130,8 @@ class BufferAssignmentTest : public HloTestBase {
       BufferAssigner::Colorer colorer = BufferAssigner::DefaultColorer(),
       const BufferAssigner::PrivateStacks& private_stacks = {},
       std::optional<BufferAssignment::BufferIsolationOptions>
-          isolation_options = std::nullopt) {
+          isolation_options = std::nullopt,
+      tsl::thread::ThreadPool* thread_pool = nullptr) {
     return BufferAssigner::Run(
                module,
                std::make_unique<SequentialHloOrdering>(module->schedule()),
@@ -137,7 +140,8 @@ class BufferAssignmentTest : public HloTestBase {
                /*allocate_buffers_for_constants=*/true, colorer,
                /*must_not_live_out=*/std::nullopt, /*can_share_buffer=*/nullptr,
                /*preset_assignments=*/{}, private_stacks,
-               /*heap_buffer_interval_compare=*/nullptr, isolation_options)
+               /*heap_buffer_interval_compare=*/nullptr, isolation_options,
+               /*temp_buffer_color=*/std::nullopt, thread_pool)
         .value();
   }
 
@@ -832,6 +836,42 @@ TEST_F(BufferAssignmentTest, BasicPartiallyColored) {
   EXPECT_EQ(param1->shape().layout().memory_space(), 0);
 }
 
+TEST_F(BufferAssignmentTest, ParallelHeapSimulationMatchesSequential) {
+  const char* hlo_text = R"(
+HloModule m, is_scheduled=true
+
+ENTRY main {
+  p0 = f32[100] parameter(0)
+  p1 = f32[100] parameter(1)
+  a = f32[100] add(p0, p1)
+  b = f32[100] multiply(a, p1)
+  c = f32[100] subtract(b, a)
+  d = f32[100] add(c, b)
+  e = f32[100] multiply(d, c)
+  ROOT f = f32[100] subtract(e, d)
+})";
+
+  // Spread the values over three colors, each with its own heap.
+  auto colorer = [](HloAliasAnalysis* alias_analysis, const HloOrdering&) {
+    for (HloValue* value : alias_analysis->dataflow_analysis().values()) {
+      value->set_color(BufferValue::Color(value->id() % 3));
+    }
+    return absl::OkStatus();
+  };
+
+  TF_ASSERT_OK_AND_ASSIGN(auto module, ParseAndReturnVerifiedModule(hlo_text));
+  auto sequential = RunBufferAssignmentWithSequentialOrdering(
+      module.get(), /*alignment=*/1, colorer);
+
+  tsl::thread::ThreadPool thread_pool(tsl::Env::Default(), "test", 4);
+  TF_ASSERT_OK_AND_ASSIGN(module, ParseAndReturnVerifiedModule(hlo_text));
+  auto parallel = RunBufferAssignmentWithSequentialOrdering(
+      module.get(), /*alignment=*/1, colorer, /*private_stacks=*/{},
+      /*isolation_options=*/std::nullopt, &thread_pool);
+
+  EXPECT_EQ(sequential->ToString(), parallel->ToString());
+}
+
 TEST_F(BufferAssignmentTest, PresetAssignments) {
   // paramscalar ------- (mul) -- (add) -- (sub)
   //                     /        /        /
@@ -3053,9 +3053,43 @@ bool IsForwardSinkIterationFeasible(HloInstruction* while_inst,
   return true;
 }
 
+// Returns the number of bytes of all arrays in `shape`.
+int64_t ByteSizeOfLeaves(const Shape& shape) {
+  int64_t size = 0;
+  ShapeUtil::ForEachLeafShape(
+      shape, [&](const Shape& subshape, const ShapeIndex& index) {
+        if (subshape.IsArray()) {
+          size += ShapeUtil::ByteSizeOf(subshape);
+        }
+      });
+  return size;
+}
+
+// Pipelining a chain once more adds another in-flight value of its collective
+// to the loop state. Returns false if that would grow the state of the loop
+// beyond `max_loop_state_bytes`.
+bool IsDeeperBackwardPipeliningFeasible(const WhileLoopAnalysis& loop_analysis,
+                                        int64_t max_loop_state_bytes) {
+  int64_t loop_state_bytes =
+      ByteSizeOfLeaves(loop_analysis.while_loop_instruction()->shape());
+  for (const WhileMoveInfo& move_info : loop_analysis.GetMoveInfos()) {
+    for (const HloInstruction* collective : move_info.collectives_to_move) {
+      loop_state_bytes += ByteSizeOfLeaves(collective->shape());
+    }
+  }
+  if (loop_state_bytes > max_loop_state_bytes) {
+    VLOG(1) << "Loop state of " << loop_state_bytes
+            << " bytes exceeds the limit of " << max_loop_state_bytes
+            << " bytes, stop pipelining deeper.";
+    return false;
+  }
+  return true;
+}
+
 absl::StatusOr<bool> CollectivePipeliner::RunPipeliner(
     HloModule* module,
-    const absl::flat_hash_set<absl::string_view>& execution_threads) {
+    const absl::flat_hash_set<absl::string_view>& execution_threads,
+    int64_t depth) {
   bool changed = false;
 
   // Precompute module-scoped analyses. Because we are running a while-loop
@@ -3114,6 +3148,11 @@ absl::StatusOr<bool> CollectivePipeliner::RunPipeliner(
     if (loop_analysis->GetMoveInfos().empty()) {
       continue;
     }
+    if (depth > 0 && !IsDeeperBackwardPipeliningFeasible(
+                         *loop_analysis,
+                         config_.max_loop_state_bytes_for_depth)) {
+      continue;
+    }
     transformed_instructions += loop_analysis->GetMoveInfos().size();
     VLOG(1) << "Found Collectives to optimize";
     if (VLOG_IS_ON(1)) {
@@ -3188,6 +3227,24 @@ absl::StatusOr<bool> CollectivePipeliner::Run(
   CHECK(config_.acceptable_formatting);
   CHECK(config_.should_process);
 
+  // Each backward run rotates the pipelined chains by one more iteration
+  // through the loop, so running the pipeliner `pipelining_depth` times starts
+  // the collectives that many iterations ahead of their uses.
+  if (config_.pipelining_direction == PipeliningDirection::kBackward &&
+      config_.pipelining_depth > 1) {
+    bool changed = false;
+    for (int64_t depth = 0; depth < config_.pipelining_depth; ++depth) {
+      TF_ASSIGN_OR_RETURN(bool depth_changed,
+                          RunPipeliner(module, execution_threads, depth));
+      VLOG(1) << "Finished pipelining at depth: " << depth + 1;
+      if (!depth_changed) {
+        break;
+      }
+      changed = true;
+    }
+    return changed;
+  }
+
   if (config_.pipelining_direction != PipeliningDirection::kForwardSink) {
     return RunPipeliner(module, execution_threads);
   }
@@ -113,6 +113,14 @@ class CollectivePipeliner : public HloModulePass {
     // Postprocessing hook which runs for every successfully pipelined op.
     HloPostprocessor postprocess_pipelined_ops;
     int64_t collective_size_threshold_to_stop_sinking = INT64_MAX;
+    // Number of iterations ahead of their uses that instructions are pipelined
+    // in kBackward direction. With a depth of k, k values of every pipelined
+    // chain are in flight in the loop state, e.g. all-gathers of weights start
+    // k layers ahead.
+    int64_t pipelining_depth = 1;
+    // Pipelining deeper than one iteration is skipped for loops whose state
+    // would grow beyond this number of bytes.
+    int64_t max_loop_state_bytes_for_depth = INT64_MAX;
   };
   static const char* const kInsertedByPreviousStep;
   static const char* const kSunkByPreviousStep;
@@ -145,10 +153,12 @@ class CollectivePipeliner : public HloModulePass {
   }
 
   // Pipelines the collectives that do not have any other pipelineable
-  // collectives in their user subtree.
+  // collectives in their user subtree. `depth` is the number of iterations
+  // collectives were already pipelined backward by previous runs.
   absl::StatusOr<bool> RunPipeliner(
       HloModule* module,
-      const absl::flat_hash_set<absl::string_view>& execution_threads);
+      const absl::flat_hash_set<absl::string_view>& execution_threads,
+      int64_t depth = 0);
 
   using HloPassInterface::Run;
   absl::StatusOr<bool> Run(
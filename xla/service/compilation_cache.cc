@@ -15,13 +15,20 @@ limitations under the License.
 
 #include "xla/service/compilation_cache.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
 #include <utility>
 
-#include "xla/types.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "xla/service/executable.h"
 #include "xla/util.h"
 #include "xla/xla_data.pb.h"
 #include "tsl/platform/logging.h"
-#include "tsl/platform/strcat.h"
 
 namespace xla {
 
@@ -38,13 +45,22 @@ int64_t GetUniqueId() {
 }  // namespace
 
 ExecutionHandle CompilationCache::Insert(
-    std::unique_ptr<Executable> executable) {
+    std::unique_ptr<Executable> executable, absl::string_view fingerprint) {
   absl::MutexLock lock(&mutex_);
 
   CacheKey key = GetUniqueId();
   VLOG(2) << "inserting cache key: " << key;
   CHECK_EQ(cache_.count(key), 0);
-  cache_.emplace(key, std::move(executable));
+  int64_t size_bytes =
+      std::max<int64_t>(executable->SizeOfGeneratedCodeInBytes(), 0);
+  lru_.push_front(key);
+  cache_.emplace(key, Entry{std::move(executable), std::string(fingerprint),
+                            size_bytes, lru_.begin()});
+  if (!fingerprint.empty()) {
+    fingerprints_[fingerprint] = key;
+  }
+  size_bytes_ += size_bytes;
+  EvictIfNeeded();
 
   ExecutionHandle handle;
   handle.set_handle(key);
@@ -57,13 +73,54 @@ absl::StatusOr<std::shared_ptr<Executable>> CompilationCache::LookUp(
 
   CacheKey key = handle.handle();
   VLOG(2) << "looking up cache key: " << key;
-  if (cache_.count(key) == 0) {
+  auto it = cache_.find(key);
+  if (it == cache_.end()) {
     VLOG(2) << "cache key not found: " << key;
-    return InvalidArgumentStrCat("can not find executable with handle ", key);
-  } else {
-    auto& result = cache_.at(key);
-    VLOG(2) << "hit executable: " << result->module().name();
-    return result;
+    return InvalidArgumentStrCat(
+        "can not find executable with handle ", key,
+        "; it may have been evicted from the compilation cache");
+  }
+  Touch(it->second);
+  VLOG(2) << "hit executable: " << it->second.executable->module().name();
+  return it->second.executable;
+}
+
+std::optional<ExecutionHandle> CompilationCache::LookUpByFingerprint(
+    absl::string_view fingerprint) const {
+  absl::MutexLock lock(&mutex_);
+  auto it = fingerprints_.find(fingerprint);
+  if (it == fingerprints_.end()) {
+    return std::nullopt;
+  }
+  Touch(cache_.at(it->second));
+  ExecutionHandle handle;
+  handle.set_handle(it->second);
+  return handle;
+}
+
+int64_t CompilationCache::size_bytes() const {
+  absl::MutexLock lock(&mutex_);
+  return size_bytes_;
+}
+
+void CompilationCache::Touch(const Entry& entry) const {
+  lru_.splice(lru_.begin(), lru_, entry.lru_position);
+}
+
+void CompilationCache::EvictIfNeeded() {
+  while (capacity_bytes_ > 0 && size_bytes_ > capacity_bytes_ &&
+         lru_.size() > 1) {
+    CacheKey key = lru_.back();
+    lru_.pop_back();
+    auto it = cache_.find(key);
+    VLOG(2) << "evicting cache key: " << key;
+    size_bytes_ -= it->second.size_bytes;
+    auto fingerprint_it = fingerprints_.find(it->second.fingerprint);
+    if (fingerprint_it != fingerprints_.end() &&
+        fingerprint_it->second == key) {
+      fingerprints_.erase(fingerprint_it);
+    }
+    cache_.erase(it);
   }
 }
 
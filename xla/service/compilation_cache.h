@@ -16,43 +16,88 @@ limitations under the License.
 #ifndef XLA_SERVICE_COMPILATION_CACHE_H_
 #define XLA_SERVICE_COMPILATION_CACHE_H_
 
-#include <map>
+#include <cstdint>
+#include <list>
 #include <memory>
+#include <optional>
 #include <string>
 
+#include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_map.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
 #include "xla/service/executable.h"
-#include "xla/service/hlo_module_config.h"
 #include "xla/types.h"
+#include "xla/xla_data.pb.h"
 
 namespace xla {
 
-// A cache which stores Executables indexed by computation handle and version.
+// A cache which stores Executables indexed by execution handle, and optionally
+// by a fingerprint of the computation and configuration they were compiled
+// from.
 //
-// TODO(b/119042872): Provide mechanism for removing computations from the
-// compilation cache.
+// If the cache has a capacity, the least recently used executables are evicted
+// once the total size of their generated code exceeds it. Looking up the handle
+// of an evicted executable fails; executions already running keep it alive.
+// Executables that don't report the size of their generated code don't count
+// towards the capacity.
 class CompilationCache {
  public:
-  CompilationCache() {}
+  // A `capacity_bytes` of 0 means the cache is unbounded.
+  explicit CompilationCache(int64_t capacity_bytes = 0)
+      : capacity_bytes_(capacity_bytes) {}
 
-  ExecutionHandle Insert(std::unique_ptr<Executable> executable);
+  // Inserts `executable` and returns its new handle. If `fingerprint` is not
+  // empty, LookUpByFingerprint returns the handle while the executable stays
+  // in the cache.
+  ExecutionHandle Insert(std::unique_ptr<Executable> executable,
+                         absl::string_view fingerprint = "");
 
   // Lookup the Executable for the specified handle in the cache. Return a
   // shared_ptr to the Executable if it exists in the cache.
   absl::StatusOr<std::shared_ptr<Executable>> LookUp(
       const ExecutionHandle& handle) const;
 
+  // Returns the handle of the cached executable with `fingerprint`, if any.
+  std::optional<ExecutionHandle> LookUpByFingerprint(
+      absl::string_view fingerprint) const;
+
+  // Total size of the generated code of the cached executables.
+  int64_t size_bytes() const;
+
  protected:
   mutable absl::Mutex mutex_;
 
   using CacheKey = int64_t;
 
-  absl::flat_hash_map<CacheKey, std::shared_ptr<Executable>> cache_
+  struct Entry {
+    std::shared_ptr<Executable> executable;
+    std::string fingerprint;
+    int64_t size_bytes;
+    // Position of the key in `lru_`.
+    std::list<CacheKey>::iterator lru_position;
+  };
+
+  absl::flat_hash_map<CacheKey, Entry> cache_ ABSL_GUARDED_BY(mutex_);
+  absl::flat_hash_map<std::string, CacheKey> fingerprints_
       ABSL_GUARDED_BY(mutex_);
+  // Keys of `cache_`, from the most to the least recently used.
+  mutable std::list<CacheKey> lru_ ABSL_GUARDED_BY(mutex_);
+  int64_t size_bytes_ ABSL_GUARDED_BY(mutex_) = 0;
 
  private:
   CompilationCache(const CompilationCache&) = delete;
   CompilationCache& operator=(const CompilationCache&) = delete;
+
+  // Marks `entry` as the most recently used.
+  void Touch(const Entry& entry) const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  // Evicts the least recently used executables, other than the most recently
+  // used one, until the cache fits in its capacity.
+  void EvictIfNeeded() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  const int64_t capacity_bytes_;
 };
 
 }  // namespace xla
@@ -0,0 +1,98 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/service/compilation_cache.h"
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/service/executable.h"
+#include "xla/service/hlo_module_config.h"
+#include "xla/service/service_executable_run_options.h"
+#include "xla/xla_data.pb.h"
+
+namespace xla {
+namespace {
+
+class TestExecutable : public Executable {
+ public:
+  explicit TestExecutable(int64_t size_bytes)
+      : Executable(std::make_shared<HloModule>("test", HloModuleConfig())),
+        size_bytes_(size_bytes) {}
+
+  absl::StatusOr<ExecutionOutput> ExecuteAsyncOnStream(
+      const ServiceExecutableRunOptions* run_options,
+      std::vector<ExecutionInput> arguments) override {
+    return absl::UnimplementedError("Not needed for this test.");
+  }
+
+  int64_t SizeOfGeneratedCodeInBytes() const override { return size_bytes_; }
+
+ private:
+  int64_t size_bytes_;
+};
+
+TEST(CompilationCacheTest, LooksUpByFingerprint) {
+  CompilationCache cache;
+  ExecutionHandle handle =
+      cache.Insert(std::make_unique<TestExecutable>(10), "fingerprint");
+  std::optional<ExecutionHandle> found =
+      cache.LookUpByFingerprint("fingerprint");
+  ASSERT_TRUE(found.has_value());
+  EXPECT_EQ(found->handle(), handle.handle());
+  EXPECT_FALSE(cache.LookUpByFingerprint("other").has_value());
+}
+
+TEST(CompilationCacheTest, EvictsLeastRecentlyUsed) {
+  CompilationCache cache(/*capacity_bytes=*/100);
+  ExecutionHandle a = cache.Insert(std::make_unique<TestExecutable>(40), "a");
+  ExecutionHandle b = cache.Insert(std::make_unique<TestExecutable>(40), "b");
+  // Using `a` makes `b` the least recently used executable.
+  EXPECT_TRUE(cache.LookUp(a).ok());
+  ExecutionHandle c = cache.Insert(std::make_unique<TestExecutable>(40), "c");
+
+  EXPECT_TRUE(cache.LookUp(a).ok());
+  EXPECT_FALSE(cache.LookUp(b).ok());
+  EXPECT_FALSE(cache.LookUpByFingerprint("b").has_value());
+  EXPECT_TRUE(cache.LookUp(c).ok());
+  EXPECT_EQ(cache.size_bytes(), 80);
+}
+
+TEST(CompilationCacheTest, KeepsExecutableLargerThanCapacity) {
+  CompilationCache cache(/*capacity_bytes=*/10);
+  ExecutionHandle a = cache.Insert(std::make_unique<TestExecutable>(5));
+  ExecutionHandle b = cache.Insert(std::make_unique<TestExecutable>(50));
+  EXPECT_FALSE(cache.LookUp(a).ok());
+  EXPECT_TRUE(cache.LookUp(b).ok());
+}
+
+TEST(CompilationCacheTest, UnsizedExecutablesAreNotCounted) {
+  CompilationCache cache(/*capacity_bytes=*/10);
+  ExecutionHandle a = cache.Insert(std::make_unique<TestExecutable>(-1));
+  ExecutionHandle b = cache.Insert(std::make_unique<TestExecutable>(10));
+  EXPECT_TRUE(cache.LookUp(a).ok());
+  EXPECT_TRUE(cache.LookUp(b).ok());
+  EXPECT_EQ(cache.size_bytes(), 10);
+}
+
+}  // namespace
+}  // namespace xla
@@ -16,9 +16,11 @@ limitations under the License.
 #include "xla/service/conditional_code_motion.h"
 
 #include <algorithm>
+#include <cmath>
 #include <cstdint>
 #include <functional>
 #include <iterator>
+#include <optional>
 #include <stack>
 #include <string>
 #include <utility>
@@ -32,6 +34,8 @@ limitations under the License.
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/numbers.h"
+#include "absl/strings/str_split.h"
+#include "absl/types/span.h"
 #include "xla/debug_options_flags.h"
 #include "xla/hlo/ir/hlo_casting_utils.h"
 #include "xla/hlo/ir/hlo_computation.h"
@@ -43,6 +47,7 @@ limitations under the License.
 #include "xla/hlo/transforms/simplifiers/tuple_simplifier.h"
 #include "xla/literal.h"
 #include "xla/map_util.h"
+#include "xla/service/hlo_cost_analysis.h"
 #include "xla/service/hlo_cse.h"
 #include "xla/service/hlo_verifier.h"
 #include "xla/shape.h"
@@ -1901,6 +1906,94 @@ class GroupConnectedBoundaries {
   }
 };
 
+// Returns the normalized branch probabilities of `conditional`, or an empty
+// vector if it has no valid kBranchProbabilitiesAttr annotation.
+std::vector<double> GetBranchProbabilities(const HloInstruction* conditional) {
+  std::optional<std::string> attr = conditional->get_frontend_attribute(
+      std::string(ConditionalCodeMotion::kBranchProbabilitiesAttr));
+  if (!attr.has_value()) {
+    return {};
+  }
+  std::vector<absl::string_view> parts = absl::StrSplit(*attr, ',');
+  if (parts.size() != conditional->branch_count()) {
+    VLOG(1) << "Ignoring branch probabilities " << *attr << " of "
+            << conditional->name() << " with " << conditional->branch_count()
+            << " branches.";
+    return {};
+  }
+  std::vector<double> probabilities;
+  double sum = 0;
+  for (absl::string_view part : parts) {
+    double probability;
+    if (!absl::SimpleAtod(part, &probability) || !std::isfinite(probability) ||
+        probability < 0) {
+      VLOG(1) << "Ignoring invalid branch probabilities " << *attr << " of "
+              << conditional->name();
+      return {};
+    }
+    probabilities.push_back(probability);
+    sum += probability;
+  }
+  if (sum <= 0) {
+    return {};
+  }
+  for (double& probability : probabilities) {
+    probability /= sum;
+  }
+  return probabilities;
+}
+
+// Returns how much moving the operand boundaries `to_move_in` into the
+// branches of `conditional` reduces its expected runtime, in tenths of the
+// expected runtime of the moved instructions and the branches together. The
+// moved instructions only feed the branches whose inputs use them, so once
+// moved they only run when one of those branches is taken. Runtime is
+// estimated by the bytes accessed according to HloCostAnalysis, since the
+// instructions that can be moved are memory bound.
+int64_t ExpectedRuntimeBenefitOfMovingIn(
+    const HloInstruction* conditional,
+    absl::Span<const double> branch_probabilities,
+    const std::vector<Boundary>& to_move_in) {
+  // Find the conditional operand the moved instructions feed.
+  const HloInstruction* input = to_move_in[0].operands()[0];
+  while (input->user_count() == 1 && input->users()[0] != conditional) {
+    input = input->users()[0];
+  }
+  if (input->user_count() != 1) {
+    return 0;
+  }
+  double use_probability = 0;
+  for (int64_t operand_index : conditional->OperandIndices(input)) {
+    if (operand_index > 0) {
+      use_probability += branch_probabilities[operand_index - 1];
+    }
+  }
+
+  HloCostAnalysis cost_analysis;
+  double moved_cost = 0;
+  for (const Boundary& b : to_move_in) {
+    const HloInstruction* op = b.operands()[0];
+    if (op->opcode() == HloOpcode::kTuple ||
+        !cost_analysis.RevisitInstruction(op).ok()) {
+      continue;
+    }
+    moved_cost += cost_analysis.bytes_accessed(*op);
+  }
+  double branch_cost = 0;
+  for (int64_t i = 0; i < conditional->branch_count(); ++i) {
+    HloCostAnalysis branch_analysis;
+    if (!conditional->branch_computation(i)->Accept(&branch_analysis).ok()) {
+      return 0;
+    }
+    branch_cost += branch_probabilities[i] * branch_analysis.bytes_accessed();
+  }
+  if (moved_cost + branch_cost <= 0) {
+    return 0;
+  }
+  return static_cast<int64_t>(10 * (1 - use_probability) * moved_cost /
+                              (moved_cost + branch_cost));
+}
+
 ConditionalCodeMotion::Decision ConditionalCodeMotion::ConsiderCodeMotion(
     HloInstruction* conditional, const Boundary& cur_boundary,
     std::vector<Boundary>& to_move, std::vector<Boundary>& new_boundaries,
@@ -1915,6 +2008,13 @@ ConditionalCodeMotion::Decision ConditionalCodeMotion::ConsiderCodeMotion(
         move_in_or_out.first, search_config_map_.empty());
     VLOG(2) << "benefit of moving in or out "
             << cur_boundary.operands()[0]->ToString() << ":" << benefit << "\n";
+    if (benefit >= 0 && !branch_probabilities_.empty() &&
+        move_in_or_out.first[0].IsOutsideBranchOperand()) {
+      int64_t runtime_benefit = ExpectedRuntimeBenefitOfMovingIn(
+          conditional, branch_probabilities_, move_in_or_out.first);
+      VLOG(2) << "expected runtime benefit of moving in: " << runtime_benefit;
+      benefit += runtime_benefit;
+    }
     if (benefit >= 0) {
       // Stop move instruction if the memory pressure is too high.
       if (move_in_or_out.second > 0 &&
@@ -2026,6 +2126,7 @@ absl::StatusOr<bool> ConditionalCodeMotion::Run(
       conditional_index++;
     }
     int branch_count = conditional->branch_count();
+    branch_probabilities_ = GetBranchProbabilities(conditional);
     // check for shared conditional computations
     bool conditional_is_shared = false;
     for (int i = 0; i < branch_count; ++i) {
@@ -17,6 +17,7 @@ limitations under the License.
 #define XLA_SERVICE_CONDITIONAL_CODE_MOTION_H_
 
 #include <string>
+#include <vector>
 
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
@@ -179,6 +180,14 @@ class ConditionalCodeMotion : public HloModulePass {
     return max_flip;
   }
 
+  // The frontend attribute of a conditional that gives the probability of
+  // taking each of its branches, as a comma separated list of non-negative
+  // numbers, one per branch, e.g. "0.9,0.1". The numbers are normalized to sum
+  // to 1. When present, moving operands into the branches is credited with the
+  // runtime it saves in expectation, as estimated by HloCostAnalysis.
+  static constexpr absl::string_view kBranchProbabilitiesAttr =
+      "_xla_branch_probabilities";
+
   absl::string_view name() const override { return "conditional-code-motion"; }
   using HloPassInterface::Run;
   absl::StatusOr<bool> Run(
@@ -228,6 +237,9 @@ class ConditionalCodeMotion : public HloModulePass {
   // moved.
   int64_t memory_increase_allowance_ = 5000;
   int64_t memory_increase_ = 0;
+  // The probability of taking each branch of the conditional being optimized,
+  // or empty if the conditional is not annotated.
+  std::vector<double> branch_probabilities_;
   absl::StatusOr<bool> MoveInstructionOut(
       HloInstruction* conditional, std::vector<Boundary>& to_move_out,
       std::vector<Boundary>& new_boundaries);
@@ -1976,6 +1976,48 @@ ENTRY %xla_computation  {
               op::Constant(),
               op::Power(op::Constant(), op::Floor(op::GetTupleElement()))))));
 }
+// Move operands into a rarely taken branch according to its annotated
+// probability.
+TEST_F(ConditionalCodeMotionTest, MoveOperandsIntoRarelyTakenBranch) {
+  absl::string_view hlo_string =
+      R"(
+HloModule xla_computation
+
+%branch_true  {
+  tmp_0 = (f32[128]) parameter(0)
+  tmp_1 = f32[128] get-tuple-element(tmp_0), index=0
+  ROOT tmp_2 = (f32[128]) tuple(tmp_1)
+}
+
+%branch_false {
+  tmp_0 = (f32[128]) parameter(0)
+  tmp_1 = f32[128] get-tuple-element(tmp_0), index=0
+  tmp_2 = f32[128] negate(tmp_1)
+  ROOT tmp_3 = (f32[128]) tuple(tmp_2)
+}
+
+ENTRY %xla_computation  {
+  %parameter.0 = f32[128] parameter(0)
+  %parameter.1 = (f32[128]) parameter(1)
+  %parameter.2 = pred[] parameter(2)
+  %exponential = f32[128] exponential(%parameter.0)
+  %multiply = f32[128] multiply(%exponential, %parameter.0)
+  %tuple = (f32[128]) tuple(%multiply)
+  ROOT conditional = (f32[128]) conditional(%parameter.2, %parameter.1, %tuple), true_computation=branch_true, false_computation=branch_false, frontend_attributes={_xla_branch_probabilities="0.99,0.01"}
+}
+)";
+  auto module = ParseAndReturnVerifiedModule(hlo_string).value();
+  ConditionalCodeMotion pass(true, true);
+  ASSERT_TRUE(pass.Run(&*module).value());
+  HloInstruction* root = module->entry_computation()->root_instruction();
+  EXPECT_THAT(root, op::Conditional(op::Parameter(), op::Parameter(),
+                                    op::Tuple()));
+  // The exponential and multiply only run in the false branch now.
+  EXPECT_THAT(root->branch_computation(1)->root_instruction(),
+              op::Tuple(op::Negate(op::Multiply(
+                  op::Exp(op::GetTupleElement()), op::GetTupleElement()))));
+}
+
 // Move partially used operands inside empty conditional branches.
 TEST_F(ConditionalCodeMotionTest, MovePartialyUsedOperands3) {
   absl::string_view hlo_string =
@@ -25,6 +25,7 @@ limitations under the License.
 #include <vector>
 
 #include "absl/algorithm/container.h"
+#include "absl/container/btree_map.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/container/inlined_vector.h"
@@ -1522,31 +1523,40 @@ class CopyRemover {
   // Try to elide the given copy. Elision of a copy is possible only if no
   // live range interference is introduced by the copy's elimination. If
   // elision is possible, then the internal state (value lists) are updated,
-  // and true is returned. Returns false otherwise.
-  bool TryElideCopy(const HloInstruction* copy,
-                    int64_t* region_analysis_limit) {
+  // and true is returned. Returns false otherwise, and sets `reason` if it is
+  // not null to why the copy can't be elided.
+  bool TryElideCopy(const HloInstruction* copy, int64_t* region_analysis_limit,
+                    std::string* reason = nullptr) {
     VLOG(2) << "Trying to remove " << copy->name();
     CHECK_NE(region_analysis_limit, nullptr);
+    auto not_removable = [&](absl::string_view why) {
+      if (reason != nullptr) {
+        *reason = std::string(why);
+      }
+      return false;
+    };
     if (copy->shape().has_layout() && copy->operand(0)->shape().has_layout()) {
       if (copy->shape().layout().memory_space() == Layout::kHostMemorySpace &&
           copy->operand(0)->shape().layout().memory_space() !=
               Layout::kHostMemorySpace) {
-        return false;
+        return not_removable("copies from device to host memory");
       }
       if (copy->shape().layout().memory_space() != Layout::kHostMemorySpace &&
           copy->operand(0)->shape().layout().memory_space() ==
               Layout::kHostMemorySpace) {
-        return false;
+        return not_removable("copies from host to device memory");
       }
     }
 
     if (!ContainsKey(copy_map_, copy)) {
       VLOG(2) << copy->name() << " is not removable";
-      return false;
+      return not_removable(
+          "the copied value is ambiguous, e.g. it is one of several values "
+          "selected by a conditional or passed to a while loop");
     }
     if (!ShapeUtil::Equal(copy->shape(), copy->operand(0)->shape())) {
       VLOG(2) << copy->name() << " is not removable (shape mismatch)";
-      return false;
+      return not_removable("the copy changes the layout");
     }
     const CopyNodes& copy_node = copy_map_.at(copy);
     DCHECK(copy_node.src != nullptr);
@@ -1572,6 +1582,8 @@ class CopyRemover {
             << copy_node.src->value->ToShortString();
     VLOG(3) << "Source buffer values: " << ValueListToString(copy_node.src);
     VLOG(3) << "Dest buffer values: " << ValueListToString(copy_node.dest);
+    // The last pair of values whose live ranges are not ordered.
+    std::string unordered_live_ranges;
     // Checks whether the live range at src is before that defined by dest.
     auto CheckLiveRangeBefore = [&](ValueNode* src, ValueNode* dest) {
       for (ValueNode* next_dest = dest; next_dest != nullptr;
@@ -1581,6 +1593,10 @@ class CopyRemover {
           if (!LiveRangeBefore(*prev_src, *next_dest)) {
             VLOG(2) << "Live range of " << prev_src->value->ToShortString()
                     << " is not before " << next_dest->value->ToShortString();
+            unordered_live_ranges = absl::StrCat(
+                "the live range of ", prev_src->value->ToShortString(),
+                " is not before the live range of ",
+                next_dest->value->ToShortString());
             return false;
           }
         }
@@ -1683,7 +1699,7 @@ class CopyRemover {
       if (!live_range_before &&
           CheckLiveRangeInterference(copy_node.src, copy_node.dest,
                                      kMergeFirstDestInSource)) {
-        return false;
+        return not_removable(unordered_live_ranges);
       }
       VLOG(2) << "Splice dest after source.";
       // Splice in destination buffer values list right after 'src'.
@@ -1716,7 +1732,7 @@ class CopyRemover {
           CheckLiveRangeInterference(copy_node.src, copy_node.dest,
                                      kMergeLastSourceInDest)) {
         VLOG(2) << "Region-based analysis concludes interference.";
-        return false;
+        return not_removable(unordered_live_ranges);
       }
       VLOG(2) << "Splice src after prev of dest.";
       // Splice source buffer values list right after 'prev_dest'.
@@ -1725,7 +1741,10 @@ class CopyRemover {
       VLOG(2) << copy->name()
               << " copies value in middle of source buffer to value in middle "
                  "of destination buffer";
-      return false;
+      return not_removable(
+          "it copies a value in the middle of the source buffer to a value in "
+          "the middle of the destination buffer, e.g. between different "
+          "indices of a while loop state");
     }
 
     RemoveCopyValue(copy_node.dest);
@@ -2451,21 +2470,24 @@ static int64_t GetNumExistingCopies(
   return num_existing_copies;
 }
 
+// Use SequentialHloOrdering if the module has a schedule. The schedule can
+// provide more information on the ordering, allowing for detecting more
+// redundant copies.
+static std::unique_ptr<HloOrdering> MakeCopyRemovalOrdering(
+    const HloModule* module) {
+  if (module->has_schedule()) {
+    return std::make_unique<SequentialHloOrdering>(module->schedule());
+  }
+  return std::make_unique<DependencyHloOrdering>(module);
+}
+
 absl::Status CopyInsertion::RemoveUnnecessaryCopies(
     HloModule* module, bool check_live_range_ordering,
     const absl::flat_hash_set<absl::string_view>& execution_threads) {
   XLA_VLOG_LINES(
       4, module->ToString(HloPrintOptions().set_syntax_sugar_async_ops(false)));
 
-  // Use SequentialHloOrdering if the module has a schedule. The schedule can
-  // provide more information on the ordering, allowing for detecting more
-  // redundant copies.
-  std::unique_ptr<HloOrdering> ordering;
-  if (module->has_schedule()) {
-    ordering = std::make_unique<SequentialHloOrdering>(module->schedule());
-  } else {
-    ordering = std::make_unique<DependencyHloOrdering>(module);
-  }
+  std::unique_ptr<HloOrdering> ordering = MakeCopyRemovalOrdering(module);
 
   TF_ASSIGN_OR_RETURN(std::unique_ptr<HloAliasAnalysis> alias_analysis,
                       HloAliasAnalysis::Run(module, can_share_buffer_));
@@ -2524,6 +2546,79 @@ absl::Status CopyInsertion::RemoveUnnecessaryCopies(
   return absl::OkStatus();
 }
 
+absl::StatusOr<absl::btree_map<std::string, CopyInsertion::CopyExplanation>>
+CopyInsertion::ExplainCopies(
+    const HloModule* module,
+    const absl::flat_hash_set<absl::string_view>& execution_threads) {
+  std::unique_ptr<HloOrdering> ordering = MakeCopyRemovalOrdering(module);
+  TF_ASSIGN_OR_RETURN(std::unique_ptr<HloAliasAnalysis> alias_analysis,
+                      HloAliasAnalysis::Run(module, can_share_buffer_));
+  CopyRemover copy_remover(*module, *alias_analysis, ordering.get(),
+                           /*check_live_range_ordering=*/false,
+                           execution_threads);
+
+  // Like RemoveUnnecessaryCopies, but only updates the state of the copy
+  // remover, so that eliding a copy can make another one removable.
+  absl::flat_hash_set<const HloInstruction*> elided;
+  absl::btree_map<std::string, CopyExplanation> explanations;
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    explanations.clear();
+    for (const HloComputation* computation :
+         module->computations(execution_threads)) {
+      for (const HloInstruction* instruction : computation->instructions()) {
+        if (instruction->opcode() != HloOpcode::kCopy ||
+            elided.contains(instruction)) {
+          continue;
+        }
+        int64_t region_analysis_limit = use_region_based_live_range_analysis_;
+        std::string reason;
+        if (copy_remover.TryElideCopy(instruction, &region_analysis_limit,
+                                      &reason)) {
+          elided.insert(instruction);
+          changed = true;
+        } else {
+          explanations[instruction->name()] = CopyExplanation{
+              instruction->operand(0)->name(),
+              ShapeUtil::ByteSizeOf(instruction->shape(),
+                                    /*pointer_size=*/sizeof(void*)),
+              std::move(reason)};
+        }
+      }
+    }
+  }
+  return explanations;
+}
+
+absl::Status CopyInsertion::MaybeDumpCopyExplanations(
+    const HloModule& module, absl::string_view file_suffix,
+    const absl::flat_hash_set<absl::string_view>& execution_threads) {
+  if (!DumpingEnabledForHloModule(module) ||
+      !DumpingEnabledForHloPass(name(), module.config().debug_options())) {
+    return absl::OkStatus();
+  }
+  TF_ASSIGN_OR_RETURN(auto explanations,
+                      ExplainCopies(&module, execution_threads));
+  std::vector<std::pair<std::string, CopyExplanation>> copies(
+      explanations.begin(), explanations.end());
+  absl::c_stable_sort(copies, [](const auto& a, const auto& b) {
+    return a.second.size_bytes > b.second.size_bytes;
+  });
+  int64_t total_bytes = 0;
+  std::string contents;
+  for (const auto& [copy, explanation] : copies) {
+    absl::StrAppend(&contents, explanation.size_bytes, "\t", copy, "\t",
+                    explanation.operand, "\t", explanation.reason, "\n");
+    total_bytes += explanation.size_bytes;
+  }
+  contents = absl::StrCat("# bytes\tcopy\toperand\treason\n", contents,
+                          "# ", copies.size(), " copies, ", total_bytes,
+                          " bytes\n");
+  DumpToFileInDirOrStdout(module, "", file_suffix, contents);
+  return absl::OkStatus();
+}
+
 absl::StatusOr<bool> CopyInsertion::Run(
     HloModule* module,
     const absl::flat_hash_set<absl::string_view>& execution_threads) {
@@ -2589,6 +2684,8 @@ absl::StatusOr<bool> CopyInsertion::Run(
   VLOG(1) << "Num copies before copy-insertion: " << num_copies_before;
   VLOG(1) << "Num copies after copy-insertion: "
           << GetNumExistingCopies(module, execution_threads);
+  TF_RETURN_IF_ERROR(MaybeDumpCopyExplanations(
+      *module, "copy_insertion_explanations.txt", execution_threads));
 
   return true;
 }
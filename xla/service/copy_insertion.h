@@ -16,6 +16,10 @@ limitations under the License.
 #ifndef XLA_SERVICE_COPY_INSERTION_H_
 #define XLA_SERVICE_COPY_INSERTION_H_
 
+#include <cstdint>
+#include <string>
+
+#include "absl/container/btree_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -82,6 +86,28 @@ class CopyInsertion : public HloModulePass {
       HloModule* module, bool check_live_range_ordering = false,
       const absl::flat_hash_set<absl::string_view>& execution_threads = {});
 
+  // Why a copy can't be removed, see ExplainCopies.
+  struct CopyExplanation {
+    std::string operand;
+    // The size of the copied buffer in bytes.
+    int64_t size_bytes;
+    std::string reason;
+  };
+
+  // Returns, by copy name, why the copies in `module` can't be removed without
+  // introducing live range interference. Copies that RemoveUnnecessaryCopies
+  // would remove are omitted, and so are the copies that are only needed by
+  // AddSpecialCaseCopies. Doesn't change `module`.
+  absl::StatusOr<absl::btree_map<std::string, CopyExplanation>> ExplainCopies(
+      const HloModule* module,
+      const absl::flat_hash_set<absl::string_view>& execution_threads = {});
+
+  // If dumping is enabled for this pass and `module`, dumps the explanations of
+  // the copies in `module`, largest first, to a file with the given suffix.
+  absl::Status MaybeDumpCopyExplanations(
+      const HloModule& module, absl::string_view file_suffix,
+      const absl::flat_hash_set<absl::string_view>& execution_threads = {});
+
   // Add copies to address special constraints on the roots of computations not
   // related to live range interference:
   //
@@ -1425,6 +1425,49 @@ TEST_F(CopyInsertionTest, SwizzlingWhile) {
   EXPECT_THAT(xla_while->operand(0), op::Tuple(op::Copy(), op::Copy()));
 }
 
+TEST_F(CopyInsertionTest, ExplainsCopiesOfSwizzlingWhile) {
+  const std::string& hlo_string = R"(
+HloModule ExplainsCopiesOfSwizzlingWhile
+
+body {
+  param = (f32[], f32[]) parameter(0)
+  element_0 = f32[] get-tuple-element(param), index=0
+  element_1 = f32[] get-tuple-element(param), index=1
+  ROOT tuple = (f32[], f32[]) tuple(element_1, element_0)
+}
+
+condition {
+  param = (f32[], f32[]) parameter(0)
+  ROOT constant = pred[] constant(true)
+}
+
+ENTRY entry {
+  constant1 = f32[] constant(1)
+  constant2 = f32[] constant(2)
+  tuple = (f32[], f32[]) tuple(constant1, constant2)
+  ROOT while = (f32[], f32[]) while(tuple), condition=condition, body=body
+}
+)";
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+  InsertCopies(module.get());
+  CopyInsertion copy_insertion;
+  TF_ASSERT_OK_AND_ASSIGN(auto explanations,
+                          copy_insertion.ExplainCopies(module.get()));
+
+  // None of the copies in the body can be removed, since the loop state
+  // elements are swapped in every iteration.
+  const HloComputation* body = module->GetComputationWithName("body");
+  for (const HloInstruction* instruction : body->instructions()) {
+    if (instruction->opcode() == HloOpcode::kCopy) {
+      ASSERT_TRUE(explanations.contains(instruction->name()))
+          << instruction->name();
+      EXPECT_FALSE(explanations.at(instruction->name()).reason.empty());
+      EXPECT_EQ(explanations.at(instruction->name()).size_bytes, 4);
+    }
+  }
+}
+
 TEST_F(CopyInsertionTest, CrossingParameters) {
   // Test a case where two parameters' dataflow cross with each other while
   // input and output are aliased with same index:
@@ -161,6 +161,15 @@ CpuAotCompilationResultThunks::CpuAotCompilationResultThunks(
   *proto_.mutable_thunk_sequence() = thunks;
 }
 
+void CpuAotCompilationResultThunks::AddObjFileVariant(
+    absl::string_view isa, std::vector<std::string> obj_files) {
+  ObjFileVariantProto* variant = proto_.add_obj_file_variants();
+  variant->set_isa(std::string(isa));
+  for (std::string& obj_file : obj_files) {
+    variant->add_obj_files(std::move(obj_file));
+  }
+}
+
 absl::StatusOr<std::unique_ptr<Executable>>
 CpuAotCompilationResultThunks::LoadExecutable(
     [[maybe_unused]] Compiler* compiler,
@@ -84,12 +84,23 @@ class CpuAotCompilationOptions : public AotCompilationOptions {
   // The relocation model used for compilation.
   RelocationModel relocation_model() const { return relocation_model_; }
 
+  // Additional instruction sets to compile kernels for ("AVX2", "AVX512",
+  // etc.), ordered from the least to the most capable one. Object files for
+  // each variant are stored next to the baseline object files compiled for
+  // `cpu_name`, and at load time XLA picks the best variant supported by the
+  // host CPU. Only supported by the thunks runtime.
+  const std::vector<std::string>& isa_variants() const { return isa_variants_; }
+  void set_isa_variants(std::vector<std::string> isa_variants) {
+    isa_variants_ = std::move(isa_variants);
+  }
+
  private:
   const std::string triple_;
   const std::string cpu_name_;
   const std::string features_;
   const std::string entry_point_name_;
   const RelocationModel relocation_model_;
+  std::vector<std::string> isa_variants_;
 };
 
 // Temporary base class for CpuAotCompilationResultLegacy and
@@ -173,6 +184,10 @@ class CpuAotCompilationResultThunks : public CpuAotCompilationResult {
 
   const CompilationResultProto& proto() const { return proto_; }
 
+  // Adds object files compiled for the given instruction set `isa`.
+  void AddObjFileVariant(absl::string_view isa,
+                         std::vector<std::string> obj_files);
+
   std::vector<absl::string_view> obj_files() const {
     std::vector<absl::string_view> obj_files;
     for (const auto& obj_file : proto_.obj_files()) {
@@ -24,6 +24,7 @@ limitations under the License.
 #include "xla/literal_util.h"
 #include "xla/service/compiler.h"
 #include "xla/service/cpu/cpu_aot_compilation_result.h"
+#include "xla/service/cpu/executable.pb.h"
 #include "xla/service/cpu/test_target_triple_helper.h"
 #include "xla/service/executable.h"
 #include "xla/service/hlo_runner.h"
@@ -126,6 +127,117 @@ ENTRY e {
   test("Test kHloAdd2", kHloAdd2, 1, 3);
 }
 
+TEST_F(CpuAotCompilerTest, AheadOfTimeCompilationWithIsaVariants) {
+  constexpr absl::string_view kHlo = R"(
+add {
+  p0 = f32[1024] parameter(0)
+  p1 = f32[1024] parameter(1)
+  ROOT a = f32[1024] add(p0, p1)
+}
+
+ENTRY e {
+  p0 = f32[1024] parameter(0)
+  p1 = f32[1024] parameter(1)
+  ROOT r = f32[1024] fusion(p0, p1), kind=kLoop, calls=add
+})";
+
+#if defined(__aarch64__)
+  std::vector<std::string> isa_variants = {"NEON", "SVE"};
+#elif defined(__x86_64__)
+  std::vector<std::string> isa_variants = {"AVX", "AVX2", "AVX512"};
+#else
+  GTEST_SKIP() << "ISA variants are not supported on this platform";
+#endif
+
+  TF_ASSERT_OK_AND_ASSIGN(se::Platform * platform,
+                          se::PlatformManager::PlatformWithName("host"));
+  TF_ASSERT_OK_AND_ASSIGN(se::StreamExecutor * stream_exec,
+                          platform->ExecutorForDevice(0));
+
+  Compiler* compiler = backend().compiler();
+  ASSERT_NE(compiler, nullptr);
+
+  CpuAotCompilationOptions aot_options(
+      /*triple=*/kTargetTripleForHost, /*cpu_name=*/kTargetCpuForHost,
+      /*features=*/"",
+      /*entry_point_name=*/"entry",
+      /*relocation_model=*/CpuAotCompilationOptions::RelocationModel::BigPic);
+  aot_options.set_executor(stream_exec);
+  aot_options.set_isa_variants(isa_variants);
+
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(kHlo));
+  auto module_group = std::make_unique<HloModuleGroup>(std::move(module));
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::vector<std::unique_ptr<AotCompilationResult>> aot_results,
+      compiler->CompileAheadOfTime(std::move(module_group), aot_options));
+
+  auto* thunks_result =
+      dynamic_cast<CpuAotCompilationResultThunks*>(aot_results[0].get());
+  ASSERT_NE(thunks_result, nullptr);
+  ASSERT_EQ(thunks_result->proto().obj_file_variants_size(),
+            isa_variants.size());
+  for (int i = 0; i < isa_variants.size(); ++i) {
+    const ObjFileVariantProto& variant =
+        thunks_result->proto().obj_file_variants(i);
+    EXPECT_EQ(variant.isa(), isa_variants[i]);
+    EXPECT_EQ(variant.obj_files_size(),
+              thunks_result->proto().obj_files_size());
+  }
+
+  TF_ASSERT_OK_AND_ASSIGN(std::string serialized_aot_result,
+                          aot_results[0]->SerializeAsString());
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<AotCompilationResult> aot_result,
+      compiler->LoadAotCompilationResult(serialized_aot_result));
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<Executable> executable,
+      std::move(*aot_result).LoadExecutable(compiler, stream_exec));
+  std::unique_ptr<OpaqueExecutable> wrapped_executable =
+      test_runner_as_hlo_runner().WrapExecutable(std::move(executable));
+
+  std::vector<float> lhs(1024), rhs(1024), expected(1024);
+  for (int i = 0; i < 1024; ++i) {
+    lhs[i] = i;
+    rhs[i] = 2 * i;
+    expected[i] = 3 * i;
+  }
+  const Literal literal_lhs = LiteralUtil::CreateR1<float>(lhs);
+  const Literal literal_rhs = LiteralUtil::CreateR1<float>(rhs);
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      Literal result,
+      test_runner_as_hlo_runner().ExecuteWithExecutable(
+          wrapped_executable.get(), {&literal_lhs, &literal_rhs}));
+  EXPECT_TRUE(
+      LiteralTestUtil::Equal(result, LiteralUtil::CreateR1<float>(expected)));
+}
+
+TEST_F(CpuAotCompilerTest, AheadOfTimeCompilationWithUnknownIsaVariant) {
+  constexpr absl::string_view kHlo = R"(
+ENTRY e {
+  p = s32[] parameter(0)
+  ROOT a = s32[] add(p, p)
+})";
+
+  Compiler* compiler = backend().compiler();
+  ASSERT_NE(compiler, nullptr);
+
+  CpuAotCompilationOptions aot_options(
+      /*triple=*/kTargetTripleForHost, /*cpu_name=*/kTargetCpuForHost,
+      /*features=*/"",
+      /*entry_point_name=*/"entry",
+      /*relocation_model=*/CpuAotCompilationOptions::RelocationModel::BigPic);
+  aot_options.set_isa_variants({"NOT_AN_ISA"});
+
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(kHlo));
+  auto module_group = std::make_unique<HloModuleGroup>(std::move(module));
+  EXPECT_FALSE(
+      compiler->CompileAheadOfTime(std::move(module_group), aot_options).ok());
+}
+
 }  // namespace
 }  // namespace cpu
 }  // namespace xla
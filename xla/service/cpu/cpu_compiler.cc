@@ -44,6 +44,7 @@ limitations under the License.
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/blocking_counter.h"
 #include "absl/types/span.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
@@ -64,6 +65,7 @@ limitations under the License.
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/CodeGen.h"
 #include "llvm/Support/Error.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/MemoryBufferRef.h"
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/raw_ostream.h"
@@ -87,6 +89,7 @@ limitations under the License.
 #include "xla/backends/cpu/codegen/execution_engine.h"
 #include "xla/backends/cpu/codegen/ir_compiler.h"
 #include "xla/backends/cpu/codegen/jit_compiler.h"
+#include "xla/backends/cpu/codegen/object_file_cache.h"
 #include "xla/backends/cpu/codegen/object_loader.h"
 #include "xla/backends/cpu/codegen/target_machine_features.h"
 #include "xla/backends/cpu/constant_allocation.h"
@@ -231,6 +234,7 @@ limitations under the License.
 #include "tsl/platform/casts.h"
 #include "tsl/platform/cpu_info.h"
 #include "tsl/platform/logging.h"  // IWYU pragma: keep
+#include "tsl/platform/protobuf.h"
 #include "tsl/profiler/lib/traceme.h"
 #include "tsl/profiler/lib/traceme_encode.h"
 
@@ -1033,6 +1037,45 @@ absl::Status CreateHloProfilingArtifacts(
   return absl::OkStatus();
 }
 
+// Runs cost analysis on all non-fusion computations of the module, so that
+// thunk emitter can record thunk cost estimates for the critical path thunk
+// scheduling. Returns nullptr if critical path scheduling is disabled.
+absl::StatusOr<std::unique_ptr<HloCostAnalysis>> CreateThunkCostAnalysis(
+    const HloModule& module) {
+  if (!module.config()
+           .debug_options()
+           .xla_cpu_enable_critical_path_thunk_priority()) {
+    return nullptr;
+  }
+
+  auto cost_analysis =
+      std::make_unique<HloCostAnalysis>(CpuExecutable::ShapeSizeBytes);
+  for (const HloComputation* computation : module.MakeNonfusionComputations()) {
+    TF_RETURN_IF_ERROR(computation->Accept(cost_analysis.get()));
+  }
+  return cost_analysis;
+}
+
+// Loads thunk profile recorded by a previous run of the module, so that thunk
+// emitter can use measured thunk execution times as thunk cost estimates.
+// Returns std::nullopt if thunk profile path is not set.
+absl::StatusOr<std::optional<ThunkProfileProto>> LoadThunkProfile(
+    const HloModule& module) {
+  const std::string& path =
+      module.config().debug_options().xla_cpu_experimental_thunk_profile_path();
+  if (path.empty()) {
+    return std::nullopt;
+  }
+
+  ThunkProfileProto thunk_profile;
+  TF_RETURN_IF_ERROR(
+      tsl::ReadTextOrBinaryProto(tsl::Env::Default(), path, &thunk_profile));
+
+  VLOG(1) << "Loaded thunk profile with " << thunk_profile.entries_size()
+          << " entries from " << path << " for module " << module.name();
+  return thunk_profile;
+}
+
 }  // namespace
 
 absl::StatusOr<std::unique_ptr<HloModule>> CpuCompiler::RunHloPasses(
@@ -1074,16 +1117,35 @@ static void DumpModuleToFile(const llvm::Module& llvm_module,
       absl::string_view(obj_file.getData().data(), obj_file.getData().size()));
 }
 
+// LLVM module flag that holds the object file cache key of the module.
+static constexpr absl::string_view kObjectFileCacheKeyFlag =
+    "xla_object_file_cache_key";
+
 // Post-compilation callback functor for use by SimpleOrcJIT.
 //
-// Dumps machine code if dumping is enabled for the module.
+// Dumps machine code if dumping is enabled for the module, and inserts it into
+// the object file cache if the module has an object file cache key.
 static std::function<void(const llvm::Module&, const llvm::object::ObjectFile&)>
-CreateOrcJITPostCompilationHook(const HloModule* hlo_module,
-                                std::vector<std::string>* obj_files) {
+CreateOrcJITPostCompilationHook(
+    const HloModule* hlo_module, std::vector<std::string>* obj_files,
+    const ObjectFileCache* object_file_cache = nullptr) {
   return [=](const llvm::Module& llvm_module,
              const llvm::object::ObjectFile& obj_file) {
     if (obj_files) obj_files->push_back(obj_file.getData().str());
 
+    if (object_file_cache) {
+      if (auto* key = llvm::dyn_cast_or_null<llvm::MDString>(
+              llvm_module.getModuleFlag(kObjectFileCacheKeyFlag))) {
+        absl::Status inserted = object_file_cache->Insert(
+            key->getString(), absl::string_view(obj_file.getData().data(),
+                                                obj_file.getData().size()));
+        if (!inserted.ok()) {
+          LOG(WARNING) << "Failed to insert object file into the cache: "
+                       << inserted;
+        }
+      }
+    }
+
     if (DumpingEnabledForHloModule(*hlo_module)) {
       DumpModuleToFile(llvm_module, obj_file, *hlo_module);
     }
@@ -1180,25 +1242,35 @@ static void RemoveUnusedSymbols(llvm::Module& module) {
   }
 }
 
-// Clones a ThreadSafeModule from the given LLVM module in a new LLVM context.
+// Serializes a part of the LLVM module after a split to bitcode.
 //
 // To enable parallel compilation, each LLVM module has to be owned by a
-// separate LLVM context. We take each part of the original module after a
-// split, and clone it into a new LLVM context.
-static llvm::orc::ThreadSafeModule CloneAsThreadSafeModule(
-    int64_t part, std::unique_ptr<llvm::Module> module) {
+// separate LLVM context. There is no way to clone a module from one context to
+// another, so we serialize each part of the original module after a split to
+// bitcode, and parse it back into a new LLVM context. Serialization reads the
+// LLVM context shared by all parts and must be done sequentially, however
+// parsing into new contexts is independent and is done in parallel.
+static llvm::SmallString<0> SerializeModulePart(int64_t part,
+                                                const llvm::Module& module) {
   TraceMe trace([&] {
-    return TraceMeEncode("CpuCompiler::CloneAsThreadSafeModule",
-                         {{"part", part}});
+    return TraceMeEncode("CpuCompiler::SerializeModulePart", {{"part", part}});
   });
 
-  // There is no way to clone a module from one context to another, so we need
-  // to serialize the module to bitcode and parse it back into the new context.
   llvm::SmallString<0> bc;
   llvm::raw_svector_ostream bcos(bc);
-  llvm::WriteBitcodeToFile(*module, bcos);
+  llvm::WriteBitcodeToFile(module, bcos);
+  return bc;
+}
+
+// Parses a serialized LLVM module part into a ThreadSafeModule that owns its
+// own LLVM context.
+static llvm::orc::ThreadSafeModule ParseAsThreadSafeModule(
+    int64_t part, const llvm::SmallString<0>& bc) {
+  TraceMe trace([&] {
+    return TraceMeEncode("CpuCompiler::ParseAsThreadSafeModule",
+                         {{"part", part}});
+  });
 
-  // Parse module back into its own LLVM context.
   auto clone_context = std::make_unique<llvm::LLVMContext>();
   auto clone_module = llvm::parseBitcodeFile(
       llvm::MemoryBufferRef(
@@ -1210,6 +1282,32 @@ static llvm::orc::ThreadSafeModule CloneAsThreadSafeModule(
                                      std::move(clone_context));
 }
 
+// Parses serialized LLVM module `parts` into ThreadSafeModules in parallel using
+// the compilation thread pool.
+static std::vector<llvm::orc::ThreadSafeModule> ParseAsThreadSafeModules(
+    absl::Span<const llvm::SmallString<0>> bcs, absl::Span<const size_t> parts) {
+  TraceMe trace([&] {
+    return TraceMeEncode("CpuCompiler::ParseAsThreadSafeModules",
+                         {{"num_parts", parts.size()}});
+  });
+
+  std::vector<llvm::orc::ThreadSafeModule> modules(parts.size());
+  if (parts.size() == 1) {
+    modules[0] = ParseAsThreadSafeModule(parts[0], bcs[parts[0]]);
+    return modules;
+  }
+
+  absl::BlockingCounter counter(parts.size());
+  for (size_t i = 0; i < parts.size(); ++i) {
+    GetCompilationThreadPool()->Schedule([&, i] {
+      modules[i] = ParseAsThreadSafeModule(parts[i], bcs[parts[i]]);
+      counter.DecrementCount();
+    });
+  }
+  counter.Wait();
+  return modules;
+}
+
 namespace {
 // Compiled symbols (kernels and comparators) from a single LLVM module part.
 struct CompiledSymbolsPart {
@@ -1386,11 +1484,21 @@ CpuCompiler::CompileCpuExecutable(std::unique_ptr<HloModule> module) {
       /*disable_loop_unrolling=*/options::DisableLoopUnrolling(config),
   };
 
+  // Optional persistent cache of compiled object files.
+  std::optional<ObjectFileCache> object_file_cache;
+  if (!debug_options.xla_cpu_experimental_object_cache_dir().empty()) {
+    object_file_cache.emplace(
+        debug_options.xla_cpu_experimental_object_cache_dir());
+  }
+  IrCompiler::Options object_file_cache_options = ir_compiler_options;
+
   // Compiler hooks to intercept compiled LLVM IR modules.
   IrCompiler::CompilationHooks ir_compiler_hooks{
       pre_optimization_ir_hook,
       post_optimization_ir_hook,
-      CreateOrcJITPostCompilationHook(module.get(), &obj_files),
+      CreateOrcJITPostCompilationHook(
+          module.get(), &obj_files,
+          object_file_cache ? &*object_file_cache : nullptr),
   };
 
   // Definition generator to link with XLA:CPU host runtime symbols.
@@ -1491,8 +1599,14 @@ CpuCompiler::CompileCpuExecutable(std::unique_ptr<HloModule> module) {
     // Thunk emitter is responsible for building a Thunk sequence that will
     // resolved kernels in the compiled LLVM module and execute them together
     // with Thunks implemented as library calls (e.g. oneDNN or Eigen).
-    ThunkEmitter thunk_emitter(ir_emitter2, *assignment,
-                               target_machine_features, module->config());
+    TF_ASSIGN_OR_RETURN(std::unique_ptr<HloCostAnalysis> thunk_cost_analysis,
+                        CreateThunkCostAnalysis(*module));
+    TF_ASSIGN_OR_RETURN(std::optional<ThunkProfileProto> thunk_profile,
+                        LoadThunkProfile(*module));
+    ThunkEmitter thunk_emitter(
+        ir_emitter2, *assignment, target_machine_features, module->config(),
+        thunk_cost_analysis.get(),
+        thunk_profile.has_value() ? &*thunk_profile : nullptr);
     TF_ASSIGN_OR_RETURN(ThunkSequence thunks,
                         thunk_emitter.EmitEntryComputation(*module));
 
@@ -1569,6 +1683,18 @@ CpuCompiler::CompileCpuExecutable(std::unique_ptr<HloModule> module) {
             << " kernels and " << ir_emitter2.comparators().size()
             << " comparators";
 
+    // Serialized LLVM module parts, where the index of the part is the index
+    // of the dylib it will be added to.
+    std::vector<llvm::SmallString<0>> module_parts;
+
+    // Object file cache keys of the LLVM module parts (if cache is enabled).
+    std::vector<std::string> module_part_keys;
+    std::string compiler_fingerprint =
+        object_file_cache ? ObjectFileCache::CompilerFingerprint(
+                                *jit_compiler.target_machine(),
+                                object_file_cache_options)
+                          : "";
+
     int dylib_index = 0;
     auto add_jit_module = [&](std::unique_ptr<llvm::Module> llvm_module_part) {
       // Collect symbols that are compiled in this LLVM module part.
@@ -1579,10 +1705,56 @@ CpuCompiler::CompileCpuExecutable(std::unique_ptr<HloModule> module) {
       std::string dump = llvm_ir::DumpToString(llvm_module_part.get());
       VLOG(5) << "Adding compilation module:\n" << dump;
 
-      // Clone LLVM module part into its own thread safe context.
-      auto tsm =
-          CloneAsThreadSafeModule(dylib_index, std::move(llvm_module_part));
-      TF_CHECK_OK(jit_compiler.AddModule(std::move(tsm), dylib_index++));
+      // Serialize LLVM module part to clone it into its own thread safe
+      // context once all parts are collected.
+      module_parts.push_back(
+          SerializeModulePart(dylib_index++, *llvm_module_part));
+      if (object_file_cache) {
+        module_part_keys.push_back(ObjectFileCache::Key(
+            absl::string_view(module_parts.back().data(),
+                              module_parts.back().size()),
+            compiler_fingerprint));
+      }
+    };
+
+    // Adds all collected LLVM module parts to the JIT compiler. Parts that
+    // were compiled before are loaded from the object file cache, and all
+    // other parts are cloned into their own thread safe contexts in parallel.
+    auto add_jit_module_parts = [&] {
+      std::vector<size_t> uncached_parts;
+      for (size_t i = 0; i < module_parts.size(); ++i) {
+        std::optional<std::string> obj_file;
+        if (object_file_cache) {
+          obj_file = object_file_cache->Lookup(module_part_keys[i]);
+        }
+        if (!obj_file.has_value()) {
+          uncached_parts.push_back(i);
+          continue;
+        }
+        VLOG(3) << "Load LLVM module part " << i << " from the object cache";
+        TF_CHECK_OK(jit_compiler.AddObjFile(
+            llvm::MemoryBuffer::getMemBufferCopy(
+                *obj_file,
+                absl::StrFormat("%s_part_%02d", kXlaModuleIdentifier, i)),
+            i));
+        obj_files.push_back(*std::move(obj_file));
+      }
+
+      std::vector<llvm::orc::ThreadSafeModule> tsms =
+          ParseAsThreadSafeModules(module_parts, uncached_parts);
+      for (size_t i = 0; i < tsms.size(); ++i) {
+        size_t part = uncached_parts[i];
+        if (object_file_cache) {
+          tsms[i].withModuleDo([&](llvm::Module& m) {
+            m.addModuleFlag(
+                llvm::Module::Warning, kObjectFileCacheKeyFlag,
+                llvm::MDString::get(m.getContext(), module_part_keys[part]));
+          });
+        }
+        TF_CHECK_OK(jit_compiler.AddModule(std::move(tsms[i]), part));
+      }
+      module_parts.clear();
+      module_part_keys.clear();
     };
 
     // If there are extra parts, compile them first, since we must
@@ -1624,9 +1796,12 @@ CpuCompiler::CompileCpuExecutable(std::unique_ptr<HloModule> module) {
       llvm_module.reset();
       llvm_context.reset();
 
+      add_jit_module_parts();
+
     } else {
       VLOG(3) << "Compile LLVM module without splitting (max split count: "
               << parallel_codegen_split_count << ")";
+      add_jit_module_parts();
       compiled_parts.push_back(
           CollectCompiledSymbolsPart(ir_emitter2, *llvm_module));
       TF_CHECK_OK(jit_compiler.AddModule(llvm::orc::ThreadSafeModule(
@@ -1907,6 +2082,31 @@ CpuCompiler::CompileAheadOfTime(std::unique_ptr<HloModuleGroup> module_group,
   std::unique_ptr<llvm::TargetMachine> target_machine =
       target_machine_builder();
 
+  // Additional ISA variants of the compiled kernels. HLO passes still run for
+  // the baseline target machine, and every variant compiles the same LLVM IR
+  // for a newer CPU generation.
+  std::vector<AotIsaVariant> isa_variants;
+  for (const std::string& isa : options.isa_variants()) {
+    std::optional<tsl::port::CPUFeature> feature = CpuFeatureFromString(isa);
+    if (!feature.has_value()) {
+      return InvalidArgument("Unsupported CPU ISA variant: %s", isa);
+    }
+    bool is_aarch64_feature = *feature == tsl::port::AARCH64_NEON ||
+                              *feature == tsl::port::AARCH64_SVE ||
+                              *feature == tsl::port::AARCH64_SVE2;
+    if (is_aarch64_feature != triple.isAArch64()) {
+      return InvalidArgument("CPU ISA variant %s is not compatible with %s",
+                             isa, triple.getTriple());
+    }
+    std::string cpu_name(CpuTargetFromMaxFeature(*feature));
+    isa_variants.push_back(AotIsaVariant{
+        isa, *feature, [&, cpu_name]() {
+          return absl::WrapUnique(target->createTargetMachine(
+              triple.getTriple(), cpu_name, /*Features=*/"", target_options,
+              reloc_model, std::nullopt, opt_level));
+        }});
+  }
+
   // Compile must be thread-safe so create a new LLVM context for the module.
   mlir::MLIRContext mlir_context;
   llvm::LLVMContext llvm_context;
@@ -1926,8 +2126,13 @@ CpuCompiler::CompileAheadOfTime(std::unique_ptr<HloModuleGroup> module_group,
       TF_ASSIGN_OR_RETURN(results.emplace_back(),
                           CompileAheadOfTimeThunks(
                               std::move(hlo_module), target_machine_builder,
-                              options, triple, pic_level, pie_level));
+                              isa_variants, options, triple, pic_level,
+                              pie_level));
     } else {
+      if (!isa_variants.empty()) {
+        return InvalidArgument(
+            "CPU ISA variants are supported only by the thunks runtime");
+      }
       TF_ASSIGN_OR_RETURN(results.emplace_back(),
                           CompileAheadOfTimeLegacy(
                               std::move(hlo_module), target_machine_builder,
@@ -2103,6 +2308,7 @@ absl::StatusOr<std::unique_ptr<AotCompilationResult>>
 CpuCompiler::CompileAheadOfTimeThunks(
     std::unique_ptr<HloModule> module,
     IrCompiler::TargetMachineBuilder target_machine_builder,
+    absl::Span<const AotIsaVariant> isa_variants,
     const CpuAotCompilationOptions& aot_options, const llvm::Triple& triple,
     const llvm::PICLevel::Level& pic_level,
     const llvm::PIELevel::Level& pie_level) {
@@ -2184,8 +2390,14 @@ CpuCompiler::CompileAheadOfTimeThunks(
   // Thunk emitter is responsible for building a Thunk sequence that will
   // resolved kernels in the compiled LLVM module and execute them together
   // with Thunks implemented as library calls (e.g. oneDNN or Eigen).
-  ThunkEmitter thunk_emitter(ir_emitter2, *assignment, target_machine_features,
-                             module->config());
+  TF_ASSIGN_OR_RETURN(std::unique_ptr<HloCostAnalysis> thunk_cost_analysis,
+                      CreateThunkCostAnalysis(*module));
+  TF_ASSIGN_OR_RETURN(std::optional<ThunkProfileProto> thunk_profile,
+                      LoadThunkProfile(*module));
+  ThunkEmitter thunk_emitter(
+      ir_emitter2, *assignment, target_machine_features, module->config(),
+      thunk_cost_analysis.get(),
+      thunk_profile.has_value() ? &*thunk_profile : nullptr);
   TF_ASSIGN_OR_RETURN(ThunkSequence thunks,
                       thunk_emitter.EmitEntryComputation(*module));
 
@@ -2258,6 +2470,9 @@ CpuCompiler::CompileAheadOfTimeThunks(
       post_codegen_hook,
   };
 
+  // Variants reuse the baseline compiler options, except for the max ISA.
+  IrCompiler::Options variant_ir_compiler_options = ir_compiler_options;
+
   IrCompiler ir_compiler(std::move(target_machine_builder),
                          std::move(ir_compiler_options),
                          std::move(ir_compiler_hooks));
@@ -2315,6 +2530,25 @@ CpuCompiler::CompileAheadOfTimeThunks(
     linker.linkInModule(std::move(cloned_module.get()));
   }
 
+  // Compile ISA variants from the clones of the linked module, as the IR
+  // compiler optimizes the module in place.
+  std::vector<std::vector<std::string>> variant_obj_files;
+  for (const AotIsaVariant& variant : isa_variants) {
+    VLOG(2) << "Compile AOT kernels for ISA variant: " << variant.isa;
+    std::unique_ptr<llvm::Module> variant_module =
+        llvm::CloneModule(*llvm_module);
+
+    IrCompiler::Options variant_options = variant_ir_compiler_options;
+    variant_options.max_cpu_feature = variant.max_cpu_feature;
+
+    IrCompiler variant_compiler(variant.target_machine_builder,
+                                std::move(variant_options),
+                                IrCompiler::CompilationHooks{});
+    std::unique_ptr<llvm::MemoryBuffer> obj_file =
+        cantFail(variant_compiler(*variant_module));
+    variant_obj_files.push_back({obj_file->getBuffer().str()});
+  }
+
   cantFail(ir_compiler(*llvm_module));
 
   for (const CompiledSymbolsPart& part : compiled_parts) {
@@ -2385,12 +2619,21 @@ CpuCompiler::CompileAheadOfTimeThunks(
                 cpu_executable->hlo_profile_printer_data())
           : nullptr;
 
-  return CpuAotCompilationResultThunks::Create(
-      &cpu_executable->module(), &cpu_executable->buffer_assignment(),
-      cpu_executable->module_name(), std::move(obj_files),
-      cpu_executable->get_compiled_symbols_proto(), thunk_sequence,
-      std::move(*cpu_executable).consume_function_library().release(),
-      std::move(executable_hlo_profile_printer_data));
+  TF_ASSIGN_OR_RETURN(
+      std::unique_ptr<CpuAotCompilationResultThunks> result,
+      CpuAotCompilationResultThunks::Create(
+          &cpu_executable->module(), &cpu_executable->buffer_assignment(),
+          cpu_executable->module_name(), std::move(obj_files),
+          cpu_executable->get_compiled_symbols_proto(), thunk_sequence,
+          std::move(*cpu_executable).consume_function_library().release(),
+          std::move(executable_hlo_profile_printer_data)));
+
+  for (size_t i = 0; i < isa_variants.size(); ++i) {
+    result->AddObjFileVariant(isa_variants[i].isa,
+                              std::move(variant_obj_files[i]));
+  }
+
+  return std::move(result);
 }
 
 se::Platform::Id CpuCompiler::PlatformId() const {
@@ -2403,6 +2646,22 @@ HloCostAnalysis::ShapeSizeFunction CpuCompiler::ShapeSizeBytesFunction() const {
 
 namespace {
 
+// Returns object files of the most capable ISA variant supported by the host
+// CPU, or the baseline object files if none of the variants is supported.
+const tsl::protobuf::RepeatedPtrField<std::string>& SelectHostObjFiles(
+    const CompilationResultProto& proto) {
+  for (auto it = proto.obj_file_variants().rbegin();
+       it != proto.obj_file_variants().rend(); ++it) {
+    std::optional<tsl::port::CPUFeature> feature =
+        CpuFeatureFromString(it->isa());
+    if (feature.has_value() && tsl::port::TestCPUFeature(*feature)) {
+      VLOG(2) << "Load object files compiled for ISA variant: " << it->isa();
+      return it->obj_files();
+    }
+  }
+  return proto.obj_files();
+}
+
 // TODO(basioli): This should be removed once new runtime is implemented, and
 // CpuAotCompilationResult will be the only implementation of
 // AotCompilationResult. This is still used as it allows us to `Export` and
@@ -2548,12 +2807,15 @@ CpuExecutableAotCompilationResult::LoadExecutable(
 
   // We might have an XLA:CPU executable that has only runtime thunks and
   // doesn't have any corresponding object files, and it's absolutely fine.
-  VLOG(2) << "Load XLA:CPU executable from " << proto_.obj_files_size()
+  const tsl::protobuf::RepeatedPtrField<std::string>& obj_files =
+      SelectHostObjFiles(proto_);
+
+  VLOG(2) << "Load XLA:CPU executable from " << obj_files.size()
           << " object files; entry_function_name="
           << proto_.entry_function_name();
 
   size_t obj_file_index = 0;
-  for (auto& obj_file : proto_.obj_files()) {
+  for (auto& obj_file : obj_files) {
     llvm::StringRef data(obj_file.data(), obj_file.size());
     TF_RETURN_IF_ERROR(
         object_loader.AddObjFile(llvm::MemoryBuffer::getMemBuffer(
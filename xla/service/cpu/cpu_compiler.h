@@ -22,6 +22,7 @@ limitations under the License.
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/types/span.h"
 #include "llvm/Support/CodeGen.h"
 #include "llvm/Target/TargetMachine.h"
 #include "llvm/TargetParser/Triple.h"
@@ -42,6 +43,7 @@ limitations under the License.
 #include "xla/stream_executor/platform.h"
 #include "xla/stream_executor/stream_executor.h"
 #include "xla/util.h"
+#include "tsl/platform/cpu_info.h"
 
 namespace mlir {
 class DialectRegistry;
@@ -127,10 +129,18 @@ class CpuCompiler : public LLVMCompiler {
       const llvm::PICLevel::Level& pic_level,
       const llvm::PIELevel::Level& pie_level);
 
+  // Target machine for compiling an additional ISA variant of AOT kernels.
+  struct AotIsaVariant {
+    std::string isa;
+    tsl::port::CPUFeature max_cpu_feature;
+    IrCompiler::TargetMachineBuilder target_machine_builder;
+  };
+
   absl::StatusOr<std::unique_ptr<AotCompilationResult>>
   CompileAheadOfTimeThunks(
       std::unique_ptr<HloModule> module,
       IrCompiler::TargetMachineBuilder target_machine_builder,
+      absl::Span<const AotIsaVariant> isa_variants,
       const CpuAotCompilationOptions& aot_options, const llvm::Triple& triple,
       const llvm::PICLevel::Level& pic_level,
       const llvm::PIELevel::Level& pie_level);
@@ -43,6 +43,7 @@ limitations under the License.
 #include "xla/backends/cpu/runtime/thread_pool_task_runner.h"
 #include "xla/backends/cpu/runtime/thunk.h"
 #include "xla/backends/cpu/runtime/thunk_executor.h"
+#include "xla/backends/cpu/runtime/thunk_profile.h"
 #include "xla/executable_run_options.h"
 #include "xla/hlo/ir/hlo_computation.h"
 #include "xla/hlo/ir/hlo_input_output_alias_config.h"
@@ -52,6 +53,7 @@ limitations under the License.
 #include "xla/service/cpu/cpu_runtime.h"
 #include "xla/service/custom_call_status.h"
 #include "xla/service/custom_call_status_internal.h"
+#include "xla/service/dump.h"
 #include "xla/service/executable.h"
 #include "xla/service/hlo_execution_profile.h"
 #include "xla/service/hlo_profile_printer_data.pb.h"
@@ -120,8 +122,31 @@ absl::StatusOr<std::unique_ptr<CpuExecutable>> CpuExecutable::Create(
       std::move(hlo_profile_index_map), std::move(assignment)));
   executable->function_library_ = std::move(function_library);
 
-  TF_ASSIGN_OR_RETURN(executable->thunks_,
-                      ThunkExecutor::Create(std::move(thunks)));
+  // Use critical path priorities computed from thunk cost estimates if
+  // requested by the module config.
+  ThunkExecutor::Options thunk_executor_options;
+  if (executable->has_module() &&
+      executable->module()
+          .config()
+          .debug_options()
+          .xla_cpu_enable_critical_path_thunk_priority()) {
+    thunk_executor_options.ready_queue_type =
+        ThunkExecutor::Options::ReadyQueueType::kPriority;
+    thunk_executor_options.use_critical_path_priority = true;
+  }
+
+  // Record thunks execution profile if requested by the module config.
+  if (executable->has_module()) {
+    thunk_executor_options.profile_num_executions =
+        std::max(0, executable->module()
+                        .config()
+                        .debug_options()
+                        .xla_cpu_experimental_thunk_profile_num_executions());
+  }
+
+  TF_ASSIGN_OR_RETURN(
+      executable->thunks_,
+      ThunkExecutor::Create(std::move(thunks), thunk_executor_options));
 
   // Re-index constants by their allocation index to allow efficient lookup.
   for (auto& constant : constants) {
@@ -150,6 +175,13 @@ CpuExecutable::CpuExecutable(
 
 CpuExecutable::~CpuExecutable() {
   if (has_module()) {
+    // Dump recorded thunks execution profile, so that it can be used to guide
+    // thunk scheduling in later compilations of the same module.
+    if (has_thunks() && thunks_->profile()) {
+      DumpPerModuleProtobufToFile(
+          module(), thunks_->profile()->ToProto(thunks_->thunk_sequence()),
+          module().config().debug_options(), "thunk_profile");
+    }
     XlaDebugInfoManager::Get()->UnregisterModule(module().unique_id());
   }
 }
@@ -22,6 +22,7 @@ limitations under the License.
 
 #include "absl/algorithm/container.h"
 #include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/log/check.h"
 #include "absl/status/status.h"
 #include "xla/hlo/ir/hlo_casting_utils.h"
@@ -123,11 +124,65 @@ static bool OperandsAndResultMustHaveRowMajorLayout(
   return false;
 }
 
+// Returns the transposes and elementwise ops that sit between two row-major
+// (NHWC) convolutions, e.g. the transposes that ConvCanonicalization inserts
+// around an NCHW activation. Leaving their layouts unconstrained lets layout
+// assignment propagate the NHWC layout of the convolutions through them, so
+// that the transposes become bitcasts instead of physical transposes between
+// every pair of convolutions.
+static absl::flat_hash_set<const HloInstruction*>
+InstructionsBetweenConvolutions(
+    const HloComputation& computation,
+    const TargetMachineFeatures& target_machine_features) {
+  auto is_row_major_convolution = [&](const HloInstruction* instr) {
+    return instr->opcode() == HloOpcode::kConvolution &&
+           OperandsAndResultMustHaveRowMajorLayout(*instr,
+                                                   target_machine_features);
+  };
+  auto can_propagate_layout = [](const HloInstruction* instr) {
+    return instr->shape().IsArray() &&
+           (instr->opcode() == HloOpcode::kTranspose ||
+            instr->IsElementwise());
+  };
+
+  // Instructions reachable from a convolution through layout propagating ops.
+  std::vector<HloInstruction*> post_order =
+      computation.MakeInstructionPostOrder();
+  absl::flat_hash_set<const HloInstruction*> after_convolution;
+  for (const HloInstruction* instr : post_order) {
+    if (can_propagate_layout(instr) &&
+        absl::c_any_of(instr->operands(), [&](const HloInstruction* operand) {
+          return is_row_major_convolution(operand) ||
+                 after_convolution.contains(operand);
+        })) {
+      after_convolution.insert(instr);
+    }
+  }
+
+  // Of those, the ones that reach a convolution through layout propagating
+  // ops, and all of whose users are on such a path as well.
+  absl::flat_hash_set<const HloInstruction*> between_convolutions;
+  for (auto it = post_order.rbegin(); it != post_order.rend(); ++it) {
+    const HloInstruction* instr = *it;
+    if (after_convolution.contains(instr) && !instr->users().empty() &&
+        computation.root_instruction() != instr &&
+        absl::c_all_of(instr->users(), [&](const HloInstruction* user) {
+          return is_row_major_convolution(user) ||
+                 between_convolutions.contains(user);
+        })) {
+      between_convolutions.insert(instr);
+    }
+  }
+  return between_convolutions;
+}
+
 absl::Status CpuLayoutAssignment::AddBackendConstraints(
     LayoutConstraints* constraints) {
   ShouldMakeOperandColMajorCache cache;
 
   const HloComputation* computation = constraints->computation();
+  const absl::flat_hash_set<const HloInstruction*> between_convolutions =
+      InstructionsBetweenConvolutions(*computation, target_machine_features_);
   for (auto* instruction : computation->instructions()) {
     if (OperandsAndResultMustHaveRowMajorLayout(*instruction,
                                                 target_machine_features_)) {
@@ -156,6 +211,9 @@ absl::Status CpuLayoutAssignment::AddBackendConstraints(
       TF_RETURN_IF_ERROR(SetInstructionLayout(
           ShapeUtil::MoveDimToMajor(ag->shape(), ag->all_gather_dimension()),
           ag));
+    } else if (between_convolutions.contains(instruction)) {
+      // Layouts are propagated from the surrounding convolutions.
+      continue;
     } else {
       for (int64_t operand_no = 0; operand_no < instruction->operand_count();
            ++operand_no) {
@@ -481,5 +481,54 @@ ENTRY BatchDotLayoutMustBeRowMajor {
           op::ShapeWithLayout(
               computation_layout.parameter_layout(1).shape()))));
 }
+
+TEST_F(CpuLayoutAssignmentTest, TransposesBetweenConvolutionsAreBitcasts) {
+  // The transposes that ConvCanonicalization inserts around the NCHW
+  // activation between two convolutions.
+  const char* hlo_string = R"(
+HloModule TransposesBetweenConvolutionsAreBitcasts
+
+ENTRY TransposesBetweenConvolutionsAreBitcasts {
+  input = f32[1,8,8,4] parameter(0)
+  kernel0 = f32[3,3,4,4] parameter(1)
+  kernel1 = f32[3,3,4,4] parameter(2)
+  conv0 = f32[1,8,8,4] convolution(input, kernel0), window={size=3x3 pad=1_1x1_1}, dim_labels=b01f_01io->b01f
+  nchw = f32[1,4,8,8] transpose(conv0), dimensions={0,3,1,2}
+  zero = f32[] constant(0)
+  zeros = f32[1,4,8,8] broadcast(zero), dimensions={}
+  relu = f32[1,4,8,8] maximum(nchw, zeros)
+  nhwc = f32[1,8,8,4] transpose(relu), dimensions={0,2,3,1}
+  ROOT conv1 = f32[1,8,8,4] convolution(nhwc, kernel1), window={size=3x3 pad=1_1x1_1}, dim_labels=b01f_01io->b01f
+}
+)";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+
+  HloComputation* computation = module->entry_computation();
+  ComputationLayout computation_layout(computation->ComputeProgramShape());
+  for (int i = 0; i < computation->num_parameters(); ++i) {
+    const Shape& shape = computation_layout.parameter_shape(i);
+    *computation_layout.mutable_parameter_layout(i) =
+        ShapeLayout(LayoutUtil::GetWithDefaultLayout(shape));
+  }
+  *computation_layout.mutable_result_layout() = ShapeLayout(
+      LayoutUtil::GetWithDefaultLayout(computation_layout.result_shape()));
+  AssignLayouts(module.get(), &computation_layout);
+
+  int64_t num_transposes = 0;
+  for (const HloInstruction* instruction : computation->instructions()) {
+    EXPECT_NE(instruction->opcode(), HloOpcode::kCopy);
+    if (instruction->opcode() == HloOpcode::kTranspose) {
+      ++num_transposes;
+      EXPECT_TRUE(ShapeUtil::TransposeIsBitcast(
+          instruction->operand(0)->shape(), instruction->shape(),
+          instruction->dimensions()))
+          << instruction->ToString();
+    }
+  }
+  EXPECT_EQ(num_transposes, 2);
+}
+
 }  // namespace
 }  // namespace xla
@@ -22,6 +22,8 @@ limitations under the License.
 #include <cstring>
 #include <initializer_list>
 #include <iterator>
+#include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -53,6 +55,16 @@ using dnnl::memory;
 using dnnl::prop_kind;
 using dnnl::stream;
 
+using OneDnnConvolutionPrimitiveCache =
+    OneDnnPrimitiveCache<convolution_forward::primitive_desc,
+                         convolution_forward>;
+
+OneDnnConvolutionPrimitiveCache& GetOneDnnConvolutionPrimitiveCache() {
+  static auto* cache = new OneDnnConvolutionPrimitiveCache(
+      "convolution", kOneDnnPrimitiveCacheCapacity);
+  return *cache;
+}
+
 memory::dims GetPrimitiveParameter(
     const tsl::protobuf::RepeatedField<uint64_t>& field, int offset) {
   memory::dims param_field(field.begin(), field.end());
@@ -211,7 +223,7 @@ ABSL_ATTRIBUTE_NO_SANITIZE_MEMORY void __xla_cpu_runtime_OneDnnConvolution(
   XLA_LIGHTWEIGHT_CHECK(run_options->intra_op_thread_pool() != nullptr);
   tsl::OneDnnThreadPool thread_pool(
       run_options->intra_op_thread_pool()->getPool(), false);
-  dnnl::engine cpu_engine(dnnl::engine::kind::cpu, 0);
+  const dnnl::engine& cpu_engine = OneDnnCpuEngine();
 #ifndef ENABLE_ONEDNN_OPENMP
   auto onednn_stream =
       stream(dnnl::threadpool_interop::make_stream(cpu_engine, &thread_pool));
@@ -315,10 +327,18 @@ ABSL_ATTRIBUTE_NO_SANITIZE_MEMORY void __xla_cpu_runtime_OneDnnConvolution(
     attrs.set_post_ops(post_ops);
   }
 
-  auto conv_pd = std::make_unique<convolution_forward::primitive_desc>(
-      cpu_engine, prop_kind::forward_inference, algorithm::convolution_direct,
-      any_inp_md, any_ker_md, bias_md, any_res_md, strides, rhs_dilations,
-      pad_left, pad_right, attrs);
+  std::vector<memory::desc> key_mds = {new_inp_md, new_ker_md, new_res_md};
+  key_mds.insert(key_mds.end(), fused_mds.begin(), fused_mds.end());
+  std::shared_ptr<const OneDnnConvolutionPrimitiveCache::Entry> cached =
+      GetOneDnnConvolutionPrimitiveCache().GetOrCreate(
+          OneDnnPrimitiveCacheKey(config_str, key_mds), [&] {
+            return convolution_forward::primitive_desc(
+                cpu_engine, prop_kind::forward_inference,
+                algorithm::convolution_direct, any_inp_md, any_ker_md, bias_md,
+                any_res_md, strides, rhs_dilations, pad_left, pad_right,
+                attrs);
+          });
+  const convolution_forward::primitive_desc* conv_pd = &cached->primitive_desc;
 
   auto inp_mem = memory(new_inp_md, cpu_engine, inp_minfo.Data());
   auto ker_mem = memory(new_ker_md, cpu_engine, ker_minfo.Data());
@@ -336,7 +356,7 @@ ABSL_ATTRIBUTE_NO_SANITIZE_MEMORY void __xla_cpu_runtime_OneDnnConvolution(
                          ? res_mem
                          : memory(conv_pd->dst_desc(), cpu_engine);
 
-  auto conv_prim = convolution_forward(*conv_pd);
+  const convolution_forward& conv_prim = cached->primitive;
 
   std::unordered_map<int, memory> conv_args{{DNNL_ARG_SRC, new_inp_mem},
                                             {DNNL_ARG_WEIGHTS, new_ker_mem},
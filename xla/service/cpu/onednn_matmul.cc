@@ -20,6 +20,8 @@ limitations under the License.
 #include <cstring>
 #include <initializer_list>
 #include <iterator>
+#include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -50,6 +52,15 @@ using dnnl::matmul;
 using dnnl::memory;
 using dnnl::stream;
 
+using OneDnnMatMulPrimitiveCache =
+    OneDnnPrimitiveCache<matmul::primitive_desc, matmul>;
+
+OneDnnMatMulPrimitiveCache& GetOneDnnMatMulPrimitiveCache() {
+  static auto* cache = new OneDnnMatMulPrimitiveCache(
+      "matmul", kOneDnnPrimitiveCacheCapacity);
+  return *cache;
+}
+
 dnnl::memory::desc OneDnnMatMulOptWeightsDesc(
     const dnnl::engine& engine, const dnnl::memory::desc& input_md,
     const dnnl::memory::desc& weights_md, const dnnl::memory::desc& bias_md,
@@ -203,7 +214,7 @@ ABSL_ATTRIBUTE_NO_SANITIZE_MEMORY void __xla_cpu_runtime_OneDnnMatMul(
       static_cast<const xla::ExecutableRunOptions*>(args[arg_indx++]);
   auto thread_pool = CreateOneDnnThreadPool(
       run_options ? run_options->intra_op_thread_pool() : nullptr);
-  engine cpu_engine(engine::kind::cpu, 0);
+  const engine& cpu_engine = OneDnnCpuEngine();
   auto onednn_stream = MakeOneDnnStream(cpu_engine, thread_pool.get());
 
   std::string config_str(static_cast<const char*>(args[arg_indx++]));
@@ -294,24 +305,37 @@ ABSL_ATTRIBUTE_NO_SANITIZE_MEMORY void __xla_cpu_runtime_OneDnnMatMul(
     fused_bufs.push_back(operand_minfo.Data());
   }
 
+  // The post-op arguments point to the buffers of this call, so they are
+  // populated on every call, while the primitive itself is cached.
   std::vector<std::pair<int, dnnl::memory>> postop_args;
   FusedOperandsRef fused_operands_ref{fused_bufs, postop_args};
-  auto matmul_pd =
-      CreateMatMulPrimDesc(cpu_engine, input_md, weights_md, output_md,
-                           fused_mds, matmul_config, &fused_operands_ref);
+  memory::desc bias_md;
+  PopulateOneDnnPostOps(cpu_engine, fused_mds, &matmul_config.fusions(),
+                        &fused_operands_ref, &bias_md);
 
   XLA_LIGHTWEIGHT_CHECK(num_args == arg_indx);
 
+  std::vector<memory::desc> key_mds = {input_md, weights_md, output_md};
+  key_mds.insert(key_mds.end(), fused_mds.begin(), fused_mds.end());
+  std::shared_ptr<const OneDnnMatMulPrimitiveCache::Entry> cached =
+      GetOneDnnMatMulPrimitiveCache().GetOrCreate(
+          OneDnnPrimitiveCacheKey(config_str, key_mds), [&] {
+            auto matmul_pd =
+                CreateMatMulPrimDesc(cpu_engine, input_md, weights_md,
+                                     output_md, fused_mds, matmul_config);
+            if (std::strstr(matmul_pd->impl_info_str(), "ref") != nullptr) {
+              LOG(WARNING)
+                  << "[Perf]: MatMul reference implementation being executed";
+            }
+            return std::move(*matmul_pd);
+          });
+  const matmul::primitive_desc& matmul_pd = cached->primitive_desc;
+  const matmul& matmul_prim = cached->primitive;
+
   auto lhs_mem = memory(input_md, cpu_engine, input_minfo.Data());
-  auto rhs_mem = memory(matmul_pd->weights_desc(), cpu_engine, rhs_data);
+  auto rhs_mem = memory(matmul_pd.weights_desc(), cpu_engine, rhs_data);
   auto result_mem = memory(output_md, cpu_engine, output_minfo.Data());
 
-  if (std::strstr(matmul_pd->impl_info_str(), "ref") != nullptr) {
-    LOG(WARNING) << "[Perf]: MatMul reference implementation being executed";
-  }
-
-  auto matmul_prim = matmul(*matmul_pd);
-
   std::unordered_map<int, memory> matmul_args{{DNNL_ARG_SRC, lhs_mem},
                                               {DNNL_ARG_WEIGHTS, rhs_mem},
                                               {DNNL_ARG_DST, result_mem}};
@@ -319,7 +343,7 @@ ABSL_ATTRIBUTE_NO_SANITIZE_MEMORY void __xla_cpu_runtime_OneDnnMatMul(
   if (matmul_config.optimization_config().user_scratchpad()) {
     XLA_LIGHTWEIGHT_CHECK(scratch != nullptr);
     MemrefInfo scratch_minfo(scratch);
-    auto scratchpad_md = matmul_pd->scratchpad_desc();
+    auto scratchpad_md = matmul_pd.scratchpad_desc();
     auto scratch_mem = memory(scratchpad_md, cpu_engine, scratch_minfo.Data());
     matmul_args.insert({DNNL_ARG_SCRATCHPAD, scratch_mem});
   }
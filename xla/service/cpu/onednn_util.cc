@@ -16,6 +16,15 @@ limitations under the License.
 
 #include "xla/service/cpu/onednn_util.h"
 
+#include <cstdint>
+#include <string>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "xla/tsl/lib/monitoring/counter.h"
+
 #define EIGEN_USE_THREADS
 
 namespace xla {
@@ -40,6 +49,54 @@ dnnl::stream MakeOneDnnStream(
              : dnnl::stream(cpu_engine);
 }
 
+namespace {
+
+auto* onednn_primitive_cache_lookups = tsl::monitoring::Counter<2>::New(
+    "/xla/service/cpu/onednn_primitive_cache_lookups",
+    "The number of lookups in the oneDNN primitive cache.", "primitive",
+    "result");
+
+absl::string_view LookupResult(bool hit) { return hit ? "hit" : "miss"; }
+
+}  // namespace
+
+const dnnl::engine& OneDnnCpuEngine() {
+  static const auto* engine = new dnnl::engine(dnnl::engine::kind::cpu, 0);
+  return *engine;
+}
+
+std::string OneDnnPrimitiveCacheKey(
+    absl::string_view config, absl::Span<const dnnl::memory::desc> mds) {
+  // The config is a serialized proto, which may contain any byte, so we
+  // prefix it with its size to keep keys unambiguous.
+  std::string key = absl::StrCat(config.size(), ":", config);
+  for (const dnnl::memory::desc& md : mds) {
+    // Strides and blocks are empty for `format_tag::any` descriptors, which
+    // the format kind tells apart.
+    absl::StrAppend(&key, "|", static_cast<int>(md.get_data_type()), ";",
+                    static_cast<int>(md.get_format_kind()), ";",
+                    absl::StrJoin(md.get_dims(), ","), ";",
+                    absl::StrJoin(md.get_strides(), ","), ";",
+                    absl::StrJoin(md.get_inner_blks(), ","), ";",
+                    absl::StrJoin(md.get_inner_idxs(), ","));
+  }
+  return key;
+}
+
+void RecordOneDnnPrimitiveCacheLookup(absl::string_view primitive_kind,
+                                      bool hit) {
+  onednn_primitive_cache_lookups
+      ->GetCell(std::string(primitive_kind), std::string(LookupResult(hit)))
+      ->IncrementBy(1);
+}
+
+int64_t GetOneDnnPrimitiveCacheLookupCount(absl::string_view primitive_kind,
+                                           bool hit) {
+  return onednn_primitive_cache_lookups
+      ->GetCell(std::string(primitive_kind), std::string(LookupResult(hit)))
+      ->value();
+}
+
 dnnl::post_ops PopulateOneDnnPostOps(
     const dnnl::engine& cpu_engine,
     const std::vector<dnnl::memory::desc>& fused_mds,
@@ -20,9 +20,22 @@ limitations under the License.
 
 #define EIGEN_USE_THREADS
 
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/functional/function_ref.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
 #include "unsupported/Eigen/CXX11/Tensor"
 #include "dnnl.hpp"
 #include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/pjrt/lru_cache.h"
 #include "xla/service/cpu/backend_config.pb.h"
 #include "xla/service/cpu/onednn_config.pb.h"
 #include "xla/tsl/util/onednn_threadpool.h"
@@ -86,6 +99,85 @@ dnnl::post_ops PopulateOneDnnPostOps(
     FusedOperandsRef* fused_operands_ref = nullptr,
     dnnl::memory::desc* bias_md = nullptr);
 
+// Returns the process-wide oneDNN CPU engine. Primitives cached by
+// OneDnnPrimitiveCache are created on this engine, so they must be executed on
+// streams of this engine as well.
+const dnnl::engine& OneDnnCpuEngine();
+
+// Returns a key for OneDnnPrimitiveCache that depends only on the serialized
+// oneDNN config of the op and the memory descriptors of its operands and
+// results, so that identical ops of different executables share a primitive.
+std::string OneDnnPrimitiveCacheKey(
+    absl::string_view config, absl::Span<const dnnl::memory::desc> mds);
+
+// Records a lookup in the oneDNN primitive cache of `primitive_kind`.
+void RecordOneDnnPrimitiveCacheLookup(absl::string_view primitive_kind,
+                                      bool hit);
+
+// Returns the number of hits, or misses, of the oneDNN primitive cache of
+// `primitive_kind` since the process started.
+int64_t GetOneDnnPrimitiveCacheLookupCount(absl::string_view primitive_kind,
+                                           bool hit);
+
+// The default number of primitives of each kind kept by OneDnnPrimitiveCache.
+inline constexpr int kOneDnnPrimitiveCacheCapacity = 1024;
+
+// Process-wide LRU cache of oneDNN primitives and their descriptors. The
+// oneDNN runtime calls would otherwise create a primitive descriptor on every
+// call, and look up the primitive in the oneDNN cache keyed by that
+// descriptor. Multi-model serving creates identical primitives over and over,
+// so we cache both, keyed by OneDnnPrimitiveCacheKey. Thread-safe.
+template <typename PrimDesc, typename Primitive>
+class OneDnnPrimitiveCache {
+ public:
+  struct Entry {
+    explicit Entry(PrimDesc prim_desc)
+        : primitive_desc(std::move(prim_desc)), primitive(primitive_desc) {}
+
+    PrimDesc primitive_desc;
+    Primitive primitive;
+  };
+
+  OneDnnPrimitiveCache(absl::string_view primitive_kind, int capacity)
+      : primitive_kind_(primitive_kind),
+        lru_list_(capacity),
+        cache_(&lru_list_) {}
+
+  ~OneDnnPrimitiveCache() {
+    absl::MutexLock lock(&mu_);
+    cache_.Clear();
+  }
+
+  // Returns the primitive cached for `key`, and creates it from the primitive
+  // descriptor returned by `create_primitive_desc` if absent. Primitives are
+  // created under the lock, as oneDNN may JIT them, so that concurrent callers
+  // don't create the same primitive twice.
+  std::shared_ptr<const Entry> GetOrCreate(
+      const std::string& key,
+      absl::FunctionRef<PrimDesc()> create_primitive_desc) {
+    bool hit = true;
+    std::shared_ptr<const Entry> entry;
+    {
+      absl::MutexLock lock(&mu_);
+      entry = cache_.GetOrCreateIfAbsent(key, [&](const std::string&) {
+        hit = false;
+        return std::make_shared<const Entry>(create_primitive_desc());
+      });
+    }
+    RecordOneDnnPrimitiveCacheLookup(primitive_kind_, hit);
+    return entry;
+  }
+
+ private:
+  using Cache = LRUCache<std::string, std::shared_ptr<const Entry>>;
+
+  std::string primitive_kind_;
+
+  absl::Mutex mu_;
+  typename Cache::LRUList lru_list_ ABSL_GUARDED_BY(mu_);
+  Cache cache_ ABSL_GUARDED_BY(mu_);
+};
+
 }  // namespace cpu
 }  // namespace xla
 
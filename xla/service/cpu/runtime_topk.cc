@@ -18,14 +18,75 @@ limitations under the License.
 #include <algorithm>
 #include <cstdint>
 #include <cstring>
+#include <functional>
 #include <limits>
-#include <numeric>
 #include <vector>
 
 #include "absl/base/attributes.h"
 #include "absl/base/casts.h"
 #include "absl/base/dynamic_annotations.h"
 
+// If `k` is at most `input_size / kHeapSelectRatio` we stream the input
+// through a binary heap of size `k`, otherwise we partition the whole input
+// with a selection algorithm and sort only the first `k` elements.
+static constexpr int64_t kHeapSelectRatio = 16;
+
+// Packs a value and its index into a single 64-bit key, such that comparing
+// keys as unsigned integers gives the same order as the TopK comparator:
+// larger values first (in the total order -NaN < -Inf < -0 < +0 < +Inf < +NaN)
+// and smaller indices first for equal values.
+template <typename T>
+static uint64_t PackKey(T value, int64_t index) {
+  static_assert(sizeof(T) == sizeof(uint32_t), "Unsupported TopK type");
+  uint32_t x = absl::bit_cast<uint32_t>(value);
+  uint32_t ordered = (x & 0x80000000u) ? ~x : (x | 0x80000000u);
+  return (static_cast<uint64_t>(ordered) << 32) |
+         (std::numeric_limits<uint32_t>::max() - static_cast<uint32_t>(index));
+}
+
+static int32_t UnpackIndex(uint64_t key) {
+  return static_cast<int32_t>(std::numeric_limits<uint32_t>::max() -
+                              static_cast<uint32_t>(key));
+}
+
+// Selects top `k` keys from `values_batch` into `keys[0, k)` sorted in
+// descending order. `keys` must have space for `input_size` elements, however
+// only the first `k` are used by the heap-based selection.
+template <typename T>
+static void SelectTopK(int64_t input_size, int64_t k, const T* values_batch,
+                       std::vector<uint64_t>& keys) {
+  auto key_greater = std::greater<uint64_t>();
+
+  if (k * kHeapSelectRatio <= input_size) {
+    // Min-heap of the largest `k` keys seen so far.
+    for (int64_t i = 0; i < k; ++i) {
+      keys[i] = PackKey(values_batch[i], i);
+    }
+    std::make_heap(keys.begin(), keys.begin() + k, key_greater);
+
+    for (int64_t i = k; i < input_size; ++i) {
+      uint64_t key = PackKey(values_batch[i], i);
+      if (key > keys[0]) {
+        std::pop_heap(keys.begin(), keys.begin() + k, key_greater);
+        keys[k - 1] = key;
+        std::push_heap(keys.begin(), keys.begin() + k, key_greater);
+      }
+    }
+
+    std::sort_heap(keys.begin(), keys.begin() + k, key_greater);
+    return;
+  }
+
+  for (int64_t i = 0; i < input_size; ++i) {
+    keys[i] = PackKey(values_batch[i], i);
+  }
+  if (k < input_size) {
+    std::nth_element(keys.begin(), keys.begin() + k,
+                     keys.begin() + input_size, key_greater);
+  }
+  std::sort(keys.begin(), keys.begin() + k, key_greater);
+}
+
 template <typename T>
 static void TopK(int64_t batch_size, int64_t input_size, int64_t k,
                  const T* values, T* out_values, int32_t* out_indices) {
@@ -33,36 +94,20 @@ static void TopK(int64_t batch_size, int64_t input_size, int64_t k,
   // initialized.
   ABSL_ANNOTATE_MEMORY_IS_INITIALIZED(values,
                                       input_size * batch_size * sizeof(T));
-  static constexpr auto convert_to_int = [](T value) {
-    uint32_t x = absl::bit_cast<uint32_t>(value);
-    return static_cast<int32_t>(x) < 0 ? std::numeric_limits<int32_t>::max() - x
-                                       : x;
-  };
+  if (k == 0) return;
 
-  std::vector<int32_t> temp_indices(input_size);
+  std::vector<uint64_t> keys(k * kHeapSelectRatio <= input_size ? k
+                                                                : input_size);
   for (int64_t batch = 0; batch != batch_size; ++batch) {
-    std::iota(temp_indices.begin(), temp_indices.end(), 0);
-
     const T* values_batch = values + batch * input_size;
-
-    auto kth_element = temp_indices.begin() + k;
-    std::partial_sort(temp_indices.begin(), kth_element, temp_indices.end(),
-                      [values_batch](size_t i1, size_t i2) {
-                        // Do the comparison in integers to enforce a total
-                        // order of -NaN < -Inf < -0 < +0 < +Inf < +NaN.
-                        int32_t v1 = convert_to_int(values_batch[i1]);
-                        int32_t v2 = convert_to_int(values_batch[i2]);
-                        if (v1 == v2) {
-                          return i1 < i2;  // Stabilize sorting.
-                        }
-                        return v1 > v2;
-                      });
+    SelectTopK(input_size, k, values_batch, keys);
 
     T* out_values_batch = out_values + batch * k;
     int32_t* out_indices_batch = out_indices + batch * k;
-    std::copy(temp_indices.begin(), kth_element, out_indices_batch);
     for (int64_t i = 0; i < k; i++) {
-      out_values_batch[i] = values_batch[temp_indices[i]];
+      int32_t index = UnpackIndex(keys[i]);
+      out_indices_batch[i] = index;
+      out_values_batch[i] = values_batch[index];
     }
   }
 }
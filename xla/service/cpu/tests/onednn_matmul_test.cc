@@ -15,6 +15,7 @@ limitations under the License.
 
 #if defined(INTEL_MKL)
 
+#include <cstdint>
 #include <utility>
 
 #include "xla/hlo/testlib/filecheck.h"
@@ -216,6 +217,26 @@ TEST_F(MatmulTest, SimpleTestF32TransposeB) {
   MatchOptimizedHlo(matmul_module_str, matmul_rewrite_str_);
 }
 
+TEST_F(MatmulTest, PrimitiveCacheSharedAcrossExecutables) {
+  const char* matmul_module_str = R"(
+  HloModule matmul.test.cache
+
+  ENTRY matmul.test.cache {
+    arg.0 = f32[16,32] parameter(0), parameter_replication={false}
+    arg.1 = f32[32,24] parameter(1), parameter_replication={false}
+    ROOT onednn.matmul.0 = f32[16,24] dot(arg.0, arg.1), lhs_contracting_dims={1}, rhs_contracting_dims={0}
+  })";
+
+  // Each run compiles a new executable, and the second one must reuse the
+  // primitive created by the first one.
+  EXPECT_TRUE(Run(matmul_module_str));
+  const int64_t hits = GetOneDnnPrimitiveCacheLookupCount("matmul", true);
+  const int64_t misses = GetOneDnnPrimitiveCacheLookupCount("matmul", false);
+  EXPECT_TRUE(Run(matmul_module_str));
+  EXPECT_GT(GetOneDnnPrimitiveCacheLookupCount("matmul", true), hits);
+  EXPECT_EQ(GetOneDnnPrimitiveCacheLookupCount("matmul", false), misses);
+}
+
 TEST_F(MatmulTest, SimpleTestF32WithBiasAddFusion1) {
   const char* matmul_module_str = R"(
   HloModule matmul.biasadd.test.f32
@@ -99,6 +99,40 @@ TEST_F(XnnFusionTest, DotRhsTransposedAndMultiply) {
   EXPECT_TRUE(RunAndCompare(kModuleStr, ErrorSpec{1e-7}));
 }
 
+TEST_F(XnnFusionTest, MlpBlock) {
+  constexpr absl::string_view kModuleStr = R"(
+    HloModule mlp_block
+
+    xnn_fusion {
+      %x = f32[4,5] parameter(0)
+      %w0 = f32[5,6] parameter(1)
+      %b0 = f32[6] parameter(2)
+      %w1 = f32[6,3] parameter(3)
+      %dot.0 = f32[4,6] dot(%x, %w0),
+        lhs_contracting_dims={1}, rhs_contracting_dims={0}
+      %bias = f32[4,6] broadcast(%b0), dimensions={1}
+      %add = f32[4,6] add(%dot.0, %bias)
+      %zero = f32[] constant(0)
+      %zeros = f32[4,6] broadcast(%zero), dimensions={}
+      %relu = f32[4,6] maximum(%add, %zeros)
+      %dot.1 = f32[4,3] dot(%relu, %w1),
+        lhs_contracting_dims={1}, rhs_contracting_dims={0}
+      ROOT %tanh = f32[4,3] tanh(%dot.1)
+    }
+
+    ENTRY entry {
+      %x = f32[4,5] parameter(0)
+      %w0 = f32[5,6] parameter(1)
+      %b0 = f32[6] parameter(2)
+      %w1 = f32[6,3] parameter(3)
+      ROOT %fusion = f32[4,3] fusion(%x, %w0, %b0, %w1),
+        kind=kCustom, calls=xnn_fusion,
+        backend_config={"fusion_config": {kind: "__xnn_fusion"}}
+    })";
+
+  EXPECT_TRUE(RunAndCompare(kModuleStr, ErrorSpec{1e-5}));
+}
+
 TEST_F(XnnFusionTest, UnsupportedDot) {
   constexpr absl::string_view kModuleStr = R"(
     HloModule unsupported_dot
@@ -56,6 +56,8 @@ limitations under the License.
 #include "xla/backends/cpu/runtime/rng_state_thunk.h"
 #include "xla/backends/cpu/runtime/sort_thunk.h"
 #include "xla/backends/cpu/runtime/thunk.h"
+#include "xla/backends/cpu/runtime/thunk.pb.h"
+#include "xla/backends/cpu/runtime/thunk_profile.h"
 #include "xla/backends/cpu/runtime/topk_thunk.h"
 #include "xla/backends/cpu/runtime/while_thunk.h"
 #include "xla/backends/cpu/runtime/xnnpack/xnn_dot_thunk.h"
@@ -83,6 +85,7 @@ limitations under the License.
 #include "xla/service/cpu/ir_emission_utils.h"
 #include "xla/service/cpu/ir_emitter2.h"
 #include "xla/service/hlo.pb.h"
+#include "xla/service/hlo_cost_analysis.h"
 #include "xla/service/hlo_module_config.h"
 #include "xla/service/pattern_matcher.h"
 #include "xla/shape.h"
@@ -107,18 +110,45 @@ namespace xla::cpu {
 ThunkEmitter::ThunkEmitter(IrEmitter2& ir_emitter,
                            const BufferAssignment& buffer_assignment,
                            const TargetMachineFeatures& target_machine_features,
-                           const HloModuleConfig& hlo_module_config)
+                           const HloModuleConfig& hlo_module_config,
+                           const HloCostAnalysis* cost_analysis,
+                           const ThunkProfileProto* thunk_profile)
     : ir_emitter_(ir_emitter),
       buffer_assignment_(buffer_assignment),
       target_machine_features_(target_machine_features),
       hlo_module_config_(hlo_module_config),
+      cost_analysis_(cost_analysis),
       communicator_resource_(
-          Resource::Create(Resource::kCollectiveCommunicator)) {}
+          Resource::Create(Resource::kCollectiveCommunicator)) {
+  if (thunk_profile) {
+    thunk_times_ = GetAverageThunkTimes(*thunk_profile);
+  }
+}
 
-static Thunk::Info ThunkInfo(const HloInstruction* instruction) {
+Thunk::Info ThunkEmitter::ThunkInfo(const HloInstruction* instruction) const {
   const HloModule* module = instruction->GetModule();
-  return Thunk::Info{std::string(instruction->name()),
-                     std::string(module->name()), module->unique_id()};
+  Thunk::Info info{std::string(instruction->name()),
+                   std::string(module->name()), module->unique_id()};
+
+  // Prefer measured execution times from the thunk profile. Thunks missing
+  // from the profile get a default unit cost at run time.
+  if (thunk_times_.has_value()) {
+    if (auto it = thunk_times_->find(info.op_name); it != thunk_times_->end()) {
+      info.cost = it->second;
+    }
+    return info;
+  }
+
+  // We use a simple cost model that adds up compute and memory costs, which is
+  // good enough to find long chains of expensive operations (dots and
+  // convolutions) for prioritizing them at run time.
+  if (cost_analysis_) {
+    info.cost = cost_analysis_->flop_count(*instruction) +
+                cost_analysis_->transcendental_count(*instruction) +
+                cost_analysis_->bytes_accessed(*instruction);
+  }
+
+  return info;
 }
 
 absl::StatusOr<ThunkSequence> ThunkEmitter::EmitEntryComputation(
@@ -1124,19 +1154,26 @@ absl::StatusOr<ThunkSequence> ThunkEmitter::EmitDynamicUpdateSliceThunk(
 }
 
 // Parse the sort comparator to determine the sort direction. Comparator is
-// expected to be an HloOpcode::kCompare with two parameters.
+// expected to be an HloOpcode::kCompare of the two parameters corresponding to
+// the first sorted operand (keys). If the sort has multiple operands, the rest
+// of them (values) must not participate in the comparison, which is guaranteed
+// by the comparator root being a compare of two parameters.
 std::optional<SortThunk::SortDirection> ThunkEmitter::MatchSortDirection(
     const HloComputation* hlo_comparator) const {
   namespace m = match;
   std::optional<SortThunk::SortDirection> direction = std::nullopt;
 
-  // TODO(tsilytskyi): Handle more than two input parameters.
-  if (hlo_comparator->root_instruction()->opcode() == HloOpcode::kCompare &&
-      hlo_comparator->root_instruction()->operand(0)->opcode() ==
-          HloOpcode::kParameter &&
-      hlo_comparator->root_instruction()->operand(1)->opcode() ==
-          HloOpcode::kParameter &&
-      hlo_comparator->num_parameters() == 2) {
+  const HloInstruction* root = hlo_comparator->root_instruction();
+  auto is_key_parameter = [](const HloInstruction* instr) {
+    return instr->opcode() == HloOpcode::kParameter &&
+           instr->parameter_number() < 2;
+  };
+
+  if (root->opcode() == HloOpcode::kCompare &&
+      is_key_parameter(root->operand(0)) &&
+      is_key_parameter(root->operand(1)) &&
+      root->operand(0) != root->operand(1) &&
+      hlo_comparator->num_parameters() % 2 == 0) {
     auto* compare =
         Cast<HloCompareInstruction>(hlo_comparator->root_instruction());
 
@@ -31,6 +31,7 @@ limitations under the License.
 #include "xla/backends/cpu/codegen/target_machine_features.h"
 #include "xla/backends/cpu/runtime/sort_thunk.h"
 #include "xla/backends/cpu/runtime/thunk.h"
+#include "xla/backends/cpu/runtime/thunk.pb.h"
 #include "xla/codegen/kernel_spec.h"
 #include "xla/hlo/ir/hlo_computation.h"
 #include "xla/hlo/ir/hlo_instruction.h"
@@ -39,6 +40,7 @@ limitations under the License.
 #include "xla/runtime/resource_use.h"
 #include "xla/service/buffer_assignment.h"
 #include "xla/service/cpu/ir_emitter2.h"
+#include "xla/service/hlo_cost_analysis.h"
 #include "xla/service/hlo_module_config.h"
 #include "xla/shape_util.h"
 #include "xla/xla_data.pb.h"
@@ -59,10 +61,17 @@ class ThunkEmitter {
     llvm::orc::ThreadSafeModule module;
   };
 
+  // If `cost_analysis` is not null, it is used to record estimated costs of
+  // emitted thunks in their `Thunk::Info`. Cost analysis must outlive the
+  // thunk emitter. If `thunk_profile` is not null, recorded thunk execution
+  // times take precedence over the cost analysis estimates, so that we never
+  // mix different cost units in a single thunk sequence.
   ThunkEmitter(IrEmitter2& ir_emitter,
                const BufferAssignment& buffer_assignment,
                const TargetMachineFeatures& target_machine_features,
-               const HloModuleConfig& hlo_module_config);
+               const HloModuleConfig& hlo_module_config,
+               const HloCostAnalysis* cost_analysis = nullptr,
+               const ThunkProfileProto* thunk_profile = nullptr);
 
   // Emits HLO module entry computation as a sequence of thunks.
   absl::StatusOr<ThunkSequence> EmitEntryComputation(const HloModule& module);
@@ -75,6 +84,9 @@ class ThunkEmitter {
     std::vector<BufferAllocation::Slice> results;
   };
 
+  // Returns thunk info for the thunk emitted for the given instruction.
+  Thunk::Info ThunkInfo(const HloInstruction* instruction) const;
+
   std::optional<SortThunk::SortDirection> MatchSortDirection(
       const HloComputation* hlo_comparator) const;
 
@@ -217,13 +229,13 @@ class ThunkEmitter {
       absl::Span<const PrimitiveType> supported_types);
 
   // Convenience function that creates a thunk sequence containing given kernel.
-  static absl::StatusOr<ThunkSequence> MakeKernelThunkSequence(
+  absl::StatusOr<ThunkSequence> MakeKernelThunkSequence(
       const HloInstruction* instruction,
       const ThunkEmitter::HostKernelAllocationSlices& buffers,
       const IrEmitter2::KernelInfo& kernel,
       std::optional<uint64_t> min_alignment = std::nullopt);
 
-  static absl::StatusOr<ThunkSequence> MakeKernelThunkSequence(
+  absl::StatusOr<ThunkSequence> MakeKernelThunkSequence(
       const HloInstruction* instruction, const KernelSpec& kernel_spec,
       std::optional<uint64_t> min_alignment = std::nullopt);
 
@@ -232,6 +244,11 @@ class ThunkEmitter {
 
   const TargetMachineFeatures& target_machine_features_;
   const HloModuleConfig& hlo_module_config_;
+  const HloCostAnalysis* cost_analysis_;
+
+  // Average thunk execution times (in nanoseconds) keyed by the thunk op name
+  // from the thunk profile recorded by a previous run.
+  std::optional<absl::flat_hash_map<std::string, int64_t>> thunk_times_;
 
   // A global resource that is used to order all collective operations.
   std::shared_ptr<Resource> communicator_resource_;
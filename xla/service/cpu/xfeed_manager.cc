@@ -15,10 +15,17 @@ limitations under the License.
 
 #include "xla/service/cpu/xfeed_manager.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <thread>  // NOLINT
 #include <utility>
 
+#include "absl/base/optimization.h"
 #include "absl/base/thread_annotations.h"
+#include "absl/numeric/bits.h"
 #include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
 #include "xla/shape.h"
@@ -29,8 +36,52 @@ namespace xla {
 namespace cpu {
 namespace runtime {
 
+XfeedRingBuffer::XfeedRingBuffer(size_t capacity)
+    : buffers_(absl::bit_ceil(std::max<size_t>(capacity, 1)), nullptr),
+      mask_(buffers_.size() - 1) {}
+
+bool XfeedRingBuffer::TryPush(XfeedBuffer* buffer) {
+  size_t tail = tail_.load(std::memory_order_relaxed);
+  if (tail - head_.load(std::memory_order_acquire) == buffers_.size()) {
+    return false;
+  }
+  buffers_[tail & mask_] = buffer;
+  tail_.store(tail + 1, std::memory_order_release);
+  return true;
+}
+
+XfeedBuffer* XfeedRingBuffer::TryPop() {
+  size_t head = head_.load(std::memory_order_relaxed);
+  if (head == tail_.load(std::memory_order_acquire)) {
+    return nullptr;
+  }
+  XfeedBuffer* buffer = buffers_[head & mask_];
+  head_.store(head + 1, std::memory_order_release);
+  return buffer;
+}
+
+void XfeedQueueManager::EnableSingleProducerSingleConsumerMode(
+    size_t capacity) {
+  absl::MutexLock l(&mu_);
+  CHECK(enqueued_buffers_.empty() && current_buffer_ == nullptr)
+      << "Single-producer/single-consumer mode must be enabled for an empty "
+      << queue_name_ << " queue";
+  ring_buffer_ = std::make_unique<XfeedRingBuffer>(capacity);
+}
+
 void XfeedQueueManager::EnqueueBuffersAtomically(
     absl::Span<XfeedBuffer* const> buffers) {
+  if (ring_buffer_) {
+    // With a single producer buffers are enqueued atomically with respect to
+    // other enqueue calls, and the consumer can only observe them in order.
+    for (XfeedBuffer* b : buffers) {
+      while (ABSL_PREDICT_FALSE(!ring_buffer_->TryPush(b))) {
+        std::this_thread::yield();
+      }
+    }
+    return;
+  }
+
   absl::MutexLock l(&mu_);
   for (XfeedBuffer* b : buffers) {
     VLOG(3) << "Enqueueing " << queue_name_ << " buffer (of " << buffers.size()
@@ -40,6 +91,16 @@ void XfeedQueueManager::EnqueueBuffersAtomically(
 }
 
 XfeedBuffer* XfeedQueueManager::BlockingDequeueBuffer() {
+  if (ring_buffer_) {
+    CHECK(current_buffer_ == nullptr);
+    XfeedBuffer* buffer;
+    while (ABSL_PREDICT_FALSE((buffer = ring_buffer_->TryPop()) == nullptr)) {
+      std::this_thread::yield();
+    }
+    current_buffer_ = buffer;
+    return current_buffer_;
+  }
+
   VLOG(3) << "Waiting for an available buffer.";
   auto available_buffer = [this]() ABSL_SHARED_LOCKS_REQUIRED(mu_) {
     return !enqueued_buffers_.empty();
@@ -54,6 +115,15 @@ XfeedBuffer* XfeedQueueManager::BlockingDequeueBuffer() {
 
 void XfeedQueueManager::ReleaseCurrentBuffer(int32_t length, void* data,
                                              absl::StatusOr<Shape> shape) {
+  if (ring_buffer_) {
+    CHECK(current_buffer_ != nullptr);
+    DCHECK_EQ(length, current_buffer_->length());
+    DCHECK_EQ(data, current_buffer_->data());
+    current_buffer_->Done(std::move(shape));
+    current_buffer_ = nullptr;
+    return;
+  }
+
   VLOG(3) << "Releasing buffer with shape: "
           << (shape.ok() ? ShapeUtil::HumanString(shape.value())
                          : "<error status>");
@@ -20,9 +20,13 @@ limitations under the License.
 #ifndef XLA_SERVICE_CPU_XFEED_MANAGER_H_
 #define XLA_SERVICE_CPU_XFEED_MANAGER_H_
 
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <deque>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "absl/status/statusor.h"
 #include "absl/synchronization/mutex.h"
@@ -50,11 +54,46 @@ class XfeedBuffer {
   virtual void Done(absl::StatusOr<Shape> shape) = 0;
 };
 
+// Lock-free single-producer/single-consumer ring buffer of xfeed buffers with
+// a fixed capacity. Buffers are handed off by pointer, and the data is never
+// copied. Push must be called from a single producer thread, and Pop from a
+// single consumer thread.
+class XfeedRingBuffer {
+ public:
+  // Capacity is rounded up to the next power of two.
+  explicit XfeedRingBuffer(size_t capacity);
+
+  // Returns false if the ring buffer is full.
+  bool TryPush(XfeedBuffer* buffer);
+
+  // Returns nullptr if the ring buffer is empty.
+  XfeedBuffer* TryPop();
+
+  size_t capacity() const { return buffers_.size(); }
+
+ private:
+  std::vector<XfeedBuffer*> buffers_;
+  size_t mask_;
+
+  // Producer and consumer positions on separate cache lines to avoid false
+  // sharing. Positions grow monotonically and are wrapped with `mask_`.
+  alignas(64) std::atomic<size_t> head_ = {0};  // next position to pop
+  alignas(64) std::atomic<size_t> tail_ = {0};  // next position to push
+};
+
 // Reusable component for managing the infeed and outfeed queue state.
 class XfeedQueueManager {
  public:
   XfeedQueueManager(std::string queue_name) : queue_name_(queue_name) {}
 
+  // Switches the queue to the lock-free single-producer/single-consumer mode
+  // backed by a ring buffer with the given capacity. This is intended for
+  // fixed-shape xfeed streams with a lot of small transfers, where the mutex
+  // based queue overhead is measurable. Must be called before any buffers are
+  // enqueued. After that, buffers must be enqueued from a single thread and
+  // dequeued from a single thread (i.e. one running XLA program).
+  void EnableSingleProducerSingleConsumerMode(size_t capacity);
+
   // Adds a sequence of buffers to the queue atomically. buffer->Done will be
   // called when the buffer will no longer be accessed by the XfeedManager,
   // either as a result of a call to Reset or because the runtime has dequeued
@@ -93,6 +132,11 @@ class XfeedQueueManager {
   // If non-NULL, the buffer that is currently being processed by the
   // runtime. Not owned.
   XfeedBuffer* current_buffer_ = nullptr;
+
+  // If non-NULL, the queue is in single-producer/single-consumer mode, and
+  // buffers are passed through the ring buffer instead of `enqueued_buffers_`.
+  // In this mode `current_buffer_` is accessed only by the consumer thread.
+  std::unique_ptr<XfeedRingBuffer> ring_buffer_;
 };
 
 // Client-side class used to enqueue infeed buffers.
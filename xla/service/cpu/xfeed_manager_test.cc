@@ -159,5 +159,47 @@ TEST_F(InfeedManagerTest, OutfeedWrongShape) {
   ProcessNextOutfeedBuffer(32, ShapeUtil::MakeShape(U8, {33}));
 }
 
+TEST_F(InfeedManagerTest, RingBufferPushPop) {
+  cpu::runtime::XfeedRingBuffer ring_buffer(/*capacity=*/3);
+  ASSERT_EQ(ring_buffer.capacity(), 4);
+
+  TestInfeedBuffer* buffers[4];
+  for (auto& buffer : buffers) {
+    buffer = new TestInfeedBuffer(8);
+    EXPECT_TRUE(ring_buffer.TryPush(buffer));
+  }
+  EXPECT_FALSE(ring_buffer.TryPush(buffers[0]));
+
+  for (auto& buffer : buffers) {
+    EXPECT_EQ(ring_buffer.TryPop(), buffer);
+    buffer->Done(buffer->shape());
+  }
+  EXPECT_EQ(ring_buffer.TryPop(), nullptr);
+}
+
+TEST_F(InfeedManagerTest, SingleProducerSingleConsumerMode) {
+  cpu::runtime::XfeedManager xfeed;
+  xfeed.infeed()->EnableSingleProducerSingleConsumerMode(/*capacity=*/16);
+
+  static constexpr int32_t kNumBuffers = 10000;
+
+  tsl::thread::ThreadPool pool(tsl::Env::Default(), "test", 1);
+  pool.Schedule([&xfeed]() {
+    for (int32_t i = 0; i < kNumBuffers; ++i) {
+      TestInfeedBuffer* buffer = new TestInfeedBuffer(i % 128);
+      xfeed.infeed()->EnqueueBuffersAtomically({buffer});
+    }
+  });
+
+  // Buffers must be dequeued in the order they were enqueued.
+  for (int32_t i = 0; i < kNumBuffers; ++i) {
+    cpu::runtime::XfeedBuffer* buffer = xfeed.infeed()->BlockingDequeueBuffer();
+    ASSERT_EQ(buffer->length(), i % 128);
+    xfeed.infeed()->ReleaseCurrentBuffer(
+        buffer->length(), buffer->data(),
+        ShapeUtil::MakeShape(U8, {buffer->length()}));
+  }
+}
+
 }  // namespace
 }  // namespace xla
@@ -16,7 +16,11 @@ limitations under the License.
 #include "xla/service/dump.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
+#include <cstdlib>
+#include <deque>
 #include <functional>
 #include <iostream>
 #include <memory>
@@ -28,8 +32,10 @@ limitations under the License.
 
 #include "absl/algorithm/container.h"
 #include "absl/base/const_init.h"
+#include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/functional/any_invocable.h"
+#include "absl/functional/function_ref.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -47,6 +53,8 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_module.h"
 #include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/hlo/ir/hlo_print_options.h"
+#include "xla/printer.h"
 #include "xla/runtime/large_hlo_snapshot_serialization/serialization.h"
 #include "xla/service/hlo.pb.h"
 #include "xla/service/hlo_graph_dumper.h"
@@ -58,6 +66,7 @@ limitations under the License.
 #include "xla/tsl/platform/file_system.h"
 #include "xla/tsl/platform/file_system_helper.h"
 #include "xla/util.h"
+#include "tsl/platform/fingerprint.h"
 #include "tsl/platform/path.h"
 #include "tsl/platform/platform.h"
 #include "tsl/platform/protobuf.h"
@@ -126,6 +135,8 @@ struct CanonicalDebugOptions {
         dump_include_timestamp(opts.xla_dump_include_timestamp()),
         dump_max_hlo_modules(opts.xla_dump_max_hlo_modules()),
         dump_compress_protos(opts.xla_dump_compress_protos()),
+        dump_async(opts.xla_dump_async()),
+        dump_async_max_queue_bytes(opts.xla_dump_async_max_queue_bytes()),
         dump_fdo_profiles(opts.xla_gpu_experimental_dump_fdo_profiles()),
         dump_mlir_pretty_form(opts.xla_dump_enable_mlir_pretty_form()) {
     // This constructor examines the values in `opts` and turns on other flags
@@ -182,6 +193,17 @@ struct CanonicalDebugOptions {
       should_dump_module = [](string_view) { return false; };
     }
 
+    // Of the modules selected above, only dump one in
+    // xla_dump_module_sample_period. The choice depends only on the module
+    // name, so that all the dumps of a module are either written or skipped.
+    if (opts.xla_dump_module_sample_period() > 1) {
+      uint64_t period = opts.xla_dump_module_sample_period();
+      should_dump_module = [period, should_dump = std::move(
+                                        should_dump_module)](string_view name) {
+        return tsl::Fingerprint64(name) % period == 0 && should_dump(name);
+      };
+    }
+
     // Initialize should_dump_pass.  This one is easy: We only dump per-pass
     // data if the user asked for it explicitly.
     if (!opts.xla_dump_hlo_pass_re().empty()) {
@@ -250,6 +272,8 @@ struct CanonicalDebugOptions {
   bool dump_include_timestamp;
   int64_t dump_max_hlo_modules;
   bool dump_compress_protos;
+  bool dump_async;
+  int64_t dump_async_max_queue_bytes;
   bool dump_fdo_profiles;
   bool dump_mlir_pretty_form;
 };
@@ -298,21 +322,187 @@ static absl::Status WriteStringToFile(tsl::Env* env, const std::string& fname,
   }
 }
 
+// A printer that writes to a file through a buffer, so that large modules are
+// dumped without being printed to a string first.
+class WritableFilePrinter : public Printer {
+ public:
+  explicit WritableFilePrinter(tsl::WritableFile* file) : file_(file) {
+    buffer_.reserve(kBufferSize);
+  }
+
+  void Append(const absl::AlphaNum& a) override {
+    if (buffer_.size() + a.size() > kBufferSize) {
+      Flush();
+    }
+    if (a.size() >= kBufferSize) {
+      Write(a.Piece());
+      return;
+    }
+    buffer_.append(a.data(), a.size());
+  }
+
+  // Writes the buffered data, and returns the first error of the writes.
+  absl::Status Finish() && {
+    Flush();
+    return status_;
+  }
+
+ private:
+  static constexpr size_t kBufferSize = 1 << 20;
+
+  void Flush() {
+    Write(buffer_);
+    buffer_.clear();
+  }
+
+  void Write(absl::string_view data) {
+    if (status_.ok() && !data.empty()) {
+      status_ = file_->Append(data);
+    }
+  }
+
+  tsl::WritableFile* file_;
+  std::string buffer_;
+  absl::Status status_;
+};
+
 static absl::Status WriteStringToFile(tsl::Env* env, const std::string& fname,
+                                      absl::FunctionRef<void(Printer*)> print,
+                                      bool compressed) {
+  std::unique_ptr<tsl::WritableFile> file;
+  TF_RETURN_IF_ERROR(env->NewWritableFile(fname, &file));
+  if (compressed) {
+    auto gz_opts = tsl::io::ZlibCompressionOptions::GZIP();
+    tsl::io::ZlibOutputBuffer gz_file(file.get(), gz_opts.input_buffer_size,
+                                      gz_opts.output_buffer_size, gz_opts);
+    TF_RETURN_IF_ERROR(gz_file.Init());
+    WritableFilePrinter printer(&gz_file);
+    print(&printer);
+    TF_RETURN_IF_ERROR(std::move(printer).Finish());
+    return gz_file.Close();
+  }
+  WritableFilePrinter printer(file.get());
+  print(&printer);
+  TF_RETURN_IF_ERROR(std::move(printer).Finish());
+  return file->Close();
+}
+
+static absl::Status WriteStringToFile(tsl::WritableFile* file,
                                       absl::string_view data, bool compressed) {
   if (!compressed) {
-    return tsl::WriteStringToFile(env, fname, data);
+    TF_RETURN_IF_ERROR(file->Append(data));
+    return file->Close();
   }
-  std::unique_ptr<tsl::WritableFile> file;
-  TF_RETURN_IF_ERROR(env->NewWritableFile(fname, &file));
   auto gz_opts = tsl::io::ZlibCompressionOptions::GZIP();
-  tsl::io::ZlibOutputBuffer gz_file(file.get(), gz_opts.input_buffer_size,
+  tsl::io::ZlibOutputBuffer gz_file(file, gz_opts.input_buffer_size,
                                     gz_opts.output_buffer_size, gz_opts);
   TF_RETURN_IF_ERROR(gz_file.Init());
   TF_RETURN_IF_ERROR(gz_file.Append(data));
   return gz_file.Close();
 }
 
+static absl::Status WriteStringToFile(tsl::Env* env, const std::string& fname,
+                                      absl::string_view data, bool compressed) {
+  std::unique_ptr<tsl::WritableFile> file;
+  TF_RETURN_IF_ERROR(env->NewWritableFile(fname, &file));
+  return WriteStringToFile(file.get(), data, compressed);
+}
+
+// Writes dump files on a background thread for --xla_dump_async.
+//
+// Files are created by the dumping thread, so that they are counted by
+// --xla_dump_max_hlo_modules right away, and written, compressed and closed
+// by the writer thread in the order they were enqueued.
+class AsyncDumpWriter {
+ public:
+  static AsyncDumpWriter& Get() {
+    static AsyncDumpWriter* writer = [] {
+      auto* writer = new AsyncDumpWriter();
+      instance_.store(writer);
+      std::atexit(WaitForPendingDumps);
+      return writer;
+    }();
+    return *writer;
+  }
+
+  // Returns nullptr if nothing was dumped asynchronously yet.
+  static AsyncDumpWriter* GetIfStarted() { return instance_.load(); }
+
+  // Blocks while more than `max_queue_bytes` are waiting to be written.
+  void Enqueue(std::string path, std::unique_ptr<tsl::WritableFile> file,
+               std::string contents, bool compress, int64_t max_queue_bytes) {
+    const int64_t size = contents.size();
+    absl::MutexLock lock(&mu_);
+    auto has_room = [&]() ABSL_SHARED_LOCKS_REQUIRED(mu_) {
+      return pending_writes_ == 0 || queued_bytes_ + size <= max_queue_bytes;
+    };
+    mu_.Await(absl::Condition(&has_room));
+    queue_.push_back(
+        {std::move(path), std::move(file), std::move(contents), compress});
+    queued_bytes_ += size;
+    ++pending_writes_;
+  }
+
+  void WaitForPendingWrites() {
+    absl::MutexLock lock(&mu_);
+    auto done = [&]() ABSL_SHARED_LOCKS_REQUIRED(mu_) {
+      return pending_writes_ == 0;
+    };
+    mu_.Await(absl::Condition(&done));
+  }
+
+ private:
+  struct PendingWrite {
+    std::string path;
+    std::unique_ptr<tsl::WritableFile> file;
+    std::string contents;
+    bool compress;
+  };
+
+  static inline std::atomic<AsyncDumpWriter*> instance_ = nullptr;
+
+  AsyncDumpWriter()
+      : thread_(tsl::Env::Default()->StartThread(
+            tsl::ThreadOptions(), "xla_dump_writer", [this] { Run(); })) {}
+
+  void Run() {
+    while (true) {
+      PendingWrite write;
+      {
+        absl::MutexLock lock(&mu_);
+        auto has_write = [&]() ABSL_SHARED_LOCKS_REQUIRED(mu_) {
+          return !queue_.empty();
+        };
+        mu_.Await(absl::Condition(&has_write));
+        write = std::move(queue_.front());
+        queue_.pop_front();
+      }
+      auto status =
+          WriteStringToFile(write.file.get(), write.contents, write.compress);
+      if (!status.ok()) {
+        LOG(ERROR) << "Could not write XLA debug data to " << write.path
+                   << ": " << status;
+      }
+      absl::MutexLock lock(&mu_);
+      queued_bytes_ -= write.contents.size();
+      --pending_writes_;
+    }
+  }
+
+  absl::Mutex mu_;
+  std::deque<PendingWrite> queue_ ABSL_GUARDED_BY(mu_);
+  // Bytes and writes that are queued or being written.
+  int64_t queued_bytes_ ABSL_GUARDED_BY(mu_) = 0;
+  int64_t pending_writes_ ABSL_GUARDED_BY(mu_) = 0;
+  std::unique_ptr<tsl::Thread> thread_;
+};
+
+void WaitForPendingDumps() {
+  if (AsyncDumpWriter* writer = AsyncDumpWriter::GetIfStarted()) {
+    writer->WaitForPendingWrites();
+  }
+}
+
 static std::optional<std::string> GetDumpFilePath(
     string_view filename, const CanonicalDebugOptions& opts) {
   if (opts.dumping_to_stdout()) {
@@ -371,8 +561,19 @@ static std::optional<std::string> DumpToFileInDirImpl(
   auto file_path = GetDumpFilePath(filename, opts);
   if (!file_path) return std::nullopt;
 
-  auto status =
-      WriteStringToFile(tsl::Env::Default(), *file_path, contents, compress);
+  absl::Status status;
+  if (opts.dump_async) {
+    std::unique_ptr<tsl::WritableFile> file;
+    status = tsl::Env::Default()->NewWritableFile(*file_path, &file);
+    if (status.ok()) {
+      AsyncDumpWriter::Get().Enqueue(*file_path, std::move(file),
+                                     std::string(contents), compress,
+                                     opts.dump_async_max_queue_bytes);
+    }
+  } else {
+    status =
+        WriteStringToFile(tsl::Env::Default(), *file_path, contents, compress);
+  }
   if (!status.ok()) {
     LOG(ERROR) << "Could not write XLA debug data to " << *file_path << ": "
                << status;
@@ -399,6 +600,23 @@ static std::optional<std::string> DumpToFileInDirImpl(
   return file_path;
 }
 
+static std::optional<std::string> DumpToFileInDirImpl(
+    string_view filename, absl::FunctionRef<void(Printer*)> print,
+    const CanonicalDebugOptions& opts) {
+  auto file_path = GetDumpFilePath(filename, opts);
+  if (!file_path) return std::nullopt;
+
+  auto status = WriteStringToFile(tsl::Env::Default(), *file_path, print,
+                                  /*compressed=*/false);
+  if (!status.ok()) {
+    LOG(ERROR) << "Could not write XLA debug data to " << *file_path << ": "
+               << status;
+    return std::nullopt;
+  }
+
+  return file_path;
+}
+
 static absl::Mutex stdout_dump_mutex(absl::kConstInit);
 
 static std::optional<std::string> DumpToFileInDirOrStdoutImpl(
@@ -434,6 +652,24 @@ static std::optional<std::string> DumpToFileInDirOrStdoutImpl(
   return DumpToFileInDirImpl(filename, data_producer, opts);
 }
 
+static std::optional<std::string> DumpToFileInDirOrStdoutImpl(
+    string_view filename, absl::FunctionRef<void(Printer*)> print,
+    const CanonicalDebugOptions& opts) {
+  // Dump to stdout if that's called for.
+  if (opts.dumping_to_stdout()) {
+    StringPrinter printer;
+    print(&printer);
+    absl::MutexLock lock(&stdout_dump_mutex);
+    std::cout << "*** Begin " << filename << " ***\n"
+              << std::move(printer).ToString() << "\n*** End " << filename
+              << " ***" << std::endl;
+    return std::nullopt;
+  }
+
+  // Otherwise, dump to a file.
+  return DumpToFileInDirImpl(filename, print, opts);
+}
+
 // Returns whether the computation is trivial enough not to warrant dumping.
 // Currently skips instructions where the root instruction has only parameters
 // as operands AND is not a fusion.
@@ -459,8 +695,11 @@ static std::vector<std::string> DumpHloModuleImpl(
   std::vector<std::optional<std::string>> file_paths;
 
   if (opts.dump_as_text) {
-    file_paths.push_back(DumpToFileInDirOrStdoutImpl(StrCat(filename, ".txt"),
-                                                     module.ToString(), opts));
+    const HloPrintOptions print_options = module.PrintOptionsFromDebugOptions();
+    file_paths.push_back(DumpToFileInDirOrStdoutImpl(
+        StrCat(filename, ".txt"),
+        [&](Printer* printer) { module.Print(printer, print_options); },
+        opts));
     if (buffer_assn) {
       DataProducer buffer_assignment;
       buffer_assignment.Append([&] { return buffer_assn->ToString(); });
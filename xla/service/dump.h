@@ -48,6 +48,10 @@ class HloSnapshot;
 // race conditions by trying again on collision.
 absl::Status CreateDirIfNeeded(const std::string& dir, tsl::Env* env);
 
+// Blocks until the files dumped with --xla_dump_async are written. Called at
+// exit.
+void WaitForPendingDumps();
+
 // Get a timestamp which we can use as a filename prefix specific to this
 // module.
 std::string TimestampFor(const HloModule& module);
@@ -18,6 +18,7 @@ limitations under the License.
 #include <sys/types.h>
 
 #include <memory>
+#include <numeric>
 #include <string>
 #include <vector>
 
@@ -25,6 +26,8 @@ limitations under the License.
 #include <gtest/gtest.h>
 #include "absl/strings/match.h"
 #include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
 #include "xla/debug_options_flags.h"
 #include "xla/hlo/ir/hlo_module.h"
 #include "xla/hlo/parser/hlo_parser.h"
@@ -100,6 +103,32 @@ TEST(DumpHloIfEnabled, LargeConstantPrinted) {
   EXPECT_TRUE(!absl::StrContains(data, "{...}"));
 }
 
+TEST(DumpHloIfEnabled, LargeModuleIsDumpedLikeToString) {
+  HloModuleConfig config;
+  DebugOptions options = config.debug_options();
+  auto env = tsl::Env::Default();
+  std::string dump_dir;
+  EXPECT_TRUE(env->LocalTempFilename(&dump_dir));
+  options.set_xla_dump_to(dump_dir);
+  options.set_xla_dump_hlo_as_text(true);
+  options.set_xla_dump_large_constants(true);
+  config.set_debug_options(options);
+  // The printed constant is larger than the buffer of the dump file.
+  std::vector<int> values(300000);
+  std::iota(values.begin(), values.end(), 1000000);
+  const std::string module_str = absl::StrCat(
+      "HloModule m\ntest {\n  p0 = s32[300000] parameter(0)\n",
+      "  c = s32[300000] constant({", absl::StrJoin(values, ", "), "})\n",
+      "  ROOT x = s32[300000] multiply(p0, c)\n}\n");
+  TF_ASSERT_OK_AND_ASSIGN(auto m,
+                          ParseAndReturnUnverifiedModule(module_str, config));
+  auto paths = DumpHloModuleIfEnabled(*m, "dump");
+  ASSERT_EQ(paths.size(), 1);
+  std::string data;
+  TF_ASSERT_OK(ReadFileToString(env, paths[0], &data));
+  EXPECT_EQ(data, m->ToString());
+}
+
 TEST(DumpTest, NoDumpingToFileWhenNotEnabled) {
   std::string filename =
       tsl::io::JoinPath(tsl::testing::TmpDir(), "disable_override");
@@ -129,6 +158,46 @@ TEST(DumpTest, DumpingToFileWorksWhenEnabled) {
   EXPECT_EQ(contents, real_contents);
 }
 
+TEST(DumpTest, AsyncDumpingToFileWorksWhenEnabled) {
+  DebugOptions options;
+  options.set_xla_dump_to(tsl::testing::TmpDir());
+  options.set_xla_enable_dumping(true);
+  options.set_xla_dump_async(true);
+  // Smaller than the files, so every dump waits for the previous one.
+  options.set_xla_dump_async_max_queue_bytes(4);
+  for (int i = 0; i < 10; ++i) {
+    DumpToFileInDir(options, absl::StrCat("async_dumping_", i),
+                    absl::StrCat("hello ", i));
+  }
+  WaitForPendingDumps();
+
+  for (int i = 0; i < 10; ++i) {
+    std::string real_contents;
+    TF_ASSERT_OK(tsl::ReadFileToString(
+        tsl::Env::Default(),
+        tsl::io::JoinPath(tsl::testing::TmpDir(),
+                          absl::StrCat("async_dumping_", i)),
+        &real_contents));
+    EXPECT_EQ(real_contents, absl::StrCat("hello ", i));
+  }
+}
+
+TEST(DumpTest, ModuleSamplingDumpsSomeModules) {
+  DebugOptions options = DefaultDebugOptionsIgnoringFlags();
+  options.set_xla_dump_to(tsl::testing::TmpDir());
+  options.set_xla_dump_module_sample_period(4);
+  int num_dumped = 0;
+  for (int i = 0; i < 100; ++i) {
+    std::string name = absl::StrCat("module_", i);
+    bool dumped = DumpingEnabledForHloModule(name, options);
+    // The choice only depends on the name.
+    EXPECT_EQ(DumpingEnabledForHloModule(name, options), dumped);
+    num_dumped += dumped;
+  }
+  EXPECT_GT(num_dumped, 0);
+  EXPECT_LT(num_dumped, 100);
+}
+
 TEST(DumpTest, DumpProtobufToFileWhenEnabled) {
   HloModuleProto module;
   module.set_name("hello");
@@ -413,6 +413,12 @@ class Executable {
     return {};
   }
 
+  // Returns the buffer assignment the executable was compiled with, or nullptr
+  // if it is not retained.
+  virtual const BufferAssignment* GetBufferAssignment() const {
+    return nullptr;
+  }
+
  protected:
   // HloModule this was compiled from. BufferAssignment keeps pointers to
   // HloInstructions owned by the HloModule so we need to keep the HloModule
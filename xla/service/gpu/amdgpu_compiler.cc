@@ -233,7 +233,8 @@ absl::Status AMDGPUCompiler::AddConvAndGemmAutotuningPasses(
   if (GpuConvAlgorithmPicker::IsEnabled(hlo_module)) {
     pipeline->AddPass<GpuConvAlgorithmPicker>(autotune_config);
   }
-  pipeline->AddPass<GemmAlgorithmPicker>(autotune_config);
+  pipeline->AddPass<GemmAlgorithmPicker>(autotune_config,
+                                         options.key_value_store);
   return absl::OkStatus();
 }
 
@@ -36,6 +36,7 @@ limitations under the License.
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
 #include "absl/time/clock.h"
+#include "absl/time/time.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/SHA256.h"
 #include "xla/autotune_results.pb.h"
@@ -43,6 +44,7 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_clone_context.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/pjrt/distributed/key_value_store_interface.h"
 #include "xla/service/dump.h"
 #include "xla/service/gpu/autotuning/autotuner_status_key.h"
 #include "xla/status_macros.h"
@@ -560,6 +562,58 @@ bool IsTextProtoPath(absl::string_view file_path) {
   return absl::OkStatus();
 }
 
+/*static*/ absl::Status AutotunerUtil::ExchangeResults(
+    KeyValueStoreInterface& key_value_store,
+    const AutotuneCacheKeySet& keys_to_send, absl::string_view key_prefix,
+    absl::string_view fingerprint, const int shard_index,
+    const int shard_count) {
+  AutotuneResults results;
+  TF_RETURN_IF_ERROR(SerializeAutotuneResults(&results, &keys_to_send));
+  TF_ASSIGN_OR_RETURN(std::string results_str,
+                      AutotuneResultsToString(results, true));
+  TF_RET_CHECK(!fingerprint.empty());
+  const std::string local_key =
+      absl::StrFormat("%s_%s_%d", key_prefix, fingerprint, shard_index);
+
+  absl::StatusOr<std::string> stored_result = key_value_store.TryGet(local_key);
+  // Given a sufficiently unique fingerprint, if the result already exists, then
+  // we may be recompiling a module that has already been autotuned within the
+  // scope of the relevant key-value store. In that case, we don't need to do
+  // anything.
+  if (stored_result.status().code() == absl::StatusCode::kNotFound) {
+    VLOG(2) << "Storing results for " << local_key;
+    TF_RETURN_IF_ERROR(key_value_store.Set(local_key, results_str));
+  } else if (!stored_result.ok()) {
+    return stored_result.status();
+  } else {
+    // TODO(bchetioui): we should optimize this to avoid even computing the
+    // results if they already exist.
+    VLOG(2) << "Results already exist for " << local_key << ", skipping store.";
+  }
+
+  VLOG(2) << "Rank " << shard_index << ": published results at " << local_key;
+  for (int i = 0; i < shard_count; ++i) {
+    if (i == shard_index) {
+      continue;
+    }
+    const std::string remote_key =
+        absl::StrFormat("%s_%s_%d", key_prefix, fingerprint, i);
+    VLOG(2) << "Rank " << shard_index << ": waiting for results from rank " << i
+            << " / " << shard_count << " at " << remote_key;
+    TF_ASSIGN_OR_RETURN(
+        std::string autotune_results_str,
+        key_value_store.Get(
+            remote_key,
+            // TODO(b/361009609): reset to infinite duration once solved.
+            // Using an infinite duration here leads to issues with MPI, see
+            // https://github.com/google/jax/issues/22995.
+            absl::Hours(24)));
+    TF_RETURN_IF_ERROR(LoadAutotuneResults(
+        autotune_results_str, /*as_textproto=*/true, /*allow_override=*/true));
+  }
+  return absl::OkStatus();
+}
+
 /*static*/ AutotunerUtil::CacheStats AutotunerUtil::GetCacheStats() {
   absl::MutexLock lock(&autotune_cache_mu);
   return autotune_cache_stats;
@@ -33,6 +33,7 @@ limitations under the License.
 #include "xla/autotune_results.pb.h"
 #include "xla/autotuning.pb.h"
 #include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/pjrt/distributed/key_value_store_interface.h"
 #include "xla/stream_executor/device_description.h"
 #include "xla/stream_executor/device_memory_allocator.h"
 #include "xla/stream_executor/stream_executor.h"
@@ -322,6 +323,24 @@ struct AutotunerUtil {
   // Warning: The results are only loaded to the in-memory cache.
   static absl::Status LoadAutotuneResultsFromFile(absl::string_view file_path);
 
+  // Publishes the results for `keys_to_send` to the given key-value store as
+  // shard `shard_index` and loads the results published by all the other
+  // `shard_count - 1` shards into the in-memory cache, blocking until they are
+  // available.
+  //
+  // `key_prefix` distinguishes the autotuners sharing a key-value store. The
+  // provided fingerprint must be sufficiently unique to avoid collisions when
+  // invoking an autotuner several times without invalidating the relevant
+  // key-value store. Collisions may result in the wrong results being fetched,
+  // leading to non-deterministic compilation. A good fingerprint uniquely
+  // identifies the input module, and the instructions that are being
+  // autotuned (up to 128-bit collisions :)).
+  static absl::Status ExchangeResults(KeyValueStoreInterface& key_value_store,
+                                      const AutotuneCacheKeySet& keys_to_send,
+                                      absl::string_view key_prefix,
+                                      absl::string_view fingerprint,
+                                      int shard_index, int shard_count);
+
   // Warning: This only clears the in-memory cache. If you use a file based
   // cache you're responsible for clearing the cache directory when you want to.
   static void ClearAutotuneResults();
@@ -17,6 +17,7 @@ limitations under the License.
 
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <optional>
 #include <string>
@@ -26,6 +27,7 @@ limitations under the License.
 #include "absl/log/check.h"
 #include "absl/log/log.h"
 #include "absl/strings/str_format.h"
+#include "absl/time/time.h"
 #include "llvm/ADT/STLExtras.h"
 #include "xla/hlo/ir/hlo_instructions.h"
 #include "xla/primitive_util.h"
@@ -150,6 +152,85 @@ std::vector<TritonGemmConfig> TritonDotFusionSearchSpace::GenerateConfigs(
   return result;
 }
 
+std::optional<absl::Duration> TritonDotFusionSearchSpace::EstimateRunTime(
+    const TritonGemmConfig& config) const {
+  const int64_t core_count = device_description_.core_count();
+  const int64_t fpus_per_core = device_description_.fpus_per_core();
+  const double flops_per_ns_per_fpu =
+      device_description_.clock_rate_ghz() * /*fma:*/ 2;
+  const double bytes_per_ns = device_description_.memory_bandwidth() * 1e-9;
+  if (core_count <= 0 || fpus_per_core <= 0 || flops_per_ns_per_fpu <= 0 ||
+      bytes_per_ns <= 0) {
+    return std::nullopt;
+  }
+
+  const int64_t num_output_tiles =
+      CeilOfRatio<int64_t>(lhs_parallel_size_, config.block_m) *
+      CeilOfRatio<int64_t>(rhs_parallel_size_, config.block_n);
+  const int64_t num_tiles = batch_size_ * config.split_k * num_output_tiles;
+  const int64_t num_waves = CeilOfRatio(num_tiles, core_count);
+  const int64_t active_cores = std::min(num_tiles, core_count);
+
+  // Partial tiles are padded, so every tile does the work of a full tile.
+  const int64_t tile_contracting_size = RoundUpTo<int64_t>(
+      CeilOfRatio<int64_t>(contracting_size_, config.split_k), config.block_k);
+  const double tile_flops =
+      2.0 * config.block_m * config.block_n * tile_contracting_size;
+  const double tile_bytes = (config.block_m + config.block_n) *
+                            tile_contracting_size * operand_bitwidth_ / 8.0;
+
+  // A tile runs on a single core, and the memory bandwidth is shared by all
+  // the cores that are active at the same time.
+  const int64_t threads_per_tile =
+      config.num_warps * device_description_.threads_per_warp();
+  const double compute_ns =
+      tile_flops / (flops_per_ns_per_fpu *
+                    std::min<int64_t>(threads_per_tile, fpus_per_core));
+  const double memory_ns = tile_bytes / (bytes_per_ns / active_cores);
+  // Pipelining overlaps loading the next contracting tile with computing the
+  // current one.
+  const double tile_ns = std::max(compute_ns, memory_ns) +
+                         std::min(compute_ns, memory_ns) / config.num_stages;
+
+  // With a contracting split, the partial results are written out, and read
+  // back again to be reduced.
+  const int64_t output_accesses =
+      config.split_k > 1 ? 2 * config.split_k + 1 : 1;
+  const double output_bytes = static_cast<double>(batch_size_) *
+                              lhs_parallel_size_ * rhs_parallel_size_ *
+                              compute_bitwidth_ / 8.0 * output_accesses;
+  return absl::Nanoseconds(num_waves * tile_ns + output_bytes / bytes_per_ns);
+}
+
+std::vector<TritonGemmConfig> TritonDotFusionSearchSpace::PruneConfigs(
+    std::vector<TritonGemmConfig> configs, int max_configs) const {
+  if (max_configs <= 0 || configs.size() <= static_cast<size_t>(max_configs)) {
+    return configs;
+  }
+  std::vector<std::pair<absl::Duration, TritonGemmConfig>> estimates;
+  estimates.reserve(configs.size());
+  for (const TritonGemmConfig& config : configs) {
+    std::optional<absl::Duration> run_time = EstimateRunTime(config);
+    if (!run_time.has_value()) {
+      return configs;
+    }
+    estimates.push_back({*run_time, config});
+  }
+  std::stable_sort(
+      estimates.begin(), estimates.end(),
+      [](const auto& a, const auto& b) { return a.first < b.first; });
+  estimates.resize(max_configs);
+
+  std::vector<TritonGemmConfig> result;
+  result.reserve(estimates.size());
+  for (const auto& [run_time, config] : estimates) {
+    VLOG(10) << "Keeping config " << config.ToString()
+             << " with estimated run time " << run_time;
+    result.push_back(config);
+  }
+  return result;
+}
+
 std::string TritonDotFusionSearchSpace::ToString() const {
   return absl::StrFormat(
       "problem_size_BxMxNxKxE: %dx%dx%dx%dx(%d->%d) "
@@ -310,6 +391,24 @@ int TritonDotFusionSearchSpace::GetMaxContractingSplit(
   VLOG(5) << "Computing split_k: Want split_k of up to " << split_for_occupancy
           << " for sufficient occupancy.";
 
+  // With more tiles than fit at once, the last wave of tiles might leave most
+  // cores idle. A contracting split creates more, smaller tiles, which evens
+  // out the last wave.
+  auto wave_utilization = [&](int64_t split) {
+    const int64_t num_tiles = min_result_tiles * split;
+    return static_cast<double>(num_tiles) /
+           RoundUpTo(num_tiles, desired_num_ctas);
+  };
+  int64_t split_for_last_wave = 1;
+  if (min_result_tiles > desired_num_ctas) {
+    while (split_for_last_wave < kMaxContractingSplitForLastWave &&
+           wave_utilization(split_for_last_wave) < kMinWaveUtilization) {
+      split_for_last_wave *= 2;
+    }
+  }
+  VLOG(5) << "Computing split_k: Want split_k of up to " << split_for_last_wave
+          << " to fill the last wave of tiles.";
+
   const int64_t split_for_contracting_size =
       NextPowerOfTwo(contracting_size_ / min_contracting_tile_size_);
   VLOG(5) << "Computing split_k: Can't have split_k more than "
@@ -317,7 +416,8 @@ int TritonDotFusionSearchSpace::GetMaxContractingSplit(
           << " to have sufficiently large contracting dimension.";
 
   const int64_t split =
-      std::min(split_for_occupancy, split_for_contracting_size);
+      std::min(std::max(split_for_occupancy, split_for_last_wave),
+               split_for_contracting_size);
   VLOG(5) << "Computing split_k: max_split_k = " << split;
   return split;
 }
@@ -21,6 +21,7 @@ limitations under the License.
 #include <string>
 #include <vector>
 
+#include "absl/time/time.h"
 #include "xla/hlo/ir/hlo_instructions.h"
 #include "xla/service/gpu/matmul_utils.h"
 #include "xla/stream_executor/device_description.h"
@@ -46,6 +47,20 @@ class TritonDotFusionSearchSpace {
   std::vector<TritonGemmConfig> GenerateConfigs(
       std::optional<int64_t> force_contracting_split = std::nullopt);
 
+  // Estimates the run time of the dot with the given config, using a roofline
+  // model per tile that is scaled by the number of waves of tiles needed to
+  // cover the output. The estimate is only meant to rank configs against each
+  // other. Returns std::nullopt if the device description lacks the
+  // information needed for the estimate.
+  std::optional<absl::Duration> EstimateRunTime(
+      const TritonGemmConfig& config) const;
+
+  // Keeps the `max_configs` configs with the lowest estimated run time, sorted
+  // by increasing estimated run time. Returns `configs` unchanged if
+  // `max_configs` is not positive, or if the run time can not be estimated.
+  std::vector<TritonGemmConfig> PruneConfigs(
+      std::vector<TritonGemmConfig> configs, int max_configs) const;
+
   // Serializes the search space to a human-readable string.
   std::string ToString() const;
 
@@ -84,6 +99,11 @@ class TritonDotFusionSearchSpace {
   // special function unit, etc.)
   // TODO: b/408114338 - Figure out a better model for this.
   static constexpr int kMaxWarpsPerScheduler = 5;
+  // When the output tiles take more than one wave of CTAs, we consider
+  // contracting splits of up to this value, until the waves are on average at
+  // least this full.
+  static constexpr int kMaxContractingSplitForLastWave = 4;
+  static constexpr double kMinWaveUtilization = 0.8;
 
   // Callback type for `ExtendConfigs`. The method should append zero or more
   // extensions of `config` to the `updated_configs` vector.
@@ -136,7 +156,7 @@ class TritonDotFusionSearchSpace {
 
   // Computes the maximum sensible split in the contracting dimension
   // (split_k) to sufficiently occupy all available cores when using the given
-  // output tile.
+  // output tile, including on the last wave of tiles.
   int GetMaxContractingSplit(OutputTile output_tile) const;
 
   // Computes the size limit for contracting dimension, based on the shared
@@ -15,12 +15,17 @@ limitations under the License.
 
 #include "xla/service/gpu/autotuning/dot_search_space.h"
 
+#include <algorithm>
 #include <memory>
+#include <optional>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include "absl/algorithm/container.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_format.h"
+#include "absl/time/time.h"
 #include "xla/hlo/ir/hlo_casting_utils.h"
 #include "xla/hlo/ir/hlo_instructions.h"
 #include "xla/hlo/testlib/hlo_hardware_independent_test_base.h"
@@ -182,6 +187,19 @@ TEST_F(DotSearchSpaceTest, LimitsContractingSplitForSmallerContractingSize) {
               AllOf(Not(IsEmpty()), Each(SplitKIs(Le(4)))));
 }
 
+TEST_F(DotSearchSpaceTest, ConsidersContractingSplitToFillLastWaveOfTiles) {
+  // With the largest tiles (256x512), there are 27 * 27 = 729 tiles, just
+  // over the 660 CTAs that we want to run at once.
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<VerifiedHloModule> module,
+                          GetDefaultDotModule(/*lhs_parallel_dim=*/6912,
+                                              /*rhs_parallel_dim=*/13824));
+  TritonDotFusionSearchSpace search_space = MakeSearchSpace(module.get());
+
+  EXPECT_THAT(search_space.GenerateConfigs(),
+              Contains(AllOf(BlockMIs(Eq(256)), BlockNIs(Eq(512)),
+                             SplitKIs(Eq(4)))));
+}
+
 TEST_F(DotSearchSpaceTest, FindsGoodDataReuseOutputTiles) {
   TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<VerifiedHloModule> module,
                           GetDefaultDotModule(/*lhs_parallel_dim=*/1024,
@@ -391,5 +409,62 @@ TEST_F(DotSearchSpaceTest, EnsuresWgmmaShapeForLargeProblem) {
                                        BlockNIs(Ge(16))))));
 }
 
+TEST_F(DotSearchSpaceTest, EstimatesLargerTilesAsFasterForLargeProblem) {
+  device_description_.set_clock_rate_ghz(1.755);
+  device_description_.set_fpus_per_core(128);
+  device_description_.set_memory_bandwidth(3'350'000'000'000);
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<VerifiedHloModule> module,
+                          GetDefaultDotModule());
+  TritonDotFusionSearchSpace search_space = MakeSearchSpace(module.get());
+
+  std::optional<absl::Duration> small_tile_run_time =
+      search_space.EstimateRunTime(TritonGemmConfig(
+          /*block_m=*/16, /*block_n=*/16, /*block_k=*/32, /*split_k=*/1,
+          /*num_stages=*/1, /*num_warps=*/1, /*num_ctas=*/1));
+  std::optional<absl::Duration> large_tile_run_time =
+      search_space.EstimateRunTime(TritonGemmConfig(
+          /*block_m=*/128, /*block_n=*/128, /*block_k=*/64, /*split_k=*/1,
+          /*num_stages=*/3, /*num_warps=*/4, /*num_ctas=*/1));
+
+  ASSERT_TRUE(small_tile_run_time.has_value());
+  ASSERT_TRUE(large_tile_run_time.has_value());
+  EXPECT_LT(*large_tile_run_time, *small_tile_run_time);
+}
+
+TEST_F(DotSearchSpaceTest, PrunesConfigsWithHighestEstimatedRunTime) {
+  device_description_.set_clock_rate_ghz(1.755);
+  device_description_.set_fpus_per_core(128);
+  device_description_.set_memory_bandwidth(3'350'000'000'000);
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<VerifiedHloModule> module,
+                          GetDefaultDotModule());
+  TritonDotFusionSearchSpace search_space = MakeSearchSpace(module.get());
+  std::vector<TritonGemmConfig> configs = search_space.GenerateConfigs();
+  ASSERT_THAT(configs.size(), Ge(4));
+
+  std::vector<TritonGemmConfig> pruned_configs =
+      search_space.PruneConfigs(configs, /*max_configs=*/3);
+
+  ASSERT_THAT(pruned_configs, SizeIs(3));
+  absl::Duration max_kept_run_time = absl::ZeroDuration();
+  for (const TritonGemmConfig& config : pruned_configs) {
+    max_kept_run_time =
+        std::max(max_kept_run_time, *search_space.EstimateRunTime(config));
+  }
+  for (const TritonGemmConfig& config : configs) {
+    if (!absl::c_linear_search(pruned_configs, config)) {
+      EXPECT_GE(*search_space.EstimateRunTime(config), max_kept_run_time);
+    }
+  }
+}
+
+TEST_F(DotSearchSpaceTest, DoesNotPruneConfigsWithoutPerformanceData) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<VerifiedHloModule> module,
+                          GetDefaultDotModule());
+  TritonDotFusionSearchSpace search_space = MakeSearchSpace(module.get());
+  std::vector<TritonGemmConfig> configs = search_space.GenerateConfigs();
+
+  EXPECT_EQ(search_space.PruneConfigs(configs, /*max_configs=*/1), configs);
+}
+
 }  // namespace
 }  // namespace xla::gpu
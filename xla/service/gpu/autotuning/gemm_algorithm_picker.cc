@@ -37,6 +37,8 @@ limitations under the License.
 #include "xla/backends/gpu/runtime/buffer_comparator.h"
 #include "xla/hlo/ir/hlo_computation.h"
 #include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/pjrt/distributed/key_value_store_interface.h"
 #include "xla/service/gpu/autotuning/autotuner_compile_util.h"
 #include "xla/service/gpu/autotuning/autotuner_util.h"
 #include "xla/service/gpu/backend_configs.pb.h"
@@ -411,6 +413,68 @@ class GemmAutotuner {
   }  // GetBestAlgorithm
 };  // class GemmAutotuner
 
+// Degenerate gemms replaced with memzero operation, no need to auto tune it.
+bool IsDegenerate(const GemmBackendConfig& backend_config) {
+  return backend_config.alpha_real() == 0.0 &&
+         backend_config.alpha_imag() == 0.0 && backend_config.beta() == 0.0;
+}
+
+// Autotunes this process' shard of the unique gemms in the module and
+// exchanges the results with the other processes, so that afterwards the
+// results for all the gemms are in the autotuning cache of every process.
+absl::Status AutotuneShardAndExchangeResults(
+    HloModule* module,
+    const absl::flat_hash_set<absl::string_view>& execution_threads,
+    GemmAutotuner& autotuner,
+    const MultiProcessKeyValueStore& key_value_store) {
+  const AutotuneConfig& config = autotuner.config();
+  // All processes compile the same module, so they collect the gemms in the
+  // same order and agree on the sharding.
+  std::vector<std::pair<AutotuneCacheKey, HloInstruction*>> gemms;
+  AutotuneCacheKeySet seen_keys;
+  for (HloComputation* computation :
+       module->MakeNonfusionComputations(execution_threads)) {
+    for (HloInstruction* instr : computation->instructions()) {
+      if (!IsCublasGemm(*instr)) {
+        continue;
+      }
+      TF_ASSIGN_OR_RETURN(GpuBackendConfig gpu_config,
+                          instr->backend_config<GpuBackendConfig>());
+      if (IsDegenerate(gpu_config.gemm_backend_config())) {
+        continue;
+      }
+      AutotuneCacheKey key(config.GetModelStr(), *instr);
+      if (seen_keys.insert(key).second) {
+        gemms.emplace_back(std::move(key), instr);
+      }
+    }
+  }
+  if (gemms.empty()) {
+    return absl::OkStatus();
+  }
+
+  AutotuneCacheKeySet keys_of_this_rank;
+  for (size_t i = key_value_store.process_index; i < gemms.size();
+       i += key_value_store.process_count) {
+    const AutotuneCacheKey& key = gemms[i].first;
+    HloInstruction* gemm = gemms[i].second;
+    TF_RETURN_IF_ERROR(AutotunerUtil::Autotune(gemm, config, [&] {
+                         return autotuner(gemm, key);
+                       }).status());
+    keys_of_this_rank.insert(key);
+  }
+  VLOG(2) << "Autotuned " << keys_of_this_rank.size() << " out of "
+          << gemms.size() << " gemms in rank "
+          << key_value_store.process_index;
+
+  std::string fingerprint =
+      absl::StrCat(module->GetFingerprint128(), "_", gemms.size());
+  return AutotunerUtil::ExchangeResults(
+      *key_value_store.key_value_store, keys_of_this_rank,
+      "gemm_algorithm_autotuning_results", fingerprint,
+      key_value_store.process_index, key_value_store.process_count);
+}
+
 // Do Gemm Autotune without stream executor. Use results from autotune cache
 // only.
 absl::StatusOr<bool> RunOnInstruction(HloInstruction* gemm,
@@ -421,9 +485,7 @@ absl::StatusOr<bool> RunOnInstruction(HloInstruction* gemm,
       gemm->backend_config<GpuBackendConfig>().value();
   GemmBackendConfig& backend_config = *gpu_config.mutable_gemm_backend_config();
 
-  // Degenerate gemms replaced with memzero operation, no need to auto tune it.
-  if (backend_config.alpha_real() == 0.0 &&
-      backend_config.alpha_imag() == 0.0 && backend_config.beta() == 0.0) {
+  if (IsDegenerate(backend_config)) {
     VLOG(3) << "Skip degenerate gemm instruction auto tuning";
     return false;
   }
@@ -504,6 +566,15 @@ absl::StatusOr<bool> GemmAlgorithmPicker::Run(
     return false;
   }
   GemmAutotuner autotuner(config_);
+  if (module->config().debug_options().xla_gpu_shard_autotuning() &&
+      key_value_store_.process_count > 1 && !config_.IsDeviceless()) {
+    if (key_value_store_.key_value_store == nullptr) {
+      return absl::FailedPreconditionError(
+          "Sharded autotuning requested but key-value store is missing.");
+    }
+    TF_RETURN_IF_ERROR(AutotuneShardAndExchangeResults(
+        module, execution_threads, autotuner, key_value_store_));
+  }
   bool changed = false;
   for (HloComputation* computation :
        module->MakeNonfusionComputations(execution_threads)) {
@@ -18,6 +18,7 @@ limitations under the License.
 #include <cstddef>
 #include <functional>
 #include <optional>
+#include <utility>
 
 #include "absl/container/flat_hash_set.h"
 #include "absl/status/statusor.h"
@@ -27,6 +28,7 @@ limitations under the License.
 #include "xla/autotuning.pb.h"
 #include "xla/hlo/ir/hlo_module.h"
 #include "xla/hlo/pass/hlo_pass_interface.h"
+#include "xla/pjrt/distributed/key_value_store_interface.h"
 #include "xla/service/gpu/autotuning/autotuner_util.h"
 #include "xla/service/hlo_module_config.h"
 #include "xla/shape.h"
@@ -46,7 +48,12 @@ namespace gpu {
 // autotune result is not stored, then algorithm is set to kRuntimeAutotuning.
 class GemmAlgorithmPicker : public HloModulePass {
  public:
-  explicit GemmAlgorithmPicker(AutotuneConfig config) : config_(config) {}
+  // If `key_value_store` spans more than one process and sharded autotuning is
+  // enabled, each process autotunes a disjoint subset of the GEMMs and the
+  // results are exchanged through the key-value store.
+  explicit GemmAlgorithmPicker(AutotuneConfig config,
+                               MultiProcessKeyValueStore key_value_store = {})
+      : config_(config), key_value_store_(std::move(key_value_store)) {}
 
   absl::string_view name() const override { return "gemm-algorithm-picker"; }
 
@@ -59,6 +66,7 @@ class GemmAlgorithmPicker : public HloModulePass {
 
  private:
   AutotuneConfig config_;
+  MultiProcessKeyValueStore key_value_store_;
   // The number of valid algorithms used for autotuning (from the last call),
   // to be used for testing purposes.
   size_t num_algorithms_left_ = 0;
@@ -17,14 +17,21 @@ limitations under the License.
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <variant>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "absl/time/time.h"
 #include "xla/autotune_results.pb.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/testlib/pattern_matcher_gmock.h"
+#include "xla/pjrt/distributed/key_value_store_interface.h"
 #include "xla/service/gpu/autotuning/autotuner_util.h"
 #include "xla/service/gpu/backend_configs.pb.h"
 #include "xla/service/gpu/transforms/gemm_rewriter.h"
@@ -39,6 +46,7 @@ limitations under the License.
 #include "xla/tsl/platform/test.h"
 #include "xla/tsl/protobuf/dnn.pb.h"
 #include "xla/xla.pb.h"
+#include "tsl/platform/protobuf.h"
 
 namespace xla::gpu {
 namespace {
@@ -323,6 +331,88 @@ ENTRY main {
   EXPECT_EQ(config.selected_algorithm(), new_algo_id);
 }
 
+// Key-value store that returns empty autotuning results when getting a key
+// that is not present, as if the other processes did not autotune anything.
+class EmptyResultsKeyValueStore : public KeyValueStoreInterface {
+ public:
+  absl::StatusOr<std::string> Get(absl::string_view key,
+                                  absl::Duration timeout) override {
+    if (auto it = storage_.find(key); it != storage_.end()) {
+      return it->second;
+    }
+    return AutotuneResultsToString(AutotuneResults(), /*as_textproto=*/true);
+  }
+
+  absl::StatusOr<std::string> TryGet(absl::string_view key) override {
+    if (auto it = storage_.find(key); it != storage_.end()) {
+      return it->second;
+    }
+    return absl::NotFoundError(absl::StrCat("Key not found: ", key));
+  }
+
+  absl::Status Set(absl::string_view key, absl::string_view value) override {
+    storage_[key] = std::string(value);
+    return absl::OkStatus();
+  }
+
+  const absl::flat_hash_map<std::string, std::string>& storage() const {
+    return storage_;
+  }
+
+ private:
+  absl::flat_hash_map<std::string, std::string> storage_;
+};
+
+TEST_P(GemmAlgorithmPickerTest, ShardedAutotuningPublishesOnlyOwnShard) {
+  constexpr absl::string_view kHlo = R"(
+HloModule module
+
+ENTRY main {
+  %arg0 = f32[100,100]{1,0} parameter(0)
+  %arg1 = f32[100,100]{1,0} parameter(1)
+  %arg2 = f32[200,100]{1,0} parameter(2)
+  %dot0 = f32[100,100]{1,0} dot(arg0, arg1), lhs_contracting_dims={1}, rhs_contracting_dims={0}
+  %dot1 = f32[200,100]{1,0} dot(arg2, arg1), lhs_contracting_dims={1}, rhs_contracting_dims={0}
+  ROOT %tuple = (f32[100,100]{1,0}, f32[200,100]{1,0}) tuple(dot0, dot1)
+})";
+  auto module_cfg = GetModuleConfigForTest();
+  DebugOptions debug_options = module_cfg.debug_options();
+  debug_options.set_xla_gpu_shard_autotuning(true);
+  module_cfg.set_debug_options(debug_options);
+  TF_ASSERT_OK_AND_ASSIGN(auto m,
+                          ParseAndReturnVerifiedModule(kHlo, module_cfg));
+  TF_ASSERT_OK(
+      RunHloPass(GemmRewriter(gpu_comp(),
+                              /*toolkit_version=*/se::SemanticVersion{12, 4, 0}),
+                 m.get())
+          .status());
+
+  auto key_value_store = std::make_shared<EmptyResultsKeyValueStore>();
+  MultiProcessKeyValueStore multi_process_key_value_store;
+  multi_process_key_value_store.key_value_store = key_value_store;
+  multi_process_key_value_store.process_count = 2;
+
+  DebugOptions opts;
+  AutotuneConfig cfg{DeviceConfig{stream_exec(), nullptr}, opts};
+  TF_ASSERT_OK(
+      RunHloPass(GemmAlgorithmPicker(cfg, multi_process_key_value_store),
+                 m.get())
+          .status());
+
+  // Only the results of the first gemm were published by this process.
+  ASSERT_EQ(key_value_store->storage().size(), 1);
+  AutotuneResults published_results;
+  ASSERT_TRUE(tsl::protobuf::TextFormat::ParseFromString(
+      key_value_store->storage().begin()->second, &published_results));
+  EXPECT_EQ(published_results.results_size(), 1);
+
+  // The second gemm, that no other process autotuned, was still autotuned
+  // locally.
+  AutotuneResults results;
+  TF_ASSERT_OK(AutotunerUtil::SerializeAutotuneResults(&results));
+  EXPECT_EQ(results.results_size(), 2);
+}
+
 INSTANTIATE_TEST_SUITE_P(GemmAlgorithmPickerTestSuite, GemmAlgorithmPickerTest,
                          ::testing::Bool());
 
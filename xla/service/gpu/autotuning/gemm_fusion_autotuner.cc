@@ -18,6 +18,7 @@ limitations under the License.
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <optional>
@@ -93,9 +94,12 @@ limitations under the License.
 #include "xla/stream_executor/device_memory.h"
 #include "xla/stream_executor/device_memory_allocator.h"
 #include "xla/stream_executor/gpu/redzone_allocator.h"
+#include "xla/stream_executor/platform.h"
+#include "xla/stream_executor/platform_manager.h"
 #include "xla/stream_executor/integrations/tf_allocator_adapter.h"
 #include "xla/stream_executor/semantic_version.h"
 #include "xla/stream_executor/stream.h"
+#include "xla/stream_executor/stream_executor.h"
 #include "xla/tools/hlo_decomposer.h"
 #include "xla/tsl/lib/core/bits.h"
 #include "xla/tsl/platform/env.h"
@@ -654,24 +658,34 @@ absl::Status GemmFusionAutotunerRewriterVisitor::HandleFusion(
   }
 
   VLOG(4) << "Autotuning fusion instruction: " << fusion_instr->ToString();
-  TF_ASSIGN_OR_RETURN(
-      AutotuneResult autotune_result,
-      AutotunerUtil::Autotune(
-          fusion_instr, config_, [&]() -> absl::StatusOr<AutotuneResult> {
-            absl::Status s;
-            if (config_.IsDeviceless()) {
-              s = absl::InternalError(absl::StrCat(
-                  "Expect autotune result cache hit for deviceless "
-                  "compilation (HLO: ",
-                  fusion_instr->ToString(), ")"));
-            } else {
-              s = absl::InternalError("Expect autotune result cache hit.");
-            }
-            tsl::errors::InsertPayloads(
-                s, {{std::string(kAutotuneCacheRequiredErrorPayloadKey), ""}});
+  const AutotuneCacheKey key = AutotunerUtil::GetKey(fusion_instr, config_);
+  TF_ASSIGN_OR_RETURN(bool is_in_cache, AutotunerUtil::IsInCache(key, config_));
+  auto default_result = default_results_.find(key);
+
+  AutotuneResult autotune_result;
+  if (!is_in_cache && default_result != default_results_.end()) {
+    autotune_result = default_result->second;
+  } else {
+    TF_ASSIGN_OR_RETURN(
+        autotune_result,
+        AutotunerUtil::Autotune(
+            fusion_instr, config_, [&]() -> absl::StatusOr<AutotuneResult> {
+              absl::Status s;
+              if (config_.IsDeviceless()) {
+                s = absl::InternalError(absl::StrCat(
+                    "Expect autotune result cache hit for deviceless "
+                    "compilation (HLO: ",
+                    fusion_instr->ToString(), ")"));
+              } else {
+                s = absl::InternalError("Expect autotune result cache hit.");
+              }
+              tsl::errors::InsertPayloads(
+                  s,
+                  {{std::string(kAutotuneCacheRequiredErrorPayloadKey), ""}});
 
-            return s;
-          }));
+              return s;
+            }));
+  }
   VLOG(4) << "Autotuning result: " << autotune_result.ShortDebugString();
 
   if (autotune_result.has_triton()) {
@@ -845,6 +859,16 @@ GemmFusionAutotunerImpl::GenerateConfigs(const HloFusionInstruction& fusion) {
   // Add triton configs.
   TF_ASSIGN_OR_RETURN(std::vector<TritonGemmConfig> triton_configs,
                       GenerateTritonConfigs(*dot));
+  if (const int max_triton_configs =
+          debug_options_.xla_gpu_autotune_max_triton_configs();
+      max_triton_configs > 0 && IsAutotuningEnabled()) {
+    const size_t num_generated_configs = triton_configs.size();
+    triton_configs =
+        TritonDotFusionSearchSpace(config_.GetDeviceDescription(), dot)
+            .PruneConfigs(std::move(triton_configs), max_triton_configs);
+    VLOG(1) << "Pruned Triton configs for " << fusion.name() << " from "
+            << num_generated_configs << " to " << triton_configs.size();
+  }
   for (TritonGemmConfig& config : triton_configs) {
     configs.push_back(std::move(config));
   }
@@ -1143,13 +1167,13 @@ GemmFusionAutotunerImpl::CompileAll(AutotunerCompileUtil& compile_util,
 }
 
 absl::Status GemmFusionAutotunerImpl::CompareBuffers(
-    const HloFusionInstruction& fusion,
+    const AutotuneConfig& config, const HloFusionInstruction& fusion,
     const ScopedShapedBuffer& reference_buffer,
     const ScopedShapedBuffer& buffer, AutotuneResult& res) {
   const HloInstruction& root = *fusion.called_computation_root();
   BufferComparator comparator(root.shape(),
                               debug_options_.xla_gpu_autotune_gemm_rtol());
-  TF_ASSIGN_OR_RETURN(se::Stream* const stream, config_.GetStream());
+  TF_ASSIGN_OR_RETURN(se::Stream* const stream, config.GetStream());
 
   TF_ASSIGN_OR_RETURN(
       bool outputs_match,
@@ -1161,7 +1185,7 @@ absl::Status GemmFusionAutotunerImpl::CompareBuffers(
         "Results do not match the reference. This is likely a "
         "bug/unexpected loss of precision.";
     LOG(ERROR) << kMessage;
-    CHECK(!config_.should_crash_on_check_failure());
+    CHECK(!config.should_crash_on_check_failure());
     // WRONG_RESULT is not taken seriously by PickBestResult(), so
     // use DISQUALIFIED.
     res.mutable_failure()->set_kind(AutotuneResult::DISQUALIFIED);
@@ -1171,26 +1195,27 @@ absl::Status GemmFusionAutotunerImpl::CompareBuffers(
 }
 
 absl::StatusOr<bool> GemmFusionAutotunerImpl::CheckRedZones(
-    const RedzoneBuffers& rz_buffers, AutotuneResult& res) {
+    const AutotuneConfig& config, const RedzoneBuffers& rz_buffers,
+    AutotuneResult& res) {
   TF_ASSIGN_OR_RETURN(se::RedzoneAllocator::RedzoneCheckStatus rz_check_status,
                       rz_buffers.RedzoneAllocator().CheckRedzones());
   if (rz_check_status.ok()) return true;
   LOG(ERROR) << "Red zone modified";
   res.mutable_failure()->set_kind(AutotuneResult::REDZONE_MODIFIED);
   res.mutable_failure()->set_msg(rz_check_status.RedzoneFailureMsg());
-  CHECK(!config_.should_crash_on_check_failure());
+  CHECK(!config.should_crash_on_check_failure());
   return false;
 }
 
 absl::StatusOr<AutotuneResult> GemmFusionAutotunerImpl::MeasurePerformance(
-    AutotunerCompileUtil& compile_util, const HloFusionInstruction& fusion,
-    const ExecutableCandidate& candidate,
+    const AutotuneConfig& config, AutotunerCompileUtil& compile_util,
+    const HloFusionInstruction& fusion, const ExecutableCandidate& candidate,
     std::optional<ScopedShapedBuffer>& reference_buffer) {
-  se::StreamExecutor* stream_exec = config_.GetExecutor();
+  se::StreamExecutor* stream_exec = config.GetExecutor();
   if (!stream_exec->SynchronizeAllActivity()) {
     return Internal("Failed to synchronize GPU for autotuning.");
   }
-  TF_ASSIGN_OR_RETURN(se::Stream* const stream, config_.GetStream());
+  TF_ASSIGN_OR_RETURN(se::Stream* const stream, config.GetStream());
 
   VLOG(5) << "Trying : " << ConfigToString(candidate.config);
   AutotuneResult res = FromConfig(candidate.config);
@@ -1198,7 +1223,7 @@ absl::StatusOr<AutotuneResult> GemmFusionAutotunerImpl::MeasurePerformance(
   const HloComputation* fusion_computation = fusion.called_computation();
   TF_ASSIGN_OR_RETURN(auto rz_buffers,
                       RedzoneBuffers::FromInstruction(
-                          *fusion_computation->FusionInstruction(), config_,
+                          *fusion_computation->FusionInstruction(), config,
                           debug_options_, RedzoneBuffers::kAllInputs));
 
   TF_ASSIGN_OR_RETURN(
@@ -1216,7 +1241,7 @@ absl::StatusOr<AutotuneResult> GemmFusionAutotunerImpl::MeasurePerformance(
   *res.mutable_run_time() =
       tsl::proto_utils::ToDurationProto(profiling_output.duration);
 
-  if (!config_.should_check_correctness()) {
+  if (!config.should_check_correctness()) {
     return res;
   }
 
@@ -1228,10 +1253,10 @@ absl::StatusOr<AutotuneResult> GemmFusionAutotunerImpl::MeasurePerformance(
   // Reference buffer is available when `config.should_check_correctness()`
   // is set and reference executable was compiled.
   if (reference_buffer.has_value()) {
-    TF_ASSIGN_OR_RETURN(bool rz_ok, CheckRedZones(rz_buffers, res));
+    TF_ASSIGN_OR_RETURN(bool rz_ok, CheckRedZones(config, rz_buffers, res));
     if (!rz_ok) return res;
 
-    TF_RETURN_IF_ERROR(CompareBuffers(fusion, *reference_buffer,
+    TF_RETURN_IF_ERROR(CompareBuffers(config, fusion, *reference_buffer,
                                       profiling_output.output, res));
   }
   return res;
@@ -1240,6 +1265,14 @@ absl::StatusOr<AutotuneResult> GemmFusionAutotunerImpl::MeasurePerformance(
 absl::StatusOr<std::vector<AutotuneResult>> GemmFusionAutotunerImpl::Profile(
     AutotunerCompileUtil& compile_util, const HloFusionInstruction& fusion,
     absl::Span<const ExecutableCandidate> candidates) {
+  return ProfileOnDevice(config_, compile_util, fusion, candidates);
+}
+
+absl::StatusOr<std::vector<AutotuneResult>>
+GemmFusionAutotunerImpl::ProfileOnDevice(
+    const AutotuneConfig& config, AutotunerCompileUtil& compile_util,
+    const HloFusionInstruction& fusion,
+    absl::Span<const ExecutableCandidate> candidates) {
   tsl::profiler::ScopedAnnotation annotation([&] {
     return absl::StrFormat("XlaAutotunerMeasurement:#hlo_op=%s#",
                            fusion.name());
@@ -1249,7 +1282,7 @@ absl::StatusOr<std::vector<AutotuneResult>> GemmFusionAutotunerImpl::Profile(
   std::optional<ScopedShapedBuffer> reference_buffer;
   for (int i = 0; i < candidates.size(); ++i) {
     absl::StatusOr<AutotuneResult> result = MeasurePerformance(
-        compile_util, fusion, candidates[i], reference_buffer);
+        config, compile_util, fusion, candidates[i], reference_buffer);
     // Treat register allocation error gracefully. If the compilation happens
     // with the driver during execution then the error could surface here.
     // It's enough to check this once here.
@@ -1276,6 +1309,115 @@ absl::StatusOr<std::vector<AutotuneResult>> GemmFusionAutotunerImpl::Profile(
   return results;
 }
 
+absl::StatusOr<std::vector<std::unique_ptr<AutotuneConfig>>>
+GemmFusionAutotunerImpl::CreateBenchmarkDeviceConfigs() const {
+  std::vector<std::unique_ptr<AutotuneConfig>> configs;
+  se::StreamExecutor* executor = config_.GetExecutor();
+  const se::DeviceDescription& description = executor->GetDeviceDescription();
+  TF_ASSIGN_OR_RETURN(
+      se::Platform * platform,
+      se::PlatformManager::PlatformWithId(executor->GetPlatform()->id()));
+  const int64_t max_devices = debug_options_.xla_gpu_autotune_max_devices();
+  for (int ordinal = 0; ordinal < platform->VisibleDeviceCount() &&
+                        configs.size() + 1 < max_devices;
+       ++ordinal) {
+    if (ordinal == executor->device_ordinal()) continue;
+    TF_ASSIGN_OR_RETURN(se::StreamExecutor * other,
+                        platform->ExecutorForDevice(ordinal));
+    const se::DeviceDescription& other_description =
+        other->GetDeviceDescription();
+    if (other_description.name() != description.name() ||
+        other_description.core_count() != description.core_count() ||
+        other_description.clock_rate_ghz() != description.clock_rate_ghz()) {
+      VLOG(1) << "Not autotuning on device " << ordinal << " ("
+              << other_description.name() << "), which differs from device "
+              << executor->device_ordinal() << " (" << description.name()
+              << ").";
+      continue;
+    }
+    // The default allocator of the executor is used, as the allocator of the
+    // autotuning config may only serve its own device.
+    configs.push_back(std::make_unique<AutotuneConfig>(
+        DeviceConfig{other, /*allocator=*/nullptr}, debug_options_));
+  }
+  return configs;
+}
+
+absl::StatusOr<absl::flat_hash_map<const HloFusionInstruction*,
+                                   std::vector<AutotuneResult>>>
+GemmFusionAutotunerImpl::ProfileAll(
+    AutotunerCompileUtil& compile_util,
+    const absl::flat_hash_map<const HloFusionInstruction*,
+                              std::vector<ExecutableCandidate>>&
+        executable_sets) {
+  absl::flat_hash_map<const HloFusionInstruction*, std::vector<AutotuneResult>>
+      results;
+
+  std::vector<std::unique_ptr<AutotuneConfig>> device_configs;
+  if (debug_options_.xla_gpu_autotune_max_devices() > 1 &&
+      executable_sets.size() > 1) {
+    TF_ASSIGN_OR_RETURN(device_configs, CreateBenchmarkDeviceConfigs());
+  }
+
+  if (device_configs.empty()) {
+    for (const auto& [fusion, candidates] : executable_sets) {
+      TF_ASSIGN_OR_RETURN(results[fusion],
+                          Profile(compile_util, *fusion, candidates));
+    }
+    return results;
+  }
+
+  // Candidates are compiled once, and executed on the device of the compile
+  // util that profiles them.
+  std::vector<std::unique_ptr<AutotunerCompileUtil>> device_compile_utils;
+  for (const std::unique_ptr<AutotuneConfig>& device_config : device_configs) {
+    TF_ASSIGN_OR_RETURN(
+        AutotunerCompileUtil device_compile_util,
+        AutotunerCompileUtil::Create(*device_config, debug_options_));
+    device_compile_utils.push_back(
+        std::make_unique<AutotunerCompileUtil>(std::move(device_compile_util)));
+  }
+
+  // Spread the fusions over the devices in a well-defined order.
+  std::vector<const HloFusionInstruction*> fusions;
+  fusions.reserve(executable_sets.size());
+  for (const auto& [fusion, unused] : executable_sets) {
+    fusions.push_back(fusion);
+  }
+  absl::c_sort(fusions, [](const HloFusionInstruction* a,
+                           const HloFusionInstruction* b) {
+    return a->name() < b->name();
+  });
+
+  const int num_devices = device_configs.size() + 1;
+  VLOG(1) << "Profiling " << fusions.size() << " fusions on " << num_devices
+          << " devices.";
+  std::vector<absl::StatusOr<std::vector<AutotuneResult>>> fusion_results(
+      fusions.size());
+  {
+    tsl::thread::ThreadPool device_threads(
+        tsl::Env::Default(), "gemm_fusion_autotuner_devices", num_devices);
+    for (int device = 0; device < num_devices; ++device) {
+      device_threads.Schedule([&, device] {
+        const AutotuneConfig& config =
+            device == 0 ? config_ : *device_configs[device - 1];
+        AutotunerCompileUtil& device_compile_util =
+            device == 0 ? compile_util : *device_compile_utils[device - 1];
+        for (int i = device; i < fusions.size(); i += num_devices) {
+          fusion_results[i] =
+              ProfileOnDevice(config, device_compile_util, *fusions[i],
+                              executable_sets.at(fusions[i]));
+        }
+      });
+    }
+  }
+
+  for (int i = 0; i < fusions.size(); ++i) {
+    TF_ASSIGN_OR_RETURN(results[fusions[i]], std::move(fusion_results[i]));
+  }
+  return results;
+}
+
 std::vector<TritonGemmConfig>
 GemmFusionAutotunerImpl::GetExhaustiveTritonConfigs() const {
   std::vector<TritonGemmConfig> configs;
@@ -1359,6 +1501,9 @@ absl::Status GemmFusionAutotunerImpl::Autotune(
     });
   }
 
+  TF_ASSIGN_OR_RETURN(auto fusion_results,
+                      ProfileAll(compile_util, executable_sets));
+
   AutotuningLogs autotuning_logs;
   int fusion_id = 0;
   for (const auto& [fusion, candidates] : executable_sets) {
@@ -1366,8 +1511,7 @@ absl::Status GemmFusionAutotunerImpl::Autotune(
       TF_RETURN_IF_ERROR(DumpOriginalFusion(compile_util, *fusion, fusion_id));
     }
 
-    TF_ASSIGN_OR_RETURN(std::vector<AutotuneResult> results,
-                        Profile(compile_util, *fusion, candidates));
+    std::vector<AutotuneResult>& results = fusion_results[fusion];
 
     // The reference config (if it exists) will be the first in the results,
     // due to how sorting the variants work.
@@ -1419,66 +1563,6 @@ absl::Status GemmFusionAutotunerImpl::Autotune(
   return DumpAutotuningLogs(debug_options_, autotuning_logs);
 }
 
-// Exchanges the results with the other hosts. The provided fingerprint must be
-// sufficiently unique to avoid collisions when invoking the autotuner several
-// times without invalidating the relevant key-value store. Collisions may
-// result in the wrong results being fetched, leading to non-deterministic
-// compilation. A good fingerprint uniquely identifies the input module, and
-// the fusions that are being autotuned (up to 128-bit collisions :)).
-static absl::Status ExchangeResults(KeyValueStoreInterface& key_value_store,
-                                    const AutotuneCacheKeySet& keys_to_send,
-                                    absl::string_view fingerprint,
-                                    const int shard_index,
-                                    const int shard_count) {
-  AutotuneResults results;
-  TF_RETURN_IF_ERROR(
-      AutotunerUtil::SerializeAutotuneResults(&results, &keys_to_send));
-  TF_ASSIGN_OR_RETURN(std::string results_str,
-                      AutotuneResultsToString(results, true));
-  constexpr absl::string_view kKeyPrefix = "gemm_fusion_autotuning_results";
-  TF_RET_CHECK(!fingerprint.empty());
-  const std::string local_key =
-      absl::StrFormat("%s_%s_%d", kKeyPrefix, fingerprint, shard_index);
-
-  absl::StatusOr<std::string> stored_result = key_value_store.TryGet(local_key);
-  // Given a sufficiently unique fingerprint, if the result already exists, then
-  // we may be recompiling a module that has already been autotuned within the
-  // scope of the relevant key-value store. In that case, we don't need to do
-  // anything.
-  if (stored_result.status().code() == absl::StatusCode::kNotFound) {
-    VLOG(2) << "Storing results for " << local_key;
-    TF_RETURN_IF_ERROR(key_value_store.Set(local_key, results_str));
-  } else if (!stored_result.ok()) {
-    return stored_result.status();
-  } else {
-    // TODO(bchetioui): we should optimize this to avoid even computing the
-    // results if they already exist.
-    VLOG(2) << "Results already exist for " << local_key << ", skipping store.";
-  }
-
-  VLOG(2) << "Rank " << shard_index << ": published results at " << local_key;
-  for (int i = 0; i < shard_count; ++i) {
-    if (i == shard_index) {
-      continue;
-    }
-    const std::string remote_key =
-        absl::StrFormat("%s_%s_%d", kKeyPrefix, fingerprint, i);
-    VLOG(2) << "Rank " << shard_index << ": waiting for results from rank " << i
-            << " / " << shard_count << " at " << remote_key;
-    TF_ASSIGN_OR_RETURN(
-        std::string autotune_results_str,
-        key_value_store.Get(
-            remote_key,
-            // TODO(b/361009609): reset to infinite duration once solved.
-            // Using an infinite duration here leads to issues with MPI, see
-            // https://github.com/google/jax/issues/22995.
-            absl::Hours(24)));
-    TF_RETURN_IF_ERROR(AutotunerUtil::LoadAutotuneResults(
-        autotune_results_str, /*as_textproto=*/true, /*allow_override=*/true));
-  }
-  return absl::OkStatus();
-}
-
 absl::StatusOr<bool> GemmFusionAutotuner::Run(
     HloModule* module,
     const absl::flat_hash_set<absl::string_view>& execution_threads) {
@@ -1515,13 +1599,25 @@ absl::StatusOr<bool> GemmFusionAutotuner::Run(
       const BackendConfigs config_sets,
       fusion_collector.GenerateConfigs(fusions.keys_and_instructions));
 
+  // Default configs used instead of autotuning results, that are not added to
+  // the autotuning cache.
+  absl::flat_hash_map<AutotuneCacheKey, AutotuneResult> default_results;
+
   if (!autotuner.IsAutotuningEnabled()) {
-    // Pick the first option for each gemm instead of autotuning.
+    // Pick the first option for each gemm instead of autotuning. If autotuning
+    // runs in the background, we must not cache the default configs, as they
+    // would shadow autotuning results from the background compilation.
+    const bool autotune_in_background =
+        debug_options.xla_gpu_experimental_autotune_in_background();
     for (const auto& [fusion, tilings] : config_sets) {
       const AutotuneCacheKey key = AutotunerUtil::GetKey(fusion, config_);
       AutotuneResult res = FromConfig(tilings[0]);
       *res.mutable_run_time() =
           tsl::proto_utils::ToDurationProto(absl::ZeroDuration());
+      if (autotune_in_background) {
+        default_results[key] = std::move(res);
+        continue;
+      }
       TF_RETURN_IF_ERROR(AutotunerUtil::AddResult(key, res, config_).status());
     }
   } else if (!debug_options.xla_gpu_override_gemm_autotuner().empty()) {
@@ -1592,14 +1688,15 @@ absl::StatusOr<bool> GemmFusionAutotuner::Run(
         absl::StrCat(module->GetFingerprint128(), "_", fusions.fingerprint);
 
     if (shard_autotuning && number_of_fusions_in_module > 0) {
-      TF_RETURN_IF_ERROR(ExchangeResults(
-          *key_value_store_.key_value_store, keys_of_this_rank, fingerprint,
+      TF_RETURN_IF_ERROR(AutotunerUtil::ExchangeResults(
+          *key_value_store_.key_value_store, keys_of_this_rank,
+          "gemm_fusion_autotuning_results", fingerprint,
           key_value_store_.process_index, key_value_store_.process_count));
     }
   }
 
-  return GemmFusionAutotunerRewriterVisitor(config_).RunOnModule(
-      module, execution_threads);
+  return GemmFusionAutotunerRewriterVisitor(config_, std::move(default_results))
+      .RunOnModule(module, execution_threads);
 }
 
 }  // namespace gpu
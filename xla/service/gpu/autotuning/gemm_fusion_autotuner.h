@@ -53,13 +53,19 @@ namespace gpu {
 // Uses profile results to rewrite a gemm fusion to use the best backend.
 class GemmFusionAutotunerRewriterVisitor : public DfsHloRewriteVisitor {
  public:
-  explicit GemmFusionAutotunerRewriterVisitor(const AutotuneConfig& config)
-      : config_(config) {}
+  // Results in `default_results` are used for fusions that are not in the
+  // autotuning cache, without adding them to the cache.
+  explicit GemmFusionAutotunerRewriterVisitor(
+      const AutotuneConfig& config,
+      absl::flat_hash_map<AutotuneCacheKey, AutotuneResult> default_results =
+          {})
+      : config_(config), default_results_(std::move(default_results)) {}
 
   absl::Status HandleFusion(HloInstruction* fusion_instr) override;
 
  private:
   AutotuneConfig config_;
+  absl::flat_hash_map<AutotuneCacheKey, AutotuneResult> default_results_;
 };
 
 // Takes a gemm fusion and chooses between cuBLAS, cuDNN, and Triton backends.
@@ -168,18 +174,43 @@ class GemmFusionAutotunerImpl {
   // If the candidate is not cuBLAS, this will check the redzones and compare
   // the outputs with the reference buffer.
   absl::StatusOr<AutotuneResult> MeasurePerformance(
-      AutotunerCompileUtil& compile_util, const HloFusionInstruction& fusion,
-      const ExecutableCandidate& candidate,
+      const AutotuneConfig& config, AutotunerCompileUtil& compile_util,
+      const HloFusionInstruction& fusion, const ExecutableCandidate& candidate,
       std::optional<ScopedShapedBuffer>& reference_buffer);
 
+  // Profiles the candidates of `fusion` on the device of `config`.
+  absl::StatusOr<std::vector<AutotuneResult>> ProfileOnDevice(
+      const AutotuneConfig& config, AutotunerCompileUtil& compile_util,
+      const HloFusionInstruction& fusion,
+      absl::Span<const ExecutableCandidate> candidates);
+
+  // Profiles the candidates of all fusions. With
+  // xla_gpu_autotune_max_devices > 1, the fusions are spread over the local
+  // devices that are identical to the autotuning device, and each device
+  // profiles its fusions on its own thread.
+  absl::StatusOr<absl::flat_hash_map<const HloFusionInstruction*,
+                                     std::vector<AutotuneResult>>>
+  ProfileAll(AutotunerCompileUtil& compile_util,
+             const absl::flat_hash_map<const HloFusionInstruction*,
+                                       std::vector<ExecutableCandidate>>&
+                 executable_sets);
+
+  // Returns the configs of the other local devices to profile on. Only devices
+  // of the same kind as the autotuning device are used, so that run times
+  // measured on different devices are comparable.
+  absl::StatusOr<std::vector<std::unique_ptr<AutotuneConfig>>>
+  CreateBenchmarkDeviceConfigs() const;
+
   // Checks that the redzone buffers are correct, updates `res` otherwise.
   // Returns true if the redzones are correct, false otherwise.
-  absl::StatusOr<bool> CheckRedZones(const RedzoneBuffers& rz_buffers,
+  absl::StatusOr<bool> CheckRedZones(const AutotuneConfig& config,
+                                     const RedzoneBuffers& rz_buffers,
                                      AutotuneResult& res);
 
   // Compares the outputs of the fusion with the reference buffer.
   // Updates `res` if the outputs do not match.
-  absl::Status CompareBuffers(const HloFusionInstruction& fusion,
+  absl::Status CompareBuffers(const AutotuneConfig& config,
+                              const HloFusionInstruction& fusion,
                               const ScopedShapedBuffer& reference_buffer,
                               const ScopedShapedBuffer& buffer,
                               AutotuneResult& res);
@@ -1003,6 +1003,60 @@ ENTRY e {
 INSTANTIATE_TEST_SUITE_P(GemmFusionAutotunerLevelSweep,
                          GemmFusionAutotunerLevelTest, ::testing::Range(0, 5));
 
+TEST_F(StatelessAutotunerTest,
+       DefaultConfigsAreNotCachedWhenAutotuningInBackground) {
+  const std::string hlo = R"(
+HloModule module
+
+ENTRY e {
+  x = s8[16,16] parameter(0)
+  c = f16[16,16] convert(x)
+  y = f16[16,16] parameter(1)
+  ROOT out = f16[16,16] dot(c, y), lhs_contracting_dims={1}, rhs_contracting_dims={0}
+}
+)";
+
+  HloPassPipeline pipeline("gemm_rewrite_deviceless");
+  pipeline.AddPass<GemmFusion>(backend()
+                                   .default_stream_executor()
+                                   ->GetDeviceDescription()
+                                   .gpu_compute_capability());
+  tsl::thread::ThreadPool thread_pool(tsl::Env::Default(), "",
+                                      tsl::port::MaxParallelism());
+  DebugOptions opts;
+  MultiProcessKeyValueStore key_value_store;
+  pipeline.AddPass<GemmFusionAutotuner>(
+      AutotuneConfig{
+          DevicelessConfig{
+              backend().default_stream_executor()->GetDeviceDescription()},
+          opts},
+      GetToolkitVersion(), &thread_pool, key_value_store);
+
+  HloModuleConfig config = GetModuleConfigForTest();
+  DebugOptions debug_options = GetDebugOptionsForTest();
+  debug_options.set_xla_gpu_autotune_level(0);
+  debug_options.set_xla_gpu_experimental_autotune_in_background(true);
+  config.set_debug_options(debug_options);
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<VerifiedHloModule> module,
+                          ParseAndReturnVerifiedModule(hlo, config));
+
+  TF_ASSERT_OK_AND_ASSIGN(bool changed,
+                          HloTestBase::RunHloPass(&pipeline, module.get()));
+  EXPECT_TRUE(changed);
+
+  // Default config is applied, but not added to the cache, where it would
+  // shadow results of the background autotuning.
+  TF_ASSERT_OK_AND_ASSIGN(
+      bool filecheck_matches,
+      RunFileCheck(
+          module->ToString(HloPrintOptions{}.set_print_operand_shape(false)),
+          R"(
+// CHECK: "triton_gemm_config":{"block_m":"16","block_n":"16","block_k":"32"
+          )"));
+  EXPECT_TRUE(filecheck_matches);
+  EXPECT_TRUE(AutotunerUtil::ResultCacheIsEmpty());
+}
+
 class GemmFusionAutotunerExhaustiveTest : public GemmFusionAutotunerTest {
  public:
   DebugOptions GetDebugOptionsForTest() const override {
@@ -60,6 +60,7 @@ limitations under the License.
 #include "xla/service/gpu/gpu_memory_space_assignment.h"
 #include "xla/service/gpu/ir_emitter_context.h"
 #include "xla/service/gpu/ir_emitter_unnested.h"
+#include "xla/service/gpu/kernel_reuse_cache.h"
 #include "xla/service/gpu/metrics.h"
 #include "xla/service/logical_buffer.h"
 #include "xla/shape.h"
@@ -172,10 +173,12 @@ std::string Phase(absl::string_view phase_name, const HloModule* module) {
                          module->name(), module->unique_id());
 }
 
-bool UseCache(const DebugOptions& options, bool split_constants_module) {
+bool UseCache(const DebugOptions& options,
+              const se::DeviceDescription& device_desc,
+              bool split_constants_module) {
   return split_constants_module &&
          options.xla_gpu_enable_llvm_module_compilation_parallelism() &&
-         !options.xla_gpu_kernel_cache_file().empty();
+         !GetKernelCacheFilePath(options, device_desc).empty();
 }
 
 absl::StatusOr<std::unique_ptr<SequentialThunk>> LowerHlo(
@@ -187,8 +190,9 @@ absl::StatusOr<std::unique_ptr<SequentialThunk>> LowerHlo(
   uint64_t start_usecs = tsl::Env::Default()->NowMicros();
 
   if (use_cache) {
-    TF_RETURN_IF_ERROR(
-        LoadCache(ir_emitter_context, options.xla_gpu_kernel_cache_file()));
+    TF_RETURN_IF_ERROR(LoadCache(
+        ir_emitter_context,
+        GetKernelCacheFilePath(options, ir_emitter_context.gpu_device_info())));
   }
   std::unique_ptr<IrEmitterUnnested> ir_emitter =
       IrEmitterUnnested::Create(&ir_emitter_context);
@@ -287,8 +291,8 @@ absl::StatusOr<CompileModuleResults> CompileModuleToLlvmIr(
     const HloDataflowAnalysis::CanShareBuffer& can_share_buffer_function,
     const BufferValue::SizeFunction& buffer_size_bytes_function,
     bool split_constants_module) {
-  const bool use_cache =
-      UseCache(hlo_module->config().debug_options(), split_constants_module);
+  const bool use_cache = UseCache(hlo_module->config().debug_options(),
+                                  device_desc, split_constants_module);
 
   CompileModuleResults results =
       InitializeResults(hlo_module, llvm_context, target_triple, data_layout,
@@ -17,6 +17,7 @@ limitations under the License.
 
 #include <cstddef>
 #include <cstdint>
+#include <type_traits>
 
 #include "xla/service/gpu/gpu_prim.h"
 #include "xla/stream_executor/gpu/gpu_types.h"
@@ -56,6 +57,39 @@ const char* CubSortKeys(
   return nullptr;
 }
 
+// Segments of at most this many items are sorted by DeviceSegmentedSort, which
+// sorts each of them within a warp or a block in shared memory, instead of by
+// the multi-pass DeviceSegmentedRadixSort.
+constexpr size_t kMaxSmallSegmentSize = 1024;
+
+// Maps a segment index to the offset of its first item. All the segments of a
+// batched sort have the same size, so the offsets don't need to be stored.
+struct SegmentOffset {
+  int segment_size;
+  __host__ __device__ int operator()(int segment) const {
+    return segment * segment_size;
+  }
+};
+
+using SegmentOffsetIterator =
+    gpuprim::TransformInputIterator<int, SegmentOffset,
+                                    gpuprim::CountingInputIterator<int>>;
+
+SegmentOffsetIterator SegmentOffsets(size_t num_items, size_t batch_size) {
+  return SegmentOffsetIterator(
+      gpuprim::CountingInputIterator<int>(0),
+      SegmentOffset{static_cast<int>(num_items / batch_size)});
+}
+
+// DeviceSegmentedSort compares keys instead of sorting their bits, which gives
+// a different order for floating point NaNs and zeros, so it is only used for
+// integer keys.
+template <typename KeyT>
+bool UseSegmentedSort(size_t num_items, size_t batch_size) {
+  return std::is_integral_v<KeyT> &&
+         num_items / batch_size <= kMaxSmallSegmentSize;
+}
+
 template <typename KeyT>
 const char* CubSortKeys(
     void* d_temp_storage, size_t& temp_bytes, const void* d_keys_in,
@@ -65,23 +99,38 @@ const char* CubSortKeys(
     return CubSortKeys<KeyT>(d_temp_storage, temp_bytes, d_keys_in, d_keys_out,
                              num_items, descending, gpu_stream_handle);
   }
-  void* d_offsets = static_cast<char*>(d_temp_storage) + temp_bytes;
-  int* start_offsets =
-      d_temp_storage != nullptr ? static_cast<int*>(d_offsets) : nullptr;
-  int* end_offsets = start_offsets != nullptr ? start_offsets + 1 : nullptr;
+  SegmentOffsetIterator start_offsets = SegmentOffsets(num_items, batch_size);
+  SegmentOffsetIterator end_offsets = start_offsets + 1;
+  if (UseSegmentedSort<KeyT>(num_items, batch_size)) {
+    auto err =
+        descending
+            ? gpuprim::DeviceSegmentedSort::StableSortKeysDescending(
+                  d_temp_storage, temp_bytes,
+                  static_cast<const KeyT*>(d_keys_in),
+                  static_cast<KeyT*>(d_keys_out), num_items, batch_size,
+                  start_offsets, end_offsets, gpu_stream_handle)
+            : gpuprim::DeviceSegmentedSort::StableSortKeys(
+                  d_temp_storage, temp_bytes,
+                  static_cast<const KeyT*>(d_keys_in),
+                  static_cast<KeyT*>(d_keys_out), num_items, batch_size,
+                  start_offsets, end_offsets, gpu_stream_handle);
+    CHK_GPU_ERR(err)
+    return nullptr;
+  }
   auto err =
       descending
-          ? gpuprim::DeviceSegmentedRadixSort::SortKeysDescending<KeyT>(
+          ? gpuprim::DeviceSegmentedRadixSort::SortKeysDescending(
                 d_temp_storage, temp_bytes, static_cast<const KeyT*>(d_keys_in),
                 static_cast<KeyT*>(d_keys_out), num_items, batch_size,
                 start_offsets, end_offsets, /*begin_bit=*/0,
                 /*end_bit=*/sizeof(KeyT) * 8, gpu_stream_handle)
-          : gpuprim::DeviceSegmentedRadixSort::SortKeys<KeyT>(
+          : gpuprim::DeviceSegmentedRadixSort::SortKeys(
                 d_temp_storage, temp_bytes, static_cast<const KeyT*>(d_keys_in),
                 static_cast<KeyT*>(d_keys_out), num_items, batch_size,
                 start_offsets, end_offsets, /*begin_bit=*/0,
                 /*end_bit=*/sizeof(KeyT) * 8, gpu_stream_handle);
-  CHK_GPU_ERR(err) return nullptr;
+  CHK_GPU_ERR(err)
+  return nullptr;
 }
 
 template <typename KeyT, typename ValT>
@@ -119,20 +168,38 @@ const char* CubSortPairs(
                                     d_keys_out, d_values_in, d_values_out,
                                     num_items, descending, gpu_stream_handle);
   }
-  void* d_offsets = static_cast<char*>(d_temp_storage) + temp_bytes;
-  int* start_offsets =
-      d_temp_storage != nullptr ? static_cast<int*>(d_offsets) : nullptr;
-  int* end_offsets = start_offsets != nullptr ? start_offsets + 1 : nullptr;
+  SegmentOffsetIterator start_offsets = SegmentOffsets(num_items, batch_size);
+  SegmentOffsetIterator end_offsets = start_offsets + 1;
+  if (UseSegmentedSort<KeyT>(num_items, batch_size)) {
+    auto err =
+        descending
+            ? gpuprim::DeviceSegmentedSort::StableSortPairsDescending(
+                  d_temp_storage, temp_bytes,
+                  static_cast<const KeyT*>(d_keys_in),
+                  static_cast<KeyT*>(d_keys_out),
+                  static_cast<const ValT*>(d_values_in),
+                  static_cast<ValT*>(d_values_out), num_items, batch_size,
+                  start_offsets, end_offsets, gpu_stream_handle)
+            : gpuprim::DeviceSegmentedSort::StableSortPairs(
+                  d_temp_storage, temp_bytes,
+                  static_cast<const KeyT*>(d_keys_in),
+                  static_cast<KeyT*>(d_keys_out),
+                  static_cast<const ValT*>(d_values_in),
+                  static_cast<ValT*>(d_values_out), num_items, batch_size,
+                  start_offsets, end_offsets, gpu_stream_handle);
+    CHK_GPU_ERR(err)
+    return nullptr;
+  }
   auto err =
       descending
-          ? gpuprim::DeviceSegmentedRadixSort::SortPairsDescending<KeyT, ValT>(
+          ? gpuprim::DeviceSegmentedRadixSort::SortPairsDescending(
                 d_temp_storage, temp_bytes, static_cast<const KeyT*>(d_keys_in),
                 static_cast<KeyT*>(d_keys_out),
                 static_cast<const ValT*>(d_values_in),
                 static_cast<ValT*>(d_values_out), num_items, batch_size,
                 start_offsets, end_offsets, /*begin_bit=*/0,
                 /*end_bit=*/sizeof(KeyT) * 8, gpu_stream_handle)
-          : gpuprim::DeviceSegmentedRadixSort::SortPairs<KeyT, ValT>(
+          : gpuprim::DeviceSegmentedRadixSort::SortPairs(
                 d_temp_storage, temp_bytes, static_cast<const KeyT*>(d_keys_in),
                 static_cast<KeyT*>(d_keys_out),
                 static_cast<const ValT*>(d_values_in),
@@ -57,6 +57,7 @@ limitations under the License.
 #include "xla/stream_executor/stream.h"
 #include "xla/tests/client_library_test_base.h"
 #include "xla/tsl/lib/core/status_test_util.h"
+#include "xla/xla.pb.h"
 #include "xla/xla_data.pb.h"
 #include "tsl/platform/statusor.h"
 
@@ -879,5 +880,34 @@ TEST_F(CustomCallTest, FfiExecutionState) {
   TF_ASSERT_OK(Execute(&b, {}).status());
 }
 
+XLA_FFI_REGISTER_HANDLER(ffi::GetXlaFfiApi(),
+                         "xla.gpu.ffi_execution_state_cmd_buffer", PLATFORM,
+                         {
+                             /*instantiate=*/kInstantiateState,
+                             /*prepare=*/nullptr,
+                             /*initialize=*/nullptr,
+                             /*execute=*/kGetState,
+                         },
+                         XLA_FFI_HANDLER_TRAITS_COMMAND_BUFFER_COMPATIBLE);
+
+// Command buffer compatible handlers see the state created by the instantiate
+// callback when they are recorded into a command buffer.
+TEST_F(CustomCallTest, FfiExecutionStateInCommandBuffer) {
+  mutable_debug_options()->add_xla_gpu_enable_command_buffer(
+      DebugOptions::CUSTOM_CALL);
+  mutable_debug_options()->set_xla_gpu_graph_min_graph_size(1);
+
+  XlaBuilder b(TestName());
+  CustomCall(&b, "xla.gpu.ffi_execution_state_cmd_buffer", /*operands=*/{},
+             ShapeUtil::MakeShape(F32, {}),
+             /*opaque=*/"",
+             /*has_side_effect=*/false,
+             /*output_operand_aliasing=*/{}, /*literal=*/nullptr,
+             /*schedule=*/CustomCallSchedule::SCHEDULE_NONE,
+             /*api_version=*/CustomCallApiVersion::API_VERSION_TYPED_FFI);
+
+  TF_ASSERT_OK(Execute(&b, {}).status());
+}
+
 }  // anonymous namespace
 }  // namespace xla
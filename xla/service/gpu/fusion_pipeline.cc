@@ -25,6 +25,7 @@ limitations under the License.
 #include "xla/service/gpu/model/gpu_hlo_cost_analysis.h"
 #include "xla/service/gpu/transforms/horizontal_input_fusion.h"
 #include "xla/service/gpu/transforms/horizontal_loop_fusion.h"
+#include "xla/service/gpu/transforms/horizontal_reduction_fusion.h"
 #include "xla/service/gpu/transforms/multi_output_fusion.h"
 #include "xla/service/gpu/transforms/priority_fusion.h"
 #include "xla/service/gpu/transforms/variadic_op_splitter.h"
@@ -45,6 +46,10 @@ HloPassPipeline FusionPipeline(
     tsl::thread::ThreadPool* thread_pool,
     const se::DeviceDescription& gpu_device_info) {
   HloPassFix<HloPassPipeline> fusion("fusion");
+  if (debug_options.xla_gpu_experimental_enable_horizontal_reduction_fusion()) {
+    // Combined reductions go through PriorityFusion like any other reduction.
+    fusion.AddPass<HorizontalReductionFusion>(gpu_device_info);
+  }
   // We try to split variadic ops with many parameters into several such ops
   // to avoid exceeding the parameter space.
   fusion.AddPass<VariadicOpSplitter>();
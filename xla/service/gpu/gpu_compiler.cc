@@ -21,14 +21,17 @@ limitations under the License.
 #include <functional>
 #include <memory>
 #include <optional>
+#include <queue>
 #include <string>
 #include <utility>
 #include <variant>
 #include <vector>
 
+#include "absl/algorithm/container.h"
 #include "absl/base/call_once.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
+#include "absl/functional/function_ref.h"
 #include "absl/log/check.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
@@ -36,6 +39,7 @@ limitations under the License.
 #include "absl/strings/str_format.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/blocking_counter.h"
+#include "absl/time/time.h"
 #include "absl/types/span.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SmallString.h"
@@ -47,7 +51,9 @@ limitations under the License.
 #include "llvm/IR/DataLayout.h"
 #include "llvm/IR/DiagnosticInfo.h"
 #include "llvm/IR/DiagnosticPrinter.h"
+#include "llvm/IR/Function.h"
 #include "llvm/IR/GlobalValue.h"
+#include "llvm/IR/GlobalVariable.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/Verifier.h"
@@ -57,10 +63,14 @@ limitations under the License.
 #include "llvm/TargetParser/Triple.h"
 #include "llvm/Transforms/Utils/Cloning.h"
 #include "llvm/Transforms/Utils/SplitModule.h"
+#include "llvm/Transforms/Utils/ValueMapper.h"
 #include "mlir/IR/Diagnostics.h"
 #include "mlir/IR/DialectRegistry.h"
 #include "mlir/Support/LLVM.h"
 #include "xla/backends/gpu/codegen/triton/support.h"
+#include "xla/backends/gpu/runtime/kernel_thunk.h"
+#include "xla/backends/gpu/runtime/sequential_thunk.h"
+#include "xla/backends/gpu/runtime/thunk.h"
 #include "xla/hlo/analysis/hlo_dataflow_analysis.h"
 #include "xla/hlo/ir/hlo_casting_utils.h"
 #include "xla/hlo/ir/hlo_computation.h"
@@ -96,13 +106,16 @@ limitations under the License.
 #include "xla/hlo/transforms/expanders/stable_sort_expander.h"
 #include "xla/hlo/transforms/expanders/stochastic_convert_decomposer.h"
 #include "xla/hlo/transforms/host_offload_legalize.h"
+#include "xla/hlo/transforms/host_offload_streaming.h"
 #include "xla/hlo/transforms/host_offloader.h"
+#include "xla/hlo/transforms/host_parameter_prefetch.h"
 #include "xla/hlo/transforms/operand_upcaster.h"
 #include "xla/hlo/transforms/simplifiers/algebraic_simplifier.h"
 #include "xla/hlo/transforms/simplifiers/all_reduce_folder.h"
 #include "xla/hlo/transforms/simplifiers/broadcast_canonicalizer.h"
 #include "xla/hlo/transforms/simplifiers/conditional_canonicalizer.h"
 #include "xla/hlo/transforms/simplifiers/convert_mover.h"
+#include "xla/hlo/transforms/simplifiers/dot_batcher.h"
 #include "xla/hlo/transforms/simplifiers/dot_merger.h"
 #include "xla/hlo/transforms/simplifiers/dynamic_dimension_simplifier.h"
 #include "xla/hlo/transforms/simplifiers/flatten_call_graph.h"
@@ -153,6 +166,7 @@ limitations under the License.
 #include "xla/service/gpu/compile_module_to_llvm_ir.h"
 #include "xla/service/gpu/conv_layout_normalization.h"
 #include "xla/service/gpu/cublas_cudnn.h"
+#include "xla/service/gpu/executable.pb.h"
 #include "xla/service/gpu/execution_stream_assignment.h"
 #include "xla/service/gpu/flag_utils.h"
 #include "xla/service/gpu/fusion_dispatch_pipeline.h"
@@ -171,6 +185,7 @@ limitations under the License.
 #include "xla/service/gpu/matmul_utils.h"
 #include "xla/service/gpu/metrics.h"
 #include "xla/service/gpu/model/collective_ptable_stats_collection.h"
+#include "xla/service/gpu/model/gpu_collective_performance_model.h"
 #include "xla/service/gpu/model/gpu_cost_model_stats_collection.h"
 #include "xla/service/gpu/model/gpu_hlo_cost_analysis.h"
 #include "xla/service/gpu/model/matmul_ptable_stats_collection.h"
@@ -192,6 +207,7 @@ limitations under the License.
 #include "xla/service/gpu/transforms/collective_permute_valid_iteration_annotator.h"
 #include "xla/service/gpu/transforms/collective_select_folder.h"
 #include "xla/service/gpu/transforms/collectives/all_gather_combiner.h"
+#include "xla/service/gpu/transforms/collectives/all_reduce_quantizer.h"
 #include "xla/service/gpu/transforms/collectives/all_reduce_combiner.h"
 #include "xla/service/gpu/transforms/collectives/collective_combiner_annotator.h"
 #include "xla/service/gpu/transforms/collectives/convert_async_collectives_to_sync.h"
@@ -220,6 +236,7 @@ limitations under the License.
 #include "xla/service/gpu/transforms/nest_gemm_fusion.h"
 #include "xla/service/gpu/transforms/pipelined_p2p_rewriter.h"
 #include "xla/service/gpu/transforms/ragged_all_to_all_canonicalizer.h"
+#include "xla/service/gpu/transforms/ragged_all_to_all_chunker.h"
 #include "xla/service/gpu/transforms/ragged_all_to_all_decomposer.h"
 #include "xla/service/gpu/transforms/reduce_scatter_creator.h"
 #include "xla/service/gpu/transforms/reduction_degenerate_dim_remover.h"
@@ -261,6 +278,7 @@ limitations under the License.
 #include "xla/service/topk_rewriter.h"
 #include "xla/service/transpose_folding.h"
 #include "xla/service/while_loop_all_reduce_code_motion.h"
+#include "xla/service/while_loop_associative_scan_rewriter.h"
 #include "xla/service/while_loop_constant_sinking.h"
 #include "xla/service/while_loop_simplifier.h"
 #include "xla/shape.h"
@@ -345,12 +363,41 @@ se::GpuComputeCapability GetGpuVersion(const se::StreamExecutor* stream_exec) {
   return stream_exec->GetDeviceDescription().gpu_compute_capability();
 }
 
+// Returns the launch parameters of the kernels launched by `thunks`. Kernels
+// with TMA metadata are skipped, as it can't be serialized.
+CompilationCacheProto GetCompiledKernels(const SequentialThunk& thunks) {
+  CompilationCacheProto proto;
+  thunks.ForAllThunks([&](const Thunk* thunk) {
+    if (thunk->kind() != Thunk::kKernel) {
+      return;
+    }
+    const auto* kernel_thunk = static_cast<const KernelThunk*>(thunk);
+    if (kernel_thunk->tma_metadata().has_value()) {
+      return;
+    }
+    CompilationCacheEntryProto entry;
+    entry.mutable_launch_dimensions()->set_num_blocks(
+        kernel_thunk->launch_dimensions().num_blocks());
+    entry.mutable_launch_dimensions()->set_num_threads_per_block(
+        kernel_thunk->launch_dimensions().num_threads_per_block());
+    if (kernel_thunk->cluster_dim().has_value()) {
+      entry.mutable_cluster_dim()->set_x(kernel_thunk->cluster_dim()->x);
+      entry.mutable_cluster_dim()->set_y(kernel_thunk->cluster_dim()->y);
+      entry.mutable_cluster_dim()->set_z(kernel_thunk->cluster_dim()->z);
+    }
+    entry.set_shmem_bytes(kernel_thunk->shmem_bytes());
+    proto.mutable_entries()->insert({kernel_thunk->kernel_name(), entry});
+  });
+  return proto;
+}
+
 class GpuThunkAotCompilationResult : public AotCompilationResult {
  public:
   static absl::StatusOr<std::unique_ptr<GpuThunkAotCompilationResult>>
   FromModule(const HloModule* hlo_module,
              const BufferAssignment* buffer_assignment,
-             absl::string_view asm_text, absl::Span<const uint8_t> binary,
+             const SequentialThunk& thunks, absl::string_view asm_text,
+             absl::Span<const uint8_t> binary,
              const BinaryMap& dnn_compiled_graphs) {
     CompilationResultProto proto;
     *proto.mutable_hlo_module_with_config() = hlo_module->ToProtoWithConfig();
@@ -359,6 +406,7 @@ class GpuThunkAotCompilationResult : public AotCompilationResult {
     proto.set_binary(binary.data(), binary.size());
     proto.mutable_dnn_compiled_graphs()->insert(dnn_compiled_graphs.cbegin(),
                                                 dnn_compiled_graphs.cend());
+    *proto.mutable_kernels() = GetCompiledKernels(thunks);
     return std::unique_ptr<GpuThunkAotCompilationResult>(
         new GpuThunkAotCompilationResult(hlo_module->Clone(),
                                          std::move(proto)));
@@ -444,9 +492,10 @@ GpuThunkAotCompilationResult::LoadExecutable(
       platform_name, gpu_device_info, mlir_context.get(), llvm_module.get(),
       /*llvm_module_constants=*/nullptr,
       /*emit_kernels=*/false);
+  ir_emitter_context.set_compiled_kernels(&proto_.kernels());
 
-  absl::string_view cache_file_path =
-      hlo_module->config().debug_options().xla_gpu_kernel_cache_file();
+  std::string cache_file_path = GetKernelCacheFilePath(
+      hlo_module->config().debug_options(), gpu_device_info);
   if (!cache_file_path.empty() &&
       hlo_module->config()
           .debug_options()
@@ -632,7 +681,7 @@ absl::Status RunSPMDPasses(
   if (num_partitions > 1 && hlo_module->config().use_spmd_partitioning()) {
     HloPassPipeline spmd_pipeline("spmd-partitioner");
     AddSPMDPasses(hlo_module, layout_insensitive_algsimp_opts,
-                  gpu_target_config.device_description.gpu_compute_capability(),
+                  gpu_target_config.device_description,
                   spmd_pipeline,
 #ifdef PLATFORM_GOOGLE
                   [&](HloPassPipeline& pipeline) {
@@ -847,10 +896,22 @@ absl::Status RunOptimizationPasses(
                                           .xla_gpu_dot_merger_threshold_mb()}
             << 20,
         can_merge);
+    // Batch the remaining small independent dots of equal shapes, such as
+    // per-head or per-expert matmuls, into batched GEMMs.
+    if (debug_options.xla_gpu_dot_batcher_threshold_mb() > 0) {
+      pipeline.AddPass<DotBatcher>(
+          /*max_size_to_batch=*/int64_t{debug_options
+                                            .xla_gpu_dot_batcher_threshold_mb()}
+              << 20,
+          can_merge);
+    }
     pipeline.AddPass<SortSimplifier>();
     pipeline.AddPass<TupleSimplifier>();
     pipeline.AddPass<WhileLoopConstantSinking>();
     pipeline.AddPass<WhileLoopSimplifier>();
+    if (debug_options.xla_gpu_experimental_enable_associative_scan_rewrite()) {
+      pipeline.AddPass<WhileLoopAssociativeScanRewriter>();
+    }
     pipeline.AddPass<SliceSinker>();
 
     ReshapeMoverOptions reshape_mover_options;
@@ -883,17 +944,23 @@ absl::Status RunOptimizationPasses(
 absl::Status RunCollectiveOptimizationPasses(
     HloModule* hlo_module,
     const AlgebraicSimplifierOptions& layout_insensitive_algsimp_opts,
-    se::GpuComputeCapability gpu_version) {
+    const se::DeviceDescription& device_description) {
   // Optimize collectives generated by SPMD partitioning. Enable these passes
   // otherwise as well so that all collectives can get these optimizations.
   const HloModuleConfig& config = hlo_module->config();
   const DebugOptions& debug_options = config.debug_options();
+  se::GpuComputeCapability gpu_version =
+      device_description.gpu_compute_capability();
 
   HloPassPipeline collectives_pipeline("collective-optimizations");
   collectives_pipeline.AddPass<RaggedAllToAllCanonicalizer>();
   if (debug_options.xla_gpu_unsupported_enable_ragged_all_to_all_decomposer()) {
     collectives_pipeline.AddPass<RaggedAllToAllDecomposer>();
   }
+  if (debug_options.xla_gpu_experimental_ragged_all_to_all_num_chunks() > 1) {
+    collectives_pipeline.AddPass<RaggedAllToAllChunker>(
+        debug_options.xla_gpu_experimental_ragged_all_to_all_num_chunks());
+  }
   collectives_pipeline.AddPass<AllReduceSimplifier>();
   collectives_pipeline.AddPass<AllReduceFolder>();
   collectives_pipeline.AddPass<AllReduceSplitter>();
@@ -943,6 +1010,10 @@ absl::Status RunCollectiveOptimizationPasses(
   if (debug_options.xla_gpu_enable_pipelined_collectives() ||
       debug_options.xla_gpu_enable_pipelined_all_gather() ||
       IsPassEnabledAtOptimizationEffort<CollectivePipeliner>(*hlo_module)) {
+    // Deeper pipelining keeps more gathered values in the loop state, which
+    // must fit into device memory.
+    int64_t max_available_memory =
+        MaxAvailableMemory(*hlo_module, device_description);
     CollectivePipeliner::Config config{
         /*level_to_operate_on=*/0,
         /*max_pipelining_per_loop=*/INT64_MAX,
@@ -961,6 +1032,12 @@ absl::Status RunCollectiveOptimizationPasses(
         /*postprocess_backward_peeled_trailing_op=*/{},
         /*should_add_loop_invariant_op_in_chain=*/true,
         /*postprocess_pipelined_ops=*/AppendPipelinedInstruction,
+        /*collective_size_threshold_to_stop_sinking=*/INT64_MAX,
+        /*pipelining_depth=*/std::max<int64_t>(
+            debug_options.xla_gpu_experimental_all_gather_pipelining_depth(),
+            1),
+        /*max_loop_state_bytes_for_depth=*/
+        max_available_memory > 0 ? max_available_memory : INT64_MAX,
     };
     collectives_pipeline.AddPass<CollectivePipeliner>(config);
   }
@@ -991,6 +1068,21 @@ absl::Status RunCollectiveOptimizationPasses(
 
   collectives_pipeline.AddPass<ReduceScatterCreator>();
 
+  // Compresses all-reduce and reduce-scatter payloads to a narrow type. Runs
+  // after all reduce-scatters are formed and before collectives become async.
+  if (PrimitiveType quantized_type =
+          debug_options.xla_gpu_experimental_collective_quantization_type();
+      quantized_type != PRIMITIVE_TYPE_INVALID) {
+    AllReduceQuantizer::Options options;
+    options.quantized_type = quantized_type;
+    options.error_feedback =
+        debug_options
+            .xla_gpu_experimental_collective_quantization_error_feedback();
+    collectives_pipeline.AddPass<AllReduceQuantizer>(options);
+    // Remove the loop bodies replaced to carry quantization errors.
+    collectives_pipeline.AddPass<HloDCE>();
+  }
+
   DebugOptions::PipelineParallelismOptLevel pipeline_parallelism_opt_level =
       debug_options.xla_gpu_experimental_pipeline_parallelism_opt_level();
   if (pipeline_parallelism_opt_level ==
@@ -1071,6 +1163,15 @@ absl::Status RunLayoutAssignmentPasses(
   // run, meaning, the pipeline that contains layout assignment cannot contain
   // a layout-sensitive verifier!
   HloPassPipeline pipeline("layout assignment");
+  const DebugOptions& debug_options = hlo_module->config().debug_options();
+  if (debug_options.xla_gpu_experimental_enable_host_parameter_prefetch()) {
+    pipeline.AddPass<HostParameterPrefetch>();
+  }
+  // Stream host-offloaded updates in chunks before the chunks get their
+  // layouts assigned.
+  if (debug_options.xla_gpu_experimental_enable_host_offload_streaming()) {
+    pipeline.AddPass<HostOffloadStreaming>();
+  }
   // Layout assignment uses alias analysis, which requires the call graph to
   // be flattened.
   pipeline.AddPass<FlattenCallGraph>();
@@ -1152,7 +1253,9 @@ void AddDoubleBufferingPasses(const HloModule& module,
   }
   if (unroll_strategy != std::nullopt) {
     pipeline.AddPass<WhileLoopSimplifier>();
-    pipeline.AddPass<DoubleBufferLoopUnrolling>(*unroll_strategy);
+    pipeline.AddPass<DoubleBufferLoopUnrolling>(
+        *unroll_strategy,
+        opts.xla_gpu_experimental_enable_launch_bound_loop_unrolling());
     pipeline.AddPass<TupleSimplifier>();
     pipeline.AddPass<HloDCE>();
   }
@@ -1199,12 +1302,24 @@ absl::Status RunPostFusionPasses(
 
   pipeline.AddPass<AllReduceContiguous>();
 
+  const DebugOptions& debug_options = hlo_module->config().debug_options();
   int32_t blueconnect_num_devices_per_host =
-      hlo_module->config()
-          .debug_options()
-          .xla_gpu_all_reduce_blueconnect_num_devices_per_host();
+      debug_options.xla_gpu_all_reduce_blueconnect_num_devices_per_host();
   if (blueconnect_num_devices_per_host > 0) {
-    pipeline.AddPass<AllReduceBlueConnect>(blueconnect_num_devices_per_host);
+    AllReduceBlueConnect::Topology topology;
+    topology.num_devices_per_host = blueconnect_num_devices_per_host;
+    topology.inter_host_bandwidth_gbps =
+        debug_options
+            .xla_gpu_all_reduce_blueconnect_inter_host_bandwidth_gbps();
+    if (auto* cuda_cc = std::get_if<se::CudaComputeCapability>(
+            &device_description.gpu_compute_capability())) {
+      topology.intra_host_bandwidth_gbps =
+          GpuPerformanceWithCollectiveModel::GetNvlinkBw(*cuda_cc) *
+          GpuPerformanceWithCollectiveModel::kMaxNumChannelsRing;
+    }
+    topology.collective_latency =
+        GpuPerformanceWithCollectiveModel::kNcclKernelLaunchOverhead;
+    pipeline.AddPass<AllReduceBlueConnect>(topology);
   }
 
   AddDoubleBufferingPasses(*hlo_module, pipeline);
@@ -1386,10 +1501,10 @@ absl::Status GpuCompiler::OptimizeHloModule(
   TF_RETURN_IF_ERROR(RunOptimizationPasses(hlo_module, stream_exec,
                                            gpu_target_config,
                                            layout_insensitive_algsimp_opts));
+  TF_RETURN_IF_ERROR(RunCollectiveOptimizationPasses(
+      hlo_module, layout_insensitive_algsimp_opts, device_description));
   se::GpuComputeCapability gpu_version =
       device_description.gpu_compute_capability();
-  TF_RETURN_IF_ERROR(RunCollectiveOptimizationPasses(
-      hlo_module, layout_insensitive_algsimp_opts, gpu_version));
 
   // Run target-specific HLO optimization passes for convolution
   // canonicalization.
@@ -1819,6 +1934,46 @@ absl::Status GpuCompiler::OptimizeHloPostLayoutAssignment(
       "has to be specified to specify the target to compile for.");
 }
 
+void GpuCompiler::ScheduleBackgroundAutotuning(
+    const HloModule& module, se::StreamExecutor* stream_exec,
+    const CompileOptions& options, const TargetConfig& gpu_target_config) {
+  // Autotuning runs on a single background thread, to leave the rest of the
+  // host to compilations and execution.
+  static tsl::thread::ThreadPool* const thread_pool =
+      new tsl::thread::ThreadPool(tsl::Env::Default(),
+                                  "xla_gpu_background_autotuning",
+                                  /*num_threads=*/1);
+
+  std::shared_ptr<HloModule> clone = module.Clone();
+  clone->mutable_config()
+      .mutable_debug_options()
+      .set_xla_gpu_experimental_autotune_in_background(false);
+
+  // Background autotuning outlives the compilation, so it can't use the
+  // caller's allocator, thread pool and key-value store.
+  CompileOptions background_options;
+  background_options.layout_canonicalization_callback =
+      options.layout_canonicalization_callback;
+
+  VLOG(1) << "Scheduling background autotuning for module " << module.name();
+  thread_pool->Schedule([this, clone, stream_exec, background_options,
+                         gpu_target_config] {
+    tsl::profiler::TraceMe traceme("GpuCompiler::BackgroundAutotuning");
+    absl::Status status = OptimizeHloModule(clone.get(), stream_exec,
+                                            background_options,
+                                            gpu_target_config);
+    if (status.ok()) {
+      status = SerializeAutotuneResultsToFile(clone->config().debug_options());
+    }
+    if (!status.ok()) {
+      LOG(WARNING) << "Background autotuning for module " << clone->name()
+                   << " failed: " << status;
+      return;
+    }
+    VLOG(1) << "Finished background autotuning for module " << clone->name();
+  });
+}
+
 absl::StatusOr<std::unique_ptr<HloModule>> GpuCompiler::RunHloPasses(
     std::unique_ptr<HloModule> module, se::StreamExecutor* stream_exec,
     const CompileOptions& options) {
@@ -1842,6 +1997,19 @@ absl::StatusOr<std::unique_ptr<HloModule>> GpuCompiler::RunHloPasses(
       [&] { return absl::StrCat("HLO Transforms:", module->name()); },
       tsl::profiler::TraceMeLevel::kInfo);
 
+  if (debug_opts.xla_gpu_experimental_autotune_in_background() &&
+      !is_deviceless && stream_exec != nullptr &&
+      !options.is_autotuning_compilation &&
+      debug_opts.xla_gpu_autotune_level() > 0) {
+    ScheduleBackgroundAutotuning(*module, stream_exec, options,
+                                 gpu_target_config);
+    // Use autotuning results cached by previous compilations, and default
+    // configs for everything else.
+    DebugOptions& module_debug_options =
+        module->mutable_config().mutable_debug_options();
+    module_debug_options.set_xla_gpu_autotune_level(0);
+  }
+
   TF_RETURN_IF_ERROR(OptimizeHloModule(module.get(),
                                        is_deviceless ? nullptr : stream_exec,
                                        options, gpu_target_config));
@@ -1905,14 +2073,21 @@ absl::Status RunPostSchedulingCopyInsertion(
   // We run a separate pass of copy elision here because the sequential ordering
   // from the HLO schedule potentially allows for more copies to be eliminated.
   constexpr int64_t kRegionBasedLiveRangeAnalysisLimit = -1;
-  const int64_t kUseRegionBasedLiveRangeAnalysis =
-      module->config()
-              .debug_options()
-              .xla_gpu_copy_insertion_use_region_analysis()
-          ? kRegionBasedLiveRangeAnalysisLimit
-          : 0;
+  // The maximal product of the live range sizes of the source and destination
+  // of a copy for which the bounded region-based analysis runs.
+  constexpr int64_t kBoundedRegionBasedLiveRangeAnalysisLimit = 1 << 16;
+  const DebugOptions& opts = module->config().debug_options();
+  const bool use_bounded_region_analysis =
+      opts.xla_gpu_experimental_enable_post_scheduling_region_analysis();
+  int64_t use_region_based_live_range_analysis = 0;
+  if (opts.xla_gpu_copy_insertion_use_region_analysis()) {
+    use_region_based_live_range_analysis = kRegionBasedLiveRangeAnalysisLimit;
+  } else if (use_bounded_region_analysis) {
+    use_region_based_live_range_analysis =
+        kBoundedRegionBasedLiveRangeAnalysisLimit;
+  }
   CopyInsertion copy_insertion(can_share_buffer,
-                               kUseRegionBasedLiveRangeAnalysis);
+                               use_region_based_live_range_analysis);
   TF_RETURN_IF_ERROR(copy_insertion.RemoveUnnecessaryCopies(module));
 
   // Stash away the schedule during copy insertion, to avoid validation failures
@@ -1939,7 +2114,8 @@ absl::Status RunPostSchedulingCopyInsertion(
   TF_RETURN_IF_ERROR(saved_schedule.Update());
   TF_RETURN_IF_ERROR(module->set_schedule(std::move(saved_schedule)));
 
-  return absl::OkStatus();
+  return copy_insertion.MaybeDumpCopyExplanations(
+      *module, "post_scheduling_copy_insertion_explanations.txt");
 }
 }  // namespace
 
@@ -2054,6 +2230,62 @@ int CountFunctions(const llvm::Module& module) {
   return num_functions;
 }
 
+// Splits `module` into `num_partitions` modules with a similar total number of
+// LLVM instructions, which is a proxy for LLVM optimization, NVPTX codegen and
+// ptxas time. Functions are assigned to partitions largest first, each to the
+// partition with the smallest total size so far. Definitions with local linkage
+// are cloned into every partition (copies unused by the partition are removed
+// by the optimization pipeline), all other global variable definitions are
+// kept in the first partition.
+void SplitModuleBySize(
+    const llvm::Module& module, int num_partitions,
+    absl::FunctionRef<void(std::unique_ptr<llvm::Module>)> callback) {
+  std::vector<std::pair<int64_t, const llvm::Function*>> functions;
+  for (const llvm::Function& func : module.functions()) {
+    if (!func.isDeclaration() && !func.hasLocalLinkage()) {
+      functions.push_back({func.getInstructionCount(), &func});
+    }
+  }
+  absl::c_sort(functions, [](const auto& a, const auto& b) {
+    return a.first != b.first ? a.first > b.first
+                              : a.second->getName() < b.second->getName();
+  });
+
+  // Min-heap of (total size, partition index).
+  using Partition = std::pair<int64_t, int>;
+  std::priority_queue<Partition, std::vector<Partition>, std::greater<>>
+      partitions;
+  for (int i = 0; i < num_partitions; ++i) partitions.push({0, i});
+
+  absl::flat_hash_map<const llvm::Function*, int> function_partition;
+  for (const auto& [size, func] : functions) {
+    auto [partition_size, partition] = partitions.top();
+    partitions.pop();
+    function_partition[func] = partition;
+    partitions.push({partition_size + size, partition});
+  }
+
+  while (!partitions.empty()) {
+    auto [partition_size, partition] = partitions.top();
+    partitions.pop();
+    VLOG(3) << "Module partition #" << partition << " has " << partition_size
+            << " instructions";
+  }
+
+  for (int i = 0; i < num_partitions; ++i) {
+    llvm::ValueToValueMapTy value_map;
+    callback(llvm::CloneModule(
+        module, value_map, [&](const llvm::GlobalValue* gv) {
+          if (gv->hasLocalLinkage()) return true;
+          if (auto* func = llvm::dyn_cast<llvm::Function>(gv)) {
+            auto it = function_partition.find(func);
+            return it != function_partition.end() && it->second == i;
+          }
+          return i == 0;
+        }));
+  }
+}
+
 // Returns the name of the single function in the module or empty string if it's
 // not a single-function module.
 std::string SingleFunctionName(const llvm::Module& module) {
@@ -2136,8 +2368,8 @@ absl::StatusOr<GpuCompiler::BackendCompileResult> GpuCompiler::CompileAndLink(
   llvm_ir::DumpIrIfEnabled(*debug_module, *llvm_module,
                            /*optimized=*/false, "inlined");
 
-  absl::string_view cache_path =
-      module_config.debug_options().xla_gpu_kernel_cache_file();
+  std::string cache_path =
+      GetKernelCacheFilePath(module_config.debug_options(), device_description);
   const bool use_cache = !cache_path.empty();
 
   struct NamedModule {
@@ -2167,24 +2399,31 @@ absl::StatusOr<GpuCompiler::BackendCompileResult> GpuCompiler::CompileAndLink(
     llvm_modules.reserve(num_modules);
   }
   int single_function_module_count = 0;
-  llvm::SplitModule(
-      *llvm_module, num_modules,
-      [&](std::unique_ptr<llvm::Module> module) {
-        // Change the linkage type of some global constant variables to internal
-        for (llvm::GlobalVariable& gv : module->globals()) {
-          if (gv.hasName() && gv.isConstant() && !gv.hasInitializer() &&
-              const_initializer_map.count(gv.getName()) != 0) {
-            gv.setInitializer(const_initializer_map[gv.getName()]);
-            gv.setLinkage(llvm::GlobalValue::InternalLinkage);
-          }
-        }
-        const std::string name = SingleFunctionName(*module);
-        if (!name.empty()) {
-          ++single_function_module_count;
-        }
-        llvm_modules.push_back({name, std::move(module)});
-      },
-      /*PreserveLocals=*/true, /*RoundRobin=*/true);
+  auto add_module = [&](std::unique_ptr<llvm::Module> module) {
+    // Change the linkage type of some global constant variables to internal
+    for (llvm::GlobalVariable& gv : module->globals()) {
+      if (gv.hasName() && gv.isConstant() && !gv.hasInitializer() &&
+          const_initializer_map.count(gv.getName()) != 0) {
+        gv.setInitializer(const_initializer_map[gv.getName()]);
+        gv.setLinkage(llvm::GlobalValue::InternalLinkage);
+      }
+    }
+    const std::string name = SingleFunctionName(*module);
+    if (!name.empty()) {
+      ++single_function_module_count;
+    }
+    llvm_modules.push_back({name, std::move(module)});
+  };
+  // With fewer modules than kernels we balance modules by kernel size, so
+  // that a few large kernels do not serialize compilation on a single thread.
+  // Caching requires single-function modules, for which we split the module
+  // round-robin.
+  if (num_modules < CountFunctions(*llvm_module)) {
+    SplitModuleBySize(*llvm_module, num_modules, add_module);
+  } else {
+    llvm::SplitModule(*llvm_module, num_modules, add_module,
+                      /*PreserveLocals=*/true, /*RoundRobin=*/true);
+  }
   VLOG(2) << "Single-function cacheable modules: "
           << single_function_module_count << " / " << llvm_modules.size();
 
@@ -2332,7 +2571,8 @@ GpuCompiler::CompileToBackendResult(
           .xla_gpu_enable_llvm_module_compilation_parallelism();
   const bool use_cache =
       split_modules &&
-      !module->config().debug_options().xla_gpu_kernel_cache_file().empty();
+      !GetKernelCacheFilePath(module->config().debug_options(), gpu_device_info)
+           .empty();
 
   CompileModuleResults compile_module_results;
 
@@ -2587,7 +2827,8 @@ GpuCompiler::CompileAheadOfTime(std::unique_ptr<HloModuleGroup> module_group,
         results.emplace_back(),
         GpuThunkAotCompilationResult::FromModule(
             module.get(), res.compile_module_results.buffer_assignment.get(),
-            res.backend_result.asm_text, res.backend_result.binary,
+            *res.compile_module_results.executable, res.backend_result.asm_text,
+            res.backend_result.binary,
             res.backend_result.dnn_compiled_graphs));
   }
 
@@ -2606,7 +2847,8 @@ absl::StatusOr<std::unique_ptr<AotCompilationResult>> GpuCompiler::Export(
 
   return GpuThunkAotCompilationResult::FromModule(
       &gpu_executable->module(), gpu_executable->buffer_assignment(),
-      gpu_executable->text(), gpu_executable->binary(),
+      gpu_executable->GetThunk(), gpu_executable->text(),
+      gpu_executable->binary(),
       gpu_executable->dnn_compiled_graphs());
 }
 
@@ -2658,7 +2900,13 @@ HloCostAnalysis::Options CreateHloAnalysisOpts(
   hlo_cost_analysis_options.shape_size = shape_size_fn;
   std::optional<HloRematerialization::HostMemoryOffloadConfig>
       offloading_config = std::nullopt;
-  if (module.config().debug_options().xla_gpu_enable_host_memory_offloading()) {
+  const DebugOptions& debug_options = module.config().debug_options();
+  if (debug_options.xla_gpu_rematerialization_minimize_added_time()) {
+    hlo_cost_analysis_options.set_bytes_per_second(
+        gpu_device_info.memory_bandwidth());
+  }
+  if (debug_options.xla_gpu_enable_host_memory_offloading() ||
+      debug_options.xla_gpu_rematerialization_minimize_added_time()) {
     constexpr float kGiga = 1e+9;
     // Fused multiply-add means that these two instructions are computed as
     // one, so for this case the maximum flops is doubled.
@@ -2709,6 +2957,20 @@ HloRematerialization::Options CreateRematOpts(
       /*block_size_limit=*/1, /*block_rematerialization_factor=*/1,
       /*min_remat_size=*/0, /*compact_shape_function=*/nullptr,
       /*host_memory_offload_config=*/offloading_config);
+  const DebugOptions& debug_options = module.config().debug_options();
+  options.minimize_added_time =
+      debug_options.xla_gpu_rematerialization_minimize_added_time();
+  if (debug_options.xla_gpu_rematerialization_time_budget_seconds() > 0) {
+    options.time_budget = absl::Seconds(
+        debug_options.xla_gpu_rematerialization_time_budget_seconds());
+  }
+  if (debug_options.xla_gpu_enable_parallel_rematerialization()) {
+    static tsl::thread::ThreadPool* const thread_pool =
+        new tsl::thread::ThreadPool(tsl::Env::Default(),
+                                    "xla_gpu_rematerialization",
+                                    tsl::port::MaxParallelism());
+    options.thread_pool = thread_pool;
+  }
   return options;
 }
 
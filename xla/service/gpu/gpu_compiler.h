@@ -218,6 +218,14 @@ class GpuCompiler : public LLVMCompiler {
   absl::Status RunCollectiveScheduleLinearizerPasses(
       HloModule* hlo_module, se::StreamExecutor* stream_exec);
 
+  // Runs HLO optimization passes with autotuning enabled on a copy of `module`
+  // in a background thread, to populate autotuning caches for later
+  // compilations. The caller compiles `module` with default autotuning configs.
+  void ScheduleBackgroundAutotuning(const HloModule& module,
+                                    se::StreamExecutor* stream_exec,
+                                    const CompileOptions& options,
+                                    const TargetConfig& gpu_target_config);
+
   // During compilation with device, stream_exec != null and autotune_results
   // == null. During deviceless AOT compilation, stream_exec == null and
   // autotune_results != null.
@@ -56,6 +56,7 @@ limitations under the License.
 #include "xla/service/executable.h"
 #include "xla/service/gpu/autotuning/autotuner_util.h"
 #include "xla/service/gpu/backend_configs.pb.h"
+#include "xla/service/gpu/executable.pb.h"
 #include "xla/service/gpu/gpu_hlo_schedule.h"
 #include "xla/service/gpu/metrics.h"
 #include "xla/service/hlo_module_config.h"
@@ -1074,6 +1075,48 @@ ENTRY e {
   test(kHloAdd2, 1, 3);
 }
 
+TEST_F(GpuCompilerTest, SerializedExecutableHasKernelLaunchParameters) {
+  const absl::string_view kHlo = R"(
+add1 {
+  p = s32[1024] parameter(0)
+  c = s32[] constant(1)
+  b = s32[1024] broadcast(c), dimensions={}
+  ROOT a = s32[1024] add(p, b)
+}
+
+ENTRY e {
+  p = s32[1024] parameter(0)
+  ROOT r = s32[1024] fusion(p), kind=kLoop, calls=add1
+})";
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(kHlo));
+  Compiler* compiler = backend().compiler();
+  AotCompilationOptions aot_options(compiler->PlatformId());
+  aot_options.set_executor(backend().default_stream_executor());
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::vector<std::unique_ptr<AotCompilationResult>> aot_results,
+      compiler->CompileAheadOfTime(
+          std::make_unique<HloModuleGroup>(std::move(module)), aot_options));
+  TF_ASSERT_OK_AND_ASSIGN(std::string serialized_aot_result,
+                          aot_results[0]->SerializeAsString());
+
+  CompilationResultProto proto;
+  ASSERT_TRUE(proto.ParseFromString(serialized_aot_result));
+  EXPECT_THAT(proto.kernels().entries(), Not(IsEmpty()));
+  for (const auto& [name, entry] : proto.kernels().entries()) {
+    EXPECT_GT(entry.launch_dimensions().num_blocks(), 0) << name;
+    EXPECT_GT(entry.launch_dimensions().num_threads_per_block(), 0) << name;
+    EXPECT_THAT(entry.binary(), IsEmpty()) << name;
+  }
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<AotCompilationResult> aot_result,
+      compiler->LoadAotCompilationResult(serialized_aot_result));
+  TF_EXPECT_OK(std::move(*aot_result)
+                   .LoadExecutable(compiler, aot_options.executor())
+                   .status());
+}
+
 class KernelCacheTestSingleThreaded : public KernelCacheTest {
  public:
   DebugOptions GetDebugOptionsForTest() const override {
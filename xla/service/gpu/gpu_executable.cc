@@ -56,6 +56,7 @@ limitations under the License.
 #include "xla/service/gpu/buffer_allocations.h"
 #include "xla/service/gpu/gpu_constants.h"
 #include "xla/service/gpu/gpu_executable_run_options.h"
+#include "xla/service/gpu/metrics.h"
 #include "xla/service/gpu/resource_requests.h"
 #include "xla/service/gpu/stream_executor_util.h"
 #include "xla/service/hlo_value.h"
@@ -85,6 +86,7 @@ limitations under the License.
 #include "tsl/platform/env_time.h"
 #include "tsl/platform/errors.h"
 #include "tsl/platform/logging.h"
+#include "tsl/platform/path.h"
 #include "tsl/platform/random.h"
 #include "tsl/platform/status.h"
 #include "tsl/platform/statusor.h"
@@ -110,6 +112,112 @@ static absl::flat_hash_set<ExecutionStreamId> GetExecutionStreamIds(
   return stream_ids;
 }
 
+// Returns true if `opcode` completes an asynchronous operation whose result
+// is defined by the matching start instruction.
+static bool IsAsyncDone(HloOpcode opcode) {
+  switch (opcode) {
+    case HloOpcode::kAllGatherDone:
+    case HloOpcode::kAllReduceDone:
+    case HloOpcode::kAsyncDone:
+    case HloOpcode::kCollectivePermuteDone:
+    case HloOpcode::kCopyDone:
+    case HloOpcode::kRecvDone:
+    case HloOpcode::kSendDone:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Returns the top-level outputs that are fully written once each top-level
+// thunk has been enqueued, keyed by the index of that thunk. Outputs that no
+// thunk writes (e.g. donated parameters) are keyed by -1. Writers of an output
+// are all values assigned to an overlapping part of its buffer allocation
+// slices. Outputs with a writer that can't be attributed to a thunk on the
+// main execution stream are left out, and become ready with the executable.
+static absl::flat_hash_map<int64_t, std::vector<int64_t>>
+GetOutputsReadyAfterThunk(const SequentialThunk& thunks,
+                          const HloModule& module,
+                          const BufferAssignment& assignment) {
+  // Maps every instruction name to the last top-level thunk that executes it.
+  absl::flat_hash_map<std::string, int64_t> thunk_index;
+  absl::flat_hash_set<int64_t> uses_other_streams;
+  for (int64_t i = 0; i < thunks.thunks().size(); ++i) {
+    thunks.thunks()[i]->ForAllThunks([&](const Thunk* thunk) {
+      if (!thunk->profile_annotation().empty()) {
+        thunk_index[thunk->profile_annotation()] = i;
+      }
+      if (thunk->execution_stream_id() != Thunk::kDefaultExecutionStreamId) {
+        uses_other_streams.insert(i);
+      }
+    });
+  }
+  auto writer_index =
+      [&](const HloInstruction* instr) -> std::optional<int64_t> {
+    if (instr->opcode() == HloOpcode::kParameter ||
+        instr->opcode() == HloOpcode::kConstant) {
+      return -1;
+    }
+    auto it = thunk_index.find(instr->name());
+    if (it == thunk_index.end() || uses_other_streams.contains(it->second)) {
+      return std::nullopt;
+    }
+    return it->second;
+  };
+
+  const HloInstruction* root = module.entry_computation()->root_instruction();
+  bool is_tuple = root->shape().IsTuple();
+  int64_t num_outputs = is_tuple ? root->shape().tuple_shapes_size() : 1;
+
+  absl::flat_hash_map<int64_t, std::vector<int64_t>> outputs_ready_after_thunk;
+  for (int64_t output_index = 0; output_index < num_outputs; ++output_index) {
+    std::optional<int64_t> ready_after = -1;
+    ShapeIndex prefix = is_tuple ? ShapeIndex{output_index} : ShapeIndex{};
+    ShapeUtil::ForEachSubshape(
+        ShapeUtil::GetSubshape(root->shape(), prefix),
+        [&](const Shape& subshape, const ShapeIndex& subindex) {
+          if (!ready_after.has_value() || !subshape.IsArray()) {
+            return;
+          }
+          ShapeIndex index = prefix;
+          for (int64_t i : subindex) {
+            index.push_back(i);
+          }
+          absl::StatusOr<BufferAllocation::Slice> slice =
+              assignment.GetUniqueSlice(root, index);
+          if (!slice.ok()) {
+            ready_after = std::nullopt;
+            return;
+          }
+          for (const auto& [value, offset_size] :
+               slice->allocation()->assigned_buffers()) {
+            if (offset_size.offset >= slice->offset() + slice->size() ||
+                offset_size.offset + offset_size.size <= slice->offset()) {
+              continue;
+            }
+            std::vector<const HloInstruction*> writers = {value->instruction()};
+            for (const HloInstruction* user : value->instruction()->users()) {
+              if (IsAsyncDone(user->opcode())) {
+                writers.push_back(user);
+              }
+            }
+            for (const HloInstruction* writer : writers) {
+              std::optional<int64_t> thunk = writer_index(writer);
+              if (!thunk.has_value()) {
+                ready_after = std::nullopt;
+                return;
+              }
+              ready_after = std::max(*ready_after, *thunk);
+            }
+          }
+        });
+    if (ready_after.has_value()) {
+      outputs_ready_after_thunk[*ready_after].push_back(output_index);
+    }
+  }
+  return outputs_ready_after_thunk;
+}
+
 absl::StatusOr<std::unique_ptr<GpuExecutable>> GpuExecutable::Create(
     Params params) {
   return std::unique_ptr<GpuExecutable>(new GpuExecutable(std::move(params)));
@@ -146,6 +254,31 @@ GpuExecutable::GpuExecutable(GpuExecutable::Params params)
     XlaDebugInfoManager::Get()->RegisterModule(shared_module(),
                                                buffer_assignment_->ToProto());
   }
+  const DebugOptions* debug_options =
+      has_module() ? &module_config().debug_options() : nullptr;
+  if (debug_options &&
+      debug_options->xla_gpu_experimental_kernel_profiling_interval() > 0 &&
+      !debug_options->xla_gpu_experimental_kernel_profile_directory().empty()) {
+    // The profile guided latency estimator looks up profiles in a directory by
+    // the fingerprint the scheduler tags the module with.
+    std::string profile_name = module_name_;
+    if (auto it = module().frontend_attributes().map().find(
+            "fingerprint_before_lhs");
+        it != module().frontend_attributes().map().end()) {
+      profile_name = it->second;
+    }
+    kernel_timing_profiler_ = std::make_unique<KernelTimingProfiler>(
+        debug_options->xla_gpu_experimental_kernel_profiling_interval(),
+        tsl::io::JoinPath(
+            debug_options->xla_gpu_experimental_kernel_profile_directory(),
+            absl::StrCat(profile_name, ".pbtxt")));
+  }
+  if (debug_options &&
+      debug_options->xla_gpu_experimental_enable_early_output_events() &&
+      buffer_assignment_ != nullptr) {
+    outputs_ready_after_thunk_ =
+        GetOutputsReadyAfterThunk(*thunks_, module(), *buffer_assignment_);
+  }
 }
 
 GpuExecutable::~GpuExecutable() {
@@ -195,13 +328,50 @@ absl::Status RendezvousAfterInitialization(
     const ServiceExecutableRunOptions* run_options,
     const DebugOptions* debug_options);
 
+// Executes `thunk_sequence` like `SequentialThunk::ExecuteOnStream`, and calls
+// `output_ready` for each output in `outputs_ready_after_thunk` right after
+// the thunk that completes it has been enqueued.
+absl::Status ExecuteThunksAndNotifyOutputs(
+    const SequentialThunk& thunk_sequence, const Thunk::ExecuteParams& params,
+    const absl::flat_hash_map<int64_t, std::vector<int64_t>>&
+        outputs_ready_after_thunk,
+    const OutputReadyFunction& output_ready) {
+  auto notify_outputs = [&](int64_t thunk_index) {
+    auto it = outputs_ready_after_thunk.find(thunk_index);
+    if (it == outputs_ready_after_thunk.end()) {
+      return;
+    }
+    for (int64_t output_index : it->second) {
+      output_ready(output_index, params.stream);
+    }
+  };
+
+  notify_outputs(-1);
+  std::optional<tsl::profiler::ScopedAnnotation> seq_annotation =
+      GetKernelAnnotation(thunk_sequence.profile_annotation());
+  const ThunkSequence& thunks = thunk_sequence.thunks();
+  for (int64_t i = 0; i < thunks.size(); ++i) {
+    const std::unique_ptr<Thunk>& thunk = thunks[i];
+    std::optional<tsl::profiler::ScopedAnnotation> annotation =
+        GetKernelAnnotation(thunk->profile_annotation());
+    if (!params.mock_collectives || !thunk->IsCollective()) {
+      TF_RETURN_IF_ERROR(thunk->ExecuteOnStream(params));
+    }
+    notify_outputs(i);
+  }
+  return absl::OkStatus();
+}
+
 absl::Status ExecuteThunksImpl(
     const DebugOptions* debug_options, const std::string& module_name,
     ModuleIdentifier module_id, SequentialThunk& thunk_sequence,
     Thunk::ExecutableSource executable_source,
     const ServiceExecutableRunOptions* run_options,
     const BufferAllocations& buffer_allocations, bool block_host_until_done,
-    const absl::flat_hash_set<ExecutionStreamId>& execution_stream_ids) {
+    const absl::flat_hash_set<ExecutionStreamId>& execution_stream_ids,
+    KernelTimingProfiler* kernel_timing_profiler,
+    const absl::flat_hash_map<int64_t, std::vector<int64_t>>&
+        outputs_ready_after_thunk) {
   bool mock_collectives =
       run_options->run_options().gpu_executable_run_options()
           ? run_options->run_options()
@@ -323,10 +493,15 @@ absl::Status ExecuteThunksImpl(
         &collective_cliques,
         run_options->run_options().ffi_execution_context(),
         run_options->local_device_count(),
-        requires_exclusive_lock_on_gpu};
+        requires_exclusive_lock_on_gpu,
+        debug_options &&
+            debug_options->xla_gpu_experimental_lazy_kernel_loading()};
 
     tsl::profiler::TraceMe trace([&] { return "Thunks::Initialize"; });
+    uint64_t start_micros = tsl::Env::Default()->NowMicros();
     TF_RETURN_IF_ERROR(thunk_sequence.Initialize(initialize_params));
+    RecordExecutableInitializeDuration(tsl::Env::Default()->NowMicros() -
+                                       start_micros);
   }
 
   // Maybe join a round of rendezvous after thunk initialization. We do this
@@ -347,7 +522,19 @@ absl::Status ExecuteThunksImpl(
 
   VLOG(1) << "[" << run_options->device_ordinal() << "] "
           << "Start GpuExecutable::ExecuteOnStream module: " << module_name;
-  TF_RETURN_IF_ERROR(thunk_sequence.ExecuteOnStream(execute_params));
+  if (kernel_timing_profiler != nullptr &&
+      kernel_timing_profiler->ShouldProfileExecution()) {
+    TF_RETURN_IF_ERROR(kernel_timing_profiler->ExecuteAndProfile(
+        thunk_sequence, execute_params));
+  } else if (OutputReadyFunction* output_ready =
+                 run_options->run_options().output_ready_function();
+             output_ready != nullptr && !outputs_ready_after_thunk.empty()) {
+    TF_RETURN_IF_ERROR(ExecuteThunksAndNotifyOutputs(
+        thunk_sequence, execute_params, outputs_ready_after_thunk,
+        *output_ready));
+  } else {
+    TF_RETURN_IF_ERROR(thunk_sequence.ExecuteOnStream(execute_params));
+  }
   VLOG(1) << "[" << run_options->device_ordinal() << "] "
           << "End GpuExecutable::ExecuteOnStream module: " << module_name;
 
@@ -894,7 +1081,51 @@ absl::Status GpuExecutable::ExecuteThunks(
   TF_RETURN_IF_ERROR(ExecuteThunksImpl(
       has_module() ? &module_config().debug_options() : nullptr, module_name_,
       unique_id, *thunks_, executable_source, run_options, buffer_allocations,
-      block_host_until_done, execution_stream_ids_));
+      block_host_until_done, execution_stream_ids_,
+      kernel_timing_profiler_.get(), outputs_ready_after_thunk_));
+  return absl::OkStatus();
+}
+
+absl::Status GpuExecutable::WarmUpCollectiveCliques(
+    const ServiceExecutableRunOptions* run_options) {
+  const DebugOptions* debug_options =
+      has_module() ? &module_config().debug_options() : nullptr;
+  int64_t collective_max_nchannels =
+      debug_options ? debug_options->xla_gpu_nccl_collective_max_nchannels()
+                    : 0;
+  int64_t p2p_max_nchannels =
+      debug_options ? debug_options->xla_gpu_nccl_p2p_max_nchannels() : 0;
+
+  tsl::profiler::TraceMe trace([&] {
+    return absl::StrCat(module_name_, ":WarmUpCollectiveCliques");
+  });
+
+  TF_ASSIGN_OR_RETURN(Thunk::CollectiveExecuteParams collective_params,
+                      Thunk::CollectiveExecuteParams::Create(
+                          *run_options, /*async_streams=*/{},
+                          run_options->stream()->parent()->device_ordinal(),
+                          collective_max_nchannels, p2p_max_nchannels));
+
+  ResourceRequests resource_requests;
+  Thunk::PrepareParams prepare_params{&collective_params};
+  TF_RETURN_IF_ERROR(thunks_->Prepare(prepare_params, resource_requests));
+
+  // Acquired cliques are kept in the process-wide clique cache, and are
+  // reused by all later executions that need the same clique keys.
+  TF_ASSIGN_OR_RETURN(
+      Thunk::CollectiveCliques collective_cliques,
+      resource_requests.AcquireCollectiveCliques(
+          collective_params,
+          debug_options
+              ? debug_options->xla_gpu_collectives_use_persistent_cliques()
+              : false));
+  VLOG(1) << "[" << run_options->device_ordinal() << "] "
+          << "Warmed up collective cliques for module " << module_name_;
+
+  if (collective_cliques.num_transient_cliques() > 0) {
+    TF_RETURN_IF_ERROR(
+        RendezvousAfterInitialization(run_options, debug_options));
+  }
   return absl::OkStatus();
 }
 
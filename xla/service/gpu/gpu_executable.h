@@ -40,6 +40,7 @@ limitations under the License.
 #include "xla/service/executable.h"
 #include "xla/service/gpu/buffer_allocations.h"
 #include "xla/service/gpu/ir_emission_utils.h"
+#include "xla/service/gpu/kernel_timing_profiler.h"
 #include "xla/service/service_executable_run_options.h"
 #include "xla/service/shaped_buffer.h"
 #include "xla/service/xla_debug_info_manager.h"
@@ -173,11 +174,22 @@ class GpuExecutable : public Executable {
     return buffer_assignment_.get();
   }
 
+  const BufferAssignment* GetBufferAssignment() const override {
+    return buffer_assignment_.get();
+  }
+
   const SequentialThunk& GetThunk() { return *thunks_; }
 
   absl::Status ExecuteThunks(const BufferAllocations& buffer_allocations,
                              const ServiceExecutableRunOptions* run_options);
 
+  // Creates the collective cliques required by the collective thunks of this
+  // executable, so that the first execution doesn't pay for communicator
+  // initialization. Like an execution, this must be called concurrently for
+  // all participating devices with the same run id.
+  absl::Status WarmUpCollectiveCliques(
+      const ServiceExecutableRunOptions* run_options);
+
   using BufferAllocToDeviceMemoryMap =
       absl::flat_hash_map<BufferAllocation::Index, se::DeviceMemoryBase>;
 
@@ -294,6 +306,17 @@ class GpuExecutable : public Executable {
   std::vector<std::shared_ptr<se::DeviceMemoryBase>> shared_constants_;
   bool enable_debug_info_manager_;
 
+  // Samples kernel execution times at runtime if enabled via
+  // xla_gpu_experimental_kernel_profiling_interval, null otherwise.
+  std::unique_ptr<KernelTimingProfiler> kernel_timing_profiler_;
+
+  // Top-level outputs that are ready once the top-level thunk with the given
+  // index has been enqueued (-1 for outputs that are ready before any thunk
+  // runs). Only populated if xla_gpu_experimental_enable_early_output_events
+  // is set.
+  absl::flat_hash_map<int64_t, std::vector<int64_t>>
+      outputs_ready_after_thunk_;
+
   GpuExecutable(const GpuExecutable&) = delete;
   GpuExecutable& operator=(const GpuExecutable&) = delete;
 };
@@ -18,6 +18,7 @@ limitations under the License.
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <limits>
 #include <optional>
 #include <utility>
 #include <vector>
@@ -35,7 +36,9 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_opcode.h"
 #include "xla/hlo/utils/hlo_traversal.h"
+#include "xla/layout_util.h"
 #include "xla/permutation_util.h"
+#include "xla/primitive_util.h"
 #include "xla/service/gpu/backend_configs.pb.h"
 #include "xla/service/gpu/hlo_fusion_analysis.h"
 #include "xla/service/gpu/ir_emission_utils.h"
@@ -79,6 +82,65 @@ int ComputeMaxUnrollFactor(int64_t num_elements) {
   return 1;
 }
 
+// Returns the unroll factor that lets each thread read the narrowest parameter
+// of the fusion with a single 128-bit load, if that is larger than what the
+// output type alone calls for. Only parameters that are read elementwise, i.e.
+// that have the shape and layout of `element_shape`, are contiguous in the
+// same way as the output. Returns 1 if no such parameter is narrow enough.
+int ComputeUnrollFactorForNarrowInputs(const HloFusionAnalysis& analysis,
+                                       const Shape& element_shape) {
+  // Wider unrolling spills registers if the output elements are wide.
+  static constexpr int kMaxUnrollFactorForNarrowInputs = 8;
+  static constexpr int kVectorLoadBits = 128;
+  int smallest_bits = std::numeric_limits<int>::max();
+  for (const HloInstruction* param : analysis.fusion().GetParameters()) {
+    if (param->shape().IsArray() &&
+        Shape::Equal().IgnoreElementType().IgnoreElementSizeInLayout()(
+            param->shape(), element_shape)) {
+      smallest_bits = std::min(
+          smallest_bits,
+          primitive_util::BitWidth(param->shape().element_type()));
+    }
+  }
+  if (smallest_bits == std::numeric_limits<int>::max()) {
+    return 1;
+  }
+  int64_t num_elements = ShapeUtil::ElementsIn(element_shape);
+  for (int i = std::min(kMaxUnrollFactorForNarrowInputs,
+                        CeilOfRatio(kVectorLoadBits, smallest_bits));
+       i > MaxUnrollFactor(); i /= 2) {
+    if (num_elements % i == 0) {
+      return i;
+    }
+  }
+  return 1;
+}
+
+// Returns the length of the rows that `instr` copies from its operand, if it
+// is a gather of whole minor-most rows, such as an embedding lookup.
+std::optional<int64_t> GetGatheredRowLength(const HloInstruction& instr) {
+  if (instr.opcode() != HloOpcode::kGather) {
+    return std::nullopt;
+  }
+  const Shape& operand_shape = instr.operand(0)->shape();
+  const GatherDimensionNumbers& dnums = instr.gather_dimension_numbers();
+  const int64_t minor_dim = operand_shape.dimensions_size() - 1;
+  if (minor_dim < 0 || !operand_shape.has_layout() ||
+      !instr.shape().has_layout() ||
+      !LayoutUtil::IsMonotonicWithDim0Major(operand_shape.layout()) ||
+      !LayoutUtil::IsMonotonicWithDim0Major(instr.shape().layout()) ||
+      absl::c_linear_search(dnums.collapsed_slice_dims(), minor_dim) ||
+      absl::c_linear_search(dnums.operand_batching_dims(), minor_dim) ||
+      dnums.offset_dims().empty() ||
+      dnums.offset_dims().Get(dnums.offset_dims_size() - 1) !=
+          instr.shape().dimensions_size() - 1 ||
+      instr.gather_slice_sizes().back() !=
+          operand_shape.dimensions(minor_dim)) {
+    return std::nullopt;
+  }
+  return operand_shape.dimensions(minor_dim);
+}
+
 }  // namespace
 
 bool IsPhysicallyTransposing(const HloInstruction& instr) {
@@ -901,7 +963,27 @@ std::vector<HloComputation*> GetFusibleComputations(
 
 LaunchDimensionsConfig ComputeLoopFusionConfig(
     const HloFusionAnalysis& analysis) {
-  return ComputeLoopFusionConfig(analysis, GetElementShape(analysis));
+  const Shape& element_shape = GetElementShape(analysis);
+  LaunchDimensionsConfig launch_config =
+      ComputeLoopFusionConfig(analysis, element_shape);
+  if (launch_config.unroll_factor != MaxUnrollFactor()) {
+    return launch_config;
+  }
+  // Loop fusions that read narrower types than they write, e.g. bf16 to f32,
+  // are unrolled further so that the narrow reads are full vector loads, as
+  // long as that launches as many threads as the smallest fusion that is
+  // unrolled by `MaxUnrollFactor()`.
+  int unroll_factor =
+      ComputeUnrollFactorForNarrowInputs(analysis, element_shape);
+  int64_t n_threads_max = analysis.device_info().threads_per_core_limit() *
+                          analysis.device_info().core_count();
+  if (unroll_factor > launch_config.unroll_factor &&
+      ShapeUtil::ElementsIn(element_shape) / unroll_factor >=
+          n_threads_max / MaxUnrollFactor()) {
+    VLOG(2) << "Unroll factor for narrow inputs: " << unroll_factor;
+    launch_config.unroll_factor = unroll_factor;
+  }
+  return launch_config;
 }
 
 LaunchDimensionsConfig ComputeLoopFusionConfig(
@@ -916,8 +998,16 @@ LaunchDimensionsConfig ComputeLoopFusionConfig(
   int64_t num_elements = ShapeUtil::ElementsIn(element_shape);
   int64_t n_threads_max = analysis.device_info().threads_per_core_limit() *
                           analysis.device_info().core_count();
-  if (num_elements >= n_threads_max &&
-      !MayPreventVectorization(analysis.fusion())) {
+  // Gathers of whole rows are an exception: each thread reads its elements
+  // with a single vector load and only needs to read the gather index once,
+  // so they are unrolled even if they are small. The unroll factor has to
+  // divide the row length, otherwise the rows are not aligned to the vectors.
+  std::optional<int64_t> row_length =
+      GetGatheredRowLength(analysis.fusion_root(0).instruction());
+  if (row_length.has_value() && !MayPreventVectorization(analysis.fusion())) {
+    unroll_factor = ComputeMaxUnrollFactor(*row_length);
+  } else if (num_elements >= n_threads_max &&
+             !MayPreventVectorization(analysis.fusion())) {
     unroll_factor = ComputeMaxUnrollFactor(num_elements);
   }
   // CHECK that unroll_factor is a power-of-2, as needed by the logic below.
@@ -226,6 +226,9 @@ bool MayPreventVectorization(const HloFusionAdaptor& fusion);
 // Returns the max loop unroll factor.
 inline constexpr int64_t MaxUnrollFactor() { return 4; }
 
+// Like the overload below for the shape of the first fusion root, but also
+// unrolls loop fusions further if that lets them read their narrowest
+// elementwise parameter with 128-bit loads.
 LaunchDimensionsConfig ComputeLoopFusionConfig(
     const HloFusionAnalysis& analysis);
 
@@ -571,6 +571,11 @@ absl::Status RunLatencyHidingSchedulerPasses(
   SchedulerConfig config = MakeGPUSchedulerConfig(
       memory_limit,
       options.xla_gpu_experimental_parallel_collective_overlap_limit());
+  if (options.xla_gpu_latency_hiding_scheduler_memory_search_steps() > 0) {
+    config.rerun =
+        options.xla_gpu_latency_hiding_scheduler_memory_search_steps();
+    config.search_memory_limit = true;
+  }
 
   auto shape_size_in_bytes = ShapeSizeBytesFunction(pointer_size);
 
@@ -591,6 +596,17 @@ absl::Status RunLatencyHidingSchedulerPasses(
       /*scheduling_instruction_crosses_overlap_limit=*/
       GpuScheduleCrossesOverlapLimit);
 
+  // Schedules are reused across compilations in this process. Profiles are
+  // specific to a module, so schedules made with them are not cached.
+  if (options.xla_gpu_enable_latency_hiding_schedule_cache() &&
+      typeid(*estimator) != typeid(ProfileGuidedLatencyEstimator)) {
+    static auto* const schedule_cache = new LatencyHidingScheduleCache();
+    scheduler_core->SetScheduleCache(
+        schedule_cache,
+        absl::StrCat(gpu_device_info.name(), ";", typeid(*estimator).name(),
+                     ";", pointer_size, ";", options.DebugString()));
+  }
+
   pipeline.AddPass<LatencyHidingScheduler>(
       std::move(estimator), std::move(async_tracker), std::move(scheduler_core),
       shape_size_in_bytes);
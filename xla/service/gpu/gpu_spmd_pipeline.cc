@@ -15,13 +15,27 @@ limitations under the License.
 
 #include "xla/service/gpu/gpu_spmd_pipeline.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <memory>
 #include <optional>
+#include <utility>
+#include <variant>
 
 #include "absl/functional/function_ref.h"
 #include "absl/log/check.h"
+#include "absl/log/log.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+#include "absl/types/span.h"
+#include "xla/hlo/ir/collective_device_list.h"
+#include "xla/hlo/ir/hlo_casting_utils.h"
+#include "xla/hlo/ir/hlo_computation.h"
 #include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_instructions.h"
 #include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/ir/hlo_opcode.h"
 #include "xla/hlo/ir/hlo_schedule.h"
 #include "xla/hlo/pass/hlo_pass_fix.h"
 #include "xla/hlo/pass/hlo_pass_pipeline.h"
@@ -34,7 +48,10 @@ limitations under the License.
 #include "xla/hlo/transforms/simplifiers/tuple_simplifier.h"
 #include "xla/service/conditional_simplifier.h"
 #include "xla/service/gather_expander.h"
+#include "xla/service/gpu/model/collective_interpolator.h"
+#include "xla/service/gpu/model/gpu_collective_performance_model.h"
 #include "xla/service/gpu/transforms/algebraic_simplifier.h"
+#include "xla/service/hlo_cost_analysis.h"
 #include "xla/service/hlo_module_config.h"
 #include "xla/service/scatter_expander.h"
 #include "xla/service/sharding_propagation.h"
@@ -43,18 +60,148 @@ limitations under the License.
 #include "xla/service/spmd/stateful_rng_spmd_partitioner.h"
 #include "xla/service/while_loop_constant_sinking.h"
 #include "xla/service/while_loop_simplifier.h"
+#include "xla/shape.h"
+#include "xla/shape_util.h"
 #include "xla/stream_executor/device_description.h"
+#include "xla/util.h"
+#include "xla/xla.pb.h"
+#include "xla/xla_data.pb.h"
 
 namespace xla {
 namespace gpu {
 
+namespace {
+
+// Roofline estimate of the run time of a dot or convolution, in milliseconds.
+double EstimateComputationTimeInMs(const se::DeviceDescription& device_info,
+                                   const HloInstruction* hlo) {
+  double flops = 0.0;
+  if (hlo->opcode() == HloOpcode::kDot) {
+    flops = HloCostAnalysis::GetDotFlops(
+        hlo->operand(0)->shape(), hlo->shape(), hlo->dot_dimension_numbers());
+  } else if (hlo->opcode() == HloOpcode::kConvolution) {
+    flops = HloCostAnalysis::GetConvolutionFlops(
+        hlo, hlo->operand(0)->shape(), hlo->operand(1)->shape(), hlo->shape());
+  }
+  double bytes = ShapeUtil::ByteSizeOf(hlo->shape());
+  for (const HloInstruction* operand : hlo->operands()) {
+    bytes += ShapeUtil::ByteSizeOf(operand->shape());
+  }
+  const double flops_per_ms = 2e6 * device_info.clock_rate_ghz() *
+                              device_info.core_count() *
+                              device_info.fpus_per_core();
+  const double bytes_per_ms = device_info.memory_bandwidth() * 1e-3;
+  if (flops_per_ms <= 0 || bytes_per_ms <= 0) {
+    return 0.0;
+  }
+  return std::max(flops / flops_per_ms, bytes / bytes_per_ms);
+}
+
+// Estimate of the run time of a ring collective that moves `bytes` within each
+// of `device_groups` over NVLink, in milliseconds.
+double EstimateCommunicationTimeInMs(
+    const se::CudaComputeCapability& compute_capability,
+    int64_t num_partitions, int64_t bytes,
+    absl::Span<const ReplicaGroup> device_groups) {
+  using Model = GpuPerformanceWithCollectiveModel;
+  const int64_t group_size = device_groups.empty()
+                                 ? num_partitions
+                                 : device_groups[0].replica_ids_size();
+  if (group_size <= 1) {
+    return 0.0;
+  }
+  // Each device sends and receives all but its own share of the data.
+  const double bytes_on_wire =
+      static_cast<double>(bytes) * (group_size - 1) / group_size;
+  const double bytes_per_ms = 1e6 * Model::GetNvlinkBw(compute_capability) *
+                              Model::kMaxNumChannelsRing *
+                              Model::kRingAlgorithmDiscountFactor;
+  return bytes_on_wire / bytes_per_ms;
+}
+
+// Run times of all-gathers looked up in the collective performance tables: the
+// default table shipped with XLA, merged with the measured tables passed in
+// --xla_gpu_experimental_collective_perf_table_path. Unlike the NVLink
+// estimate, the tables also cover collectives that cross hosts.
+class CollectivePerfTableTimes {
+ public:
+  // Returns nullptr if there is no table for `device_description`.
+  static std::shared_ptr<const CollectivePerfTableTimes> Create(
+      absl::string_view perf_table_paths,
+      const se::DeviceDescription& device_description) {
+    auto times = std::make_shared<CollectivePerfTableTimes>(device_description);
+    absl::StatusOr<std::unique_ptr<CollectiveInterpolator>> interpolator =
+        CollectiveInterpolator::Create(perf_table_paths,
+                                       times->device_description_);
+    if (!interpolator.ok()) {
+      VLOG(1) << "No collective perf table for the windowed einsum cost "
+                 "model: "
+              << interpolator.status();
+      return nullptr;
+    }
+    times->interpolator_ = *std::move(interpolator);
+    return times;
+  }
+
+  explicit CollectivePerfTableTimes(
+      const se::DeviceDescription& device_description)
+      : device_description_(device_description) {}
+
+  // Returns the run time of an all-gather of `bytes` within each of
+  // `device_groups`, in milliseconds, or nullopt if the tables don't model it.
+  std::optional<double> AllGatherTimeInMs(
+      int64_t num_partitions, int64_t bytes,
+      absl::Span<const ReplicaGroup> device_groups) const {
+    const int64_t group_size = device_groups.empty()
+                                   ? num_partitions
+                                   : device_groups[0].replica_ids_size();
+    if (group_size <= 1) {
+      return 0.0;
+    }
+    HloModuleConfig config;
+    config.set_num_partitions(num_partitions);
+    HloModule module("all_gather", config);
+    const int64_t shard_bytes = CeilOfRatio(bytes, group_size);
+    CollectiveDeviceList device_list =
+        device_groups.empty()
+            ? CollectiveDeviceList(IotaReplicaGroupList(1, num_partitions))
+            : CollectiveDeviceList(device_groups);
+    HloComputation::Builder builder("entry");
+    HloInstruction* param =
+        builder.AddInstruction(HloInstruction::CreateParameter(
+            0, ShapeUtil::MakeShape(U8, {shard_bytes}), "p0"));
+    HloInstruction* all_gather =
+        builder.AddInstruction(HloInstruction::CreateAllGather(
+            ShapeUtil::MakeShape(U8, {shard_bytes * group_size}), {param},
+            /*all_gather_dimension=*/0, device_list,
+            /*constrain_layout=*/false, /*channel_id=*/1,
+            /*use_global_device_ids=*/true));
+    module.AddEntryComputation(builder.Build());
+    std::optional<absl::Duration> runtime = interpolator_->EstimatedRuntime(
+        *Cast<HloCollectiveInstruction>(all_gather));
+    if (!runtime.has_value()) {
+      return std::nullopt;
+    }
+    return absl::ToDoubleMilliseconds(*runtime);
+  }
+
+ private:
+  // Owned here, since the interpolator keeps a reference to it.
+  se::DeviceDescription device_description_;
+  std::unique_ptr<CollectiveInterpolator> interpolator_;
+};
+
+}  // namespace
+
 void AddSPMDPasses(
     const HloModule* hlo_module,
     const AlgebraicSimplifierOptions& layout_insensitive_algsimp_opts,
-    const se::GpuComputeCapability& compute_capability,
+    const se::DeviceDescription& device_description,
     HloPassPipeline& spmd_pipeline,
     std::optional<const absl::FunctionRef<void(HloPassPipeline&)>>
         auto_sharding_func) {
+  const se::GpuComputeCapability& compute_capability =
+      device_description.gpu_compute_capability();
   const int64_t num_partitions = hlo_module->config().num_partitions();
   CHECK_GE(num_partitions, 1);
 
@@ -102,25 +249,49 @@ void AddSPMDPasses(
         /*is_spmd=*/true, /*propagate_metadata=*/false,
         config.allow_spmd_sharding_propagation_to_output());
   }
+  const DebugOptions& debug_options = hlo_module->config().debug_options();
   std::optional<int64_t> oper_size_threshold = std::nullopt;
-  if (hlo_module->config()
-          .debug_options()
-          .xla_gpu_operand_bytes_threshold_for_windowed_einsum() >= 0) {
+  if (debug_options.xla_gpu_operand_bytes_threshold_for_windowed_einsum() >=
+      0) {
     oper_size_threshold =
-        hlo_module->config()
-            .debug_options()
-            .xla_gpu_operand_bytes_threshold_for_windowed_einsum();
+        debug_options.xla_gpu_operand_bytes_threshold_for_windowed_einsum();
+  }
+  spmd::SpmdPartitionerOptions partitioner_options =
+      spmd::StatefulRngSpmdPartitioner::GetSpmdPartitionerOptions(
+          debug_options.xla_gpu_threshold_for_windowed_einsum_mib(),
+          debug_options.xla_gpu_multi_streamed_windowed_einsum(),
+          /*skip_checking_windowed_einsum_users=*/true,
+          /*disable_ag_rewrite_for_multiple_consumers=*/true,
+          oper_size_threshold);
+  if (debug_options.xla_gpu_experimental_enable_windowed_einsum_cost_model() &&
+      std::holds_alternative<se::CudaComputeCapability>(compute_capability)) {
+    partitioner_options.computation_time_in_ms =
+        [device_description](const HloInstruction* hlo) {
+          return EstimateComputationTimeInMs(device_description, hlo);
+        };
+    partitioner_options.communication_time_in_ms =
+        [cuda_compute_capability =
+             std::get<se::CudaComputeCapability>(compute_capability),
+         num_partitions,
+         perf_table_times = CollectivePerfTableTimes::Create(
+             debug_options.xla_gpu_experimental_collective_perf_table_path(),
+             device_description)](
+            int64_t bytes, absl::Span<const ReplicaGroup> device_groups) {
+          if (perf_table_times != nullptr) {
+            std::optional<double> time_in_ms =
+                perf_table_times->AllGatherTimeInMs(num_partitions, bytes,
+                                                    device_groups);
+            if (time_in_ms.has_value()) {
+              return *time_in_ms;
+            }
+          }
+          return EstimateCommunicationTimeInMs(
+              cuda_compute_capability, num_partitions, bytes, device_groups);
+        };
   }
   spmd_pipeline.AddPass<spmd::StatefulRngSpmdPartitioner>(
       num_partitions, hlo_module->config().replica_count(),
-      hlo_module->config()
-          .debug_options()
-          .xla_gpu_threshold_for_windowed_einsum_mib(),
-      hlo_module->config()
-          .debug_options()
-          .xla_gpu_multi_streamed_windowed_einsum(),
-      /*skip_checking_windowed_einsum_users=*/true,
-      /*disable_ag_rewrite_for_multiple_consumers=*/true, oper_size_threshold);
+      std::move(partitioner_options));
   spmd_pipeline.AddPass<CollectivePermuteMotion>();
 }
 
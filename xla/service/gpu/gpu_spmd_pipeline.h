@@ -22,15 +22,17 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_module.h"
 #include "xla/hlo/pass/hlo_pass_pipeline.h"
 #include "xla/hlo/transforms/simplifiers/algebraic_simplifier.h"
+#include "xla/stream_executor/device_description.h"
 
 namespace xla {
 namespace gpu {
 
-// Adds SPMD passes to the pipeline.
+// Adds SPMD passes to the pipeline. `device_description` is used by the cost
+// model behind xla_gpu_experimental_enable_windowed_einsum_cost_model.
 void AddSPMDPasses(
     const HloModule* hlo_module,
     const AlgebraicSimplifierOptions& layout_insensitive_algsimp_opts,
-    const se::GpuComputeCapability& compute_capability,
+    const se::DeviceDescription& device_description,
     HloPassPipeline& spmd_pipeline,
     std::optional<const absl::FunctionRef<void(HloPassPipeline&)>>
         auto_sharding_func = std::nullopt);
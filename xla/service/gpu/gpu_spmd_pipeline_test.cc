@@ -21,19 +21,24 @@ limitations under the License.
 #include <string>
 
 #include <gtest/gtest.h>
+#include "absl/algorithm/container.h"
 #include "absl/log/check.h"
 #include "absl/log/log.h"
 #include "xla/client/executable_build_options.h"
 #include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/ir/hlo_opcode.h"
 #include "xla/hlo/parser/hlo_parser.h"
 #include "xla/hlo/pass/hlo_pass_pipeline.h"
 #include "xla/hlo/transforms/simplifiers/algebraic_simplifier.h"
+#include "xla/service/gpu/gpu_device_info_for_tests.h"
 #include "xla/service/hlo_module_config.h"
 #include "xla/service/spmd/shardy/constants.h"
 #include "xla/shape_util.h"
 #include "xla/stream_executor/device_description.h"
 #include "xla/tests/hlo_test_base.h"
 #include "xla/util.h"
+#include "xla/xla.pb.h"
 #include "tsl/platform/errors.h"
 #include "tsl/platform/statusor.h"
 
@@ -45,9 +50,13 @@ class GpuSpmdPartitioningTest : public HloTestBase,
                                 public ::testing::WithParamInterface<bool> {
  public:
   absl::StatusOr<std::unique_ptr<HloModule>> PartitionComputation(
-      const char* hlo_module, int64_t num_devices) {
+      const char* hlo_module, int64_t num_devices,
+      std::optional<DebugOptions> debug_options = std::nullopt) {
     HloModuleConfig config = GetModuleConfigForTest(
         /*replica_count=*/1, /*num_partitions=*/num_devices);
+    if (debug_options.has_value()) {
+      config.set_debug_options(*debug_options);
+    }
     config.set_num_partitions(num_devices);
     config.set_use_shardy_partitioner(UseShardy());
     TF_ASSIGN_OR_RETURN(auto module,
@@ -59,9 +68,9 @@ class GpuSpmdPartitioningTest : public HloTestBase,
     }
 
     HloPassPipeline spmd_pipeline("spmd-partitioner");
-    se::CudaComputeCapability ampere(8, 0);
+    se::DeviceDescription ampere =
+        TestGpuDeviceInfo::RTXA6000DeviceInfo(se::CudaComputeCapability(8, 0));
     AlgebraicSimplifierOptions alg_simplifier_options;
-    // Ampere Core_count from tensorflow/compiler/xla/tools/hlo_opt/gpu_specs/.
     AddSPMDPasses(module.get(), alg_simplifier_options, ampere, spmd_pipeline,
                   std::nullopt);
     TF_RETURN_IF_ERROR(spmd_pipeline.Run(module.get()).status());
@@ -102,6 +111,47 @@ TEST_P(GpuSpmdPartitioningTest, DotWithEntryComputationLayout) {
             ShapeUtil::MakeShapeWithDenseLayout(F32, {8, 24}, {1, 0}));
 }
 
+constexpr const char* kAllGatherDotHloModule = R"(
+  HloModule module
+
+  ENTRY main {
+    %p0 = f32[64,1024] parameter(0), sharding={devices=[2,1]<=[2]}
+    %p1 = f32[1024,1024] parameter(1), sharding={devices=[1,2]<=[2]}
+    ROOT %dot = f32[64,1024] dot(%p0, %p1), lhs_contracting_dims={1},
+     rhs_contracting_dims={0}, sharding={devices=[2,1]<=[2]}
+  })";
+
+bool HasWhileLoop(const HloModule& module) {
+  return absl::c_any_of(module.entry_computation()->instructions(),
+                        HloPredicateIsOp<HloOpcode::kWhile>);
+}
+
+TEST_P(GpuSpmdPartitioningTest, UsesWindowedEinsumAboveThreshold) {
+  DebugOptions debug_options = GetDebugOptionsForTest();
+  debug_options.set_xla_gpu_threshold_for_windowed_einsum_mib(0);
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto module, PartitionComputation(kAllGatherDotHloModule,
+                                        /*num_devices=*/2, debug_options));
+
+  EXPECT_TRUE(HasWhileLoop(*module));
+}
+
+TEST_P(GpuSpmdPartitioningTest, CostModelSkipsUnprofitableWindowedEinsum) {
+  // With two partitions, the prologue of the windowed einsum loop exposes as
+  // much communication as the all-gather it replaces.
+  DebugOptions debug_options = GetDebugOptionsForTest();
+  debug_options.set_xla_gpu_threshold_for_windowed_einsum_mib(0);
+  debug_options.set_xla_gpu_experimental_enable_windowed_einsum_cost_model(
+      true);
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto module, PartitionComputation(kAllGatherDotHloModule,
+                                        /*num_devices=*/2, debug_options));
+
+  EXPECT_FALSE(HasWhileLoop(*module));
+}
+
 std::string TestParamToString(
     const ::testing::TestParamInfo<bool>& param_info) {
   return param_info.param ? "Shardy" : "GSPMD";
@@ -15,7 +15,9 @@ limitations under the License.
 
 #include "xla/service/gpu/infeed_manager.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <limits>
 #include <memory>
 #include <utility>
@@ -24,12 +26,18 @@ limitations under the License.
 #include "absl/log/log.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
 #include "xla/literal.h"
 #include "xla/service/gpu/xfeed_queue.h"
 #include "xla/shape.h"
 #include "xla/shape_tree.h"
 #include "xla/shape_util.h"
 #include "xla/stream_executor/device_memory_handle.h"
+#include "xla/stream_executor/event.h"
+#include "xla/stream_executor/memory_allocation.h"
+#include "xla/stream_executor/stream.h"
 #include "xla/util.h"
 #include "tsl/platform/errors.h"
 #include "tsl/platform/statusor.h"
@@ -39,12 +47,87 @@ namespace gpu {
 
 constexpr int kMaxInfeedsInFlight = 8;
 
+// Alignment of the leaves of a literal in a staging buffer.
+constexpr int64_t kStagingAlignment = 64;
+
 InfeedManager::InfeedManager(se::StreamExecutor* executor)
     : BlockingXfeedQueue(/*max_pending_xfeeds=*/kMaxInfeedsInFlight),
       stream_(executor->CreateStream().value()) {
   stream_->SetName("Infeed manager");
 }
 
+InfeedManager::~InfeedManager() {
+  // Staging buffers may still be read by pending copies, and released buffers
+  // by the streams of running executables.
+  absl::Status status = stream_->BlockHostUntilDone();
+  if (!status.ok()) {
+    LOG(ERROR) << "Failed to complete infeed transfers: " << status;
+  }
+  absl::MutexLock lock(&released_mu_);
+  for (ReleasedBuffers& released : released_) {
+    while (released.done->PollForStatus() == se::Event::Status::kPending) {
+      absl::SleepFor(absl::Milliseconds(1));
+    }
+  }
+}
+
+absl::StatusOr<InfeedManager::StagingBuffer*>
+InfeedManager::AcquireStagingBuffer(int64_t size) {
+  if (size == 0) {
+    return nullptr;
+  }
+  if (staging_buffers_.empty()) {
+    staging_buffers_.resize(kMaxInfeedsInFlight);
+  }
+  StagingBuffer& staging = staging_buffers_[next_staging_buffer_];
+  next_staging_buffer_ = (next_staging_buffer_ + 1) % staging_buffers_.size();
+
+  // The previous copy from this buffer must be complete before we overwrite
+  // it. This only blocks if all staging buffers have pending copies.
+  if (staging.copied != nullptr) {
+    if (staging.copied->PollForStatus() != se::Event::Status::kComplete) {
+      TF_RETURN_IF_ERROR(stream()->BlockHostUntilDone());
+    }
+    staging.copied.reset();
+  }
+
+  if (staging.memory == nullptr || staging.memory->size() < static_cast<uint64_t>(size)) {
+    staging.memory.reset();
+    absl::StatusOr<std::unique_ptr<se::MemoryAllocation>> memory =
+        stream()->parent()->HostMemoryAllocate(size);
+    if (!memory.ok() || *memory == nullptr) {
+      VLOG(1) << "Failed to allocate " << size
+              << " bytes of pinned memory for infeed, copying from pageable "
+                 "memory instead";
+      return nullptr;
+    }
+    staging.memory = *std::move(memory);
+  }
+  return &staging;
+}
+
+void InfeedManager::FreeReleasedBuffers() {
+  absl::MutexLock lock(&released_mu_);
+  released_.erase(
+      std::remove_if(released_.begin(), released_.end(),
+                     [](const ReleasedBuffers& released) {
+                       return released.done->PollForStatus() !=
+                              se::Event::Status::kPending;
+                     }),
+      released_.end());
+}
+
+absl::Status InfeedManager::ReleaseAfter(
+    se::Stream* stream, ShapeTree<se::DeviceMemoryHandle> buffers) {
+  FreeReleasedBuffers();
+  TF_ASSIGN_OR_RETURN(std::unique_ptr<se::Event> done,
+                      stream->parent()->CreateEvent());
+  TF_RETURN_IF_ERROR(stream->RecordEvent(done.get()));
+  absl::MutexLock lock(&released_mu_);
+  released_.push_back(ReleasedBuffers{std::move(buffers), std::move(done)});
+  return absl::OkStatus();
+}
+
 static absl::StatusOr<se::DeviceMemoryHandle> CopyBufferToDevice(
     se::Stream* stream, int64_t size, const void* source) {
   if (size > std::numeric_limits<int32_t>::max()) {
@@ -71,29 +154,59 @@ absl::Status InfeedManager::TransferLiteralToInfeed(
           << ShapeUtil::HumanString(literal_shape);
 
   BlockUntilEnqueueSlotAvailable();
+  FreeReleasedBuffers();
 
-  // For a tuple, we transfer each of its elements to the device and enqueue the
-  // resulting destination device addresses with the infeed manager.
+  absl::MutexLock lock(&transfer_mu_);
+
+  // The whole literal is staged through a single pinned buffer.
   ShapeTree<se::DeviceMemoryHandle> buffer_tree(literal_shape);
+  int64_t staging_size = 0;
   for (auto& leaf : buffer_tree.leaves()) {
     const Shape& sub_shape = ShapeUtil::GetSubshape(literal_shape, leaf.first);
     CHECK(sub_shape.IsArray()) << ShapeUtil::HumanStringWithLayout(sub_shape);
-    TF_ASSIGN_OR_RETURN(
-        leaf.second,
-        CopyBufferToDevice(stream(), ShapeUtil::ByteSizeOf(sub_shape),
-                           literal.untyped_data(leaf.first)));
+    staging_size +=
+        RoundUpTo<int64_t>(ShapeUtil::ByteSizeOf(sub_shape), kStagingAlignment);
+  }
+  TF_ASSIGN_OR_RETURN(StagingBuffer * staging,
+                      AcquireStagingBuffer(staging_size));
+
+  // For a tuple, we transfer each of its elements to the device and enqueue the
+  // resulting destination device addresses with the infeed manager.
+  int64_t staging_offset = 0;
+  for (auto& leaf : buffer_tree.leaves()) {
+    const Shape& sub_shape = ShapeUtil::GetSubshape(literal_shape, leaf.first);
+    const int64_t size = ShapeUtil::ByteSizeOf(sub_shape);
+    const void* source = literal.untyped_data(leaf.first);
+    if (staging != nullptr) {
+      void* staged =
+          static_cast<char*>(staging->memory->opaque()) + staging_offset;
+      std::memcpy(staged, source, size);
+      source = staged;
+      staging_offset += RoundUpTo<int64_t>(size, kStagingAlignment);
+    }
+    TF_ASSIGN_OR_RETURN(leaf.second,
+                        CopyBufferToDevice(stream(), size, source));
   }
 
-  // TODO(b/30467474): Since this stream is shared across different infeed
-  // requests, blocking on the stream might be heavy-handed. Figure out if
-  // finer-grained acknowledgement is possible.
-  absl::Status block_status = stream()->BlockHostUntilDone();
-  if (!block_status.ok()) {
-    return Internal("Failed to complete data transfer on stream %p: %s",
-                    stream(), block_status.message());
+  if (staging == nullptr) {
+    // The copies read the literal, which the caller owns, so we must wait for
+    // them to complete.
+    absl::Status block_status = stream()->BlockHostUntilDone();
+    if (!block_status.ok()) {
+      return Internal("Failed to complete data transfer on stream %p: %s",
+                      stream(), block_status.message());
+    }
+    EnqueueDestination(InfeedBuffers{std::move(buffer_tree), nullptr});
+    return absl::OkStatus();
   }
 
-  EnqueueDestination(std::move(buffer_tree));
+  // Copies from pinned memory are asynchronous, and the infeed thunk waits for
+  // them on the device.
+  TF_ASSIGN_OR_RETURN(std::shared_ptr<se::Event> copied,
+                      executor->CreateEvent());
+  TF_RETURN_IF_ERROR(stream()->RecordEvent(copied.get()));
+  staging->copied = copied;
+  EnqueueDestination(InfeedBuffers{std::move(buffer_tree), std::move(copied)});
   return absl::OkStatus();
 }
 
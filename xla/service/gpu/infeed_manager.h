@@ -20,13 +20,21 @@ limitations under the License.
 #ifndef XLA_SERVICE_GPU_INFEED_MANAGER_H_
 #define XLA_SERVICE_GPU_INFEED_MANAGER_H_
 
+#include <cstdint>
 #include <memory>
+#include <vector>
 
+#include "absl/base/thread_annotations.h"
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
 #include "xla/literal.h"
 #include "xla/service/gpu/xfeed_queue.h"
 #include "xla/shape_tree.h"
 #include "xla/stream_executor/device_memory_handle.h"
+#include "xla/stream_executor/event.h"
+#include "xla/stream_executor/memory_allocation.h"
+#include "xla/stream_executor/stream.h"
 #include "xla/stream_executor/stream_executor.h"
 
 namespace xla {
@@ -44,20 +52,68 @@ namespace gpu {
 // memory. Potential solution is to pre-allocate a fixed amount of
 // memory and block when that memory is full.
 
+// The device buffers of one infeed, and the event recorded on the infeed
+// stream once they are filled. Consumers must wait for `ready` before reading
+// the buffers.
+struct InfeedBuffers {
+  ShapeTree<se::DeviceMemoryHandle> buffers;
+  std::shared_ptr<se::Event> ready;
+};
+
 // Client-side class used to enqueue infeed buffers.
-class InfeedManager
-    : public BlockingXfeedQueue<ShapeTree<se::DeviceMemoryHandle>> {
+//
+// Literals are staged through a ring of pinned host buffers, one per infeed in
+// flight, so that the host to device copies are asynchronous and neither the
+// client nor the infeed thunk has to block the host on a stream.
+class InfeedManager : public BlockingXfeedQueue<InfeedBuffers> {
  public:
   explicit InfeedManager(se::StreamExecutor* executor);
+  ~InfeedManager() override;
 
   absl::Status TransferLiteralToInfeed(se::StreamExecutor* executor,
                                        const LiteralSlice& literal);
 
+  // Releases the device buffers of a dequeued infeed once all the work
+  // currently enqueued on `stream`, which reads them, is done.
+  absl::Status ReleaseAfter(se::Stream* stream,
+                            ShapeTree<se::DeviceMemoryHandle> buffers);
+
  private:
+  // A pinned host buffer that literals are copied into before being copied to
+  // the device. It can be reused once `copied` is complete.
+  struct StagingBuffer {
+    std::unique_ptr<se::MemoryAllocation> memory;
+    std::shared_ptr<se::Event> copied;
+  };
+
+  // Device buffers that are freed once `done` is complete.
+  struct ReleasedBuffers {
+    ShapeTree<se::DeviceMemoryHandle> buffers;
+    std::unique_ptr<se::Event> done;
+  };
+
   se::Stream* stream() const { return stream_.get(); }
 
+  // Returns a staging buffer of at least `size` bytes that is not in use by
+  // any pending copy, or nullptr if pinned memory can't be allocated.
+  absl::StatusOr<StagingBuffer*> AcquireStagingBuffer(int64_t size)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(transfer_mu_);
+
+  // Frees the released device buffers that are not in use anymore.
+  void FreeReleasedBuffers();
+
   // Stream used to enqueue infeed device copies.
   std::unique_ptr<se::Stream> stream_;
+
+  // Serializes the transfers, which share the staging buffers and the stream.
+  absl::Mutex transfer_mu_;
+
+  // Staging buffers used in a round-robin fashion.
+  std::vector<StagingBuffer> staging_buffers_ ABSL_GUARDED_BY(transfer_mu_);
+  int64_t next_staging_buffer_ ABSL_GUARDED_BY(transfer_mu_) = 0;
+
+  absl::Mutex released_mu_;
+  std::vector<ReleasedBuffers> released_ ABSL_GUARDED_BY(released_mu_);
 };
 
 }  // namespace gpu
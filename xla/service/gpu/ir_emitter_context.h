@@ -34,6 +34,7 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_module.h"
 #include "xla/service/buffer_assignment.h"
 #include "xla/service/gpu/execution_stream_assignment.h"
+#include "xla/service/gpu/executable.pb.h"
 #include "xla/service/gpu/gpu_executable.h"
 #include "xla/service/gpu/ir_emission_utils.h"
 #include "xla/service/gpu/kernel_reuse_cache.h"
@@ -132,6 +133,16 @@ class IrEmitterContext {
 
   bool emit_kernels() const { return emit_kernels_; }
 
+  // Launch parameters of the kernels of an already compiled executable, keyed
+  // by kernel name. Set when loading thunks from a compilation result, so that
+  // emitters can skip generating kernels just to get their parameters.
+  const CompilationCacheProto* compiled_kernels() const {
+    return compiled_kernels_;
+  }
+  void set_compiled_kernels(const CompilationCacheProto* compiled_kernels) {
+    compiled_kernels_ = compiled_kernels;
+  }
+
  private:
   const HloModule* hlo_module_;
   const BufferAssignment* buffer_assignment_;
@@ -149,6 +160,7 @@ class IrEmitterContext {
 
   // We should not emit kernels when loading thunks from a compilation result.
   const bool emit_kernels_;
+  const CompilationCacheProto* compiled_kernels_ = nullptr;
 };
 
 }  // namespace gpu
@@ -573,10 +573,15 @@ absl::Status IrEmitterUnnested::EmitCommandBufferThunk(
           ? CommandBufferCmdSequence::SynchronizationMode::kAutomatic
           : CommandBufferCmdSequence::SynchronizationMode::kSerialize;
 
+  ConvertToCommandsOptions options;
+  options.synchronization_mode = synchronization_mode;
+  options.max_unrolled_loop_trip_count =
+      ir_emitter_context_->debug_options()
+          .xla_gpu_graph_max_unrolled_loop_trip_count();
+
   TF_ASSIGN_OR_RETURN(
       CommandBufferCmdSequence cmd_sequence,
-      ConvertToCommands(thunk_sequence->thunks(),
-                        ConvertToCommandsOptions{synchronization_mode}));
+      ConvertToCommands(thunk_sequence->thunks(), options));
 
   AddThunkToThunkSequence(std::make_unique<CommandBufferThunk>(
       std::move(cmd_sequence), Thunk::ThunkInfo::WithProfileAnnotation(instr),
@@ -2647,6 +2652,14 @@ absl::Status IrEmitterUnnested::EmitHloInstruction(
                 TF_RETURN_IF_ERROR(
                     EmitCollectiveAsyncDone(Thunk::kReduceScatterDone, instr));
                 break;
+              case HloOpcode::kAllReduce:
+                TF_RETURN_IF_ERROR(
+                    EmitCollectiveAsyncDone(Thunk::kAllReduceDone, instr));
+                break;
+              case HloOpcode::kAllGather:
+                TF_RETURN_IF_ERROR(
+                    EmitCollectiveAsyncDone(Thunk::kAllGatherDone, instr));
+                break;
               default:
                 return absl::InternalError(absl::StrFormat(
                     "Unhandled collective in dynamic slice fusion "
@@ -17,6 +17,7 @@ limitations under the License.
 #include <functional>
 #include <string>
 #include <utility>
+#include <variant>
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/status/status.h"
@@ -31,11 +32,14 @@ limitations under the License.
 #include "xla/service/gpu/kernel_arguments.h"
 #include "xla/service/gpu/launch_dimensions.h"
 #include "xla/status_macros.h"
+#include "xla/stream_executor/device_description.h"
 #include "xla/stream_executor/launch_dim.h"
 #include "xla/util.h"
+#include "xla/xla.pb.h"
 #include "tsl/platform/env.h"
 #include "tsl/platform/errors.h"
 #include "tsl/platform/logging.h"
+#include "tsl/platform/path.h"
 
 namespace xla {
 namespace gpu {
@@ -172,15 +176,44 @@ absl::Status UpdateDiskKernelCache(
     ++stored_kernel_count;
   }
   if (stored_kernel_count > 0) {
-    TF_RETURN_IF_ERROR(tsl::WriteStringToFile(tsl::Env::Default(),
-                                              std::string(path),
-                                              disk_cache.SerializeAsString()));
+    // The cache file can be shared by concurrently compiling processes. Write
+    // to a temporary file and rename it to the final file to never expose
+    // partially written cache files to readers.
+    tsl::Env* env = tsl::Env::Default();
+    std::string dir(tsl::io::Dirname(path));
+    if (!dir.empty() && !env->IsDirectory(dir).ok()) {
+      TF_RETURN_IF_ERROR(env->RecursivelyCreateDir(dir));
+    }
+    std::string temp_path = absl::StrCat(path, ".tmp.", env->NowNanos());
+    TF_RETURN_IF_ERROR(
+        tsl::WriteStringToFile(env, temp_path, disk_cache.SerializeAsString()));
+    TF_RETURN_IF_ERROR(env->RenameFile(temp_path, std::string(path)));
     VLOG(2) << "Stored " << stored_kernel_count << " / "
             << binaries_to_cache.size() << " kernels in the cache file.";
   }
   return absl::OkStatus();
 }
 
+std::string GetKernelCacheFilePath(
+    const DebugOptions& debug_options,
+    const se::DeviceDescription& device_description) {
+  if (!debug_options.xla_gpu_kernel_cache_file().empty()) {
+    return debug_options.xla_gpu_kernel_cache_file();
+  }
+  if (debug_options.xla_gpu_kernel_cache_dir().empty()) {
+    return "";
+  }
+  // Compiled kernels are only compatible with the compute capability they were
+  // compiled for, so processes running on different devices use separate
+  // cache files.
+  std::string compute_capability = std::visit(
+      [](const auto& cc) { return cc.ToString(); },
+      device_description.gpu_compute_capability());
+  return tsl::io::JoinPath(
+      debug_options.xla_gpu_kernel_cache_dir(),
+      absl::StrCat("kernel_cache_", compute_capability, ".pb"));
+}
+
 std::pair<absl::StatusOr<const KernelReuseCache::Entry*>, bool>
 KernelReuseCache::GetWithStatus(
     const HloComputation* fused_computation,
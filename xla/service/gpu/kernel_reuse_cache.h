@@ -20,6 +20,7 @@ limitations under the License.
 #include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
@@ -31,8 +32,10 @@ limitations under the License.
 #include "xla/service/gpu/executable.pb.h"
 #include "xla/service/gpu/kernel_arguments.h"
 #include "xla/service/gpu/launch_dimensions.h"
+#include "xla/stream_executor/device_description.h"
 #include "xla/stream_executor/gpu/tma_metadata.h"
 #include "xla/stream_executor/launch_dim.h"
+#include "xla/xla.pb.h"
 
 namespace xla {
 namespace gpu {
@@ -104,6 +107,14 @@ absl::Status UpdateDiskKernelCache(
     const CompilationCacheProto& current_cache,
     absl::Span<const KernelReuseCache::NamedBinary> binaries_to_cache);
 
+// Returns the path of the persistent kernel cache file for the given device:
+// xla_gpu_kernel_cache_file if set, otherwise a per compute capability file in
+// xla_gpu_kernel_cache_dir. Returns an empty string if kernel caching is
+// disabled.
+std::string GetKernelCacheFilePath(
+    const DebugOptions& debug_options,
+    const se::DeviceDescription& device_description);
+
 // Calculates the fingerprint of a (fused_computation, kernel_arguments,
 // discriminator) tuple.
 //
@@ -14,11 +14,19 @@ limitations under the License.
 ==============================================================================*/
 #include "xla/service/gpu/kernel_reuse_cache.h"
 
+#include <string>
+#include <vector>
+
 #include <gtest/gtest.h>
 #include "absl/log/check.h"
 #include "xla/service/gpu/executable.pb.h"
+#include "xla/service/gpu/gpu_device_info_for_tests.h"
+#include "xla/stream_executor/cuda/cuda_compute_capability.h"
+#include "xla/stream_executor/device_description.h"
 #include "xla/tsl/lib/core/status_test_util.h"
+#include "xla/xla.pb.h"
 #include "tsl/platform/env.h"
+#include "tsl/platform/path.h"
 
 namespace xla {
 namespace gpu {
@@ -77,6 +85,40 @@ TEST_F(KernelReuseTest, UpdatingDiskKernelCacheWorks) {
   EXPECT_EQ(proto.entries_size(), 2);
 }
 
+TEST_F(KernelReuseTest, KernelCacheFilePath) {
+  se::DeviceDescription device_info = TestGpuDeviceInfo::RTXA6000DeviceInfo(
+      se::CudaComputeCapability(9, 0));
+  DebugOptions debug_options;
+  EXPECT_EQ(GetKernelCacheFilePath(debug_options, device_info), "");
+
+  debug_options.set_xla_gpu_kernel_cache_dir("/tmp/kernels");
+  EXPECT_EQ(GetKernelCacheFilePath(debug_options, device_info),
+            "/tmp/kernels/kernel_cache_9.0.pb");
+
+  // Explicitly configured cache file takes precedence over the directory.
+  debug_options.set_xla_gpu_kernel_cache_file("/tmp/kernels.pb");
+  EXPECT_EQ(GetKernelCacheFilePath(debug_options, device_info),
+            "/tmp/kernels.pb");
+}
+
+TEST_F(KernelReuseTest, UpdatingDiskKernelCacheCreatesDirectory) {
+  std::string cache_dir;
+  CHECK(tsl::Env::Default()->LocalTempFilename(&cache_dir));
+  std::string cache_file_path = tsl::io::JoinPath(cache_dir, "kernels.pb");
+
+  KernelReuseCache cache;
+  auto [result, was_cached] = cache.GetWithStatus("fingerprint", []() {
+    return KernelReuseCache::Entry{.kernel_name = "k1"};
+  });
+  TF_EXPECT_OK(UpdateDiskKernelCache(cache_file_path, /*do_append=*/false,
+                                     cache.Export(),
+                                     {{.name = "k1", .binary = {5, 6}}}));
+
+  std::vector<std::string> children;
+  TF_EXPECT_OK(tsl::Env::Default()->GetChildren(cache_dir, &children));
+  EXPECT_EQ(children, std::vector<std::string>{"kernels.pb"});
+}
+
 }  // namespace
 }  // namespace gpu
 }  // namespace xla
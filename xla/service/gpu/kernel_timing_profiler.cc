@@ -0,0 +1,147 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/service/gpu/kernel_timing_profiler.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "xla/backends/gpu/runtime/annotation.h"
+#include "xla/backends/gpu/runtime/sequential_thunk.h"
+#include "xla/backends/gpu/runtime/thunk.h"
+#include "xla/stream_executor/event_based_timer.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/errors.h"
+#include "xla/tsl/platform/statusor.h"
+#include "tsl/profiler/lib/scoped_annotation.h"
+#include "tsl/profiler/protobuf/profiled_instructions.pb.h"
+
+namespace xla::gpu {
+namespace {
+
+// Returns whether `thunk` launches device work on the main stream that
+// completes before the next thunk starts, so that its execution time can be
+// measured with events on the main stream.
+bool IsTimedThunk(const Thunk& thunk) {
+  if (thunk.execution_stream_id() != Thunk::kDefaultExecutionStreamId) {
+    return false;
+  }
+  switch (thunk.kind()) {
+    case Thunk::kCholesky:
+    case Thunk::kConvolution:
+    case Thunk::kCuDnn:
+    case Thunk::kCubSort:
+    case Thunk::kCublasLtMatmul:
+    case Thunk::kCustomKernel:
+    case Thunk::kFft:
+    case Thunk::kGemm:
+    case Thunk::kKernel:
+    case Thunk::kNorm:
+    case Thunk::kTriangularSolve:
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+KernelTimingProfiler::KernelTimingProfiler(int64_t sampling_interval,
+                                           std::string profile_path)
+    : sampling_interval_(std::max<int64_t>(sampling_interval, 1)),
+      profile_path_(std::move(profile_path)) {}
+
+bool KernelTimingProfiler::ShouldProfileExecution() {
+  return num_executions_.fetch_add(1) % sampling_interval_ == 0;
+}
+
+absl::Status KernelTimingProfiler::ExecuteAndProfile(
+    const SequentialThunk& thunk_sequence, const Thunk::ExecuteParams& params) {
+  std::vector<std::pair<absl::string_view, absl::Duration>> timings;
+  for (const std::unique_ptr<Thunk>& thunk : thunk_sequence.thunks()) {
+    std::optional<tsl::profiler::ScopedAnnotation> annotation =
+        GetKernelAnnotation(thunk->profile_annotation());
+    if (params.mock_collectives && thunk->IsCollective()) {
+      continue;
+    }
+    if (!IsTimedThunk(*thunk)) {
+      TF_RETURN_IF_ERROR(thunk->ExecuteOnStream(params));
+      continue;
+    }
+    TF_ASSIGN_OR_RETURN(
+        std::unique_ptr<se::EventBasedTimer> timer,
+        params.stream->CreateEventBasedTimer(/*use_delay_kernel=*/false));
+    TF_RETURN_IF_ERROR(thunk->ExecuteOnStream(params));
+    TF_ASSIGN_OR_RETURN(absl::Duration elapsed, timer->GetElapsedDuration());
+    timings.push_back({thunk->profile_annotation(), elapsed});
+  }
+
+  for (const auto& [name, duration] : timings) {
+    RecordTiming(name, duration);
+  }
+  VLOG(2) << "Sampled the execution times of " << timings.size()
+          << " thunks, writing the profile to " << profile_path_;
+  return WriteProfile();
+}
+
+void KernelTimingProfiler::RecordTiming(absl::string_view name,
+                                        absl::Duration duration) {
+  absl::MutexLock lock(&mu_);
+  Timing& timing = timings_[name];
+  timing.total += duration;
+  ++timing.count;
+}
+
+tensorflow::profiler::ProfiledInstructionsProto KernelTimingProfiler::ToProto()
+    const {
+  std::vector<std::pair<std::string, double>> costs;
+  {
+    absl::MutexLock lock(&mu_);
+    costs.reserve(timings_.size());
+    for (const auto& [name, timing] : timings_) {
+      costs.push_back(
+          {name, absl::ToDoubleMicroseconds(timing.total / timing.count)});
+    }
+  }
+  // Sort by name to produce a deterministic profile.
+  std::sort(costs.begin(), costs.end());
+
+  tensorflow::profiler::ProfiledInstructionsProto profile;
+  for (auto& [name, cost_us] : costs) {
+    auto* cost = profile.add_costs();
+    cost->set_name(std::move(name));
+    cost->set_cost_us(cost_us);
+  }
+  return profile;
+}
+
+absl::Status KernelTimingProfiler::WriteProfile() const {
+  tensorflow::profiler::ProfiledInstructionsProto profile = ToProto();
+  // Serialize concurrent writers of the same profile.
+  absl::MutexLock lock(&mu_);
+  return tsl::WriteTextProto(tsl::Env::Default(), profile_path_, profile);
+}
+
+}  // namespace xla::gpu
@@ -0,0 +1,79 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_SERVICE_GPU_KERNEL_TIMING_PROFILER_H_
+#define XLA_SERVICE_GPU_KERNEL_TIMING_PROFILER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "xla/backends/gpu/runtime/sequential_thunk.h"
+#include "xla/backends/gpu/runtime/thunk.h"
+#include "tsl/profiler/protobuf/profiled_instructions.pb.h"
+
+namespace xla::gpu {
+
+// Samples the execution times of the kernels of a GPU executable at runtime.
+//
+// Every `sampling_interval`-th execution runs the thunks one at a time and
+// times the ones that launch work on the main stream with events. The average
+// time of every instruction is written to `profile_path` as a
+// ProfiledInstructionsProto, which can be fed back to the profile guided
+// latency estimator via `xla_gpu_pgle_profile_file_or_directory_path`.
+class KernelTimingProfiler {
+ public:
+  KernelTimingProfiler(int64_t sampling_interval, std::string profile_path);
+
+  // Returns true for every `sampling_interval`-th call, starting with the
+  // first one.
+  bool ShouldProfileExecution();
+
+  // Executes `thunk_sequence`, records the timings of its thunks and writes
+  // the updated profile.
+  absl::Status ExecuteAndProfile(const SequentialThunk& thunk_sequence,
+                                 const Thunk::ExecuteParams& params);
+
+  // Adds a sampled execution time of the instruction called `name`.
+  void RecordTiming(absl::string_view name, absl::Duration duration);
+
+  // Returns the average execution time of every sampled instruction.
+  tensorflow::profiler::ProfiledInstructionsProto ToProto() const;
+
+  absl::Status WriteProfile() const;
+
+ private:
+  struct Timing {
+    absl::Duration total;
+    int64_t count = 0;
+  };
+
+  const int64_t sampling_interval_;
+  const std::string profile_path_;
+  std::atomic<int64_t> num_executions_{0};
+
+  mutable absl::Mutex mu_;
+  absl::flat_hash_map<std::string, Timing> timings_ ABSL_GUARDED_BY(mu_);
+};
+
+}  // namespace xla::gpu
+
+#endif  // XLA_SERVICE_GPU_KERNEL_TIMING_PROFILER_H_
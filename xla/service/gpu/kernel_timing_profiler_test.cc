@@ -0,0 +1,72 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/service/gpu/kernel_timing_profiler.h"
+
+#include <string>
+
+#include <gtest/gtest.h>
+#include "absl/time/time.h"
+#include "xla/tsl/lib/core/status_test_util.h"
+#include "xla/tsl/platform/env.h"
+#include "tsl/platform/path.h"
+#include "tsl/profiler/protobuf/profiled_instructions.pb.h"
+
+namespace xla::gpu {
+namespace {
+
+using ::tensorflow::profiler::ProfiledInstructionsProto;
+
+TEST(KernelTimingProfilerTest, ProfilesEveryNthExecution) {
+  KernelTimingProfiler profiler(/*sampling_interval=*/3, /*profile_path=*/"");
+
+  EXPECT_TRUE(profiler.ShouldProfileExecution());
+  EXPECT_FALSE(profiler.ShouldProfileExecution());
+  EXPECT_FALSE(profiler.ShouldProfileExecution());
+  EXPECT_TRUE(profiler.ShouldProfileExecution());
+}
+
+TEST(KernelTimingProfilerTest, AveragesSampledTimings) {
+  KernelTimingProfiler profiler(/*sampling_interval=*/1, /*profile_path=*/"");
+  profiler.RecordTiming("fusion.2", absl::Microseconds(5));
+  profiler.RecordTiming("fusion.1", absl::Microseconds(10));
+  profiler.RecordTiming("fusion.1", absl::Microseconds(20));
+
+  ProfiledInstructionsProto profile = profiler.ToProto();
+
+  ASSERT_EQ(profile.costs_size(), 2);
+  EXPECT_EQ(profile.costs(0).name(), "fusion.1");
+  EXPECT_DOUBLE_EQ(profile.costs(0).cost_us(), 15);
+  EXPECT_EQ(profile.costs(1).name(), "fusion.2");
+  EXPECT_DOUBLE_EQ(profile.costs(1).cost_us(), 5);
+}
+
+TEST(KernelTimingProfilerTest, WritesProfile) {
+  std::string profile_path =
+      tsl::io::JoinPath(::testing::TempDir(), "kernel_timings.pbtxt");
+  KernelTimingProfiler profiler(/*sampling_interval=*/1, profile_path);
+  profiler.RecordTiming("fusion", absl::Microseconds(7));
+
+  TF_ASSERT_OK(profiler.WriteProfile());
+
+  ProfiledInstructionsProto profile;
+  TF_ASSERT_OK(tsl::ReadTextProto(tsl::Env::Default(), profile_path, &profile));
+  ASSERT_EQ(profile.costs_size(), 1);
+  EXPECT_EQ(profile.costs(0).name(), "fusion");
+  EXPECT_DOUBLE_EQ(profile.costs(0).cost_us(), 7);
+}
+
+}  // namespace
+}  // namespace xla::gpu
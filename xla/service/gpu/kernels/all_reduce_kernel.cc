@@ -22,6 +22,7 @@ limitations under the License.
 #include "absl/algorithm/container.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
+#include "absl/strings/str_format.h"
 #include "absl/types/span.h"
 #include "xla/service/gpu/kernels/all_reduce_kernel_common.h"
 #include "xla/stream_executor/device_memory.h"
@@ -31,40 +32,80 @@ limitations under the License.
 #include "xla/stream_executor/stream_executor.h"
 #include "xla/stream_executor/typed_kernel_factory.h"
 #include "xla/tsl/platform/statusor.h"
+#include "xla/types.h"
 #include "xla/xla_data.pb.h"
 
 namespace xla::gpu {
 
 namespace {
 
+// Messages up to this size are latency bound, and reading the whole input of
+// every peer is cheaper than the extra synchronization of two-shot.
+constexpr int64_t kOneShotAllReduceMaxBytes = 64 * 1024;
+
+template <AllReduceStrategy kStrategy>
 void* GetKernel(PrimitiveType element_type) {
   switch (element_type) {
     case F32:
-      return GetAllReduceKernel<float>();
+      return GetAllReduceKernel<float, kStrategy>();
+    case BF16:
+      return GetAllReduceKernel<bfloat16, kStrategy>();
     default:
       return nullptr;
   }
 }
 
+void* GetKernel(PrimitiveType element_type, AllReduceStrategy strategy) {
+  return strategy == AllReduceStrategy::kOneShot
+             ? GetKernel<AllReduceStrategy::kOneShot>(element_type)
+             : GetKernel<AllReduceStrategy::kTwoShot>(element_type);
+}
+
 }  // namespace
 
-bool IsAllReduceKernelSupported(int64_t num_outputs,
+bool IsAllReduceKernelSupported(int64_t num_ranks,
                                 PrimitiveType element_type) {
-  return num_outputs <= kMaxNumAllReduceInputPtrs &&
-         GetKernel(element_type) != nullptr;
+  return num_ranks <= kMaxNumAllReduceInputPtrs &&
+         GetKernel(element_type, AllReduceStrategy::kOneShot) != nullptr;
+}
+
+AllReduceStrategy GetAllReduceStrategy(int64_t num_bytes, int64_t num_ranks) {
+  if (num_ranks <= 2 || num_bytes <= kOneShotAllReduceMaxBytes) {
+    return AllReduceStrategy::kOneShot;
+  }
+  return AllReduceStrategy::kTwoShot;
 }
 
 absl::Status RunAllReduceKernel(
     se::Stream* stream, PrimitiveType element_type,
     absl::Span<const se::DeviceMemoryBase> input_buffers,
-    se::DeviceMemoryBase output_buffer, int64_t num_inputs,
-    int64_t num_elements) {
+    absl::Span<const se::DeviceMemoryBase> output_buffers, int64_t rank,
+    int64_t num_elements, AllReduceStrategy strategy) {
   if (input_buffers.size() > kMaxNumAllReduceInputPtrs) {
     return absl::InvalidArgumentError(
         "Number of input pointers exceeds the maximum supported number of "
         "input pointers.");
   }
 
+  if (input_buffers.size() != output_buffers.size()) {
+    return absl::InvalidArgumentError(
+        "Number of input and output pointers must be equal to the number of "
+        "ranks.");
+  }
+
+  int64_t num_ranks = input_buffers.size();
+  if (rank < 0 || rank >= num_ranks) {
+    return absl::InvalidArgumentError(
+        absl::StrFormat("Rank %d is out of range [0, %d).", rank, num_ranks));
+  }
+
+  void* kernel_symbol = GetKernel(element_type, strategy);
+  if (kernel_symbol == nullptr) {
+    return absl::InvalidArgumentError(
+        absl::StrFormat("Unsupported all-reduce kernel element type: %s",
+                        PrimitiveType_Name(element_type)));
+  }
+
   se::StreamExecutor* executor = stream->parent();
 
   // TODO(b/383125489): Fine tune the block and thread dimensions.
@@ -73,19 +114,28 @@ absl::Status RunAllReduceKernel(
 
   TF_ASSIGN_OR_RETURN(
       auto kernel,
-      (se::TypedKernelFactory<std::array<void*, kMaxNumAllReduceInputPtrs>,
-                              se::DeviceMemoryBase, int64_t,
-                              int64_t>::Create(executor, "one_shot_all_reduce",
-                                               GetKernel(element_type))));
+      (se::TypedKernelFactory<
+          std::array<void*, kMaxNumAllReduceInputPtrs>,
+          std::array<void*, kMaxNumAllReduceInputPtrs>, int64_t, int64_t,
+          int64_t>::Create(executor,
+                           strategy == AllReduceStrategy::kOneShot
+                               ? "one_shot_all_reduce"
+                               : "two_shot_all_reduce",
+                           kernel_symbol)));
 
   std::array<void*, kMaxNumAllReduceInputPtrs> input_ptrs;
   absl::c_transform(
       input_buffers, input_ptrs.begin(),
       [](se::DeviceMemoryBase buffer) { return buffer.opaque(); });
 
+  std::array<void*, kMaxNumAllReduceInputPtrs> output_ptrs;
+  absl::c_transform(
+      output_buffers, output_ptrs.begin(),
+      [](se::DeviceMemoryBase buffer) { return buffer.opaque(); });
+
   return kernel.Launch(se::ThreadDim(kThreads, 1, 1),
                        se::BlockDim(kBlocks, 1, 1), stream, input_ptrs,
-                       output_buffer, num_inputs, num_elements);
+                       output_ptrs, rank, num_ranks, num_elements);
 }
 
 }  // namespace xla::gpu
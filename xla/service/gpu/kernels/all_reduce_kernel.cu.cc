@@ -17,46 +17,88 @@ limitations under the License.
 #include <cstdint>
 
 #include "xla/service/gpu/kernels/all_reduce_kernel_common.h"
+#include "xla/types.h"
 
 namespace xla::gpu {
 namespace {
 
 template <typename T>
+__device__ __forceinline__ float LoadAndSum(
+    const std::array<void* __restrict__, kMaxNumAllReduceInputPtrs>&
+        input_ptrs,
+    int64_t num_inputs, int64_t index) {
+  // Accumulate in f32 so that bf16 inputs do not lose precision between the
+  // partial sums.
+  float sum = 0;
+
+#pragma unroll
+  for (int j = 0; j < kMaxNumAllReduceInputPtrs; ++j) {
+    if (j >= num_inputs) break;
+
+    // TODO(b/383125489): Add vectorization.
+    T* input_ptr =
+        reinterpret_cast<  // REINTERPRET_CAST_OK=tsl::safe_reinterpret_cast
+                           // doesn't work with __restrict__.
+            T* __restrict__>(input_ptrs[j]);
+    sum += static_cast<float>(input_ptr[index]);
+  }
+
+  return sum;
+}
+
+template <typename T, AllReduceStrategy kStrategy>
 __global__ void AllReduceKernel(
     std::array<void* __restrict__, kMaxNumAllReduceInputPtrs> input_ptrs,
-    T* __restrict__ output_ptr, int64_t num_inputs, int64_t num_elements) {
+    std::array<void* __restrict__, kMaxNumAllReduceInputPtrs> output_ptrs,
+    int64_t rank, int64_t num_ranks, int64_t num_elements) {
   int64_t offset = blockIdx.x * blockDim.x + threadIdx.x;
   int64_t stride = blockDim.x * gridDim.x;
 
-  for (int i = offset; i < num_elements; i += stride) {
-    T sum = 0;
+  if constexpr (kStrategy == AllReduceStrategy::kOneShot) {
+    T* output_ptr =
+        reinterpret_cast<  // REINTERPRET_CAST_OK=tsl::safe_reinterpret_cast
+                           // doesn't work with __restrict__.
+            T* __restrict__>(output_ptrs[rank]);
 
-#pragma unroll
-    for (int j = 0; j < kMaxNumAllReduceInputPtrs; ++j) {
-      if (j >= num_inputs) break;
-
-      // TODO(b/383125489): Add vectorization.
-      T* input_ptr =
-          reinterpret_cast<  // REINTERPRET_CAST_OK=tsl::safe_reinterpret_cast
-                             // doesn't work with __restrict__.
-              T* __restrict__>(input_ptrs[j]);
-      sum += input_ptr[i];
+    for (int64_t i = offset; i < num_elements; i += stride) {
+      output_ptr[i] = static_cast<T>(LoadAndSum<T>(input_ptrs, num_ranks, i));
     }
+  } else {
+    // Reduce the slice owned by this rank and broadcast it to all peers.
+    int64_t slice_size = (num_elements + num_ranks - 1) / num_ranks;
+    int64_t slice_begin = rank * slice_size;
+    int64_t slice_end = min(slice_begin + slice_size, num_elements);
+
+    for (int64_t i = slice_begin + offset; i < slice_end; i += stride) {
+      T sum = static_cast<T>(LoadAndSum<T>(input_ptrs, num_ranks, i));
+
+#pragma unroll
+      for (int j = 0; j < kMaxNumAllReduceInputPtrs; ++j) {
+        if (j >= num_ranks) break;
 
-    output_ptr[i] = sum;
+        T* output_ptr =
+            reinterpret_cast<  // REINTERPRET_CAST_OK=tsl::safe_reinterpret_cast
+                               // doesn't work with __restrict__.
+                T* __restrict__>(output_ptrs[j]);
+        output_ptr[i] = sum;
+      }
+    }
   }
 }
 
 }  // namespace
 
-template <typename T>
+template <typename T, AllReduceStrategy kStrategy>
 void* GetAllReduceKernel() {
   return reinterpret_cast<  // REINTERPRET_CAST_OK=tsl::safe_reinterpret_cast
                             // doesn't support this cast, but it's necessary to
                             // conform to se::TypedKernelFactory<>::Create().
-      void*>(&AllReduceKernel<T>);
+      void*>(&AllReduceKernel<T, kStrategy>);
 }
 
-template void* GetAllReduceKernel<float>();
+template void* GetAllReduceKernel<float, AllReduceStrategy::kOneShot>();
+template void* GetAllReduceKernel<float, AllReduceStrategy::kTwoShot>();
+template void* GetAllReduceKernel<bfloat16, AllReduceStrategy::kOneShot>();
+template void* GetAllReduceKernel<bfloat16, AllReduceStrategy::kTwoShot>();
 
 }  // namespace xla::gpu
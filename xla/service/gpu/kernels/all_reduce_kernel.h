@@ -20,6 +20,7 @@ limitations under the License.
 
 #include "absl/status/status.h"
 #include "absl/types/span.h"
+#include "xla/service/gpu/kernels/all_reduce_kernel_common.h"
 #include "xla/stream_executor/device_memory.h"
 #include "xla/stream_executor/stream.h"
 #include "xla/types.h"  // IWYU pragma: keep
@@ -27,27 +28,41 @@ limitations under the License.
 
 namespace xla::gpu {
 
+// Returns true if the all-reduce kernel supports `num_ranks` participants
+// with elements of type `element_type`.
+bool IsAllReduceKernelSupported(int64_t num_ranks, PrimitiveType element_type);
+
+// Returns the strategy the all-reduce kernel should use for a reduction of
+// `num_bytes` bytes between `num_ranks` participants.
+AllReduceStrategy GetAllReduceStrategy(int64_t num_bytes, int64_t num_ranks);
+
 // Performs element-wise addition of all input buffers and stores the result in
-// the output buffer.
+// the output buffers.
 // The kernel is intended to be used for all-reduce operations in environment
-// where direct peer memory access is available. Input buffers can point to
-// memory on different devices. The caller is responsible to gather pointers
-// from different devices.
+// where direct peer memory access is available. Input and output buffers can
+// point to memory on different devices. The caller is responsible to gather
+// pointers from different devices, ordered by rank.
+//
+// With the one-shot strategy the kernel only writes the output buffer of
+// `rank`. With the two-shot strategy it writes the `rank`-th slice of the
+// result to the output buffers of all ranks, so the all-reduce is only
+// complete once the kernel has finished on every device.
 //
 // TODO(b/383125489): Add synchronization between blocks in the kernek.
 // The caller is also responsible to synchronize streams on all participating
 // devices before and after the kernel execution.
 //
 // Input arguments:
-//  - input_buffers: A list of input buffers.
-//  - output_buffer: The buffer to store the result.
-//  - num_inputs: The number of input buffers.
+//  - input_buffers: A list of input buffers, one per rank.
+//  - output_buffers: A list of output buffers, one per rank.
+//  - rank: The rank of the device that runs the kernel.
 //  - num_elements: The number of elements in each buffer.
+//  - strategy: The algorithm used to perform the all-reduce.
 absl::Status RunAllReduceKernel(
     se::Stream* stream, PrimitiveType element_type,
     absl::Span<const se::DeviceMemoryBase> input_buffers,
-    se::DeviceMemoryBase output_buffer, int64_t num_inputs,
-    int64_t num_elements);
+    absl::Span<const se::DeviceMemoryBase> output_buffers, int64_t rank,
+    int64_t num_elements, AllReduceStrategy strategy);
 
 }  // namespace xla::gpu
 
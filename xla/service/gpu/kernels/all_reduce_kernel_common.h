@@ -24,9 +24,18 @@ namespace xla::gpu {
 // kernel.
 inline constexpr int64_t kMaxNumAllReduceInputPtrs = 8;
 
-// Returns a pointer to the all-reduce kernel for the given element type.
-// Returns nullptr if the element type is not supported.
-template <typename T>
+enum class AllReduceStrategy : int64_t {
+  // Every rank reads the whole input of every peer and writes the full result
+  // to its own output. Lowest latency, but reads `num_ranks` times more data.
+  kOneShot,
+  // Every rank reduces a `1 / num_ranks` slice of the inputs and writes it to
+  // the outputs of all peers.
+  kTwoShot,
+};
+
+// Returns a pointer to the all-reduce kernel for the given element type and
+// strategy.
+template <typename T, AllReduceStrategy kStrategy>
 void* GetAllReduceKernel();
 
 }  // namespace xla::gpu
@@ -18,13 +18,14 @@ limitations under the License.
 #include <algorithm>
 #include <cstdint>
 #include <functional>
-#include <numeric>
+#include <utility>
 #include <vector>
 
 #include <gtest/gtest.h>
 #include "absl/log/check.h"
 #include "absl/log/log.h"
 #include "xla/primitive_util.h"
+#include "xla/service/gpu/kernels/all_reduce_kernel_common.h"
 #include "xla/stream_executor/device_memory.h"
 #include "xla/stream_executor/device_memory_handle.h"
 #include "xla/stream_executor/gpu/gpu_init.h"
@@ -33,6 +34,7 @@ limitations under the License.
 #include "xla/stream_executor/stream.h"
 #include "xla/tsl/lib/core/status_test_util.h"
 #include "xla/tsl/platform/test.h"
+#include "xla/types.h"
 #include "xla/xla_data.pb.h"
 
 namespace xla::gpu {
@@ -44,54 +46,112 @@ se::StreamExecutor* GetGpuExecutor() {
   return platform->ExecutorForDevice(0).value();
 }
 
-using AllReduceKernelTest = ::testing::Test;
-
-TEST_F(AllReduceKernelTest, SimpleKernelTest) {
-  using T = float;
-
+// Runs the all-reduce kernel for every rank on a single device, which is
+// equivalent to running it on `num_ranks` devices with peer access, and returns
+// the contents of all output buffers.
+template <typename T>
+std::vector<std::vector<T>> RunAllReduceForAllRanks(
+    AllReduceStrategy strategy, int64_t num_ranks, int64_t num_elements,
+    std::vector<T>& expected) {
   auto* executor = GetGpuExecutor();
   auto stream = executor->CreateStream().value();
 
-  constexpr int64_t num_inputs = 2;
-  constexpr int64_t num_elements = 128000;
-
   std::vector<se::DeviceMemoryHandle> input_buffers;
-  for (int64_t i = 0; i < num_inputs; ++i) {
+  std::vector<se::DeviceMemoryHandle> output_buffers;
+  for (int64_t i = 0; i < num_ranks; ++i) {
     input_buffers.emplace_back(executor,
                                executor->AllocateArray<T>(num_elements));
-    ASSERT_TRUE(!input_buffers[i].memory().is_null());
+    output_buffers.emplace_back(executor,
+                                executor->AllocateArray<T>(num_elements));
+    CHECK(!input_buffers[i].memory().is_null());
+    CHECK(!output_buffers[i].memory().is_null());
   }
 
-  se::DeviceMemoryHandle output_buffer(
-      executor, executor->AllocateArray<T>(num_elements));
-  ASSERT_TRUE(!output_buffer.memory().is_null());
-
-  std::vector<T> output_data(num_elements);
-  for (int i = 0; i < num_inputs; ++i) {
+  expected.assign(num_elements, static_cast<T>(0));
+  for (int64_t i = 0; i < num_ranks; ++i) {
     std::vector<T> input_data(num_elements);
-    std::iota(input_data.begin(), input_data.end(), 0);
+    for (int64_t j = 0; j < num_elements; ++j) {
+      input_data[j] = static_cast<T>((i + j) % 32);
+    }
 
-    TF_ASSERT_OK(stream->Memcpy(input_buffers[i].memory_ptr(),
-                                input_data.data(), num_elements * sizeof(T)));
+    CHECK_OK(stream->Memcpy(input_buffers[i].memory_ptr(), input_data.data(),
+                            num_elements * sizeof(T)));
 
-    std::transform(input_data.begin(), input_data.end(), output_data.begin(),
-                   output_data.begin(), std::plus<T>());
+    std::transform(input_data.begin(), input_data.end(), expected.begin(),
+                   expected.begin(), std::plus<T>());
   }
 
   std::vector<se::DeviceMemoryBase> input_buffers_span;
-  for (auto& input_buffer : input_buffers) {
-    input_buffers_span.push_back(input_buffer.memory());
+  std::vector<se::DeviceMemoryBase> output_buffers_span;
+  for (int64_t i = 0; i < num_ranks; ++i) {
+    input_buffers_span.push_back(input_buffers[i].memory());
+    output_buffers_span.push_back(output_buffers[i].memory());
   }
 
-  TF_ASSERT_OK(RunAllReduceKernel(
-      stream.get(), primitive_util::NativeToPrimitiveType<T>(),
-      input_buffers_span, output_buffer.memory(), num_inputs, num_elements));
+  for (int64_t rank = 0; rank < num_ranks; ++rank) {
+    CHECK_OK(RunAllReduceKernel(
+        stream.get(), primitive_util::NativeToPrimitiveType<T>(),
+        input_buffers_span, output_buffers_span, rank, num_elements,
+        strategy));
+  }
 
-  std::vector<T> output_results(num_elements);
-  TF_ASSERT_OK(stream->Memcpy(output_results.data(), output_buffer.memory(),
-                              num_elements * sizeof(T)));
+  std::vector<std::vector<T>> results;
+  for (int64_t i = 0; i < num_ranks; ++i) {
+    std::vector<T> output_results(num_elements);
+    CHECK_OK(stream->Memcpy(output_results.data(), output_buffers[i].memory(),
+                            num_elements * sizeof(T)));
+    results.push_back(std::move(output_results));
+  }
+  CHECK_OK(stream->BlockHostUntilDone());
+  return results;
+}
+
+using AllReduceKernelTest = ::testing::Test;
+
+TEST_F(AllReduceKernelTest, SimpleKernelTest) {
+  std::vector<float> expected;
+  auto results = RunAllReduceForAllRanks<float>(
+      AllReduceStrategy::kOneShot, /*num_ranks=*/2, /*num_elements=*/128000,
+      expected);
+  for (const auto& result : results) {
+    EXPECT_EQ(result, expected);
+  }
+}
+
+TEST_F(AllReduceKernelTest, TwoShotKernelTest) {
+  // Use a number of elements that is not a multiple of the number of ranks to
+  // cover the uneven last slice.
+  std::vector<float> expected;
+  auto results = RunAllReduceForAllRanks<float>(
+      AllReduceStrategy::kTwoShot, /*num_ranks=*/4, /*num_elements=*/128001,
+      expected);
+  for (const auto& result : results) {
+    EXPECT_EQ(result, expected);
+  }
+}
+
+TEST_F(AllReduceKernelTest, BF16KernelTest) {
+  for (AllReduceStrategy strategy :
+       {AllReduceStrategy::kOneShot, AllReduceStrategy::kTwoShot}) {
+    std::vector<bfloat16> expected;
+    auto results = RunAllReduceForAllRanks<bfloat16>(
+        strategy, /*num_ranks=*/4, /*num_elements=*/4096, expected);
+    for (const auto& result : results) {
+      EXPECT_EQ(result, expected);
+    }
+  }
+}
 
-  EXPECT_EQ(output_results, output_data);
+TEST_F(AllReduceKernelTest, StrategySelection) {
+  EXPECT_EQ(GetAllReduceStrategy(/*num_bytes=*/1024, /*num_ranks=*/8),
+            AllReduceStrategy::kOneShot);
+  EXPECT_EQ(GetAllReduceStrategy(/*num_bytes=*/1024 * 1024, /*num_ranks=*/2),
+            AllReduceStrategy::kOneShot);
+  EXPECT_EQ(GetAllReduceStrategy(/*num_bytes=*/1024 * 1024, /*num_ranks=*/8),
+            AllReduceStrategy::kTwoShot);
+  EXPECT_TRUE(IsAllReduceKernelSupported(/*num_ranks=*/8, BF16));
+  EXPECT_FALSE(IsAllReduceKernelSupported(/*num_ranks=*/16, F32));
+  EXPECT_FALSE(IsAllReduceKernelSupported(/*num_ranks=*/2, S32));
 }
 
 }  // namespace
@@ -58,6 +58,13 @@ size_t EstimateOptimalNumThreads(size_t n, size_t k, size_t batch_size) {
   return std::min(threads_per_block, min_slice);
 }
 
+// The radix select kernel used for k > kTopKMaxSmallK keeps nothing in
+// registers, so it uses full blocks unless the input is smaller.
+size_t EstimateRadixSelectNumThreads(size_t n, size_t wavefront_size) {
+  return std::max(wavefront_size,
+                  std::min(kTopKMaxThreadsPerBlock, absl::bit_ceil(n)));
+}
+
 // Gets the right version of TopK kernel based on the value of `k`.
 template <typename T>
 absl::StatusOr<void*> GetKernel(int n, int k) {
@@ -66,6 +73,7 @@ absl::StatusOr<void*> GetKernel(int n, int k) {
   if (k <= 4) return GetTopKKernelForK<T, 4>(n);
   if (k <= 8) return GetTopKKernelForK<T, 8>(n);
   if (k <= 16) return GetTopKKernelForK<T, 16>(n);
+  if (k <= kRadixTopKMaxK) return GetRadixTopKKernel<T>();
   return absl::UnimplementedError(absl::StrCat("Unsupported K: ", k));
 }
 
@@ -91,10 +99,18 @@ KernelArgsPacking CreateTopKArgsPacking(size_t num_elements, size_t k) {
 template <typename T>
 absl::StatusOr<CustomKernel> GetTypedTopK(std::string name, size_t num_elements,
                                           size_t k, size_t batch_size) {
-  constexpr size_t kMaxKVSize = sizeof(uint64_t);
-  // Allocate shmem assuming we have a full reduction.
-  int shmem_size = absl::bit_ceil(k) * kMaxKVSize * GetTopKWaveFrontSize<T>();
-  int num_threads = EstimateOptimalNumThreads(num_elements, k, batch_size);
+  int shmem_size;
+  int num_threads;
+  if (k <= kTopKMaxSmallK) {
+    constexpr size_t kMaxKVSize = sizeof(uint64_t);
+    // Allocate shmem assuming we have a full reduction.
+    shmem_size = absl::bit_ceil(k) * kMaxKVSize * GetTopKWaveFrontSize<T>();
+    num_threads = EstimateOptimalNumThreads(num_elements, k, batch_size);
+  } else {
+    shmem_size = GetRadixTopKSharedMemoryBytes(k);
+    num_threads =
+        EstimateRadixSelectNumThreads(num_elements, GetTopKWaveFrontSize<T>());
+  }
   if (num_threads == 0) {
     return absl::FailedPreconditionError(
         "Invalid kernel parameters. This is likely a bug in the "
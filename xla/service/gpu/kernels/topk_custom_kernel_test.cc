@@ -203,4 +203,18 @@ INSTANTIATE_TEST_SUITE_P(TopKTests, TopKKernelTest,
                                std::get<3>(info.param));
                          });
 
+INSTANTIATE_TEST_SUITE_P(RadixSelectTopKTests, TopKKernelTest,
+                         Combine(
+                             /*n_kb=*/Values(1, 64, 256),
+                             /*k=*/Values(17, 100, 1024),
+                             /*batch_size=*/Values(1, 16),
+                             /*offset=*/Values(0, 7, 4)),
+                         [](const auto& info) {
+                           return absl::Substitute(
+                               "n$0KiB_k$1_batch_size$2_offset$3",
+                               std::get<0>(info.param), std::get<1>(info.param),
+                               std::get<2>(info.param),
+                               std::get<3>(info.param));
+                         });
+
 }  // namespace xla::gpu::kernel::topk
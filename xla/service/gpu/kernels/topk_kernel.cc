@@ -55,6 +55,13 @@ size_t NumThreads(size_t n, size_t k, size_t batch_size) {
   return std::min(threads_per_block, min_slice);
 }
 
+// The radix select kernel keeps nothing in registers, so it uses full blocks
+// unless the input is smaller.
+size_t RadixSelectNumThreads(size_t n, size_t wavefront_size) {
+  return std::max(wavefront_size,
+                  std::min(kTopKMaxThreadsPerBlock, absl::bit_ceil(n)));
+}
+
 template <typename T>
 absl::StatusOr<void*> GetKernel(int n, int k) {
   if (k <= 1) return GetTopKKernelForK<T, 1>(n);
@@ -62,6 +69,7 @@ absl::StatusOr<void*> GetKernel(int n, int k) {
   if (k <= 4) return GetTopKKernelForK<T, 4>(n);
   if (k <= 8) return GetTopKKernelForK<T, 8>(n);
   if (k <= 16) return GetTopKKernelForK<T, 16>(n);
+  if (k <= kRadixTopKMaxK) return GetRadixTopKKernel<T>();
   return absl::UnimplementedError(absl::StrCat("Unsupported K: ", k));
 }
 
@@ -70,10 +78,18 @@ absl::Status TypedTopK(se::Stream* stream, se::DeviceMemoryBase data,
                        size_t num_elements, se::DeviceMemoryBase top_elements,
                        se::DeviceMemoryBase top_indices, size_t k,
                        size_t batch_size) {
-  constexpr size_t max_kv_size = sizeof(uint64_t);
-  // Allocate shmem assuming we have a full reduction.
-  int shmem_size = absl::bit_ceil(k) * max_kv_size * GetTopKWaveFrontSize<T>();
-  int num_threads = NumThreads(num_elements, k, batch_size);
+  int shmem_size;
+  int num_threads;
+  if (k <= kTopKMaxSmallK) {
+    constexpr size_t max_kv_size = sizeof(uint64_t);
+    // Allocate shmem assuming we have a full reduction.
+    shmem_size = absl::bit_ceil(k) * max_kv_size * GetTopKWaveFrontSize<T>();
+    num_threads = NumThreads(num_elements, k, batch_size);
+  } else {
+    shmem_size = GetRadixTopKSharedMemoryBytes(k);
+    num_threads =
+        RadixSelectNumThreads(num_elements, GetTopKWaveFrontSize<T>());
+  }
   if (num_threads == 0) {
     return absl::FailedPreconditionError(
         "Invalid kernel parameters. This is likely a bug in the "
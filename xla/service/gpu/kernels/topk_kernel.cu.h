@@ -26,6 +26,7 @@ limitations under the License.
 
 #include "xla/service/gpu/kernels/topk_kernel_common.h"
 #include "xla/tsl/lib/math/math_util.h"
+#include "xla/types.h"
 
 #if GOOGLE_CUDA
 
@@ -317,6 +318,214 @@ int32_t GetTopKWaveFrontSize() {
   return WAVEFRONT_SIZE;
 }
 
+// Maps keys to unsigned integers in the same order, i.e. the total order in
+// which -NaN < -Inf < ... < -0 < +0 < ... < +Inf < +NaN.
+template <typename T>
+struct RadixKey;
+
+template <>
+struct RadixKey<float> {
+  static constexpr int kBits = 32;
+
+  __device__ FORCEINLINE static uint32_t ToOrdered(float key) {
+    uint32_t bits = __float_as_uint(key);
+    return (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+  }
+
+  __device__ FORCEINLINE static float FromOrdered(uint32_t bits) {
+    return __uint_as_float((bits & 0x80000000u) ? bits & 0x7fffffffu : ~bits);
+  }
+};
+
+template <>
+struct RadixKey<bfloat16> {
+  static constexpr int kBits = 16;
+
+  __device__ FORCEINLINE static uint32_t ToOrdered(bfloat16 key) {
+    uint32_t bits = Eigen::numext::bit_cast<uint16_t>(key);
+    return (bits & 0x8000u) ? ~bits & 0xffffu : bits | 0x8000u;
+  }
+
+  __device__ FORCEINLINE static bfloat16 FromOrdered(uint32_t bits) {
+    return Eigen::numext::bit_cast<bfloat16>(
+        static_cast<uint16_t>((bits & 0x8000u) ? bits & 0x7fffu : ~bits));
+  }
+};
+
+// Returns the exclusive prefix sum of `value` over the threads of the block,
+// and the sum over all threads in `total`. `warp_sums` must have room for one
+// element per warp. Must be called by all threads of the block, and the block
+// size must be a multiple of the warp size.
+__device__ FORCEINLINE uint32_t BlockExclusiveSum(uint32_t value,
+                                                  uint32_t* warp_sums,
+                                                  uint32_t* total) {
+  constexpr uint32_t WarpSize = WAVEFRONT_SIZE;
+  const uint32_t lane_id = threadIdx.x % WarpSize;
+  const uint32_t warp_id = threadIdx.x / WarpSize;
+  const uint32_t num_warps = blockDim.x / WarpSize;
+
+  uint32_t inclusive = value;
+#pragma unroll
+  for (uint32_t offset = 1; offset < WarpSize; offset *= 2) {
+    uint32_t other = GpuShuffle<ShflType::kUp>(inclusive, offset);
+    if (lane_id >= offset) inclusive += other;
+  }
+  if (lane_id == WarpSize - 1) warp_sums[warp_id] = inclusive;
+  __syncthreads();
+
+  // A block has at most as many warps as a warp has lanes, so one warp scans
+  // the per-warp sums.
+  if (warp_id == 0) {
+    uint32_t warp_sum = lane_id < num_warps ? warp_sums[lane_id] : 0;
+#pragma unroll
+    for (uint32_t offset = 1; offset < WarpSize; offset *= 2) {
+      uint32_t other = GpuShuffle<ShflType::kUp>(warp_sum, offset);
+      if (lane_id >= offset) warp_sum += other;
+    }
+    if (lane_id < num_warps) warp_sums[lane_id] = warp_sum;
+  }
+  __syncthreads();
+
+  const uint32_t warp_offset = warp_id == 0 ? 0 : warp_sums[warp_id - 1];
+  *total = warp_sums[num_warps - 1];
+  // Let all threads read the sums before `warp_sums` is reused.
+  __syncthreads();
+  return warp_offset + inclusive - value;
+}
+
+// RunRadixSelect implements TopK for large k, up to kRadixTopKMaxK, with one
+// block per batch dimension.
+//
+// The per-thread sorted lists of TopK don't scale past small k, as they are
+// kept in registers. Instead, we find the k-th largest key with a radix
+// select: keys are mapped to unsigned integers with the same order, and for
+// each 8-bit digit, from the most significant one, we build a histogram of the
+// digit over the keys that match the digits found so far, and pick the digit
+// at which the count of larger keys reaches k. Each pass reads the data once,
+// so a row is read 4 times for f32 and 2 times for bf16.
+//
+// A final pass then collects the keys larger than the k-th largest key, and as
+// many keys equal to it as needed, taking the ones with the smallest indices
+// like a stable sort would. The k selected elements are sorted in shared
+// memory with a bitonic sort, as keys packed with their inverted indices, so
+// that the output is ordered by decreasing key and then increasing index.
+template <typename KT>
+__launch_bounds__(kTopKMaxThreadsPerBlock, 1) __global__
+    void RunRadixSelect(KT* data, int n, KT* result, uint32_t* result_idxs,
+                        int k) {
+  using Key = RadixKey<KT>;
+  constexpr uint32_t kDigitBits = 8;
+  static_assert(kRadixTopKNumBins == 1 << kDigitBits);
+  static_assert(Key::kBits % kDigitBits == 0);
+
+  const uint32_t num_slots = GetRadixTopKNumSlots(k);
+  uint64_t* selected = reinterpret_cast<uint64_t*>(shmem);
+  uint32_t* histogram = reinterpret_cast<uint32_t*>(selected + num_slots);
+  uint32_t* warp_sums = histogram + kRadixTopKNumBins;
+  uint32_t* digit_state = warp_sums + kRadixTopKMaxWarps;
+
+  const KT* in = data + static_cast<size_t>(n) * blockIdx.x;
+  KT* vals_out = result + static_cast<size_t>(k) * blockIdx.x;
+  uint32_t* idxs_out = result_idxs + static_cast<size_t>(k) * blockIdx.x;
+
+  // Find the k-th largest key one digit at a time. `remaining` is the rank of
+  // the k-th largest key among the keys that match `prefix`.
+  uint32_t prefix = 0;
+  uint32_t prefix_mask = 0;
+  uint32_t remaining = k;
+  for (int shift = Key::kBits - kDigitBits; shift >= 0; shift -= kDigitBits) {
+    for (uint32_t i = threadIdx.x; i < kRadixTopKNumBins; i += blockDim.x) {
+      histogram[i] = 0;
+    }
+    __syncthreads();
+    for (int i = threadIdx.x; i < n; i += blockDim.x) {
+      uint32_t key = Key::ToOrdered(in[i]);
+      if ((key & prefix_mask) == prefix) {
+        atomicAdd(&histogram[(key >> shift) & (kRadixTopKNumBins - 1)], 1);
+      }
+    }
+    __syncthreads();
+    if (threadIdx.x == 0) {
+      uint32_t digit = kRadixTopKNumBins - 1;
+      for (; digit > 0 && histogram[digit] < remaining; --digit) {
+        remaining -= histogram[digit];
+      }
+      digit_state[0] = digit;
+      digit_state[1] = remaining;
+    }
+    __syncthreads();
+    prefix |= digit_state[0] << shift;
+    prefix_mask |= (kRadixTopKNumBins - 1) << shift;
+    remaining = digit_state[1];
+  }
+
+  // Collect the selected elements. The counts are the same in all threads, so
+  // all of them leave the loop together.
+  const uint32_t threshold = prefix;
+  const uint32_t num_greater = k - remaining;
+  uint32_t greater_taken = 0;
+  uint32_t equal_taken = 0;
+  for (int base = 0;
+       base < n && (greater_taken < num_greater || equal_taken < remaining);
+       base += blockDim.x) {
+    const int i = base + threadIdx.x;
+    const uint32_t key = i < n ? Key::ToOrdered(in[i]) : 0;
+    const bool greater = i < n && key > threshold;
+    const bool equal = i < n && key == threshold;
+    // Both counts of a chunk are at most the block size, so they can be
+    // scanned together in the two halves of a word.
+    uint32_t total;
+    const uint32_t offset = BlockExclusiveSum(
+        (static_cast<uint32_t>(greater) << 16) | static_cast<uint32_t>(equal),
+        warp_sums, &total);
+    const uint64_t packed =
+        (static_cast<uint64_t>(key) << 32) | (0xffffffffu - i);
+    if (greater) {
+      selected[greater_taken + (offset >> 16)] = packed;
+    }
+    const uint32_t equal_rank = equal_taken + (offset & 0xffffu);
+    if (equal && equal_rank < remaining) {
+      selected[num_greater + equal_rank] = packed;
+    }
+    greater_taken += total >> 16;
+    equal_taken += total & 0xffffu;
+  }
+  // Pad with elements that sort after all others.
+  for (uint32_t i = k + threadIdx.x; i < num_slots; i += blockDim.x) {
+    selected[i] = 0;
+  }
+  __syncthreads();
+
+  // Bitonic sort in decreasing order.
+  for (uint32_t size = 2; size <= num_slots; size *= 2) {
+    for (uint32_t stride = size / 2; stride > 0; stride /= 2) {
+      for (uint32_t i = threadIdx.x; i < num_slots; i += blockDim.x) {
+        const uint32_t j = i ^ stride;
+        if (j <= i) continue;
+        const uint64_t a = selected[i];
+        const uint64_t b = selected[j];
+        const bool descending = (i & size) == 0;
+        if ((a < b) == descending) {
+          selected[i] = b;
+          selected[j] = a;
+        }
+      }
+      __syncthreads();
+    }
+  }
+
+  for (uint32_t i = threadIdx.x; i < k; i += blockDim.x) {
+    const uint64_t packed = selected[i];
+    vals_out[i] = Key::FromOrdered(static_cast<uint32_t>(packed >> 32));
+    idxs_out[i] = 0xffffffffu - static_cast<uint32_t>(packed);
+  }
+}
+
+template <typename T>
+void* GetRadixTopKKernel() {
+  return reinterpret_cast<void*>(&RunRadixSelect<T>);
+}
+
 }  // namespace xla::gpu
 
 #endif  // XLA_SERVICE_GPU_KERNELS_TOPK_KERNEL_CU_H_
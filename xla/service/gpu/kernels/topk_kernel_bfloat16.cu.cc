@@ -24,6 +24,8 @@ template void* GetTopKKernelForK<bfloat16, 4>(int n);
 template void* GetTopKKernelForK<bfloat16, 8>(int n);
 template void* GetTopKKernelForK<bfloat16, 16>(int n);
 
+template void* GetRadixTopKKernel<bfloat16>();
+
 template int32_t GetTopKWaveFrontSize<bfloat16>();
 
 }  // namespace xla::gpu
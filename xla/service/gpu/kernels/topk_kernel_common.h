@@ -17,6 +17,7 @@ limitations under the License.
 #define XLA_SERVICE_GPU_KERNELS_TOPK_KERNEL_COMMON_H_
 
 #include <cstddef>
+#include <cstdint>
 
 // Contains shared declarations between topk_kernel.cc and topk_kernel.cu.cc
 // but avoids including ABSL, etc. which some CUDA compilers cannot
@@ -28,9 +29,41 @@ namespace xla::gpu {
 // block we support is 1024.
 static constexpr size_t kTopKMaxThreadsPerBlock = 1024;
 
+// The largest k of the TopK kernel, which keeps the top elements of each
+// thread in registers.
+static constexpr size_t kTopKMaxSmallK = 16;
+
+// The largest k of the radix select kernel, which sorts the selected elements
+// in shared memory.
+static constexpr size_t kRadixTopKMaxK = 1024;
+
+// The number of bins of the radix select histograms, one per 8-bit digit.
+static constexpr size_t kRadixTopKNumBins = 256;
+
+// An upper bound of the number of warps in a block.
+static constexpr size_t kRadixTopKMaxWarps = kTopKMaxThreadsPerBlock / 32;
+
+// Returns the number of slots in which the radix select kernel sorts the `k`
+// selected elements, the smallest power of two that is at least `k`.
+inline constexpr uint32_t GetRadixTopKNumSlots(uint32_t k) {
+  uint32_t num_slots = 1;
+  while (num_slots < k) num_slots *= 2;
+  return num_slots;
+}
+
+// Returns the shared memory used by the radix select kernel: the sorted
+// elements, the histogram, the per-warp sums and the selected digit.
+inline constexpr size_t GetRadixTopKSharedMemoryBytes(size_t k) {
+  return GetRadixTopKNumSlots(k) * sizeof(uint64_t) +
+         (kRadixTopKNumBins + kRadixTopKMaxWarps + 2) * sizeof(uint32_t);
+}
+
 template <typename T, size_t K>
 void* GetTopKKernelForK(int n);
 
+template <typename T>
+void* GetRadixTopKKernel();
+
 template <typename T>
 int32_t GetTopKWaveFrontSize();
 
@@ -51,6 +51,35 @@ auto* gpu_compiler_stacktrace_count = tsl::monitoring::Counter<1>::New(
     "/xla/service/gpu/compiler_stacktrace_count",
     "The number of times a compiler stacktrace was called.", "stacktrace");
 
+auto* command_buffer_time_usecs_histogram = tsl::monitoring::Sampler<2>::New(
+    {"/xla/service/gpu/command_buffer_time_usecs_histogram",
+     "The wall-clock time spent on initializing and updating command buffers "
+     "in microseconds.",
+     "command_buffer", "phase"},
+    // These exponential buckets cover the following range:
+    // Minimum: 1 us
+    // Maximum: 1 us * 2 ^ 24 == ~16.8 seconds
+    {tsl::monitoring::Buckets::Exponential(1, 2, 25)});
+
+auto* executable_initialize_time_usecs_histogram =
+    tsl::monitoring::Sampler<0>::New(
+        {"/xla/service/gpu/executable_initialize_time_usecs_histogram",
+         "The wall-clock time spent on initializing thunks of GPU executables "
+         "in microseconds."},
+        // These exponential buckets cover the following range:
+        // Minimum: 1 us
+        // Maximum: 1 us * 2 ^ 24 == ~16.8 seconds
+        {tsl::monitoring::Buckets::Exponential(1, 2, 25)});
+
+auto* command_buffer_updated_commands_count = tsl::monitoring::Counter<1>::New(
+    "/xla/service/gpu/command_buffer_updated_commands_count",
+    "The number of commands updated in command buffers.", "command_buffer");
+
+auto* command_buffer_fallback_count = tsl::monitoring::Counter<2>::New(
+    "/xla/service/gpu/command_buffer_fallback_count",
+    "The number of command buffer executions that fell back to thunks.",
+    "command_buffer", "reason");
+
 }  // namespace
 
 void RecordHloPassesDuration(const uint64_t time_usecs) {
@@ -136,4 +165,39 @@ int GetGpuCompilerStacktraceCount(absl::string_view stacktrace) {
       ->value();
 }
 
+void RecordCommandBufferInitializeDuration(absl::string_view command_buffer,
+                                           const uint64_t time_usecs) {
+  command_buffer_time_usecs_histogram
+      ->GetCell(std::string(command_buffer), "initialize")
+      ->Add(time_usecs);
+}
+
+void RecordCommandBufferUpdate(absl::string_view command_buffer,
+                               const uint64_t time_usecs,
+                               const int64_t num_commands) {
+  command_buffer_time_usecs_histogram
+      ->GetCell(std::string(command_buffer), "update")
+      ->Add(time_usecs);
+  command_buffer_updated_commands_count->GetCell(std::string(command_buffer))
+      ->IncrementBy(num_commands);
+}
+
+void RecordExecutableInitializeDuration(const uint64_t time_usecs) {
+  executable_initialize_time_usecs_histogram->GetCell()->Add(time_usecs);
+}
+
+void IncrementCommandBufferFallbackCount(absl::string_view command_buffer,
+                                         absl::string_view reason) {
+  command_buffer_fallback_count
+      ->GetCell(std::string(command_buffer), std::string(reason))
+      ->IncrementBy(1);
+}
+
+int64_t GetCommandBufferFallbackCount(absl::string_view command_buffer,
+                                      absl::string_view reason) {
+  return command_buffer_fallback_count
+      ->GetCell(std::string(command_buffer), std::string(reason))
+      ->value();
+}
+
 }  // namespace xla
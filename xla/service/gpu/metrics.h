@@ -61,6 +61,31 @@ void RecordGpuCompilerStacktrace();
 // stacktrace.
 int GetGpuCompilerStacktraceCount(absl::string_view stacktrace);
 
+// Command buffers (CUDA graphs) run time metrics. Command buffers are
+// identified by the profile annotation of the command buffer thunk.
+
+// Records the time spent on recording and instantiating a command buffer.
+void RecordCommandBufferInitializeDuration(absl::string_view command_buffer,
+                                           uint64_t time_usecs);
+
+// Records the time spent on updating a command buffer and the number of
+// updated commands.
+void RecordCommandBufferUpdate(absl::string_view command_buffer,
+                               uint64_t time_usecs, int64_t num_commands);
+
+// Records the time spent on initializing all thunks of an executable before
+// its execution.
+void RecordExecutableInitializeDuration(uint64_t time_usecs);
+
+// Counts command buffer executions that fell back to thunks execution.
+void IncrementCommandBufferFallbackCount(absl::string_view command_buffer,
+                                         absl::string_view reason);
+
+// Returns the number of command buffer executions that fell back to thunks
+// execution for the given reason.
+int64_t GetCommandBufferFallbackCount(absl::string_view command_buffer,
+                                      absl::string_view reason);
+
 }  // namespace xla
 
 #endif  // XLA_SERVICE_GPU_METRICS_H_
@@ -45,6 +45,41 @@ TEST(MetricsTest, RecordsGpuCompilerStacktrace) {
       1);
 }
 
+TEST(MetricsTest, RecordsExecutableInitializeDuration) {
+  RecordExecutableInitializeDuration(100);
+
+  tsl::monitoring::CollectionRegistry::CollectMetricsOptions options;
+  std::unique_ptr<tsl::monitoring::CollectedMetrics> metrics =
+      tsl::monitoring::CollectionRegistry::Default()->CollectMetrics(options);
+
+  EXPECT_TRUE(
+      metrics->point_set_map.find(
+          "/xla/service/gpu/executable_initialize_time_usecs_histogram") !=
+      metrics->point_set_map.end());
+}
+
+TEST(MetricsTest, RecordsCommandBufferMetrics) {
+  RecordCommandBufferInitializeDuration("command_buffer_test", 100);
+  RecordCommandBufferUpdate("command_buffer_test", 10, /*num_commands=*/2);
+
+  EXPECT_EQ(GetCommandBufferFallbackCount("command_buffer_test", "profiling"),
+            0);
+  IncrementCommandBufferFallbackCount("command_buffer_test", "profiling");
+  EXPECT_EQ(GetCommandBufferFallbackCount("command_buffer_test", "profiling"),
+            1);
+
+  tsl::monitoring::CollectionRegistry::CollectMetricsOptions options;
+  std::unique_ptr<tsl::monitoring::CollectedMetrics> metrics =
+      tsl::monitoring::CollectionRegistry::Default()->CollectMetrics(options);
+
+  EXPECT_TRUE(metrics->point_set_map.find(
+                  "/xla/service/gpu/command_buffer_time_usecs_histogram") !=
+              metrics->point_set_map.end());
+  EXPECT_TRUE(metrics->point_set_map.find(
+                  "/xla/service/gpu/command_buffer_updated_commands_count") !=
+              metrics->point_set_map.end());
+}
+
 }  // namespace
 }  // namespace gpu
 }  // namespace xla
@@ -21,6 +21,7 @@ limitations under the License.
 #include <optional>
 #include <string>
 #include <utility>
+#include <variant>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
@@ -28,6 +29,8 @@ limitations under the License.
 #include "absl/log/log.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
 #include "absl/time/time.h"
 #include "xla/hlo/ir/collective_device_list.h"
 #include "xla/hlo/ir/hlo_casting_utils.h"
@@ -47,9 +50,12 @@ limitations under the License.
 #include "xla/service/hlo_module_config.h"
 #include "xla/shape.h"
 #include "xla/shape_util.h"
+#include "xla/stream_executor/cuda/cuda_compute_capability.h"
 #include "xla/stream_executor/device_description.h"
+#include "xla/tsl/platform/env.h"
 #include "xla/tsl/platform/errors.h"
 #include "xla/tsl/platform/statusor.h"
+#include "tsl/platform/protobuf.h"
 
 namespace xla::gpu {
 
@@ -250,6 +256,32 @@ HloOpcode AsyncToSyncOpcode(const HloCollectiveInstruction& instr) {
   return opcode;
 }
 
+// Returns the key of the table in `profiles` to use for `device_info`. That is
+// the table of its GPU generation if there is one, and otherwise the table of
+// the closest older minor revision of the same major generation.
+std::optional<std::string> FindProfileKey(
+    const DeviceHloInstructionProfiles& profiles,
+    const se::DeviceDescription& device_info) {
+  std::string key = HloOpProfiles::GetProfileName(device_info);
+  if (profiles.entries().contains(key)) {
+    return key;
+  }
+  auto* cc = std::get_if<se::CudaComputeCapability>(
+      &device_info.gpu_compute_capability());
+  if (cc == nullptr) {
+    return std::nullopt;
+  }
+  for (int minor = cc->minor - 1; minor >= 0; --minor) {
+    std::string fallback_key = absl::StrCat("sm_", cc->major, minor);
+    if (profiles.entries().contains(fallback_key)) {
+      VLOG(1) << "Using collective perf table of " << fallback_key
+              << " for " << key;
+      return fallback_key;
+    }
+  }
+  return std::nullopt;
+}
+
 absl::StatusOr<HloInstructionProfileList> ReadDefaultProfiles(
     const se::DeviceDescription& device_info) {
   DeviceHloInstructionProfiles profile;
@@ -258,12 +290,31 @@ absl::StatusOr<HloInstructionProfileList> ReadDefaultProfiles(
                                                   &profile)) {
     return absl::FailedPreconditionError("Cannot parse a default profile.");
   }
-  std::string key = HloOpProfiles::GetProfileName(device_info);
+  std::optional<std::string> key = FindProfileKey(profile, device_info);
+  if (!key.has_value()) {
+    return absl::NotFoundError(absl::StrCat(
+        "Cannot find key: ", HloOpProfiles::GetProfileName(device_info)));
+  }
+  return profile.entries().at(*key);
+}
 
-  if (!profile.entries().contains(key)) {
-    return absl::NotFoundError(absl::StrCat("Cannot find key: ", key));
+// Reads the table for `device_info` from `perf_table_path`. Returns an empty
+// list if the file has no table for the GPU generation.
+absl::StatusOr<HloInstructionProfileList> ReadProfiles(
+    const std::string& perf_table_path,
+    const se::DeviceDescription& device_info) {
+  DeviceHloInstructionProfiles profile;
+  TF_RETURN_IF_ERROR(tsl::Env::Default()->FileExists(perf_table_path));
+  TF_RETURN_IF_ERROR(tsl::ReadTextOrBinaryProto(tsl::Env::Default(),
+                                                perf_table_path, &profile));
+  std::optional<std::string> key = FindProfileKey(profile, device_info);
+  if (!key.has_value()) {
+    VLOG(1) << "No collective perf table for "
+            << HloOpProfiles::GetProfileName(device_info) << " in "
+            << perf_table_path;
+    return HloInstructionProfileList();
   }
-  return profile.entries().at(key);
+  return profile.entries().at(*key);
 }
 
 }  // namespace
@@ -328,6 +379,78 @@ CollectiveInterpolator::Create(const HloInstructionProfileList& profiles,
       new CollectiveInterpolator(std::move(interpolators), device_info));
 }
 
+/*static*/ absl::StatusOr<std::unique_ptr<CollectiveInterpolator>>
+CollectiveInterpolator::Create(absl::string_view perf_table_paths,
+                               const se::DeviceDescription& device_info) {
+  if (perf_table_paths.empty()) {
+    return Create(device_info);
+  }
+
+  std::vector<HloInstructionProfileList> tables;
+  if (absl::StatusOr<HloInstructionProfileList> default_profiles =
+          ReadDefaultProfiles(device_info);
+      default_profiles.ok()) {
+    tables.push_back(*std::move(default_profiles));
+  }
+  for (absl::string_view path :
+       absl::StrSplit(perf_table_paths, ',', absl::SkipEmpty())) {
+    TF_ASSIGN_OR_RETURN(HloInstructionProfileList table,
+                        ReadProfiles(std::string(path), device_info));
+    tables.push_back(std::move(table));
+  }
+
+  // Later measurements of the same point replace earlier ones.
+  absl::flat_hash_map<InterpolatorKey,
+                      absl::flat_hash_map<std::array<int64_t, 2>, int64_t>>
+      merged;
+  for (const HloInstructionProfileList& table : tables) {
+    for (const HloInstructionProfile& profile : table.entries()) {
+      TF_ASSIGN_OR_RETURN(InterpolationSpecification spec,
+                          Spec(profile, device_info));
+      CollectiveInterpolator::InterpolatorKey key{
+          /*opcode=*/spec.opcode,
+          /*communication_type=*/spec.comm,
+      };
+      merged[key][{spec.transfer_size, spec.num_devices}] =
+          profile.network_throughput_bytes_per_sec();
+    }
+  }
+  if (merged.empty()) {
+    return absl::NotFoundError(
+        absl::StrCat("Cannot find collective perf tables for: ",
+                     HloOpProfiles::GetProfileName(device_info)));
+  }
+
+  auto interpolators = std::make_unique<absl::flat_hash_map<
+      InterpolatorKey, std::unique_ptr<InterpolatorBase<int64_t, 2>>>>();
+  for (auto& [key, points] : merged) {
+    auto interpolator = std::make_unique<EuclideanNNInterpolator<int64_t, 2>>();
+    for (const auto& [point, throughput] : points) {
+      std::array<int64_t, 2> p = point;
+      interpolator->Add(p, throughput);
+    }
+    (*interpolators)[key] = std::move(interpolator);
+  }
+  return std::unique_ptr<CollectiveInterpolator>(
+      new CollectiveInterpolator(std::move(interpolators), device_info));
+}
+
+/*static*/ bool CollectiveInterpolator::IsSupported(
+    const HloInstruction& instr) {
+  switch (instr.opcode()) {
+    case HloOpcode::kAllReduce:
+    case HloOpcode::kAllReduceStart:
+    case HloOpcode::kAllGather:
+    case HloOpcode::kAllGatherStart:
+    case HloOpcode::kReduceScatter:
+      return true;
+    case HloOpcode::kAsyncStart:
+      return instr.async_wrapped_opcode() == HloOpcode::kReduceScatter;
+    default:
+      return false;
+  }
+}
+
 std::optional<absl::Duration> CollectiveInterpolator::EstimatedRuntime(
     const HloCollectiveInstruction& instr) const {
   GpuHloCostAnalysis analysis(GpuHloCostAnalysis::Options(), device_info_);
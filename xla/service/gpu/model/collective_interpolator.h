@@ -23,8 +23,10 @@ limitations under the License.
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
 #include "absl/time/time.h"
 #include "xla/hlo/ir/hlo_clone_context.h"
+#include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_instructions.h"
 #include "xla/hlo/ir/hlo_opcode.h"
 #include "xla/service/gpu/model/hlo_op_profile.pb.h"
@@ -58,9 +60,27 @@ class CollectiveInterpolator {
       const HloInstructionProfileList& profiles,
       const se::DeviceDescription& device_info);
 
+  // Creates an interpolator from the performance table shipped with XLA for
+  // the GPU generation of `device_info`. Devices without a table of their own
+  // use the table of the closest older revision of the same generation.
   static absl::StatusOr<std::unique_ptr<CollectiveInterpolator>> Create(
       const se::DeviceDescription& device_info);
 
+  // Creates an interpolator from the default performance table merged with
+  // the tables in the comma-separated list of `perf_table_paths`, e.g. ones
+  // measured on a particular cluster with `collective_perf_table_gen`. Entries
+  // of later tables take precedence over earlier ones and over the default
+  // table when they measure the same collective. Falls back to the default
+  // table alone if `perf_table_paths` is empty.
+  static absl::StatusOr<std::unique_ptr<CollectiveInterpolator>> Create(
+      absl::string_view perf_table_paths,
+      const se::DeviceDescription& device_info);
+
+  // Returns whether perf tables model `instr`: all-reduce, all-gather and
+  // reduce-scatter, in their sync or async start forms. For an async
+  // reduce-scatter `EstimatedRuntime` takes the wrapped instruction.
+  static bool IsSupported(const HloInstruction& instr);
+
   // Constructs the semantically correct module from the profile.
   // Usually the root instruction of the entry computation is of interest and is
   // directly related to the `profile`d information.
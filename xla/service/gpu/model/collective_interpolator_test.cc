@@ -24,6 +24,8 @@ limitations under the License.
 #include <gtest/gtest.h>
 #include "absl/log/check.h"
 #include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "absl/time/time.h"
 #include "xla/hlo/ir/collective_device_list.h"
@@ -40,8 +42,11 @@ limitations under the License.
 #include "xla/shape_util.h"
 #include "xla/stream_executor/cuda/cuda_compute_capability.h"
 #include "xla/stream_executor/device_description.h"
+#include "xla/tsl/lib/core/status_test_util.h"
+#include "xla/tsl/platform/env.h"
 #include "xla/tsl/platform/statusor.h"
 #include "xla/xla_data.pb.h"
+#include "tsl/platform/path.h"
 
 namespace xla::gpu {
 namespace {
@@ -922,5 +927,95 @@ TEST(CollectiveInterpolatorTest, LoadsDefaultProfile) {
   EXPECT_TRUE(interpolator->EstimatedRuntime(*instr).has_value());
 }
 
+constexpr absl::string_view kSingleHostAllReduceHlo = R"(
+    HloModule m, num_partitions=8
+
+    wrapped_add {
+        a = f32[] parameter(0)
+        b = f32[] parameter(1)
+        ROOT _ = f32[] add(a,b)
+    }
+
+    ENTRY main {
+        p = f32[256] parameter(0)
+        ROOT _ = f32[256] all-reduce(p),
+        to_apply=wrapped_add,
+        replica_groups=[1,8]<=[8],
+        use_global_device_ids=true,
+        channel_id=1
+    }
+)";
+
+// Writes a perf table with a single measurement of `kSingleHostAllReduceHlo`
+// as the table of `device_key` and returns its path.
+std::string WriteSingleHostAllReduceTable(absl::string_view file_name,
+                                          absl::string_view device_key,
+                                          int64_t throughput_bytes_per_sec) {
+  HloInstructionProfile profile;
+  *profile.mutable_instruction()->mutable_opcode() =
+      HloOpcodeString(HloOpcode::kAllReduce);
+  *profile.mutable_instruction()->mutable_shape() =
+      ShapeUtil::MakeShape(F32, {256}).ToProto();
+  *profile.mutable_instruction()->mutable_collective_device_list() =
+      CollectiveDeviceList(
+          IotaReplicaGroupList(/*num_replica_groups=*/1,
+                               /*num_devices_per_group=*/kNumGpusPerHost))
+          .ToProto();
+  profile.mutable_instruction()->set_use_global_device_ids(true);
+  profile.mutable_instruction()->set_channel_id(1);
+  profile.set_network_throughput_bytes_per_sec(throughput_bytes_per_sec);
+
+  DeviceHloInstructionProfiles device_profiles;
+  *(*device_profiles.mutable_entries())[device_key].add_entries() = profile;
+  std::string path = tsl::io::JoinPath(::testing::TempDir(), file_name);
+  CHECK_OK(tsl::WriteTextProto(tsl::Env::Default(), path, device_profiles));
+  return path;
+}
+
+TEST(CollectiveInterpolatorTest, MergesPerfTablesOverDefaultProfile) {
+  auto device_info = TestGpuDeviceInfo::RTXA6000DeviceInfo(
+      stream_executor::CudaComputeCapability::Hopper());
+  // f32[256] all-reduce transfers 1024 bytes.
+  std::string first_table =
+      WriteSingleHostAllReduceTable("first.pbtxt", "sm_90", 1024);
+  std::string second_table =
+      WriteSingleHostAllReduceTable("second.pbtxt", "sm_90", 2048);
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<CollectiveInterpolator> interpolator,
+      CollectiveInterpolator::Create(
+          absl::StrCat(first_table, ",", second_table), device_info));
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto module, ParseAndReturnUnverifiedModule(kSingleHostAllReduceHlo));
+  HloCollectiveInstruction* instr = Cast<HloCollectiveInstruction>(
+      module->entry_computation()->root_instruction());
+
+  EXPECT_EQ(interpolator->EstimatedRuntime(*instr), absl::Milliseconds(500));
+}
+
+TEST(CollectiveInterpolatorTest, UsesTableOfOlderRevision) {
+  auto device_info = TestGpuDeviceInfo::RTXA6000DeviceInfo(
+      stream_executor::CudaComputeCapability(8, 6));
+  std::string table =
+      WriteSingleHostAllReduceTable("sm_80.pbtxt", "sm_80", 1024);
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<CollectiveInterpolator> interpolator,
+                          CollectiveInterpolator::Create(table, device_info));
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto module, ParseAndReturnUnverifiedModule(kSingleHostAllReduceHlo));
+  HloCollectiveInstruction* instr = Cast<HloCollectiveInstruction>(
+      module->entry_computation()->root_instruction());
+
+  EXPECT_EQ(interpolator->EstimatedRuntime(*instr), absl::Seconds(1));
+}
+
+TEST(CollectiveInterpolatorTest, FailsWithoutPerfTableForDevice) {
+  auto device_info = TestGpuDeviceInfo::RTXA6000DeviceInfo(
+      stream_executor::CudaComputeCapability(8, 6));
+  std::string table =
+      WriteSingleHostAllReduceTable("sm_90.pbtxt", "sm_90", 1024);
+
+  EXPECT_EQ(CollectiveInterpolator::Create(table, device_info).status().code(),
+            absl::StatusCode::kNotFound);
+}
+
 }  // namespace
 }  // namespace xla::gpu
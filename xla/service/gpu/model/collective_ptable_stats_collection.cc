@@ -16,14 +16,11 @@ limitations under the License.
 #include "xla/service/gpu/model/collective_ptable_stats_collection.h"
 
 #include <memory>
-#include <string>
 
 #include "absl/container/flat_hash_set.h"
 #include "absl/log/check.h"
 #include "absl/log/log.h"
-#include "absl/status/status.h"
 #include "absl/status/statusor.h"
-#include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "absl/time/time.h"
 #include "xla/hlo/ir/hlo_casting_utils.h"
@@ -33,43 +30,18 @@ limitations under the License.
 #include "xla/hlo/utils/hlo_query.h"
 #include "xla/service/gpu/backend_configs.pb.h"
 #include "xla/service/gpu/model/collective_interpolator.h"
-#include "xla/service/gpu/model/hlo_op_profile.pb.h"
-#include "xla/service/gpu/model/hlo_op_profiles.h"
 #include "xla/stream_executor/device_description.h"
-#include "xla/tsl/platform/env.h"
-#include "xla/tsl/platform/errors.h"
 #include "xla/tsl/platform/status.h"
 #include "xla/tsl/platform/statusor.h"
 
 namespace xla::gpu {
 
-namespace {
-
-absl::StatusOr<HloInstructionProfileList> CollectProfiles(
-    const std::string& perf_table_path,
-    const se::DeviceDescription& device_info) {
-  DeviceHloInstructionProfiles profile;
-
-  TF_RETURN_IF_ERROR(tsl::Env::Default()->FileExists(perf_table_path));
-  TF_RETURN_IF_ERROR(tsl::ReadTextOrBinaryProto(tsl::Env::Default(),
-                                                perf_table_path, &profile));
-  std::string key = HloOpProfiles::GetProfileName(device_info);
-
-  if (!profile.entries().contains(key)) {
-    return absl::NotFoundError(absl::StrCat("Cannot find key: ", key));
-  }
-  return profile.entries().at(key);
-}
-
-}  // namespace
-
 absl::StatusOr<bool> CollectivePerfTableStatsCollection::Run(
     HloModule* module,
     const absl::flat_hash_set<absl::string_view>& execution_threads) {
-  TF_ASSIGN_OR_RETURN(HloInstructionProfileList profiles,
-                      CollectProfiles(perf_table_path_, device_info_));
-  TF_ASSIGN_OR_RETURN(std::unique_ptr<CollectiveInterpolator> interpolator,
-                      CollectiveInterpolator::Create(profiles, device_info_));
+  TF_ASSIGN_OR_RETURN(
+      std::unique_ptr<CollectiveInterpolator> interpolator,
+      CollectiveInterpolator::Create(perf_table_path_, device_info_));
   hlo_query::ForEachInstructionWithPred(
       *module,
       [](const HloInstruction* instr) {
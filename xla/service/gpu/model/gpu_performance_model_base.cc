@@ -19,12 +19,16 @@ limitations under the License.
 #include <cmath>
 #include <cstdint>
 #include <optional>
+#include <string>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/log/check.h"
+#include "absl/functional/function_ref.h"
 #include "absl/log/log.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
 #include "absl/synchronization/mutex.h"
 #include "absl/time/time.h"
 #include "xla/backends/gpu/codegen/fusion_emitter.h"
@@ -32,6 +36,7 @@ limitations under the License.
 #include "xla/backends/gpu/codegen/triton/fusion.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/hlo/ir/hlo_print_options.h"
 #include "xla/hlo/utils/hlo_traversal.h"
 #include "xla/service/gpu/backend_configs.pb.h"
 #include "xla/service/gpu/hlo_fusion_analysis.h"
@@ -39,8 +44,10 @@ limitations under the License.
 #include "xla/service/gpu/model/gpu_hlo_cost_analysis.h"
 #include "xla/shape_util.h"
 #include "xla/stream_executor/device_description.h"
+#include "xla/tsl/platform/statusor.h"
 #include "xla/util.h"
 #include "xla/xla_data.pb.h"
+#include "tsl/platform/fingerprint.h"
 
 namespace xla {
 namespace gpu {
@@ -140,6 +147,33 @@ void GpuPerformanceModelCache::Invalidate(const HloInstruction& instruction) {
   }
 }
 
+absl::StatusOr<EstimateRunTimeData>
+GpuPerformanceModelFingerprintCache::GetOrEstimate(
+    const HloInstruction& instruction,
+    absl::FunctionRef<absl::StatusOr<EstimateRunTimeData>()> estimate) {
+  // The backend config holds the tiling of Triton fusions, which the estimate
+  // depends on.
+  std::string key = instruction.ToString(
+      HloPrintOptions::Fingerprint().set_print_backend_config(true));
+  // Operands are printed without their names, but the bytes accessed are
+  // looked up by the first index of each operand.
+  for (const HloInstruction* operand : instruction.operands()) {
+    absl::StrAppend(&key, ",", instruction.operand_index(operand));
+  }
+  const tsl::Fprint128 fingerprint = tsl::Fingerprint128(key);
+  {
+    absl::MutexLock lock(&mutex_);
+    auto it = runtime_data_.find(fingerprint);
+    if (it != runtime_data_.end()) {
+      return it->second;
+    }
+  }
+  TF_ASSIGN_OR_RETURN(EstimateRunTimeData runtime_data, estimate());
+  absl::MutexLock lock(&mutex_);
+  runtime_data_.emplace(fingerprint, runtime_data);
+  return runtime_data;
+}
+
 /*static*/
 LaunchDimensions GpuPerformanceModelBase::EstimateFusionLaunchDimensions(
     const HloFusionAnalysis& fusion_analysis) {
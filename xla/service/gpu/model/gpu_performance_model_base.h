@@ -22,6 +22,8 @@ limitations under the License.
 #include <string>
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/functional/function_ref.h"
+#include "absl/status/statusor.h"
 #include "absl/strings/str_format.h"
 #include "absl/synchronization/mutex.h"
 #include "absl/time/time.h"
@@ -32,6 +34,7 @@ limitations under the License.
 #include "xla/service/gpu/model/gpu_hlo_cost_analysis.h"
 #include "xla/stream_executor/device_description.h"
 #include "xla/xla_data.pb.h"
+#include "tsl/platform/fingerprint.h"
 
 namespace xla {
 namespace gpu {
@@ -126,6 +129,28 @@ class GpuPerformanceModelCache {
       fusion_runtime_data_;
 };
 
+// Caches runtime data for individual instructions by a fingerprint of the
+// instruction, including its fused computation and operand shapes. Unlike
+// GpuPerformanceModelCache, the entries outlive the instructions: identical
+// instructions share an estimate, also across passes over a changed module.
+//
+// Estimates depend on the device and on the cost analysis options, so a cache
+// must only be shared between users that have the same ones.
+class GpuPerformanceModelFingerprintCache {
+ public:
+  // Returns the cached runtime data for instructions identical to
+  // `instruction`, or computes it with `estimate` and caches it.
+  absl::StatusOr<EstimateRunTimeData> GetOrEstimate(
+      const HloInstruction& instruction,
+      absl::FunctionRef<absl::StatusOr<EstimateRunTimeData>()> estimate);
+
+ private:
+  absl::Mutex mutex_;
+
+  absl::flat_hash_map<tsl::Fprint128, EstimateRunTimeData, tsl::Fprint128Hasher>
+      runtime_data_;
+};
+
 struct GpuPerformanceModelOptions {
   // Factor for how much parallelism between compute and memory accesses should
   // be assumed. If 1.0, assume perfect parallelism (the run time is the maximum
@@ -18,6 +18,7 @@ limitations under the License.
 #include <memory>
 
 #include <gtest/gtest.h>
+#include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
 #include "xla/hlo/ir/hlo_computation.h"
 #include "xla/hlo/ir/hlo_instruction.h"
@@ -279,6 +280,39 @@ ENTRY e {
   EXPECT_EQ(launch_dimensions.num_threads_per_block(), 128);
 }
 
+TEST_F(GpuPerformanceModelBaseTest,
+       FingerprintCache_SharesEstimatesOfIdenticalInstructions) {
+  absl::string_view hlo_string = R"(
+HloModule m
+
+ENTRY entry_computation {
+  p0 = f32[8,16] parameter(0)
+  p1 = f32[8,16] parameter(1)
+  p2 = f32[16,8] parameter(2)
+  log0 = f32[8,16] log(p0)
+  log1 = f32[8,16] log(p1)
+  log2 = f32[16,8] log(p2)
+  ROOT tuple = (f32[8,16], f32[8,16], f32[16,8]) tuple(log0, log1, log2)
+}
+)";
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+  const HloInstruction* root = module->entry_computation()->root_instruction();
+
+  GpuPerformanceModelFingerprintCache cache;
+  int num_estimates = 0;
+  auto estimate = [&]() -> absl::StatusOr<EstimateRunTimeData> {
+    ++num_estimates;
+    return EstimateRunTimeData::Zero();
+  };
+
+  ASSERT_IS_OK(cache.GetOrEstimate(*root->operand(0), estimate).status());
+  ASSERT_IS_OK(cache.GetOrEstimate(*root->operand(1), estimate).status());
+  EXPECT_EQ(num_estimates, 1);
+  ASSERT_IS_OK(cache.GetOrEstimate(*root->operand(2), estimate).status());
+  EXPECT_EQ(num_estimates, 2);
+}
+
 }  // namespace
 }  // namespace gpu
 }  // namespace xla
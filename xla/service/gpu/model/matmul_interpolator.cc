@@ -19,6 +19,7 @@ limitations under the License.
 #include <cstdint>
 #include <memory>
 #include <optional>
+#include <string>
 #include <utility>
 
 #include "absl/algorithm/container.h"
@@ -27,6 +28,7 @@ limitations under the License.
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
 #include "absl/time/time.h"
 #include "xla/backends/gpu/codegen/triton/support.h"
 #include "xla/hlo/ir/hlo_casting_utils.h"
@@ -36,12 +38,17 @@ limitations under the License.
 #include "xla/service/gpu/backend_configs.pb.h"
 #include "xla/service/gpu/cublas_cudnn.h"
 #include "xla/service/gpu/model/hlo_op_profile.pb.h"
+#include "xla/service/gpu/model/hlo_op_profiles.h"
 #include "xla/service/gpu/model/interpolator.h"
+#include "xla/service/gpu/model/matmul_interpolator_data.h"
 #include "xla/shape.h"
 #include "xla/shape_util.h"
 #include "xla/stream_executor/device_description.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/errors.h"
 #include "xla/tsl/platform/statusor.h"
 #include "xla/util.h"
+#include "tsl/platform/protobuf.h"
 
 namespace xla::gpu {
 namespace {
@@ -143,8 +150,44 @@ InterpolationSpecification Spec(const HloFusionInstruction& dot_fusion) {
   return ExtractDotSpec(dot_dims, lhs_shape, rhs_shape);
 }
 
+absl::StatusOr<HloInstructionProfileList> ReadProfiles(
+    absl::string_view perf_table_path,
+    const se::DeviceDescription& device_info) {
+  DeviceHloInstructionProfiles profile;
+  if (perf_table_path.empty()) {
+    if (!tsl::protobuf::TextFormat::ParseFromString(kDefaultMatmulPTable,
+                                                    &profile)) {
+      return absl::FailedPreconditionError("Cannot parse a default profile.");
+    }
+  } else {
+    std::string path(perf_table_path);
+    TF_RETURN_IF_ERROR(tsl::Env::Default()->FileExists(path));
+    TF_RETURN_IF_ERROR(
+        tsl::ReadTextOrBinaryProto(tsl::Env::Default(), path, &profile));
+  }
+  std::string key = HloOpProfiles::GetProfileName(device_info);
+
+  if (!profile.entries().contains(key)) {
+    return absl::NotFoundError(absl::StrCat("Cannot find key: ", key));
+  }
+  return profile.entries().at(key);
+}
+
 }  // namespace
 
+/*static*/ absl::StatusOr<std::unique_ptr<MatmulInterpolator>>
+MatmulInterpolator::Create(absl::string_view perf_table_path,
+                           const se::DeviceDescription& device_info) {
+  TF_ASSIGN_OR_RETURN(HloInstructionProfileList profiles,
+                      ReadProfiles(perf_table_path, device_info));
+  return Create(profiles, device_info);
+}
+
+/*static*/ bool MatmulInterpolator::IsSupported(const HloInstruction& instr) {
+  return instr.opcode() == HloOpcode::kDot || IsCublasGemm(instr) ||
+         IsTritonGemm(instr);
+}
+
 /*static*/ absl::StatusOr<std::unique_ptr<MatmulInterpolator>>
 MatmulInterpolator::Create(const HloInstructionProfileList& profiles,
                            const se::DeviceDescription& device_info) {
@@ -22,6 +22,7 @@ limitations under the License.
 #include <utility>
 
 #include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
 #include "absl/time/time.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/service/gpu/model/hlo_op_profile.pb.h"
@@ -36,6 +37,18 @@ class MatmulInterpolator {
       const HloInstructionProfileList& profiles,
       const se::DeviceDescription& device_info);
 
+  // Creates an interpolator from the performance table for the GPU generation
+  // of `device_info`. The table is read from `perf_table_path` if it is not
+  // empty, and is the default table shipped with XLA otherwise. Returns
+  // NotFound if the table has no entries for the GPU generation.
+  static absl::StatusOr<std::unique_ptr<MatmulInterpolator>> Create(
+      absl::string_view perf_table_path,
+      const se::DeviceDescription& device_info);
+
+  // Returns whether `EstimatedRuntime` supports `instr`: dots, cuBLAS GEMMs and
+  // Triton GEMM fusions.
+  static bool IsSupported(const HloInstruction& instr);
+
   // Returns the estimated runtime for a supported `collective`.
   std::optional<absl::Duration> EstimatedRuntime(const HloInstruction& instr);
 
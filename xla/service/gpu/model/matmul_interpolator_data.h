@@ -0,0 +1,29 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_SERVICE_GPU_MODEL_MATMUL_INTERPOLATOR_DATA_H_
+#define XLA_SERVICE_GPU_MODEL_MATMUL_INTERPOLATOR_DATA_H_
+
+// Default matmul performance tables, keyed by GPU generation (e.g. "sm_90").
+// Tables for new GPU generations are added by merging the entries generated
+// via
+//
+//   bazel run --config=cuda -- //xla/tools:matmul_perf_table_gen_main
+//
+// on the corresponding hardware.
+constexpr char kDefaultMatmulPTable[] = R"pb(
+)pb";
+
+#endif  // XLA_SERVICE_GPU_MODEL_MATMUL_INTERPOLATOR_DATA_H_
@@ -25,6 +25,7 @@ limitations under the License.
 
 #include <gtest/gtest.h>
 #include "absl/log/check.h"
+#include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
 #include "absl/strings/substitute.h"
@@ -35,9 +36,14 @@ limitations under the License.
 #include "xla/hlo/parser/hlo_parser.h"
 #include "xla/service/gpu/gpu_device_info_for_tests.h"
 #include "xla/service/gpu/model/hlo_op_profile.pb.h"
+#include "xla/service/gpu/model/hlo_op_profiles.h"
 #include "xla/stream_executor/device_description.h"
+#include "xla/tsl/lib/core/status_test_util.h"
+#include "xla/tsl/platform/env.h"
 #include "xla/tsl/platform/statusor.h"
 #include "xla/xla_data.pb.h"
+#include "tsl/platform/path.h"
+#include "tsl/platform/protobuf.h"
 
 namespace xla::gpu {
 namespace {
@@ -303,16 +309,17 @@ class MatmulInterpolatorTest : public Test {
         clock_cycles: 1410000000
       }
     )pb";
-    HloInstructionProfileList profiles;
-    CHECK(tsl::protobuf::TextFormat::ParseFromString(perf_table, &profiles));
+    CHECK(tsl::protobuf::TextFormat::ParseFromString(perf_table, &profiles_));
     interpolator_ = *MatmulInterpolator::Create(
-        profiles, TestGpuDeviceInfo::RTXA6000DeviceInfo());
+        profiles_, TestGpuDeviceInfo::RTXA6000DeviceInfo());
   }
 
  protected:
+  const HloInstructionProfileList& profiles() const { return profiles_; }
   MatmulInterpolator& interpolator() { return *interpolator_; }
 
  private:
+  HloInstructionProfileList profiles_;
   std::unique_ptr<MatmulInterpolator> interpolator_;
 };
 
@@ -387,5 +394,50 @@ TEST_F(MatmulInterpolatorTest, SupportsDotTritonFusion) {
   EXPECT_EQ(*interpolator().EstimatedRuntime(custom_call), absl::Seconds(1));
 }
 
+TEST_F(MatmulInterpolatorTest, CreatesFromPerfTableFile) {
+  se::DeviceDescription device_info = TestGpuDeviceInfo::RTXA6000DeviceInfo();
+  DeviceHloInstructionProfiles device_profiles;
+  (*device_profiles.mutable_entries())[HloOpProfiles::GetProfileName(
+      device_info)] = profiles();
+  std::string perf_table_path =
+      tsl::io::JoinPath(::testing::TempDir(), "matmul_perf_table.pbtxt");
+  TF_ASSERT_OK(tsl::WriteTextProto(tsl::Env::Default(), perf_table_path,
+                                   device_profiles));
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<MatmulInterpolator> interpolator,
+      MatmulInterpolator::Create(perf_table_path, device_info));
+  absl::string_view hlo = R"(
+    HloModule m
+
+    ENTRY e {
+      lhs = bf16[1,1024,1024] parameter(0)
+      rhs = bf16[1,1024,1024] parameter(1)
+      ROOT _ = bf16[1,1024,1024] dot(lhs,rhs),
+       lhs_contracting_dims={2}, rhs_contracting_dims={1},
+       lhs_batch_dims={0}, rhs_batch_dims={0}
+    }
+)";
+  TF_ASSERT_OK_AND_ASSIGN(auto module, ParseAndReturnUnverifiedModule(hlo));
+  const HloInstruction& dot = *module->entry_computation()->root_instruction();
+  EXPECT_TRUE(MatmulInterpolator::IsSupported(dot));
+  EXPECT_EQ(*interpolator->EstimatedRuntime(dot), absl::Seconds(1));
+}
+
+TEST_F(MatmulInterpolatorTest, FailsWithoutPerfTableForDevice) {
+  se::DeviceDescription device_info = TestGpuDeviceInfo::RTXA6000DeviceInfo();
+  DeviceHloInstructionProfiles device_profiles;
+  (*device_profiles.mutable_entries())["unknown_gpu"] = profiles();
+  std::string perf_table_path = tsl::io::JoinPath(
+      ::testing::TempDir(), "matmul_perf_table_unknown_gpu.pbtxt");
+  TF_ASSERT_OK(tsl::WriteTextProto(tsl::Env::Default(), perf_table_path,
+                                   device_profiles));
+
+  EXPECT_EQ(MatmulInterpolator::Create(perf_table_path, device_info)
+                .status()
+                .code(),
+            absl::StatusCode::kNotFound);
+}
+
 }  // namespace
 }  // namespace xla::gpu
@@ -17,19 +17,26 @@ limitations under the License.
 
 #include <cstdint>
 #include <memory>
+#include <optional>
+#include <string>
 #include <utility>
 
 #include "absl/log/check.h"
 #include "absl/log/log.h"
+#include "absl/status/statusor.h"
 #include "absl/time/time.h"
 #include "xla/hlo/analysis/hlo_dataflow_analysis.h"
+#include "xla/hlo/ir/hlo_casting_utils.h"
 #include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_instructions.h"
 #include "xla/hlo/ir/hlo_opcode.h"
 #include "xla/hlo/utils/hlo_query.h"
 #include "xla/service/gpu/backend_configs.pb.h"
+#include "xla/service/gpu/model/collective_interpolator.h"
 #include "xla/service/gpu/model/gpu_hlo_cost_analysis.h"
 #include "xla/service/gpu/model/gpu_performance_model.h"
 #include "xla/service/gpu/model/gpu_performance_model_base.h"
+#include "xla/service/gpu/model/matmul_interpolator.h"
 #include "xla/service/gpu/model/sol_gpu_cost_model.h"
 #include "xla/service/hlo_cost_analysis.h"
 #include "xla/service/latency_hiding_scheduler.h"
@@ -158,6 +165,16 @@ LatencyEstimator::TimeCost SolLatencyEstimator::GetLatencyBetween(
   }
 
   if (IsAsyncPair(from, target)) {
+    if (std::optional<absl::Duration> table_time =
+            CollectivePerfTableTime(from.GetInstr());
+        table_time.has_value()) {
+      double coll_time = absl::ToDoubleMicroseconds(*table_time);
+      VLOG(10) << "[SoL] Collective perf table estimated latency between "
+               << from.GetInstr().name() << " and "
+               << target.GetInstr().name() << " to be: " << coll_time
+               << " us.";
+      return coll_time;
+    }
     double coll_time = absl::ToDoubleMicroseconds(
         ComputeCollectiveTime(from.GetInstr(), gpu_info_, shape_size_function_,
                               sol_flags_, *cost_analysis_));
@@ -169,6 +186,20 @@ LatencyEstimator::TimeCost SolLatencyEstimator::GetLatencyBetween(
   return latency_estimator_->GetLatencyBetween(from, target);
 }
 
+std::optional<absl::Duration> SolLatencyEstimator::CollectivePerfTableTime(
+    const HloInstruction& instr) const {
+  if (collective_interpolator_ == nullptr ||
+      !CollectiveInterpolator::IsSupported(instr)) {
+    return std::nullopt;
+  }
+  const HloInstruction* collective = &instr;
+  if (instr.opcode() == HloOpcode::kAsyncStart) {
+    collective = instr.async_wrapped_instruction();
+  }
+  return collective_interpolator_->EstimatedRuntime(
+      *Cast<HloCollectiveInstruction>(collective));
+}
+
 LatencyEstimator::TimeCost SolLatencyEstimator::NodeCost(
     const HloInstruction* instr) const {
   if (hlo_query::IsAsyncCollectiveStartOp(instr, /*include_send_recv=*/true) ||
@@ -176,6 +207,19 @@ LatencyEstimator::TimeCost SolLatencyEstimator::NodeCost(
     return kLowCost;
   }
 
+  if (matmul_interpolator_ != nullptr &&
+      MatmulInterpolator::IsSupported(*instr)) {
+    if (std::optional<absl::Duration> matmul_time =
+            matmul_interpolator_->EstimatedRuntime(*instr);
+        matmul_time.has_value()) {
+      LatencyEstimator::TimeCost cost_in_us =
+          absl::ToDoubleMicroseconds(*matmul_time);
+      VLOG(10) << "Matmul perf table estimated cost for: " << instr->name()
+               << ". Cost: " << cost_in_us;
+      return cost_in_us;
+    }
+  }
+
   absl::Duration total_estimated_time =
       GpuPerformanceModel::EstimateRunTimeForInstruction(
           instr, gpu_info_, &*cost_analysis_,
@@ -212,6 +256,35 @@ SolLatencyEstimator::SolLatencyEstimator(
       sol_flags_.rtt == absl::ZeroDuration() || sol_flags_.gpus_per_node == 0) {
     LOG(WARNING) << "[SoL] Failed to parse SoL system config options.";
   }
+  const std::string& matmul_perf_table_path =
+      computation->parent()
+          ->config()
+          .debug_options()
+          .xla_gpu_experimental_matmul_perf_table_path();
+  absl::StatusOr<std::unique_ptr<MatmulInterpolator>> matmul_interpolator =
+      MatmulInterpolator::Create(matmul_perf_table_path, gpu_info_);
+  if (matmul_interpolator.ok()) {
+    matmul_interpolator_ = *std::move(matmul_interpolator);
+  } else {
+    VLOG(1) << "[SoL] No matmul perf table, falling back to the analytical "
+               "model for matmuls: "
+            << matmul_interpolator.status();
+  }
+  const std::string& collective_perf_table_paths =
+      computation->parent()
+          ->config()
+          .debug_options()
+          .xla_gpu_experimental_collective_perf_table_path();
+  absl::StatusOr<std::unique_ptr<CollectiveInterpolator>>
+      collective_interpolator =
+          CollectiveInterpolator::Create(collective_perf_table_paths, gpu_info_);
+  if (collective_interpolator.ok()) {
+    collective_interpolator_ = *std::move(collective_interpolator);
+  } else {
+    VLOG(1) << "[SoL] No collective perf table, falling back to the "
+               "analytical model for collectives: "
+            << collective_interpolator.status();
+  }
 }
 
 }  // namespace gpu
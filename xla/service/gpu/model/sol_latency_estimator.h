@@ -22,7 +22,9 @@ limitations under the License.
 #include "absl/time/time.h"
 #include "xla/hlo/ir/hlo_computation.h"
 #include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/service/gpu/model/collective_interpolator.h"
 #include "xla/service/gpu/model/gpu_hlo_cost_analysis.h"
+#include "xla/service/gpu/model/matmul_interpolator.h"
 #include "xla/service/gpu/model/sol_gpu_cost_model.h"
 #include "xla/service/hlo_cost_analysis.h"
 #include "xla/service/latency_hiding_scheduler.h"
@@ -63,12 +65,23 @@ class SolLatencyEstimator : public LatencyEstimator {
   static constexpr TimeCost kLowLatency = 1.0;
 
  private:
+  // Returns the runtime of the async collective started by `instr` estimated
+  // from performance tables, if they cover it.
+  std::optional<absl::Duration> CollectivePerfTableTime(
+      const HloInstruction& instr) const;
+
   const SchedulerConfig config_;
   const se::DeviceDescription& gpu_info_;
   std::optional<GpuHloCostAnalysis> cost_analysis_;
   std::unique_ptr<LatencyEstimator> latency_estimator_;
   HloCostAnalysis::ShapeSizeFunction shape_size_function_;
   const SolGPUCostModel::Config sol_flags_;
+  // Estimates matmul run times from measured performance tables. Null if no
+  // table is available for the GPU.
+  std::unique_ptr<MatmulInterpolator> matmul_interpolator_;
+  // Estimates collective run times from measured performance tables. Null if
+  // no table is available for the GPU.
+  std::unique_ptr<CollectiveInterpolator> collective_interpolator_;
 };
 
 }  // namespace gpu
@@ -532,6 +532,11 @@ absl::StatusOr<int64_t> GetRealRootIndex(
           root_indexing.GetRealRoot(), root_indexing.real_root_indexing));
 
   std::vector<SymbolicTiledHloInstruction*> worklist = {root_tiled_hlo};
+  // An instruction that is reached with different indexing maps has several
+  // tiled instructions, but its output to input indexing does not depend on
+  // the tiling, so it is only computed once.
+  absl::flat_hash_map<const HloInstruction*, HloInstructionIndexing>
+      operands_indexing_cache;
 
   while (!worklist.empty()) {
     auto tiled_hlo_instruction = worklist.back();
@@ -543,9 +548,14 @@ absl::StatusOr<int64_t> GetRealRootIndex(
       continue;
     }
 
-    HloInstructionIndexing operands_indexing =
-        ComputeOutputToInputIndexing(tiled_hlo_instruction->hlo(),
-                                     /*output_id=*/0, ctx);
+    auto [operands_indexing_it, inserted_indexing] =
+        operands_indexing_cache.try_emplace(tiled_hlo_instruction->hlo());
+    if (inserted_indexing) {
+      operands_indexing_it->second = ComputeOutputToInputIndexing(
+          tiled_hlo_instruction->hlo(), /*output_id=*/0, ctx);
+    }
+    const HloInstructionIndexing& operands_indexing =
+        operands_indexing_it->second;
 
     for (auto [operand, operand_indexing_map_set] :
          llvm::zip(instruction_adaptor.GetOperands(),
@@ -1139,27 +1149,39 @@ std::vector<SymbolicTileAnalysis::Tiling> GetGoodTilings(
     std::function<bool(absl::Span<const int64_t>)> is_valid) {
   CHECK(is_valid != nullptr);
 
+  std::vector<std::vector<int64_t>> possible_tile_sizes;
+  possible_tile_sizes.reserve(dim_sizes.size());
+  for (int64_t dim_size : dim_sizes) {
+    possible_tile_sizes.push_back(PossibleTileSizesForOneDimension(dim_size));
+  }
+
+  // Enumerates the tilings in lexicographic order of the indices into
+  // `possible_tile_sizes` and checks each one as it is created, so that the
+  // invalid tilings of the cartesian product are never stored.
   std::vector<SymbolicTileAnalysis::Tiling> tilings;
-  tilings.push_back({});
-  for (int dim_size : dim_sizes) {
-    std::vector<int64_t> possible_tile_sizes =
-        PossibleTileSizesForOneDimension(dim_size);
-    std::vector<SymbolicTileAnalysis::Tiling> extended_tilings;
-    extended_tilings.reserve(tilings.size() * possible_tile_sizes.size());
-    for (const SymbolicTileAnalysis::Tiling& tiling : tilings) {
-      for (int64_t tile_size : possible_tile_sizes) {
-        SymbolicTileAnalysis::Tiling extended_tiling = tiling;
-        extended_tiling.push_back(tile_size);
-        extended_tilings.push_back(extended_tiling);
+  std::vector<size_t> indices(dim_sizes.size(), 0);
+  SymbolicTileAnalysis::Tiling tiling(dim_sizes.size());
+  while (true) {
+    for (size_t dim = 0; dim < indices.size(); ++dim) {
+      tiling[dim] = possible_tile_sizes[dim][indices[dim]];
+    }
+    if (is_valid(tiling)) {
+      tilings.push_back(tiling);
+    }
+    // Advance to the next tiling, with the minor-most dimension varying
+    // fastest.
+    int64_t dim = static_cast<int64_t>(indices.size()) - 1;
+    for (; dim >= 0; --dim) {
+      if (++indices[dim] < possible_tile_sizes[dim].size()) {
+        break;
       }
+      indices[dim] = 0;
+    }
+    if (dim < 0) {
+      break;
     }
-    tilings = std::move(extended_tilings);
   }
 
-  tilings.erase(
-      std::remove_if(tilings.begin(), tilings.end(), std::not_fn(is_valid)),
-      tilings.end());
-
   return tilings;
 }
 }  // namespace detail
@@ -1182,6 +1204,10 @@ SymbolicTileAnalysis::GetGoodTilings() const {
   absl::Status status = absl::OkStatus();
   std::vector<SymbolicTileAnalysis::Tiling> result = detail::GetGoodTilings(
       shape.dimensions(), [&](absl::Span<const int64_t> tile_sizes) {
+        // Don't check the remaining tilings once one of them failed.
+        if (!status.ok()) {
+          return false;
+        }
         absl::StatusOr<bool> is_valid =
             ParametersSatisfyConstraints(tile_sizes);
         if (!is_valid.ok()) {
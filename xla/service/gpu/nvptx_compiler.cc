@@ -354,7 +354,8 @@ absl::Status NVPTXCompiler::AddConvAndGemmAutotuningPasses(
   // 'is_autotuning_compilation' set to true.
   if (!std::get<se::CudaComputeCapability>(gpu_version).IsAtLeastAmpere() ||
       options.is_autotuning_compilation) {
-    pipeline->AddPass<GemmAlgorithmPicker>(autotune_config);
+    pipeline->AddPass<GemmAlgorithmPicker>(autotune_config,
+                                           options.key_value_store);
   }
   return absl::OkStatus();
 }
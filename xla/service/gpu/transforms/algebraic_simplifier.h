@@ -92,6 +92,15 @@ class GpuAlgebraicSimplifier : public AlgebraicSimplifier {
     return changed;
   }
 
+  absl::Status RunOnChangedComputations(
+      HloModule* module, RunState* run_state,
+      const absl::flat_hash_set<absl::string_view>& execution_threads)
+      override {
+    GpuAlgebraicSimplifierVisitor visitor(options_, compute_capability_, this);
+    return RunVisitorOnChangedComputations(visitor, module, run_state,
+                                           execution_threads);
+  }
+
  private:
   se::GpuComputeCapability compute_capability_;
 };
@@ -27,6 +27,7 @@ limitations under the License.
 #include "absl/container/btree_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/strings/string_view.h"
+#include "absl/time/time.h"
 #include "absl/types/span.h"
 #include "xla/hlo/ir/hlo_casting_utils.h"
 #include "xla/hlo/ir/hlo_instruction.h"
@@ -66,6 +67,8 @@ std::vector<HloInstruction*> GetOutputs(HloInstruction& instruction) {
 struct DecomposedReplicaGroups {
   std::vector<ReplicaGroup> scatter_gather_groups;
   std::vector<ReplicaGroup> new_all_reduce_groups;
+  // True if every scatter-gather group only contains devices of one host.
+  bool scatter_gather_within_host = true;
 };
 
 // Returns the global device id for the given replica id. Returns nullopt if
@@ -148,7 +151,9 @@ absl::StatusOr<std::optional<DecomposedReplicaGroups>> TryDecomposeReplicaGroup(
   }
 
   return {DecomposedReplicaGroups{std::move(scatter_gather_groups),
-                                  std::move(new_all_reduce_groups)}};
+                                  std::move(new_all_reduce_groups),
+                                  /*scatter_gather_within_host=*/
+                                  num_local_devices > 1}};
 }
 
 absl::StatusOr<std::optional<DecomposedReplicaGroups>>
@@ -174,6 +179,7 @@ TryDecomposeReplicaGroups(const HloAllReduceInstruction& all_reduce,
 
   std::vector<ReplicaGroup> scatter_gather_groups;
   std::vector<ReplicaGroup> new_all_reduce_groups;
+  bool scatter_gather_within_host = true;
 
   // Try to find a valid decomposition for each replica group.
   for (const ReplicaGroup& replica_group : replica_groups) {
@@ -214,10 +220,72 @@ TryDecomposeReplicaGroups(const HloAllReduceInstruction& all_reduce,
                  std::back_inserter(scatter_gather_groups));
     absl::c_move(decomposed_groups->new_all_reduce_groups,
                  std::back_inserter(new_all_reduce_groups));
+    scatter_gather_within_host &= decomposed_groups->scatter_gather_within_host;
   }
 
   return {DecomposedReplicaGroups{std::move(scatter_gather_groups),
-                                  std::move(new_all_reduce_groups)}};
+                                  std::move(new_all_reduce_groups),
+                                  scatter_gather_within_host}};
+}
+
+// Returns the estimated time of a ring collective between `num_devices`
+// devices that sends `fraction` of `num_bytes` over every link.
+absl::Duration RingCollectiveTime(int64_t num_devices, int64_t num_bytes,
+                                  double fraction, double bandwidth_gbps,
+                                  absl::Duration latency) {
+  double steps = static_cast<double>(num_devices - 1) / num_devices;
+  return latency +
+         absl::Seconds(fraction * steps * num_bytes / (bandwidth_gbps * 1e9));
+}
+
+// Returns true if the decomposition is estimated to be faster than the original
+// all-reduce, using a simple bandwidth-latency model of ring collectives. The
+// original all-reduce spans multiple hosts, so it is bound by the inter-host
+// bandwidth, while the reduce-scatter and all-gather stages only use the fast
+// interconnect if their groups are contained within a host.
+bool IsDecompositionProfitable(const HloAllReduceInstruction& all_reduce,
+                               const DecomposedReplicaGroups& groups,
+                               const AllReduceBlueConnect::Topology& topology) {
+  if (topology.intra_host_bandwidth_gbps <= 0 ||
+      topology.inter_host_bandwidth_gbps <= 0) {
+    return true;
+  }
+
+  int64_t num_bytes = 0;
+  for (const HloInstruction* operand : all_reduce.operands()) {
+    num_bytes += ShapeUtil::ByteSizeOf(operand->shape());
+  }
+
+  int64_t scatter_group_size =
+      groups.scatter_gather_groups[0].replica_ids_size();
+  int64_t all_reduce_group_size =
+      groups.new_all_reduce_groups[0].replica_ids_size();
+  int64_t group_size = scatter_group_size * all_reduce_group_size;
+
+  double stage_bandwidth_gbps = groups.scatter_gather_within_host
+                                    ? topology.intra_host_bandwidth_gbps
+                                    : topology.inter_host_bandwidth_gbps;
+
+  absl::Duration original_time = RingCollectiveTime(
+      group_size, num_bytes, /*fraction=*/2, topology.inter_host_bandwidth_gbps,
+      topology.collective_latency);
+
+  // Reduce-scatter and all-gather within the scatter-gather groups.
+  absl::Duration scatter_gather_time =
+      2 * RingCollectiveTime(scatter_group_size, num_bytes, /*fraction=*/1,
+                             stage_bandwidth_gbps,
+                             topology.collective_latency);
+  // All-reduce of the scattered shards between hosts.
+  absl::Duration decomposed_time =
+      scatter_gather_time +
+      RingCollectiveTime(all_reduce_group_size, num_bytes / scatter_group_size,
+                         /*fraction=*/2, topology.inter_host_bandwidth_gbps,
+                         topology.collective_latency);
+
+  VLOG(2) << "All-reduce " << all_reduce.name() << " of " << num_bytes
+          << " bytes: estimated time " << original_time
+          << ", decomposed estimated time " << decomposed_time;
+  return decomposed_time < original_time;
 }
 
 // Attempts to decompose all-reduces as described by the BlueConnect paper.
@@ -234,8 +302,9 @@ TryDecomposeReplicaGroups(const HloAllReduceInstruction& all_reduce,
 //
 // When applied repeatedly, this transformation will reproduce the same pattern
 // as described in the BlueConnect paper.
-absl::StatusOr<bool> TryDecomposeAllReduce(HloAllReduceInstruction* all_reduce,
-                                           size_t num_devices_per_host) {
+absl::StatusOr<bool> TryDecomposeAllReduce(
+    HloAllReduceInstruction* all_reduce,
+    const AllReduceBlueConnect::Topology& topology) {
   TF_RET_CHECK(all_reduce);
   TF_RET_CHECK(!all_reduce->has_sharding());
 
@@ -244,10 +313,14 @@ absl::StatusOr<bool> TryDecomposeAllReduce(HloAllReduceInstruction* all_reduce,
 
   TF_ASSIGN_OR_RETURN(
       std::optional<DecomposedReplicaGroups> decomposed_groups,
-      TryDecomposeReplicaGroups(*all_reduce, num_devices_per_host));
+      TryDecomposeReplicaGroups(*all_reduce, topology.num_devices_per_host));
 
   if (!decomposed_groups) return false;
 
+  if (!IsDecompositionProfitable(*all_reduce, *decomposed_groups, topology)) {
+    return false;
+  }
+
   // Bitcast operands to 1D to guarantee that first dimension is divisible by
   // scatter group size (we checked num elements was divisible above).
   std::vector<HloInstruction*> flat_operands;
@@ -324,7 +397,7 @@ absl::StatusOr<bool> TryDecomposeAllReduce(HloAllReduceInstruction* all_reduce,
   // Try to apply decomposition recursively.
   TF_RETURN_IF_ERROR(
       TryDecomposeAllReduce(Cast<HloAllReduceInstruction>(new_all_reduce),
-                            num_devices_per_host)
+                            topology)
           .status());
   return true;
 }
@@ -363,7 +436,7 @@ absl::StatusOr<bool> AllReduceBlueConnect::Run(
   for (HloAllReduceInstruction* all_reduce : all_reduces) {
     TF_ASSIGN_OR_RETURN(
         bool all_reduce_changed,
-        TryDecomposeAllReduce(all_reduce, num_devices_per_host_));
+        TryDecomposeAllReduce(all_reduce, topology_));
     changed |= all_reduce_changed;
   }
 
@@ -21,6 +21,7 @@ limitations under the License.
 #include "absl/container/flat_hash_set.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
+#include "absl/time/time.h"
 #include "xla/hlo/ir/hlo_module.h"
 #include "xla/hlo/pass/hlo_pass_interface.h"
 
@@ -37,8 +38,29 @@ namespace xla {
 // that host IDs are ordered corresponding to network hierarchy.
 class AllReduceBlueConnect : public HloModulePass {
  public:
+  // Describes the two levels of the network hierarchy that all-reduces are
+  // decomposed for.
+  struct Topology {
+    // Number of consecutive devices that share the fast interconnect (e.g.
+    // NVLink). With multi-host NVLink slices this spans several hosts.
+    size_t num_devices_per_host = 0;
+
+    // Bus bandwidths (in GB/s) of the fast interconnect within a host and of
+    // the network between hosts. If either is not set, all-reduces are
+    // decomposed whenever the replica groups allow it. Otherwise a
+    // decomposition is only applied if it is estimated to be faster than the
+    // original all-reduce.
+    double intra_host_bandwidth_gbps = 0;
+    double inter_host_bandwidth_gbps = 0;
+
+    // Fixed latency of a single collective, paid once per stage.
+    absl::Duration collective_latency = absl::ZeroDuration();
+  };
+
   explicit AllReduceBlueConnect(size_t num_devices_per_host)
-      : num_devices_per_host_(num_devices_per_host) {}
+      : topology_{num_devices_per_host} {}
+
+  explicit AllReduceBlueConnect(Topology topology) : topology_(topology) {}
 
   absl::string_view name() const override { return "all-reduce-blueconnect"; }
 
@@ -48,7 +70,7 @@ class AllReduceBlueConnect : public HloModulePass {
       const absl::flat_hash_set<absl::string_view>& execution_threads) override;
 
  private:
-  size_t num_devices_per_host_;
+  Topology topology_;
 };
 
 }  // namespace xla
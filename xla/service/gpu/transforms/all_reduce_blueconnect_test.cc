@@ -25,6 +25,7 @@ limitations under the License.
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "absl/strings/string_view.h"
+#include "absl/time/time.h"
 #include "absl/types/span.h"
 #include "xla/hlo/ir/hlo_computation.h"
 #include "xla/hlo/ir/hlo_instruction.h"
@@ -322,6 +323,76 @@ ENTRY %comp {
   EXPECT_THAT(pass.Run(module.get()), IsOkAndHolds(false));
 }
 
+AllReduceBlueConnect::Topology GetTopologyWithBandwidths() {
+  AllReduceBlueConnect::Topology topology;
+  topology.num_devices_per_host = 4;
+  topology.intra_host_bandwidth_gbps = 320;
+  topology.inter_host_bandwidth_gbps = 25;
+  topology.collective_latency = absl::Microseconds(5);
+  return topology;
+}
+
+TEST_F(AllReduceBlueConnectTest, LatencyBoundAllReduceIsNotDecomposed) {
+  constexpr absl::string_view hlo_string = R"(
+HloModule module
+
+%add {
+  lhs = f32[] parameter(0)
+  rhs = f32[] parameter(1)
+  ROOT add = f32[] add(lhs, rhs)
+}
+
+ENTRY %comp {
+  p0 = f32[4,4] parameter(0)
+  ROOT crs = f32[4,4] all-reduce(p0), to_apply=add
+})";
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+  SetModuleConfig(*module, /*replica_count=*/8);
+
+  // Three collectives cost more than the bandwidth saved on 64 bytes.
+  AllReduceBlueConnect pass(GetTopologyWithBandwidths());
+  EXPECT_THAT(pass.Run(module.get()), IsOkAndHolds(false));
+}
+
+TEST_F(AllReduceBlueConnectTest, BandwidthBoundAllReduceIsDecomposed) {
+  constexpr absl::string_view hlo_string = R"(
+HloModule module
+
+%add {
+  lhs = f32[] parameter(0)
+  rhs = f32[] parameter(1)
+  ROOT add = f32[] add(lhs, rhs)
+}
+
+ENTRY %comp {
+  p0 = f32[1024,1024] parameter(0)
+  ROOT crs = f32[1024,1024] all-reduce(p0), to_apply=add
+})";
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+  SetModuleConfig(*module, /*replica_count=*/8);
+
+  AllReduceBlueConnect pass(GetTopologyWithBandwidths());
+  EXPECT_THAT(pass.Run(module.get()), IsOkAndHolds(true));
+
+  // clang-format off
+  std::vector<std::vector<int64_t>> scatter_gather_groups = {
+      {0, 1, 2, 3}, {4, 5, 6, 7}};
+  std::vector<std::vector<int64_t>> new_all_reduce_groups = {
+      {0, 4}, {1, 5}, {2, 6}, {3, 7}};
+  // clang-format on
+
+  auto reduce_scatter = m::ReduceScatter(m::Bitcast(m::Parameter(0)))
+                            .WithReplicaGroups(scatter_gather_groups);
+  auto all_reduce =
+      m::AllReduce(reduce_scatter).WithReplicaGroups(new_all_reduce_groups);
+  auto all_gather =
+      m::AllGather(all_reduce).WithReplicaGroups(scatter_gather_groups);
+  EXPECT_THAT(module->entry_computation()->root_instruction(),
+              GmockMatch(m::Bitcast(all_gather)));
+}
+
 TEST_F(AllReduceBlueConnectTest, ControlDeps) {
   constexpr absl::string_view hlo_string = R"(
 HloModule module
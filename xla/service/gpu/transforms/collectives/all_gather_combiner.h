@@ -18,9 +18,11 @@ limitations under the License.
 
 #include <cstdint>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_computation.h"
 #include "xla/hlo/ir/hlo_module.h"
 #include "xla/hlo/pass/hlo_pass_interface.h"
 #include "xla/hlo/transforms/collectives/all_gather_combiner.h"
@@ -52,10 +54,17 @@ class GpuAllGatherCombiner : public AllGatherCombiner {
       HloModule* module,
       const absl::flat_hash_set<absl::string_view>& execution_threads) override;
 
+ protected:
+  int64_t CombineThresholdInBytes(
+      const HloComputation& computation) const override;
+
  private:
   const se::DeviceDescription& device_info_;
   const int default_combine_threshold_in_bytes_;
   int64_t pointer_size_;
+  // Memory left on the device while each computation runs. Populated only
+  // while `Run` picks thresholds by itself.
+  absl::flat_hash_map<const HloComputation*, int64_t> memory_headroom_;
 };
 
 }  // namespace xla::gpu
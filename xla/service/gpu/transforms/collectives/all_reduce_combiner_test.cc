@@ -423,6 +423,39 @@ TEST_F(GpuAllReduceCombinerTest,
   EXPECT_THAT(combiner.Run(module.get()), IsOkAndHolds(false));
 }
 
+TEST_F(GpuAllReduceCombinerTest,
+       DoNotCombineCollectivesBeyondMemoryHeadroom) {
+  absl::string_view kHloText = R"(
+    HloModule m
+
+    add {
+      p0 = f16[] parameter(0)
+      p1 = f16[] parameter(1)
+      ROOT add = f16[] add(p0, p1)
+    }
+
+    ENTRY main {
+      p0 = f16[10000]{0} parameter(0)
+      p1 = f16[10000]{0} parameter(1)
+      ar0 = f16[10000]{0} all-reduce(p0), replica_groups={}, to_apply=add
+      ar1 = f16[10000]{0} all-reduce(p1), replica_groups={}, to_apply=add
+      ROOT result = tuple(ar0, ar1)
+    }
+  )";
+  DeviceDescription device_info;
+  // Available memory is 95000 bytes, the peak is 80008 bytes. The headroom of
+  // the entry computation is below the size of a single all-reduce.
+  device_info.set_device_memory_size(100000);
+
+  TF_ASSERT_OK_AND_ASSIGN(auto module, ParseAndReturnVerifiedModule(kHloText));
+  GpuAllReduceCombiner combiner(
+      device_info, /*default_combine_threshold_in_bytes=*/
+      kDefaultAllReduceCombineThreshold,
+      /*combine_threshold_in_bytes=*/kDefaultAllReduceCombineThreshold,
+      /*combine_threshold_count=*/256, /*pointer_size=*/4);
+  EXPECT_THAT(combiner.Run(module.get()), IsOkAndHolds(false));
+}
+
 }  // namespace
 
 }  // namespace xla::gpu
@@ -0,0 +1,423 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/service/gpu/transforms/collectives/all_reduce_quantizer.h"
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "xla/hlo/ir/hlo_casting_utils.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_instructions.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/hlo/utils/hlo_query.h"
+#include "xla/map_util.h"
+#include "xla/primitive_util.h"
+#include "xla/service/call_graph.h"
+#include "xla/service/collective_ops_utils.h"
+#include "xla/service/hlo_creation_utils.h"
+#include "xla/service/hlo_module_config.h"
+#include "xla/service/while_util.h"
+#include "xla/shape.h"
+#include "xla/shape_util.h"
+#include "xla/tsl/platform/errors.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/util.h"
+#include "xla/xla_data.pb.h"
+
+namespace xla::gpu {
+namespace {
+
+// Sizes of the rewrite of one collective. The operand of N elements is split
+// into G shards of M elements, each padded to K blocks of the block size.
+struct QuantizationPlan {
+  int64_t group_size;
+  int64_t num_elements;
+  int64_t shard_size;
+  int64_t num_blocks;
+};
+
+struct QuantizedValues {
+  HloInstruction* values;
+  HloInstruction* scales;
+};
+
+using Collective = std::pair<HloAllReduceInstructionBase*, QuantizationPlan>;
+
+float MaxQuantizedValue(PrimitiveType type) {
+  switch (type) {
+    case S8:
+      return 127.0f;
+    case F8E4M3FN:
+      return 448.0f;
+    case F8E5M2:
+      return 57344.0f;
+    default:
+      LOG(FATAL) << "Unsupported quantized type: "
+                 << primitive_util::LowercasePrimitiveTypeName(type);
+  }
+}
+
+// Returns the number of devices in each group of `ar`, if the all-to-alls and
+// all-gathers of the rewrite form the same groups. That is the case for
+// cross-replica collectives, and for collectives with flattened ids on a
+// single replica, whose ids are partition ids.
+std::optional<int64_t> GetGroupSize(const HloAllReduceInstructionBase& ar,
+                                    const HloModuleConfig& config) {
+  bool cross_replica = !ar.channel_id().has_value();
+  bool cross_partition = ar.channel_id().has_value() &&
+                         ar.use_global_device_ids() &&
+                         config.replica_count() == 1;
+  if (!cross_replica && !cross_partition) {
+    return std::nullopt;
+  }
+  if (ar.replica_groups().empty()) {
+    return cross_replica ? config.replica_count() : config.num_partitions();
+  }
+  int64_t group_size = ar.replica_groups().front().replica_ids_size();
+  for (const ReplicaGroup& group : ar.replica_groups()) {
+    if (group.replica_ids_size() != group_size) {
+      return std::nullopt;
+    }
+  }
+  return group_size;
+}
+
+std::optional<QuantizationPlan> GetQuantizationPlan(
+    const HloInstruction& instr, const AllReduceQuantizer::Options& options,
+    const HloModuleConfig& config) {
+  if (instr.opcode() != HloOpcode::kAllReduce &&
+      instr.opcode() != HloOpcode::kReduceScatter) {
+    return std::nullopt;
+  }
+  const auto& ar = *Cast<HloAllReduceInstructionBase>(&instr);
+  if (ar.operand_count() != 1 || !ar.shape().IsArray() ||
+      ar.shape().is_dynamic() || ar.constrain_layout()) {
+    return std::nullopt;
+  }
+  PrimitiveType type = ar.shape().element_type();
+  if (type != BF16 && type != F32) {
+    return std::nullopt;
+  }
+  if (MatchReductionComputation(ar.to_apply()) != ReductionKind::SUM) {
+    return std::nullopt;
+  }
+  const Shape& operand_shape = ar.operand(0)->shape();
+  if (ShapeUtil::ByteSizeOf(operand_shape) < options.min_size_in_bytes) {
+    return std::nullopt;
+  }
+  std::optional<int64_t> group_size = GetGroupSize(ar, config);
+  if (!group_size.has_value() || *group_size <= 1) {
+    return std::nullopt;
+  }
+  // The shards of a reduce-scatter have to be contiguous in the flattened
+  // operand.
+  if (auto* rs = DynCast<HloReduceScatterInstruction>(&ar)) {
+    for (int64_t i = 0; i < rs->scatter_dimension(); ++i) {
+      if (operand_shape.dimensions(i) != 1) {
+        return std::nullopt;
+      }
+    }
+  }
+  int64_t num_elements = ShapeUtil::ElementsIn(operand_shape);
+  int64_t shard_size = CeilOfRatio(num_elements, *group_size);
+  return QuantizationPlan{
+      /*group_size=*/*group_size,
+      /*num_elements=*/num_elements,
+      /*shard_size=*/shard_size,
+      /*num_blocks=*/CeilOfRatio(shard_size, options.block_size),
+  };
+}
+
+std::vector<int64_t> MajorDimensions(const Shape& shape) {
+  std::vector<int64_t> dims(shape.dimensions().size() - 1);
+  std::iota(dims.begin(), dims.end(), 0);
+  return dims;
+}
+
+// Pads the minor dimension of the f32 `operand` with zeros to `size`.
+absl::StatusOr<HloInstruction*> PadMinor(HloInstruction* operand,
+                                         int64_t size) {
+  int64_t minor = operand->shape().dimensions().size() - 1;
+  int64_t padding = size - operand->shape().dimensions(minor);
+  if (padding == 0) {
+    return operand;
+  }
+  PaddingConfig config =
+      MakeNoPaddingConfig(operand->shape().dimensions().size());
+  config.mutable_dimensions(minor)->set_edge_padding_high(padding);
+  return MakePadHlo(operand,
+                    MakeR0ConstantHlo<float>(operand->parent(), 0.0f), config);
+}
+
+// Slices the minor dimension of `operand` to its first `size` elements.
+absl::StatusOr<HloInstruction*> SliceMinor(HloInstruction* operand,
+                                           int64_t size) {
+  int64_t rank = operand->shape().dimensions().size();
+  if (operand->shape().dimensions(rank - 1) == size) {
+    return operand;
+  }
+  std::vector<int64_t> limits(operand->shape().dimensions().begin(),
+                              operand->shape().dimensions().end());
+  limits.back() = size;
+  return MakeSliceHlo(operand, std::vector<int64_t>(rank, 0), limits,
+                      std::vector<int64_t>(rank, 1));
+}
+
+// Quantizes the f32 `blocks` to `type`, with one scale per block along the
+// minor dimension.
+absl::StatusOr<QuantizedValues> Quantize(HloInstruction* blocks,
+                                         PrimitiveType type) {
+  HloComputation* computation = blocks->parent();
+  const Shape& shape = blocks->shape();
+  int64_t minor = shape.dimensions().size() - 1;
+
+  TF_ASSIGN_OR_RETURN(HloInstruction * abs,
+                      MakeUnaryHlo(HloOpcode::kAbs, blocks));
+  TF_ASSIGN_OR_RETURN(
+      HloInstruction * amax,
+      MakeReduceHlo(abs, MakeR0ConstantHlo<float>(computation, 0.0f), {minor},
+                    HloOpcode::kMaximum));
+  TF_ASSIGN_OR_RETURN(
+      HloInstruction * scales,
+      MakeBinaryHlo(HloOpcode::kDivide, amax,
+                    MakeBroadcastHlo(MakeR0ConstantHlo<float>(
+                                         computation, MaxQuantizedValue(type)),
+                                     {}, amax->shape())));
+  // Blocks of zeros get the smallest normal scale instead of zero.
+  TF_ASSIGN_OR_RETURN(
+      scales,
+      MakeBinaryHlo(
+          HloOpcode::kMaximum, scales,
+          MakeBroadcastHlo(MakeR0ConstantHlo<float>(
+                               computation, std::numeric_limits<float>::min()),
+                           {}, scales->shape())));
+  TF_ASSIGN_OR_RETURN(
+      HloInstruction * scaled,
+      MakeBinaryHlo(HloOpcode::kDivide, blocks,
+                    MakeBroadcastHlo(scales, MajorDimensions(shape), shape)));
+  if (primitive_util::IsIntegralType(type)) {
+    TF_ASSIGN_OR_RETURN(scaled,
+                        MakeUnaryHlo(HloOpcode::kRoundNearestEven, scaled));
+  }
+  return QuantizedValues{MakeConvertToHlo(scaled, type), scales};
+}
+
+absl::StatusOr<HloInstruction*> Dequantize(const QuantizedValues& quantized) {
+  HloInstruction* values = MakeConvertToHlo(quantized.values, F32);
+  return MakeBinaryHlo(
+      HloOpcode::kMultiply, values,
+      MakeBroadcastHlo(quantized.scales, MajorDimensions(values->shape()),
+                       values->shape()));
+}
+
+// Rewrites `ar` according to `plan`. If `residual` is not null, it holds the
+// quantization error of the previous iteration of the enclosing loop, and the
+// quantization error of this iteration is returned. Returns null otherwise.
+absl::StatusOr<HloInstruction*> QuantizeCollective(
+    HloAllReduceInstructionBase* ar, const QuantizationPlan& plan,
+    const AllReduceQuantizer::Options& options, HloInstruction* residual,
+    int64_t& next_channel_id) {
+  HloComputation* computation = ar->parent();
+  const int64_t g = plan.group_size;
+  const int64_t k = plan.num_blocks;
+  const int64_t b = options.block_size;
+  auto channel_id = [&]() -> std::optional<int64_t> {
+    if (!ar->channel_id().has_value()) {
+      return std::nullopt;
+    }
+    return next_channel_id++;
+  };
+
+  HloInstruction* x = MakeConvertToHlo(ar->mutable_operand(0), F32);
+  TF_ASSIGN_OR_RETURN(x, MakeReshapeHlo({plan.num_elements}, x));
+  TF_ASSIGN_OR_RETURN(x, PadMinor(x, g * plan.shard_size));
+  TF_ASSIGN_OR_RETURN(x, MakeReshapeHlo({g, plan.shard_size}, x));
+  TF_ASSIGN_OR_RETURN(x, PadMinor(x, k * b));
+  TF_ASSIGN_OR_RETURN(HloInstruction * blocks, MakeReshapeHlo({g, k, b}, x));
+  if (residual != nullptr) {
+    TF_ASSIGN_OR_RETURN(blocks,
+                        MakeBinaryHlo(HloOpcode::kAdd, blocks, residual));
+  }
+
+  TF_ASSIGN_OR_RETURN(QuantizedValues local,
+                      Quantize(blocks, options.quantized_type));
+  HloInstruction* next_residual = nullptr;
+  if (residual != nullptr) {
+    TF_ASSIGN_OR_RETURN(HloInstruction * dequantized, Dequantize(local));
+    TF_ASSIGN_OR_RETURN(
+        next_residual,
+        MakeBinaryHlo(HloOpcode::kSubtract, blocks, dequantized));
+  }
+
+  // Row i of the exchanged blocks holds the i-th device's values of our shard.
+  auto all_to_all = [&](HloInstruction* operand) {
+    return computation->AddInstruction(HloInstruction::CreateAllToAll(
+        operand->shape(), {operand}, ar->device_list(),
+        /*constrain_layout=*/false, channel_id(), /*split_dimension=*/0));
+  };
+  TF_ASSIGN_OR_RETURN(HloInstruction * exchanged,
+                      Dequantize({all_to_all(local.values),
+                                  all_to_all(local.scales)}));
+  TF_ASSIGN_OR_RETURN(
+      HloInstruction * partial,
+      MakeReduceHlo(exchanged, MakeR0ConstantHlo<float>(computation, 0.0f),
+                    {0}, HloOpcode::kAdd));
+
+  HloInstruction* result;
+  if (ar->opcode() == HloOpcode::kReduceScatter) {
+    TF_ASSIGN_OR_RETURN(result, MakeReshapeHlo({k * b}, partial));
+    TF_ASSIGN_OR_RETURN(result, SliceMinor(result, plan.shard_size));
+  } else {
+    TF_ASSIGN_OR_RETURN(QuantizedValues shard,
+                        Quantize(partial, options.quantized_type));
+    TF_ASSIGN_OR_RETURN(shard.values, MakeReshapeHlo({1, k, b}, shard.values));
+    TF_ASSIGN_OR_RETURN(shard.scales, MakeReshapeHlo({1, k}, shard.scales));
+    auto all_gather = [&](HloInstruction* operand) {
+      Shape shape = operand->shape();
+      shape.set_dimensions(0, g);
+      return computation->AddInstruction(HloInstruction::CreateAllGather(
+          shape, {operand}, /*all_gather_dimension=*/0, ar->device_list(),
+          /*constrain_layout=*/false, channel_id(),
+          ar->use_global_device_ids()));
+    };
+    TF_ASSIGN_OR_RETURN(result, Dequantize({all_gather(shard.values),
+                                            all_gather(shard.scales)}));
+    TF_ASSIGN_OR_RETURN(result, MakeReshapeHlo({g, k * b}, result));
+    TF_ASSIGN_OR_RETURN(result, SliceMinor(result, plan.shard_size));
+    TF_ASSIGN_OR_RETURN(result, MakeReshapeHlo({g * plan.shard_size}, result));
+    TF_ASSIGN_OR_RETURN(result, SliceMinor(result, plan.num_elements));
+  }
+  TF_ASSIGN_OR_RETURN(
+      result,
+      MakeReshapeHlo(ShapeUtil::ChangeElementType(ar->shape(), F32), result));
+  result = MakeConvertToHlo(result, ar->shape().element_type());
+
+  VLOG(1) << "Quantized " << ar->name() << " to "
+          << primitive_util::LowercasePrimitiveTypeName(options.quantized_type)
+          << (residual != nullptr ? " with error feedback" : "");
+  TF_RETURN_IF_ERROR(computation->ReplaceInstruction(ar, result));
+  return next_residual;
+}
+
+// Returns the while loop with body `computation` if it is the only caller of
+// `computation`, and null otherwise.
+HloInstruction* GetWhileOfBody(const HloComputation* computation) {
+  std::unique_ptr<CallGraph> call_graph =
+      CallGraph::Build(computation->parent());
+  const std::vector<CallSite>& callsites =
+      call_graph->GetNode(computation).caller_callsites();
+  if (callsites.size() != 1) {
+    return nullptr;
+  }
+  HloInstruction* caller = callsites.front().instruction();
+  if (caller->opcode() != HloOpcode::kWhile ||
+      caller->while_body() != computation || !caller->shape().IsTuple()) {
+    return nullptr;
+  }
+  return caller;
+}
+
+// Quantizes `collectives` of the body of `while_instr`, adding one element with
+// the quantization error of each to the loop state.
+absl::Status QuantizeCollectivesWithErrorFeedback(
+    HloInstruction* while_instr, absl::Span<const Collective> collectives,
+    const AllReduceQuantizer::Options& options, int64_t& next_channel_id) {
+  HloComputation* parent = while_instr->parent();
+  std::vector<HloInstruction*> initial_residuals;
+  for (const auto& [ar, plan] : collectives) {
+    Shape shape = ShapeUtil::MakeShape(
+        F32, {plan.group_size, plan.num_blocks, options.block_size});
+    initial_residuals.push_back(MakeBroadcastHlo(
+        MakeR0ConstantHlo<float>(parent, 0.0f), {}, shape));
+  }
+
+  std::string backend_config = while_instr->raw_backend_config_string();
+  TF_ASSIGN_OR_RETURN(
+      WhileUtil::MakeInstructionsLiveInResult live_in,
+      WhileUtil::MakeInstructionsLiveIn(while_instr, initial_residuals));
+  live_in.new_while_instr->set_raw_backend_config_string(backend_config);
+
+  HloInstruction* root =
+      live_in.new_while_instr->while_body()->root_instruction();
+  int64_t first_residual = root->operand_count() - collectives.size();
+  for (int64_t i = 0; i < collectives.size(); ++i) {
+    auto* ar = Cast<HloAllReduceInstructionBase>(
+        FindOrDie(live_in.while_body_instruction_map, collectives[i].first));
+    TF_ASSIGN_OR_RETURN(
+        HloInstruction * residual,
+        QuantizeCollective(ar, collectives[i].second, options,
+                           live_in.while_body_live_in_values[i],
+                           next_channel_id));
+    TF_RETURN_IF_ERROR(root->ReplaceOperandWith(first_residual + i, residual));
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace
+
+absl::StatusOr<bool> AllReduceQuantizer::Run(
+    HloModule* module,
+    const absl::flat_hash_set<absl::string_view>& execution_threads) {
+  int64_t next_channel_id = hlo_query::NextChannelId(*module);
+  bool changed = false;
+  for (HloComputation* computation :
+       module->MakeNonfusionComputations(execution_threads)) {
+    std::vector<Collective> collectives;
+    for (HloInstruction* instr : computation->instructions()) {
+      if (std::optional<QuantizationPlan> plan =
+              GetQuantizationPlan(*instr, options_, module->config());
+          plan.has_value()) {
+        collectives.push_back(
+            {Cast<HloAllReduceInstructionBase>(instr), *plan});
+      }
+    }
+    if (collectives.empty()) {
+      continue;
+    }
+    changed = true;
+
+    HloInstruction* while_instr =
+        options_.error_feedback ? GetWhileOfBody(computation) : nullptr;
+    if (while_instr != nullptr) {
+      TF_RETURN_IF_ERROR(QuantizeCollectivesWithErrorFeedback(
+          while_instr, collectives, options_, next_channel_id));
+      continue;
+    }
+    for (const auto& [ar, plan] : collectives) {
+      TF_RETURN_IF_ERROR(QuantizeCollective(ar, plan, options_,
+                                            /*residual=*/nullptr,
+                                            next_channel_id)
+                             .status());
+    }
+  }
+  return changed;
+}
+
+}  // namespace xla::gpu
@@ -0,0 +1,80 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_SERVICE_GPU_TRANSFORMS_COLLECTIVES_ALL_REDUCE_QUANTIZER_H_
+#define XLA_SERVICE_GPU_TRANSFORMS_COLLECTIVES_ALL_REDUCE_QUANTIZER_H_
+
+#include <cstdint>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/pass/hlo_pass_interface.h"
+#include "xla/xla_data.pb.h"
+
+namespace xla::gpu {
+
+// Compresses the payloads of bf16 and f32 sum all-reduces and reduce-scatters
+// to a narrow type with one f32 scale per block of elements. Unlike
+// `CollectiveQuantizer`, this changes numerics and is therefore opt-in.
+//
+// An all-reduce over groups of G devices
+//
+//   ar = f32[N] all-reduce(x), to_apply=add
+//
+// is rewritten into
+//
+//   q, s = quantize(x)                            // s8[G,K,B], f32[G,K]
+//   partial = reduce(dequantize(all-to-all(q), all-to-all(s)), dims={0}, add)
+//   q', s' = quantize(partial)                    // s8[K,B], f32[K]
+//   ar = dequantize(all-gather(q'), all-gather(s'))
+//
+// where B is the block size and K the number of blocks of each of the G
+// shards of x. Partial sums are accumulated in f32. A reduce-scatter is
+// rewritten into the first half, up to `partial`.
+//
+// With `error_feedback`, collectives in while loop bodies add the quantization
+// error of the previous iteration to `x` before quantizing it. The error is
+// carried in an extra element of the loop state, so that it does not
+// accumulate across iterations, e.g. training steps.
+class AllReduceQuantizer : public HloModulePass {
+ public:
+  struct Options {
+    // S8, F8E4M3FN or F8E5M2.
+    PrimitiveType quantized_type = S8;
+    // Number of elements sharing a scale.
+    int64_t block_size = 256;
+    // Collectives with smaller payloads are latency bound and left alone.
+    int64_t min_size_in_bytes = 1 << 20;
+    bool error_feedback = false;
+  };
+
+  explicit AllReduceQuantizer(Options options) : options_(options) {}
+
+  absl::string_view name() const override { return "all-reduce-quantizer"; }
+
+  using HloPassInterface::Run;
+  absl::StatusOr<bool> Run(
+      HloModule* module,
+      const absl::flat_hash_set<absl::string_view>& execution_threads) override;
+
+ private:
+  Options options_;
+};
+
+}  // namespace xla::gpu
+
+#endif  // XLA_SERVICE_GPU_TRANSFORMS_COLLECTIVES_ALL_REDUCE_QUANTIZER_H_
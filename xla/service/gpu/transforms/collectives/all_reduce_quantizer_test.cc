@@ -0,0 +1,245 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/service/gpu/transforms/collectives/all_reduce_quantizer.h"
+
+#include <cstdint>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/algorithm/container.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/hlo/testlib/hlo_hardware_independent_test_base.h"
+#include "xla/shape_util.h"
+#include "xla/tsl/lib/core/status_test_util.h"
+#include "xla/tsl/platform/status_matchers.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/xla_data.pb.h"
+
+namespace xla::gpu {
+namespace {
+
+using ::tsl::testing::IsOkAndHolds;
+
+class AllReduceQuantizerTest : public HloHardwareIndependentTestBase {
+ protected:
+  absl::StatusOr<bool> RunAllReduceQuantizer(HloModule* module,
+                                             bool error_feedback = false) {
+    AllReduceQuantizer::Options options;
+    options.block_size = 128;
+    options.min_size_in_bytes = 0;
+    options.error_feedback = error_feedback;
+    return RunHloPass(AllReduceQuantizer(options), module);
+  }
+};
+
+int64_t CountOpcode(const HloComputation* computation, HloOpcode opcode) {
+  return absl::c_count_if(
+      computation->instructions(),
+      [&](const HloInstruction* instr) { return instr->opcode() == opcode; });
+}
+
+TEST_F(AllReduceQuantizerTest, QuantizesAllReduce) {
+  absl::string_view kHloText = R"(
+    HloModule m, replica_count=4
+
+    add {
+      x = f32[] parameter(0)
+      y = f32[] parameter(1)
+      ROOT _ = f32[] add(x, y)
+    }
+
+    ENTRY main {
+      p = f32[1000] parameter(0)
+      ROOT ar = f32[1000] all-reduce(p), replica_groups={{0,1,2,3}},
+        to_apply=add
+    }
+  )";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          ParseAndReturnVerifiedModule(kHloText, 4));
+  EXPECT_THAT(RunAllReduceQuantizer(module.get()), IsOkAndHolds(true));
+  TF_ASSERT_OK(verifier().Run(module.get()).status());
+
+  const HloComputation* entry = module->entry_computation();
+  EXPECT_EQ(CountOpcode(entry, HloOpcode::kAllReduce), 0);
+  EXPECT_EQ(CountOpcode(entry, HloOpcode::kAllToAll), 2);
+  EXPECT_EQ(CountOpcode(entry, HloOpcode::kAllGather), 2);
+  for (const HloInstruction* instr : entry->instructions()) {
+    // 1000 elements are split into 4 shards of 2 blocks of 128 elements.
+    if (instr->opcode() == HloOpcode::kAllToAll &&
+        instr->shape().element_type() == S8) {
+      EXPECT_TRUE(ShapeUtil::Equal(instr->shape(),
+                                   ShapeUtil::MakeShape(S8, {4, 2, 128})));
+    }
+  }
+  EXPECT_TRUE(ShapeUtil::Compatible(entry->root_instruction()->shape(),
+                                    ShapeUtil::MakeShape(F32, {1000})));
+}
+
+TEST_F(AllReduceQuantizerTest, QuantizesReduceScatter) {
+  absl::string_view kHloText = R"(
+    HloModule m, replica_count=4
+
+    add {
+      x = bf16[] parameter(0)
+      y = bf16[] parameter(1)
+      ROOT _ = bf16[] add(x, y)
+    }
+
+    ENTRY main {
+      p = bf16[8,256] parameter(0)
+      ROOT rs = bf16[2,256] reduce-scatter(p), replica_groups={{0,1,2,3}},
+        dimensions={0}, to_apply=add
+    }
+  )";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          ParseAndReturnVerifiedModule(kHloText, 4));
+  EXPECT_THAT(RunAllReduceQuantizer(module.get()), IsOkAndHolds(true));
+  TF_ASSERT_OK(verifier().Run(module.get()).status());
+
+  const HloComputation* entry = module->entry_computation();
+  EXPECT_EQ(CountOpcode(entry, HloOpcode::kReduceScatter), 0);
+  EXPECT_EQ(CountOpcode(entry, HloOpcode::kAllToAll), 2);
+  EXPECT_EQ(CountOpcode(entry, HloOpcode::kAllGather), 0);
+  EXPECT_TRUE(ShapeUtil::Compatible(entry->root_instruction()->shape(),
+                                    ShapeUtil::MakeShape(BF16, {2, 256})));
+}
+
+TEST_F(AllReduceQuantizerTest, SkipsUnsupportedCollectives) {
+  absl::string_view kHloText = R"(
+    HloModule m, replica_count=4
+
+    add {
+      x = f32[] parameter(0)
+      y = f32[] parameter(1)
+      ROOT _ = f32[] add(x, y)
+    }
+
+    max {
+      x = f32[] parameter(0)
+      y = f32[] parameter(1)
+      ROOT _ = f32[] maximum(x, y)
+    }
+
+    ENTRY main {
+      p0 = f32[1024] parameter(0)
+      p1 = f32[2,8] parameter(1)
+      ar_max = f32[1024] all-reduce(p0), replica_groups={{0,1,2,3}},
+        to_apply=max
+      rs_minor = f32[2,2] reduce-scatter(p1), replica_groups={{0,1,2,3}},
+        dimensions={1}, to_apply=add
+      ROOT t = (f32[1024], f32[2,2]) tuple(ar_max, rs_minor)
+    }
+  )";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          ParseAndReturnVerifiedModule(kHloText, 4));
+  EXPECT_THAT(RunAllReduceQuantizer(module.get()), IsOkAndHolds(false));
+}
+
+TEST_F(AllReduceQuantizerTest, SkipsSmallCollectivesByDefault) {
+  absl::string_view kHloText = R"(
+    HloModule m, replica_count=4
+
+    add {
+      x = f32[] parameter(0)
+      y = f32[] parameter(1)
+      ROOT _ = f32[] add(x, y)
+    }
+
+    ENTRY main {
+      p = f32[1024] parameter(0)
+      ROOT ar = f32[1024] all-reduce(p), replica_groups={{0,1,2,3}},
+        to_apply=add
+    }
+  )";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          ParseAndReturnVerifiedModule(kHloText, 4));
+  EXPECT_THAT(RunHloPass(AllReduceQuantizer(AllReduceQuantizer::Options()),
+                         module.get()),
+              IsOkAndHolds(false));
+}
+
+TEST_F(AllReduceQuantizerTest, AddsErrorFeedbackToWhileLoopState) {
+  absl::string_view kHloText = R"(
+    HloModule m, replica_count=4
+
+    add {
+      x = f32[] parameter(0)
+      y = f32[] parameter(1)
+      ROOT _ = f32[] add(x, y)
+    }
+
+    body {
+      p = (s32[], f32[1000]) parameter(0)
+      i = s32[] get-tuple-element(p), index=0
+      g = f32[1000] get-tuple-element(p), index=1
+      ar = f32[1000] all-reduce(g), replica_groups={{0,1,2,3}}, to_apply=add
+      one = s32[] constant(1)
+      next = s32[] add(i, one)
+      ROOT t = (s32[], f32[1000]) tuple(next, ar)
+    }
+
+    cond {
+      p = (s32[], f32[1000]) parameter(0)
+      i = s32[] get-tuple-element(p), index=0
+      n = s32[] constant(10)
+      ROOT lt = pred[] compare(i, n), direction=LT
+    }
+
+    ENTRY main {
+      p0 = f32[1000] parameter(0)
+      zero = s32[] constant(0)
+      init = (s32[], f32[1000]) tuple(zero, p0)
+      w = (s32[], f32[1000]) while(init), condition=cond, body=body
+      ROOT r = f32[1000] get-tuple-element(w), index=1
+    }
+  )";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          ParseAndReturnVerifiedModule(kHloText, 4));
+  EXPECT_THAT(RunAllReduceQuantizer(module.get(), /*error_feedback=*/true),
+              IsOkAndHolds(true));
+  TF_ASSERT_OK(verifier().Run(module.get()).status());
+
+  const HloInstruction* while_instr = nullptr;
+  for (const HloInstruction* instr :
+       module->entry_computation()->instructions()) {
+    if (instr->opcode() == HloOpcode::kWhile) {
+      while_instr = instr;
+    }
+  }
+  ASSERT_NE(while_instr, nullptr);
+  ASSERT_EQ(while_instr->shape().tuple_shapes_size(), 3);
+  EXPECT_TRUE(ShapeUtil::Equal(while_instr->shape().tuple_shapes(2),
+                               ShapeUtil::MakeShape(F32, {4, 2, 128})));
+
+  const HloComputation* body = while_instr->while_body();
+  EXPECT_EQ(CountOpcode(body, HloOpcode::kAllReduce), 0);
+  EXPECT_EQ(CountOpcode(body, HloOpcode::kAllToAll), 2);
+  EXPECT_EQ(body->root_instruction()->operand(2)->opcode(),
+            HloOpcode::kSubtract);
+}
+
+}  // namespace
+}  // namespace xla::gpu
@@ -13,18 +13,30 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <algorithm>
 #include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "xla/hlo/analysis/hlo_alias_analysis.h"
+#include "xla/hlo/ir/hlo_computation.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_module.h"
 #include "xla/hlo/ir/hlo_opcode.h"
 #include "xla/hlo/ir/hlo_schedule.h"
+#include "xla/hlo/utils/hlo_live_range.h"
 #include "xla/service/collective_ops_utils.h"
 #include "xla/service/collective_utils.h"
 #include "xla/service/gpu/backend_configs.pb.h"
 #include "xla/service/gpu/gpu_hlo_schedule.h"
+#include "xla/service/hlo_buffer.h"
+#include "xla/service/hlo_value.h"
+#include "xla/shape_util.h"
 #include "xla/stream_executor/device_description.h"
 #include "xla/util.h"
 
@@ -71,6 +83,77 @@ int64_t ComputeSuggestedCombinerThreshold(
   return MaxAvailableMemory(module, device_info) - peak_memory_bytes;
 }
 
+absl::flat_hash_map<const HloComputation*, int64_t>
+ComputeMemoryHeadroomPerComputation(const HloModule& module,
+                                    const se::DeviceDescription& device_info,
+                                    int64_t pointer_size) {
+  absl::flat_hash_map<const HloComputation*, int64_t> headroom;
+  int64_t max_available_memory = MaxAvailableMemory(module, device_info);
+  if (max_available_memory <= 0) {
+    return headroom;
+  }
+
+  absl::StatusOr<HloSchedule> schedule =
+      ScheduleGpuModuleWithMemoryScheduler(&module, pointer_size);
+  if (!schedule.ok()) {
+    VLOG(1) << "Cannot schedule module: " << schedule.status().message();
+    return headroom;
+  }
+  absl::StatusOr<std::unique_ptr<HloAliasAnalysis>> alias_analysis =
+      HloAliasAnalysis::Run(&module);
+  if (!alias_analysis.ok()) {
+    VLOG(1) << "Cannot run alias analysis: "
+            << alias_analysis.status().message();
+    return headroom;
+  }
+  absl::StatusOr<std::unique_ptr<HloLiveRange>> live_range = HloLiveRange::Run(
+      *schedule, **alias_analysis, module.entry_computation());
+  if (!live_range.ok()) {
+    VLOG(1) << "Cannot compute live ranges: "
+            << live_range.status().message();
+    return headroom;
+  }
+
+  // Live bytes at every step of the flattened schedule. Values of a buffer
+  // alias each other and are counted once over their joint live range.
+  int64_t num_times = (*live_range)->schedule_end_time() + 1;
+  std::vector<int64_t> live_bytes(num_times + 1, 0);
+  for (const HloBuffer& buffer : (*alias_analysis)->buffers()) {
+    HloLiveRange::LogicalTime start =
+        std::numeric_limits<HloLiveRange::LogicalTime>::max();
+    HloLiveRange::LogicalTime end = -1;
+    int64_t size = 0;
+    for (const HloValue* value : buffer.values()) {
+      auto it = (*live_range)->buffer_live_ranges().find(value);
+      if (it == (*live_range)->buffer_live_ranges().end()) {
+        continue;
+      }
+      start = std::min(start, it->second.start);
+      end = std::max(end, it->second.end);
+      size =
+          std::max(size, ShapeUtil::ByteSizeOf(value->shape(), pointer_size));
+    }
+    if (end < start) {
+      continue;
+    }
+    live_bytes[std::clamp<int64_t>(start, 0, num_times)] += size;
+    live_bytes[std::clamp<int64_t>(end + 1, 0, num_times)] -= size;
+  }
+  for (int64_t time = 1; time < num_times; ++time) {
+    live_bytes[time] += live_bytes[time - 1];
+  }
+
+  for (const auto& [computation, span] :
+       (*live_range)->computation_span_times()) {
+    int64_t start = std::clamp<int64_t>(span.start, 0, num_times - 1);
+    int64_t end = std::clamp<int64_t>(span.end, start, num_times - 1);
+    int64_t peak_bytes = *std::max_element(live_bytes.begin() + start,
+                                           live_bytes.begin() + end + 1);
+    headroom[computation] = max_available_memory - peak_bytes;
+  }
+  return headroom;
+}
+
 absl::Status AppendPipelinedInstruction(HloInstruction* instr,
                                         HloInstruction* new_while_instr) {
   if (!IsCollective(instr)) {
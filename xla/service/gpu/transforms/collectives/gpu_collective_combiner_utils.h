@@ -18,7 +18,9 @@ limitations under the License.
 
 #include <cstdint>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/status/status.h"
+#include "xla/hlo/ir/hlo_computation.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_module.h"
 #include "xla/hlo/ir/hlo_opcode.h"
@@ -40,6 +42,18 @@ int64_t ComputeSuggestedCombinerThreshold(
     const HloModule& module, const se::DeviceDescription& device_info,
     HloOpcode collective_opcode, int64_t pointer_size);
 
+// Returns, for every computation of a memory schedule of `module`, the memory
+// still available on a device while the computation runs: the max available
+// memory minus the peak of live bytes over the part of the schedule spanned by
+// the computation. Combining collectives in a computation by no more than its
+// headroom keeps the peak of the module within the device memory limit.
+// Returns an empty map if the device memory size is unknown or the module
+// cannot be scheduled.
+absl::flat_hash_map<const HloComputation*, int64_t>
+ComputeMemoryHeadroomPerComputation(const HloModule& module,
+                                    const se::DeviceDescription& device_info,
+                                    int64_t pointer_size);
+
 // Adds information that `instr` has been pipelined to the
 // `CollectiveBackendInfo`. It is up to the caller to decide when to invoke
 // this.
@@ -19,8 +19,10 @@ limitations under the License.
 #include <optional>
 
 #include <gtest/gtest.h>
+#include "absl/container/flat_hash_map.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_computation.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_opcode.h"
 #include "xla/hlo/pass/hlo_pass_fix.h"
@@ -98,6 +100,57 @@ TEST_F(CollectiveCombinerUtilsTest,
   EXPECT_EQ(suggested_threshold, 6712);
 }
 
+TEST_F(CollectiveCombinerUtilsTest,
+       ComputeMemoryHeadroomPerComputationSubtractsPeakOfComputation) {
+  absl::string_view kHloText = R"(
+  HloModule m
+
+  ENTRY ar {
+    p0 = f32[32,32] parameter(0)
+    p1 = f32[32,32] parameter(1)
+
+    ROOT _ = f32[32,32]{1,0} custom-call(p0, p1),
+      custom_call_target="__cublas$gemm"
+  })";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto module, ParseAndReturnVerifiedModule(kHloText));
+  int pointer_size = 4;
+  stream_executor::DeviceDescription device_info;
+  device_info.set_device_memory_size(20000);
+
+  absl::flat_hash_map<const HloComputation*, int64_t> headroom =
+      ComputeMemoryHeadroomPerComputation(*module, device_info, pointer_size);
+
+  // device size = 20000 bytes
+  // slop factor = 0.95
+  // peak memory = parameters + output = (2*32*32 + 32*32) * 4 bytes = 12288
+  // headroom = device size * slop factor - peak memory
+  ASSERT_TRUE(headroom.contains(module->entry_computation()));
+  EXPECT_EQ(headroom.at(module->entry_computation()), 6712);
+}
+
+TEST_F(CollectiveCombinerUtilsTest,
+       ComputeMemoryHeadroomPerComputationIsEmptyForUnknownDeviceMemory) {
+  absl::string_view kHloText = R"(
+  HloModule m
+
+  ENTRY ar {
+    p0 = f32[32,32] parameter(0)
+    p1 = f32[32,32] parameter(1)
+
+    ROOT _ = f32[32,32]{1,0} custom-call(p0, p1),
+      custom_call_target="__cublas$gemm"
+  })";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto module, ParseAndReturnVerifiedModule(kHloText));
+  int pointer_size = 4;
+  stream_executor::DeviceDescription device_info;
+
+  EXPECT_TRUE(
+      ComputeMemoryHeadroomPerComputation(*module, device_info, pointer_size)
+          .empty());
+}
+
 TEST_F(CollectiveCombinerUtilsTest,
        AppendPipelinedInstructionAppendsPipelinedInstructionInfoForward) {
   // This is just a canonical IR which makes it easy to pipeline a collective
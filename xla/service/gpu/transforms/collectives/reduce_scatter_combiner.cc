@@ -15,11 +15,14 @@ limitations under the License.
 
 #include "xla/service/gpu/transforms/collectives/reduce_scatter_combiner.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <optional>
 
 #include "absl/container/flat_hash_set.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_computation.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_opcode.h"
 #include "xla/service/gpu/backend_configs.pb.h"
@@ -61,6 +64,8 @@ std::optional<ReduceScatterCombiner::GroupKey> SynchronousCombinerKey(
 absl::StatusOr<bool> GpuReduceScatterCombiner::Run(
     HloModule* module,
     const absl::flat_hash_set<absl::string_view>& execution_threads) {
+  memory_headroom_.clear();
+
   // Combiner threshold is specified. Running parent pass code.
   if (combine_threshold_in_bytes_ != default_combine_threshold_in_bytes_) {
     return ReduceScatterCombiner::Run(module, execution_threads);
@@ -82,12 +87,22 @@ absl::StatusOr<bool> GpuReduceScatterCombiner::Run(
     changed |= combined;
   }
 
+  // Combining extends the live ranges of operands and results. From here on
+  // thresholds are capped per computation by the memory left on the device
+  // while it runs, so that combining does not push the peak past the limit.
+  memory_headroom_ =
+      ComputeMemoryHeadroomPerComputation(*module, device_info_, pointer_size_);
+
   // If there are no pipelined instructions in the IR, the optimizations below
   // do not kick in anyway.
   if (ContainsPipelinedInstruction(*module)) {
     // Combine as much as possible for pipelined collectives.
-    combine_threshold_in_bytes_ = ComputeSuggestedCombinerThreshold(
-        *module, device_info_, HloOpcode::kReduceScatter, pointer_size_);
+    combine_threshold_in_bytes_ =
+        memory_headroom_.empty()
+            ? ComputeSuggestedCombinerThreshold(*module, device_info_,
+                                                HloOpcode::kReduceScatter,
+                                                pointer_size_)
+            : MaxAvailableMemory(*module, device_info_);
     TF_ASSIGN_OR_RETURN(
         bool combined,
         RunWithKeyCombiner(module, execution_threads, PipelinedCombinerKey));
@@ -100,7 +115,17 @@ absl::StatusOr<bool> GpuReduceScatterCombiner::Run(
   TF_ASSIGN_OR_RETURN(bool combined_rest,
                       ReduceScatterCombiner::Run(module, execution_threads));
   changed |= combined_rest;
+  memory_headroom_.clear();
   return changed;
 }
 
+int64_t GpuReduceScatterCombiner::CombineThresholdInBytes(
+    const HloComputation& computation) const {
+  auto it = memory_headroom_.find(&computation);
+  if (it == memory_headroom_.end()) {
+    return combine_threshold_in_bytes_;
+  }
+  return std::min(combine_threshold_in_bytes_, it->second);
+}
+
 }  // namespace xla::gpu
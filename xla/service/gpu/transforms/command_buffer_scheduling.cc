@@ -31,6 +31,7 @@ limitations under the License.
 #include "absl/container/inlined_vector.h"
 #include "absl/status/status.h"
 #include "absl/strings/string_view.h"
+#include "absl/time/time.h"
 #include "absl/types/span.h"
 #include "xla/ffi/ffi_api.h"
 #include "xla/hlo/ir/hlo_casting_utils.h"
@@ -44,6 +45,9 @@ limitations under the License.
 #include "xla/service/gpu/cublas_cudnn.h"
 #include "xla/service/gpu/hlo_fusion_analysis.h"
 #include "xla/service/gpu/ir_emission_utils.h"
+#include "xla/service/gpu/model/gpu_hlo_cost_analysis.h"
+#include "xla/service/gpu/model/gpu_performance_model.h"
+#include "xla/service/gpu/model/gpu_performance_model_base.h"
 #include "xla/service/overload.h"
 #include "xla/shape.h"
 #include "xla/shape_util.h"
@@ -532,6 +536,46 @@ CommandBufferScheduling::CollectCommandBufferSequences(
   return sequences;
 }
 
+//===----------------------------------------------------------------------===//
+// Filtering command sequences using the GPU performance model
+//===----------------------------------------------------------------------===//
+
+bool CommandBufferScheduling::IsLaunchOverheadSignificant(
+    const HloInstructionSequence& seq, const GpuHloCostAnalysis& cost_analysis,
+    const se::DeviceDescription& device_description,
+    float min_launch_overhead_ratio) {
+  int64_t num_commands = 0;
+  absl::Duration exec_time = absl::ZeroDuration();
+
+  for (const HloInstruction* inst : seq.instructions()) {
+    if (IsNoOp(inst)) continue;
+    ++num_commands;
+
+    // We only estimate kernels and library calls. Control flow commands save
+    // host synchronization on top of the launch overhead, and we never
+    // penalize them for the runtime of their bodies.
+    if (inst->opcode() == HloOpcode::kFusion ||
+        inst->opcode() == HloOpcode::kCustomCall) {
+      exec_time += GpuPerformanceModel::EstimateRunTimeForInstruction(
+                       inst, device_description, &cost_analysis,
+                       GpuPerformanceModelOptions::Default())
+                       .exec_time;
+    }
+  }
+
+  absl::Duration launch_overhead =
+      num_commands * GpuPerformanceModelBase::kKernelLaunchOverhead;
+  double ratio = absl::FDivDuration(launch_overhead,
+                                    launch_overhead + exec_time);
+
+  VLOG(3) << "Command sequence of " << num_commands
+          << " commands: estimated launch overhead "
+          << absl::FormatDuration(launch_overhead) << ", estimated run time "
+          << absl::FormatDuration(exec_time) << ", ratio " << ratio;
+
+  return ratio >= min_launch_overhead_ratio;
+}
+
 // This function moves kParameter and kConstant instructions in a computation to
 // the beginning of the computation. This simplifies the construction of command
 // buffer computations because we don't need to deal with parameters and
@@ -905,6 +949,25 @@ absl::StatusOr<bool> CommandBufferScheduling::Run(
             module->schedule().sequence(comp), config,
             debug_options.xla_gpu_graph_min_graph_size());
 
+    // Drop sequences where launch overhead is not a significant share of the
+    // estimated runtime, as they would pay command buffer update costs without
+    // any benefit from the reduced number of launches.
+    if (float min_ratio =
+            debug_options.xla_gpu_graph_min_launch_overhead_ratio();
+        min_ratio > 0 && !sequences.empty()) {
+      GpuHloCostAnalysis cost_analysis(GpuHloCostAnalysis::Options{},
+                                       device_description_);
+      TF_RETURN_IF_ERROR(comp->Accept(&cost_analysis));
+      sequences.erase(
+          std::remove_if(sequences.begin(), sequences.end(),
+                         [&](const HloInstructionSequence& seq) {
+                           return !IsLaunchOverheadSignificant(
+                               seq, cost_analysis, device_description_,
+                               min_ratio);
+                         }),
+          sequences.end());
+    }
+
     for (const HloInstructionSequence& seq : sequences) {
       TF_ASSIGN_OR_RETURN(CommandBuffer command_buffer,
                           PrepareCommandBuffer(seq, comp->parent()));
@@ -30,6 +30,7 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_module.h"
 #include "xla/hlo/ir/hlo_schedule.h"
 #include "xla/hlo/pass/hlo_pass_interface.h"
+#include "xla/service/gpu/model/gpu_hlo_cost_analysis.h"
 #include "xla/stream_executor/device_description.h"
 
 namespace xla::gpu {
@@ -95,6 +96,17 @@ class CommandBufferScheduling : public HloModulePass {
       HloInstructionSequence schedule, const CommandBufferConfig& config,
       int32_t min_num_commands = 1);
 
+  // Returns true if the estimated kernel launch overhead of commands in `seq`
+  // is at least `min_launch_overhead_ratio` of the estimated sequence runtime
+  // (launch overhead plus kernel execution time from the GPU performance
+  // model). Regions dominated by long running kernels (i.e. large GEMMs) do not
+  // benefit from command buffers, but pay for command buffer updates.
+  static bool IsLaunchOverheadSignificant(
+      const HloInstructionSequence& seq,
+      const GpuHloCostAnalysis& cost_analysis,
+      const se::DeviceDescription& device_description,
+      float min_launch_overhead_ratio);
+
   // Moves kParameter and kConstant instructions in a computation to
   // the beginning of the computation. This simplifies the construction of
   // command buffer computations because we don't need to deal with parameters
@@ -20,6 +20,7 @@ limitations under the License.
 #include <vector>
 
 #include <gtest/gtest.h>
+#include "xla/hlo/ir/hlo_computation.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_opcode.h"
 #include "xla/hlo/ir/hlo_schedule.h"
@@ -29,6 +30,7 @@ limitations under the License.
 #include "xla/service/executable.h"
 #include "xla/service/gpu/gpu_device_info_for_tests.h"
 #include "xla/service/gpu/gpu_executable.h"
+#include "xla/service/gpu/model/gpu_hlo_cost_analysis.h"
 #include "xla/service/hlo_module_config.h"
 #include "xla/service/hlo_runner_interface.h"
 #include "xla/stream_executor/device_description.h"
@@ -526,6 +528,68 @@ TEST_F(CommandBufferSchedulingTest, CollectCommandBufferSequence) {
   EXPECT_EQ(seq_1[1]->opcode(), HloOpcode::kFusion);
 }
 
+TEST_F(CommandBufferSchedulingTest, LaunchOverheadSignificance) {
+  const char* hlo = R"(
+      HloModule TestModule, is_scheduled=true
+
+      %fused_computation(param_0: f32[4], param_1: f32[4]) -> f32[4] {
+        %p0 = f32[4] parameter(0)
+        %p1 = f32[4] parameter(1)
+        ROOT %add = f32[4] add(%p0, %p1)
+      }
+
+      %fused_computation.1(param_0: f32[8192,8192], param_1: f32[8192,8192])
+          -> f32[8192,8192] {
+        %p0 = f32[8192,8192] parameter(0)
+        %p1 = f32[8192,8192] parameter(1)
+        ROOT %add = f32[8192,8192] add(%p0, %p1)
+      }
+
+      ENTRY %main (a: f32[4], b: f32[8192,8192]) -> (f32[4], f32[8192,8192]) {
+        %a = f32[4] parameter(0)
+        %b = f32[8192,8192] parameter(1)
+        %fusion = f32[4] fusion(%a, %a), kind=kLoop, calls=%fused_computation
+        %fusion.1 = f32[4] fusion(%fusion, %a), kind=kLoop,
+          calls=%fused_computation
+        %fusion.2 = f32[8192,8192] fusion(%b, %b), kind=kLoop,
+          calls=%fused_computation.1
+        %fusion.3 = f32[8192,8192] fusion(%fusion.2, %b), kind=kLoop,
+          calls=%fused_computation.1
+        ROOT %tuple = (f32[4], f32[8192,8192]) tuple(%fusion.1, %fusion.3)
+      })";
+
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<VerifiedHloModule> module,
+                          ParseAndReturnVerifiedModule(hlo));
+
+  HloComputation* entry = module->entry_computation();
+  GpuHloCostAnalysis cost_analysis(GpuHloCostAnalysis::Options{},
+                                   device_desc());
+  TF_ASSERT_OK(entry->Accept(&cost_analysis));
+
+  HloInstructionSequence small_kernels;
+  small_kernels.push_back(entry->GetInstructionWithName("fusion"));
+  small_kernels.push_back(entry->GetInstructionWithName("fusion.1"));
+
+  HloInstructionSequence large_kernels;
+  large_kernels.push_back(entry->GetInstructionWithName("fusion.2"));
+  large_kernels.push_back(entry->GetInstructionWithName("fusion.3"));
+
+  // Launch overhead dominates the runtime of tiny kernels.
+  EXPECT_TRUE(CommandBufferScheduling::IsLaunchOverheadSignificant(
+      small_kernels, cost_analysis, device_desc(),
+      /*min_launch_overhead_ratio=*/0.5));
+
+  // Bandwidth bound kernels that read and write 768MiB run for milliseconds.
+  EXPECT_FALSE(CommandBufferScheduling::IsLaunchOverheadSignificant(
+      large_kernels, cost_analysis, device_desc(),
+      /*min_launch_overhead_ratio=*/0.5));
+
+  // Zero ratio accepts all sequences.
+  EXPECT_TRUE(CommandBufferScheduling::IsLaunchOverheadSignificant(
+      large_kernels, cost_analysis, device_desc(),
+      /*min_launch_overhead_ratio=*/0.0));
+}
+
 TEST_F(CommandBufferSchedulingTest, MoveParametersToFront) {
   const char* hlo = R"(
       HloModule TestModule, is_scheduled=true
@@ -30,6 +30,8 @@ limitations under the License.
 #include "absl/log/log.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
 #include "absl/strings/string_view.h"
 #include "third_party/gpus/cudnn/cudnn_version.h"
 #include "xla/comparison_util.h"
@@ -46,6 +48,7 @@ limitations under the License.
 #include "xla/service/dump.h"
 #include "xla/service/gpu/backend_configs.pb.h"
 #include "xla/service/gpu/cudnn_support_utils.h"
+#include "xla/service/gpu/executable.pb.h"
 #include "xla/service/gpu/ir_emission_utils.h"
 #include "xla/service/gpu/kernel_reuse_cache.h"
 #include "xla/service/gpu/matmul_indexing_utils.h"
@@ -57,7 +60,10 @@ limitations under the License.
 #include "xla/stream_executor/dnn.h"
 #include "xla/stream_executor/stream_executor.h"
 #include "xla/util.h"
+#include "tsl/platform/env.h"
 #include "tsl/platform/errors.h"
+#include "tsl/platform/fingerprint.h"
+#include "tsl/platform/path.h"
 #include "tsl/platform/statusor.h"
 
 namespace xla {
@@ -659,11 +665,67 @@ absl::StatusOr<HloInstruction*> AddWorkspace(HloInstruction& fusion,
   return new_fusion;
 }
 
+std::string GetGraphCacheFilePath(absl::string_view cache_dir,
+                                  absl::string_view key) {
+  const tsl::Fprint128 fingerprint = tsl::Fingerprint128(key);
+  return tsl::io::JoinPath(
+      cache_dir, absl::StrFormat("%016x%016x.cudnn_graph", fingerprint.high64,
+                                 fingerprint.low64));
+}
+
+// Returns the compiled graph with `key` from the cache in `cache_dir`, if it
+// is there.
+absl::StatusOr<std::optional<CudnnGraphCacheEntryProto>> ReadGraphFromCache(
+    absl::string_view cache_dir, absl::string_view key) {
+  if (cache_dir.empty()) {
+    return std::nullopt;
+  }
+  const std::string file_path = GetGraphCacheFilePath(cache_dir, key);
+  tsl::Env* env = tsl::Env::Default();
+  if (!env->FileExists(file_path).ok()) {
+    VLOG(4) << "cuDNN graph cache miss: " << file_path;
+    return std::nullopt;
+  }
+  VLOG(4) << "cuDNN graph cache hit: " << file_path;
+  CudnnGraphCacheEntryProto entry;
+  TF_RETURN_IF_ERROR(tsl::ReadBinaryProto(env, file_path, &entry));
+  return entry;
+}
+
+absl::Status WriteGraphToCache(absl::string_view cache_dir,
+                               absl::string_view key,
+                               const CudnnGraphCacheEntryProto& entry) {
+  if (cache_dir.empty()) {
+    return absl::OkStatus();
+  }
+  tsl::Env* env = tsl::Env::Default();
+  TF_RETURN_IF_ERROR(env->RecursivelyCreateDir(std::string(cache_dir)));
+  const std::string file_path = GetGraphCacheFilePath(cache_dir, key);
+  // Write to a temporary file first and rename it, so that concurrent
+  // compilations never read a partially written entry.
+  std::string temp_file_path = file_path;
+  if (!env->CreateUniqueFileName(&temp_file_path, ".tmp")) {
+    return absl::InternalError(
+        absl::StrCat("Failed to create a temporary file for ", file_path));
+  }
+  TF_RETURN_IF_ERROR(tsl::WriteBinaryProto(env, temp_file_path, entry));
+  VLOG(4) << "Writing cuDNN graph to cache: " << file_path;
+  return env->RenameFile(temp_file_path, file_path);
+}
+
 class CuDnnFusionVisitor : public DfsHloRewriteVisitor {
  public:
-  explicit CuDnnFusionVisitor(se::dnn::DnnSupport& dnn_support,
-                              BinaryMap& compilation_results)
-      : dnn_support_(dnn_support), compilation_results_(compilation_results) {}
+  // If `cache_dir` is not empty, compiled graphs are looked up in and added to
+  // the cache in this directory, with keys prefixed by `cache_key_prefix`,
+  // which identifies the device and the cuDNN version.
+  CuDnnFusionVisitor(se::dnn::DnnSupport& dnn_support,
+                     BinaryMap& compilation_results,
+                     absl::string_view cache_dir,
+                     absl::string_view cache_key_prefix)
+      : dnn_support_(dnn_support),
+        compilation_results_(compilation_results),
+        cache_dir_(cache_dir),
+        cache_key_prefix_(cache_key_prefix) {}
 
   absl::Status HandleFusion(HloInstruction* hlo) override {
     TF_ASSIGN_OR_RETURN(auto gpu_config,
@@ -713,12 +775,38 @@ class CuDnnFusionVisitor : public DfsHloRewriteVisitor {
       return graph;
     };
 
-    auto serialize_graph =
-        [](const se::gpu::CudnnGraph& graph) -> absl::StatusOr<std::string> {
+    // Returns the compiled graph of `fingerprint`, from the cache if it is
+    // there, and compiles and caches it otherwise.
+    auto get_compiled_graph = [&](absl::string_view fingerprint)
+        -> absl::StatusOr<CudnnGraphCacheEntryProto> {
+      const int64_t requested_plan_id =
+          fusion_backend_config.has_cudnn_fusion_config()
+              ? fusion_backend_config.cudnn_fusion_config().plan_id()
+              : -1;
+      const std::string cache_key = absl::StrCat(
+          cache_key_prefix_, ";plan=", requested_plan_id, ";", fingerprint);
+      TF_ASSIGN_OR_RETURN(std::optional<CudnnGraphCacheEntryProto> cached,
+                          ReadGraphFromCache(cache_dir_, cache_key));
+      if (cached.has_value()) {
+        if (requested_plan_id < 0) {
+          gpu_config.mutable_fusion_backend_config()
+              ->mutable_cudnn_fusion_config()
+              ->set_plan_id(cached->plan_id());
+          TF_RETURN_IF_ERROR(hlo->set_backend_config(gpu_config));
+        }
+        return *std::move(cached);
+      }
+      TF_ASSIGN_OR_RETURN(const se::gpu::CudnnGraph graph, compile_graph());
+      CudnnGraphCacheEntryProto entry;
+      entry.set_workspace_size(graph.Graph().get_workspace_size());
+      entry.set_plan_id(fusion_backend_config.cudnn_fusion_config().plan_id());
       std::vector<uint8_t> serialized_graph;
       RETURN_IF_CUDNN_FRONTEND_ERROR(graph.Graph().serialize(serialized_graph));
-      return std::string(reinterpret_cast<char*>(serialized_graph.data()),
-                         serialized_graph.size());
+      entry.set_serialized_graph(
+          reinterpret_cast<const char*>(serialized_graph.data()),
+          serialized_graph.size());
+      TF_RETURN_IF_ERROR(WriteGraphToCache(cache_dir_, cache_key, entry));
+      return entry;
     };
 
     if (IsWorkspaceAllocationRoot(*hlo->fused_expression_root())) {
@@ -727,10 +815,10 @@ class CuDnnFusionVisitor : public DfsHloRewriteVisitor {
           GetComputationFingerprint(hlo->fused_instructions_computation(), {});
       if (auto it = compilation_results_.find(fingerprint);
           it == compilation_results_.cend()) {
-        TF_ASSIGN_OR_RETURN(const se::gpu::CudnnGraph graph, compile_graph());
-        TF_ASSIGN_OR_RETURN(const std::string serialized,
-                            serialize_graph(graph));
-        compilation_results_.insert(it, {fingerprint, serialized});
+        TF_ASSIGN_OR_RETURN(CudnnGraphCacheEntryProto entry,
+                            get_compiled_graph(fingerprint));
+        compilation_results_.insert(
+            it, {fingerprint, std::move(*entry.mutable_serialized_graph())});
       }
       return absl::OkStatus();
     }
@@ -749,14 +837,15 @@ class CuDnnFusionVisitor : public DfsHloRewriteVisitor {
     auto workspace_size_it =
         workspace_sizes_.find(fingerprint_without_workspace);
     if (workspace_size_it == workspace_sizes_.cend()) {
-      TF_ASSIGN_OR_RETURN(const se::gpu::CudnnGraph graph, compile_graph());
-      const int64_t workspace_size = graph.Graph().get_workspace_size();
+      TF_ASSIGN_OR_RETURN(CudnnGraphCacheEntryProto entry,
+                          get_compiled_graph(fingerprint_without_workspace));
+      const int64_t workspace_size = entry.workspace_size();
       workspace_sizes_.insert(workspace_size_it,
                               {fingerprint_without_workspace, workspace_size});
       TF_RETURN_IF_ERROR(add_workspace(workspace_size));
-      TF_ASSIGN_OR_RETURN(const std::string serialized, serialize_graph(graph));
       compilation_results_[GetComputationFingerprint(
-          hlo->fused_instructions_computation(), {})] = serialized;
+          hlo->fused_instructions_computation(), {})] =
+          std::move(*entry.mutable_serialized_graph());
     } else {
       VLOG(4) << "Cache hit.";
       TF_RETURN_IF_ERROR(add_workspace(workspace_size_it->second));
@@ -771,6 +860,8 @@ class CuDnnFusionVisitor : public DfsHloRewriteVisitor {
   // <HLO computation fingerprint, serialized compiled cuDNN graph>.
   BinaryMap& compilation_results_;
   absl::flat_hash_map<std::string, int64_t> workspace_sizes_;
+  const std::string cache_dir_;
+  const std::string cache_key_prefix_;
 };
 
 }  // namespace
@@ -779,7 +870,20 @@ absl::StatusOr<bool> CuDnnFusionCompiler::Run(
     HloModule* module,
     const absl::flat_hash_set<absl::string_view>& execution_threads) {
   XLA_SCOPED_LOGGING_TIMER("cuDNN fusion compiler");
-  return CuDnnFusionVisitor(dnn_support_, compilation_results_)
+  const std::string& cache_dir =
+      module->config().debug_options().xla_gpu_cudnn_graph_cache_dir();
+  std::string cache_key_prefix;
+  if (!cache_dir.empty()) {
+    // Serialized graphs are only valid for the device and the cuDNN version
+    // they were built with.
+    TF_ASSIGN_OR_RETURN(se::dnn::VersionInfo version,
+                        dnn_support_.GetVersion());
+    cache_key_prefix = absl::StrCat(
+        device_model_, ";cudnn=", version.major_version(), ".",
+        version.minor_version(), ".", version.patch());
+  }
+  return CuDnnFusionVisitor(dnn_support_, compilation_results_, cache_dir,
+                            cache_key_prefix)
       .RunOnModule(module, execution_threads);
 }
 
@@ -33,6 +33,7 @@ limitations under the License.
 #include "absl/strings/string_view.h"
 #include "xla/hlo/ir/hlo_casting_utils.h"
 #include "xla/hlo/ir/hlo_clone_context.h"
+#include "xla/hlo/ir/hlo_computation.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_instruction_utils.h"
 #include "xla/hlo/ir/hlo_instructions.h"
@@ -523,10 +524,64 @@ absl::StatusOr<bool> DoubleBufferingUnroll(HloInstruction* while_instr,
   return true;  // changed
 }
 
+// Loops are unrolled until an iteration launches at least this many kernels.
+constexpr int64_t kMinKernelsPerIteration = 16;
+// The maximum number of instructions in the body of an unrolled loop.
+constexpr int64_t kMaxUnrolledBodyInstructionCount = 800;
+
+// Returns the number of instructions of `computation` that launch a kernel or
+// a library call.
+int64_t CountKernels(const HloComputation* computation) {
+  return absl::c_count_if(
+      computation->instructions(),
+      HloPredicateIsNotOp<HloOpcode::kParameter, HloOpcode::kConstant,
+                          HloOpcode::kGetTupleElement, HloOpcode::kTuple,
+                          HloOpcode::kBitcast>);
+}
+
+// Unrolls a loop that launches few kernels per iteration. Every iteration goes
+// through the while thunk, or the conditional node of a command buffer, and
+// its kernels can't be scheduled together with the ones of other iterations,
+// which dominates the run time of small bodies. The loop is unrolled fully if
+// its unrolled body stays within kMaxUnrolledBodyInstructionCount, and
+// otherwise doubled while an iteration launches fewer than
+// kMinKernelsPerIteration kernels and the body stays within the budget.
+absl::StatusOr<bool> UnrollLaunchBoundLoop(HloInstruction* while_instr,
+                                           HloModule* module) {
+  HloComputation* while_body = while_instr->while_body();
+  int64_t kernels = CountKernels(while_body);
+  if (kernels == 0 || kernels >= kMinKernelsPerIteration) {
+    return false;
+  }
+  TF_ASSIGN_OR_RETURN(auto config,
+                      while_instr->backend_config<WhileLoopBackendConfig>());
+  int64_t trip_count = config.known_trip_count().n();
+  if (trip_count * while_body->instruction_count() <=
+      kMaxUnrolledBodyInstructionCount) {
+    VLOG(2) << "Fully unrolling launch bound loop " << while_instr->name();
+    return FullyUnroll(while_instr, module);
+  }
+  bool changed = false;
+  while (trip_count > 1 && kernels < kMinKernelsPerIteration &&
+         2 * while_body->instruction_count() <=
+             kMaxUnrolledBodyInstructionCount) {
+    VLOG(2) << "Doubling the body of launch bound loop "
+            << while_instr->name();
+    TF_RETURN_IF_ERROR(DoubleBufferingUnroll(while_instr, module).status());
+    TF_ASSIGN_OR_RETURN(config,
+                        while_instr->backend_config<WhileLoopBackendConfig>());
+    trip_count = config.known_trip_count().n();
+    kernels *= 2;
+    changed = true;
+  }
+  return changed;
+}
+
 // Function performs double buffering unrolling strategy iff there is any
-// collective operation within a body computation.
-absl::StatusOr<bool> AutoUnroll(HloInstruction* while_instr,
-                                HloModule* module) {
+// collective operation within a body computation. Otherwise, it unrolls loops
+// with few kernels per iteration if `unroll_launch_bound_loops` is set.
+absl::StatusOr<bool> AutoUnroll(HloInstruction* while_instr, HloModule* module,
+                                bool unroll_launch_bound_loops) {
   CHECK_EQ(while_instr->opcode(), HloOpcode::kWhile);
 
   bool any_collective_present = absl::c_any_of(
@@ -537,6 +592,9 @@ absl::StatusOr<bool> AutoUnroll(HloInstruction* while_instr,
   if (any_collective_present) {
     return DoubleBufferingUnroll(while_instr, module);
   }
+  if (unroll_launch_bound_loops) {
+    return UnrollLaunchBoundLoop(while_instr, module);
+  }
   return false;  // IR not changed.
 }
 
@@ -573,7 +631,9 @@ absl::StatusOr<bool> DoubleBufferLoopUnrolling::Run(
     } else if (unroll_strategy_ == UnrollStrategy::kDoubleBuffer) {
       TF_ASSIGN_OR_RETURN(changed, DoubleBufferingUnroll(while_instr, module));
     } else if (unroll_strategy_ == UnrollStrategy::kAuto) {
-      TF_ASSIGN_OR_RETURN(changed, AutoUnroll(while_instr, module));
+      TF_ASSIGN_OR_RETURN(
+          changed,
+          AutoUnroll(while_instr, module, unroll_launch_bound_loops_));
     } else {
       LOG(FATAL) << absl::StrCat("Unhandled unrolling strategy: ",
                                  unroll_strategy_);
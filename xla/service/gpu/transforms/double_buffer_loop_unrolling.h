@@ -43,6 +43,12 @@ namespace gpu {
 //   passes (like `WhileLoopSimplifier`) to simplify/get rid of the while loop
 //   eventually.
 //
+// With `kAuto` strategy:
+//   This pass performs the `kDoubleBuffer` transformation on the loops that
+//   contain collectives. If `unroll_launch_bound_loops` is set, the other
+//   loops that launch few kernels per iteration are unrolled too, fully if
+//   the unrolled body is small enough and otherwise by a power of two.
+//
 // Note that this pass will flatten the call graph if any loop has been
 // unrolled.
 class DoubleBufferLoopUnrolling : public HloModulePass {
@@ -50,8 +56,10 @@ class DoubleBufferLoopUnrolling : public HloModulePass {
   enum class UnrollStrategy { kDoubleBuffer, kFullUnroll, kAuto };
 
   explicit DoubleBufferLoopUnrolling(
-      UnrollStrategy unroll_strategy = UnrollStrategy::kDoubleBuffer)
-      : unroll_strategy_(unroll_strategy) {};
+      UnrollStrategy unroll_strategy = UnrollStrategy::kDoubleBuffer,
+      bool unroll_launch_bound_loops = false)
+      : unroll_strategy_(unroll_strategy),
+        unroll_launch_bound_loops_(unroll_launch_bound_loops) {};
   ~DoubleBufferLoopUnrolling() override = default;
 
   absl::string_view name() const override {
@@ -65,6 +73,7 @@ class DoubleBufferLoopUnrolling : public HloModulePass {
 
  private:
   UnrollStrategy unroll_strategy_;
+  bool unroll_launch_bound_loops_;
 };
 
 }  // end namespace gpu
@@ -156,6 +156,51 @@ ENTRY main {
   EXPECT_EQ(config.known_trip_count().n(), 10);
 }
 
+TEST_F(GpuLoopDoubleBufferTransformerTest,
+       AutoUnrollFullyUnrollsLaunchBoundLoopWithoutCollectives) {
+  absl::string_view kModuleString = R"(
+HloModule m
+condition {
+  input_tuple = (s32[]) parameter(0)
+  cond = s32[] get-tuple-element(input_tuple), index=0
+  trip_count = s32[] constant(10)
+  ROOT done = pred[] compare(cond, trip_count), direction=LT
+}
+
+body {
+  input_tuple = (s32[]) parameter(0)
+  cond = s32[] get-tuple-element(input_tuple), index=0
+  one = s32[] constant(1)
+  cond_plus_1 = s32[] add(cond, one)
+  ROOT output_tuple = (s32[]) tuple(cond_plus_1)
+}
+
+ENTRY main {
+  param_0 = s32[] constant(0)
+  tuple = (s32[]) tuple(param_0)
+  ROOT while = (s32[]) while(tuple), condition=condition, body=body, backend_config={"known_trip_count":{"n":"10"}}
+})";
+
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<xla::HloModule> module,
+                          ParseAndReturnVerifiedModule(kModuleString));
+  DoubleBufferLoopUnrolling unroller(
+      DoubleBufferLoopUnrolling::UnrollStrategy::kAuto,
+      /*unroll_launch_bound_loops=*/true);
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, unroller.Run(module.get()));
+
+  EXPECT_TRUE(changed);
+
+  HloInstruction* while_instruction = hlo_query::GetFirstInstructionWithOpcode(
+      *module->entry_computation(), HloOpcode::kWhile);
+  TF_ASSERT_OK_AND_ASSIGN(
+      WhileLoopBackendConfig config,
+      while_instruction->backend_config<WhileLoopBackendConfig>());
+  EXPECT_EQ(config.known_trip_count().n(), 1);
+  EXPECT_EQ(
+      CountInstructions((*while_instruction->while_body()), HloOpcode::kAdd),
+      10);
+}
+
 TEST_F(GpuLoopDoubleBufferTransformerTest, FullUnrollOddTripCountTest) {
   const char* const kModuleString = R"(
 HloModule all_gather_overlapping
@@ -2118,6 +2118,65 @@ TEST_F(DynamicSliceFusionRewriterTest, ReduceScatterDynamicSlice) {
   RunAndFilecheckHloRewrite(hlo, DynamicSliceFusionRewriter("gpu"), expected);
 }
 
+TEST_F(DynamicSliceFusionRewriterTest, AllReduceDynamicSlice) {
+  const char* hlo = R"(
+  HloModule jit_slice, replica_count=2
+
+  add {
+    a = s32[] parameter(0)
+    b = s32[] parameter(1)
+    ROOT add = add(a,b)
+  }
+
+  ENTRY %main.9 {
+    p0 = s32[2,8,32]{2,1,0} parameter(0)
+    c0 = s32[] constant(0)
+    c1 = s32[] constant(1)
+    slice = s32[1,8,32]{2,1,0} dynamic-slice(p0, c1, c0, c0), dynamic_slice_sizes={1,8,32}
+    bc = s32[8,32]{1,0} bitcast(%slice)
+    ROOT ar = s32[8,32] all-reduce(bc), channel_id=64, replica_groups={{0,1}}, use_global_device_ids=true, to_apply=add
+  })";
+  const char* expected = R"(
+  // CHECK: add
+  // CHECK: dynamic-slice-fusion{{.*}} {
+  // CHECK:   %[[p0:.+]] = {{.+}} parameter(0)
+  // CHECK:   %[[slice:.+]] = {{.+}} dynamic-slice(%[[p0]], {{.+}}), dynamic_slice_sizes={1,8,32}
+  // CHECK:   %[[bc:.+]] = {{.+}} bitcast(%[[slice]])
+  // CHECK:   ROOT {{.+}} = {{.+}} all-reduce(%[[bc]])
+  // CHECK: }
+  // CHECK: ENTRY
+  )";
+  RunAndFilecheckHloRewrite(hlo, DynamicSliceFusionRewriter("gpu"), expected);
+}
+
+TEST_F(DynamicSliceFusionRewriterTest, AllGatherMultipleDynamicSlices) {
+  const char* hlo = R"(
+  HloModule jit_slice, replica_count=2
+
+  ENTRY %main.9 {
+    p0 = s32[2,8,32]{2,1,0} parameter(0)
+    p1 = s32[2,8,32]{2,1,0} parameter(1)
+    c0 = s32[] constant(0)
+    c1 = s32[] constant(1)
+    slice0 = s32[1,8,32]{2,1,0} dynamic-slice(p0, c1, c0, c0), dynamic_slice_sizes={1,8,32}
+    slice1 = s32[1,8,32]{2,1,0} dynamic-slice(p1, c1, c0, c0), dynamic_slice_sizes={1,8,32}
+    bc0 = s32[8,32]{1,0} bitcast(%slice0)
+    bc1 = s32[8,32]{1,0} bitcast(%slice1)
+    ROOT ag = (s32[16,32], s32[16,32]) all-gather(bc0, bc1), channel_id=64, replica_groups={{0,1}}, use_global_device_ids=true, dimensions={0}
+  })";
+  const char* expected = R"(
+  // CHECK: dynamic-slice-fusion{{.*}} {
+  // CHECK-DAG:   %[[slice0:.+]] = {{.+}} dynamic-slice({{.+}}), dynamic_slice_sizes={1,8,32}
+  // CHECK-DAG:   %[[slice1:.+]] = {{.+}} dynamic-slice({{.+}}), dynamic_slice_sizes={1,8,32}
+  // CHECK-DAG:   %[[bc0:.+]] = {{.+}} bitcast(%[[slice0]])
+  // CHECK-DAG:   %[[bc1:.+]] = {{.+}} bitcast(%[[slice1]])
+  // CHECK:   %[[ag:.+]] = {{.+}} all-gather(%[[bc0]], %[[bc1]])
+  // CHECK: }
+  // CHECK: ENTRY
+  )";
+  RunAndFilecheckHloRewrite(hlo, DynamicSliceFusionRewriter("gpu"), expected);
+}
+
 TEST_F(DynamicSliceFusionRewriterTest,
        OffsetAsFunctionOfInductionVariableShouldFuse) {
   const char* hlo = R"(
@@ -1498,7 +1498,10 @@ class GemmRewriterVisitor : public DfsHloRewriteVisitor {
           maybe_reduce = gemm_users[i];
         }
 
+        // cuBLASLt only computes the maximum over the whole output, so
+        // reductions to a non-scalar shape can't be fused.
         if (HloPredicateIsOp<HloOpcode::kReduce>(maybe_reduce) &&
+            ShapeUtil::IsScalar(maybe_reduce->shape()) &&
             maybe_reduce->operands().size() == 2 &&
             maybe_reduce->operand(1)->opcode() == HloOpcode::kConstant &&
             ShapeUtil::IsScalar(maybe_reduce->operand(1)->shape())) {
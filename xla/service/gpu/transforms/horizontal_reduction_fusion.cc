@@ -0,0 +1,229 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/service/gpu/transforms/horizontal_reduction_fusion.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+#include "absl/algorithm/container.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/layout_util.h"
+#include "xla/service/gpu/gpu_fusible.h"
+#include "xla/service/hlo_creation_utils.h"
+#include "xla/shape.h"
+#include "xla/stream_executor/device_description.h"
+#include "xla/tsl/platform/errors.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/util.h"
+#include "xla/xla_data.pb.h"
+
+namespace xla {
+namespace gpu {
+
+namespace {
+
+// The maximum number of reductions combined into one.
+constexpr size_t kMaxReductionsPerGroup = 64;
+
+// A reduction of the minor-most dimensions of its operand, seen as a reduction
+// of a [rows, row_length] operand along its second dimension.
+struct Candidate {
+  HloInstruction* reduce;
+  int64_t rows;
+  int64_t row_length;
+};
+
+std::optional<Candidate> GetCandidate(HloInstruction* instr,
+                                      int64_t max_elements) {
+  if (instr->opcode() != HloOpcode::kReduce || instr->operand_count() != 2 ||
+      instr->operand(1)->opcode() != HloOpcode::kConstant) {
+    return std::nullopt;
+  }
+  const Shape& input_shape = instr->operand(0)->shape();
+  if (!input_shape.has_layout() || !instr->shape().has_layout() ||
+      !LayoutUtil::IsMonotonicWithDim0Major(input_shape.layout()) ||
+      !LayoutUtil::IsMonotonicWithDim0Major(instr->shape().layout())) {
+    return std::nullopt;
+  }
+  std::vector<int64_t> reduced_dims(instr->dimensions().begin(),
+                                    instr->dimensions().end());
+  if (reduced_dims.empty()) {
+    return std::nullopt;
+  }
+  absl::c_sort(reduced_dims);
+  const int64_t num_kept_dims =
+      input_shape.dimensions().size() - reduced_dims.size();
+  for (size_t i = 0; i < reduced_dims.size(); ++i) {
+    if (reduced_dims[i] != num_kept_dims + static_cast<int64_t>(i)) {
+      return std::nullopt;
+    }
+  }
+  Candidate candidate{
+      instr, Product(input_shape.dimensions().subspan(0, num_kept_dims)),
+      Product(input_shape.dimensions().subspan(num_kept_dims))};
+  const int64_t num_elements = candidate.rows * candidate.row_length;
+  if (num_elements == 0 || num_elements > max_elements) {
+    return std::nullopt;
+  }
+  return candidate;
+}
+
+// Returns the reductions that are only consumed by `consumer` (or the root),
+// sorted by increasing row length.
+std::vector<Candidate> FindCandidates(HloInstruction* consumer,
+                                      int64_t max_elements) {
+  absl::flat_hash_set<HloInstruction*> candidate_set;
+  std::vector<Candidate> candidates;
+  for (HloInstruction* operand : consumer->operands()) {
+    std::optional<Candidate> candidate = GetCandidate(operand, max_elements);
+    if (candidate.has_value() &&
+        IsConsumerTheOnlyNonRootUser(*operand, *consumer) &&
+        candidate_set.insert(operand).second) {
+      candidates.push_back(*candidate);
+    }
+  }
+  absl::c_sort(candidates, [](const Candidate& a, const Candidate& b) {
+    return std::tuple{a.row_length, a.reduce->unique_id()} <
+           std::tuple{b.row_length, b.reduce->unique_id()};
+  });
+  return candidates;
+}
+
+bool CanCombine(const HloInstruction& a, const HloInstruction& b) {
+  return a.shape().element_type() == b.shape().element_type() &&
+         a.operand(1)->literal() == b.operand(1)->literal() &&
+         a.to_apply()->Equal(*b.to_apply(), /*is_layout_sensitive=*/false);
+}
+
+// Splits `candidates` into groups of reductions that can be combined. Row
+// lengths in a group differ by at most 2x, which bounds the padding.
+std::vector<std::vector<Candidate>> GroupCandidates(
+    absl::Span<const Candidate> candidates) {
+  std::vector<std::vector<Candidate>> groups;
+  for (const Candidate& candidate : candidates) {
+    auto group = absl::c_find_if(groups, [&](const auto& group) {
+      return group.size() < kMaxReductionsPerGroup &&
+             candidate.row_length <= 2 * group.front().row_length &&
+             CanCombine(*group.front().reduce, *candidate.reduce);
+    });
+    if (group != groups.end()) {
+      group->push_back(candidate);
+    } else {
+      groups.push_back({candidate});
+    }
+  }
+  return groups;
+}
+
+absl::Status CombineReductions(absl::Span<const Candidate> group) {
+  HloInstruction* init = group.front().reduce->mutable_operand(1);
+  const int64_t row_length = group.back().row_length;
+  std::vector<HloInstruction*> inputs;
+  inputs.reserve(group.size());
+  for (const Candidate& candidate : group) {
+    HloInstruction* input = candidate.reduce->mutable_operand(0);
+    const std::vector<int64_t> dims = {candidate.rows, candidate.row_length};
+    if (input->shape().dimensions() != absl::MakeConstSpan(dims)) {
+      TF_ASSIGN_OR_RETURN(input, MakeReshapeHlo(dims, input));
+    }
+    if (candidate.row_length < row_length) {
+      PaddingConfig padding_config = MakeNoPaddingConfig(2);
+      padding_config.mutable_dimensions(1)->set_edge_padding_high(
+          row_length - candidate.row_length);
+      TF_ASSIGN_OR_RETURN(input, MakePadHlo(input, init, padding_config));
+    }
+    inputs.push_back(input);
+  }
+  TF_ASSIGN_OR_RETURN(HloInstruction * concat,
+                      MakeConcatHlo(inputs, /*dimension=*/0));
+  TF_ASSIGN_OR_RETURN(
+      HloInstruction * reduce,
+      MakeReduceHlo(concat, init, /*dimensions=*/{1},
+                    group.front().reduce->to_apply(),
+                    &group.front().reduce->metadata()));
+
+  int64_t offset = 0;
+  for (const Candidate& candidate : group) {
+    TF_ASSIGN_OR_RETURN(
+        HloInstruction * slice,
+        MakeSliceHlo(reduce, /*start_indices=*/{offset},
+                     /*limit_indices=*/{offset + candidate.rows},
+                     /*strides=*/{1}));
+    TF_ASSIGN_OR_RETURN(HloInstruction * result,
+                        MakeReshapeHlo(candidate.reduce->shape(), slice));
+    TF_RETURN_IF_ERROR(candidate.reduce->ReplaceAllUsesWith(result));
+    offset += candidate.rows;
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace
+
+absl::StatusOr<bool> HorizontalReductionFusion::RunOnComputation(
+    HloComputation* computation) {
+  // A reduction that reads fewer elements than the GPU runs threads at once
+  // can't fill the GPU on its own.
+  const int64_t max_elements =
+      device_info_.core_count() * device_info_.threads_per_core_limit();
+  bool changed = false;
+  // The combined reductions are left in place for DCE, so the post order stays
+  // valid.
+  for (HloInstruction* consumer : computation->MakeInstructionPostOrder()) {
+    std::vector<Candidate> candidates = FindCandidates(consumer, max_elements);
+    if (candidates.size() <= 1) {
+      continue;
+    }
+    for (const std::vector<Candidate>& group : GroupCandidates(candidates)) {
+      if (group.size() <= 1) {
+        continue;
+      }
+      VLOG(3) << "Combining " << group.size() << " reductions consumed by "
+              << consumer->name();
+      TF_RETURN_IF_ERROR(CombineReductions(group));
+      changed = true;
+    }
+  }
+  return changed;
+}
+
+absl::StatusOr<bool> HorizontalReductionFusion::Run(
+    HloModule* module,
+    const absl::flat_hash_set<absl::string_view>& execution_threads) {
+  bool any_changed = false;
+  VLOG(2) << "Run horizontal reduction fusion.";
+  for (HloComputation* comp :
+       module->MakeNonfusionComputations(execution_threads)) {
+    TF_ASSIGN_OR_RETURN(bool changed, RunOnComputation(comp));
+    any_changed |= changed;
+  }
+  return any_changed;
+}
+
+}  // namespace gpu
+}  // namespace xla
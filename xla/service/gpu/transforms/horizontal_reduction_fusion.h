@@ -0,0 +1,82 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_SERVICE_GPU_TRANSFORMS_HORIZONTAL_REDUCTION_FUSION_H_
+#define XLA_SERVICE_GPU_TRANSFORMS_HORIZONTAL_REDUCTION_FUSION_H_
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/pass/hlo_pass_interface.h"
+#include "xla/stream_executor/device_description.h"
+
+namespace xla {
+namespace gpu {
+
+// Combines small row reductions of different shapes into a single reduction,
+// so that they are emitted as one kernel instead of one kernel each.
+//
+// HorizontalInputFusion only fuses reductions with the same input shape. This
+// pass runs before fusion and rewrites the reductions themselves: the operand
+// of each reduction is reshaped to [rows, row length], padded with the init
+// value to the longest row length of the group, and concatenated with the
+// others along the rows. The result of the combined reduction is then sliced
+// back into the original results:
+//
+//   r0 = f32[8] reduce(f32[8,100] p0, c0), dimensions={1}
+//   r1 = f32[] reduce(f32[120] p1, c0), dimensions={0}
+//
+// becomes
+//
+//   concat = f32[9,120] concatenate(pad(p0, c0), reshape(p1)), dimensions={0}
+//   r = f32[9] reduce(concat, c0), dimensions={1}
+//   r0 = f32[8] slice(r), slice={[0:8]}
+//   r1 = f32[] reshape(slice(r), slice={[8:9]})
+//
+// The producers of the reductions are then fused into the concatenation by
+// PriorityFusion, and the slices are fused horizontally.
+//
+// The combined reductions have to reduce the minor-most dimensions of an
+// operand in the default layout, with the same reducer and constant init
+// value, and each of them has to read fewer elements than the GPU runs threads
+// at once. Like HorizontalInputFusion, only reductions whose results are
+// consumed by the same instruction (or the root) are combined, so that
+// combining them can't create cycles.
+class HorizontalReductionFusion : public HloModulePass {
+ public:
+  explicit HorizontalReductionFusion(const se::DeviceDescription& d)
+      : device_info_(d) {}
+
+  absl::string_view name() const override {
+    return "horizontal_reduction_fusion";
+  }
+
+  using HloPassInterface::Run;
+  absl::StatusOr<bool> Run(
+      HloModule* module,
+      const absl::flat_hash_set<absl::string_view>& execution_threads) override;
+
+ private:
+  absl::StatusOr<bool> RunOnComputation(HloComputation*);
+
+  const se::DeviceDescription& device_info_;
+};
+
+}  // namespace gpu
+}  // namespace xla
+
+#endif  // XLA_SERVICE_GPU_TRANSFORMS_HORIZONTAL_REDUCTION_FUSION_H_
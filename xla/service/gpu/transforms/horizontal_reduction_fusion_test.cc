@@ -0,0 +1,185 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/service/gpu/transforms/horizontal_reduction_fusion.h"
+
+#include <memory>
+#include <utility>
+
+#include "xla/error_spec.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/testlib/pattern_matcher_gmock.h"
+#include "xla/hlo/testlib/test.h"
+#include "xla/service/gpu/gpu_device_info_for_tests.h"
+#include "xla/service/gpu/tests/gpu_codegen_test.h"
+#include "xla/service/pattern_matcher.h"
+#include "xla/stream_executor/device_description.h"
+#include "xla/tsl/platform/statusor.h"
+
+namespace xla {
+namespace gpu {
+namespace {
+
+namespace m = ::xla::match;
+
+class HorizontalReductionFusionTest : public GpuCodegenTest {
+ public:
+  se::DeviceDescription device_description_{
+      TestGpuDeviceInfo::RTXA6000DeviceInfo()};
+  HorizontalReductionFusion horizontal_reduction_fusion_{device_description_};
+};
+
+TEST_F(HorizontalReductionFusionTest, CombinesReductionsOfDifferentShapes) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(R"(
+HloModule CombinesReductionsOfDifferentShapes
+
+add {
+  x = f32[] parameter(0)
+  y = f32[] parameter(1)
+  ROOT add = f32[] add(x, y)
+}
+
+ENTRY entry {
+  p0 = f32[8,100] parameter(0)
+  p1 = f32[120] parameter(1)
+  p2 = f32[4,2,30] parameter(2)
+  c0 = f32[] constant(0)
+  r0 = f32[8] reduce(p0, c0), dimensions={1}, to_apply=add
+  r1 = f32[] reduce(p1, c0), dimensions={0}, to_apply=add
+  r2 = f32[4] reduce(p2, c0), dimensions={1,2}, to_apply=add
+  ROOT tuple = (f32[8], f32[], f32[4]) tuple(r0, r1, r2)
+})"));
+  std::unique_ptr<HloModule> original = module->Clone();
+
+  EXPECT_TRUE(horizontal_reduction_fusion_.Run(module.get()).value());
+
+  const HloInstruction* reduce = nullptr;
+  ASSERT_THAT(
+      module->entry_computation()->root_instruction(),
+      GmockMatch(m::Tuple(
+          m::Reshape(m::Slice(m::Reduce(&reduce, m::Concatenate(),
+                                        m::ConstantScalar(0)))),
+          m::Reshape(m::Slice(m::Op().Is(reduce))),
+          m::Reshape(m::Slice(m::Op().Is(reduce))))));
+  EXPECT_THAT(reduce->shape().dimensions(), ::testing::ElementsAre(13));
+  EXPECT_THAT(reduce->operand(0)->shape().dimensions(),
+              ::testing::ElementsAre(13, 120));
+  EXPECT_TRUE(RunAndCompareTwoModules(std::move(original), std::move(module),
+                                      ErrorSpec{1e-5, 1e-5}));
+}
+
+TEST_F(HorizontalReductionFusionTest, DoesNotCombineDifferentReducers) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(R"(
+HloModule DoesNotCombineDifferentReducers
+
+add {
+  x = f32[] parameter(0)
+  y = f32[] parameter(1)
+  ROOT add = f32[] add(x, y)
+}
+
+max {
+  x = f32[] parameter(0)
+  y = f32[] parameter(1)
+  ROOT max = f32[] maximum(x, y)
+}
+
+ENTRY entry {
+  p0 = f32[8,100] parameter(0)
+  p1 = f32[8,100] parameter(1)
+  c0 = f32[] constant(0)
+  r0 = f32[8] reduce(p0, c0), dimensions={1}, to_apply=add
+  r1 = f32[8] reduce(p1, c0), dimensions={1}, to_apply=max
+  ROOT tuple = (f32[8], f32[8]) tuple(r0, r1)
+})"));
+
+  EXPECT_FALSE(horizontal_reduction_fusion_.Run(module.get()).value());
+}
+
+TEST_F(HorizontalReductionFusionTest, DoesNotCombineColumnReductions) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(R"(
+HloModule DoesNotCombineColumnReductions
+
+add {
+  x = f32[] parameter(0)
+  y = f32[] parameter(1)
+  ROOT add = f32[] add(x, y)
+}
+
+ENTRY entry {
+  p0 = f32[8,100] parameter(0)
+  p1 = f32[8,100] parameter(1)
+  c0 = f32[] constant(0)
+  r0 = f32[100] reduce(p0, c0), dimensions={0}, to_apply=add
+  r1 = f32[100] reduce(p1, c0), dimensions={0}, to_apply=add
+  ROOT tuple = (f32[100], f32[100]) tuple(r0, r1)
+})"));
+
+  EXPECT_FALSE(horizontal_reduction_fusion_.Run(module.get()).value());
+}
+
+TEST_F(HorizontalReductionFusionTest, DoesNotCombineLargeReductions) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(R"(
+HloModule DoesNotCombineLargeReductions
+
+add {
+  x = f32[] parameter(0)
+  y = f32[] parameter(1)
+  ROOT add = f32[] add(x, y)
+}
+
+ENTRY entry {
+  p0 = f32[1024,1024] parameter(0)
+  p1 = f32[1024,1024] parameter(1)
+  c0 = f32[] constant(0)
+  r0 = f32[1024] reduce(p0, c0), dimensions={1}, to_apply=add
+  r1 = f32[1024] reduce(p1, c0), dimensions={1}, to_apply=add
+  ROOT tuple = (f32[1024], f32[1024]) tuple(r0, r1)
+})"));
+
+  EXPECT_FALSE(horizontal_reduction_fusion_.Run(module.get()).value());
+}
+
+TEST_F(HorizontalReductionFusionTest, DoesNotCombineDependentReductions) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(R"(
+HloModule DoesNotCombineDependentReductions
+
+add {
+  x = f32[] parameter(0)
+  y = f32[] parameter(1)
+  ROOT add = f32[] add(x, y)
+}
+
+ENTRY entry {
+  p0 = f32[8,100] parameter(0)
+  c0 = f32[] constant(0)
+  r0 = f32[8] reduce(p0, c0), dimensions={1}, to_apply=add
+  b0 = f32[8,100] broadcast(r0), dimensions={0}
+  r1 = f32[8] reduce(b0, c0), dimensions={1}, to_apply=add
+  ROOT tuple = (f32[8], f32[8]) tuple(r0, r1)
+})"));
+
+  EXPECT_FALSE(horizontal_reduction_fusion_.Run(module.get()).value());
+}
+
+}  // namespace
+}  // namespace gpu
+}  // namespace xla
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "xla/service/gpu/transforms/layout_assignment.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <initializer_list>
@@ -28,6 +29,7 @@ limitations under the License.
 #include "absl/log/check.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
 #include "absl/types/span.h"
 #include "xla/hlo/ir/hlo_casting_utils.h"
 #include "xla/hlo/ir/hlo_computation.h"
@@ -44,6 +46,7 @@ limitations under the License.
 #include "xla/service/gpu/matmul_utils.h"
 #include "xla/service/gpu/reduction_utils.h"
 #include "xla/service/gpu/stream_executor_util.h"
+#include "xla/service/hlo_cost_analysis.h"
 #include "xla/service/logical_buffer.h"
 #include "xla/service/memory_annotations.h"
 #include "xla/shape.h"
@@ -195,6 +198,55 @@ HeuristicLayoutAssignment(const HloInstruction* instr,
   return kAllNHWC;
 }
 
+// Roofline estimate of the run time of the convolution `instr` with the given
+// input, filter and output shapes, in milliseconds.
+static double EstimateConvolutionTimeInMs(
+    const se::DeviceDescription& device_info, const HloInstruction* instr,
+    const Shape& input_shape, const Shape& filter_shape,
+    const Shape& output_shape) {
+  const double flops = HloCostAnalysis::GetConvolutionFlops(
+      instr, input_shape, filter_shape, output_shape);
+  const double bytes = ShapeUtil::ByteSizeOf(input_shape) +
+                       ShapeUtil::ByteSizeOf(filter_shape) +
+                       ShapeUtil::ByteSizeOf(output_shape);
+  const double flops_per_ms = 2e6 * device_info.clock_rate_ghz() *
+                              device_info.core_count() *
+                              device_info.fpus_per_core();
+  const double bytes_per_ms = device_info.memory_bandwidth() * 1e-3;
+  if (flops_per_ms <= 0 || bytes_per_ms <= 0) {
+    return 0.0;
+  }
+  return std::max(flops / flops_per_ms, bytes / bytes_per_ms);
+}
+
+absl::StatusOr<double> GpuLayoutAssignment::FixedLayoutTransposeTimeInMs(
+    const HloCustomCallInstruction* instr, const Shape& lhs_shape,
+    const Shape& rhs_shape, const Shape& result_shape) const {
+  int64_t bytes = 0;
+  auto add_transpose_bytes = [&](const LogicalBuffer& buffer,
+                                 const Shape& shape) {
+    const BufferLayoutConstraint* constraint =
+        GetBufferLayoutConstraint(buffer);
+    if (constraint != nullptr && constraint->mandatory() &&
+        !LayoutUtil::Equal(constraint->layout(), shape.layout())) {
+      // A transpose reads and writes the whole array.
+      bytes += 2 * ShapeUtil::ByteSizeOf(shape);
+    }
+  };
+  for (int64_t i = 0; i < 2; ++i) {
+    const PointsToSet::BufferSet* buffers = GetBufferSet(instr->operand(i));
+    if (buffers->size() == 1) {
+      add_transpose_bytes(**buffers->begin(), i == 0 ? lhs_shape : rhs_shape);
+    }
+  }
+  TF_ASSIGN_OR_RETURN(
+      const LogicalBuffer* result_buffer,
+      points_to_analysis_->GetBufferDefinedAt(instr, /*index=*/{0}));
+  add_transpose_bytes(*result_buffer, result_shape);
+  const double bytes_per_ms = device_description_.memory_bandwidth() * 1e-3;
+  return bytes_per_ms > 0 ? bytes / bytes_per_ms : 0.0;
+}
+
 // Adds layout constraints on the cudnn custom-call instruction. The layout
 // constraints are represented in terms of minor_to_major fields of both
 // operands and the output shape. Depending on the underlying algorithm, one of
@@ -243,6 +295,55 @@ absl::Status GpuLayoutAssignment::AddBackendConstraintsToDnnConvCustomCall(
                  *output_shape->mutable_layout()),
         StreamExecutorConvLayoutsToXlaLayouts(
             instr->convolution_dimension_numbers(), input, filter, output));
+
+    // For floating-point convolutions other than F8, NHWC is only a performance
+    // preference: cuDNN runs them in NCHW as well. If operands or the result
+    // have a fixed layout that doesn't match, NHWC is only worth the transposes
+    // if they are estimated to be cheaper than the convolution itself, since
+    // the choice of layout at most halves its run time.
+    const DebugOptions& debug_options =
+        instr->GetModule()->config().debug_options();
+    const PrimitiveType input_ty = instr->operand(0)->shape().element_type();
+    if (debug_options.xla_gpu_experimental_enable_cost_based_conv_layout() &&
+        !debug_options.xla_gpu_force_conv_nhwc() &&
+        input == DataLayout::kBatchYXDepth &&
+        primitive_util::IsFloatingPointType(input_ty) &&
+        !primitive_util::IsF8Type(input_ty)) {
+      TF_ASSIGN_OR_RETURN(
+          double nhwc_transpose_time,
+          FixedLayoutTransposeTimeInMs(instr, lhs_shape, rhs_shape,
+                                       result_shape));
+      Shape nchw_lhs_shape = lhs_shape;
+      Shape nchw_rhs_shape = rhs_shape;
+      Shape nchw_result_shape = result_shape;
+      auto nchw_shape = [&](const Shape* shape) {
+        return shape == &lhs_shape   ? &nchw_lhs_shape
+               : shape == &rhs_shape ? &nchw_rhs_shape
+                                     : &nchw_result_shape;
+      };
+      TF_ASSIGN_OR_RETURN(
+          std::tie(*nchw_shape(input_shape)->mutable_layout(),
+                   *nchw_shape(filter_shape)->mutable_layout(),
+                   *nchw_shape(output_shape)->mutable_layout()),
+          StreamExecutorConvLayoutsToXlaLayouts(
+              instr->convolution_dimension_numbers(), DataLayout::kBatchDepthYX,
+              FilterLayout::kOutputInputYX, DataLayout::kBatchDepthYX));
+      TF_ASSIGN_OR_RETURN(
+          double nchw_transpose_time,
+          FixedLayoutTransposeTimeInMs(instr, nchw_lhs_shape, nchw_rhs_shape,
+                                       nchw_result_shape));
+      const double conv_time =
+          EstimateConvolutionTimeInMs(device_description_, instr, *input_shape,
+                                      *filter_shape, *output_shape);
+      if (nhwc_transpose_time - nchw_transpose_time > conv_time) {
+        VLOG(2) << "Using NCHW for " << instr->ToString()
+                << ", transposing to NHWC takes " << nhwc_transpose_time
+                << "ms vs " << conv_time << "ms for the convolution";
+        lhs_shape = std::move(nchw_lhs_shape);
+        rhs_shape = std::move(nchw_rhs_shape);
+        result_shape = std::move(nchw_result_shape);
+      }
+    }
   }
 
   // The custom call returns a tuple of (actual_result, scratch_buffer);
@@ -20,11 +20,13 @@ limitations under the License.
 #include <initializer_list>
 
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
 #include "absl/types/span.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_instructions.h"
 #include "xla/service/computation_layout.h"
 #include "xla/service/layout_assignment.h"
+#include "xla/shape.h"
 #include "xla/stream_executor/device_description.h"
 #include "xla/stream_executor/dnn.h"
 
@@ -54,6 +56,14 @@ class GpuLayoutAssignment : public LayoutAssignment {
   absl::Status AddBackendConstraintsToDnnConvCustomCall(
       HloCustomCallInstruction* instr, LayoutConstraints* constraints);
 
+  // Returns the estimated time it takes to transpose the operands and the
+  // result of the convolution `instr` whose layouts are already fixed, e.g. by
+  // the entry computation layout, to `lhs_shape`, `rhs_shape` and
+  // `result_shape`.
+  absl::StatusOr<double> FixedLayoutTransposeTimeInMs(
+      const HloCustomCallInstruction* instr, const Shape& lhs_shape,
+      const Shape& rhs_shape, const Shape& result_shape) const;
+
   // dim_groups are ordered from major to minor dimensions.
   absl::Status SetOperandMajorToMinorLayout(
       const HloInstruction* instruction, int64_t operand,
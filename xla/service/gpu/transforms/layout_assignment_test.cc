@@ -638,6 +638,41 @@ ENTRY entry {
       IsOkAndHolds(true));
 }
 
+TEST_F(LayoutAssignmentTest,
+       CostBasedConvLayoutKeepsFixedNCHWLayoutOfMemoryBoundConvolution) {
+  const char* hlo = R"(
+ENTRY entry {
+  p0 = f16[8,16,256,256]{3,2,1,0} parameter(0)
+  p1 = f16[16,16,1,1]{3,2,1,0} parameter(1)
+  ROOT conv = (f16[8,16,256,256]{3,2,1,0}, u8[0]{0}) custom-call(p0, p1),
+    window={size=1x1}, dim_labels=bf01_oi01->bf01,
+    custom_call_target="__cudnn$convForward"
+})";
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> hlo_module,
+                          ParseAndReturnVerifiedModule(hlo));
+  hlo_module->mutable_config()
+      .mutable_debug_options()
+      .set_xla_gpu_experimental_enable_cost_based_conv_layout(true);
+  ComputationLayout computation_layout(
+      hlo_module->entry_computation()->ComputeProgramShape());
+
+  GpuLayoutAssignment layout_assignment(
+      &computation_layout, se::CudaComputeCapability::Hopper(), GetDnnVersion(),
+      GetDeviceDescription());
+
+  EXPECT_THAT(layout_assignment.Run(hlo_module.get()), IsOkAndHolds(true));
+
+  // Transposing the parameters and the result to NHWC would take longer than
+  // the 1x1 convolution itself, so it keeps their NCHW layout.
+  EXPECT_THAT(
+      RunFileCheck(hlo_module->ToString(HloPrintOptions::ShortParsable()), R"(
+// CHECK-NOT: copy
+// CHECK:     custom-call({{.*}}), {{.*}}dim_labels=bf01_oi01->bf01
+// CHECK-NOT: copy
+)"),
+      IsOkAndHolds(true));
+}
+
 TEST_F(LayoutAssignmentTest, ConvCuDNNF8) {
   if (!GetCudaComputeCapability().IsAtLeast(
           se::CudaComputeCapability::kHopper)) {
@@ -29,6 +29,7 @@ limitations under the License.
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/string_view.h"
+#include "absl/time/time.h"
 #include "xla/debug_options_flags.h"
 #include "xla/hlo/analysis/hlo_dfs_reachability.h"
 #include "xla/hlo/ir/hlo_casting_utils.h"
@@ -308,6 +309,56 @@ FusionDecision CanFuseSiblings(const HloInstruction& sibling_consumer_1,
   return FusionDecision::Allow();
 }
 
+// Unfused siblings are normally left alone, since there is no fusion to fuse
+// them into. Elementwise siblings that are still unfused here are worth
+// wrapping into a new fusion if the model estimates that reading
+// `common_producer` only once saves more than is lost by running the compute
+// of both siblings in one kernel.
+FusionDecision UnfusedSiblingsAreProfitable(
+    const HloInstruction& sibling_consumer_1,
+    const HloInstruction& sibling_consumer_2,
+    const HloInstruction& common_producer,
+    const se::DeviceDescription& device_info,
+    const GpuHloCostAnalysis* cost_analysis) {
+  if (!sibling_consumer_1.IsElementwise() ||
+      !sibling_consumer_2.IsElementwise()) {
+    return FusionDecision::Forbid("unfused siblings are not elementwise");
+  }
+  GpuPerformanceModelOptions config = GpuPerformanceModelOptions::Default();
+  EstimateRunTimeData runtime_1 =
+      GpuPerformanceModel::EstimateRunTimeForInstruction(
+          &sibling_consumer_1, device_info, cost_analysis, config);
+  EstimateRunTimeData runtime_2 =
+      GpuPerformanceModel::EstimateRunTimeForInstruction(
+          &sibling_consumer_2, device_info, cost_analysis, config);
+
+  // The second sibling no longer reads the common operand from memory.
+  int64_t shared_bytes = GpuPerformanceModelBase::GetOperandBytesAccessed(
+      cost_analysis, &sibling_consumer_2, &common_producer);
+  absl::Duration shared_read_time =
+      runtime_2.bytes_read > 0
+          ? runtime_2.read_time * (static_cast<double>(shared_bytes) /
+                                   runtime_2.bytes_read)
+          : absl::ZeroDuration();
+
+  absl::Duration time_unfused =
+      2 * GpuPerformanceModelBase::kKernelLaunchOverhead +
+      runtime_1.exec_time + runtime_2.exec_time;
+  absl::Duration time_fused =
+      GpuPerformanceModelBase::kKernelLaunchOverhead +
+      GpuPerformanceModelBase::CombineComputeAndMemoryAccessTime(
+          runtime_1.compute_time + runtime_2.compute_time,
+          runtime_1.read_time + runtime_2.read_time - shared_read_time +
+              runtime_1.write_time + runtime_2.write_time,
+          config);
+  VLOG(8) << "Unfused siblings time: " << time_unfused
+          << ", fused time: " << time_fused;
+  if (time_fused > time_unfused) {
+    return FusionDecision::Forbid("will execute slower if fused");
+  }
+  return FusionDecision::Allow();
+}
+
 }  // namespace
 
 void MultiOutputFusion::RecomputeReachability() {
@@ -342,15 +393,21 @@ bool MultiOutputFusion::FuseSiblings(HloInstruction* parent,
 
   for (auto i = siblings.begin(); i != siblings.end(); ++i) {
     VLOG(3) << "Considering " << (*i)->name();
-    if ((*i)->opcode() != HloOpcode::kFusion) {
+    // Siblings are sorted, so if `*i` is not a fusion, neither is `*j`.
+    bool unfused_siblings = (*i)->opcode() != HloOpcode::kFusion;
+    if (unfused_siblings && !(*i)->IsElementwise()) {
       continue;
     }
     for (auto j = i + 1; j != siblings.end();) {
       VLOG(3) << "Considering " << (*i)->name() << " and " << (*j)->name();
 
-      if (auto fusible = CanFuseSiblings(**i, **j, *parent, *reachability_,
-                                         fusion_info_cache, device_info_);
-          !fusible) {
+      auto fusible = CanFuseSiblings(**i, **j, *parent, *reachability_,
+                                     fusion_info_cache, device_info_);
+      if (fusible && unfused_siblings) {
+        fusible = UnfusedSiblingsAreProfitable(**i, **j, *parent, device_info_,
+                                               cost_analysis);
+      }
+      if (!fusible) {
         // We pick `j` arbitrarily as a consumer.
         if (dump_fusion) {
           RegisterFusionState(
@@ -378,6 +435,16 @@ bool MultiOutputFusion::FuseSiblings(HloInstruction* parent,
       HloInstruction* fused = *j;
       TF_CHECK_OK(cost_analysis->RemoveInstruction(remaining));
       TF_CHECK_OK(cost_analysis->RemoveInstruction(fused));
+      if (unfused_siblings) {
+        remaining = computation_->AddInstruction(HloInstruction::CreateFusion(
+            (*i)->shape(), HloInstruction::FusionKind::kLoop, *i));
+        VLOG(2) << "Wrap sibling " << (*i)->name() << " into "
+                << remaining->name();
+        TF_CHECK_OK(computation_->ReplaceInstruction(*i, remaining));
+        fusion_info_cache->Invalidate(remaining);
+        *i = remaining;
+        unfused_siblings = false;
+      }
 
       DumpFusionState(*remaining,
                       absl::StrCat("About to fuse sibling |", fused->name(),
@@ -519,6 +519,24 @@ TEST_F(MultiOutputFusionTest, MultiOutputFusionLoopElementwise) {
               GmockMatch(m::Tuple(m::Multiply(), m::Divide())));
 }
 
+TEST_F(MultiOutputFusionTest, MultiOutputFusionUnfusedElementwiseSiblings) {
+  auto module = ParseAndReturnVerifiedModule(absl::StrCat(kModulePrefix, R"(
+    ENTRY entry {
+      p0 = f32[1024,1024]{1,0} parameter(0)
+      exp = f32[1024,1024]{1,0} exponential(p0)
+      log = f32[1024,1024]{1,0} log(p0)
+      ROOT root = (f32[1024,1024]{1,0}, f32[1024,1024]{1,0}) tuple(exp, log)
+    })"))
+                    .value();
+  ASSERT_TRUE(mof_.Run(module.get()).value());
+  SCOPED_TRACE(module->ToString());
+  const HloInstruction* fusion =
+      module->entry_computation()->root_instruction()->operand(0)->operand(0);
+  ASSERT_TRUE(fusion->IsMultiOutputFusion());
+  EXPECT_THAT(fusion->fused_expression_root(),
+              GmockMatch(m::Tuple(m::Exp(), m::Log())));
+}
+
 TEST_F(MultiOutputFusionTest, MultiOutputFusionSiblingLoopsDifferentShapes) {
   auto module = ParseAndReturnVerifiedModule(absl::StrCat(kModulePrefix, R"(
     fused_computation_1 {
@@ -31,6 +31,7 @@ limitations under the License.
 #include "absl/container/flat_hash_set.h"
 #include "absl/log/check.h"
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/string_view.h"
@@ -151,6 +152,7 @@ class PriorityFusionQueue {
                       mlir::MLIRContext* mlir_context,
                       HloFusionAnalysisCache& fusion_analysis_cache,
                       FusionDeduplicationCache& fusion_deduplication_cache,
+                      GpuPerformanceModelFingerprintCache& runtime_data_cache,
                       bool triton_heroless_fusion_enabled)
       : computation_(computation),
         device_info_(device_info),
@@ -162,6 +164,7 @@ class PriorityFusionQueue {
         thread_pool_(thread_pool),
         fusion_analysis_cache_(fusion_analysis_cache),
         fusion_deduplication_cache_(fusion_deduplication_cache),
+        runtime_data_cache_(runtime_data_cache),
         fusion_info_cache_(*device_info_),
         reachability_(HloDfsReachability::Build(computation)),
         triton_heroless_fusion_enabled_(triton_heroless_fusion_enabled) {
@@ -290,17 +293,19 @@ class PriorityFusionQueue {
       return absl::OkStatus();
     }
 
-    EstimateRunTimeData runtime_data;
-    if (IsGenericTritonFusion(*producer)) {
-      TF_ASSIGN_OR_RETURN(
-          runtime_data,
-          gpu_indexing_performance_model_.EstimateRunTimeForTriton(producer));
-    } else {
-      auto config = GpuPerformanceModelOptions::Default(
-          &fusion_analysis_cache_, &gpu_performance_model_cache_);
-      runtime_data = GpuPerformanceModel::EstimateRunTimeForInstruction(
-          producer, *device_info_, &cost_analysis_, config);
-    }
+    TF_ASSIGN_OR_RETURN(
+        EstimateRunTimeData runtime_data,
+        runtime_data_cache_.GetOrEstimate(
+            *producer, [&]() -> absl::StatusOr<EstimateRunTimeData> {
+              if (IsGenericTritonFusion(*producer)) {
+                return gpu_indexing_performance_model_
+                    .EstimateRunTimeForTriton(producer);
+              }
+              auto config = GpuPerformanceModelOptions::Default(
+                  &fusion_analysis_cache_, &gpu_performance_model_cache_);
+              return GpuPerformanceModel::EstimateRunTimeForInstruction(
+                  producer, *device_info_, &cost_analysis_, config);
+            }));
 
     gpu_performance_model_cache_.Set(*producer, runtime_data);
 
@@ -987,6 +992,9 @@ class PriorityFusionQueue {
   FusionDeduplicationCache& fusion_deduplication_cache_;
   absl::Mutex fusion_deduplication_cache_mutex_;
 
+  // Unfused runtime data by instruction fingerprint. Outlives the queue.
+  GpuPerformanceModelFingerprintCache& runtime_data_cache_;
+
   // Caches result of can_fuse for a (producer, consumer) pair. A cache entry is
   // invalidated if producer or consumer is modified.
   absl::flat_hash_map<
@@ -1113,7 +1121,7 @@ absl::StatusOr<bool> PriorityFusion::Run(
         computation, cost_analysis_options_, &device_info_,
         fusion_process_dump_.get(), thread_pool_, &mlir_context_,
         fusion_analysis_cache_, fusion_deduplication_cache,
-        triton_heroless_fusion_enabled);
+        runtime_data_cache_, triton_heroless_fusion_enabled);
 
     while (fusion_queue->DequeueNextProducer()) {
       auto producer = fusion_queue->current_producer();
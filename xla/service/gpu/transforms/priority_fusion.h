@@ -30,6 +30,7 @@ limitations under the License.
 #include "xla/service/gpu/fusion_process_dump.pb.h"
 #include "xla/service/gpu/model/fusion_analysis_cache.h"
 #include "xla/service/gpu/model/gpu_hlo_cost_analysis.h"
+#include "xla/service/gpu/model/gpu_performance_model_base.h"
 #include "xla/service/hlo_cost_analysis.h"
 #include "xla/service/instruction_fusion.h"
 #include "xla/stream_executor/device_description.h"
@@ -84,6 +85,11 @@ class PriorityFusion : public HloModulePass {
 
   HloFusionAnalysisCache fusion_analysis_cache_;
 
+  // Unfused runtime estimates by instruction fingerprint. They are kept across
+  // runs of the pass, e.g. when the fusion pipeline runs to a fixed point, so
+  // that instructions that didn't change aren't estimated again.
+  GpuPerformanceModelFingerprintCache runtime_data_cache_;
+
   mlir::MLIRContext mlir_context_;
 };
 
@@ -0,0 +1,146 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/service/gpu/transforms/ragged_all_to_all_chunker.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_instructions.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/hlo/utils/hlo_query.h"
+#include "xla/service/hlo_creation_utils.h"
+#include "xla/tsl/platform/errors.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/util.h"
+
+namespace xla {
+namespace gpu {
+namespace {
+
+// Returns the slice [:, begin, end) of a ragged metadata operand viewed as
+// [num_replicas, num_updates_per_replica], flattened back to 1D.
+absl::StatusOr<HloInstruction*> SliceMetadata(HloInstruction* metadata,
+                                              int64_t num_replicas,
+                                              int64_t num_updates_per_replica,
+                                              int64_t begin, int64_t end) {
+  TF_ASSIGN_OR_RETURN(
+      HloInstruction * reshaped,
+      MakeReshapeHlo({num_replicas, num_updates_per_replica}, metadata));
+  TF_ASSIGN_OR_RETURN(HloInstruction * sliced,
+                      MakeSliceHlo(reshaped, /*start_indices=*/{0, begin},
+                                   /*limit_indices=*/{num_replicas, end},
+                                   /*strides=*/{1, 1}));
+  return MakeReshapeHlo({num_replicas * (end - begin)}, sliced);
+}
+
+absl::StatusOr<bool> ChunkRaggedAllToAll(HloInstruction* ragged_all_to_all,
+                                         HloComputation* computation,
+                                         int64_t num_chunks,
+                                         int64_t& next_channel_id) {
+  if (HloPredicateIsNotOp<HloOpcode::kRaggedAllToAll>(ragged_all_to_all)) {
+    return false;
+  }
+
+  const auto& replica_groups =
+      ragged_all_to_all->device_list().replica_groups();
+  if (replica_groups.empty()) {
+    return false;
+  }
+
+  const int64_t num_replicas = replica_groups.front().replica_ids_size();
+  const HloInstruction* input_offsets = ragged_all_to_all->operand(2);
+  if (num_replicas == 0 || input_offsets->shape().dimensions_size() != 1) {
+    return false;
+  }
+
+  const int64_t num_total_updates = input_offsets->shape().dimensions(0);
+  if (num_total_updates % num_replicas != 0) {
+    return false;
+  }
+
+  const int64_t num_updates_per_replica = num_total_updates / num_replicas;
+  num_chunks = std::min(num_chunks, num_updates_per_replica);
+  if (num_chunks <= 1) {
+    return false;
+  }
+
+  HloInstruction* input = ragged_all_to_all->mutable_operand(0);
+  HloInstruction* output = ragged_all_to_all->mutable_operand(1);
+
+  for (int64_t chunk = 0; chunk < num_chunks; ++chunk) {
+    int64_t begin = chunk * num_updates_per_replica / num_chunks;
+    int64_t end = (chunk + 1) * num_updates_per_replica / num_chunks;
+
+    std::vector<HloInstruction*> new_operands = {input, output};
+    for (int i = 2; i < ragged_all_to_all->operand_count(); ++i) {
+      TF_ASSIGN_OR_RETURN(
+          HloInstruction * sliced,
+          SliceMetadata(ragged_all_to_all->mutable_operand(i), num_replicas,
+                        num_updates_per_replica, begin, end));
+      new_operands.push_back(sliced);
+    }
+
+    // The first chunk keeps the original channel id, the others get fresh
+    // ones so that all collectives in the module stay uniquely identified.
+    std::optional<int64_t> channel_id = ragged_all_to_all->channel_id();
+    if (channel_id.has_value() && chunk > 0) {
+      channel_id = next_channel_id++;
+    }
+
+    output = computation->AddInstruction(HloInstruction::CreateRaggedAllToAll(
+        ragged_all_to_all->shape(), new_operands,
+        ragged_all_to_all->device_list(), channel_id));
+    output->set_metadata(ragged_all_to_all->metadata());
+  }
+
+  TF_RETURN_IF_ERROR(ragged_all_to_all->ReplaceAllUsesWith(output));
+  TF_RETURN_IF_ERROR(computation->RemoveInstruction(ragged_all_to_all));
+  return true;
+}
+
+}  // namespace
+
+absl::StatusOr<bool> RaggedAllToAllChunker::Run(
+    HloModule* module,
+    const absl::flat_hash_set<absl::string_view>& execution_threads) {
+  if (num_chunks_ <= 1) {
+    return false;
+  }
+
+  bool changed = false;
+  int64_t next_channel_id = hlo_query::NextChannelId(*module);
+
+  for (auto computation : module->computations(execution_threads)) {
+    for (auto hlo : computation->MakeInstructionPostOrder()) {
+      TF_ASSIGN_OR_RETURN(bool chunked,
+                          ChunkRaggedAllToAll(hlo, computation, num_chunks_,
+                                              next_channel_id));
+      changed |= chunked;
+    }
+  }
+  return changed;
+}
+
+}  // namespace gpu
+}  // namespace xla
@@ -0,0 +1,63 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_SERVICE_GPU_TRANSFORMS_RAGGED_ALL_TO_ALL_CHUNKER_H_
+#define XLA_SERVICE_GPU_TRANSFORMS_RAGGED_ALL_TO_ALL_CHUNKER_H_
+
+#include <cstdint>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/pass/hlo_pass_interface.h"
+
+namespace xla {
+namespace gpu {
+
+// Splits a `ragged-all-to-all` with several updates per replica into a chain of
+// `num_chunks` ragged-all-to-alls.
+//
+// The offset and size operands of a ragged-all-to-all are laid out as
+// [num_replicas, num_updates_per_replica]. Chunk `c` exchanges a contiguous
+// range of the updates of every replica (e.g. the tokens of a group of local
+// experts in a mixture-of-experts dispatch) and takes the result of chunk
+// `c - 1` as its output operand. Updates write disjoint regions of the output,
+// so the final result is the same as for the original instruction, but every
+// chunk becomes a separate async collective that the scheduler can overlap
+// with compute.
+//
+// Expects canonical ragged-all-to-alls, see RaggedAllToAllCanonicalizer.
+class RaggedAllToAllChunker : public HloModulePass {
+ public:
+  explicit RaggedAllToAllChunker(int64_t num_chunks)
+      : num_chunks_(num_chunks) {}
+
+  absl::string_view name() const override {
+    return "ragged-all-to-all-chunker";
+  }
+
+  absl::StatusOr<bool> Run(
+      HloModule* module,
+      const absl::flat_hash_set<absl::string_view>& execution_threads) override;
+
+ private:
+  int64_t num_chunks_;
+};
+
+}  // namespace gpu
+}  // namespace xla
+
+#endif  // XLA_SERVICE_GPU_TRANSFORMS_RAGGED_ALL_TO_ALL_CHUNKER_H_
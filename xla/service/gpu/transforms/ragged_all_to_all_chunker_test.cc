@@ -0,0 +1,139 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/service/gpu/transforms/ragged_all_to_all_chunker.h"
+
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/service/hlo_runner.h"
+#include "xla/service/platform_util.h"
+#include "xla/tests/hlo_runner_agnostic_test_base.h"
+#include "xla/tests/test_utils.h"
+#include "xla/tsl/lib/core/status_test_util.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/tsl/platform/test.h"
+
+namespace xla {
+namespace gpu {
+namespace {
+
+class RaggedAllToAllChunkerTest : public HloRunnerAgnosticTestBase {
+ public:
+  RaggedAllToAllChunkerTest()
+      : HloRunnerAgnosticTestBase(std::make_unique<HloRunner>(
+            PlatformUtil::GetDefaultPlatform().value())) {}
+};
+
+std::vector<HloInstruction*> FindRaggedAllToAlls(HloModule* module) {
+  std::vector<HloInstruction*> ragged_all_to_alls;
+  for (HloInstruction* instr :
+       module->entry_computation()->MakeInstructionPostOrder()) {
+    if (instr->opcode() == HloOpcode::kRaggedAllToAll) {
+      ragged_all_to_alls.push_back(instr);
+    }
+  }
+  return ragged_all_to_alls;
+}
+
+TEST_F(RaggedAllToAllChunkerTest, RaggedAllToAllIsSplitIntoChainedChunks) {
+  TF_ASSERT_OK_AND_ASSIGN(auto module, ParseAndReturnVerifiedModule(R"(
+HloModule module
+
+ENTRY main {
+  input = bf16[64,8] parameter(0)
+  output = bf16[64,8] parameter(1)
+  input_offsets = s64[8] parameter(2)
+  send_sizes = s64[8] parameter(3)
+  output_offsets = s64[8] parameter(4)
+  recv_sizes = s64[8] parameter(5)
+  ROOT ra2a = bf16[64,8] ragged-all-to-all(input, output, input_offsets,
+    send_sizes, output_offsets, recv_sizes), channel_id=1,
+    replica_groups={{0,1}}
+}
+)"));
+
+  RaggedAllToAllChunker chunker(/*num_chunks=*/2);
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, chunker.Run(module.get(), {}));
+  EXPECT_TRUE(changed);
+  TF_EXPECT_OK(VerifyHloModule(module.get(), true, true));
+
+  std::vector<HloInstruction*> chunks = FindRaggedAllToAlls(module.get());
+  ASSERT_EQ(chunks.size(), 2);
+
+  // Every chunk exchanges two of the four updates of each replica.
+  for (HloInstruction* chunk : chunks) {
+    for (int i = 2; i < chunk->operand_count(); ++i) {
+      EXPECT_EQ(chunk->operand(i)->shape().dimensions(0), 4);
+    }
+  }
+
+  // The second chunk writes into the result of the first one and is the new
+  // root.
+  EXPECT_EQ(chunks[1]->operand(1), chunks[0]);
+  EXPECT_EQ(module->entry_computation()->root_instruction(), chunks[1]);
+  EXPECT_NE(chunks[0]->channel_id(), chunks[1]->channel_id());
+}
+
+TEST_F(RaggedAllToAllChunkerTest, NumChunksIsCappedByNumUpdates) {
+  TF_ASSERT_OK_AND_ASSIGN(auto module, ParseAndReturnVerifiedModule(R"(
+HloModule module
+
+ENTRY main {
+  input = f32[16] parameter(0)
+  output = f32[16] parameter(1)
+  input_offsets = s64[6] parameter(2)
+  send_sizes = s64[6] parameter(3)
+  output_offsets = s64[6] parameter(4)
+  recv_sizes = s64[6] parameter(5)
+  ROOT ra2a = f32[16] ragged-all-to-all(input, output, input_offsets,
+    send_sizes, output_offsets, recv_sizes), replica_groups={{0,1}}
+}
+)"));
+
+  RaggedAllToAllChunker chunker(/*num_chunks=*/8);
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, chunker.Run(module.get(), {}));
+  EXPECT_TRUE(changed);
+  TF_EXPECT_OK(VerifyHloModule(module.get(), true, true));
+  EXPECT_EQ(FindRaggedAllToAlls(module.get()).size(), 3);
+}
+
+TEST_F(RaggedAllToAllChunkerTest, SingleUpdatePerReplicaIsNotChanged) {
+  TF_ASSERT_OK_AND_ASSIGN(auto module, ParseAndReturnVerifiedModule(R"(
+HloModule module
+
+ENTRY main {
+  input = f32[16] parameter(0)
+  output = f32[16] parameter(1)
+  input_offsets = s64[2] parameter(2)
+  send_sizes = s64[2] parameter(3)
+  output_offsets = s64[2] parameter(4)
+  recv_sizes = s64[2] parameter(5)
+  ROOT ra2a = f32[16] ragged-all-to-all(input, output, input_offsets,
+    send_sizes, output_offsets, recv_sizes), replica_groups={{0,1}}
+}
+)"));
+
+  RaggedAllToAllChunker chunker(/*num_chunks=*/2);
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, chunker.Run(module.get(), {}));
+  EXPECT_FALSE(changed);
+}
+
+}  // namespace
+}  // namespace gpu
+}  // namespace xla
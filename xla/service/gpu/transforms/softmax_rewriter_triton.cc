@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "xla/service/gpu/transforms/softmax_rewriter_triton.h"
 
+#include <cstdint>
 #include <functional>
 #include <string>
 #include <utility>
@@ -84,6 +85,14 @@ inline bool HasOneUse(const HloInstruction* instr) {
   return instr->user_count() == 1;
 }
 
+// Returns true if the reduction of a diamond may also be used outside of the
+// diamond, in which case it becomes an extra output of the fusion.
+bool AllowReductionOutputs(const HloModule& module) {
+  return module.config()
+      .debug_options()
+      .xla_gpu_experimental_enable_multi_output_normalization_fusion();
+}
+
 // Chooses which operand to use for fusion processing. Taking in a unary or
 // binary instruction, returns the first non-splat operand. If none is
 // present, returns any operand.
@@ -194,11 +203,16 @@ bool IsTriviallyConnectedProducerOf(
 // fusion instruction is added to the module, but is not yet inserted into the
 // graph as a replacement of the original instructions.
 //
+// If the reduction of the diamond is also used outside of the diamond, the
+// fusion returns a tuple of the root and the reduction, and the reduction is
+// added to `extra_outputs` if it is not null.
+//
 // TODO(b/347956491): this awkward abstraction is needed to work around
 // limitations of HloFusionAdaptor, which underpins the implementation of
 // SymbolicTileAnalysis. We need to come up with a better solution.
 absl::StatusOr<HloFusionInstruction*> MakeFusionForDiamond(
-    const DiamondDescriptor& diamond) {
+    const DiamondDescriptor& diamond,
+    std::vector<HloInstruction*>* extra_outputs = nullptr) {
   auto [root, producer] = diamond;
 
   std::string suggested_name = "triton_softmax";
@@ -214,6 +228,7 @@ absl::StatusOr<HloFusionInstruction*> MakeFusionForDiamond(
   param++;
 
   std::vector<HloInstruction*> parameters = {producer};
+  std::vector<HloInstruction*> fused_instructions;
 
   std::function<void(HloInstruction*)> create_computation =
       [&](HloInstruction* instr) -> void {
@@ -234,17 +249,42 @@ absl::StatusOr<HloFusionInstruction*> MakeFusionForDiamond(
     } else {
       old_to_new_mapping[instr] = builder.AddInstruction(
           instr->CloneWithNewOperands(instr->shape(), new_operands));
+      fused_instructions.push_back(instr);
     }
   };
   create_computation(root);
 
+  // The matcher only lets reductions have users outside of the diamond.
+  std::vector<HloInstruction*> outputs = {root};
+  for (HloInstruction* instr : fused_instructions) {
+    if (instr->opcode() == HloOpcode::kReduce &&
+        absl::c_any_of(instr->users(), [&](const HloInstruction* user) {
+          return !old_to_new_mapping.contains(user);
+        })) {
+      outputs.push_back(instr);
+    }
+  }
+  Shape fusion_shape = root->shape();
+  if (outputs.size() > 1) {
+    std::vector<HloInstruction*> fused_outputs;
+    for (HloInstruction* output : outputs) {
+      fused_outputs.push_back(old_to_new_mapping[output]);
+    }
+    fusion_shape =
+        builder.AddInstruction(HloInstruction::CreateTuple(fused_outputs))
+            ->shape();
+    if (extra_outputs != nullptr) {
+      extra_outputs->assign(outputs.begin() + 1, outputs.end());
+    }
+  }
+
   HloComputation* computation =
       root->GetModule()->AddComputationAndUnifyNamesAndIds(builder.Build(),
                                                            /*is_entry=*/false);
 
   HloInstruction* normalization_fusion =
       root->parent()->AddInstruction(HloInstruction::CreateFusion(
-          root->shape(), HloInstruction::FusionKind::kCustom, parameters,
+          fusion_shape, HloInstruction::FusionKind::kCustom, parameters,
           computation));
 
   normalization_fusion->GetModule()->SetAndUniquifyInstrName(
@@ -398,8 +438,9 @@ absl::StatusOr<bool> MaybeFuseDiamondImpl(
     const se::DeviceDescription& device_info,
     const HloCostAnalysis::ShapeSizeFunction& shape_size,
     bool use_cost_model_to_evaluate_fusions) {
+  std::vector<HloInstruction*> extra_outputs;
   TF_ASSIGN_OR_RETURN(HloFusionInstruction * normalization_fusion,
-                      MakeFusionForDiamond(diamond));
+                      MakeFusionForDiamond(diamond, &extra_outputs));
   HloInstruction* root = diamond.root;
 
   VLOG(2) << "MaybeFuseDiamondImpl: " << normalization_fusion->ToString();
@@ -418,13 +459,26 @@ absl::StatusOr<bool> MaybeFuseDiamondImpl(
     return false;
   }
 
+  HloInstruction* new_root = normalization_fusion;
+  if (!extra_outputs.empty()) {
+    HloComputation* computation = root->parent();
+    for (int64_t i = 0; i < extra_outputs.size(); ++i) {
+      HloInstruction* output = extra_outputs[i];
+      TF_RETURN_IF_ERROR(output->ReplaceAllUsesWith(
+          computation->AddInstruction(HloInstruction::CreateGetTupleElement(
+              output->shape(), normalization_fusion, i + 1))));
+    }
+    new_root =
+        computation->AddInstruction(HloInstruction::CreateGetTupleElement(
+            root->shape(), normalization_fusion, 0));
+  }
+
   if (root->IsRoot()) {
-    root->parent()->set_root_instruction(normalization_fusion);
+    root->parent()->set_root_instruction(new_root);
     TF_RETURN_IF_ERROR(
         root->parent()->RemoveInstructionAndUnusedOperands(root));
   } else {
-    TF_RETURN_IF_ERROR(
-        root->parent()->ReplaceInstruction(root, normalization_fusion));
+    TF_RETURN_IF_ERROR(root->parent()->ReplaceInstruction(root, new_root));
   }
   return true;
 }
@@ -486,7 +540,8 @@ FusionDecision ShouldFuseReduction(const HloInstruction& reduce,
 }
 
 DiamondMatchingDecision MatchesTritonCompatibleClosedReductionDiamondImpl(
-    HloInstruction* instr, const se::GpuComputeCapability& cc) {
+    HloInstruction* instr, const se::GpuComputeCapability& cc,
+    bool allow_reduction_outputs) {
   if (!instr->IsElementwiseBinary()) {
     return FusionDecision::Forbid("Root is not elementwise binary.");
   }
@@ -539,7 +594,8 @@ DiamondMatchingDecision MatchesTritonCompatibleClosedReductionDiamondImpl(
         "constant.");
   }
 
-  if (!HasOneUse(broadcast) || !HasOneUse(reduce)) {
+  if (!HasOneUse(broadcast) ||
+      (!allow_reduction_outputs && !HasOneUse(reduce))) {
     return FusionDecision::Forbid("More than one use of broadcast or reduce.");
   }
 
@@ -583,7 +639,8 @@ DiamondMatchingDecision
 SoftmaxRewriterTriton::MatchesTritonCompatibleClosedReductionDiamond(
     HloInstruction* instr) const {
   return MatchesTritonCompatibleClosedReductionDiamondImpl(
-      instr, device_info_.gpu_compute_capability());
+      instr, device_info_.gpu_compute_capability(),
+      AllowReductionOutputs(*instr->GetModule()));
 }
 
 absl::StatusOr<std::vector<DiamondDescriptor>>
@@ -591,6 +648,7 @@ SoftmaxRewriterTriton::FindAllFusibleNormalizationDiamonds(
     HloModule& module,
     const absl::flat_hash_set<absl::string_view>& execution_threads) const {
   const se::GpuComputeCapability& cc = device_info_.gpu_compute_capability();
+  const bool allow_reduction_outputs = AllowReductionOutputs(module);
   std::vector<DiamondDescriptor> matched_diamonds;
 
   for (HloComputation* comp :
@@ -599,8 +657,8 @@ SoftmaxRewriterTriton::FindAllFusibleNormalizationDiamonds(
       continue;
     }
     for (HloInstruction* instr : comp->MakeInstructionPostOrder()) {
-      auto producer =
-          MatchesTritonCompatibleClosedReductionDiamondImpl(instr, cc);
+      auto producer = MatchesTritonCompatibleClosedReductionDiamondImpl(
+          instr, cc, allow_reduction_outputs);
       if (std::holds_alternative<HloInstruction*>(producer)) {
         DiamondDescriptor diamond{
             /*root=*/instr, /*producer=*/std::get<HloInstruction*>(producer)};
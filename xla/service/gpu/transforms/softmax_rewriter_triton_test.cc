@@ -293,6 +293,63 @@ ENTRY main {
   EXPECT_FALSE(fusion_rewriter_.Run(module.get()).value());
 }
 
+TEST_F(SoftmaxRewriterTritonTest,
+       CanNotFuseSoftmaxDiamondWithExtraReduceUsageByDefault) {
+  const std::string hlo_string = R"(
+HloModule softmax
+max_computation {
+  arg_0 = f32[] parameter(0)
+  arg_1 = f32[] parameter(1)
+  ROOT maximum = f32[] maximum(arg_0, arg_1)
+}
+ENTRY main {
+  param_0 = f32[127,125]{1,0} parameter(0)
+  constant_neg_inf = f32[] constant(-inf)
+  reduce = f32[127]{0} reduce(param_0, constant_neg_inf), dimensions={1}, to_apply=max_computation
+  broadcast = f32[127,125]{1,0} broadcast(reduce), dimensions={0}
+  subtract = f32[127,125]{1,0} subtract(param_0, broadcast)
+  ROOT tuple = (f32[127,125]{1,0}, f32[127]{0}) tuple(subtract, reduce)
+}
+)";
+  auto module = ParseAndReturnVerifiedModule(hlo_string).value();
+  EXPECT_FALSE(fusion_rewriter_.Run(module.get()).value());
+}
+
+TEST_F(SoftmaxRewriterTritonTest,
+       CanFuseSoftmaxDiamondWithExtraReduceUsageAsMultiOutputFusion) {
+  const std::string hlo_string = R"(
+HloModule softmax
+max_computation {
+  arg_0 = f32[] parameter(0)
+  arg_1 = f32[] parameter(1)
+  ROOT maximum = f32[] maximum(arg_0, arg_1)
+}
+ENTRY main {
+  param_0 = f32[127,125]{1,0} parameter(0)
+  constant_neg_inf = f32[] constant(-inf)
+  reduce = f32[127]{0} reduce(param_0, constant_neg_inf), dimensions={1}, to_apply=max_computation
+  broadcast = f32[127,125]{1,0} broadcast(reduce), dimensions={0}
+  subtract = f32[127,125]{1,0} subtract(param_0, broadcast)
+  ROOT tuple = (f32[127,125]{1,0}, f32[127]{0}) tuple(subtract, reduce)
+}
+)";
+  auto module = ParseAndReturnVerifiedModule(hlo_string).value();
+  module->mutable_config()
+      .mutable_debug_options()
+      .set_xla_gpu_experimental_enable_multi_output_normalization_fusion(true);
+  EXPECT_TRUE(fusion_rewriter_.Run(module.get()).value());
+  EXPECT_TRUE(verifier().Run(module.get()).status().ok());
+
+  const HloInstruction* fusion = nullptr;
+  EXPECT_THAT(
+      module->entry_computation()->root_instruction(),
+      GmockMatch(m::Tuple(
+          m::GetTupleElement(m::Fusion(&fusion, m::Parameter())
+                                 .WithPredicate(HasBlockLevelFusionConfig),
+                             0),
+          m::GetTupleElement(m::Op().Is(fusion), 1))));
+}
+
 TEST_F(SoftmaxRewriterTritonTest, DoesNotFuseReductionOnNonMinorAxis) {
   const std::string hlo_string = R"(
 max_computation {
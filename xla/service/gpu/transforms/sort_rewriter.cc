@@ -320,12 +320,6 @@ absl::StatusOr<bool> SortRewriter::RunOnInstruction(
       int64_t scratch_size,
       runner->GetScratchSize(Product(operand_shape.dimensions()), batch_size));
 
-  // Align and increase scratch size to fit the offsets.
-  if (batch_size > 1) {
-    scratch_size += sizeof(int) - scratch_size % sizeof(int);
-    scratch_size += (batch_size + 1) * sizeof(int);
-  }
-
   // Values are only present if sorting a pair of tensors.
   HloInstruction* keys;
   HloInstruction* values = nullptr;
@@ -60,7 +60,10 @@ absl::StatusOr<HloInstruction*> SmallBufferOptimization(
                            data_shape.ToString());
   }
   bool has_batch = data_shape.dimensions_size() == 2;
-  constexpr size_t max_k = 16;
+  // k <= 16 runs the TopK kernel, which keeps the top elements of each thread
+  // in registers, and larger k the radix select kernel, which is faster than
+  // sorting the whole row for large inputs such as vocabularies.
+  constexpr size_t max_k = 1024;
   constexpr size_t min_n = 1024;
   size_t n = data_shape.dimensions(has_batch ? 1 : 0);
   size_t k = topk->shape().tuple_shapes(0).dimensions(has_batch ? 1 : 0);
@@ -156,5 +156,18 @@ INSTANTIATE_TEST_SUITE_P(
                               std::get<2>(info.param), std::get<3>(info.param));
     });
 
+INSTANTIATE_TEST_SUITE_P(
+    LargeKTopkTests, TopkTest,
+    Combine(
+        /*n_kb=*/Values(1, 32, 256),
+        /*k=*/Values(17, 64, 1000, 1024),
+        /*batch_size=*/Values(1, 16),
+        /*dtype=*/Values(absl::string_view("f32"), "bf16")),
+    [](const auto& info) {
+      return absl::Substitute("n$0KiB_k$1_batch_size$2_$3",
+                              std::get<0>(info.param), std::get<1>(info.param),
+                              std::get<2>(info.param), std::get<3>(info.param));
+    });
+
 }  // namespace
 }  // namespace xla
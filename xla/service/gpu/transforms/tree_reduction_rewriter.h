@@ -73,6 +73,12 @@ namespace gpu {
 // f32[A, Q, C] inner_reduce = reduce(reshaped, dimensions={2})
 // f32[A, C] outer_reduce = reduce(inner_reduce, dimensions={1})
 //
+// The two reductions are emitted as two kernels, and the result doesn't depend
+// on the order in which blocks run. Reducing a row across blocks in a single
+// kernel (e.g. the last block to finish reducing the partial results) would
+// need a zero-initialized counter and a scratch buffer for the partial results.
+// Fusion emitters can't allocate either.
+//
 class TreeReductionRewriter : public HloModulePass {
  public:
   explicit TreeReductionRewriter(
@@ -0,0 +1,197 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/service/heap_simulator/constraint_solver_heap.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/log/check.h"
+#include "absl/log/log.h"
+#include "absl/status/statusor.h"
+#include "absl/types/span.h"
+#include "ortools/linear_solver/linear_solver.h"
+#include "xla/service/hlo_value.h"
+#include "xla/util.h"
+
+namespace xla {
+namespace {
+
+using ::operations_research::MPConstraint;
+using ::operations_research::MPSolver;
+using ::operations_research::MPVariable;
+
+bool OverlapInTime(const ConstraintSolverHeap::BufferInterval& a,
+                   const ConstraintSolverHeap::BufferInterval& b) {
+  return a.start <= b.end && b.start <= a.end;
+}
+
+}  // namespace
+
+absl::StatusOr<ConstraintSolverHeap::Result> ConstraintSolverHeap::Finish() {
+  std::vector<BufferInterval> sorted_buffer_intervals =
+      GetSortedBufferIntervals();
+  for (const BufferInterval& buffer_interval : sorted_buffer_intervals) {
+    if (buffer_interval.need_allocation) {
+      CommitChunk(buffer_interval, FindChunkCandidate(buffer_interval));
+    }
+  }
+  HeapResult best_fit_result = result_;
+
+  // Score the buffers by how much space they contend for with the best-fit
+  // packing.
+  std::vector<std::pair<double, const BufferInterval*>> scored_intervals;
+  for (const BufferInterval& buffer_interval : sorted_buffer_intervals) {
+    if (!buffer_interval.need_allocation ||
+        !buffer_interval.colocations.empty()) {
+      continue;
+    }
+    int num_overlapping = interval_tree_.NumChunksOverlappingInTime(
+        buffer_interval.start, buffer_interval.end);
+    scored_intervals.push_back(
+        {static_cast<double>(buffer_interval.size) * num_overlapping,
+         &buffer_interval});
+  }
+  std::stable_sort(
+      scored_intervals.begin(), scored_intervals.end(),
+      [](const auto& a, const auto& b) { return a.first > b.first; });
+  if (scored_intervals.size() >
+      static_cast<size_t>(options_.max_solver_buffers)) {
+    scored_intervals.resize(options_.max_solver_buffers);
+  }
+
+  std::optional<std::vector<int64_t>> offsets;
+  std::vector<const BufferInterval*> solver_intervals;
+  // A single buffer is placed at offset 0 by best-fit already.
+  if (scored_intervals.size() > 1) {
+    solver_intervals.reserve(scored_intervals.size());
+    for (const auto& [score, buffer_interval] : scored_intervals) {
+      solver_intervals.push_back(buffer_interval);
+    }
+    offsets = SolveOffsets(solver_intervals, best_fit_result.heap_size);
+  }
+
+  if (offsets.has_value()) {
+    result_ = {};
+    interval_tree_ = {};
+    absl::flat_hash_set<const HloValue*> solver_buffers;
+    for (size_t i = 0; i < solver_intervals.size(); ++i) {
+      CommitChunk(*solver_intervals[i],
+                  Chunk::FromOffsetSize((*offsets)[i],
+                                        solver_intervals[i]->size));
+      solver_buffers.insert(solver_intervals[i]->buffer);
+    }
+    for (const BufferInterval& buffer_interval : sorted_buffer_intervals) {
+      if (buffer_interval.need_allocation &&
+          !solver_buffers.contains(buffer_interval.buffer)) {
+        CommitChunk(buffer_interval, FindChunkCandidate(buffer_interval));
+      }
+    }
+    VLOG(1) << "Constraint solver heap size: " << result_.heap_size
+            << ", best-fit heap size: " << best_fit_result.heap_size;
+  }
+  if (!offsets.has_value() || result_.heap_size >= best_fit_result.heap_size) {
+    result_ = std::move(best_fit_result);
+  }
+
+  Result result;
+  result.heap_size = result_.heap_size;
+  result.heap_results.push_back(result_);
+  return result;
+}
+
+std::optional<std::vector<int64_t>> ConstraintSolverHeap::SolveOffsets(
+    absl::Span<const BufferInterval* const> buffer_intervals,
+    int64_t max_heap_size) const {
+  // Offsets are multiples of the granule, so they stay aligned.
+  const int64_t granule = RoundUpTo(
+      std::max(alignment_, CeilOfRatio(max_heap_size, options_.max_granules)),
+      alignment_);
+  const int64_t max_granules = max_heap_size / granule;
+  std::vector<int64_t> sizes;
+  sizes.reserve(buffer_intervals.size());
+  for (const BufferInterval* buffer_interval : buffer_intervals) {
+    sizes.push_back(CeilOfRatio(buffer_interval->size, granule));
+    if (sizes.back() > max_granules) {
+      return std::nullopt;
+    }
+  }
+
+#ifdef PLATFORM_GOOGLE
+  std::unique_ptr<MPSolver> solver(MPSolver::CreateSolver("SAT"));
+#else
+  std::unique_ptr<MPSolver> solver(
+      std::make_unique<MPSolver>("", MPSolver::SAT_INTEGER_PROGRAMMING));
+#endif
+  CHECK(solver);
+  solver->SetTimeLimit(options_.time_limit);
+
+  MPVariable* heap_size = solver->MakeIntVar(0, max_granules, "heap_size");
+  std::vector<MPVariable*> offsets;
+  offsets.reserve(buffer_intervals.size());
+  for (size_t i = 0; i < buffer_intervals.size(); ++i) {
+    offsets.push_back(solver->MakeIntVar(0, max_granules - sizes[i], ""));
+    // heap_size >= offset_i + size_i
+    MPConstraint* fits =
+        solver->MakeRowConstraint(sizes[i], solver->infinity());
+    fits->SetCoefficient(heap_size, 1);
+    fits->SetCoefficient(offsets[i], -1);
+  }
+  // For buffers i and j that are live at the same time, either i is below j
+  // (below_ij = 1) or j is below i (below_ij = 0):
+  //   offset_i + size_i <= offset_j + max_granules * (1 - below_ij)
+  //   offset_j + size_j <= offset_i + max_granules * below_ij
+  for (size_t i = 0; i < buffer_intervals.size(); ++i) {
+    for (size_t j = i + 1; j < buffer_intervals.size(); ++j) {
+      if (!OverlapInTime(*buffer_intervals[i], *buffer_intervals[j])) {
+        continue;
+      }
+      MPVariable* below = solver->MakeBoolVar("");
+      MPConstraint* i_below_j = solver->MakeRowConstraint(
+          sizes[i] - max_granules, solver->infinity());
+      i_below_j->SetCoefficient(offsets[j], 1);
+      i_below_j->SetCoefficient(offsets[i], -1);
+      i_below_j->SetCoefficient(below, -max_granules);
+      MPConstraint* j_below_i =
+          solver->MakeRowConstraint(sizes[j], solver->infinity());
+      j_below_i->SetCoefficient(offsets[i], 1);
+      j_below_i->SetCoefficient(offsets[j], -1);
+      j_below_i->SetCoefficient(below, max_granules);
+    }
+  }
+  solver->MutableObjective()->SetCoefficient(heap_size, 1);
+  solver->MutableObjective()->SetMinimization();
+
+  const MPSolver::ResultStatus status = solver->Solve();
+  if (status != MPSolver::OPTIMAL && status != MPSolver::FEASIBLE) {
+    VLOG(1) << "Constraint solver found no packing, status: " << status;
+    return std::nullopt;
+  }
+  std::vector<int64_t> result;
+  result.reserve(offsets.size());
+  for (const MPVariable* offset : offsets) {
+    result.push_back(std::llround(offset->solution_value()) * granule);
+  }
+  return result;
+}
+
+}  // namespace xla
@@ -0,0 +1,80 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_SERVICE_HEAP_SIMULATOR_CONSTRAINT_SOLVER_HEAP_H_
+#define XLA_SERVICE_HEAP_SIMULATOR_CONSTRAINT_SOLVER_HEAP_H_
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "absl/status/statusor.h"
+#include "absl/time/time.h"
+#include "absl/types/span.h"
+#include "xla/service/heap_simulator/heap_simulator.h"
+#include "xla/service/hlo_value.h"
+
+namespace xla {
+
+// A heap algorithm that packs the buffers that matter most with an integer
+// program, and the rest with GlobalDecreasingSizeBestFitHeap.
+//
+// The buffers that matter most are the large ones that are live at the same
+// time as many others, which is where best-fit leaves the biggest holes. Their
+// offsets are chosen to minimize the heap size, subject to buffers that are
+// live at the same time not overlapping in space. The solver is given a time
+// limit and the best-fit heap size as an upper bound, so the result is never
+// worse than best-fit's.
+//
+// Buffers with colocations are always placed by best-fit.
+class ConstraintSolverHeap : public GlobalDecreasingSizeBestFitHeap<HloValue> {
+ public:
+  struct Options {
+    // The number of buffers placed by the solver. The number of variables of
+    // the integer program is quadratic in it.
+    int64_t max_solver_buffers = 64;
+    // The solver returns the best packing found so far after this time.
+    absl::Duration time_limit = absl::Seconds(10);
+    // Offsets and sizes are expressed to the solver in units of at least
+    // heap size / max_granules bytes, to keep the integer program small. Sizes
+    // are rounded up, so solutions are always valid, if not exactly optimal.
+    int64_t max_granules = int64_t{1} << 20;
+  };
+
+  ConstraintSolverHeap(int64_t alignment, Options options,
+                       Type type = kSpatial,
+                       BufferIntervalCompare buffer_interval_compare = nullptr)
+      : GlobalDecreasingSizeBestFitHeap<HloValue>(alignment, type,
+                                                  buffer_interval_compare),
+        alignment_(alignment),
+        options_(options) {}
+  ~ConstraintSolverHeap() override {}
+
+  absl::StatusOr<Result> Finish() override;
+
+ private:
+  // Returns offsets for `buffer_intervals` that fit in `max_heap_size`, or
+  // nullopt if the solver found none within the time limit.
+  std::optional<std::vector<int64_t>> SolveOffsets(
+      absl::Span<const BufferInterval* const> buffer_intervals,
+      int64_t max_heap_size) const;
+
+  int64_t alignment_;
+  Options options_;
+};
+
+}  // namespace xla
+
+#endif  // XLA_SERVICE_HEAP_SIMULATOR_CONSTRAINT_SOLVER_HEAP_H_
@@ -0,0 +1,150 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/service/heap_simulator/constraint_solver_heap.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/literal_util.h"
+#include "xla/service/heap_simulator/heap_simulator.h"
+#include "xla/service/hlo_value.h"
+#include "xla/shape_util.h"
+#include "xla/tsl/platform/statusor.h"
+
+namespace xla {
+namespace {
+
+class ConstraintSolverHeapTest : public ::testing::Test {
+ protected:
+  ConstraintSolverHeapTest() : builder_("constraint_solver_heap_test") {}
+
+  // Creates a dummy HloValue to pass to the heap algorithm.
+  const HloValue* DummyBufferValue() {
+    const HloValue::Id id = buffers_.size();
+    auto const0 = builder_.AddInstruction(
+        HloInstruction::CreateConstant(LiteralUtil::CreateR0<float>(1.0)));
+    buffers_.emplace_back(std::make_unique<HloValue>(id, const0, ShapeIndex{}));
+    return buffers_.back().get();
+  }
+
+  // Allocates the buffers in order and frees them in a staggered order, so that
+  // many of them are live at the same time.
+  void AllocAndFreeStaggered(
+      HeapAlgorithm<HloValue>& heap,
+      const std::vector<std::pair<const HloValue*, int64_t>>& buffers) {
+    for (size_t i = 0; i < buffers.size(); ++i) {
+      heap.Alloc(buffers[i].first, buffers[i].second);
+      if (i % 3 == 2) {
+        heap.Free(buffers[i - 2].first, buffers[i - 2].second);
+      }
+    }
+    for (size_t i = 0; i < buffers.size(); ++i) {
+      if (i % 3 != 0 || i + 2 >= buffers.size()) {
+        heap.Free(buffers[i].first, buffers[i].second);
+      }
+    }
+  }
+
+ private:
+  HloComputation::Builder builder_;
+  std::vector<std::unique_ptr<HloValue>> buffers_;
+};
+
+TEST_F(ConstraintSolverHeapTest, FindsOptimalPacking) {
+  // The heap is as large as the buffers live at the same time as e.
+  const HloValue* a = DummyBufferValue();
+  const HloValue* b = DummyBufferValue();
+  const HloValue* c = DummyBufferValue();
+  const HloValue* d = DummyBufferValue();
+  const HloValue* e = DummyBufferValue();
+  ConstraintSolverHeap heap(/*alignment=*/1, ConstraintSolverHeap::Options());
+  heap.Alloc(a, 10);
+  heap.Alloc(b, 20);
+  heap.Alloc(c, 40);
+  heap.Free(a, 10);
+  heap.Alloc(d, 30);
+  heap.Alloc(e, 50);
+  heap.Free(b, 20);
+  heap.Free(c, 40);
+  heap.Free(d, 30);
+  heap.Free(e, 50);
+
+  TF_ASSERT_OK_AND_ASSIGN(const HeapSimulator::Result<HloValue> results,
+                          heap.Finish());
+  ASSERT_EQ(results.heap_results.size(), 1);
+  EXPECT_EQ(results.heap_size, 140);
+  EXPECT_EQ(results.heap_results[0].chunk_map.size(), 5);
+}
+
+TEST_F(ConstraintSolverHeapTest, NeverWorseThanBestFit) {
+  std::vector<std::pair<const HloValue*, int64_t>> buffers;
+  for (int64_t i = 0; i < 12; ++i) {
+    buffers.push_back({DummyBufferValue(), 8 + (i * 37) % 64});
+  }
+  GlobalDecreasingSizeBestFitHeap<HloValue> best_fit_heap(/*alignment=*/8);
+  AllocAndFreeStaggered(best_fit_heap, buffers);
+  TF_ASSERT_OK_AND_ASSIGN(const HeapSimulator::Result<HloValue> best_fit,
+                          best_fit_heap.Finish());
+
+  ConstraintSolverHeap::Options options;
+  options.max_solver_buffers = 6;
+  ConstraintSolverHeap heap(/*alignment=*/8, options);
+  AllocAndFreeStaggered(heap, buffers);
+  TF_ASSERT_OK_AND_ASSIGN(const HeapSimulator::Result<HloValue> results,
+                          heap.Finish());
+
+  EXPECT_LE(results.heap_size, best_fit.heap_size);
+  const HeapSimulator::HeapResult<HloValue>& result = results.heap_results[0];
+  ASSERT_EQ(result.chunk_map.size(), buffers.size());
+  for (const auto& [buffer, size] : buffers) {
+    EXPECT_EQ(result.chunk_map.at(buffer).offset % 8, 0);
+    EXPECT_EQ(result.chunk_map.at(buffer).size, size);
+    EXPECT_LE(result.chunk_map.at(buffer).chunk_end(), results.heap_size);
+  }
+}
+
+TEST_F(ConstraintSolverHeapTest, MatchesBestFitWithoutSolverBuffers) {
+  std::vector<std::pair<const HloValue*, int64_t>> buffers;
+  for (int64_t i = 0; i < 9; ++i) {
+    buffers.push_back({DummyBufferValue(), 16 + (i * 23) % 48});
+  }
+  GlobalDecreasingSizeBestFitHeap<HloValue> best_fit_heap(/*alignment=*/1);
+  AllocAndFreeStaggered(best_fit_heap, buffers);
+  TF_ASSERT_OK_AND_ASSIGN(const HeapSimulator::Result<HloValue> best_fit,
+                          best_fit_heap.Finish());
+
+  ConstraintSolverHeap::Options options;
+  options.max_solver_buffers = 0;
+  ConstraintSolverHeap heap(/*alignment=*/1, options);
+  AllocAndFreeStaggered(heap, buffers);
+  TF_ASSERT_OK_AND_ASSIGN(const HeapSimulator::Result<HloValue> results,
+                          heap.Finish());
+
+  EXPECT_EQ(results.heap_size, best_fit.heap_size);
+  for (const auto& [buffer, size] : buffers) {
+    EXPECT_EQ(results.heap_results[0].chunk_map.at(buffer).offset,
+              best_fit.heap_results[0].chunk_map.at(buffer).offset);
+  }
+}
+
+}  // namespace
+}  // namespace xla
@@ -19,6 +19,7 @@ limitations under the License.
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <functional>
 #include <iostream>
 #include <list>
@@ -427,7 +428,10 @@ class BufferIntervalTree {
       int64_t start, int64_t end) const;
 
   BufferIntervalTreeNode* root_ = nullptr;
-  std::list<BufferIntervalTreeNode> node_storage_;
+  // A deque keeps the nodes stable in memory like a list, but allocates them
+  // in contiguous blocks, which makes tree traversals more cache friendly and
+  // saves an allocation per node.
+  std::deque<BufferIntervalTreeNode> node_storage_;
 };
 
 // An iterator that is passed to
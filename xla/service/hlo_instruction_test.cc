@@ -64,6 +64,7 @@ namespace {
 namespace m = ::xla::match;
 
 using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
 using ::testing::UnorderedElementsAre;
 using ::tsl::proto_testing::EqualsProto;
 
@@ -589,6 +590,40 @@ TEST_F(HloInstructionTest, ReplaceAllUsesInMultipleOps) {
   EXPECT_THAT(bar->users(), UnorderedElementsAre(add_foobar, exp, tuple));
 }
 
+TEST_F(HloInstructionTest, ReplaceAllUsesWithUnusedInstruction) {
+  // An instruction without users takes over the user list as a whole. Use
+  // enough users that the list keeps a membership map.
+  HloComputation::Builder builder(TestName());
+  auto foo =
+      builder.AddInstruction(HloInstruction::CreateParameter(0, r0f32_, "foo"));
+  auto bar =
+      builder.AddInstruction(HloInstruction::CreateParameter(1, r0f32_, "bar"));
+  std::vector<HloInstruction*> negates;
+  for (int i = 0; i < 20; ++i) {
+    negates.push_back(builder.AddInstruction(
+        HloInstruction::CreateUnary(r0f32_, HloOpcode::kNegate, foo)));
+  }
+  builder.AddInstruction(HloInstruction::CreateTuple(negates));
+  auto module = CreateNewVerifiedModule();
+  module->AddEntryComputation(builder.Build());
+
+  std::vector<HloInstruction*> foo_users(foo->users().begin(),
+                                         foo->users().end());
+  ASSERT_IS_OK(foo->ReplaceAllUsesWith(bar));
+
+  EXPECT_EQ(0, foo->user_count());
+  EXPECT_THAT(bar->users(), ElementsAreArray(foo_users));
+  for (HloInstruction* negate : negates) {
+    EXPECT_EQ(negate->operand(0), bar);
+    EXPECT_TRUE(negate->IsUserOf(bar));
+  }
+
+  // The membership map moved along with the users.
+  ASSERT_IS_OK(negates[3]->ReplaceOperandWith(0, foo));
+  EXPECT_EQ(19, bar->user_count());
+  EXPECT_THAT(foo->users(), ElementsAre(negates[3]));
+}
+
 // Simple visitor that collects and post-processes each node in the graph.
 class NodeCollectorAndPostProcessor : public DfsHloVisitorWithDefault {
  public:
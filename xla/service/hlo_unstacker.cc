@@ -33,6 +33,7 @@ limitations under the License.
 #include "absl/status/status.h"
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
 #include "absl/strings/string_view.h"
 #include "xla/hlo/ir/hlo_computation.h"
 #include "xla/hlo/ir/hlo_instruction.h"
@@ -57,6 +58,7 @@ enum class PatternType {
   DSFusionNoBitcastPattern,
   DSFusionPattern,
   NestedDSFusionPattern,
+  DSOperandFusionPattern,
   Other,
 };
 
@@ -68,6 +70,8 @@ static std::string PatternTypeToString(PatternType pattern_type) {
       return "DSFusionPattern";
     case PatternType::NestedDSFusionPattern:
       return "NestedDSFusionPattern";
+    case PatternType::DSOperandFusionPattern:
+      return "DSOperandFusionPattern";
     case PatternType::Other:
       return "Other";
   }
@@ -148,6 +152,8 @@ class UnstackerTransformer {
     // Currently, we only unstack operands that are used within fusion
     // computations.
     if (instr->opcode() != HloOpcode::kFusion) {
+      SetFailureReason(absl::StrCat("used by ", instr->name(),
+                                    ", which is not a fusion"));
       return {};
     }
     VLOG(3) << "HandleInstruction(" << instr->shape().ToString()
@@ -179,6 +185,9 @@ class UnstackerTransformer {
                   << "\n current computations: \n"
                   << pattern_info.unstacking_computation->ToString(
                          HloPrintOptions::Fingerprint());
+          SetFailureReason(absl::StrCat(
+              "users need different unstacking computations, e.g. ",
+              instr->name()));
           return {};
         }
       }
@@ -202,6 +211,8 @@ class UnstackerTransformer {
       body_changes_.push_back(unstack_wrapper);
       return pattern_info.unstacked_instrs;
     }
+    SetFailureReason(
+        absl::StrCat("no unstacking pattern matches ", instr->name()));
     return {};
   }
 
@@ -244,8 +255,19 @@ class UnstackerTransformer {
 
   PatternType GetPatternType() const { return pattern_type_; }
 
+  // Records why the operand cannot be unstacked. Only the first reason is
+  // kept, since the later ones are usually a consequence of it.
+  void SetFailureReason(std::string reason) {
+    if (failure_reason_.empty()) {
+      failure_reason_ = std::move(reason);
+    }
+  }
+
+  const std::string& GetFailureReason() const { return failure_reason_; }
+
  private:
   PatternType pattern_type_;
+  std::string failure_reason_;
   const UnstackerMetadata& metadata_;
   // This pointer is populated if the unstacker finds unstackable loop input.
   std::unique_ptr<Shape> unstacked_shape_ = nullptr;
@@ -273,7 +295,8 @@ bool CanUnstackWhileOperand(const HloInstruction* while_instr,
 
 bool UnstackWhileOperandAtIndex(
     const UnstackerMetadata& metadata, HloInstruction* while_instr,
-    int64_t index, std::vector<const HloInstruction*>& unstacked_instructions);
+    int64_t index, std::vector<const HloInstruction*>& unstacked_instructions,
+    std::string* failure_reason);
 
 // Given a gte and an unstacker instance, this function walks down the graph of
 // the users in BFS manner and propagates the index of the changed input operand
@@ -509,13 +532,13 @@ void UnstackWhileInput(const UnstackerTransformer& unstacker,
       HloInstruction* slice = nullptr;
       if (unstacker.GetPatternType() == PatternType::DSFusionPattern ||
           unstacker.GetPatternType() == PatternType::NestedDSFusionPattern ||
-          unstacker.GetPatternType() == PatternType::DSFusionNoBitcastPattern) {
+          unstacker.GetPatternType() == PatternType::DSFusionNoBitcastPattern ||
+          unstacker.GetPatternType() == PatternType::DSOperandFusionPattern) {
         if (unstacker.GetPatternType() == PatternType::DSFusionPattern ||
             unstacker.GetPatternType() == PatternType::NestedDSFusionPattern) {
           slice = while_instr->AddInstruction(DynamicSliceToSlice(
               root_instr->mutable_operand(0), old_while_input, i));
-        } else if (unstacker.GetPatternType() ==
-                   PatternType::DSFusionNoBitcastPattern) {
+        } else {
           slice = while_instr->AddInstruction(
               DynamicSliceToSlice(root_instr, old_while_input, i));
         }
@@ -596,6 +619,8 @@ bool CanUnstackWhileOperand(const HloInstruction* while_instr,
     } else if (!Match(gte_operand, match::Parameter().WithParameterNum(0))) {
       VLOG(3) << "Failed: root operand of while_body at " << index
               << " is not a parameter";
+      unstacker.SetFailureReason(absl::StrCat(
+          "the loop body updates the operand with ", root_operand->name()));
       return false;
     }
   }
@@ -627,10 +652,12 @@ bool CanUnstackWhileOperand(const HloInstruction* while_instr,
 }
 
 // Apply the two-step unstacking algorithm to the given while_instr at the given
-// index.
+// index. If the operand is not unstacked, `failure_reason` is set to the
+// reason.
 bool UnstackWhileOperandAtIndex(
     const UnstackerMetadata& metadata, HloInstruction* while_instr,
-    int64_t index, std::vector<const HloInstruction*>& unstacked_instructions) {
+    int64_t index, std::vector<const HloInstruction*>& unstacked_instructions,
+    std::string* failure_reason) {
   UnstackerTransformer unstacker = UnstackerTransformer(metadata);
 
   // First step of unstacking to determine whether while_instr at index is
@@ -639,6 +666,7 @@ bool UnstackWhileOperandAtIndex(
   if (!can_unstack) {
     VLOG(3) << "Unstacking failed for " << while_instr->name() << " at "
             << index;
+    *failure_reason = unstacker.GetFailureReason();
     return false;
   }
 
@@ -646,6 +674,7 @@ bool UnstackWhileOperandAtIndex(
   // applying the unstacker changes.
   if (unstacker.GetUnstackedShape() == nullptr) {
     VLOG(3) << "Failed: unstacked shape is null";
+    *failure_reason = "no user slices the operand";
     return false;
   }
 
@@ -653,6 +682,7 @@ bool UnstackWhileOperandAtIndex(
   // applying the unstacker changes.
   if (unstacker.GetUnstackingComputation() == nullptr) {
     VLOG(3) << "Failed: unstacking computation is null";
+    *failure_reason = "no unstacking computation was found";
     return false;
   }
 
@@ -1398,6 +1428,116 @@ absl::Status UnstackReduceFusionPattern(HloInstruction* mutable_reduce_fusion,
   return mutable_reduce_fusion->ReplaceAllUsesWithDifferentShape(new_operand);
 }
 
+// This function recognizes fusions that read the stacked operand only through
+// a shape-covering dynamic-slice, whatever else they compute, e.g., a
+// dequantization of the slice or a dot of the slice with other operands:
+// fusion(..., stacked, ..., loop_iteration_var, ...)
+// computation {
+//   p0 = parameter(0)
+//   ...
+//   p1 = parameter(1)
+//   slice = dynamic_slice(p0, p1, zero, ...)
+//   convert = convert(slice)
+//   ROOT dot = dot(convert, ...)
+// }
+// The fusion must contain no other dynamic-slice, and the offset of the
+// dynamic-slice must be a parameter of the fusion.
+std::optional<PatternInfo> GetDSOperandFusionPattern(
+    const UnstackerMetadata& metadata, const HloInstruction* instr,
+    int64_t stacked_operand_idx) {
+  VLOG(3) << "Checking DSOperandFusion";
+  std::optional<WhileLoopConfig> while_instr_config =
+      IsFusionInsideUnrollableLoopWithNumParameter(metadata, instr,
+                                                   std::nullopt);
+  if (!while_instr_config.has_value()) {
+    return std::nullopt;
+  }
+  HloComputation* fused_computation = instr->fused_instructions_computation();
+  const HloInstruction* stacked_param =
+      fused_computation->parameter_instruction(stacked_operand_idx);
+  if (stacked_param->user_count() != 1) {
+    return std::nullopt;
+  }
+  HloInstruction* ds = stacked_param->users().front();
+  if (ds->opcode() != HloOpcode::kDynamicSlice ||
+      ds->operand(0) != stacked_param ||
+      ds->operand(1)->opcode() != HloOpcode::kParameter) {
+    return std::nullopt;
+  }
+  if (absl::c_count_if(fused_computation->instructions(),
+                       HloPredicateIsOp<HloOpcode::kDynamicSlice>) != 1) {
+    return std::nullopt;
+  }
+  std::optional<int64_t> dynamic_index =
+      MatchShapeCoveringDynamicIndexInstruction(ds, stacked_param,
+                                                HloOpcode::kDynamicSlice,
+                                                while_instr_config.value());
+  if (!dynamic_index.has_value() || dynamic_index.value() != 0) {
+    return std::nullopt;
+  }
+  if (!ShouldUnfuseSlices(metadata, ds)) {
+    return std::nullopt;
+  }
+
+  // The unstacking computation only slices the stacked operand, the rest of
+  // the fusion stays in the loop body.
+  HloComputation::Builder builder("unstack_ds");
+  HloInstruction* p0 = builder.AddInstruction(
+      HloInstruction::CreateParameter(0, stacked_param->shape(), "p0"));
+  HloInstruction* p1 = builder.AddInstruction(
+      HloInstruction::CreateParameter(1, ds->operand(1)->shape(), "p1"));
+  HloInstruction* zero =
+      builder.AddInstruction(MakeScalarConstantWithShape(p1->shape(), 0));
+  std::vector<HloInstruction*> slice_starts(ds->shape().dimensions_size(),
+                                            zero);
+  slice_starts[0] = p1;
+  HloInstruction* slice =
+      builder.AddInstruction(HloInstruction::CreateDynamicSlice(
+          ds->shape(), p0, slice_starts, ds->dynamic_slice_sizes()));
+  HloComputation* unstack_ds =
+      instr->GetModule()->AddEmbeddedComputation(builder.Build(slice));
+
+  PatternInfo pattern_info;
+  pattern_info.type = PatternType::DSOperandFusionPattern;
+  pattern_info.instr = instr;
+  const int64_t num_layers = stacked_param->shape().dimensions(0);
+  pattern_info.unstacked_shape =
+      MakeUnstackedShapeFromSlice(ds->shape(), num_layers);
+  pattern_info.unstacking_computation = unstack_ds;
+  pattern_info.unstacked_instrs.push_back(instr);
+  return pattern_info;
+}
+
+// Replaces the dynamic-slice of the stacked operand inside the fusion with a
+// parameter that receives the slice.
+absl::Status UnstackDSOperandFusionPattern(HloInstruction* mutable_fusion,
+                                           const Shape& slice_shape) {
+  HloComputation* parent_loop = mutable_fusion->parent();
+  HloComputation* fused_computation =
+      mutable_fusion->fused_instructions_computation();
+  HloInstruction* ds = *absl::c_find_if(
+      fused_computation->instructions(),
+      HloPredicateIsOp<HloOpcode::kDynamicSlice>);
+  int64_t stacked_param_number = ds->operand(0)->parameter_number();
+  HloInstruction* stacked =
+      mutable_fusion->mutable_operand(stacked_param_number);
+  HloInstruction* offset =
+      mutable_fusion->mutable_operand(ds->operand(1)->parameter_number());
+
+  HloInstruction* sliced_param = fused_computation->ReplaceParameter(
+      stacked_param_number,
+      HloInstruction::CreateParameter(stacked_param_number, slice_shape,
+                                      "sliced"));
+  TF_RETURN_IF_ERROR(ds->ReplaceAllUsesWith(sliced_param));
+  TF_RETURN_IF_ERROR(fused_computation->RemoveInstruction(ds));
+
+  HloInstruction* new_operand =
+      parent_loop->AddInstruction(HloInstruction::CreateCustomCall(
+          slice_shape, {stacked, offset}, "DynamicGte"));
+  return mutable_fusion->ReplaceOperandWithDifferentShape(stacked_param_number,
+                                                          new_operand);
+}
+
 };  // namespace
 
 // The entry point of the unstacking algorithm. Given a module, it creates the
@@ -1431,6 +1571,10 @@ absl::StatusOr<bool> HloUnstacker::Run(
       std::make_pair(GetNestedDSFusionPattern, UnstackNestedDSFusionPattern));
   metadata.custom_handlers.push_back(std::make_pair(
       GetDSFusionNoBitcastPattern, UnstackDSFusionNoBitcastPattern));
+  // This pattern covers fusions that the patterns above also match, so it is
+  // checked last.
+  metadata.custom_handlers.push_back(std::make_pair(
+      GetDSOperandFusionPattern, UnstackDSOperandFusionPattern));
 
   std::vector<HloInstruction*> entry_loops;
   for (HloInstruction* instr :
@@ -1445,25 +1589,42 @@ absl::StatusOr<bool> HloUnstacker::Run(
   int64_t num_unstacked = 0;
   bool unstacked = false;
   std::vector<const HloInstruction*> unstacked_instructions;
+  // Operands that look stacked, i.e., whose most major dimension is the trip
+  // count of their loop, but were left stacked, with the reason.
+  std::vector<std::string> left_stacked;
   for (HloInstruction* loop : entry_loops) {
+    auto config = metadata.unrollable_loop_bodies.find(loop->while_body());
     for (int64_t i = 0; i < loop->shape().tuple_shapes_size(); ++i) {
       // We don't handle tuples and if we see then we assume they come from a
       // previous unstacking attempt.
-      if (loop->while_init()->operand(i)->shape().IsTuple()) {
+      const Shape& operand_shape = loop->while_init()->operand(i)->shape();
+      if (operand_shape.IsTuple()) {
         continue;
       }
       VLOG(3) << "Attempting to unstack " << loop->name() << " at " << i
-              << " = " << loop->while_init()->operand(i)->shape().ToString(true)
+              << " = " << operand_shape.ToString(true)
               << loop->while_init()->operand(i)->ToShortString();
-      bool current_unstacked =
-          UnstackWhileOperandAtIndex(metadata, loop, i, unstacked_instructions);
+      std::string failure_reason;
+      bool current_unstacked = UnstackWhileOperandAtIndex(
+          metadata, loop, i, unstacked_instructions, &failure_reason);
       if (current_unstacked) {
         num_unstacked++;
         unstacked = true;
+      } else if (config != metadata.unrollable_loop_bodies.end() &&
+                 operand_shape.IsArray() &&
+                 operand_shape.dimensions_size() > 0 &&
+                 operand_shape.dimensions(0) == config->second.trip_count) {
+        left_stacked.push_back(absl::StrCat(loop->name(), " at ", i, " (",
+                                            operand_shape.ToString(), "): ",
+                                            failure_reason));
       }
       VLOG(3) << "###################";
     }
   }
+  if (!left_stacked.empty()) {
+    VLOG(1) << "Operands left stacked in " << module->name() << ":\n  "
+            << absl::StrJoin(left_stacked, "\n  ");
+  }
   if (!unstacked) {
     return false;
   }
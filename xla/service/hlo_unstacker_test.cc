@@ -265,6 +265,68 @@ TEST_F(UnstackerTest, UnstackDSFusionPatternWithUnusedOperand) {
                                       std::nullopt, false));
 }
 
+TEST_F(UnstackerTest, UnstackDSOperandFusionPattern) {
+  std::string hlo_string = R"(
+  HloModule SimpleLoop
+  %fused_computation.dequantize_dot (param_0.51117: s8[3,128,128], p1: s32[], p2: bf16[8,128]) -> bf16[8,128] {
+    %param_0.51117 = s8[3,128,128] parameter(0)
+    p1 = s32[] parameter(1)
+    p2 = bf16[8,128] parameter(2)
+    %constant.85694 = s32[] constant(0)
+    %dynamic-slice.22040 = s8[1,128,128] dynamic-slice(s8[3,128,128] %param_0.51117, p1, s32[] %constant.85694, s32[] %constant.85694), dynamic_slice_sizes={1,128,128}
+    %bitcast.31250 = s8[128,128] bitcast(s8[1,128,128] %dynamic-slice.22040)
+    convert = bf16[128,128] convert(%bitcast.31250)
+    ROOT dot = bf16[8,128] dot(p2, convert), lhs_contracting_dims={1}, rhs_contracting_dims={0}
+  }
+
+  %while.body (wide_param: (s32[], bf16[8,128], s8[3,128,128])) -> (s32[], bf16[8,128], s8[3,128,128]) {
+    wide_p = (s32[], bf16[8,128], s8[3,128,128]) parameter(0)
+    i = s32[] get-tuple-element(wide_p), index=0
+    p0 = bf16[8,128] get-tuple-element(wide_p), index=1
+    p1 = s8[3,128,128] get-tuple-element(wide_p), index=2
+    one = s32[] constant(1)
+    inc = s32[] add(i, one)
+    %fusion.67830 = bf16[8,128] fusion(s8[3,128,128] p1, i, p0), kind=kOutput, calls=%fused_computation.dequantize_dot
+    ROOT out = (s32[], bf16[8,128], s8[3,128,128]) tuple(inc, %fusion.67830, p1)
+  }
+
+  %while.cond (wide_param: (s32[], bf16[8,128], s8[3,128,128])) -> pred[] {
+    wide_p = (s32[], bf16[8,128], s8[3,128,128]) parameter(0)
+    i = s32[] get-tuple-element(wide_p), index=0
+    %constant.12857 = s32[] constant(3)
+    ROOT %compare.1921 = pred[]{:T(512)} compare(s32[] i, s32[] %constant.12857), direction=LT
+  }
+
+  ENTRY main {
+    p0 = s8[3,128,128] parameter(0)
+    p1 = bf16[8,128] parameter(1)
+    init = s32[] constant(0)
+    while.input = (s32[], bf16[8,128], s8[3,128,128]) tuple(init, p1, p0)
+    while.out = (s32[], bf16[8,128], s8[3,128,128]) while(while.input), condition=%while.cond , body=%while.body
+    while_use = s8[3,128,128] get-tuple-element(while.out), index=2
+    ROOT out = bf16[8,128] get-tuple-element(while.out), index=1
+  }
+  )";
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+  auto original = module->Clone();
+  TF_ASSERT_OK_AND_ASSIGN(bool unstacked, HloUnstacker().Run(module.get()));
+  EXPECT_TRUE(unstacked);
+  // Check for the creation of slice instructions. The dequantization and the
+  // dot stay fused, but no longer slice the stacked operand.
+  EXPECT_EQ(GetInstrCountWithOpcodeInEntry(module.get(), HloOpcode::kSlice), 3);
+  for (HloInstruction* instr :
+       module->entry_computation()->MakeInstructionPostOrder()) {
+    if (instr->opcode() == HloOpcode::kFusion) {
+      EXPECT_EQ(instr->fused_expression_root()->opcode(), HloOpcode::kDot);
+      EXPECT_EQ(instr->operand(0)->shape().dimensions_size(), 3);
+      EXPECT_EQ(instr->operand(0)->shape().dimensions(0), 1);
+    }
+  }
+  EXPECT_TRUE(RunAndCompareTwoModules(std::move(module), std::move(original),
+                                      std::nullopt, false));
+}
+
 TEST_F(UnstackerTest, UnstackReduceFusionPattern) {
   std::string hlo_string = R"(
   HloModule SimpleLoop
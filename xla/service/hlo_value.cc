@@ -156,6 +156,32 @@ void HloValue::SetPositions(absl::Span<const HloPosition> positions) {
       IsRootOf(defining_instruction()->GetModule()->entry_computation());
 }
 
+void HloValue::AddPosition(HloInstruction* instruction,
+                           const ShapeIndex& index) {
+  HloPosition new_position{instruction, index};
+  DCHECK(!absl::c_linear_search(positions_, new_position));
+  positions_.push_back(std::move(new_position));
+  live_out_of_module_ =
+      IsRootOf(defining_instruction()->GetModule()->entry_computation());
+  InvalidateUses();
+}
+
+void HloValue::RemovePosition(HloInstruction* instruction,
+                              const ShapeIndex& index) {
+  HloPosition position{instruction, index};
+  CHECK_NE(position, defining_position());
+  auto it = absl::c_find(positions_, position);
+  CHECK(it != positions_.end());
+  positions_.erase(it);
+  live_out_of_module_ =
+      IsRootOf(defining_instruction()->GetModule()->entry_computation());
+  InvalidateUses();
+}
+
+void HloValue::InvalidateUses() {
+  uses_ = Lazy<Uses>([this] { return ComputeUses(); });
+}
+
 HloValue::Uses HloValue::ComputeUses() const {
   // Gather the computation roots at which this value appears.
   absl::flat_hash_set<HloInstruction*> root_positions;
@@ -129,6 +129,15 @@ class HloValue : public BufferValue {
   // 'positions' as this is set at construction time.
   void SetPositions(absl::Span<const HloPosition> positions);
 
+  // Adds or removes a non-defining position of the HloValue. Used to keep the
+  // HloValue up to date after the module changed.
+  void AddPosition(HloInstruction* instruction, const ShapeIndex& index);
+  void RemovePosition(HloInstruction* instruction, const ShapeIndex& index);
+
+  // Makes the next GetUses call recompute the uses, e.g. after the users of an
+  // instruction at one of the positions changed.
+  void InvalidateUses();
+
   // Returns whether this value is a phi value.
   bool is_phi() const { return is_phi_; }
 
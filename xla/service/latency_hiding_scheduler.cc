@@ -38,6 +38,7 @@ limitations under the License.
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
 #include "xla/debug_options_flags.h"
 #include "xla/hlo/analysis/hlo_alias_analysis.h"
@@ -47,6 +48,7 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_instructions.h"
 #include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/hlo/ir/hlo_print_options.h"
 #include "xla/hlo/ir/hlo_schedule.h"
 #include "xla/map_util.h"
 #include "xla/service/dump.h"
@@ -60,6 +62,7 @@ limitations under the License.
 #include "xla/tsl/platform/statusor.h"
 #include "xla/util.h"
 #include "xla/xla.pb.h"
+#include "tsl/platform/fingerprint.h"
 
 namespace xla {
 namespace {
@@ -2408,6 +2411,7 @@ absl::Status DefaultSchedulerCore::InitializeScheduler(
       module, alias_analysis_.get(), shape_size_bytes_);
   module_pressure_state_->InitializePressureStates();
   module_pressure_state_->SetMemoryPeak(0);
+  schedule_cycles_ = 0;
   annotation_tracker_ = std::make_unique<AnnotationTracker>(module);
   if (VLOG_IS_ON(2)) {
     annotation_tracker_->PrintAnnotationSets(2);
@@ -2480,6 +2484,56 @@ bool DefaultSchedulerCore::SchedulingAnnotationCrossesOverlapLimit(
   }
   return false;
 }
+std::optional<LatencyHidingScheduleCache::Entry>
+LatencyHidingScheduleCache::Find(const Key& key) const {
+  absl::MutexLock lock(&mutex_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+void LatencyHidingScheduleCache::Insert(const Key& key, Entry entry) {
+  absl::MutexLock lock(&mutex_);
+  if (entries_.size() >= max_entries_) {
+    entries_.clear();
+  }
+  entries_[key] = std::move(entry);
+}
+
+int64_t LatencyHidingScheduleCache::size() const {
+  absl::MutexLock lock(&mutex_);
+  return entries_.size();
+}
+
+LatencyHidingScheduleCache::Key DefaultSchedulerCore::ScheduleCacheKey(
+    const HloComputation* computation, const HloInstructionSequence& sequence,
+    const MemoryPressureTracker& memory_pressure_tracker) const {
+  // Printing in the input order makes the canonical names, and so the key,
+  // depend on it. Backend configs and control dependencies constrain the
+  // schedule as well.
+  HloPrintOptions options = HloPrintOptions::Fingerprint()
+                                .set_print_backend_config(true)
+                                .set_print_control_dependencies(true);
+  std::string key = absl::StrCat(
+      schedule_cache_context_, ";", config_.memory_limit, ";",
+      memory_pressure_tracker.memory_usage(), ";",
+      computation->ToString(options, sequence.instructions()));
+  // The peaks of the called computations contribute to the memory pressure.
+  for (const HloInstruction* instr : sequence.instructions()) {
+    for (const HloComputation* called : instr->called_computations()) {
+      if (module_pressure_state_->ComputationIsMemoryTracked(called)) {
+        absl::StrAppend(
+            &key, ";",
+            module_pressure_state_->GetPressureStateForComputation(called)
+                .memory_peak);
+      }
+    }
+  }
+  return tsl::Fingerprint128(key);
+}
+
 absl::StatusOr<std::vector<HloInstruction*>>
 DefaultSchedulerCore::ScheduleComputation(const HloComputation* computation) {
   const HloSchedule& module_schedule = computation->parent()->schedule();
@@ -2491,6 +2545,33 @@ DefaultSchedulerCore::ScheduleComputation(const HloComputation* computation) {
       module_pressure_state_->GetPressureStateForComputation(computation)
           .live_ids_at_bottom);
 
+  // The schedule proto needs the schedule graph, which is not cached.
+  std::optional<LatencyHidingScheduleCache::Key> cache_key;
+  if (schedule_cache_ != nullptr && !schedule_proto_.has_value()) {
+    const HloInstructionSequence& sequence =
+        module_schedule.sequence(computation);
+    cache_key =
+        ScheduleCacheKey(computation, sequence, memory_pressure_tracker);
+    if (std::optional<LatencyHidingScheduleCache::Entry> entry =
+            schedule_cache_->Find(*cache_key);
+        entry.has_value() && entry->positions.size() == sequence.size()) {
+      VLOG(1) << "Reusing cached schedule of " << computation->name();
+      std::vector<HloInstruction*> new_sequence;
+      new_sequence.reserve(entry->positions.size());
+      for (int64_t position : entry->positions) {
+        new_sequence.push_back(sequence.instructions()[position]);
+      }
+      // Replay the schedule bottom up to track its memory pressure.
+      for (auto it = new_sequence.rbegin(); it != new_sequence.rend(); ++it) {
+        memory_pressure_tracker.UpdateBuffers(*it);
+      }
+      module_pressure_state_->UpdatePressureStateForComputation(
+          computation, memory_pressure_tracker.pressure_state());
+      schedule_cycles_ += entry->total_cycles;
+      return new_sequence;
+    }
+  }
+
   SchedulingState sched_state(
       &module_schedule.sequence(computation), alias_analysis_.get(),
       latency_estimator_, async_tracker_, &memory_pressure_tracker, config_);
@@ -2590,12 +2671,30 @@ DefaultSchedulerCore::ScheduleComputation(const HloComputation* computation) {
           << sched_state.sched_graph
                  .GetNode(sched_state.new_sequence_reversed.front())
                  .GetReadyTime();
+  const HloGraphNode& first_node = sched_state.sched_graph.GetNode(
+      sched_state.new_sequence_reversed.front());
+  const double total_cycles = first_node.GetReadyTime() + first_node.GetCost();
+  schedule_cycles_ += total_cycles;
 
   if (schedule_proto_.has_value()) {
     *schedule_proto_->add_computation_schedules() = ComputationScheduleToProto(
         computation, sched_state.sched_graph, *latency_estimator_,
         sched_state.new_sequence_reversed);
   }
+  if (cache_key.has_value()) {
+    const HloInstructionSequence& sequence =
+        module_schedule.sequence(computation);
+    absl::flat_hash_map<const HloInstruction*, int64_t> input_positions;
+    for (int64_t i = 0; i < sequence.size(); ++i) {
+      input_positions[sequence.instructions()[i]] = i;
+    }
+    std::vector<int64_t> positions;
+    positions.reserve(sched_state.new_sequence_reversed.size());
+    for (const HloInstruction* instr : sched_state.new_sequence_reversed) {
+      positions.push_back(input_positions.at(instr));
+    }
+    schedule_cache_->Insert(*cache_key, {std::move(positions), total_cycles});
+  }
   return std::move(sched_state.new_sequence_reversed);
 }
 
@@ -2832,6 +2931,86 @@ LatencyHidingScheduler::SchedulerStatistics::ToProto() const {
   return proto;
 }
 
+absl::Status LatencyHidingScheduler::SearchMemoryLimit(
+    HloModule* module, absl::Span<HloComputation* const> computations,
+    absl::flat_hash_map<HloComputation*, std::vector<HloInstruction*>>&
+        schedules) {
+  const uint64_t memory_limit = scheduler_core_->GetMemoryLimit();
+  auto fits = [&](const ScheduleCandidate& candidate) {
+    return static_cast<uint64_t>(candidate.memory_peak) <= memory_limit;
+  };
+  // Prefers fitting schedules with fewer cycles, and otherwise lower peaks.
+  auto is_better = [&](const ScheduleCandidate& a,
+                       const ScheduleCandidate& b) {
+    if (fits(a) != fits(b)) {
+      return fits(a);
+    }
+    if (fits(a)) {
+      return std::make_pair(a.total_cycles, a.memory_peak) <
+             std::make_pair(b.total_cycles, b.memory_peak);
+    }
+    return a.memory_peak < b.memory_peak;
+  };
+  std::vector<ScheduleCandidate> candidates = {
+      {memory_limit, scheduler_core_->GetMemoryPeak(),
+       scheduler_core_->GetScheduleCycles()}};
+  ScheduleCandidate best = candidates.front();
+  // Candidates scheduled with limits up to `lower` fit, ones scheduled with
+  // `upper` do not, so the limits in between are left to explore.
+  uint64_t lower = 0;
+  uint64_t upper = memory_limit;
+  for (int64_t iter = 0; !fits(candidates.front()) &&
+                         iter < scheduler_core_->GetRerunTimes() &&
+                         upper - lower > 1;
+       ++iter) {
+    const uint64_t limit = lower + (upper - lower) / 2;
+    TF_RETURN_IF_ERROR(scheduler_core_->InitializeScheduler(module));
+    scheduler_core_->SetMemoryLimit(limit);
+    absl::flat_hash_map<HloComputation*, std::vector<HloInstruction*>>
+        new_schedules;
+    for (HloComputation* computation : computations) {
+      TF_ASSIGN_OR_RETURN(new_schedules[computation],
+                          scheduler_core_->ScheduleComputation(computation));
+    }
+    ScheduleCandidate candidate = {limit, scheduler_core_->GetMemoryPeak(),
+                                   scheduler_core_->GetScheduleCycles()};
+    VLOG(1) << "LatencyHidingScheduler memory limit " << limit
+            << " bytes gives a peak of " << candidate.memory_peak
+            << " bytes and " << candidate.total_cycles << " cycles";
+    // Backtrack toward more overlap once a schedule fits.
+    if (fits(candidate)) {
+      lower = limit;
+    } else {
+      upper = limit;
+    }
+    if (is_better(candidate, best)) {
+      best = candidate;
+      schedules = std::move(new_schedules);
+    }
+    candidates.push_back(candidate);
+  }
+  scheduler_core_->SetMemoryLimit(best.scheduler_memory_limit);
+  LOG(INFO) << "LatencyHidingScheduler memory usage: " << best.memory_peak
+            << " bytes, limit: " << memory_limit << " bytes, found with "
+            << "scheduler memory limit " << best.scheduler_memory_limit
+            << " after " << candidates.size() << " schedules";
+
+  absl::c_sort(candidates,
+               [](const ScheduleCandidate& a, const ScheduleCandidate& b) {
+                 return std::make_pair(a.memory_peak, a.total_cycles) <
+                        std::make_pair(b.memory_peak, b.total_cycles);
+               });
+  for (const ScheduleCandidate& candidate : candidates) {
+    if (pareto_frontier_.empty() ||
+        candidate.total_cycles < pareto_frontier_.back().total_cycles) {
+      pareto_frontier_.push_back(candidate);
+      VLOG(1) << "Pareto frontier: memory peak " << candidate.memory_peak
+              << " bytes, " << candidate.total_cycles << " cycles";
+    }
+  }
+  return absl::OkStatus();
+}
+
 void LatencyHidingScheduler::LogScheduleStatistics(
     const HloComputation* computation) {
   XLA_VLOG_LINES(
@@ -2881,7 +3060,13 @@ absl::StatusOr<bool> LatencyHidingScheduler::Run(
     saved_schedules[computation] = std::move(new_schedule);
   }
   uint64_t initial_memory_limit = scheduler_core_->GetMemoryLimit();
+  pareto_frontier_.clear();
+  if (scheduler_core_->SearchMemoryLimit()) {
+    TF_RETURN_IF_ERROR(
+        SearchMemoryLimit(module, computations_to_schedule, saved_schedules));
+  }
   for (int64_t iter = 0;
+       !scheduler_core_->SearchMemoryLimit() &&
        iter < scheduler_core_->GetRerunTimes() &&
        scheduler_core_->GetMemoryPeak() > initial_memory_limit;
        iter++) {
@@ -2899,9 +3084,11 @@ absl::StatusOr<bool> LatencyHidingScheduler::Run(
       saved_schedules[computation] = std::move(new_schedule);
     }
   }
-  LOG(INFO) << "LatencyHidingScheduler current memory usage: "
-            << scheduler_core_->GetMemoryPeak()
-            << " bytes. Current limit: " << scheduler_core_->GetMemoryLimit();
+  if (!scheduler_core_->SearchMemoryLimit()) {
+    LOG(INFO) << "LatencyHidingScheduler current memory usage: "
+              << scheduler_core_->GetMemoryPeak()
+              << " bytes. Current limit: " << scheduler_core_->GetMemoryLimit();
+  }
   for (HloComputation* computation : computations_to_schedule) {
     VLOG(1) << "Statistics before scheduling:";
     LogScheduleStatistics(computation);
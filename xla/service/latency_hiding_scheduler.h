@@ -28,6 +28,7 @@ limitations under the License.
 #include <vector>
 
 #include "absl/algorithm/container.h"
+#include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/container/inlined_vector.h"
@@ -37,6 +38,7 @@ limitations under the License.
 #include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
 #include "xla/hlo/analysis/hlo_alias_analysis.h"
 #include "xla/hlo/ir/hlo_computation.h"
@@ -53,6 +55,7 @@ limitations under the License.
 #include "xla/side_effect_util.h"
 #include "xla/status_macros.h"
 #include "xla/xla.pb.h"
+#include "tsl/platform/fingerprint.h"
 
 namespace xla {
 
@@ -149,6 +152,10 @@ struct SchedulerConfig {
   bool enable_selective_resources = false;
   int64_t max_hops_to_closest_selective_overlap = 0;
   int64_t rerun = 0;
+  // If the schedule does not fit in `memory_limit`, bisects the limit the
+  // scheduler works with over the `rerun` attempts instead of lowering it by
+  // 10% each time, and keeps the fitting schedule with the fewest cycles.
+  bool search_memory_limit = false;
   int64_t parallel_collective_overlap_limit = 1;
 };
 
@@ -346,6 +353,10 @@ class SchedulerCore {
   virtual void SetMemoryLimit(uint64_t new_limit) = 0;
   virtual uint64_t GetMemoryLimit() = 0;
   virtual int64_t GetRerunTimes() = 0;
+  virtual bool SearchMemoryLimit() = 0;
+  // Returns the estimated cycles of the computations scheduled since the last
+  // call to InitializeScheduler.
+  virtual double GetScheduleCycles() = 0;
 };
 
 // Tracks user annotations for scheduling.
@@ -997,6 +1008,39 @@ class ModulePressureState {
   int64_t memory_peak_ = 0;
 };
 
+// Caches latency hiding schedules of computations, so that recompiling a module
+// after an edit only reschedules the computations that changed. Entries are
+// keyed on a fingerprint of the computation in its input order, the memory
+// pressure it is scheduled under and a context describing the latency
+// estimator and the scheduler configuration. They hold the positions of the
+// scheduled instructions in the input order. Thread-safe.
+class LatencyHidingScheduleCache {
+ public:
+  using Key = tsl::Fprint128;
+
+  struct Entry {
+    std::vector<int64_t> positions;
+    // Estimated cycles of the schedule.
+    double total_cycles = 0;
+  };
+
+  explicit LatencyHidingScheduleCache(int64_t max_entries = 4096)
+      : max_entries_(max_entries) {}
+
+  std::optional<Entry> Find(const Key& key) const;
+
+  // Drops all entries once the cache is full.
+  void Insert(const Key& key, Entry entry);
+
+  int64_t size() const;
+
+ private:
+  const int64_t max_entries_;
+  mutable absl::Mutex mutex_;
+  absl::flat_hash_map<Key, Entry, tsl::Fprint128Hasher> entries_
+      ABSL_GUARDED_BY(mutex_);
+};
+
 // Implementation of the default scheduling algorithm.
 class DefaultSchedulerCore : public SchedulerCore {
  public:
@@ -1169,6 +1213,17 @@ class DefaultSchedulerCore : public SchedulerCore {
     this->config_.memory_limit = new_limit;
   }
   int64_t GetRerunTimes() override { return config_.rerun; }
+  bool SearchMemoryLimit() override { return config_.search_memory_limit; }
+  double GetScheduleCycles() override { return schedule_cycles_; }
+  // Reuses schedules from `cache` for computations that were scheduled before
+  // under the same memory pressure. `context` must identify the latency
+  // estimator, the async tracker and the scheduler configuration, as the cache
+  // can not tell them apart.
+  void SetScheduleCache(LatencyHidingScheduleCache* cache,
+                        std::string context) {
+    schedule_cache_ = cache;
+    schedule_cache_context_ = std::move(context);
+  }
   bool SchedulingAnnotationCrossesOverlapLimit(
       const SchedulingState& sched_state, int64_t annotation);
   absl::flat_hash_map<int64_t, int64_t> GetNumResourcesNeededForAnnotation(
@@ -1213,6 +1268,16 @@ class DefaultSchedulerCore : public SchedulerCore {
   std::unique_ptr<AnnotationTracker> annotation_tracker_;
   std::optional<ScheduleProto> schedule_proto_;
   const HloModule* module_ = nullptr;
+  LatencyHidingScheduleCache* schedule_cache_ = nullptr;
+  std::string schedule_cache_context_;
+  double schedule_cycles_ = 0;
+
+ private:
+  // Returns the key of `computation` in the schedule cache. The memory pressure
+  // state of the computations it calls must be up to date.
+  LatencyHidingScheduleCache::Key ScheduleCacheKey(
+      const HloComputation* computation, const HloInstructionSequence& sequence,
+      const MemoryPressureTracker& memory_pressure_tracker) const;
 };
 
 // A scheduler oriented to hiding latencies of operations that can run in
@@ -1266,6 +1331,14 @@ class LatencyHidingScheduler : public HloModulePass {
       const AsyncTracker* async_tracker,
       const HloCostAnalysis::ShapeSizeFunction& shape_size_bytes);
 
+  // A module schedule found while fitting the memory limit.
+  struct ScheduleCandidate {
+    // The memory limit the scheduler core worked with.
+    uint64_t scheduler_memory_limit = 0;
+    int64_t memory_peak = 0;
+    double total_cycles = 0;
+  };
+
   using HloPassInterface::Run;
   absl::StatusOr<bool> Run(
       HloModule* module,
@@ -1273,12 +1346,28 @@ class LatencyHidingScheduler : public HloModulePass {
 
   virtual void LogScheduleStatistics(const HloComputation* computation);
 
+  // Returns the candidates of the last Run that no other candidate beats in
+  // both memory peak and cycles, by increasing memory peak. Only populated when
+  // the scheduler core searches the memory limit.
+  absl::Span<const ScheduleCandidate> pareto_frontier() const {
+    return pareto_frontier_;
+  }
+
  private:
+  // Reschedules `computations` under successively bisected memory limits until
+  // the rerun budget is spent, and stores the fitting schedule with the fewest
+  // cycles in `schedules`, or the one with the lowest peak if none fits.
+  absl::Status SearchMemoryLimit(
+      HloModule* module, absl::Span<HloComputation* const> computations,
+      absl::flat_hash_map<HloComputation*, std::vector<HloInstruction*>>&
+          schedules);
+
   std::unique_ptr<LatencyEstimator> latency_estimator_;
   std::unique_ptr<AsyncTracker> async_tracker_;
   std::unique_ptr<SchedulerCore> scheduler_core_;
   const HloCostAnalysis::ShapeSizeFunction shape_size_bytes_;
   absl::flat_hash_set<HloComputation*> computations_to_schedule_;
+  std::vector<ScheduleCandidate> pareto_frontier_;
 };
 
 }  // namespace xla
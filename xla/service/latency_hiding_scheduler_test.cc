@@ -33,6 +33,7 @@ limitations under the License.
 #include "absl/log/log.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
+#include "absl/strings/substitute.h"
 #include "absl/types/span.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_opcode.h"
@@ -146,7 +147,10 @@ absl::StatusOr<bool> RunScheduler(
     HloModule* module, SchedulerConfig sched_config = GetDefaultSchedConfig(),
     std::unique_ptr<LatencyEstimator> latency_estimator =
         std::make_unique<ApproximateLatencyEstimator>(),
-    std::unique_ptr<AsyncTracker> async_tracker = nullptr) {
+    std::unique_ptr<AsyncTracker> async_tracker = nullptr,
+    LatencyHidingScheduleCache* schedule_cache = nullptr,
+    std::vector<LatencyHidingScheduler::ScheduleCandidate>* pareto_frontier =
+        nullptr) {
   AsyncCollectiveCreator::CollectiveCreatorConfig config{
       /*convert_all_reduce=*/HloPredicateTrue,
       /*convert_all_gather=*/HloPredicateTrue,
@@ -177,11 +181,17 @@ absl::StatusOr<bool> RunScheduler(
   auto scheduler_core = std::make_unique<DefaultSchedulerCore>(
       shape_size_bytes, async_tracker.get(), latency_estimator.get(),
       sched_config);
-  TF_ASSIGN_OR_RETURN(
-      value, LatencyHidingScheduler(std::move(latency_estimator),
-                                    std::move(async_tracker),
-                                    std::move(scheduler_core), shape_size_bytes)
-                 .Run(module));
+  if (schedule_cache != nullptr) {
+    scheduler_core->SetScheduleCache(schedule_cache, /*context=*/"");
+  }
+  LatencyHidingScheduler scheduler(std::move(latency_estimator),
+                                   std::move(async_tracker),
+                                   std::move(scheduler_core), shape_size_bytes);
+  TF_ASSIGN_OR_RETURN(value, scheduler.Run(module));
+  if (pareto_frontier != nullptr) {
+    pareto_frontier->assign(scheduler.pareto_frontier().begin(),
+                            scheduler.pareto_frontier().end());
+  }
 
   return value;
 }
@@ -3028,6 +3038,51 @@ TEST_F(LatencyHidingSchedulerTest, RerunWithSmallerMemoryLimit) {
             PositionInVector(new_instruction_sequence, cps));
 }
 
+TEST_F(LatencyHidingSchedulerTest, SearchMemoryLimitReportsParetoFrontier) {
+  absl::string_view hlo_string = R"(
+    HloModule rerun_scheduler_test, is_scheduled=true
+    ENTRY main {
+     p0 = bf16[8]{0} parameter(0)
+     c = bf16[] constant(0)
+     b = bf16[43]{0} broadcast(c), dimensions={}
+     s = bf16[1]{0} slice(b), slice={[0:1]}
+     cp = bf16[8]{0} collective-permute(p0), source_target_pairs={{0,1},{1,2},{2,3}}
+    ROOT tuple = (bf16[8]{0}, bf16[1]{0}) tuple(cp, s)
+  }
+)";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto hlo_module, ParseHloText(hlo_string));
+  auto sched_config = GetDefaultSchedConfig();
+  sched_config.memory_limit = 110;
+  sched_config.rerun = 4;
+  sched_config.search_memory_limit = true;
+  std::vector<LatencyHidingScheduler::ScheduleCandidate> pareto_frontier;
+  TF_EXPECT_OK(RunScheduler(hlo_module.get(), sched_config,
+                            std::make_unique<ApproximateLatencyEstimator>(),
+                            /*async_tracker=*/nullptr,
+                            /*schedule_cache=*/nullptr, &pareto_frontier));
+  // As in RerunWithSmallerMemoryLimit, the first schedule peaks at 136 bytes
+  // and the search settles on one that does not overlap the slice.
+  std::vector<HloInstruction*> new_instruction_sequence =
+      hlo_module->schedule()
+          .sequence(hlo_module->entry_computation())
+          .instructions();
+  const HloInstruction* s = FindInstruction(hlo_module.get(), "s");
+  const HloInstruction* cps =
+      FindInstruction(hlo_module.get(), "collective-permute-start");
+  EXPECT_LT(PositionInVector(new_instruction_sequence, s),
+            PositionInVector(new_instruction_sequence, cps));
+
+  ASSERT_FALSE(pareto_frontier.empty());
+  EXPECT_LE(pareto_frontier.front().memory_peak, 110);
+  for (int64_t i = 1; i < pareto_frontier.size(); ++i) {
+    EXPECT_GT(pareto_frontier[i].memory_peak,
+              pareto_frontier[i - 1].memory_peak);
+    EXPECT_LT(pareto_frontier[i].total_cycles,
+              pareto_frontier[i - 1].total_cycles);
+  }
+}
+
 TEST_F(LatencyHidingSchedulerTest, MultipleAsyncDoneOperationsDoNotCreateLoop) {
   absl::string_view hlo_string = R"(
 HloModule multiple_async_done_scheduler_test, is_scheduled=true
@@ -4279,4 +4334,65 @@ TEST_F(LatencyHidingSchedulerTest, WhileWithCompleteResourceList) {
             GetIndex(new_instruction_sequence, "while"));
 }
 
+TEST_F(LatencyHidingSchedulerTest, ReusesCachedSchedule) {
+  constexpr absl::string_view kHloTemplate = R"(
+HloModule module, is_scheduled=true
+
+ENTRY %module {
+  %replica_id = u32[] replica-id()
+  %convert = f32[] convert(u32[] %replica_id)
+  %color_operand.1 = f32[8,256,256] broadcast(f32[] %convert), dimensions={}
+  %ag-start = (f32[8,256,256], f32[16,256,256]) all-gather-start(
+    f32[8,256,256] %color_operand.1), replica_groups={{0,1}}, dimensions={0}
+  %ag-done = f32[16,256,256] all-gather-done(
+    (f32[8,256,256], f32[16,256,256]) %ag-start)
+  p0 = f32[16,64,256]{2,1,0} parameter(0)
+  p1 = f32[16,64,256]{2,1,0} parameter(1)
+  c0 = f32[16,256,256]{2,1,0} convolution(p0, p1),
+    window={size=16 stride=15 lhs_dilate=16}, dim_labels=0fb_0io->0fb
+  ROOT a2 = f32[16,256,256]{2,1,0} $0(%ag-done, c0)
+}
+)";
+  auto schedule_names = [](const HloModule& module) {
+    std::vector<std::string> names;
+    for (const HloInstruction* instr :
+         module.schedule().sequence(module.entry_computation())
+             .instructions()) {
+      names.push_back(instr->name());
+    }
+    return names;
+  };
+  LatencyHidingScheduleCache schedule_cache;
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto first_module,
+      ParseHloText(absl::Substitute(kHloTemplate, "add")));
+  TF_ASSERT_OK(RunScheduler(first_module.get(), GetDefaultSchedConfig(),
+                            std::make_unique<ApproximateLatencyEstimator>(),
+                            /*async_tracker=*/nullptr, &schedule_cache)
+                   .status());
+  EXPECT_EQ(schedule_cache.size(), 1);
+
+  // Scheduling the same computation again reuses the cached schedule.
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto second_module,
+      ParseHloText(absl::Substitute(kHloTemplate, "add")));
+  TF_ASSERT_OK(RunScheduler(second_module.get(), GetDefaultSchedConfig(),
+                            std::make_unique<ApproximateLatencyEstimator>(),
+                            /*async_tracker=*/nullptr, &schedule_cache)
+                   .status());
+  EXPECT_EQ(schedule_cache.size(), 1);
+  EXPECT_EQ(schedule_names(*second_module), schedule_names(*first_module));
+
+  // A changed computation is scheduled from scratch.
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto edited_module,
+      ParseHloText(absl::Substitute(kHloTemplate, "multiply")));
+  TF_ASSERT_OK(RunScheduler(edited_module.get(), GetDefaultSchedConfig(),
+                            std::make_unique<ApproximateLatencyEstimator>(),
+                            /*async_tracker=*/nullptr, &schedule_cache)
+                   .status());
+  EXPECT_EQ(schedule_cache.size(), 2);
+}
+
 }  // namespace xla
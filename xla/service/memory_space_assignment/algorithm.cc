@@ -340,11 +340,34 @@ CrossProgramPrefetches FindCrossProgramPrefetches(
 
   DefaultCrossProgramPrefetchBufferIntervalComparator default_comparator(
       hlo_live_range, options.msa_sort_order_overrides);
+  std::optional<BenefitPerByteCrossProgramPrefetchBufferIntervalComparator>
+      benefit_per_byte_comparator;
   BufferIntervalComparator* comparator =
       (options.default_cross_program_prefetch_heuristic &&
                options.buffer_interval_comparator
            ? options.buffer_interval_comparator
            : &default_comparator);
+  if (options.cross_program_prefetch_benefit_per_byte_heuristic &&
+      options.cost_analysis) {
+    benefit_per_byte_comparator.emplace(*options.cost_analysis,
+                                        options.msa_sort_order_overrides);
+    comparator = &*benefit_per_byte_comparator;
+    // Buffers overridden by msa_sort_order_overrides are kept regardless of
+    // their benefit.
+    std::vector<MsaBufferInterval>& candidates =
+        cross_program_prefetches.candidates;
+    candidates.erase(
+        std::remove_if(
+            candidates.begin(), candidates.end(),
+            [&](const MsaBufferInterval& candidate) {
+              return benefit_per_byte_comparator->GetBenefitPerByte(
+                         candidate) <= 0.0 &&
+                     !MemorySpaceAssignmentUtils::
+                         DoesCrossProgramPrefetchBufferMatchAnyFilter(
+                             options.msa_sort_order_overrides, candidate);
+            }),
+        candidates.end());
+  }
   absl::c_sort(cross_program_prefetches.candidates,
                comparator->GetComparisonFunctor());
 
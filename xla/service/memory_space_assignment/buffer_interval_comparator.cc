@@ -28,6 +28,7 @@ limitations under the License.
 #include "absl/strings/str_join.h"
 #include "absl/strings/string_view.h"
 #include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_opcode.h"
 #include "xla/hlo/utils/hlo_live_range.h"
 #include "xla/service/hlo_value.h"
 #include "xla/service/memory_space_assignment/cost_analysis.h"
@@ -168,5 +169,73 @@ DefaultCrossProgramPrefetchBufferIntervalComparator::GetTuple(
                          buffer_interval.buffer->id());
 }
 
+BenefitPerByteCrossProgramPrefetchBufferIntervalComparator::
+    BenefitPerByteCrossProgramPrefetchBufferIntervalComparator(
+        const CostAnalysis& cost_analysis,
+        const MsaSortOrderOverrides& msa_sort_order_overrides)
+    : BufferIntervalComparator(),
+      cost_analysis_(cost_analysis),
+      msa_sort_order_overrides_(msa_sort_order_overrides) {}
+
+std::string BenefitPerByteCrossProgramPrefetchBufferIntervalComparator::
+    DescribeComparisonCriteria() const {
+  return "[ override priority, -benefit per byte, -size, instruction id ]";
+}
+
+std::string
+BenefitPerByteCrossProgramPrefetchBufferIntervalComparator::CriteriaToString(
+    const MsaBufferInterval& buffer_interval) {
+  return absl::StrCat("[ ", absl::StrJoin(GetTuple(buffer_interval), ", "),
+                      " ]");
+}
+
+bool BenefitPerByteCrossProgramPrefetchBufferIntervalComparator::LessThan(
+    const MsaBufferInterval& lhs, const MsaBufferInterval& rhs) {
+  return GetTuple(lhs) < GetTuple(rhs);
+}
+
+float BenefitPerByteCrossProgramPrefetchBufferIntervalComparator::
+    GetBenefitPerByte(const MsaBufferInterval& buffer_interval) {
+  auto it = benefit_per_byte_.find(buffer_interval.buffer);
+  if (it != benefit_per_byte_.end()) {
+    return it->second;
+  }
+  float benefit = 0.0;
+  auto add_use_benefits = [&](const HloValue* value) {
+    for (const HloUse& use : value->GetUses()) {
+      // We look inside the called computations of while and conditional, so
+      // don't use the benefit of while and conditional directly.
+      if (use.instruction->opcode() == HloOpcode::kWhile ||
+          use.instruction->opcode() == HloOpcode::kConditional) {
+        continue;
+      }
+      // Compute bound uses don't get faster from the prefetch.
+      benefit += std::max(
+          0.0f,
+          cost_analysis_.GetAlternateMemoryBenefit(use, &cost_analysis_cache_));
+    }
+  };
+  add_use_benefits(buffer_interval.buffer);
+  for (const HloValue* colocation : buffer_interval.colocations) {
+    add_use_benefits(colocation);
+  }
+  float benefit_per_byte =
+      buffer_interval.size > 0 ? benefit / buffer_interval.size : 0.0;
+  benefit_per_byte_[buffer_interval.buffer] = benefit_per_byte;
+  return benefit_per_byte;
+}
+
+BenefitPerByteCrossProgramPrefetchBufferIntervalComparator::ComparisonTuple
+BenefitPerByteCrossProgramPrefetchBufferIntervalComparator::GetTuple(
+    const MsaBufferInterval& buffer_interval) {
+  int64_t priority =
+      MemorySpaceAssignmentUtils::GetBufferIntervalOverridePriority(
+          msa_sort_order_overrides_, buffer_interval,
+          /*is_cross_program_prefetch=*/true);
+  return std::make_tuple(priority, -1.0f * GetBenefitPerByte(buffer_interval),
+                         -1 * buffer_interval.size,
+                         buffer_interval.buffer->id());
+}
+
 }  // namespace memory_space_assignment
 }  // namespace xla
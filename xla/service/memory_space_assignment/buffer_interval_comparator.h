@@ -144,6 +144,47 @@ class DefaultCrossProgramPrefetchBufferIntervalComparator
   const MsaSortOrderOverrides& msa_sort_order_overrides_;
 };
 
+// A BufferIntervalComparator used for cross-program prefetching that ranks
+// candidates by the alternate memory benefit of their uses, as given by
+// CostAnalysis, per byte of alternate memory they occupy. Uses in while loops
+// are weighted by the while nest multiplier, so that weights read every
+// iteration are preferred.
+//
+// This class caches HloValue -> benefit per byte.
+class BenefitPerByteCrossProgramPrefetchBufferIntervalComparator
+    : public BufferIntervalComparator {
+ public:
+  BenefitPerByteCrossProgramPrefetchBufferIntervalComparator(
+      const CostAnalysis& cost_analysis,
+      const MsaSortOrderOverrides& msa_sort_order_overrides);
+
+  ~BenefitPerByteCrossProgramPrefetchBufferIntervalComparator() override =
+      default;
+
+  std::string DescribeComparisonCriteria() const override;
+  std::string CriteriaToString(
+      const MsaBufferInterval& buffer_interval) override;
+  bool LessThan(const MsaBufferInterval& lhs,
+                const MsaBufferInterval& rhs) override;
+
+  // Returns the sum of the positive alternate memory benefits of the uses of
+  // buffer_interval and its colocations, divided by its size.
+  float GetBenefitPerByte(const MsaBufferInterval& buffer_interval);
+
+ private:
+  // See the value returned by DescribeComparisonCriteria() for the meaning of
+  // each tuple element.
+  using ComparisonTuple =
+      std::tuple<int64_t, float, int64_t, BufferValue::Id>;
+
+  ComparisonTuple GetTuple(const MsaBufferInterval& buffer_interval);
+
+  absl::flat_hash_map<const HloValue*, float> benefit_per_byte_;
+  const CostAnalysis& cost_analysis_;
+  CostAnalysis::Cache cost_analysis_cache_;
+  const MsaSortOrderOverrides& msa_sort_order_overrides_;
+};
+
 }  // namespace memory_space_assignment
 }  // namespace xla
 
@@ -34,6 +34,7 @@ limitations under the License.
 #include "absl/log/check.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/string_view.h"
@@ -42,11 +43,13 @@ limitations under the License.
 #include "xla/hlo/analysis/hlo_dataflow_analysis.h"
 #include "xla/hlo/ir/hlo_computation.h"
 #include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_module.h"
 #include "xla/hlo/ir/hlo_opcode.h"
 #include "xla/hlo/ir/hlo_schedule.h"
 #include "xla/hlo/utils/hlo_live_range.h"
 #include "xla/layout.h"
 #include "xla/service/buffer_value.h"
+#include "xla/service/computation_layout.h"
 #include "xla/service/heap_simulator/heap_simulator.h"
 #include "xla/service/hlo.pb.h"
 #include "xla/service/hlo_buffer.h"
@@ -57,6 +60,7 @@ limitations under the License.
 #include "xla/service/memory_space_assignment/options.h"
 #include "xla/service/memory_space_assignment/simulator.h"
 #include "xla/service/memory_space_assignment/slice.h"
+#include "xla/service/memory_space_assignment/tuning_utils.h"
 #include "xla/shape.h"
 #include "xla/shape_util.h"
 #include "xla/status_macros.h"
@@ -269,6 +273,54 @@ void TransformAllocationSequenceToSpill(AllocationSequence& allocations,
   SortAllocationSequence(allocations);
 }
 
+// The parts of a module that finding an allocation sequence changes: the
+// memory spaces and split configs in instruction shapes, the entry computation
+// layout, the memory space assignment config and the cross-program prefetches.
+// Used to try several configurations on the same module when tuning.
+class ModuleAllocationState {
+ public:
+  explicit ModuleAllocationState(HloModule* module)
+      : module_(module),
+        cross_program_prefetches_(module->CrossProgramPrefetches().begin(),
+                                  module->CrossProgramPrefetches().end()),
+        memory_space_assignment_config_(
+            module->config().memory_space_assignment_config()) {
+    for (HloComputation* computation : module->computations()) {
+      for (HloInstruction* instruction : computation->instructions()) {
+        shapes_.push_back({instruction, instruction->shape()});
+      }
+    }
+    if (module->config().has_entry_computation_layout()) {
+      entry_computation_layout_ = module->config().entry_computation_layout();
+    }
+  }
+
+  void Restore() const {
+    for (const auto& [instruction, shape] : shapes_) {
+      *instruction->mutable_shape() = shape;
+    }
+    if (entry_computation_layout_.has_value()) {
+      *module_->mutable_config().mutable_entry_computation_layout() =
+          *entry_computation_layout_;
+    }
+    *module_->mutable_config().mutable_memory_space_assignment_config() =
+        memory_space_assignment_config_;
+    module_->ClearCrossProgramPrefetches();
+    for (const HloModule::CrossProgramPrefetchInfo& prefetch :
+         cross_program_prefetches_) {
+      module_->AddCrossProgramPrefetch(prefetch.parameter, prefetch.index,
+                                       prefetch.alt_memory_offset);
+    }
+  }
+
+ private:
+  HloModule* module_;
+  std::vector<std::pair<HloInstruction*, Shape>> shapes_;
+  std::optional<ComputationLayout> entry_computation_layout_;
+  std::vector<HloModule::CrossProgramPrefetchInfo> cross_program_prefetches_;
+  std::vector<uint64_t> memory_space_assignment_config_;
+};
+
 }  // namespace
 
 absl::StatusOr<MemorySpaceAssignment::AsyncCopyStats>
@@ -325,6 +377,15 @@ MemorySpaceAssignment::Run(HloModule* module,
     XLA_LOG_LINES(INFO, module->ToString());
     LOG(INFO) << "Schedule: " << module->schedule().ToString();
   }
+  if (!options.tuning_configs.empty() && options.cost_analysis != nullptr) {
+    TF_ASSIGN_OR_RETURN(
+        Options tuned_options,
+        TuneOptions(module, hlo_live_range, alias_analysis, options));
+    MemorySpaceAssignment memory_space_assignment(module, tuned_options,
+                                                  hlo_live_range);
+    return memory_space_assignment.RunMemorySpaceAssignment(hlo_live_range,
+                                                            alias_analysis);
+  }
   MemorySpaceAssignment memory_space_assignment(module, options,
                                                 hlo_live_range);
 
@@ -332,6 +393,46 @@ MemorySpaceAssignment::Run(HloModule* module,
                                                           alias_analysis);
 }
 
+absl::StatusOr<Options> MemorySpaceAssignment::TuneOptions(
+    HloModule* module, const HloLiveRange& hlo_live_range,
+    const HloAliasAnalysis& alias_analysis, const Options& options) {
+  std::vector<std::string> names = {"default"};
+  std::vector<Options> candidates = {options};
+  candidates.front().tuning_configs.clear();
+  for (const TuningConfig& config : options.tuning_configs) {
+    names.push_back(config.name);
+    candidates.push_back(candidates.front());
+    config.update_options_fn(candidates.back());
+  }
+
+  ModuleAllocationState initial_state(module);
+  std::vector<TuningResult> results;
+  int best_index = 0;
+  for (int i = 0; i < candidates.size(); ++i) {
+    MemorySpaceAssignment memory_space_assignment(module, candidates[i],
+                                                  hlo_live_range);
+    TF_RETURN_IF_ERROR(memory_space_assignment.FindAllocationSequence(
+        hlo_live_range, alias_analysis));
+    RuntimeSimulator runtime_simulator(candidates[i].cost_analysis,
+                                       candidates[i].alternate_memory_space);
+    float estimated_time =
+        runtime_simulator.SimulateElapsedTimeWithoutAsyncCopyLikes(
+            hlo_live_range, memory_space_assignment.allocations_);
+    initial_state.Restore();
+    VLOG(1) << "Tuning config " << names[i]
+            << ": estimated elapsed time (sec): " << estimated_time;
+    results.push_back({names[i], estimated_time});
+    if (estimated_time < results[best_index].estimated_elapsed_time) {
+      best_index = i;
+    }
+  }
+  VLOG(1) << "Using tuning config " << names[best_index];
+  if (options.dump_fn != nullptr) {
+    options.dump_fn("tuning", TuningResultsToCsv(results, best_index));
+  }
+  return candidates[best_index];
+}
+
 absl::Status MemorySpaceAssignment::VerifyAllocations() const {
   BufferIntervalTree interval_tree;
   // Checks the chunks that overlap with a given allocation in time do not
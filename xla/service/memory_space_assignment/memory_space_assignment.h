@@ -330,6 +330,13 @@ class MemorySpaceAssignment {
   RunMemorySpaceAssignment(const HloLiveRange& hlo_live_range,
                            const HloAliasAnalysis& alias_analysis);
 
+  // Finds an allocation sequence with options and with each of its tuning
+  // configs applied, and returns the options with the smallest estimated
+  // elapsed time. The module is left as it was.
+  static absl::StatusOr<Options> TuneOptions(
+      HloModule* module, const HloLiveRange& hlo_live_range,
+      const HloAliasAnalysis& alias_analysis, const Options& options);
+
   // Finds an AllocationSequence for placing buffers in alternate memory using
   // the MsaAlgorithm algorithm. Must be set before Process() is called.
   virtual absl::Status FindAllocationSequence(
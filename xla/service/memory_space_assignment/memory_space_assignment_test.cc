@@ -5290,6 +5290,49 @@ TEST_F(MemorySpaceAssignmentTest, CostAnalysis) {
   EXPECT_THAT(negate6, op::ShapeWithLayout(shape_in_alternate_mem));
 }
 
+TEST_F(MemorySpaceAssignmentTest, TuningKeepsFastestConfig) {
+  absl::string_view hlo_string = R"(
+HloModule module, is_scheduled=true
+
+ENTRY entry {
+  p0 = f32[2,3] parameter(0)
+  p1 = f32[2,3] parameter(1)
+  negate0 = f32[2,3] negate(p0)
+  negate1 = f32[2,3] negate(negate0)
+  negate2 = f32[2,3] negate(negate1)
+  negate3 = f32[2,3] negate(negate2)
+  ROOT add = f32[2,3] add(negate3, p1)
+}
+  )";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+  Options options = DefaultMemorySpaceOptions();
+  options.verify = true;
+  options.is_allowed_in_alternate_mem_fn = [](const HloValue&) {
+    return false;
+  };
+  options.tuning_configs.push_back(
+      {"allow_alternate_mem", [](Options& options) {
+         options.is_allowed_in_alternate_mem_fn = [](const HloValue& value) {
+           return value.instruction()->opcode() != HloOpcode::kParameter;
+         };
+       }});
+  std::string tuning_csv;
+  options.dump_fn = [&](absl::string_view name, absl::string_view contents) {
+    if (name == "tuning") {
+      tuning_csv = std::string(contents);
+    }
+  };
+  AssignMemorySpaceUsingCostAnalysis(module.get(), options);
+
+  EXPECT_THAT(tuning_csv, ::testing::HasSubstr("default,"));
+  EXPECT_THAT(tuning_csv, ::testing::HasSubstr("allow_alternate_mem,"));
+  EXPECT_THAT(tuning_csv, ::testing::EndsWith(",1\n"));
+  const HloInstruction* negate1 = FindInstruction(module.get(), "negate1");
+  EXPECT_EQ(negate1->shape().layout().memory_space(), kAlternateMemorySpace);
+}
+
 TEST_F(MemorySpaceAssignmentTest, MemoryBoundednessBufferIntervalCompare) {
   // This test is carefully crafted to force only negates to be allocated to the
   // alternate memory. The graph consists of interleaving negate and tanh
@@ -11567,6 +11610,42 @@ ENTRY entry {
   EXPECT_EQ(cross_program_prefetches.size(), 1);
 }
 
+TEST_F(MemorySpaceAssignmentTest, CrossProgramPrefetchBenefitPerByte) {
+  // p0 is the largest candidate, but p1 has twice as many memory bound uses
+  // per byte.
+  absl::string_view hlo_string = R"(
+HloModule module, is_scheduled=true
+
+ENTRY entry {
+  p0 = f32[16] parameter(0)
+  p1 = f32[4] parameter(1)
+  a = f32[16] negate(p0)
+  b = f32[4] negate(p1)
+  c = f32[4] abs(p1)
+  d = f32[4] add(b, c)
+  ROOT t = (f32[16], f32[4]) tuple(a, d)
+}
+  )";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+  Options options = DefaultMemorySpaceOptions();
+  options.cross_program_prefetch_permissive_mode = true;
+  options.cross_program_prefetch_benefit_per_byte_heuristic = true;
+  AssignMemorySpaceUsingCostAnalysis(module.get(), options);
+  auto cross_program_prefetches = module->CrossProgramPrefetches();
+  ASSERT_EQ(cross_program_prefetches.size(), 1);
+  EXPECT_EQ(cross_program_prefetches[0].parameter, 1);
+
+  TF_ASSERT_OK_AND_ASSIGN(module, ParseAndReturnVerifiedModule(hlo_string));
+  options.max_cross_program_prefetches = -1;
+  AssignMemorySpaceUsingCostAnalysis(module.get(), options);
+  cross_program_prefetches = module->CrossProgramPrefetches();
+  ASSERT_EQ(cross_program_prefetches.size(), 2);
+  EXPECT_EQ(cross_program_prefetches[0].parameter, 1);
+  EXPECT_EQ(cross_program_prefetches[1].parameter, 0);
+}
+
 // Test description:
 // - Setup: Make sure p1 can not be prefetched to alternate memory until after
 //   instruction c. We do this by causing p0 to be prefetched to alternate
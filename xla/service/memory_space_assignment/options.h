@@ -104,6 +104,16 @@ enum class WindowPrefetchMode {
   kWindowPrefetch,
 };
 
+struct Options;
+
+// An alternative configuration MemorySpaceAssignment can try when tuning, e.g.
+// a different prefetch interval picker or buffer interval comparator. See
+// Options::tuning_configs.
+struct TuningConfig {
+  std::string name;
+  std::function<void(Options&)> update_options_fn;
+};
+
 // The different options to be passed to the Run() API.
 struct Options {
   // The backend-specific integer value that describes the default memory.
@@ -288,10 +298,27 @@ struct Options {
   // cross-program-prefetched buffer can be reused.
   bool enable_cross_program_prefetch_freeing = true;
 
-  // The maximum number of cross program prefetches.
+  // The maximum number of cross program prefetches. Negative means no limit.
   // TODO(tjablin): Use a heuristic to determine this automatically.
   int max_cross_program_prefetches = 1;
 
+  // If true and cost_analysis is set, rank cross-program prefetch candidates
+  // by the alternate memory benefit of their uses per byte, and drop the
+  // candidates that no use benefits from. Combined with a negative
+  // max_cross_program_prefetches, this keeps as many beneficial buffers (e.g.
+  // the weights of an inference program) resident in alternate memory across
+  // program executions as fit, while cross-program prefetch freeing lets the
+  // space be reused between their last use and the end of the program.
+  bool cross_program_prefetch_benefit_per_byte_heuristic = false;
+
+  // If non-empty and cost_analysis is set, MemorySpaceAssignment::Run finds an
+  // allocation sequence with these options and with each of the tuning configs
+  // applied to them, estimates their elapsed times with RuntimeSimulator and
+  // keeps the fastest configuration. The estimates are passed to dump_fn as
+  // "tuning". The configs are tried one after another because finding an
+  // allocation sequence changes the module, which is restored in between.
+  std::vector<TuningConfig> tuning_configs;
+
   // If false, we assume tensors that we couldn't explicitly determine to be
   // activations are activations. If true, we assume these aren't activations,
   // so they may be cross-program-prefetch candidates.
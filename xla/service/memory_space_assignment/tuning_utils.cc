@@ -17,10 +17,13 @@ limitations under the License.
 
 #include <cstdint>
 #include <optional>
+#include <string>
 #include <vector>
 
 #include "absl/algorithm/container.h"
 #include "absl/log/check.h"
+#include "absl/strings/str_cat.h"
+#include "absl/types/span.h"
 #include "xla/hlo/ir/hlo_module.h"
 
 namespace xla {
@@ -60,5 +63,16 @@ void CustomizeSortedBufferInterval(
   }
 }
 
+std::string TuningResultsToCsv(absl::Span<const TuningResult> results,
+                               int best_index) {
+  std::string csv = "config_name,estimated_elapsed_time,best\n";
+  for (int i = 0; i < results.size(); ++i) {
+    absl::StrAppend(&csv, results[i].config_name, ",",
+                    results[i].estimated_elapsed_time, ",",
+                    i == best_index ? 1 : 0, "\n");
+  }
+  return csv;
+}
+
 }  // namespace memory_space_assignment
 }  // namespace xla
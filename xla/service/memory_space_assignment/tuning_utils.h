@@ -18,8 +18,10 @@ limitations under the License.
 
 #include <cstdint>
 #include <optional>
+#include <string>
 #include <vector>
 
+#include "absl/types/span.h"
 #include "xla/hlo/ir/hlo_module.h"
 #include "xla/service/heap_simulator/heap_simulator.h"
 #include "xla/service/hlo_value.h"
@@ -37,6 +39,17 @@ void CustomizeSortedBufferInterval(
     std::optional<std::vector<uint64_t>> memory_space_assignment_config,
     std::vector<BufferInterval>& sorted_buffer_intervals);
 
+// The estimated elapsed time of the allocation sequence found with one tuning
+// config.
+struct TuningResult {
+  std::string config_name;
+  float estimated_elapsed_time;
+};
+
+// Returns the tuning results as CSV, marking the result at best_index.
+std::string TuningResultsToCsv(absl::Span<const TuningResult> results,
+                               int best_index);
+
 }  // namespace memory_space_assignment
 }  // namespace xla
 
@@ -240,7 +240,7 @@ absl::StatusOr<bool> ReduceScatterCombiner::RunWithKeyCombiner(
         bool computation_changed,
         CombineInstructionsByKey<ReduceScatterCombiner::GroupKey>(
             computation, key_fn, &CombineReduceScatters,
-            combine_threshold_in_bytes_, combine_threshold_count_));
+            CombineThresholdInBytes(*computation), combine_threshold_count_));
     changed |= computation_changed;
   }
 
@@ -16,9 +16,11 @@ limitations under the License.
 #include "xla/service/service.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <numeric>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -27,6 +29,7 @@ limitations under the License.
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
+#include "absl/strings/string_view.h"
 #include "absl/types/span.h"
 #include "xla/executable_run_options.h"
 #include "xla/hlo/builder/xla_computation.h"
@@ -60,11 +63,15 @@ limitations under the License.
 #include "xla/stream_executor/device_memory_allocator.h"
 #include "xla/stream_executor/platform.h"
 #include "xla/stream_executor/stream_executor.h"
+#include "xla/tsl/lib/strings/proto_serialization.h"
 #include "xla/util.h"
 #include "xla/xla.pb.h"
 #include "xla/xla_data.pb.h"
+#include "tsl/platform/env.h"
 #include "tsl/platform/errors.h"
+#include "tsl/platform/fingerprint.h"
 #include "tsl/platform/logging.h"
+#include "tsl/platform/path.h"
 #include "tsl/platform/protobuf.h"
 #include "tsl/platform/status.h"
 #include "tsl/platform/statusor.h"
@@ -102,6 +109,23 @@ absl::Status RecordResult(const ShapedBuffer& result, se::Stream* stream,
   return absl::OkStatus();
 }
 
+// Returns a fingerprint of everything that determines the executable built
+// from `module_proto` with `config` for `platform_name`.
+std::string CompilationFingerprint(const HloModuleProto& module_proto,
+                                   const HloModuleConfig& config,
+                                   absl::string_view platform_name) {
+  std::string serialized;
+  CHECK(tsl::SerializeToStringDeterministic(module_proto, &serialized));
+  absl::StrAppend(&serialized, config.compilation_cache_key(), platform_name);
+  tsl::Fprint128 fingerprint = tsl::Fingerprint128(serialized);
+  return absl::StrFormat("%016x%016x", fingerprint.high64, fingerprint.low64);
+}
+
+std::string CompilationCachePath(absl::string_view dir,
+                                 absl::string_view fingerprint) {
+  return tsl::io::JoinPath(dir, absl::StrCat(fingerprint, ".xla_executable"));
+}
+
 }  // namespace
 
 ServiceOptions& ServiceOptions::set_platform(se::Platform* platform) {
@@ -138,9 +162,30 @@ const std::optional<std::set<int>>& ServiceOptions::allowed_devices() const {
   return allowed_devices_;
 }
 
+ServiceOptions& ServiceOptions::set_compilation_cache_capacity_bytes(
+    int64_t capacity_bytes) {
+  compilation_cache_capacity_bytes_ = capacity_bytes;
+  return *this;
+}
+
+int64_t ServiceOptions::compilation_cache_capacity_bytes() const {
+  return compilation_cache_capacity_bytes_;
+}
+
+ServiceOptions& ServiceOptions::set_compilation_cache_dir(
+    std::string compilation_cache_dir) {
+  compilation_cache_dir_ = std::move(compilation_cache_dir);
+  return *this;
+}
+
+const std::string& ServiceOptions::compilation_cache_dir() const {
+  return compilation_cache_dir_;
+}
+
 Service::Service(const ServiceOptions& options,
                  std::unique_ptr<Backend> execute_backend)
     : options_(options),
+      compilation_cache_(options.compilation_cache_capacity_bytes()),
       allocation_tracker_(execute_backend.get()),
       execute_backend_(std::move(execute_backend)) {
   CHECK_GT(options_.number_of_replicas(), 0);
@@ -829,15 +874,85 @@ absl::StatusOr<ExecutionHandle> Service::Compile(
   VLOG(3) << "Compile created HloModuleConfig computation layout: "
           << module_config->entry_computation_layout().ToString();
 
-  TF_ASSIGN_OR_RETURN(
-      std::unique_ptr<Executable> executable,
-      BuildExecutable(computation.proto(), std::move(module_config),
-                      execute_backend_.get(),
-                      execute_backend_->default_stream_executor(),
-                      {/*device_allocator=*/nullptr}));
+  const std::string fingerprint = CompilationFingerprint(
+      computation.proto(), *module_config,
+      execute_backend_->platform()->Name());
+  if (std::optional<ExecutionHandle> handle =
+          compilation_cache_.LookUpByFingerprint(fingerprint)) {
+    VLOG(1) << "'compile' request hit the compilation cache";
+    return *handle;
+  }
+
+  se::StreamExecutor* executor = execute_backend_->default_stream_executor();
+  std::unique_ptr<Executable> executable;
+  if (!options_.compilation_cache_dir().empty()) {
+    executable = LoadExecutableFromCacheDir(fingerprint, executor);
+  }
+  if (executable == nullptr) {
+    TF_ASSIGN_OR_RETURN(
+        executable,
+        BuildExecutable(computation.proto(), std::move(module_config),
+                        execute_backend_.get(), executor,
+                        {/*device_allocator=*/nullptr}));
+    if (!options_.compilation_cache_dir().empty()) {
+      SaveExecutableToCacheDir(executable.get(), fingerprint);
+    }
+  }
 
   VLOG(1) << "successfully completed 'compile' request";
-  return compilation_cache_.Insert(std::move(executable));
+  return compilation_cache_.Insert(std::move(executable), fingerprint);
+}
+
+std::unique_ptr<Executable> Service::LoadExecutableFromCacheDir(
+    absl::string_view fingerprint, se::StreamExecutor* executor) {
+  std::string path = CompilationCachePath(options_.compilation_cache_dir(),
+                                          fingerprint);
+  if (!tsl::Env::Default()->FileExists(path).ok()) {
+    return nullptr;
+  }
+  Compiler* compiler = execute_backend_->compiler();
+  auto load = [&]() -> absl::StatusOr<std::unique_ptr<Executable>> {
+    std::string serialized;
+    TF_RETURN_IF_ERROR(
+        tsl::ReadFileToString(tsl::Env::Default(), path, &serialized));
+    TF_ASSIGN_OR_RETURN(std::unique_ptr<AotCompilationResult> aot_result,
+                        compiler->LoadAotCompilationResult(serialized));
+    return std::move(*aot_result).LoadExecutable(compiler, executor);
+  };
+  absl::StatusOr<std::unique_ptr<Executable>> executable = load();
+  if (!executable.ok()) {
+    LOG(WARNING) << "Failed to load executable from the compilation cache at "
+                 << path << ": " << executable.status();
+    return nullptr;
+  }
+  VLOG(1) << "Loaded executable from the compilation cache at " << path;
+  return *std::move(executable);
+}
+
+void Service::SaveExecutableToCacheDir(Executable* executable,
+                                       absl::string_view fingerprint) {
+  const std::string& dir = options_.compilation_cache_dir();
+  auto save = [&]() -> absl::Status {
+    TF_ASSIGN_OR_RETURN(std::unique_ptr<AotCompilationResult> aot_result,
+                        execute_backend_->compiler()->Export(executable));
+    TF_ASSIGN_OR_RETURN(std::string serialized,
+                        aot_result->SerializeAsString());
+    TF_RETURN_IF_ERROR(tsl::Env::Default()->RecursivelyCreateDir(dir));
+    // Writes to a temporary file first, so that concurrent services never
+    // load a partially written executable.
+    std::string path = CompilationCachePath(dir, fingerprint);
+    std::string tmp_path =
+        absl::StrCat(path, ".tmp.", tsl::Env::Default()->NowMicros(), ".",
+                     reinterpret_cast<uintptr_t>(this));
+    TF_RETURN_IF_ERROR(
+        tsl::WriteStringToFile(tsl::Env::Default(), tmp_path, serialized));
+    return tsl::Env::Default()->RenameFile(tmp_path, path);
+  };
+  absl::Status status = save();
+  if (!status.ok()) {
+    VLOG(1) << "Not saving the executable to the compilation cache in " << dir
+            << ": " << status;
+  }
 }
 
 absl::StatusOr<std::unique_ptr<GlobalData>> Service::Execute(
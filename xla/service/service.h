@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef XLA_SERVICE_SERVICE_H_
 #define XLA_SERVICE_SERVICE_H_
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <set>
@@ -23,6 +24,7 @@ limitations under the License.
 #include <vector>
 
 #include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
 #include "absl/types/span.h"
 #include "xla/debug_options_flags.h"
 #include "xla/executable_run_options.h"
@@ -74,11 +76,24 @@ class ServiceOptions {
       const std::optional<std::set<int>>& allowed_devices);
   const std::optional<std::set<int>>& allowed_devices() const;
 
+  // Bounds the total generated code size of the executables kept by Compile.
+  // 0 means unbounded.
+  ServiceOptions& set_compilation_cache_capacity_bytes(int64_t capacity_bytes);
+  int64_t compilation_cache_capacity_bytes() const;
+
+  // If not empty, Compile saves the executables it builds to this directory,
+  // and loads them from it instead of compiling them again, if the backend
+  // supports exporting executables.
+  ServiceOptions& set_compilation_cache_dir(std::string compilation_cache_dir);
+  const std::string& compilation_cache_dir() const;
+
  private:
   se::Platform* platform_ = nullptr;
   int number_of_replicas_ = 1;
   int intra_op_parallelism_threads_ = -1;
   std::optional<std::set<int>> allowed_devices_;
+  int64_t compilation_cache_capacity_bytes_ = 0;
+  std::string compilation_cache_dir_;
 };
 
 // A GlobalData object represents a globally-accessible allocation of
@@ -293,6 +308,19 @@ class Service {
       se::StreamExecutor* executor, const Compiler::CompileOptions& options,
       bool run_backend_only = false);
 
+ private:
+  // Loads the executable with `fingerprint` from the compilation cache
+  // directory. Returns null if it isn't there or can't be loaded.
+  std::unique_ptr<Executable> LoadExecutableFromCacheDir(
+      absl::string_view fingerprint, se::StreamExecutor* executor);
+
+  // Saves `executable` to the compilation cache directory, if the backend
+  // supports exporting it.
+  void SaveExecutableToCacheDir(Executable* executable,
+                                absl::string_view fingerprint);
+
+ public:
+
   // Same as BuildExecutable() above, but builds a list of Executables for the
   // given computations that may interact with each other.
   absl::StatusOr<std::vector<std::unique_ptr<Executable>>> BuildExecutables(
@@ -345,7 +373,8 @@ class Service {
 
   ServiceOptions options_;
 
-  // Cache containing previously built Executables.
+  // Cache containing previously built Executables, also keyed by a fingerprint
+  // of the computation and module config they were built from.
   CompilationCache compilation_cache_;
 
   // Tracks channels created via the API.
@@ -2848,6 +2848,55 @@ absl::StatusOr<bool> ShardingPropagation::RunToFixPoint(
   absl::flat_hash_set<const HloInstruction*> already_inferred_from_users;
   bool changed_last_iter = true;
   const bool may_merge_partial = is_spmd_ && aggressiveness > 0;
+  // Propagation doesn't add or remove instructions, so the post orders are
+  // computed once. The shardings of a computation can only change if the cache
+  // entry of one of its instructions was cleared since it was last visited, so
+  // the other computations are skipped.
+  std::vector<std::pair<const HloComputation*, std::vector<HloInstruction*>>>
+      post_orders;
+  absl::flat_hash_set<const HloComputation*> computations_to_visit;
+  for (const HloComputation* computation :
+       module->computations(execution_threads)) {
+    post_orders.emplace_back(computation,
+                             computation->MakeInstructionPostOrder());
+    computations_to_visit.insert(computation);
+  }
+  auto clear_cache = [&](HloInstruction* hlo,
+                         HloInstruction* hlo_for_users = nullptr) {
+    for (auto operand : hlo->operands()) {
+      already_inferred_from_users.erase(operand);
+      computations_to_visit.insert(operand->parent());
+    }
+    if (hlo_for_users == nullptr) {
+      hlo_for_users = hlo;
+    }
+    for (auto user : hlo_for_users->users()) {
+      already_inferred_from_operands.erase(user);
+      computations_to_visit.insert(user->parent());
+      // If the user has called computations, then the parameter
+      // instructions of these called computations are also removed from
+      // already_inferred_from_operands.
+      for (auto c : user->called_computations()) {
+        for (auto parameter : c->parameter_instructions()) {
+          already_inferred_from_operands.erase(parameter);
+        }
+        computations_to_visit.insert(c);
+      }
+    }
+    if (instruction_to_shard_group_id.contains(hlo)) {
+      const int64_t shard_group_id = instruction_to_shard_group_id.at(hlo);
+      const std::vector<HloInstruction*>& shard_group =
+          shard_group_id_to_shard_as_group.contains(shard_group_id)
+              ? shard_group_id_to_shard_as_group.at(shard_group_id)
+              : shard_group_id_to_shard_like_group.at(shard_group_id);
+      for (HloInstruction* member : shard_group) {
+        if (member != hlo) {
+          already_inferred_from_shard_group.erase(member);
+          computations_to_visit.insert(member->parent());
+        }
+      }
+    }
+  };
   while (changed_last_iter) {
     changed_last_iter = false;
     int64_t inferred_from_shard_group_counter = 0;
@@ -2855,48 +2904,16 @@ absl::StatusOr<bool> ShardingPropagation::RunToFixPoint(
     int64_t inferred_from_user_counter = 0;
     int64_t instruction_counter = 0;
     int64_t already_sharded_counter = 0;
-    for (const HloComputation* computation :
-         module->computations(execution_threads)) {
+    for (const auto& [computation, instructions] : post_orders) {
+      if (!computations_to_visit.erase(computation)) {
+        continue;
+      }
       VLOG(2) << "Consider computation: " << computation->name();
-      std::vector<HloInstruction*> instructions =
-          computation->MakeInstructionPostOrder();
 
       instruction_counter += instructions.size();
       already_sharded_counter += absl::c_count_if(
           instructions,
           [](const HloInstruction* inst) { return inst->has_sharding(); });
-      auto clear_cache = [&](HloInstruction* hlo,
-                             HloInstruction* hlo_for_users = nullptr) {
-        for (auto operand : hlo->operands()) {
-          already_inferred_from_users.erase(operand);
-        }
-        if (hlo_for_users == nullptr) {
-          hlo_for_users = hlo;
-        }
-        for (auto user : hlo_for_users->users()) {
-          already_inferred_from_operands.erase(user);
-          // If the user has called computations, then the parameter
-          // instructions of these called computations are also removed from
-          // already_inferred_from_operands.
-          for (auto c : user->called_computations()) {
-            for (auto parameter : c->parameter_instructions()) {
-              already_inferred_from_operands.erase(parameter);
-            }
-          }
-        }
-        if (instruction_to_shard_group_id.contains(hlo)) {
-          const int64_t shard_group_id = instruction_to_shard_group_id.at(hlo);
-          const std::vector<HloInstruction*>& shard_group =
-              shard_group_id_to_shard_as_group.contains(shard_group_id)
-                  ? shard_group_id_to_shard_as_group.at(shard_group_id)
-                  : shard_group_id_to_shard_like_group.at(shard_group_id);
-          for (HloInstruction* member : shard_group) {
-            if (member != hlo) {
-              already_inferred_from_shard_group.erase(member);
-            }
-          }
-        }
-      };
       // 1. Iterate the shard groups to take shardings from instructions of
       // the same group.
       if (propagate_shard_group) {
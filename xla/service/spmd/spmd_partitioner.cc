@@ -33,6 +33,7 @@ limitations under the License.
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/container/inlined_vector.h"
+#include "absl/functional/function_ref.h"
 #include "absl/log/check.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
@@ -240,6 +241,39 @@ HloSharding GetShardingReplicatedOnWindowedDimension(
       sharding, dimensions_to_replicate);
 }
 
+// Returns the number of bytes that each partition receives through the
+// collectives that compute `resharded` from `original`.
+int64_t ReshardCollectiveBytes(const HloInstruction* original,
+                               const HloInstruction* resharded) {
+  int64_t bytes = 0;
+  absl::flat_hash_set<const HloInstruction*> visited = {original};
+  std::vector<const HloInstruction*> worklist = {resharded};
+  while (!worklist.empty()) {
+    const HloInstruction* hlo = worklist.back();
+    worklist.pop_back();
+    if (!visited.insert(hlo).second) {
+      continue;
+    }
+    switch (hlo->opcode()) {
+      case HloOpcode::kAllGather:
+      case HloOpcode::kAllReduce:
+      case HloOpcode::kAllToAll:
+      case HloOpcode::kCollectivePermute:
+        ShapeUtil::ForEachLeafShape(
+            hlo->shape(), [&](const Shape& subshape, const ShapeIndex&) {
+              bytes += ShapeUtil::ByteSizeOfElements(subshape);
+            });
+        break;
+      default:
+        break;
+    }
+    for (const HloInstruction* operand : hlo->operands()) {
+      worklist.push_back(operand);
+    }
+  }
+  return bytes;
+}
+
 }  // namespace
 
 HloInstruction* SpmdBuilder::AddInstruction(
@@ -547,23 +581,43 @@ PartitionedHlo PartitionedHlo::ReshardNoCache(
     return ReshardWithAllToAll(target, *src_tgt_dims);
   }
 
-  if (!target.IsTileMaximal() && sharding().ReplicateOnLastTileDim()) {
-    auto try_reshard = ReshardFromPartialReplicateWithDynamicSlice(target);
-    if (try_reshard.has_value()) {
-      return try_reshard.value();
+  // Returns the cheaper of `first` and the plan built by `second`, in terms of
+  // bytes received through collectives. `second` is only built if `first` is
+  // missing or needs collectives. Ties go to `first`. The instructions of the
+  // plan that is not chosen are left for DCE.
+  auto cheaper_reshard =
+      [&](std::optional<PartitionedHlo> first,
+          absl::FunctionRef<std::optional<PartitionedHlo>()> second)
+      -> std::optional<PartitionedHlo> {
+    int64_t first_bytes = 0;
+    if (first.has_value()) {
+      first_bytes = ReshardCollectiveBytes(hlo_, first->hlo());
+      if (first_bytes == 0) {
+        return first;
+      }
+    }
+    std::optional<PartitionedHlo> second_reshard = second();
+    if (!first.has_value() ||
+        (second_reshard.has_value() &&
+         ReshardCollectiveBytes(hlo_, second_reshard->hlo()) < first_bytes)) {
+      return second_reshard;
     }
-    try_reshard = ReshardPartialReplicateWithAllToAll(target);
+    return first;
+  };
+
+  if (!target.IsTileMaximal() && sharding().ReplicateOnLastTileDim()) {
+    auto try_reshard = cheaper_reshard(
+        ReshardFromPartialReplicateWithDynamicSlice(target),
+        [&] { return ReshardPartialReplicateWithAllToAll(target); });
     if (try_reshard.has_value()) {
       return try_reshard.value();
     }
   }
 
   if (!sharding().IsTileMaximal() && target.ReplicateOnLastTileDim()) {
-    auto try_reshard = ReshardToPartialReplicateWithAllGather(target);
-    if (try_reshard.has_value()) {
-      return try_reshard.value();
-    }
-    try_reshard = ReshardPartialReplicateWithAllToAll(target);
+    auto try_reshard = cheaper_reshard(
+        ReshardToPartialReplicateWithAllGather(target),
+        [&] { return ReshardPartialReplicateWithAllToAll(target); });
     if (try_reshard.has_value()) {
       return try_reshard.value();
     }
@@ -122,6 +122,16 @@ struct SpmdPartitionerOptions {
   // This combines sizes in bytes of both operands.
   // When it's set, it will override threshold_for_windowed_einsum_mib.
   std::optional<int64_t> total_bytes_windowed_einsum_threshold = std::nullopt;
+
+  // Estimate the run time in milliseconds of an instruction, and of a
+  // collective that moves `bytes` within each of `device_groups`. When set,
+  // they are used by the default implementations of the cost queries of
+  // SpmdPartitioningVisitor, which skip windowed einsum where its overheads
+  // outweigh the overlap of communication and computation.
+  std::function<double(const HloInstruction*)> computation_time_in_ms;
+  std::function<double(int64_t bytes,
+                       absl::Span<const ReplicaGroup> device_groups)>
+      communication_time_in_ms;
 };
 
 // Class to wrap the computation builder to capture information during SPMD
@@ -705,11 +715,17 @@ class SpmdPartitioningVisitor : public DfsHloVisitorWithDefault {
       const SpmdPartitionerOptions& options);
 
   virtual double GetComputationTimeInMilliSec(HloInstruction* hlo) {
+    if (options_.computation_time_in_ms) {
+      return options_.computation_time_in_ms(hlo);
+    }
     return 0.0;
   }
 
   virtual double GetCommunicationTimeInMilliSec(
       int64_t bytes, absl::Span<const ReplicaGroup> device_groups) {
+    if (options_.communication_time_in_ms) {
+      return options_.communication_time_in_ms(bytes, device_groups);
+    }
     return 0.0;
   }
 
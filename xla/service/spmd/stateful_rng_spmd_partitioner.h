@@ -67,28 +67,11 @@ class StatefulRngSpmdPartitioner : public spmd::SpmdPartitioner {
                                       skip_checking_windowed_einsum_users,
                                       disable_ag_rewrite_for_multiple_consumers,
                                       total_bytes_windowed_einsum_threshold)) {}
+  StatefulRngSpmdPartitioner(int64_t num_partitions, int64_t num_replicas,
+                             spmd::SpmdPartitionerOptions options)
+      : spmd::SpmdPartitioner(num_partitions, num_replicas,
+                              std::move(options)) {}
 
- protected:
-  std::unique_ptr<spmd::SpmdPartitioningVisitor> CreateVisitor(
-      HloComputation* computation, int64_t num_partitions, int64_t num_replicas,
-      const spmd::SPMDCollectiveOpsCreator& collective_ops_creator,
-      int64_t* next_channel_id, spmd::SpmdLogger* logger,
-      spmd::SpmdPartitionerOptions options,
-      const CallGraph& call_graph) override;
-
-  absl::Status PreprocessSharding(
-      HloModule* module,
-      const absl::flat_hash_set<absl::string_view>& execution_threads) override;
-
-  // This adds an unsafe attribute labelling the while loop as a pipelined
-  // while loop. This attribute lets the rest of the passes ignore the
-  // computations in the pipeline bubble.
-  absl::Status HandleRotateRightWhilePreprocessing(
-      HloComputation* computation) override;
-  bool CanSideEffectingHaveReplicatedSharding(
-      const HloInstruction* hlo) override;
-
- private:
   static spmd::SpmdPartitionerOptions GetSpmdPartitionerOptions(
       int64_t threshold_for_windowed_einsum_mib,
       bool windowed_einsum_use_multiple_streams = false,
@@ -109,6 +92,26 @@ class StatefulRngSpmdPartitioner : public spmd::SpmdPartitioner {
         total_bytes_windowed_einsum_threshold;
     return options;
   }
+
+ protected:
+  std::unique_ptr<spmd::SpmdPartitioningVisitor> CreateVisitor(
+      HloComputation* computation, int64_t num_partitions, int64_t num_replicas,
+      const spmd::SPMDCollectiveOpsCreator& collective_ops_creator,
+      int64_t* next_channel_id, spmd::SpmdLogger* logger,
+      spmd::SpmdPartitionerOptions options,
+      const CallGraph& call_graph) override;
+
+  absl::Status PreprocessSharding(
+      HloModule* module,
+      const absl::flat_hash_set<absl::string_view>& execution_threads) override;
+
+  // This adds an unsafe attribute labelling the while loop as a pipelined
+  // while loop. This attribute lets the rest of the passes ignore the
+  // computations in the pipeline bubble.
+  absl::Status HandleRotateRightWhilePreprocessing(
+      HloComputation* computation) override;
+  bool CanSideEffectingHaveReplicatedSharding(
+      const HloInstruction* hlo) override;
 };
 
 }  // namespace spmd
@@ -0,0 +1,321 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/service/while_loop_associative_scan_rewriter.h"
+
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "absl/algorithm/container.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/literal.h"
+#include "xla/literal_util.h"
+#include "xla/primitive_util.h"
+#include "xla/service/hlo_creation_utils.h"
+#include "xla/service/while_loop_unroller.h"
+#include "xla/shape.h"
+#include "xla/shape_util.h"
+#include "xla/tsl/platform/errors.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/xla_data.pb.h"
+
+namespace xla {
+namespace {
+
+// A loop state element that is combined with one slice of a read-only input
+// per iteration.
+struct ScanCarry {
+  int64_t index;
+  HloOpcode opcode;
+  // The loop state index of the scanned input.
+  int64_t input_index;
+  // The dimension of the input that is scanned.
+  int64_t dim;
+};
+
+struct ScanLoop {
+  std::vector<ScanCarry> carries;
+  // Maps the loop state index of each accumulator to the index of the carry it
+  // stores.
+  absl::flat_hash_map<int64_t, int64_t> accumulators;
+};
+
+// Returns the identity of the associative `opcode` on `type`, or nullopt if
+// `opcode` is not a supported combiner.
+std::optional<Literal> GetCombinerIdentity(HloOpcode opcode,
+                                           PrimitiveType type) {
+  if (type == PRED) {
+    switch (opcode) {
+      case HloOpcode::kAnd:
+        return LiteralUtil::One(type);
+      case HloOpcode::kOr:
+        return LiteralUtil::Zero(type);
+      default:
+        return std::nullopt;
+    }
+  }
+  switch (opcode) {
+    case HloOpcode::kAdd:
+      return LiteralUtil::Zero(type);
+    case HloOpcode::kMultiply:
+      return LiteralUtil::One(type);
+    case HloOpcode::kMaximum:
+      if (primitive_util::IsComplexType(type)) {
+        return std::nullopt;
+      }
+      return LiteralUtil::MinValue(type);
+    case HloOpcode::kMinimum:
+      if (primitive_util::IsComplexType(type)) {
+        return std::nullopt;
+      }
+      return LiteralUtil::MaxValue(type);
+    default:
+      return std::nullopt;
+  }
+}
+
+bool IsParameterElement(const HloInstruction* instr,
+                        const HloInstruction* param, int64_t index) {
+  return instr->opcode() == HloOpcode::kGetTupleElement &&
+         instr->operand(0) == param && instr->tuple_index() == index;
+}
+
+bool IsReadOnly(const HloInstruction* root, const HloInstruction* param,
+                int64_t index) {
+  return IsParameterElement(root->operand(index), param, index);
+}
+
+// Matches carry' = op(carry, reshape(dynamic-slice(input, i, 0, ...))) at
+// `index` of the loop state, where input is read-only.
+std::optional<ScanCarry> MatchScanCarry(const HloInstruction* root,
+                                        const HloInstruction* param,
+                                        int64_t index,
+                                        const WhileLoopConfig& config) {
+  const HloInstruction* combined = root->operand(index);
+  if (!GetCombinerIdentity(combined->opcode(),
+                           combined->shape().element_type())
+           .has_value()) {
+    return std::nullopt;
+  }
+  for (int64_t i = 0; i < combined->operand_count(); ++i) {
+    if (!IsParameterElement(combined->operand(i), param, index)) {
+      continue;
+    }
+    const HloInstruction* slice = combined->operand(1 - i);
+    if (slice->opcode() != HloOpcode::kReshape) {
+      continue;
+    }
+    slice = slice->operand(0);
+    if (slice->opcode() != HloOpcode::kDynamicSlice ||
+        slice->operand(0)->opcode() != HloOpcode::kGetTupleElement ||
+        slice->operand(0)->operand(0) != param) {
+      continue;
+    }
+    const HloInstruction* input = slice->operand(0);
+    if (input->tuple_index() == config.induction_var_idx ||
+        !IsReadOnly(root, param, input->tuple_index())) {
+      continue;
+    }
+    std::optional<int64_t> dim = MatchShapeCoveringDynamicIndexInstruction(
+        slice, input, HloOpcode::kDynamicSlice, config);
+    if (!dim.has_value() ||
+        !ShapeUtil::Compatible(ShapeUtil::DeleteDimension(*dim, input->shape()),
+                               combined->shape())) {
+      continue;
+    }
+    return ScanCarry{index, combined->opcode(), input->tuple_index(), *dim};
+  }
+  return std::nullopt;
+}
+
+// Returns the scan computed by `while_instr`, or nullopt if the loop state
+// contains anything else than the induction variable, read-only values, scan
+// carries and the accumulators of the carries.
+std::optional<ScanLoop> MatchScanLoop(const HloInstruction* while_instr,
+                                      const WhileLoopConfig& config) {
+  const HloComputation* body = while_instr->while_body();
+  const HloInstruction* root = body->root_instruction();
+  const HloInstruction* param = body->parameter_instruction(0);
+  if (config.init != 0 || config.trip_count < 2 || body->HasSideEffect() ||
+      root->opcode() != HloOpcode::kTuple) {
+    return std::nullopt;
+  }
+
+  ScanLoop loop;
+  std::vector<int64_t> remaining;
+  for (int64_t i = 0; i < root->operand_count(); ++i) {
+    if (i == config.induction_var_idx || IsReadOnly(root, param, i)) {
+      continue;
+    }
+    if (std::optional<ScanCarry> carry =
+            MatchScanCarry(root, param, i, config)) {
+      loop.carries.push_back(*carry);
+    } else {
+      remaining.push_back(i);
+    }
+  }
+  if (loop.carries.empty()) {
+    return std::nullopt;
+  }
+
+  // The remaining elements must be accumulators, i.e.
+  // acc' = dynamic-update-slice(acc, reshape(carry'), i, 0, ...).
+  for (int64_t index : remaining) {
+    const HloInstruction* update = root->operand(index);
+    std::optional<int64_t> dim = MatchShapeCoveringDynamicIndexInstruction(
+        update, /*input=*/nullptr, HloOpcode::kDynamicUpdateSlice, config);
+    if (!dim.has_value() ||
+        !IsParameterElement(update->operand(0), param, index) ||
+        update->operand(1)->opcode() != HloOpcode::kReshape) {
+      return std::nullopt;
+    }
+    const HloInstruction* stored = update->operand(1)->operand(0);
+    auto stored_carry =
+        absl::c_find_if(loop.carries, [&](const ScanCarry& carry) {
+          return root->operand(carry.index) == stored && carry.dim == *dim &&
+                 ShapeUtil::Compatible(
+                     root->operand(carry.input_index)->shape(),
+                     update->shape());
+        });
+    if (stored_carry == loop.carries.end()) {
+      return std::nullopt;
+    }
+    loop.accumulators[index] = stored_carry->index;
+  }
+  return loop;
+}
+
+// Computes the inclusive prefix scan of `input` along `dim` in log2(n) steps,
+// where n is the size of `dim`. In each step, the scan is combined with itself
+// shifted by the next power of two, padded with the identity.
+absl::StatusOr<HloInstruction*> MakeParallelPrefixScan(HloInstruction* input,
+                                                       int64_t dim,
+                                                       HloOpcode opcode) {
+  const Shape& shape = input->shape();
+  const int64_t n = shape.dimensions(dim);
+  HloInstruction* identity =
+      input->AddInstruction(HloInstruction::CreateConstant(
+          *GetCombinerIdentity(opcode, shape.element_type())));
+  std::vector<int64_t> start_indices(shape.dimensions().size(), 0);
+  std::vector<int64_t> limit_indices(shape.dimensions().begin(),
+                                     shape.dimensions().end());
+  std::vector<int64_t> strides(shape.dimensions().size(), 1);
+  HloInstruction* scan = input;
+  for (int64_t shift = 1; shift < n; shift *= 2) {
+    limit_indices[dim] = n - shift;
+    TF_ASSIGN_OR_RETURN(
+        HloInstruction * prefix,
+        MakeSliceHlo(scan, start_indices, limit_indices, strides));
+    PaddingConfig padding_config =
+        MakeNoPaddingConfig(shape.dimensions().size());
+    padding_config.mutable_dimensions(dim)->set_edge_padding_low(shift);
+    TF_ASSIGN_OR_RETURN(HloInstruction * shifted,
+                        MakePadHlo(prefix, identity, padding_config));
+    TF_ASSIGN_OR_RETURN(scan, MakeBinaryHlo(opcode, shifted, scan));
+  }
+  return scan;
+}
+
+absl::Status RewriteScanLoop(HloInstruction* while_instr,
+                             const WhileLoopConfig& config,
+                             const ScanLoop& loop) {
+  HloComputation* computation = while_instr->parent();
+  HloInstruction* init = while_instr->mutable_operand(0);
+  const int64_t num_elements = init->shape().tuple_shapes_size();
+
+  // The read-only values are passed through.
+  std::vector<HloInstruction*> results(num_elements);
+  for (int64_t i = 0; i < num_elements; ++i) {
+    TF_ASSIGN_OR_RETURN(results[i], MakeGetTupleElementHlo(init, i));
+  }
+  results[config.induction_var_idx] = MakeScalarLike(
+      results[config.induction_var_idx], config.init + config.trip_count);
+
+  // The scans of the carries, by carry index.
+  absl::flat_hash_map<int64_t, HloInstruction*> scans;
+  for (const ScanCarry& carry : loop.carries) {
+    HloInstruction* input = results[carry.input_index];
+    HloInstruction* carry_init = results[carry.index];
+    TF_ASSIGN_OR_RETURN(HloInstruction * scan,
+                        MakeParallelPrefixScan(input, carry.dim, carry.opcode));
+    std::vector<int64_t> broadcast_dims;
+    for (int64_t i = 0; i < input->shape().dimensions_size(); ++i) {
+      if (i != carry.dim) {
+        broadcast_dims.push_back(i);
+      }
+    }
+    TF_ASSIGN_OR_RETURN(
+        scan, MakeBinaryHlo(carry.opcode,
+                            MakeBroadcastHlo(carry_init, broadcast_dims,
+                                             input->shape()),
+                            scan));
+    scans[carry.index] = scan;
+
+    std::vector<int64_t> start_indices(broadcast_dims.size() + 1, 0);
+    std::vector<int64_t> limit_indices(input->shape().dimensions().begin(),
+                                       input->shape().dimensions().end());
+    std::vector<int64_t> strides(broadcast_dims.size() + 1, 1);
+    start_indices[carry.dim] = config.trip_count - 1;
+    TF_ASSIGN_OR_RETURN(
+        HloInstruction * last,
+        MakeSliceHlo(scan, start_indices, limit_indices, strides));
+    TF_ASSIGN_OR_RETURN(results[carry.index],
+                        MakeReshapeHlo(carry_init->shape(), last));
+  }
+  for (const auto& [index, carry_index] : loop.accumulators) {
+    results[index] = scans[carry_index];
+  }
+
+  VLOG(2) << "Rewriting " << while_instr->name() << " with "
+          << loop.carries.size() << " carries into a parallel prefix scan";
+  return computation->ReplaceWithNewInstruction(
+      while_instr, HloInstruction::CreateTuple(results));
+}
+
+}  // namespace
+
+absl::StatusOr<bool> WhileLoopAssociativeScanRewriter::Run(
+    HloModule* module,
+    const absl::flat_hash_set<absl::string_view>& execution_threads) {
+  std::vector<std::pair<HloInstruction*, WhileLoopConfig>> unrollable_loops =
+      WhileLoopUnroller::GetUnrollableLoops(module, execution_threads,
+                                            /*unroll_config=*/std::nullopt);
+  bool changed = false;
+  for (auto& [while_instr, config] : unrollable_loops) {
+    std::optional<ScanLoop> loop = MatchScanLoop(while_instr, config);
+    if (!loop.has_value()) {
+      continue;
+    }
+    TF_RETURN_IF_ERROR(RewriteScanLoop(while_instr, config, *loop));
+    changed = true;
+  }
+  if (changed) {
+    TF_RETURN_IF_ERROR(module->RemoveUnusedComputations());
+  }
+  return changed;
+}
+
+}  // namespace xla
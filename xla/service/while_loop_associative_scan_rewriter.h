@@ -0,0 +1,71 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_SERVICE_WHILE_LOOP_ASSOCIATIVE_SCAN_REWRITER_H_
+#define XLA_SERVICE_WHILE_LOOP_ASSOCIATIVE_SCAN_REWRITER_H_
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/pass/hlo_pass_interface.h"
+
+namespace xla {
+
+// Rewrites sequential scan loops with an associative combiner into a parallel
+// prefix scan of depth log2(trip count). The scan loops usually come from
+// jax.lax.scan computing e.g. a cumulative sum:
+//
+//   +-scan-------------------------------------+
+//   | param = tuple(i, carry, acc, xs)         |
+//   | x = reshape(ds(xs, i, 0, ...))           |
+//   | carry' = add(carry, x)                   |
+//   | acc' = dus(acc, reshape(carry'), i, ...) |
+//   | ROOT = tuple(i + 1, carry', acc', xs)    |
+//   +------------------------------------------+
+//
+// becomes a Hillis-Steele scan of xs followed by the combination with the
+// initial carry:
+//
+//   y_0 = xs
+//   y_k = add(pad(slice(y_{k-1}, [0:n-2^k]), identity, low=2^k), y_{k-1})
+//   acc' = add(broadcast(carry), y_log2(n))
+//   carry' = reshape(slice(acc', [n-1:n]))
+//
+// The loop must have a statically known trip count, with an induction variable
+// starting at zero that indexes the scanned dimension of the inputs and the
+// accumulators. Every other element of the loop state has to be read-only, a
+// carry combined with a slice of a read-only input using add, multiply,
+// maximum or minimum (and, or for predicates), or an accumulator that is fully
+// overwritten with the carries. Loops that compute anything else are left
+// unchanged.
+//
+// This reassociates the combiner, so floating-point results may differ from
+// the sequential loop by rounding.
+class WhileLoopAssociativeScanRewriter : public HloModulePass {
+ public:
+  absl::string_view name() const override {
+    return "while-loop-associative-scan-rewriter";
+  }
+
+  using HloPassInterface::Run;
+  absl::StatusOr<bool> Run(
+      HloModule* module,
+      const absl::flat_hash_set<absl::string_view>& execution_threads) override;
+};
+
+}  // namespace xla
+
+#endif  // XLA_SERVICE_WHILE_LOOP_ASSOCIATIVE_SCAN_REWRITER_H_
@@ -0,0 +1,219 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/service/while_loop_associative_scan_rewriter.h"
+
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include <gtest/gtest.h>
+#include "absl/strings/string_view.h"
+#include "xla/error_spec.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/hlo/utils/hlo_query.h"
+#include "xla/tests/hlo_test_base.h"
+#include "xla/tsl/platform/statusor.h"
+
+namespace xla {
+namespace {
+
+using WhileLoopAssociativeScanRewriterTest = HloTestBase;
+
+TEST_F(WhileLoopAssociativeScanRewriterTest, RewritesCumulativeSum) {
+  constexpr absl::string_view kModule = R"(
+HloModule cumsum
+
+body {
+  param = (s32[], s32[], s32[10], s32[10]) parameter(0)
+  i = s32[] get-tuple-element(param), index=0
+  carry = s32[] get-tuple-element(param), index=1
+  acc = s32[10] get-tuple-element(param), index=2
+  xs = s32[10] get-tuple-element(param), index=3
+  slice = s32[1] dynamic-slice(xs, i), dynamic_slice_sizes={1}
+  x = s32[] reshape(slice)
+  next_carry = s32[] add(carry, x)
+  update = s32[1] reshape(next_carry)
+  next_acc = s32[10] dynamic-update-slice(acc, update, i)
+  one = s32[] constant(1)
+  next_i = s32[] add(i, one)
+  ROOT tuple = (s32[], s32[], s32[10], s32[10]) tuple(next_i, next_carry, next_acc, xs)
+}
+
+condition {
+  param = (s32[], s32[], s32[10], s32[10]) parameter(0)
+  i = s32[] get-tuple-element(param), index=0
+  trip_count = s32[] constant(10)
+  ROOT done = pred[] compare(i, trip_count), direction=LT
+}
+
+ENTRY main {
+  zero = s32[] constant(0)
+  carry = s32[] constant(5)
+  acc = s32[10] broadcast(zero), dimensions={}
+  xs = s32[10] constant({1, 2, 3, 4, 5, 6, 7, 8, 9, 10})
+  tuple = (s32[], s32[], s32[10], s32[10]) tuple(zero, carry, acc, xs)
+  ROOT while = (s32[], s32[], s32[10], s32[10]) while(tuple), condition=condition, body=body
+})";
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(kModule));
+  std::unique_ptr<HloModule> original = module->Clone();
+
+  TF_ASSERT_OK_AND_ASSIGN(bool changed,
+                          WhileLoopAssociativeScanRewriter().Run(module.get()));
+  EXPECT_TRUE(changed);
+  EXPECT_EQ(hlo_query::GetFirstInstructionWithOpcode(
+                *module->entry_computation(), HloOpcode::kWhile),
+            nullptr);
+  EXPECT_TRUE(RunAndCompareTwoModules(std::move(module), std::move(original),
+                                      {}, std::nullopt,
+                                      /*run_hlo_passes=*/false));
+}
+
+TEST_F(WhileLoopAssociativeScanRewriterTest, RewritesCumulativeMaxOfMatrix) {
+  constexpr absl::string_view kModule = R"(
+HloModule cummax
+
+body {
+  param = (s32[], f32[4], f32[4,13], f32[4,13]) parameter(0)
+  i = s32[] get-tuple-element(param), index=0
+  carry = f32[4] get-tuple-element(param), index=1
+  acc = f32[4,13] get-tuple-element(param), index=2
+  xs = f32[4,13] get-tuple-element(param), index=3
+  zero = s32[] constant(0)
+  slice = f32[4,1] dynamic-slice(xs, zero, i), dynamic_slice_sizes={4,1}
+  x = f32[4] reshape(slice)
+  next_carry = f32[4] maximum(x, carry)
+  update = f32[4,1] reshape(next_carry)
+  next_acc = f32[4,13] dynamic-update-slice(acc, update, zero, i)
+  one = s32[] constant(1)
+  next_i = s32[] add(i, one)
+  ROOT tuple = (s32[], f32[4], f32[4,13], f32[4,13]) tuple(next_i, next_carry, next_acc, xs)
+}
+
+condition {
+  param = (s32[], f32[4], f32[4,13], f32[4,13]) parameter(0)
+  i = s32[] get-tuple-element(param), index=0
+  trip_count = s32[] constant(13)
+  ROOT done = pred[] compare(i, trip_count), direction=LT
+}
+
+ENTRY main {
+  zero = s32[] constant(0)
+  carry = f32[4] parameter(0)
+  acc = f32[4,13] parameter(1)
+  xs = f32[4,13] parameter(2)
+  tuple = (s32[], f32[4], f32[4,13], f32[4,13]) tuple(zero, carry, acc, xs)
+  while = (s32[], f32[4], f32[4,13], f32[4,13]) while(tuple), condition=condition, body=body
+  result_carry = f32[4] get-tuple-element(while), index=1
+  result_acc = f32[4,13] get-tuple-element(while), index=2
+  ROOT result = (f32[4], f32[4,13]) tuple(result_carry, result_acc)
+})";
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(kModule));
+  std::unique_ptr<HloModule> original = module->Clone();
+
+  TF_ASSERT_OK_AND_ASSIGN(bool changed,
+                          WhileLoopAssociativeScanRewriter().Run(module.get()));
+  EXPECT_TRUE(changed);
+  EXPECT_EQ(hlo_query::GetFirstInstructionWithOpcode(
+                *module->entry_computation(), HloOpcode::kWhile),
+            nullptr);
+  EXPECT_TRUE(RunAndCompareTwoModules(std::move(module), std::move(original),
+                                      ErrorSpec{0, 0},
+                                      /*run_hlo_passes=*/false));
+}
+
+TEST_F(WhileLoopAssociativeScanRewriterTest,
+       DoesNotRewriteNonAssociativeCombiner) {
+  constexpr absl::string_view kModule = R"(
+HloModule cumsub
+
+body {
+  param = (s32[], s32[], s32[10]) parameter(0)
+  i = s32[] get-tuple-element(param), index=0
+  carry = s32[] get-tuple-element(param), index=1
+  xs = s32[10] get-tuple-element(param), index=2
+  slice = s32[1] dynamic-slice(xs, i), dynamic_slice_sizes={1}
+  x = s32[] reshape(slice)
+  next_carry = s32[] subtract(carry, x)
+  one = s32[] constant(1)
+  next_i = s32[] add(i, one)
+  ROOT tuple = (s32[], s32[], s32[10]) tuple(next_i, next_carry, xs)
+}
+
+condition {
+  param = (s32[], s32[], s32[10]) parameter(0)
+  i = s32[] get-tuple-element(param), index=0
+  trip_count = s32[] constant(10)
+  ROOT done = pred[] compare(i, trip_count), direction=LT
+}
+
+ENTRY main {
+  zero = s32[] constant(0)
+  xs = s32[10] parameter(0)
+  tuple = (s32[], s32[], s32[10]) tuple(zero, zero, xs)
+  ROOT while = (s32[], s32[], s32[10]) while(tuple), condition=condition, body=body
+})";
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(kModule));
+  TF_ASSERT_OK_AND_ASSIGN(bool changed,
+                          WhileLoopAssociativeScanRewriter().Run(module.get()));
+  EXPECT_FALSE(changed);
+}
+
+TEST_F(WhileLoopAssociativeScanRewriterTest,
+       DoesNotRewriteLoopWithOtherLoopState) {
+  constexpr absl::string_view kModule = R"(
+HloModule cumsum_and_product
+
+body {
+  param = (s32[], s32[], s32[], s32[10]) parameter(0)
+  i = s32[] get-tuple-element(param), index=0
+  carry = s32[] get-tuple-element(param), index=1
+  other = s32[] get-tuple-element(param), index=2
+  xs = s32[10] get-tuple-element(param), index=3
+  slice = s32[1] dynamic-slice(xs, i), dynamic_slice_sizes={1}
+  x = s32[] reshape(slice)
+  next_carry = s32[] add(carry, x)
+  next_other = s32[] multiply(carry, x)
+  one = s32[] constant(1)
+  next_i = s32[] add(i, one)
+  ROOT tuple = (s32[], s32[], s32[], s32[10]) tuple(next_i, next_carry, next_other, xs)
+}
+
+condition {
+  param = (s32[], s32[], s32[], s32[10]) parameter(0)
+  i = s32[] get-tuple-element(param), index=0
+  trip_count = s32[] constant(10)
+  ROOT done = pred[] compare(i, trip_count), direction=LT
+}
+
+ENTRY main {
+  zero = s32[] constant(0)
+  xs = s32[10] parameter(0)
+  tuple = (s32[], s32[], s32[], s32[10]) tuple(zero, zero, zero, xs)
+  ROOT while = (s32[], s32[], s32[], s32[10]) while(tuple), condition=condition, body=body
+})";
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(kModule));
+  TF_ASSERT_OK_AND_ASSIGN(bool changed,
+                          WhileLoopAssociativeScanRewriter().Run(module.get()));
+  EXPECT_FALSE(changed);
+}
+
+}  // namespace
+}  // namespace xla
@@ -226,6 +226,10 @@ WhileLoopInvariantCodeMotion::TryHoistingInvariantInstructionsFromWhileBody(
   std::vector<HloInstruction*> instructions_to_replace;
   std::vector<HloInstruction*> replacement_instructions;
 
+  // What is left of the budget for the outputs of the instructions over the
+  // inflation ratio.
+  int64_t remaining_size_budget = hoist_size_budget_.value_or(0);
+
   for (auto* instruction : while_body->MakeInstructionPostOrder()) {
     allowance->DeductCost(1);
     if (!allowance->ContinueAnalysis()) {
@@ -246,6 +250,7 @@ WhileLoopInvariantCodeMotion::TryHoistingInvariantInstructionsFromWhileBody(
     }
     // Constants don't inflate, so size inflation check doesn't make sense for
     // constants.
+    int64_t inflating_output_size = 0;
     if (hoist_size_inflation_ratio_ &&
         instruction->opcode() != HloOpcode::kConstant) {
       // Check that hoisting the instruction doesn't cause a significant memory
@@ -275,7 +280,10 @@ WhileLoopInvariantCodeMotion::TryHoistingInvariantInstructionsFromWhileBody(
           });
 
       if (output_size > input_size * *hoist_size_inflation_ratio_) {
-        continue;
+        if (!hoist_size_budget_.has_value()) {
+          continue;
+        }
+        inflating_output_size = output_size;
       }
     }
 
@@ -289,6 +297,15 @@ WhileLoopInvariantCodeMotion::TryHoistingInvariantInstructionsFromWhileBody(
       continue;
     }
 
+    // The output is charged even if it ends up being only hoisted along with
+    // a user, or not at all, which keeps the estimate conservative.
+    if (inflating_output_size > 0) {
+      if (inflating_output_size > remaining_size_budget) {
+        continue;
+      }
+      remaining_size_budget -= inflating_output_size;
+    }
+
     if (NotWorthHoistingIndividually(*instruction)) {
       VLOG(2) << "Adding " << instruction->ToString(print_no_metadata)
               << " to unhoisted invariant set.";
@@ -48,6 +48,12 @@ class WhileLoopInvariantCodeMotion : public HloModulePass {
   // input(s) is larger than hoist_size_inflation_ratio. This is useful on
   // platforms on which it's important to prevent blow-ups in memory size.
   //
+  // If `hoist_size_budget` is provided as well, instructions over the
+  // inflation ratio are still hoisted out of a while loop as long as the sum of
+  // their output sizes, which stay live during the whole loop, fits in the
+  // budget. This allows e.g. hoisting the dequantization of loop invariant
+  // weights while bounding the extra memory.
+  //
   // If `hoist_reshapes` is true, then reshapes are allowed to be hoisted out of
   // while loop body by themselves. Otherwise, they are only hoisted out if they
   // enable other non-trivial computations to be hoisted out.
@@ -60,12 +66,14 @@ class WhileLoopInvariantCodeMotion : public HloModulePass {
       bool hoist_constants = false, bool hoist_reshapes = false,
       bool hoist_other = true,
       std::optional<float> hoist_size_inflation_ratio = std::nullopt,
-      ShapeSizeFunction shape_size_function = ShapeUtil::ByteSizeOfElements)
+      ShapeSizeFunction shape_size_function = ShapeUtil::ByteSizeOfElements,
+      std::optional<int64_t> hoist_size_budget = std::nullopt)
       : hoist_constants_(hoist_constants),
         hoist_reshapes_(hoist_reshapes),
         hoist_other_(hoist_other),
         hoist_size_inflation_ratio_(hoist_size_inflation_ratio),
-        shape_size_function_(shape_size_function) {}
+        shape_size_function_(shape_size_function),
+        hoist_size_budget_(hoist_size_budget) {}
   ~WhileLoopInvariantCodeMotion() override = default;
 
   absl::string_view name() const override {
@@ -86,6 +94,7 @@ class WhileLoopInvariantCodeMotion : public HloModulePass {
   bool hoist_other_;
   std::optional<float> hoist_size_inflation_ratio_;
   ShapeSizeFunction shape_size_function_;
+  std::optional<int64_t> hoist_size_budget_;
 };
 }  // namespace xla
 
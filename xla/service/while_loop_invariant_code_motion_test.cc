@@ -630,6 +630,37 @@ TEST_F(WhileLoopInvariantCodeMotionTest, NoHoistInflating) {
   EXPECT_FALSE(simplified_loop);
 }
 
+TEST_F(WhileLoopInvariantCodeMotionTest, HoistsInflatingWithinSizeBudget) {
+  constexpr int64_t kIotaSize = 1024 * 1024 * sizeof(float);
+  {
+    auto m = ParseAndReturnVerifiedModule(kInflatingTestCase).value();
+    TF_ASSERT_OK_AND_ASSIGN(
+        bool simplified_loop,
+        WhileLoopInvariantCodeMotion(
+            /*hoist_constants=*/false, /*hoist_reshapes=*/true,
+            /*hoist_other=*/true, /*hoist_size_inflation_ratio=*/1.0,
+            ShapeUtil::ByteSizeOfElements,
+            /*hoist_size_budget=*/kIotaSize)
+            .Run(m.get()));
+    EXPECT_TRUE(simplified_loop);
+    HloComputation* while_body = m->GetComputationWithName("wide.body");
+    ASSERT_NE(while_body, nullptr);
+    EXPECT_THAT(while_body->instructions(), Not(Contains(op::Iota())));
+  }
+  {
+    auto m = ParseAndReturnVerifiedModule(kInflatingTestCase).value();
+    TF_ASSERT_OK_AND_ASSIGN(
+        bool simplified_loop,
+        WhileLoopInvariantCodeMotion(
+            /*hoist_constants=*/false, /*hoist_reshapes=*/true,
+            /*hoist_other=*/true, /*hoist_size_inflation_ratio=*/1.0,
+            ShapeUtil::ByteSizeOfElements,
+            /*hoist_size_budget=*/kIotaSize - 1)
+            .Run(m.get()));
+    EXPECT_FALSE(simplified_loop);
+  }
+}
+
 TEST_F(WhileLoopInvariantCodeMotionTest, DoesNotHoistSPMDFullToShardShape) {
   auto m = CreateNewVerifiedModule();
   auto array_s32 = ShapeUtil::MakeShape(S32, {4});
@@ -156,6 +156,11 @@ class CommandBuffer {
                             const ThreadDim& threads, const BlockDim& blocks,
                             Args... args);
 
+  // Creates an empty command that does nothing on device. Empty commands are
+  // used as join or fork points in the command dependency DAG.
+  virtual absl::StatusOr<const Command*> CreateEmptyCmd(
+      absl::Span<const Command* const> dependencies) = 0;
+
   // Creates a command that launches a nested command buffer.
   virtual absl::StatusOr<const Command*> CreateNestedCommand(
       const CommandBuffer& nested,
@@ -69,6 +69,7 @@ limitations under the License.
 #include "xla/stream_executor/generic_memory_allocation.h"
 #include "xla/stream_executor/generic_memory_allocator.h"
 #include "xla/stream_executor/gpu/context.h"
+#include "xla/stream_executor/gpu/pinned_host_memory_pool.h"
 #include "xla/stream_executor/gpu/read_numa_node.h"
 #include "xla/stream_executor/gpu/scoped_activate_context.h"
 #include "xla/stream_executor/gpu/tma_metadata.h"
@@ -534,8 +535,12 @@ absl::StatusOr<void*> HostAllocate(Context* context, int numa_node,
     // CUDA programming guide: "Any address of a variable ... returned by one
     // of the memory allocation routines from the driver ... API is always
     // aligned to at least 256 bytes."
-    auto* buffer =
-        tsl::port::NUMAMalloc(numa_node, size, /* minimum_alignment=*/256);
+    // Align large buffers to the huge page size so that they can be backed by
+    // transparent huge pages, which reduces the pinning and TLB cost.
+    int alignment = size >= PinnedHostMemoryPool::kHugePageSize
+                        ? PinnedHostMemoryPool::kHugePageSize
+                        : 256;
+    auto* buffer = tsl::port::NUMAMalloc(numa_node, size, alignment);
     if (buffer == nullptr && size > 0) {
       return absl::InternalError(absl::StrFormat(
           "Failed to allocate host memory of size %d pinned to NUMA node %d",
@@ -703,6 +708,10 @@ absl::Status CudaExecutor::Init() {
     VLOG(2) << "Could not determine NUMA node of device ordinal "
             << device_ordinal();
   }
+  host_memory_pool_ = std::make_unique<PinnedHostMemoryPool>(
+      [this](uint64_t size) {
+        return AllocateHostMemory(cuda_context_, numa_node_, size);
+      });
   return absl::OkStatus();
 }
 
@@ -1003,7 +1012,9 @@ DeviceMemoryBase CudaExecutor::Allocate(uint64_t size, int64_t memory_space) {
     return DeviceMemoryBase(result.value(), size);
   } else if (memory_space ==
              static_cast<int64_t>(stream_executor::MemoryType::kHost)) {
-    auto result = HostAllocate(cuda_context_, numa_node_, size);
+    auto result = PinnedHostMemoryPool::IsPooled(size)
+                      ? host_memory_pool_->Allocate(size)
+                      : HostAllocate(cuda_context_, numa_node_, size);
     if (!result.ok()) {
       return DeviceMemoryBase(nullptr, 0);
     }
@@ -1026,7 +1037,9 @@ void CudaExecutor::Deallocate(DeviceMemoryBase* mem) {
   }
   auto memory_space = status_or_memory_space.value();
   if (memory_space == MemoryType::kHost) {
-    HostDeallocate(cuda_context_, numa_node_, mem->opaque(), mem->size());
+    if (!host_memory_pool_->Deallocate(mem->opaque())) {
+      HostDeallocate(cuda_context_, numa_node_, mem->opaque(), mem->size());
+    }
   } else {
     DeviceDeallocate(cuda_context_, mem->opaque());
   }
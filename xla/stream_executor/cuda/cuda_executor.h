@@ -45,6 +45,7 @@ limitations under the License.
 #include "xla/stream_executor/event_based_timer.h"
 #include "xla/stream_executor/fft.h"
 #include "xla/stream_executor/gpu/gpu_executor.h"
+#include "xla/stream_executor/gpu/pinned_host_memory_pool.h"
 #include "xla/stream_executor/gpu/tma_metadata.h"
 #include "xla/stream_executor/kernel.h"
 #include "xla/stream_executor/kernel_spec.h"
@@ -217,6 +218,10 @@ class CudaExecutor : public GpuExecutor {
 
   // CudaContext for this device.
   CudaContext* cuda_context_;
+
+  // Pool of pinned host memory backing `Allocate` calls for the host memory
+  // space, so that small host buffers do not pin memory one by one.
+  std::unique_ptr<PinnedHostMemoryPool> host_memory_pool_;
 };
 
 }  // namespace stream_executor::gpu
@@ -218,6 +218,18 @@ absl::Status GpuCommandBuffer::UpdateLaunch(const Command* command,
   return absl::InternalError("Unsupported kernel arguments type");
 }
 
+absl::StatusOr<const CommandBuffer::Command*> GpuCommandBuffer::CreateEmptyCmd(
+    absl::Span<const Command* const> dependencies) {
+  TF_RETURN_IF_ERROR(CheckInState(State::kCreate));
+
+  Dependencies barrier = dependencies.empty()
+                             ? GetAutoDependencies()
+                             : ToGraphNodeDependencies(dependencies);
+  TF_ASSIGN_OR_RETURN(GraphNodeHandle handle, CreateBarrierNode(barrier));
+
+  return AppendCommand(GpuCommand{handle});
+}
+
 absl::StatusOr<const CommandBuffer::Command*>
 GpuCommandBuffer::CreateNestedCommand(
     const CommandBuffer& nested,
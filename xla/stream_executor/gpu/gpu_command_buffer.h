@@ -136,6 +136,9 @@ class GpuCommandBuffer : public CommandBuffer {
                             const BlockDim& blocks, const Kernel& kernel,
                             const KernelArgs& args) override;
 
+  absl::StatusOr<const Command*> CreateEmptyCmd(
+      absl::Span<const Command* const> dependencies) override;
+
   absl::StatusOr<const Command*> CreateNestedCommand(
       const CommandBuffer& nested,
       absl::Span<const Command* const> dependencies) override;
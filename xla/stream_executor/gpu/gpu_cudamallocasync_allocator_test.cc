@@ -15,8 +15,11 @@ limitations under the License.
 
 #include "xla/stream_executor/gpu/gpu_cudamallocasync_allocator.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <optional>
+#include <vector>
 
 #include <gtest/gtest.h>
 #include "absl/log/check.h"
@@ -25,9 +28,11 @@ limitations under the License.
 #include "xla/stream_executor/platform.h"
 #include "xla/stream_executor/platform_manager.h"
 #include "xla/stream_executor/stream_executor.h"
+#include "xla/tsl/framework/allocator.h"
 #include "xla/tsl/framework/device_id.h"
 #include "tsl/platform/statusor.h"
 #include "tsl/platform/test.h"
+#include "tsl/platform/test_benchmark.h"
 
 namespace se = stream_executor;
 
@@ -133,4 +138,93 @@ TEST(GpuCudaMallocAsyncAllocator, SyncAddressAlignedNewPool) {
   EXPECT_TRUE(stream->ok());
 }
 
+//===----------------------------------------------------------------------===//
+// Performance benchmarks below
+//===----------------------------------------------------------------------===//
+
+// Measures the host-side latency of a stream-ordered allocation followed by a
+// stream-ordered free of `state.range(0)` bytes from a dedicated pool.
+static void BM_AllocateDeallocate(benchmark::State& state) {
+  se::StreamExecutor* executor = GpuExecutor();
+  auto stream = executor->CreateStream().value();
+  auto allocator = GpuCudaMallocAsyncAllocator(
+      /*platform_device_id*/ tsl::PlatformDeviceId(executor->device_ordinal()),
+      /*create_new_pool*/ true,
+      /*new_pool_size*/ int64_t{1} << 30,
+      /*reserve_memory*/ true,
+      /*release_threshold*/ 0,
+      /*sync_mode*/ false,
+      /*compute_stats*/ false);
+  allocator.SetStreamAndPreallocateMemory(
+      stream->platform_specific_handle().stream);
+
+  for (auto s : state) {
+    void* ptr = allocator.AllocateRaw(tsl::Allocator::kAllocatorAlignment,
+                                      state.range(0));
+    benchmark::DoNotOptimize(ptr);
+    allocator.DeallocateRaw(ptr);
+  }
+  CHECK_OK(stream->BlockHostUntilDone());
+}
+
+BENCHMARK(BM_AllocateDeallocate)
+    ->Arg(256)
+    ->Arg(4 << 10)
+    ->Arg(1 << 20)
+    ->Arg(64 << 20);
+
+// Models a fragmenting workload: many small buffers are allocated, every
+// other one is freed, and the freed space is then requested back as buffers
+// twice as large. Reports the peak pool usage relative to the live bytes.
+static void BM_FragmentedAllocations(benchmark::State& state) {
+  se::StreamExecutor* executor = GpuExecutor();
+  auto stream = executor->CreateStream().value();
+  auto allocator = GpuCudaMallocAsyncAllocator(
+      /*platform_device_id*/ tsl::PlatformDeviceId(executor->device_ordinal()),
+      /*create_new_pool*/ true,
+      /*new_pool_size*/ int64_t{1} << 30,
+      /*reserve_memory*/ false,
+      /*release_threshold*/ 0,
+      /*sync_mode*/ false,
+      /*compute_stats*/ true);
+  allocator.SetStreamAndPreallocateMemory(
+      stream->platform_specific_handle().stream);
+
+  const int64_t num_buffers = state.range(0);
+  constexpr size_t kSmallSize = 64 << 10;
+  int64_t live_bytes = 0;
+  for (auto s : state) {
+    std::vector<void*> small(num_buffers);
+    for (void*& ptr : small) {
+      ptr = allocator.AllocateRaw(tsl::Allocator::kAllocatorAlignment,
+                                  kSmallSize);
+    }
+    for (int64_t i = 0; i < num_buffers; i += 2) {
+      allocator.DeallocateRaw(small[i]);
+    }
+    std::vector<void*> large(num_buffers / 4);
+    for (void*& ptr : large) {
+      ptr = allocator.AllocateRaw(tsl::Allocator::kAllocatorAlignment,
+                                  2 * kSmallSize);
+    }
+    live_bytes = (num_buffers / 2) * kSmallSize +
+                 (num_buffers / 4) * 2 * kSmallSize;
+    for (int64_t i = 1; i < num_buffers; i += 2) {
+      allocator.DeallocateRaw(small[i]);
+    }
+    for (void* ptr : large) {
+      allocator.DeallocateRaw(ptr);
+    }
+  }
+  CHECK_OK(stream->BlockHostUntilDone());
+
+  std::optional<tsl::AllocatorStats> stats = allocator.GetStats();
+  if (stats.has_value() && live_bytes > 0) {
+    state.counters["peak_to_live_ratio"] =
+        static_cast<double>(stats->peak_bytes_in_use) / live_bytes;
+  }
+}
+
+BENCHMARK(BM_FragmentedAllocations)->Arg(64)->Arg(1024);
+
 }  // namespace stream_executor
@@ -0,0 +1,86 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/stream_executor/gpu/pinned_host_memory_pool.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "absl/log/check.h"
+#include "absl/numeric/bits.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "xla/stream_executor/memory_allocation.h"
+#include "xla/tsl/platform/statusor.h"
+
+namespace stream_executor::gpu {
+
+static_assert((PinnedHostMemoryPool::kMinSizeClass << 18) ==
+              PinnedHostMemoryPool::kMaxSizeClass);
+
+PinnedHostMemoryPool::PinnedHostMemoryPool(SlabAllocator slab_allocator)
+    : slab_allocator_(std::move(slab_allocator)) {}
+
+int PinnedHostMemoryPool::SizeClassIndex(uint64_t size) {
+  uint64_t rounded = absl::bit_ceil(std::max(size, kMinSizeClass));
+  return absl::countr_zero(rounded) - absl::countr_zero(kMinSizeClass);
+}
+
+absl::StatusOr<void*> PinnedHostMemoryPool::Allocate(uint64_t size) {
+  CHECK(IsPooled(size)) << "Size " << size << " is not served by the pool";
+  int index = SizeClassIndex(size);
+
+  absl::MutexLock lock(&mu_);
+  std::vector<void*>& free_list = free_lists_[index];
+  if (free_list.empty()) {
+    // Carve a new huge-page-aligned slab into buffers of this size class.
+    uint64_t buffer_bytes = SizeClassBytes(index);
+    uint64_t slab_bytes = std::max(buffer_bytes, kHugePageSize);
+    TF_ASSIGN_OR_RETURN(std::unique_ptr<MemoryAllocation> slab,
+                        slab_allocator_(slab_bytes));
+    char* base = static_cast<char*>(slab->opaque());
+    for (uint64_t offset = 0; offset + buffer_bytes <= slab_bytes;
+         offset += buffer_bytes) {
+      free_list.push_back(base + offset);
+    }
+    reserved_bytes_ += slab_bytes;
+    slabs_.push_back(std::move(slab));
+  }
+
+  void* ptr = free_list.back();
+  free_list.pop_back();
+  allocated_[ptr] = index;
+  return ptr;
+}
+
+bool PinnedHostMemoryPool::Deallocate(void* ptr) {
+  absl::MutexLock lock(&mu_);
+  auto it = allocated_.find(ptr);
+  if (it == allocated_.end()) {
+    return false;
+  }
+  free_lists_[it->second].push_back(ptr);
+  allocated_.erase(it);
+  return true;
+}
+
+uint64_t PinnedHostMemoryPool::reserved_bytes() const {
+  absl::MutexLock lock(&mu_);
+  return reserved_bytes_;
+}
+
+}  // namespace stream_executor::gpu
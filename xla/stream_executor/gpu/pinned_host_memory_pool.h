@@ -0,0 +1,85 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_STREAM_EXECUTOR_GPU_PINNED_HOST_MEMORY_POOL_H_
+#define XLA_STREAM_EXECUTOR_GPU_PINNED_HOST_MEMORY_POOL_H_
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/functional/any_invocable.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "xla/stream_executor/memory_allocation.h"
+
+namespace stream_executor::gpu {
+
+// A pool of pinned host memory with power-of-two size-class free lists.
+//
+// Pinning host memory (e.g. with cuMemHostAlloc) is expensive, so instead of
+// pinning every host buffer separately the pool carves buffers out of large
+// pinned slabs, and keeps freed buffers on a free list of their size class for
+// reuse. Slabs are multiples of the 2MiB huge page size so that they can be
+// backed by transparent huge pages, and are only released when the pool is
+// destroyed. Requests larger than the largest size class are not pooled.
+class PinnedHostMemoryPool {
+ public:
+  // Allocates a slab of pinned host memory of the given size.
+  using SlabAllocator =
+      absl::AnyInvocable<absl::StatusOr<std::unique_ptr<MemoryAllocation>>(
+          uint64_t size)>;
+
+  static constexpr uint64_t kHugePageSize = 2 << 20;
+  static constexpr uint64_t kMinSizeClass = 256;
+  static constexpr uint64_t kMaxSizeClass = 64 << 20;
+
+  explicit PinnedHostMemoryPool(SlabAllocator slab_allocator);
+
+  // Returns true if requests of `size` bytes are served from the pool.
+  static bool IsPooled(uint64_t size) { return size <= kMaxSizeClass; }
+
+  // Allocates `size` bytes of pinned host memory. `size` must be pooled.
+  absl::StatusOr<void*> Allocate(uint64_t size);
+
+  // Returns `ptr` to its size class free list. Returns false if `ptr` was not
+  // allocated from this pool.
+  bool Deallocate(void* ptr);
+
+  // Total bytes of pinned slabs held by the pool.
+  uint64_t reserved_bytes() const;
+
+ private:
+  static constexpr int kNumSizeClasses = 19;  // 256B to 64MiB.
+  static int SizeClassIndex(uint64_t size);
+  static uint64_t SizeClassBytes(int index) { return kMinSizeClass << index; }
+
+  SlabAllocator slab_allocator_;
+
+  mutable absl::Mutex mu_;
+  std::vector<std::unique_ptr<MemoryAllocation>> slabs_ ABSL_GUARDED_BY(mu_);
+  std::array<std::vector<void*>, kNumSizeClasses> free_lists_
+      ABSL_GUARDED_BY(mu_);
+  // Size class index of each buffer handed out by the pool.
+  absl::flat_hash_map<void*, int> allocated_ ABSL_GUARDED_BY(mu_);
+  uint64_t reserved_bytes_ ABSL_GUARDED_BY(mu_) = 0;
+};
+
+}  // namespace stream_executor::gpu
+
+#endif  // XLA_STREAM_EXECUTOR_GPU_PINNED_HOST_MEMORY_POOL_H_
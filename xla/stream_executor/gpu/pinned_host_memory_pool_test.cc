@@ -0,0 +1,90 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/stream_executor/gpu/pinned_host_memory_pool.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+
+#include <gtest/gtest.h>
+#include "absl/status/statusor.h"
+#include "xla/stream_executor/generic_memory_allocation.h"
+#include "xla/stream_executor/memory_allocation.h"
+#include "xla/tsl/lib/core/status_test_util.h"
+#include "xla/tsl/platform/statusor.h"
+
+namespace stream_executor::gpu {
+namespace {
+
+// Allocates slabs from regular host memory and counts the number of slabs.
+PinnedHostMemoryPool::SlabAllocator CountingSlabAllocator(int* num_slabs) {
+  return [num_slabs](uint64_t size)
+             -> absl::StatusOr<std::unique_ptr<MemoryAllocation>> {
+    ++*num_slabs;
+    return std::make_unique<GenericMemoryAllocation>(
+        std::malloc(size), size,
+        [](void* ptr, uint64_t size) { std::free(ptr); });
+  };
+}
+
+TEST(PinnedHostMemoryPoolTest, ReusesFreedBuffers) {
+  int num_slabs = 0;
+  PinnedHostMemoryPool pool(CountingSlabAllocator(&num_slabs));
+
+  TF_ASSERT_OK_AND_ASSIGN(void* a, pool.Allocate(1000));
+  ASSERT_TRUE(pool.Deallocate(a));
+  TF_ASSERT_OK_AND_ASSIGN(void* b, pool.Allocate(1024));
+
+  EXPECT_EQ(a, b);
+  EXPECT_EQ(num_slabs, 1);
+  EXPECT_EQ(pool.reserved_bytes(), PinnedHostMemoryPool::kHugePageSize);
+}
+
+TEST(PinnedHostMemoryPoolTest, CarvesSlabIntoSizeClassBuffers) {
+  int num_slabs = 0;
+  PinnedHostMemoryPool pool(CountingSlabAllocator(&num_slabs));
+
+  // A single huge page slab holds 2048 buffers of 1KiB.
+  for (int i = 0; i < 2048; ++i) {
+    TF_ASSERT_OK_AND_ASSIGN(void* ptr, pool.Allocate(1024));
+    EXPECT_NE(ptr, nullptr);
+  }
+  EXPECT_EQ(num_slabs, 1);
+
+  TF_ASSERT_OK(pool.Allocate(1024).status());
+  EXPECT_EQ(num_slabs, 2);
+}
+
+TEST(PinnedHostMemoryPoolTest, LargeSizeClassesGetTheirOwnSlab) {
+  int num_slabs = 0;
+  PinnedHostMemoryPool pool(CountingSlabAllocator(&num_slabs));
+
+  TF_ASSERT_OK(pool.Allocate((8 << 20) - 1).status());
+  EXPECT_EQ(num_slabs, 1);
+  EXPECT_EQ(pool.reserved_bytes(), 8 << 20);
+  EXPECT_FALSE(PinnedHostMemoryPool::IsPooled(
+      PinnedHostMemoryPool::kMaxSizeClass + 1));
+}
+
+TEST(PinnedHostMemoryPoolTest, RejectsForeignPointers) {
+  int num_slabs = 0;
+  PinnedHostMemoryPool pool(CountingSlabAllocator(&num_slabs));
+  int value = 0;
+  EXPECT_FALSE(pool.Deallocate(&value));
+}
+
+}  // namespace
+}  // namespace stream_executor::gpu
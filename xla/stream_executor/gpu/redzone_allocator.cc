@@ -22,6 +22,7 @@ limitations under the License.
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/container/fixed_array.h"
 #include "absl/log/check.h"
@@ -201,58 +202,52 @@ static absl::Status ReinitializeRedzone(Stream* stream,
   return absl::OkStatus();
 }
 
-// Check redzones around the user allocation.
-//
-// Precondition: the memory pointed out by out_param is zeroed.
-static absl::StatusOr<RedzoneCheckStatus> CheckRedzonesForBuffer(
-    Stream* stream, DeviceMemoryBase memory,
-    const DeviceMemory<uint64_t>& out_param,
-    ComparisonKernel& comparison_kernel, int64_t user_allocation_size,
-    uint64_t redzone_size, uint8_t redzone_pattern) {
+// The redzones on both sides of a user allocation.
+struct BufferRedzones {
+  DeviceMemory<uint8_t> lhs_redzone;
+  DeviceMemory<uint8_t> user_allocation;
+  DeviceMemory<uint8_t> rhs_redzone;
+};
+
+static BufferRedzones GetBufferRedzones(DeviceMemoryBase memory,
+                                        int64_t user_allocation_size,
+                                        uint64_t redzone_size) {
   int64_t rhs_slop =
       RoundUpToNearest<int64_t>(user_allocation_size, kRhsRedzoneAlign) -
       user_allocation_size;
   CHECK_EQ(memory.size(), user_allocation_size + rhs_slop + 2 * redzone_size);
 
   DeviceMemory<uint8_t> buffer_uint8(memory);
-  DeviceMemory<uint8_t> lhs_redzone =
+  return BufferRedzones{
       buffer_uint8.GetSlice(0,
-                            /*element_count=*/redzone_size);
-  DeviceMemory<uint8_t> user_allocation =
+                            /*element_count=*/redzone_size),
       buffer_uint8.GetSlice(redzone_size,
-                            /*element_count=*/user_allocation_size);
-  DeviceMemory<uint8_t> rhs_redzone =
+                            /*element_count=*/user_allocation_size),
       buffer_uint8.GetSlice(redzone_size + user_allocation_size,
-                            /*element_count=*/redzone_size + rhs_slop);
-
-  TF_RETURN_IF_ERROR(RunRedzoneChecker(stream, lhs_redzone, redzone_pattern,
-                                       out_param, comparison_kernel));
-  TF_RETURN_IF_ERROR(RunRedzoneChecker(stream, rhs_redzone, redzone_pattern,
-                                       out_param, comparison_kernel));
-  int64_t result;
-  CHECK_EQ(out_param.size(), sizeof(result));
-  TF_RETURN_IF_ERROR(stream->Memcpy(&result, out_param, sizeof(result)));
-  TF_RETURN_IF_ERROR(stream->BlockHostUntilDone());
-
-  if (result != 0) {
-    TF_ASSIGN_OR_RETURN(RedzoneCheckStatus lhs_check,
-                        CheckRedzoneHost(lhs_redzone, user_allocation, "LHS",
-                                         stream, redzone_pattern));
-    TF_ASSIGN_OR_RETURN(RedzoneCheckStatus rhs_check,
-                        CheckRedzoneHost(rhs_redzone, user_allocation, "RHS",
-                                         stream, redzone_pattern));
-
-    CHECK(!lhs_check.ok() || !rhs_check.ok())
-        << "Mismatched results with host and device comparison";
+                            /*element_count=*/redzone_size + rhs_slop)};
+}
 
-    TF_RETURN_IF_ERROR(
-        ReinitializeRedzone(stream, lhs_redzone, redzone_pattern));
-    TF_RETURN_IF_ERROR(
-        ReinitializeRedzone(stream, rhs_redzone, redzone_pattern));
-    return !lhs_check.ok() ? lhs_check : rhs_check;
+// Checks the redzones of a buffer on the host, after the device check found a
+// mismatch in some buffer, and re-initializes them if they were modified.
+static absl::StatusOr<RedzoneCheckStatus> CheckAndReinitializeRedzonesOnHost(
+    Stream* stream, const BufferRedzones& redzones, uint8_t redzone_pattern) {
+  TF_ASSIGN_OR_RETURN(
+      RedzoneCheckStatus lhs_check,
+      CheckRedzoneHost(redzones.lhs_redzone, redzones.user_allocation, "LHS",
+                       stream, redzone_pattern));
+  TF_ASSIGN_OR_RETURN(
+      RedzoneCheckStatus rhs_check,
+      CheckRedzoneHost(redzones.rhs_redzone, redzones.user_allocation, "RHS",
+                       stream, redzone_pattern));
+  if (lhs_check.ok() && rhs_check.ok()) {
+    return RedzoneCheckStatus::OK();
   }
 
-  return RedzoneCheckStatus::OK();
+  TF_RETURN_IF_ERROR(
+      ReinitializeRedzone(stream, redzones.lhs_redzone, redzone_pattern));
+  TF_RETURN_IF_ERROR(
+      ReinitializeRedzone(stream, redzones.rhs_redzone, redzone_pattern));
+  return !lhs_check.ok() ? lhs_check : rhs_check;
 }
 
 absl::StatusOr<DeviceMemoryBase> RedzoneAllocator::CreateBuffer(
@@ -277,19 +272,42 @@ absl::StatusOr<RedzoneCheckStatus> RedzoneAllocator::CheckRedzones() const {
   TF_RETURN_IF_ERROR(
       stream_->MemZero(out_param.memory_ptr(), sizeof(uint64_t)));
 
+  // The checker kernels of all buffers count mismatches into the same
+  // `out_param`, so the host waits for the device only once.
+  std::vector<BufferRedzones> buffer_redzones;
+  buffer_redzones.reserve(allocated_buffers_.size());
   for (const auto& buf_and_size : allocated_buffers_) {
-    TF_ASSIGN_OR_RETURN(
-        RedzoneCheckStatus redzone_status,
-        CheckRedzonesForBuffer(stream_, *buf_and_size.first,
-                               DeviceMemory<uint64_t>(out_param.memory()),
-                               *kernel, buf_and_size.second, redzone_size_,
-                               redzone_pattern_));
+    const BufferRedzones& redzones = buffer_redzones.emplace_back(
+        GetBufferRedzones(*buf_and_size.first, buf_and_size.second,
+                          redzone_size_));
+    TF_RETURN_IF_ERROR(RunRedzoneChecker(
+        stream_, redzones.lhs_redzone, redzone_pattern_,
+        DeviceMemory<uint64_t>(out_param.memory()), *kernel));
+    TF_RETURN_IF_ERROR(RunRedzoneChecker(
+        stream_, redzones.rhs_redzone, redzone_pattern_,
+        DeviceMemory<uint64_t>(out_param.memory()), *kernel));
+  }
+
+  int64_t result;
+  CHECK_EQ(out_param.memory().size(), sizeof(result));
+  TF_RETURN_IF_ERROR(
+      stream_->Memcpy(&result, out_param.memory(), sizeof(result)));
+  TF_RETURN_IF_ERROR(stream_->BlockHostUntilDone());
+  if (result == 0) {
+    return RedzoneCheckStatus::OK();
+  }
+
+  // A redzone was modified, which is rare. Find the first such buffer on the
+  // host.
+  for (const BufferRedzones& redzones : buffer_redzones) {
+    TF_ASSIGN_OR_RETURN(RedzoneCheckStatus redzone_status,
+                        CheckAndReinitializeRedzonesOnHost(stream_, redzones,
+                                                           redzone_pattern_));
     if (!redzone_status.ok()) {
       return redzone_status;
     }
   }
-
-  return RedzoneCheckStatus::OK();
+  LOG(FATAL) << "Mismatched results with host and device comparison";
 }
 
 std::string RedzoneCheckStatus::RedzoneFailureMsg() const {
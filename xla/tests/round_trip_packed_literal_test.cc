@@ -14,6 +14,7 @@ limitations under the License.
 ==============================================================================*/
 
 #include <memory>
+#include <string>
 
 #include "absl/base/casts.h"
 #include "absl/status/statusor.h"
@@ -21,11 +22,13 @@ limitations under the License.
 #include "xla/client/local_client.h"
 #include "xla/layout_util.h"
 #include "xla/literal.h"
+#include "xla/literal_util.h"
 #include "xla/packed_literal_reader.h"
 #include "xla/shape_util.h"
 #include "xla/tests/client_library_test_base.h"
 #include "xla/tests/literal_test_util.h"
 #include "xla/tests/test_macros.h"
+#include "xla/types.h"
 #include "xla/xla_data.pb.h"
 #include "tsl/platform/env.h"
 #include "tsl/platform/test.h"
@@ -124,5 +127,22 @@ TEST_F(RoundTripPackedLiteralTest, RoundTripsR2F32Size2x2Dim1Minor) {
   EXPECT_TRUE(LiteralTestUtil::Equal(round_tripped, actual));
 }
 
+TEST_F(RoundTripPackedLiteralTest, ReadsPackedR1S4Length5) {
+  // Two elements to a byte, the first one in the low-order bits.
+  std::string data = {'\xe1', '\xc3', '\x07'};
+
+  std::string fname = tsl::testing::TmpDir() + "/ReadsPackedR1S4Length5.data";
+  EXPECT_TRUE(tsl::WriteStringToFile(tsl::Env::Default(), fname, data).ok());
+
+  std::unique_ptr<tsl::RandomAccessFile> f;
+  TF_CHECK_OK(tsl::Env::Default()->NewRandomAccessFile(fname, &f));
+  PackedLiteralReader reader(f.release());
+  Literal actual = reader.Read(ShapeUtil::MakeShape(S4, {5})).value();
+  EXPECT_TRUE(reader.IsExhausted());
+
+  EXPECT_EQ(LiteralUtil::CreateR1<s4>({s4(1), s4(-2), s4(3), s4(-4), s4(7)}),
+            actual);
+}
+
 }  // namespace
 }  // namespace xla
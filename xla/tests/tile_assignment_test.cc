@@ -72,6 +72,14 @@ TEST(TileAssignmentTest, V1V2Equivalence) {
   EXPECT_EQ(absl::HashOf(v1), absl::HashOf(v2));
 }
 
+TEST(TileAssignmentTest, HashOfLargeIotaMatchesArray) {
+  TileAssignment iota({64, 128}, {128, 64}, {1, 0});
+  TileAssignment array(iota.shared_array_clone());
+  TileAssignment other_iota({64, 128});
+  EXPECT_EQ(absl::HashOf(iota), absl::HashOf(array));
+  EXPECT_NE(absl::HashOf(iota), absl::HashOf(other_iota));
+}
+
 TEST(TileAssignmentTest, CopyConstruction) {
   TileAssignment tile({2, 2, 4}, {2, 2, 4}, {2, 1, 0});
   TileAssignment copied(tile);
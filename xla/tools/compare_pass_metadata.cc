@@ -0,0 +1,135 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/tools/compare_pass_metadata.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/string_view.h"
+#include "xla/service/hlo.pb.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/errors.h"
+#include "xla/tsl/platform/statusor.h"
+
+namespace xla {
+namespace {
+
+absl::StatusOr<HloModuleMetadataProto> ReadMetadata(absl::string_view path) {
+  HloModuleMetadataProto metadata;
+  TF_RETURN_IF_ERROR(tsl::ReadTextOrBinaryProto(
+      tsl::Env::Default(), std::string(path), &metadata));
+  return metadata;
+}
+
+double ToMillis(int64_t usec) { return usec / 1000.0; }
+
+double ToMegabytes(int64_t bytes) { return bytes / (1024.0 * 1024.0); }
+
+}  // namespace
+
+PassMetadataSummaries SummarizePassMetadata(
+    const HloModuleMetadataProto& metadata) {
+  PassMetadataSummaries summaries;
+  for (const HloPassMetadata& pass : metadata.pass_metadata()) {
+    PassMetadataSummary& summary =
+        summaries[absl::StrCat(pass.pipeline_name(), "/", pass.pass_name())];
+    ++summary.runs;
+    summary.changed_runs += pass.module_changed() ? 1 : 0;
+    summary.total_time_usec +=
+        pass.end_timestamp_usec() - pass.start_timestamp_usec();
+    summary.instruction_count_delta +=
+        pass.instruction_count_after() - pass.instruction_count_before();
+    summary.max_peak_rss_increase_bytes = std::max(
+        summary.max_peak_rss_increase_bytes, pass.peak_rss_increase_bytes());
+  }
+  return summaries;
+}
+
+std::string ComparePassMetadata(const PassMetadataSummaries& baseline,
+                                const PassMetadataSummaries& test,
+                                int64_t min_time_delta_usec) {
+  // A pass that only ran in one of the compilations is compared against an
+  // empty summary.
+  std::vector<std::pair<std::string, std::pair<PassMetadataSummary,
+                                               PassMetadataSummary>>>
+      rows;
+  for (const auto& [name, summary] : baseline) {
+    auto it = test.find(name);
+    rows.push_back({name, {summary, it == test.end() ? PassMetadataSummary()
+                                                     : it->second}});
+  }
+  for (const auto& [name, summary] : test) {
+    if (!baseline.contains(name)) {
+      rows.push_back({name, {PassMetadataSummary(), summary}});
+    }
+  }
+  auto time_delta = [](const auto& row) {
+    return row.second.second.total_time_usec -
+           row.second.first.total_time_usec;
+  };
+  std::stable_sort(rows.begin(), rows.end(),
+                   [&](const auto& a, const auto& b) {
+                     return std::abs(time_delta(a)) > std::abs(time_delta(b));
+                   });
+
+  std::string result = absl::StrFormat(
+      "%-60s %12s %12s %12s %11s %11s %13s %13s\n", "pass", "base ms",
+      "test ms", "delta ms", "base runs", "test runs", "base instrs",
+      "test instrs");
+  for (const auto& row : rows) {
+    if (std::abs(time_delta(row)) < min_time_delta_usec) {
+      continue;
+    }
+    const auto& [base, tested] = row.second;
+    absl::StrAppendFormat(
+        &result, "%-60s %12.3f %12.3f %+12.3f %5d/%-5d %5d/%-5d %+13d %+13d\n",
+        row.first, ToMillis(base.total_time_usec),
+        ToMillis(tested.total_time_usec), ToMillis(time_delta(row)),
+        base.changed_runs, base.runs, tested.changed_runs, tested.runs,
+        base.instruction_count_delta, tested.instruction_count_delta);
+    if (base.max_peak_rss_increase_bytes != 0 ||
+        tested.max_peak_rss_increase_bytes != 0) {
+      absl::StrAppendFormat(&result, "%-60s %12.1f %12.1f %+12.1f (peak MB)\n",
+                            "", ToMegabytes(base.max_peak_rss_increase_bytes),
+                            ToMegabytes(tested.max_peak_rss_increase_bytes),
+                            ToMegabytes(tested.max_peak_rss_increase_bytes -
+                                        base.max_peak_rss_increase_bytes));
+    }
+  }
+  return result;
+}
+
+absl::Status Run(absl::string_view baseline_file, absl::string_view test_file,
+                 int64_t min_time_delta_usec) {
+  TF_ASSIGN_OR_RETURN(HloModuleMetadataProto baseline,
+                      ReadMetadata(baseline_file));
+  TF_ASSIGN_OR_RETURN(HloModuleMetadataProto test, ReadMetadata(test_file));
+  std::cout << ComparePassMetadata(SummarizePassMetadata(baseline),
+                                   SummarizePassMetadata(test),
+                                   min_time_delta_usec);
+  return absl::OkStatus();
+}
+
+}  // namespace xla
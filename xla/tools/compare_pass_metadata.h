@@ -0,0 +1,64 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// A library for comparing the per-pass compile time and memory of two
+// compilations, from the metadata dumped with --xla_dump_module_metadata.
+
+#ifndef XLA_TOOLS_COMPARE_PASS_METADATA_H_
+#define XLA_TOOLS_COMPARE_PASS_METADATA_H_
+
+#include <cstdint>
+#include <string>
+
+#include "absl/container/btree_map.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "xla/service/hlo.pb.h"
+
+namespace xla {
+
+// Totals over all the runs of a pass in one compilation.
+struct PassMetadataSummary {
+  int64_t runs = 0;
+  int64_t changed_runs = 0;
+  int64_t total_time_usec = 0;
+  // Sum of instruction_count_after - instruction_count_before over the runs.
+  int64_t instruction_count_delta = 0;
+  int64_t max_peak_rss_increase_bytes = 0;
+};
+
+// Pass summaries keyed by "<pipeline name>/<pass name>".
+using PassMetadataSummaries = absl::btree_map<std::string, PassMetadataSummary>;
+
+// Sums the metadata of each pass that ran on the module.
+PassMetadataSummaries SummarizePassMetadata(
+    const HloModuleMetadataProto& metadata);
+
+// Returns a table of the passes of `baseline` and `test`, sorted by decreasing
+// absolute difference in total time. Passes whose time differs by less than
+// `min_time_delta_usec` are omitted.
+std::string ComparePassMetadata(const PassMetadataSummaries& baseline,
+                                const PassMetadataSummaries& test,
+                                int64_t min_time_delta_usec = 0);
+
+// Reads two text or binary HloModuleMetadataProto files, and prints the
+// comparison of their passes to stdout.
+absl::Status Run(absl::string_view baseline_file, absl::string_view test_file,
+                 int64_t min_time_delta_usec);
+
+}  // namespace xla
+
+#endif  // XLA_TOOLS_COMPARE_PASS_METADATA_H_
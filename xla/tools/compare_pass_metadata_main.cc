@@ -0,0 +1,69 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// A tool for comparing the per-pass compile time and memory of two
+// compilations.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "xla/tools/compare_pass_metadata.h"
+#include "xla/tsl/util/command_line_flags.h"
+#include "tsl/platform/init_main.h"
+
+namespace {
+
+const char* const kUsage = R"(
+    This tool compares the passes of two compilations of the same module, from
+    the module_XXXX.metadata.textproto files written by
+    --xla_dump_module_metadata. For each pass it prints the total time, the
+    number of runs that changed the module, the change in instruction count,
+    and the largest increase in peak memory of a run.
+
+    Usage:
+
+      bazel run compare_pass_metadata -- --baseline=path/to/before.textproto \
+        --test=path/to/after.textproto --min_time_delta_usec=1000
+    )";
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::string baseline, test;
+  int64_t min_time_delta_usec = 0;
+  std::vector<tsl::Flag> flag_list = {
+      tsl::Flag("baseline", &baseline, "baseline module metadata file"),
+      tsl::Flag("test", &test, "module metadata file to compare"),
+      tsl::Flag("min_time_delta_usec", &min_time_delta_usec,
+                "omit passes whose time differs by less than this")};
+  const std::string kUsageString =
+      absl::StrCat(kUsage, "\n\n", tsl::Flags::Usage(argv[0], flag_list));
+  bool parse_ok = tsl::Flags::Parse(&argc, argv, flag_list);
+  tsl::port::InitMain(kUsageString.c_str(), &argc, &argv);
+  if (!parse_ok || baseline.empty() || test.empty()) {
+    LOG(QFATAL) << kUsageString;
+  }
+
+  absl::Status status = xla::Run(baseline, test, min_time_delta_usec);
+  if (!status.ok()) {
+    LOG(ERROR) << status;
+    return 1;
+  }
+  return 0;
+}
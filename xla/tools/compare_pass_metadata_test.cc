@@ -0,0 +1,89 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/tools/compare_pass_metadata.h"
+
+#include <cstdint>
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/strings/string_view.h"
+#include "xla/service/hlo.pb.h"
+
+namespace xla {
+namespace {
+
+using ::testing::HasSubstr;
+using ::testing::Not;
+
+void AddPass(HloModuleMetadataProto& metadata, absl::string_view pass_name,
+             int64_t time_usec, bool changed, int64_t instructions_before,
+             int64_t instructions_after) {
+  HloPassMetadata* pass = metadata.add_pass_metadata();
+  pass->set_pass_name(pass_name);
+  pass->set_pipeline_name("pipeline");
+  pass->set_start_timestamp_usec(1000);
+  pass->set_end_timestamp_usec(1000 + time_usec);
+  pass->set_module_changed(changed);
+  pass->set_instruction_count_before(instructions_before);
+  pass->set_instruction_count_after(instructions_after);
+}
+
+TEST(ComparePassMetadataTest, SummarizesRunsOfEachPass) {
+  HloModuleMetadataProto metadata;
+  AddPass(metadata, "dce", 100, true, 10, 8);
+  AddPass(metadata, "cse", 300, false, 8, 8);
+  AddPass(metadata, "dce", 50, false, 8, 8);
+  metadata.mutable_pass_metadata(2)->set_peak_rss_increase_bytes(4096);
+
+  PassMetadataSummaries summaries = SummarizePassMetadata(metadata);
+  ASSERT_EQ(summaries.size(), 2);
+  const PassMetadataSummary& dce = summaries.at("pipeline/dce");
+  EXPECT_EQ(dce.runs, 2);
+  EXPECT_EQ(dce.changed_runs, 1);
+  EXPECT_EQ(dce.total_time_usec, 150);
+  EXPECT_EQ(dce.instruction_count_delta, -2);
+  EXPECT_EQ(dce.max_peak_rss_increase_bytes, 4096);
+  EXPECT_EQ(summaries.at("pipeline/cse").total_time_usec, 300);
+}
+
+TEST(ComparePassMetadataTest, SortsByTimeDelta) {
+  HloModuleMetadataProto baseline, test;
+  AddPass(baseline, "dce", 100, true, 10, 8);
+  AddPass(baseline, "cse", 300, false, 8, 8);
+  AddPass(test, "dce", 150, true, 10, 8);
+  AddPass(test, "cse", 100, false, 8, 8);
+  AddPass(test, "fusion", 10, true, 8, 4);
+
+  std::string comparison = ComparePassMetadata(SummarizePassMetadata(baseline),
+                                               SummarizePassMetadata(test));
+  size_t cse = comparison.find("pipeline/cse");
+  size_t dce = comparison.find("pipeline/dce");
+  size_t fusion = comparison.find("pipeline/fusion");
+  ASSERT_NE(cse, std::string::npos);
+  ASSERT_NE(dce, std::string::npos);
+  ASSERT_NE(fusion, std::string::npos);
+  EXPECT_LT(cse, dce);
+  EXPECT_LT(dce, fusion);
+
+  EXPECT_THAT(ComparePassMetadata(SummarizePassMetadata(baseline),
+                                  SummarizePassMetadata(test),
+                                  /*min_time_delta_usec=*/100),
+              Not(HasSubstr("pipeline/dce")));
+}
+
+}  // namespace
+}  // namespace xla
@@ -0,0 +1,220 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/tools/fusion_roofline_report.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "absl/algorithm/container.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/service/hlo_cost_analysis.h"
+#include "xla/tools/hlo_module_loader.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/errors.h"
+#include "xla/tsl/platform/statusor.h"
+#include "tsl/profiler/protobuf/xplane.pb.h"
+
+namespace xla {
+
+namespace {
+
+constexpr absl::string_view kHloOpStatName = "hlo_op";
+
+// Returns the name of the HLO op of `event`, if it has one.
+std::optional<absl::string_view> GetHloOpName(
+    const tensorflow::profiler::XPlane& plane,
+    const tensorflow::profiler::XEvent& event, int64_t hlo_op_stat_id) {
+  for (const tensorflow::profiler::XStat& stat : event.stats()) {
+    if (stat.metadata_id() != hlo_op_stat_id) {
+      continue;
+    }
+    if (stat.has_str_value()) {
+      return stat.str_value();
+    }
+    // String stats that repeat are stored as references to stat metadata.
+    if (stat.has_ref_value()) {
+      auto it = plane.stat_metadata().find(stat.ref_value());
+      if (it != plane.stat_metadata().end()) {
+        return it->second.name();
+      }
+    }
+  }
+  return std::nullopt;
+}
+
+}  // namespace
+
+absl::string_view RooflineBoundName(RooflineBound bound) {
+  switch (bound) {
+    case RooflineBound::kCompute:
+      return "compute";
+    case RooflineBound::kMemory:
+      return "memory";
+    case RooflineBound::kLatency:
+      return "latency";
+  }
+}
+
+absl::StatusOr<absl::flat_hash_map<std::string, HloOpTime>> GetHloOpTimes(
+    const tensorflow::profiler::XSpace& xspace,
+    absl::string_view device_plane_name) {
+  for (const tensorflow::profiler::XPlane& plane : xspace.planes()) {
+    if (plane.name() != device_plane_name) {
+      continue;
+    }
+    int64_t hlo_op_stat_id = -1;
+    for (const auto& [id, stat_metadata] : plane.stat_metadata()) {
+      if (stat_metadata.name() == kHloOpStatName) {
+        hlo_op_stat_id = id;
+        break;
+      }
+    }
+    absl::flat_hash_map<std::string, HloOpTime> op_times;
+    if (hlo_op_stat_id < 0) {
+      return op_times;
+    }
+    for (const tensorflow::profiler::XLine& line : plane.lines()) {
+      for (const tensorflow::profiler::XEvent& event : line.events()) {
+        std::optional<absl::string_view> op_name =
+            GetHloOpName(plane, event, hlo_op_stat_id);
+        if (!op_name.has_value()) {
+          continue;
+        }
+        HloOpTime& op_time = op_times[*op_name];
+        op_time.total_time_ps += event.duration_ps();
+        ++op_time.occurrences;
+      }
+    }
+    return op_times;
+  }
+  return absl::NotFoundError(
+      absl::StrCat("No plane named ", device_plane_name, " in the XSpace."));
+}
+
+absl::StatusOr<std::vector<HloOpRoofline>> ComputeHloOpRooflines(
+    const HloModule& module, const HloCostAnalysis& cost_analysis,
+    const absl::flat_hash_map<std::string, HloOpTime>& op_times,
+    const RooflineOptions& options) {
+  if (options.peak_flops_per_second <= 0 ||
+      options.peak_bytes_per_second <= 0) {
+    return absl::InvalidArgumentError(
+        "The compute and memory peaks must be positive.");
+  }
+  std::vector<HloOpRoofline> rooflines;
+  for (const HloComputation* computation :
+       module.MakeNonfusionComputations()) {
+    for (const HloInstruction* instr : computation->instructions()) {
+      auto it = op_times.find(instr->name());
+      if (it == op_times.end() || it->second.occurrences == 0) {
+        continue;
+      }
+      HloOpRoofline& roofline = rooflines.emplace_back();
+      roofline.name = instr->name();
+      roofline.occurrences = it->second.occurrences;
+      roofline.measured_time_us =
+          static_cast<double>(it->second.total_time_ps) / 1e6 /
+          it->second.occurrences;
+      roofline.flops = cost_analysis.flop_count(*instr);
+      roofline.bytes_accessed = cost_analysis.bytes_accessed(*instr);
+      roofline.compute_time_us =
+          roofline.flops / options.peak_flops_per_second * 1e6;
+      roofline.memory_time_us =
+          roofline.bytes_accessed / options.peak_bytes_per_second * 1e6;
+
+      const double roofline_time_us =
+          std::max(roofline.compute_time_us, roofline.memory_time_us);
+      if (roofline_time_us <
+          options.latency_bound_fraction * roofline.measured_time_us) {
+        roofline.bound = RooflineBound::kLatency;
+      } else if (roofline.compute_time_us >= roofline.memory_time_us) {
+        roofline.bound = RooflineBound::kCompute;
+      } else {
+        roofline.bound = RooflineBound::kMemory;
+      }
+      roofline.total_headroom_us =
+          std::max(0.0, roofline.measured_time_us - roofline_time_us) *
+          roofline.occurrences;
+    }
+  }
+  absl::c_stable_sort(rooflines, [](const HloOpRoofline& a,
+                                    const HloOpRoofline& b) {
+    return a.total_headroom_us > b.total_headroom_us;
+  });
+  return rooflines;
+}
+
+std::string FormatRooflineReport(absl::Span<const HloOpRoofline> rooflines) {
+  std::string report = absl::StrFormat(
+      "%-40s %8s %12s %14s %14s %12s %12s %8s %14s\n", "HLO op", "count",
+      "time (us)", "flops", "bytes", "compute (us)", "memory (us)", "bound",
+      "headroom (us)");
+  for (const HloOpRoofline& roofline : rooflines) {
+    absl::StrAppendFormat(
+        &report, "%-40s %8d %12.2f %14d %14d %12.2f %12.2f %8s %14.2f\n",
+        roofline.name, roofline.occurrences, roofline.measured_time_us,
+        roofline.flops, roofline.bytes_accessed, roofline.compute_time_us,
+        roofline.memory_time_us, RooflineBoundName(roofline.bound),
+        roofline.total_headroom_us);
+  }
+  return report;
+}
+
+absl::Status RunFusionRooflineReport(absl::string_view xspace_file,
+                                     absl::string_view hlo_file,
+                                     absl::string_view hlo_format,
+                                     absl::string_view device_plane_name,
+                                     const RooflineOptions& options) {
+  if (xspace_file.empty() || hlo_file.empty()) {
+    return absl::InvalidArgumentError(
+        "Both the XSpace and the HLO files must be specified.");
+  }
+  tensorflow::profiler::XSpace xspace;
+  TF_RETURN_IF_ERROR(tsl::ReadBinaryProto(tsl::Env::Default(),
+                                          std::string(xspace_file), &xspace));
+  TF_ASSIGN_OR_RETURN(
+      std::unique_ptr<HloModule> module,
+      LoadModuleFromFile(std::string(hlo_file), std::string(hlo_format)));
+
+  HloCostAnalysis cost_analysis;
+  for (HloComputation* computation : module->MakeNonfusionComputations()) {
+    TF_RETURN_IF_ERROR(computation->Accept(&cost_analysis));
+  }
+
+  TF_ASSIGN_OR_RETURN(auto op_times, GetHloOpTimes(xspace, device_plane_name));
+  LOG(INFO) << "Found the device time of " << op_times.size() << " HLO ops.";
+  TF_ASSIGN_OR_RETURN(
+      std::vector<HloOpRoofline> rooflines,
+      ComputeHloOpRooflines(*module, cost_analysis, op_times, options));
+  std::cout << FormatRooflineReport(rooflines);
+  return absl::OkStatus();
+}
+
+}  // namespace xla
@@ -0,0 +1,106 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_TOOLS_FUSION_ROOFLINE_REPORT_H_
+#define XLA_TOOLS_FUSION_ROOFLINE_REPORT_H_
+
+// A library for joining the kernel times of an XSpace with the cost analysis
+// of its HLO module, to tell which fusions are far from the roofline.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/service/hlo_cost_analysis.h"
+#include "tsl/profiler/protobuf/xplane.pb.h"
+
+namespace xla {
+
+// The device time of an HLO op, summed over all its executions.
+struct HloOpTime {
+  int64_t total_time_ps = 0;
+  int64_t occurrences = 0;
+};
+
+// What bounds the execution time of a kernel.
+enum class RooflineBound {
+  kCompute,
+  kMemory,
+  // The kernel reaches only a small fraction of both the compute and the
+  // memory peaks, e.g. because it is too small to hide the launch latency.
+  kLatency,
+};
+
+absl::string_view RooflineBoundName(RooflineBound bound);
+
+struct RooflineOptions {
+  double peak_flops_per_second = 0.0;
+  double peak_bytes_per_second = 0.0;
+  // A kernel whose roofline time is less than this fraction of its measured
+  // time is latency bound.
+  double latency_bound_fraction = 0.1;
+};
+
+// The roofline analysis of the kernels of one HLO op, usually a fusion.
+struct HloOpRoofline {
+  std::string name;
+  int64_t occurrences = 0;
+  // Per execution of the op.
+  double measured_time_us = 0.0;
+  int64_t flops = 0;
+  int64_t bytes_accessed = 0;
+  // The times the op would take at the compute and memory peaks.
+  double compute_time_us = 0.0;
+  double memory_time_us = 0.0;
+  RooflineBound bound = RooflineBound::kLatency;
+  // The time that would be saved over all executions if the op ran at its
+  // roofline time.
+  double total_headroom_us = 0.0;
+};
+
+// Sums the time of the events of the `device_plane_name` plane of `xspace` per
+// HLO op, as given by the "hlo_op" stat of the events.
+absl::StatusOr<absl::flat_hash_map<std::string, HloOpTime>> GetHloOpTimes(
+    const tensorflow::profiler::XSpace& xspace,
+    absl::string_view device_plane_name);
+
+// Returns the roofline analysis of the HLO ops of `module` that have a time in
+// `op_times`, sorted by decreasing total headroom. `cost_analysis` must have
+// visited all the non-fusion computations of `module`.
+absl::StatusOr<std::vector<HloOpRoofline>> ComputeHloOpRooflines(
+    const HloModule& module, const HloCostAnalysis& cost_analysis,
+    const absl::flat_hash_map<std::string, HloOpTime>& op_times,
+    const RooflineOptions& options);
+
+// Formats `rooflines` as a table, one op per line.
+std::string FormatRooflineReport(absl::Span<const HloOpRoofline> rooflines);
+
+// Reads an XSpace protobuf and an HLO module from files, and prints the
+// roofline report of the ops of the module to stdout.
+absl::Status RunFusionRooflineReport(absl::string_view xspace_file,
+                                     absl::string_view hlo_file,
+                                     absl::string_view hlo_format,
+                                     absl::string_view device_plane_name,
+                                     const RooflineOptions& options);
+
+}  // namespace xla
+
+#endif  // XLA_TOOLS_FUSION_ROOFLINE_REPORT_H_
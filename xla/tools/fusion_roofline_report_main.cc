@@ -0,0 +1,84 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// A tool for ranking the fusions of an HLO module by how far their measured
+// kernel times are from the roofline.
+
+#include <string>
+#include <vector>
+
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "xla/tools/fusion_roofline_report.h"
+#include "xla/tsl/util/command_line_flags.h"
+#include "tsl/platform/init_main.h"
+
+namespace {
+
+const char* const kUsage = R"(
+    This tool joins the kernel times of an XSpace protobuf with the cost
+    analysis of the HLO module they were measured on. For each HLO op with
+    device time, usually a fusion, it prints its flops and bytes accessed, the
+    times it would take at the compute and memory peaks, whether it is compute,
+    memory or latency bound, and the time that would be saved if it ran at its
+    roofline time. Ops are ranked by that time.
+
+    Usage:
+
+      bazel run fusion_roofline_report_main -- --xspace=path/to/xspace.pb \
+        --hlo=path/to/module.hlo --peak_tflops=989 --peak_gbps=3350
+    )";
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::string xspace, hlo, format = "hlo", device_plane = "/device:GPU:0";
+  float peak_tflops = 0.0;
+  float peak_gbps = 0.0;
+  float latency_bound_fraction = 0.1;
+  std::vector<tsl::Flag> flag_list = {
+      tsl::Flag("xspace", &xspace, "XSpace protobuf with the kernel times"),
+      tsl::Flag("hlo", &hlo, "HLO module the kernel times were measured on"),
+      tsl::Flag("format", &format, "Format of the HLO module: hlo|pb|pbtxt"),
+      tsl::Flag("device_plane", &device_plane,
+                "Name of the XSpace plane of the device"),
+      tsl::Flag("peak_tflops", &peak_tflops,
+                "Peak compute throughput of the device in TFLOP/s"),
+      tsl::Flag("peak_gbps", &peak_gbps,
+                "Peak memory bandwidth of the device in GB/s"),
+      tsl::Flag("latency_bound_fraction", &latency_bound_fraction,
+                "Ops whose roofline time is less than this fraction of their "
+                "measured time are latency bound")};
+  const std::string kUsageString =
+      absl::StrCat(kUsage, "\n\n", tsl::Flags::Usage(argv[0], flag_list));
+  bool parse_ok = tsl::Flags::Parse(&argc, argv, flag_list);
+  tsl::port::InitMain(kUsageString.c_str(), &argc, &argv);
+  if (!parse_ok) {
+    LOG(QFATAL) << kUsageString;
+  }
+
+  xla::RooflineOptions options;
+  options.peak_flops_per_second = peak_tflops * 1e12;
+  options.peak_bytes_per_second = peak_gbps * 1e9;
+  options.latency_bound_fraction = latency_bound_fraction;
+  absl::Status status = xla::RunFusionRooflineReport(xspace, hlo, format,
+                                                     device_plane, options);
+  if (!status.ok()) {
+    LOG(ERROR) << status;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,164 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/tools/fusion_roofline_report.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/container/flat_hash_map.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/parser/hlo_parser.h"
+#include "xla/service/hlo_cost_analysis.h"
+#include "xla/tsl/lib/core/status_test_util.h"
+#include "xla/tsl/platform/statusor.h"
+#include "tsl/profiler/protobuf/xplane.pb.h"
+
+namespace xla {
+namespace {
+
+using ::testing::AllOf;
+using ::testing::Field;
+using ::testing::Pair;
+using ::testing::UnorderedElementsAre;
+
+void AddEvent(tensorflow::profiler::XLine* line, int64_t duration_ps,
+              int64_t stat_id, const std::string& hlo_op) {
+  tensorflow::profiler::XEvent* event = line->add_events();
+  event->set_duration_ps(duration_ps);
+  tensorflow::profiler::XStat* stat = event->add_stats();
+  stat->set_metadata_id(stat_id);
+  stat->set_str_value(hlo_op);
+}
+
+TEST(FusionRooflineReportTest, GetHloOpTimes) {
+  tensorflow::profiler::XSpace xspace;
+  tensorflow::profiler::XPlane* plane = xspace.add_planes();
+  plane->set_name("/device:GPU:0");
+  (*plane->mutable_stat_metadata())[1].set_id(1);
+  (*plane->mutable_stat_metadata())[1].set_name("hlo_op");
+  (*plane->mutable_stat_metadata())[2].set_id(2);
+  (*plane->mutable_stat_metadata())[2].set_name("fusion.2");
+  tensorflow::profiler::XLine* line = plane->add_lines();
+  AddEvent(line, 1000, /*stat_id=*/1, "fusion.1");
+  AddEvent(line, 3000, /*stat_id=*/1, "fusion.1");
+  // Repeated HLO op names may be stored as references to stat metadata.
+  tensorflow::profiler::XEvent* ref_event = line->add_events();
+  ref_event->set_duration_ps(5000);
+  tensorflow::profiler::XStat* ref_stat = ref_event->add_stats();
+  ref_stat->set_metadata_id(1);
+  ref_stat->set_ref_value(2);
+  // Events without an HLO op, e.g. memcpys, are ignored.
+  line->add_events()->set_duration_ps(7000);
+
+  TF_ASSERT_OK_AND_ASSIGN(auto op_times,
+                          GetHloOpTimes(xspace, "/device:GPU:0"));
+  EXPECT_THAT(
+      op_times,
+      UnorderedElementsAre(
+          Pair("fusion.1", AllOf(Field(&HloOpTime::total_time_ps, 4000),
+                                 Field(&HloOpTime::occurrences, 2))),
+          Pair("fusion.2", AllOf(Field(&HloOpTime::total_time_ps, 5000),
+                                 Field(&HloOpTime::occurrences, 1)))));
+  EXPECT_FALSE(GetHloOpTimes(xspace, "/device:GPU:1").ok());
+}
+
+TEST(FusionRooflineReportTest, ClassifiesAndRanksFusions) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnUnverifiedModule(R"(
+HloModule ClassifiesAndRanksFusions
+
+fused_small_add {
+  p0 = f32[1024] parameter(0)
+  ROOT add = f32[1024] add(p0, p0)
+}
+
+fused_large_add {
+  p0 = f32[262144] parameter(0)
+  ROOT add = f32[262144] add(p0, p0)
+}
+
+fused_dot {
+  p0 = f32[256,256] parameter(0)
+  ROOT dot = f32[256,256] dot(p0, p0), lhs_contracting_dims={1}, rhs_contracting_dims={0}
+}
+
+ENTRY entry {
+  small = f32[1024] parameter(0)
+  large = f32[262144] parameter(1)
+  matrix = f32[256,256] parameter(2)
+  small_add = f32[1024] fusion(small), kind=kLoop, calls=fused_small_add
+  large_add = f32[262144] fusion(large), kind=kLoop, calls=fused_large_add
+  dot = f32[256,256] fusion(matrix), kind=kOutput, calls=fused_dot
+  ROOT tuple = (f32[1024], f32[262144], f32[256,256]) tuple(small_add, large_add, dot)
+})"));
+  HloCostAnalysis cost_analysis;
+  for (HloComputation* computation : module->MakeNonfusionComputations()) {
+    TF_ASSERT_OK(computation->Accept(&cost_analysis));
+  }
+
+  // A 1 TFLOP/s and 100 GB/s device.
+  RooflineOptions options;
+  options.peak_flops_per_second = 1e12;
+  options.peak_bytes_per_second = 1e11;
+  absl::flat_hash_map<std::string, HloOpTime> op_times = {
+      // ~0.08us at the memory peak.
+      {"small_add", {/*total_time_ps=*/20'000'000, /*occurrences=*/2}},
+      // ~21us at the memory peak.
+      {"large_add", {/*total_time_ps=*/30'000'000, /*occurrences=*/1}},
+      // ~33.5us at the compute peak.
+      {"dot", {/*total_time_ps=*/50'000'000, /*occurrences=*/1}},
+  };
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::vector<HloOpRoofline> rooflines,
+      ComputeHloOpRooflines(*module, cost_analysis, op_times, options));
+
+  ASSERT_EQ(rooflines.size(), 3);
+  EXPECT_EQ(rooflines[0].name, "small_add");
+  EXPECT_EQ(rooflines[0].bound, RooflineBound::kLatency);
+  EXPECT_EQ(rooflines[0].measured_time_us, 10.0);
+  EXPECT_EQ(rooflines[1].name, "dot");
+  EXPECT_EQ(rooflines[1].bound, RooflineBound::kCompute);
+  EXPECT_EQ(rooflines[1].flops, 2 * 256 * 256 * 256);
+  EXPECT_EQ(rooflines[2].name, "large_add");
+  EXPECT_EQ(rooflines[2].bound, RooflineBound::kMemory);
+  EXPECT_GT(rooflines[0].total_headroom_us, rooflines[1].total_headroom_us);
+  EXPECT_GT(rooflines[1].total_headroom_us, rooflines[2].total_headroom_us);
+  EXPECT_GT(rooflines[2].total_headroom_us, 0.0);
+
+  EXPECT_THAT(FormatRooflineReport(rooflines),
+              ::testing::HasSubstr("latency"));
+}
+
+TEST(FusionRooflineReportTest, RejectsMissingPeaks) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnUnverifiedModule(R"(
+HloModule RejectsMissingPeaks
+
+ENTRY entry {
+  ROOT p0 = f32[16] parameter(0)
+})"));
+  HloCostAnalysis cost_analysis;
+  EXPECT_FALSE(
+      ComputeHloOpRooflines(*module, cost_analysis, {}, RooflineOptions())
+          .ok());
+}
+
+}  // namespace
+}  // namespace xla
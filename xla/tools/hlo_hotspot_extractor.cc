@@ -0,0 +1,141 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/tools/hlo_hotspot_extractor.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/algorithm/container.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/tools/fusion_roofline_report.h"
+#include "xla/tools/hlo_extractor.h"
+#include "xla/tools/hlo_module_loader.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/errors.h"
+#include "xla/tsl/platform/statusor.h"
+#include "tsl/platform/path.h"
+#include "tsl/profiler/protobuf/xplane.pb.h"
+
+namespace xla {
+
+absl::StatusOr<std::vector<HloHotSpot>> ExtractHloHotSpots(
+    const HloModule& module,
+    const absl::flat_hash_map<std::string, HloOpTime>& op_times, int64_t top_n,
+    int64_t height) {
+  if (top_n <= 0) {
+    return absl::InvalidArgumentError(
+        "The number of hot spots must be positive.");
+  }
+  std::vector<std::pair<const HloInstruction*, HloOpTime>> timed_ops;
+  for (const HloComputation* computation :
+       module.MakeNonfusionComputations()) {
+    for (const HloInstruction* instr : computation->instructions()) {
+      auto it = op_times.find(instr->name());
+      if (it != op_times.end() && it->second.total_time_ps > 0) {
+        timed_ops.push_back({instr, it->second});
+      }
+    }
+  }
+  absl::c_stable_sort(timed_ops, [](const auto& a, const auto& b) {
+    return a.second.total_time_ps > b.second.total_time_ps;
+  });
+  if (timed_ops.size() > static_cast<size_t>(top_n)) {
+    timed_ops.resize(top_n);
+  }
+
+  std::vector<HloHotSpot> hot_spots;
+  for (const auto& [instr, time] : timed_ops) {
+    VLOG(1) << "Extracting " << instr->name() << " from "
+            << instr->parent()->name();
+    HloHotSpot& hot_spot = hot_spots.emplace_back();
+    hot_spot.name = instr->name();
+    hot_spot.time = time;
+    hot_spot.module = ExtractModule(instr, height);
+    hot_spot.module->set_name(absl::StrCat(module.name(), "_", instr->name()));
+  }
+  return hot_spots;
+}
+
+std::string FormatHloHotSpots(absl::Span<const HloHotSpot> hot_spots,
+                              absl::Span<const std::string> file_names) {
+  std::string table = absl::StrFormat("%4s %-40s %8s %14s %14s  %s\n", "rank",
+                                      "HLO op", "count", "total (us)",
+                                      "per run (us)", "file");
+  for (int64_t i = 0; i < hot_spots.size(); ++i) {
+    const HloHotSpot& hot_spot = hot_spots[i];
+    const double total_time_us =
+        static_cast<double>(hot_spot.time.total_time_ps) / 1e6;
+    absl::StrAppendFormat(
+        &table, "%4d %-40s %8d %14.2f %14.2f  %s\n", i + 1, hot_spot.name,
+        hot_spot.time.occurrences, total_time_us,
+        total_time_us / std::max<int64_t>(hot_spot.time.occurrences, 1),
+        i < file_names.size() ? file_names[i] : "");
+  }
+  return table;
+}
+
+absl::Status RunHloHotSpotExtractor(absl::string_view xspace_file,
+                                    absl::string_view hlo_file,
+                                    absl::string_view hlo_format,
+                                    absl::string_view device_plane_name,
+                                    int64_t top_n, int64_t height,
+                                    absl::string_view output_dir) {
+  if (xspace_file.empty() || hlo_file.empty() || output_dir.empty()) {
+    return absl::InvalidArgumentError(
+        "The XSpace and the HLO files and the output directory must be "
+        "specified.");
+  }
+  tensorflow::profiler::XSpace xspace;
+  TF_RETURN_IF_ERROR(tsl::ReadBinaryProto(tsl::Env::Default(),
+                                          std::string(xspace_file), &xspace));
+  TF_ASSIGN_OR_RETURN(
+      std::unique_ptr<HloModule> module,
+      LoadModuleFromFile(std::string(hlo_file), std::string(hlo_format)));
+  TF_ASSIGN_OR_RETURN(auto op_times, GetHloOpTimes(xspace, device_plane_name));
+  TF_ASSIGN_OR_RETURN(std::vector<HloHotSpot> hot_spots,
+                      ExtractHloHotSpots(*module, op_times, top_n, height));
+
+  TF_RETURN_IF_ERROR(
+      tsl::Env::Default()->RecursivelyCreateDir(std::string(output_dir)));
+  std::vector<std::string> file_names;
+  for (int64_t i = 0; i < hot_spots.size(); ++i) {
+    std::string file_name = tsl::io::JoinPath(
+        output_dir, absl::StrFormat("%03d_%s.hlo", i + 1, hot_spots[i].name));
+    TF_RETURN_IF_ERROR(tsl::WriteStringToFile(
+        tsl::Env::Default(), file_name, hot_spots[i].module->ToString()));
+    file_names.push_back(std::move(file_name));
+  }
+  std::cout << FormatHloHotSpots(hot_spots, file_names);
+  return absl::OkStatus();
+}
+
+}  // namespace xla
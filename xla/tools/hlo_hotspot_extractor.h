@@ -0,0 +1,71 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_TOOLS_HLO_HOTSPOT_EXTRACTOR_H_
+#define XLA_TOOLS_HLO_HOTSPOT_EXTRACTOR_H_
+
+// A library for extracting the HLO ops with the most device time in a profile
+// into standalone modules, to reproduce performance issues in isolation.
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/tools/fusion_roofline_report.h"
+
+namespace xla {
+
+// An HLO op with device time, extracted into its own module.
+struct HloHotSpot {
+  std::string name;
+  HloOpTime time;
+  std::unique_ptr<HloModule> module;
+};
+
+// Extracts the `top_n` HLO ops of `module` with the largest total time in
+// `op_times`, in decreasing order of that time. Each op is extracted with the
+// ops up to `height` hops above it, see ExtractModule, and the operands at the
+// boundary become parameters of the extracted module. Runners such as
+// run_hlo_module generate fake data for these parameters.
+absl::StatusOr<std::vector<HloHotSpot>> ExtractHloHotSpots(
+    const HloModule& module,
+    const absl::flat_hash_map<std::string, HloOpTime>& op_times, int64_t top_n,
+    int64_t height = 0);
+
+// Formats `hot_spots` as a table, one op per line. `file_names` holds the file
+// each hot spot was written to, or is empty.
+std::string FormatHloHotSpots(absl::Span<const HloHotSpot> hot_spots,
+                              absl::Span<const std::string> file_names);
+
+// Reads an XSpace protobuf and an HLO module from files, and writes the
+// `top_n` hot spots of the module as HLO text to `output_dir`, one file per
+// hot spot named after its rank and op.
+absl::Status RunHloHotSpotExtractor(absl::string_view xspace_file,
+                                    absl::string_view hlo_file,
+                                    absl::string_view hlo_format,
+                                    absl::string_view device_plane_name,
+                                    int64_t top_n, int64_t height,
+                                    absl::string_view output_dir);
+
+}  // namespace xla
+
+#endif  // XLA_TOOLS_HLO_HOTSPOT_EXTRACTOR_H_
@@ -0,0 +1,79 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// A tool for extracting the HLO ops with the most device time in a profile
+// into standalone HLO modules.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "xla/tools/hlo_hotspot_extractor.h"
+#include "xla/tsl/util/command_line_flags.h"
+#include "tsl/platform/init_main.h"
+
+namespace {
+
+const char* const kUsage = R"(
+    This tool joins the kernel times of an XSpace protobuf with the HLO module
+    they were measured on, and writes the HLO ops with the most device time,
+    usually fusions, to standalone HLO modules. The operands of each op become
+    parameters of its module, so that it can be run and timed on its own, e.g.
+    with run_hlo_module or a benchmark runner, to reproduce performance issues.
+
+    Usage:
+
+      bazel run hlo_hotspot_extractor_main -- --xspace=path/to/xspace.pb \
+        --hlo=path/to/module.hlo --top_n=10 --output_dir=/tmp/hotspots
+    )";
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::string xspace, hlo, format = "hlo", device_plane = "/device:GPU:0";
+  std::string output_dir;
+  int64_t top_n = 10;
+  int64_t height = 0;
+  std::vector<tsl::Flag> flag_list = {
+      tsl::Flag("xspace", &xspace, "XSpace protobuf with the kernel times"),
+      tsl::Flag("hlo", &hlo, "HLO module the kernel times were measured on"),
+      tsl::Flag("format", &format, "Format of the HLO module: hlo|pb|pbtxt"),
+      tsl::Flag("device_plane", &device_plane,
+                "Name of the XSpace plane of the device"),
+      tsl::Flag("top_n", &top_n, "Number of HLO ops to extract"),
+      tsl::Flag("height", &height,
+                "Number of levels of operands to extract with each op. The "
+                "default of 0 extracts only the op itself"),
+      tsl::Flag("output_dir", &output_dir,
+                "Directory to which the extracted modules are written")};
+  const std::string kUsageString =
+      absl::StrCat(kUsage, "\n\n", tsl::Flags::Usage(argv[0], flag_list));
+  bool parse_ok = tsl::Flags::Parse(&argc, argv, flag_list);
+  tsl::port::InitMain(kUsageString.c_str(), &argc, &argv);
+  if (!parse_ok) {
+    LOG(QFATAL) << kUsageString;
+  }
+
+  absl::Status status = xla::RunHloHotSpotExtractor(
+      xspace, hlo, format, device_plane, top_n, height, output_dir);
+  if (!status.ok()) {
+    LOG(ERROR) << status;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,86 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/tools/hlo_hotspot_extractor.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/container/flat_hash_map.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/hlo/parser/hlo_parser.h"
+#include "xla/tools/fusion_roofline_report.h"
+#include "xla/tsl/platform/statusor.h"
+
+namespace xla {
+namespace {
+
+TEST(HloHotSpotExtractorTest, ExtractsTheSlowestOps) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnUnverifiedModule(R"(
+HloModule ExtractsTheSlowestOps
+
+fused_add {
+  p0 = f32[1024] parameter(0)
+  ROOT add = f32[1024] add(p0, p0)
+}
+
+fused_multiply {
+  p0 = f32[1024] parameter(0)
+  p1 = f32[1024] parameter(1)
+  ROOT multiply = f32[1024] multiply(p0, p1)
+}
+
+ENTRY entry {
+  x = f32[1024] parameter(0)
+  y = f32[1024] parameter(1)
+  add = f32[1024] fusion(x), kind=kLoop, calls=fused_add
+  multiply = f32[1024] fusion(add, y), kind=kLoop, calls=fused_multiply
+  ROOT negate = f32[1024] negate(multiply)
+})"));
+  absl::flat_hash_map<std::string, HloOpTime> op_times = {
+      {"add", {/*total_time_ps=*/1000, /*occurrences=*/1}},
+      {"multiply", {/*total_time_ps=*/5000, /*occurrences=*/2}},
+      {"negate", {/*total_time_ps=*/3000, /*occurrences=*/1}},
+      // Ops that are not in the module are ignored.
+      {"copy", {/*total_time_ps=*/9000, /*occurrences=*/1}},
+  };
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::vector<HloHotSpot> hot_spots,
+      ExtractHloHotSpots(*module, op_times, /*top_n=*/2));
+
+  ASSERT_EQ(hot_spots.size(), 2);
+  EXPECT_EQ(hot_spots[0].name, "multiply");
+  EXPECT_EQ(hot_spots[0].time.occurrences, 2);
+  const HloInstruction* root =
+      hot_spots[0].module->entry_computation()->root_instruction();
+  EXPECT_EQ(root->opcode(), HloOpcode::kFusion);
+  EXPECT_EQ(root->operand(0)->opcode(), HloOpcode::kParameter);
+  EXPECT_EQ(hot_spots[0].module->entry_computation()->num_parameters(), 2);
+  EXPECT_EQ(hot_spots[1].name, "negate");
+
+  EXPECT_THAT(FormatHloHotSpots(hot_spots, {"001_multiply.hlo"}),
+              ::testing::HasSubstr("001_multiply.hlo"));
+  EXPECT_FALSE(ExtractHloHotSpots(*module, op_times, /*top_n=*/0).ok());
+}
+
+}  // namespace
+}  // namespace xla
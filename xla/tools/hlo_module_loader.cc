@@ -19,14 +19,14 @@ limitations under the License.
 
 #include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
-#include <vector>
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/ascii.h"
 #include "absl/strings/str_cat.h"
-#include "absl/strings/str_join.h"
 #include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
 #include "re2/re2.h"
@@ -56,24 +56,73 @@ absl::Status OverrideConfig(const hlo_module_loader_details::Config& ovr_config,
   return absl::OkStatus();
 }
 
-}  // namespace
-
-std::string StripLogHeaders(absl::string_view hlo_string) {
+// If `line` starts with a log header, returns the rest of the line.
+std::optional<absl::string_view> StripLogHeader(absl::string_view line) {
   // I0521 12:04:45.883483    1509 service.cc:186] ...
   static RE2* matcher = new RE2(
       "[IWEF]\\d{4} "
       "\\d{2}:\\d{2}:\\d{2}\\.\\d+\\s+\\d+\\s+[^:]+:\\d+\\]\\s?(.*)");
-  absl::string_view matches[4];
-  std::vector<std::string> lines = absl::StrSplit(hlo_string, '\n');
-  for (auto& line : lines) {
-    if (matcher->Match(line, 0, line.size(), RE2::ANCHOR_START, matches, 4)) {
-      line = std::string(matches[1]);
+  // Most lines of a dump have no header, and are rejected without running the
+  // regular expression.
+  constexpr absl::string_view kSeverities = "IWEF";
+  if (line.size() < 2 ||
+      kSeverities.find(line[0]) == absl::string_view::npos ||
+      !absl::ascii_isdigit(line[1])) {
+    return std::nullopt;
+  }
+  absl::string_view matches[2];
+  if (!matcher->Match(line, 0, line.size(), RE2::ANCHOR_START, matches, 2)) {
+    return std::nullopt;
+  }
+  return matches[1];
+}
+
+bool HasLogHeaders(absl::string_view hlo_string) {
+  for (absl::string_view line : absl::StrSplit(hlo_string, '\n')) {
+    if (StripLogHeader(line).has_value()) {
+      return true;
     }
   }
-  return absl::StrJoin(lines, "\n",
-                       [](std::string* out, const std::string& line) {
-                         absl::StrAppend(out, line);
-                       });
+  return false;
+}
+
+absl::StatusOr<std::unique_ptr<HloModule>> LoadModuleFromHloText(
+    absl::string_view data,
+    const hlo_module_loader_details::Config& ovr_config,
+    const std::function<void(HloModuleConfig*)>& config_modifier_hook,
+    bool fill_missing_layouts) {
+  // Only copy the text if there are log headers to strip.
+  std::string stripped;
+  absl::string_view hlo_string = data;
+  if (HasLogHeaders(data)) {
+    stripped = StripLogHeaders(data);
+    hlo_string = stripped;
+  }
+  HloModuleConfig config;
+  config.set_debug_options(GetDebugOptionsFromFlags());
+  TF_RETURN_IF_ERROR(OverrideConfig(ovr_config, &config));
+  if (config_modifier_hook) {
+    config_modifier_hook(&config);
+  }
+  HloParserOptions options;
+  options.set_fill_missing_layouts(fill_missing_layouts);
+  return ParseAndReturnUnverifiedModule(hlo_string, config, options);
+}
+
+}  // namespace
+
+std::string StripLogHeaders(absl::string_view hlo_string) {
+  std::string result;
+  result.reserve(hlo_string.size());
+  bool first_line = true;
+  for (absl::string_view line : absl::StrSplit(hlo_string, '\n')) {
+    if (!first_line) {
+      result.push_back('\n');
+    }
+    first_line = false;
+    absl::StrAppend(&result, StripLogHeader(line).value_or(line));
+  }
+  return result;
 }
 
 absl::StatusOr<std::unique_ptr<HloModule>> LoadModuleFromData(
@@ -84,17 +133,9 @@ absl::StatusOr<std::unique_ptr<HloModule>> LoadModuleFromData(
   DebugOptions debug_options = GetDebugOptionsFromFlags();
   std::unique_ptr<HloModule> module;
   if (format == "hlo" || format == "txt") {
-    std::string hlo_string = StripLogHeaders(data);
-    HloModuleConfig config;
-    config.set_debug_options(debug_options);
-    TF_RETURN_IF_ERROR(OverrideConfig(ovr_config, &config));
-    if (config_modifier_hook) {
-      config_modifier_hook(&config);
-    }
-    HloParserOptions options;
-    options.set_fill_missing_layouts(fill_missing_layouts);
     TF_ASSIGN_OR_RETURN(
-        module, ParseAndReturnUnverifiedModule(hlo_string, config, options));
+        module, LoadModuleFromHloText(data, ovr_config, config_modifier_hook,
+                                      fill_missing_layouts));
   } else {
     HloSnapshot proto;
     if (format == "pb") {
@@ -147,6 +188,19 @@ absl::StatusOr<std::unique_ptr<HloModule>> LoadModuleFromFile(
   if (format.empty()) {
     format = std::string(tsl::io::Extension(path));
   }
+  if (format == "hlo" || format == "txt") {
+    // Text dumps can be gigabytes large, so parse them straight from the
+    // memory-mapped file when the file system supports it.
+    std::unique_ptr<tsl::ReadOnlyMemoryRegion> region;
+    if (tsl::Env::Default()
+            ->NewReadOnlyMemoryRegionFromFile(path, &region)
+            .ok()) {
+      return LoadModuleFromHloText(
+          absl::string_view(static_cast<const char*>(region->data()),
+                            region->length()),
+          ovr_config, config_modifier_hook, fill_missing_layouts);
+    }
+  }
   TF_RETURN_IF_ERROR(tsl::ReadFileToString(tsl::Env::Default(), path, &data));
   return LoadModuleFromData(data, format, ovr_config, config_modifier_hook,
                             buffer_assignment_proto, fill_missing_layouts);
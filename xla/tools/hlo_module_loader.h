@@ -71,7 +71,8 @@ absl::StatusOr<std::unique_ptr<HloModule>> LoadModuleFromData(
 //    extension).
 // 2) A hlo text dump, the string should be in HloModule::ToString() format
 //    (with a .hlo or .txt extension). A text file can also contain log headers,
-//    which will be stripped.
+//    which will be stripped. It is parsed from a memory mapping of the file if
+//    the file system supports it, rather than from a copy.
 // If the format is specified (not empty), it overrides the one guessed from the
 // file extension. The ovr_config data can be used to override certain fields of
 // the HloModuleConfig.
@@ -21,6 +21,8 @@ limitations under the License.
 #include <gtest/gtest.h>
 #include "xla/tests/hlo_test_base.h"
 #include "xla/tsl/lib/core/status_test_util.h"
+#include "tsl/platform/env.h"
+#include "tsl/platform/path.h"
 #include "tsl/platform/test.h"
 
 namespace xla {
@@ -48,5 +50,31 @@ I0521 12:04:45.883483    1509 service.cc:186] }
   EXPECT_NE(FindInstruction(hlo_module.get(), "rooty"), nullptr);
 }
 
+TEST_F(HloModuleLoaderTest, StripsOnlyLinesWithLogHeaders) {
+  EXPECT_EQ(StripLogHeaders("I0521 12:04:45.883483    1509 service.cc:186] a\n"
+                            "I0521 b\n"
+                            "\n"
+                            "E0521 12:04:45.883483    1509 service.cc:186]  c"),
+            "a\nI0521 b\n\n c");
+}
+
+TEST_F(HloModuleLoaderTest, LoadsTextFile) {
+  const std::string path =
+      tsl::io::JoinPath(tsl::testing::TmpDir(), "load_text.hlo");
+  TF_ASSERT_OK(tsl::WriteStringToFile(tsl::Env::Default(), path, R"(
+HloModule load_text
+
+ENTRY entry {
+  p0 = f32[4]{0} parameter(0)
+  ROOT neg = f32[4]{0} negate(p0)
+}
+)"));
+
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> hlo_module,
+                          LoadModuleFromFile(path));
+  EXPECT_EQ(hlo_module->name(), "load_text");
+  EXPECT_NE(FindInstruction(hlo_module.get(), "neg"), nullptr);
+}
+
 }  // namespace
 }  // namespace xla
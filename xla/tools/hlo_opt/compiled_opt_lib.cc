@@ -118,6 +118,7 @@ absl::StatusOr<std::unique_ptr<HloModule>> CompiledOptProvider::GetOptimizedHlo(
   input_module->mutable_config().set_debug_options(d);
 
   if (input_module->has_schedule()) {
+    RecordPassMetadata(*input_module);
     return input_module;
   }
 
@@ -126,6 +127,7 @@ absl::StatusOr<std::unique_ptr<HloModule>> CompiledOptProvider::GetOptimizedHlo(
       std::unique_ptr<HloModule> optimized_module,
       compiler->RunHloPasses(std::move(input_module), executor, opts));
 
+  RecordPassMetadata(*optimized_module);
   return optimized_module;
 }
 
@@ -139,6 +141,11 @@ absl::StatusOr<std::unique_ptr<Executable>> CompiledOptProvider::GetExecutable(
   TF_ASSIGN_OR_RETURN(
       std::unique_ptr<Executable> executable,
       compiler->RunBackend(std::move(optimized_module), executor, opts));
+  // The module of the executable also went through the passes that
+  // GetOptimizedHlo recorded.
+  if (executable->has_module()) {
+    pass_metadata_.back() = executable->module().metadata().proto();
+  }
   return executable;
 }
 
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "xla/tools/multihost_hlo_runner/functional_hlo_runner.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
@@ -34,9 +35,12 @@ limitations under the License.
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
+#include "absl/strings/str_replace.h"
 #include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
 #include "absl/types/span.h"
 #include "mlir/Dialect/Func/Extensions/AllExtensions.h"
 #include "xla/client/executable_build_options.h"
@@ -503,6 +507,89 @@ absl::Status FunctionalHloRunner::DumpOutput(
   return absl::OkStatus();
 }
 
+namespace {
+
+// Uses the nearest-rank method, so that every percentile is one of the times.
+FunctionalHloRunner::TimeStats ComputeTimeStats(
+    std::vector<absl::Duration> times) {
+  CHECK(!times.empty());
+  absl::c_sort(times);
+  auto percentile = [&times](int64_t p) {
+    int64_t rank = (p * static_cast<int64_t>(times.size()) + 99) / 100;
+    return times[std::max<int64_t>(rank, 1) - 1];
+  };
+  absl::Duration sum;
+  for (absl::Duration time : times) {
+    sum += time;
+  }
+  return FunctionalHloRunner::TimeStats{
+      /*p50=*/percentile(50), /*p90=*/percentile(90),
+      /*p99=*/percentile(99),
+      /*mean=*/sum / static_cast<int64_t>(times.size())};
+}
+
+std::string TimeStatsToJson(const FunctionalHloRunner::TimeStats& stats) {
+  return absl::StrFormat(
+      "{\"p50_us\":%.3f,\"p90_us\":%.3f,\"p99_us\":%.3f,\"mean_us\":%.3f}",
+      absl::ToDoubleMicroseconds(stats.p50),
+      absl::ToDoubleMicroseconds(stats.p90),
+      absl::ToDoubleMicroseconds(stats.p99),
+      absl::ToDoubleMicroseconds(stats.mean));
+}
+
+}  // namespace
+
+absl::StatusOr<FunctionalHloRunner::BenchmarkStats>
+FunctionalHloRunner::ComputeBenchmarkStats(
+    absl::Span<const absl::Duration> wall_times,
+    absl::Span<const ExecutionProfile> execution_profiles,
+    int64_t num_warmup_repeats) {
+  if (num_warmup_repeats < 0 ||
+      num_warmup_repeats >= static_cast<int64_t>(wall_times.size())) {
+    return absl::InvalidArgumentError(absl::StrFormat(
+        "Expected fewer warmup repeats than the %d repeats, got %d.",
+        wall_times.size(), num_warmup_repeats));
+  }
+  if (!execution_profiles.empty() &&
+      execution_profiles.size() != wall_times.size()) {
+    return absl::InvalidArgumentError(absl::StrFormat(
+        "Expected one execution profile per repeat, got %d profiles for %d "
+        "repeats.",
+        execution_profiles.size(), wall_times.size()));
+  }
+  BenchmarkStats stats;
+  stats.num_warmup_repeats = num_warmup_repeats;
+  stats.num_timed_repeats = wall_times.size() - num_warmup_repeats;
+  stats.wall_time = ComputeTimeStats(std::vector<absl::Duration>(
+      wall_times.begin() + num_warmup_repeats, wall_times.end()));
+  if (!execution_profiles.empty()) {
+    std::vector<absl::Duration> device_times;
+    for (const ExecutionProfile& profile :
+         execution_profiles.subspan(num_warmup_repeats)) {
+      device_times.push_back(absl::Nanoseconds(profile.compute_time_ns()));
+    }
+    stats.device_time = ComputeTimeStats(std::move(device_times));
+  }
+  return stats;
+}
+
+std::string FunctionalHloRunner::BenchmarkStatsToJson(
+    const BenchmarkStats& stats, absl::string_view hlo_file, int task_id) {
+  std::string escaped_hlo_file =
+      absl::StrReplaceAll(hlo_file, {{"\\", "\\\\"}, {"\"", "\\\""}});
+  std::string json = absl::StrFormat(
+      "{\"hlo_file\":\"%s\",\"task_id\":%d,\"num_warmup_repeats\":%d,"
+      "\"num_timed_repeats\":%d,\"wall_time\":%s",
+      escaped_hlo_file, task_id, stats.num_warmup_repeats,
+      stats.num_timed_repeats, TimeStatsToJson(stats.wall_time));
+  if (stats.device_time.has_value()) {
+    absl::StrAppend(&json, ",\"device_time\":",
+                    TimeStatsToJson(*stats.device_time));
+  }
+  absl::StrAppend(&json, "}");
+  return json;
+}
+
 absl::Span<PjRtDevice* const> FunctionalHloRunner::GetLocalDevices(
     const PjRtClient& client) {
   return client.addressable_devices();
@@ -1089,6 +1176,14 @@ FunctionalHloRunner::RunInternal(
   futures.emplace();
   std::vector<std::vector<std::unique_ptr<PjRtBuffer>>> device_buffers;
   std::vector<std::vector<PjRtBuffer*>> argument_ptrs;
+  const size_t profile_repeat =
+      running_options.profile_repeat.value_or(running_options.num_repeats - 1);
+  if (running_options.profiler != nullptr &&
+      profile_repeat >= running_options.num_repeats) {
+    return absl::InvalidArgumentError(absl::StrFormat(
+        "Cannot profile repeat %d of %d repeats.", profile_repeat,
+        running_options.num_repeats));
+  }
   for (int repeat = 0; repeat < running_options.num_repeats; ++repeat) {
     VLOG(1) << "FunctionalHloRunner: ExecuteOnDevices started (repeat = "
             << repeat << ").";
@@ -1102,9 +1197,9 @@ FunctionalHloRunner::RunInternal(
     }
     if (repeat == running_options.num_repeats - 1) {
       execute_options.untuple_result = default_untuple_result;
-      if (running_options.profiler != nullptr) {
-        running_options.profiler->CreateSession();
-      }
+    }
+    if (running_options.profiler != nullptr && repeat == profile_repeat) {
+      running_options.profiler->CreateSession();
     }
     execute_options.launch_id = repeat + 1;
     if (running_options.execution_profiles != nullptr) {
@@ -1113,14 +1208,23 @@ FunctionalHloRunner::RunInternal(
       execute_options.execution_profile->set_warmup_run_executed(repeat > 0);
     }
     futures->clear();
+    absl::Time start_time = absl::Now();
     TF_ASSIGN_OR_RETURN(
         output_buffers,
         executable->Execute(argument_ptrs, execute_options, futures));
     for (auto& future : *futures) {
       TF_RETURN_IF_ERROR(future.Await());
     }
+    if (running_options.repeat_wall_times != nullptr) {
+      running_options.repeat_wall_times->push_back(absl::Now() - start_time);
+    }
     VLOG(1) << "FunctionalHloRunner: ExecuteOnDevices succeeded (repeat = "
             << repeat << ")";
+    if (running_options.profiler != nullptr &&
+        running_options.profile_repeat.has_value() &&
+        repeat == profile_repeat) {
+      running_options.profiler->UploadSession();
+    }
     if (repeat < running_options.num_repeats - 1) {
       switch (parameter_type) {
         case ParameterType::kOneTupleOfArrays:
@@ -1145,7 +1249,8 @@ FunctionalHloRunner::RunInternal(
                       FetchAndLogOutput(client, output_buffers,
                                         running_options.module_output_mode,
                                         running_options.log_input_output()));
-  if (running_options.profiler != nullptr) {
+  if (running_options.profiler != nullptr &&
+      !running_options.profile_repeat.has_value()) {
     running_options.profiler->UploadSession();
   }
   return results;
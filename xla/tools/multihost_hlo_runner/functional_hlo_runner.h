@@ -29,6 +29,7 @@ limitations under the License.
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
+#include "absl/time/time.h"
 #include "absl/types/span.h"
 #include "xla/client/executable_build_options.h"
 #include "xla/hlo/ir/hlo_module.h"
@@ -296,6 +297,9 @@ class FunctionalHloRunner {
     LogOutputMode log_input_output_mode = LogOutputMode::kNotLogOutput;
     const MultiSliceConfig* multi_slice_config = nullptr;
     ProfilerInterface* profiler = nullptr;
+    // The repeat that the profiler captures. If unset, the last repeat is
+    // profiled, together with fetching its outputs.
+    std::optional<size_t> profile_repeat = std::nullopt;
     // Whether to untuple the result of running HLO module into a vector of
     // arrays. If unprovided, use the default in ExecuteOptions.
     std::optional<bool> untuple_result = std::nullopt;
@@ -303,6 +307,9 @@ class FunctionalHloRunner {
     // Note that the first repeat is a warmup run, and uses less precise
     // profiling method.
     std::vector<ExecutionProfile>* execution_profiles = nullptr;
+    // If not null, the wall time of each repeat is stored here, from the launch
+    // of the execution to the completion of all its futures.
+    std::vector<absl::Duration>* repeat_wall_times = nullptr;
 
     // Should we log the inputs and outputs to stderr?
     bool log_input_output() const {
@@ -324,6 +331,24 @@ class FunctionalHloRunner {
     int partitions = 1;
   };
 
+  // Percentiles of the times of the timed repeats of a benchmark, as measured
+  // on one host.
+  struct TimeStats {
+    absl::Duration p50;
+    absl::Duration p90;
+    absl::Duration p99;
+    absl::Duration mean;
+  };
+
+  struct BenchmarkStats {
+    int64_t num_warmup_repeats = 0;
+    int64_t num_timed_repeats = 0;
+    TimeStats wall_time;
+    // The device time of the executions, as reported by the execution
+    // profiles. Unset if there are no profiles.
+    std::optional<TimeStats> device_time;
+  };
+
   // Loads an ExecutionOptions proto (which can be used in RawCompileOptions).
   static absl::StatusOr<ExecutionOptions> LoadExecutionOptions(
       absl::string_view path);
@@ -429,6 +454,19 @@ class FunctionalHloRunner {
       absl::string_view dump_output_to, int task_id,
       OutputFormat output_format = OutputFormat::kText);
 
+  // Computes the statistics of the repeats after the first
+  // `num_warmup_repeats` ones. `execution_profiles` may be empty, otherwise it
+  // has one profile per repeat like `wall_times`.
+  static absl::StatusOr<BenchmarkStats> ComputeBenchmarkStats(
+      absl::Span<const absl::Duration> wall_times,
+      absl::Span<const ExecutionProfile> execution_profiles,
+      int64_t num_warmup_repeats);
+
+  // Returns `stats` as a single-line JSON object, for tracking regressions.
+  static std::string BenchmarkStatsToJson(const BenchmarkStats& stats,
+                                          absl::string_view hlo_file,
+                                          int task_id);
+
  private:
   // Calculates the requested number of replicas and partitions.
   //
@@ -743,6 +743,39 @@ TEST(FunctionalHloRunnerTest, TestDebugOptionsAreNotOverwrittenByRawOptions) {
                   .xla_dump_hlo_as_text());
 }
 
+TEST(FunctionalHloRunnerTest, ComputeBenchmarkStatsSkipsWarmupRepeats) {
+  std::vector<absl::Duration> wall_times = {absl::Seconds(100)};
+  std::vector<ExecutionProfile> profiles(1);
+  profiles[0].set_compute_time_ns(100000);
+  for (int i = 1; i <= 10; ++i) {
+    wall_times.push_back(absl::Microseconds(i));
+    profiles.emplace_back().set_compute_time_ns(i * 100);
+  }
+
+  TF_ASSERT_OK_AND_ASSIGN(FunctionalHloRunner::BenchmarkStats stats,
+                          FunctionalHloRunner::ComputeBenchmarkStats(
+                              wall_times, profiles, /*num_warmup_repeats=*/1));
+  EXPECT_EQ(stats.num_timed_repeats, 10);
+  EXPECT_EQ(stats.wall_time.p50, absl::Microseconds(5));
+  EXPECT_EQ(stats.wall_time.p90, absl::Microseconds(9));
+  EXPECT_EQ(stats.wall_time.p99, absl::Microseconds(10));
+  EXPECT_EQ(stats.wall_time.mean, absl::Nanoseconds(5500));
+  ASSERT_TRUE(stats.device_time.has_value());
+  EXPECT_EQ(stats.device_time->p50, absl::Nanoseconds(500));
+
+  EXPECT_EQ(FunctionalHloRunner::BenchmarkStatsToJson(stats, "a.hlo",
+                                                      /*task_id=*/1),
+            "{\"hlo_file\":\"a.hlo\",\"task_id\":1,\"num_warmup_repeats\":1,"
+            "\"num_timed_repeats\":10,\"wall_time\":{\"p50_us\":5.000,"
+            "\"p90_us\":9.000,\"p99_us\":10.000,\"mean_us\":5.500},"
+            "\"device_time\":{\"p50_us\":0.500,\"p90_us\":0.900,"
+            "\"p99_us\":1.000,\"mean_us\":0.550}}");
+
+  EXPECT_THAT(FunctionalHloRunner::ComputeBenchmarkStats(
+                  wall_times, profiles, /*num_warmup_repeats=*/11),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
 }  // namespace
 }  // namespace xla
 
@@ -35,6 +35,8 @@ limitations under the License.
 #include "xla/service/hlo_module_util.h"
 #include "xla/tools/multihost_hlo_runner/create_client.h"
 #include "xla/tools/multihost_hlo_runner/functional_hlo_runner.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/errors.h"
 #include "xla/tsl/platform/statusor.h"
 #include "xla/tsl/util/command_line_flags.h"
 #include "xla/xla_data.pb.h"
@@ -70,6 +72,11 @@ all HLOs from an execution dump, with e.g.:
 Mock GPU usage:
   bazel run hlo_runner_main -- --enable_mock_nccl=true /path/to/hlo_module.hlo
 
+Benchmark usage:
+  bazel run hlo_runner_main -- --benchmark --num_repeats=100 \
+    --num_warmup_repeats=10 --benchmark_json_to=/tmp/stats.json \
+    /path/to/hlo_module.hlo
+
 Tip: If the input generation takes too long or uses too much host memory,
 consider using --hlo_argument_mode=uninitialized.
 )";
@@ -105,6 +112,10 @@ struct HloRunnerConfig {
   float gpu_client_mem_fraction = xla::GpuAllocatorConfig{}.memory_fraction;
   bool profile_execution = false;
   std::string xla_gpu_dump_xspace_to = "";
+  int32_t profile_repeat = -1;
+  bool benchmark = false;
+  int32_t num_warmup_repeats = 1;
+  std::string benchmark_json_to = "";
 };
 
 }  // namespace
@@ -165,6 +176,9 @@ RunningOptionsFromFlags(const HloRunnerConfig& opts) {
   out.module_output_mode =
       FunctionalHloRunner::ModuleOutputMode::kReturnOutputs;
   out.num_repeats = static_cast<size_t>(opts.num_repeats);
+  if (opts.profile_repeat >= 0) {
+    out.profile_repeat = static_cast<size_t>(opts.profile_repeat);
+  }
   out.log_input_output_mode =
       opts.log_output ? FunctionalHloRunner::LogOutputMode::kLogOutput
                       : FunctionalHloRunner::LogOutputMode::kNotLogOutput;
@@ -271,13 +285,28 @@ static absl::Status RunMultihostHloRunner(int argc, char** argv,
   CHECK(env.client != nullptr);
 
   std::vector<ExecutionProfile> execution_profiles;
-  if (opts.profile_execution) {
+  if (opts.profile_execution || opts.benchmark) {
     running_options.execution_profiles = &execution_profiles;
   }
+  std::vector<absl::Duration> repeat_wall_times;
+  std::string benchmark_json_path = opts.benchmark_json_to;
+  if (opts.benchmark) {
+    QCHECK(opts.should_run) << "Cannot benchmark without running the HLO";
+    QCHECK_GE(opts.num_warmup_repeats, 0);
+    QCHECK_GT(opts.num_repeats, opts.num_warmup_repeats)
+        << "--num_repeats must be greater than --num_warmup_repeats";
+    running_options.repeat_wall_times = &repeat_wall_times;
+    // Each host writes its own statistics.
+    if (!benchmark_json_path.empty() && opts.num_nodes > 1) {
+      absl::StrAppend(&benchmark_json_path, ".task_", opts.task_id);
+    }
+  }
+  std::string benchmark_json;
 
   for (int c = 1; c < argc; c++) {
     const char* hlo_file = argv[c];
     execution_profiles.clear();
+    repeat_wall_times.clear();
     if (opts.should_run) {
       std::cout << "\n** Running " << hlo_file << " **\n";
       TF_RETURN_IF_ERROR(xla::FunctionalHloRunner::LoadAndRunAndDump(
@@ -295,6 +324,34 @@ static absl::Status RunMultihostHloRunner(int argc, char** argv,
                 << " duration=" << execution_profiles[i].compute_time_ns()
                 << "ns" << std::endl;
     }
+    if (opts.benchmark) {
+      TF_ASSIGN_OR_RETURN(
+          FunctionalHloRunner::BenchmarkStats stats,
+          FunctionalHloRunner::ComputeBenchmarkStats(
+              repeat_wall_times, execution_profiles, opts.num_warmup_repeats));
+      std::cout << "## Benchmark, file=" << hlo_file
+                << " task=" << opts.task_id
+                << " repeats=" << stats.num_timed_repeats
+                << " wall p50=" << stats.wall_time.p50
+                << " p90=" << stats.wall_time.p90
+                << " p99=" << stats.wall_time.p99;
+      if (stats.device_time.has_value()) {
+        std::cout << " device p50=" << stats.device_time->p50
+                  << " p90=" << stats.device_time->p90
+                  << " p99=" << stats.device_time->p99;
+      }
+      std::cout << std::endl;
+      if (!benchmark_json_path.empty()) {
+        // Rewrite the file after each HLO, so that the statistics of the
+        // earlier HLOs are kept if a later one fails.
+        absl::StrAppend(&benchmark_json,
+                        FunctionalHloRunner::BenchmarkStatsToJson(
+                            stats, hlo_file, opts.task_id),
+                        "\n");
+        TF_RETURN_IF_ERROR(tsl::WriteStringToFile(
+            tsl::Env::Default(), benchmark_json_path, benchmark_json));
+      }
+    }
   }
   return absl::OkStatus();
 }
@@ -382,7 +439,20 @@ int main(int argc, char** argv) {
       tsl::Flag("profile_execution", &opts.profile_execution,
                 "If set, we will profile the execution and print the results."),
       tsl::Flag("xla_gpu_dump_xspace_to", &opts.xla_gpu_dump_xspace_to,
-                "A directory to dump xspace data for GPU profiling.")};
+                "A directory to dump xspace data for GPU profiling."),
+      tsl::Flag("profile_repeat", &opts.profile_repeat,
+                "The repeat to capture with --xla_gpu_dump_xspace_to. If "
+                "negative, the last repeat is profiled."),
+      tsl::Flag("benchmark", &opts.benchmark,
+                "If set, time each repeat and print the p50/p90/p99 wall and "
+                "device times of the repeats after the warmup ones."),
+      tsl::Flag("num_warmup_repeats", &opts.num_warmup_repeats,
+                "The number of repeats that --benchmark leaves out of the "
+                "statistics."),
+      tsl::Flag("benchmark_json_to", &opts.benchmark_json_to,
+                "A file to which --benchmark writes one JSON line of "
+                "statistics per HLO file. With more than one node, each task "
+                "writes to this path suffixed with .task_<task_id>.")};
 
   xla::AppendDebugOptionsFlags(&flag_list);
 
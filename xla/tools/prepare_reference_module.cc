@@ -57,4 +57,20 @@ absl::StatusOr<std::unique_ptr<HloModule>> PrepareReferenceModule(
   }
   return std::move(reference_module);
 }
+
+void SetStrictCpuReferenceDebugOptions(DebugOptions* debug_options) {
+  debug_options->set_xla_cpu_enable_fast_math(false);
+  debug_options->set_xla_cpu_enable_fast_min_max(false);
+  debug_options->set_xla_cpu_fast_math_honor_nans(true);
+  debug_options->set_xla_cpu_fast_math_honor_infs(true);
+  debug_options->set_xla_cpu_fast_math_honor_division(true);
+  debug_options->set_xla_cpu_fast_math_honor_functions(true);
+  // Don't upcast f16 and bf16 dots and convolutions, so that they round like
+  // the interpreter does.
+  debug_options->set_xla_cpu_strict_dot_conv_math(true);
+  debug_options->set_xla_cpu_use_mkl_dnn(false);
+  debug_options->set_xla_cpu_use_acl(false);
+  debug_options->set_xla_cpu_use_xnnpack(false);
+  debug_options->set_xla_cpu_use_thunk_runtime(true);
+}
 };  // namespace xla
@@ -24,6 +24,7 @@ limitations under the License.
 #include "xla/service/hlo_module_config.h"
 #include "xla/service/hlo_runner_interface.h"
 #include "xla/stream_executor/platform.h"
+#include "xla/xla.pb.h"
 #include "tsl/platform/status.h"
 
 namespace xla {
@@ -40,6 +41,13 @@ absl::StatusOr<std::unique_ptr<HloModule>> PrepareReferenceModule(
                                      HloModule*)>& module_modifier_hook = {},
     bool skip_despecialization = false);
 
+// Sets the DebugOptions that make the CPU backend a fast stand-in for the
+// interpreter as a reference platform: IEEE semantics without fast-math, no
+// rewrites that change precision, no external matmul and convolution
+// libraries, and the thunk runtime. Reductions and dots may still accumulate
+// in a different order than the interpreter does.
+void SetStrictCpuReferenceDebugOptions(DebugOptions* debug_options);
+
 }  // namespace xla
 
 #endif  // XLA_TOOLS_PREPARE_REFERENCE_MODULE_H_
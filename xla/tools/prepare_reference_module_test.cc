@@ -18,6 +18,7 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_module.h"
 #include "xla/hlo/testlib/test.h"
 #include "xla/tests/hlo_test_base.h"
+#include "xla/xla.pb.h"
 #include "tsl/platform/statusor.h"
 
 namespace xla {
@@ -72,5 +73,19 @@ TEST_F(PrepareReferenceModuleTest, SkipDespecialization) {
   EXPECT_THAT(reference_module->ToString(), ::testing::HasSubstr("fusion"));
 }
 
+TEST_F(PrepareReferenceModuleTest, StrictCpuReferenceDisablesFastMath) {
+  DebugOptions debug_options;
+  debug_options.set_xla_cpu_enable_fast_math(true);
+  debug_options.set_xla_cpu_enable_fast_min_max(true);
+  debug_options.set_xla_cpu_fast_math_honor_nans(false);
+  SetStrictCpuReferenceDebugOptions(&debug_options);
+
+  EXPECT_FALSE(debug_options.xla_cpu_enable_fast_math());
+  EXPECT_FALSE(debug_options.xla_cpu_enable_fast_min_max());
+  EXPECT_TRUE(debug_options.xla_cpu_fast_math_honor_nans());
+  EXPECT_TRUE(debug_options.xla_cpu_strict_dot_conv_math());
+  EXPECT_TRUE(debug_options.xla_cpu_use_thunk_runtime());
+}
+
 }  // namespace
 }  // namespace xla
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "xla/tools/run_hlo_module.h"
 
+#include <cstdint>
 #include <functional>
 #include <iomanip>
 #include <iostream>
@@ -31,16 +32,25 @@ limitations under the License.
 #include "absl/log/check.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/str_join.h"
 #include "absl/strings/str_replace.h"
+#include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
 #include "absl/types/span.h"
+#include "xla/debug_options_flags.h"
 #include "xla/error_spec.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_module.h"
 #include "xla/hlo/ir/hlo_opcode.h"
 #include "xla/literal.h"
 #include "xla/literal_comparison.h"
+#include "xla/service/buffer_assignment.h"
+#include "xla/service/executable.h"
 #include "xla/service/hlo.pb.h"
 #include "xla/service/hlo_module_config.h"
 #include "xla/service/hlo_verifier.h"
@@ -50,7 +60,9 @@ limitations under the License.
 #include "xla/tools/hlo_module_loader.h"
 #include "xla/tools/prepare_reference_module.h"
 #include "xla/tools/run_hlo_module.pb.h"
+#include "xla/tsl/util/command_line_flags.h"
 #include "xla/util.h"
+#include "xla/xla.pb.h"
 #include "xla/xla_data.pb.h"
 #include "tsl/platform/env.h"
 #include "tsl/platform/errors.h"
@@ -259,6 +271,16 @@ absl::Status RunAndCompareInternal(
     }
   }
 
+  if (options.strict_cpu_reference) {
+    config_modifier_hook = [hook = std::move(config_modifier_hook)](
+                               HloModuleConfig* config) {
+      hook(config);
+      DebugOptions debug_options = config->debug_options();
+      SetStrictCpuReferenceDebugOptions(&debug_options);
+      config->set_debug_options(debug_options);
+    };
+  }
+
   std::unique_ptr<HloModule> reference_module;
   if (reference_runner != nullptr) {
     // If reference platform is the same as test platform, we shouldn't
@@ -475,8 +497,151 @@ absl::Status RunIsolatedAndCompare(
   return status;
 }
 
+absl::StatusOr<ModulePerformance> MeasurePerformance(
+    const HloModule& module, const DebugOptions& debug_options,
+    absl::Span<const Literal> args, HloRunner* runner, bool run_hlo_passes,
+    int iterations) {
+  std::unique_ptr<HloModule> clone = module.Clone("");
+  clone->mutable_config().set_debug_options(debug_options);
+  ModulePerformance performance;
+  performance.platform = std::string(runner->Name());
+
+  std::cerr << "Compiling HLO module with runner " << runner->Name()
+            << "...\n";
+  absl::Time start = absl::Now();
+  TF_ASSIGN_OR_RETURN(std::unique_ptr<OpaqueExecutable> executable,
+                      runner->CreateExecutable(std::move(clone),
+                                               run_hlo_passes));
+  performance.compile_time = absl::Now() - start;
+
+  TF_ASSIGN_OR_RETURN(Executable* const unwrapped,
+                      runner->ExecutableFromWrapped(executable.get()));
+  if (absl::Span<const BufferAllocation> allocations =
+          unwrapped->GetAllocations();
+      !allocations.empty()) {
+    performance.allocated_bytes = 0;
+    for (const BufferAllocation& allocation : allocations) {
+      if (!allocation.is_entry_computation_parameter() &&
+          !allocation.is_constant()) {
+        performance.allocated_bytes += allocation.size();
+      }
+    }
+  }
+
+  // The first run loads the executable and warms up the caches.
+  TF_RETURN_IF_ERROR(
+      runner->ExecuteWithExecutable(executable.get(), args).status());
+  std::vector<absl::Duration> run_times;
+  for (int i = 0; i < iterations; ++i) {
+    ExecutionProfile profile;
+    start = absl::Now();
+    TF_RETURN_IF_ERROR(
+        runner->ExecuteWithExecutable(executable.get(), args, &profile)
+            .status());
+    absl::Duration wall_time = absl::Now() - start;
+    // Prefer the device time, which leaves out the transfers of the arguments
+    // and the results.
+    run_times.push_back(profile.compute_time_ns() > 0
+                            ? absl::Nanoseconds(profile.compute_time_ns())
+                            : wall_time);
+  }
+  absl::c_sort(run_times);
+  performance.run_time = run_times[run_times.size() / 2];
+  return performance;
+}
+
 }  // namespace
 
+std::string FormatPerformanceComparison(const ModulePerformance& baseline,
+                                        const ModulePerformance& test) {
+  auto relative_delta = [](double baseline, double test) -> std::string {
+    if (baseline == 0) {
+      return "n/a";
+    }
+    return absl::StrFormat("%+.1f%%", (test - baseline) / baseline * 100);
+  };
+  std::string table = absl::StrFormat("%-20s %16s %16s %10s\n", "",
+                                      "baseline", "test", "delta");
+  absl::StrAppendFormat(&table, "%-20s %16s %16s %10s\n", "platform",
+                        baseline.platform, test.platform, "");
+  const double baseline_compile_s =
+      absl::ToDoubleSeconds(baseline.compile_time);
+  const double test_compile_s = absl::ToDoubleSeconds(test.compile_time);
+  absl::StrAppendFormat(&table, "%-20s %16.3f %16.3f %10s\n",
+                        "compile time (s)", baseline_compile_s,
+                        test_compile_s,
+                        relative_delta(baseline_compile_s, test_compile_s));
+  const double baseline_run_us = absl::ToDoubleMicroseconds(baseline.run_time);
+  const double test_run_us = absl::ToDoubleMicroseconds(test.run_time);
+  absl::StrAppendFormat(&table, "%-20s %16.1f %16.1f %10s\n", "run time (us)",
+                        baseline_run_us, test_run_us,
+                        relative_delta(baseline_run_us, test_run_us));
+  if (baseline.allocated_bytes >= 0 && test.allocated_bytes >= 0) {
+    absl::StrAppendFormat(
+        &table, "%-20s %16d %16d %10s\n", "allocated (bytes)",
+        baseline.allocated_bytes, test.allocated_bytes,
+        relative_delta(baseline.allocated_bytes, test.allocated_bytes));
+  }
+  return table;
+}
+
+absl::StatusOr<DebugOptions> ApplyDebugOptionsFlags(
+    absl::string_view flags, DebugOptions debug_options) {
+  std::vector<tsl::Flag> flag_list;
+  MakeDebugOptionsFlags(&flag_list, &debug_options);
+  std::vector<std::string> args =
+      absl::StrSplit(flags, ' ', absl::SkipWhitespace());
+  if (!tsl::Flags::Parse(args, flag_list)) {
+    return InvalidArgument("Failed to parse the flags \"%s\".", flags);
+  }
+  if (!args.empty()) {
+    return InvalidArgument("Unknown DebugOptions flags: %s",
+                           absl::StrJoin(args, " "));
+  }
+  return debug_options;
+}
+
+absl::Status ComparePerformance(const std::string& hlo_filename,
+                                HloRunner* test_runner,
+                                HloRunner* baseline_runner,
+                                const DebugOptions& test_debug_options,
+                                const DebugOptions& baseline_debug_options,
+                                std::minstd_rand0* engine,
+                                const RunHloModuleOptions& options) {
+  if (options.iterations < 1) {
+    return InvalidArgument("Need at least one iteration to compare, got %d.",
+                           options.iterations);
+  }
+  std::string input_format = options.input_format;
+  if (input_format.empty()) {
+    input_format = std::string(tsl::io::Extension(hlo_filename));
+  }
+  TF_ASSIGN_OR_RETURN(std::unique_ptr<HloModule> module,
+                      LoadModuleFromFile(hlo_filename, input_format));
+  if (options.flatten_control_flow) {
+    HloControlFlowFlattening control_flow_flattening(
+        HloControlFlowFlattening::Options{/*while_execution_count=*/1});
+    TF_RETURN_IF_ERROR(control_flow_flattening.Run(module.get()).status());
+  }
+  TF_ASSIGN_OR_RETURN(std::vector<Literal> args,
+                      MakeFakeArguments(module.get(), engine,
+                                        options.use_large_float_range,
+                                        options.treat_gte_as_data_formatting));
+
+  TF_ASSIGN_OR_RETURN(
+      ModulePerformance baseline,
+      MeasurePerformance(*module, baseline_debug_options, args,
+                         baseline_runner, options.run_reference_hlo_passes,
+                         options.iterations));
+  TF_ASSIGN_OR_RETURN(
+      ModulePerformance test,
+      MeasurePerformance(*module, test_debug_options, args, test_runner,
+                         options.run_test_hlo_passes, options.iterations));
+  std::cout << "\n** Performance of " << hlo_filename << " **\n"
+            << FormatPerformanceComparison(baseline, test);
+  return absl::OkStatus();
+}
+
 absl::Status RunAndCompare(
     std::unique_ptr<HloModule> test_module,
     const BufferAssignmentProto* buffer_assignment_proto,
@@ -16,15 +16,20 @@ limitations under the License.
 #ifndef XLA_TOOLS_RUN_HLO_MODULE_H_
 #define XLA_TOOLS_RUN_HLO_MODULE_H_
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <random>
 #include <string>
 
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
 #include "xla/hlo/ir/hlo_module.h"
 #include "xla/service/hlo_runner.h"
 #include "xla/tools/run_hlo_module.pb.h"
+#include "xla/xla.pb.h"
 #include "tsl/platform/status.h"
 
 namespace xla {
@@ -41,6 +46,9 @@ struct RunHloModuleOptions {
   bool run_test_hlo_passes{true};
   bool run_reference_hlo_passes{true};
   bool force_use_cpu_thunk_runtime_for_test{false};
+  // Run the reference module with SetStrictCpuReferenceDebugOptions. Meant for
+  // using the CPU backend instead of the interpreter as the reference.
+  bool strict_cpu_reference{false};
   // Using small float range by default, as otherwise all reductions
   // miscompare vs. the interpreter with inf/nan.
   bool use_large_float_range{false};
@@ -93,6 +101,40 @@ absl::Status RunAndCompare(
                                HloModule& module)>
         compilation_env_modifier_hook = {});
 
+// The cost of one configuration of a module, as measured by
+// ComparePerformance.
+struct ModulePerformance {
+  std::string platform;
+  absl::Duration compile_time;
+  // The median run time of the timed runs.
+  absl::Duration run_time;
+  // The size of the buffers allocated for the temporaries and the outputs of
+  // the module, or -1 if the executable does not expose its allocations.
+  int64_t allocated_bytes = -1;
+};
+
+// Formats `baseline`, `test` and their deltas as a table.
+std::string FormatPerformanceComparison(const ModulePerformance& baseline,
+                                        const ModulePerformance& test);
+
+// Returns `debug_options` with the DebugOptions flags in `flags`, e.g.
+// "--xla_gpu_autotune_level=0 --xla_gpu_enable_triton_gemm=false", applied.
+absl::StatusOr<DebugOptions> ApplyDebugOptionsFlags(
+    absl::string_view flags, DebugOptions debug_options);
+
+// Compiles the module in 'hlo_filename' on 'baseline_runner' with
+// 'baseline_debug_options' and on 'test_runner' with 'test_debug_options', and
+// runs both with the same fake arguments, once to warm up and then
+// 'options.iterations' times. Prints the compile time, run time and allocated
+// memory of both and their deltas. The results are not compared.
+absl::Status ComparePerformance(const std::string& hlo_filename,
+                                HloRunner* test_runner,
+                                HloRunner* baseline_runner,
+                                const DebugOptions& test_debug_options,
+                                const DebugOptions& baseline_debug_options,
+                                std::minstd_rand0* engine,
+                                const RunHloModuleOptions& options);
+
 // Read the input literals from 'file_path'. The file can be either a binary
 // proto or a text proto. If it doesn't contain a RunHloModuleLiterals proto, it
 // will fallback to reading a RunHloModuleIterationLiterals proto and use that
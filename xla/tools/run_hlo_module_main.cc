@@ -28,6 +28,7 @@ limitations under the License.
 #include "absl/log/check.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MemoryBuffer.h"
@@ -41,6 +42,7 @@ limitations under the License.
 #include "xla/tools/run_hlo_module.h"
 #include "xla/tools/run_hlo_module.pb.h"
 #include "xla/tsl/util/command_line_flags.h"
+#include "xla/xla.pb.h"
 #include "tsl/platform/init_main.h"
 #include "tsl/platform/logging.h"
 #include "tsl/platform/status.h"
@@ -70,6 +72,13 @@ Usage:
 Multiple files can be run as well:
 
   bazel run run_hlo_module -- --platform=[CPU|CUDA|Interpreter] /path/*.hlo
+
+The compile time, run time and memory of a module under two sets of flags can
+be compared as well, without comparing the results:
+
+  bazel run run_hlo_module -- --platform=CUDA --compare_performance \
+    --compare_xla_flags="--xla_gpu_enable_triton_gemm=false" --iterations=10 \
+    path/to/hlo_module
 )";
 const char kInterpreterPlatformName[] = "Interpreter";
 
@@ -80,9 +89,10 @@ std::string GetTestPlatformName(std::string name) {
 }
 
 // Returns the name of the reference platform
-std::string GetReferencePlatformName(std::string reference_platform) {
+std::string GetReferencePlatformName(std::string reference_platform,
+                                     bool strict_cpu_reference) {
   if (reference_platform == "default") {
-    return kInterpreterPlatformName;
+    return strict_cpu_reference ? "cpu" : kInterpreterPlatformName;
   }
   return reference_platform;
 }
@@ -91,6 +101,9 @@ std::string GetReferencePlatformName(std::string reference_platform) {
 int main(int argc, char** argv) {
   xla::RunHloModuleOptions opts;
   bool different_random_seeds = false;
+  bool compare_performance = false;
+  std::string compare_platform;
+  std::string compare_xla_flags;
   std::vector<tsl::Flag> flag_list = {
       tsl::Flag("platform", &opts.platform,
                 "The test platform that the HLO module will be executed on "
@@ -133,6 +146,14 @@ int main(int argc, char** argv) {
           "will be used for the test run regardless of the "
           "xla_cpu_use_thunk_runtime flag in XLA_FLAGS. This option doesn't "
           "impact reference run. It is ignored for platforms other than CPU."),
+      tsl::Flag(
+          "strict_cpu_reference", &opts.strict_cpu_reference,
+          "Compile the reference module with fast-math and the other "
+          "precision-changing CPU rewrites disabled, using the thunk runtime. "
+          "With --reference_platform=default, the reference platform becomes "
+          "'cpu' instead of 'interpreter', which is much faster on large "
+          "modules. Results may still differ from the interpreter's in the "
+          "accumulation order of reductions and dots."),
       tsl::Flag("random_init_input_literals", &opts.random_init_input_literals,
                 "Initialize input literals with random numbers."
                 "Leave them uninitialized otherwise."),
@@ -165,6 +186,19 @@ int main(int argc, char** argv) {
       tsl::Flag("different_random_seeds", &different_random_seeds,
                 "Whether each iteration should use a different random seed for "
                 "the HloModuleConfig."),
+      tsl::Flag("compare_performance", &compare_performance,
+                "Rather than comparing the results with the reference "
+                "platform, compare the compile time, median run time of "
+                "--iterations runs and allocated memory of the module on "
+                "--platform with the DebugOptions flags in --compare_xla_flags "
+                "applied against a baseline without them."),
+      tsl::Flag("compare_platform", &compare_platform,
+                "The platform of the --compare_performance baseline. Defaults "
+                "to --platform."),
+      tsl::Flag("compare_xla_flags", &compare_xla_flags,
+                "Space-separated DebugOptions flags that --compare_performance "
+                "applies on top of the other flags for the test run only, e.g. "
+                "\"--xla_gpu_autotune_level=0\"."),
   };
   xla::AppendDebugOptionsFlags(&flag_list);
   // The usage string includes the message at the top of the file, the
@@ -182,8 +216,13 @@ int main(int argc, char** argv) {
          "together";
 
   const std::string test_platform_name = GetTestPlatformName(opts.platform);
+  if (compare_performance) {
+    // There is no reference result to compare against.
+    opts.reference_platform = "";
+  }
   const std::string reference_platform_name =
-      GetReferencePlatformName(opts.reference_platform);
+      GetReferencePlatformName(opts.reference_platform,
+                               opts.strict_cpu_reference);
   auto* test_platform =
       xla::PlatformUtil::GetPlatform(test_platform_name).value();
   auto* reference_platform =
@@ -197,6 +236,20 @@ int main(int argc, char** argv) {
 
   QCHECK(argc > 1) << "Input HLO file missing.";
 
+  std::unique_ptr<xla::HloRunner> baseline_runner;
+  xla::DebugOptions test_debug_options;
+  if (compare_performance) {
+    if (!compare_platform.empty()) {
+      baseline_runner = std::make_unique<xla::HloRunner>(
+          xla::PlatformUtil::GetPlatform(compare_platform).value());
+    }
+    absl::StatusOr<xla::DebugOptions> debug_options =
+        xla::ApplyDebugOptionsFlags(compare_xla_flags,
+                                    xla::GetDebugOptionsFromFlags());
+    QCHECK_OK(debug_options.status());
+    test_debug_options = *std::move(debug_options);
+  }
+
   int failure_count = 0;
   for (int c = 1; c < argc; c++) {
     const char* hlo_filename = argv[c];
@@ -250,6 +303,19 @@ int main(int argc, char** argv) {
       opts.input_format = "hlo";
     }
 
+    if (compare_performance) {
+      std::minstd_rand0 engine;
+      absl::Status result = xla::ComparePerformance(
+          hlo_filename, &test_runner,
+          baseline_runner ? baseline_runner.get() : &test_runner,
+          test_debug_options, xla::GetDebugOptionsFromFlags(), &engine, opts);
+      if (!result.ok()) {
+        failure_count++;
+        std::cerr << result << "\n";
+      }
+      continue;
+    }
+
     xla::RunHloModuleLiterals literals_proto;
     std::unique_ptr<std::minstd_rand0> engine;
     if (opts.random_init_input_literals) {
@@ -17,10 +17,13 @@ limitations under the License.
 
 #include <string>
 
+#include "absl/status/statusor.h"
+#include "absl/time/time.h"
 #include "xla/literal.h"
 #include "xla/literal_util.h"
 #include "xla/tools/run_hlo_module.pb.h"
 #include "xla/tsl/lib/core/status_test_util.h"
+#include "xla/xla.pb.h"
 #include "xla/xla_data.pb.h"
 #include "tsl/platform/env.h"
 #include "tsl/platform/test.h"
@@ -90,5 +93,35 @@ TEST(ReadInputLiteralsFromFile, ReadRunHloModuleIterationLiteralsTextProto) {
             proto.SerializeAsString());
 }
 
+TEST(ApplyDebugOptionsFlags, OverridesOnlyTheGivenFlags) {
+  DebugOptions debug_options;
+  debug_options.set_xla_gpu_autotune_level(4);
+  debug_options.set_xla_dump_to("/tmp/dump");
+  absl::StatusOr<DebugOptions> result = ApplyDebugOptionsFlags(
+      " --xla_gpu_autotune_level=0  --xla_gpu_enable_triton_gemm=false",
+      debug_options);
+  TF_ASSERT_OK(result.status());
+  EXPECT_EQ(result->xla_gpu_autotune_level(), 0);
+  EXPECT_FALSE(result->xla_gpu_enable_triton_gemm());
+  EXPECT_EQ(result->xla_dump_to(), "/tmp/dump");
+}
+
+TEST(ApplyDebugOptionsFlags, RejectsUnknownFlags) {
+  EXPECT_FALSE(
+      ApplyDebugOptionsFlags("--xla_not_a_flag=1", DebugOptions()).ok());
+}
+
+TEST(FormatPerformanceComparison, PrintsRelativeDeltas) {
+  ModulePerformance baseline{"CUDA", absl::Seconds(2), absl::Microseconds(100),
+                             1000};
+  ModulePerformance test{"CUDA", absl::Seconds(1), absl::Microseconds(110),
+                         -1};
+  std::string table = FormatPerformanceComparison(baseline, test);
+  EXPECT_THAT(table, ::testing::HasSubstr("-50.0%"));
+  EXPECT_THAT(table, ::testing::HasSubstr("+10.0%"));
+  // The memory is unknown for the test executable.
+  EXPECT_THAT(table, ::testing::Not(::testing::HasSubstr("allocated")));
+}
+
 }  // namespace
 }  // namespace xla
@@ -21,6 +21,7 @@ limitations under the License.
 #include <functional>
 #include <limits>
 #include <optional>
+#include <vector>
 
 #include "absl/strings/string_view.h"
 #include "xla/tsl/framework/numeric_types.h"
@@ -92,6 +93,15 @@ struct AllocatorStats {
   std::optional<int64_t> pool_bytes;
   std::optional<int64_t> peak_pool_bytes;
 
+  // Free bytes held by the allocator, bucketed by chunk size: entry i covers
+  // free chunks of [256 << i, 256 << (i + 1)) bytes, the last entry covers all
+  // larger chunks. Empty if the allocator doesn't pool memory.
+  std::vector<int64_t> free_bytes_histogram;
+
+  // Requested sizes of the most recent allocations, oldest first. Empty unless
+  // the allocator is configured to keep an allocation history.
+  std::vector<int64_t> recent_allocation_sizes;
+
   AllocatorStats()
       : num_allocs(0),
         bytes_in_use(0),
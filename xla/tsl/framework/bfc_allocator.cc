@@ -625,6 +625,13 @@ void* BFCAllocator::FindChunkPtr(BinNum bin_num, size_t rounded_bytes,
             std::max(stats_.peak_bytes_in_use, stats_.bytes_in_use);
         stats_.largest_alloc_size =
             std::max<std::size_t>(stats_.largest_alloc_size, chunk->size);
+        if (opts_.allocation_size_history_length > 0) {
+          allocation_size_history_.push_back(num_bytes);
+          if (allocation_size_history_.size() >
+              static_cast<size_t>(opts_.allocation_size_history_length)) {
+            allocation_size_history_.pop_front();
+          }
+        }
 
 #ifdef TENSORFLOW_MEM_DEBUG
         if (ShouldRecordOpName()) {
@@ -1227,7 +1234,17 @@ MemoryDump BFCAllocator::RecordMemoryMapInternal() {
 
 std::optional<AllocatorStats> BFCAllocator::GetStats() {
   absl::MutexLock l(&mutex_);
-  return stats_;
+  AllocatorStats stats = stats_;
+  stats.largest_free_block_bytes = LargestFreeChunk();
+  stats.free_bytes_histogram.assign(kNumBins, 0);
+  for (BinNum b = 0; b < kNumBins; b++) {
+    for (ChunkHandle h : BinFromIndex(b)->free_chunks) {
+      stats.free_bytes_histogram[b] += ChunkFromHandle(h)->size;
+    }
+  }
+  stats.recent_allocation_sizes.assign(allocation_size_history_.begin(),
+                                       allocation_size_history_.end());
+  return stats;
 }
 
 bool BFCAllocator::ClearStats() {
@@ -1235,6 +1252,7 @@ bool BFCAllocator::ClearStats() {
   stats_.num_allocs = 0;
   stats_.peak_bytes_in_use = stats_.bytes_in_use;
   stats_.largest_alloc_size = 0;
+  allocation_size_history_.clear();
   return true;
 }
 
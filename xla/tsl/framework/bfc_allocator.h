@@ -74,6 +74,10 @@ class BFCAllocator : public Allocator {
     // Controls when a chunk should be split, if its size exceeds the requested
     // allocation size.
     double fragmentation_fraction = 0;
+
+    // Number of most recent allocation sizes to keep and report in
+    // `AllocatorStats::recent_allocation_sizes`. Zero disables the history.
+    int64_t allocation_size_history_length = 0;
   };
   BFCAllocator(std::unique_ptr<SubAllocator> sub_allocator, size_t total_memory,
                const string& name, const Options& opts);
@@ -595,6 +599,10 @@ class BFCAllocator : public Allocator {
   // Stats.
   AllocatorStats stats_ ABSL_GUARDED_BY(mutex_);
 
+  // Requested sizes of the most recent allocations, see
+  // `Options::allocation_size_history_length`.
+  std::deque<int64_t> allocation_size_history_ ABSL_GUARDED_BY(mutex_);
+
 #ifdef TENSORFLOW_MEM_DEBUG
   int64 action_counter_ ABSL_GUARDED_BY(mutex_);
 #define MEM_DEBUG_SIZE_HISTORY_SIZE 4096
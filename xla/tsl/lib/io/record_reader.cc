@@ -17,12 +17,18 @@ limitations under the License.
 
 #include <limits.h>
 
+#include <cstddef>
+
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+
 #include "xla/tsl/lib/hash/crc32c.h"
 #include "xla/tsl/lib/io/buffered_inputstream.h"
 #include "xla/tsl/lib/io/compression.h"
 #include "xla/tsl/lib/io/random_inputstream.h"
 #include "xla/tsl/platform/env.h"
 #include "xla/tsl/platform/errors.h"
+#include "xla/tsl/platform/file_system.h"
 #include "tsl/platform/raw_coding.h"
 
 namespace tsl {
@@ -260,5 +266,67 @@ SequentialRecordReader::SequentialRecordReader(
     RandomAccessFile* file, const RecordReaderOptions& options)
     : underlying_(file, options), offset_(0) {}
 
+MappedRecordReader::MappedRecordReader(ReadOnlyMemoryRegion* region)
+    : data_(static_cast<const char*>(region->data())),
+      size_(region->length()) {}
+
+// Same as RecordReader::ReadChecksummed, but returns a view of the first n
+// bytes in the region instead of reading them.
+absl::Status MappedRecordReader::ReadChecksummed(
+    uint64 offset, size_t n, absl::string_view* result) const {
+  if (n >= SIZE_MAX - sizeof(uint32)) {
+    return errors::DataLoss("record size too large",
+                            GetChecksumErrorSuffix(offset));
+  }
+
+  const size_t expected = n + sizeof(uint32);
+  if (offset >= size_) {
+    return errors::OutOfRange("eof", GetChecksumErrorSuffix(offset));
+  }
+  if (size_ - offset < expected) {
+    return errors::DataLoss("truncated record at ", offset,
+                            GetChecksumErrorSuffix(offset));
+  }
+
+  const char* data = data_ + offset;
+  const uint32 masked_crc = core::DecodeFixed32(data + n);
+  if (crc32c::Unmask(masked_crc) != crc32c::Value(data, n)) {
+    return errors::DataLoss("corrupted record at ", offset,
+                            GetChecksumErrorSuffix(offset));
+  }
+  *result = absl::string_view(data, n);
+  return absl::OkStatus();
+}
+
+absl::Status MappedRecordReader::ReadRecord(uint64* offset,
+                                            absl::string_view* record) const {
+  // Read header data.
+  absl::string_view header;
+  TF_RETURN_IF_ERROR(ReadChecksummed(*offset, sizeof(uint64), &header));
+  const uint64 length = core::DecodeFixed64(header.data());
+
+  // Read data
+  absl::Status s = ReadChecksummed(*offset + RecordReader::kHeaderSize,
+                                   length, record);
+  if (!s.ok()) {
+    if (errors::IsOutOfRange(s)) {
+      s = errors::DataLoss("truncated record at ", *offset, "' failed with ",
+                           s.message());
+    }
+    return s;
+  }
+
+  *offset += RecordReader::kHeaderSize + length + RecordReader::kFooterSize;
+  return absl::OkStatus();
+}
+
+absl::Status MappedRecordReader::ReadRecord(uint64* offset,
+                                            tstring* record) const {
+  absl::string_view view;
+  TF_RETURN_IF_ERROR(ReadRecord(offset, &view));
+  record->assign(view.data(), view.size());
+  return absl::OkStatus();
+}
+
 }  // namespace io
 }  // namespace tsl
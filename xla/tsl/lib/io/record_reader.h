@@ -16,6 +16,11 @@ limitations under the License.
 #ifndef XLA_TSL_LIB_IO_RECORD_READER_H_
 #define XLA_TSL_LIB_IO_RECORD_READER_H_
 
+#include <cstddef>
+#include <memory>
+
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
 #include "xla/tsl/lib/io/inputstream_interface.h"
 #include "xla/tsl/platform/errors.h"
 #include "tsl/platform/stringpiece.h"
@@ -30,6 +35,7 @@ limitations under the License.
 
 namespace tsl {
 class RandomAccessFile;
+class ReadOnlyMemoryRegion;
 
 namespace io {
 
@@ -174,6 +180,35 @@ class SequentialRecordReader {
   uint64 offset_ = 0;
 };
 
+// Interface to read uncompressed TFRecord files from a memory region, e.g. a
+// memory mapped file from Env::NewReadOnlyMemoryRegionFromFile. Records are
+// returned as views into the region, so reading them doesn't copy them through
+// an input buffer, and the operating system reads ahead the mapped pages.
+//
+// Note: this class is not thread safe; external synchronization required.
+class MappedRecordReader {
+ public:
+  // Create a reader that will return records from "*region".
+  // "*region" must remain live while this Reader and the records it returned
+  // are in use.
+  explicit MappedRecordReader(tsl::ReadOnlyMemoryRegion* region);
+
+  // Set *record to a view of the record at "*offset" and update *offset to
+  // point to the offset of the next record. Returns OK on success,
+  // OUT_OF_RANGE for end of file, or something else for an error.
+  absl::Status ReadRecord(uint64* offset, absl::string_view* record) const;
+
+  // Same as above, but copies the record into *record.
+  absl::Status ReadRecord(uint64* offset, tstring* record) const;
+
+ private:
+  absl::Status ReadChecksummed(uint64 offset, size_t n,
+                               absl::string_view* result) const;
+
+  const char* data_;
+  uint64 size_;
+};
+
 }  // namespace io
 }  // namespace tsl
 
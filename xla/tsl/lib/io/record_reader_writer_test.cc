@@ -23,6 +23,7 @@ limitations under the License.
 #include <memory>
 #include <vector>
 
+#include "absl/strings/string_view.h"
 #include "xla/tsl/lib/core/status_test_util.h"
 #include "xla/tsl/platform/env.h"
 #include "xla/tsl/platform/errors.h"
@@ -162,6 +163,60 @@ TEST(RecordReaderWriterTest, TestBasics) {
   }
 }
 
+TEST(RecordReaderWriterTest, TestMappedReader) {
+  Env* env = Env::Default();
+  string fname = testing::TmpDir() + "/record_reader_writer_mapped_test";
+
+  {
+    std::unique_ptr<WritableFile> file;
+    TF_CHECK_OK(env->NewWritableFile(fname, &file));
+    io::RecordWriter writer(file.get());
+    TF_EXPECT_OK(writer.WriteRecord("abc"));
+    TF_EXPECT_OK(writer.WriteRecord("defg"));
+    TF_EXPECT_OK(writer.WriteRecord(""));
+    TF_CHECK_OK(writer.Flush());
+  }
+
+  std::unique_ptr<ReadOnlyMemoryRegion> region;
+  TF_CHECK_OK(env->NewReadOnlyMemoryRegionFromFile(fname, &region));
+  io::MappedRecordReader reader(region.get());
+
+  uint64 offset = 0;
+  absl::string_view record;
+  TF_CHECK_OK(reader.ReadRecord(&offset, &record));
+  EXPECT_EQ("abc", record);
+  EXPECT_EQ(static_cast<const char*>(region->data()) +
+                io::RecordReader::kHeaderSize,
+            record.data());
+
+  tstring copied;
+  TF_CHECK_OK(reader.ReadRecord(&offset, &copied));
+  EXPECT_EQ("defg", copied);
+  TF_CHECK_OK(reader.ReadRecord(&offset, &record));
+  EXPECT_EQ("", record);
+  EXPECT_EQ(offset, region->length());
+  EXPECT_EQ(reader.ReadRecord(&offset, &record).code(), error::OUT_OF_RANGE);
+
+  // A reader of a truncated region reports data loss.
+  class TruncatedRegion : public ReadOnlyMemoryRegion {
+   public:
+    explicit TruncatedRegion(ReadOnlyMemoryRegion* region)
+        : region_(region) {}
+    const void* data() override { return region_->data(); }
+    uint64 length() override { return region_->length() - 1; }
+
+   private:
+    ReadOnlyMemoryRegion* region_;
+  };
+  TruncatedRegion truncated(region.get());
+  io::MappedRecordReader truncated_reader(&truncated);
+  offset = 0;
+  TF_CHECK_OK(truncated_reader.ReadRecord(&offset, &record));
+  TF_CHECK_OK(truncated_reader.ReadRecord(&offset, &record));
+  EXPECT_EQ(truncated_reader.ReadRecord(&offset, &record).code(),
+            error::DATA_LOSS);
+}
+
 TEST(RecordReaderWriterTest, TestSkipBasic) {
   Env* env = Env::Default();
   string fname = testing::TmpDir() + "/record_reader_writer_skip_basic_test";
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "xla/tsl/platform/threadpool.h"
 
+#include <atomic>
 #include <cfenv>  // NOLINT
 #include <cstdint>
 #include <functional>
@@ -24,6 +25,7 @@ limitations under the License.
 
 #include "absl/base/optimization.h"
 #include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/env_time.h"
 #include "xla/tsl/platform/logging.h"
 #include "xla/tsl/platform/threadpool_interface.h"
 #include "xla/tsl/platform/types.h"
@@ -214,8 +216,13 @@ void ThreadPool::ParallelForFixedBlockSizeScheduling(
 
   // Adapted from Eigen's parallelFor implementation.
   BlockingCounter counter(num_shards_used);
+  // Shards that are not done yet, for spin waiting before blocking on
+  // `counter`. Shards decrement it before `counter`, so the caller still waits
+  // on `counter` afterwards, which returns right away once all shards are done.
+  std::atomic<int> pending_shards(num_shards_used);
   std::function<void(int64_t, int64_t)> handle_range =
-      [=, &handle_range, &counter, &fn](int64_t first, int64_t last) {
+      [=, &handle_range, &counter, &pending_shards, &fn](int64_t first,
+                                                         int64_t last) {
         while (last - first > block_size) {
           // Find something near the midpoint which is a multiple of block size.
           const int64_t mid = first + ((last - first) / 2 + block_size - 1) /
@@ -225,6 +232,7 @@ void ThreadPool::ParallelForFixedBlockSizeScheduling(
         }
         // Single block or less, execute directly.
         fn(first, last);
+        pending_shards.fetch_sub(1, std::memory_order_release);
         counter.DecrementCount();  // The shard is done.
       };
   if (num_shards_used <= NumThreads()) {
@@ -236,6 +244,13 @@ void ThreadPool::ParallelForFixedBlockSizeScheduling(
     // numThreads() threads.
     Schedule([=, &handle_range]() { handle_range(0, total); });
   }
+  if (parallel_for_spin_wait_micros_ > 0) {
+    const uint64 deadline =
+        EnvTime::NowMicros() + parallel_for_spin_wait_micros_;
+    while (pending_shards.load(std::memory_order_acquire) > 0) {
+      if (EnvTime::NowMicros() >= deadline) break;
+    }
+  }
   counter.Wait();
 }
 
@@ -150,8 +150,21 @@ class ThreadPool {
   // Schedules fn() for execution in the pool of threads.
   void Schedule(std::function<void()> fn);
 
+  // Schedules fn() for execution in the pool of threads, preferably on one of
+  // the threads with ids in [start, limit). With `limit == start + 1` the task
+  // is pushed to the queue of that thread, which hands it off to a specific
+  // worker, e.g. one that has the task inputs in its cache.
   void ScheduleWithHint(std::function<void()> fn, int start, int limit);
 
+  // Sets how long ParallelFor with fixed block size scheduling spins waiting
+  // for the shards running in other threads before parking the calling
+  // thread. For loops whose shards take a few microseconds, this avoids the
+  // latency of waking up the caller, at the cost of CPU time. Defaults to 0,
+  // which parks the caller right away.
+  void SetParallelForSpinWaitMicros(int64_t micros) {
+    parallel_for_spin_wait_micros_ = micros;
+  }
+
   // Returns the number of shards used by ParallelForFixedBlockSizeScheduling
   // with these parameters.
   int NumShardsUsedByFixedBlockSizeScheduling(int64_t total,
@@ -249,6 +262,8 @@ class ThreadPool {
   std::unique_ptr<Eigen::ThreadPoolTempl<EigenEnvironment>> eigen_threadpool_;
   std::unique_ptr<Eigen::ThreadPoolDevice> threadpool_device_;
 
+  int64_t parallel_for_spin_wait_micros_ = 0;
+
   ThreadPool(const ThreadPool&) = delete;
   void operator=(const ThreadPool&) = delete;
 };
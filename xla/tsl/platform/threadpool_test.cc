@@ -0,0 +1,97 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/tsl/platform/threadpool.h"
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/env_time.h"
+#include "xla/tsl/platform/test.h"
+#include "xla/tsl/platform/test_benchmark.h"
+#include "tsl/platform/blocking_counter.h"
+
+namespace tsl::thread {
+namespace {
+
+TEST(ThreadPoolTest, ParallelForWithSpinWait) {
+  ThreadPool thread_pool(Env::Default(), "test", 4);
+
+  for (int64_t spin_wait_micros : {0, 1, 1000}) {
+    thread_pool.SetParallelForSpinWaitMicros(spin_wait_micros);
+    for (int64_t total = 1; total < 64; ++total) {
+      std::vector<std::atomic<int>> counts(total);
+      thread_pool.ParallelFor(total, ThreadPool::SchedulingParams::Fixed(1),
+                              [&](int64_t begin, int64_t end) {
+                                for (int64_t i = begin; i < end; ++i) {
+                                  counts[i].fetch_add(1);
+                                }
+                              });
+      for (int64_t i = 0; i < total; ++i) {
+        EXPECT_EQ(counts[i].load(), 1) << total << " " << i;
+      }
+    }
+  }
+}
+
+TEST(ThreadPoolTest, ScheduleWithHintToSingleThread) {
+  ThreadPool thread_pool(Env::Default(), "test", 4);
+
+  std::atomic<int> thread_id = -2;
+  BlockingCounter counter(1);
+  thread_pool.ScheduleWithHint(
+      [&] {
+        thread_id = thread_pool.CurrentThreadId();
+        counter.DecrementCount();
+      },
+      /*start=*/2, /*limit=*/3);
+  counter.Wait();
+  EXPECT_GE(thread_id.load(), 0);
+}
+
+//===----------------------------------------------------------------------===//
+// Performance benchmarks.
+//===----------------------------------------------------------------------===//
+
+// Runs a parallel loop of microsecond-scale tasks, to measure the latency of
+// scheduling them and of waiting for their completion.
+static void BM_ParallelForShortTasks(benchmark::State& state) {
+  const int64_t spin_wait_micros = state.range(0);
+  const int64_t task_micros = state.range(1);
+
+  ThreadPool thread_pool(Env::Default(), "bench", 8);
+  thread_pool.SetParallelForSpinWaitMicros(spin_wait_micros);
+
+  for (auto _ : state) {
+    thread_pool.ParallelFor(8, ThreadPool::SchedulingParams::Fixed(1),
+                            [&](int64_t begin, int64_t end) {
+                              const uint64_t deadline =
+                                  EnvTime::NowMicros() + task_micros;
+                              while (EnvTime::NowMicros() < deadline) {
+                              }
+                            });
+  }
+}
+
+BENCHMARK(BM_ParallelForShortTasks)
+    ->ArgPair(0, 1)
+    ->ArgPair(0, 10)
+    ->ArgPair(50, 1)
+    ->ArgPair(50, 10);
+
+}  // namespace
+}  // namespace tsl::thread
@@ -388,6 +388,19 @@ TEST(UtilTest, PackInt4) {
   }
 }
 
+TEST(UtilTest, PackAndUnpackInt1) {
+  std::vector<char> input = {1, 0, 1, 1, 0, 0, 0, 1, 1, 1};
+
+  std::vector<char> packed(CeilOfRatio<int64_t>(input.size(), 8));
+  PackIntN(1, input, absl::MakeSpan(packed));
+  EXPECT_EQ(static_cast<uint8_t>(packed[0]), 0b10001101);
+  EXPECT_EQ(static_cast<uint8_t>(packed[1]), 0b00000011);
+
+  std::vector<char> unpacked(input.size());
+  UnpackIntN(1, packed, absl::MakeSpan(unpacked));
+  EXPECT_EQ(unpacked, input);
+}
+
 TEST(UtilTest, MaybeOwningTestNull) {
   MaybeOwning<char> m(nullptr);
   EXPECT_EQ(m.get(), nullptr);